@@ -255,6 +255,31 @@ ErrorOr<size_t> CircularBuffer::copy_from_seekback(size_t distance, size_t lengt
     if (distance > m_seekback_limit)
         return Error::from_string_literal("Tried a seekback copy beyond the seekback limit");
 
+    // Fast path for the common case of neither the source nor the destination wrapping around the end of the buffer.
+    auto const write_offset = (m_reading_head + m_used_space) % capacity();
+    if (distance != 0 && distance <= write_offset && write_offset + length <= capacity() && length <= empty_space()) {
+        auto* destination = m_buffer.data() + write_offset;
+        auto const* source = destination - distance;
+
+        if (distance >= length) {
+            __builtin_memcpy(destination, source, length);
+        } else {
+            // The source overlaps with the destination, which repeats the last `distance` bytes. Copying in chunks of
+            // up to `distance` bytes from front to back gets that right.
+            size_t i = 0;
+            if (distance >= sizeof(u64)) {
+                for (; i + sizeof(u64) <= length; i += sizeof(u64))
+                    __builtin_memcpy(destination + i, source + i, sizeof(u64));
+            }
+            for (; i < length; ++i)
+                destination[i] = source[i];
+        }
+
+        m_used_space += length;
+        m_seekback_limit = min(m_seekback_limit + length, capacity());
+        return length;
+    }
+
     auto remaining_length = length;
     while (remaining_length > 0) {
         if (empty_space() == 0)
@@ -36,6 +36,41 @@ public:
 
     ErrorOr<size_t> copy_from_seekback(size_t distance, size_t length);
 
+    /// These are fast paths for decoders that look back at and produce their output one byte at a time.
+    [[nodiscard]] u8 byte_at_seekback(size_t distance) const
+    {
+        VERIFY(distance > 0 && distance <= m_seekback_limit);
+
+        // Note: The write offset can be up to twice the capacity here, so wrapping it around takes at most one step in
+        //       either direction.
+        auto const capacity = m_buffer.size();
+        auto offset = m_reading_head + m_used_space;
+        if (offset < distance)
+            offset += capacity;
+        offset -= distance;
+        if (offset >= capacity)
+            offset -= capacity;
+
+        return m_buffer.data()[offset];
+    }
+
+    [[nodiscard]] bool write_byte(u8 value)
+    {
+        auto const capacity = m_buffer.size();
+        if (m_used_space == capacity)
+            return false;
+
+        auto offset = m_reading_head + m_used_space;
+        if (offset >= capacity)
+            offset -= capacity;
+        m_buffer.data()[offset] = value;
+
+        ++m_used_space;
+        if (m_seekback_limit < capacity)
+            ++m_seekback_limit;
+        return true;
+    }
+
     [[nodiscard]] size_t empty_space() const;
     [[nodiscard]] size_t used_space() const;
     [[nodiscard]] size_t capacity() const;
@@ -0,0 +1,617 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/Concepts.h>
+#include <AK/Error.h>
+#include <AK/HashTable.h>
+#include <AK/Optional.h>
+#include <AK/SIMD.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Traits.h>
+#include <AK/Types.h>
+#include <AK/kmalloc.h>
+
+namespace AK {
+
+namespace Detail {
+
+// Every slot of a FlatHashTable has one control byte. Used slots store the low 7 bits of their value's hash, so that
+// the bytes of a whole group of slots can be compared against the hash we're looking for at once.
+enum class FlatHashTableControl : i8 {
+    Empty = -128,
+    Deleted = -2,
+};
+
+// The slots in a group of control bytes that matched, one bit (or byte, without SSE2) per slot.
+template<typename MaskType, size_t Width, size_t Shift>
+class FlatHashTableMatch {
+public:
+    explicit FlatHashTableMatch(MaskType mask)
+        : m_mask(mask)
+    {
+    }
+
+    explicit operator bool() const { return m_mask != 0; }
+
+    size_t lowest_index() const { return count_trailing_zeroes(m_mask) >> Shift; }
+    size_t trailing_unmatched_count() const { return count_trailing_zeroes_safe(m_mask) >> Shift; }
+    size_t leading_unmatched_count() const { return (count_leading_zeroes_safe(m_mask) - (sizeof(MaskType) * 8 - (Width << Shift))) >> Shift; }
+    void clear_lowest() { m_mask &= m_mask - 1; }
+
+private:
+    MaskType m_mask;
+};
+
+#if defined(__SSE2__)
+// With SSE2, all 16 control bytes of a group are compared at once, and pmovmskb turns the result into one bit per slot.
+struct FlatHashTableGroup {
+    static constexpr size_t width = 16;
+    using Match = FlatHashTableMatch<u32, width, 0>;
+
+    explicit FlatHashTableGroup(i8 const* control)
+    {
+        __builtin_memcpy(&m_control, control, width);
+    }
+
+    Match match(i8 h2) const { return mask_of(m_control == h2); }
+    Match match_empty() const { return mask_of(m_control == static_cast<i8>(FlatHashTableControl::Empty)); }
+    // Empty and deleted control bytes are the only ones that have the sign bit set.
+    Match match_empty_or_deleted() const { return mask_of(m_control); }
+
+private:
+    static Match mask_of(SIMD::i8x16 bytes) { return Match(static_cast<u32>(__builtin_ia32_pmovmskb128(reinterpret_cast<SIMD::c8x16>(bytes)))); }
+
+    SIMD::i8x16 m_control;
+};
+#else
+// Elsewhere, compare 8 control bytes at a time. This is a single instruction with NEON, and leaves the top bit of every
+// byte set for the slots that matched.
+struct FlatHashTableGroup {
+    static constexpr size_t width = 8;
+    using Match = FlatHashTableMatch<u64, width, 3>;
+
+    explicit FlatHashTableGroup(i8 const* control)
+    {
+        __builtin_memcpy(&m_control, control, width);
+    }
+
+    Match match(i8 h2) const { return mask_of(m_control == h2); }
+    Match match_empty() const { return mask_of(m_control == static_cast<i8>(FlatHashTableControl::Empty)); }
+    Match match_empty_or_deleted() const { return mask_of(m_control < 0); }
+
+private:
+    static Match mask_of(SIMD::i8x8 bytes) { return Match(bit_cast<u64>(bytes) & 0x8080808080808080ull); }
+
+    SIMD::i8x8 m_control;
+};
+#endif
+
+}
+
+template<typename TableType, typename T>
+class FlatHashTableIterator {
+    friend TableType;
+
+public:
+    bool operator==(FlatHashTableIterator const& other) const { return m_slot == other.m_slot; }
+    bool operator!=(FlatHashTableIterator const& other) const { return m_slot != other.m_slot; }
+    T& operator*() { return *m_slot; }
+    T* operator->() { return m_slot; }
+    void operator++() { skip_to_next(); }
+
+private:
+    void skip_to_next()
+    {
+        if (!m_slot)
+            return;
+        do {
+            ++m_control;
+            ++m_slot;
+            if (m_control == m_end_control) {
+                m_slot = nullptr;
+                return;
+            }
+        } while (*m_control < 0);
+    }
+
+    FlatHashTableIterator(i8 const* control, T* slot, i8 const* end_control)
+        : m_control(control)
+        , m_slot(slot)
+        , m_end_control(end_control)
+    {
+    }
+
+    i8 const* m_control { nullptr };
+    T* m_slot { nullptr };
+    i8 const* m_end_control { nullptr };
+};
+
+// A set datastructure with the same interface as (unordered) HashTable, laid out like Abseil's "Swiss tables":
+// the values live in a flat array of slots, next to a separate array of one control byte per slot. Lookups compare
+// a whole group of control bytes against 7 bits of the hash at once, so even long probe sequences only touch the
+// slots whose hash bits match. This makes lookups in large or heavily loaded tables cheaper than with HashTable,
+// which has to look at every slot along the way.
+template<typename T, typename TraitsForT>
+class FlatHashTable {
+    using Control = Detail::FlatHashTableControl;
+    using Group = Detail::FlatHashTableGroup;
+
+    static constexpr size_t group_width = Group::width;
+    static constexpr size_t minimum_capacity = group_width;
+    static constexpr size_t max_load_factor_numerator = 7;
+    static constexpr size_t max_load_factor_denominator = 8;
+
+public:
+    FlatHashTable() = default;
+    explicit FlatHashTable(size_t capacity) { MUST(try_ensure_capacity(capacity)); }
+
+    ~FlatHashTable()
+    {
+        if (!m_control)
+            return;
+
+        destroy_values();
+        kfree_sized(m_control, size_in_bytes(m_capacity));
+    }
+
+    FlatHashTable(FlatHashTable const& other)
+    {
+        MUST(try_ensure_capacity(other.size()));
+        for (auto& it : other)
+            set(it);
+    }
+
+    FlatHashTable& operator=(FlatHashTable const& other)
+    {
+        FlatHashTable temporary(other);
+        swap(*this, temporary);
+        return *this;
+    }
+
+    FlatHashTable(FlatHashTable&& other) noexcept
+        : m_control(other.m_control)
+        , m_slots(other.m_slots)
+        , m_size(other.m_size)
+        , m_capacity(other.m_capacity)
+        , m_growth_left(other.m_growth_left)
+    {
+        other.m_control = nullptr;
+        other.m_slots = nullptr;
+        other.m_size = 0;
+        other.m_capacity = 0;
+        other.m_growth_left = 0;
+    }
+
+    FlatHashTable& operator=(FlatHashTable&& other) noexcept
+    {
+        FlatHashTable temporary { move(other) };
+        swap(*this, temporary);
+        return *this;
+    }
+
+    friend void swap(FlatHashTable& a, FlatHashTable& b) noexcept
+    {
+        swap(a.m_control, b.m_control);
+        swap(a.m_slots, b.m_slots);
+        swap(a.m_size, b.m_size);
+        swap(a.m_capacity, b.m_capacity);
+        swap(a.m_growth_left, b.m_growth_left);
+    }
+
+    [[nodiscard]] bool is_empty() const { return m_size == 0; }
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] size_t capacity() const { return m_capacity; }
+
+    template<typename U, size_t N>
+    ErrorOr<void> try_set_from(U (&from_array)[N])
+    {
+        for (size_t i = 0; i < N; ++i)
+            TRY(try_set(from_array[i]));
+        return {};
+    }
+    template<typename U, size_t N>
+    void set_from(U (&from_array)[N])
+    {
+        MUST(try_set_from(from_array));
+    }
+
+    ErrorOr<void> try_ensure_capacity(size_t capacity)
+    {
+        // As with HashTable, "capacity" here means the number of values that fit without reallocating.
+        if (m_size + m_growth_left >= capacity)
+            return {};
+        return try_rehash(capacity_for_size(capacity));
+    }
+    void ensure_capacity(size_t capacity)
+    {
+        MUST(try_ensure_capacity(capacity));
+    }
+
+    [[nodiscard]] bool contains(T const& value) const
+    {
+        return find(value) != end();
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] bool contains(K const& value) const
+    {
+        return find(value) != end();
+    }
+
+    using Iterator = FlatHashTableIterator<FlatHashTable, T>;
+
+    [[nodiscard]] Iterator begin()
+    {
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (is_full(m_control[i]))
+                return iterator_at(i);
+        }
+        return end();
+    }
+
+    [[nodiscard]] Iterator end()
+    {
+        return Iterator(nullptr, nullptr, nullptr);
+    }
+
+    using ConstIterator = FlatHashTableIterator<FlatHashTable const, T const>;
+
+    [[nodiscard]] ConstIterator begin() const
+    {
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (is_full(m_control[i]))
+                return const_iterator_at(i);
+        }
+        return end();
+    }
+
+    [[nodiscard]] ConstIterator end() const
+    {
+        return ConstIterator(nullptr, nullptr, nullptr);
+    }
+
+    void clear()
+    {
+        *this = FlatHashTable();
+    }
+
+    void clear_with_capacity()
+    {
+        if (m_capacity == 0)
+            return;
+        destroy_values();
+        __builtin_memset(m_control, static_cast<u8>(Control::Empty), m_capacity + group_width);
+        m_size = 0;
+        m_growth_left = max_size_for_capacity(m_capacity);
+    }
+
+    template<typename U = T>
+    ErrorOr<HashSetResult> try_set(U&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace)
+    {
+        auto hash = TraitsForT::hash(value);
+        if (auto index = lookup_with_hash(hash, [&](auto& entry) { return TraitsForT::equals(entry, static_cast<T const&>(value)); }); index.has_value()) {
+            if (existing_entry_behavior == HashSetExistingEntryBehavior::Replace) {
+                m_slots[*index] = forward<U>(value);
+                return HashSetResult::ReplacedExistingEntry;
+            }
+            return HashSetResult::KeptExistingEntry;
+        }
+
+        if (m_capacity == 0)
+            TRY(try_rehash(minimum_capacity));
+
+        auto index = find_insertion_index(hash);
+        if (m_growth_left == 0 && m_control[index] == static_cast<i8>(Control::Empty)) {
+            // Throw out deleted slots if they make up a good part of the table, grow it otherwise.
+            auto new_capacity = m_size * 2 < max_size_for_capacity(m_capacity) ? m_capacity : m_capacity * 2;
+            TRY(try_rehash(max(new_capacity, minimum_capacity)));
+            index = find_insertion_index(hash);
+        }
+
+        insert_at(index, hash, forward<U>(value));
+        return HashSetResult::InsertedNewEntry;
+    }
+    template<typename U = T>
+    HashSetResult set(U&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace)
+    {
+        return MUST(try_set(forward<U>(value), existing_entry_behavior));
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] Iterator find(unsigned hash, TUnaryPredicate predicate)
+    {
+        auto index = lookup_with_hash(hash, move(predicate));
+        if (!index.has_value())
+            return end();
+        return iterator_at(*index);
+    }
+
+    [[nodiscard]] Iterator find(T const& value)
+    {
+        if (is_empty())
+            return end();
+        return find(TraitsForT::hash(value), [&](auto& entry) { return TraitsForT::equals(entry, value); });
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] ConstIterator find(unsigned hash, TUnaryPredicate predicate) const
+    {
+        auto index = lookup_with_hash(hash, move(predicate));
+        if (!index.has_value())
+            return end();
+        return const_iterator_at(*index);
+    }
+
+    [[nodiscard]] ConstIterator find(T const& value) const
+    {
+        if (is_empty())
+            return end();
+        return find(TraitsForT::hash(value), [&](auto& entry) { return TraitsForT::equals(entry, value); });
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] Iterator find(K const& value)
+    {
+        if (is_empty())
+            return end();
+        return find(Traits<K>::hash(value), [&](auto& entry) { return Traits<T>::equals(entry, value); });
+    }
+
+    template<Concepts::HashCompatible<T> K, typename TUnaryPredicate>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] Iterator find(K const& value, TUnaryPredicate predicate)
+    {
+        if (is_empty())
+            return end();
+        return find(Traits<K>::hash(value), move(predicate));
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] ConstIterator find(K const& value) const
+    {
+        if (is_empty())
+            return end();
+        return find(Traits<K>::hash(value), [&](auto& entry) { return Traits<T>::equals(entry, value); });
+    }
+
+    template<Concepts::HashCompatible<T> K, typename TUnaryPredicate>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] ConstIterator find(K const& value, TUnaryPredicate predicate) const
+    {
+        if (is_empty())
+            return end();
+        return find(Traits<K>::hash(value), move(predicate));
+    }
+
+    bool remove(T const& value)
+    {
+        auto it = find(value);
+        if (it != end()) {
+            remove(it);
+            return true;
+        }
+        return false;
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) bool remove(K const& value)
+    {
+        auto it = find(value);
+        if (it != end()) {
+            remove(it);
+            return true;
+        }
+        return false;
+    }
+
+    // This invalidates the iterator
+    void remove(Iterator& iterator)
+    {
+        VERIFY(iterator.m_slot);
+        delete_at(iterator.m_slot - m_slots);
+        iterator.m_slot = nullptr;
+    }
+
+    template<typename TUnaryPredicate>
+    bool remove_all_matching(TUnaryPredicate const& predicate)
+    {
+        // Removing values never moves the other ones around, so we can simply walk the slots.
+        bool has_removed_anything = false;
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (!is_full(m_control[i]) || !predicate(m_slots[i]))
+                continue;
+            delete_at(i);
+            has_removed_anything = true;
+        }
+        return has_removed_anything;
+    }
+
+    [[nodiscard]] Vector<T> values() const
+    {
+        Vector<T> list;
+        list.ensure_capacity(size());
+        for (auto& value : *this)
+            list.unchecked_append(value);
+        return list;
+    }
+
+private:
+    // Probing goes through the table one group at a time, with the distance between groups growing by one group each
+    // time. With a power-of-two capacity, this visits every group exactly once before it wraps around.
+    class ProbeSequence {
+    public:
+        ProbeSequence(size_t hash, size_t mask)
+            : m_mask(mask)
+            , m_offset(hash & mask)
+        {
+        }
+
+        size_t offset() const { return m_offset; }
+        size_t offset(size_t i) const { return (m_offset + i) & m_mask; }
+        void next()
+        {
+            m_index += group_width;
+            m_offset = (m_offset + m_index) & m_mask;
+        }
+
+    private:
+        size_t m_mask;
+        size_t m_offset;
+        size_t m_index { 0 };
+    };
+
+    static constexpr bool is_full(i8 control) { return control >= 0; }
+    static constexpr size_t h1(unsigned hash) { return hash >> 7; }
+    static constexpr i8 h2(unsigned hash) { return static_cast<i8>(hash & 0x7f); }
+
+    static constexpr size_t max_size_for_capacity(size_t capacity) { return capacity * max_load_factor_numerator / max_load_factor_denominator; }
+    static size_t capacity_for_size(size_t size)
+    {
+        size_t capacity = minimum_capacity;
+        while (max_size_for_capacity(capacity) < size)
+            capacity *= 2;
+        return capacity;
+    }
+
+    // There is one control byte per slot, followed by a copy of the first group's control bytes, so that groups read
+    // near the end of the table don't have to wrap around. The slots follow the control bytes.
+    static constexpr size_t slots_offset(size_t capacity) { return align_up_to(capacity + group_width, alignof(T)); }
+    static constexpr size_t size_in_bytes(size_t capacity) { return slots_offset(capacity) + sizeof(T) * capacity; }
+
+    Iterator iterator_at(size_t index) { return Iterator(&m_control[index], &m_slots[index], &m_control[m_capacity]); }
+    ConstIterator const_iterator_at(size_t index) const { return ConstIterator(&m_control[index], &m_slots[index], &m_control[m_capacity]); }
+
+    void set_control(size_t index, i8 control)
+    {
+        m_control[index] = control;
+        if (index < group_width)
+            m_control[m_capacity + index] = control;
+    }
+
+    void destroy_values()
+    {
+        if constexpr (!IsTriviallyDestructible<T>) {
+            for (size_t i = 0; i < m_capacity; ++i) {
+                if (is_full(m_control[i]))
+                    m_slots[i].~T();
+            }
+        }
+    }
+
+    ErrorOr<void> try_rehash(size_t new_capacity)
+    {
+        VERIFY(new_capacity >= minimum_capacity && popcount(new_capacity) == 1);
+        VERIFY(max_size_for_capacity(new_capacity) >= m_size);
+
+        auto* new_memory = static_cast<u8*>(kmalloc(size_in_bytes(new_capacity)));
+        if (!new_memory)
+            return Error::from_errno(ENOMEM);
+
+        auto* old_control = m_control;
+        auto* old_slots = m_slots;
+        auto old_capacity = m_capacity;
+
+        m_control = reinterpret_cast<i8*>(new_memory);
+        m_slots = reinterpret_cast<T*>(new_memory + slots_offset(new_capacity));
+        m_capacity = new_capacity;
+        m_growth_left = max_size_for_capacity(new_capacity);
+        __builtin_memset(m_control, static_cast<u8>(Control::Empty), new_capacity + group_width);
+
+        if (!old_control)
+            return {};
+
+        auto old_size = m_size;
+        m_size = 0;
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (!is_full(old_control[i]))
+                continue;
+            auto hash = TraitsForT::hash(old_slots[i]);
+            insert_at(find_insertion_index(hash), hash, move(old_slots[i]));
+            old_slots[i].~T();
+        }
+        VERIFY(m_size == old_size);
+
+        kfree_sized(old_control, size_in_bytes(old_capacity));
+        return {};
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] Optional<size_t> lookup_with_hash(unsigned hash, TUnaryPredicate predicate) const
+    {
+        if (is_empty())
+            return {};
+
+        ProbeSequence sequence { h1(hash), m_capacity - 1 };
+        for (;;) {
+            Group group { m_control + sequence.offset() };
+            for (auto match = group.match(h2(hash)); match; match.clear_lowest()) {
+                auto index = sequence.offset(match.lowest_index());
+                if (predicate(m_slots[index]))
+                    return index;
+            }
+            if (group.match_empty())
+                return {};
+            sequence.next();
+        }
+    }
+
+    // Finds the first empty or deleted slot that a value with the given hash can go into.
+    size_t find_insertion_index(unsigned hash) const
+    {
+        ProbeSequence sequence { h1(hash), m_capacity - 1 };
+        for (;;) {
+            Group group { m_control + sequence.offset() };
+            if (auto match = group.match_empty_or_deleted())
+                return sequence.offset(match.lowest_index());
+            sequence.next();
+        }
+    }
+
+    template<typename U>
+    void insert_at(size_t index, unsigned hash, U&& value)
+    {
+        if (m_control[index] == static_cast<i8>(Control::Empty))
+            --m_growth_left;
+        new (&m_slots[index]) T(forward<U>(value));
+        set_control(index, h2(hash));
+        ++m_size;
+    }
+
+    void delete_at(size_t index)
+    {
+        VERIFY(index < m_capacity && is_full(m_control[index]));
+
+        m_slots[index].~T();
+        --m_size;
+
+        // If there has never been a full group around this slot, no probe sequence can have gone past it, so it can
+        // become empty again instead of being marked as deleted.
+        Group group_before { m_control + ((index - group_width) & (m_capacity - 1)) };
+        Group group_after { m_control + index };
+        auto empty_before = group_before.match_empty();
+        auto empty_after = group_after.match_empty();
+        if (empty_before && empty_after && empty_before.leading_unmatched_count() + empty_after.trailing_unmatched_count() < group_width) {
+            set_control(index, static_cast<i8>(Control::Empty));
+            ++m_growth_left;
+        } else {
+            set_control(index, static_cast<i8>(Control::Deleted));
+        }
+    }
+
+    i8* m_control { nullptr };
+    T* m_slots { nullptr };
+    size_t m_size { 0 };
+    size_t m_capacity { 0 };
+    // How many more values fit before we have to rehash. Deleted slots count against this until the next rehash.
+    size_t m_growth_left { 0 };
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::FlatHashTable;
+#endif
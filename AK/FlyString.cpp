@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
 #include <AK/DeprecatedFlyString.h>
 #include <AK/FlyString.h>
 #include <AK/HashMap.h>
@@ -20,20 +22,93 @@ struct FlyStringTableHashTraits : public Traits<Detail::StringData const*> {
     static bool equals(Detail::StringData const* a, Detail::StringData const* b) { return *a == *b; }
 };
 
-static auto& all_fly_strings()
+// FlyStrings may be created and destroyed on any thread. To keep threads that intern strings at the same time from
+// contending on a single lock, the table is split into shards by hash, each of them guarded by its own lock.
+class FlyStringTable {
+public:
+    class Shard {
+    public:
+        HashTable<Detail::StringData const*, FlyStringTableHashTraits>& strings() { return m_strings; }
+
+        void lock()
+        {
+            while (m_locked.exchange(true, AK::MemoryOrder::memory_order_acquire)) {
+                // Only the few instructions of a hash table lookup or insertion are ever run under the lock.
+                while (m_locked.load(AK::MemoryOrder::memory_order_relaxed))
+                    sched_yield();
+            }
+        }
+
+        void unlock() { m_locked.store(false, AK::MemoryOrder::memory_order_release); }
+
+    private:
+        Atomic<bool> m_locked { false };
+        HashTable<Detail::StringData const*, FlyStringTableHashTraits> m_strings;
+    };
+
+    class Locker {
+        AK_MAKE_NONCOPYABLE(Locker);
+        AK_MAKE_NONMOVABLE(Locker);
+
+    public:
+        explicit Locker(Shard& shard)
+            : m_shard(shard)
+        {
+            m_shard.lock();
+        }
+        ~Locker() { m_shard.unlock(); }
+
+    private:
+        Shard& m_shard;
+    };
+
+    // The low bits of the hash pick the bucket inside a shard's HashTable, so pick the shard with the high ones.
+    Shard& shard_for_hash(u32 hash) { return m_shards[hash >> (32 - shard_count_bits)]; }
+
+    size_t size()
+    {
+        size_t size = 0;
+        for (auto& shard : m_shards) {
+            Locker locker(shard);
+            size += shard.strings().size();
+        }
+        return size;
+    }
+
+private:
+    static constexpr size_t shard_count_bits = 6;
+    Array<Shard, 1 << shard_count_bits> m_shards;
+};
+
+static FlyStringTable& all_fly_strings()
 {
-    static Singleton<HashTable<Detail::StringData const*, FlyStringTableHashTraits>> table;
+    static Singleton<FlyStringTable> table;
     return *table;
 }
 
+// Looks for an interned string with the given contents, and takes a reference to it if there is one.
+static Detail::StringData const* find_fly_string_data(StringView string)
+{
+    auto hash = string.hash();
+    auto& shard = all_fly_strings().shard_for_hash(hash);
+    FlyStringTable::Locker locker(shard);
+
+    auto it = shard.strings().find(hash, [&](auto& entry) { return entry->bytes_as_string_view() == string; });
+    // The last reference to a string may have gone away on another thread that is now waiting for our lock to
+    // remove the string from the table. Treat it as if it was already gone.
+    if (it == shard.strings().end() || !(*it)->try_ref())
+        return nullptr;
+    return *it;
+}
+
 ErrorOr<FlyString> FlyString::from_utf8(StringView string)
 {
     if (string.is_empty())
         return FlyString {};
     if (string.length() <= Detail::MAX_SHORT_STRING_BYTE_COUNT)
         return FlyString { TRY(String::from_utf8(string)) };
-    if (auto it = all_fly_strings().find(string.hash(), [&](auto& entry) { return entry->bytes_as_string_view() == string; }); it != all_fly_strings().end())
-        return FlyString { Detail::StringBase(**it) };
+    if (auto const* data = find_fly_string_data(string))
+        return FlyString { Detail::StringBase(adopt_ref(*data)) };
     return FlyString { TRY(String::from_utf8(string)) };
 }
 
@@ -43,8 +118,8 @@ FlyString FlyString::from_utf8_without_validation(ReadonlyBytes string)
         return FlyString {};
     if (string.size() <= Detail::MAX_SHORT_STRING_BYTE_COUNT)
         return FlyString { String::from_utf8_without_validation(string) };
-    if (auto it = all_fly_strings().find(StringView(string).hash(), [&](auto& entry) { return entry->bytes_as_string_view() == string; }); it != all_fly_strings().end())
-        return FlyString { Detail::StringBase(**it) };
+    if (auto const* data = find_fly_string_data(StringView(string)))
+        return FlyString { Detail::StringBase(adopt_ref(*data)) };
     return FlyString { String::from_utf8_without_validation(string) };
 }
 
@@ -60,15 +135,20 @@ FlyString::FlyString(String const& string)
         return;
     }
 
-    auto it = all_fly_strings().find(string.m_data);
-    if (it == all_fly_strings().end()) {
-        m_data = string;
-        all_fly_strings().set(string.m_data);
-        string.m_data->set_fly_string(true);
-    } else {
+    auto hash = string.m_data->hash();
+    auto& shard = all_fly_strings().shard_for_hash(hash);
+    FlyStringTable::Locker locker(shard);
+
+    auto it = shard.strings().find(string.m_data);
+    if (it != shard.strings().end() && (*it)->try_ref()) {
         m_data.m_data = *it;
-        m_data.m_data->ref();
+        return;
     }
+
+    // If there was an entry we couldn't take a reference to, it is on its way out, and this replaces it.
+    m_data = string;
+    string.m_data->set_fly_string(true);
+    shard.strings().set(string.m_data);
 }
 
 FlyString& FlyString::operator=(String const& string)
@@ -135,7 +215,14 @@ bool FlyString::operator==(char const* string) const
 
 void FlyString::did_destroy_fly_string_data(Badge<Detail::StringData>, Detail::StringData const& string_data)
 {
-    all_fly_strings().remove(&string_data);
+    auto hash = string_data.hash();
+    auto& shard = all_fly_strings().shard_for_hash(hash);
+    FlyStringTable::Locker locker(shard);
+
+    // Another string with the same contents may have replaced this one in the table already, so only remove this exact one.
+    auto it = shard.strings().find(hash, [&](auto* entry) { return entry == &string_data; });
+    if (it != shard.strings().end())
+        shard.strings().remove(it);
 }
 
 Detail::StringBase FlyString::data(Badge<String>) const
@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteString.h>
 #include <AK/CharacterTypes.h>
+#include <AK/FlyString.h>
 #include <AK/Format.h>
 #include <AK/GenericLexer.h>
 #include <AK/IntegralMath.h>
@@ -85,26 +87,56 @@ static constexpr size_t convert_unsigned_to_string(u64 value, Array<u8, 128>& bu
     return used;
 }
 
+// Writes the parameter the same way its Formatter would for a replacement field without a format specification.
+ErrorOr<void> format_plain_value(FormatBuilder& builder, TypeErasedParameter const& parameter)
+{
+    switch (parameter.plain_format) {
+    case TypeErasedParameter::PlainFormat::Integer:
+        return parameter.visit([&]<typename T>(T value) {
+            if constexpr (IsSigned<T>)
+                return builder.put_i64(value);
+            else
+                return builder.put_u64(value);
+        });
+    case TypeErasedParameter::PlainFormat::StringView:
+        return builder.put_string(*static_cast<StringView const*>(parameter.value));
+    case TypeErasedParameter::PlainFormat::String:
+        return builder.put_string(static_cast<String const*>(parameter.value)->bytes_as_string_view());
+    case TypeErasedParameter::PlainFormat::FlyString:
+        return builder.put_string(static_cast<FlyString const*>(parameter.value)->bytes_as_string_view());
+    case TypeErasedParameter::PlainFormat::ByteString:
+        return builder.put_string(static_cast<ByteString const*>(parameter.value)->view());
+    case TypeErasedParameter::PlainFormat::None:
+        break;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 ErrorOr<void> vformat_impl(TypeErasedFormatParams& params, FormatBuilder& builder, FormatParser& parser)
 {
-    auto const literal = parser.consume_literal();
-    TRY(builder.put_literal(literal));
+    while (true) {
+        auto const literal = parser.consume_literal();
+        TRY(builder.put_literal(literal));
+
+        FormatParser::FormatSpecifier specifier;
+        if (!parser.consume_specifier(specifier)) {
+            VERIFY(parser.is_eof());
+            return {};
+        }
 
-    FormatParser::FormatSpecifier specifier;
-    if (!parser.consume_specifier(specifier)) {
-        VERIFY(parser.is_eof());
-        return {};
-    }
+        if (specifier.index == use_next_index)
+            specifier.index = params.take_next_index();
 
-    if (specifier.index == use_next_index)
-        specifier.index = params.take_next_index();
+        auto& parameter = params.parameters().at(specifier.index);
 
-    auto& parameter = params.parameters().at(specifier.index);
+        if (specifier.flags.is_empty() && parameter.plain_format != TypeErasedParameter::PlainFormat::None) {
+            TRY(format_plain_value(builder, parameter));
+            continue;
+        }
 
-    FormatParser argparser { specifier.flags };
-    TRY(parameter.formatter(params, builder, argparser, parameter.value));
-    TRY(vformat_impl(params, builder, parser));
-    return {};
+        FormatParser argparser { specifier.flags };
+        TRY(parameter.formatter(params, builder, argparser, parameter.value));
+    }
 }
 
 } // namespace AK::{anonymous}
@@ -207,10 +239,14 @@ ErrorOr<void> FormatBuilder::put_padding(char fill, size_t amount)
 }
 ErrorOr<void> FormatBuilder::put_literal(StringView value)
 {
-    for (size_t i = 0; i < value.length(); ++i) {
-        TRY(m_builder.try_append(value[i]));
-        if (value[i] == '{' || value[i] == '}')
-            ++i;
+    // Escaped braces are doubled, so append everything up to and including the first brace of each pair at once.
+    while (!value.is_empty()) {
+        auto brace_index = value.find_any_of("{}"sv);
+        if (!brace_index.has_value())
+            return m_builder.try_append(value);
+
+        TRY(m_builder.try_append(value.substring_view(0, *brace_index + 1)));
+        value = value.substring_view(min(*brace_index + 2, value.length()));
     }
     return {};
 }
@@ -314,9 +350,7 @@ ErrorOr<void> FormatBuilder::put_u64(
     };
 
     auto const put_digits = [&]() -> ErrorOr<void> {
-        for (size_t i = 0; i < used_by_digits; ++i)
-            TRY(m_builder.try_append(buffer[i]));
-        return {};
+        return m_builder.try_append(StringView { buffer.data(), used_by_digits });
     };
 
     if (align == Align::Left) {
@@ -101,6 +101,35 @@ struct TypeErasedParameter {
             return Type::Custom;
     }
 
+    // Values of these kinds are written out directly for a replacement field without a format specification ("{}"),
+    // which is by far the most common one, instead of going through their Formatter.
+    enum class PlainFormat : u8 {
+        None,
+        Integer,
+        StringView,
+        String,
+        FlyString,
+        ByteString,
+    };
+
+    template<typename T>
+    static consteval PlainFormat get_plain_format()
+    {
+        // These have formatters of their own that don't print them as numbers.
+        if constexpr (IsIntegral<T> && !IsOneOf<T, bool, char, wchar_t>)
+            return PlainFormat::Integer;
+        else if constexpr (IsSame<T, AK::StringView>)
+            return PlainFormat::StringView;
+        else if constexpr (IsSame<T, AK::String>)
+            return PlainFormat::String;
+        else if constexpr (IsSame<T, AK::FlyString>)
+            return PlainFormat::FlyString;
+        else if constexpr (IsSame<T, AK::ByteString>)
+            return PlainFormat::ByteString;
+        else
+            return PlainFormat::None;
+    }
+
     template<typename Visitor>
     constexpr auto visit(Visitor&& visitor) const
     {
@@ -141,6 +170,7 @@ struct TypeErasedParameter {
 
     void const* value;
     Type type;
+    PlainFormat plain_format;
     ErrorOr<void> (*formatter)(TypeErasedFormatParams&, FormatBuilder&, FormatParser&, void const* value);
 };
 
@@ -309,7 +339,7 @@ public:
 
     explicit VariadicFormatParams(Parameters const&... parameters)
         : TypeErasedFormatParams(sizeof...(Parameters))
-        , m_parameter_storage { TypeErasedParameter { &parameters, TypeErasedParameter::get_type<Parameters>(), __format_value<Parameters> }... }
+        , m_parameter_storage { TypeErasedParameter { &parameters, TypeErasedParameter::get_type<Parameters>(), TypeErasedParameter::get_plain_format<Parameters>(), __format_value<Parameters> }... }
     {
         constexpr bool any_debug_formatters = (is_debug_only_formatter<Formatter<Parameters>>() || ...);
         static_assert(!any_debug_formatters || allow_debug_formatters == AllowDebugOnlyFormatters::Yes,
@@ -95,6 +95,9 @@ class HashTable;
 template<typename T, typename TraitsForT = Traits<T>>
 using OrderedHashTable = HashTable<T, TraitsForT, true>;
 
+template<typename T, typename TraitsForT = Traits<T>>
+class FlatHashTable;
+
 template<typename K, typename V, typename KeyTraits = Traits<K>, typename ValueTraits = Traits<V>, bool IsOrdered = false>
 class HashMap;
 
@@ -162,6 +165,7 @@ using AK::DoublyLinkedList;
 using AK::Error;
 using AK::ErrorOr;
 using AK::FixedArray;
+using AK::FlatHashTable;
 using AK::FlyString;
 using AK::Function;
 using AK::GenericLexer;
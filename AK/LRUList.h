@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AnyOf.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// The entries of a small cache, kept in most-recently-used order so that the least recently used entry is the one that
+// gets evicted first. Looking an entry up marks it as the most recently used one. How many entries to keep is up to
+// the cache, which takes the least recently used entries out until it's within its budget again.
+template<typename T>
+class LRUList {
+public:
+    size_t size() const { return m_entries.size(); }
+    bool is_empty() const { return m_entries.is_empty(); }
+
+    template<typename Predicate>
+    T* find_if(Predicate predicate)
+    {
+        auto index = m_entries.find_first_index_if(move(predicate));
+        if (!index.has_value())
+            return nullptr;
+        if (*index != 0)
+            m_entries.prepend(m_entries.take(*index));
+        return &m_entries.first();
+    }
+
+    // Unlike find_if(), this doesn't count as using the entry.
+    template<typename Predicate>
+    bool contains_if(Predicate predicate) const
+    {
+        return any_of(m_entries, predicate);
+    }
+
+    void add(T entry) { m_entries.prepend(move(entry)); }
+
+    T take_least_recently_used() { return m_entries.take_last(); }
+
+    void clear() { m_entries.clear(); }
+
+private:
+    Vector<T> m_entries;
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::LRUList;
+#endif
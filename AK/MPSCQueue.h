@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/StdLibExtras.h>
+
+namespace AK {
+
+// A queue that any number of threads can push to at the same time without taking a lock, and that a single thread
+// empties in batches. Pushing is one compare-and-swap, and taking everything that has been pushed so far is one
+// exchange, after which the batch can be worked through without touching shared state.
+template<typename T>
+class MPSCQueue {
+    AK_MAKE_NONCOPYABLE(MPSCQueue);
+    AK_MAKE_NONMOVABLE(MPSCQueue);
+
+    struct Node {
+        T value;
+        Node* next { nullptr };
+    };
+
+public:
+    // Values taken out of the queue at once, in the order they were pushed.
+    class Batch {
+        AK_MAKE_NONCOPYABLE(Batch);
+
+    public:
+        Batch() = default;
+
+        Batch(Batch&& other)
+            : m_head(exchange(other.m_head, nullptr))
+        {
+        }
+
+        Batch& operator=(Batch&& other)
+        {
+            if (this != &other) {
+                clear();
+                m_head = exchange(other.m_head, nullptr);
+            }
+            return *this;
+        }
+
+        ~Batch() { clear(); }
+
+        bool is_empty() const { return m_head == nullptr; }
+
+        // Visits the values in place, without taking them out of the batch.
+        template<typename Callback>
+        void for_each(Callback callback)
+        {
+            for (auto* node = m_head; node; node = node->next)
+                callback(node->value);
+        }
+
+        T take_first()
+        {
+            VERIFY(m_head);
+            auto* node = m_head;
+            m_head = node->next;
+            auto value = move(node->value);
+            delete node;
+            return value;
+        }
+
+        void clear()
+        {
+            while (m_head)
+                delete exchange(m_head, m_head->next);
+        }
+
+    private:
+        friend class MPSCQueue;
+
+        explicit Batch(Node* head)
+            : m_head(head)
+        {
+        }
+
+        Node* m_head { nullptr };
+    };
+
+    MPSCQueue() = default;
+
+    ~MPSCQueue()
+    {
+        // Anything still in the queue gets destroyed along with the batch.
+        (void)take_all();
+    }
+
+    // May be called from any thread.
+    template<typename U = T>
+    void push(U&& value)
+    {
+        auto* node = new Node { forward<U>(value) };
+        auto* head = m_head.load(AK::MemoryOrder::memory_order_relaxed);
+        do {
+            node->next = head;
+        } while (!m_head.compare_exchange_strong(head, node, AK::MemoryOrder::memory_order_release));
+    }
+
+    // May be called from any thread. Pushes every value of the batch at once, reusing its nodes rather than allocating.
+    void push_all(Batch&& batch)
+    {
+        auto* node = exchange(batch.m_head, nullptr);
+        if (!node)
+            return;
+
+        // The batch is in the order the values were pushed, so turn it around to get a stack of pushes again.
+        auto* last = node;
+        Node* reversed = nullptr;
+        while (node) {
+            auto* next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+
+        auto* head = m_head.load(AK::MemoryOrder::memory_order_relaxed);
+        do {
+            last->next = head;
+        } while (!m_head.compare_exchange_strong(head, reversed, AK::MemoryOrder::memory_order_release));
+    }
+
+    // May only be called from the consuming thread.
+    [[nodiscard]] Batch take_all()
+    {
+        auto* node = m_head.exchange(nullptr, AK::MemoryOrder::memory_order_acquire);
+
+        // The queue is a stack of pushes, newest first, so turn it around to get them in the order they were pushed.
+        Node* reversed = nullptr;
+        while (node) {
+            auto* next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+        return Batch { reversed };
+    }
+
+    bool is_empty() const { return m_head.load(AK::MemoryOrder::memory_order_acquire) == nullptr; }
+
+private:
+    Atomic<Node*> m_head { nullptr };
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::MPSCQueue;
+#endif
@@ -100,6 +100,25 @@ ErrorOr<String> String::from_utf16(Utf16View const& utf16)
     return result;
 }
 
+ErrorOr<String> String::from_latin1(ReadonlyBytes bytes)
+{
+    if (bytes.is_empty())
+        return String {};
+
+    auto const* latin1 = reinterpret_cast<char const*>(bytes.data());
+    auto utf8_length = simdutf::utf8_length_from_latin1(latin1, bytes.size());
+
+    String result;
+    TRY(result.replace_with_new_string(utf8_length, [&](Bytes buffer) -> ErrorOr<void> {
+        [[maybe_unused]] auto result = simdutf::convert_latin1_to_utf8(latin1, bytes.size(), reinterpret_cast<char*>(buffer.data()));
+        ASSERT(result == buffer.size());
+
+        return {};
+    }));
+
+    return result;
+}
+
 ErrorOr<String> String::from_stream(Stream& stream, size_t byte_count)
 {
     String result;
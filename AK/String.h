@@ -71,6 +71,9 @@ public:
     // Creates a new String from a sequence of UTF-16 encoded code points.
     static ErrorOr<String> from_utf16(Utf16View const&);
 
+    // Creates a new String from a sequence of Latin-1 encoded bytes, each of which is the code point of the same value.
+    static ErrorOr<String> from_latin1(ReadonlyBytes);
+
     // Creates a new String by reading byte_count bytes from a UTF-8 encoded Stream.
     static ErrorOr<String> from_stream(Stream&, size_t byte_count);
 
@@ -6,18 +6,25 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
+#include <AK/Checked.h>
 #include <AK/Error.h>
 #include <AK/FlyString.h>
 #include <AK/NonnullRefPtr.h>
-#include <AK/RefCounted.h>
+#include <AK/Noncopyable.h>
 #include <AK/StringBase.h>
 #include <AK/StringBuilder.h>
 #include <AK/kmalloc.h>
 
 namespace AK::Detail {
 
-class StringData final : public RefCounted<StringData> {
+class StringData final {
+    AK_MAKE_NONCOPYABLE(StringData);
+    AK_MAKE_NONMOVABLE(StringData);
+
 public:
+    using AllowOwnPtr = FalseType;
+
     static ErrorOr<NonnullRefPtr<StringData>> create_uninitialized(size_t byte_count, u8*& buffer)
     {
         VERIFY(byte_count);
@@ -103,6 +110,46 @@ public:
         return m_hash;
     }
 
+    // Interned strings are reachable from every thread through the FlyString table, so their reference count has to be
+    // updated atomically. Any other string data is only ever used by one thread at a time and gets to skip that cost.
+    ALWAYS_INLINE void ref() const
+    {
+        if (m_is_fly_string) {
+            auto old_ref_count = m_ref_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+            VERIFY(old_ref_count > 0);
+            return;
+        }
+        auto ref_count = m_ref_count.load(AK::MemoryOrder::memory_order_relaxed);
+        VERIFY(ref_count > 0);
+        VERIFY(!Checked<u32>::addition_would_overflow(ref_count, 1));
+        m_ref_count.store(ref_count + 1, AK::MemoryOrder::memory_order_relaxed);
+    }
+
+    // Takes a reference unless the last one is already gone, which can happen to interned strings that another thread
+    // is about to remove from the FlyString table.
+    [[nodiscard]] bool try_ref() const
+    {
+        auto ref_count = m_ref_count.load(AK::MemoryOrder::memory_order_relaxed);
+        while (ref_count != 0) {
+            if (m_ref_count.compare_exchange_strong(ref_count, ref_count + 1, AK::MemoryOrder::memory_order_acquire))
+                return true;
+        }
+        return false;
+    }
+
+    ALWAYS_INLINE void unref() const
+    {
+        u32 new_ref_count;
+        if (m_is_fly_string) {
+            new_ref_count = m_ref_count.fetch_sub(1, AK::MemoryOrder::memory_order_acq_rel) - 1;
+        } else {
+            new_ref_count = m_ref_count.load(AK::MemoryOrder::memory_order_relaxed) - 1;
+            m_ref_count.store(new_ref_count, AK::MemoryOrder::memory_order_relaxed);
+        }
+        if (new_ref_count == 0)
+            delete this;
+    }
+
     bool is_fly_string() const { return m_is_fly_string; }
     void set_fly_string(bool is_fly_string) const { m_is_fly_string = is_fly_string; }
 
@@ -141,6 +188,7 @@ private:
         m_has_hash = true;
     }
 
+    mutable Atomic<u32> m_ref_count { 1 };
     u32 m_byte_count { 0 };
     u32 m_capacity { 0 };
 
@@ -66,6 +66,21 @@ FloatingPointExponentialForm inner_convert_floating_point_to_decimal_exponential
     i32 real_exponent = (exponent == 0 ? 1 : exponent) - Extractor::exponent_bias - Extractor::mantissa_bits;
     // abs(value) = real_mantissa * 2 ^ real_exponent
 
+    // Shortcut for integers that fit into the mantissa, which are very common. Neighbouring values are at most 1 apart
+    // there, so no shorter decimal representation rounds to the value, and removing trailing zeroes is all we have to do.
+    if (real_exponent <= 0 && real_exponent >= -static_cast<i32>(Extractor::mantissa_bits)) {
+        auto fractional_bits = real_mantissa & ((1ull << -real_exponent) - 1);
+        if (fractional_bits == 0) {
+            u64 fraction = real_mantissa >> -real_exponent;
+            i32 exponent10 = 0;
+            while (fraction % 10 == 0) {
+                fraction /= 10;
+                ++exponent10;
+            }
+            return { sign, fraction, exponent10 };
+        }
+    }
+
     // Step 2. Determine the interval of information-preserving outputs.
     // u, v, w are, respectively, lower bound for answer, exact value and upper bound for answer.
     i32 synthetic_exponent = real_exponent - 2;
@@ -141,6 +156,20 @@ FloatingPointExponentialForm inner_convert_floating_point_to_decimal_exponential
 
     int exponent10 = skipped_iters - max(-synthetic_exponent, 0);
 
+    // Remove two digits at a time while we can, this does the same as two iterations of the loop below.
+    // Only worth it for doubles, floats have too few digits to remove.
+    if constexpr (IsSame<FloatingPoint, double>) {
+        while (u / 100 < w / 100) {
+            all_a_zero &= u % 100 == 0;
+            all_b_zero &= last_digit == 0 && v % 10 == 0;
+            last_digit = v % 100 / 10;
+
+            u /= 100;
+            v /= 100;
+            w /= 100;
+            exponent10 += 2;
+        }
+    }
     while (u / 10 < w / 10) {
         all_a_zero &= u % 10 == 0;
         all_b_zero &= last_digit == 0;
@@ -25,6 +25,7 @@ class WebViewBridge;
 
 - (ErrorOr<void>)launchRequestServer;
 - (ErrorOr<void>)launchImageDecoder;
+- (void)launchSpareWebContentProcesses;
 - (ErrorOr<NonnullRefPtr<WebView::WebContentClient>>)launchWebContent:(Ladybird::WebViewBridge&)web_view_bridge;
 - (ErrorOr<IPC::File>)launchWebWorker;
 
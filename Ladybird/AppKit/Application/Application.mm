@@ -54,6 +54,8 @@ ApplicationBridge::ApplicationBridge(Badge<WebView::Application>, Main::Argument
 
     RefPtr<Requests::RequestClient> m_request_server_client;
     RefPtr<ImageDecoderClient::Client> m_image_decoder_client;
+
+    dispatch_source_t m_memory_pressure_source;
 }
 
 @end
@@ -66,6 +68,19 @@ ApplicationBridge::ApplicationBridge(Badge<WebView::Application>, Main::Argument
                   newTabPageURL:(URL::URL)new_tab_page_url
 {
     m_application_bridge = Ladybird::ApplicationBridge::create(arguments, move(new_tab_page_url));
+
+    __weak Application* weak_self = self;
+
+    m_memory_pressure_source = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0, DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL, dispatch_get_main_queue());
+    dispatch_source_set_event_handler(m_memory_pressure_source, ^{
+        Application* self = weak_self;
+        if (self == nil) {
+            return;
+        }
+
+        m_application_bridge->handle_memory_pressure();
+    });
+    dispatch_resume(m_memory_pressure_source);
 }
 
 - (ErrorOr<void>)launchRequestServer
@@ -117,8 +132,30 @@ static ErrorOr<NonnullRefPtr<ImageDecoderClient::Client>> launch_new_image_decod
     return {};
 }
 
+- (void)launchSpareWebContentProcesses
+{
+    __weak Application* weak_self = self;
+
+    m_application_bridge->set_spare_web_content_process_launcher([weak_self]() -> ErrorOr<NonnullRefPtr<WebView::WebContentClient>> {
+        Application* self = weak_self;
+        if (self == nil) {
+            return Error::from_string_literal("Application is gone");
+        }
+
+        auto request_server_socket = TRY(connect_new_request_server_client(*m_request_server_client));
+        auto image_decoder_socket = TRY(connect_new_image_decoder_client(*m_image_decoder_client));
+
+        auto web_content_paths = TRY(get_paths_for_helper_process("WebContent"sv));
+        return launch_spare_web_content_process(web_content_paths, move(image_decoder_socket), move(request_server_socket));
+    });
+}
+
 - (ErrorOr<NonnullRefPtr<WebView::WebContentClient>>)launchWebContent:(Ladybird::WebViewBridge&)web_view_bridge
 {
+    if (auto web_content = m_application_bridge->take_spare_web_content_process(web_view_bridge)) {
+        return web_content.release_nonnull();
+    }
+
     // FIXME: Fail to open the tab, rather than crashing the whole application if this fails
     auto request_server_socket = TRY(connect_new_request_server_client(*m_request_server_client));
     auto image_decoder_socket = TRY(connect_new_image_decoder_client(*m_image_decoder_client));
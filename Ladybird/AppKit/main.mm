@@ -87,6 +87,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     TRY([application launchImageDecoder]);
 
+    [application launchSpareWebContentProcesses];
+
     auto* delegate = [[ApplicationDelegate alloc] init];
     [NSApp setDelegate:delegate];
 
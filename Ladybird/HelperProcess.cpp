@@ -8,6 +8,7 @@
 #include "Utilities.h"
 #include <AK/Enumerate.h>
 #include <LibCore/Process.h>
+#include <LibCore/Tracing.h>
 #include <LibWebView/Application.h>
 
 template<typename ClientType, typename... ClientArguments>
@@ -31,6 +32,20 @@ static ErrorOr<NonnullRefPtr<ClientType>> launch_server_process(
     if (chrome_options.debug_helper_process == process_type)
         arguments.append("--wait-for-debugger"sv);
 
+    // The process records its trace events straight into a buffer that we keep a hold of.
+    Optional<Core::AnonymousBuffer> trace_buffer;
+    Optional<IPC::File> trace_buffer_file;
+    if (auto trace_categories = Core::Tracing::enabled_categories(); trace_categories != Core::Tracing::Category::None) {
+        trace_buffer = TRY(Core::Tracing::create_shared_buffer());
+        trace_buffer_file = TRY(IPC::File::clone_fd(trace_buffer->fd()));
+        TRY(trace_buffer_file->clear_close_on_exec());
+
+        arguments.append("--trace-buffer"sv);
+        arguments.append(ByteString::number(trace_buffer_file->fd()));
+        arguments.append("--trace-categories"sv);
+        arguments.append(Core::Tracing::category_names(trace_categories));
+    }
+
     for (auto [i, path] : enumerate(candidate_server_paths)) {
         Core::ProcessSpawnOptions options { .name = server_name, .arguments = arguments };
 
@@ -50,7 +65,10 @@ static ErrorOr<NonnullRefPtr<ClientType>> launch_server_process(
             if constexpr (requires { process.client->set_pid(pid_t {}); })
                 process.client->set_pid(process.process.pid());
 
-            WebView::Application::the().add_child_process(WebView::Process { process_type, process.client, move(process.process) });
+            WebView::Process child_process { process_type, process.client, move(process.process) };
+            if (trace_buffer.has_value())
+                child_process.set_trace_buffer(trace_buffer.release_value());
+            WebView::Application::the().add_child_process(move(child_process));
 
             if (chrome_options.profile_helper_process == process_type) {
                 dbgln();
@@ -71,11 +89,7 @@ static ErrorOr<NonnullRefPtr<ClientType>> launch_server_process(
     VERIFY_NOT_REACHED();
 }
 
-ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_process(
-    WebView::ViewImplementation& view,
-    ReadonlySpan<ByteString> candidate_web_content_paths,
-    IPC::File image_decoder_socket,
-    Optional<IPC::File> request_server_socket)
+static Vector<ByteString> web_content_process_arguments(IPC::File const& image_decoder_socket, Optional<IPC::File> const& request_server_socket)
 {
     auto const& web_content_options = WebView::Application::web_content_options();
 
@@ -106,6 +120,12 @@ ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_process(
         arguments.append("--force-cpu-painting"sv);
     if (web_content_options.force_fontconfig == WebView::ForceFontconfig::Yes)
         arguments.append("--force-fontconfig"sv);
+    if (web_content_options.log_display_list_optimizations == WebView::LogDisplayListOptimizations::Yes)
+        arguments.append("--log-display-list-optimizations"sv);
+    if (web_content_options.memory_budget_in_mib.has_value()) {
+        arguments.append("--memory-budget"sv);
+        arguments.append(ByteString::number(*web_content_options.memory_budget_in_mib));
+    }
     if (auto server = mach_server_name(); server.has_value()) {
         arguments.append("--mach-server-name"sv);
         arguments.append(server.value());
@@ -118,9 +138,28 @@ ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_process(
     arguments.append("--image-decoder-socket"sv);
     arguments.append(ByteString::number(image_decoder_socket.fd()));
 
+    return arguments;
+}
+
+ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_process(
+    WebView::ViewImplementation& view,
+    ReadonlySpan<ByteString> candidate_web_content_paths,
+    IPC::File image_decoder_socket,
+    Optional<IPC::File> request_server_socket)
+{
+    auto arguments = web_content_process_arguments(image_decoder_socket, request_server_socket);
     return launch_server_process<WebView::WebContentClient>("WebContent"sv, candidate_web_content_paths, move(arguments), view);
 }
 
+ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_spare_web_content_process(
+    ReadonlySpan<ByteString> candidate_web_content_paths,
+    IPC::File image_decoder_socket,
+    Optional<IPC::File> request_server_socket)
+{
+    auto arguments = web_content_process_arguments(image_decoder_socket, request_server_socket);
+    return launch_server_process<WebView::WebContentClient>("WebContent"sv, candidate_web_content_paths, move(arguments));
+}
+
 ErrorOr<NonnullRefPtr<ImageDecoderClient::Client>> launch_image_decoder_process(ReadonlySpan<ByteString> candidate_image_decoder_paths)
 {
     Vector<ByteString> arguments;
@@ -158,6 +197,9 @@ ErrorOr<NonnullRefPtr<Requests::RequestClient>> launch_request_server_process(Re
     for (auto const& certificate : WebView::Application::chrome_options().certificates)
         arguments.append(ByteString::formatted("--certificate={}", certificate));
 
+    if (WebView::Application::web_content_options().enable_http_cache == WebView::EnableHTTPCache::Yes)
+        arguments.append("--enable-http-cache"sv);
+
     if (auto server = mach_server_name(); server.has_value()) {
         arguments.append("--mach-server-name"sv);
         arguments.append(server.value());
@@ -31,7 +31,7 @@ void ImageCodecPlugin::set_client(NonnullRefPtr<ImageDecoderClient::Client> clie
 
 ImageCodecPlugin::~ImageCodecPlugin() = default;
 
-NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, bool is_high_priority)
 {
     auto promise = Core::Promise<Web::Platform::DecodedImage>::construct();
     if (on_resolved)
@@ -49,8 +49,11 @@ NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::deco
         [promise](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
             // FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
             Web::Platform::DecodedImage decoded_image;
+            decoded_image.image_id = result.image_id;
             decoded_image.is_animated = result.is_animated;
             decoded_image.loop_count = result.loop_count;
+            decoded_image.frame_count = result.frame_count;
+            decoded_image.natural_size = result.natural_size;
             for (auto& frame : result.frames) {
                 decoded_image.frames.empend(move(frame.bitmap), frame.duration);
             }
@@ -59,9 +62,34 @@ NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::deco
         },
         [promise](auto& error) {
             promise->reject(Error::copy(error));
-        });
+        },
+        ideal_size, {}, is_high_priority);
 
     return promise;
 }
 
+void ImageCodecPlugin::request_animation_frames(i64 image_id, size_t first_frame_index, size_t count, AnimationFramesCallback on_decoded)
+{
+    if (!m_client)
+        return;
+
+    m_client->request_animation_frames(image_id, first_frame_index, count, [on_decoded = move(on_decoded)](u32 first_frame_index, Vector<Optional<ImageDecoderClient::Frame>> result) {
+        Vector<Web::Platform::Frame> frames;
+        frames.ensure_capacity(result.size());
+        for (auto& frame : result) {
+            if (frame.has_value())
+                frames.unchecked_append({ move(frame->bitmap), frame->duration });
+            else
+                frames.unchecked_append({});
+        }
+        on_decoded(first_frame_index, move(frames));
+    });
+}
+
+void ImageCodecPlugin::release_animation(i64 image_id)
+{
+    if (m_client)
+        m_client->release_animation(image_id);
+}
+
 }
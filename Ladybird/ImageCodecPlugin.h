@@ -17,7 +17,9 @@ public:
     explicit ImageCodecPlugin(NonnullRefPtr<ImageDecoderClient::Client>);
     virtual ~ImageCodecPlugin() override;
 
-    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected) override;
+    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, bool is_high_priority = false) override;
+    virtual void request_animation_frames(i64 image_id, size_t first_frame_index, size_t count, AnimationFramesCallback on_decoded) override;
+    virtual void release_animation(i64 image_id) override;
 
     void set_client(NonnullRefPtr<ImageDecoderClient::Client>);
 
@@ -10,6 +10,7 @@
 #include <LibCore/ArgsParser.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Process.h>
+#include <LibCore/Tracing.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
 
@@ -24,14 +25,21 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     Core::ArgsParser args_parser;
     StringView mach_server_name;
     bool wait_for_debugger = false;
+    int trace_buffer { -1 };
+    StringView trace_categories;
 
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
     args_parser.add_option(wait_for_debugger, "Wait for debugger", "wait-for-debugger");
+    args_parser.add_option(trace_buffer, "File descriptor of the buffer to record trace events into", "trace-buffer", 0, "trace_buffer");
+    args_parser.add_option(trace_categories, "Trace categories to record", "trace-categories", 0, "categories");
     args_parser.parse(arguments);
 
     if (wait_for_debugger)
         Core::Process::wait_for_debugger_and_break();
 
+    if (trace_buffer != -1)
+        TRY(Core::Tracing::use_shared_buffer(trace_buffer, trace_categories));
+
     Core::EventLoop event_loop;
 
 #if defined(AK_OS_MACOS)
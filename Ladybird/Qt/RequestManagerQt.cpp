@@ -34,12 +34,12 @@ void RequestManagerQt::reply_finished(QNetworkReply* reply)
     request->did_finish();
 }
 
-RefPtr<Web::ResourceLoaderConnectorRequest> RequestManagerQt::start_request(ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ReadonlyBytes request_body, Core::ProxyData const& proxy)
+RefPtr<Web::ResourceLoaderConnectorRequest> RequestManagerQt::start_request(ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ReadonlyBytes request_body, Core::ProxyData const& proxy, RequestServer::RequestPriority priority, ByteString const&)
 {
     if (!url.scheme().bytes_as_string_view().is_one_of_ignoring_ascii_case("http"sv, "https"sv)) {
         return nullptr;
     }
-    auto request_or_error = Request::create(*m_qnam, method, url, request_headers, request_body, proxy);
+    auto request_or_error = Request::create(*m_qnam, method, url, request_headers, request_body, proxy, priority);
     if (request_or_error.is_error()) {
         return nullptr;
     }
@@ -48,9 +48,22 @@ RefPtr<Web::ResourceLoaderConnectorRequest> RequestManagerQt::start_request(Byte
     return request;
 }
 
-ErrorOr<NonnullRefPtr<RequestManagerQt::Request>> RequestManagerQt::Request::create(QNetworkAccessManager& qnam, ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ReadonlyBytes request_body, Core::ProxyData const&)
+ErrorOr<NonnullRefPtr<RequestManagerQt::Request>> RequestManagerQt::Request::create(QNetworkAccessManager& qnam, ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ReadonlyBytes request_body, Core::ProxyData const&, RequestServer::RequestPriority priority)
 {
     QNetworkRequest request { QString(url.to_byte_string().characters()) };
+    switch (priority) {
+    case RequestServer::RequestPriority::Highest:
+    case RequestServer::RequestPriority::High:
+        request.setPriority(QNetworkRequest::HighPriority);
+        break;
+    case RequestServer::RequestPriority::Medium:
+        request.setPriority(QNetworkRequest::NormalPriority);
+        break;
+    case RequestServer::RequestPriority::Low:
+    case RequestServer::RequestPriority::Lowest:
+        request.setPriority(QNetworkRequest::LowPriority);
+        break;
+    }
     request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::ManualRedirectPolicy);
     request.setAttribute(QNetworkRequest::CookieLoadControlAttribute, QNetworkRequest::Manual);
     request.setAttribute(QNetworkRequest::CookieSaveControlAttribute, QNetworkRequest::Manual);
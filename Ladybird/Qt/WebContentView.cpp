@@ -647,22 +647,26 @@ void WebContentView::initialize_client(WebView::ViewImplementation::CreateNewCli
     if (create_new_client == CreateNewClient::Yes) {
         m_client_state = {};
 
-        Optional<IPC::File> request_server_socket;
-        if (WebView::Application::web_content_options().use_lagom_networking == WebView::UseLagomNetworking::Yes) {
-            auto& protocol = static_cast<Ladybird::Application*>(QApplication::instance())->request_server_client;
+        if (auto spare_client = WebView::Application::the().take_spare_web_content_process(*this)) {
+            m_client_state.client = spare_client;
+        } else {
+            Optional<IPC::File> request_server_socket;
+            if (WebView::Application::web_content_options().use_lagom_networking == WebView::UseLagomNetworking::Yes) {
+                auto& protocol = static_cast<Ladybird::Application*>(QApplication::instance())->request_server_client;
 
-            // FIXME: Fail to open the tab, rather than crashing the whole application if this fails
-            auto socket = connect_new_request_server_client(*protocol).release_value_but_fixme_should_propagate_errors();
-            request_server_socket = AK::move(socket);
-        }
+                // FIXME: Fail to open the tab, rather than crashing the whole application if this fails
+                auto socket = connect_new_request_server_client(*protocol).release_value_but_fixme_should_propagate_errors();
+                request_server_socket = AK::move(socket);
+            }
 
-        auto image_decoder = static_cast<Ladybird::Application*>(QApplication::instance())->image_decoder_client();
-        auto image_decoder_socket = connect_new_image_decoder_client(*image_decoder).release_value_but_fixme_should_propagate_errors();
+            auto image_decoder = static_cast<Ladybird::Application*>(QApplication::instance())->image_decoder_client();
+            auto image_decoder_socket = connect_new_image_decoder_client(*image_decoder).release_value_but_fixme_should_propagate_errors();
 
-        auto candidate_web_content_paths = get_paths_for_helper_process("WebContent"sv).release_value_but_fixme_should_propagate_errors();
-        auto new_client = launch_web_content_process(*this, candidate_web_content_paths, AK::move(image_decoder_socket), AK::move(request_server_socket)).release_value_but_fixme_should_propagate_errors();
+            auto candidate_web_content_paths = get_paths_for_helper_process("WebContent"sv).release_value_but_fixme_should_propagate_errors();
+            auto new_client = launch_web_content_process(*this, candidate_web_content_paths, AK::move(image_decoder_socket), AK::move(request_server_socket)).release_value_but_fixme_should_propagate_errors();
 
-        m_client_state.client = new_client;
+            m_client_state.client = new_client;
+        }
     } else {
         m_client_state.client->register_view(m_client_state.page_index, *this);
     }
@@ -79,6 +79,11 @@ ByteString WebSocketQt::subprotocol_in_use()
     return m_websocket->subprotocol_in_use();
 }
 
+ByteString WebSocketQt::extensions_in_use()
+{
+    return m_websocket->extensions_in_use();
+}
+
 void WebSocketQt::send(ByteBuffer binary_or_text_message, bool is_text)
 {
     m_websocket->send(WebSocket::Message(binary_or_text_message, is_text));
@@ -22,6 +22,7 @@ public:
 
     virtual Web::WebSockets::WebSocket::ReadyState ready_state() override;
     virtual ByteString subprotocol_in_use() override;
+    virtual ByteString extensions_in_use() override;
     virtual void send(ByteBuffer binary_or_text_message, bool is_text) override;
     virtual void send(StringView message) override;
     virtual void close(u16 code, ByteString reason) override;
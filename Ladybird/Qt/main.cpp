@@ -122,6 +122,16 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     TRY(app->initialize_image_decoder());
 
+    app->set_spare_web_content_process_launcher([&app]() -> ErrorOr<NonnullRefPtr<WebView::WebContentClient>> {
+        Optional<IPC::File> request_server_socket;
+        if (app->web_content_options().use_lagom_networking == WebView::UseLagomNetworking::Yes)
+            request_server_socket = TRY(connect_new_request_server_client(*app->request_server_client));
+
+        auto image_decoder_socket = TRY(connect_new_image_decoder_client(*app->image_decoder_client()));
+        auto candidate_web_content_paths = TRY(get_paths_for_helper_process("WebContent"sv));
+        return launch_spare_web_content_process(candidate_web_content_paths, move(image_decoder_socket), move(request_server_socket));
+    });
+
     chrome_process.on_new_window = [&](auto const& urls) {
         app->new_window(urls);
     };
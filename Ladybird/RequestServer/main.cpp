@@ -11,12 +11,15 @@
 #include <LibCore/EventLoop.h>
 #include <LibCore/LocalServer.h>
 #include <LibCore/Process.h>
+#include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
+#include <LibCore/Tracing.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
 #include <LibTLS/Certificate.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/DiskCache.h>
 
 #if defined(AK_OS_MACOS)
 #    include <LibCore/Platform/ProcessStatisticsMach.h>
@@ -24,6 +27,7 @@
 
 namespace RequestServer {
 extern ByteString g_default_certificate_path;
+extern bool g_http3_enabled;
 }
 
 static ErrorOr<ByteString> find_certificates(StringView serenity_resource_root)
@@ -42,28 +46,44 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     Vector<ByteString> certificates;
     StringView mach_server_name;
     bool wait_for_debugger = false;
+    int trace_buffer { -1 };
+    StringView trace_categories;
+    bool enable_http_cache = false;
+    bool enable_http3 = false;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(certificates, "Path to a certificate file", "certificate", 'C', "certificate");
     args_parser.add_option(serenity_resource_root, "Absolute path to directory for serenity resources", "serenity-resource-root", 'r', "serenity-resource-root");
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
     args_parser.add_option(wait_for_debugger, "Wait for debugger", "wait-for-debugger");
+    args_parser.add_option(enable_http_cache, "Enable HTTP cache", "enable-http-cache");
+    args_parser.add_option(enable_http3, "Prefer HTTP/3 where the server supports it", "enable-http3");
+    args_parser.add_option(trace_buffer, "File descriptor of the buffer to record trace events into", "trace-buffer", 0, "trace_buffer");
+    args_parser.add_option(trace_categories, "Trace categories to record", "trace-categories", 0, "categories");
     args_parser.parse(arguments);
 
     if (wait_for_debugger)
         Core::Process::wait_for_debugger_and_break();
 
+    if (trace_buffer != -1)
+        TRY(Core::Tracing::use_shared_buffer(trace_buffer, trace_categories));
+
     // Ensure the certificates are read out here.
     if (certificates.is_empty())
         certificates.append(TRY(find_certificates(serenity_resource_root)));
     else
         RequestServer::g_default_certificate_path = certificates.first();
 
+    RequestServer::g_http3_enabled = enable_http3;
+
     DefaultRootCACertificates::set_default_certificate_paths(certificates.span());
     [[maybe_unused]] auto& certs = DefaultRootCACertificates::the();
 
     Core::EventLoop event_loop;
 
+    if (enable_http_cache)
+        RequestServer::DiskCache::initialize(ByteString::formatted("{}/Ladybird/Cache", Core::StandardPaths::user_data_directory()));
+
 #if defined(AK_OS_MACOS)
     if (!mach_server_name.is_empty())
         Core::Platform::register_with_mach_server(mach_server_name);
@@ -13,7 +13,11 @@
 #include <LibCore/LocalServer.h>
 #include <LibCore/Process.h>
 #include <LibCore/Resource.h>
+#include <LibCore/StandardPaths.h>
 #include <LibCore/SystemServerTakeover.h>
+#include <LibCore/Timer.h>
+#include <LibCore/Tracing.h>
+#include <LibGfx/Font/DecompressedFontCache.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibJS/Bytecode/Interpreter.h>
@@ -25,6 +29,7 @@
 #include <LibWeb/Loader/ContentFilter.h>
 #include <LibWeb/Loader/GeneratedPagesLoader.h>
 #include <LibWeb/Loader/ResourceLoader.h>
+#include <LibWeb/Painting/DisplayList.h>
 #include <LibWeb/PermissionsPolicy/AutoplayAllowlist.h>
 #include <LibWeb/Platform/AudioCodecPluginAgnostic.h>
 #include <LibWeb/Platform/EventLoopPluginSerenity.h>
@@ -102,11 +107,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool expose_internals_object = false;
     bool use_lagom_networking = false;
     bool wait_for_debugger = false;
+    int trace_buffer { -1 };
+    StringView trace_categories;
     bool log_all_js_exceptions = false;
     bool enable_idl_tracing = false;
     bool enable_http_cache = false;
     bool force_cpu_painting = false;
     bool force_fontconfig = false;
+    bool log_display_list_optimizations = false;
+    size_t memory_budget_in_mib = 0;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(command_line, "Chrome process command line", "command-line", 0, "command_line");
@@ -125,6 +134,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(enable_http_cache, "Enable HTTP cache", "enable-http-cache");
     args_parser.add_option(force_cpu_painting, "Force CPU painting", "force-cpu-painting");
     args_parser.add_option(force_fontconfig, "Force using fontconfig for font loading", "force-fontconfig");
+    args_parser.add_option(log_display_list_optimizations, "Log display list command counts before and after optimization", "log-display-list-optimizations");
+    args_parser.add_option(trace_buffer, "File descriptor of the buffer to record trace events into", "trace-buffer", 0, "trace_buffer");
+    args_parser.add_option(trace_categories, "Trace categories to record", "trace-categories", 0, "categories");
+    args_parser.add_option(memory_budget_in_mib, "Give back memory once more than this many MiB are in use", "memory-budget", 0, "MiB");
 
     args_parser.parse(arguments);
 
@@ -132,6 +145,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         Core::Process::wait_for_debugger_and_break();
     }
 
+    if (trace_buffer != -1)
+        TRY(Core::Tracing::use_shared_buffer(trace_buffer, trace_categories));
+
     if (force_fontconfig) {
         Gfx::FontDatabase::the().set_force_fontconfig(true);
     }
@@ -152,6 +168,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     if (enable_http_cache) {
         Web::Fetch::Fetching::g_http_cache_enabled = true;
+
+        // Every WebContent process shares this, so a web font is only decompressed once no matter which tab loads it.
+        Gfx::DecompressedFontCache::initialize(ByteString::formatted("{}/Ladybird/FontCache", Core::StandardPaths::user_data_directory()));
+    }
+
+    if (log_display_list_optimizations) {
+        Web::Painting::g_log_display_list_optimizations = true;
     }
 
 #if defined(AK_OS_MACOS)
@@ -206,6 +229,21 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             dbgln("Failed to reinitialize image decoder: {}", maybe_error.error());
     };
 
+    RefPtr<Core::Timer> memory_budget_timer;
+    if (memory_budget_in_mib != 0) {
+        // Memory that has been given back isn't always returned to the system, so only try again once we've grown
+        // since then. Otherwise we'd keep throwing away everything we just loaded again.
+        memory_budget_timer = Core::Timer::create_repeating(5000, [&, memory_budget = static_cast<size_t>(memory_budget_in_mib * MiB), resident_size_after_reclaim = size_t { 0 }]() mutable {
+            auto resident_size = Core::Process::resident_memory_size();
+            if (resident_size.is_error() || resident_size.value() <= max(memory_budget, resident_size_after_reclaim))
+                return;
+
+            webcontent_client->reclaim_memory();
+            resident_size_after_reclaim = Core::Process::resident_memory_size().value_or(resident_size.value());
+        });
+        memory_budget_timer->start();
+    }
+
     return event_loop.exec();
 }
 
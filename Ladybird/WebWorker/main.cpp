@@ -13,6 +13,7 @@
 #include <LibCore/Process.h>
 #include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
+#include <LibCore/Tracing.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
@@ -43,6 +44,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     Vector<ByteString> certificates;
     bool use_lagom_networking { false };
     bool wait_for_debugger = false;
+    int trace_buffer { -1 };
+    StringView trace_categories;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(request_server_socket, "File descriptor of the request server socket", "request-server-socket", 's', "request-server-socket");
@@ -50,11 +53,16 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(use_lagom_networking, "Enable Lagom servers for networking", "use-lagom-networking");
     args_parser.add_option(certificates, "Path to a certificate file", "certificate", 'C', "certificate");
     args_parser.add_option(wait_for_debugger, "Wait for debugger", "wait-for-debugger");
+    args_parser.add_option(trace_buffer, "File descriptor of the buffer to record trace events into", "trace-buffer", 0, "trace_buffer");
+    args_parser.add_option(trace_categories, "Trace categories to record", "trace-categories", 0, "categories");
     args_parser.parse(arguments);
 
     if (wait_for_debugger)
         Core::Process::wait_for_debugger_and_break();
 
+    if (trace_buffer != -1)
+        TRY(Core::Tracing::use_shared_buffer(trace_buffer, trace_categories));
+
 #if defined(HAVE_QT)
     QCoreApplication app(arguments.argc, arguments.argv);
     Core::EventLoopManager::install(*new Ladybird::EventLoopManagerQt);
@@ -37,6 +37,7 @@ set(LZW_DEBUG ON)
 set(MACH_PORT_DEBUG ON)
 set(MATROSKA_DEBUG ON)
 set(MATROSKA_TRACE_DEBUG ON)
+set(MEMORY_PRESSURE_DEBUG ON)
 set(NETWORKJOB_DEBUG ON)
 set(NT_DEBUG ON)
 set(OPENTYPE_GPOS_DEBUG ON)
@@ -53,6 +54,7 @@ set(SHARED_QUEUE_DEBUG ON)
 set(SPAM_DEBUG ON)
 set(STYLE_INVALIDATION_DEBUG ON)
 set(SYNTAX_HIGHLIGHTING_DEBUG ON)
+set(TASK_QUEUE_DEBUG ON)
 set(TEXTEDITOR_DEBUG ON)
 set(TIFF_DEBUG ON)
 set(TIME_ZONE_DEBUG ON)
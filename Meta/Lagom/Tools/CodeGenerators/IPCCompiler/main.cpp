@@ -42,6 +42,7 @@ static ByteString pascal_case(ByteString const& identifier)
 }
 
 struct Message {
+    Vector<ByteString> attributes;
     ByteString name;
     bool is_synchronous { false };
     Vector<Parameter> inputs;
@@ -141,6 +142,23 @@ Vector<Endpoint> parse(ByteBuffer const& file_contents)
         return parameter_type;
     };
 
+    auto parse_attributes = [&](Vector<ByteString>& storage) {
+        if (!lexer.consume_specific('['))
+            return;
+        for (;;) {
+            if (lexer.consume_specific(']')) {
+                consume_whitespace();
+                break;
+            }
+            if (lexer.consume_specific(',')) {
+                consume_whitespace();
+            }
+            auto attribute = lexer.consume_until([](char ch) { return ch == ']' || ch == ','; });
+            storage.append(attribute);
+            consume_whitespace();
+        }
+    };
+
     auto parse_parameter = [&](Vector<Parameter>& storage, StringView message_name) {
         for (auto parameter_index = 1;; ++parameter_index) {
             Parameter parameter;
@@ -151,20 +169,7 @@ Vector<Endpoint> parse(ByteBuffer const& file_contents)
             consume_whitespace();
             if (lexer.peek() == ')')
                 break;
-            if (lexer.consume_specific('[')) {
-                for (;;) {
-                    if (lexer.consume_specific(']')) {
-                        consume_whitespace();
-                        break;
-                    }
-                    if (lexer.consume_specific(',')) {
-                        consume_whitespace();
-                    }
-                    auto attribute = lexer.consume_until([](char ch) { return ch == ']' || ch == ','; });
-                    parameter.attributes.append(attribute);
-                    consume_whitespace();
-                }
-            }
+            parse_attributes(parameter.attributes);
             parameter.type = parse_parameter_type();
             if (parameter.type.ends_with(',') || parameter.type.ends_with(')')) {
                 warnln("Parameter {} of method: {} must be named", parameter_index, message_name);
@@ -197,6 +202,7 @@ Vector<Endpoint> parse(ByteBuffer const& file_contents)
     auto parse_message = [&] {
         Message message;
         consume_whitespace();
+        parse_attributes(message.attributes);
         message.name = lexer.consume_until([](char ch) { return isspace(ch) || ch == '('; });
         consume_whitespace();
         assert_specific('(');
@@ -223,6 +229,17 @@ Vector<Endpoint> parse(ByteBuffer const& file_contents)
 
         consume_whitespace();
 
+        if (message.attributes.contains_slow("Coalesce"sv)) {
+            if (message.is_synchronous) {
+                warnln("Synchronous message {} cannot be coalesced", message.name);
+                VERIFY_NOT_REACHED();
+            }
+            if (message.inputs.is_empty() || message.inputs.first().type != "u64") {
+                warnln("Coalesced message {} must take a u64 as its first parameter to coalesce by", message.name);
+                VERIFY_NOT_REACHED();
+            }
+        }
+
         endpoints.last().messages.append(move(message));
     };
 
@@ -328,7 +345,7 @@ ByteString constructor_for_message(ByteString const& name, Vector<Parameter> con
     return builder.to_byte_string();
 }
 
-void do_message(SourceGenerator message_generator, ByteString const& name, Vector<Parameter> const& parameters, ByteString const& response_type = {})
+void do_message(SourceGenerator message_generator, ByteString const& name, Vector<Parameter> const& parameters, ByteString const& response_type = {}, bool coalesce = false)
 {
     auto pascal_name = pascal_case(name);
     message_generator.set("message.name", name);
@@ -435,6 +452,12 @@ public:)~~~");
         return buffer;
     })~~~");
 
+    if (coalesce) {
+        message_generator.set("coalescing_key.name", parameters.first().name);
+        message_generator.appendln(R"~~~(
+    virtual Optional<u64> coalescing_key() const override { return m_@coalescing_key.name@; })~~~");
+    }
+
     for (auto const& parameter : parameters) {
         auto parameter_generator = message_generator.fork();
         parameter_generator.set("parameter.type", parameter.type);
@@ -584,7 +607,7 @@ void build_endpoint(SourceGenerator generator, Endpoint const& endpoint)
             response_name = message.response_name();
             do_message(generator.fork(), response_name, message.outputs);
         }
-        do_message(generator.fork(), message.name, message.inputs, response_name);
+        do_message(generator.fork(), message.name, message.inputs, response_name, message.attributes.contains_slow("Coalesce"sv));
     }
 
     generator.appendln(R"~~~(
@@ -2289,11 +2289,28 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@function.name:snakecase@)
         if (effective_overload_set.size() == 0)
             continue;
 
-        auto distinguishing_argument_index = 0u;
-        if (effective_overload_set.size() > 1)
-            distinguishing_argument_index = resolve_distinguishing_argument_index(interface, effective_overload_set, argument_count);
-
         function_generator.set("current_argument_count", ByteString::number(argument_count));
+
+        // NOTE: With only one overload to choose from, overload resolution can't fail and doesn't convert any arguments,
+        //       so we can skip building the overload set at runtime and call the overload directly.
+        if (effective_overload_set.size() == 1) {
+            function_generator.set("overload.callable_id", ByteString::number(effective_overload_set.first().callable_id));
+            if (is_constructor == IsConstructor::Yes) {
+                function_generator.append(R"~~~(
+    case @current_argument_count@:
+        return construct@overload.callable_id@(new_target);
+)~~~");
+            } else {
+                function_generator.append(R"~~~(
+    case @current_argument_count@:
+        return @function.name:snakecase@@overload.callable_id@(vm);
+)~~~");
+            }
+            continue;
+        }
+
+        auto distinguishing_argument_index = resolve_distinguishing_argument_index(interface, effective_overload_set, argument_count);
+
         function_generator.set("overload_count", ByteString::number(effective_overload_set.size()));
         function_generator.appendln(R"~~~(
     case @current_argument_count@: {
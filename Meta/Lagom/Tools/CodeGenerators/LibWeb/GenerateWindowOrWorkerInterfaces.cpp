@@ -131,7 +131,7 @@ void Intrinsics::create_web_namespace<@namespace_class@>(JS::Realm& realm)
 
         gen.append(R"~~~(
 template<>
-void Intrinsics::create_web_prototype_and_constructor<@prototype_class@>(JS::Realm& realm)
+void Intrinsics::create_web_prototype<@prototype_class@>(JS::Realm& realm)
 {
     auto& vm = realm.vm();
 
@@ -148,10 +148,17 @@ void Intrinsics::create_web_prototype_and_constructor<@prototype_class@>(JS::Rea
     auto prototype = heap().allocate<@prototype_class@>(realm, realm);
     m_prototypes.set("@interface_name@"_fly_string, prototype);
 
+    prototype->define_intrinsic_accessor(vm.names.constructor, JS::Attribute::Writable | JS::Attribute::Configurable, [](auto& realm) -> JS::Value { return &Bindings::ensure_web_constructor<@prototype_class@>(realm, "@interface_name@"_fly_string); });
+}
+
+template<>
+void Intrinsics::create_web_constructor<@prototype_class@>(JS::Realm& realm)
+{
+    auto& vm = realm.vm();
+
     auto constructor = heap().allocate<@constructor_class@>(realm, realm);
     m_constructors.set("@interface_name@"_fly_string, constructor);
 
-    prototype->define_direct_property(vm.names.constructor, constructor.ptr(), JS::Attribute::Writable | JS::Attribute::Configurable);
     constructor->define_direct_property(vm.names.name, JS::PrimitiveString::create(vm, "@interface_name@"_string), JS::Attribute::Configurable);
 )~~~");
 
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteString.h>
+#include <AK/FlatHashTable.h>
+#include <AK/HashTable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/QuickSort.h>
+#include <AK/Random.h>
+#include <AK/Vector.h>
+
+TEST_CASE(construct)
+{
+    using IntTable = FlatHashTable<int>;
+    EXPECT(IntTable().is_empty());
+    EXPECT_EQ(IntTable().size(), 0u);
+    EXPECT(IntTable().begin() == IntTable().end());
+}
+
+TEST_CASE(basic_move)
+{
+    FlatHashTable<int> foo;
+    foo.set(1);
+    EXPECT_EQ(foo.size(), 1u);
+    auto bar = move(foo);
+    EXPECT_EQ(bar.size(), 1u);
+    EXPECT_EQ(foo.size(), 0u);
+    foo = move(bar);
+    EXPECT_EQ(bar.size(), 0u);
+    EXPECT_EQ(foo.size(), 1u);
+}
+
+TEST_CASE(copy)
+{
+    FlatHashTable<ByteString> strings;
+    strings.set("One");
+    strings.set("Two");
+
+    auto copy = strings;
+    strings.remove("One");
+    EXPECT_EQ(copy.size(), 2u);
+    EXPECT(copy.contains("One"));
+    EXPECT(copy.contains("Two"));
+}
+
+TEST_CASE(populate)
+{
+    FlatHashTable<ByteString> strings;
+    strings.set("One");
+    strings.set("Two");
+    strings.set("Three");
+
+    EXPECT_EQ(strings.is_empty(), false);
+    EXPECT_EQ(strings.size(), 3u);
+}
+
+TEST_CASE(range_loop)
+{
+    FlatHashTable<ByteString> strings;
+    EXPECT_EQ(strings.set("One"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.set("Two"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.set("Three"), AK::HashSetResult::InsertedNewEntry);
+
+    int loop_counter = 0;
+    for (auto& it : strings) {
+        EXPECT_EQ(it.is_empty(), false);
+        ++loop_counter;
+    }
+    EXPECT_EQ(loop_counter, 3);
+}
+
+TEST_CASE(existing_entry_behavior)
+{
+    FlatHashTable<ByteString, CaseInsensitiveStringTraits> strings;
+    EXPECT_EQ(strings.set("nickserv"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.set("NickServ", AK::HashSetExistingEntryBehavior::Keep), AK::HashSetResult::KeptExistingEntry);
+    EXPECT_EQ(*strings.begin(), "nickserv");
+    EXPECT_EQ(strings.set("NickServ"), AK::HashSetResult::ReplacedExistingEntry);
+    EXPECT_EQ(*strings.begin(), "NickServ");
+    EXPECT_EQ(strings.size(), 1u);
+}
+
+TEST_CASE(remove_all_matching)
+{
+    FlatHashTable<int> ints;
+
+    ints.set(1);
+    ints.set(2);
+    ints.set(3);
+    ints.set(4);
+
+    EXPECT_EQ(ints.size(), 4u);
+
+    EXPECT_EQ(ints.remove_all_matching([&](int value) { return value > 2; }), true);
+    EXPECT_EQ(ints.remove_all_matching([&](int) { return false; }), false);
+
+    EXPECT_EQ(ints.size(), 2u);
+
+    EXPECT(ints.contains(1));
+    EXPECT(ints.contains(2));
+
+    EXPECT_EQ(ints.remove_all_matching([&](int) { return true; }), true);
+
+    EXPECT(ints.is_empty());
+
+    EXPECT_EQ(ints.remove_all_matching([&](int) { return true; }), false);
+}
+
+TEST_CASE(many_strings)
+{
+    FlatHashTable<ByteString> strings;
+    for (int i = 0; i < 999; ++i) {
+        EXPECT_EQ(strings.set(ByteString::number(i)), AK::HashSetResult::InsertedNewEntry);
+    }
+    EXPECT_EQ(strings.size(), 999u);
+    for (int i = 0; i < 999; ++i) {
+        EXPECT(strings.contains(ByteString::number(i)));
+    }
+    for (int i = 0; i < 999; ++i) {
+        EXPECT_EQ(strings.remove(ByteString::number(i)), true);
+    }
+    EXPECT_EQ(strings.is_empty(), true);
+}
+
+TEST_CASE(many_collisions)
+{
+    struct StringCollisionTraits : public DefaultTraits<ByteString> {
+        static unsigned hash(ByteString const&) { return 0; }
+    };
+
+    FlatHashTable<ByteString, StringCollisionTraits> strings;
+    for (int i = 0; i < 999; ++i) {
+        EXPECT_EQ(strings.set(ByteString::number(i)), AK::HashSetResult::InsertedNewEntry);
+    }
+
+    EXPECT_EQ(strings.set("foo"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(strings.size(), 1000u);
+
+    for (int i = 0; i < 999; ++i) {
+        EXPECT_EQ(strings.remove(ByteString::number(i)), true);
+    }
+
+    EXPECT(strings.find("foo") != strings.end());
+}
+
+TEST_CASE(space_reuse)
+{
+    struct StringCollisionTraits : public DefaultTraits<ByteString> {
+        static unsigned hash(ByteString const&) { return 0; }
+    };
+
+    FlatHashTable<ByteString, StringCollisionTraits> strings;
+
+    // Add a few items to allow it to do initial resizing.
+    EXPECT_EQ(strings.set("0"), AK::HashSetResult::InsertedNewEntry);
+    for (int i = 1; i < 5; ++i) {
+        EXPECT_EQ(strings.set(ByteString::number(i)), AK::HashSetResult::InsertedNewEntry);
+        EXPECT_EQ(strings.remove(ByteString::number(i - 1)), true);
+    }
+
+    auto capacity = strings.capacity();
+
+    for (int i = 5; i < 999; ++i) {
+        EXPECT_EQ(strings.set(ByteString::number(i)), AK::HashSetResult::InsertedNewEntry);
+        EXPECT_EQ(strings.remove(ByteString::number(i - 1)), true);
+    }
+
+    EXPECT_EQ(strings.capacity(), capacity);
+}
+
+TEST_CASE(capacity_leak)
+{
+    FlatHashTable<int> table;
+    for (size_t i = 0; i < 10000; ++i) {
+        table.set(i);
+        table.remove(i);
+    }
+    EXPECT(table.capacity() < 100u);
+}
+
+TEST_CASE(ensure_capacity)
+{
+    FlatHashTable<int> table;
+    table.ensure_capacity(1000);
+    auto capacity = table.capacity();
+    for (int i = 0; i < 1000; ++i)
+        table.set(i);
+    EXPECT_EQ(table.capacity(), capacity);
+    EXPECT_EQ(table.size(), 1000u);
+}
+
+TEST_CASE(non_trivial_type_table)
+{
+    FlatHashTable<NonnullOwnPtr<int>> table;
+
+    table.set(make<int>(3));
+    table.set(make<int>(11));
+
+    for (int i = 0; i < 1'000; ++i) {
+        table.set(make<int>(-i));
+    }
+    for (int i = 0; i < 10'000; ++i) {
+        table.set(make<int>(i));
+        table.remove(make<int>(i));
+    }
+
+    EXPECT_EQ(table.remove_all_matching([&](auto&) { return true; }), true);
+    EXPECT(table.is_empty());
+    EXPECT_EQ(table.remove_all_matching([&](auto&) { return true; }), false);
+}
+
+TEST_CASE(clear_with_capacity)
+{
+    FlatHashTable<ByteString> table;
+    table.clear_with_capacity();
+    for (int i = 0; i < 100; ++i)
+        table.set(ByteString::number(i));
+
+    auto capacity = table.capacity();
+    table.clear_with_capacity();
+    EXPECT(table.is_empty());
+    EXPECT_EQ(table.capacity(), capacity);
+    EXPECT(!table.contains("1"));
+
+    table.set("1");
+    EXPECT(table.contains("1"));
+}
+
+TEST_CASE(iterator_removal)
+{
+    FlatHashTable<int> map;
+    map.set(0);
+    map.set(1);
+
+    auto it = map.begin();
+    map.remove(it);
+    EXPECT_EQ(it, map.end());
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST_CASE(behaves_like_hash_table)
+{
+    HashTable<u32> expected;
+    FlatHashTable<u32> table;
+
+    for (size_t i = 0; i < 100'000; ++i) {
+        // Keep the values in a small range so that we remove and re-add the same ones a lot.
+        auto value = get_random_uniform(5'000);
+        if (get_random_uniform(3) == 0) {
+            EXPECT_EQ(table.remove(value), expected.remove(value));
+        } else {
+            EXPECT_EQ(table.set(value), expected.set(value));
+        }
+        EXPECT_EQ(table.size(), expected.size());
+    }
+
+    for (u32 value = 0; value < 5'000; ++value)
+        EXPECT_EQ(table.contains(value), expected.contains(value));
+
+    size_t iterated_count = 0;
+    for (auto value : table) {
+        EXPECT(expected.contains(value));
+        ++iterated_count;
+    }
+    EXPECT_EQ(iterated_count, expected.size());
+}
+
+TEST_CASE(values)
+{
+    FlatHashTable<int> table;
+    table.set(10);
+    table.set(30);
+    table.set(20);
+    auto values = table.values();
+    quick_sort(values);
+    EXPECT_EQ(values, (Vector<int> { 10, 20, 30 }));
+}
+
+template<typename TableType>
+static void benchmark_integer_lookups()
+{
+    static constexpr u32 value_count = 100'000;
+
+    TableType table;
+    for (u32 i = 0; i < value_count; ++i)
+        table.set(i * 7);
+
+    size_t found_count = 0;
+    for (size_t round = 0; round < 20; ++round) {
+        for (u32 i = 0; i < value_count; ++i) {
+            // Every other lookup misses.
+            if (table.contains(i * 7 + (i & 1)))
+                ++found_count;
+        }
+    }
+    EXPECT_EQ(found_count, 20 * value_count / 2);
+}
+
+BENCHMARK_CASE(integer_lookups_hash_table)
+{
+    benchmark_integer_lookups<HashTable<u32>>();
+}
+
+BENCHMARK_CASE(integer_lookups_flat_hash_table)
+{
+    benchmark_integer_lookups<FlatHashTable<u32>>();
+}
+
+template<typename TableType>
+static void benchmark_string_lookups()
+{
+    static constexpr size_t value_count = 20'000;
+
+    Vector<ByteString> strings;
+    for (size_t i = 0; i < value_count; ++i)
+        strings.append(ByteString::formatted("class-name-{}", i));
+
+    TableType table;
+    for (size_t i = 0; i < value_count; i += 2)
+        table.set(strings[i]);
+
+    size_t found_count = 0;
+    for (size_t round = 0; round < 20; ++round) {
+        for (auto const& string : strings) {
+            if (table.contains(string))
+                ++found_count;
+        }
+    }
+    EXPECT_EQ(found_count, 20 * value_count / 2);
+}
+
+BENCHMARK_CASE(string_lookups_hash_table)
+{
+    benchmark_string_lookups<HashTable<ByteString>>();
+}
+
+BENCHMARK_CASE(string_lookups_flat_hash_table)
+{
+    benchmark_string_lookups<FlatHashTable<ByteString>>();
+}
+
+template<typename TableType>
+static void benchmark_insertion_and_removal()
+{
+    static constexpr u32 value_count = 100'000;
+
+    for (size_t round = 0; round < 5; ++round) {
+        TableType table;
+        for (u32 i = 0; i < value_count; ++i)
+            table.set(i);
+        for (u32 i = 0; i < value_count; i += 2)
+            table.remove(i);
+        for (u32 i = 0; i < value_count; ++i)
+            table.set(i);
+        EXPECT_EQ(table.size(), value_count);
+    }
+}
+
+BENCHMARK_CASE(insertion_and_removal_hash_table)
+{
+    benchmark_insertion_and_removal<HashTable<u32>>();
+}
+
+BENCHMARK_CASE(insertion_and_removal_flat_hash_table)
+{
+    benchmark_insertion_and_removal<FlatHashTable<u32>>();
+}
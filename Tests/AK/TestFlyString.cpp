@@ -9,6 +9,8 @@
 #include <AK/FlyString.h>
 #include <AK/String.h>
 #include <AK/Try.h>
+#include <AK/Vector.h>
+#include <pthread.h>
 
 TEST_CASE(empty_string)
 {
@@ -134,3 +136,46 @@ TEST_CASE(is_one_of)
     EXPECT(bar.is_one_of("bar"sv, "foo"sv));
     EXPECT(bar.is_one_of("bar"sv));
 }
+
+TEST_CASE(interning_from_several_threads)
+{
+    static constexpr size_t thread_count = 8;
+    static constexpr size_t name_count = 256;
+
+    Vector<String> names;
+    for (size_t i = 0; i < name_count; ++i)
+        names.append(MUST(String::formatted("an-attribute-name-that-is-long-{}", i)));
+
+    auto intern_names = [](void* argument) -> void* {
+        auto const& names = *static_cast<Vector<String> const*>(argument);
+        for (size_t round = 0; round < 200; ++round) {
+            Vector<FlyString> kept;
+            for (size_t i = 0; i < name_count; ++i) {
+                auto const& name = names[(round * 7 + i * 13) % name_count];
+                auto fly = MUST(FlyString::from_utf8(name.bytes_as_string_view()));
+                VERIFY(fly == name.bytes_as_string_view());
+                VERIFY(fly == MUST(FlyString::from_utf8(name.bytes_as_string_view())));
+                if (i % 2)
+                    kept.append(move(fly));
+            }
+        }
+        return nullptr;
+    };
+
+    // Every thread needs its own copies, since only interned strings may be shared between threads.
+    Vector<Vector<String>> names_per_thread;
+    for (size_t i = 0; i < thread_count; ++i) {
+        Vector<String> copies;
+        for (auto const& name : names)
+            copies.append(MUST(String::from_utf8(name.bytes_as_string_view())));
+        names_per_thread.append(move(copies));
+    }
+
+    pthread_t threads[thread_count];
+    for (size_t i = 0; i < thread_count; ++i)
+        EXPECT_EQ(pthread_create(&threads[i], nullptr, intern_names, &names_per_thread[i]), 0);
+    for (auto thread : threads)
+        EXPECT_EQ(pthread_join(thread, nullptr), 0);
+
+    EXPECT_EQ(FlyString::number_of_fly_strings(), 0u);
+}
@@ -7,6 +7,8 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/ByteString.h>
+#include <AK/FlyString.h>
+#include <AK/String.h>
 #include <AK/StringBuilder.h>
 #include <AK/Vector.h>
 #include <math.h>
@@ -80,6 +82,14 @@ TEST_CASE(string_builder)
     EXPECT_EQ(builder.to_byte_string(), " 42  21 ");
 }
 
+TEST_CASE(plain_replacement_fields)
+{
+    EXPECT_EQ(ByteString::formatted("{}-{}-{}-{}", "foo"sv, "bar"_string, "baz"_fly_string, ByteString("qux")), "foo-bar-baz-qux");
+    EXPECT_EQ(ByteString::formatted("{}{}{}{}", static_cast<u8>(200), static_cast<i8>(-100), static_cast<u16>(65535), NumericLimits<i64>::min()), "200-10065535-9223372036854775808");
+    EXPECT_EQ(ByteString::formatted("{}{}{}", 'x', true, L'y'), "xtruey");
+    EXPECT_EQ(ByteString::formatted("{{{}}}{{}}", 1), "{1}{}");
+}
+
 TEST_CASE(format_without_arguments)
 {
     EXPECT_EQ(ByteString::formatted("foo"), "foo");
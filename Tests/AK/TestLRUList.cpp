@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/LRUList.h>
+
+TEST_CASE(construct)
+{
+    LRUList<int> list;
+    EXPECT(list.is_empty());
+    EXPECT_EQ(list.size(), 0u);
+    EXPECT_EQ(list.find_if([](int) { return true; }), nullptr);
+}
+
+TEST_CASE(evicts_least_recently_added_entry)
+{
+    LRUList<int> list;
+    list.add(1);
+    list.add(2);
+    list.add(3);
+    EXPECT_EQ(list.size(), 3u);
+
+    EXPECT_EQ(list.take_least_recently_used(), 1);
+    EXPECT_EQ(list.take_least_recently_used(), 2);
+    EXPECT_EQ(list.take_least_recently_used(), 3);
+    EXPECT(list.is_empty());
+}
+
+TEST_CASE(find_if_marks_entry_as_used)
+{
+    LRUList<int> list;
+    list.add(1);
+    list.add(2);
+    list.add(3);
+
+    auto* entry = list.find_if([](int value) { return value == 1; });
+    VERIFY(entry);
+    EXPECT_EQ(*entry, 1);
+
+    EXPECT_EQ(list.take_least_recently_used(), 2);
+    EXPECT_EQ(list.take_least_recently_used(), 3);
+    EXPECT_EQ(list.take_least_recently_used(), 1);
+}
+
+TEST_CASE(contains_if_does_not_mark_entry_as_used)
+{
+    LRUList<int> list;
+    list.add(1);
+    list.add(2);
+
+    EXPECT(list.contains_if([](int value) { return value == 1; }));
+    EXPECT(!list.contains_if([](int value) { return value == 3; }));
+    EXPECT_EQ(list.take_least_recently_used(), 1);
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Atomic.h>
+#include <AK/MPSCQueue.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+#include <pthread.h>
+
+TEST_CASE(construct)
+{
+    MPSCQueue<int> queue;
+    EXPECT(queue.is_empty());
+    EXPECT(queue.take_all().is_empty());
+}
+
+TEST_CASE(take_all_keeps_push_order)
+{
+    MPSCQueue<int> queue;
+    for (int i = 0; i < 10; ++i)
+        queue.push(i);
+    EXPECT(!queue.is_empty());
+
+    auto batch = queue.take_all();
+    EXPECT(queue.is_empty());
+
+    queue.push(10);
+
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(batch.take_first(), i);
+    EXPECT(batch.is_empty());
+
+    batch = queue.take_all();
+    EXPECT_EQ(batch.take_first(), 10);
+    EXPECT(batch.is_empty());
+}
+
+TEST_CASE(push_all_hands_over_a_batch)
+{
+    MPSCQueue<int> queue;
+    MPSCQueue<int> other_queue;
+    for (int i = 0; i < 5; ++i)
+        queue.push(i);
+
+    auto batch = queue.take_all();
+    int sum = 0;
+    batch.for_each([&](int& value) {
+        sum += value;
+        value *= 10;
+    });
+    EXPECT_EQ(sum, 10);
+    EXPECT(!batch.is_empty());
+
+    other_queue.push(-1);
+    other_queue.push_all(move(batch));
+    other_queue.push(50);
+    EXPECT(batch.is_empty());
+
+    batch = other_queue.take_all();
+    for (int expected : { -1, 0, 10, 20, 30, 40, 50 })
+        EXPECT_EQ(batch.take_first(), expected);
+    EXPECT(batch.is_empty());
+
+    other_queue.push_all(MPSCQueue<int>::Batch {});
+    EXPECT(other_queue.is_empty());
+}
+
+TEST_CASE(destroys_values_left_behind)
+{
+    struct Counted {
+        explicit Counted(int& count)
+            : count(count)
+        {
+            ++count;
+        }
+        ~Counted() { --count; }
+        int& count;
+    };
+
+    int count = 0;
+    {
+        MPSCQueue<NonnullOwnPtr<Counted>> queue;
+        for (int i = 0; i < 5; ++i)
+            queue.push(make<Counted>(count));
+
+        auto batch = queue.take_all();
+        (void)batch.take_first();
+        EXPECT_EQ(count, 4);
+
+        queue.push(make<Counted>(count));
+        EXPECT_EQ(count, 5);
+    }
+    EXPECT_EQ(count, 0);
+}
+
+TEST_CASE(push_from_several_threads)
+{
+    static constexpr size_t thread_count = 8;
+    static constexpr size_t values_per_thread = 20'000;
+
+    struct Context {
+        MPSCQueue<size_t> queue;
+        Atomic<size_t> finished_thread_count { 0 };
+    } context;
+
+    struct ThreadArgument {
+        Context* context;
+        size_t thread_index;
+    };
+
+    auto push_values = [](void* argument) -> void* {
+        auto [context, thread_index] = *static_cast<ThreadArgument*>(argument);
+        for (size_t i = 0; i < values_per_thread; ++i)
+            context->queue.push(thread_index * values_per_thread + i);
+        ++context->finished_thread_count;
+        return nullptr;
+    };
+
+    ThreadArgument arguments[thread_count];
+    pthread_t threads[thread_count];
+    for (size_t i = 0; i < thread_count; ++i) {
+        arguments[i] = { &context, i };
+        EXPECT_EQ(pthread_create(&threads[i], nullptr, push_values, &arguments[i]), 0);
+    }
+
+    // Values from any one thread have to come out in the order that thread pushed them.
+    Vector<size_t> next_value_per_thread;
+    next_value_per_thread.resize(thread_count);
+    size_t taken_count = 0;
+
+    auto take_pushed_values = [&] {
+        auto batch = context.queue.take_all();
+        while (!batch.is_empty()) {
+            auto value = batch.take_first();
+            auto thread_index = value / values_per_thread;
+            EXPECT_EQ(value % values_per_thread, next_value_per_thread[thread_index]);
+            ++next_value_per_thread[thread_index];
+            ++taken_count;
+        }
+    };
+
+    while (context.finished_thread_count.load() < thread_count)
+        take_pushed_values();
+    take_pushed_values();
+
+    for (auto thread : threads)
+        EXPECT_EQ(pthread_join(thread, nullptr), 0);
+
+    EXPECT_EQ(taken_count, thread_count * values_per_thread);
+    EXPECT(context.queue.is_empty());
+}
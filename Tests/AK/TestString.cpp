@@ -192,6 +192,19 @@ TEST_CASE(with_replacement_character)
     EXPECT_EQ(string6, "\xEF\xBB\xBFWHF!"sv);
 }
 
+TEST_CASE(from_latin1)
+{
+    auto string1 = MUST(String::from_latin1("Well, hello friends!"sv.bytes()));
+    EXPECT_EQ(string1, "Well, hello friends!"sv);
+
+    Array<u8, 6> latin1 { 'c', 'a', 'f', 0xe9, 0x80, 0xff };
+    auto string2 = MUST(String::from_latin1(latin1));
+    EXPECT_EQ(string2, "café\u0080ÿ"sv);
+
+    auto string3 = MUST(String::from_latin1({}));
+    EXPECT(string3.is_empty());
+}
+
 TEST_CASE(from_code_points)
 {
     for (u32 code_point = 0; code_point < 0x80; ++code_point) {
@@ -54,6 +54,17 @@ TEST_CASE(double_conversion)
     DOES_CONVERT_DOUBLE_TO(bit_cast<double>(0xc3c04222300db8acULL), 1, 23430728857074627, 2);
 }
 
+TEST_CASE(double_integer_conversion)
+{
+    DOES_CONVERT_DOUBLE_TO(42, 0, 42, 0);
+    DOES_CONVERT_DOUBLE_TO(-1200, 1, 12, 2);
+    DOES_CONVERT_DOUBLE_TO(1e15, 0, 1, 15);
+    DOES_CONVERT_DOUBLE_TO(9007199254740991, 0, 9007199254740991, 0);
+    DOES_CONVERT_DOUBLE_TO(9007199254740992, 0, 9007199254740992, 0);
+    DOES_CONVERT_DOUBLE_TO(4503599627370497, 0, 4503599627370497, 0);
+    DOES_CONVERT_DOUBLE_TO(4503599627370495.5, 0, 45035996273704955, -1);
+}
+
 #define DOES_CONVERT_FLOAT_TO(value, sign, fraction, exponent)                             \
     do {                                                                                   \
         EXPECT_EQ(                                                                         \
@@ -76,3 +87,19 @@ TEST_CASE(float_conversion)
     DOES_CONVERT_FLOAT_TO(11754944e-45, 0, 11754944, -45);
     DOES_CONVERT_FLOAT_TO(-11754944e-45, 1, 11754944, -45);
 }
+
+BENCHMARK_CASE(double_conversion_of_integers)
+{
+    u64 checksum = 0;
+    for (u32 i = 0; i < 10'000'000; ++i)
+        checksum += convert_floating_point_to_decimal_exponential_form(static_cast<double>(i)).fraction;
+    EXPECT(checksum != 0);
+}
+
+BENCHMARK_CASE(double_conversion_of_decimals)
+{
+    u64 checksum = 0;
+    for (u32 i = 0; i < 10'000'000; ++i)
+        checksum += convert_floating_point_to_decimal_exponential_form(static_cast<double>(i) / 100).fraction;
+    EXPECT(checksum != 0);
+}
@@ -162,3 +162,26 @@ TEST_CASE(brotli_decompress_zero_one_bin)
     EXPECT(bytes_read == 32 * MiB);
     EXPECT(brotli_stream.is_eof());
 }
+
+static void run_decompression_benchmark(StringView const file_name)
+{
+    ByteString path = ByteString::formatted("brotli-test-files/{}", file_name);
+    auto file = MUST(Core::File::open(path, Core::File::OpenMode::Read));
+    auto compressed_data = MUST(file->read_until_eof());
+
+    for (size_t i = 0; i < 100; ++i) {
+        auto brotli_stream = Compress::BrotliDecompressionStream { MaybeOwned<Stream> { make<FixedMemoryStream>(compressed_data.bytes()) } };
+        auto data = MUST(brotli_stream.read_until_eof());
+        EXPECT(!data.is_empty());
+    }
+}
+
+BENCHMARK_CASE(brotli_decompress_html)
+{
+    run_decompression_benchmark("happy3rd.html.br"sv);
+}
+
+BENCHMARK_CASE(brotli_decompress_font)
+{
+    run_decompression_benchmark("KaticaRegular10.font.br"sv);
+}
@@ -122,6 +122,21 @@ TEST_CASE(deflate_decompress_zeroes)
     EXPECT(uncompressed == decompressed.value().bytes());
 }
 
+TEST_CASE(deflate_decompress_final_code_at_end_of_input)
+{
+    // The end-of-block code takes up exactly the last 7 bits of the input, which is less than a full table lookup.
+    Array<u8, 8> const compressed {
+        0x9b, 0x30, 0x71, 0xd2, 0xe4, 0x29, 0x53, 0x01
+    };
+
+    Array<u8, 6> const uncompressed {
+        0x90, 0x91, 0x92, 0x93, 0x94, 0x95
+    };
+
+    auto const decompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(decompressed.bytes() == uncompressed.span());
+}
+
 TEST_CASE(deflate_round_trip_store)
 {
     auto original = ByteBuffer::create_uninitialized(1024).release_value();
@@ -152,6 +167,21 @@ TEST_CASE(deflate_round_trip_compress_large)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(deflate_round_trip_compress_in_parallel)
+{
+    // Repeat a random pattern so that there are back references reaching across chunk boundaries
+    auto size = Compress::DeflateCompressor::parallel_chunk_size * 4 + 1234;
+    auto original = ByteBuffer::create_uninitialized(size).release_value();
+    fill_with_random(original.bytes().trim(10000));
+    for (size_t i = 10000; i < size; ++i)
+        original[i] = original[i - 10000];
+
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all_in_parallel(original, Compress::DeflateCompressor::CompressionLevel::FAST, 3));
+    EXPECT(compressed.size() < original.size());
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
 TEST_CASE(deflate_compress_literals)
 {
     // This byte array is known to not produce any back references with our lz77 implementation even at the highest compression settings
@@ -31,3 +31,21 @@ TEST_CASE(roundtrip_lzw_little_endian_long)
     constexpr auto input = "WellWellWellWellaqwertyuiop[]sdfghjkl;'zxcvbnm,./uipnaspchu9epqrjepncdp9ruew-r8thvnufsipdonvjcx zvlrz[iu0q-348urfjsd;fjmvxc.nnnmvcxzvmc c,m;l'/,l4532[5i904tmorew;lgkrmopds['kg,l;'s,gWellWellWellWellaqwertyuiop[]sdfghjkl;'zxcvbnm,./uipnaspchu9epqrjepncdp9ruew-r8thvnufsipdonvjcx zvlrz[iu0q-348urfjsd;fjmvxc.nnnmvcxzvmc c,m;l'/,l4532[5i904tmorew;lgkrmopds['kg,l;'s,gWellWellWellWellaqwertyuiop[]sdfghjkl;'zxcvbnm,./uipnaspchu9epqrjepncdp9ruew-r8thvnufsipdonvjcx zvlrz[iu0q-348urfjsd;fjmvxc.nnnmvcxzvmc c,m;l'/,l4532[5i904tmorew;lgkrmopds['kg,l;'s,gWellWellWellWellaqwertyuiop[]sdfghjkl;'zxcvbnm,./uipnaspchu9epqrjepncdp9ruew-r8thvnufsipdonvjcx zvlrz[iu0q-348urfjsd;fjmvxc.nnnmvcxzvmc c,m;l'/,l4532[5i904tmorew;lgkrmopds['kg,l;'s,g"sv;
     EXPECT(TRY_OR_FAIL(test_roundtrip_string(input)));
 }
+
+TEST_CASE(decompress_lzw_in_small_chunks)
+{
+    // Strings that don't fit into the output buffer have to be continued in the next one.
+    constexpr auto input = "WellWellWellWellWellWellWellWellWellWellWellWellWellWellWellWellWellWellWellWellWellWell"sv;
+    auto const compressed = TRY_OR_FAIL(Compress::LzwCompressor::compress_all(input.bytes(), 8));
+
+    auto memory_stream = make<FixedMemoryStream>(compressed);
+    auto lzw_stream = make<LittleEndianInputBitStream>(MaybeOwned<Stream>(move(memory_stream)));
+    Compress::LzwDecompressor<LittleEndianInputBitStream> decompressor { MaybeOwned<LittleEndianInputBitStream> { move(lzw_stream) }, 8 };
+
+    ByteBuffer decompressed;
+    Array<u8, 3> buffer;
+    while (!decompressor.has_reached_end_of_data())
+        TRY_OR_FAIL(decompressed.try_append(TRY_OR_FAIL(decompressor.decompress_some(buffer))));
+
+    EXPECT_EQ(decompressed.bytes(), input.bytes());
+}
@@ -1629,41 +1629,41 @@ TEST_CASE(xz_utils_good_1_empty_bcj_lzma2)
     (void)decompressor->read_until_eof(PAGE_SIZE);
 }
 
+static Array<u8, 424> const xz_utils_good_1_lzma2_1_compressed {
+    0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00, 0x00, 0x01, 0x69, 0x22, 0xDE, 0x36, 0x02, 0x00, 0x21, 0x01,
+    0x08, 0x00, 0x00, 0x00, 0xD8, 0x0F, 0x23, 0x13, 0xE0, 0x00, 0xE2, 0x00, 0xB6, 0x5D, 0x00, 0x26,
+    0x1B, 0xCA, 0x46, 0x67, 0x5A, 0xF2, 0x77, 0xB8, 0x7D, 0x86, 0xD8, 0x41, 0xDB, 0x05, 0x35, 0xCD,
+    0x83, 0xA5, 0x7C, 0x12, 0xA5, 0x05, 0xDB, 0x90, 0xBD, 0x2F, 0x14, 0xD3, 0x71, 0x72, 0x96, 0xA8,
+    0x8A, 0x7D, 0x84, 0x56, 0x71, 0x8D, 0x6A, 0x22, 0x98, 0xAB, 0x9E, 0x3D, 0x90, 0x80, 0x2D, 0xC7,
+    0x5E, 0x0C, 0x12, 0x52, 0xD3, 0x3F, 0x07, 0x08, 0x7B, 0x1C, 0xA4, 0x77, 0xF3, 0x13, 0xB8, 0x17,
+    0xC0, 0xEE, 0x91, 0x81, 0x39, 0xB3, 0x87, 0xF0, 0xFF, 0x00, 0xB3, 0x6A, 0x52, 0x41, 0xED, 0x2E,
+    0xB0, 0xF2, 0x64, 0x97, 0xA4, 0x9A, 0x9E, 0x63, 0xA1, 0xAE, 0x19, 0x74, 0x0D, 0xA9, 0xD5, 0x5B,
+    0x6C, 0xEE, 0xB1, 0xE0, 0x2C, 0xDC, 0x61, 0xDC, 0xCB, 0x9D, 0x86, 0xCF, 0xE1, 0xDC, 0x0A, 0x7A,
+    0x81, 0x14, 0x5F, 0xD0, 0x40, 0xC8, 0x7E, 0x0D, 0x97, 0x44, 0xCE, 0xB5, 0xC2, 0xFC, 0x2C, 0x59,
+    0x08, 0xBF, 0x03, 0x80, 0xDC, 0xD7, 0x44, 0x8E, 0xB3, 0xD4, 0x2D, 0xDE, 0xE5, 0x16, 0x21, 0x6E,
+    0x47, 0x82, 0xAC, 0x08, 0x59, 0xD8, 0xE4, 0x66, 0x29, 0x61, 0xD5, 0xD1, 0xFA, 0x49, 0x63, 0x90,
+    0x11, 0x3E, 0x20, 0xD0, 0xA9, 0xE2, 0xD5, 0x14, 0x81, 0xD9, 0x23, 0xD0, 0x8F, 0x43, 0xAE, 0x45,
+    0x55, 0x36, 0x69, 0xAA, 0x00, 0xC0, 0x00, 0xE5, 0x00, 0xAD, 0x0B, 0x00, 0x8C, 0xF1, 0x9D, 0x40,
+    0x2B, 0xD0, 0x7D, 0x1D, 0x99, 0xEE, 0xE4, 0xDC, 0x63, 0x74, 0x64, 0x46, 0xA4, 0xA0, 0x4A, 0x64,
+    0x65, 0xB2, 0xF6, 0x4E, 0xC1, 0xC8, 0x68, 0x9F, 0x27, 0x54, 0xAD, 0xBB, 0xA6, 0x34, 0x3C, 0x77,
+    0xEC, 0x0F, 0x2E, 0x1B, 0x8E, 0x42, 0x27, 0xE5, 0x68, 0xBF, 0x60, 0xF4, 0x0B, 0x3A, 0xF0, 0x9B,
+    0x31, 0xEB, 0xDF, 0x3F, 0xD8, 0xAF, 0xA5, 0x55, 0x92, 0x46, 0x05, 0x58, 0x22, 0x09, 0x8F, 0xA8,
+    0x60, 0x08, 0x0B, 0xA3, 0xE9, 0x3E, 0xBC, 0xB4, 0x16, 0xDB, 0xC7, 0xA3, 0xA2, 0xC0, 0x16, 0xD5,
+    0x14, 0xA7, 0x22, 0xE8, 0x2F, 0xE8, 0xB4, 0xD0, 0x77, 0x17, 0xC5, 0x8B, 0xE4, 0xF2, 0xBB, 0x6B,
+    0xD6, 0xEF, 0x9A, 0x81, 0x34, 0x4E, 0x1D, 0xDC, 0xEC, 0x36, 0xE6, 0x44, 0x72, 0xBF, 0x29, 0xB5,
+    0x3C, 0x05, 0x31, 0x60, 0x66, 0xBA, 0x2C, 0x03, 0x0F, 0xD6, 0x47, 0xC6, 0x7D, 0x85, 0xD4, 0xC5,
+    0x5E, 0x4E, 0x57, 0x73, 0xC3, 0x41, 0x69, 0xBE, 0x0D, 0x8C, 0x9C, 0xB5, 0x15, 0xA9, 0xE7, 0xD2,
+    0x78, 0x51, 0x4B, 0xD5, 0x29, 0xD0, 0xF9, 0x35, 0x1A, 0xC5, 0x5D, 0xF4, 0x8C, 0x7A, 0x70, 0xD5,
+    0x5E, 0xA8, 0x31, 0x57, 0x80, 0xC8, 0xA5, 0xD8, 0xE0, 0x00, 0x00, 0x00, 0xFB, 0x47, 0x48, 0xDB,
+    0x00, 0x01, 0x82, 0x03, 0xC9, 0x03, 0x00, 0x00, 0x0B, 0x04, 0x8E, 0xDE, 0x3E, 0x30, 0x0D, 0x8B,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x59, 0x5A
+};
+
 TEST_CASE(xz_utils_good_1_lzma2_1)
 {
     // "good-1-lzma2-1.xz has two LZMA2 chunks, of which the second sets
     //  new properties."
-    Array<u8, 424> const compressed {
-        0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00, 0x00, 0x01, 0x69, 0x22, 0xDE, 0x36, 0x02, 0x00, 0x21, 0x01,
-        0x08, 0x00, 0x00, 0x00, 0xD8, 0x0F, 0x23, 0x13, 0xE0, 0x00, 0xE2, 0x00, 0xB6, 0x5D, 0x00, 0x26,
-        0x1B, 0xCA, 0x46, 0x67, 0x5A, 0xF2, 0x77, 0xB8, 0x7D, 0x86, 0xD8, 0x41, 0xDB, 0x05, 0x35, 0xCD,
-        0x83, 0xA5, 0x7C, 0x12, 0xA5, 0x05, 0xDB, 0x90, 0xBD, 0x2F, 0x14, 0xD3, 0x71, 0x72, 0x96, 0xA8,
-        0x8A, 0x7D, 0x84, 0x56, 0x71, 0x8D, 0x6A, 0x22, 0x98, 0xAB, 0x9E, 0x3D, 0x90, 0x80, 0x2D, 0xC7,
-        0x5E, 0x0C, 0x12, 0x52, 0xD3, 0x3F, 0x07, 0x08, 0x7B, 0x1C, 0xA4, 0x77, 0xF3, 0x13, 0xB8, 0x17,
-        0xC0, 0xEE, 0x91, 0x81, 0x39, 0xB3, 0x87, 0xF0, 0xFF, 0x00, 0xB3, 0x6A, 0x52, 0x41, 0xED, 0x2E,
-        0xB0, 0xF2, 0x64, 0x97, 0xA4, 0x9A, 0x9E, 0x63, 0xA1, 0xAE, 0x19, 0x74, 0x0D, 0xA9, 0xD5, 0x5B,
-        0x6C, 0xEE, 0xB1, 0xE0, 0x2C, 0xDC, 0x61, 0xDC, 0xCB, 0x9D, 0x86, 0xCF, 0xE1, 0xDC, 0x0A, 0x7A,
-        0x81, 0x14, 0x5F, 0xD0, 0x40, 0xC8, 0x7E, 0x0D, 0x97, 0x44, 0xCE, 0xB5, 0xC2, 0xFC, 0x2C, 0x59,
-        0x08, 0xBF, 0x03, 0x80, 0xDC, 0xD7, 0x44, 0x8E, 0xB3, 0xD4, 0x2D, 0xDE, 0xE5, 0x16, 0x21, 0x6E,
-        0x47, 0x82, 0xAC, 0x08, 0x59, 0xD8, 0xE4, 0x66, 0x29, 0x61, 0xD5, 0xD1, 0xFA, 0x49, 0x63, 0x90,
-        0x11, 0x3E, 0x20, 0xD0, 0xA9, 0xE2, 0xD5, 0x14, 0x81, 0xD9, 0x23, 0xD0, 0x8F, 0x43, 0xAE, 0x45,
-        0x55, 0x36, 0x69, 0xAA, 0x00, 0xC0, 0x00, 0xE5, 0x00, 0xAD, 0x0B, 0x00, 0x8C, 0xF1, 0x9D, 0x40,
-        0x2B, 0xD0, 0x7D, 0x1D, 0x99, 0xEE, 0xE4, 0xDC, 0x63, 0x74, 0x64, 0x46, 0xA4, 0xA0, 0x4A, 0x64,
-        0x65, 0xB2, 0xF6, 0x4E, 0xC1, 0xC8, 0x68, 0x9F, 0x27, 0x54, 0xAD, 0xBB, 0xA6, 0x34, 0x3C, 0x77,
-        0xEC, 0x0F, 0x2E, 0x1B, 0x8E, 0x42, 0x27, 0xE5, 0x68, 0xBF, 0x60, 0xF4, 0x0B, 0x3A, 0xF0, 0x9B,
-        0x31, 0xEB, 0xDF, 0x3F, 0xD8, 0xAF, 0xA5, 0x55, 0x92, 0x46, 0x05, 0x58, 0x22, 0x09, 0x8F, 0xA8,
-        0x60, 0x08, 0x0B, 0xA3, 0xE9, 0x3E, 0xBC, 0xB4, 0x16, 0xDB, 0xC7, 0xA3, 0xA2, 0xC0, 0x16, 0xD5,
-        0x14, 0xA7, 0x22, 0xE8, 0x2F, 0xE8, 0xB4, 0xD0, 0x77, 0x17, 0xC5, 0x8B, 0xE4, 0xF2, 0xBB, 0x6B,
-        0xD6, 0xEF, 0x9A, 0x81, 0x34, 0x4E, 0x1D, 0xDC, 0xEC, 0x36, 0xE6, 0x44, 0x72, 0xBF, 0x29, 0xB5,
-        0x3C, 0x05, 0x31, 0x60, 0x66, 0xBA, 0x2C, 0x03, 0x0F, 0xD6, 0x47, 0xC6, 0x7D, 0x85, 0xD4, 0xC5,
-        0x5E, 0x4E, 0x57, 0x73, 0xC3, 0x41, 0x69, 0xBE, 0x0D, 0x8C, 0x9C, 0xB5, 0x15, 0xA9, 0xE7, 0xD2,
-        0x78, 0x51, 0x4B, 0xD5, 0x29, 0xD0, 0xF9, 0x35, 0x1A, 0xC5, 0x5D, 0xF4, 0x8C, 0x7A, 0x70, 0xD5,
-        0x5E, 0xA8, 0x31, 0x57, 0x80, 0xC8, 0xA5, 0xD8, 0xE0, 0x00, 0x00, 0x00, 0xFB, 0x47, 0x48, 0xDB,
-        0x00, 0x01, 0x82, 0x03, 0xC9, 0x03, 0x00, 0x00, 0x0B, 0x04, 0x8E, 0xDE, 0x3E, 0x30, 0x0D, 0x8B,
-        0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x59, 0x5A
-    };
-
-    auto stream = MUST(try_make<FixedMemoryStream>(compressed));
+    auto stream = MUST(try_make<FixedMemoryStream>(xz_utils_good_1_lzma2_1_compressed));
     auto decompressor = MUST(Compress::XzDecompressor::create(move(stream)));
     auto buffer = TRY_OR_FAIL(decompressor->read_until_eof(PAGE_SIZE));
     EXPECT_EQ(buffer.span(), xz_utils_lorem_ipsum.bytes());
@@ -2057,3 +2057,131 @@ TEST_CASE(xz_utils_unsupported_filter_flags_3)
     auto buffer_or_error = decompressor->read_until_eof(PAGE_SIZE);
     EXPECT(buffer_or_error.is_error());
 }
+
+TEST_CASE(xz_parallel_multiple_blocks)
+{
+    // Three blocks of "Hello\nWorld!\n" as multithreaded xz writes them, except that the second block doesn't
+    // store its sizes. That one can't be read ahead, so it has to be decompressed in between the other two.
+    Array<u8, 144> const compressed {
+        // Stream Header
+        0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00, // Magic
+        0x00, 0x01,                         // Stream Flags
+        0x69, 0x22, 0xDE, 0x36,             // CRC32
+
+        // Block 0 Header
+        0x02, // Block Header Size
+        0xC0, // Block Flags (one filter, compressed size and uncompressed size present)
+        0x11, // Compressed Size
+        0x0D, // Uncompressed Size
+        // Filter 0 Flags
+        0x21,                   // Filter ID
+        0x01,                   // Size of Properties
+        0x16,                   // Filter Properties
+        0x00,                   // Header Padding
+        0xAB, 0x45, 0xD4, 0xDE, // CRC32
+
+        // Compressed Data (LZMA2)
+        //   Uncompressed chunk with dictionary reset
+        0x01,       // Control Byte
+        0x00, 0x0C, // 16-bit data size minus one (big-endian)
+        0x48, 0x65, 0x6C, 0x6C, 0x6F, 0x0A, 0x57, 0x6F, 0x72, 0x6C, 0x64, 0x21, 0x0A,
+        //   End of LZMA2 stream
+        0x00,
+
+        // Block Padding
+        0x00, 0x00, 0x00,
+
+        // Uncompressed Data Check (CRC32)
+        0x43, 0xA3, 0xA2, 0x15,
+
+        // Block 1 Header
+        0x02, // Block Header Size
+        0x00, // Block Flags (one filter, no compressed or uncompressed size present)
+        // Filter 0 Flags
+        0x21,                   // Filter ID
+        0x01,                   // Size of Properties
+        0x16,                   // Filter Properties
+        0x00, 0x00, 0x00,       // Header Padding
+        0x74, 0x2F, 0xE5, 0xA3, // CRC32
+
+        // Compressed Data (LZMA2)
+        //   Uncompressed chunk with dictionary reset
+        0x01,       // Control Byte
+        0x00, 0x0C, // 16-bit data size minus one (big-endian)
+        0x48, 0x65, 0x6C, 0x6C, 0x6F, 0x0A, 0x57, 0x6F, 0x72, 0x6C, 0x64, 0x21, 0x0A,
+        //   End of LZMA2 stream
+        0x00,
+
+        // Block Padding
+        0x00, 0x00, 0x00,
+
+        // Uncompressed Data Check (CRC32)
+        0x43, 0xA3, 0xA2, 0x15,
+
+        // Block 2 Header
+        0x02, // Block Header Size
+        0xC0, // Block Flags (one filter, compressed size and uncompressed size present)
+        0x11, // Compressed Size
+        0x0D, // Uncompressed Size
+        // Filter 0 Flags
+        0x21,                   // Filter ID
+        0x01,                   // Size of Properties
+        0x16,                   // Filter Properties
+        0x00,                   // Header Padding
+        0xAB, 0x45, 0xD4, 0xDE, // CRC32
+
+        // Compressed Data (LZMA2)
+        //   Uncompressed chunk with dictionary reset
+        0x01,       // Control Byte
+        0x00, 0x0C, // 16-bit data size minus one (big-endian)
+        0x48, 0x65, 0x6C, 0x6C, 0x6F, 0x0A, 0x57, 0x6F, 0x72, 0x6C, 0x64, 0x21, 0x0A,
+        //   End of LZMA2 stream
+        0x00,
+
+        // Block Padding
+        0x00, 0x00, 0x00,
+
+        // Uncompressed Data Check (CRC32)
+        0x43, 0xA3, 0xA2, 0x15,
+
+        // Index
+        0x00, // Index Indicator
+        0x03, // Number of Records (multibyte integer)
+        //   Record 0
+        0x21, // Unpadded Size (multibyte integer)
+        0x0D, // Uncompressed Size (multibyte integer)
+        //   Record 1
+        0x21, // Unpadded Size (multibyte integer)
+        0x0D, // Uncompressed Size (multibyte integer)
+        //   Record 2
+        0x21, // Unpadded Size (multibyte integer)
+        0x0D, // Uncompressed Size (multibyte integer)
+        //   CRC32
+        0x80, 0xE5, 0xD2, 0x82,
+
+        // Stream Footer
+        0x3E, 0x30, 0x0D, 0x8B, // CRC32
+        0x02, 0x00, 0x00, 0x00, // Backward Size
+        0x00, 0x01,             // Stream Flags
+        0x59, 0x5A,             // Footer Magic Bytes
+    };
+
+    auto expected = "Hello\nWorld!\nHello\nWorld!\nHello\nWorld!\n"sv;
+
+    for (size_t thread_count : { 1, 2, 4 }) {
+        auto stream = MUST(try_make<FixedMemoryStream>(compressed));
+        auto decompressor = MUST(Compress::XzDecompressor::create_parallel(move(stream), thread_count));
+        auto buffer = TRY_OR_FAIL(decompressor->read_until_eof(PAGE_SIZE));
+        EXPECT_EQ(buffer.span(), expected.bytes());
+    }
+}
+
+BENCHMARK_CASE(xz_utils_good_1_lzma2_1_decompression)
+{
+    for (size_t i = 0; i < 10000; ++i) {
+        auto stream = MUST(try_make<FixedMemoryStream>(xz_utils_good_1_lzma2_1_compressed));
+        auto decompressor = MUST(Compress::XzDecompressor::create(move(stream)));
+        auto buffer = TRY_OR_FAIL(decompressor->read_until_eof(PAGE_SIZE));
+        EXPECT_EQ(buffer.span(), xz_utils_lorem_ipsum.bytes());
+    }
+}
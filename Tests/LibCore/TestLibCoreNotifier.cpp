@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibCore/Notifier.h>
+#include <LibCore/System.h>
+#include <LibCore/Timer.h>
+#include <LibTest/TestCase.h>
+#include <fcntl.h>
+
+// Returns 0 once the notifier has been activated, and 1 if it isn't activated within a second.
+static int wait_for_activation(Core::EventLoop& event_loop, int fd, Core::Notifier::Type type)
+{
+    auto notifier = Core::Notifier::construct(fd, type);
+    notifier->on_activation = [&] {
+        notifier->set_enabled(false);
+        event_loop.quit(0);
+    };
+
+    auto timeout = Core::Timer::create_single_shot(1000, [&] { event_loop.quit(1); });
+    timeout->start();
+
+    return event_loop.exec();
+}
+
+TEST_CASE(notifier_on_regular_file)
+{
+    Core::EventLoop event_loop;
+
+    char path[] = "/tmp/TestLibCoreNotifier.XXXXXX";
+    auto fd = TRY_OR_FAIL(Core::System::mkstemp(path));
+    TRY_OR_FAIL(Core::System::unlink({ path, sizeof(path) - 1 }));
+    TRY_OR_FAIL(Core::System::write(fd, "Well hello friends!"sv.bytes()));
+    TRY_OR_FAIL(Core::System::lseek(fd, 0, SEEK_SET));
+
+    EXPECT_EQ(wait_for_activation(event_loop, fd, Core::Notifier::Type::Read), 0);
+    EXPECT_EQ(wait_for_activation(event_loop, fd, Core::Notifier::Type::Write), 0);
+
+    TRY_OR_FAIL(Core::System::close(fd));
+}
+
+TEST_CASE(notifier_on_dev_null)
+{
+    Core::EventLoop event_loop;
+
+    auto fd = TRY_OR_FAIL(Core::System::open("/dev/null"sv, O_RDWR));
+    EXPECT_EQ(wait_for_activation(event_loop, fd, Core::Notifier::Type::Write), 0);
+
+    TRY_OR_FAIL(Core::System::close(fd));
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <LibCore/SharedByteRingBuffer.h>
+#include <LibTest/TestCase.h>
+
+TEST_CASE(write_until_full)
+{
+    auto ring = MUST(Core::SharedByteRingBuffer::create(16));
+    Array<u8, 10> data {};
+
+    EXPECT_EQ(ring.write(data), 10u);
+    EXPECT_EQ(ring.write(data), 6u);
+    EXPECT_EQ(ring.write(data), 0u);
+    EXPECT_EQ(ring.used_space(), 16u);
+    EXPECT_EQ(ring.free_space(), 0u);
+}
+
+TEST_CASE(read_back_across_wraparound)
+{
+    auto ring = MUST(Core::SharedByteRingBuffer::create(8));
+    Array<u8, 8> output {};
+
+    EXPECT_EQ(ring.write("abcdef"sv.bytes()), 6u);
+    EXPECT_EQ(ring.read(output.span().trim(4)), 4u);
+    EXPECT_EQ(StringView(output.span().trim(4)), "abcd"sv);
+
+    // This write wraps around the end of the ring.
+    EXPECT_EQ(ring.write("ghijkl"sv.bytes()), 6u);
+    EXPECT_EQ(ring.read(output), 8u);
+    EXPECT_EQ(StringView(output.span()), "efghijkl"sv);
+    EXPECT_EQ(ring.read(output), 0u);
+}
+
+TEST_CASE(attach_to_existing_buffer)
+{
+    auto producer = MUST(Core::SharedByteRingBuffer::create(32));
+    auto consumer = MUST(Core::SharedByteRingBuffer::attach(producer.anonymous_buffer()));
+    EXPECT_EQ(consumer.capacity(), 32u);
+
+    EXPECT_EQ(producer.write("hello"sv.bytes()), 5u);
+
+    Array<u8, 5> output {};
+    EXPECT_EQ(consumer.read(output), 5u);
+    EXPECT_EQ(StringView(output.span()), "hello"sv);
+    EXPECT_EQ(producer.free_space(), 32u);
+}
+
+TEST_CASE(producer_wakeup_request)
+{
+    auto ring = MUST(Core::SharedByteRingBuffer::create(4));
+    EXPECT(!ring.take_producer_is_waiting());
+
+    ring.set_producer_is_waiting();
+    EXPECT(ring.take_producer_is_waiting());
+    EXPECT(!ring.take_producer_is_waiting());
+}
+
+TEST_CASE(attach_rejects_invalid_buffer)
+{
+    auto buffer = MUST(Core::AnonymousBuffer::create_with_size(4));
+    EXPECT(Core::SharedByteRingBuffer::attach(buffer).is_error());
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Timer.h>
+#include <LibTest/TestCase.h>
+#include <unistd.h>
+
+TEST_CASE(timer_with_less_slack_fires_first)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA Core::EventLoop event_loop;
+    IGNORE_USE_IN_ESCAPING_LAMBDA Vector<char> fired_timers;
+
+    auto on_timeout = [&](char timer) {
+        fired_timers.append(timer);
+        if (fired_timers.size() == 2)
+            event_loop.quit(0);
+    };
+
+    // A 64ms timer may be up to 4ms late, while a 1ms timer gets almost no slack. So a 1ms timer that is started
+    // shortly before the 64ms timer is due is due after it, but has to fire before the 64ms timer's slack runs out.
+    auto started_at = MonotonicTime::now_coarse();
+    auto long_timer = Core::Timer::create_single_shot(64, [&] { on_timeout('L'); });
+    long_timer->start();
+
+    while (MonotonicTime::now_coarse() - started_at < AK::Duration::from_milliseconds(60))
+        usleep(100);
+    auto waited = MonotonicTime::now_coarse() - started_at;
+    auto short_timer_interval = 64 - static_cast<int>(waited.to_milliseconds()) + 1;
+    if (short_timer_interval <= 0)
+        return;
+
+    auto short_timer = Core::Timer::create_single_shot(short_timer_interval, [&] { on_timeout('S'); });
+    short_timer->start();
+
+    event_loop.exec();
+
+    EXPECT_EQ(fired_timers, (Vector<char> { 'S', 'L' }));
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonObject.h>
+#include <LibCore/System.h>
+#include <LibCore/Tracing.h>
+#include <LibTest/TestCase.h>
+
+using Core::Tracing::Category;
+
+TEST_CASE(parse_categories)
+{
+    EXPECT(Core::Tracing::parse_categories("all"sv) == Category::All);
+    EXPECT(Core::Tracing::parse_categories("none"sv) == Category::None);
+    EXPECT(Core::Tracing::parse_categories("style"sv) == Category::Style);
+    EXPECT(Core::Tracing::parse_categories("style, layout,gc"sv) == (Category::Style | Category::Layout | Category::GC));
+    EXPECT(!Core::Tracing::parse_categories("style,bogus"sv).has_value());
+}
+
+TEST_CASE(only_enabled_categories_are_recorded)
+{
+    Core::Tracing::set_enabled_categories(Category::Layout);
+    (void)Core::Tracing::take_events();
+
+    {
+        Core::Tracing::ScopedEvent layout_event { Category::Layout, "layout"sv };
+        Core::Tracing::ScopedEvent style_event { Category::Style, "style"sv };
+    }
+
+    auto events = Core::Tracing::take_events();
+    EXPECT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].name, "layout"sv);
+    EXPECT_EQ(events[0].category, Category::Layout);
+    EXPECT(events[0].duration >= AK::Duration::zero());
+
+    Core::Tracing::set_enabled_categories(Category::None);
+    {
+        Core::Tracing::ScopedEvent layout_event { Category::Layout, "layout"sv };
+    }
+    EXPECT(Core::Tracing::take_events().is_empty());
+}
+
+TEST_CASE(chrome_trace_events)
+{
+    Core::Tracing::set_enabled_categories(Category::Fetch);
+    (void)Core::Tracing::take_events();
+
+    auto start = MonotonicTime::now();
+    Core::Tracing::add_event(Category::Fetch, "load"sv, start, start + AK::Duration::from_microseconds(1500), "https://example.com"sv);
+    Core::Tracing::set_enabled_categories(Category::None);
+
+    auto trace_events = Core::Tracing::to_chrome_trace_events(Core::Tracing::take_events());
+    EXPECT_EQ(trace_events.size(), 1u);
+
+    auto const& event = trace_events[0].as_object();
+    EXPECT_EQ(event.get_byte_string("name"sv), "load"sv);
+    EXPECT_EQ(event.get_byte_string("cat"sv), "fetch"sv);
+    EXPECT_EQ(event.get_byte_string("ph"sv), "X"sv);
+    EXPECT_EQ(event.get_i64("ts"sv), start.nanoseconds() / 1000);
+    EXPECT_EQ(event.get_i64("dur"sv), 1500);
+    EXPECT_EQ(event.get_object("args"sv)->get_byte_string("detail"sv), "https://example.com"sv);
+}
+
+TEST_CASE(category_names)
+{
+    EXPECT_EQ(Core::Tracing::category_names(Category::All), "all"sv);
+    EXPECT_EQ(Core::Tracing::category_names(Category::None), "none"sv);
+    EXPECT_EQ(Core::Tracing::category_names(Category::Style | Category::IPC), "style,ipc"sv);
+    EXPECT(Core::Tracing::parse_categories(Core::Tracing::category_names(Category::Fetch | Category::GC)) == (Category::Fetch | Category::GC));
+}
+
+TEST_CASE(long_names_are_truncated)
+{
+    Core::Tracing::set_enabled_categories(Category::Layout);
+    (void)Core::Tracing::take_events();
+
+    auto long_name = ByteString::repeated('a', 1000);
+    auto start = MonotonicTime::now();
+    Core::Tracing::add_event(Category::Layout, long_name, start, start, long_name);
+    Core::Tracing::set_enabled_categories(Category::None);
+
+    auto events = Core::Tracing::take_events();
+    EXPECT_EQ(events.size(), 1u);
+    EXPECT(events[0].name.length() < long_name.length());
+    EXPECT(long_name.starts_with(events[0].name));
+    EXPECT(events[0].detail.length() < long_name.length());
+    EXPECT_EQ(events[0].start, start);
+}
+
+TEST_CASE(oldest_events_are_overwritten)
+{
+    Core::Tracing::set_enabled_categories(Category::Layout);
+    (void)Core::Tracing::take_events();
+
+    auto start = MonotonicTime::now();
+    for (size_t i = 0; i < 100'000; ++i)
+        Core::Tracing::add_event(Category::Layout, ByteString::number(i), start, start);
+    Core::Tracing::set_enabled_categories(Category::None);
+
+    auto events = Core::Tracing::take_events();
+    EXPECT(!events.is_empty());
+    EXPECT(events.size() < 100'000u);
+    EXPECT_EQ(events.last().name, "99999"sv);
+    EXPECT_EQ(events.first().name, ByteString::number(100'000 - events.size()));
+}
+
+TEST_CASE(shared_buffer)
+{
+    auto buffer = MUST(Core::Tracing::create_shared_buffer());
+    EXPECT(Core::Tracing::take_events(buffer).is_empty());
+
+    // This process already has a buffer of its own.
+    EXPECT(Core::Tracing::use_shared_buffer(MUST(Core::System::dup(buffer.fd())), "all"sv).is_error());
+
+    auto not_a_trace_buffer = MUST(Core::AnonymousBuffer::create_with_size(4096));
+    EXPECT(Core::Tracing::take_events(not_a_trace_buffer).is_empty());
+}
+
+TEST_CASE(flow_events)
+{
+    Core::Tracing::set_enabled_categories(Category::IPC);
+    (void)Core::Tracing::take_events();
+
+    auto flow_id = Core::Tracing::next_flow_id();
+    EXPECT(Core::Tracing::next_flow_id() != flow_id);
+
+    auto start = MonotonicTime::now();
+    Core::Tracing::add_event(Category::IPC, "send"sv, start, start, {}, flow_id, Core::Tracing::Flow::Out);
+    Core::Tracing::add_event(Category::IPC, "handle"sv, start, start, {}, flow_id, Core::Tracing::Flow::In);
+    Core::Tracing::set_enabled_categories(Category::None);
+
+    auto trace_events = Core::Tracing::to_chrome_trace_events(Core::Tracing::take_events());
+    EXPECT_EQ(trace_events.size(), 4u);
+
+    EXPECT_EQ(trace_events[0].as_object().get_byte_string("ph"sv), "X"sv);
+    EXPECT_EQ(trace_events[1].as_object().get_byte_string("ph"sv), "s"sv);
+    EXPECT_EQ(trace_events[2].as_object().get_byte_string("ph"sv), "X"sv);
+    EXPECT_EQ(trace_events[3].as_object().get_byte_string("ph"sv), "f"sv);
+    EXPECT_EQ(trace_events[1].as_object().get_byte_string("id"sv), trace_events[3].as_object().get_byte_string("id"sv));
+}
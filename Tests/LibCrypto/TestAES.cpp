@@ -347,6 +347,19 @@ BENCHMARK_CASE(GCM)
     }
 }
 
+BENCHMARK_CASE(GCM_encrypt)
+{
+    Crypto::Cipher::AESCipher::GCMMode cipher("WellHelloFriends"_b, 128, Crypto::Cipher::Intent::Encryption);
+    auto in = ByteBuffer::create_uninitialized(16 * MiB).release_value();
+    auto out = ByteBuffer::create_uninitialized(16 * MiB).release_value();
+    auto tag = ByteBuffer::create_uninitialized(16).release_value();
+    fill_with_random(in);
+    for (size_t i = 0; i < 10; ++i) {
+        cipher.encrypt(in, out, "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"_b, {}, tag);
+        AK::taint_for_optimizer(out);
+    }
+}
+
 TEST_CASE(test_AES_GCM_name)
 {
     Crypto::Cipher::AESCipher::GCMMode cipher("WellHelloFriends"_b, 128, Crypto::Cipher::Intent::Encryption);
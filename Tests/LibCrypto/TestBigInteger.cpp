@@ -201,6 +201,33 @@ TEST_CASE(test_unsigned_bigint_multiplication_with_big_numbers2)
     EXPECT_EQ(result.words(), expected_result);
 }
 
+TEST_CASE(test_unsigned_bigint_multiplication_with_karatsuba)
+{
+    // (2^a - 1) * (2^b - 1) = 2^(a + b) - 2^a - 2^b + 1, with operands long enough to be split up, including very unbalanced ones.
+    Crypto::UnsignedBigInteger one(1);
+    struct {
+        size_t a;
+        size_t b;
+    } lengths[] = { { 2048, 2048 }, { 4096, 4096 }, { 8209, 7001 }, { 16384, 1057 }, { 3000, 1500 } };
+
+    for (auto [a, b] : lengths) {
+        auto x = one.shift_left(a).minus(one);
+        auto y = one.shift_left(b).minus(one);
+        auto expected = one.shift_left(a + b).minus(one.shift_left(a)).minus(one.shift_left(b)).plus(one);
+        EXPECT_EQ(x.multiplied_by(y), expected);
+        EXPECT_EQ(y.multiplied_by(x), expected);
+    }
+
+    for (size_t bits : { 1024, 2048, 4096, 10000 }) {
+        auto x = Crypto::NumberTheory::random_number(one, one.shift_left(bits));
+        auto y = Crypto::NumberTheory::random_number(one, one.shift_left(bits / 3 + 100));
+        auto product = x.multiplied_by(y);
+        auto division = product.divided_by(y);
+        EXPECT_EQ(division.quotient, x);
+        EXPECT_EQ(division.remainder, 0u);
+    }
+}
+
 TEST_CASE(test_unsigned_bigint_simple_division)
 {
     Crypto::UnsignedBigInteger num1(27194);
@@ -335,6 +362,38 @@ TEST_CASE(test_bigint_modular_power_extra_tests)
     }
 }
 
+static void benchmark_modular_power(size_t bits, bool private_exponent)
+{
+    Crypto::UnsignedBigInteger one(1);
+    auto modulo = Crypto::NumberTheory::random_number(one.shift_left(bits - 1), one.shift_left(bits));
+    if (!modulo.is_odd())
+        modulo = modulo.plus(one);
+    auto base = Crypto::NumberTheory::random_number(one, modulo);
+    auto exponent = private_exponent ? Crypto::NumberTheory::random_number(one, modulo) : Crypto::UnsignedBigInteger(65537);
+    for (size_t i = 0; i < (private_exponent ? 10 : 500); ++i)
+        (void)Crypto::NumberTheory::ModularPower(base, exponent, modulo);
+}
+
+BENCHMARK_CASE(bigint_modular_power_2048_public_exponent)
+{
+    benchmark_modular_power(2048, false);
+}
+
+BENCHMARK_CASE(bigint_modular_power_2048_private_exponent)
+{
+    benchmark_modular_power(2048, true);
+}
+
+BENCHMARK_CASE(bigint_modular_power_4096_public_exponent)
+{
+    benchmark_modular_power(4096, false);
+}
+
+BENCHMARK_CASE(bigint_modular_power_4096_private_exponent)
+{
+    benchmark_modular_power(4096, true);
+}
+
 TEST_CASE(test_bigint_primality_test)
 {
     struct {
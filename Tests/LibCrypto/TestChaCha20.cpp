@@ -5,6 +5,7 @@
  */
 
 #include <AK/ByteBuffer.h>
+#include <AK/Random.h>
 #include <LibCrypto/Cipher/ChaCha20.h>
 #include <LibTest/TestCase.h>
 
@@ -139,3 +140,45 @@ TEST_CASE(test_vector_3)
     auto expected = ReadonlyBytes { ciphertext, 127 };
     EXPECT_EQ(result, expected);
 }
+
+TEST_CASE(encrypt_multiple_blocks_at_once)
+{
+    // Encrypting a long input at once takes the multi-block paths, which must agree with encrypting one block at a time.
+    u8 key[32] {};
+    u8 nonce[12] {};
+    fill_with_random(key);
+    fill_with_random(nonce);
+    u32 initial_block_counter { 1 };
+
+    auto plaintext = MUST(ByteBuffer::create_uninitialized(1000 * 64 + 17));
+    fill_with_random(plaintext);
+
+    auto expected = MUST(ByteBuffer::create_uninitialized(plaintext.size()));
+    for (size_t offset = 0; offset < plaintext.size(); offset += 64) {
+        auto size = min(64, plaintext.size() - offset);
+        auto output = expected.bytes().slice(offset, size);
+        Crypto::Cipher::ChaCha20 cipher(ReadonlyBytes { key, 32 }, ReadonlyBytes { nonce, 12 }, initial_block_counter + offset / 64);
+        cipher.encrypt(plaintext.bytes().slice(offset, size), output);
+    }
+
+    auto result = MUST(ByteBuffer::create_uninitialized(plaintext.size()));
+    auto output = result.bytes();
+    Crypto::Cipher::ChaCha20 cipher(ReadonlyBytes { key, 32 }, ReadonlyBytes { nonce, 12 }, initial_block_counter);
+    cipher.encrypt(plaintext, output);
+    EXPECT_EQ(result, expected);
+}
+
+BENCHMARK_CASE(encrypt)
+{
+    u8 key[32] {};
+    u8 nonce[12] {};
+    auto in = ByteBuffer::create_uninitialized(16 * MiB).release_value();
+    auto out = ByteBuffer::create_uninitialized(16 * MiB).release_value();
+    fill_with_random(in);
+    for (size_t i = 0; i < 10; ++i) {
+        Crypto::Cipher::ChaCha20 cipher(ReadonlyBytes { key, 32 }, ReadonlyBytes { nonce, 12 });
+        auto output = out.bytes();
+        cipher.encrypt(in, output);
+        AK::taint_for_optimizer(out);
+    }
+}
@@ -241,6 +241,29 @@ TEST_CASE(test_SHA256_hash_split_into_blocks)
     EXPECT(memcmp(result, digest.data, Crypto::Hash::SHA256::digest_size()) == 0);
 }
 
+TEST_CASE(test_SHA256_hash_many)
+{
+    // Enough inputs of different lengths that lanes finish at different times and pick up further inputs.
+    Vector<ByteBuffer> inputs;
+    for (size_t length : { 0, 1, 55, 56, 63, 64, 65, 119, 120, 128, 1000, 3, 4096, 200 }) {
+        auto input = MUST(ByteBuffer::create_uninitialized(length));
+        for (size_t i = 0; i < length; ++i)
+            input[i] = static_cast<u8>(i * 7 + length);
+        inputs.append(move(input));
+    }
+
+    Vector<ReadonlyBytes> spans;
+    for (auto& input : inputs)
+        spans.append(input.bytes());
+
+    Vector<Crypto::Hash::SHA256::DigestType> digests;
+    digests.resize(inputs.size());
+    Crypto::Hash::SHA256::hash_many(spans, digests);
+
+    for (size_t i = 0; i < inputs.size(); ++i)
+        EXPECT_EQ(digests[i].bytes(), Crypto::Hash::SHA256::hash(inputs[i]).bytes());
+}
+
 TEST_CASE(test_SHA384_name)
 {
     Crypto::Hash::SHA384 sha;
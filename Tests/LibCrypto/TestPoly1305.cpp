@@ -5,6 +5,7 @@
  */
 
 #include <AK/ByteBuffer.h>
+#include <AK/Random.h>
 #include <LibCrypto/Authentication/Poly1305.h>
 #include <LibTest/TestCase.h>
 
@@ -303,3 +304,38 @@ TEST_CASE(test_vector_11)
     auto expected = ReadonlyBytes { expected_result, 16 };
     EXPECT_EQ(result, expected);
 }
+
+TEST_CASE(update_in_pieces)
+{
+    // Whole blocks are processed in pairs, which must agree with feeding the message one byte at a time.
+    u8 key[32] {};
+    fill_with_random(key);
+
+    auto message = MUST(ByteBuffer::create_uninitialized(1000 * 16 + 7));
+    fill_with_random(message);
+
+    Crypto::Authentication::Poly1305 expected_mac(ReadonlyBytes { key, 32 });
+    for (size_t i = 0; i < message.size(); i++)
+        expected_mac.update(message.bytes().slice(i, 1));
+    auto expected = MUST(expected_mac.digest());
+
+    Crypto::Authentication::Poly1305 mac(ReadonlyBytes { key, 32 });
+    mac.update(message.bytes().slice(0, 5));
+    mac.update(message.bytes().slice(5));
+    auto result = MUST(mac.digest());
+    EXPECT_EQ(result, expected);
+}
+
+BENCHMARK_CASE(authenticate)
+{
+    u8 key[32] {};
+    auto message = ByteBuffer::create_uninitialized(16 * MiB).release_value();
+    fill_with_random(message);
+    fill_with_random(key);
+    for (size_t i = 0; i < 10; ++i) {
+        Crypto::Authentication::Poly1305 mac(ReadonlyBytes { key, 32 });
+        mac.update(message);
+        auto result = MUST(mac.digest());
+        AK::taint_for_optimizer(result);
+    }
+}
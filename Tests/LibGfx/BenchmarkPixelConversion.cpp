@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/MappedFile.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/CMYKBitmap.h>
+#include <LibGfx/ICC/Profile.h>
+#include <LibGfx/ICC/WellKnownProfiles.h>
+#include <LibGfx/PixelConversion.h>
+#include <LibTest/TestCase.h>
+
+#define TEST_INPUT(x) ("test-inputs/" x)
+
+static NonnullRefPtr<Gfx::CMYKBitmap> create_cmyk_bitmap(Gfx::IntSize size)
+{
+    auto bitmap = MUST(Gfx::CMYKBitmap::create_with_size(size));
+    for (int y = 0; y < size.height(); ++y) {
+        for (int x = 0; x < size.width(); ++x)
+            bitmap->scanline(y)[x] = { static_cast<u8>(x), static_cast<u8>(y), static_cast<u8>(x ^ y), static_cast<u8>(x + y) };
+    }
+    return bitmap;
+}
+
+static NonnullRefPtr<Gfx::Bitmap> create_rgb_bitmap(Gfx::IntSize size)
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, size));
+    for (int y = 0; y < size.height(); ++y) {
+        for (int x = 0; x < size.width(); ++x)
+            bitmap->set_pixel(x, y, Gfx::Color(x, y, x ^ y, x + y));
+    }
+    return bitmap;
+}
+
+TEST_CASE(cmyk_to_rgb)
+{
+    // An odd width makes sure the pixels left over after the vectorized loop are converted too.
+    auto cmyk = create_cmyk_bitmap({ 255, 256 });
+    auto rgb = MUST(cmyk->to_low_quality_rgb());
+
+    for (int y = 0; y < cmyk->size().height(); ++y) {
+        for (int x = 0; x < cmyk->size().width(); ++x) {
+            auto const& pixel = cmyk->scanline(y)[x];
+            int k = 255 - pixel.k;
+            auto expected = Gfx::Color((255 - pixel.c) * k / 255, (255 - pixel.m) * k / 255, (255 - pixel.y) * k / 255);
+            EXPECT_EQ(rgb->get_pixel(x, y), expected);
+        }
+    }
+}
+
+TEST_CASE(icc_matrix_matrix_conversion)
+{
+    auto sRGB = MUST(Gfx::ICC::sRGB());
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("icc/p3-v4.icc"sv)));
+    auto p3 = MUST(Gfx::ICC::Profile::try_load_from_externally_owned_memory(file->bytes()));
+    auto conversion = sRGB->matrix_matrix_conversion(*p3);
+    EXPECT(conversion.has_value());
+
+    auto original = create_rgb_bitmap({ 255, 256 });
+    auto converted = MUST(original->clone());
+    MUST(sRGB->convert_image(*converted, *p3));
+
+    for (int y = 0; y < original->height(); ++y) {
+        for (int x = 0; x < original->width(); ++x) {
+            auto pixel = original->get_pixel(x, y);
+            auto expected = conversion->map(FloatVector3 { (float)pixel.red(), (float)pixel.green(), (float)pixel.blue() } / 255.0f);
+            expected.set_alpha(pixel.alpha());
+            EXPECT_EQ(converted->get_pixel(x, y), expected);
+        }
+    }
+}
+
+TEST_CASE(icc_matrix_matrix_conversion_matches_pcs_conversion)
+{
+    auto sRGB = MUST(Gfx::ICC::sRGB());
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("icc/p3-v4.icc"sv)));
+    auto p3 = MUST(Gfx::ICC::Profile::try_load_from_externally_owned_memory(file->bytes()));
+
+    // The matrix/matrix path samples the inverse of the destination curves, so it may be off from the exact
+    // conversion through the PCS by one level.
+    auto original = create_rgb_bitmap({ 255, 256 });
+    for (int i = 0; i < 2; ++i) {
+        // The second conversion uses the lookup tables that the first one cached.
+        auto converted = MUST(original->clone());
+        MUST(sRGB->convert_image(*converted, *p3));
+
+        for (int y = 0; y < original->height(); ++y) {
+            for (int x = 0; x < original->width(); ++x) {
+                auto pixel = original->get_pixel(x, y);
+                u8 const source[3] = { pixel.red(), pixel.green(), pixel.blue() };
+                u8 expected[3];
+                auto pcs = MUST(p3->to_pcs(source));
+                MUST(sRGB->from_pcs(*p3, pcs, expected));
+
+                auto actual = converted->get_pixel(x, y);
+                EXPECT(abs(actual.red() - expected[0]) <= 1);
+                EXPECT(abs(actual.green() - expected[1]) <= 1);
+                EXPECT(abs(actual.blue() - expected[2]) <= 1);
+            }
+        }
+    }
+}
+
+// Every combination of alpha and channel value, plus one more pixel so that some are left over after the vectorized loop.
+static Vector<u32> create_pixels_with_all_alphas()
+{
+    Vector<u32> pixels;
+    for (u32 alpha = 0; alpha < 256; ++alpha) {
+        for (u32 value = 0; value < 256; ++value)
+            pixels.append((alpha << 24) | (value << 16) | (((value * 7) & 0xff) << 8) | ((value * 13) & 0xff));
+    }
+    pixels.append(0x80402010);
+    return pixels;
+}
+
+TEST_CASE(bgra_premultiplied_to_rgba_unpremultiplied)
+{
+    auto source = create_pixels_with_all_alphas();
+    Vector<u32> destination;
+    destination.resize(source.size());
+    Gfx::convert_bgra_premultiplied_to_rgba_unpremultiplied(source, destination);
+
+    for (size_t i = 0; i < source.size(); ++i) {
+        u32 alpha = source[i] >> 24;
+        auto unpremultiply = [&](u32 value) { return alpha == 0 ? 0 : min<u32>(static_cast<u32>(value * 255.0 / alpha + 0.5), 255); };
+        auto expected = alpha == 0 ? 0 : (alpha << 24) | (unpremultiply(source[i] & 0xff) << 16) | (unpremultiply((source[i] >> 8) & 0xff) << 8) | unpremultiply((source[i] >> 16) & 0xff);
+        EXPECT_EQ(destination[i], expected);
+    }
+}
+
+TEST_CASE(rgba_unpremultiplied_to_bgra_premultiplied)
+{
+    auto source = create_pixels_with_all_alphas();
+    Vector<u32> destination;
+    destination.resize(source.size());
+    Gfx::convert_rgba_unpremultiplied_to_bgra_premultiplied(source, destination);
+
+    for (size_t i = 0; i < source.size(); ++i) {
+        u32 alpha = source[i] >> 24;
+        auto premultiply = [&](u32 value) { return static_cast<u32>(value * alpha / 255.0 + 0.5); };
+        auto expected = (alpha << 24) | (premultiply(source[i] & 0xff) << 16) | (premultiply((source[i] >> 8) & 0xff) << 8) | premultiply((source[i] >> 16) & 0xff);
+        EXPECT_EQ(destination[i], expected);
+    }
+}
+
+BENCHMARK_CASE(cmyk_to_rgb)
+{
+    auto cmyk = create_cmyk_bitmap({ 2048, 2048 });
+    MUST(cmyk->to_low_quality_rgb());
+}
+
+BENCHMARK_CASE(icc_matrix_matrix_conversion)
+{
+    auto sRGB = MUST(Gfx::ICC::sRGB());
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("icc/p3-v4.icc"sv)));
+    auto p3 = MUST(Gfx::ICC::Profile::try_load_from_externally_owned_memory(file->bytes()));
+
+    auto bitmap = create_rgb_bitmap({ 2048, 2048 });
+    MUST(sRGB->convert_image(*bitmap, *p3));
+}
+
+// One full HD frame worth of pixels, as an image processing page would read and write every frame.
+BENCHMARK_CASE(bgra_premultiplied_to_rgba_unpremultiplied)
+{
+    auto pixels = create_pixels_with_all_alphas();
+    Vector<u32> source;
+    source.resize(1920 * 1080);
+    for (size_t i = 0; i < source.size(); ++i)
+        source[i] = pixels[i % pixels.size()];
+    Vector<u32> destination;
+    destination.resize(source.size());
+    for (int i = 0; i < 10; ++i)
+        Gfx::convert_bgra_premultiplied_to_rgba_unpremultiplied(source, destination);
+}
+
+BENCHMARK_CASE(rgba_unpremultiplied_to_bgra_premultiplied)
+{
+    auto pixels = create_pixels_with_all_alphas();
+    Vector<u32> source;
+    source.resize(1920 * 1080);
+    for (size_t i = 0; i < source.size(); ++i)
+        source[i] = pixels[i % pixels.size()];
+    Vector<u32> destination;
+    destination.resize(source.size());
+    for (int i = 0; i < 10; ++i)
+        Gfx::convert_rgba_unpremultiplied_to_bgra_premultiplied(source, destination);
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteString.h>
+#include <AK/Vector.h>
+#include <LibGfx/DeferredPainter.h>
+#include <LibGfx/PaintStyle.h>
+#include <LibTest/TestCase.h>
+
+namespace {
+
+// Remembers the names of the operations it was asked to do.
+class LoggingPainter final : public Gfx::Painter {
+public:
+    explicit LoggingPainter(Vector<ByteString>& log)
+        : m_log(log)
+    {
+    }
+
+    virtual void clear_rect(Gfx::FloatRect const&, Gfx::Color) override { m_log.append("clear_rect"); }
+    virtual void fill_rect(Gfx::FloatRect const&, Gfx::Color) override { m_log.append("fill_rect"); }
+    virtual void draw_bitmap(Gfx::FloatRect const&, Gfx::Bitmap const&, Gfx::IntRect const&, Gfx::ScalingMode, float) override { m_log.append("draw_bitmap"); }
+    virtual void stroke_path(Gfx::Path const&, Gfx::Color, float) override { m_log.append("stroke_path"); }
+    virtual void stroke_path(Gfx::Path const&, Gfx::PaintStyle const&, float, float) override { m_log.append("stroke_path_with_style"); }
+    virtual void fill_path(Gfx::Path const&, Gfx::Color, Gfx::WindingRule) override { m_log.append("fill_path"); }
+    virtual void fill_path(Gfx::Path const&, Gfx::PaintStyle const&, float, Gfx::WindingRule) override { m_log.append("fill_path_with_style"); }
+    virtual void set_transform(Gfx::AffineTransform const&) override { m_log.append("set_transform"); }
+    virtual void save() override { m_log.append("save"); }
+    virtual void restore() override { m_log.append("restore"); }
+    virtual void clip(Gfx::Path const&, Gfx::WindingRule) override { m_log.append("clip"); }
+
+private:
+    Vector<ByteString>& m_log;
+};
+
+struct Setup {
+    Setup()
+        : painter(make<LoggingPainter>(log), { 100, 100 })
+    {
+    }
+
+    Vector<ByteString> log;
+    Gfx::DeferredPainter painter;
+};
+
+}
+
+TEST_CASE(records_until_flushed)
+{
+    Setup setup;
+    setup.painter.fill_path(Gfx::Path {}, Gfx::Color::Red, Gfx::WindingRule::Nonzero);
+    setup.painter.stroke_path(Gfx::Path {}, Gfx::Color::Blue, 1);
+    EXPECT(setup.log.is_empty());
+    EXPECT(setup.painter.has_pending_commands());
+
+    setup.painter.flush();
+    EXPECT_EQ(setup.log, (Vector<ByteString> { "fill_path", "stroke_path" }));
+    EXPECT(!setup.painter.has_pending_commands());
+}
+
+TEST_CASE(full_clear_drops_earlier_drawing)
+{
+    Setup setup;
+    setup.painter.save();
+    setup.painter.fill_path(Gfx::Path {}, Gfx::Color::Red, Gfx::WindingRule::Nonzero);
+    setup.painter.restore();
+    setup.painter.fill_rect({ 0, 0, 10, 10 }, Gfx::Color::Green);
+    setup.painter.clear_rect({ 0, 0, 100, 100 }, Gfx::Color::Transparent);
+    setup.painter.fill_path(Gfx::Path {}, Gfx::Color::Red, Gfx::WindingRule::Nonzero);
+    setup.painter.flush();
+    EXPECT_EQ(setup.log, (Vector<ByteString> { "save", "restore", "clear_rect", "fill_path" }));
+}
+
+TEST_CASE(partial_clear_keeps_earlier_drawing)
+{
+    Setup setup;
+    setup.painter.fill_path(Gfx::Path {}, Gfx::Color::Red, Gfx::WindingRule::Nonzero);
+    setup.painter.clear_rect({ 0, 0, 50, 100 }, Gfx::Color::Transparent);
+    setup.painter.flush();
+    EXPECT_EQ(setup.log, (Vector<ByteString> { "fill_path", "clear_rect" }));
+}
+
+TEST_CASE(translucent_fill_keeps_earlier_drawing)
+{
+    Setup setup;
+    setup.painter.fill_path(Gfx::Path {}, Gfx::Color::Red, Gfx::WindingRule::Nonzero);
+    setup.painter.fill_rect({ 0, 0, 100, 100 }, Gfx::Color(Gfx::Color::Red).with_alpha(128));
+    setup.painter.flush();
+    EXPECT_EQ(setup.log, (Vector<ByteString> { "fill_path", "fill_rect" }));
+}
+
+TEST_CASE(full_clear_respects_transform_and_clip)
+{
+    {
+        Setup setup;
+        setup.painter.fill_path(Gfx::Path {}, Gfx::Color::Red, Gfx::WindingRule::Nonzero);
+        setup.painter.set_transform(Gfx::AffineTransform {}.scale(2, 2));
+        setup.painter.clear_rect({ 0, 0, 50, 50 }, Gfx::Color::Transparent);
+        setup.painter.flush();
+        EXPECT_EQ(setup.log, (Vector<ByteString> { "set_transform", "clear_rect" }));
+    }
+    {
+        Setup setup;
+        setup.painter.fill_path(Gfx::Path {}, Gfx::Color::Red, Gfx::WindingRule::Nonzero);
+        setup.painter.set_transform(Gfx::AffineTransform {}.rotate_radians(1));
+        setup.painter.clear_rect({ -1000, -1000, 2000, 2000 }, Gfx::Color::Transparent);
+        setup.painter.flush();
+        EXPECT_EQ(setup.log, (Vector<ByteString> { "fill_path", "set_transform", "clear_rect" }));
+    }
+    {
+        Setup setup;
+        setup.painter.fill_path(Gfx::Path {}, Gfx::Color::Red, Gfx::WindingRule::Nonzero);
+        setup.painter.save();
+        setup.painter.clip(Gfx::Path {}, Gfx::WindingRule::Nonzero);
+        setup.painter.clear_rect({ 0, 0, 100, 100 }, Gfx::Color::Transparent);
+        setup.painter.restore();
+        setup.painter.clear_rect({ 0, 0, 100, 100 }, Gfx::Color::Transparent);
+        setup.painter.flush();
+        EXPECT_EQ(setup.log, (Vector<ByteString> { "save", "clip", "restore", "clear_rect" }));
+    }
+}
+
+TEST_CASE(consecutive_transforms_are_merged)
+{
+    Setup setup;
+    setup.painter.set_transform(Gfx::AffineTransform {}.translate(1, 1));
+    setup.painter.set_transform(Gfx::AffineTransform {}.translate(2, 2));
+    setup.painter.fill_path(Gfx::Path {}, Gfx::Color::Red, Gfx::WindingRule::Nonzero);
+    setup.painter.flush();
+    EXPECT_EQ(setup.log, (Vector<ByteString> { "set_transform", "fill_path" }));
+}
+
+TEST_CASE(paint_styles_are_not_deferred)
+{
+    Setup setup;
+    auto paint_style = MUST(Gfx::SolidColorPaintStyle::create(Gfx::Color::Red));
+    setup.painter.fill_path(Gfx::Path {}, Gfx::Color::Red, Gfx::WindingRule::Nonzero);
+    setup.painter.fill_path(Gfx::Path {}, *paint_style, 1, Gfx::WindingRule::Nonzero);
+    EXPECT_EQ(setup.log, (Vector<ByteString> { "fill_path", "fill_path_with_style" }));
+    EXPECT(!setup.painter.has_pending_commands());
+}
@@ -172,6 +172,78 @@ TEST_CASE(test_png)
     TRY_OR_FAIL((test_roundtrip<Gfx::PNGWriter, Gfx::PNGImageDecoderPlugin>(TRY_OR_FAIL(create_test_rgba_bitmap()))));
 }
 
+static ErrorOr<void> test_png_encoded_in_parallel(Gfx::Bitmap const& bitmap, Gfx::PNGWriter::Options options)
+{
+    options.encode_in_parallel = true;
+    auto encoded_data = TRY(encode_bitmap<Gfx::PNGWriter>(bitmap, options));
+    auto decoded = TRY(expect_single_frame_of_size(*TRY(Gfx::PNGImageDecoderPlugin::create(encoded_data)), bitmap.size()));
+    expect_bitmaps_equal(*decoded, bitmap);
+    return {};
+}
+
+TEST_CASE(test_png_encoded_in_parallel)
+{
+    TRY_OR_FAIL(test_png_encoded_in_parallel(TRY_OR_FAIL(create_test_rgb_bitmap()), {}));
+    TRY_OR_FAIL(test_png_encoded_in_parallel(TRY_OR_FAIL(create_test_rgba_bitmap()), {}));
+    TRY_OR_FAIL(test_png_encoded_in_parallel(TRY_OR_FAIL(create_test_rgba_bitmap()), { .compression_level = 0 }));
+    TRY_OR_FAIL(test_png_encoded_in_parallel(TRY_OR_FAIL(create_test_rgba_bitmap()), { .compression_level = 9 }));
+
+    // Large enough to be compressed in several chunks.
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 1024, 512 }));
+    for (int y = 0; y < bitmap->height(); ++y)
+        for (int x = 0; x < bitmap->width(); ++x)
+            bitmap->set_pixel(x, y, (x / 64 + y / 32) % 2 ? Gfx::Color(x, y, 255 - x) : Gfx::Color(Gfx::Color::NamedColor::White));
+    TRY_OR_FAIL(test_png_encoded_in_parallel(bitmap, {}));
+}
+
+TEST_CASE(test_png_encoded_in_parallel_icc)
+{
+    auto sRGB_icc_profile = MUST(Gfx::ICC::sRGB());
+    auto sRGB_icc_data = MUST(Gfx::ICC::encode(sRGB_icc_profile));
+
+    auto rgba_bitmap = TRY_OR_FAIL(create_test_rgba_bitmap());
+    auto encoded_rgba_bitmap = TRY_OR_FAIL((encode_bitmap<Gfx::PNGWriter>(rgba_bitmap, Gfx::PNGWriter::Options { .icc_data = sRGB_icc_data.bytes(), .encode_in_parallel = true })));
+
+    auto decoded_rgba_plugin = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(encoded_rgba_bitmap));
+    expect_bitmaps_equal(*TRY_OR_FAIL(expect_single_frame_of_size(*decoded_rgba_plugin, rgba_bitmap->size())), rgba_bitmap);
+    auto decoded_rgba_profile = TRY_OR_FAIL(Gfx::ICC::Profile::try_load_from_externally_owned_memory(TRY_OR_FAIL(decoded_rgba_plugin->icc_data()).value()));
+    auto reencoded_icc_data = TRY_OR_FAIL(Gfx::ICC::encode(decoded_rgba_profile));
+    EXPECT_EQ(sRGB_icc_data, reencoded_icc_data);
+}
+
+// Something that looks like a screenshot of a page: mostly flat colors, with some text-like noise and an image.
+static NonnullRefPtr<Gfx::Bitmap> create_4k_screenshot_bitmap()
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 3840, 2160 }));
+    for (int y = 0; y < bitmap->height(); ++y) {
+        for (int x = 0; x < bitmap->width(); ++x) {
+            Gfx::Color color = Gfx::Color::NamedColor::White;
+            if (y < 120)
+                color = Gfx::Color(40, 44, 52);
+            else if (x >= 2400 && x < 3600 && y >= 400 && y < 1200)
+                color = Gfx::Color(x, y, x ^ y);
+            else if ((y / 40) % 2 && ((x * 7 + y * 13) % 11) < 3)
+                color = Gfx::Color::NamedColor::Black;
+            bitmap->set_pixel(x, y, color);
+        }
+    }
+    return bitmap;
+}
+
+BENCHMARK_CASE(encode_4k_screenshot_png)
+{
+    auto bitmap = create_4k_screenshot_bitmap();
+    for (int i = 0; i < 3; ++i)
+        (void)MUST(Gfx::PNGWriter::encode(bitmap));
+}
+
+BENCHMARK_CASE(encode_4k_screenshot_png_in_parallel)
+{
+    auto bitmap = create_4k_screenshot_bitmap();
+    for (int i = 0; i < 3; ++i)
+        (void)MUST(Gfx::PNGWriter::encode(bitmap, { .compression_level = 1, .encode_in_parallel = true }));
+}
+
 TEST_CASE(test_webp)
 {
     TRY_OR_FAIL((test_roundtrip<Gfx::WebPWriter, Gfx::WebPImageDecoderPlugin>(TRY_OR_FAIL(create_test_rgb_bitmap()))));
@@ -18,6 +18,9 @@
 #include <LibFileSystem/FileSystem.h>
 #include <LibMain/Main.h>
 #include <LibTest/TestRunnerUtil.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+#include <signal.h>
 
 enum class TestResult {
     Passed,
@@ -107,15 +110,21 @@ static StringView emoji_for_result(TestResult result)
 
 static constexpr StringView total_test_emoji = "🧪"sv;
 
-static ErrorOr<HashMap<size_t, TestResult>> run_test_files(Span<ByteString> files, size_t offset, StringView command, char const* const arguments[])
+struct TestOutcome {
+    TestResult result { TestResult::RunnerFailure };
+    // Only known if the runner reported on the test, i.e. not for tests that crashed or timed out.
+    Optional<i64> duration_in_ms {};
+};
+
+static ErrorOr<HashMap<size_t, TestOutcome>> run_test_files(Span<ByteString> files, size_t offset, StringView command, char const* const arguments[])
 {
-    HashMap<size_t, TestResult> results {};
+    HashMap<size_t, TestOutcome> results {};
     TRY(results.try_ensure_capacity(files.size()));
     size_t test_index = 0;
 
     auto fail_all_after = [&] {
         for (; test_index < files.size(); ++test_index)
-            results.set(offset + test_index, TestResult::RunnerFailure);
+            results.set(offset + test_index, { TestResult::RunnerFailure });
     };
 
     while (test_index < files.size()) {
@@ -138,7 +147,7 @@ static ErrorOr<HashMap<size_t, TestResult>> run_test_files(Span<ByteString> file
         if (output_or_error.is_error())
             warnln("Got error: {} while reading runner output", output_or_error.error());
         else
-            output = ByteString(output_or_error.release_value().standard_error.bytes(), Chomp);
+            output = ByteString(output_or_error.release_value().standard_output.bytes(), Chomp);
 
         auto status_or_error = runner_process->status();
         bool failed = false;
@@ -158,7 +167,7 @@ static ErrorOr<HashMap<size_t, TestResult>> run_test_files(Span<ByteString> file
 
             line = line.substring_view(7).trim("\n\0 "sv);
             JsonParser parser { line };
-            TestResult result = TestResult::RunnerFailure;
+            TestOutcome outcome {};
             auto result_object_or_error = parser.parse();
             if (!result_object_or_error.is_error() && result_object_or_error.value().is_object()) {
                 auto& result_object = result_object_or_error.value().as_object();
@@ -169,11 +178,12 @@ static ErrorOr<HashMap<size_t, TestResult>> run_test_files(Span<ByteString> file
                         failed = false;
                     }
 
-                    result = result_from_string(view);
+                    outcome.result = result_from_string(view);
                 }
+                outcome.duration_in_ms = result_object.get_i64("duration"sv);
             }
 
-            results.set(test_for_line + offset, result);
+            results.set(test_for_line + offset, outcome);
         }
 
         if (failed) {
@@ -182,7 +192,7 @@ static ErrorOr<HashMap<size_t, TestResult>> run_test_files(Span<ByteString> file
                 result = TestResult::TimeoutError;
             }
             // assume the last test failed, if by SIGALRM signal it's a timeout
-            results.set(test_index + offset, result);
+            results.set(test_index + offset, { result });
             ++test_index;
         }
     }
@@ -190,7 +200,8 @@ static ErrorOr<HashMap<size_t, TestResult>> run_test_files(Span<ByteString> file
     return results;
 }
 
-void write_per_file(HashMap<size_t, TestResult> const& result_map, Vector<ByteString> const& paths, StringView per_file_name, double time_taken_in_ms);
+void write_per_file(HashMap<size_t, TestOutcome> const& result_map, Vector<ByteString> const& paths, StringView per_file_name, double time_taken_in_ms);
+void print_slowest_tests(HashMap<size_t, TestOutcome> const& result_map, Vector<ByteString> const& paths, size_t count);
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
@@ -201,6 +212,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     StringView test_directory;
     bool dont_print_progress = false;
     bool dont_disable_core_dump = false;
+    size_t jobs = 1;
+    Optional<size_t> timeout_in_seconds;
+    size_t slowest_test_count = 0;
 
     Core::ArgsParser args_parser;
     args_parser.add_positional_argument(test_directory, "Directory to search for tests", "tests");
@@ -210,8 +224,16 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(pass_through_parameters, "Parameters to pass through to the runner, will split on spaces", "pass-through", 'p', "parameters");
     args_parser.add_option(dont_print_progress, "Hide progress information", "quiet", 'q');
     args_parser.add_option(dont_disable_core_dump, "Enabled core dumps for runner (i.e. don't pass --disable-core-dump)", "enable-core-dumps");
+    args_parser.add_option(jobs, "Number of runner processes to run concurrently", "jobs", 'j', "jobs");
+    args_parser.add_option(timeout_in_seconds, "Seconds before a single test should timeout (uses the runner's default if not given)", "timeout", 't', "seconds");
+    args_parser.add_option(slowest_test_count, "Show the given number of slowest tests when done", "show-slowest", 's', "count");
     args_parser.parse(arguments);
 
+    if (jobs == 0) {
+        warnln("jobs must be at least 1");
+        return 1;
+    }
+
     // Normalize the path to ensure filenames are consistent
     Vector<ByteString> paths;
 
@@ -231,10 +253,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     auto parameters = pass_through_parameters.split_view(' ');
     Vector<ByteString> args;
-    args.ensure_capacity(parameters.size() + 2);
+    args.ensure_capacity(parameters.size() + 4);
     args.append(runner_command);
     if (!dont_disable_core_dump)
         args.append("--disable-core-dump"sv);
+    if (timeout_in_seconds.has_value()) {
+        args.append("--timeout"sv);
+        args.append(ByteString::number(*timeout_in_seconds));
+    }
 
     for (auto parameter : parameters)
         args.append(parameter);
@@ -248,7 +274,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     dbgln("test262 runner command: {}", args);
 
-    HashMap<size_t, TestResult> results;
+    HashMap<size_t, TestOutcome> results;
     Array<size_t, 9> result_counts {};
     static_assert(result_counts.size() == static_cast<size_t>(TestResult::TodoError) + 1u);
     size_t index = 0;
@@ -268,20 +294,71 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         }
     };
 
-    while (index < paths.size()) {
-        print_progress();
-        auto this_batch_size = min(batch_size, paths.size() - index);
-        auto batch_results = TRY(run_test_files(paths.span().slice(index, this_batch_size), index, args[0], raw_args.data()));
+    // Each batch is run by its own runner process, so a crashing runner only takes down the test it was running.
+    // With multiple jobs, that many batches are in flight at once, each driven by a thread of its own.
+    Threading::Mutex mutex;
+    size_t next_batch_start = 0;
+    Optional<Error> batch_error;
+
+    auto run_batches = [&]() -> intptr_t {
+        while (true) {
+            size_t batch_start = 0;
+            size_t this_batch_size = 0;
+            {
+                Threading::MutexLocker locker { mutex };
+                if (next_batch_start >= paths.size() || batch_error.has_value())
+                    return 0;
+                batch_start = next_batch_start;
+                this_batch_size = min(batch_size, paths.size() - batch_start);
+                next_batch_start += this_batch_size;
+            }
+
+            auto batch_results_or_error = run_test_files(paths.span().slice(batch_start, this_batch_size), batch_start, args[0], raw_args.data());
 
-        TRY(results.try_ensure_capacity(results.size() + batch_results.size()));
-        for (auto& [key, value] : batch_results) {
-            results.set(key, value);
-            ++result_counts[static_cast<size_t>(value)];
+            Threading::MutexLocker locker { mutex };
+            if (batch_results_or_error.is_error()) {
+                batch_error = batch_results_or_error.release_error();
+                return 1;
+            }
+
+            auto& batch_results = batch_results_or_error.value();
+            if (auto result = results.try_ensure_capacity(results.size() + batch_results.size()); result.is_error()) {
+                batch_error = result.release_error();
+                return 1;
+            }
+            for (auto& [key, value] : batch_results) {
+                results.set(key, value);
+                ++result_counts[static_cast<size_t>(value.result)];
+            }
+
+            index += this_batch_size;
+            print_progress();
         }
+    };
 
-        index += this_batch_size;
+    print_progress();
+    if (jobs == 1) {
+        run_batches();
+    } else {
+        // Core::Command temporarily ignores SIGPIPE while writing to a runner, and restores the previous handler after.
+        // Ignore it for the whole process up front, so that concurrent writes can't restore the default handler for
+        // each other.
+        signal(SIGPIPE, SIG_IGN);
+
+        Vector<NonnullRefPtr<Threading::Thread>> threads;
+        threads.ensure_capacity(jobs);
+        for (size_t i = 0; i < jobs; ++i) {
+            auto thread = Threading::Thread::construct([&] { return run_batches(); }, "test262 batch"sv);
+            thread->start();
+            threads.unchecked_append(move(thread));
+        }
+        for (auto& thread : threads)
+            (void)thread->join();
     }
 
+    if (batch_error.has_value())
+        return batch_error.release_value();
+
     double time_taken_in_ms = Test::get_time_in_ms() - start_time;
 
     print_progress();
@@ -295,13 +372,35 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         outln("{}: {} ({:3.2f}%)", emoji_for_result(result_type), result_counts[i], 100. * static_cast<double>(result_counts[i]) / paths.size());
     }
 
+    if (slowest_test_count != 0)
+        print_slowest_tests(results, paths, slowest_test_count);
+
     if (!per_file_location.is_empty())
         write_per_file(results, paths, per_file_location, time_taken_in_ms);
 
     return 0;
 }
 
-void write_per_file(HashMap<size_t, TestResult> const& result_map, Vector<ByteString> const& paths, StringView per_file_name, double time_taken_in_ms)
+void print_slowest_tests(HashMap<size_t, TestOutcome> const& result_map, Vector<ByteString> const& paths, size_t count)
+{
+    Vector<size_t> timed_tests;
+    for (auto& [test, value] : result_map) {
+        if (value.duration_in_ms.has_value())
+            timed_tests.append(test);
+    }
+
+    quick_sort(timed_tests, [&](size_t a, size_t b) {
+        return result_map.get(a)->duration_in_ms.value() > result_map.get(b)->duration_in_ms.value();
+    });
+
+    outln("Slowest tests:");
+    for (size_t i = 0; i < min(count, timed_tests.size()); ++i) {
+        auto test = timed_tests[i];
+        outln("{:>8}ms {}", result_map.get(test)->duration_in_ms.value(), paths[test]);
+    }
+}
+
+void write_per_file(HashMap<size_t, TestOutcome> const& result_map, Vector<ByteString> const& paths, StringView per_file_name, double time_taken_in_ms)
 {
 
     auto file_or_error = Core::File::open(per_file_name, Core::File::OpenMode::Write);
@@ -314,7 +413,7 @@ void write_per_file(HashMap<size_t, TestResult> const& result_map, Vector<ByteSt
 
     JsonObject result_object;
     for (auto& [test, value] : result_map)
-        result_object.set(paths[test], name_for_result(value));
+        result_object.set(paths[test], name_for_result(value.result));
 
     JsonObject complete_results {};
     complete_results.set("duration", time_taken_in_ms / 1000.);
@@ -12,6 +12,7 @@
 #include <AK/ScopeGuard.h>
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/File.h>
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Generator.h>
@@ -732,7 +733,10 @@ int main(int argc, char** argv)
         JsonObject result_object;
         result_object.set("test", path);
 
+        auto test_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+
         ScopeGuard output_guard = [&] {
+            result_object.set("duration", test_timer.elapsed_milliseconds());
             outln(saved_stdout_fd, "RESULT {}{}", result_object.to_byte_string(), '\0');
             fflush(saved_stdout_fd);
         };
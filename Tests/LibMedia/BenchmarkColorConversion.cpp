@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibMedia/Color/ColorConverter.h>
+#include <LibMedia/VideoFrame.h>
+#include <LibTest/TestCase.h>
+
+static constexpr auto output_cicp = Media::CodingIndependentCodePoints(Media::ColorPrimaries::BT709, Media::TransferCharacteristics::SRGB, Media::MatrixCoefficients::BT709, Media::VideoFullRangeFlag::Full);
+
+// Rows that go through every sample value. The odd width makes sure some pixels are left over after the vectorized loop.
+template<typename T>
+static void expect_row_conversion_matches_per_pixel_conversion(u8 bit_depth, Media::CodingIndependentCodePoints cicp)
+{
+    auto converter = MUST(Media::ColorConverter::create(bit_depth, cicp, output_cicp));
+
+    u32 maximum_value = (1u << bit_depth) - 1;
+    Vector<T> y_row;
+    Vector<T> u_row;
+    Vector<T> v_row;
+    for (u32 i = 0; i <= maximum_value; ++i) {
+        y_row.append(i);
+        u_row.append((i * 7) & maximum_value);
+        v_row.append((i * 13) & maximum_value);
+    }
+    y_row.append(maximum_value / 2);
+    u_row.append(maximum_value / 2);
+    v_row.append(maximum_value / 2);
+
+    Vector<u32> output;
+    output.resize(y_row.size());
+    converter.convert_row(y_row.data(), u_row.data(), v_row.data(), output.data(), output.size());
+
+    for (size_t i = 0; i < output.size(); ++i) {
+        auto expected = converter.convert_yuv(y_row[i], u_row[i], v_row[i]);
+        auto actual = Gfx::Color::from_argb(output[i]);
+        // NOTE: The order of the floating point operations may differ slightly between the two, and that is allowed
+        //       to round a channel one step the other way.
+        EXPECT(abs(actual.red() - expected.red()) <= 1);
+        EXPECT(abs(actual.green() - expected.green()) <= 1);
+        EXPECT(abs(actual.blue() - expected.blue()) <= 1);
+        EXPECT_EQ(actual.alpha(), 255);
+    }
+}
+
+TEST_CASE(row_conversion)
+{
+    for (auto matrix_coefficients : { Media::MatrixCoefficients::BT601, Media::MatrixCoefficients::BT709, Media::MatrixCoefficients::BT2020NonConstantLuminance }) {
+        for (auto range : { Media::VideoFullRangeFlag::Studio, Media::VideoFullRangeFlag::Full }) {
+            // The sRGB transfer characteristics match the output and skip the remapping, while BT.709 has to be remapped.
+            for (auto transfer_characteristics : { Media::TransferCharacteristics::SRGB, Media::TransferCharacteristics::BT709 }) {
+                Media::CodingIndependentCodePoints cicp(Media::ColorPrimaries::BT709, transfer_characteristics, matrix_coefficients, range);
+                expect_row_conversion_matches_per_pixel_conversion<u8>(8, cicp);
+                expect_row_conversion_matches_per_pixel_conversion<u16>(10, cicp);
+            }
+        }
+    }
+}
+
+template<typename T>
+static NonnullOwnPtr<Media::SubsampledYUVFrame> create_frame(Gfx::Size<u32> size, u8 bit_depth, Media::Subsampling subsampling)
+{
+    Media::CodingIndependentCodePoints cicp(Media::ColorPrimaries::BT709, Media::TransferCharacteristics::BT709, Media::MatrixCoefficients::BT709, Media::VideoFullRangeFlag::Studio);
+    auto frame = MUST(Media::SubsampledYUVFrame::try_create({}, size, bit_depth, cicp, subsampling));
+
+    u32 maximum_value = (1u << bit_depth) - 1;
+    auto fill_plane = [&](u32 plane, Gfx::Size<u32> plane_size) {
+        auto* data = frame->get_plane_data<T>(plane);
+        for (u32 i = 0; i < plane_size.width() * plane_size.height(); ++i)
+            data[i] = static_cast<T>((i * (plane + 1)) & maximum_value);
+    };
+    fill_plane(0, size);
+    fill_plane(1, subsampling.subsampled_size(size));
+    fill_plane(2, subsampling.subsampled_size(size));
+    return frame;
+}
+
+BENCHMARK_CASE(yuv420_8_bit_4k)
+{
+    auto frame = create_frame<u8>({ 3840, 2160 }, 8, { true, true });
+    for (int i = 0; i < 10; ++i)
+        MUST(frame->to_bitmap());
+}
+
+BENCHMARK_CASE(yuv422_8_bit_1080p)
+{
+    auto frame = create_frame<u8>({ 1920, 1080 }, 8, { true, false });
+    for (int i = 0; i < 10; ++i)
+        MUST(frame->to_bitmap());
+}
+
+BENCHMARK_CASE(yuv420_10_bit_4k)
+{
+    auto frame = create_frame<u16>({ 3840, 2160 }, 10, { true, true });
+    for (int i = 0; i < 10; ++i)
+        MUST(frame->to_bitmap());
+}
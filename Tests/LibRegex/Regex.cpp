@@ -1221,3 +1221,52 @@ TEST_CASE(mismatching_brackets)
         EXPECT_EQ(re.parser_result.error, regex::Error::MismatchingBracket);
     }
 }
+
+TEST_CASE(deep_backtracking_reuses_fork_states)
+{
+    // Every character forks here, and most forks are tried and discarded before the match fails;
+    // make sure the results are unaffected by the fork states being recycled.
+    Regex<ECMA262> re("^(a|ab)*c$");
+    auto subject = ByteString::repeated('a', 2000);
+
+    auto result = re.match(subject.view());
+    EXPECT_EQ(result.success, false);
+
+    auto matching_subject = ByteString::formatted("{}c", subject);
+    result = re.match(matching_subject.view());
+    EXPECT_EQ(result.success, true);
+    EXPECT_EQ(result.matches.first().view.length(), 2001u);
+}
+
+TEST_CASE(starting_ranges_prefilter)
+{
+    struct _test {
+        StringView pattern;
+        StringView subject;
+        bool matches;
+        StringView first_match;
+        size_t match_count;
+    };
+
+    auto const tests = Array {
+        _test { "foo|bar"sv, "xxxxbarxxfooxx"sv, true, "bar"sv, 2 },
+        _test { "(a+)c"sv, "bbbbaac"sv, true, "aac"sv, 1 },
+        _test { "[x-z]1"sv, "ab1y1z"sv, true, "y1"sv, 1 },
+        _test { "a*b"sv, "cccb"sv, true, "b"sv, 1 },
+        _test { "q+x"sv, "no such thing"sv, false, ""sv, 0 },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.pattern, ECMAScriptFlags::Global);
+        EXPECT(re.parser_result.error == regex::Error::NoError);
+        auto result = re.match(test.subject);
+        EXPECT_EQ(result.success, test.matches);
+        EXPECT_EQ(result.count, test.match_count);
+        if (test.matches)
+            EXPECT_EQ(result.matches.first().view, test.first_match);
+    }
+
+    // Non-global patterns must not skip ahead, only reject the starting position.
+    Regex<ECMA262> re("ba+r", ECMAScriptFlags::Sticky);
+    EXPECT_EQ(re.match("xbar"sv).success, false);
+}
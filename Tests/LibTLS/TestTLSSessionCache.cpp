@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTLS/SessionCache.h>
+#include <LibTest/TestCase.h>
+
+static constexpr Array cipher_suites { TLS::CipherSuite::TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256, TLS::CipherSuite::TLS_RSA_WITH_AES_128_GCM_SHA256 };
+static auto const example_key = TLS::SessionCache::key_for("example.com"sv, 443, cipher_suites, true);
+static auto const other_host_key = TLS::SessionCache::key_for("example.org"sv, 443, cipher_suites, true);
+
+static TLS::Session make_session(u8 id)
+{
+    return {
+        .session_id = MUST(ByteBuffer::create_zeroed(32)),
+        .master_key = MUST(ByteBuffer::copy(Array<u8, 4> { id, id, id, id }.span())),
+        .cipher = TLS::CipherSuite::TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256,
+        .extended_master_secret = true,
+    };
+}
+
+TEST_CASE(test_session_cache_find_and_store)
+{
+    auto& cache = TLS::SessionCache::the();
+    cache.clear();
+
+    EXPECT(!cache.find(example_key).has_value());
+    EXPECT_EQ(cache.statistics().misses, 1u);
+
+    cache.store(example_key, make_session(1));
+    auto session = cache.find(example_key);
+    EXPECT(session.has_value());
+    EXPECT_EQ(session->master_key[0], 1);
+    EXPECT_EQ(session->cipher, TLS::CipherSuite::TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256);
+    EXPECT(session->extended_master_secret);
+    EXPECT(!cache.find(other_host_key).has_value());
+
+    cache.did_resume();
+    EXPECT_EQ(cache.statistics().hits, 1u);
+    EXPECT_EQ(cache.statistics().misses, 2u);
+}
+
+TEST_CASE(test_session_cache_forgets_declined_sessions)
+{
+    auto& cache = TLS::SessionCache::the();
+    cache.clear();
+
+    cache.store(example_key, make_session(1));
+    cache.did_not_resume(example_key);
+    EXPECT_EQ(cache.statistics().misses, 1u);
+    EXPECT(!cache.find(example_key).has_value());
+}
+
+TEST_CASE(test_session_cache_evicts_oldest_session)
+{
+    auto& cache = TLS::SessionCache::the();
+    cache.clear();
+
+    for (size_t i = 0; i < TLS::SessionCache::max_entries; ++i) {
+        auto session = make_session(static_cast<u8>(i));
+        session.established_time = MonotonicTime::now_coarse() + AK::Duration::from_milliseconds(i);
+        cache.store(ByteString::formatted("host{}", i), move(session));
+    }
+    cache.store("newcomer", make_session(0));
+
+    EXPECT(!cache.find("host0"sv).has_value());
+    EXPECT(cache.find("host1"sv).has_value());
+    EXPECT(cache.find("newcomer"sv).has_value());
+}
+
+TEST_CASE(test_session_cache_keys_depend_on_port_and_options)
+{
+    auto& cache = TLS::SessionCache::the();
+    cache.clear();
+
+    cache.store(example_key, make_session(1));
+    EXPECT(cache.find(TLS::SessionCache::key_for("example.com"sv, 443, cipher_suites, true)).has_value());
+    EXPECT(!cache.find(TLS::SessionCache::key_for("example.com"sv, 8443, cipher_suites, true)).has_value());
+    EXPECT(!cache.find(TLS::SessionCache::key_for("example.com"sv, 443, cipher_suites, false)).has_value());
+    EXPECT(!cache.find(TLS::SessionCache::key_for("example.com"sv, 443, ReadonlySpan<TLS::CipherSuite> { cipher_suites }.slice(1), true)).has_value());
+}
@@ -70,3 +70,23 @@ TEST_CASE(test_utf16le_decode)
     auto utf8 = MUST(decoder.to_utf8(test_string));
     EXPECT_EQ(utf8, "säk😀"sv);
 }
+
+TEST_CASE(test_latin1_decode)
+{
+    auto decoder = TextCodec::decoder_for_exact_name("iso-8859-1"sv);
+    EXPECT(decoder.has_value());
+
+    EXPECT_EQ(MUST(decoder->to_utf8("plain ASCII"sv)), "plain ASCII"sv);
+    EXPECT_EQ(MUST(decoder->to_utf8("caf\xe9 \x80\xff"sv)), "café \u0080ÿ"sv);
+}
+
+TEST_CASE(test_windows1252_decode)
+{
+    auto decoder = TextCodec::decoder_for_exact_name("windows-1252"sv);
+    EXPECT(decoder.has_value());
+
+    EXPECT_EQ(MUST(decoder->to_utf8(""sv)), ""sv);
+    EXPECT_EQ(MUST(decoder->to_utf8("plain ASCII"sv)), "plain ASCII"sv);
+    EXPECT_EQ(MUST(decoder->to_utf8("\x80 for a caf\xe9"sv)), "€ for a café"sv);
+    EXPECT_EQ(MUST(decoder->to_utf8("\x93quoted\x94"sv)), "“quoted”"sv);
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/FixedArray.h>
+#include <AK/QuickSort.h>
+#include <LibCore/EventLoop.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/ThreadPool.h>
+#include <pthread.h>
+#include <unistd.h>
+
+static void wait_until(Function<bool()> condition)
+{
+    for (auto i = 0; i < 500; ++i) {
+        if (condition())
+            return;
+        usleep(10 * 1000);
+    }
+
+    FAIL("Timed out waiting for the work to run");
+}
+
+TEST_CASE(runs_all_enqueued_work)
+{
+    auto pool = MUST(Threading::ThreadPool::create("TestThreadPool"sv, 4));
+    EXPECT_EQ(pool->thread_count(), 4u);
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<int> counter = 0;
+    for (auto i = 0; i < 100; ++i)
+        pool->enqueue([&counter] { counter.fetch_add(1); });
+
+    wait_until([&] { return counter.load() == 100; });
+}
+
+TEST_CASE(high_priority_work_goes_first)
+{
+    auto pool = MUST(Threading::ThreadPool::create("TestThreadPool"sv, 1));
+
+    // Keep the only thread busy until everything else has been enqueued.
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> may_continue = false;
+    pool->enqueue([&may_continue] {
+        while (!may_continue.load())
+            usleep(1000);
+    });
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Threading::Mutex mutex;
+    IGNORE_USE_IN_ESCAPING_LAMBDA Vector<int> order;
+    auto record = [&](int value) {
+        return [&mutex, &order, value] {
+            Threading::MutexLocker locker(mutex);
+            order.append(value);
+        };
+    };
+    pool->enqueue(record(1));
+    pool->enqueue(record(2), Threading::ThreadPool::Priority::High);
+    pool->enqueue(record(3), Threading::ThreadPool::Priority::Low);
+    pool->enqueue(record(4));
+    pool->enqueue(record(5), Threading::ThreadPool::Priority::High);
+    may_continue.store(true);
+
+    wait_until([&] {
+        Threading::MutexLocker locker(mutex);
+        return order.size() == 5;
+    });
+    EXPECT_EQ(order, (Vector<int> { 2, 5, 1, 4, 3 }));
+}
+
+TEST_CASE(parallel_for_visits_every_index_once)
+{
+    auto pool = MUST(Threading::ThreadPool::create("TestThreadPool"sv, 4));
+
+    for (size_t grain_size : { 1, 7, 1000, 100000 }) {
+        auto visits = MUST(FixedArray<Atomic<int>>::create(10007));
+        pool->parallel_for(0, visits.size(), [&](size_t index) { visits[index].fetch_add(1); }, grain_size);
+        for (auto& visit_count : visits)
+            EXPECT_EQ(visit_count.load(), 1);
+    }
+
+    pool->parallel_for(5, 5, [](size_t) { FAIL("Called for an empty range"); });
+}
+
+TEST_CASE(parallel_for_can_be_nested)
+{
+    auto pool = MUST(Threading::ThreadPool::create("TestThreadPool"sv, 2));
+
+    Atomic<u64> total = 0;
+    pool->parallel_for(0, 64, [&](size_t i) {
+        pool->parallel_for(0, 1000, [&](size_t j) { total.fetch_add(i * j); });
+    });
+    EXPECT_EQ(total.load(), (63u * 64 / 2) * (999u * 1000 / 2));
+}
+
+static u64 fibonacci(Threading::ThreadPool& pool, u64 n)
+{
+    if (n < 2)
+        return n;
+    if (n < 16)
+        return fibonacci(pool, n - 1) + fibonacci(pool, n - 2);
+
+    u64 a = 0;
+    u64 b = 0;
+    pool.parallel_invoke(
+        [&] { a = fibonacci(pool, n - 1); },
+        [&] { b = fibonacci(pool, n - 2); });
+    return a + b;
+}
+
+TEST_CASE(parallel_invoke_runs_every_callback)
+{
+    auto pool = MUST(Threading::ThreadPool::create("TestThreadPool"sv, 4));
+    EXPECT_EQ(fibonacci(*pool, 25), 75025u);
+}
+
+TEST_CASE(results_are_delivered_to_the_event_loop)
+{
+    Core::EventLoop loop;
+    auto pool = MUST(Threading::ThreadPool::create("TestThreadPool"sv, 2));
+
+    auto main_thread = pthread_self();
+    Vector<int> results;
+    for (auto i = 0; i < 10; ++i) {
+        pool->enqueue_with_completion(
+            [i] { return i * i; },
+            [&](int result) {
+                EXPECT(pthread_equal(pthread_self(), main_thread));
+                results.append(result);
+                if (results.size() == 10)
+                    loop.quit(0);
+            });
+    }
+    loop.exec();
+
+    quick_sort(results);
+    EXPECT_EQ(results, (Vector<int> { 0, 1, 4, 9, 16, 25, 36, 49, 64, 81 }));
+}
+
+BENCHMARK_CASE(many_small_tasks)
+{
+    auto& pool = Threading::ThreadPool::the();
+
+    Atomic<u64> sum = 0;
+    for (auto i = 0; i < 100; ++i) {
+        pool.parallel_for(0, 100'000, [&](size_t index) {
+            sum.fetch_add(index, AK::MemoryOrder::memory_order_relaxed);
+        },
+            1000);
+    }
+    EXPECT_EQ(sum.load(), 100u * (99'999u * 100'000 / 2));
+}
+
+BENCHMARK_CASE(recursive_fan_out)
+{
+    EXPECT_EQ(fibonacci(Threading::ThreadPool::the(), 32), 2178309u);
+}
@@ -531,3 +531,67 @@ TEST_CASE(invalid_domain_code_points)
         EXPECT(!url.is_valid());
     }
 }
+
+TEST_CASE(normalized_url)
+{
+    {
+        auto url = URL::Parser::basic_parse("https://www.example.com:8080/a/b/?c=d&e#f"sv);
+        EXPECT(url.is_valid());
+        EXPECT_EQ(url.scheme(), "https");
+        EXPECT_EQ(MUST(url.serialized_host()), "www.example.com"sv);
+        EXPECT_EQ(url.port(), 8080);
+        EXPECT_EQ(url.paths().size(), 3u);
+        EXPECT_EQ(url.paths()[2], ""sv);
+        EXPECT_EQ(url.query(), "c=d&e");
+        EXPECT_EQ(url.fragment(), "f");
+        EXPECT_EQ(url.serialize(), "https://www.example.com:8080/a/b/?c=d&e#f");
+    }
+
+    // The default port is dropped, and an empty path becomes a single empty path segment.
+    {
+        auto url = URL::Parser::basic_parse("http://example.com:80?q"sv);
+        EXPECT(url.is_valid());
+        EXPECT(!url.port().has_value());
+        EXPECT_EQ(url.paths().size(), 1u);
+        EXPECT_EQ(url.serialize(), "http://example.com/?q");
+    }
+
+    {
+        auto url = URL::Parser::basic_parse("http://example.com:/#"sv);
+        EXPECT(url.is_valid());
+        EXPECT(!url.port().has_value());
+        EXPECT_EQ(url.fragment(), "");
+        EXPECT_EQ(url.serialize(), "http://example.com/#");
+    }
+
+    // These look like the URLs above, but aren't normalized.
+    EXPECT_EQ(URL::Parser::basic_parse("http://example.com/a/./b/../c"sv).serialize(), "http://example.com/a/c");
+    EXPECT_EQ(URL::Parser::basic_parse("http://example.com/%2e%2E/a"sv).serialize(), "http://example.com/a");
+    EXPECT_EQ(URL::Parser::basic_parse("http://example.com/a\\b"sv).serialize(), "http://example.com/a/b");
+    EXPECT_EQ(URL::Parser::basic_parse("http://example.com/{a}?'b'#`c`"sv).serialize(), "http://example.com/%7Ba%7D?%27b%27#%60c%60");
+    EXPECT_EQ(URL::Parser::basic_parse("http://0x7f.1/"sv).serialize(), "http://127.0.0.1/");
+    EXPECT_EQ(URL::Parser::basic_parse("http://a.b.1/"sv).is_valid(), false);
+    EXPECT_EQ(URL::Parser::basic_parse("http://example.com:65536/"sv).is_valid(), false);
+    EXPECT_EQ(URL::Parser::basic_parse("http://user@example.com/"sv).serialize(), "http://user@example.com/");
+}
+
+BENCHMARK_CASE(parse_normalized_urls)
+{
+    constexpr Array urls {
+        "https://en.wikipedia.org/wiki/Main_Page"sv,
+        "https://www.google.com/search?q=ladybird+browser&hl=en"sv,
+        "https://github.com/LadybirdBrowser/ladybird/pull/1234/files#diff-0123456789abcdef"sv,
+        "http://example.com:8080/path/to/resource.png?size=large"sv,
+        "https://fonts.googleapis.com/css2?family=Roboto:wght@400;700&display=swap"sv,
+        "https://cdn.jsdelivr.net/npm/bootstrap@5.3.0/dist/css/bootstrap.min.css"sv,
+        "https://www.youtube.com/watch?v=dQw4w9WgXcQ&t=42s"sv,
+        "https://news.ycombinator.com/item?id=12345678"sv,
+        "wss://socket.example.org/chat"sv,
+        "https://www.example.com/"sv,
+    };
+
+    for (size_t i = 0; i < 100'000; ++i) {
+        for (auto url : urls)
+            EXPECT(URL::Parser::basic_parse(url).is_valid());
+    }
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+
+static constexpr auto page_size = Wasm::Constants::page_size;
+
+TEST_CASE(memory_only_reserves_its_initial_size)
+{
+    auto memory = TRY_OR_FAIL(Wasm::MemoryInstance::create(Wasm::MemoryType { Wasm::Limits(1, 65536) }));
+    EXPECT_EQ(memory.size(), page_size);
+    EXPECT(memory.data().capacity() < 2 * page_size);
+}
+
+TEST_CASE(growing_memory_zeroes_new_pages)
+{
+    auto memory = TRY_OR_FAIL(Wasm::MemoryInstance::create(Wasm::MemoryType { Wasm::Limits(1, 65536) }));
+    memory.data().bytes().fill(0xff);
+
+    for (size_t i = 0; i < 64; ++i)
+        EXPECT(memory.grow(page_size));
+
+    EXPECT_EQ(memory.size(), 65 * page_size);
+    EXPECT_EQ(memory.data()[page_size - 1], 0xff);
+    EXPECT(all_of(memory.data().bytes().slice(page_size), [](auto byte) { return byte == 0; }));
+
+    // Capacity grows along with the memory, rather than all the way to the maximum right away.
+    EXPECT(memory.data().capacity() < 256 * page_size);
+}
+
+TEST_CASE(memory_does_not_grow_past_its_maximum)
+{
+    auto memory = TRY_OR_FAIL(Wasm::MemoryInstance::create(Wasm::MemoryType { Wasm::Limits(1, 3) }));
+    EXPECT(memory.grow(2 * page_size));
+    EXPECT(!memory.grow(page_size));
+    EXPECT_EQ(memory.size(), 3 * page_size);
+    EXPECT(memory.data().capacity() < 4 * page_size);
+}
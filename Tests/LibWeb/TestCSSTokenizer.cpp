@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/StringBuilder.h>
+#include <LibWeb/CSS/Parser/Tokenizer.h>
+
+using Web::CSS::Parser::Token;
+using Web::CSS::Parser::Tokenizer;
+
+static Vector<Token> tokenize(StringView input)
+{
+    return Tokenizer::tokenize(input, "utf-8"sv);
+}
+
+TEST_CASE(ascii_and_non_ascii_idents)
+{
+    auto tokens = tokenize("color café -x-\\41 b _über"sv);
+    EXPECT_EQ(tokens.size(), 8u);
+    EXPECT_EQ(tokens[0].ident(), "color"sv);
+    EXPECT_EQ(tokens[2].ident(), "café"sv);
+    EXPECT_EQ(tokens[4].ident(), "-x-Ab"sv);
+    EXPECT_EQ(tokens[6].ident(), "_über"sv);
+    EXPECT(tokens[7].is(Token::Type::EndOfFile));
+}
+
+TEST_CASE(strings)
+{
+    auto tokens = tokenize("\"plain\" 'it\\'s' \"été\" \"broken\nnext"sv);
+    EXPECT_EQ(tokens[0].string(), "plain"sv);
+    EXPECT_EQ(tokens[2].string(), "it's"sv);
+    EXPECT_EQ(tokens[4].string(), "été"sv);
+    EXPECT(tokens[6].is(Token::Type::BadString));
+}
+
+TEST_CASE(comments_and_whitespace_positions)
+{
+    auto tokens = tokenize("/* a * b */  \n\t a /* é */b"sv);
+    EXPECT(tokens[0].is(Token::Type::Whitespace));
+    EXPECT(tokens[1].is(Token::Type::Ident));
+    EXPECT_EQ(tokens[1].ident(), "a"sv);
+    EXPECT_EQ(tokens[1].start_position().line, 1u);
+    EXPECT_EQ(tokens[1].start_position().column, 2u);
+    EXPECT(tokens[2].is(Token::Type::Whitespace));
+    EXPECT_EQ(tokens[3].ident(), "b"sv);
+    EXPECT_EQ(tokens[3].end_position().line, 1u);
+    EXPECT_EQ(tokens[3].end_position().column, 12u);
+}
+
+BENCHMARK_CASE(tokenize_large_style_sheet)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 20'000; ++i) {
+        builder.appendff("/* Rule number {} */\n", i);
+        builder.appendff(".theme-button-{}:hover > .icon, #sidebar-item-{} {{\n", i, i);
+        builder.append("    font-family: \"Helvetica Neue\", Arial, sans-serif;\n"sv);
+        builder.append("    background: linear-gradient(to right, rgba(255, 255, 255, 0.5), transparent);\n"sv);
+        builder.append("    margin: 0 auto 12px calc(100% - 3em);\n}\n"sv);
+    }
+    auto style_sheet = builder.to_byte_string();
+
+    for (size_t i = 0; i < 10; ++i) {
+        auto tokens = tokenize(style_sheet);
+        EXPECT(tokens.last().is(Token::Type::EndOfFile));
+    }
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibURL/URL.h>
+#include <LibWeb/Loader/ContentFilter.h>
+
+static void set_patterns(std::initializer_list<StringView> patterns)
+{
+    Vector<String> strings;
+    for (auto pattern : patterns)
+        strings.append(MUST(String::from_utf8(pattern)));
+    MUST(Web::ContentFilter::the().set_patterns(strings));
+}
+
+static bool is_filtered(StringView url)
+{
+    return Web::ContentFilter::the().is_filtered(URL::URL(url));
+}
+
+TEST_CASE(substring_patterns)
+{
+    set_patterns({ "/ads/"sv, "tracker.js"sv, "dsx"sv, "adserver"sv, "adsx"sv });
+
+    EXPECT(is_filtered("https://example.com/ads/banner.png"sv));
+    EXPECT(is_filtered("https://cdn.example.com/static/tracker.js?v=1"sv));
+    EXPECT(is_filtered("https://adserver.example.com/"sv));
+    // Found through a failure link: "adsx" fails after "ads" and continues in "dsx".
+    EXPECT(is_filtered("https://example.com/badsx"sv));
+    EXPECT(!is_filtered("https://example.com/adverts/banner.png"sv));
+    EXPECT(is_filtered("https://example.com/tracker.json"sv));
+    EXPECT(!is_filtered("https://example.com/ads"sv));
+    EXPECT(!is_filtered("data:text/html,/ads/"sv));
+}
+
+TEST_CASE(domain_patterns)
+{
+    set_patterns({ "||ads.example.com^"sv, "||Tracker.net"sv, "/pixel.gif"sv });
+
+    EXPECT(is_filtered("https://ads.example.com/"sv));
+    EXPECT(is_filtered("https://eu.ads.example.com/script.js"sv));
+    EXPECT(is_filtered("http://tracker.net:8080/"sv));
+    EXPECT(is_filtered("https://example.com/pixel.gif"sv));
+    EXPECT(!is_filtered("https://example.com/"sv));
+    EXPECT(!is_filtered("https://badads.example.com/"sv));
+    EXPECT(!is_filtered("https://example.com/?ref=ads.example.com"sv));
+    EXPECT(!is_filtered("https://tracker.network/"sv));
+}
+
+TEST_CASE(no_patterns)
+{
+    set_patterns({});
+
+    EXPECT(!is_filtered("https://ads.example.com/ads/"sv));
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibWeb/SRI/SRI.h>
+
+static constexpr auto script = "alert('Hello, world.');"sv;
+
+static bool does_script_match_metadata_list(StringView metadata_list)
+{
+    return MUST(Web::SRI::do_bytes_match_metadata_list(MUST(ByteBuffer::copy(script.bytes())), metadata_list));
+}
+
+TEST_CASE(match_metadata_list)
+{
+    EXPECT(does_script_match_metadata_list(""sv));
+    EXPECT(does_script_match_metadata_list("md5-Ly2n+ATQQUOU7tRc1L8+Wg=="sv));
+
+    EXPECT(does_script_match_metadata_list("sha256-qznLcsROx4GACP2dm0UCKCzCG+HiZ1guq6ZZDob/Tng="sv));
+    EXPECT(does_script_match_metadata_list("sha384-H8BRh8j48O9oYatfu5AZzq6A9RINhZO5H16dQZngK7T62em8MUt1FLm52t+eX6xO"sv));
+    EXPECT(does_script_match_metadata_list("sha512-Q2bFTOhEALkN8hOms2FKTDLy7eugP2zFZ1T8LCvX42Fp3WoNr3bjZSAHeOsHrbV1Fu9/A0EzCinRE7Af1ofPrw=="sv));
+    EXPECT(!does_script_match_metadata_list("sha256-qznLcsROx4GACP2dm0UCKCzCG+HiZ1guq6ZZDob/Tnf="sv));
+
+    // Any of the items with the strongest algorithm may match.
+    EXPECT(does_script_match_metadata_list("sha384-wrong sha384-H8BRh8j48O9oYatfu5AZzq6A9RINhZO5H16dQZngK7T62em8MUt1FLm52t+eX6xO"sv));
+
+    // Only the items with the strongest algorithm are considered.
+    EXPECT(does_script_match_metadata_list("sha256-wrong sha384-H8BRh8j48O9oYatfu5AZzq6A9RINhZO5H16dQZngK7T62em8MUt1FLm52t+eX6xO"sv));
+    EXPECT(!does_script_match_metadata_list("sha256-qznLcsROx4GACP2dm0UCKCzCG+HiZ1guq6ZZDob/Tng= sha512-wrong"sv));
+}
+
+TEST_CASE(match_metadata_list_incrementally)
+{
+    auto matcher = MUST(Web::SRI::MetadataListMatcher::create("sha384-H8BRh8j48O9oYatfu5AZzq6A9RINhZO5H16dQZngK7T62em8MUt1FLm52t+eX6xO"sv));
+    for (size_t i = 0; i < script.length(); i += 5)
+        matcher.update(script.substring_view(i, min<size_t>(5, script.length() - i)).bytes());
+    EXPECT(MUST(matcher.matches()));
+
+    auto partial_matcher = MUST(Web::SRI::MetadataListMatcher::create("sha384-H8BRh8j48O9oYatfu5AZzq6A9RINhZO5H16dQZngK7T62em8MUt1FLm52t+eX6xO"sv));
+    partial_matcher.update(script.substring_view(0, script.length() - 1).bytes());
+    EXPECT(!MUST(partial_matcher.matches()));
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <AK/Vector.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/WebAudio/AudioKernels.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
+
+using namespace Web::WebAudio;
+
+TEST_CASE(mix_into)
+{
+    Vector<float> destination { 1, 2, 3, 4, 5, 6 };
+    Vector<float> source { 6, 5, 4, 3, 2, 1 };
+    mix_into(destination.span(), source.span());
+    EXPECT_EQ(destination, (Vector<float> { 7, 7, 7, 7, 7, 7 }));
+}
+
+TEST_CASE(apply_gain_ramp)
+{
+    Vector<float> samples;
+    samples.resize(10);
+    samples.span().fill(1);
+    apply_gain_ramp(samples.span(), 0, 1);
+    for (size_t i = 0; i < samples.size(); ++i)
+        EXPECT_APPROXIMATE(samples[i], static_cast<float>(i + 1) / 10);
+
+    samples.span().fill(2);
+    apply_gain_ramp(samples.span(), 0.5f, 0.5f);
+    for (auto sample : samples)
+        EXPECT_EQ(sample, 1.0f);
+}
+
+TEST_CASE(interleave)
+{
+    Vector<float> left { 1, 3, 5, 7, 9 };
+    Vector<float> right { 2, 4, 6, 8, 10 };
+    Vector<float> output;
+    output.resize(10);
+    interleave(left.span(), right.span(), output.span());
+    EXPECT_EQ(output, (Vector<float> { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }));
+}
+
+TEST_CASE(apply_biquad_matches_direct_form)
+{
+    auto coefficients = BiquadCoefficients::compute(Web::Bindings::BiquadFilterType::Lowpass, 44100, 1000, 0, 1, 0);
+
+    Vector<float> left;
+    Vector<float> right;
+    for (size_t i = 0; i < 300; ++i) {
+        left.append(AK::sin(static_cast<float>(i) * 0.3f));
+        right.append(i % 7 == 0 ? 1.0f : 0.0f);
+    }
+
+    auto filter_one_channel = [&](Vector<float> samples) {
+        float x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+        for (auto& sample : samples) {
+            auto y = coefficients.b0 * sample + coefficients.b1 * x1 + coefficients.b2 * x2 - coefficients.a1 * y1 - coefficients.a2 * y2;
+            x2 = exchange(x1, sample);
+            y2 = exchange(y1, y);
+            sample = y;
+        }
+        return samples;
+    };
+    auto expected_left = filter_one_channel(left);
+    auto expected_right = filter_one_channel(right);
+
+    // Filtering in two halves has to carry the state over.
+    BiquadState state;
+    for (size_t start : { 0, 150 }) {
+        Array<Span<float>, 2> channels { left.span().slice(start, 150), right.span().slice(start, 150) };
+        apply_biquad(coefficients, state, channels.span());
+    }
+
+    for (size_t i = 0; i < left.size(); ++i) {
+        EXPECT_APPROXIMATE(left[i], expected_left[i]);
+        EXPECT_APPROXIMATE(right[i], expected_right[i]);
+    }
+}
+
+TEST_CASE(biquad_coefficients_are_finite)
+{
+    auto coefficients = BiquadCoefficients::compute(Web::Bindings::BiquadFilterType::Bandpass, 44100, 1000, 0, 0, 0);
+    EXPECT(!isnan(coefficients.b0));
+    EXPECT(!isnan(coefficients.a1));
+}
+
+namespace {
+
+class TestDestinationNode final : public RenderNode {
+public:
+    virtual bool is_destination() const override { return true; }
+    virtual void process(AudioBus&, float) override { }
+};
+
+class ConstantSourceNode final : public RenderNode {
+public:
+    explicit ConstantSourceNode(float value)
+        : m_value(value)
+    {
+    }
+
+    virtual void process(AudioBus& bus, float) override
+    {
+        for (auto& channel : bus.channels)
+            channel.fill(m_value);
+    }
+
+private:
+    float m_value { 0 };
+};
+
+class DestructionTrackingNode final : public RenderNode {
+public:
+    explicit DestructionTrackingNode(bool& destroyed)
+        : m_destroyed(destroyed)
+    {
+    }
+
+    virtual ~DestructionTrackingNode() override { m_destroyed = true; }
+
+private:
+    bool& m_destroyed;
+};
+
+}
+
+TEST_CASE(render_graph_mixes_into_destination)
+{
+    auto graph = RenderGraph::create();
+    auto destination = make<TestDestinationNode>();
+    auto first_source = make<ConstantSourceNode>(0.25f);
+    auto second_source = make<ConstantSourceNode>(0.5f);
+    auto& destination_node = *destination;
+    auto& first_source_node = *first_source;
+    auto& second_source_node = *second_source;
+
+    graph->add_node(move(destination));
+    graph->add_node(move(first_source));
+    graph->add_node(move(second_source));
+    graph->connect(first_source_node, destination_node);
+    graph->connect(second_source_node, destination_node);
+    // Connecting the same nodes again is ignored.
+    graph->connect(second_source_node, destination_node);
+
+    // More frames than fit in one render quantum.
+    Vector<float> output;
+    output.resize(200 * AudioBus::channel_count);
+    graph->render(output.span(), 44100);
+    for (auto sample : output)
+        EXPECT_EQ(sample, 0.75f);
+
+    // Changes only take effect at the start of the next render quantum.
+    graph->disconnect(first_source_node, destination_node);
+    graph->render(output.span(), 44100);
+    for (size_t frame = 0; frame < 200; ++frame) {
+        auto expected = frame < 56 ? 0.75f : 0.5f;
+        EXPECT_EQ(output[frame * 2], expected);
+        EXPECT_EQ(output[frame * 2 + 1], expected);
+    }
+
+    graph->remove_node(second_source_node);
+    graph->render(output.span(), 44100);
+    for (size_t frame = 0; frame < 200; ++frame) {
+        auto expected = frame < 112 ? 0.5f : 0.0f;
+        EXPECT_EQ(output[frame * 2], expected);
+        EXPECT_EQ(output[frame * 2 + 1], expected);
+    }
+}
+
+TEST_CASE(render_graph_destroys_removed_nodes_on_the_control_thread)
+{
+    auto graph = RenderGraph::create();
+    auto destination = make<TestDestinationNode>();
+    auto& destination_node = *destination;
+    graph->add_node(move(destination));
+
+    bool destroyed = false;
+    auto source = make<DestructionTrackingNode>(destroyed);
+    auto& source_node = *source;
+    graph->add_node(move(source));
+    graph->connect(source_node, destination_node);
+
+    Vector<float> output;
+    output.resize(render_quantum_size * AudioBus::channel_count);
+    graph->render(output.span(), 44100);
+
+    // The rendering thread only hands the node back...
+    graph->remove_node(source_node);
+    graph->render(output.span(), 44100);
+    EXPECT(!destroyed);
+
+    // ...and it's destroyed with the next change made on the control thread.
+    graph->update_node(destination_node, [](RenderNode&) { });
+    EXPECT(destroyed);
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Base64.h>
+#include <AK/ByteBuffer.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibCompress/Deflate.h>
+#include <LibCore/EventLoop.h>
+#include <LibCrypto/Hash/HashManager.h>
+#include <LibTest/TestCase.h>
+#include <LibURL/URL.h>
+#include <LibWebSocket/Impl/WebSocketImpl.h>
+#include <LibWebSocket/WebSocket.h>
+
+static constexpr u8 text_op_code = 0x1;
+static constexpr u8 binary_op_code = 0x2;
+
+static constexpr auto permessage_deflate_response = "permessage-deflate; server_no_context_takeover; client_no_context_takeover"sv;
+
+// Plays the server's side of a connection, without any actual networking.
+class FakeWebSocketImpl final : public WebSocket::WebSocketImpl {
+public:
+    virtual void connect(WebSocket::ConnectionInfo const&) override { on_connected(); }
+    virtual bool can_read_line() override { return !m_lines.is_empty(); }
+    virtual ErrorOr<ByteString> read_line(size_t) override { return m_lines.take_first(); }
+
+    virtual ErrorOr<ByteBuffer> read(int) override
+    {
+        auto data = move(m_data);
+        m_data = {};
+        return data;
+    }
+
+    virtual bool send(ReadonlyBytes bytes) override
+    {
+        if (m_client_handshake.is_empty())
+            m_client_handshake = ByteString { bytes };
+        return true;
+    }
+
+    virtual bool eof() override { return false; }
+    virtual void discard_connection() override { }
+
+    void accept_handshake(Optional<StringView> extensions)
+    {
+        Optional<ByteString> key;
+        for (auto line : m_client_handshake.view().split_view("\r\n"sv)) {
+            if (line.starts_with("Sec-WebSocket-Key: "sv))
+                key = line.substring_view(19);
+        }
+        VERIFY(key.has_value());
+
+        Crypto::Hash::Manager hash;
+        hash.initialize(Crypto::Hash::HashKind::SHA1);
+        hash.update(ByteString::formatted("{}258EAFA5-E914-47DA-95CA-C5AB0DC85B11", *key));
+        auto digest = hash.digest();
+        auto accept = MUST(encode_base64({ digest.immutable_data(), digest.data_length() }));
+
+        m_lines.append("HTTP/1.1 101 Switching Protocols");
+        m_lines.append("Upgrade: websocket");
+        m_lines.append("Connection: Upgrade");
+        m_lines.append(ByteString::formatted("Sec-WebSocket-Accept: {}", accept));
+        if (extensions.has_value())
+            m_lines.append(ByteString::formatted("Sec-WebSocket-Extensions: {}", *extensions));
+        m_lines.append("");
+        on_ready_to_read();
+    }
+
+    void send_frame(u8 op_code, ReadonlyBytes payload, bool is_compressed)
+    {
+        m_data.append(0x80 | (is_compressed ? 0x40 : 0x00) | op_code);
+        if (payload.size() < 126) {
+            m_data.append(static_cast<u8>(payload.size()));
+        } else {
+            m_data.append(127);
+            for (int shift = 56; shift >= 0; shift -= 8)
+                m_data.append(static_cast<u8>(static_cast<u64>(payload.size()) >> shift));
+        }
+        m_data.append(payload);
+        on_ready_to_read();
+    }
+
+    ByteString const& client_handshake() const { return m_client_handshake; }
+
+private:
+    ByteString m_client_handshake;
+    Vector<ByteString> m_lines;
+    ByteBuffer m_data;
+};
+
+static NonnullRefPtr<WebSocket::WebSocket> create_websocket(FakeWebSocketImpl& impl)
+{
+    WebSocket::ConnectionInfo connection_info(URL::URL("ws://localhost/"sv));
+    connection_info.set_permessage_deflate_enabled(true);
+    auto websocket = WebSocket::WebSocket::create(move(connection_info), impl);
+    websocket->start();
+    return websocket;
+}
+
+// The server compresses messages the same way we do: a DEFLATE stream, minus the empty block it would end with.
+static ByteBuffer compress_message(ReadonlyBytes message)
+{
+    auto compressed = MUST(Compress::DeflateCompressor::compress_all(message));
+    MUST(compressed.try_append(0x00));
+    return compressed;
+}
+
+TEST_CASE(extensions_accepted_by_server)
+{
+    Core::EventLoop event_loop;
+    auto impl = adopt_ref(*new FakeWebSocketImpl);
+    auto websocket = create_websocket(*impl);
+
+    EXPECT(impl->client_handshake().contains("Sec-WebSocket-Extensions: permessage-deflate"sv));
+
+    impl->accept_handshake(permessage_deflate_response);
+    EXPECT_EQ(websocket->ready_state(), WebSocket::ReadyState::Open);
+    EXPECT_EQ(websocket->extensions_in_use(), permessage_deflate_response);
+}
+
+TEST_CASE(no_extensions_accepted_by_server)
+{
+    Core::EventLoop event_loop;
+    auto impl = adopt_ref(*new FakeWebSocketImpl);
+    auto websocket = create_websocket(*impl);
+
+    impl->accept_handshake({});
+    EXPECT_EQ(websocket->ready_state(), WebSocket::ReadyState::Open);
+    EXPECT(websocket->extensions_in_use().is_empty());
+}
+
+TEST_CASE(receive_compressed_message)
+{
+    Core::EventLoop event_loop;
+    auto impl = adopt_ref(*new FakeWebSocketImpl);
+    auto websocket = create_websocket(*impl);
+
+    Vector<ByteString> messages;
+    websocket->on_message = [&](auto message) {
+        messages.append(ByteString { message.data().bytes() });
+    };
+    impl->accept_handshake(permessage_deflate_response);
+
+    auto text = "Hello, compressed world! Hello, compressed world! Hello, compressed world!"sv;
+    impl->send_frame(text_op_code, compress_message(text.bytes()), true);
+
+    EXPECT_EQ(messages.size(), 1u);
+    EXPECT_EQ(messages.first(), text);
+}
+
+TEST_CASE(oversized_compressed_message_fails_connection)
+{
+    Core::EventLoop event_loop;
+    auto impl = adopt_ref(*new FakeWebSocketImpl);
+    auto websocket = create_websocket(*impl);
+
+    bool received_message = false;
+    Optional<WebSocket::WebSocket::Error> error;
+    websocket->on_message = [&](auto) { received_message = true; };
+    websocket->on_error = [&](auto websocket_error) { error = websocket_error; };
+    impl->accept_handshake(permessage_deflate_response);
+
+    // A small payload that inflates to more than the largest message we accept.
+    auto message = MUST(ByteBuffer::create_zeroed(65 * MiB));
+    impl->send_frame(binary_op_code, compress_message(message), true);
+
+    EXPECT(!received_message);
+    EXPECT(error == WebSocket::WebSocket::Error::ServerClosedSocket);
+}
@@ -41,3 +41,25 @@ TEST_CASE(predefined_character_reference)
     auto const& content = node.children[0]->content.get<XML::Node::Text>();
     EXPECT_EQ(content.builder.string_view(), "Well hello &, <, >, ', and \"!");
 }
+
+TEST_CASE(listener_events)
+{
+    struct EventRecorder : public XML::Listener {
+        virtual void element_start(XML::Name const& name, HashMap<XML::Name, ByteString> const& attributes) override
+        {
+            builder.appendff("<{}", name);
+            if (auto value = attributes.get("id"sv); value.has_value())
+                builder.appendff(" id={}", *value);
+            builder.append('>');
+        }
+        virtual void element_end(XML::Name const& name) override { builder.appendff("</{}>", name); }
+        virtual void text(StringView text) override { builder.appendff("[{}]", text); }
+
+        StringBuilder builder;
+    };
+
+    XML::Parser parser("<svg><g id=\"a\"><rect/>x &amp; y</g><g/></svg>"sv);
+    EventRecorder recorder;
+    MUST(parser.parse_with_listener(recorder));
+    EXPECT_EQ(recorder.builder.string_view(), "<svg><g id=a><rect></rect>[x ][&][ y]</g><g></g></svg>"sv);
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibCore/MappedFile.h>
+#include <LibCore/System.h>
+#include <LibFileSystem/TempFile.h>
+#include <LibTest/TestCase.h>
+#include <RequestServer/DiskCache.h>
+
+static constexpr auto partition = "https://example.com"sv;
+static constexpr auto other_partition = "https://example.org"sv;
+
+static URL::URL const resource_url { "https://cdn.example.net/script.js"sv };
+
+static HTTP::HeaderMap make_headers(Vector<HTTP::Header> headers)
+{
+    HTTP::HeaderMap map;
+    for (auto const& header : headers)
+        map.set(header.name, header.value);
+    return map;
+}
+
+struct TestCache {
+    TestCache()
+        : directory(MUST(FileSystem::TempFile::create_temp_directory()))
+        , cache(MUST(RequestServer::DiskCache::create(directory->path().to_byte_string())))
+    {
+    }
+
+    void store(HTTP::HeaderMap const& headers, AK::Duration age = AK::Duration::zero(), StringView in_partition = partition)
+    {
+        auto response_time = UnixDateTime::now() - age;
+        cache->store(in_partition, resource_url, 200, headers, "console.log('hi');"sv.bytes(), response_time, response_time);
+    }
+
+    Optional<RequestServer::DiskCache::LookupResult> lookup(StringView in_partition = partition, HTTP::HeaderMap const& request_headers = {})
+    {
+        return cache->lookup("GET"sv, in_partition, resource_url, request_headers);
+    }
+
+    Core::EventLoop event_loop;
+    NonnullOwnPtr<FileSystem::TempFile> directory;
+    NonnullOwnPtr<RequestServer::DiskCache> cache;
+};
+
+TEST_CASE(entries_are_partitioned)
+{
+    TestCache cache;
+    cache.store(make_headers({ { "Cache-Control", "max-age=3600" } }));
+
+    auto result = cache.lookup();
+    EXPECT(result.has_value());
+    EXPECT_EQ(result->freshness, RequestServer::DiskCache::Freshness::Fresh);
+
+    EXPECT(!cache.lookup(other_partition).has_value());
+    EXPECT(!MUST(cache.cache->open(partition, resource_url)).body->bytes().is_empty());
+    EXPECT(cache.cache->open(other_partition, resource_url).is_error());
+}
+
+TEST_CASE(requests_without_a_partition_bypass_the_cache)
+{
+    TestCache cache;
+    cache.store(make_headers({ { "Cache-Control", "max-age=3600" } }), AK::Duration::zero(), ""sv);
+
+    EXPECT(!cache.lookup(""sv).has_value());
+    EXPECT(!cache.lookup().has_value());
+}
+
+TEST_CASE(stale_entries_are_revalidated)
+{
+    TestCache cache;
+    cache.store(make_headers({ { "Cache-Control", "max-age=60" }, { "ETag", "\"v1\"" } }), AK::Duration::from_seconds(120));
+
+    auto result = cache.lookup();
+    EXPECT(result.has_value());
+    EXPECT_EQ(result->freshness, RequestServer::DiskCache::Freshness::NeedsRevalidation);
+    EXPECT_EQ(result->conditional_request_headers.get("If-None-Match"sv), "\"v1\""sv);
+}
+
+TEST_CASE(stale_entries_without_validators_are_dropped)
+{
+    TestCache cache;
+    cache.store(make_headers({ { "Cache-Control", "max-age=60" } }), AK::Duration::from_seconds(120));
+
+    EXPECT(!cache.lookup().has_value());
+    EXPECT(cache.cache->open(partition, resource_url).is_error());
+}
+
+TEST_CASE(no_cache_forces_revalidation)
+{
+    TestCache cache;
+    cache.store(make_headers({ { "Cache-Control", "max-age=3600" }, { "Last-Modified", "Mon, 01 Jan 2024 00:00:00 GMT" } }));
+
+    auto result = cache.lookup(partition, make_headers({ { "Cache-Control", "no-cache" } }));
+    EXPECT(result.has_value());
+    EXPECT_EQ(result->freshness, RequestServer::DiskCache::Freshness::NeedsRevalidation);
+    EXPECT_EQ(result->conditional_request_headers.get("If-Modified-Since"sv), "Mon, 01 Jan 2024 00:00:00 GMT"sv);
+}
+
+TEST_CASE(stale_while_revalidate)
+{
+    TestCache cache;
+    auto headers = make_headers({ { "Cache-Control", "max-age=60, stale-while-revalidate=600" }, { "ETag", "\"v1\"" } });
+
+    cache.store(headers, AK::Duration::from_seconds(120));
+    auto result = cache.lookup();
+    EXPECT(result.has_value());
+    EXPECT_EQ(result->freshness, RequestServer::DiskCache::Freshness::StaleWhileRevalidate);
+    EXPECT_EQ(result->conditional_request_headers.get("If-None-Match"sv), "\"v1\""sv);
+
+    // Past the stale-while-revalidate window, the response has to be revalidated before it is used.
+    cache.store(headers, AK::Duration::from_seconds(1200));
+    result = cache.lookup();
+    EXPECT(result.has_value());
+    EXPECT_EQ(result->freshness, RequestServer::DiskCache::Freshness::NeedsRevalidation);
+
+    // Only one background revalidation runs per entry.
+    EXPECT(cache.cache->begin_background_revalidation(partition, resource_url));
+    EXPECT(!cache.cache->begin_background_revalidation(partition, resource_url));
+    EXPECT(cache.cache->begin_background_revalidation(other_partition, resource_url));
+    cache.cache->end_background_revalidation(partition, resource_url);
+    EXPECT(cache.cache->begin_background_revalidation(partition, resource_url));
+}
+
+TEST_CASE(not_modified_response_freshens_entry)
+{
+    TestCache cache;
+    cache.store(make_headers({ { "Cache-Control", "max-age=60" }, { "ETag", "\"v1\"" }, { "Content-Length", "18" } }), AK::Duration::from_seconds(120));
+    EXPECT_EQ(cache.lookup()->freshness, RequestServer::DiskCache::Freshness::NeedsRevalidation);
+
+    auto not_modified_headers = make_headers({ { "Cache-Control", "max-age=3600" }, { "Content-Length", "0" } });
+    auto now = UnixDateTime::now();
+    cache.cache->freshen(partition, resource_url, not_modified_headers, now, now);
+
+    EXPECT_EQ(cache.lookup()->freshness, RequestServer::DiskCache::Freshness::Fresh);
+
+    auto cached_response = MUST(cache.cache->open(partition, resource_url));
+    EXPECT_EQ(cached_response.headers.get("Cache-Control"sv), "max-age=3600"sv);
+    EXPECT_EQ(cached_response.headers.get("Content-Length"sv), "18"sv);
+    EXPECT_EQ(cached_response.headers.get("ETag"sv), "\"v1\""sv);
+}
+
+TEST_CASE(missing_body_drops_entry)
+{
+    TestCache cache;
+    cache.store(make_headers({ { "Cache-Control", "max-age=60" }, { "ETag", "\"v1\"" } }), AK::Duration::from_seconds(120));
+    EXPECT(cache.lookup().has_value());
+
+    // Remove the stored body behind the cache's back, leaving only the index entry.
+    MUST(Core::System::unlink(ByteString::formatted("{}/{:016x}", cache.directory->path(), 1)));
+
+    EXPECT(cache.cache->open(partition, resource_url).is_error());
+    EXPECT(!cache.lookup().has_value());
+}
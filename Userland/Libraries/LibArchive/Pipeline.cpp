@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibArchive/Pipeline.h>
+
+namespace Archive {
+
+ErrorOr<NonnullOwnPtr<ReadAheadStream>> ReadAheadStream::create(NonnullOwnPtr<Stream> stream, size_t chunk_size, size_t max_buffered_chunks)
+{
+    VERIFY(chunk_size > 0);
+    VERIFY(max_buffered_chunks > 0);
+
+    auto read_ahead_stream = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ReadAheadStream(move(stream), chunk_size, max_buffered_chunks)));
+    read_ahead_stream->m_thread = TRY(Threading::Thread::try_create([&self = *read_ahead_stream] { return self.read_ahead(); }, "Read ahead"sv));
+    read_ahead_stream->m_thread->start();
+    return read_ahead_stream;
+}
+
+ReadAheadStream::ReadAheadStream(NonnullOwnPtr<Stream> stream, size_t chunk_size, size_t max_buffered_chunks)
+    : m_stream(move(stream))
+    , m_chunk_size(chunk_size)
+    , m_max_buffered_chunks(max_buffered_chunks)
+{
+}
+
+ReadAheadStream::~ReadAheadStream()
+{
+    {
+        Threading::MutexLocker locker { m_mutex };
+        m_should_stop = true;
+        m_space_available.signal();
+    }
+    (void)m_thread->join();
+}
+
+intptr_t ReadAheadStream::read_ahead()
+{
+    for (;;) {
+        {
+            Threading::MutexLocker locker { m_mutex };
+            m_space_available.wait_while([&] { return !m_should_stop && m_chunks.size() >= m_max_buffered_chunks; });
+            if (m_should_stop)
+                return 0;
+        }
+
+        auto chunk_or_error = [&]() -> ErrorOr<ByteBuffer> {
+            auto chunk = TRY(ByteBuffer::create_uninitialized(m_chunk_size));
+            size_t chunk_size = 0;
+            while (chunk_size < m_chunk_size && !m_stream->is_eof())
+                chunk_size += TRY(m_stream->read_some(chunk.bytes().slice(chunk_size))).size();
+            chunk.trim(chunk_size, false);
+            return chunk;
+        }();
+        auto reached_end = !chunk_or_error.is_error() && m_stream->is_eof();
+
+        Threading::MutexLocker locker { m_mutex };
+        if (chunk_or_error.is_error())
+            m_error = chunk_or_error.release_error();
+        else if (!chunk_or_error.value().is_empty())
+            m_chunks.enqueue(chunk_or_error.release_value());
+        m_reached_end = reached_end;
+        m_chunk_available.signal();
+
+        if (m_error.has_value() || m_reached_end)
+            return 0;
+    }
+}
+
+// NOTE: This has to be called with the mutex locked.
+void ReadAheadStream::wait_for_chunk() const
+{
+    m_chunk_available.wait_while([&] { return m_chunks.is_empty() && !m_reached_end && !m_error.has_value(); });
+}
+
+ErrorOr<Bytes> ReadAheadStream::read_some(Bytes bytes)
+{
+    if (m_current_chunk_offset == m_current_chunk.size()) {
+        Threading::MutexLocker locker { m_mutex };
+        wait_for_chunk();
+
+        if (m_chunks.is_empty()) {
+            if (m_error.has_value())
+                return Error::copy(*m_error);
+            return bytes.trim(0);
+        }
+
+        m_current_chunk = m_chunks.dequeue();
+        m_current_chunk_offset = 0;
+        m_space_available.signal();
+    }
+
+    auto size = min(bytes.size(), m_current_chunk.size() - m_current_chunk_offset);
+    m_current_chunk.bytes().slice(m_current_chunk_offset, size).copy_to(bytes);
+    m_current_chunk_offset += size;
+    return bytes.trim(size);
+}
+
+ErrorOr<size_t> ReadAheadStream::write_some(ReadonlyBytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+bool ReadAheadStream::is_eof() const
+{
+    if (m_current_chunk_offset < m_current_chunk.size())
+        return false;
+
+    // We can only tell once the reading thread either found more data or the end.
+    Threading::MutexLocker locker { m_mutex };
+    wait_for_chunk();
+    return m_chunks.is_empty() && m_reached_end;
+}
+
+ErrorOr<NonnullOwnPtr<SerialWorkQueue>> SerialWorkQueue::create(StringView thread_name, size_t max_pending_bytes)
+{
+    auto queue = TRY(adopt_nonnull_own_or_enomem(new (nothrow) SerialWorkQueue(max_pending_bytes)));
+    queue->m_thread = TRY(Threading::Thread::try_create([&self = *queue] { return self.run(); }, thread_name));
+    queue->m_thread->start();
+    return queue;
+}
+
+SerialWorkQueue::SerialWorkQueue(size_t max_pending_bytes)
+    : m_max_pending_bytes(max_pending_bytes)
+{
+}
+
+SerialWorkQueue::~SerialWorkQueue()
+{
+    (void)wait();
+
+    {
+        Threading::MutexLocker locker { m_mutex };
+        m_should_stop = true;
+        m_operation_available.signal();
+    }
+    (void)m_thread->join();
+}
+
+ErrorOr<void> SerialWorkQueue::enqueue(Operation operation, size_t size)
+{
+    Threading::MutexLocker locker { m_mutex };
+
+    // An operation that is larger than the limit on its own still gets to run, once everything before it has.
+    m_operation_finished.wait_while([&] { return !m_error.has_value() && m_pending_bytes > 0 && m_pending_bytes + size > m_max_pending_bytes; });
+    if (m_error.has_value())
+        return Error::copy(*m_error);
+
+    m_operations.enqueue({ move(operation), size });
+    m_pending_bytes += size;
+    m_operation_available.signal();
+    return {};
+}
+
+ErrorOr<void> SerialWorkQueue::wait()
+{
+    Threading::MutexLocker locker { m_mutex };
+    m_operation_finished.wait_while([&] { return !m_error.has_value() && (!m_operations.is_empty() || m_is_running_operation); });
+    if (m_error.has_value())
+        return Error::copy(*m_error);
+    return {};
+}
+
+intptr_t SerialWorkQueue::run()
+{
+    for (;;) {
+        PendingOperation pending_operation;
+        {
+            Threading::MutexLocker locker { m_mutex };
+            m_operation_available.wait_while([&] { return !m_should_stop && m_operations.is_empty(); });
+            if (m_operations.is_empty())
+                return 0;
+
+            pending_operation = m_operations.dequeue();
+            m_is_running_operation = true;
+        }
+
+        auto result = pending_operation.operation();
+
+        // Let go of whatever the operation held on to before making room for more.
+        pending_operation.operation = nullptr;
+
+        Threading::MutexLocker locker { m_mutex };
+        m_is_running_operation = false;
+        m_pending_bytes -= pending_operation.size;
+        if (result.is_error() && !m_error.has_value()) {
+            m_error = result.release_error();
+            m_operations.clear();
+            m_pending_bytes = 0;
+        }
+        m_operation_finished.broadcast();
+    }
+}
+
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Function.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Queue.h>
+#include <AK/Stream.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+
+namespace Archive {
+
+// The stages of extracting an archive can run on separate threads, connected by bounded buffers: a ReadAheadStream
+// decompresses the archive ahead of the thread parsing it, which hands the file system work to a SerialWorkQueue.
+
+// Reads the underlying stream on a separate thread, so that producing the data (e.g. decompressing it) overlaps with
+// consuming it. Up to max_buffered_chunks chunks of at most chunk_size bytes are read ahead.
+class ReadAheadStream final : public Stream {
+public:
+    static ErrorOr<NonnullOwnPtr<ReadAheadStream>> create(NonnullOwnPtr<Stream>, size_t chunk_size = 64 * KiB, size_t max_buffered_chunks = 16);
+    virtual ~ReadAheadStream() override;
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override { return true; }
+    virtual void close() override { }
+
+private:
+    ReadAheadStream(NonnullOwnPtr<Stream>, size_t chunk_size, size_t max_buffered_chunks);
+
+    intptr_t read_ahead();
+    void wait_for_chunk() const;
+
+    NonnullOwnPtr<Stream> m_stream;
+    size_t m_chunk_size { 0 };
+    size_t m_max_buffered_chunks { 0 };
+    RefPtr<Threading::Thread> m_thread;
+
+    mutable Threading::Mutex m_mutex;
+    mutable Threading::ConditionVariable m_chunk_available { m_mutex };
+    Threading::ConditionVariable m_space_available { m_mutex };
+    Queue<ByteBuffer> m_chunks;
+    Optional<Error> m_error;
+    bool m_reached_end { false };
+    bool m_should_stop { false };
+
+    // The chunk that is currently being read from, only used by the consuming thread.
+    ByteBuffer m_current_chunk;
+    size_t m_current_chunk_offset { 0 };
+};
+
+// Runs operations one after another on a separate thread, in the order in which they were enqueued. Enqueueing blocks
+// while operations worth more than max_pending_bytes are waiting to run, so that e.g. file contents that are waiting
+// to be written don't pile up in memory.
+class SerialWorkQueue {
+    AK_MAKE_NONCOPYABLE(SerialWorkQueue);
+    AK_MAKE_NONMOVABLE(SerialWorkQueue);
+
+public:
+    using Operation = Function<ErrorOr<void>()>;
+
+    static ErrorOr<NonnullOwnPtr<SerialWorkQueue>> create(StringView thread_name, size_t max_pending_bytes = 16 * MiB);
+
+    // Waits for all operations to run, as if wait() was called.
+    ~SerialWorkQueue();
+
+    // The size is how much memory the operation holds on to until it has run.
+    // Once an operation has failed, no further operations are run, and its error is returned from here on.
+    ErrorOr<void> enqueue(Operation, size_t size = 0);
+
+    // Waits for all operations to run, and returns the error of the one that failed, if any.
+    ErrorOr<void> wait();
+
+private:
+    SerialWorkQueue(size_t max_pending_bytes);
+
+    intptr_t run();
+
+    struct PendingOperation {
+        Operation operation;
+        size_t size { 0 };
+    };
+
+    size_t m_max_pending_bytes { 0 };
+    RefPtr<Threading::Thread> m_thread;
+
+    Threading::Mutex m_mutex;
+    Threading::ConditionVariable m_operation_available { m_mutex };
+    Threading::ConditionVariable m_operation_finished { m_mutex };
+    Queue<PendingOperation> m_operations;
+    size_t m_pending_bytes { 0 };
+    bool m_is_running_operation { false };
+    Optional<Error> m_error;
+    bool m_should_stop { false };
+};
+
+}
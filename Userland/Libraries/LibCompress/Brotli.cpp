@@ -4,20 +4,111 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/BinarySearch.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/QuickSort.h>
 #include <LibCompress/Brotli.h>
 #include <LibCompress/BrotliDictionary.h>
 
 namespace Compress {
 
+static size_t reverse_bits(size_t value, size_t bit_count)
+{
+    size_t reversed = 0;
+    for (size_t i = 0; i < bit_count; ++i) {
+        reversed = (reversed << 1) | (value & 1);
+        value >>= 1;
+    }
+    return reversed;
+}
+
+static size_t code_length_of(size_t code)
+{
+    // Drop the leading one bit that marks the length.
+    return count_required_bits(code) - 1;
+}
+
+void Brotli::CanonicalCode::build_lookup_table()
+{
+    m_lookup_table.clear();
+    m_max_code_length = 0;
+    for (auto code : m_symbol_codes)
+        m_max_code_length = max(m_max_code_length, code_length_of(code));
+
+    // A code with a single zero-length symbol does not need any bits, and the fallback handles that just as quickly.
+    if (m_max_code_length == 0)
+        return;
+
+    m_root_bits = min(root_table_bits, m_max_code_length);
+    m_lookup_table.resize(1 << m_root_bits);
+
+    // Codes are read starting with their most significant bit, but the bit stream hands out the earliest bits in its
+    // least significant bits, so the tables are indexed by the reversed codes.
+    Array<u8, 1 << root_table_bits> subtable_bits_for_prefix {};
+    for (auto code : m_symbol_codes) {
+        auto code_length = code_length_of(code);
+        if (code_length <= m_root_bits)
+            continue;
+        auto prefix = reverse_bits(code >> (code_length - m_root_bits), m_root_bits);
+        subtable_bits_for_prefix[prefix] = max(subtable_bits_for_prefix[prefix], code_length - m_root_bits);
+    }
+
+    for (size_t prefix = 0; prefix < subtable_bits_for_prefix.size(); ++prefix) {
+        if (subtable_bits_for_prefix[prefix] == 0)
+            continue;
+        m_lookup_table[prefix] = { static_cast<u16>(m_lookup_table.size()), 0, subtable_bits_for_prefix[prefix] };
+        m_lookup_table.resize(m_lookup_table.size() + (1 << subtable_bits_for_prefix[prefix]));
+    }
+
+    for (size_t i = 0; i < m_symbol_codes.size(); ++i) {
+        auto code_length = code_length_of(m_symbol_codes[i]);
+        auto code = m_symbol_codes[i] & ((1 << code_length) - 1);
+        LookupTableEntry entry { static_cast<u16>(m_symbol_values[i]), static_cast<u8>(code_length), 0 };
+
+        if (code_length <= m_root_bits) {
+            for (auto index = reverse_bits(code, code_length); index < (1u << m_root_bits); index += 1 << code_length)
+                m_lookup_table[index] = entry;
+            continue;
+        }
+
+        auto remaining_length = code_length - m_root_bits;
+        auto const& link = m_lookup_table[reverse_bits(code >> remaining_length, m_root_bits)];
+        if (link.subtable_bits == 0)
+            continue; // Only possible for codes that are not prefix-free, which the readers above never produce.
+        auto subtable_offset = link.value;
+        auto subtable_size = 1u << link.subtable_bits;
+        for (auto index = reverse_bits(code, remaining_length); index < subtable_size; index += 1 << remaining_length)
+            m_lookup_table[subtable_offset + index] = entry;
+    }
+}
+
 ErrorOr<size_t> Brotli::CanonicalCode::read_symbol(LittleEndianInputBitStream& input_stream) const
+{
+    if (m_lookup_table.is_empty())
+        return read_symbol_bit_by_bit(input_stream);
+
+    // Close to the end of the input, there may not be enough bits left to peek at even though the code itself fits.
+    auto peeked_bits_or_error = input_stream.peek_bits(m_max_code_length);
+    if (peeked_bits_or_error.is_error())
+        return read_symbol_bit_by_bit(input_stream);
+    auto bits = peeked_bits_or_error.value();
+
+    auto entry = m_lookup_table[bits & ((1 << m_root_bits) - 1)];
+    if (entry.subtable_bits != 0)
+        entry = m_lookup_table[entry.value + ((bits >> m_root_bits) & ((1 << entry.subtable_bits) - 1))];
+    if (entry.code_length == 0)
+        return Error::from_string_literal("no matching code found");
+
+    input_stream.discard_previously_peeked_bits(entry.code_length);
+    return entry.value;
+}
+
+ErrorOr<size_t> Brotli::CanonicalCode::read_symbol_bit_by_bit(LittleEndianInputBitStream& input_stream) const
 {
     size_t code_bits = 1;
 
     while (code_bits < (1 << 16)) {
-        // FIXME: This is very inefficient and could greatly be improved by implementing this
-        //        algorithm: https://www.hanshq.net/zip.html#huffdec
         size_t index;
         if (binary_search(m_symbol_codes.span(), code_bits, &index))
             return m_symbol_values[index];
@@ -227,6 +318,7 @@ ErrorOr<Brotli::CanonicalCode> Brotli::CanonicalCode::read_simple_prefix_code(Li
         }
     }
 
+    code.build_lookup_table();
     return code;
 }
 
@@ -286,6 +378,8 @@ ErrorOr<Brotli::CanonicalCode> Brotli::CanonicalCode::read_complex_prefix_code(L
         }
     }
 
+    temp_code.build_lookup_table();
+
     // Read the actual prefix code_value
     sum = 0;
     size_t i = 0;
@@ -381,6 +475,7 @@ ErrorOr<Brotli::CanonicalCode> Brotli::CanonicalCode::read_complex_prefix_code(L
         }
     }
 
+    final_code.build_lookup_table();
     return final_code;
 }
 
@@ -489,63 +584,64 @@ ErrorOr<void> BrotliDecompressionStream::block_read_new_state(Block& block)
     return {};
 }
 
+// RFC 7932 section 7.1
+static constexpr u8 context_id_lut0[256] {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 4, 0, 0, 4, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    8, 12, 16, 12, 12, 20, 12, 16, 24, 28, 12, 12, 32, 12, 36, 12,
+    44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 32, 32, 24, 40, 28, 12,
+    12, 48, 52, 52, 52, 48, 52, 52, 52, 48, 52, 52, 52, 52, 52, 48,
+    52, 52, 52, 52, 52, 48, 52, 52, 52, 52, 52, 24, 12, 28, 12, 12,
+    12, 56, 60, 60, 60, 56, 60, 60, 60, 56, 60, 60, 60, 60, 60, 56,
+    60, 60, 60, 60, 60, 56, 60, 60, 60, 60, 60, 24, 12, 28, 12, 0,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+    2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
+    2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
+    2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
+    2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3
+};
+static constexpr u8 context_id_lut1[256] {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1,
+    1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1,
+    1, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 1, 1, 1, 1, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2
+};
+static constexpr u8 context_id_lut2[256] {
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 7
+};
+
 size_t BrotliDecompressionStream::literal_code_index_from_context()
 {
-    size_t const context_id_lut0[256] {
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 4, 0, 0, 4, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        8, 12, 16, 12, 12, 20, 12, 16, 24, 28, 12, 12, 32, 12, 36, 12,
-        44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 32, 32, 24, 40, 28, 12,
-        12, 48, 52, 52, 52, 48, 52, 52, 52, 48, 52, 52, 52, 52, 52, 48,
-        52, 52, 52, 52, 52, 48, 52, 52, 52, 52, 52, 24, 12, 28, 12, 12,
-        12, 56, 60, 60, 60, 56, 60, 60, 60, 56, 60, 60, 60, 60, 60, 56,
-        60, 60, 60, 60, 60, 56, 60, 60, 60, 60, 60, 24, 12, 28, 12, 0,
-        0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
-        0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
-        0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
-        0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
-        2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
-        2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
-        2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
-        2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3
-    };
-    size_t const context_id_lut1[256] {
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1,
-        1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1,
-        1, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
-        3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 1, 1, 1, 1, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2
-    };
-    size_t const context_id_lut2[256] {
-        0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-        2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-        3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
-        3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
-        3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
-        3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
-        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
-        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
-        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
-        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
-        5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
-        5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
-        5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
-        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 7
-    };
-
     size_t context_mode = m_literal_context_modes[m_literal_block.type];
     size_t context_id;
     switch (context_mode) {
@@ -735,9 +831,7 @@ ErrorOr<Bytes> BrotliDecompressionStream::read_some(Bytes output_buffer)
             if (uncompressed_bytes.is_empty())
                 return Error::from_string_literal("eof");
 
-            // TODO: Replace the home-grown LookbackBuffer with AK::CircularBuffer.
-            for (auto c : uncompressed_bytes)
-                m_lookback_buffer.value().write(c);
+            m_lookback_buffer.value().write(uncompressed_bytes);
 
             m_bytes_left -= uncompressed_bytes.size();
             bytes_read += uncompressed_bytes.size();
@@ -780,19 +874,22 @@ ErrorOr<Bytes> BrotliDecompressionStream::read_some(Bytes output_buffer)
                 m_current_state = State::CompressedDistance;
             }
         } else if (m_current_state == State::CompressedLiteral) {
-            if (m_literal_block.length == 0) {
-                TRY(block_read_new_state(m_literal_block));
-            }
-            m_literal_block.length--;
+            // Decode as many literals as fit, rather than going through the state machine for each one.
+            while (m_insert_length > 0 && m_bytes_left > 0 && bytes_read < output_buffer.size()) {
+                if (m_literal_block.length == 0) {
+                    TRY(block_read_new_state(m_literal_block));
+                }
+                m_literal_block.length--;
 
-            size_t literal_code_index = literal_code_index_from_context();
-            size_t literal_value = TRY(m_literal_codes[literal_code_index].read_symbol(m_input_stream));
+                size_t literal_code_index = literal_code_index_from_context();
+                size_t literal_value = TRY(m_literal_codes[literal_code_index].read_symbol(m_input_stream));
 
-            output_buffer[bytes_read] = literal_value;
-            m_lookback_buffer.value().write(literal_value);
-            bytes_read++;
-            m_insert_length--;
-            m_bytes_left--;
+                output_buffer[bytes_read] = literal_value;
+                m_lookback_buffer.value().write(literal_value);
+                bytes_read++;
+                m_insert_length--;
+                m_bytes_left--;
+            }
 
             if (m_bytes_left == 0)
                 m_current_state = State::Idle;
@@ -906,13 +1003,12 @@ ErrorOr<Bytes> BrotliDecompressionStream::read_some(Bytes output_buffer)
                 m_current_state = State::CompressedCopy;
             }
         } else if (m_current_state == State::CompressedCopy) {
-            u8 copy_value = m_lookback_buffer.value().lookback(m_distance);
+            size_t length = min(min(m_copy_length, m_bytes_left), output_buffer.size() - bytes_read);
+            m_lookback_buffer.value().copy_from_lookback(m_distance, output_buffer.slice(bytes_read, length));
 
-            output_buffer[bytes_read] = copy_value;
-            m_lookback_buffer.value().write(copy_value);
-            bytes_read++;
-            m_copy_length--;
-            m_bytes_left--;
+            bytes_read += length;
+            m_copy_length -= length;
+            m_bytes_left -= length;
 
             if (m_bytes_left == 0)
                 m_current_state = State::Idle;
@@ -920,13 +1016,14 @@ ErrorOr<Bytes> BrotliDecompressionStream::read_some(Bytes output_buffer)
                 m_current_state = State::CompressedCommand;
         } else if (m_current_state == State::CompressedDictionary) {
             size_t offset = m_dictionary_data.size() - m_copy_length;
-            u8 dictionary_value = m_dictionary_data[offset];
-
-            output_buffer[bytes_read] = dictionary_value;
-            m_lookback_buffer.value().write(dictionary_value);
-            bytes_read++;
-            m_copy_length--;
-            m_bytes_left--;
+            size_t length = min(min(m_copy_length, m_bytes_left), output_buffer.size() - bytes_read);
+            auto dictionary_bytes = m_dictionary_data.bytes().slice(offset, length);
+
+            dictionary_bytes.copy_to(output_buffer.slice(bytes_read));
+            m_lookback_buffer.value().write(dictionary_bytes);
+            bytes_read += length;
+            m_copy_length -= length;
+            m_bytes_left -= length;
 
             if (m_bytes_left == 0)
                 m_current_state = State::Idle;
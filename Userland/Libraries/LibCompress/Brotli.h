@@ -20,7 +20,10 @@ public:
     CanonicalCode() = default;
     CanonicalCode(Vector<size_t> codes, Vector<size_t> values)
         : m_symbol_codes(move(codes))
-        , m_symbol_values(move(values)) {};
+        , m_symbol_values(move(values))
+    {
+        build_lookup_table();
+    }
 
     static ErrorOr<CanonicalCode> read_prefix_code(LittleEndianInputBitStream&, size_t alphabet_size);
     static ErrorOr<CanonicalCode> read_simple_prefix_code(LittleEndianInputBitStream&, size_t alphabet_size);
@@ -31,8 +34,26 @@ public:
 private:
     static ErrorOr<size_t> read_complex_prefix_code_length(LittleEndianInputBitStream&);
 
+    ErrorOr<size_t> read_symbol_bit_by_bit(LittleEndianInputBitStream&) const;
+    void build_lookup_table();
+
+    static constexpr size_t root_table_bits = 8;
+
+    // An entry either holds a symbol along with the length of its code, or, for codes that are longer than the root
+    // table's index, where the subtable that is indexed by the remaining bits starts.
+    struct LookupTableEntry {
+        u16 value { 0 };
+        u8 code_length { 0 };
+        u8 subtable_bits { 0 };
+    };
+
+    // Codes are stored with a leading one bit that marks their length, e.g. 0b101 is the two-bit code 01.
     Vector<size_t> m_symbol_codes;
     Vector<size_t> m_symbol_values;
+
+    Vector<LookupTableEntry> m_lookup_table;
+    size_t m_root_bits { 0 };
+    size_t m_max_code_length { 0 };
 };
 
 }
@@ -67,45 +88,71 @@ public:
     private:
         LookbackBuffer(FixedArray<u8>& buffer)
             : m_buffer(move(buffer))
+            , m_mask(m_buffer.size() - 1)
         {
         }
 
     public:
         static ErrorOr<LookbackBuffer> try_create(size_t size)
         {
-            auto buffer = TRY(FixedArray<u8>::create(size));
+            // Round the size up to a power of two, so that positions wrap around with a mask rather than a division.
+            size_t capacity = 1;
+            while (capacity < size)
+                capacity <<= 1;
+            auto buffer = TRY(FixedArray<u8>::create(capacity));
             return LookbackBuffer { buffer };
         }
 
         void write(u8 value)
         {
             m_buffer[m_offset] = value;
-            m_offset = (m_offset + 1) % m_buffer.size();
+            m_offset = (m_offset + 1) & m_mask;
             m_total_written++;
         }
 
+        void write(ReadonlyBytes bytes)
+        {
+            while (!bytes.is_empty()) {
+                auto written = bytes.copy_trimmed_to(m_buffer.span().slice(m_offset));
+                m_offset = (m_offset + written) & m_mask;
+                m_total_written += written;
+                bytes = bytes.slice(written);
+            }
+        }
+
+        // Repeats the bytes starting at the given distance back into the output, byte by byte, so that copies can
+        // overlap the bytes they produce.
+        void copy_from_lookback(size_t distance, Bytes output)
+        {
+            VERIFY(distance <= m_total_written);
+            VERIFY(distance <= m_buffer.size());
+            for (auto& byte : output) {
+                byte = m_buffer[(m_offset - distance) & m_mask];
+                m_buffer[m_offset] = byte;
+                m_offset = (m_offset + 1) & m_mask;
+            }
+            m_total_written += output.size();
+        }
+
         u8 lookback(size_t offset) const
         {
             VERIFY(offset <= m_total_written);
             VERIFY(offset <= m_buffer.size());
-            size_t index = (m_offset + m_buffer.size() - offset) % m_buffer.size();
-            return m_buffer[index];
+            return m_buffer[(m_offset - offset) & m_mask];
         }
 
         u8 lookback(size_t offset, u8 fallback) const
         {
             if (offset > m_total_written || offset > m_buffer.size())
                 return fallback;
-            VERIFY(offset <= m_total_written);
-            VERIFY(offset <= m_buffer.size());
-            size_t index = (m_offset + m_buffer.size() - offset) % m_buffer.size();
-            return m_buffer[index];
+            return m_buffer[(m_offset - offset) & m_mask];
         }
 
         size_t total_written() { return m_total_written; }
 
     private:
         FixedArray<u8> m_buffer;
+        size_t m_mask { 0 };
         size_t m_offset { 0 };
         size_t m_total_written { 0 };
     };
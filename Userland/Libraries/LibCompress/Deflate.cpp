@@ -7,12 +7,17 @@
 
 #include <AK/Array.h>
 #include <AK/Assertions.h>
-#include <AK/BinarySearch.h>
+#include <AK/Atomic.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/Endian.h>
 #include <AK/MemoryStream.h>
 #include <string.h>
 
 #include <LibCompress/Deflate.h>
 #include <LibCompress/Huffman.h>
+#include <LibCore/System.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
 
 namespace Compress {
 
@@ -67,6 +72,7 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
         code.m_prefix_table[0] = PrefixTableEntry { static_cast<u16>(last_non_zero), 1u };
         code.m_prefix_table[1] = code.m_prefix_table[0];
         code.m_max_prefixed_code_length = 1;
+        code.m_max_code_length = 1;
 
         if (code.m_bit_codes.size() < static_cast<size_t>(last_non_zero + 1)) {
             TRY(code.m_bit_codes.try_resize(last_non_zero + 1));
@@ -83,11 +89,10 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
         u16 symbol_value { 0 };
         u16 code_length { 0 };
     };
-    Array<PrefixCode, 1 << CanonicalCode::max_allowed_prefixed_code_length> prefix_codes;
-    size_t number_of_prefix_codes = 0;
+    Vector<PrefixCode, 288> prefix_codes;
 
     auto next_code = 0;
-    for (size_t code_length = 1; code_length <= 15; ++code_length) {
+    for (size_t code_length = 1; code_length <= max_code_length; ++code_length) {
         next_code <<= 1;
         auto start_bit = 1 << code_length;
 
@@ -98,46 +103,76 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
             if (next_code > start_bit)
                 return Error::from_string_literal("Failed to decode code lengths");
 
-            if (code_length <= CanonicalCode::max_allowed_prefixed_code_length) {
-                if (number_of_prefix_codes >= prefix_codes.size())
-                    return Error::from_string_literal("Invalid canonical Huffman code");
-
-                auto& prefix_code = prefix_codes[number_of_prefix_codes++];
-                prefix_code.symbol_code = next_code;
-                prefix_code.symbol_value = symbol;
-                prefix_code.code_length = code_length;
-
-                code.m_max_prefixed_code_length = code_length;
-            } else {
-                code.m_symbol_codes.append(start_bit | next_code);
-                code.m_symbol_values.append(symbol);
-            }
+            // DEFLATE writes huffman encoded symbols as lsb-first
+            auto reversed_code = fast_reverse16(start_bit | next_code, code_length);
+            TRY(prefix_codes.try_append({ reversed_code, static_cast<u16>(symbol), static_cast<u16>(code_length) }));
+            code.m_max_code_length = code_length;
 
             if (code.m_bit_codes.size() < symbol + 1) {
                 TRY(code.m_bit_codes.try_resize(symbol + 1));
                 TRY(code.m_bit_code_lengths.try_resize(symbol + 1));
             }
-            code.m_bit_codes[symbol] = fast_reverse16(start_bit | next_code, code_length); // DEFLATE writes huffman encoded symbols as lsb-first
+            code.m_bit_codes[symbol] = reversed_code;
             code.m_bit_code_lengths[symbol] = code_length;
 
             next_code++;
         }
     }
 
-    if (next_code != (1 << 15))
+    if (next_code != (1 << max_code_length))
         return Error::from_string_literal("Failed to decode code lengths");
 
+    auto const root_bits = min(code.m_max_code_length, max_allowed_prefixed_code_length);
+    auto const root_mask = (1u << root_bits) - 1;
+    code.m_max_prefixed_code_length = root_bits;
+
+    // Codes that fit into the prefix table fill every entry whose index starts with them.
     for (auto [symbol_code, symbol_value, code_length] : prefix_codes) {
-        if (code_length == 0 || code_length > CanonicalCode::max_allowed_prefixed_code_length)
-            break;
+        if (code_length > root_bits)
+            continue;
+        for (size_t index = symbol_code; index <= root_mask; index += 1u << code_length)
+            code.m_prefix_table[index] = PrefixTableEntry { symbol_value, static_cast<u8>(code_length) };
+    }
 
-        auto shift = code.m_max_prefixed_code_length - code_length;
-        symbol_code <<= shift;
+    // Longer codes get a subtable for each prefix table index they start with, sized for the longest of them.
+    if (code.m_max_code_length > root_bits) {
+        for (auto [symbol_code, symbol_value, code_length] : prefix_codes) {
+            if (code_length <= root_bits)
+                continue;
+            auto& link = code.m_prefix_table[symbol_code & root_mask];
+            link.subtable_bits = max(link.subtable_bits, static_cast<u8>(code_length - root_bits));
+        }
 
-        for (size_t j = 0; j < (1u << shift); ++j) {
-            auto index = fast_reverse16(symbol_code + j, code.m_max_prefixed_code_length);
-            code.m_prefix_table[index] = PrefixTableEntry { symbol_value, code_length };
+        size_t subtables_size = 0;
+        for (auto& entry : code.m_prefix_table.span().trim(root_mask + 1)) {
+            if (entry.subtable_bits == 0)
+                continue;
+            entry.symbol_value = static_cast<u16>(subtables_size);
+            subtables_size += 1u << entry.subtable_bits;
         }
+        TRY(code.m_subtables.try_resize(subtables_size));
+
+        for (auto [symbol_code, symbol_value, code_length] : prefix_codes) {
+            if (code_length <= root_bits)
+                continue;
+            auto const& link = code.m_prefix_table[symbol_code & root_mask];
+            for (size_t index = symbol_code >> root_bits; index < (1u << link.subtable_bits); index += 1u << (code_length - root_bits))
+                code.m_subtables[link.symbol_value + index] = PrefixTableEntry { symbol_value, static_cast<u8>(code_length) };
+        }
+    }
+
+    // Let literals with short codes pick up a second literal that fits into the rest of the index.
+    for (size_t index = 0; index <= root_mask; ++index) {
+        auto& entry = code.m_prefix_table[index];
+        if (entry.subtable_bits != 0 || entry.symbol_value >= 256 || entry.code_length >= root_bits)
+            continue;
+
+        auto const& next_entry = code.m_prefix_table[index >> entry.code_length];
+        if (next_entry.subtable_bits != 0 || next_entry.symbol_value >= 256 || next_entry.code_length > root_bits - entry.code_length)
+            continue;
+
+        entry.next_literal = next_entry.symbol_value;
+        entry.length_with_next_literal = entry.code_length + next_entry.code_length;
     }
 
     return code;
@@ -145,23 +180,58 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
 
 ErrorOr<u32> CanonicalCode::read_symbol(LittleEndianInputBitStream& stream) const
 {
-    auto prefix = TRY(stream.peek_bits<size_t>(m_max_prefixed_code_length));
+    auto prefix_or_error = stream.peek_bits<size_t>(m_max_prefixed_code_length);
+    if (prefix_or_error.is_error()) [[unlikely]]
+        return read_symbol_bit_by_bit(stream);
+
+    auto const& entry = m_prefix_table[prefix_or_error.value()];
+    if (entry.subtable_bits == 0) [[likely]] {
+        stream.discard_previously_peeked_bits(entry.code_length);
+        return entry.symbol_value;
+    }
 
-    if (auto [symbol_value, code_length] = m_prefix_table[prefix]; code_length != 0) {
-        stream.discard_previously_peeked_bits(code_length);
-        return symbol_value;
+    auto code_or_error = stream.peek_bits<size_t>(m_max_prefixed_code_length + entry.subtable_bits);
+    if (code_or_error.is_error()) [[unlikely]]
+        return read_symbol_bit_by_bit(stream);
+
+    auto const& subtable_entry = m_subtables[entry.symbol_value + (code_or_error.value() >> m_max_prefixed_code_length)];
+    stream.discard_previously_peeked_bits(subtable_entry.code_length);
+    return subtable_entry.symbol_value;
+}
+
+ErrorOr<CanonicalCode::Symbols> CanonicalCode::read_symbols(LittleEndianInputBitStream& stream) const
+{
+    auto prefix_or_error = stream.peek_bits<size_t>(m_max_prefixed_code_length);
+    if (!prefix_or_error.is_error()) [[likely]] {
+        auto const& entry = m_prefix_table[prefix_or_error.value()];
+        if (entry.length_with_next_literal != 0) {
+            stream.discard_previously_peeked_bits(entry.length_with_next_literal);
+            return Symbols { entry.symbol_value, entry.next_literal, true };
+        }
     }
 
-    auto code_bits = TRY(stream.read_bits<u16>(m_max_prefixed_code_length));
-    code_bits = fast_reverse16(code_bits, m_max_prefixed_code_length);
-    code_bits |= 1 << m_max_prefixed_code_length;
+    return Symbols { static_cast<u16>(TRY(read_symbol(stream))) };
+}
+
+// Near the end of the input, there may be fewer bits left than a full lookup needs.
+ErrorOr<u32> CanonicalCode::read_symbol_bit_by_bit(LittleEndianInputBitStream& stream) const
+{
+    auto const root_mask = (1u << m_max_prefixed_code_length) - 1;
 
-    for (size_t i = m_max_prefixed_code_length; i < 16; ++i) {
-        size_t index;
-        if (binary_search(m_symbol_codes.span(), code_bits, &index))
-            return m_symbol_values[index];
+    for (size_t length = 1; length <= m_max_code_length; ++length) {
+        auto bits = TRY(stream.peek_bits<size_t>(length));
+
+        auto const* entry = &m_prefix_table[bits & root_mask];
+        if (entry->subtable_bits != 0) {
+            if (length <= m_max_prefixed_code_length)
+                continue;
+            entry = &m_subtables[entry->symbol_value + ((bits >> m_max_prefixed_code_length) & ((1u << entry->subtable_bits) - 1))];
+        }
 
-        code_bits = code_bits << 1 | TRY(stream.read_bit());
+        if (entry->code_length != 0 && entry->code_length <= length) {
+            stream.discard_previously_peeked_bits(entry->code_length);
+            return entry->symbol_value;
+        }
     }
 
     return Error::from_string_literal("Symbol exceeds maximum symbol number");
@@ -179,37 +249,58 @@ ErrorOr<bool> DeflateDecompressor::CompressedBlock::try_read_more()
     if (m_eof == true)
         return false;
 
-    auto const symbol = TRY(m_literal_codes.read_symbol(*m_decompressor.m_input_stream));
+    auto& input_stream = *m_decompressor.m_input_stream;
+    auto& output_buffer = m_decompressor.m_output_buffer;
+    auto const used_space_before = output_buffer.used_space();
+
+    // Decode for as long as the longest possible back-reference is still guaranteed to fit into the output buffer.
+    // Literals are gathered up and written in batches, rather than going through the output buffer one at a time.
+    Array<u8, 256> literals;
+    size_t literal_count = 0;
+    auto flush_literals = [&] {
+        auto written = output_buffer.write(literals.span().trim(literal_count));
+        VERIFY(written == literal_count);
+        literal_count = 0;
+    };
 
-    if (symbol >= 286)
-        return Error::from_string_literal("Invalid deflate literal/length symbol");
+    while (output_buffer.empty_space() >= literal_count + max_back_reference_length) {
+        auto const symbols = TRY(m_literal_codes.read_symbols(input_stream));
+        auto const symbol = symbols.symbol;
 
-    if (symbol < EndOfBlock) {
-        u8 byte_symbol = symbol;
-        m_decompressor.m_output_buffer.write({ &byte_symbol, sizeof(byte_symbol) });
-        return true;
-    }
+        if (symbol < EndOfBlock) {
+            literals[literal_count++] = symbol;
+            if (symbols.has_next_literal)
+                literals[literal_count++] = symbols.next_literal;
+            if (literal_count > literals.size() - 2)
+                flush_literals();
+            continue;
+        }
 
-    if (symbol == EndOfBlock) {
-        m_eof = true;
-        return false;
-    }
+        flush_literals();
 
-    if (!m_distance_codes.has_value())
-        return Error::from_string_literal("Distance codes have not been initialized");
+        if (symbol >= 286)
+            return Error::from_string_literal("Invalid deflate literal/length symbol");
+
+        if (symbol == EndOfBlock) {
+            m_eof = true;
+            return output_buffer.used_space() != used_space_before;
+        }
 
-    auto const length = TRY(m_decompressor.decode_length(symbol));
-    auto const distance_symbol = TRY(m_distance_codes.value().read_symbol(*m_decompressor.m_input_stream));
-    if (distance_symbol >= 30)
-        return Error::from_string_literal("Invalid deflate distance symbol");
+        if (!m_distance_codes.has_value())
+            return Error::from_string_literal("Distance codes have not been initialized");
 
-    auto const distance = TRY(m_decompressor.decode_distance(distance_symbol));
+        auto const length = TRY(m_decompressor.decode_length(symbol));
+        auto const distance_symbol = TRY(m_distance_codes.value().read_symbol(input_stream));
+        if (distance_symbol >= 30)
+            return Error::from_string_literal("Invalid deflate distance symbol");
 
-    auto copied_length = TRY(m_decompressor.m_output_buffer.copy_from_seekback(distance, length));
+        auto const distance = TRY(m_decompressor.decode_distance(distance_symbol));
 
-    // TODO: What should we do if the output buffer is full?
-    VERIFY(copied_length == length);
+        auto copied_length = TRY(output_buffer.copy_from_seekback(distance, length));
+        VERIFY(copied_length == length);
+    }
 
+    flush_literals();
     return true;
 }
 
@@ -539,8 +630,17 @@ size_t DeflateCompressor::compare_match_candidate(size_t start, size_t candidate
             return 0;
     }
 
-    // Find the actual length
+    // Find the actual length, comparing eight bytes at a time for as long as possible
     auto match_length = previous_match_length + 1;
+    while (match_length + sizeof(u64) <= maximum_match_length) {
+        u64 a;
+        u64 b;
+        memcpy(&a, &m_rolling_window[start + match_length], sizeof(u64));
+        memcpy(&b, &m_rolling_window[candidate + match_length], sizeof(u64));
+        if (auto difference = AK::convert_between_host_and_little_endian(a ^ b); difference != 0)
+            return match_length + count_trailing_zeroes(difference) / 8;
+        match_length += sizeof(u64);
+    }
     while (match_length < maximum_match_length && m_rolling_window[start + match_length] == m_rolling_window[candidate + match_length]) {
         match_length++;
     }
@@ -569,7 +669,7 @@ size_t DeflateCompressor::find_back_match(size_t start, u16 hash, size_t previou
             break; // no remaining candidates
 
         VERIFY(candidate < start);
-        if (start - candidate > window_size)
+        if (start - candidate > max_distance)
             break; // outside the window
 
         auto match_length = compare_match_candidate(start, candidate, previous_match_length, maximum_match_length);
@@ -607,6 +707,11 @@ void DeflateCompressor::lz77_compress_block()
         m_hash_head[hash] = window_pos;
     };
 
+    // Make the dictionary available to back references. It only ever precedes the first block.
+    for (auto position = block_size - m_dictionary_size; position < block_size; ++position)
+        insert_hash(position, hash_sequence(&m_rolling_window[position]));
+    m_dictionary_size = 0;
+
     auto emit_literal = [&](auto literal) {
         VERIFY(m_pending_symbol_size <= block_size + 1);
         auto index = m_pending_symbol_size++;
@@ -959,6 +1064,29 @@ ErrorOr<void> DeflateCompressor::final_flush()
     return {};
 }
 
+ErrorOr<void> DeflateCompressor::final_sync_flush()
+{
+    VERIFY(!m_finished);
+    if (m_pending_block_size != 0)
+        TRY(flush());
+    m_finished = true;
+
+    TRY(m_output_stream->write_bits(0b000u, 3)); // non-final block, no compression
+    TRY(m_output_stream->align_to_byte_boundary());
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0));
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0xffff));
+    TRY(m_output_stream->flush_buffer_to_stream());
+    return {};
+}
+
+void DeflateCompressor::set_dictionary(ReadonlyBytes dictionary)
+{
+    VERIFY(!m_finished && m_pending_block_size == 0);
+    dictionary = dictionary.slice(dictionary.size() - min(dictionary.size(), block_size));
+    dictionary.copy_to({ m_rolling_window + block_size - dictionary.size(), dictionary.size() });
+    m_dictionary_size = dictionary.size();
+}
+
 ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, CompressionLevel compression_level)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
@@ -973,4 +1101,89 @@ ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, Compres
     return buffer;
 }
 
+
+static ErrorOr<ByteBuffer> compress_chunk(ReadonlyBytes chunk, ReadonlyBytes dictionary, DeflateCompressor::CompressionLevel compression_level, bool is_last_chunk)
+{
+    auto output_stream = TRY(try_make<AllocatingMemoryStream>());
+    auto deflate_stream = TRY(DeflateCompressor::construct(MaybeOwned<Stream>(*output_stream), compression_level));
+
+    deflate_stream->set_dictionary(dictionary);
+    TRY(deflate_stream->write_until_depleted(chunk));
+    if (is_last_chunk)
+        TRY(deflate_stream->final_flush());
+    else
+        TRY(deflate_stream->final_sync_flush());
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(output_stream->used_buffer_size()));
+    TRY(output_stream->read_until_filled(buffer));
+    return buffer;
+}
+
+ErrorOr<ByteBuffer> DeflateCompressor::compress_all_in_parallel(ReadonlyBytes bytes, CompressionLevel compression_level, size_t thread_count)
+{
+    auto chunk_count = ceil_div(bytes.size(), parallel_chunk_size);
+    if (thread_count == 0)
+        thread_count = Core::System::hardware_concurrency();
+    thread_count = min(thread_count, chunk_count);
+    if (thread_count <= 1)
+        return compress_all(bytes, compression_level);
+
+    Vector<ByteBuffer> compressed_chunks;
+    TRY(compressed_chunks.try_resize(chunk_count));
+
+    Atomic<size_t> next_chunk_index { 0 };
+    Threading::Mutex error_mutex;
+    Optional<Error> error;
+
+    auto compress_chunks = [&]() -> intptr_t {
+        for (;;) {
+            auto index = next_chunk_index.fetch_add(1);
+            if (index >= chunk_count)
+                return 0;
+
+            auto offset = index * parallel_chunk_size;
+            auto chunk = bytes.slice(offset, min(parallel_chunk_size, bytes.size() - offset));
+            auto dictionary_size = min(offset, block_size);
+            auto dictionary = bytes.slice(offset - dictionary_size, dictionary_size);
+
+            auto compressed_chunk = compress_chunk(chunk, dictionary, compression_level, index == chunk_count - 1);
+            if (compressed_chunk.is_error()) {
+                Threading::MutexLocker locker { error_mutex };
+                if (!error.has_value())
+                    error = compressed_chunk.release_error();
+                continue;
+            }
+            compressed_chunks[index] = compressed_chunk.release_value();
+        }
+    };
+
+    // This thread does its share of the work too, and picks up all of it if no other thread can be started.
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (size_t i = 1; i < thread_count; ++i) {
+        auto thread = Threading::Thread::try_create([&] { return compress_chunks(); }, "Deflate"sv);
+        if (thread.is_error() || threads.try_append(thread.value()).is_error())
+            break;
+        thread.value()->start();
+    }
+
+    compress_chunks();
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    if (error.has_value())
+        return error.release_value();
+
+    size_t compressed_size = 0;
+    for (auto const& compressed_chunk : compressed_chunks)
+        compressed_size += compressed_chunk.size();
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(compressed_size));
+    size_t buffer_offset = 0;
+    for (auto const& compressed_chunk : compressed_chunks) {
+        compressed_chunk.bytes().copy_to(buffer.bytes().slice(buffer_offset));
+        buffer_offset += compressed_chunk.size();
+    }
+    return buffer;
+}
+
 }
@@ -23,6 +23,17 @@ class CanonicalCode {
 public:
     CanonicalCode() = default;
     ErrorOr<u32> read_symbol(LittleEndianInputBitStream&) const;
+
+    // A symbol, followed by a second literal byte if that was decoded in the same lookup.
+    struct Symbols {
+        u16 symbol { 0 };
+        u8 next_literal { 0 };
+        bool has_next_literal { false };
+    };
+
+    // Like read_symbol(), but if the symbol is a literal byte (i.e. below 256) and directly followed by another one
+    // whose code also fits into the lookup, reads both of them at once.
+    ErrorOr<Symbols> read_symbols(LittleEndianInputBitStream&) const;
     ErrorOr<void> write_symbol(LittleEndianOutputBitStream&, u32) const;
 
     static CanonicalCode const& fixed_literal_codes();
@@ -31,19 +42,27 @@ public:
     static ErrorOr<CanonicalCode> from_bytes(ReadonlyBytes);
 
 private:
-    static constexpr size_t max_allowed_prefixed_code_length = 8;
+    static constexpr size_t max_allowed_prefixed_code_length = 10;
+    static constexpr size_t max_code_length = 15;
 
     struct PrefixTableEntry {
+        // For entries that link to a subtable, the index of the subtable's first entry.
         u16 symbol_value { 0 };
-        u16 code_length { 0 };
+        u8 code_length { 0 };
+        u8 subtable_bits { 0 };
+
+        u8 next_literal { 0 };
+        u8 length_with_next_literal { 0 };
     };
 
-    // Decompression - indexed by code
-    Vector<u16, 286> m_symbol_codes;
-    Vector<u16, 286> m_symbol_values;
+    ErrorOr<u32> read_symbol_bit_by_bit(LittleEndianInputBitStream&) const;
 
+    // Decompression - indexed by the next (bit-reversed) bits of the input. Codes longer than the prefix table's index
+    // continue in a subtable, indexed by the bits after that.
     Array<PrefixTableEntry, 1 << max_allowed_prefixed_code_length> m_prefix_table {};
+    Vector<PrefixTableEntry> m_subtables;
     size_t m_max_prefixed_code_length { 0 };
+    size_t m_max_code_length { 0 };
 
     // Compression - indexed by symbol
     // Deflate uses a maximum of 288 symbols (maximum of 32 for distances),
@@ -138,6 +157,7 @@ public:
     static constexpr size_t max_huffman_distances = 32;
     static constexpr size_t min_match_length = 4;   // matches smaller than these are not worth the size of the back reference
     static constexpr size_t max_match_length = 258; // matches longer than these cannot be encoded using huffman codes
+    static constexpr size_t max_distance = 32 * KiB; // back references cannot reach further back than this
     static constexpr u16 empty_slot = UINT16_MAX;
 
     struct CompressionConstants {
@@ -174,8 +194,22 @@ public:
     virtual void close() override;
     ErrorOr<void> final_flush();
 
+    // Like final_flush(), but ends the output with an empty non-final stored block instead of a final block. The output
+    // is then byte-aligned and can be followed by more blocks, which is how independently compressed chunks are joined.
+    ErrorOr<void> final_sync_flush();
+
+    // Lets back references reach into data that precedes the input without that data becoming part of the output.
+    // Only the last block_size bytes are used. Has to be called before anything is written.
+    void set_dictionary(ReadonlyBytes);
+
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
 
+    // Compresses chunks of the input on several threads at once, each primed with the data right before it, much like
+    // pigz does. The result is a single DEFLATE stream that is only slightly larger than what compress_all() produces.
+    // A thread count of zero uses all available cores.
+    static ErrorOr<ByteBuffer> compress_all_in_parallel(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD, size_t thread_count = 0);
+    static constexpr size_t parallel_chunk_size = 128 * KiB;
+
 private:
     DeflateCompressor(NonnullOwnPtr<LittleEndianOutputBitStream>, CompressionLevel = CompressionLevel::GOOD);
 
@@ -211,6 +245,7 @@ private:
 
     u8 m_rolling_window[window_size];
     size_t m_pending_block_size { 0 };
+    size_t m_dictionary_size { 0 }; // the dictionary sits at the end of the first half of the window
 
     struct [[gnu::packed]] {
         u16 distance; // back reference length
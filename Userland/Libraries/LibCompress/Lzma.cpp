@@ -6,6 +6,7 @@
 
 #include <AK/Debug.h>
 #include <AK/IntegralMath.h>
+#include <AK/ScopeGuard.h>
 #include <LibCompress/Lzma.h>
 
 namespace Compress {
@@ -179,7 +180,7 @@ LzmaDecompressor::LzmaDecompressor(MaybeOwned<Stream> stream, LzmaDecompressorOp
 
 bool LzmaDecompressor::is_range_decoder_in_clean_state() const
 {
-    return m_range_decoder_code == 0;
+    return m_range_decoder.code == 0;
 }
 
 bool LzmaDecompressor::has_reached_expected_data_size() const
@@ -196,21 +197,70 @@ ErrorOr<void> LzmaDecompressor::initialize_range_decoder()
     //  That scheme allows to simplify the code of the Range Encoder in the
     //  LZMA Encoder. If initial byte is not equal to ZERO, the LZMA Decoder must
     //  stop decoding and report error."
+
+    // Note: Anything that is still buffered is left over from the stream that we are replacing, so we start out empty.
+    auto decoder = RangeDecoder {};
+
     {
-        auto byte = TRY(m_stream->read_value<u8>());
+        auto byte = read_input_byte(decoder);
+        TRY(check_for_input_error());
         if (byte != 0)
             return Error::from_string_literal("Initial byte of data stream is not zero");
     }
 
     // Read the initial bytes into the range decoder.
-    m_range_decoder_code = 0;
-    for (size_t i = 0; i < 4; i++) {
-        auto byte = TRY(m_stream->read_value<u8>());
-        m_range_decoder_code = m_range_decoder_code << 8 | byte;
+    for (size_t i = 0; i < 4; i++)
+        decoder.code = decoder.code << 8 | read_input_byte(decoder);
+    TRY(check_for_input_error());
+
+    m_range_decoder = decoder;
+
+    return {};
+}
+
+ALWAYS_INLINE u8 LzmaDecompressor::read_input_byte(RangeDecoder& decoder)
+{
+    if (decoder.input == decoder.input_end) [[unlikely]] {
+        auto input = refill_input_buffer();
+        if (input.is_empty())
+            return 0;
+
+        decoder.input = input.data();
+        decoder.input_end = input.data() + input.size();
     }
 
-    m_range_decoder_range = 0xFFFFFFFF;
+    return *decoder.input++;
+}
+
+ReadonlyBytes LzmaDecompressor::refill_input_buffer()
+{
+    // Once the input has failed, we only shift in zeroes until the current symbol is done and the error is picked up.
+    if (m_input_error.has_value())
+        return {};
+
+    // Note: The streams that we are reading from end where the LZMA data does, so reading ahead doesn't take anything
+    //       away from whoever reads from them after us.
+    while (true) {
+        auto read_bytes = m_stream->read_some(m_input_buffer);
+        if (read_bytes.is_error()) {
+            m_input_error = read_bytes.release_error();
+            return {};
+        }
+
+        if (!read_bytes.value().is_empty())
+            return read_bytes.release_value();
+
+        if (m_stream->is_eof()) {
+            m_input_error = Error::from_string_literal("Reached the end of the input while decoding LZMA stream");
+            return {};
+        }
+    }
+}
 
+ErrorOr<void> LzmaDecompressor::check_for_input_error() const
+{
+    if (m_input_error.has_value()) [[unlikely]]
+        return Error::copy(*m_input_error);
     return {};
 }
 
@@ -229,21 +279,17 @@ ErrorOr<void> LzmaDecompressor::append_input_stream(MaybeOwned<Stream> stream, O
     return {};
 }
 
-ErrorOr<void> LzmaDecompressor::normalize_range_decoder()
+ALWAYS_INLINE void LzmaDecompressor::normalize_range_decoder(RangeDecoder& decoder)
 {
     // "The Normalize() function keeps the "Range" value in described range."
 
-    if (m_range_decoder_range >= minimum_range_value)
-        return {};
-
-    m_range_decoder_range <<= 8;
-    m_range_decoder_code <<= 8;
-
-    m_range_decoder_code |= TRY(m_stream->read_value<u8>());
+    if (decoder.range >= minimum_range_value)
+        return;
 
-    VERIFY(m_range_decoder_range >= minimum_range_value);
+    decoder.range <<= 8;
+    decoder.code <<= 8;
 
-    return {};
+    decoder.code |= read_input_byte(decoder);
 }
 
 ErrorOr<void> LzmaCompressor::shift_range_encoder()
@@ -297,21 +343,21 @@ ErrorOr<void> LzmaCompressor::normalize_range_encoder()
     return {};
 }
 
-ErrorOr<u8> LzmaDecompressor::decode_direct_bit()
+ALWAYS_INLINE ErrorOr<u8> LzmaDecompressor::decode_direct_bit(RangeDecoder& decoder)
 {
-    dbgln_if(LZMA_DEBUG, "Decoding direct bit {} with code = {:#x}, range = {:#x}", 1 - ((m_range_decoder_code - (m_range_decoder_range >> 1)) >> 31), m_range_decoder_code, m_range_decoder_range);
+    dbgln_if(LZMA_DEBUG, "Decoding direct bit {} with code = {:#x}, range = {:#x}", 1 - ((decoder.code - (decoder.range >> 1)) >> 31), decoder.code, decoder.range);
 
-    m_range_decoder_range >>= 1;
-    m_range_decoder_code -= m_range_decoder_range;
+    decoder.range >>= 1;
+    decoder.code -= decoder.range;
 
-    u32 temp = 0 - (m_range_decoder_code >> 31);
+    u32 temp = 0 - (decoder.code >> 31);
 
-    m_range_decoder_code += m_range_decoder_range & temp;
+    decoder.code += decoder.range & temp;
 
-    if (m_range_decoder_code == m_range_decoder_range)
+    if (decoder.code == decoder.range)
         return Error::from_string_literal("Reached an invalid state while decoding LZMA stream");
 
-    TRY(normalize_range_decoder());
+    normalize_range_decoder(decoder);
 
     return temp + 1;
 }
@@ -330,28 +376,30 @@ ErrorOr<void> LzmaCompressor::encode_direct_bit(u8 value)
     return {};
 }
 
-ErrorOr<u8> LzmaDecompressor::decode_bit_with_probability(Probability& probability)
+ALWAYS_INLINE u8 LzmaDecompressor::decode_bit_with_probability(RangeDecoder& decoder, Probability& probability)
 {
     // "The LZMA decoder provides the pointer to CProb variable that contains
     //  information about estimated probability for symbol 0 and the Range Decoder
     //  updates that CProb variable after decoding."
 
-    u32 bound = (m_range_decoder_range >> probability_bit_count) * probability;
+    u32 bound = (decoder.range >> probability_bit_count) * probability;
 
-    dbgln_if(LZMA_DEBUG, "Decoding bit {} with probability = {:#x}, bound = {:#x}, code = {:#x}, range = {:#x}", m_range_decoder_code < bound ? 0 : 1, probability, bound, m_range_decoder_code, m_range_decoder_range);
+    dbgln_if(LZMA_DEBUG, "Decoding bit {} with probability = {:#x}, bound = {:#x}, code = {:#x}, range = {:#x}", decoder.code < bound ? 0 : 1, probability, bound, decoder.code, decoder.range);
 
-    if (m_range_decoder_code < bound) {
+    u8 bit;
+    if (decoder.code < bound) {
+        decoder.range = bound;
         probability += ((1 << probability_bit_count) - probability) >> probability_shift_width;
-        m_range_decoder_range = bound;
-        TRY(normalize_range_decoder());
-        return 0;
+        bit = 0;
     } else {
+        decoder.range -= bound;
+        decoder.code -= bound;
         probability -= probability >> probability_shift_width;
-        m_range_decoder_code -= bound;
-        m_range_decoder_range -= bound;
-        TRY(normalize_range_decoder());
-        return 1;
+        bit = 1;
     }
+
+    normalize_range_decoder(decoder);
+    return bit;
 }
 
 ErrorOr<void> LzmaCompressor::encode_bit_with_probability(Probability& probability, u8 value)
@@ -373,7 +421,7 @@ ErrorOr<void> LzmaCompressor::encode_bit_with_probability(Probability& probabili
     return {};
 }
 
-ErrorOr<u16> LzmaDecompressor::decode_symbol_using_bit_tree(size_t bit_count, Span<Probability> probability_tree)
+ALWAYS_INLINE u16 LzmaDecompressor::decode_symbol_using_bit_tree(RangeDecoder& decoder, size_t bit_count, Span<Probability> probability_tree)
 {
     VERIFY(bit_count <= sizeof(u16) * 8);
     VERIFY(probability_tree.size() >= 1ul << bit_count);
@@ -385,7 +433,7 @@ ErrorOr<u16> LzmaDecompressor::decode_symbol_using_bit_tree(size_t bit_count, Sp
     size_t tree_index = 1;
 
     for (size_t i = 0; i < bit_count; i++) {
-        u16 next_bit = TRY(decode_bit_with_probability(probability_tree[tree_index]));
+        u16 next_bit = decode_bit_with_probability(decoder, probability_tree[tree_index]);
         result = (result << 1) | next_bit;
         tree_index = (tree_index << 1) | next_bit;
     }
@@ -420,7 +468,7 @@ ErrorOr<void> LzmaCompressor::encode_symbol_using_bit_tree(size_t bit_count, Spa
     return {};
 }
 
-ErrorOr<u16> LzmaDecompressor::decode_symbol_using_reverse_bit_tree(size_t bit_count, Span<Probability> probability_tree)
+ALWAYS_INLINE u16 LzmaDecompressor::decode_symbol_using_reverse_bit_tree(RangeDecoder& decoder, size_t bit_count, Span<Probability> probability_tree)
 {
     VERIFY(bit_count <= sizeof(u16) * 8);
     VERIFY(probability_tree.size() >= 1ul << bit_count);
@@ -429,7 +477,7 @@ ErrorOr<u16> LzmaDecompressor::decode_symbol_using_reverse_bit_tree(size_t bit_c
     size_t tree_index = 1;
 
     for (size_t i = 0; i < bit_count; i++) {
-        u16 next_bit = TRY(decode_bit_with_probability(probability_tree[tree_index]));
+        u16 next_bit = decode_bit_with_probability(decoder, probability_tree[tree_index]);
         result |= next_bit << i;
         tree_index = (tree_index << 1) | next_bit;
     }
@@ -464,10 +512,8 @@ ErrorOr<void> LzmaCompressor::encode_symbol_using_reverse_bit_tree(size_t bit_co
 ErrorOr<void> LzmaDecompressor::decode_literal_to_output_buffer()
 {
     u8 previous_byte = 0;
-    if (m_dictionary->seekback_limit() > 0) {
-        auto read_bytes = MUST(m_dictionary->read_with_seekback({ &previous_byte, sizeof(previous_byte) }, 1));
-        VERIFY(read_bytes.size() == sizeof(previous_byte));
-    }
+    if (m_dictionary->seekback_limit() > 0)
+        previous_byte = m_dictionary->byte_at_seekback(1);
 
     // "To select the table for decoding it uses the context that consists of
     //  (lc) high bits from previous literal and (lp) low bits from value that
@@ -488,10 +534,12 @@ ErrorOr<void> LzmaDecompressor::decode_literal_to_output_buffer()
     //  of latest decoded match."
     // Note: The specification says `(State > 7)`, but the reference implementation does `(State >= 7)`, which is a mismatch.
     //       Testing `(State > 7)` with actual test files yields errors, so the reference implementation appears to be the correct one.
+    auto decoder = m_range_decoder;
+
     if (m_state >= 7) {
-        u8 matched_byte = 0;
-        auto read_bytes = TRY(m_dictionary->read_with_seekback({ &matched_byte, sizeof(matched_byte) }, current_repetition_offset()));
-        VERIFY(read_bytes.size() == sizeof(matched_byte));
+        if (current_repetition_offset() > m_dictionary->seekback_limit())
+            return Error::from_string_literal("Tried a seekback read beyond the seekback limit");
+        u8 matched_byte = m_dictionary->byte_at_seekback(current_repetition_offset());
 
         dbgln_if(LZMA_DEBUG, "Decoding literal using match byte {:#x}", matched_byte);
 
@@ -499,7 +547,7 @@ ErrorOr<void> LzmaDecompressor::decode_literal_to_output_buffer()
             u8 match_bit = (matched_byte >> 7) & 1;
             matched_byte <<= 1;
 
-            u8 decoded_bit = TRY(decode_bit_with_probability(selected_probability_table[((1 + match_bit) << 8) + result]));
+            u8 decoded_bit = decode_bit_with_probability(decoder, selected_probability_table[((1 + match_bit) << 8) + result]);
             result = result << 1 | decoded_bit;
 
             if (match_bit != decoded_bit)
@@ -508,12 +556,15 @@ ErrorOr<void> LzmaDecompressor::decode_literal_to_output_buffer()
     }
 
     while (result < 0x100)
-        result = (result << 1) | TRY(decode_bit_with_probability(selected_probability_table[result]));
+        result = (result << 1) | decode_bit_with_probability(decoder, selected_probability_table[result]);
+
+    m_range_decoder = decoder;
 
     u8 actual_result = result - 0x100;
 
-    size_t written_bytes = m_dictionary->write({ &actual_result, sizeof(actual_result) });
-    VERIFY(written_bytes == sizeof(actual_result));
+    TRY(check_for_input_error());
+    auto did_write = m_dictionary->write_byte(actual_result);
+    VERIFY(did_write);
     m_total_processed_bytes += sizeof(actual_result);
 
     dbgln_if(LZMA_DEBUG, "Decoded literal {:#x} in state {} using literal state {:#x} (previous byte is {:#x})", actual_result, m_state, literal_state, previous_byte);
@@ -670,27 +721,30 @@ LzmaState::LzmaLengthCoderState::LzmaLengthCoderState()
     initialize_to_default_probability(m_high_length_probabilities);
 }
 
-ErrorOr<u16> LzmaDecompressor::decode_normalized_match_length(LzmaLengthCoderState& length_decoder_state)
+u16 LzmaDecompressor::decode_normalized_match_length(LzmaLengthCoderState& length_decoder_state)
 {
     // "LZMA uses "posState" value as context to select the binary tree
     //  from LowCoder and MidCoder binary tree arrays:"
     u16 position_state = m_total_processed_bytes & ((1 << m_options.position_bits) - 1);
 
+    auto decoder = m_range_decoder;
+    ScopeGuard store_decoder_state = [&] { m_range_decoder = decoder; };
+
     // "The following scheme is used for the match length encoding:
     //
     //   Binary encoding    Binary Tree structure    Zero-based match length
     //   sequence                                    (binary + decimal):
     //
     //   0 xxx              LowCoder[posState]       xxx
-    if (TRY(decode_bit_with_probability(length_decoder_state.m_first_choice_probability)) == 0)
-        return TRY(decode_symbol_using_bit_tree(3, length_decoder_state.m_low_length_probabilities[position_state].span()));
+    if (decode_bit_with_probability(decoder, length_decoder_state.m_first_choice_probability) == 0)
+        return decode_symbol_using_bit_tree(decoder, 3, length_decoder_state.m_low_length_probabilities[position_state].span());
 
     //   1 0 yyy            MidCoder[posState]       yyy + 8
-    if (TRY(decode_bit_with_probability(length_decoder_state.m_second_choice_probability)) == 0)
-        return TRY(decode_symbol_using_bit_tree(3, length_decoder_state.m_medium_length_probabilities[position_state].span())) + 8;
+    if (decode_bit_with_probability(decoder, length_decoder_state.m_second_choice_probability) == 0)
+        return decode_symbol_using_bit_tree(decoder, 3, length_decoder_state.m_medium_length_probabilities[position_state].span()) + 8;
 
     //   1 1 zzzzzzzz       HighCoder                zzzzzzzz + 16"
-    return TRY(decode_symbol_using_bit_tree(8, length_decoder_state.m_high_length_probabilities.span())) + 16;
+    return decode_symbol_using_bit_tree(decoder, 8, length_decoder_state.m_high_length_probabilities.span()) + 16;
 }
 
 ErrorOr<void> LzmaCompressor::encode_normalized_match_length(LzmaLengthCoderState& length_coder_state, u16 normalized_length)
@@ -722,9 +776,12 @@ ErrorOr<u32> LzmaDecompressor::decode_normalized_match_distance(u16 normalized_m
     //  to calculate the context state "lenState" do decode the distance value."
     u16 length_state = min(normalized_match_length, number_of_length_to_position_states - 1);
 
+    auto decoder = m_range_decoder;
+    ScopeGuard store_decoder_state = [&] { m_range_decoder = decoder; };
+
     // "At first stage the distance decoder decodes 6-bit "posSlot" value with bit
     //  tree decoder from PosSlotDecoder array."
-    u16 position_slot = TRY(decode_symbol_using_bit_tree(6, m_length_to_position_states[length_state].span()));
+    u16 position_slot = decode_symbol_using_bit_tree(decoder, 6, m_length_to_position_states[length_state].span());
 
     // "The encoding scheme for distance value is shown in the following table:
     //
@@ -776,7 +833,7 @@ ErrorOr<u32> LzmaDecompressor::decode_normalized_match_distance(u16 normalized_m
     if (position_slot < first_position_slot_with_direct_encoded_bits) {
         size_t number_of_bits_to_decode = (position_slot / 2) - 1;
         auto& selected_probability_tree = m_binary_tree_distance_probabilities[position_slot - first_position_slot_with_binary_tree_bits];
-        return (distance_prefix << number_of_bits_to_decode) | TRY(decode_symbol_using_reverse_bit_tree(number_of_bits_to_decode, selected_probability_tree));
+        return (distance_prefix << number_of_bits_to_decode) | decode_symbol_using_reverse_bit_tree(decoder, number_of_bits_to_decode, selected_probability_tree);
     }
 
     // "  if (posSlot >= kEndPosModelIndex), the middle bits are decoded as direct
@@ -784,9 +841,9 @@ ErrorOr<u32> LzmaDecompressor::decode_normalized_match_distance(u16 normalized_m
     //     decoder "AlignDecoder" with "Reverse" scheme."
     size_t number_of_direct_bits_to_decode = ((position_slot - first_position_slot_with_direct_encoded_bits) / 2) + 2;
     for (size_t i = 0; i < number_of_direct_bits_to_decode; i++) {
-        distance_prefix = (distance_prefix << 1) | TRY(decode_direct_bit());
+        distance_prefix = (distance_prefix << 1) | TRY(decode_direct_bit(decoder));
     }
-    return (distance_prefix << number_of_alignment_bits) | TRY(decode_symbol_using_reverse_bit_tree(number_of_alignment_bits, m_alignment_bit_probabilities));
+    return (distance_prefix << number_of_alignment_bits) | decode_symbol_using_reverse_bit_tree(decoder, number_of_alignment_bits, m_alignment_bit_probabilities);
 }
 
 ErrorOr<void> LzmaCompressor::encode_normalized_match_distance(u16 normalized_match_length, u32 normalized_match_distance)
@@ -878,19 +935,22 @@ void LzmaState::update_state_after_short_rep()
         m_state = 11;
 }
 
-ErrorOr<LzmaDecompressor::MatchType> LzmaDecompressor::decode_match_type()
+LzmaDecompressor::MatchType LzmaDecompressor::decode_match_type()
 {
     // "The decoder calculates "state2" variable value to select exact variable from
     //  "IsMatch" and "IsRep0Long" arrays."
     u16 position_state = m_total_processed_bytes & ((1 << m_options.position_bits) - 1);
     u16 state2 = (m_state << maximum_number_of_position_bits) + position_state;
 
+    auto decoder = m_range_decoder;
+    ScopeGuard store_decoder_state = [&] { m_range_decoder = decoder; };
+
     // "The decoder uses the following code flow scheme to select exact
     //  type of LITERAL or MATCH:
     //
     //  IsMatch[state2] decode
     //   0 - the Literal"
-    if (TRY(decode_bit_with_probability(m_is_match_probabilities[state2])) == 0) {
+    if (decode_bit_with_probability(decoder, m_is_match_probabilities[state2]) == 0) {
         dbgln_if(LZMA_DEBUG, "Decoded match type 'Literal'");
         return MatchType::Literal;
     }
@@ -898,7 +958,7 @@ ErrorOr<LzmaDecompressor::MatchType> LzmaDecompressor::decode_match_type()
     // " 1 - the Match
     //     IsRep[state] decode
     //       0 - Simple Match"
-    if (TRY(decode_bit_with_probability(m_is_rep_probabilities[m_state])) == 0) {
+    if (decode_bit_with_probability(decoder, m_is_rep_probabilities[m_state]) == 0) {
         dbgln_if(LZMA_DEBUG, "Decoded match type 'SimpleMatch'");
         return MatchType::SimpleMatch;
     }
@@ -906,10 +966,10 @@ ErrorOr<LzmaDecompressor::MatchType> LzmaDecompressor::decode_match_type()
     // "     1 - Rep Match
     //         IsRepG0[state] decode
     //           0 - the distance is rep0"
-    if (TRY(decode_bit_with_probability(m_is_rep_g0_probabilities[m_state])) == 0) {
+    if (decode_bit_with_probability(decoder, m_is_rep_g0_probabilities[m_state]) == 0) {
         // "       IsRep0Long[state2] decode
         //           0 - Short Rep Match"
-        if (TRY(decode_bit_with_probability(m_is_rep0_long_probabilities[state2])) == 0) {
+        if (decode_bit_with_probability(decoder, m_is_rep0_long_probabilities[state2]) == 0) {
             dbgln_if(LZMA_DEBUG, "Decoded match type 'ShortRepMatch'");
             return MatchType::ShortRepMatch;
         }
@@ -922,7 +982,7 @@ ErrorOr<LzmaDecompressor::MatchType> LzmaDecompressor::decode_match_type()
     // "         1 -
     //             IsRepG1[state] decode
     //               0 - Rep Match 1"
-    if (TRY(decode_bit_with_probability(m_is_rep_g1_probabilities[m_state])) == 0) {
+    if (decode_bit_with_probability(decoder, m_is_rep_g1_probabilities[m_state]) == 0) {
         dbgln_if(LZMA_DEBUG, "Decoded match type 'RepMatch1'");
         return MatchType::RepMatch1;
     }
@@ -930,7 +990,7 @@ ErrorOr<LzmaDecompressor::MatchType> LzmaDecompressor::decode_match_type()
     // "             1 -
     //                 IsRepG2[state] decode
     //                   0 - Rep Match 2"
-    if (TRY(decode_bit_with_probability(m_is_rep_g2_probabilities[m_state])) == 0) {
+    if (decode_bit_with_probability(decoder, m_is_rep_g2_probabilities[m_state]) == 0) {
         dbgln_if(LZMA_DEBUG, "Decoded match type 'RepMatch2'");
         return MatchType::RepMatch2;
     }
@@ -1039,6 +1099,8 @@ ErrorOr<Bytes> LzmaDecompressor::read_some(Bytes bytes)
         auto copy_match_to_buffer = [&](u16 real_length) -> ErrorOr<void> {
             VERIFY(!m_leftover_match_length.has_value());
 
+            TRY(check_for_input_error());
+
             if (m_options.uncompressed_size.has_value() && m_options.uncompressed_size.value() < m_total_processed_bytes + real_length)
                 return Error::from_string_literal("Tried to copy match beyond expected uncompressed file size");
 
@@ -1059,7 +1121,7 @@ ErrorOr<Bytes> LzmaDecompressor::read_some(Bytes bytes)
             continue;
         }
 
-        auto const match_type = TRY(decode_match_type());
+        auto const match_type = decode_match_type();
 
         // If we are looking for EOS, but find another match type, the stream is also corrupted.
         if (has_reached_expected_data_size() && match_type != MatchType::SimpleMatch)
@@ -1085,13 +1147,14 @@ ErrorOr<Bytes> LzmaDecompressor::read_some(Bytes bytes)
             m_rep1 = m_rep0;
 
             // "The zero-based length is decoded with "LenDecoder"."
-            u16 normalized_length = TRY(decode_normalized_match_length(m_length_coder));
+            u16 normalized_length = decode_normalized_match_length(m_length_coder);
 
             // "The state is update with UpdateState_Match function."
             update_state_after_match();
 
             // "and the new "rep0" value is decoded with DecodeDistance."
             m_rep0 = TRY(decode_normalized_match_distance(normalized_length));
+            TRY(check_for_input_error());
 
             // "If the value of "rep0" is equal to 0xFFFFFFFF, it means that we have
             //  "End of stream" marker, so we can stop decoding and check finishing
@@ -1166,7 +1229,7 @@ ErrorOr<Bytes> LzmaDecompressor::read_some(Bytes bytes)
 
         // "In other cases (Rep Match 0/1/2/3), it decodes the zero-based
         //  length of match with "RepLenDecoder" decoder."
-        u16 normalized_length = TRY(decode_normalized_match_length(m_rep_length_coder));
+        u16 normalized_length = decode_normalized_match_length(m_rep_length_coder);
 
         // "Then it updates the state."
         update_state_after_rep();
@@ -187,24 +187,41 @@ private:
     Optional<u16> m_leftover_match_length;
 
     // Range decoder state (initialized with stream data in LzmaDecompressor::create).
-    u32 m_range_decoder_range { 0xFFFFFFFF };
-    u32 m_range_decoder_code { 0 };
+    // The decoding functions work on a local copy of this that they store back once they are done, which allows the
+    // compiler to keep it in registers instead of going through memory for every decoded bit.
+    struct RangeDecoder {
+        u32 range { 0xFFFFFFFF };
+        u32 code { 0 };
+        u8 const* input { nullptr };
+        u8 const* input_end { nullptr };
+    };
+    RangeDecoder m_range_decoder;
+
+    // The range decoder reads its input in blocks instead of going through the stream for every byte that it shifts in.
+    // Running out of input is only reported once the symbol that it happened in has been decoded, which keeps all error
+    // checks out of the per-bit path.
+    static constexpr size_t input_buffer_size = 4 * KiB;
+    Array<u8, input_buffer_size> m_input_buffer;
+    Optional<Error> m_input_error;
+    ReadonlyBytes refill_input_buffer();
+    ErrorOr<void> check_for_input_error() const;
 
     ErrorOr<void> initialize_range_decoder();
-    ErrorOr<void> normalize_range_decoder();
-    ErrorOr<u8> decode_direct_bit();
-    ErrorOr<u8> decode_bit_with_probability(Probability& probability);
+    u8 read_input_byte(RangeDecoder&);
+    void normalize_range_decoder(RangeDecoder&);
+    ErrorOr<u8> decode_direct_bit(RangeDecoder&);
+    u8 decode_bit_with_probability(RangeDecoder&, Probability& probability);
 
-    ErrorOr<MatchType> decode_match_type();
+    MatchType decode_match_type();
 
     // Decodes a multi-bit symbol using a given probability tree (either in normal or in reverse order).
     // The specification states that "unsigned" is at least 16 bits in size, our implementation assumes this as the maximum symbol size.
-    ErrorOr<u16> decode_symbol_using_bit_tree(size_t bit_count, Span<Probability> probability_tree);
-    ErrorOr<u16> decode_symbol_using_reverse_bit_tree(size_t bit_count, Span<Probability> probability_tree);
+    u16 decode_symbol_using_bit_tree(RangeDecoder&, size_t bit_count, Span<Probability> probability_tree);
+    u16 decode_symbol_using_reverse_bit_tree(RangeDecoder&, size_t bit_count, Span<Probability> probability_tree);
 
     ErrorOr<void> decode_literal_to_output_buffer();
 
-    ErrorOr<u16> decode_normalized_match_length(LzmaLengthCoderState&);
+    u16 decode_normalized_match_length(LzmaLengthCoderState&);
 
     // This deviates from the specification, which states that "unsigned" is at least 16-bit.
     // However, the match distance needs to be at least 32-bit, at the very least to hold the 0xFFFFFFFF end marker value.
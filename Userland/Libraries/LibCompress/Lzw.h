@@ -7,12 +7,15 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/BitStream.h>
+#include <AK/ByteBuffer.h>
 #include <AK/Concepts.h>
 #include <AK/Debug.h>
 #include <AK/Format.h>
 #include <AK/IntegralMath.h>
 #include <AK/MemoryStream.h>
+#include <AK/Noncopyable.h>
 #include <AK/Vector.h>
 
 namespace Compress {
@@ -88,13 +91,38 @@ protected:
 }
 
 template<InputBitStream InputStream>
-class LzwDecompressor : private Details::LzwState {
+class LzwDecompressor {
+    AK_MAKE_NONCOPYABLE(LzwDecompressor);
+    AK_MAKE_NONMOVABLE(LzwDecompressor);
+
 public:
     explicit LzwDecompressor(MaybeOwned<InputStream> lzw_stream, u8 min_code_size, i32 offset_for_size_change = 0)
-        : LzwState(min_code_size, offset_for_size_change)
-        , m_bit_stream(move(lzw_stream))
-
+        : m_bit_stream(move(lzw_stream))
+        , m_offset_for_size_change(offset_for_size_change)
     {
+        VERIFY(min_code_size <= 8);
+
+        u16 const literal_code_count = 1 << min_code_size;
+        for (u16 code = 0; code < literal_code_count; ++code) {
+            m_suffixes[code] = code;
+            m_first_bytes[code] = code;
+            m_lengths[code] = 1;
+        }
+
+        // The control codes directly follow the literals, and adding them to the table can already grow the code size.
+        m_clear_code = literal_code_count;
+        m_end_of_data_code = literal_code_count + 1;
+
+        m_initial_code_size = min_code_size;
+        u32 table_capacity = AK::exp2<u32>(min_code_size);
+        for (u32 table_size = m_clear_code + 1; table_size <= static_cast<u32>(m_end_of_data_code) + 1; ++table_size) {
+            if (table_size >= table_capacity && m_initial_code_size < max_code_size) {
+                ++m_initial_code_size;
+                table_capacity *= 2;
+            }
+        }
+
+        reset();
     }
 
     static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes bytes, u8 initial_code_size, i32 offset_for_size_change = 0)
@@ -104,73 +132,142 @@ public:
         LzwDecompressor lzw_decompressor { MaybeOwned<InputStream> { move(lzw_stream) }, initial_code_size, offset_for_size_change };
 
         ByteBuffer decompressed;
+        Array<u8, 4 * KiB> buffer;
 
-        u16 const clear_code = lzw_decompressor.add_control_code();
-        u16 const end_of_data_code = lzw_decompressor.add_control_code();
+        while (!lzw_decompressor.has_reached_end_of_data()) {
+            auto const decompressed_bytes = TRY(lzw_decompressor.decompress_some(buffer));
+            TRY(decompressed.try_append(decompressed_bytes));
+        }
 
-        while (true) {
-            auto const code = TRY(lzw_decompressor.next_code());
+        return decompressed;
+    }
+
+    // Fills the given buffer with decompressed data and returns the filled part of it, which is only shorter than the
+    // buffer once the end of data code has been reached.
+    ErrorOr<Bytes> decompress_some(Bytes output)
+    {
+        // Finish the string that didn't fit into the previous buffer first.
+        size_t written = m_pending_output.copy_trimmed_to(output);
+        m_pending_output = m_pending_output.slice(written);
 
-            if (code == clear_code) {
-                lzw_decompressor.reset();
+        while (written < output.size() && !m_reached_end_of_data) {
+            auto const code = TRY(next_code());
+
+            if (code == m_clear_code) {
+                reset();
                 continue;
             }
 
-            if (code == end_of_data_code)
+            if (code == m_end_of_data_code) {
+                m_reached_end_of_data = true;
                 break;
+            }
 
-            TRY(decompressed.try_append(lzw_decompressor.get_output()));
+            extend_code_table(code);
+
+            // Strings that fit are written straight into the output, the others are kept around until the next call.
+            u16 const length = m_lengths[code];
+            if (length <= output.size() - written) {
+                write_string(code, output.slice(written, length));
+                written += length;
+            } else {
+                auto string = m_pending_output_buffer.span().trim(length);
+                write_string(code, string);
+                auto const written_from_string = string.copy_trimmed_to(output.slice(written));
+                m_pending_output = string.slice(written_from_string);
+                written += written_from_string;
+            }
         }
 
-        return decompressed;
+        return output.trim(written);
     }
 
+    bool has_reached_end_of_data() const { return m_reached_end_of_data && m_pending_output.is_empty(); }
+
+private:
+    static constexpr int max_code_size = 12;
+    static constexpr int max_table_size = 1 << max_code_size;
+
     void reset()
     {
-        LzwState::reset();
-        m_output.clear();
+        m_next_code = m_end_of_data_code + 1;
+        m_code_size = m_initial_code_size;
+        m_table_capacity = AK::exp2<u32>(m_code_size);
+        m_previous_code.clear();
     }
 
     ErrorOr<u16> next_code()
     {
-        m_current_code = TRY(m_bit_stream->template read_bits<u16>(m_code_size));
+        auto const code = TRY(m_bit_stream->template read_bits<u16>(m_code_size));
 
-        if (m_current_code > m_code_table.size()) {
-            dbgln_if(LZW_DEBUG, "Corrupted LZW stream, invalid code: {}, code table size: {}",
-                m_current_code,
-                m_code_table.size());
+        if (code > m_next_code) {
+            dbgln_if(LZW_DEBUG, "Corrupted LZW stream, invalid code: {}, code table size: {}", code, m_next_code);
             return Error::from_string_literal("Corrupted LZW stream, invalid code");
-        } else if (m_current_code == m_code_table.size() && m_output.is_empty()) {
-            dbgln_if(LZW_DEBUG, "Corrupted LZW stream, valid new code but output buffer is empty: {}, code table size: {}",
-                m_current_code,
-                m_code_table.size());
+        } else if (code == m_next_code && !m_previous_code.has_value()) {
+            dbgln_if(LZW_DEBUG, "Corrupted LZW stream, valid new code but output buffer is empty: {}, code table size: {}", code, m_next_code);
             return Error::from_string_literal("Corrupted LZW stream, valid new code but output buffer is empty");
         }
 
-        return m_current_code;
+        return code;
     }
 
-    Vector<u8>& get_output()
+    // Every code but the first one after a reset adds the previous string followed by the first byte of the current one
+    // to the table. If the current code is the one that is being added, its first byte is the first byte of the previous string.
+    void extend_code_table(u16 code)
     {
-        VERIFY(m_current_code <= m_code_table.size());
-        if (m_current_code < m_code_table.size()) {
-            Vector<u8> new_entry = m_output;
-            m_output = m_code_table.at(m_current_code);
-            new_entry.append(m_output[0]);
-            extend_code_table(new_entry);
-        } else if (m_current_code == m_code_table.size()) {
-            VERIFY(!m_output.is_empty());
-            m_output.append(m_output[0]);
-            extend_code_table(m_output);
+        if (m_previous_code.has_value() && m_next_code < max_table_size) {
+            u16 const previous_code = *m_previous_code;
+            u16 const new_code = m_next_code++;
+
+            m_prefixes[new_code] = previous_code;
+            m_suffixes[new_code] = code == new_code ? m_first_bytes[previous_code] : m_first_bytes[code];
+            m_first_bytes[new_code] = m_first_bytes[previous_code];
+            m_lengths[new_code] = m_lengths[previous_code] + 1;
+
+            if (m_next_code >= (m_table_capacity + m_offset_for_size_change) && m_code_size < max_code_size) {
+                ++m_code_size;
+                m_table_capacity *= 2;
+            }
         }
-        return m_output;
+
+        m_previous_code = code;
+    }
+
+    // The table only stores the last byte of each string and the code for the rest of it, so strings are written back to front.
+    ALWAYS_INLINE void write_string(u16 code, Bytes destination) const
+    {
+        VERIFY(destination.size() == m_lengths[code]);
+
+        u8* data = destination.data();
+        for (size_t i = destination.size() - 1; i > 0; --i) {
+            data[i] = m_suffixes[code];
+            code = m_prefixes[code];
+        }
+        data[0] = m_suffixes[code];
     }
 
-private:
     MaybeOwned<InputStream> m_bit_stream;
 
-    u16 m_current_code { 0 };
-    Vector<u8> m_output {};
+    Array<u16, max_table_size> m_prefixes {};
+    Array<u8, max_table_size> m_suffixes {};
+    Array<u8, max_table_size> m_first_bytes {};
+    Array<u16, max_table_size> m_lengths {};
+
+    u16 m_clear_code { 0 };
+    u16 m_end_of_data_code { 0 };
+    u16 m_next_code { 0 };
+    Optional<u16> m_previous_code;
+
+    u8 m_code_size { 0 };
+    u8 m_initial_code_size { 0 };
+
+    u32 m_table_capacity { 0 };
+    i32 m_offset_for_size_change {};
+
+    bool m_reached_end_of_data { false };
+
+    Array<u8, max_table_size> m_pending_output_buffer;
+    Bytes m_pending_output;
 };
 
 class LzwCompressor : private Details::LzwState {
@@ -4,11 +4,16 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AtomicRefCounted.h>
 #include <AK/ByteBuffer.h>
 #include <AK/MemoryStream.h>
 #include <LibCompress/Lzma2.h>
 #include <LibCompress/Xz.h>
+#include <LibCore/System.h>
 #include <LibCrypto/Checksum/CRC32.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/ThreadPool.h>
 
 namespace Compress {
 
@@ -339,20 +344,47 @@ void XzFilterBCJArm64::close()
 {
 }
 
+struct XzDecompressor::BlockInFlight : public AtomicRefCounted<BlockInFlight> {
+    Optional<u64> expected_uncompressed_size;
+    u64 unpadded_size { 0 };
+
+    Threading::Mutex mutex;
+    Threading::ConditionVariable finished { mutex };
+    Optional<ErrorOr<ByteBuffer>> output;
+};
+
 ErrorOr<NonnullOwnPtr<XzDecompressor>> XzDecompressor::create(MaybeOwned<Stream> stream)
 {
     auto counting_stream = TRY(try_make<CountingStream>(move(stream)));
 
-    auto decompressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) XzDecompressor(move(counting_stream))));
+    auto decompressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) XzDecompressor(move(counting_stream), 0)));
+
+    return decompressor;
+}
+
+ErrorOr<NonnullOwnPtr<XzDecompressor>> XzDecompressor::create_parallel(MaybeOwned<Stream> stream, size_t thread_count)
+{
+    if (thread_count == 0)
+        thread_count = Core::System::hardware_concurrency();
+    if (thread_count <= 1)
+        return create(move(stream));
+
+    auto counting_stream = TRY(try_make<CountingStream>(move(stream)));
+
+    auto decompressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) XzDecompressor(move(counting_stream), thread_count)));
 
     return decompressor;
 }
 
-XzDecompressor::XzDecompressor(NonnullOwnPtr<CountingStream> stream)
+XzDecompressor::XzDecompressor(NonnullOwnPtr<CountingStream> stream, size_t max_blocks_in_flight)
     : m_stream(move(stream))
+    , m_max_blocks_in_flight(max_blocks_in_flight)
 {
 }
 
+// NOTE: Blocks that are still being decompressed keep their own reference, so they can safely outlive us.
+XzDecompressor::~XzDecompressor() = default;
+
 static Optional<size_t> size_for_check_type(XzStreamCheckType check_type)
 {
     switch (check_type) {
@@ -430,7 +462,7 @@ ErrorOr<bool> XzDecompressor::load_next_stream()
     return true;
 }
 
-ErrorOr<void> XzDecompressor::load_next_block(u8 encoded_block_header_size)
+ErrorOr<XzDecompressor::BlockHeader> XzDecompressor::read_block_header(u8 encoded_block_header_size)
 {
     // We already read the encoded Block Header size (one byte) to determine that this is not an Index.
     m_current_block_start_offset = m_stream->read_bytes() - 1;
@@ -465,7 +497,7 @@ ErrorOr<void> XzDecompressor::load_next_block(u8 encoded_block_header_size)
     if (flags.reserved != 0)
         return Error::from_string_literal("XZ block header has reserved non-null block flag bits");
 
-    MaybeOwned<Stream> new_block_stream { *m_stream };
+    BlockHeader block_header;
 
     // 3.1.3. Compressed Size:
     // "This field is present only if the appropriate bit is set in
@@ -479,7 +511,7 @@ ErrorOr<void> XzDecompressor::load_next_block(u8 encoded_block_header_size)
         if (compressed_size == 0)
             return Error::from_string_literal("XZ block header contains a compressed size of zero");
 
-        new_block_stream = TRY(try_make<ConstrainedStream>(move(new_block_stream), compressed_size));
+        block_header.compressed_size = compressed_size;
     }
 
     // 3.1.4. Uncompressed Size:
@@ -489,19 +521,9 @@ ErrorOr<void> XzDecompressor::load_next_block(u8 encoded_block_header_size)
         // "Uncompressed Size is stored using the encoding described in Section 1.2."
         u64 const uncompressed_size = TRY(header_stream.read_value<XzMultibyteInteger>());
 
-        m_current_block_expected_uncompressed_size = uncompressed_size;
-    } else {
-        m_current_block_expected_uncompressed_size.clear();
+        block_header.uncompressed_size = uncompressed_size;
     }
 
-    // We need to process the filters in reverse order, since they are listed in the order that they have been applied in.
-    struct FilterEntry {
-        u64 id;
-        ByteBuffer properties;
-        bool last;
-    };
-    Vector<FilterEntry, 4> filters;
-
     // 3.1.5. List of Filter Flags:
     // "The number of Filter Flags fields is stored in the Block Flags
     //  field (see Section 3.1.2)."
@@ -518,10 +540,45 @@ ErrorOr<void> XzDecompressor::load_next_block(u8 encoded_block_header_size)
         auto filter_properties = TRY(ByteBuffer::create_uninitialized(size_of_properties));
         TRY(header_stream.read_until_filled(filter_properties));
 
-        filters.empend(filter_id, move(filter_properties), last);
+        TRY(block_header.filters.try_empend(filter_id, move(filter_properties), last));
     }
 
-    for (auto& filter : filters.in_reverse()) {
+    // 3.1.6. Header Padding:
+    // "This field contains as many null byte as it is needed to make
+    //  the Block Header have the size specified in Block Header Size."
+    constexpr size_t size_of_block_header_size = 1;
+    constexpr size_t size_of_crc32 = 4;
+    while (MUST(header_stream.tell()) < block_header_size - size_of_block_header_size - size_of_crc32) {
+        auto const padding_byte = TRY(header_stream.read_value<u8>());
+
+        // "If any of the bytes are not null bytes, the decoder MUST
+        //  indicate an error."
+        if (padding_byte != 0)
+            return Error::from_string_literal("XZ block header padding contains non-null bytes");
+    }
+
+    // 3.1.7. CRC32:
+    // "The CRC32 is calculated over everything in the Block Header
+    //  field except the CRC32 field itself.
+    Crypto::Checksum::CRC32 calculated_header_crc32 { header.span().trim(block_header_size - size_of_crc32) };
+    //  It is stored as an unsigned 32-bit little endian integer.
+    u32 const stored_header_crc32 = TRY(header_stream.read_value<LittleEndian<u32>>());
+    //  If the calculated value does not match the stored one, the decoder MUST indicate
+    //  an error."
+    if (calculated_header_crc32.digest() != stored_header_crc32)
+        return Error::from_string_literal("Stored XZ block header CRC32 does not match the stored CRC32");
+
+    return block_header;
+}
+
+ErrorOr<MaybeOwned<Stream>> XzDecompressor::create_block_stream(MaybeOwned<Stream> compressed_data, BlockHeader const& block_header)
+{
+    MaybeOwned<Stream> new_block_stream = move(compressed_data);
+    if (block_header.compressed_size.has_value())
+        new_block_stream = TRY(try_make<ConstrainedStream>(move(new_block_stream), *block_header.compressed_size));
+
+    // We need to process the filters in reverse order, since they are listed in the order that they have been applied in.
+    for (auto const& filter : block_header.filters.in_reverse()) {
         // 5.3.1. LZMA2
         if (filter.id == 0x21) {
             if (!filter.last)
@@ -530,7 +587,7 @@ ErrorOr<void> XzDecompressor::load_next_block(u8 encoded_block_header_size)
             if (filter.properties.size() < sizeof(XzFilterLzma2Properties))
                 return Error::from_string_literal("XZ LZMA2 filter has a smaller-than-needed properties size");
 
-            auto const* properties = reinterpret_cast<XzFilterLzma2Properties*>(filter.properties.data());
+            auto const* properties = reinterpret_cast<XzFilterLzma2Properties const*>(filter.properties.data());
             TRY(properties->validate());
 
             new_block_stream = TRY(Lzma2Decompressor::create_from_raw_stream(move(new_block_stream), properties->dictionary_size()));
@@ -546,7 +603,7 @@ ErrorOr<void> XzDecompressor::load_next_block(u8 encoded_block_header_size)
             if (filter.properties.size() == 0) {
                 // No start offset given.
             } else if (filter.properties.size() == sizeof(XzFilterBCJProperties)) {
-                auto const* properties = reinterpret_cast<XzFilterBCJProperties*>(filter.properties.data());
+                auto const* properties = reinterpret_cast<XzFilterBCJProperties const*>(filter.properties.data());
                 start_offset = properties->start_offset;
             } else {
                 return Error::from_string_literal("XZ BCJ filter has an unknown properties size");
@@ -564,7 +621,7 @@ ErrorOr<void> XzDecompressor::load_next_block(u8 encoded_block_header_size)
             if (filter.properties.size() < sizeof(XzFilterDeltaProperties))
                 return Error::from_string_literal("XZ Delta filter has a smaller-than-needed properties size");
 
-            auto const* properties = reinterpret_cast<XzFilterDeltaProperties*>(filter.properties.data());
+            auto const* properties = reinterpret_cast<XzFilterDeltaProperties const*>(filter.properties.data());
 
             new_block_stream = TRY(XzFilterDelta::create(move(new_block_stream), properties->distance()));
             continue;
@@ -573,40 +630,12 @@ ErrorOr<void> XzDecompressor::load_next_block(u8 encoded_block_header_size)
         return Error::from_string_literal("XZ block header contains unknown filter ID");
     }
 
-    // 3.1.6. Header Padding:
-    // "This field contains as many null byte as it is needed to make
-    //  the Block Header have the size specified in Block Header Size."
-    constexpr size_t size_of_block_header_size = 1;
-    constexpr size_t size_of_crc32 = 4;
-    while (MUST(header_stream.tell()) < block_header_size - size_of_block_header_size - size_of_crc32) {
-        auto const padding_byte = TRY(header_stream.read_value<u8>());
-
-        // "If any of the bytes are not null bytes, the decoder MUST
-        //  indicate an error."
-        if (padding_byte != 0)
-            return Error::from_string_literal("XZ block header padding contains non-null bytes");
-    }
-
-    // 3.1.7. CRC32:
-    // "The CRC32 is calculated over everything in the Block Header
-    //  field except the CRC32 field itself.
-    Crypto::Checksum::CRC32 calculated_header_crc32 { header.span().trim(block_header_size - size_of_crc32) };
-    //  It is stored as an unsigned 32-bit little endian integer.
-    u32 const stored_header_crc32 = TRY(header_stream.read_value<LittleEndian<u32>>());
-    //  If the calculated value does not match the stored one, the decoder MUST indicate
-    //  an error."
-    if (calculated_header_crc32.digest() != stored_header_crc32)
-        return Error::from_string_literal("Stored XZ block header CRC32 does not match the stored CRC32");
-
-    m_current_block_stream = move(new_block_stream);
-    m_current_block_uncompressed_size = 0;
-
-    return {};
+    return new_block_stream;
 }
 
-ErrorOr<void> XzDecompressor::finish_current_block()
+ErrorOr<u64> XzDecompressor::read_block_padding_and_check()
 {
-    auto unpadded_size = m_stream->read_bytes() - m_current_block_start_offset;
+    u64 unpadded_size = m_stream->read_bytes() - m_current_block_start_offset;
 
     // 3.3. Block Padding:
     // "Block Padding MUST contain 0-3 null bytes to make the size of
@@ -640,6 +669,15 @@ ErrorOr<void> XzDecompressor::finish_current_block()
     TRY(m_stream->discard(*maybe_check_size));
     unpadded_size += *maybe_check_size;
 
+    return unpadded_size;
+}
+
+ErrorOr<void> XzDecompressor::finish_current_block()
+{
+    // Blocks that were decompressed ahead of time already had their trailing data read.
+    if (!m_current_block_unpadded_size.has_value())
+        m_current_block_unpadded_size = TRY(read_block_padding_and_check());
+
     if (m_current_block_expected_uncompressed_size.has_value()) {
         if (*m_current_block_expected_uncompressed_size != m_current_block_uncompressed_size)
             return Error::from_string_literal("Uncompressed size of XZ block does not match the expected value");
@@ -647,9 +685,13 @@ ErrorOr<void> XzDecompressor::finish_current_block()
 
     TRY(m_processed_blocks.try_append({
         .uncompressed_size = m_current_block_uncompressed_size,
-        .unpadded_size = unpadded_size,
+        .unpadded_size = *m_current_block_unpadded_size,
     }));
 
+    m_current_block_stream.clear();
+    m_current_block_output.clear();
+    m_current_block_unpadded_size.clear();
+
     return {};
 }
 
@@ -756,6 +798,95 @@ ErrorOr<void> XzDecompressor::finish_current_stream()
     return {};
 }
 
+ErrorOr<void> XzDecompressor::read_ahead()
+{
+    while (!m_found_index && !m_next_block_header.has_value()) {
+        // Once enough blocks are in flight, only read on if there is nothing else to do.
+        if (!m_blocks_in_flight.is_empty() && m_blocks_in_flight.size() >= m_max_blocks_in_flight)
+            return {};
+
+        // The first byte between Block Header (3.1.1. Block Header Size) and Index (4.1. Index Indicator) overlap.
+        // Block header sizes have valid values in the range of [0x01, 0xFF], the only valid value for an Index Indicator is therefore 0x00.
+        auto const encoded_block_header_size_or_index_indicator = TRY(m_stream->read_value<u8>());
+
+        if (encoded_block_header_size_or_index_indicator == 0x00) {
+            // This is an Index, which is the last element before the stream footer.
+            m_found_index = true;
+            return {};
+        }
+
+        auto block_header = TRY(read_block_header(encoded_block_header_size_or_index_indicator));
+
+        // Without knowing where the block ends, we can't read past it before decompressing it.
+        if (m_max_blocks_in_flight == 0 || !block_header.compressed_size.has_value()) {
+            m_next_block_header = move(block_header);
+            return {};
+        }
+
+        TRY(start_block_in_flight(move(block_header)));
+    }
+
+    return {};
+}
+
+ErrorOr<void> XzDecompressor::start_block_in_flight(BlockHeader block_header)
+{
+    auto block = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) BlockInFlight));
+    block->expected_uncompressed_size = block_header.uncompressed_size;
+
+    auto compressed_data = TRY(ByteBuffer::create_uninitialized(*block_header.compressed_size));
+    TRY(m_stream->read_until_filled(compressed_data));
+    block->unpadded_size = TRY(read_block_padding_and_check());
+
+    m_blocks_in_flight.enqueue(block);
+
+    Threading::ThreadPool::the().enqueue([block, block_header = move(block_header), compressed_data = move(compressed_data)]() {
+        auto decompress = [&]() -> ErrorOr<ByteBuffer> {
+            auto block_stream = TRY(create_block_stream(TRY(try_make<FixedMemoryStream>(compressed_data.bytes())), block_header));
+            return block_stream->read_until_eof(64 * KiB);
+        };
+        auto output = decompress();
+
+        Threading::MutexLocker locker { block->mutex };
+        block->output = move(output);
+        block->finished.signal();
+    });
+
+    return {};
+}
+
+ErrorOr<void> XzDecompressor::load_next_block()
+{
+    TRY(read_ahead());
+
+    if (!m_blocks_in_flight.is_empty()) {
+        auto block = m_blocks_in_flight.dequeue();
+
+        // Keep the pool busy while we are waiting for this block.
+        TRY(read_ahead());
+
+        {
+            Threading::MutexLocker locker { block->mutex };
+            block->finished.wait_while([&] { return !block->output.has_value(); });
+        }
+
+        m_current_block_output = TRY(block->output.release_value());
+        m_current_block_stream = TRY(try_make<FixedMemoryStream>(m_current_block_output.bytes()));
+        m_current_block_expected_uncompressed_size = block->expected_uncompressed_size;
+        m_current_block_unpadded_size = block->unpadded_size;
+        m_current_block_uncompressed_size = 0;
+        return {};
+    }
+
+    VERIFY(m_next_block_header.has_value());
+    auto block_header = m_next_block_header.release_value();
+
+    m_current_block_stream = TRY(create_block_stream(MaybeOwned<Stream> { *m_stream }, block_header));
+    m_current_block_expected_uncompressed_size = block_header.uncompressed_size;
+    m_current_block_uncompressed_size = 0;
+    return {};
+}
+
 ErrorOr<Bytes> XzDecompressor::read_some(Bytes bytes)
 {
     if (!m_stream_flags.has_value()) {
@@ -769,21 +900,19 @@ ErrorOr<Bytes> XzDecompressor::read_some(Bytes bytes)
             TRY(finish_current_block());
         }
 
-        // The first byte between Block Header (3.1.1. Block Header Size) and Index (4.1. Index Indicator) overlap.
-        // Block header sizes have valid values in the range of [0x01, 0xFF], the only valid value for an Index Indicator is therefore 0x00.
-        auto const encoded_block_header_size_or_index_indicator = TRY(m_stream->read_value<u8>());
+        TRY(read_ahead());
 
-        if (encoded_block_header_size_or_index_indicator == 0x00) {
-            // This is an Index, which is the last element before the stream footer.
+        if (m_blocks_in_flight.is_empty() && m_found_index && !m_next_block_header.has_value()) {
             TRY(finish_current_stream());
 
             // Another XZ Stream might follow, so we just unset the current information and continue on the next read.
             m_stream_flags.clear();
             m_processed_blocks.clear();
+            m_found_index = false;
             return bytes.trim(0);
         }
 
-        TRY(load_next_block(encoded_block_header_size_or_index_indicator));
+        TRY(load_next_block());
     }
 
     auto result = TRY((*m_current_block_stream)->read_some(bytes));
@@ -14,6 +14,7 @@
 #include <AK/MaybeOwned.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/OwnPtr.h>
+#include <AK/Queue.h>
 #include <AK/Stream.h>
 #include <AK/Vector.h>
 
@@ -156,6 +157,13 @@ class XzDecompressor : public Stream {
 public:
     static ErrorOr<NonnullOwnPtr<XzDecompressor>> create(MaybeOwned<Stream>);
 
+    // Reads ahead and decompresses up to thread_count blocks at once on the shared thread pool. This only applies to
+    // blocks that store their compressed size in the block header (as multithreaded xz writes them), all other blocks
+    // are decompressed as they are read. A thread count of zero uses all available cores.
+    static ErrorOr<NonnullOwnPtr<XzDecompressor>> create_parallel(MaybeOwned<Stream>, size_t thread_count = 0);
+
+    virtual ~XzDecompressor() override;
+
     virtual ErrorOr<Bytes> read_some(Bytes) override;
     virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
     virtual bool is_eof() const override;
@@ -163,10 +171,28 @@ public:
     virtual void close() override;
 
 private:
-    XzDecompressor(NonnullOwnPtr<CountingStream>);
+    XzDecompressor(NonnullOwnPtr<CountingStream>, size_t max_blocks_in_flight);
+
+    struct BlockHeader {
+        struct Filter {
+            u64 id;
+            ByteBuffer properties;
+            bool last;
+        };
+
+        Optional<u64> compressed_size;
+        Optional<u64> uncompressed_size;
+        Vector<Filter, 4> filters;
+    };
+    struct BlockInFlight;
 
     ErrorOr<bool> load_next_stream();
-    ErrorOr<void> load_next_block(u8 encoded_block_header_size);
+    ErrorOr<BlockHeader> read_block_header(u8 encoded_block_header_size);
+    static ErrorOr<MaybeOwned<Stream>> create_block_stream(MaybeOwned<Stream>, BlockHeader const&);
+    ErrorOr<void> read_ahead();
+    ErrorOr<void> start_block_in_flight(BlockHeader);
+    ErrorOr<void> load_next_block();
+    ErrorOr<u64> read_block_padding_and_check();
     ErrorOr<void> finish_current_block();
     ErrorOr<void> finish_current_stream();
 
@@ -180,6 +206,17 @@ private:
     u64 m_current_block_uncompressed_size {};
     u64 m_current_block_start_offset {};
 
+    // Blocks that are read ahead are decompressed as a whole, and their trailing data was already read.
+    ByteBuffer m_current_block_output;
+    Optional<u64> m_current_block_unpadded_size {};
+
+    size_t m_max_blocks_in_flight { 0 };
+    Queue<NonnullRefPtr<BlockInFlight>> m_blocks_in_flight;
+
+    // Reading ahead stops at the first block that can't be decompressed separately, and at the Index.
+    Optional<BlockHeader> m_next_block_header {};
+    bool m_found_index { false };
+
     struct BlockMetadata {
         u64 uncompressed_size {};
         u64 unpadded_size {};
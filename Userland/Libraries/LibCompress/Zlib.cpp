@@ -89,7 +89,7 @@ ZlibCompressor::~ZlibCompressor()
     VERIFY(m_finished);
 }
 
-ErrorOr<void> ZlibCompressor::write_header(ZlibCompressionMethod compression_method, ZlibCompressionLevel compression_level)
+static ZlibHeader make_header(ZlibCompressionMethod compression_method, ZlibCompressionLevel compression_level)
 {
     u8 compression_info = 0;
     if (compression_method == ZlibCompressionMethod::Deflate) {
@@ -105,6 +105,12 @@ ErrorOr<void> ZlibCompressor::write_header(ZlibCompressionMethod compression_met
         .compression_level = compression_level,
     };
     header.check_bits = 0b11111 - header.as_u16 % 31;
+    return header;
+}
+
+ErrorOr<void> ZlibCompressor::write_header(ZlibCompressionMethod compression_method, ZlibCompressionLevel compression_level)
+{
+    auto header = make_header(compression_method, compression_level);
 
     // FIXME: Support pre-defined dictionaries.
 
@@ -171,4 +177,18 @@ ErrorOr<ByteBuffer> ZlibCompressor::compress_all(ReadonlyBytes bytes, ZlibCompre
     return buffer;
 }
 
+ErrorOr<ByteBuffer> ZlibCompressor::compress_all_in_parallel(ReadonlyBytes bytes, ZlibCompressionLevel compression_level, size_t thread_count)
+{
+    auto header = make_header(ZlibCompressionMethod::Deflate, compression_level);
+    auto compressed_bytes = TRY(DeflateCompressor::compress_all_in_parallel(bytes, static_cast<DeflateCompressor::CompressionLevel>(compression_level), thread_count));
+    NetworkOrdered<u32> adler_sum = Crypto::Checksum::Adler32 { bytes }.digest();
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(sizeof(header) + compressed_bytes.size() + sizeof(adler_sum)));
+    memcpy(buffer.data(), &header.as_u16, sizeof(header));
+    memcpy(buffer.offset_pointer(sizeof(header)), compressed_bytes.data(), compressed_bytes.size());
+    memcpy(buffer.offset_pointer(sizeof(header) + compressed_bytes.size()), &adler_sum, sizeof(adler_sum));
+
+    return buffer;
+}
+
 }
@@ -75,6 +75,10 @@ public:
 
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, ZlibCompressionLevel = ZlibCompressionLevel::Default);
 
+    // Produces a single zlib stream, but compresses it in independent chunks on multiple threads. The output is
+    // slightly larger than that of compress_all().
+    static ErrorOr<ByteBuffer> compress_all_in_parallel(ReadonlyBytes bytes, ZlibCompressionLevel = ZlibCompressionLevel::Default, size_t thread_count = 0);
+
 private:
     ZlibCompressor(MaybeOwned<Stream> stream, NonnullOwnPtr<Stream> compressor_stream);
     ErrorOr<void> write_header(ZlibCompressionMethod, ZlibCompressionLevel);
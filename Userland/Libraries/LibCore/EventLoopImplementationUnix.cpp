@@ -20,6 +20,22 @@
 #include <sys/select.h>
 #include <unistd.h>
 
+// Waiting with poll() means handing the kernel every file descriptor we watch on every iteration, and then looking
+// through all of them for the few that are ready. Where the system lets us keep a persistent set of watched file
+// descriptors around instead, use that.
+#if defined(AK_OS_LINUX) && !defined(AK_OS_ANDROID)
+#    define EVENT_LOOP_USES_EPOLL 1
+#    include <sys/epoll.h>
+#elif defined(AK_OS_BSD_GENERIC)
+#    define EVENT_LOOP_USES_KQUEUE 1
+#    include <fcntl.h>
+#    include <sys/event.h>
+#endif
+
+#if defined(EVENT_LOOP_USES_EPOLL) || defined(EVENT_LOOP_USES_KQUEUE)
+#    define EVENT_LOOP_USES_EVENT_QUEUE 1
+#endif
+
 namespace Core {
 
 namespace {
@@ -33,6 +49,7 @@ static pthread_rwlock_t* s_thread_data_lock = nullptr;
 thread_local pthread_t s_thread_id;
 thread_local OwnPtr<ThreadData> s_this_thread_data;
 
+#ifndef EVENT_LOOP_USES_EVENT_QUEUE
 short notification_type_to_poll_events(NotificationType type)
 {
     short events = 0;
@@ -42,12 +59,40 @@ short notification_type_to_poll_events(NotificationType type)
         events |= POLLOUT;
     return events;
 }
+#endif
 
 bool has_flag(int value, int flag)
 {
     return (value & flag) == flag;
 }
 
+#ifdef EVENT_LOOP_USES_EPOLL
+u32 notification_type_to_epoll_events(NotificationType type)
+{
+    // Hang-ups and errors are always reported.
+    u32 events = 0;
+    if (has_flag(type, NotificationType::Read))
+        events |= EPOLLIN;
+    if (has_flag(type, NotificationType::Write))
+        events |= EPOLLOUT;
+    return events;
+}
+
+NotificationType epoll_events_to_notification_type(u32 events)
+{
+    NotificationType type = NotificationType::None;
+    if (has_flag(events, EPOLLIN))
+        type |= NotificationType::Read;
+    if (has_flag(events, EPOLLOUT))
+        type |= NotificationType::Write;
+    if (has_flag(events, EPOLLHUP))
+        type |= NotificationType::HangUp;
+    if (has_flag(events, EPOLLERR))
+        type |= NotificationType::Error;
+    return type;
+}
+#endif
+
 class EventLoopTimeout {
 public:
     static constexpr ssize_t INVALID_INDEX = NumericLimits<ssize_t>::max();
@@ -59,6 +104,12 @@ public:
 
     MonotonicTime fire_time() const { return m_fire_time; }
 
+    // The timeout may fire this much later than its fire time, so that it can fire together with other timeouts
+    // instead of waking the event loop up once for each of them.
+    AK::Duration slack() const { return m_slack; }
+    void set_slack(AK::Duration slack) { m_slack = slack; }
+    MonotonicTime latest_fire_time() const { return m_fire_time + m_slack; }
+
     void absolutize(Badge<TimeoutSet>, MonotonicTime current_time)
     {
         m_fire_time = current_time + m_duration;
@@ -76,6 +127,7 @@ protected:
     };
 
 private:
+    AK::Duration m_slack;
     ssize_t m_index = INVALID_INDEX;
 };
 
@@ -83,10 +135,12 @@ class TimeoutSet {
 public:
     TimeoutSet() = default;
 
+    // The time by which the event loop has to wake up for the next timeout. This waits out the slack of the timeout
+    // that has to fire first, and the timeouts after it whose fire time has come by then fire along with it.
     Optional<MonotonicTime> next_timer_expiration()
     {
         if (!m_heap.is_empty()) {
-            return m_heap.peek_min()->fire_time();
+            return m_heap.peek_min()->latest_fire_time();
         } else {
             return {};
         }
@@ -158,8 +212,10 @@ public:
 private:
     IntrusiveBinaryHeap<
         EventLoopTimeout*,
+        // NOTE: Timeouts are ordered by the latest time they may fire at, because a timeout that is due later can still
+        //       have less slack than one that is due earlier.
         decltype([](EventLoopTimeout* a, EventLoopTimeout* b) {
-            return a->fire_time() < b->fire_time();
+            return a->latest_fire_time() < b->latest_fire_time();
         }),
         decltype([](EventLoopTimeout* timeout, size_t index) {
             timeout->set_index({}, static_cast<ssize_t>(index));
@@ -217,6 +273,15 @@ public:
     Atomic<bool> is_being_deleted { false };
 };
 
+// Timers may be late by a small fraction of their interval, which lets timers that expire around the same time
+// (e.g. the many timers that pages set up) share one wakeup. Short timers get hardly any slack, and no timer gets
+// more than a few milliseconds, so animation timers stay on time.
+AK::Duration timer_slack_for_interval(AK::Duration interval)
+{
+    static constexpr auto max_timer_slack = AK::Duration::from_milliseconds(4);
+    return min(AK::Duration::from_microseconds(interval.to_microseconds() / 16), max_timer_slack);
+}
+
 struct ThreadData {
     static ThreadData& the()
     {
@@ -255,6 +320,7 @@ struct ThreadData {
     ThreadData()
     {
         pid = getpid();
+        initialize_event_queue();
         initialize_wake_pipe();
     }
 
@@ -263,8 +329,140 @@ struct ThreadData {
         pthread_rwlock_wrlock(&*s_thread_data_lock);
         s_thread_data.remove(s_thread_id);
         pthread_rwlock_unlock(&*s_thread_data_lock);
+
+#ifdef EVENT_LOOP_USES_EVENT_QUEUE
+        if (event_queue_fd != -1)
+            close(event_queue_fd);
+#endif
+    }
+
+    void initialize_event_queue()
+    {
+#ifdef EVENT_LOOP_USES_EVENT_QUEUE
+        // NOTE: After a fork, the child shares the parent's epoll instance, so it has to make one of its own.
+        if (event_queue_fd != -1)
+            close(event_queue_fd);
+        notifiers_by_fd.clear();
+        always_ready_fds.clear();
+
+#    ifdef EVENT_LOOP_USES_EPOLL
+        event_queue_fd = epoll_create1(EPOLL_CLOEXEC);
+#    else
+        event_queue_fd = kqueue();
+        if (event_queue_fd != -1)
+            fcntl(event_queue_fd, F_SETFD, FD_CLOEXEC);
+#    endif
+        if (event_queue_fd == -1) {
+            perror("EventLoopImplementationUnix: Failed to create event queue");
+            VERIFY_NOT_REACHED();
+        }
+#endif
     }
 
+#ifdef EVENT_LOOP_USES_EVENT_QUEUE
+    // Tells the kernel which events to watch the file descriptor for, now that the notifiers on it want the given types
+    // instead of the previous ones. An empty type means that no notifier is left on the file descriptor at all.
+    void update_watched_events(int fd, Optional<NotificationType> previous_type, Optional<NotificationType> type)
+    {
+        if (always_ready_fds.contains(fd)) {
+            if (!type.has_value())
+                always_ready_fds.remove(fd);
+            return;
+        }
+
+#    ifdef EVENT_LOOP_USES_EPOLL
+        if (!type.has_value()) {
+            // This fails if the file descriptor was closed before its notifiers were disabled, which is fine,
+            // since closing it already made the kernel forget about it.
+            (void)epoll_ctl(event_queue_fd, EPOLL_CTL_DEL, fd, nullptr);
+            return;
+        }
+
+        epoll_event event {};
+        event.events = notification_type_to_epoll_events(*type);
+        event.data.fd = fd;
+        if (epoll_ctl(event_queue_fd, previous_type.has_value() ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event) < 0) {
+            // epoll refuses regular files and some devices, such as /dev/null.
+            if (errno == EPERM) {
+                always_ready_fds.set(fd);
+                return;
+            }
+            dbgln("EventLoopImplementationUnix: Failed to watch fd {}: {}", fd, Error::from_errno(errno));
+        }
+#    else
+        // kqueue watches reading and writing with separate filters. Without either, we can't tell about hang-ups.
+        auto was_reading = previous_type.has_value() && has_flag(*previous_type, NotificationType::Read);
+        auto was_writing = previous_type.has_value() && has_flag(*previous_type, NotificationType::Write);
+        auto is_reading = type.has_value() && has_flag(*type, NotificationType::Read);
+        auto is_writing = type.has_value() && has_flag(*type, NotificationType::Write);
+
+        struct kevent changes[2];
+        int change_count = 0;
+        if (was_reading != is_reading)
+            EV_SET(&changes[change_count++], fd, EVFILT_READ, is_reading ? EV_ADD : EV_DELETE, 0, 0, nullptr);
+        if (was_writing != is_writing)
+            EV_SET(&changes[change_count++], fd, EVFILT_WRITE, is_writing ? EV_ADD : EV_DELETE, 0, 0, nullptr);
+        if (change_count == 0)
+            return;
+
+        if (kevent(event_queue_fd, changes, change_count, nullptr, 0, nullptr) < 0 && (is_reading || is_writing)) {
+            // kqueue refuses some devices, such as /dev/null on macOS.
+            if (errno == EINVAL || errno == ENODEV) {
+                struct kevent deletions[2];
+                EV_SET(&deletions[0], fd, EVFILT_READ, EV_DELETE, 0, 0, nullptr);
+                EV_SET(&deletions[1], fd, EVFILT_WRITE, EV_DELETE, 0, 0, nullptr);
+                (void)kevent(event_queue_fd, deletions, 2, nullptr, 0, nullptr);
+                always_ready_fds.set(fd);
+                return;
+            }
+            dbgln("EventLoopImplementationUnix: Failed to watch fd {}: {}", fd, Error::from_errno(errno));
+        }
+#    endif
+    }
+
+    Optional<NotificationType> watched_type_for_fd(int fd) const
+    {
+        auto it = notifiers_by_fd.find(fd);
+        if (it == notifiers_by_fd.end())
+            return {};
+        NotificationType type = NotificationType::None;
+        for (auto* notifier : it->value)
+            type |= notifier->type();
+        return type;
+    }
+
+    void add_notifier(Notifier& notifier)
+    {
+        auto previous_type = watched_type_for_fd(notifier.fd());
+        notifiers_by_fd.ensure(notifier.fd()).append(&notifier);
+        update_watched_events(notifier.fd(), previous_type, watched_type_for_fd(notifier.fd()));
+    }
+
+    void remove_notifier(Notifier& notifier)
+    {
+        auto it = notifiers_by_fd.find(notifier.fd());
+        VERIFY(it != notifiers_by_fd.end());
+
+        auto previous_type = watched_type_for_fd(notifier.fd());
+        it->value.remove_first_matching([&](auto* entry) { return entry == &notifier; });
+        if (it->value.is_empty())
+            notifiers_by_fd.remove(it);
+        update_watched_events(notifier.fd(), previous_type, watched_type_for_fd(notifier.fd()));
+    }
+
+    void post_notifier_activations(int fd, NotificationType ready_type)
+    {
+        auto it = notifiers_by_fd.find(fd);
+        if (it == notifiers_by_fd.end())
+            return;
+        for (auto* notifier : it->value) {
+            auto type = ready_type & notifier->type();
+            if (type != NotificationType::None)
+                ThreadEventQueue::current().post_event(*notifier, make<NotifierActivationEvent>(notifier->fd(), type));
+        }
+    }
+#endif
+
     void initialize_wake_pipe()
     {
         if (wake_pipe_fds[0] != -1)
@@ -281,17 +479,31 @@ struct ThreadData {
         wake_pipe_fds = result.release_value();
 
         // The wake pipe informs us of POSIX signals as well as manual calls to wake()
+#ifdef EVENT_LOOP_USES_EVENT_QUEUE
+        update_watched_events(wake_pipe_fds[0], {}, NotificationType::Read);
+#else
         VERIFY(poll_fds.size() == 0);
         poll_fds.append({ .fd = wake_pipe_fds[0], .events = POLLIN, .revents = 0 });
         notifier_by_index.append(nullptr);
+#endif
     }
 
     // Each thread has its own timers, notifiers and a wake pipe.
     TimeoutSet timeouts;
 
+#ifdef EVENT_LOOP_USES_EVENT_QUEUE
+    // The epoll or kqueue instance, which knows about every file descriptor that this thread has notifiers on.
+    int event_queue_fd { -1 };
+    // There may be more than one notifier per file descriptor, e.g. one for reading and one for writing.
+    HashMap<int, Vector<Notifier*, 1>> notifiers_by_fd;
+    // File descriptors with notifiers that the event queue can't watch. poll() reports these as always ready to be
+    // read from and written to, so their notifiers are activated on every iteration, without waiting.
+    HashTable<int> always_ready_fds;
+#else
     Vector<pollfd> poll_fds;
     HashMap<Notifier*, size_t> notifier_by_ptr;
     Vector<Notifier*> notifier_by_index;
+#endif
 
     // The wake pipe is used to notify another event loop that someone has called wake(), or a signal has been received.
     // wake() writes 0i32 into the pipe, signals write the signal number (guaranteed non-zero).
@@ -381,6 +593,57 @@ retry:
         }
     }
 
+#ifdef EVENT_LOOP_USES_EVENT_QUEUE
+    if (!thread_data.always_ready_fds.is_empty()) {
+        timeout = 0;
+        should_wait_forever = false;
+    }
+#endif
+
+#if defined(EVENT_LOOP_USES_EPOLL)
+    static constexpr int max_events_per_wait = 64;
+    epoll_event ready_events[max_events_per_wait];
+
+try_select_again:
+    // Wait for file system events, calls to wake(), POSIX signals, or timer expirations.
+    int ready_event_count = epoll_wait(thread_data.event_queue_fd, ready_events, max_events_per_wait, should_wait_forever ? -1 : timeout);
+    auto time_after_poll = MonotonicTime::now_coarse();
+    // Because POSIX, we might spuriously return with EINTR; just wait again.
+    if (ready_event_count < 0) {
+        if (errno == EINTR)
+            goto try_select_again;
+        dbgln("EventLoopImplementationUnix::wait_for_events: {}", Error::from_errno(errno));
+        VERIFY_NOT_REACHED();
+    }
+
+    bool wake_pipe_is_readable = false;
+    for (int i = 0; i < ready_event_count; ++i) {
+        if (ready_events[i].data.fd == thread_data.wake_pipe_fds[0])
+            wake_pipe_is_readable = true;
+    }
+#elif defined(EVENT_LOOP_USES_KQUEUE)
+    static constexpr int max_events_per_wait = 64;
+    struct kevent ready_events[max_events_per_wait];
+
+try_select_again:
+    // Wait for file system events, calls to wake(), POSIX signals, or timer expirations.
+    timespec timeout_spec { .tv_sec = timeout / 1000, .tv_nsec = (timeout % 1000) * 1'000'000 };
+    int ready_event_count = kevent(thread_data.event_queue_fd, nullptr, 0, ready_events, max_events_per_wait, should_wait_forever ? nullptr : &timeout_spec);
+    auto time_after_poll = MonotonicTime::now_coarse();
+    // Because POSIX, we might spuriously return with EINTR; just wait again.
+    if (ready_event_count < 0) {
+        if (errno == EINTR)
+            goto try_select_again;
+        dbgln("EventLoopImplementationUnix::wait_for_events: {}", Error::from_errno(errno));
+        VERIFY_NOT_REACHED();
+    }
+
+    bool wake_pipe_is_readable = false;
+    for (int i = 0; i < ready_event_count; ++i) {
+        if (static_cast<int>(ready_events[i].ident) == thread_data.wake_pipe_fds[0])
+            wake_pipe_is_readable = true;
+    }
+#else
 try_select_again:
     // select() and wait for file system events, calls to wake(), POSIX signals, or timer expirations.
     ErrorOr<int> error_or_marked_fd_count = System::poll(thread_data.poll_fds, should_wait_forever ? -1 : timeout);
@@ -393,9 +656,12 @@ try_select_again:
         VERIFY_NOT_REACHED();
     }
 
+    bool wake_pipe_is_readable = has_flag(thread_data.poll_fds[0].revents, POLLIN);
+#endif
+
     // We woke up due to a call to wake() or a POSIX signal.
     // Handle signals and see whether we need to handle events as well.
-    if (has_flag(thread_data.poll_fds[0].revents, POLLIN)) {
+    if (wake_pipe_is_readable) {
         int wake_events[8];
         ssize_t nread;
         // We might receive another signal while read()ing here. The signal will go to the handle_signal properly,
@@ -424,14 +690,49 @@ try_select_again:
             goto retry;
     }
 
+#if defined(EVENT_LOOP_USES_EPOLL)
+    // Handle file system notifiers by making them normal events.
+    for (int i = 0; i < ready_event_count; ++i) {
+        auto fd = ready_events[i].data.fd;
+        if (fd != thread_data.wake_pipe_fds[0])
+            thread_data.post_notifier_activations(fd, epoll_events_to_notification_type(ready_events[i].events));
+    }
+#elif defined(EVENT_LOOP_USES_KQUEUE)
+    // Handle file system notifiers by making them normal events.
+    // Reading and writing are reported separately, so gather them up first to activate each notifier only once.
+    HashMap<int, NotificationType, AK::Traits<int>, AK::Traits<NotificationType>, true> ready_types_by_fd;
+    for (int i = 0; i < ready_event_count; ++i) {
+        auto const& event = ready_events[i];
+        auto fd = static_cast<int>(event.ident);
+        if (fd == thread_data.wake_pipe_fds[0])
+            continue;
+
+        auto& type = ready_types_by_fd.ensure(fd, [] { return NotificationType::None; });
+        if (event.filter == EVFILT_READ)
+            type |= NotificationType::Read;
+        if (event.filter == EVFILT_WRITE)
+            type |= NotificationType::Write;
+        if (has_flag(event.flags, EV_EOF))
+            type |= NotificationType::HangUp;
+        if (has_flag(event.flags, EV_ERROR))
+            type |= NotificationType::Error;
+    }
+    for (auto& [fd, type] : ready_types_by_fd)
+        thread_data.post_notifier_activations(fd, type);
+#endif
+
+#ifdef EVENT_LOOP_USES_EVENT_QUEUE
+    for (auto fd : thread_data.always_ready_fds)
+        thread_data.post_notifier_activations(fd, NotificationType::Read | NotificationType::Write);
+#else
     if (error_or_marked_fd_count.value() != 0) {
         // Handle file system notifiers by making them normal events.
         for (size_t i = 1; i < thread_data.poll_fds.size(); ++i) {
             // FIXME: Make the check work under Android, pehaps use ALooper
-#ifdef AK_OS_ANDROID
+#    ifdef AK_OS_ANDROID
             auto& notifier = *thread_data.notifier_by_index[i];
             ThreadEventQueue::current().post_event(notifier, make<NotifierActivationEvent>(notifier.fd(), notifier.type()));
-#else
+#    else
             auto& revents = thread_data.poll_fds[i].revents;
             auto& notifier = *thread_data.notifier_by_index[i];
 
@@ -447,9 +748,10 @@ try_select_again:
             type &= notifier.type();
             if (type != NotificationType::None)
                 ThreadEventQueue::current().post_event(notifier, make<NotifierActivationEvent>(notifier.fd(), type));
-#endif
+#    endif
         }
     }
+#endif
 
     // Handle expired timers.
     thread_data.timeouts.fire_expired(time_after_poll);
@@ -526,9 +828,13 @@ void EventLoopImplementationUnix::notify_forked_and_in_child()
 {
     auto& thread_data = ThreadData::the();
     thread_data.timeouts.clear();
+#ifdef EVENT_LOOP_USES_EVENT_QUEUE
+    thread_data.initialize_event_queue();
+#else
     thread_data.poll_fds.clear();
     thread_data.notifier_by_ptr.clear();
     thread_data.notifier_by_index.clear();
+#endif
     thread_data.initialize_wake_pipe();
     if (auto* info = signals_info<false>()) {
         info->signal_handlers.clear();
@@ -658,6 +964,7 @@ intptr_t EventLoopManagerUnix::register_timer(EventReceiver& object, int millise
     timer->owner_thread = s_thread_id;
     timer->owner = object;
     timer->interval = AK::Duration::from_milliseconds(milliseconds);
+    timer->set_slack(timer_slack_for_interval(timer->interval));
     timer->reload(MonotonicTime::now_coarse());
     timer->should_reload = should_reload;
     timer->fire_when_not_visible = fire_when_not_visible;
@@ -684,6 +991,9 @@ void EventLoopManagerUnix::register_notifier(Notifier& notifier)
 {
     auto& thread_data = ThreadData::the();
 
+#ifdef EVENT_LOOP_USES_EVENT_QUEUE
+    thread_data.add_notifier(notifier);
+#else
     thread_data.notifier_by_ptr.set(&notifier, thread_data.poll_fds.size());
     thread_data.notifier_by_index.append(&notifier);
     thread_data.poll_fds.append({
@@ -691,6 +1001,7 @@ void EventLoopManagerUnix::register_notifier(Notifier& notifier)
         .events = notification_type_to_poll_events(notifier.type()),
         .revents = 0,
     });
+#endif
 
     notifier.set_owner_thread(s_thread_id);
 }
@@ -702,6 +1013,9 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
         return;
 
     auto& thread_data = *thread_data_ptr;
+#ifdef EVENT_LOOP_USES_EVENT_QUEUE
+    thread_data.remove_notifier(notifier);
+#else
     auto it = thread_data.notifier_by_ptr.find(&notifier);
     VERIFY(it != thread_data.notifier_by_ptr.end());
 
@@ -715,6 +1029,7 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
     }
     thread_data.poll_fds.take_last();
     thread_data.notifier_by_index.take_last();
+#endif
 }
 
 void EventLoopManagerUnix::did_post_event()
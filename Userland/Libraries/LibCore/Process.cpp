@@ -37,6 +37,9 @@ extern "C" {
 #if defined(AK_OS_FREEBSD)
 #    include <sys/user.h>
 #endif
+#if defined(AK_OS_MACOS)
+#    include <mach/mach.h>
+#endif
 
 namespace Core {
 
@@ -302,6 +305,31 @@ ErrorOr<bool> Process::is_being_debugged()
     return Error::from_string_literal("Platform does not support checking for debugger");
 }
 
+ErrorOr<size_t> Process::resident_memory_size()
+{
+#if defined(AK_OS_LINUX)
+    // The second field of /proc/self/statm is the resident set size, in pages.
+    auto statm_file = TRY(Core::File::open("/proc/self/statm"sv, Core::File::OpenMode::Read));
+    auto contents = TRY(statm_file->read_until_eof());
+    auto fields = StringView { contents }.split_view(' ');
+    if (fields.size() < 2)
+        return Error::from_string_literal("Unexpected contents of /proc/self/statm");
+    auto resident_pages = fields[1].to_number<size_t>();
+    if (!resident_pages.has_value())
+        return Error::from_string_literal("Unexpected contents of /proc/self/statm");
+    return *resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#elif defined(AK_OS_MACOS)
+    mach_task_basic_info_data_t basic_info {};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (auto result = task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&basic_info), &count); result != KERN_SUCCESS)
+        return Error::from_string_literal("Unable to get the task info of this process");
+    return basic_info.resident_size;
+#else
+    // FIXME: Implement this for more platforms.
+    return Error::from_string_literal("Platform does not support getting the resident memory size");
+#endif
+}
+
 // Forces the process to sleep until a debugger is attached, then breaks.
 void Process::wait_for_debugger_and_break()
 {
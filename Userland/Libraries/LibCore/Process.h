@@ -94,6 +94,9 @@ public:
     static void wait_for_debugger_and_break();
     static ErrorOr<bool> is_being_debugged();
 
+    // The number of bytes of this process's memory that are currently in RAM.
+    static ErrorOr<size_t> resident_memory_size();
+
     pid_t pid() const { return m_pid; }
 
     ErrorOr<void> disown();
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/NumericLimits.h>
+#include <LibCore/SharedByteRingBuffer.h>
+
+namespace Core {
+
+ErrorOr<SharedByteRingBuffer> SharedByteRingBuffer::create(size_t capacity)
+{
+    VERIFY(capacity > 0 && popcount(capacity) == 1);
+    VERIFY(capacity <= NumericLimits<u32>::max());
+
+    auto buffer = TRY(AnonymousBuffer::create_with_size(sizeof(Header) + capacity));
+    auto* header = new (buffer.data<u8>()) Header {};
+    header->capacity = static_cast<u32>(capacity);
+
+    return SharedByteRingBuffer { move(buffer), capacity };
+}
+
+ErrorOr<SharedByteRingBuffer> SharedByteRingBuffer::attach(AnonymousBuffer buffer)
+{
+    if (!buffer.is_valid() || buffer.size() < sizeof(Header))
+        return Error::from_string_literal("Shared ring buffer is too small");
+
+    auto capacity = static_cast<size_t>(reinterpret_cast<Header const*>(buffer.data<u8>())->capacity);
+    if (capacity == 0 || popcount(capacity) != 1 || buffer.size() < sizeof(Header) + capacity)
+        return Error::from_string_literal("Shared ring buffer has an invalid capacity");
+
+    return SharedByteRingBuffer { move(buffer), capacity };
+}
+
+SharedByteRingBuffer::SharedByteRingBuffer(AnonymousBuffer buffer, size_t capacity)
+    : m_buffer(move(buffer))
+    , m_header(reinterpret_cast<Header*>(m_buffer.data<u8>()))
+    , m_capacity(capacity)
+{
+}
+
+size_t SharedByteRingBuffer::used_space() const
+{
+    VERIFY(is_valid());
+    auto write_position = m_header->write_position.load();
+    auto read_position = m_header->read_position.load();
+    return static_cast<size_t>(write_position - read_position);
+}
+
+size_t SharedByteRingBuffer::write(ReadonlyBytes bytes)
+{
+    VERIFY(is_valid());
+
+    auto write_position = m_header->write_position.load(AK::MemoryOrder::memory_order_relaxed);
+    auto read_position = m_header->read_position.load(AK::MemoryOrder::memory_order_acquire);
+    auto free = m_capacity - static_cast<size_t>(write_position - read_position);
+
+    auto length = min(bytes.size(), free);
+    if (length == 0)
+        return 0;
+
+    auto offset = static_cast<size_t>(write_position & (m_capacity - 1));
+    auto first_part = min(length, m_capacity - offset);
+    __builtin_memcpy(data() + offset, bytes.data(), first_part);
+    __builtin_memcpy(data(), bytes.data() + first_part, length - first_part);
+
+    m_header->write_position.store(write_position + length, AK::MemoryOrder::memory_order_seq_cst);
+    return length;
+}
+
+size_t SharedByteRingBuffer::read(Bytes bytes)
+{
+    VERIFY(is_valid());
+
+    auto read_position = m_header->read_position.load(AK::MemoryOrder::memory_order_relaxed);
+    auto write_position = m_header->write_position.load(AK::MemoryOrder::memory_order_acquire);
+    auto used = static_cast<size_t>(write_position - read_position);
+
+    auto length = min(bytes.size(), used);
+    if (length == 0)
+        return 0;
+
+    auto offset = static_cast<size_t>(read_position & (m_capacity - 1));
+    auto first_part = min(length, m_capacity - offset);
+    __builtin_memcpy(bytes.data(), data() + offset, first_part);
+    __builtin_memcpy(bytes.data() + first_part, data(), length - first_part);
+
+    m_header->read_position.store(read_position + length, AK::MemoryOrder::memory_order_seq_cst);
+    return length;
+}
+
+void SharedByteRingBuffer::set_producer_is_waiting()
+{
+    VERIFY(is_valid());
+    m_header->producer_is_waiting.store(1, AK::MemoryOrder::memory_order_seq_cst);
+}
+
+bool SharedByteRingBuffer::take_producer_is_waiting()
+{
+    VERIFY(is_valid());
+    return m_header->producer_is_waiting.exchange(0, AK::MemoryOrder::memory_order_seq_cst) != 0;
+}
+
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Error.h>
+#include <AK/Span.h>
+#include <AK/Types.h>
+#include <LibCore/AnonymousBuffer.h>
+
+namespace Core {
+
+// A lock-free ring buffer of bytes with a single producer and a single consumer, residing in shared memory.
+// Unlike SharedSingleProducerCircularQueue, which moves one element at a time, this copies whole spans in and out,
+// which makes it suitable for streaming large amounts of data such as response bodies between processes.
+// It carries no means of waking up the other side; pair it with something pollable (a pipe or socket) for that.
+class SharedByteRingBuffer {
+public:
+    SharedByteRingBuffer() = default;
+
+    // Allocates a new ring buffer in shared memory. The capacity must be a power of two.
+    static ErrorOr<SharedByteRingBuffer> create(size_t capacity);
+
+    // Uses an existing ring buffer from shared memory that another process created.
+    static ErrorOr<SharedByteRingBuffer> attach(AnonymousBuffer);
+
+    bool is_valid() const { return m_header != nullptr; }
+    AnonymousBuffer const& anonymous_buffer() const { return m_buffer; }
+
+    size_t capacity() const { return m_capacity; }
+
+    // These are only hints unless called from the side that would be blocked by the answer, i.e. the producer asking
+    // for free space or the consumer asking for used space.
+    size_t used_space() const;
+    size_t free_space() const { return m_capacity - used_space(); }
+
+    // Producer side: copies as much of the given data as fits and returns how much that was.
+    size_t write(ReadonlyBytes);
+
+    // Consumer side: copies up to the given buffer's size out of the ring and returns how much that was.
+    size_t read(Bytes);
+
+    // Lets the producer ask to be woken up once the consumer has made room. The producer has to check for free space
+    // again after calling this, since the consumer may have caught up in the meantime.
+    void set_producer_is_waiting();
+
+    // Called by the consumer after reading. Returns whether the producer asked to be woken up, and resets that request.
+    bool take_producer_is_waiting();
+
+private:
+    struct Header {
+        Atomic<u64> write_position;
+        Atomic<u64> read_position;
+        Atomic<u32> producer_is_waiting;
+        u32 capacity;
+    };
+
+    SharedByteRingBuffer(AnonymousBuffer, size_t capacity);
+
+    u8* data() { return m_buffer.data<u8>() + sizeof(Header); }
+
+    AnonymousBuffer m_buffer;
+    Header* m_header { nullptr };
+    size_t m_capacity { 0 };
+};
+
+}
@@ -509,7 +509,8 @@ ErrorOr<int> anon_create([[maybe_unused]] size_t size, [[maybe_unused]] int opti
     fd = ::anon_create(round_up_to_power_of_two(size, PAGE_SIZE), options);
 #elif defined(AK_OS_LINUX) || defined(AK_OS_FREEBSD)
     // FIXME: Support more options on Linux.
-    auto linux_options = ((options & O_CLOEXEC) > 0) ? MFD_CLOEXEC : 0;
+    // NOTE: Sealing is allowed so that a process can promise whoever it shares the file with not to change it anymore.
+    auto linux_options = (((options & O_CLOEXEC) > 0) ? MFD_CLOEXEC : 0) | MFD_ALLOW_SEALING;
     fd = memfd_create("", linux_options);
     if (fd < 0)
         return Error::from_errno(errno);
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/MPSCQueue.h>
 #include <AK/Vector.h>
 #include <LibCore/DeferredInvocationContext.h>
 #include <LibCore/EventLoopImplementation.h>
@@ -34,8 +35,10 @@ struct ThreadEventQueue::Private {
         NonnullOwnPtr<Event> event;
     };
 
+    // Events are posted from any thread, so they get a queue of their own that doesn't need the mutex.
+    MPSCQueue<QueuedEvent> queued_events;
+
     Threading::Mutex mutex;
-    Vector<QueuedEvent, 128> queued_events;
     Vector<NonnullRefPtr<Promise<NonnullRefPtr<EventReceiver>>>, 16> pending_promises;
     bool warned_promise_count { false };
 };
@@ -69,10 +72,7 @@ ThreadEventQueue::~ThreadEventQueue() = default;
 
 void ThreadEventQueue::post_event(Core::EventReceiver& receiver, NonnullOwnPtr<Core::Event> event)
 {
-    {
-        Threading::MutexLocker lock(m_private->mutex);
-        m_private->queued_events.empend(receiver, move(event));
-    }
+    m_private->queued_events.push(Private::QueuedEvent { receiver, move(event) });
     Core::EventLoopManager::the().did_post_event();
 }
 
@@ -93,16 +93,15 @@ void ThreadEventQueue::cancel_all_pending_jobs()
 
 size_t ThreadEventQueue::process()
 {
-    decltype(m_private->queued_events) events;
+    auto events = m_private->queued_events.take_all();
     {
         Threading::MutexLocker locker(m_private->mutex);
-        events = move(m_private->queued_events);
         m_private->pending_promises.remove_all_matching([](auto& job) { return job->is_resolved() || job->is_rejected(); });
     }
 
     size_t processed_events = 0;
-    for (size_t i = 0; i < events.size(); ++i) {
-        auto& queued_event = events.at(i);
+    while (!events.is_empty()) {
+        auto queued_event = events.take_first();
         auto receiver = queued_event.receiver.strong_ref();
         auto& event = *queued_event.event;
 
@@ -135,7 +134,6 @@ size_t ThreadEventQueue::process()
 
 bool ThreadEventQueue::has_pending_events() const
 {
-    Threading::MutexLocker locker(m_private->mutex);
     return !m_private->queued_events.is_empty();
 }
 
@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/JsonObject.h>
+#include <AK/StringBuilder.h>
+#include <LibCore/Tracing.h>
+#include <LibThreading/Mutex.h>
+#include <unistd.h>
+
+namespace Core::Tracing {
+
+namespace Detail {
+Atomic<u32> g_enabled_categories { 0 };
+}
+
+// The layout of the shared buffer. Both are plain data, as they live in memory that other processes read from, and
+// every field that is written while others may be reading is only accessed atomically.
+struct BufferHeader {
+    u32 magic;
+    u32 record_count;
+    u64 write_index;
+    u64 read_index;
+    i32 process_id;
+    u8 padding[36];
+};
+static_assert(sizeof(BufferHeader) == 64);
+
+struct Record {
+    // Odd while the record is being written. Once it has been, this is 2 * (index + 1) of the write that filled it,
+    // which tells readers whether the record is still the one they are looking for.
+    u64 sequence;
+    i64 start;
+    i64 duration;
+    u64 flow_id;
+    u32 category;
+    u32 thread_id;
+    u8 flow;
+    u8 name_length;
+    u8 detail_length;
+    u8 padding[5];
+    char name[64];
+    char detail[144];
+};
+static_assert(sizeof(Record) == 256);
+
+static constexpr u32 buffer_magic = 0x54524143; // "TRAC"
+static constexpr size_t buffer_size = 4 * MiB;
+static constexpr u32 record_count = (buffer_size - sizeof(BufferHeader)) / sizeof(Record);
+
+static Threading::Mutex s_buffer_mutex;
+static AnonymousBuffer s_buffer;
+static Atomic<BufferHeader*> s_buffer_header { nullptr };
+
+static Atomic<u32> s_next_thread_id { 1 };
+static thread_local u32 s_thread_id { 0 };
+
+static Atomic<u32> s_next_flow_id { 1 };
+
+static constexpr Array categories {
+    Category::Fetch,
+    Category::HTMLParse,
+    Category::Style,
+    Category::Layout,
+    Category::DisplayList,
+    Category::Raster,
+    Category::JavaScript,
+    Category::GC,
+    Category::IPC,
+};
+
+StringView category_name(Category category)
+{
+    switch (category) {
+    case Category::Fetch:
+        return "fetch"sv;
+    case Category::HTMLParse:
+        return "html-parse"sv;
+    case Category::Style:
+        return "style"sv;
+    case Category::Layout:
+        return "layout"sv;
+    case Category::DisplayList:
+        return "display-list"sv;
+    case Category::Raster:
+        return "raster"sv;
+    case Category::JavaScript:
+        return "javascript"sv;
+    case Category::GC:
+        return "gc"sv;
+    case Category::IPC:
+        return "ipc"sv;
+    default:
+        return "unknown"sv;
+    }
+}
+
+Optional<Category> parse_categories(StringView names)
+{
+    if (names == "all"sv)
+        return Category::All;
+    if (names == "none"sv || names.is_empty())
+        return Category::None;
+
+    auto result = Category::None;
+    for (auto name : names.split_view(',')) {
+        auto category = Category::None;
+        for (auto candidate : categories) {
+            if (category_name(candidate) == name.trim_whitespace())
+                category = candidate;
+        }
+        if (category == Category::None)
+            return {};
+        result |= category;
+    }
+    return result;
+}
+
+ByteString category_names(Category enabled)
+{
+    if (enabled == Category::All)
+        return "all"sv;
+    if (enabled == Category::None)
+        return "none"sv;
+
+    StringBuilder builder;
+    for (auto category : categories) {
+        if (!has_flag(enabled, category))
+            continue;
+        if (!builder.is_empty())
+            builder.append(',');
+        builder.append(category_name(category));
+    }
+    return builder.to_byte_string();
+}
+
+Category enabled_categories()
+{
+    return static_cast<Category>(Detail::g_enabled_categories.load(AK::MemoryOrder::memory_order_relaxed));
+}
+
+void set_enabled_categories(Category categories)
+{
+    Detail::g_enabled_categories.store(to_underlying(categories), AK::MemoryOrder::memory_order_relaxed);
+}
+
+static BufferHeader& header_of(AnonymousBuffer& buffer)
+{
+    return *buffer.data<BufferHeader>();
+}
+
+static Record* records_of(BufferHeader& header)
+{
+    return reinterpret_cast<Record*>(&header + 1);
+}
+
+static void initialize_buffer(AnonymousBuffer& buffer)
+{
+    auto& header = header_of(buffer);
+    header.magic = buffer_magic;
+    header.record_count = record_count;
+}
+
+static ErrorOr<void> start_recording_into(AnonymousBuffer buffer)
+{
+    if (buffer.size() < buffer_size || header_of(buffer).magic != buffer_magic || header_of(buffer).record_count != record_count)
+        return Error::from_string_literal("Not a trace buffer");
+
+    header_of(buffer).process_id = getpid();
+    s_buffer = move(buffer);
+    s_buffer_header.store(&header_of(s_buffer), AK::MemoryOrder::memory_order_release);
+    return {};
+}
+
+static BufferHeader* buffer_header()
+{
+    if (auto* header = s_buffer_header.load(AK::MemoryOrder::memory_order_acquire))
+        return header;
+
+    Threading::MutexLocker locker(s_buffer_mutex);
+    if (auto* header = s_buffer_header.load(AK::MemoryOrder::memory_order_acquire))
+        return header;
+
+    auto buffer = create_shared_buffer();
+    if (buffer.is_error() || start_recording_into(buffer.release_value()).is_error())
+        return nullptr;
+    return s_buffer_header.load(AK::MemoryOrder::memory_order_acquire);
+}
+
+static u8 copy_truncated(StringView string, Span<char> destination)
+{
+    auto length = min(string.length(), destination.size());
+    __builtin_memcpy(destination.data(), string.characters_without_null_termination(), length);
+    return static_cast<u8>(length);
+}
+
+void add_event(Category category, StringView name, MonotonicTime start, MonotonicTime end, StringView detail, u64 flow_id, Flow flow)
+{
+    auto* header = buffer_header();
+    if (!header)
+        return;
+
+    if (s_thread_id == 0)
+        s_thread_id = s_next_thread_id.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+
+    auto index = AK::atomic_fetch_add(&header->write_index, static_cast<u64>(1), AK::MemoryOrder::memory_order_relaxed);
+    auto& record = records_of(*header)[index % record_count];
+
+    AK::atomic_store(&record.sequence, 2 * index + 1, AK::MemoryOrder::memory_order_relaxed);
+    AK::atomic_thread_fence(AK::MemoryOrder::memory_order_release);
+
+    record.start = start.nanoseconds();
+    record.duration = (end - start).to_nanoseconds();
+    record.flow_id = flow_id;
+    record.category = to_underlying(category);
+    record.thread_id = s_thread_id;
+    record.flow = to_underlying(flow);
+    record.name_length = copy_truncated(name, record.name);
+    record.detail_length = copy_truncated(detail, record.detail);
+
+    AK::atomic_store(&record.sequence, 2 * index + 2, AK::MemoryOrder::memory_order_release);
+}
+
+u64 next_flow_id()
+{
+    return (static_cast<u64>(getpid()) << 32) | s_next_flow_id.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+}
+
+ErrorOr<AnonymousBuffer> create_shared_buffer()
+{
+    auto buffer = TRY(AnonymousBuffer::create_with_size(buffer_size));
+    initialize_buffer(buffer);
+    return buffer;
+}
+
+ErrorOr<void> use_shared_buffer(int fd, StringView categories)
+{
+    auto buffer = TRY(AnonymousBuffer::create_from_anon_fd(fd, buffer_size));
+
+    auto enabled = parse_categories(categories);
+    if (!enabled.has_value())
+        return Error::from_string_literal("Unknown trace categories");
+
+    {
+        Threading::MutexLocker locker(s_buffer_mutex);
+        if (s_buffer_header.load(AK::MemoryOrder::memory_order_acquire))
+            return Error::from_string_literal("Already recording trace events");
+        TRY(start_recording_into(move(buffer)));
+    }
+
+    set_enabled_categories(*enabled);
+    return {};
+}
+
+static MonotonicTime monotonic_time_from_nanoseconds(i64 nanoseconds)
+{
+    // MonotonicTime can't be made from a raw timestamp, but it can be reached from any other point in time.
+    auto now = MonotonicTime::now();
+    return now - AK::Duration::from_nanoseconds(now.nanoseconds() - nanoseconds);
+}
+
+static Vector<Event> take_events(BufferHeader& header)
+{
+    auto end = AK::atomic_load(&header.write_index, AK::MemoryOrder::memory_order_acquire);
+    auto begin = AK::atomic_exchange(&header.read_index, end, AK::MemoryOrder::memory_order_acq_rel);
+
+    // Anything older than the last record_count events has been overwritten.
+    if (end - begin > record_count)
+        begin = end - record_count;
+
+    auto process_id = AK::atomic_load(&header.process_id, AK::MemoryOrder::memory_order_relaxed);
+    auto* records = records_of(header);
+
+    Vector<Event> events;
+    events.ensure_capacity(end - begin);
+
+    for (auto index = begin; index < end; ++index) {
+        auto const& shared_record = records[index % record_count];
+
+        // Records that are still being written, or have already been overwritten by a newer event, are skipped.
+        auto sequence = AK::atomic_load(&shared_record.sequence, AK::MemoryOrder::memory_order_acquire);
+        if (sequence != 2 * index + 2)
+            continue;
+
+        Record record;
+        __builtin_memcpy(&record, &shared_record, sizeof(record));
+
+        AK::atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
+        if (AK::atomic_load(&shared_record.sequence, AK::MemoryOrder::memory_order_relaxed) != sequence)
+            continue;
+
+        events.unchecked_append({
+            .name = StringView { record.name, min<size_t>(record.name_length, sizeof(record.name)) },
+            .category = static_cast<Category>(record.category),
+            .start = monotonic_time_from_nanoseconds(record.start),
+            .duration = AK::Duration::from_nanoseconds(record.duration),
+            .process_id = process_id,
+            .thread_id = record.thread_id,
+            .flow_id = record.flow_id,
+            .flow = static_cast<Flow>(record.flow),
+            .detail = StringView { record.detail, min<size_t>(record.detail_length, sizeof(record.detail)) },
+        });
+    }
+
+    return events;
+}
+
+Vector<Event> take_events()
+{
+    auto* header = s_buffer_header.load(AK::MemoryOrder::memory_order_acquire);
+    if (!header)
+        return {};
+    return take_events(*header);
+}
+
+Vector<Event> take_events(AnonymousBuffer& buffer)
+{
+    if (buffer.size() < buffer_size || header_of(buffer).magic != buffer_magic || header_of(buffer).record_count != record_count)
+        return {};
+    return take_events(header_of(buffer));
+}
+
+JsonArray to_chrome_trace_events(Vector<Event> const& events)
+{
+    JsonArray trace_events;
+    trace_events.ensure_capacity(events.size());
+
+    for (auto const& event : events) {
+        JsonObject trace_event;
+        trace_event.set("name"sv, event.name);
+        trace_event.set("cat"sv, category_name(event.category));
+        trace_event.set("ph"sv, "X"sv);
+        trace_event.set("ts"sv, event.start.nanoseconds() / 1000);
+        trace_event.set("dur"sv, event.duration.to_microseconds());
+        trace_event.set("pid"sv, event.process_id);
+        trace_event.set("tid"sv, event.thread_id);
+
+        if (!event.detail.is_empty()) {
+            JsonObject args;
+            args.set("detail"sv, event.detail);
+            trace_event.set("args"sv, move(args));
+        }
+
+        trace_events.must_append(move(trace_event));
+
+        if (event.flow == Flow::None)
+            continue;
+
+        // Flow events bind to the slice that encloses them on their thread, which is the event we just added.
+        JsonObject flow_event;
+        flow_event.set("name"sv, "flow"sv);
+        flow_event.set("cat"sv, category_name(event.category));
+        flow_event.set("ph"sv, event.flow == Flow::Out ? "s"sv : "f"sv);
+        if (event.flow == Flow::In)
+            flow_event.set("bp"sv, "e"sv);
+        // Flow IDs don't fit into the doubles that JSON numbers usually end up as.
+        flow_event.set("id"sv, ByteString::formatted("{:#x}", event.flow_id));
+        flow_event.set("ts"sv, event.start.nanoseconds() / 1000);
+        flow_event.set("pid"sv, event.process_id);
+        flow_event.set("tid"sv, event.thread_id);
+        trace_events.must_append(move(flow_event));
+    }
+
+    return trace_events;
+}
+
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/ByteString.h>
+#include <AK/EnumBits.h>
+#include <AK/JsonArray.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibCore/AnonymousBuffer.h>
+
+// A lightweight way of recording how long things take, for finding out where the time goes while loading a page.
+// Events are only recorded for the categories that have been enabled, so leaving the trace points in costs next to
+// nothing while tracing is off.
+//
+// Every process records its events into a ring buffer of compact binary records, overwriting the oldest ones once it
+// is full. The buffer is shared memory: the UI process creates one for every helper process it launches, so that it
+// can collect the events of all of its processes without talking to them, even if one of them has stopped responding.
+namespace Core::Tracing {
+
+enum class Category : u32 {
+    None = 0,
+    Fetch = 1 << 0,
+    HTMLParse = 1 << 1,
+    Style = 1 << 2,
+    Layout = 1 << 3,
+    DisplayList = 1 << 4,
+    Raster = 1 << 5,
+    JavaScript = 1 << 6,
+    GC = 1 << 7,
+    IPC = 1 << 8,
+    All = (1 << 9) - 1,
+};
+
+AK_ENUM_BITWISE_OPERATORS(Category);
+
+StringView category_name(Category);
+
+// Parses a comma-separated list of category names, as well as "all" and "none".
+Optional<Category> parse_categories(StringView);
+
+// The inverse of parse_categories().
+ByteString category_names(Category);
+
+// Flows connect events in different threads or processes, like the sending and the handling of an IPC message.
+enum class Flow : u8 {
+    None,
+    Out,
+    In,
+};
+
+struct Event {
+    ByteString name;
+    Category category { Category::None };
+    MonotonicTime start;
+    AK::Duration duration;
+    pid_t process_id { 0 };
+    u32 thread_id { 0 };
+    u64 flow_id { 0 };
+    Flow flow { Flow::None };
+    ByteString detail;
+};
+
+namespace Detail {
+extern Atomic<u32> g_enabled_categories;
+}
+
+ALWAYS_INLINE bool is_enabled(Category category)
+{
+    return (Detail::g_enabled_categories.load(AK::MemoryOrder::memory_order_relaxed) & to_underlying(category)) != 0;
+}
+
+Category enabled_categories();
+void set_enabled_categories(Category);
+
+// Names and details longer than the records have room for are cut off.
+// May be called from any thread.
+void add_event(Category, StringView name, MonotonicTime start, MonotonicTime end, StringView detail = {}, u64 flow_id = 0, Flow = Flow::None);
+
+// Returns an ID for a new flow that is unique across all processes.
+u64 next_flow_id();
+
+// Creates a buffer for a helper process to record its events into, see use_shared_buffer().
+ErrorOr<AnonymousBuffer> create_shared_buffer();
+
+// Makes this process record events of the given categories into a buffer created by create_shared_buffer() in another
+// process. This has to happen before the first event is recorded, as otherwise this process has already created a
+// buffer of its own. Takes ownership of the file descriptor.
+ErrorOr<void> use_shared_buffer(int fd, StringView categories);
+
+// Returns the events recorded in this process so far, and forgets about them.
+Vector<Event> take_events();
+
+// Returns the events recorded into a buffer created by create_shared_buffer() so far, and forgets about them.
+Vector<Event> take_events(AnonymousBuffer&);
+
+// Converts events to the "complete" events of the Chrome trace event format, which chrome://tracing and Perfetto
+// can load. Timestamps are in microseconds of the monotonic clock, so that events from different processes line up.
+// Events that are part of a flow are followed by a flow event binding them to it.
+JsonArray to_chrome_trace_events(Vector<Event> const&);
+
+// Records an event spanning its own lifetime.
+class ScopedEvent {
+    AK_MAKE_NONCOPYABLE(ScopedEvent);
+    AK_MAKE_NONMOVABLE(ScopedEvent);
+
+public:
+    ScopedEvent(Category category, StringView name)
+    {
+        if (is_enabled(category)) {
+            m_category = category;
+            m_name = name;
+            m_start = MonotonicTime::now();
+        }
+    }
+
+    ~ScopedEvent()
+    {
+        if (m_start.has_value())
+            add_event(m_category, m_name, *m_start, MonotonicTime::now());
+    }
+
+private:
+    Category m_category { Category::None };
+    StringView m_name;
+    Optional<MonotonicTime> m_start;
+};
+
+}
@@ -5,214 +5,285 @@
  */
 
 #include <AK/ByteReader.h>
+#include <AK/Concepts.h>
 #include <AK/Endian.h>
+#include <AK/SIMD.h>
 #include <LibCrypto/Authentication/Poly1305.h>
 
+#if ARCH(X86_64)
+#    include <immintrin.h>
+#endif
+
 namespace Crypto::Authentication {
 
+using AK::SIMD::u64x2;
+
+static constexpr u32 limb_mask = 0x3FFFFFF;
+static constexpr u32 full_block_high_bit = 1 << 24;
+
+template<typename T>
+concept Poly1305Limb = OneOf<T, u64, u64x2>;
+
+static ALWAYS_INLINE u64 multiply_low_halves(u64 a, u64 b)
+{
+    // NOTE: Both operands are always smaller than 2^32.
+    return a * b;
+}
+
+static ALWAYS_INLINE u64x2 multiply_low_halves(u64x2 a, u64x2 b)
+{
+#if ARCH(X86_64)
+    // NOTE: A generic 64-bit vector multiplication is lowered to three pmuludq, we only need one.
+    return (u64x2)_mm_mul_epu32((__m128i)a, (__m128i)b);
+#else
+    return (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+#endif
+}
+
+// Read a 16-byte block as a little-endian number split into 26-bit limbs, limb i starts at bit 26 * i.
+static ALWAYS_INLINE u32 load_limb(u8 const* block, size_t index, u32 high_bit)
+{
+    auto word = AK::convert_between_host_and_little_endian(ByteReader::load32(block + index * 3));
+    if (index == 4)
+        return (word >> 8) | high_bit;
+    return (word >> (index * 2)) & limb_mask;
+}
+
+// Compute d = h * r mod 2^130 - 5, without any carry propagation. Since 2^130 = 5 mod 2^130 - 5, the limbs that end
+// up above 2^130 are folded back in by multiplying with s = r * 5.
+template<Poly1305Limb T>
+static ALWAYS_INLINE void multiply(T const (&h)[5], T const (&r)[5], T const (&s)[5], T (&d)[5])
+{
+    d[0] = multiply_low_halves(h[0], r[0]) + multiply_low_halves(h[1], s[4]) + multiply_low_halves(h[2], s[3]) + multiply_low_halves(h[3], s[2]) + multiply_low_halves(h[4], s[1]);
+    d[1] = multiply_low_halves(h[0], r[1]) + multiply_low_halves(h[1], r[0]) + multiply_low_halves(h[2], s[4]) + multiply_low_halves(h[3], s[3]) + multiply_low_halves(h[4], s[2]);
+    d[2] = multiply_low_halves(h[0], r[2]) + multiply_low_halves(h[1], r[1]) + multiply_low_halves(h[2], r[0]) + multiply_low_halves(h[3], s[4]) + multiply_low_halves(h[4], s[3]);
+    d[3] = multiply_low_halves(h[0], r[3]) + multiply_low_halves(h[1], r[2]) + multiply_low_halves(h[2], r[1]) + multiply_low_halves(h[3], r[0]) + multiply_low_halves(h[4], s[4]);
+    d[4] = multiply_low_halves(h[0], r[4]) + multiply_low_halves(h[1], r[3]) + multiply_low_halves(h[2], r[2]) + multiply_low_halves(h[3], r[1]) + multiply_low_halves(h[4], r[0]);
+}
+
+// Carry the product back into 26-bit limbs. The result is only partially reduced, h[1] may still be slightly
+// larger than 2^26, which is fine as input for the next multiplication.
+template<Poly1305Limb T>
+static ALWAYS_INLINE void carry(T (&d)[5])
+{
+    d[1] += d[0] >> 26;
+    d[0] &= limb_mask;
+    d[2] += d[1] >> 26;
+    d[1] &= limb_mask;
+    d[3] += d[2] >> 26;
+    d[2] &= limb_mask;
+    d[4] += d[3] >> 26;
+    d[3] &= limb_mask;
+    d[0] += (d[4] >> 26) * 5;
+    d[4] &= limb_mask;
+    d[1] += d[0] >> 26;
+    d[0] &= limb_mask;
+}
+
+template<Poly1305Limb T>
+static ALWAYS_INLINE void multiply_by_five(T const (&r)[5], T (&s)[5])
+{
+    for (size_t i = 1; i < 5; i++)
+        s[i] = r[i] * 5;
+}
+
 Poly1305::Poly1305(ReadonlyBytes key)
 {
+    u32 r[4];
     for (size_t i = 0; i < 16; i += 4) {
-        m_state.r[i / 4] = AK::convert_between_host_and_little_endian(ByteReader::load32(key.offset(i)));
+        r[i / 4] = AK::convert_between_host_and_little_endian(ByteReader::load32(key.offset(i)));
     }
 
     // r[3], r[7], r[11], and r[15] are required to have their top four bits clear (be smaller than 16)
     // r[4], r[8], and r[12] are required to have their bottom two bits clear (be divisible by 4)
-    m_state.r[0] &= 0x0FFFFFFF;
-    m_state.r[1] &= 0x0FFFFFFC;
-    m_state.r[2] &= 0x0FFFFFFC;
-    m_state.r[3] &= 0x0FFFFFFC;
+    r[0] &= 0x0FFFFFFF;
+    r[1] &= 0x0FFFFFFC;
+    r[2] &= 0x0FFFFFFC;
+    r[3] &= 0x0FFFFFFC;
+
+    m_state.r[0] = r[0] & limb_mask;
+    m_state.r[1] = ((r[0] >> 26) | (r[1] << 6)) & limb_mask;
+    m_state.r[2] = ((r[1] >> 20) | (r[2] << 12)) & limb_mask;
+    m_state.r[3] = ((r[2] >> 14) | (r[3] << 18)) & limb_mask;
+    m_state.r[4] = r[3] >> 8;
 
     for (size_t i = 16; i < 32; i += 4) {
         m_state.s[(i - 16) / 4] = AK::convert_between_host_and_little_endian(ByteReader::load32(key.offset(i)));
     }
+
+    // Precompute r^2, which lets us process two blocks at once: ((h + m0) * r + m1) * r = (h + m0) * r^2 + m1 * r.
+    u64 limbs[5];
+    u64 s[5];
+    for (size_t i = 0; i < 5; i++)
+        limbs[i] = m_state.r[i];
+    multiply_by_five(limbs, s);
+
+    u64 squared[5];
+    multiply(limbs, limbs, s, squared);
+    carry(squared);
+    for (size_t i = 0; i < 5; i++)
+        m_state.r_squared[i] = squared[i];
 }
 
 void Poly1305::update(ReadonlyBytes message)
 {
     size_t offset = 0;
-    while (offset < message.size()) {
-        u32 n = min(message.size() - offset, 16 - m_state.block_count);
-        memcpy(m_state.blocks + m_state.block_count, message.offset_pointer(offset), n);
+
+    // Complete a previously buffered partial block first.
+    if (m_state.block_count != 0) {
+        u32 n = min(message.size(), 16 - m_state.block_count);
+        memcpy(m_state.blocks + m_state.block_count, message.data(), n);
         m_state.block_count += n;
         offset += n;
 
-        if (m_state.block_count == 16) {
-            process_block();
-            m_state.block_count = 0;
-        }
-    }
-}
+        if (m_state.block_count < 16)
+            return;
 
-void Poly1305::process_block()
-{
-    u32 a[5];
-    u8 n = m_state.block_count;
-
-    // Add one bit beyond the number of octets.  For a 16-byte block,
-    // this is equivalent to adding 2^128 to the number.  For the shorter
-    // block, it can be 2^120, 2^112, or any power of two that is evenly
-    // divisible by 8, all the way down to 2^8.
-    m_state.blocks[n++] = 0x01;
-
-    // If the block is not 17 bytes long (the last block), pad it with zeros.
-    // This is meaningless if you are treating the blocks as numbers.
-    while (n < 17) {
-        m_state.blocks[n++] = 0x00;
+        process_block(m_state.blocks, full_block_high_bit);
+        m_state.block_count = 0;
     }
 
-    // Read the block as a little-endian number.
-    for (size_t i = 0; i < 16; i += 4) {
-        a[i / 4] = AK::convert_between_host_and_little_endian(ByteReader::load32(m_state.blocks + i));
+    // Then process all whole blocks straight from the message.
+    size_t block_count = (message.size() - offset) / 16;
+    if (block_count >= 2) {
+        process_block_pairs(message.offset_pointer(offset), block_count / 2);
+        offset += (block_count & ~1) * 16;
+    }
+    if (block_count % 2 != 0) {
+        process_block(message.offset_pointer(offset), full_block_high_bit);
+        offset += 16;
     }
-    a[4] = m_state.blocks[16];
+
+    // And keep whatever is left for later.
+    m_state.block_count = message.size() - offset;
+    if (m_state.block_count != 0)
+        memcpy(m_state.blocks, message.offset_pointer(offset), m_state.block_count);
+}
+
+void Poly1305::process_block(u8 const* block, u32 high_bit)
+{
+    u64 h[5];
+    u64 r[5];
+    u64 s[5];
 
     // Add this number to the accumulator.
-    m_state.a[0] += a[0];
-    m_state.a[1] += a[1];
-    m_state.a[2] += a[2];
-    m_state.a[3] += a[3];
-    m_state.a[4] += a[4];
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-
-    // Only consider the least significant bits
-    a[0] = m_state.a[0] & 0xFFFFFFFF;
-    a[1] = m_state.a[1] & 0xFFFFFFFF;
-    a[2] = m_state.a[2] & 0xFFFFFFFF;
-    a[3] = m_state.a[3] & 0xFFFFFFFF;
-    a[4] = m_state.a[4] & 0xFFFFFFFF;
+    for (size_t i = 0; i < 5; i++) {
+        h[i] = m_state.h[i] + load_limb(block, i, high_bit);
+        r[i] = m_state.r[i];
+    }
+    multiply_by_five(r, s);
 
     // Multiply by r
-    m_state.a[0] = (u64)a[0] * m_state.r[0];
-    m_state.a[1] = (u64)a[0] * m_state.r[1] + (u64)a[1] * m_state.r[0];
-    m_state.a[2] = (u64)a[0] * m_state.r[2] + (u64)a[1] * m_state.r[1] + (u64)a[2] * m_state.r[0];
-    m_state.a[3] = (u64)a[0] * m_state.r[3] + (u64)a[1] * m_state.r[2] + (u64)a[2] * m_state.r[1] + (u64)a[3] * m_state.r[0];
-    m_state.a[4] = (u64)a[1] * m_state.r[3] + (u64)a[2] * m_state.r[2] + (u64)a[3] * m_state.r[1] + (u64)a[4] * m_state.r[0];
-    m_state.a[5] = (u64)a[2] * m_state.r[3] + (u64)a[3] * m_state.r[2] + (u64)a[4] * m_state.r[1];
-    m_state.a[6] = (u64)a[3] * m_state.r[3] + (u64)a[4] * m_state.r[2];
-    m_state.a[7] = (u64)a[4] * m_state.r[3];
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-    m_state.a[5] += m_state.a[4] >> 32;
-    m_state.a[6] += m_state.a[5] >> 32;
-    m_state.a[7] += m_state.a[6] >> 32;
-
-    // Save the high part of the accumulator
-    a[0] = m_state.a[4] & 0xFFFFFFFC;
-    a[1] = m_state.a[5] & 0xFFFFFFFF;
-    a[2] = m_state.a[6] & 0xFFFFFFFF;
-    a[3] = m_state.a[7] & 0xFFFFFFFF;
-
-    // Only consider the least significant bits
-    m_state.a[0] &= 0xFFFFFFFF;
-    m_state.a[1] &= 0xFFFFFFFF;
-    m_state.a[2] &= 0xFFFFFFFF;
-    m_state.a[3] &= 0xFFFFFFFF;
-    m_state.a[4] &= 0x00000003;
-
-    // Fast modular reduction (first pass)
-    m_state.a[0] += a[0];
-    m_state.a[0] += (a[0] >> 2) | (a[1] << 30);
-    m_state.a[1] += a[1];
-    m_state.a[1] += (a[1] >> 2) | (a[2] << 30);
-    m_state.a[2] += a[2];
-    m_state.a[2] += (a[2] >> 2) | (a[3] << 30);
-    m_state.a[3] += a[3];
-    m_state.a[3] += (a[3] >> 2);
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-
-    // Save the high part of the accumulator
-    a[0] = m_state.a[4] & 0xFFFFFFFC;
-
-    // Only consider the least significant bits
-    m_state.a[0] &= 0xFFFFFFFF;
-    m_state.a[1] &= 0xFFFFFFFF;
-    m_state.a[2] &= 0xFFFFFFFF;
-    m_state.a[3] &= 0xFFFFFFFF;
-    m_state.a[4] &= 0x00000003;
-
-    // Fast modular reduction (second pass)
-    m_state.a[0] += a[0];
-    m_state.a[0] += a[0] >> 2;
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-
-    // Only consider the least significant bits
-    m_state.a[0] &= 0xFFFFFFFF;
-    m_state.a[1] &= 0xFFFFFFFF;
-    m_state.a[2] &= 0xFFFFFFFF;
-    m_state.a[3] &= 0xFFFFFFFF;
-    m_state.a[4] &= 0x00000003;
+    u64 d[5];
+    multiply(h, r, s, d);
+    carry(d);
+
+    for (size_t i = 0; i < 5; i++)
+        m_state.h[i] = d[i];
 }
 
-ErrorOr<ByteBuffer> Poly1305::digest()
+void Poly1305::process_block_pairs(u8 const* blocks, size_t pair_count)
 {
-    if (m_state.block_count != 0)
-        process_block();
+    // NOTE: Each lane holds its own accumulator. Lane 0 takes the even blocks and lane 1 the odd blocks, and both are
+    //       multiplied by r^2 per pair. The lanes are only combined after the last pair, by multiplying lane 0 with
+    //       r^2 and lane 1 with r, so that every block ends up multiplied by the right power of r.
+    u64x2 h[5];
+    u64x2 r[5];
+    u64x2 s[5];
+    u64x2 d[5];
+
+    for (size_t i = 0; i < 5; i++) {
+        h[i] = u64x2 { m_state.h[i] + load_limb(blocks, i, full_block_high_bit), load_limb(blocks + 16, i, full_block_high_bit) };
+        r[i] = u64x2 { m_state.r_squared[i], m_state.r_squared[i] };
+    }
+    multiply_by_five(r, s);
 
-    u32 b[4];
+    for (size_t pair = 1; pair < pair_count; pair++) {
+        multiply(h, r, s, d);
+        carry(d);
+
+        blocks += 32;
+        for (size_t i = 0; i < 5; i++)
+            h[i] = d[i] + u64x2 { load_limb(blocks, i, full_block_high_bit), load_limb(blocks + 16, i, full_block_high_bit) };
+    }
+
+    for (size_t i = 0; i < 5; i++)
+        r[i][1] = m_state.r[i];
+    multiply_by_five(r, s);
+    multiply(h, r, s, d);
+
+    u64 sum[5];
+    for (size_t i = 0; i < 5; i++)
+        sum[i] = d[i][0] + d[i][1];
+    carry(sum);
 
-    // Save the accumulator
-    b[0] = m_state.a[0] & 0xFFFFFFFF;
-    b[1] = m_state.a[1] & 0xFFFFFFFF;
-    b[2] = m_state.a[2] & 0xFFFFFFFF;
-    b[3] = m_state.a[3] & 0xFFFFFFFF;
+    for (size_t i = 0; i < 5; i++)
+        m_state.h[i] = sum[i];
+}
 
-    // Compute a + 5
-    m_state.a[0] += 5;
+ErrorOr<ByteBuffer> Poly1305::digest()
+{
+    if (m_state.block_count != 0) {
+        // Add one bit beyond the number of octets. For the last, shorter block, this can be 2^120, 2^112, or any
+        // power of two that is evenly divisible by 8, all the way down to 2^8.
+        m_state.blocks[m_state.block_count] = 0x01;
 
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
+        // Pad it with zeros. This is meaningless if you are treating the blocks as numbers.
+        for (size_t i = m_state.block_count + 1; i < 16; i++)
+            m_state.blocks[i] = 0x00;
 
-    // Select mask based on (a + 5) >= 2^130
-    u32 mask = ((m_state.a[4] & 0x04) >> 2) - 1;
+        process_block(m_state.blocks, 0);
+        m_state.block_count = 0;
+    }
 
-    // Select based on mask
-    m_state.a[0] = (m_state.a[0] & ~mask) | (b[0] & mask);
-    m_state.a[1] = (m_state.a[1] & ~mask) | (b[1] & mask);
-    m_state.a[2] = (m_state.a[2] & ~mask) | (b[2] & mask);
-    m_state.a[3] = (m_state.a[3] & ~mask) | (b[3] & mask);
+    // Fully carry the accumulator.
+    u32 h[5];
+    for (size_t i = 0; i < 5; i++)
+        h[i] = m_state.h[i];
+
+    h[2] += h[1] >> 26;
+    h[1] &= limb_mask;
+    h[3] += h[2] >> 26;
+    h[2] &= limb_mask;
+    h[4] += h[3] >> 26;
+    h[3] &= limb_mask;
+    h[0] += (h[4] >> 26) * 5;
+    h[4] &= limb_mask;
+    h[1] += h[0] >> 26;
+    h[0] &= limb_mask;
+
+    // Compute h + 5 - 2^130
+    u32 g[5];
+    g[0] = h[0] + 5;
+    g[1] = h[1] + (g[0] >> 26);
+    g[0] &= limb_mask;
+    g[2] = h[2] + (g[1] >> 26);
+    g[1] &= limb_mask;
+    g[3] = h[3] + (g[2] >> 26);
+    g[2] &= limb_mask;
+    g[4] = h[4] + (g[3] >> 26) - (1 << 26);
+    g[3] &= limb_mask;
+
+    // Select based on (h + 5) >= 2^130, i.e. whether the subtraction above did not underflow.
+    u32 mask = (g[4] >> 31) - 1;
+    for (size_t i = 0; i < 5; i++)
+        h[i] = (h[i] & ~mask) | (g[i] & mask);
+
+    // Pack the limbs back into 32-bit words.
+    u32 b[4];
+    b[0] = h[0] | (h[1] << 26);
+    b[1] = (h[1] >> 6) | (h[2] << 20);
+    b[2] = (h[2] >> 12) | (h[3] << 14);
+    b[3] = (h[3] >> 18) | (h[4] << 8);
 
     // Finally, the value of the secret key "s" is added to the accumulator,
     // and the 128 least significant bits are serialized in little-endian
     // order to form the tag.
-    m_state.a[0] += m_state.s[0];
-    m_state.a[1] += m_state.s[1];
-    m_state.a[2] += m_state.s[2];
-    m_state.a[3] += m_state.s[3];
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-
-    // Only consider the least significant bits
-    b[0] = m_state.a[0] & 0xFFFFFFFF;
-    b[1] = m_state.a[1] & 0xFFFFFFFF;
-    b[2] = m_state.a[2] & 0xFFFFFFFF;
-    b[3] = m_state.a[3] & 0xFFFFFFFF;
+    u64 f = 0;
+    for (size_t i = 0; i < 4; i++) {
+        f = (f >> 32) + b[i] + m_state.s[i];
+        b[i] = f & 0xFFFFFFFF;
+    }
 
     ByteBuffer output = TRY(ByteBuffer::create_uninitialized(16));
 
@@ -10,11 +10,13 @@
 
 namespace Crypto::Authentication {
 
+// NOTE: The accumulator and r are kept as five 26-bit limbs, so that the products of two limbs still fit in 64 bits.
 struct State {
-    u32 r[4] {};
+    u32 r[5] {};
+    u32 r_squared[5] {};
     u32 s[4] {};
-    u64 a[8] {};
-    u8 blocks[17] {};
+    u32 h[5] {};
+    u8 blocks[16] {};
     u8 block_count {};
 };
 
@@ -26,7 +28,8 @@ public:
     ErrorOr<ByteBuffer> digest();
 
 private:
-    void process_block();
+    void process_block(u8 const* block, u32 high_bit);
+    void process_block_pairs(u8 const* blocks, size_t pair_count);
 
     State m_state;
 };
@@ -14,8 +14,6 @@ void UnsignedBigIntegerAlgorithms::destructive_modular_power_without_allocation(
     UnsignedBigInteger& base,
     UnsignedBigInteger const& m,
     UnsignedBigInteger& temp_1,
-    UnsignedBigInteger& temp_2,
-    UnsignedBigInteger& temp_3,
     UnsignedBigInteger& temp_multiply,
     UnsignedBigInteger& temp_quotient,
     UnsignedBigInteger& temp_remainder,
@@ -25,7 +23,7 @@ void UnsignedBigIntegerAlgorithms::destructive_modular_power_without_allocation(
     while (!(ep < 1)) {
         if (ep.words()[0] % 2 == 1) {
             // exp = (exp * base) % m;
-            multiply_without_allocation(exp, base, temp_1, temp_2, temp_3, temp_multiply);
+            multiply_without_allocation(exp, base, temp_1, temp_multiply);
             divide_without_allocation(temp_multiply, m, temp_quotient, temp_remainder);
             exp.set_to(temp_remainder);
         }
@@ -34,7 +32,7 @@ void UnsignedBigIntegerAlgorithms::destructive_modular_power_without_allocation(
         ep.set_to(ep.shift_right(1));
 
         // base = (base * base) % m;
-        multiply_without_allocation(base, base, temp_1, temp_2, temp_3, temp_multiply);
+        multiply_without_allocation(base, base, temp_1, temp_multiply);
         divide_without_allocation(temp_multiply, m, temp_quotient, temp_remainder);
         base.set_to(temp_remainder);
 
@@ -69,21 +67,11 @@ ALWAYS_INLINE static u32 inverse_wrapped(u32 value)
 }
 
 /**
- * Computes z = x * y + c. z_carry contains the top bits, z contains the bottom bits.
+ * Computes z = x * y + c + d. z_carry contains the top bits, z contains the bottom bits.
  */
-ALWAYS_INLINE static void linear_multiplication_with_carry(u32 x, u32 y, u32 c, u32& z_carry, u32& z)
+ALWAYS_INLINE static void linear_multiplication_with_carry(u32 x, u32 y, u32 c, u32 d, u32& z, u32& z_carry)
 {
-    u64 result = static_cast<u64>(x) * static_cast<u64>(y) + static_cast<u64>(c);
-    z_carry = static_cast<u32>(result >> 32);
-    z = static_cast<u32>(result);
-}
-
-/**
- * Computes z = a + b. z_carry contains the top bit (1 or 0), z contains the bottom bits.
- */
-ALWAYS_INLINE static void addition_with_carry(u32 a, u32 b, u32& z_carry, u32& z)
-{
-    u64 result = static_cast<u64>(a) + static_cast<u64>(b);
+    u64 result = static_cast<u64>(x) * static_cast<u64>(y) + static_cast<u64>(c) + static_cast<u64>(d);
     z_carry = static_cast<u32>(result >> 32);
     z = static_cast<u32>(result);
 }
@@ -94,16 +82,20 @@ ALWAYS_INLINE static void addition_with_carry(u32 a, u32 b, u32& z_carry, u32& z
  */
 UnsignedBigInteger::Word UnsignedBigIntegerAlgorithms::montgomery_fragment(UnsignedBigInteger& z, size_t offset_in_z, UnsignedBigInteger const& x, UnsignedBigInteger::Word y_digit, size_t num_words)
 {
+    VERIFY(z.length() >= offset_in_z + num_words);
+    VERIFY(x.length() >= num_words);
+
+    // This is the innermost loop of the modular power, so it works on the words directly rather than going through the
+    // bounds checks of the vectors for every word.
+    auto* z_words = z.m_words.data() + offset_in_z;
+    auto const* x_words = x.m_words.data();
+
     UnsignedBigInteger::Word carry { 0 };
     for (size_t i = 0; i < num_words; ++i) {
-        UnsignedBigInteger::Word a_carry;
-        UnsignedBigInteger::Word a;
-        linear_multiplication_with_carry(x.m_words[i], y_digit, z.m_words[offset_in_z + i], a_carry, a);
-        UnsignedBigInteger::Word b_carry;
-        UnsignedBigInteger::Word b;
-        addition_with_carry(a, carry, b_carry, b);
-        z.m_words[offset_in_z + i] = b;
-        carry = a_carry + b_carry;
+        // x * y + z + carry can't overflow a u64, as it's at most (2^32 - 1)^2 + 2 * (2^32 - 1) = 2^64 - 1.
+        UnsignedBigInteger::Word result;
+        linear_multiplication_with_carry(x_words[i], y_digit, z_words[i], carry, result, carry);
+        z_words[i] = result;
     }
     return carry;
 }
@@ -150,16 +142,10 @@ void UnsignedBigIntegerAlgorithms::almost_montgomery_multiplication_without_allo
         previous_double_carry = (temp_carry < carry_1 || overall_carry < carry_2) ? 1 : 0;
     }
 
-    if (previous_double_carry == 0) {
-        // Return the top num_words bytes of Z, which contains our result.
-        shift_right_by_n_words(z, num_words, result);
-        result.resize_with_leading_zeros(num_words);
-        return;
-    }
-
-    // We have a carry, so we're "one bigger" than we need to be.
+    // If we have a carry, we're "one bigger" than we need to be.
     // Subtract the modulo from the result (the top half of z), and write it to the bottom half of Z since we have space.
     // (With carry, of course.)
+    // This is done even without a carry, and the right half picked afterwards, so that the time taken doesn't depend on the values.
     UnsignedBigInteger::Word c { 0 };
     for (size_t i = 0; i < num_words; ++i) {
         UnsignedBigInteger::Word z_digit = z.m_words[num_words + i];
@@ -170,15 +156,33 @@ void UnsignedBigIntegerAlgorithms::almost_montgomery_multiplication_without_allo
         c = ((modulo_digit & ~z_digit) | ((modulo_digit | ~z_digit) & new_z_digit)) >> (UnsignedBigInteger::BITS_IN_WORD - 1);
     }
 
-    // Return the bottom num_words bytes of Z (with the carry bit handled)
-    z.m_words.resize(num_words);
-    result.set_to(z);
+    // Return the bottom num_words words of Z if we had a carry, and the top num_words words otherwise.
+    auto take_difference = static_cast<UnsignedBigInteger::Word>(0) - previous_double_carry;
+    result.set_to_0();
+    result.resize_with_leading_zeros(num_words);
+    for (size_t i = 0; i < num_words; ++i)
+        result.m_words[i] = (z.m_words[i] & take_difference) | (z.m_words[num_words + i] & ~take_difference);
+}
+
+/**
+ * Copies powers[index] to result, reading every one of the powers so that the memory accesses don't reveal the index.
+ */
+void UnsignedBigIntegerAlgorithms::select_power_in_constant_time(ReadonlySpan<UnsignedBigInteger> powers, size_t index, size_t num_words, UnsignedBigInteger& result)
+{
+    result.set_to_0();
     result.resize_with_leading_zeros(num_words);
+    for (size_t i = 0; i < powers.size(); ++i) {
+        auto mask = static_cast<UnsignedBigInteger::Word>(0) - static_cast<UnsignedBigInteger::Word>(i == index);
+        for (size_t j = 0; j < num_words; ++j)
+            result.m_words[j] |= powers[i].m_words[j] & mask;
+    }
 }
 
 /**
  * Complexity: still O(N^3) with N the number of words in the largest word, but less complex than the classical mod power.
  * Note: the montgomery multiplications requires an inverse modulo over 2^32, which is only defined for odd numbers.
+ * The sequence of operations and memory accesses only depends on the lengths of the exponent and modulo, not their values,
+ * as the exponent is often a private key.
  */
 void UnsignedBigIntegerAlgorithms::montgomery_modular_power_with_minimal_allocations(
     UnsignedBigInteger const& base,
@@ -242,8 +246,8 @@ void UnsignedBigIntegerAlgorithms::montgomery_modular_power_with_minimal_allocat
                 almost_montgomery_multiplication_without_allocation(zz, zz, modulo, temp_z, k, num_words, z);
             }
             auto power_index = exponent_word >> (UnsignedBigInteger::BITS_IN_WORD - window_size);
-            auto& power = powers[power_index];
-            almost_montgomery_multiplication_without_allocation(z, power, modulo, temp_z, k, num_words, zz);
+            select_power_in_constant_time(powers, power_index, num_words, x);
+            almost_montgomery_multiplication_without_allocation(z, x, modulo, temp_z, k, num_words, zz);
 
             swap(z, zz);
 
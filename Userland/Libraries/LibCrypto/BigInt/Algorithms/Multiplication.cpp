@@ -9,38 +9,178 @@
 
 namespace Crypto {
 
+using Word = UnsignedBigInteger::Word;
+using DoubleWord = u64;
+static_assert(sizeof(DoubleWord) == 2 * sizeof(Word));
+
+// Below this many words in the shorter operand, the bookkeeping of Karatsuba costs more than it saves.
+static constexpr size_t karatsuba_threshold = 32;
+
+/**
+ * Computes output[0..output_length) += value[0..value_length), where value_length <= output_length.
+ * The sum must fit into output_length words.
+ */
+static void add_words_in_place(Word* output, size_t output_length, Word const* value, size_t value_length)
+{
+    Word carry = 0;
+    size_t i = 0;
+    for (; i < value_length; ++i) {
+        DoubleWord sum = static_cast<DoubleWord>(output[i]) + value[i] + carry;
+        output[i] = static_cast<Word>(sum);
+        carry = static_cast<Word>(sum >> UnsignedBigInteger::BITS_IN_WORD);
+    }
+    for (; carry != 0 && i < output_length; ++i) {
+        output[i] += carry;
+        carry = output[i] == 0 ? 1 : 0;
+    }
+}
+
+/**
+ * Computes output[0..output_length) -= value[0..value_length), where value_length <= output_length.
+ * The difference must not be negative.
+ */
+static void subtract_words_in_place(Word* output, size_t output_length, Word const* value, size_t value_length)
+{
+    Word borrow = 0;
+    size_t i = 0;
+    for (; i < value_length; ++i) {
+        DoubleWord difference = static_cast<DoubleWord>(output[i]) - value[i] - borrow;
+        output[i] = static_cast<Word>(difference);
+        borrow = static_cast<Word>(difference >> UnsignedBigInteger::BITS_IN_WORD) & 1;
+    }
+    for (; borrow != 0 && i < output_length; ++i) {
+        borrow = output[i] == 0 ? 1 : 0;
+        --output[i];
+    }
+}
+
+/**
+ * Complexity: O(N * M) where N and M are the lengths of the operands
+ * Writes the product to output[0..left_length + right_length).
+ */
+static void schoolbook_multiply(Word const* left, size_t left_length, Word const* right, size_t right_length, Word* output)
+{
+    __builtin_memset(output, 0, (left_length + right_length) * sizeof(Word));
+    for (size_t i = 0; i < left_length; ++i) {
+        Word carry = 0;
+        DoubleWord left_word = left[i];
+        for (size_t j = 0; j < right_length; ++j) {
+            DoubleWord product = left_word * right[j] + output[i + j] + carry;
+            output[i + j] = static_cast<Word>(product);
+            carry = static_cast<Word>(product >> UnsignedBigInteger::BITS_IN_WORD);
+        }
+        output[i + right_length] = carry;
+    }
+}
+
+/**
+ * Returns how many words of scratch space multiply_words() needs for operands of at most the given length.
+ * This mirrors the recursion below: each Karatsuba level needs room for the two sums of halves and their product.
+ */
+static size_t scratch_length_for_multiplication(size_t length)
+{
+    size_t scratch_length = 0;
+    while (length >= karatsuba_threshold) {
+        auto half_length = (length + 1) / 2;
+        scratch_length += 4 * half_length + 4;
+        length = half_length + 1;
+    }
+    return scratch_length;
+}
+
 /**
- * Complexity: O(N^2) where N is the number of words in the larger number
+ * Writes the product to output[0..left_length + right_length), which must not overlap either operand.
+ */
+static void multiply_words(Word const* left, size_t left_length, Word const* right, size_t right_length, Word* output, Word* scratch)
+{
+    if (left_length < right_length) {
+        swap(left, right);
+        swap(left_length, right_length);
+    }
+
+    if (right_length < karatsuba_threshold) {
+        schoolbook_multiply(left, left_length, right, right_length, output);
+        return;
+    }
+
+    auto half_length = (left_length + 1) / 2;
+
+    // If the operands are very unbalanced, multiply the shorter one by slices of the longer one of the same length.
+    if (right_length <= half_length) {
+        __builtin_memset(output, 0, (left_length + right_length) * sizeof(Word));
+        auto* product = scratch;
+        for (size_t offset = 0; offset < left_length; offset += right_length) {
+            auto slice_length = min(right_length, left_length - offset);
+            multiply_words(left + offset, slice_length, right, right_length, product, scratch + 2 * right_length);
+            add_words_in_place(output + offset, left_length + right_length - offset, product, slice_length + right_length);
+        }
+        return;
+    }
+
+    /**
+     * Karatsuba: with left = l1 * B + l0 and right = r1 * B + r0, where B = 2^(half_length * BITS_IN_WORD),
+     *   left * right = l1r1 * B^2 + ((l0 + l1)(r0 + r1) - l0r0 - l1r1) * B + l0r0
+     * which takes three multiplications of half the size instead of four.
+     */
+    auto left_high_length = left_length - half_length;
+    auto right_high_length = right_length - half_length;
+    auto* low_product = output;
+    auto* high_product = output + 2 * half_length;
+    multiply_words(left, half_length, right, half_length, low_product, scratch);
+    multiply_words(left + half_length, left_high_length, right + half_length, right_high_length, high_product, scratch);
+
+    auto sum_length = half_length + 1;
+    auto* left_sum = scratch;
+    auto* right_sum = scratch + sum_length;
+    auto* middle_product = scratch + 2 * sum_length;
+    auto* next_scratch = middle_product + 2 * sum_length;
+
+    __builtin_memcpy(left_sum, left, half_length * sizeof(Word));
+    left_sum[half_length] = 0;
+    add_words_in_place(left_sum, sum_length, left + half_length, left_high_length);
+    __builtin_memcpy(right_sum, right, half_length * sizeof(Word));
+    right_sum[half_length] = 0;
+    add_words_in_place(right_sum, sum_length, right + half_length, right_high_length);
+
+    multiply_words(left_sum, sum_length, right_sum, sum_length, middle_product, next_scratch);
+
+    auto middle_length = 2 * sum_length;
+    subtract_words_in_place(middle_product, middle_length, low_product, 2 * half_length);
+    subtract_words_in_place(middle_product, middle_length, high_product, left_high_length + right_high_length);
+
+    // The middle term fits into the product's words above half_length, so any words of it beyond those are zero.
+    auto product_length = left_length + right_length;
+    add_words_in_place(output + half_length, product_length - half_length, middle_product, min(middle_length, product_length - half_length));
+}
+
+/**
+ * Complexity: O(N^2) where N is the number of words in the larger number, or O(N^log2(3)) once both operands are
+ * at least karatsuba_threshold words long.
  * Multiplication method:
- * An integer is equal to the sum of the powers of two
- * according to the indices of its 'on' bits.
- * So to multiple x*y, we go over each '1' bit in x (say the i'th bit),
- * and add y<<i to the result.
+ * Schoolbook multiplication one word at a time, split up with Karatsuba's method for large operands.
+ * temp_scratch holds the intermediate results of the Karatsuba recursion.
  */
 FLATTEN void UnsignedBigIntegerAlgorithms::multiply_without_allocation(
     UnsignedBigInteger const& left,
     UnsignedBigInteger const& right,
-    UnsignedBigInteger& temp_shift_result,
-    UnsignedBigInteger& temp_shift_plus,
-    UnsignedBigInteger& temp_shift,
+    UnsignedBigInteger& temp_scratch,
     UnsignedBigInteger& output)
 {
+    auto left_length = left.trimmed_length();
+    auto right_length = right.trimmed_length();
+
     output.set_to_0();
+    if (left_length == 0 || right_length == 0)
+        return;
 
-    // iterate all bits
-    for (size_t word_index = 0; word_index < left.length(); ++word_index) {
-        for (size_t bit_index = 0; bit_index < UnsignedBigInteger::BITS_IN_WORD; ++bit_index) {
-            // If the bit is off - skip over it
-            if (!(left.m_words[word_index] & (1 << bit_index)))
-                continue;
+    output.resize_with_leading_zeros(left_length + right_length);
 
-            size_t shift_amount = word_index * UnsignedBigInteger::BITS_IN_WORD + bit_index;
+    auto scratch_length = scratch_length_for_multiplication(max(left_length, right_length));
+    temp_scratch.set_to_0();
+    temp_scratch.resize_with_leading_zeros(scratch_length);
 
-            // output += (right << shift_amount);
-            shift_left_without_allocation(right, shift_amount, temp_shift_result, temp_shift_plus, temp_shift);
-            add_into_accumulator_without_allocation(output, temp_shift);
-        }
-    }
+    multiply_words(left.m_words.data(), left_length, right.m_words.data(), right_length, output.m_words.data(), temp_scratch.m_words.data());
+    output.clamp_to_trimmed_length();
 }
 
 }
@@ -4,12 +4,48 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteReader.h>
+#include <AK/Endian.h>
 #include <AK/StringBuilder.h>
 #include <LibCrypto/Cipher/AES.h>
 #include <LibCrypto/Cipher/AESTables.h>
 
+#if ARCH(X86_64)
+#    include <immintrin.h>
+#endif
+
 namespace Crypto::Cipher {
 
+#if ARCH(X86_64)
+// NOTE: With AES-NI, every round is a single instruction that runs in constant time, unlike the table lookups below.
+static bool has_aes_instructions()
+{
+    static bool const has_aes_instructions = __builtin_cpu_supports("aes");
+    return has_aes_instructions;
+}
+
+[[gnu::target("aes")]] static void encrypt_block_with_aes_instructions(u8 const* round_keys, size_t rounds, u8 const* in, u8* out)
+{
+    auto const* keys = reinterpret_cast<__m128i const*>(round_keys);
+    auto state = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(in)), _mm_load_si128(keys));
+    for (size_t i = 1; i < rounds; ++i)
+        state = _mm_aesenc_si128(state, _mm_load_si128(keys + i));
+    state = _mm_aesenclast_si128(state, _mm_load_si128(keys + rounds));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), state);
+}
+
+// NOTE: The decryption round keys are already those of the equivalent inverse cipher, which is what AESDEC expects.
+[[gnu::target("aes")]] static void decrypt_block_with_aes_instructions(u8 const* round_keys, size_t rounds, u8 const* in, u8* out)
+{
+    auto const* keys = reinterpret_cast<__m128i const*>(round_keys);
+    auto state = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(in)), _mm_load_si128(keys));
+    for (size_t i = 1; i < rounds; ++i)
+        state = _mm_aesdec_si128(state, _mm_load_si128(keys + i));
+    state = _mm_aesdeclast_si128(state, _mm_load_si128(keys + rounds));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), state);
+}
+#endif
+
 template<typename T>
 constexpr u32 get_key(T pt)
 {
@@ -150,6 +186,12 @@ void AESCipherKey::expand_encrypt_key(ReadonlyBytes user_key, size_t bits)
     }
 }
 
+void AESCipherKey::store_round_key_bytes()
+{
+    for (size_t i = 0; i < (rounds() + 1) * 4; ++i)
+        ByteReader::store(m_rd_key_bytes + i * 4, AK::convert_between_host_and_big_endian(m_rd_keys[i]));
+}
+
 void AESCipherKey::expand_decrypt_key(ReadonlyBytes user_key, size_t bits)
 {
     u32* round_key;
@@ -196,6 +238,13 @@ void AESCipherKey::expand_decrypt_key(ReadonlyBytes user_key, size_t bits)
 
 void AESCipher::encrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 {
+#if ARCH(X86_64)
+    if (has_aes_instructions()) {
+        encrypt_block_with_aes_instructions(key().round_key_bytes(), key().rounds(), in.bytes().data(), out.bytes().data());
+        return;
+    }
+#endif
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
@@ -285,6 +334,13 @@ void AESCipher::encrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 
 void AESCipher::decrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 {
+#if ARCH(X86_64)
+    if (has_aes_instructions()) {
+        decrypt_block_with_aes_instructions(key().round_key_bytes(), key().rounds(), in.bytes().data(), out.bytes().data());
+        return;
+    }
+#endif
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
@@ -65,6 +65,9 @@ struct AESCipherKey : public CipherKey {
         return (u32 const*)m_rd_keys;
     }
 
+    // The round keys laid out as bytes, which is how the CPU's AES instructions take them.
+    u8 const* round_key_bytes() const { return m_rd_key_bytes; }
+
     AESCipherKey(ReadonlyBytes user_key, size_t key_bits, Intent intent)
         : m_bits(key_bits)
     {
@@ -72,6 +75,7 @@ struct AESCipherKey : public CipherKey {
             expand_encrypt_key(user_key, key_bits);
         else
             expand_decrypt_key(user_key, key_bits);
+        store_round_key_bytes();
     }
 
     virtual ~AESCipherKey() override = default;
@@ -86,8 +90,11 @@ protected:
     }
 
 private:
+    void store_round_key_bytes();
+
     static constexpr size_t MAX_ROUND_COUNT = 14;
     u32 m_rd_keys[(MAX_ROUND_COUNT + 1) * 4] { 0 };
+    alignas(16) u8 m_rd_key_bytes[(MAX_ROUND_COUNT + 1) * 16] { 0 };
     size_t m_rounds;
     size_t m_bits;
 };
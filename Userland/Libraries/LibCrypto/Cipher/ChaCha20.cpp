@@ -6,10 +6,124 @@
 
 #include <AK/ByteReader.h>
 #include <AK/Endian.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <LibCrypto/Cipher/ChaCha20.h>
 
 namespace Crypto::Cipher {
 
+// The round functions also take vectors of words, so that several consecutive blocks can be generated in lockstep.
+template<typename T>
+concept ChaCha20Word = OneOf<T, u32, AK::SIMD::u32x4, AK::SIMD::u32x8>;
+
+template<ChaCha20Word T>
+ALWAYS_INLINE static void rotl(T& x, u32 n)
+{
+    x = (x << n) | (x >> (32 - n));
+}
+
+// https://datatracker.ietf.org/doc/html/rfc8439#section-2.1
+template<ChaCha20Word T>
+ALWAYS_INLINE static void quarter_round(T& a, T& b, T& c, T& d)
+{
+    a += b;
+    d ^= a;
+    rotl(d, 16);
+
+    c += d;
+    b ^= c;
+    rotl(b, 12);
+
+    a += b;
+    d ^= a;
+    rotl(d, 8);
+
+    c += d;
+    b ^= c;
+    rotl(b, 7);
+}
+
+template<ChaCha20Word T>
+ALWAYS_INLINE static void run_rounds(T (&block)[16])
+{
+    // ChaCha20 runs 20 rounds, alternating between "column rounds" and "diagonal rounds".
+    // Each round consists of four quarter-rounds
+    for (u32 i = 0; i < 20; i += 2) {
+        // Column rounds
+        quarter_round(block[0], block[4], block[8], block[12]);
+        quarter_round(block[1], block[5], block[9], block[13]);
+        quarter_round(block[2], block[6], block[10], block[14]);
+        quarter_round(block[3], block[7], block[11], block[15]);
+
+        // Diagonal rounds
+        quarter_round(block[0], block[5], block[10], block[15]);
+        quarter_round(block[1], block[6], block[11], block[12]);
+        quarter_round(block[2], block[7], block[8], block[13]);
+        quarter_round(block[3], block[4], block[9], block[14]);
+    }
+}
+
+// Generates the key stream of as many consecutive blocks as the vector has lanes, one block per lane.
+template<ChaCha20Word Vector>
+ALWAYS_INLINE static void generate_blocks(u32 const (&state)[16], u8* key_stream)
+{
+    static constexpr size_t lane_count = AK::SIMD::vector_length<Vector>;
+
+    Vector input[16];
+    for (size_t i = 0; i < 16; ++i)
+        input[i] = Vector {} + state[i];
+
+    // Every lane gets its own block counter, which carries over to word 13 like a single block does.
+    for (size_t lane = 0; lane < lane_count; ++lane)
+        input[12][lane] += lane;
+    input[13] -= (Vector)(input[12] < state[12]);
+
+    Vector block[16];
+    for (size_t i = 0; i < 16; ++i)
+        block[i] = input[i];
+
+    run_rounds(block);
+
+    // Add the original input words to the output words, and serialize each lane's block in little-endian order.
+    for (size_t i = 0; i < 16; ++i)
+        block[i] += input[i];
+    for (size_t lane = 0; lane < lane_count; ++lane) {
+        for (size_t i = 0; i < 16; ++i)
+            ByteReader::store(key_stream + lane * 64 + i * 4, AK::convert_between_host_and_little_endian(block[i][lane]));
+    }
+}
+
+static void generate_four_blocks(u32 const (&state)[16], u8* key_stream)
+{
+    generate_blocks<AK::SIMD::u32x4>(state, key_stream);
+}
+
+#if ARCH(X86_64)
+static bool has_avx2()
+{
+    static bool const has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+[[gnu::target("avx2")]] static void generate_eight_blocks_with_avx2(u32 const (&state)[16], u8* key_stream)
+{
+    generate_blocks<AK::SIMD::u32x8>(state, key_stream);
+}
+#endif
+
+static void xor_key_stream(u8 const* input, u8 const* key_stream, u8* output, size_t length)
+{
+    using AK::SIMD::u8x16;
+
+    size_t i = 0;
+    for (; i + sizeof(u8x16) <= length; i += sizeof(u8x16)) {
+        auto data = AK::SIMD::load_unaligned<u8x16>(input + i) ^ AK::SIMD::load_unaligned<u8x16>(key_stream + i);
+        AK::SIMD::store_unaligned(output + i, data);
+    }
+    for (; i < length; ++i)
+        output[i] = input[i] ^ key_stream[i];
+}
+
 ChaCha20::ChaCha20(ReadonlyBytes key, ReadonlyBytes nonce, u32 initial_counter)
 {
     VERIFY(key.size() == 16 || key.size() == 32);
@@ -59,21 +173,7 @@ void ChaCha20::generate_block()
     // Copy the current state into the block
     memcpy(m_block, m_state, 16 * sizeof(u32));
 
-    // ChaCha20 runs 20 rounds, alternating between "column rounds" and "diagonal rounds".
-    // Each round consists of four quarter-rounds
-    for (u32 i = 0; i < 20; i += 2) {
-        // Column rounds
-        do_quarter_round(m_block[0], m_block[4], m_block[8], m_block[12]);
-        do_quarter_round(m_block[1], m_block[5], m_block[9], m_block[13]);
-        do_quarter_round(m_block[2], m_block[6], m_block[10], m_block[14]);
-        do_quarter_round(m_block[3], m_block[7], m_block[11], m_block[15]);
-
-        // Diagonal rounds
-        do_quarter_round(m_block[0], m_block[5], m_block[10], m_block[15]);
-        do_quarter_round(m_block[1], m_block[6], m_block[11], m_block[12]);
-        do_quarter_round(m_block[2], m_block[7], m_block[8], m_block[13]);
-        do_quarter_round(m_block[3], m_block[4], m_block[9], m_block[14]);
-    }
+    run_rounds(m_block);
 
     // At the end of 20 rounds, we add the original input words to the output words,
     for (u32 i = 0; i < 16; i++) {
@@ -86,62 +186,45 @@ void ChaCha20::generate_block()
     }
 }
 
-ALWAYS_INLINE static void rotl(u32& x, u32 n)
+void ChaCha20::advance_block_counter(u32 block_count)
 {
-    x = (x << n) | (x >> (32 - n));
-}
-
-// https://datatracker.ietf.org/doc/html/rfc8439#section-2.1
-void ChaCha20::do_quarter_round(u32& a, u32& b, u32& c, u32& d)
-{
-    a += b;
-    d ^= a;
-    rotl(d, 16);
-
-    c += d;
-    b ^= c;
-    rotl(b, 12);
-
-    a += b;
-    d ^= a;
-    rotl(d, 8);
-
-    c += d;
-    b ^= c;
-    rotl(b, 7);
+    // Increment the block counter, and carry over to block 13
+    auto previous_counter = m_state[12];
+    m_state[12] += block_count;
+    if (m_state[12] < previous_counter)
+        m_state[13]++;
 }
 
 void ChaCha20::run_cipher(ReadonlyBytes input, Bytes& output)
 {
     size_t offset = 0;
-    size_t block_offset = 0;
-    while (offset < input.size()) {
-        if (block_offset == 0 || block_offset >= 64) {
-            // Generate a new XOR block
-            generate_block();
-
-            // Increment the block counter, and carry over to block 13
-            m_state[12]++;
-            if (m_state[12] == 0) {
-                m_state[13]++;
-            }
 
-            block_offset = 0;
+    // As long as there is enough input, generate the key stream of several blocks at once.
+    alignas(32) u8 key_stream[8 * 64];
+    auto run_whole_blocks = [&](size_t block_count, auto generate) {
+        while (input.size() - offset >= block_count * 64) {
+            generate(m_state, key_stream);
+            advance_block_counter(block_count);
+            xor_key_stream(input.offset_pointer(offset), key_stream, output.offset_pointer(offset), block_count * 64);
+            offset += block_count * 64;
         }
+    };
 
-        // XOR the input and the current block
-        u32 n = min(input.size() - offset, 64 - block_offset);
-        u8* key_block = (u8*)m_block + block_offset;
-        for (u32 i = 0; i < n; i++) {
-            u8 input_byte = input.offset_pointer(offset)[i];
-            u8 key_byte = key_block[i];
-            u8 output_byte = input_byte ^ key_byte;
-
-            ByteReader::store(output.offset_pointer(offset + i), output_byte);
-        }
+#if ARCH(X86_64)
+    if (has_avx2())
+        run_whole_blocks(8, generate_eight_blocks_with_avx2);
+#endif
+    run_whole_blocks(4, generate_four_blocks);
 
+    while (offset < input.size()) {
+        // Generate a new XOR block
+        generate_block();
+        advance_block_counter(1);
+
+        // XOR the input and the current block
+        size_t n = min(input.size() - offset, 64);
+        xor_key_stream(input.offset_pointer(offset), reinterpret_cast<u8 const*>(m_block), output.offset_pointer(offset), n);
         offset += n;
-        block_offset += n;
     }
 }
 
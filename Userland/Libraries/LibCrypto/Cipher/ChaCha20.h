@@ -24,7 +24,7 @@ public:
 
 private:
     void run_cipher(ReadonlyBytes input, Bytes& output);
-    ALWAYS_INLINE void do_quarter_round(u32& a, u32& b, u32& c, u32& d);
+    void advance_block_counter(u32 block_count);
 
     u32 m_state[16] {};
     u32 m_block[16] {};
@@ -7,11 +7,72 @@
 
 #include <AK/Endian.h>
 #include <AK/Memory.h>
+#include <AK/StdLibExtras.h>
 #include <AK/Types.h>
 #include <LibCrypto/Hash/SHA1.h>
 
+#if ARCH(X86_64)
+#    include <immintrin.h>
+#endif
+
 namespace Crypto::Hash {
 
+#if ARCH(X86_64)
+static bool has_sha_instructions()
+{
+    static bool const has_sha_instructions = __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+    return has_sha_instructions;
+}
+
+// Each group of four rounds is a single SHA1RNDS4, with the message schedule computed four words at a time alongside,
+// following Intel's "New Instructions Supporting the Secure Hash Algorithm on Intel Architecture Processors".
+[[gnu::target("sha,sse4.1")]] static void transform_with_sha_instructions(u32 (&state)[5], u8 const* data, size_t block_count)
+{
+    auto const byte_swap_mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    auto abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(state)), 0x1b);
+    auto e = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+
+    for (; block_count > 0; --block_count, data += 64) {
+        auto saved_abcd = abcd;
+        auto saved_e = e;
+        __m128i message[4];
+        __m128i previous_abcd;
+
+        auto four_rounds = [&]<size_t Group>() __attribute__((target("sha,sse4.1"))) {
+            auto& current = message[Group % 4];
+            if constexpr (Group < 4)
+                current = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + Group * 16)), byte_swap_mask);
+
+            // Finish the words needed by the next group, and advance the schedule of the ones after that.
+            if constexpr (Group >= 3 && Group <= 18)
+                message[(Group + 1) % 4] = _mm_sha1msg2_epu32(message[(Group + 1) % 4], current);
+            if constexpr (Group >= 2 && Group <= 17)
+                message[(Group + 2) % 4] = _mm_xor_si128(message[(Group + 2) % 4], current);
+            if constexpr (Group >= 1 && Group <= 16)
+                message[(Group + 3) % 4] = _mm_sha1msg1_epu32(message[(Group + 3) % 4], current);
+
+            __m128i e_with_message;
+            if constexpr (Group == 0)
+                e_with_message = _mm_add_epi32(e, current);
+            else
+                e_with_message = _mm_sha1nexte_epu32(previous_abcd, current);
+            previous_abcd = abcd;
+            abcd = _mm_sha1rnds4_epu32(abcd, e_with_message, Group / 5);
+        };
+        [&]<size_t... Groups>(IndexSequence<Groups...>) __attribute__((target("sha,sse4.1"))) {
+            (four_rounds.template operator()<Groups>(), ...);
+        }(MakeIndexSequence<20>());
+
+        e = _mm_sha1nexte_epu32(previous_abcd, saved_e);
+        abcd = _mm_add_epi32(abcd, saved_abcd);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1b));
+    state[4] = static_cast<u32>(_mm_extract_epi32(e, 3));
+}
+#endif
+
 static constexpr auto ROTATE_LEFT(u32 value, size_t bits)
 {
     return (value << bits) | (value >> (32 - bits));
@@ -67,16 +128,36 @@ inline void SHA1::transform(u8 const* data)
     secure_zero(blocks, 16 * sizeof(u32));
 }
 
+void SHA1::transform_blocks(u8 const* data, size_t block_count)
+{
+#if ARCH(X86_64)
+    if (has_sha_instructions())
+        return transform_with_sha_instructions(m_state, data, block_count);
+#endif
+    for (size_t i = 0; i < block_count; ++i)
+        transform(data + i * BlockSize);
+}
+
 void SHA1::update(u8 const* message, size_t length)
 {
     while (length > 0) {
+        // Whole blocks are hashed straight from the message, rather than being copied into the buffer first.
+        if (m_data_length == 0 && length >= BlockSize) {
+            auto block_count = length / BlockSize;
+            transform_blocks(message, block_count);
+            m_bit_length += block_count * BlockSize * 8;
+            message += block_count * BlockSize;
+            length -= block_count * BlockSize;
+            continue;
+        }
+
         size_t copy_bytes = AK::min(length, BlockSize - m_data_length);
         __builtin_memcpy(m_data_buffer + m_data_length, message, copy_bytes);
         message += copy_bytes;
         length -= copy_bytes;
         m_data_length += copy_bytes;
         if (m_data_length == BlockSize) {
-            transform(m_data_buffer);
+            transform_blocks(m_data_buffer, 1);
             m_bit_length += BlockSize * 8;
             m_data_length = 0;
         }
@@ -111,7 +192,7 @@ SHA1::DigestType SHA1::peek()
         m_data_buffer[i++] = 0x80;
         while (i < BlockSize)
             m_data_buffer[i++] = 0x00;
-        transform(m_data_buffer);
+        transform_blocks(m_data_buffer, 1);
 
         // Then start another block with BlockSize - 8 bytes of zeros
         __builtin_memset(m_data_buffer, 0, FinalBlockDataSize);
@@ -128,7 +209,7 @@ SHA1::DigestType SHA1::peek()
     m_data_buffer[BlockSize - 7] = m_bit_length >> 48;
     m_data_buffer[BlockSize - 8] = m_bit_length >> 56;
 
-    transform(m_data_buffer);
+    transform_blocks(m_data_buffer, 1);
 
     for (i = 0; i < 4; ++i) {
         digest.data[i + 0] = (m_state[0] >> (24 - i * 8)) & 0x000000ff;
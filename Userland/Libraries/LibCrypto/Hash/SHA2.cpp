@@ -5,17 +5,39 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
+#include <AK/Array.h>
+#include <AK/Concepts.h>
+#include <AK/Optional.h>
+#include <AK/SIMD.h>
+#include <AK/StdLibExtras.h>
 #include <AK/Types.h>
 #include <LibCrypto/Hash/SHA2.h>
 
+#if ARCH(X86_64)
+#    include <immintrin.h>
+#endif
+
 namespace Crypto::Hash {
-constexpr static auto ROTRIGHT(u32 a, size_t b) { return (a >> b) | (a << (32 - b)); }
-constexpr static auto CH(u32 x, u32 y, u32 z) { return (x & y) ^ (z & ~x); }
-constexpr static auto MAJ(u32 x, u32 y, u32 z) { return (x & y) ^ (x & z) ^ (y & z); }
-constexpr static auto EP0(u32 x) { return ROTRIGHT(x, 2) ^ ROTRIGHT(x, 13) ^ ROTRIGHT(x, 22); }
-constexpr static auto EP1(u32 x) { return ROTRIGHT(x, 6) ^ ROTRIGHT(x, 11) ^ ROTRIGHT(x, 25); }
-constexpr static auto SIGN0(u32 x) { return ROTRIGHT(x, 7) ^ ROTRIGHT(x, 18) ^ (x >> 3); }
-constexpr static auto SIGN1(u32 x) { return ROTRIGHT(x, 17) ^ ROTRIGHT(x, 19) ^ (x >> 10); }
+
+// The 32-bit functions also take vectors of words, so that several independent messages can be hashed in lockstep.
+template<typename T>
+concept SHA256Word = OneOf<T, u32, AK::SIMD::u32x4>;
+
+template<SHA256Word T>
+constexpr static auto ROTRIGHT(T a, size_t b) { return (a >> b) | (a << (32 - b)); }
+template<SHA256Word T>
+constexpr static auto CH(T x, T y, T z) { return (x & y) ^ (z & ~x); }
+template<SHA256Word T>
+constexpr static auto MAJ(T x, T y, T z) { return (x & y) ^ (x & z) ^ (y & z); }
+template<SHA256Word T>
+constexpr static auto EP0(T x) { return ROTRIGHT(x, 2) ^ ROTRIGHT(x, 13) ^ ROTRIGHT(x, 22); }
+template<SHA256Word T>
+constexpr static auto EP1(T x) { return ROTRIGHT(x, 6) ^ ROTRIGHT(x, 11) ^ ROTRIGHT(x, 25); }
+template<SHA256Word T>
+constexpr static auto SIGN0(T x) { return ROTRIGHT(x, 7) ^ ROTRIGHT(x, 18) ^ (x >> 3); }
+template<SHA256Word T>
+constexpr static auto SIGN1(T x) { return ROTRIGHT(x, 17) ^ ROTRIGHT(x, 19) ^ (x >> 10); }
 
 constexpr static auto ROTRIGHT(u64 a, size_t b) { return (a >> b) | (a << (64 - b)); }
 constexpr static auto CH(u64 x, u64 y, u64 z) { return (x & y) ^ (z & ~x); }
@@ -25,25 +47,20 @@ constexpr static auto EP1(u64 x) { return ROTRIGHT(x, 14) ^ ROTRIGHT(x, 18) ^ RO
 constexpr static auto SIGN0(u64 x) { return ROTRIGHT(x, 1) ^ ROTRIGHT(x, 8) ^ (x >> 7); }
 constexpr static auto SIGN1(u64 x) { return ROTRIGHT(x, 19) ^ ROTRIGHT(x, 61) ^ (x >> 6); }
 
-inline void SHA256::transform(u8 const* data)
+// Expects the first 16 words of the message schedule to be filled in already.
+template<SHA256Word T>
+ALWAYS_INLINE static void sha256_compress(T (&state)[8], T (&m)[64])
 {
-    u32 m[64];
-
-    size_t i = 0;
-    for (size_t j = 0; i < 16; ++i, j += 4) {
-        m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | data[j + 3];
-    }
-
-    for (; i < BlockSize; ++i) {
+    for (size_t i = 16; i < 64; ++i) {
         m[i] = SIGN1(m[i - 2]) + m[i - 7] + SIGN0(m[i - 15]) + m[i - 16];
     }
 
-    auto a = m_state[0], b = m_state[1],
-         c = m_state[2], d = m_state[3],
-         e = m_state[4], f = m_state[5],
-         g = m_state[6], h = m_state[7];
+    auto a = state[0], b = state[1],
+         c = state[2], d = state[3],
+         e = state[4], f = state[5],
+         g = state[6], h = state[7];
 
-    for (i = 0; i < Rounds; ++i) {
+    for (size_t i = 0; i < 64; ++i) {
         auto temp0 = h + EP1(e) + CH(e, f, g) + SHA256Constants::RoundConstants[i] + m[i];
         auto temp1 = EP0(a) + MAJ(a, b, c);
         h = g;
@@ -56,14 +73,94 @@ inline void SHA256::transform(u8 const* data)
         a = temp0 + temp1;
     }
 
-    m_state[0] += a;
-    m_state[1] += b;
-    m_state[2] += c;
-    m_state[3] += d;
-    m_state[4] += e;
-    m_state[5] += f;
-    m_state[6] += g;
-    m_state[7] += h;
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+inline void SHA256::transform(u8 const* data)
+{
+    u32 m[64];
+
+    for (size_t i = 0, j = 0; i < 16; ++i, j += 4) {
+        m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | data[j + 3];
+    }
+
+    sha256_compress(m_state, m);
+}
+
+#if ARCH(X86_64)
+static bool has_sha_instructions()
+{
+    static bool const has_sha_instructions = __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+    return has_sha_instructions;
+}
+
+// Each SHA256RNDS2 performs two rounds, with the message schedule computed four words at a time alongside,
+// following Intel's "New Instructions Supporting the Secure Hash Algorithm on Intel Architecture Processors".
+[[gnu::target("sha,sse4.1")]] static void transform_with_sha_instructions(u32 (&state)[8], u8 const* data, size_t block_count)
+{
+    auto const byte_swap_mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // The instructions want the state as ABEF and CDGH rather than ABCD and EFGH.
+    auto dcba = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(&state[0])), 0xb1);
+    auto hgfe = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(&state[4])), 0x1b);
+    auto abef = _mm_alignr_epi8(dcba, hgfe, 8);
+    auto cdgh = _mm_blend_epi16(hgfe, dcba, 0xf0);
+
+    for (; block_count > 0; --block_count, data += 64) {
+        auto saved_abef = abef;
+        auto saved_cdgh = cdgh;
+        __m128i message[4];
+
+        auto four_rounds = [&]<size_t Group>() __attribute__((target("sha,sse4.1"))) {
+            auto& current = message[Group % 4];
+            if constexpr (Group < 4)
+                current = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + Group * 16)), byte_swap_mask);
+
+            auto words = _mm_add_epi32(current, _mm_loadu_si128(reinterpret_cast<__m128i const*>(&SHA256Constants::RoundConstants[Group * 4])));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, words);
+
+            // Finish the words needed by the next group, and advance the schedule of the ones after that.
+            if constexpr (Group >= 3 && Group <= 14) {
+                auto& next = message[(Group + 1) % 4];
+                next = _mm_add_epi32(next, _mm_alignr_epi8(current, message[(Group + 3) % 4], 4));
+                next = _mm_sha256msg2_epu32(next, current);
+            }
+
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(words, 0x0e));
+
+            if constexpr (Group >= 1 && Group <= 12)
+                message[(Group + 3) % 4] = _mm_sha256msg1_epu32(message[(Group + 3) % 4], current);
+        };
+        [&]<size_t... Groups>(IndexSequence<Groups...>) __attribute__((target("sha,sse4.1"))) {
+            (four_rounds.template operator()<Groups>(), ...);
+        }(MakeIndexSequence<16>());
+
+        abef = _mm_add_epi32(abef, saved_abef);
+        cdgh = _mm_add_epi32(cdgh, saved_cdgh);
+    }
+
+    auto feba = _mm_shuffle_epi32(abef, 0x1b);
+    auto dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_blend_epi16(feba, dchg, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+}
+#endif
+
+void SHA256::transform_blocks(u8 const* data, size_t block_count)
+{
+#if ARCH(X86_64)
+    if (has_sha_instructions())
+        return transform_with_sha_instructions(m_state, data, block_count);
+#endif
+    for (size_t i = 0; i < block_count; ++i)
+        transform(data + i * BlockSize);
 }
 
 template<size_t BlockSize, typename Callback>
@@ -84,10 +181,27 @@ void update_buffer(u8* buffer, u8 const* input, size_t length, size_t& data_leng
 
 void SHA256::update(u8 const* message, size_t length)
 {
-    update_buffer<BlockSize>(m_data_buffer, message, length, m_data_length, [&]() {
-        transform(m_data_buffer);
+    auto transform_buffer = [&]() {
+        transform_blocks(m_data_buffer, 1);
         m_bit_length += BlockSize * 8;
-    });
+    };
+
+    if (m_data_length > 0) {
+        auto prefix_length = min(length, BlockSize - m_data_length);
+        update_buffer<BlockSize>(m_data_buffer, message, prefix_length, m_data_length, transform_buffer);
+        message += prefix_length;
+        length -= prefix_length;
+    }
+
+    // Whole blocks are hashed straight from the message, rather than being copied into the buffer first.
+    if (auto block_count = length / BlockSize; block_count > 0) {
+        transform_blocks(message, block_count);
+        m_bit_length += block_count * BlockSize * 8;
+        message += block_count * BlockSize;
+        length -= block_count * BlockSize;
+    }
+
+    update_buffer<BlockSize>(m_data_buffer, message, length, m_data_length, transform_buffer);
 }
 
 SHA256::DigestType SHA256::digest()
@@ -111,7 +225,7 @@ SHA256::DigestType SHA256::peek()
         m_data_buffer[i++] = 0x80;
         while (i < BlockSize)
             m_data_buffer[i++] = 0x00;
-        transform(m_data_buffer);
+        transform_blocks(m_data_buffer, 1);
 
         // Then start another block with BlockSize - 8 bytes of zeros
         __builtin_memset(m_data_buffer, 0, FinalBlockDataSize);
@@ -128,7 +242,7 @@ SHA256::DigestType SHA256::peek()
     m_data_buffer[BlockSize - 7] = m_bit_length >> 48;
     m_data_buffer[BlockSize - 8] = m_bit_length >> 56;
 
-    transform(m_data_buffer);
+    transform_blocks(m_data_buffer, 1);
 
     // SHA uses big-endian and we assume little-endian
     // FIXME: looks like a thing for AK::NetworkOrdered,
@@ -146,6 +260,102 @@ SHA256::DigestType SHA256::peek()
     return digest;
 }
 
+// Returns the given block of the message as it is fed into the compression function, with the padding and length
+// appended after the message's last byte.
+static u8 const* padded_message_block(ReadonlyBytes message, size_t block_index, u8 (&scratch)[64])
+{
+    auto offset = block_index * 64;
+    if (offset + 64 <= message.size())
+        return message.data() + offset;
+
+    __builtin_memset(scratch, 0, sizeof(scratch));
+    if (offset <= message.size()) {
+        auto remaining = message.size() - offset;
+        __builtin_memcpy(scratch, message.data() + offset, remaining);
+        scratch[remaining] = 0x80;
+    }
+
+    auto padded_block_count = (message.size() + 8) / 64 + 1;
+    if (block_index == padded_block_count - 1) {
+        u64 bit_length = static_cast<u64>(message.size()) * 8;
+        for (size_t i = 0; i < 8; ++i)
+            scratch[63 - i] = static_cast<u8>(bit_length >> (i * 8));
+    }
+    return scratch;
+}
+
+void SHA256::hash_many(ReadonlySpan<ReadonlyBytes> inputs, Span<DigestType> digests)
+{
+    VERIFY(inputs.size() == digests.size());
+
+#if ARCH(X86_64)
+    // A single message already keeps the SHA instructions busy enough that interleaving would gain little.
+    if (has_sha_instructions()) {
+        for (size_t i = 0; i < inputs.size(); ++i)
+            digests[i] = hash(inputs[i].data(), inputs[i].size());
+        return;
+    }
+#endif
+
+    using AK::SIMD::u32x4;
+    static constexpr size_t lane_count = 4;
+
+    struct Lane {
+        Optional<size_t> input_index;
+        size_t block_index { 0 };
+        size_t block_count { 0 };
+    };
+    Array<Lane, lane_count> lanes;
+    u32x4 state[8];
+    u8 scratch[lane_count][64] {};
+    size_t next_input_index = 0;
+
+    // Whenever a lane finishes its message, it moves on to the next input that is still waiting.
+    auto start_next_input = [&](size_t lane_index) {
+        auto& lane = lanes[lane_index];
+        if (next_input_index == inputs.size()) {
+            lane.input_index = {};
+            return;
+        }
+        lane.input_index = next_input_index;
+        lane.block_index = 0;
+        lane.block_count = (inputs[next_input_index].size() + 8) / 64 + 1;
+        ++next_input_index;
+        for (size_t i = 0; i < 8; ++i)
+            state[i][lane_index] = SHA256Constants::InitializationHashes[i];
+    };
+    for (size_t lane_index = 0; lane_index < lane_count; ++lane_index)
+        start_next_input(lane_index);
+
+    while (any_of(lanes, [](auto& lane) { return lane.input_index.has_value(); })) {
+        u32x4 m[64];
+        for (size_t lane_index = 0; lane_index < lane_count; ++lane_index) {
+            auto& lane = lanes[lane_index];
+            u8 const* block = scratch[lane_index];
+            if (lane.input_index.has_value())
+                block = padded_message_block(inputs[*lane.input_index], lane.block_index, scratch[lane_index]);
+            for (size_t i = 0, j = 0; i < 16; ++i, j += 4)
+                m[i][lane_index] = (block[j] << 24) | (block[j + 1] << 16) | (block[j + 2] << 8) | block[j + 3];
+        }
+
+        sha256_compress(state, m);
+
+        for (size_t lane_index = 0; lane_index < lane_count; ++lane_index) {
+            auto& lane = lanes[lane_index];
+            if (!lane.input_index.has_value() || ++lane.block_index < lane.block_count)
+                continue;
+
+            auto& digest = digests[*lane.input_index];
+            for (size_t i = 0; i < 8; ++i) {
+                auto word = state[i][lane_index];
+                for (size_t j = 0; j < 4; ++j)
+                    digest.data[i * 4 + j] = static_cast<u8>(word >> (24 - j * 8));
+            }
+            start_next_input(lane_index);
+        }
+    }
+}
+
 inline void SHA384::transform(u8 const* data)
 {
     u64 m[80];
@@ -96,6 +96,11 @@ public:
     static DigestType hash(ByteBuffer const& buffer) { return hash(buffer.data(), buffer.size()); }
     static DigestType hash(StringView buffer) { return hash((u8 const*)buffer.characters_without_null_termination(), buffer.length()); }
 
+    // Hashes several independent inputs, writing the digest of each input to the same index in digests.
+    // Without dedicated SHA instructions, the inputs are spread across the lanes of a vector and hashed in lockstep,
+    // which is considerably faster than hashing them one after another.
+    static void hash_many(ReadonlySpan<ReadonlyBytes> inputs, Span<DigestType> digests);
+
     virtual ByteString class_name() const override
     {
         return ByteString::formatted("SHA{}", DigestSize * 8);
@@ -111,6 +116,7 @@ public:
 
 private:
     inline void transform(u8 const*);
+    void transform_blocks(u8 const*, size_t block_count);
 
     u8 m_data_buffer[BlockSize] {};
     size_t m_data_length { 0 };
@@ -77,6 +77,12 @@ ErrorOr<void> encode(Encoder& encoder, Gfx::BitmapSequence const& bitmap_sequenc
 
     TRY(encoder.encode(metadata));
 
+    // A lone bitmap that already lives in shared memory (e.g. a still image decoded straight into it) is sent as-is.
+    if (bitmaps.size() == 1 && bitmaps[0].has_value() && bitmaps[0].value()->anonymous_buffer().is_valid()) {
+        TRY(encoder.encode(bitmaps[0].value()->anonymous_buffer()));
+        return {};
+    }
+
     // collate all of the bitmap data into one contiguous buffer
     auto collated_buffer = TRY(Core::AnonymousBuffer::create_with_size(total_buffer_size));
 
@@ -108,7 +114,7 @@ ErrorOr<Gfx::BitmapSequence> decode(Decoder& decoder)
     ReadonlyBytes bytes = ReadonlyBytes(collated_buffer.data<u8>(), collated_buffer.size());
     size_t bytes_read = 0;
 
-    // sequentially read each valid bitmap's data from the collated buffer
+    // sequentially wrap each valid bitmap's data in the collated buffer, without copying it out again
     for (auto const& metadata_option : metadata_list) {
         Optional<NonnullRefPtr<Gfx::Bitmap>> bitmap = {};
 
@@ -121,14 +127,22 @@ ErrorOr<Gfx::BitmapSequence> decode(Decoder& decoder)
             if (size_check.has_overflow() || size_check.value() > bytes.size())
                 return Error::from_string_literal("IPC: Invalid Gfx::BitmapSequence buffer data");
 
-            auto buffer = TRY(Core::AnonymousBuffer::create_with_size(size_in_bytes));
-            auto buffer_bytes = Bytes { buffer.data<u8>(), buffer.size() };
+            if (metadata.size.is_empty())
+                return Error::from_string_literal("IPC: Invalid Gfx::BitmapSequence bitmap size");
 
-            bytes.slice(bytes_read, size_in_bytes).copy_to(buffer_bytes);
+            auto pitch = size_in_bytes / metadata.size.height();
+            if (pitch < Gfx::Bitmap::minimum_pitch(metadata.size.width(), metadata.format) || Gfx::Bitmap::size_in_bytes(pitch, metadata.size.height()) != size_in_bytes)
+                return Error::from_string_literal("IPC: Invalid Gfx::BitmapSequence bitmap pitch");
 
-            bytes_read += size_in_bytes;
+            if (bytes_read == 0 && metadata_list.size() == 1 && pitch == Gfx::Bitmap::minimum_pitch(metadata.size.width(), metadata.format)) {
+                // The bitmap owns the whole buffer, so keep it shareable in case it has to be passed on.
+                bitmap = TRY(Gfx::Bitmap::create_with_anonymous_buffer(metadata.format, metadata.alpha_type, collated_buffer, metadata.size));
+            } else {
+                auto* data = const_cast<u8*>(bytes.offset_pointer(bytes_read));
+                bitmap = TRY(Gfx::Bitmap::create_wrapper(metadata.format, metadata.alpha_type, metadata.size, pitch, data, [collated_buffer] {}));
+            }
 
-            bitmap = TRY(Gfx::Bitmap::create_with_anonymous_buffer(metadata.format, metadata.alpha_type, move(buffer), metadata.size));
+            bytes_read += size_in_bytes;
         }
 
         bitmaps.append(move(bitmap));
@@ -5,10 +5,19 @@
  */
 
 #include <AK/Checked.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <LibGfx/CMYKBitmap.h>
 
 namespace Gfx {
 
+// Exact for x <= 255 * 255, and works on vectors too.
+template<typename T>
+ALWAYS_INLINE static T divide_by_255(T x)
+{
+    return (x + 1 + (x >> 8)) >> 8;
+}
+
 ErrorOr<NonnullRefPtr<CMYKBitmap>> CMYKBitmap::create_with_size(IntSize const& size)
 {
     VERIFY(size.width() >= 0 && size.height() >= 0);
@@ -26,11 +35,29 @@ ErrorOr<RefPtr<Bitmap>> CMYKBitmap::to_low_quality_rgb() const
     if (!m_rgb_bitmap) {
         m_rgb_bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, { m_size.width(), m_size.height() }));
 
+        using namespace AK::SIMD;
+        static_assert(sizeof(CMYK) == sizeof(u32));
+
         for (int y = 0; y < m_size.height(); ++y) {
-            for (int x = 0; x < m_size.width(); ++x) {
-                auto const& cmyk = scanline(y)[x];
-                u8 k = 255 - cmyk.k;
-                m_rgb_bitmap->scanline(y)[x] = Color((255 - cmyk.c) * k / 255, (255 - cmyk.m) * k / 255, (255 - cmyk.y) * k / 255).value();
+            auto const* in = scanline(y);
+            auto* out = m_rgb_bitmap->scanline(y);
+
+            // Four pixels at a time: with each CMYK pixel loaded as one little-endian u32, inverting all of its
+            // channels is a bitwise NOT, and the rest is shifts and multiplies in 32-bit lanes.
+            int x = 0;
+            for (; x + 4 <= m_size.width(); x += 4) {
+                auto inverted = ~load_unaligned<u32x4>(in + x);
+                auto k = inverted >> 24;
+                auto r = divide_by_255((inverted & 0xff) * k);
+                auto g = divide_by_255(((inverted >> 8) & 0xff) * k);
+                auto b = divide_by_255(((inverted >> 16) & 0xff) * k);
+                store_unaligned(out + x, 0xff000000 | (r << 16) | (g << 8) | b);
+            }
+
+            for (; x < m_size.width(); ++x) {
+                auto const& cmyk = in[x];
+                u32 k = 255 - cmyk.k;
+                out[x] = Color(divide_by_255((255 - cmyk.c) * k), divide_by_255((255 - cmyk.m) * k), divide_by_255((255 - cmyk.y) * k)).value();
             }
         }
     }
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/DeferredPainter.h>
+
+namespace Gfx {
+
+// Past this, keeping the commands around costs more memory than drawing them right away would save time.
+static constexpr size_t max_pending_commands = 4096;
+
+DeferredPainter::DeferredPainter(NonnullOwnPtr<Painter> target, IntSize target_size)
+    : m_target(move(target))
+    , m_target_rect(IntRect { {}, target_size }.to_type<float>())
+{
+}
+
+DeferredPainter::~DeferredPainter() = default;
+
+void DeferredPainter::flush()
+{
+    for (auto& command : m_commands) {
+        command.visit(
+            [&](ClearRect const& command) { m_target->clear_rect(command.rect, command.color); },
+            [&](FillRect const& command) { m_target->fill_rect(command.rect, command.color); },
+            [&](StrokePath const& command) { m_target->stroke_path(command.path, command.color, command.thickness); },
+            [&](FillPath const& command) { m_target->fill_path(command.path, command.color, command.winding_rule); },
+            [&](SetTransform const& command) { m_target->set_transform(command.transform); },
+            [&](Save const&) { m_target->save(); },
+            [&](Restore const&) { m_target->restore(); },
+            [&](Clip const& command) { m_target->clip(command.path, command.winding_rule); });
+    }
+    m_commands.clear_with_capacity();
+}
+
+void DeferredPainter::record(Command command)
+{
+    m_commands.append(move(command));
+    if (m_commands.size() >= max_pending_commands)
+        flush();
+}
+
+bool DeferredPainter::covers_target(FloatRect const& rect) const
+{
+    if (m_state.is_clipped || !m_state.transform.is_identity_or_translation_or_scale())
+        return false;
+    return m_state.transform.map(rect).contains(m_target_rect);
+}
+
+void DeferredPainter::drop_pending_drawing()
+{
+    // NOTE: The commands that change the state have to stay, as what is drawn afterwards depends on them.
+    m_commands.remove_all_matching([](Command const& command) {
+        return command.has<ClearRect>() || command.has<FillRect>() || command.has<StrokePath>() || command.has<FillPath>();
+    });
+}
+
+void DeferredPainter::clear_rect(FloatRect const& rect, Color color)
+{
+    if (covers_target(rect))
+        drop_pending_drawing();
+    record(ClearRect { rect, color });
+}
+
+void DeferredPainter::fill_rect(FloatRect const& rect, Color color)
+{
+    if (color.alpha() == 255 && covers_target(rect))
+        drop_pending_drawing();
+    record(FillRect { rect, color });
+}
+
+void DeferredPainter::draw_bitmap(FloatRect const& dst_rect, Bitmap const& src_bitmap, IntRect const& src_rect, ScalingMode scaling_mode, float global_alpha)
+{
+    flush();
+    m_target->draw_bitmap(dst_rect, src_bitmap, src_rect, scaling_mode, global_alpha);
+}
+
+void DeferredPainter::stroke_path(Path const& path, Color color, float thickness)
+{
+    record(StrokePath { path, color, thickness });
+}
+
+void DeferredPainter::stroke_path(Path const& path, PaintStyle const& paint_style, float thickness, float global_alpha)
+{
+    flush();
+    m_target->stroke_path(path, paint_style, thickness, global_alpha);
+}
+
+void DeferredPainter::fill_path(Path const& path, Color color, WindingRule winding_rule)
+{
+    record(FillPath { path, color, winding_rule });
+}
+
+void DeferredPainter::fill_path(Path const& path, PaintStyle const& paint_style, float global_alpha, WindingRule winding_rule)
+{
+    flush();
+    m_target->fill_path(path, paint_style, global_alpha, winding_rule);
+}
+
+void DeferredPainter::set_transform(AffineTransform const& transform)
+{
+    m_state.transform = transform;
+
+    // Setting the transform again before drawing anything replaces the previous one.
+    if (!m_commands.is_empty() && m_commands.last().has<SetTransform>()) {
+        m_commands.last().get<SetTransform>().transform = transform;
+        return;
+    }
+    record(SetTransform { transform });
+}
+
+void DeferredPainter::save()
+{
+    m_state_stack.append(m_state);
+    record(Save {});
+}
+
+void DeferredPainter::restore()
+{
+    if (!m_state_stack.is_empty())
+        m_state = m_state_stack.take_last();
+    record(Restore {});
+}
+
+void DeferredPainter::clip(Path const& path, WindingRule winding_rule)
+{
+    m_state.is_clipped = true;
+    record(Clip { path, winding_rule });
+}
+
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Variant.h>
+#include <AK/Vector.h>
+#include <LibGfx/AffineTransform.h>
+#include <LibGfx/Color.h>
+#include <LibGfx/Painter.h>
+#include <LibGfx/Path.h>
+#include <LibGfx/Rect.h>
+
+namespace Gfx {
+
+// A painter that records what is drawn with it, and only draws it with the painter it wraps once flush() is called.
+// This lets many small drawing operations be worked through in one go, and drops those that won't be visible because
+// the whole target gets cleared or painted over before the next flush.
+//
+// Only operations that don't refer to anything the caller could change afterwards are recorded. Drawing a bitmap or
+// drawing with a paint style flushes what has been recorded so far and draws right away, since the pixels of the
+// bitmap or the stops of a gradient may have changed by the time of the next flush.
+class DeferredPainter final : public Painter {
+public:
+    DeferredPainter(NonnullOwnPtr<Painter> target, IntSize target_size);
+
+    // Anything that hasn't been flushed yet is dropped.
+    virtual ~DeferredPainter() override;
+
+    // Draws everything recorded so far with the target painter.
+    void flush();
+    bool has_pending_commands() const { return !m_commands.is_empty(); }
+
+    virtual void clear_rect(FloatRect const&, Color) override;
+    virtual void fill_rect(FloatRect const&, Color) override;
+    virtual void draw_bitmap(FloatRect const& dst_rect, Bitmap const& src_bitmap, IntRect const& src_rect, ScalingMode, float global_alpha) override;
+    virtual void stroke_path(Path const&, Color, float thickness) override;
+    virtual void stroke_path(Path const&, PaintStyle const&, float thickness, float global_alpha) override;
+    virtual void fill_path(Path const&, Color, WindingRule) override;
+    virtual void fill_path(Path const&, PaintStyle const&, float global_alpha, WindingRule) override;
+    virtual void set_transform(AffineTransform const&) override;
+    virtual void save() override;
+    virtual void restore() override;
+    virtual void clip(Path const&, WindingRule) override;
+
+private:
+    struct ClearRect {
+        FloatRect rect;
+        Color color;
+    };
+    struct FillRect {
+        FloatRect rect;
+        Color color;
+    };
+    struct StrokePath {
+        Path path;
+        Color color;
+        float thickness { 0 };
+    };
+    struct FillPath {
+        Path path;
+        Color color;
+        WindingRule winding_rule;
+    };
+    struct SetTransform {
+        AffineTransform transform;
+    };
+    struct Save { };
+    struct Restore { };
+    struct Clip {
+        Path path;
+        WindingRule winding_rule;
+    };
+    using Command = Variant<ClearRect, FillRect, StrokePath, FillPath, SetTransform, Save, Restore, Clip>;
+
+    // What the target's state will be once the recorded commands have been replayed.
+    struct State {
+        AffineTransform transform;
+        bool is_clipped { false };
+    };
+
+    void record(Command);
+    bool covers_target(FloatRect const&) const;
+    void drop_pending_drawing();
+
+    NonnullOwnPtr<Painter> m_target;
+    FloatRect m_target_rect;
+    Vector<Command> m_commands;
+    State m_state;
+    Vector<State> m_state_stack;
+};
+
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibGfx/Font/DecompressedFontCache.h>
+#include <LibGfx/Font/Typeface.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace Gfx {
+
+// Bump this whenever the decompressors change what they produce, so that stale entries are never picked up.
+static constexpr u32 cache_format_version = 1;
+
+static DecompressedFontCache* s_decompressed_font_cache;
+
+void DecompressedFontCache::initialize(ByteString directory)
+{
+    VERIFY(!s_decompressed_font_cache);
+
+    if (auto result = Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes); result.is_error()) {
+        dbgln("DecompressedFontCache: Unable to create cache directory {}: {}", directory, result.error());
+        return;
+    }
+
+    s_decompressed_font_cache = new DecompressedFontCache(move(directory));
+    s_decompressed_font_cache->evict_if_needed();
+}
+
+DecompressedFontCache* DecompressedFontCache::the()
+{
+    return s_decompressed_font_cache;
+}
+
+DecompressedFontCache::DecompressedFontCache(ByteString directory)
+    : m_directory(move(directory))
+{
+}
+
+ErrorOr<NonnullRefPtr<Typeface>> DecompressedFontCache::try_load_typeface(ReadonlyBytes compressed_bytes, unsigned ttc_index, Decompressor const& decompress)
+{
+    auto* cache = the();
+    if (!cache) {
+        auto font_data = FontData::create_from_byte_buffer(TRY(decompress(compressed_bytes)));
+        return Typeface::try_load_from_font_data(move(font_data), ttc_index);
+    }
+
+    auto key = key_for(compressed_bytes);
+    if (auto font_data = cache->load(key)) {
+        if (auto typeface = Typeface::try_load_from_font_data(font_data.release_nonnull(), ttc_index); !typeface.is_error())
+            return typeface.release_value();
+
+        // NOTE: Whatever is on disk didn't come from us, so we drop it and decompress the font again.
+        cache->remove(key);
+    }
+
+    auto font_data = FontData::create_from_byte_buffer(TRY(decompress(compressed_bytes)));
+    auto decompressed_bytes = font_data->bytes();
+    auto typeface = TRY(Typeface::try_load_from_font_data(move(font_data), ttc_index));
+
+    // Only fonts that load successfully are worth keeping around.
+    cache->store(key, decompressed_bytes);
+    return typeface;
+}
+
+DecompressedFontCache::Key DecompressedFontCache::key_for(ReadonlyBytes compressed_bytes)
+{
+    auto digest = Crypto::Hash::SHA256::hash(compressed_bytes);
+    Key key;
+    digest.bytes().copy_to(key);
+    return key;
+}
+
+ByteString DecompressedFontCache::path_for(Key const& key) const
+{
+    StringBuilder builder;
+    builder.appendff("{}/v{}-", m_directory, cache_format_version);
+    for (auto byte : key)
+        builder.appendff("{:02x}", byte);
+    return builder.to_byte_string();
+}
+
+OwnPtr<FontData> DecompressedFontCache::load(Key const& key)
+{
+    auto file = Core::MappedFile::map(path_for(key));
+    if (file.is_error())
+        return {};
+    return FontData::create_from_mapped_file(file.release_value());
+}
+
+void DecompressedFontCache::store(Key const& key, ReadonlyBytes decompressed_bytes)
+{
+    if (decompressed_bytes.size() > size_limit)
+        return;
+
+    auto path = path_for(key);
+
+    // Other processes may map the entry at any time, so it's written to a file of its own and only moved into place once
+    // it's complete. Renaming over an entry that another process stored in the meantime is harmless, as it's identical.
+    auto temporary_path = ByteString::formatted("{}.{}.tmp", path, getpid());
+    auto write_entry = [&]() -> ErrorOr<void> {
+        {
+            auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+            TRY(file->write_until_depleted(decompressed_bytes));
+        }
+        TRY(Core::System::rename(temporary_path, path));
+        return {};
+    };
+
+    if (auto result = write_entry(); result.is_error()) {
+        dbgln("DecompressedFontCache: Unable to store {}: {}", path, result.error());
+        (void)Core::System::unlink(temporary_path);
+    }
+}
+
+void DecompressedFontCache::remove(Key const& key)
+{
+    (void)Core::System::unlink(path_for(key));
+}
+
+// NOTE: This only runs when a process sets up the cache, which is often enough to keep the directory from growing
+//       without bound, and avoids having the processes that share it coordinate with each other.
+void DecompressedFontCache::evict_if_needed()
+{
+    struct Entry {
+        ByteString path;
+        u64 size { 0 };
+        time_t last_access_time { 0 };
+    };
+    Vector<Entry> entries;
+    u64 total_size = 0;
+
+    auto result = Core::Directory::for_each_entry(m_directory, Core::DirIterator::SkipParentAndBaseDir, [&](auto const& entry, auto const&) -> ErrorOr<IterationDecision> {
+        auto path = ByteString::formatted("{}/{}", m_directory, entry.name);
+        auto stat = Core::System::stat(path);
+        if (stat.is_error())
+            return IterationDecision::Continue;
+
+        // Leftovers of a different format version, or of a process that died in the middle of a store, are never read.
+        if (!entry.name.starts_with(ByteString::formatted("v{}-", cache_format_version)) || entry.name.ends_with(".tmp"sv)) {
+            // Stores in progress are only a moment old, so anything older than that is safe to remove.
+            if (!entry.name.ends_with(".tmp"sv) || time(nullptr) - stat.value().st_mtime > 60)
+                (void)Core::System::unlink(path);
+            return IterationDecision::Continue;
+        }
+
+        entries.append({ move(path), static_cast<u64>(stat.value().st_size), stat.value().st_atime });
+        total_size += stat.value().st_size;
+        return IterationDecision::Continue;
+    });
+    if (result.is_error()) {
+        dbgln("DecompressedFontCache: Unable to list {}: {}", m_directory, result.error());
+        return;
+    }
+
+    if (total_size <= size_limit)
+        return;
+
+    quick_sort(entries, [](auto const& a, auto const& b) { return a.last_access_time < b.last_access_time; });
+    for (auto const& entry : entries) {
+        if (total_size <= size_limit)
+            break;
+        (void)Core::System::unlink(entry.path);
+        total_size -= entry.size;
+    }
+}
+
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/ByteString.h>
+#include <AK/Function.h>
+#include <AK/NonnullRefPtr.h>
+#include <LibGfx/Font/FontData.h>
+#include <LibGfx/Forward.h>
+
+namespace Gfx {
+
+class Typeface;
+
+// A disk cache of the sfnt data that WOFF and WOFF2 fonts decompress to, shared by every process that points it at the
+// same directory. Entries are keyed by a hash of the compressed font, and are memory-mapped instead of decoded again.
+class DecompressedFontCache {
+public:
+    static void initialize(ByteString directory);
+    static DecompressedFontCache* the();
+
+    using Decompressor = Function<ErrorOr<ByteBuffer>(ReadonlyBytes)>;
+
+    // Loads the typeface that the compressed font decompresses to, from the cache if there is one and it has an entry.
+    static ErrorOr<NonnullRefPtr<Typeface>> try_load_typeface(ReadonlyBytes compressed_bytes, unsigned ttc_index, Decompressor const&);
+
+    static constexpr u64 size_limit = 64 * MiB;
+
+private:
+    using Key = Array<u8, 32>;
+
+    explicit DecompressedFontCache(ByteString directory);
+
+    static Key key_for(ReadonlyBytes compressed_bytes);
+    ByteString path_for(Key const&) const;
+
+    OwnPtr<FontData> load(Key const&);
+    void store(Key const&, ReadonlyBytes decompressed_bytes);
+    void remove(Key const&);
+    void evict_if_needed();
+
+    ByteString m_directory;
+};
+
+}
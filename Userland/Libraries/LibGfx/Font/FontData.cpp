@@ -18,12 +18,20 @@ NonnullOwnPtr<FontData> FontData::create_from_resource(Core::Resource const& res
     return adopt_own(*new FontData(resource));
 }
 
+NonnullOwnPtr<FontData> FontData::create_from_mapped_file(NonnullOwnPtr<Core::MappedFile> mapped_file)
+{
+    return adopt_own(*new FontData(move(mapped_file)));
+}
+
 ReadonlyBytes FontData::bytes() const
 {
     return m_data.visit(
         [&](ByteBuffer const& byte_buffer) { return byte_buffer.bytes(); },
-        [&](Core::Resource const& resource) {
-            return resource.data();
+        [&](NonnullRefPtr<Core::Resource> const& resource) {
+            return resource->data();
+        },
+        [&](NonnullOwnPtr<Core::MappedFile> const& mapped_file) {
+            return mapped_file->bytes();
         });
 }
 
@@ -37,4 +45,9 @@ FontData::FontData(NonnullRefPtr<Core::Resource> resource)
 {
 }
 
+FontData::FontData(NonnullOwnPtr<Core::MappedFile> mapped_file)
+    : m_data(move(mapped_file))
+{
+}
+
 }
@@ -9,6 +9,7 @@
 #include <AK/HashMap.h>
 #include <AK/Noncopyable.h>
 #include <AK/RefCounted.h>
+#include <LibCore/MappedFile.h>
 #include <LibCore/Resource.h>
 #include <LibGfx/Forward.h>
 
@@ -18,14 +19,16 @@ class FontData {
 public:
     static NonnullOwnPtr<FontData> create_from_byte_buffer(ByteBuffer&&);
     static NonnullOwnPtr<FontData> create_from_resource(Core::Resource const&);
+    static NonnullOwnPtr<FontData> create_from_mapped_file(NonnullOwnPtr<Core::MappedFile>);
 
     ReadonlyBytes bytes() const;
 
 private:
     FontData(ByteBuffer&& byte_buffer);
     FontData(NonnullRefPtr<Core::Resource> resource);
+    FontData(NonnullOwnPtr<Core::MappedFile> mapped_file);
 
-    Variant<ByteBuffer, NonnullRefPtr<Core::Resource>> m_data;
+    Variant<ByteBuffer, NonnullRefPtr<Core::Resource>, NonnullOwnPtr<Core::MappedFile>> m_data;
 };
 
 }
@@ -14,8 +14,13 @@
 #include <LibGfx/Font/ScaledFont.h>
 #include <LibGfx/Font/WOFF/Loader.h>
 
+#include <core/SkGraphics.h>
+
 namespace Gfx {
 
+// Skia's default budget only fits a few fonts' worth of glyphs, which text-heavy pages churn through every frame.
+static constexpr size_t default_glyph_cache_budget = 32 * MiB;
+
 FontDatabase& FontDatabase::the()
 {
     static FontDatabase s_the;
@@ -37,6 +42,33 @@ bool FontDatabase::should_force_fontconfig() const
     return m_private->force_fontconfig;
 }
 
+size_t FontDatabase::purge_glyph_caches()
+{
+    auto bytes_before = SkGraphics::GetFontCacheUsed();
+    SkGraphics::PurgeFontCache();
+    auto bytes_after = SkGraphics::GetFontCacheUsed();
+    return bytes_before > bytes_after ? bytes_before - bytes_after : 0;
+}
+
+size_t FontDatabase::glyph_cache_size()
+{
+    return SkGraphics::GetFontCacheUsed();
+}
+
+FontDatabase::GlyphCacheStatistics FontDatabase::glyph_cache_statistics()
+{
+    return {
+        .bytes = SkGraphics::GetFontCacheUsed(),
+        .budget_bytes = SkGraphics::GetFontCacheLimit(),
+        .glyph_count = static_cast<size_t>(SkGraphics::GetFontCacheCountUsed()),
+    };
+}
+
+void FontDatabase::set_glyph_cache_budget(size_t bytes)
+{
+    SkGraphics::SetFontCacheLimit(bytes);
+}
+
 void FontDatabase::load_all_fonts_from_uri(StringView uri)
 {
     auto root_or_error = Core::Resource::load_from_uri(uri);
@@ -77,6 +109,7 @@ void FontDatabase::load_all_fonts_from_uri(StringView uri)
 FontDatabase::FontDatabase()
     : m_private(make<Private>())
 {
+    set_glyph_cache_budget(default_glyph_cache_budget);
 }
 
 RefPtr<Gfx::Font> FontDatabase::get(FlyString const& family, float point_size, unsigned weight, unsigned width, unsigned slope)
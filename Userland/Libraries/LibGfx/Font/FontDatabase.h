@@ -30,6 +30,24 @@ public:
     void set_force_fontconfig(bool);
     [[nodiscard]] bool should_force_fontconfig() const;
 
+    // Drops the glyphs that have been rasterized so far. They're rasterized again when they're next drawn.
+    // Returns the number of bytes that were freed.
+    static size_t purge_glyph_caches();
+
+    // The number of bytes taken up by rasterized glyphs.
+    static size_t glyph_cache_size();
+
+    // Rasterized glyphs are kept in one cache for the whole process, keyed by typeface, size and subpixel offset, so
+    // all pages and surfaces drawing the same text share them. Once the cache grows past its budget, the glyphs that
+    // were drawn least recently are dropped.
+    struct GlyphCacheStatistics {
+        size_t bytes { 0 };
+        size_t budget_bytes { 0 };
+        size_t glyph_count { 0 };
+    };
+    static GlyphCacheStatistics glyph_cache_statistics();
+    static void set_glyph_cache_budget(size_t bytes);
+
 private:
     FontDatabase();
     ~FontDatabase() = default;
@@ -9,6 +9,7 @@
 #include <AK/IntegralMath.h>
 #include <LibCompress/Zlib.h>
 #include <LibCore/Resource.h>
+#include <LibGfx/Font/DecompressedFontCache.h>
 #include <LibGfx/Font/WOFF/Loader.h>
 #include <LibGfx/FourCC.h>
 
@@ -102,7 +103,7 @@ struct [[gnu::packed]] TableRecord {
 };
 static_assert(AssertSize<TableRecord, 16>());
 
-ErrorOr<NonnullRefPtr<Gfx::Typeface>> try_load_from_externally_owned_memory(ReadonlyBytes buffer, unsigned int index)
+static ErrorOr<ByteBuffer> decompress(ReadonlyBytes buffer)
 {
     FixedMemoryStream stream(buffer);
     auto header = TRY(stream.read_value<Header>());
@@ -186,8 +187,12 @@ ErrorOr<NonnullRefPtr<Gfx::Typeface>> try_load_from_externally_owned_memory(Read
     if (header.total_sfnt_size != expected_total_sfnt_size)
         return Error::from_string_literal("Invalid WOFF total sfnt size");
 
-    auto font_data = Gfx::FontData::create_from_byte_buffer(move(font_buffer));
-    return TRY(Gfx::Typeface::try_load_from_font_data(move(font_data), index));
+    return font_buffer;
+}
+
+ErrorOr<NonnullRefPtr<Gfx::Typeface>> try_load_from_externally_owned_memory(ReadonlyBytes buffer, unsigned int index)
+{
+    return Gfx::DecompressedFontCache::try_load_typeface(buffer, index, decompress);
 }
 
 }
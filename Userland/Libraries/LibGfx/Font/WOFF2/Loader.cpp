@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibGfx/Font/DecompressedFontCache.h>
 #include <LibGfx/Font/Typeface.h>
 #include <LibGfx/Font/WOFF2/Loader.h>
 #include <woff2/decode.h>
@@ -53,7 +54,7 @@ private:
     ByteBuffer& m_buffer;
 };
 
-ErrorOr<NonnullRefPtr<Gfx::Typeface>> try_load_from_externally_owned_memory(ReadonlyBytes bytes)
+static ErrorOr<ByteBuffer> decompress(ReadonlyBytes bytes)
 {
     auto ttf_buffer = TRY(ByteBuffer::create_uninitialized(0));
     auto output = WOFF2ByteBufferOut { ttf_buffer };
@@ -62,9 +63,12 @@ ErrorOr<NonnullRefPtr<Gfx::Typeface>> try_load_from_externally_owned_memory(Read
         return Error::from_string_literal("Failed to convert the WOFF2 font to TTF");
     }
 
-    auto font_data = Gfx::FontData::create_from_byte_buffer(move(ttf_buffer));
-    auto input_font = TRY(Gfx::Typeface::try_load_from_font_data(move(font_data)));
-    return input_font;
+    return ttf_buffer;
+}
+
+ErrorOr<NonnullRefPtr<Gfx::Typeface>> try_load_from_externally_owned_memory(ReadonlyBytes bytes)
+{
+    return Gfx::DecompressedFontCache::try_load_typeface(bytes, 0, decompress);
 }
 
 }
@@ -11,11 +11,13 @@ namespace Gfx {
 void FontCascadeList::add(NonnullRefPtr<Font> font)
 {
     m_fonts.append({ move(font), {} });
+    m_font_for_code_point_cache.clear();
 }
 
 void FontCascadeList::add(NonnullRefPtr<Font> font, Vector<UnicodeRange> unicode_ranges)
 {
     m_fonts.append({ move(font), move(unicode_ranges) });
+    m_font_for_code_point_cache.clear();
 }
 
 void FontCascadeList::extend(FontCascadeList const& other)
@@ -23,9 +25,15 @@ void FontCascadeList::extend(FontCascadeList const& other)
     for (auto const& font : other.m_fonts) {
         m_fonts.append({ font.font, font.unicode_ranges });
     }
+    m_font_for_code_point_cache.clear();
 }
 
 Gfx::Font const& FontCascadeList::font_for_code_point(u32 code_point) const
+{
+    return *m_font_for_code_point_cache.ensure(code_point, [&] { return &find_font_for_code_point(code_point); });
+}
+
+Gfx::Font const& FontCascadeList::find_font_for_code_point(u32 code_point) const
 {
     for (auto const& entry : m_fonts) {
         if (entry.unicode_ranges.has_value()) {
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Font/UnicodeRange.h>
 
@@ -43,11 +44,21 @@ public:
         Optional<Vector<UnicodeRange>> unicode_ranges;
     };
 
-    void set_last_resort_font(NonnullRefPtr<Font> font) { m_last_resort_font = move(font); }
+    void set_last_resort_font(NonnullRefPtr<Font> font)
+    {
+        m_last_resort_font = move(font);
+        m_font_for_code_point_cache.clear();
+    }
 
 private:
+    Font const& find_font_for_code_point(u32 code_point) const;
+
     RefPtr<Font const> m_last_resort_font;
     Vector<Entry> m_fonts;
+
+    // Text nodes with the same computed font share a list, so the fonts found for the code points of one of them are
+    // reused for all the others. The fonts are kept alive by the entries and cleared whenever those change.
+    mutable HashMap<u32, Font const*> m_font_for_code_point_cache;
 };
 
 }
@@ -4,13 +4,18 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/Endian.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <LibGfx/CIELAB.h>
 #include <LibGfx/CMYKBitmap.h>
 #include <LibGfx/ICC/BinaryFormat.h>
+#include <LibGfx/ICC/BinaryWriter.h>
 #include <LibGfx/ICC/Profile.h>
 #include <LibGfx/ICC/Tags.h>
 #include <LibGfx/Matrix3x3.h>
+#include <LibThreading/Mutex.h>
 #include <math.h>
 #include <time.h>
 
@@ -1206,7 +1211,12 @@ ErrorOr<NonnullRefPtr<Profile>> Profile::try_load_from_externally_owned_memory(R
     bytes = bytes.trim(header.on_disk_size);
     auto tag_table = TRY(read_tag_table(bytes));
 
-    return create(header, move(tag_table));
+    auto profile = TRY(create(header, move(tag_table)));
+
+    // If the profile has an ID, read_header() has already checked that it matches the contents.
+    profile->m_cached_content_id = header.id.has_value() ? *header.id : compute_id(bytes);
+
+    return profile;
 }
 
 ErrorOr<NonnullRefPtr<Profile>> Profile::create(ProfileHeader const& header, OrderedHashMap<TagSignature, NonnullRefPtr<TagData>> tag_table)
@@ -1241,6 +1251,14 @@ Crypto::Hash::MD5::DigestType Profile::compute_id(ReadonlyBytes bytes)
     return md5.digest();
 }
 
+ErrorOr<Crypto::Hash::MD5::DigestType> Profile::content_id() const
+{
+    // Profiles that weren't loaded from bytes have to be serialized first.
+    if (!m_cached_content_id.has_value())
+        m_cached_content_id = compute_id(TRY(encode(*this)));
+    return *m_cached_content_id;
+}
+
 static TagSignature forward_transform_tag_for_rendering_intent(RenderingIntent rendering_intent)
 {
     // ICCv4, Table 25 — Profile type/profile tag and defined rendering intents
@@ -1637,7 +1655,8 @@ MatrixMatrixConversion::MatrixMatrixConversion(LutCurveType source_red_TRC,
     FloatMatrix3x3 matrix,
     LutCurveType destination_red_TRC,
     LutCurveType destination_green_TRC,
-    LutCurveType destination_blue_TRC)
+    LutCurveType destination_blue_TRC,
+    NonnullRefPtr<LookupTables const> lookup_tables)
     : m_source_red_TRC(move(source_red_TRC))
     , m_source_green_TRC(move(source_green_TRC))
     , m_source_blue_TRC(move(source_blue_TRC))
@@ -1645,6 +1664,7 @@ MatrixMatrixConversion::MatrixMatrixConversion(LutCurveType source_red_TRC,
     , m_destination_red_TRC(move(destination_red_TRC))
     , m_destination_green_TRC(move(destination_green_TRC))
     , m_destination_blue_TRC(move(destination_blue_TRC))
+    , m_lookup_tables(move(lookup_tables))
 {
     auto check = [](auto const& trc) {
         VERIFY(trc->type() == CurveTagData::Type || trc->type() == ParametricCurveTagData::Type);
@@ -1657,6 +1677,135 @@ MatrixMatrixConversion::MatrixMatrixConversion(LutCurveType source_red_TRC,
     check(m_destination_blue_TRC);
 }
 
+ErrorOr<NonnullRefPtr<MatrixMatrixConversion::LookupTables>> MatrixMatrixConversion::LookupTables::create(TagData const& source_red_TRC,
+    TagData const& source_green_TRC,
+    TagData const& source_blue_TRC,
+    TagData const& destination_red_TRC,
+    TagData const& destination_green_TRC,
+    TagData const& destination_blue_TRC)
+{
+    auto tables = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) LookupTables));
+
+    // There are only 256 possible inputs per channel, so evaluate the source curves once for each of them up front.
+    for (size_t i = 0; i < 256; ++i) {
+        tables->source_red[i] = evaluate_curve(source_red_TRC, i / 255.0f);
+        tables->source_green[i] = evaluate_curve(source_green_TRC, i / 255.0f);
+        tables->source_blue[i] = evaluate_curve(source_blue_TRC, i / 255.0f);
+    }
+
+    // The inverse destination curves are much more expensive to evaluate, and have to be evaluated for arbitrary
+    // linear values, so they are sampled finely enough that interpolating between the samples is very close to exact.
+    auto evaluate_curve_inverse = [](TagData const& trc, float f) {
+        if (trc.type() == CurveTagData::Type)
+            return static_cast<CurveTagData const&>(trc).evaluate_inverse(f);
+        return static_cast<ParametricCurveTagData const&>(trc).evaluate_inverse(f);
+    };
+    for (size_t i = 0; i <= destination_curve_sample_count; ++i) {
+        float linear = static_cast<float>(i) / destination_curve_sample_count;
+        tables->destination_red[i] = 255 * evaluate_curve_inverse(destination_red_TRC, linear);
+        tables->destination_green[i] = 255 * evaluate_curve_inverse(destination_green_TRC, linear);
+        tables->destination_blue[i] = 255 * evaluate_curve_inverse(destination_blue_TRC, linear);
+    }
+
+    return tables;
+}
+
+void MatrixMatrixConversion::map_pixels(Span<ARGB32> pixels) const
+{
+    using namespace AK::SIMD;
+
+    auto const& tables = *m_lookup_tables;
+    auto const& red_lut = tables.source_red;
+    auto const& green_lut = tables.source_green;
+    auto const& blue_lut = tables.source_blue;
+
+    auto const& m = m_matrix.elements();
+
+    // Go through four pixels at a time, doing the matrix multiplication for all of them at once.
+    size_t i = 0;
+    for (; i + 4 <= pixels.size(); i += 4) {
+        auto argb = load_unaligned<u32x4>(&pixels[i]);
+        f32x4 r = { red_lut[(argb[0] >> 16) & 0xff], red_lut[(argb[1] >> 16) & 0xff], red_lut[(argb[2] >> 16) & 0xff], red_lut[(argb[3] >> 16) & 0xff] };
+        f32x4 g = { green_lut[(argb[0] >> 8) & 0xff], green_lut[(argb[1] >> 8) & 0xff], green_lut[(argb[2] >> 8) & 0xff], green_lut[(argb[3] >> 8) & 0xff] };
+        f32x4 b = { blue_lut[argb[0] & 0xff], blue_lut[argb[1] & 0xff], blue_lut[argb[2] & 0xff], blue_lut[argb[3] & 0xff] };
+
+        f32x4 linear_r = r * m[0][0] + g * m[0][1] + b * m[0][2];
+        f32x4 linear_g = r * m[1][0] + g * m[1][1] + b * m[1][2];
+        f32x4 linear_b = r * m[2][0] + g * m[2][1] + b * m[2][2];
+
+        for (size_t lane = 0; lane < 4; ++lane) {
+            u8 out_r = evaluate_sampled_curve_inverse(tables.destination_red, linear_r[lane]);
+            u8 out_g = evaluate_sampled_curve_inverse(tables.destination_green, linear_g[lane]);
+            u8 out_b = evaluate_sampled_curve_inverse(tables.destination_blue, linear_b[lane]);
+            pixels[i + lane] = (argb[lane] & 0xff000000) | (out_r << 16) | (out_g << 8) | out_b;
+        }
+    }
+
+    for (; i < pixels.size(); ++i) {
+        auto color = Color::from_argb(pixels[i]);
+        auto out = map(FloatVector3 { (float)color.red(), (float)color.green(), (float)color.blue() } / 255.0f);
+        out.set_alpha(color.alpha());
+        pixels[i] = out.value();
+    }
+}
+
+namespace {
+
+struct MatrixMatrixConversionCacheKey {
+    Crypto::Hash::MD5::DigestType source_profile_id;
+    Crypto::Hash::MD5::DigestType destination_profile_id;
+
+    bool operator==(MatrixMatrixConversionCacheKey const&) const = default;
+};
+
+struct MatrixMatrixConversionCacheKeyTraits : public DefaultTraits<MatrixMatrixConversionCacheKey> {
+    static unsigned hash(MatrixMatrixConversionCacheKey const& key)
+    {
+        return pair_int_hash(
+            string_hash(reinterpret_cast<char const*>(key.source_profile_id.data), sizeof(key.source_profile_id.data)),
+            string_hash(reinterpret_cast<char const*>(key.destination_profile_id.data), sizeof(key.destination_profile_id.data)));
+    }
+};
+
+// All images that are tagged with the same profile get converted to the same destination profile, usually the one of
+// the display, so the lookup tables for the most recent conversions are kept around for the next image.
+static constexpr size_t matrix_matrix_conversion_cache_size = 16;
+
+class MatrixMatrixConversionCache {
+public:
+    static MatrixMatrixConversionCache& the()
+    {
+        static auto& cache = *new MatrixMatrixConversionCache;
+        return cache;
+    }
+
+    RefPtr<MatrixMatrixConversion::LookupTables const> get(MatrixMatrixConversionCacheKey const& key)
+    {
+        Threading::MutexLocker locker { m_mutex };
+        return m_lookup_tables.get(key).value_or(nullptr);
+    }
+
+    NonnullRefPtr<MatrixMatrixConversion::LookupTables const> set(MatrixMatrixConversionCacheKey const& key, NonnullRefPtr<MatrixMatrixConversion::LookupTables const> lookup_tables)
+    {
+        Threading::MutexLocker locker { m_mutex };
+
+        // Another thread might have created the same tables in the meantime.
+        if (auto existing_lookup_tables = m_lookup_tables.get(key); existing_lookup_tables.has_value())
+            return *existing_lookup_tables.value();
+
+        if (m_lookup_tables.size() >= matrix_matrix_conversion_cache_size)
+            m_lookup_tables.remove(m_lookup_tables.begin());
+        m_lookup_tables.set(key, lookup_tables);
+        return lookup_tables;
+    }
+
+private:
+    Threading::Mutex m_mutex;
+    OrderedHashMap<MatrixMatrixConversionCacheKey, NonnullRefPtr<MatrixMatrixConversion::LookupTables const>, MatrixMatrixConversionCacheKeyTraits> m_lookup_tables;
+};
+
+}
+
 Optional<MatrixMatrixConversion> Profile::matrix_matrix_conversion(Profile const& source_profile) const
 {
     auto has_normal_device_class = [](DeviceClass device) {
@@ -1691,17 +1840,27 @@ Optional<MatrixMatrixConversion> Profile::matrix_matrix_conversion(Profile const
     LutCurveType destinationGreenTRC = *m_tag_table.get(greenTRCTag).value();
     LutCurveType destinationBlueTRC = *m_tag_table.get(blueTRCTag).value();
 
-    return MatrixMatrixConversion(sourceRedTRC, sourceGreenTRC, sourceBlueTRC, matrix, destinationRedTRC, destinationGreenTRC, destinationBlueTRC);
+    auto lookup_tables = [&]() -> ErrorOr<NonnullRefPtr<MatrixMatrixConversion::LookupTables const>> {
+        MatrixMatrixConversionCacheKey key { TRY(source_profile.content_id()), TRY(content_id()) };
+
+        auto& cache = MatrixMatrixConversionCache::the();
+        if (auto lookup_tables = cache.get(key))
+            return lookup_tables.release_nonnull();
+
+        return cache.set(key, TRY(MatrixMatrixConversion::LookupTables::create(*sourceRedTRC, *sourceGreenTRC, *sourceBlueTRC, *destinationRedTRC, *destinationGreenTRC, *destinationBlueTRC)));
+    }();
+
+    // Without the lookup tables, the conversion falls back to the generic path.
+    if (lookup_tables.is_error())
+        return OptionalNone {};
+
+    return MatrixMatrixConversion(sourceRedTRC, sourceGreenTRC, sourceBlueTRC, matrix, destinationRedTRC, destinationGreenTRC, destinationBlueTRC, lookup_tables.release_value());
 }
 
 ErrorOr<void> Profile::convert_image_matrix_matrix(Gfx::Bitmap& bitmap, MatrixMatrixConversion const& map) const
 {
-    for (auto& pixel : bitmap) {
-        FloatVector3 rgb { (float)Color::from_argb(pixel).red(), (float)Color::from_argb(pixel).green(), (float)Color::from_argb(pixel).blue() };
-        auto out = map.map(rgb / 255.0f);
-        out.set_alpha(Color::from_argb(pixel).alpha());
-        pixel = out.value();
-    }
+    for (int y = 0; y < bitmap.height(); ++y)
+        map.map_pixels({ bitmap.scanline(y), static_cast<size_t>(bitmap.width()) });
     return {};
 }
 
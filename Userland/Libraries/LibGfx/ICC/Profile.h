@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/AtomicRefCounted.h>
 #include <AK/Error.h>
 #include <AK/Format.h>
 #include <AK/HashMap.h>
@@ -168,17 +170,60 @@ struct ProfileHeader {
 // FIXME: This doesn't belong here.
 class MatrixMatrixConversion {
 public:
+    // The destination curves are sampled at this many evenly spaced linear values, and interpolated in between.
+    static constexpr size_t destination_curve_sample_count = 4096;
+
+    // The curves of a conversion, evaluated up front. These only depend on the contents of the two profiles, so they
+    // are shared between all conversions from and to the same profiles, even across threads.
+    struct LookupTables : public AtomicRefCounted<LookupTables> {
+        static ErrorOr<NonnullRefPtr<LookupTables>> create(TagData const& source_red_TRC,
+            TagData const& source_green_TRC,
+            TagData const& source_blue_TRC,
+            TagData const& destination_red_TRC,
+            TagData const& destination_green_TRC,
+            TagData const& destination_blue_TRC);
+
+        // Indexed by the 8-bit channel values.
+        Array<float, 256> source_red;
+        Array<float, 256> source_green;
+        Array<float, 256> source_blue;
+
+        // Already scaled to [0, 255], with one extra sample for interpolating up to 1.
+        Array<float, destination_curve_sample_count + 1> destination_red;
+        Array<float, destination_curve_sample_count + 1> destination_green;
+        Array<float, destination_curve_sample_count + 1> destination_blue;
+    };
+
     MatrixMatrixConversion(LutCurveType source_red_TRC,
         LutCurveType source_green_TRC,
         LutCurveType source_blue_TRC,
         FloatMatrix3x3 matrix,
         LutCurveType destination_red_TRC,
         LutCurveType destination_green_TRC,
-        LutCurveType destination_blue_TRC);
+        LutCurveType destination_blue_TRC,
+        NonnullRefPtr<LookupTables const>);
 
     Color map(FloatVector3) const;
 
+    // Converts pixels in place, keeping their alpha. Much faster than calling map() for each of them.
+    void map_pixels(Span<ARGB32>) const;
+
 private:
+    static float evaluate_curve(TagData const& trc, float f)
+    {
+        if (trc.type() == CurveTagData::Type)
+            return static_cast<CurveTagData const&>(trc).evaluate(f);
+        return static_cast<ParametricCurveTagData const&>(trc).evaluate(f);
+    }
+
+    static u8 evaluate_sampled_curve_inverse(Array<float, destination_curve_sample_count + 1> const& samples, float f)
+    {
+        float position = clamp(f, 0.f, 1.f) * destination_curve_sample_count;
+        size_t index = min(static_cast<size_t>(position), destination_curve_sample_count - 1);
+        float fraction = position - index;
+        return round(samples[index] + (samples[index + 1] - samples[index]) * fraction);
+    }
+
     LutCurveType m_source_red_TRC;
     LutCurveType m_source_green_TRC;
     LutCurveType m_source_blue_TRC;
@@ -186,22 +231,11 @@ private:
     LutCurveType m_destination_red_TRC;
     LutCurveType m_destination_green_TRC;
     LutCurveType m_destination_blue_TRC;
+    NonnullRefPtr<LookupTables const> m_lookup_tables;
 };
 
 inline Color MatrixMatrixConversion::map(FloatVector3 in_rgb) const
 {
-    auto evaluate_curve = [](TagData const& trc, float f) {
-        if (trc.type() == CurveTagData::Type)
-            return static_cast<CurveTagData const&>(trc).evaluate(f);
-        return static_cast<ParametricCurveTagData const&>(trc).evaluate(f);
-    };
-
-    auto evaluate_curve_inverse = [](TagData const& trc, float f) {
-        if (trc.type() == CurveTagData::Type)
-            return static_cast<CurveTagData const&>(trc).evaluate_inverse(f);
-        return static_cast<ParametricCurveTagData const&>(trc).evaluate_inverse(f);
-    };
-
     FloatVector3 linear_rgb = {
         evaluate_curve(m_source_red_TRC, in_rgb[0]),
         evaluate_curve(m_source_green_TRC, in_rgb[1]),
@@ -209,14 +243,9 @@ inline Color MatrixMatrixConversion::map(FloatVector3 in_rgb) const
     };
     linear_rgb = m_matrix * linear_rgb;
 
-    linear_rgb.clamp(0.f, 1.f);
-    float device_r = evaluate_curve_inverse(m_destination_red_TRC, linear_rgb[0]);
-    float device_g = evaluate_curve_inverse(m_destination_green_TRC, linear_rgb[1]);
-    float device_b = evaluate_curve_inverse(m_destination_blue_TRC, linear_rgb[2]);
-
-    u8 out_r = round(255 * device_r);
-    u8 out_g = round(255 * device_g);
-    u8 out_b = round(255 * device_b);
+    u8 out_r = evaluate_sampled_curve_inverse(m_lookup_tables->destination_red, linear_rgb[0]);
+    u8 out_g = evaluate_sampled_curve_inverse(m_lookup_tables->destination_green, linear_rgb[1]);
+    u8 out_b = evaluate_sampled_curve_inverse(m_lookup_tables->destination_blue, linear_rgb[2]);
 
     return Color(out_r, out_g, out_b);
 }
@@ -338,6 +367,11 @@ private:
 
     mutable Optional<FloatMatrix3x3> m_cached_xyz_to_rgb_matrix;
 
+    // The profile's ID, or the ID that it would have if it doesn't have one. Used to share data between profiles with
+    // the same contents.
+    ErrorOr<Crypto::Hash::MD5::DigestType> content_id() const;
+    mutable Optional<Crypto::Hash::MD5::DigestType> m_cached_content_id;
+
     struct OneElementCLUTCache {
         Vector<u8, 4> key;
         FloatVector3 value;
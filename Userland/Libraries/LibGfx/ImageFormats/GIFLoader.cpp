@@ -16,7 +16,6 @@
 #include <AK/Try.h>
 #include <LibCompress/Lzw.h>
 #include <LibGfx/ImageFormats/GIFLoader.h>
-#include <LibGfx/Painter.h>
 #include <string.h>
 
 namespace Gfx {
@@ -113,10 +112,16 @@ static ErrorOr<GIFFormat> decode_gif_header(Stream& stream)
     return Error::from_string_literal("GIF header unknown");
 }
 
-static void copy_frame_buffer(Bitmap& dest, Bitmap const& src)
+static void copy_rect(Bitmap& dest, Bitmap const& src, IntRect const& rect)
 {
-    VERIFY(dest.size_in_bytes() == src.size_in_bytes());
-    memcpy(dest.scanline(0), src.scanline(0), dest.size_in_bytes());
+    VERIFY(dest.size() == src.size());
+
+    auto intersection_rect = rect.intersected(dest.rect());
+    if (intersection_rect.is_empty())
+        return;
+
+    for (int y = intersection_rect.top(); y < intersection_rect.bottom(); ++y)
+        memcpy(dest.scanline(y) + intersection_rect.left(), src.scanline(y) + intersection_rect.left(), intersection_rect.width() * sizeof(ARGB32));
 }
 
 static void clear_rect(Bitmap& bitmap, IntRect const& rect, Color color)
@@ -159,69 +164,79 @@ static ErrorOr<void> decode_frame(GIFLoadingContext& context, size_t frame_index
 
         auto const previous_image_disposal_method = i > 0 ? context.images.at(i - 1)->disposal_method : GIFImageDescriptor::DisposalMethod::None;
 
+        // Every frame only ever changes the pixels inside its own rect, so that is all that disposing of it has to touch.
         if (i == 0) {
-            auto painter = Gfx::Painter::create(*context.frame_buffer);
-            painter->clear_rect(context.frame_buffer->rect().to_type<float>(), Color::Transparent);
-        } else if (i > 0 && image->disposal_method == GIFImageDescriptor::DisposalMethod::RestorePrevious
-            && previous_image_disposal_method != GIFImageDescriptor::DisposalMethod::RestorePrevious) {
-            // This marks the start of a run of frames that once disposed should be restored to the
-            // previous underlying image contents. Therefore we make a copy of the current frame
-            // buffer so that it can be restored later.
-            copy_frame_buffer(*context.prev_frame_buffer, *context.frame_buffer);
-        }
-
-        if (previous_image_disposal_method == GIFImageDescriptor::DisposalMethod::RestoreBackground) {
+            clear_rect(*context.frame_buffer, context.frame_buffer->rect(), Color::Transparent);
+        } else if (previous_image_disposal_method == GIFImageDescriptor::DisposalMethod::RestoreBackground) {
             // Note: RestoreBackground could be interpreted either as restoring the underlying
             // background of the entire image (e.g. container element's background-color), or the
             // background color of the GIF itself. It appears that all major browsers and most other
             // GIF decoders adhere to the former interpretation, therefore we will do the same by
-            // clearing the entire frame buffer to transparent.
+            // clearing the previous frame's rect to transparent.
             clear_rect(*context.frame_buffer, context.images[i - 1]->rect(), Color::Transparent);
-        } else if (i > 0 && previous_image_disposal_method == GIFImageDescriptor::DisposalMethod::RestorePrevious) {
+        } else if (previous_image_disposal_method == GIFImageDescriptor::DisposalMethod::RestorePrevious) {
             // Previous frame indicated that once disposed, it should be restored to *its* previous
-            // underlying image contents, therefore we restore the saved previous frame buffer.
-            copy_frame_buffer(*context.frame_buffer, *context.prev_frame_buffer);
+            // underlying image contents, therefore we restore the part of the frame buffer that we saved.
+            copy_rect(*context.frame_buffer, *context.prev_frame_buffer, context.images[i - 1]->rect());
+        }
+
+        if (image->disposal_method == GIFImageDescriptor::DisposalMethod::RestorePrevious) {
+            // Save the contents that this frame is going to be drawn over, so that they can be restored
+            // once it is disposed.
+            copy_rect(*context.prev_frame_buffer, *context.frame_buffer, image->rect());
         }
 
         if (image->lzw_min_code_size > 8)
             return Error::from_string_literal("LZW minimum code size is greater than 8");
 
-        auto decoded_stream = TRY(Compress::LzwDecompressor<LittleEndianInputBitStream>::decompress_all(image->lzw_encoded_bytes, image->lzw_min_code_size));
+        if (!image->width)
+            continue;
+
+        FixedMemoryStream lzw_stream { image->lzw_encoded_bytes.bytes() };
+        LittleEndianInputBitStream lzw_bit_stream { MaybeOwned<Stream> { lzw_stream } };
+        Compress::LzwDecompressor<LittleEndianInputBitStream> decompressor { MaybeOwned { lzw_bit_stream }, image->lzw_min_code_size };
 
         auto const& color_map = image->use_global_color_map ? context.logical_screen.color_map : image->color_map;
+        auto const visible_rect = image->rect().intersected(context.frame_buffer->rect());
+
+        // The decompressor writes each row of color indices straight into this buffer, and each row is composited
+        // into the frame buffer before the next one is decoded.
+        Vector<u8> row_indices;
+        TRY(row_indices.try_resize(image->width));
 
-        int pixel_index = 0;
         int row = 0;
         int interlace_pass = 0;
 
-        if (!image->width)
-            continue;
+        for (int decoded_rows = 0; decoded_rows < image->height; ++decoded_rows) {
+            auto const decoded_indices = TRY(decompressor.decompress_some(row_indices));
 
-        for (auto const& color : decoded_stream.bytes()) {
-            auto c = color_map[color];
+            int const y = row + image->y;
+            if (y >= visible_rect.top() && y < visible_rect.bottom()) {
+                ARGB32* scanline = context.frame_buffer->scanline(y);
+                int const end_x = min(visible_rect.right(), image->x + static_cast<int>(decoded_indices.size()));
 
-            int x = pixel_index % image->width + image->x;
-            int y = row + image->y;
-
-            if (context.frame_buffer->rect().contains(x, y) && (!image->transparent || color != image->transparency_index)) {
-                context.frame_buffer->set_pixel(x, y, c);
+                for (int x = visible_rect.left(); x < end_x; ++x) {
+                    auto const color = decoded_indices[x - image->x];
+                    if (!image->transparent || color != image->transparency_index)
+                        scanline[x] = color_map[color].value();
+                }
             }
 
-            ++pixel_index;
-            if (pixel_index % image->width == 0) {
-                if (image->interlaced) {
-                    if (interlace_pass < 4) {
-                        if (row + INTERLACE_ROW_STRIDES[interlace_pass] >= image->height) {
-                            ++interlace_pass;
-                            if (interlace_pass < 4)
-                                row = INTERLACE_ROW_OFFSETS[interlace_pass];
-                        } else {
-                            row += INTERLACE_ROW_STRIDES[interlace_pass];
-                        }
+            if (decoded_indices.size() < row_indices.size())
+                break;
+
+            if (image->interlaced) {
+                if (interlace_pass < 4) {
+                    if (row + INTERLACE_ROW_STRIDES[interlace_pass] >= image->height) {
+                        ++interlace_pass;
+                        if (interlace_pass < 4)
+                            row = INTERLACE_ROW_OFFSETS[interlace_pass];
+                    } else {
+                        row += INTERLACE_ROW_STRIDES[interlace_pass];
                     }
-                } else {
-                    ++row;
                 }
+            } else {
+                ++row;
             }
         }
 
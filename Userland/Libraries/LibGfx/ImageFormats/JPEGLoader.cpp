@@ -23,6 +23,9 @@ struct JPEGLoadingContext {
     RefPtr<Gfx::Bitmap> rgb_bitmap;
     RefPtr<Gfx::CMYKBitmap> cmyk_bitmap;
 
+    // The size of the image itself, which is larger than the bitmaps if it was decoded at a reduced scale.
+    IntSize natural_size;
+
     ReadonlyBytes data;
     Vector<u8> icc_data;
 
@@ -31,14 +34,14 @@ struct JPEGLoadingContext {
     {
     }
 
-    ErrorOr<void> decode();
+    ErrorOr<void> decode(Optional<IntSize> ideal_size);
 };
 
 struct JPEGErrorManager : jpeg_error_mgr {
     jmp_buf setjmp_buffer {};
 };
 
-ErrorOr<void> JPEGLoadingContext::decode()
+ErrorOr<void> JPEGLoadingContext::decode(Optional<IntSize> ideal_size)
 {
     struct jpeg_decompress_struct cinfo;
     struct JPEGErrorManager jerr;
@@ -63,7 +66,14 @@ ErrorOr<void> JPEGLoadingContext::decode()
     source_manager.next_input_byte = data.data();
     source_manager.bytes_in_buffer = data.size();
     source_manager.init_source = [](j_decompress_ptr) {};
-    source_manager.fill_input_buffer = [](j_decompress_ptr) -> boolean { return false; };
+    source_manager.fill_input_buffer = [](j_decompress_ptr context) -> boolean {
+        // The data ended before the image did, e.g. because the rest of it hasn't arrived yet. Like libjpeg's own
+        // memory source, pretend the image ends here, so that what has been decoded so far still makes an image.
+        static JOCTET const end_of_image[] = { 0xFF, JPEG_EOI };
+        context->src->next_input_byte = end_of_image;
+        context->src->bytes_in_buffer = sizeof(end_of_image);
+        return TRUE;
+    };
     source_manager.skip_input_data = [](j_decompress_ptr context, long num_bytes) {
         if (num_bytes > static_cast<long>(context->src->bytes_in_buffer)) {
             context->src->bytes_in_buffer = 0;
@@ -89,10 +99,27 @@ ErrorOr<void> JPEGLoadingContext::decode()
         cinfo.out_color_space = JCS_EXT_BGRX;
     }
 
+    natural_size = { static_cast<int>(cinfo.image_width), static_cast<int>(cinfo.image_height) };
+
+    // libjpeg-turbo can scale the image by N/8 as part of the inverse DCT, which is much cheaper than decoding it at
+    // full size and scaling it down afterwards. Pick the smallest such scale that is still at least as large as
+    // the ideal size in both dimensions.
+    if (ideal_size.has_value() && !ideal_size->is_empty()) {
+        for (unsigned numerator = 1; numerator < 8; ++numerator) {
+            if (cinfo.image_width * numerator >= static_cast<unsigned>(ideal_size->width()) * 8
+                && cinfo.image_height * numerator >= static_cast<unsigned>(ideal_size->height()) * 8) {
+                cinfo.scale_num = numerator;
+                cinfo.scale_denom = 8;
+                break;
+            }
+        }
+    }
+
     jpeg_start_decompress(&cinfo);
 
     if (cinfo.out_color_space == JCS_EXT_BGRX) {
-        rgb_bitmap = TRY(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { static_cast<int>(cinfo.output_width), static_cast<int>(cinfo.output_height) }));
+        // Decode straight into shared memory, so the bitmap can be handed to another process without a copy.
+        rgb_bitmap = TRY(Gfx::Bitmap::create_shareable(Gfx::BitmapFormat::BGRx8888, Gfx::AlphaType::Premultiplied, { static_cast<int>(cinfo.output_width), static_cast<int>(cinfo.output_height) }));
         while (cinfo.output_scanline < cinfo.output_height) {
             auto* row_ptr = (u8*)rgb_bitmap->scanline(cinfo.output_scanline);
             jpeg_read_scanlines(&cinfo, &row_ptr, 1);
@@ -137,11 +164,7 @@ IntSize JPEGImageDecoderPlugin::size()
 
     if (m_context->state == JPEGLoadingContext::State::Error)
         return {};
-    if (m_context->rgb_bitmap)
-        return m_context->rgb_bitmap->size();
-    if (m_context->cmyk_bitmap)
-        return m_context->cmyk_bitmap->size();
-    return {};
+    return m_context->natural_size;
 }
 
 bool JPEGImageDecoderPlugin::sniff(ReadonlyBytes data)
@@ -157,7 +180,7 @@ ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create(Readon
     return adopt_own(*new JPEGImageDecoderPlugin(make<JPEGLoadingContext>(data)));
 }
 
-ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index > 0)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
@@ -166,7 +189,7 @@ ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Option
         return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
 
     if (m_context->state < JPEGLoadingContext::State::Decoded) {
-        TRY(m_context->decode());
+        TRY(m_context->decode(ideal_size));
         m_context->state = JPEGLoadingContext::State::Decoded;
     }
 
@@ -4,8 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Endian.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Vector.h>
+#include <LibCompress/Zlib.h>
+#include <LibCrypto/Checksum/CRC32.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/PNGWriter.h>
 #include <png.h>
@@ -19,6 +22,9 @@ struct WriterContext {
 
 ErrorOr<ByteBuffer> PNGWriter::encode(Gfx::Bitmap const& bitmap, Options options)
 {
+    if (options.encode_in_parallel)
+        return encode_in_parallel(bitmap, options);
+
     auto context = make<WriterContext>();
     int width = bitmap.width();
     int height = bitmap.height();
@@ -43,6 +49,11 @@ ErrorOr<ByteBuffer> PNGWriter::encode(Gfx::Bitmap const& bitmap, Options options
         png_set_iCCP(png_ptr, info_ptr, "embedded profile", 0, options.icc_data->data(), options.icc_data->size());
     }
 
+    if (options.compression_level.has_value()) {
+        VERIFY(*options.compression_level >= 0 && *options.compression_level <= 9);
+        png_set_compression_level(png_ptr, *options.compression_level);
+    }
+
     if (bitmap.format() == BitmapFormat::BGRA8888 || bitmap.format() == BitmapFormat::BGRx8888) {
         png_set_bgr(png_ptr);
     }
@@ -66,4 +77,159 @@ ErrorOr<ByteBuffer> PNGWriter::encode(Gfx::Bitmap const& bitmap, Options options
     return context->png_data;
 }
 
+static constexpr Array<u8, 8> png_signature = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+static constexpr size_t bytes_per_pixel = 4;
+
+enum class FilterType : u8 {
+    None,
+    Sub,
+    Up,
+    Average,
+    Paeth,
+};
+
+static ALWAYS_INLINE u8 paeth_predictor(u8 a, u8 b, u8 c)
+{
+    int p = a + b - c;
+    int pa = abs(p - a);
+    int pb = abs(p - b);
+    int pc = abs(p - c);
+    if (pa <= pb && pa <= pc)
+        return a;
+    if (pb <= pc)
+        return b;
+    return c;
+}
+
+// Filters a row into `out` and returns the sum of the filtered bytes as signed values, the usual "minimum sum of
+// absolute differences" estimate of how well the row will compress.
+template<FilterType filter_type>
+static u32 filter_row(ReadonlyBytes row, ReadonlyBytes previous_row, Bytes out)
+{
+    u32 sum = 0;
+    for (size_t i = 0; i < row.size(); ++i) {
+        u8 left = i >= bytes_per_pixel ? row[i - bytes_per_pixel] : 0;
+        u8 up = previous_row[i];
+        u8 upper_left = i >= bytes_per_pixel ? previous_row[i - bytes_per_pixel] : 0;
+
+        u8 predictor = 0;
+        if constexpr (filter_type == FilterType::Sub)
+            predictor = left;
+        else if constexpr (filter_type == FilterType::Up)
+            predictor = up;
+        else if constexpr (filter_type == FilterType::Paeth)
+            predictor = paeth_predictor(left, up, upper_left);
+
+        u8 value = row[i] - predictor;
+        out[i] = value;
+        sum += abs(static_cast<i8>(value));
+    }
+    return sum;
+}
+
+ErrorOr<ByteBuffer> PNGWriter::encode_in_parallel(Gfx::Bitmap const& bitmap, Options const& options)
+{
+    auto width = static_cast<size_t>(bitmap.width());
+    auto height = static_cast<size_t>(bitmap.height());
+    auto row_size = width * bytes_per_pixel;
+    bool swap_red_and_blue = bitmap.format() == BitmapFormat::BGRA8888 || bitmap.format() == BitmapFormat::BGRx8888;
+
+    // Each filtered row is prefixed by its filter type.
+    auto image_data = TRY(ByteBuffer::create_uninitialized(height * (1 + row_size)));
+
+    auto previous_row = TRY(ByteBuffer::create_zeroed(row_size));
+    auto row = TRY(ByteBuffer::create_uninitialized(row_size));
+    auto candidate = TRY(ByteBuffer::create_uninitialized(row_size));
+
+    for (size_t y = 0; y < height; ++y) {
+        auto const* scanline = bitmap.scanline_u8(y);
+        if (swap_red_and_blue) {
+            for (size_t i = 0; i < row_size; i += bytes_per_pixel) {
+                row[i + 0] = scanline[i + 2];
+                row[i + 1] = scanline[i + 1];
+                row[i + 2] = scanline[i + 0];
+                row[i + 3] = scanline[i + 3];
+            }
+        } else {
+            memcpy(row.data(), scanline, row_size);
+        }
+
+        auto* out = image_data.offset_pointer(y * (1 + row_size));
+        Bytes best { out + 1, row_size };
+
+        // UI content is mostly made of flat runs and rows that repeat the one above, which Sub and Up turn into zeros.
+        // Paeth covers gradients and images. Average rarely wins against these and isn't tried.
+        auto best_filter = FilterType::Sub;
+        auto best_sum = filter_row<FilterType::Sub>(row, previous_row, best);
+        auto try_filter = [&]<FilterType filter_type>() {
+            if (best_sum == 0)
+                return;
+            auto sum = filter_row<filter_type>(row, previous_row, candidate);
+            if (sum < best_sum) {
+                best_filter = filter_type;
+                best_sum = sum;
+                candidate.bytes().copy_to(best);
+            }
+        };
+        if (y > 0) {
+            try_filter.template operator()<FilterType::Up>();
+            try_filter.template operator()<FilterType::Paeth>();
+        }
+        try_filter.template operator()<FilterType::None>();
+
+        out[0] = to_underlying(best_filter);
+        swap(row, previous_row);
+    }
+
+    auto compression_level = Compress::ZlibCompressionLevel::Default;
+    if (options.compression_level.has_value()) {
+        VERIFY(*options.compression_level >= 0 && *options.compression_level <= 9);
+        if (*options.compression_level == 0)
+            compression_level = Compress::ZlibCompressionLevel::Fastest;
+        else if (*options.compression_level <= 3)
+            compression_level = Compress::ZlibCompressionLevel::Fast;
+        else if (*options.compression_level >= 7)
+            compression_level = Compress::ZlibCompressionLevel::Best;
+    }
+    auto compressed_image_data = TRY(Compress::ZlibCompressor::compress_all_in_parallel(image_data, compression_level));
+
+    ByteBuffer png_data;
+    auto write_chunk = [&](StringView type, ReadonlyBytes data) -> ErrorOr<void> {
+        BigEndian<u32> length = data.size();
+        TRY(png_data.try_append(&length, sizeof(length)));
+
+        auto type_and_data_offset = png_data.size();
+        TRY(png_data.try_append(type.bytes()));
+        TRY(png_data.try_append(data));
+
+        BigEndian<u32> crc = Crypto::Checksum::CRC32 { png_data.bytes().slice(type_and_data_offset) }.digest();
+        TRY(png_data.try_append(&crc, sizeof(crc)));
+        return {};
+    };
+
+    TRY(png_data.try_append(png_signature.data(), png_signature.size()));
+
+    ByteBuffer header;
+    BigEndian<u32> big_endian_width = width;
+    BigEndian<u32> big_endian_height = height;
+    TRY(header.try_append(&big_endian_width, sizeof(big_endian_width)));
+    TRY(header.try_append(&big_endian_height, sizeof(big_endian_height)));
+    // Bit depth, color type (RGBA), compression method, filter method and interlace method.
+    TRY(header.try_append(to_array<u8>({ 8, 6, 0, 0, 0 }).span()));
+    TRY(write_chunk("IHDR"sv, header));
+
+    if (options.icc_data.has_value()) {
+        ByteBuffer icc_profile;
+        // The profile name, its null terminator and the compression method.
+        TRY(icc_profile.try_append("embedded profile\0\0"sv.bytes()));
+        TRY(icc_profile.try_append(TRY(Compress::ZlibCompressor::compress_all(*options.icc_data))));
+        TRY(write_chunk("iCCP"sv, icc_profile));
+    }
+
+    TRY(write_chunk("IDAT"sv, compressed_image_data));
+    TRY(write_chunk("IEND"sv, {}));
+
+    return png_data;
+}
+
 }
@@ -18,6 +18,15 @@ struct PNGWriterOptions {
     // Data for the iCCP chunk.
     // FIXME: Allow writing cICP, sRGB, or gAMA instead too.
     Optional<ReadonlyBytes> icc_data;
+
+    // The zlib compression level of the image data, from 0 (no compression) to 9 (smallest output). Lower levels are
+    // faster to encode. If empty, libpng's default is used.
+    Optional<int> compression_level;
+
+    // Encodes the image without libpng, choosing a filter for each row with a cheap heuristic and compressing the image
+    // data on multiple threads. This is several times faster for large images such as screenshots, at the cost of a
+    // slightly larger output.
+    bool encode_in_parallel { false };
 };
 
 class PNGWriter {
@@ -28,6 +37,8 @@ public:
 
 private:
     PNGWriter() = default;
+
+    static ErrorOr<ByteBuffer> encode_in_parallel(Gfx::Bitmap const&, Options const&);
 };
 
 }
@@ -150,7 +150,8 @@ static ErrorOr<void> decode_webp_image(WebPLoadingContext& context)
         }
     } else {
         auto bitmap_format = context.has_alpha ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888;
-        auto bitmap = TRY(Bitmap::create(bitmap_format, Gfx::AlphaType::Unpremultiplied, context.size));
+        // Decode straight into shared memory, so the bitmap can be handed to another process without a copy.
+        auto bitmap = TRY(Bitmap::create_shareable(bitmap_format, Gfx::AlphaType::Unpremultiplied, context.size));
 
         auto image_data = WebPDecodeBGRAInto(context.data.data(), context.data.size(), bitmap->scanline_u8(0), bitmap->data_size(), bitmap->pitch());
         if (image_data == nullptr)
@@ -4,12 +4,36 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#define AK_DONT_REPLACE_STD
+
 #include <LibGfx/ImmutableBitmap.h>
 
+#include <core/SkImage.h>
+#include <core/SkPixmap.h>
+
 namespace Gfx {
 
 static size_t s_next_immutable_bitmap_id = 0;
 
+static SkColorType to_skia_color_type(Gfx::BitmapFormat format)
+{
+    switch (format) {
+    case Gfx::BitmapFormat::Invalid:
+        return kUnknown_SkColorType;
+    case Gfx::BitmapFormat::BGRA8888:
+    case Gfx::BitmapFormat::BGRx8888:
+        return kBGRA_8888_SkColorType;
+    case Gfx::BitmapFormat::RGBA8888:
+        return kRGBA_8888_SkColorType;
+    default:
+        return kUnknown_SkColorType;
+    }
+}
+
+struct ImmutableBitmap::Impl {
+    sk_sp<SkImage> sk_image;
+};
+
 NonnullRefPtr<ImmutableBitmap> ImmutableBitmap::create(NonnullRefPtr<Bitmap> bitmap)
 {
     return adopt_ref(*new ImmutableBitmap(move(bitmap)));
@@ -18,7 +42,21 @@ NonnullRefPtr<ImmutableBitmap> ImmutableBitmap::create(NonnullRefPtr<Bitmap> bit
 ImmutableBitmap::ImmutableBitmap(NonnullRefPtr<Bitmap> bitmap)
     : m_bitmap(move(bitmap))
     , m_id(s_next_immutable_bitmap_id++)
+    , m_impl(adopt_own(*new Impl))
+{
+    auto alpha_type = m_bitmap->alpha_type() == AlphaType::Premultiplied ? kPremul_SkAlphaType : kUnpremul_SkAlphaType;
+    auto info = SkImageInfo::Make(m_bitmap->width(), m_bitmap->height(), to_skia_color_type(m_bitmap->format()), alpha_type);
+    SkPixmap pixmap(info, m_bitmap->begin(), m_bitmap->pitch());
+
+    // NOTE: The pixels are not copied, which is fine as the bitmap is never changed and outlives the image.
+    m_impl->sk_image = SkImages::RasterFromPixmap(pixmap, nullptr, nullptr);
+}
+
+ImmutableBitmap::~ImmutableBitmap() = default;
+
+SkImage const* ImmutableBitmap::sk_image() const
 {
+    return m_impl->sk_image.get();
 }
 
 }
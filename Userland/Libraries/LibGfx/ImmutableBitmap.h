@@ -7,21 +7,28 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/RefCounted.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Forward.h>
 #include <LibGfx/Rect.h>
 
+class SkImage;
+
 namespace Gfx {
 
 class ImmutableBitmap final : public RefCounted<ImmutableBitmap> {
 public:
     static NonnullRefPtr<ImmutableBitmap> create(NonnullRefPtr<Bitmap> bitmap);
 
-    ~ImmutableBitmap() = default;
+    ~ImmutableBitmap();
 
     Bitmap const& bitmap() const { return *m_bitmap; }
 
+    // The pixels wrapped in an SkImage that lives as long as this bitmap. GPU backends key the textures they upload
+    // images to on the SkImage, so drawing this one instead of a fresh wrapper lets them skip the upload next frame.
+    SkImage const* sk_image() const;
+
     size_t width() const { return m_bitmap->width(); }
     size_t height() const { return m_bitmap->height(); }
 
@@ -34,6 +41,9 @@ private:
     NonnullRefPtr<Bitmap> m_bitmap;
     size_t m_id;
 
+    struct Impl;
+    NonnullOwnPtr<Impl> m_impl;
+
     explicit ImmutableBitmap(NonnullRefPtr<Bitmap> bitmap);
 };
 
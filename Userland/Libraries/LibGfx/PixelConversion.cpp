@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/SIMDMath.h>
+#include <LibGfx/PixelConversion.h>
+
+namespace Gfx {
+
+// Loaded as little-endian u32s, BGRA8888 pixels are 0xAARRGGBB and RGBA8888 pixels are 0xAABBGGRR, so going from one to
+// the other means swapping the lowest and the third byte. These work on vectors too.
+template<typename T>
+ALWAYS_INLINE static T swap_red_and_blue(T pixel)
+{
+    return (pixel & 0xff00ff00) | ((pixel >> 16) & 0xff) | ((pixel & 0xff) << 16);
+}
+
+// Exact for c, a <= 255.
+template<typename T>
+ALWAYS_INLINE static T premultiply(T channel, T alpha)
+{
+    auto x = channel * alpha + 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// Rounds c * 255 / a to the nearest value as floor((510 * c + a) / (2 * a)). Numerator and denominator are integers that
+// floats hold exactly, and a correctly rounded division never crosses an integer the exact quotient doesn't reach, so
+// the vector version below (which divides floats) gives the same results.
+ALWAYS_INLINE static u32 unpremultiply(u32 channel, u32 alpha)
+{
+    return min((510 * channel + alpha) / (2 * alpha), 255u);
+}
+
+void convert_bgra_premultiplied_to_rgba_unpremultiplied(ReadonlySpan<u32> source, Span<u32> destination)
+{
+    using namespace AK::SIMD;
+    VERIFY(source.size() == destination.size());
+
+    size_t x = 0;
+    for (; x + 4 <= source.size(); x += 4) {
+        auto pixels = load_unaligned<u32x4>(source.data() + x);
+        auto alpha = pixels >> 24;
+
+        // Opaque pixels are the most common ones by far, and only need their channels swapped.
+        if (all(alpha == 255)) {
+            store_unaligned(destination.data() + x, swap_red_and_blue(pixels));
+            continue;
+        }
+
+        // NOTE: Dividing by the alpha of transparent pixels is avoided by dividing by 2 instead, and their result dropped.
+        auto is_transparent = static_cast<u32x4>(alpha == 0);
+        auto numerator_alpha = to_f32x4(alpha);
+        auto denominator = to_f32x4((alpha | (is_transparent & 1)) * 2);
+        auto unpremultiply_channel = [&](u32x4 channel) {
+            return to_u32x4(clamp((to_f32x4(channel) * 510.0f + numerator_alpha) / denominator, 0.0f, 255.0f));
+        };
+        auto red = unpremultiply_channel((pixels >> 16) & 0xff);
+        auto green = unpremultiply_channel((pixels >> 8) & 0xff);
+        auto blue = unpremultiply_channel(pixels & 0xff);
+        store_unaligned(destination.data() + x, ((alpha << 24) | (blue << 16) | (green << 8) | red) & ~is_transparent);
+    }
+
+    for (; x < source.size(); ++x) {
+        auto pixel = source[x];
+        u32 alpha = pixel >> 24;
+        if (alpha == 255) {
+            destination[x] = swap_red_and_blue(pixel);
+        } else if (alpha == 0) {
+            destination[x] = 0;
+        } else {
+            auto red = unpremultiply((pixel >> 16) & 0xff, alpha);
+            auto green = unpremultiply((pixel >> 8) & 0xff, alpha);
+            auto blue = unpremultiply(pixel & 0xff, alpha);
+            destination[x] = (alpha << 24) | (blue << 16) | (green << 8) | red;
+        }
+    }
+}
+
+void convert_rgba_unpremultiplied_to_bgra_premultiplied(ReadonlySpan<u32> source, Span<u32> destination)
+{
+    using namespace AK::SIMD;
+    VERIFY(source.size() == destination.size());
+
+    size_t x = 0;
+    for (; x + 4 <= source.size(); x += 4) {
+        auto pixels = load_unaligned<u32x4>(source.data() + x);
+        auto alpha = pixels >> 24;
+
+        if (all(alpha == 255)) {
+            store_unaligned(destination.data() + x, swap_red_and_blue(pixels));
+            continue;
+        }
+
+        auto red = premultiply(pixels & 0xff, alpha);
+        auto green = premultiply((pixels >> 8) & 0xff, alpha);
+        auto blue = premultiply((pixels >> 16) & 0xff, alpha);
+        store_unaligned(destination.data() + x, (alpha << 24) | (red << 16) | (green << 8) | blue);
+    }
+
+    for (; x < source.size(); ++x) {
+        auto pixel = source[x];
+        u32 alpha = pixel >> 24;
+        if (alpha == 255) {
+            destination[x] = swap_red_and_blue(pixel);
+        } else {
+            auto red = premultiply(pixel & 0xff, alpha);
+            auto green = premultiply((pixel >> 8) & 0xff, alpha);
+            auto blue = premultiply((pixel >> 16) & 0xff, alpha);
+            destination[x] = (alpha << 24) | (red << 16) | (green << 8) | blue;
+        }
+    }
+}
+
+}
@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+#include <AK/Types.h>
+
+namespace Gfx {
+
+// Conversions between the pixels that canvases draw into (BGRA8888, premultiplied alpha) and the ones that ImageData
+// hands to scripts (RGBA8888, unpremultiplied alpha), a scanline at a time. Both spans have to be the same size.
+// Results are rounded to the nearest value. Pixels with an alpha of zero come out as transparent black.
+void convert_bgra_premultiplied_to_rgba_unpremultiplied(ReadonlySpan<u32> source, Span<u32> destination);
+void convert_rgba_unpremultiplied_to_bgra_premultiplied(ReadonlySpan<u32> source, Span<u32> destination);
+
+}
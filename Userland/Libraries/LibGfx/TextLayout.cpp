@@ -6,37 +6,163 @@
  */
 
 #include "TextLayout.h"
+#include <AK/HashTable.h>
+#include <AK/IntrusiveList.h>
 #include <AK/TypeCasts.h>
 #include <LibGfx/Font/ScaledFont.h>
 #include <harfbuzz/hb.h>
 
 namespace Gfx {
 
-RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, Utf8View string, Gfx::Font const& font, GlyphRun::TextType text_type)
+// NOTE: We shape with no user features, so the font and the text fully determine the shaping result.
+//       This lets us cache shaped runs across layouts and measurement passes, which see the same words over and over.
+static constexpr size_t text_shaping_cache_max_run_count = 16384;
+static constexpr size_t text_shaping_cache_max_glyph_count = 256 * KiB;
+static constexpr size_t text_shaping_cache_max_text_length = 1 * KiB;
+
+struct ShapedGlyph {
+    u32 glyph_id { 0 };
+    hb_position_t x_offset { 0 };
+    hb_position_t y_offset { 0 };
+    hb_position_t x_advance { 0 };
+    hb_position_t y_advance { 0 };
+};
+
+struct ShapedText {
+    ShapedText(Font const& font, StringView text, unsigned hash, Vector<ShapedGlyph> glyphs)
+        : font(font)
+        , text(text)
+        , hash(hash)
+        , glyphs(move(glyphs))
+    {
+    }
+
+    // NOTE: Holding a reference to the font ensures that no other font can reuse its address while we're cached.
+    NonnullRefPtr<Font const> font;
+    ByteString text;
+    unsigned hash { 0 };
+    Vector<ShapedGlyph> glyphs;
+
+    IntrusiveListNode<ShapedText> list_node;
+    using List = IntrusiveList<&ShapedText::list_node>;
+};
+
+struct ShapedTextTraits : public DefaultTraits<NonnullOwnPtr<ShapedText>> {
+    static unsigned hash(NonnullOwnPtr<ShapedText> const& shaped_text) { return shaped_text->hash; }
+    static bool equals(NonnullOwnPtr<ShapedText> const& a, NonnullOwnPtr<ShapedText> const& b)
+    {
+        return a->font.ptr() == b->font.ptr() && a->text == b->text;
+    }
+};
+
+struct TextShapingCache {
+    HashTable<NonnullOwnPtr<ShapedText>, ShapedTextTraits> runs;
+    // Most recently used first.
+    ShapedText::List lru_list;
+    size_t glyph_count { 0 };
+    TextShapingCacheStatistics statistics;
+};
+
+static TextShapingCache& text_shaping_cache()
+{
+    static auto& cache = *new TextShapingCache;
+    return cache;
+}
+
+static Vector<ShapedGlyph> shape_text_with_harfbuzz(Utf8View string, Gfx::Font const& font)
 {
     hb_buffer_t* buffer = hb_buffer_create();
     ScopeGuard destroy_buffer = [&]() { hb_buffer_destroy(buffer); };
     hb_buffer_add_utf8(buffer, reinterpret_cast<char const*>(string.bytes()), string.byte_length(), 0, -1);
     hb_buffer_guess_segment_properties(buffer);
 
-    u32 glyph_count;
-    auto* glyph_info = hb_buffer_get_glyph_infos(buffer, &glyph_count);
-    Vector<hb_glyph_info_t> const input_glyph_info({ glyph_info, glyph_count });
-
     auto* hb_font = font.harfbuzz_font();
     hb_shape(hb_font, buffer, nullptr, 0);
 
-    glyph_info = hb_buffer_get_glyph_infos(buffer, &glyph_count);
+    u32 glyph_count;
+    auto* glyph_info = hb_buffer_get_glyph_infos(buffer, &glyph_count);
     auto* positions = hb_buffer_get_glyph_positions(buffer, &glyph_count);
 
+    Vector<ShapedGlyph> glyphs;
+    glyphs.ensure_capacity(glyph_count);
+    for (size_t i = 0; i < glyph_count; ++i)
+        glyphs.unchecked_append({ glyph_info[i].codepoint, positions[i].x_offset, positions[i].y_offset, positions[i].x_advance, positions[i].y_advance });
+    return glyphs;
+}
+
+static void evict_least_recently_used_shaped_text(TextShapingCache& cache)
+{
+    auto* shaped_text = cache.lru_list.last();
+    VERIFY(shaped_text);
+    cache.lru_list.remove(*shaped_text);
+    cache.glyph_count -= shaped_text->glyphs.size();
+    ++cache.statistics.evictions;
+
+    auto it = cache.runs.find(shaped_text->hash, [&](auto& entry) { return entry.ptr() == shaped_text; });
+    VERIFY(it != cache.runs.end());
+    cache.runs.remove(it);
+}
+
+static ReadonlySpan<ShapedGlyph> shaped_glyphs_for(Utf8View string, Gfx::Font const& font, Vector<ShapedGlyph>& uncached_glyphs)
+{
+    if (string.byte_length() > text_shaping_cache_max_text_length) {
+        uncached_glyphs = shape_text_with_harfbuzz(string, font);
+        return uncached_glyphs;
+    }
+
+    auto& cache = text_shaping_cache();
+    auto text = string.as_string();
+    auto hash = pair_int_hash(ptr_hash(&font), text.hash());
+
+    auto it = cache.runs.find(hash, [&](auto& entry) { return entry->font.ptr() == &font && entry->text == text; });
+    if (it != cache.runs.end()) {
+        ++cache.statistics.hits;
+        cache.lru_list.prepend(**it);
+        return (*it)->glyphs;
+    }
+    ++cache.statistics.misses;
+
+    auto shaped_text = make<ShapedText>(font, text, hash, shape_text_with_harfbuzz(string, font));
+    if (shaped_text->glyphs.size() > text_shaping_cache_max_glyph_count) {
+        uncached_glyphs = move(shaped_text->glyphs);
+        return uncached_glyphs;
+    }
+
+    while (!cache.lru_list.is_empty()
+        && (cache.runs.size() >= text_shaping_cache_max_run_count || cache.glyph_count + shaped_text->glyphs.size() > text_shaping_cache_max_glyph_count)) {
+        evict_least_recently_used_shaped_text(cache);
+    }
+
+    auto& shaped_text_ref = *shaped_text;
+    cache.glyph_count += shaped_text_ref.glyphs.size();
+    cache.lru_list.prepend(shaped_text_ref);
+    cache.runs.set(move(shaped_text));
+    return shaped_text_ref.glyphs;
+}
+
+TextShapingCacheStatistics text_shaping_cache_statistics()
+{
+    auto const& cache = text_shaping_cache();
+    auto statistics = cache.statistics;
+    statistics.run_count = cache.runs.size();
+    statistics.glyph_count = cache.glyph_count;
+    return statistics;
+}
+
+RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, Utf8View string, Gfx::Font const& font, GlyphRun::TextType text_type)
+{
+    Vector<ShapedGlyph> uncached_glyphs;
+    auto shaped_glyphs = shaped_glyphs_for(string, font, uncached_glyphs);
+
     Vector<Gfx::DrawGlyph> glyph_run;
+    glyph_run.ensure_capacity(shaped_glyphs.size());
     FloatPoint point = baseline_start;
-    for (size_t i = 0; i < glyph_count; ++i) {
+    for (auto const& glyph : shaped_glyphs) {
         auto position = point
             - FloatPoint { 0, font.pixel_metrics().ascent }
-            + FloatPoint { positions[i].x_offset, positions[i].y_offset } / text_shaping_resolution;
-        glyph_run.append({ position, glyph_info[i].codepoint });
-        point += FloatPoint { positions[i].x_advance, positions[i].y_advance } / text_shaping_resolution;
+            + FloatPoint { glyph.x_offset, glyph.y_offset } / text_shaping_resolution;
+        glyph_run.unchecked_append({ position, glyph.glyph_id });
+        point += FloatPoint { glyph.x_advance, glyph.y_advance } / text_shaping_resolution;
     }
 
     return adopt_ref(*new Gfx::GlyphRun(move(glyph_run), font, text_type, point.x()));
@@ -48,4 +174,16 @@ float measure_text_width(Utf8View const& string, Gfx::Font const& font)
     return glyph_run->width();
 }
 
+NonnullRefPtr<GlyphRun> GlyphRun::merged_with(GlyphRun const& other, FloatPoint other_glyphs_delta) const
+{
+    Vector<DrawGlyph> glyphs;
+    glyphs.ensure_capacity(m_glyphs.size() + other.m_glyphs.size());
+    glyphs.extend(m_glyphs);
+    for (auto glyph : other.m_glyphs) {
+        glyph.translate_by(other_glyphs_delta);
+        glyphs.unchecked_append(glyph);
+    }
+    return adopt_ref(*new GlyphRun(move(glyphs), m_font, m_text_type, m_width + other.m_width));
+}
+
 }
@@ -10,6 +10,7 @@
 #include <AK/ByteString.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Forward.h>
+#include <AK/OwnPtr.h>
 #include <AK/Utf32View.h>
 #include <AK/Utf8View.h>
 #include <AK/Vector.h>
@@ -18,6 +19,8 @@
 #include <LibGfx/Forward.h>
 #include <LibGfx/Rect.h>
 
+class SkTextBlob;
+
 namespace Gfx {
 
 struct DrawGlyph {
@@ -48,6 +51,8 @@ public:
     {
     }
 
+    ~GlyphRun();
+
     [[nodiscard]] Font const& font() const { return m_font; }
     [[nodiscard]] TextType text_type() const { return m_text_type; }
     [[nodiscard]] Vector<DrawGlyph> const& glyphs() const { return m_glyphs; }
@@ -57,13 +62,36 @@ public:
 
     void append(DrawGlyph glyph) { m_glyphs.append(glyph); }
 
+    // The glyphs as a text blob to be drawn at the baseline start, scaled by the given factor. The blob is kept around
+    // for as long as the run is drawn at the same scale. GPU backends cache where the glyphs of a blob are in their glyph
+    // atlas on the blob, so drawing the same one each frame lets them skip looking the glyphs up again.
+    // Returns nullptr for runs without glyphs.
+    // NOTE: This isn't thread-safe. A run is only ever painted by the rendering thread of its page.
+    SkTextBlob const* sk_text_blob(float scale) const;
+
+    // Returns a new run with the glyphs of this run followed by those of the other one, offset by the given delta.
+    [[nodiscard]] NonnullRefPtr<GlyphRun> merged_with(GlyphRun const& other, FloatPoint other_glyphs_delta) const;
+
 private:
     Vector<DrawGlyph> m_glyphs;
     NonnullRefPtr<Font> m_font;
     TextType m_text_type;
     float m_width { 0 };
+
+    struct TextBlob;
+    mutable OwnPtr<TextBlob> m_text_blob;
+};
+
+struct TextShapingCacheStatistics {
+    size_t hits { 0 };
+    size_t misses { 0 };
+    size_t evictions { 0 };
+    size_t run_count { 0 };
+    size_t glyph_count { 0 };
 };
 
+TextShapingCacheStatistics text_shaping_cache_statistics();
+
 RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, Utf8View string, Gfx::Font const& font, GlyphRun::TextType);
 float measure_text_width(Utf8View const& string, Gfx::Font const& font);
 
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#define AK_DONT_REPLACE_STD
+
+#include <LibGfx/Font/ScaledFont.h>
+#include <LibGfx/TextLayout.h>
+
+#include <core/SkFont.h>
+#include <core/SkTextBlob.h>
+
+namespace Gfx {
+
+struct GlyphRun::TextBlob {
+    sk_sp<SkTextBlob> blob;
+    float scale { 0 };
+};
+
+GlyphRun::~GlyphRun() = default;
+
+SkTextBlob const* GlyphRun::sk_text_blob(float scale) const
+{
+    if (m_text_blob && m_text_blob->scale == scale)
+        return m_text_blob->blob.get();
+
+    auto const& font = static_cast<ScaledFont const&>(*m_font);
+    auto sk_font = font.skia_font(scale);
+    auto font_ascent = font.pixel_metrics().ascent;
+
+    SkTextBlobBuilder builder;
+    auto const& buffer = builder.allocRunPos(sk_font, static_cast<int>(m_glyphs.size()));
+    for (size_t i = 0; i < m_glyphs.size(); ++i) {
+        auto const& glyph = m_glyphs[i];
+        buffer.glyphs[i] = glyph.glyph_id;
+        buffer.points()[i] = SkPoint::Make(glyph.position.x() * scale, (glyph.position.y() + font_ascent) * scale);
+    }
+
+    if (!m_text_blob)
+        m_text_blob = make<TextBlob>();
+    m_text_blob->blob = builder.make();
+    m_text_blob->scale = scale;
+    return m_text_blob->blob.get();
+}
+
+}
@@ -8,6 +8,7 @@
 #include <AK/Vector.h>
 #include <LibCore/Socket.h>
 #include <LibCore/Timer.h>
+#include <LibCore/Tracing.h>
 #include <LibIPC/Connection.h>
 #include <LibIPC/Message.h>
 #include <LibIPC/Stub.h>
@@ -43,13 +44,32 @@ ConnectionBase::ConnectionBase(IPC::Stub& local_stub, NonnullOwnPtr<Core::LocalS
                 break;
             }
 
-            auto message = queue->messages.take_first();
+            // Take everything that has piled up while we were busy sending, so it goes out in as few writes as possible.
+            Vector<MessageBuffer> batch;
+            size_t batch_size = 0;
+            size_t batch_fds = 0;
+            while (!queue->messages.is_empty()) {
+                auto const& next = queue->messages.first();
+                if (!batch.is_empty()) {
+                    if (batch_size + next.data_size() > max_message_batch_size)
+                        break;
+                    if (batch_fds + next.file_descriptor_count() > max_message_batch_file_descriptors)
+                        break;
+                }
+                batch_size += next.data_size();
+                batch_fds += next.file_descriptor_count();
+                batch.append(queue->messages.take_first());
+            }
             queue->mutex.unlock();
 
-            if (auto result = message.transfer_message(*m_socket); result.is_error()) {
+            if (auto result = MessageBuffer::transfer_messages(batch, *m_socket); result.is_error()) {
                 dbgln("ConnectionBase::send_thread: {}", result.error());
                 continue;
             }
+
+            queue->messages_sent += batch.size();
+            queue->bytes_sent += batch_size;
+            ++queue->batches_sent;
         }
         return 0;
     });
@@ -73,7 +93,26 @@ bool ConnectionBase::is_open() const
 
 ErrorOr<void> ConnectionBase::post_message(Message const& message)
 {
-    return post_message(TRY(message.encode()));
+    Optional<MonotonicTime> trace_start;
+    if (Core::Tracing::is_enabled(Core::Tracing::Category::IPC))
+        trace_start = MonotonicTime::now();
+
+    auto buffer = TRY(message.encode());
+    if (auto key = message.coalescing_key(); key.has_value())
+        buffer.set_coalescing_key({ message.endpoint_magic(), message.message_id(), *key });
+
+    if (trace_start.has_value()) {
+        auto flow_id = Core::Tracing::next_flow_id();
+        TRY(buffer.append_trace_flow_id(flow_id));
+        Core::Tracing::add_event(Core::Tracing::Category::IPC, StringView { message.message_name(), strlen(message.message_name()) }, *trace_start, MonotonicTime::now(), {}, flow_id, Core::Tracing::Flow::Out);
+    }
+
+    return post_message(move(buffer));
+}
+
+static void add_received_message_trace_event(Message const& message, MonotonicTime start)
+{
+    Core::Tracing::add_event(Core::Tracing::Category::IPC, StringView { message.message_name(), strlen(message.message_name()) }, start, MonotonicTime::now(), {}, message.trace_flow_id(), Core::Tracing::Flow::In);
 }
 
 ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
@@ -85,7 +124,18 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
 
     {
         Threading::MutexLocker locker(m_send_queue->mutex);
-        m_send_queue->messages.append(move(buffer));
+
+        // Only the message queued last may be replaced, so that coalescing never reorders messages. Messages carrying
+        // file descriptors are left alone, as the peer may be expecting to receive every one of those.
+        auto& messages = m_send_queue->messages;
+        if (buffer.coalescing_key().has_value() && buffer.file_descriptor_count() == 0 && !messages.is_empty()
+            && messages.last().coalescing_key() == buffer.coalescing_key() && messages.last().file_descriptor_count() == 0) {
+            messages.last() = move(buffer);
+            ++m_send_queue->messages_coalesced;
+        } else {
+            messages.append(move(buffer));
+        }
+
         m_send_queue->condition.signal();
     }
 
@@ -93,6 +143,20 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
     return {};
 }
 
+ConnectionBase::Statistics ConnectionBase::statistics() const
+{
+    Statistics statistics;
+    statistics.messages_sent = m_send_queue->messages_sent.load();
+    statistics.bytes_sent = m_send_queue->bytes_sent.load();
+    statistics.batches_sent = m_send_queue->batches_sent.load();
+    statistics.messages_received = m_messages_received;
+    statistics.bytes_received = m_bytes_received;
+
+    Threading::MutexLocker locker(m_send_queue->mutex);
+    statistics.messages_coalesced = m_send_queue->messages_coalesced;
+    return statistics;
+}
+
 void ConnectionBase::shutdown()
 {
     m_socket->close();
@@ -110,7 +174,14 @@ void ConnectionBase::handle_messages()
     auto messages = move(m_unprocessed_messages);
     for (auto& message : messages) {
         if (message->endpoint_magic() == m_local_endpoint_magic) {
+            Optional<MonotonicTime> trace_start;
+            if (message->trace_flow_id() != 0 && Core::Tracing::is_enabled(Core::Tracing::Category::IPC))
+                trace_start = MonotonicTime::now();
+
             auto handler_result = m_local_stub.handle(*message);
+            if (trace_start.has_value())
+                add_received_message_trace_event(*message, *trace_start);
+
             if (handler_result.is_error()) {
                 dbgln("IPC::ConnectionBase::handle_messages: {}", handler_result.error());
                 continue;
@@ -232,8 +303,11 @@ OwnPtr<IPC::Message> ConnectionBase::wait_for_specific_endpoint_message_impl(u32
             auto& message = m_unprocessed_messages[i];
             if (message->endpoint_magic() != endpoint_magic)
                 continue;
-            if (message->message_id() == message_id)
-                return m_unprocessed_messages.take(i);
+            if (message->message_id() != message_id)
+                continue;
+            if (message->trace_flow_id() != 0 && Core::Tracing::is_enabled(Core::Tracing::Category::IPC))
+                add_received_message_trace_event(*message, MonotonicTime::now());
+            return m_unprocessed_messages.take(i);
         }
 
         if (!m_socket->is_open())
@@ -251,12 +325,28 @@ void ConnectionBase::try_parse_messages(Vector<u8> const& bytes, size_t& index)
     u32 message_size = 0;
     for (; index + sizeof(message_size) < bytes.size(); index += message_size) {
         memcpy(&message_size, bytes.data() + index, sizeof(message_size));
+        auto has_trace_flow_id = (message_size & message_has_trace_flow_id) != 0;
+        message_size &= ~message_has_trace_flow_id;
         if (message_size == 0 || bytes.size() - index - sizeof(uint32_t) < message_size)
             break;
         index += sizeof(message_size);
-        auto remaining_bytes = ReadonlyBytes { bytes.data() + index, message_size };
+
+        auto payload_size = message_size;
+        u64 trace_flow_id = 0;
+        if (has_trace_flow_id) {
+            if (payload_size < sizeof(trace_flow_id)) {
+                dbgln("Failed to parse IPC message: Too small to hold a trace flow ID");
+                break;
+            }
+            payload_size -= sizeof(trace_flow_id);
+            memcpy(&trace_flow_id, bytes.data() + index + payload_size, sizeof(trace_flow_id));
+        }
+        auto remaining_bytes = ReadonlyBytes { bytes.data() + index, payload_size };
 
         if (auto message = try_parse_message(remaining_bytes, m_unprocessed_fds)) {
+            message->set_trace_flow_id(trace_flow_id);
+            ++m_messages_received;
+            m_bytes_received += sizeof(message_size) + message_size;
             m_unprocessed_messages.append(message.release_nonnull());
             continue;
         }
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Forward.h>
 #include <AK/Queue.h>
 #include <LibCore/EventReceiver.h>
@@ -32,6 +33,16 @@ public:
 
     Core::LocalSocket& socket() { return *m_socket; }
 
+    struct Statistics {
+        u64 messages_sent { 0 };
+        u64 bytes_sent { 0 };
+        u64 batches_sent { 0 };
+        u64 messages_coalesced { 0 };
+        u64 messages_received { 0 };
+        u64 bytes_received { 0 };
+    };
+    Statistics statistics() const;
+
 protected:
     explicit ConnectionBase(IPC::Stub&, NonnullOwnPtr<Core::LocalSocket>, u32 local_endpoint_magic);
 
@@ -66,10 +77,18 @@ protected:
         Threading::Mutex mutex;
         Threading::ConditionVariable condition { mutex };
         bool running { true };
+
+        u64 messages_coalesced { 0 };
+        Atomic<u64> messages_sent { 0 };
+        Atomic<u64> bytes_sent { 0 };
+        Atomic<u64> batches_sent { 0 };
     };
 
     RefPtr<Threading::Thread> m_send_thread;
     RefPtr<SendQueue> m_send_queue;
+
+    u64 m_messages_received { 0 };
+    u64 m_bytes_received { 0 };
 };
 
 template<typename LocalEndpoint, typename PeerEndpoint>
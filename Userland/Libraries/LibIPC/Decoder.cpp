@@ -9,8 +9,10 @@
 #include <AK/NumericLimits.h>
 #include <LibCore/AnonymousBuffer.h>
 #include <LibCore/DateTime.h>
+#include <LibCore/MappedFile.h>
 #include <LibCore/Proxy.h>
 #include <LibCore/Socket.h>
+#include <LibCore/System.h>
 #include <LibIPC/Decoder.h>
 #include <LibIPC/File.h>
 #include <LibURL/URL.h>
@@ -23,11 +25,49 @@ ErrorOr<size_t> Decoder::decode_size()
     return static_cast<size_t>(TRY(decode<u32>()));
 }
 
+ErrorOr<void> Decoder::decode_payload_into(Bytes bytes)
+{
+    if (bytes.size() < out_of_line_payload_threshold)
+        return decode_into(bytes);
+
+    auto payload = TRY(decode_out_of_line_payload(bytes.size()));
+    __builtin_memcpy(bytes.data(), payload->data(), bytes.size());
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<Core::MappedFile>> Decoder::decode_out_of_line_payload(size_t size)
+{
+    VERIFY(size >= out_of_line_payload_threshold);
+
+    auto file = TRY(decode<IPC::File>());
+
+#ifdef F_GET_SEALS
+    // Without these seals, the peer could still shrink the file after our size check, which would turn our next access
+    // past its new end into a crash.
+    auto seals = TRY(Core::System::fcntl(file.fd(), F_GET_SEALS));
+    if ((seals & (F_SEAL_SHRINK | F_SEAL_WRITE)) != (F_SEAL_SHRINK | F_SEAL_WRITE))
+        return Error::from_string_literal("IPC: Out-of-line payload is not sealed");
+#endif
+
+    // Mapping more than the peer actually gave us would turn the first access past its end into a crash.
+    auto stat = TRY(Core::System::fstat(file.fd()));
+    if (stat.st_size < 0 || static_cast<u64>(stat.st_size) < size)
+        return Error::from_string_literal("IPC: Out-of-line payload is smaller than its declared size");
+
+    return Core::MappedFile::map_from_fd_and_close(file.take_fd(), {});
+}
+
 template<>
 ErrorOr<String> decode(Decoder& decoder)
 {
     auto length = TRY(decoder.decode_size());
-    return String::from_stream(decoder.stream(), length);
+    if (length < out_of_line_payload_threshold)
+        return String::from_stream(decoder.stream(), length);
+
+    // NOTE: The payload is validated after it has been copied into the string, as the peer may still be able to change
+    //       the shared memory it's in.
+    auto payload = TRY(decoder.decode_out_of_line_payload(length));
+    return String::from_stream(*payload, length);
 }
 
 template<>
@@ -38,7 +78,7 @@ ErrorOr<ByteString> decode(Decoder& decoder)
         return ByteString::empty();
 
     return ByteString::create_and_overwrite(length, [&](Bytes bytes) -> ErrorOr<void> {
-        TRY(decoder.decode_into(bytes));
+        TRY(decoder.decode_payload_into(bytes));
         return {};
     });
 }
@@ -51,9 +91,7 @@ ErrorOr<ByteBuffer> decode(Decoder& decoder)
         return ByteBuffer {};
 
     auto buffer = TRY(ByteBuffer::create_uninitialized(length));
-    auto bytes = buffer.bytes();
-
-    TRY(decoder.decode_into(bytes));
+    TRY(decoder.decode_payload_into(buffer.bytes()));
     return buffer;
 }
 
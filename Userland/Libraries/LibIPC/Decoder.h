@@ -58,6 +58,10 @@ public:
         return {};
     }
 
+    // Reads the bytes of a string or buffer written by Encoder::append_payload().
+    ErrorOr<void> decode_payload_into(Bytes);
+    ErrorOr<NonnullOwnPtr<Core::MappedFile>> decode_out_of_line_payload(size_t size);
+
     ErrorOr<size_t> decode_size();
 
     Stream& stream() { return m_stream; }
@@ -21,6 +21,7 @@
 #include <LibIPC/Encoder.h>
 #include <LibIPC/File.h>
 #include <LibURL/URL.h>
+#include <fcntl.h>
 
 namespace IPC {
 
@@ -31,6 +32,28 @@ ErrorOr<void> Encoder::encode_size(size_t size)
     return encode(static_cast<u32>(size));
 }
 
+ErrorOr<void> Encoder::append_payload(ReadonlyBytes bytes)
+{
+    if (bytes.size() < out_of_line_payload_threshold)
+        return append(bytes.data(), bytes.size());
+
+#ifdef F_ADD_SEALS
+    // The peer can only trust the size and contents of the payload if we can't change them once it has been sent, so
+    // seal the file. Seals can't be added while there is a writable shared mapping of it, so write to it instead.
+    auto file = IPC::File::adopt_fd(TRY(Core::System::anon_create(bytes.size(), O_CLOEXEC)));
+    for (auto remaining = bytes; !remaining.is_empty();)
+        remaining = remaining.slice(TRY(Core::System::write(file.fd(), remaining)));
+    TRY(Core::System::fcntl(file.fd(), F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL));
+
+    return encode(file);
+#else
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(bytes.size()));
+    __builtin_memcpy(buffer.data<u8>(), bytes.data(), bytes.size());
+
+    return encode(TRY(IPC::File::clone_fd(buffer.fd())));
+#endif
+}
+
 template<>
 ErrorOr<void> encode(Encoder& encoder, float const& value)
 {
@@ -48,7 +71,7 @@ ErrorOr<void> encode(Encoder& encoder, String const& value)
 {
     auto bytes = value.bytes();
     TRY(encoder.encode_size(bytes.size()));
-    TRY(encoder.append(bytes.data(), bytes.size()));
+    TRY(encoder.append_payload(bytes));
     return {};
 }
 
@@ -60,7 +83,7 @@ ErrorOr<void> encode(Encoder& encoder, StringView const& value)
         return encoder.encode(NumericLimits<u32>::max());
 
     TRY(encoder.encode_size(value.length()));
-    TRY(encoder.append(reinterpret_cast<u8 const*>(value.characters_without_null_termination()), value.length()));
+    TRY(encoder.append_payload(value.bytes()));
     return {};
 }
 
@@ -74,7 +97,7 @@ template<>
 ErrorOr<void> encode(Encoder& encoder, ByteBuffer const& value)
 {
     TRY(encoder.encode_size(value.size()));
-    TRY(encoder.append(value.data(), value.size()));
+    TRY(encoder.append_payload(value.bytes()));
     return {};
 }
 
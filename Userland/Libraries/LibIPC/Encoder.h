@@ -55,6 +55,10 @@ public:
         return {};
     }
 
+    // Appends the bytes of a string or buffer, moving them into shared memory if there are many of them.
+    // The other side reads them back with Decoder::decode_payload_into().
+    ErrorOr<void> append_payload(ReadonlyBytes);
+
     ErrorOr<void> encode_size(size_t size);
 
 private:
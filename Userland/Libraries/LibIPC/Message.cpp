@@ -38,27 +38,32 @@ ErrorOr<void> MessageBuffer::append_file_descriptor(int fd)
     return {};
 }
 
-ErrorOr<void> MessageBuffer::transfer_message(Core::LocalSocket& socket)
+ErrorOr<void> MessageBuffer::append_trace_flow_id(u64 flow_id)
+{
+    VERIFY(!m_has_trace_flow_id);
+    TRY(append_data(reinterpret_cast<u8 const*>(&flow_id), sizeof(flow_id)));
+    m_has_trace_flow_id = true;
+    return {};
+}
+
+ErrorOr<void> MessageBuffer::write_size_prefix()
 {
     Checked<MessageSizeType> checked_message_size { m_data.size() };
     checked_message_size -= sizeof(MessageSizeType);
 
-    if (checked_message_size.has_overflow())
+    if (checked_message_size.has_overflow() || (checked_message_size.value() & message_has_trace_flow_id) != 0)
         return Error::from_string_literal("Message is too large for IPC encoding");
 
-    MessageSizeType const message_size = checked_message_size.value();
+    MessageSizeType message_size = checked_message_size.value();
+    if (m_has_trace_flow_id)
+        message_size |= message_has_trace_flow_id;
     m_data.span().overwrite(0, reinterpret_cast<u8 const*>(&message_size), sizeof(message_size));
+    return {};
+}
 
-    auto raw_fds = Vector<int, 1> {};
-    auto num_fds_to_transfer = m_fds.size();
-    if (num_fds_to_transfer > 0) {
-        raw_fds.ensure_capacity(num_fds_to_transfer);
-        for (auto& owned_fd : m_fds) {
-            raw_fds.unchecked_append(owned_fd->value());
-        }
-    }
-
-    ReadonlyBytes bytes_to_write { m_data.span() };
+static ErrorOr<void> transfer_data(ReadonlyBytes bytes_to_write, Vector<int, 1> const& raw_fds, Core::LocalSocket& socket)
+{
+    auto num_fds_to_transfer = raw_fds.size();
 
     while (!bytes_to_write.is_empty()) {
         ErrorOr<ssize_t> maybe_nwritten = 0;
@@ -104,4 +109,48 @@ ErrorOr<void> MessageBuffer::transfer_message(Core::LocalSocket& socket)
     return {};
 }
 
+ErrorOr<void> MessageBuffer::transfer_message(Core::LocalSocket& socket)
+{
+    TRY(write_size_prefix());
+
+    auto raw_fds = Vector<int, 1> {};
+    if (!m_fds.is_empty()) {
+        raw_fds.ensure_capacity(m_fds.size());
+        for (auto& owned_fd : m_fds) {
+            raw_fds.unchecked_append(owned_fd->value());
+        }
+    }
+
+    return transfer_data(m_data.span(), raw_fds, socket);
+}
+
+ErrorOr<void> MessageBuffer::transfer_messages(Span<MessageBuffer> messages, Core::LocalSocket& socket)
+{
+    if (messages.size() == 1)
+        return messages[0].transfer_message(socket);
+
+    size_t total_size = 0;
+    size_t total_fds = 0;
+    for (auto& message : messages) {
+        TRY(message.write_size_prefix());
+        total_size += message.m_data.size();
+        total_fds += message.m_fds.size();
+    }
+
+    Vector<u8> data;
+    TRY(data.try_ensure_capacity(total_size));
+    auto raw_fds = Vector<int, 1> {};
+    TRY(raw_fds.try_ensure_capacity(total_fds));
+
+    // The peer hands out received file descriptors in order as it decodes messages, so sending them all up front in
+    // message order is equivalent to sending each with its own message.
+    for (auto& message : messages) {
+        data.unchecked_append(message.m_data.data(), message.m_data.size());
+        for (auto& owned_fd : message.m_fds)
+            raw_fds.unchecked_append(owned_fd->value());
+    }
+
+    return transfer_data(data.span(), raw_fds, socket);
+}
+
 }
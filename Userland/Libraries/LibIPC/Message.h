@@ -8,8 +8,10 @@
 #pragma once
 
 #include <AK/Error.h>
+#include <AK/Optional.h>
 #include <AK/RefCounted.h>
 #include <AK/RefPtr.h>
+#include <AK/Span.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
 #include <unistd.h>
@@ -35,6 +37,16 @@ private:
     int m_fd;
 };
 
+// Identifies queued messages that supersede one another: a message with the same key as the one queued right before it
+// replaces that message instead of being sent after it.
+struct CoalescingKey {
+    u32 endpoint_magic { 0 };
+    i32 message_id { 0 };
+    u64 key { 0 };
+
+    bool operator==(CoalescingKey const&) const = default;
+};
+
 class MessageBuffer {
 public:
     MessageBuffer();
@@ -44,13 +56,42 @@ public:
 
     ErrorOr<void> append_file_descriptor(int fd);
 
+    size_t data_size() const { return m_data.size(); }
+    size_t file_descriptor_count() const { return m_fds.size(); }
+
+    Optional<CoalescingKey> const& coalescing_key() const { return m_coalescing_key; }
+    void set_coalescing_key(CoalescingKey key) { m_coalescing_key = key; }
+
+    // Has to be the last thing appended to the message.
+    ErrorOr<void> append_trace_flow_id(u64);
+
     ErrorOr<void> transfer_message(Core::LocalSocket& socket);
 
+    // Writes several messages to the socket as though they were one, so that a backlog of small messages costs a
+    // single system call rather than one each. The messages' file descriptors all travel with the first write.
+    static ErrorOr<void> transfer_messages(Span<MessageBuffer> messages, Core::LocalSocket& socket);
+
 private:
+    ErrorOr<void> write_size_prefix();
+
     Vector<u8, 1024> m_data;
     Vector<NonnullRefPtr<AutoCloseFileDescriptor>, 1> m_fds;
+    Optional<CoalescingKey> m_coalescing_key;
+    bool m_has_trace_flow_id { false };
 };
 
+// Set in the size prefix of a message that is followed by the ID of the trace flow it is part of. The flow ID is
+// counted in the size, so that the peer can skip over the message without knowing about it.
+constexpr u32 message_has_trace_flow_id = 1u << 31;
+
+// The send thread batches queued messages up to these limits. Anything larger than the byte limit is sent on its own.
+constexpr size_t max_message_batch_size = 64 * KiB;
+constexpr size_t max_message_batch_file_descriptors = 32;
+
+// Byte payloads (strings and buffers) at least this large travel in shared memory next to the message instead of in it.
+// That spares them the trip through the socket, which would copy them in socket-buffer-sized pieces on both ends.
+constexpr size_t out_of_line_payload_threshold = 256 * KiB;
+
 enum class ErrorCode : u32 {
     PeerDisconnected
 };
@@ -68,8 +109,19 @@ public:
     virtual bool valid() const = 0;
     virtual ErrorOr<MessageBuffer> encode() const = 0;
 
+    // Messages declared with the [Coalesce] attribute return a key here. Only the latest of several such messages with
+    // equal keys that are queued back-to-back is actually sent.
+    virtual Optional<u64> coalescing_key() const { return {}; }
+
+    // Connects the sending of this message to its handling in a trace, if the sender was tracing IPC.
+    u64 trace_flow_id() const { return m_trace_flow_id; }
+    void set_trace_flow_id(u64 trace_flow_id) { m_trace_flow_id = trace_flow_id; }
+
 protected:
     Message() = default;
+
+private:
+    u64 m_trace_flow_id { 0 };
 };
 
 }
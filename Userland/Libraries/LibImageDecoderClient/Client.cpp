@@ -20,9 +20,10 @@ void Client::die()
         promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
     }
     m_pending_decoded_images.clear();
+    m_pending_animation_frames.clear();
 }
 
-NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, bool is_high_priority)
 {
     auto promise = Core::Promise<DecodedImage>::construct();
     if (on_resolved)
@@ -45,7 +46,7 @@ NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes en
 
     memcpy(encoded_buffer.data<void>(), encoded_data.data(), encoded_data.size());
 
-    auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::DecodeImage>(move(encoded_buffer), ideal_size, mime_type);
+    auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::DecodeImage>(move(encoded_buffer), ideal_size, mime_type, is_high_priority);
     if (!response) {
         dbgln("ImageDecoder disconnected trying to decode image");
         promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
@@ -57,7 +58,19 @@ NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes en
     return promise;
 }
 
-void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations, Gfx::FloatPoint scale)
+void Client::request_animation_frames(i64 image_id, u32 first_frame_index, u32 count, AnimationFramesCallback on_decoded)
+{
+    m_pending_animation_frames.set(image_id, move(on_decoded));
+    async_request_animation_frames(image_id, first_frame_index, count);
+}
+
+void Client::release_animation(i64 image_id)
+{
+    m_pending_animation_frames.remove(image_id);
+    async_release_animation(image_id);
+}
+
+void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, u32 frame_count, Gfx::IntSize natural_size, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations, Gfx::FloatPoint scale)
 {
     auto const& bitmaps = bitmap_sequence.bitmaps;
     VERIFY(!bitmaps.is_empty());
@@ -70,8 +83,11 @@ void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gf
     auto promise = maybe_promise.release_value();
 
     DecodedImage image;
+    image.image_id = image_id;
     image.is_animated = is_animated;
     image.loop_count = loop_count;
+    image.frame_count = frame_count;
+    image.natural_size = natural_size;
     image.scale = scale;
     image.frames.ensure_capacity(bitmaps.size());
     for (size_t i = 0; i < bitmaps.size(); ++i) {
@@ -87,6 +103,25 @@ void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gf
     promise->resolve(move(image));
 }
 
+void Client::did_decode_animation_frames(i64 image_id, u32 first_frame_index, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations)
+{
+    auto on_decoded = m_pending_animation_frames.take(image_id);
+    if (!on_decoded.has_value())
+        return;
+
+    auto const& bitmaps = bitmap_sequence.bitmaps;
+    Vector<Optional<Frame>> frames;
+    frames.ensure_capacity(bitmaps.size());
+    for (size_t i = 0; i < bitmaps.size(); ++i) {
+        if (bitmaps[i].has_value())
+            frames.unchecked_append(Frame { *bitmaps[i], durations[i] });
+        else
+            frames.unchecked_append({});
+    }
+
+    on_decoded.value()(first_frame_index, move(frames));
+}
+
 void Client::did_fail_to_decode_image(i64 image_id, String const& error_message)
 {
     auto maybe_promise = m_pending_decoded_images.take(image_id);
@@ -20,9 +20,17 @@ struct Frame {
 };
 
 struct DecodedImage {
+    i64 image_id { 0 };
     bool is_animated { false };
     Gfx::FloatPoint scale { 1, 1 };
     u32 loop_count { 0 };
+
+    // The size of the image itself. The frames may be smaller than this if an ideal size was asked for.
+    Gfx::IntSize natural_size;
+
+    // The total number of frames. Long animations only come with their first few frames; the rest have to be asked
+    // for with request_animation_frames(), and the animation released with release_animation() when it's no longer used.
+    u32 frame_count { 0 };
     Vector<Frame> frames;
 };
 
@@ -34,17 +42,24 @@ class Client final
 public:
     Client(NonnullOwnPtr<Core::LocalSocket>);
 
-    NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {});
+    NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {}, bool is_high_priority = false);
+
+    // Frames that failed to decode are handed back as empty.
+    using AnimationFramesCallback = Function<void(u32 first_frame_index, Vector<Optional<Frame>>)>;
+    void request_animation_frames(i64 image_id, u32 first_frame_index, u32 count, AnimationFramesCallback on_decoded);
+    void release_animation(i64 image_id);
 
     Function<void()> on_death;
 
 private:
     virtual void die() override;
 
-    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations, Gfx::FloatPoint scale) override;
+    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, u32 frame_count, Gfx::IntSize natural_size, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations, Gfx::FloatPoint scale) override;
+    virtual void did_decode_animation_frames(i64 image_id, u32 first_frame_index, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations) override;
     virtual void did_fail_to_decode_image(i64 image_id, String const& error_message) override;
 
     HashMap<i64, NonnullRefPtr<Core::Promise<DecodedImage>>> m_pending_decoded_images;
+    HashMap<i64, AnimationFramesCallback> m_pending_animation_frames;
 };
 
 }
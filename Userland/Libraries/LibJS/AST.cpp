@@ -47,6 +47,14 @@ ASTNode::ASTNode(SourceRange source_range)
 {
 }
 
+void ASTNode::operator delete(ASTNode* node, std::destroying_delete_t)
+{
+    // The node's memory is freed along with all the others from the same source code, once that goes away.
+    // Since the node itself may be what keeps the source code alive, hold on to it until the node is destroyed.
+    NonnullRefPtr<SourceCode const> source_code = *node->m_source_code;
+    node->~ASTNode();
+}
+
 SourceRange ASTNode::source_range() const
 {
     return m_source_code->range_from_offsets(m_start_offset, m_end_offset);
@@ -239,7 +247,7 @@ ThrowCompletionOr<ClassElement::ClassValue> ClassField::class_element_evaluation
             });
 
         // FIXME: A potential optimization is not creating the functions here since these are never directly accessible.
-        auto function_code = create_ast_node<ClassFieldInitializerStatement>(m_initializer->source_range(), copy_initializer.release_nonnull(), name);
+        auto function_code = adopt_ref(*new ClassFieldInitializerStatement(m_initializer->source_range(), copy_initializer.release_nonnull(), name));
         FunctionParsingInsights parsing_insights;
         parsing_insights.uses_this_from_environment = true;
         parsing_insights.uses_this = true;
@@ -1350,11 +1358,11 @@ void CatchClause::dump(int indent) const
 {
     print_indent(indent);
     m_parameter.visit(
-        [&](DeprecatedFlyString const& parameter) {
-            if (parameter.is_empty())
-                outln("CatchClause");
-            else
-                outln("CatchClause ({})", parameter);
+        [&](Empty) {
+            outln("CatchClause");
+        },
+        [&](NonnullRefPtr<Identifier const> const& parameter) {
+            outln("CatchClause ({})", parameter->string());
         },
         [&](NonnullRefPtr<BindingPattern const> const& pattern) {
             outln("CatchClause");
@@ -31,6 +31,7 @@
 #include <LibJS/Runtime/PropertyKey.h>
 #include <LibJS/Runtime/Reference.h>
 #include <LibJS/Runtime/Value.h>
+#include <LibJS/SourceCode.h>
 #include <LibJS/SourceRange.h>
 #include <LibRegex/Regex.h>
 
@@ -43,19 +44,22 @@ class Identifier;
 class MemberExpression;
 class VariableDeclaration;
 
+// AST nodes are allocated from the SourceCode they were parsed from, and freed along with it. See SourceCode::allocate_ast_node().
 template<class T, class... Args>
 static inline NonnullRefPtr<T>
 create_ast_node(SourceRange range, Args&&... args)
 {
-    return adopt_ref(*new T(move(range), forward<Args>(args)...));
+    auto* memory = range.code->allocate_ast_node(sizeof(T), alignof(T));
+    return adopt_ref(*::new (memory) T(move(range), forward<Args>(args)...));
 }
 
 class ASTNode : public RefCounted<ASTNode> {
 public:
     virtual ~ASTNode() = default;
 
-    // NOTE: This is here to stop ASAN complaining about mismatch between new/delete sizes in ASTNodeWithTailArray.
-    void operator delete(void* ptr) { ::operator delete(ptr); }
+    // NOTE: AST nodes live in memory owned by their SourceCode, so they have to be made with create_ast_node().
+    static void* operator new(size_t) = delete;
+    void operator delete(ASTNode*, std::destroying_delete_t);
 
     virtual Bytecode::CodeGenerationErrorOr<Optional<Bytecode::ScopedOperand>> generate_bytecode(Bytecode::Generator&, Optional<Bytecode::ScopedOperand> preferred_dst = {}) const;
     virtual void dump(int indent) const;
@@ -133,7 +137,7 @@ protected:
     {
         static_assert(sizeof(ActualDerived) == sizeof(Derived), "This leaf class cannot add more members");
         static_assert(alignof(ActualDerived) % alignof(T) == 0, "Need padding for tail array");
-        auto* memory = ::operator new(sizeof(ActualDerived) + tail_size * sizeof(T));
+        auto* memory = source_range.code->allocate_ast_node(sizeof(ActualDerived) + tail_size * sizeof(T), alignof(ActualDerived));
         return adopt_ref(*::new (memory) ActualDerived(move(source_range), forward<Args>(args)...));
     }
 
@@ -1495,6 +1499,10 @@ public:
     {
     }
 
+    // NOTE: These are made anew every time a class is evaluated, so they can't stay around until their source code goes away.
+    static void* operator new(size_t size) { return ::operator new(size); }
+    void operator delete(void* ptr) { ::operator delete(ptr); }
+
     virtual void dump(int) const override;
     virtual Bytecode::CodeGenerationErrorOr<Optional<Bytecode::ScopedOperand>> generate_bytecode(Bytecode::Generator&, Optional<Bytecode::ScopedOperand> preferred_dst = {}) const override;
 
@@ -2041,7 +2049,13 @@ private:
 
 class CatchClause final : public ASTNode {
 public:
-    CatchClause(SourceRange source_range, DeprecatedFlyString parameter, NonnullRefPtr<BlockStatement const> body)
+    CatchClause(SourceRange source_range, NonnullRefPtr<BlockStatement const> body)
+        : ASTNode(move(source_range))
+        , m_body(move(body))
+    {
+    }
+
+    CatchClause(SourceRange source_range, NonnullRefPtr<Identifier const> parameter, NonnullRefPtr<BlockStatement const> body)
         : ASTNode(move(source_range))
         , m_parameter(move(parameter))
         , m_body(move(body))
@@ -2061,7 +2075,7 @@ public:
     virtual void dump(int indent) const override;
 
 private:
-    Variant<DeprecatedFlyString, NonnullRefPtr<BindingPattern const>> m_parameter;
+    Variant<Empty, NonnullRefPtr<Identifier const>, NonnullRefPtr<BindingPattern const>> m_parameter;
     NonnullRefPtr<BlockStatement const> m_body;
 };
 
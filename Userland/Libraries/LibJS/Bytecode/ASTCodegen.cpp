@@ -2633,18 +2633,25 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> TryStatement::generate_
             generator.emit<Bytecode::Op::RestoreScheduledJump>();
         }
 
-        // OPTIMIZATION: We avoid creating a lexical environment if the catch clause has no parameter.
+        // OPTIMIZATION: We avoid creating a lexical environment if the catch clause has no parameter, or if the parameter
+        //               is kept in a local because nothing reaches it through an environment.
         bool did_create_variable_scope_for_catch_clause = false;
 
         TRY(m_handler->parameter().visit(
-            [&](DeprecatedFlyString const& parameter) -> Bytecode::CodeGenerationErrorOr<void> {
-                if (!parameter.is_empty()) {
-                    generator.begin_variable_scope();
-                    did_create_variable_scope_for_catch_clause = true;
-                    auto parameter_identifier = generator.intern_identifier(parameter);
-                    generator.emit<Bytecode::Op::CreateVariable>(parameter_identifier, Bytecode::Op::EnvironmentMode::Lexical, false);
-                    generator.emit<Bytecode::Op::InitializeLexicalBinding>(parameter_identifier, caught_value);
+            [&](Empty) -> Bytecode::CodeGenerationErrorOr<void> {
+                return {};
+            },
+            [&](NonnullRefPtr<Identifier const> const& parameter) -> Bytecode::CodeGenerationErrorOr<void> {
+                if (parameter->is_local()) {
+                    generator.emit<Bytecode::Op::Mov>(generator.local(parameter->local_variable_index()), caught_value);
+                    generator.set_local_initialized(parameter->local_variable_index());
+                    return {};
                 }
+                generator.begin_variable_scope();
+                did_create_variable_scope_for_catch_clause = true;
+                auto parameter_identifier = generator.intern_identifier(parameter->string());
+                generator.emit<Bytecode::Op::CreateVariable>(parameter_identifier, Bytecode::Op::EnvironmentMode::Lexical, false);
+                generator.emit<Bytecode::Op::InitializeLexicalBinding>(parameter_identifier, caught_value);
                 return {};
             },
             [&](NonnullRefPtr<BindingPattern const> const& binding_pattern) -> Bytecode::CodeGenerationErrorOr<void> {
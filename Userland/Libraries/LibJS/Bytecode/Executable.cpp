@@ -14,6 +14,44 @@ namespace JS::Bytecode {
 
 JS_DEFINE_ALLOCATOR(Executable);
 
+PropertyLookupCache::State PropertyLookupCache::state() const
+{
+    if (m_megamorphic)
+        return State::Megamorphic;
+    size_t live_entries = 0;
+    for (auto const& entry : entries) {
+        if (entry.shape)
+            ++live_entries;
+    }
+    if (live_entries == 0)
+        return State::Uninitialized;
+    if (live_entries == 1)
+        return State::Monomorphic;
+    return State::Polymorphic;
+}
+
+PropertyLookupCache::Entry* PropertyLookupCache::entry_for_insertion()
+{
+    if (m_megamorphic)
+        return nullptr;
+
+    // Prefer an entry that was never used, or whose shape has since been garbage collected.
+    for (auto& entry : entries) {
+        if (!entry.shape)
+            return &entry;
+    }
+
+    if (++m_eviction_count > max_number_of_evictions_before_megamorphic) {
+        m_megamorphic = true;
+        entries = {};
+        return nullptr;
+    }
+
+    auto& entry = entries[m_next_entry_to_evict];
+    m_next_entry_to_evict = (m_next_entry_to_evict + 1) % max_number_of_shapes_to_remember;
+    return &entry;
+}
+
 Executable::Executable(
     Vector<u8> bytecode,
     NonnullOwnPtr<IdentifierTable> identifier_table,
@@ -89,6 +127,37 @@ void Executable::visit_edges(Visitor& visitor)
     visitor.visit(constants);
 }
 
+void Executable::dump_property_lookup_cache_statistics() const
+{
+    auto state_name = [](PropertyLookupCache::State state) {
+        switch (state) {
+        case PropertyLookupCache::State::Uninitialized:
+            return "uninitialized"sv;
+        case PropertyLookupCache::State::Monomorphic:
+            return "monomorphic"sv;
+        case PropertyLookupCache::State::Polymorphic:
+            return "polymorphic"sv;
+        case PropertyLookupCache::State::Megamorphic:
+            return "megamorphic"sv;
+        }
+        VERIFY_NOT_REACHED();
+    };
+
+    warnln("\033[37;1mProperty lookup caches\033[0m \"{}\"", name);
+    for (size_t i = 0; i < property_lookup_caches.size(); ++i) {
+        auto const& cache = property_lookup_caches[i];
+        auto total = cache.hit_count + cache.miss_count;
+        if (total == 0)
+            continue;
+        warnln("    #{:<4} {:>13} hits: {:>8} misses: {:>8} ({}%)",
+            i,
+            state_name(cache.state()),
+            cache.hit_count,
+            cache.miss_count,
+            cache.hit_count * 100 / total);
+    }
+}
+
 Optional<Executable::ExceptionHandlers const&> Executable::exception_handlers_for_offset(size_t offset) const
 {
     for (auto& handlers : exception_handlers) {
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/DeprecatedFlyString.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
@@ -23,13 +24,47 @@
 namespace JS::Bytecode {
 
 struct PropertyLookupCache {
-    WeakPtr<Shape> shape;
-    Optional<u32> property_offset;
-    WeakPtr<Object> prototype;
-    WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    static constexpr size_t max_number_of_shapes_to_remember = 4;
+
+    // NOTE: Once this many live entries have been evicted, the site is considered megamorphic
+    //       and we stop caching shapes for it altogether.
+    static constexpr u32 max_number_of_evictions_before_megamorphic = 4;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        Optional<u32> property_offset;
+        WeakPtr<Object> prototype;
+        WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    };
+
+    enum class State : u8 {
+        Uninitialized,
+        Monomorphic,
+        Polymorphic,
+        Megamorphic,
+    };
+
+    [[nodiscard]] bool is_megamorphic() const { return m_megamorphic; }
+    [[nodiscard]] State state() const;
+
+    // Returns the entry that should be (re)populated for a newly observed shape,
+    // or nullptr if the site has gone megamorphic.
+    Entry* entry_for_insertion();
+
+    AK::Array<Entry, max_number_of_shapes_to_remember> entries;
+
+    u64 hit_count { 0 };
+    u64 miss_count { 0 };
+
+private:
+    u32 m_eviction_count { 0 };
+    u8 m_next_entry_to_evict { 0 };
+    bool m_megamorphic { false };
 };
 
-struct GlobalVariableCache : public PropertyLookupCache {
+struct GlobalVariableCache {
+    WeakPtr<Shape> shape;
+    Optional<u32> property_offset;
     u64 environment_serial_number { 0 };
     Optional<u32> environment_binding_index;
 };
@@ -103,6 +138,7 @@ public:
     [[nodiscard]] UnrealizedSourceRange source_range_at(size_t offset) const;
 
     void dump() const;
+    void dump_property_lookup_cache_statistics() const;
 
 private:
     virtual void visit_edges(Visitor&) override;
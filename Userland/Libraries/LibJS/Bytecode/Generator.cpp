@@ -287,6 +287,83 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
         }
     }
 
+    auto& blocks = generator.m_root_basic_blocks;
+
+    // Pass: Thread jumps through blocks that consist of nothing but an unconditional jump.
+    size_t number_of_threaded_jumps = 0;
+    auto forwarding_target_of = [&](size_t block_index) -> Optional<size_t> {
+        auto const& block = *blocks[block_index];
+        if (block.size() == 0)
+            return {};
+        auto const& instruction = *InstructionStreamIterator { block.instruction_stream() };
+        if (instruction.type() != Instruction::Type::Jump)
+            return {};
+        return static_cast<Op::Jump const&>(instruction).target().basic_block_index();
+    };
+    for (auto& block : blocks) {
+        Bytecode::InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            instruction.visit_labels([&](Label& label) {
+                auto target_index = label.basic_block_index();
+                // NOTE: Bound the number of hops so that jump-only cycles (e.g. `for (;;) {}`) terminate.
+                for (size_t hops = 0; hops < blocks.size(); ++hops) {
+                    auto forwarded_index = forwarding_target_of(target_index);
+                    if (!forwarded_index.has_value() || *forwarded_index == target_index)
+                        break;
+                    target_index = *forwarded_index;
+                }
+                if (target_index != label.basic_block_index()) {
+                    label = Label { static_cast<u32>(target_index) };
+                    ++number_of_threaded_jumps;
+                }
+            });
+            ++it;
+        }
+    }
+
+    // Pass: Find the blocks reachable from the entry block, so that we don't emit the rest.
+    Vector<bool> block_is_reachable;
+    block_is_reachable.resize(blocks.size());
+    {
+        Vector<size_t> blocks_to_visit;
+        auto mark_reachable = [&](size_t block_index) {
+            if (block_is_reachable[block_index])
+                return;
+            block_is_reachable[block_index] = true;
+            blocks_to_visit.append(block_index);
+        };
+        mark_reachable(0);
+        while (!blocks_to_visit.is_empty()) {
+            auto& block = *blocks[blocks_to_visit.take_last()];
+            if (block.handler())
+                mark_reachable(block.handler()->index());
+            if (block.finalizer())
+                mark_reachable(block.finalizer()->index());
+            Bytecode::InstructionStreamIterator it(block.instruction_stream());
+            while (!it.at_end()) {
+                const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                    mark_reachable(label.basic_block_index());
+                });
+                ++it;
+            }
+        }
+    }
+    size_t number_of_unreachable_blocks = 0;
+    for (auto is_reachable : block_is_reachable) {
+        if (!is_reachable)
+            ++number_of_unreachable_blocks;
+    }
+
+    // For every block, the index of the next block that will actually be emitted after it.
+    Vector<Optional<size_t>> next_emitted_block_index;
+    next_emitted_block_index.resize(blocks.size());
+    for (size_t i = blocks.size(); i > 1; --i) {
+        next_emitted_block_index[i - 2] = block_is_reachable[i - 1] ? i - 1 : next_emitted_block_index[i - 1];
+    }
+
+    size_t number_of_removed_moves = 0;
+
     auto number_of_registers = generator.m_next_register;
     auto number_of_constants = generator.m_constants.size();
 
@@ -320,6 +397,9 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
         undefined_constant.value().operand().offset_index_by(number_of_registers);
 
     for (auto& block : generator.m_root_basic_blocks) {
+        if (!block_is_reachable[block->index()])
+            continue;
+
         basic_block_start_offsets.append(bytecode.size());
         if (block->handler() || block->finalizer()) {
             unlinked_exception_handlers.append({
@@ -332,19 +412,31 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
 
         block_offsets.set(block.ptr(), bytecode.size());
 
-        for (auto& [offset, source_record] : block->source_map()) {
-            source_map.set(bytecode.size() + offset, source_record);
-        }
+        auto next_block_index = next_emitted_block_index[block->index()];
 
         Bytecode::InstructionStreamIterator it(block->instruction_stream());
         while (!it.at_end()) {
             auto& instruction = const_cast<Instruction&>(*it);
 
+            // NOTE: Since some instructions below are dropped or replaced, we map source records one instruction at a time.
+            if (auto source_record = block->source_map().get(it.offset()); source_record.has_value())
+                source_map.set(bytecode.size(), *source_record);
+
+            // OPTIMIZATION: Don't emit moves from an operand to itself.
+            if (instruction.type() == Instruction::Type::Mov) {
+                auto& mov = static_cast<Bytecode::Op::Mov&>(instruction);
+                if (mov.dst() == mov.src()) {
+                    ++number_of_removed_moves;
+                    ++it;
+                    continue;
+                }
+            }
+
             if (instruction.type() == Instruction::Type::Jump) {
                 auto& jump = static_cast<Bytecode::Op::Jump&>(instruction);
 
                 // OPTIMIZATION: Don't emit jumps that just jump to the next block.
-                if (jump.target().basic_block_index() == block->index() + 1) {
+                if (jump.target().basic_block_index() == next_block_index) {
                     if (basic_block_start_offsets.last() == bytecode.size()) {
                         // This block is empty, just skip it.
                         basic_block_start_offsets.take_last();
@@ -381,7 +473,7 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
             //               we can emit a `JumpTrue` or `JumpFalse` (to the other block) instead.
             if (instruction.type() == Instruction::Type::JumpIf) {
                 auto& jump = static_cast<Bytecode::Op::JumpIf&>(instruction);
-                if (jump.true_target().basic_block_index() == block->index() + 1) {
+                if (jump.true_target().basic_block_index() == next_block_index) {
                     Op::JumpFalse jump_false(jump.condition(), Label { jump.false_target() });
                     auto& label = jump_false.target();
                     size_t label_offset = bytecode.size() + (bit_cast<FlatPtr>(&label) - bit_cast<FlatPtr>(&jump_false));
@@ -390,7 +482,7 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
                     ++it;
                     continue;
                 }
-                if (jump.false_target().basic_block_index() == block->index() + 1) {
+                if (jump.false_target().basic_block_index() == next_block_index) {
                     Op::JumpTrue jump_true(jump.condition(), Label { jump.true_target() });
                     auto& label = jump_true.target();
                     size_t label_offset = bytecode.size() + (bit_cast<FlatPtr>(&label) - bit_cast<FlatPtr>(&jump_true));
@@ -455,6 +547,15 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
     executable->local_index_base = number_of_registers + number_of_constants;
     executable->length_identifier = generator.m_length_identifier;
 
+    if (g_dump_bytecode_passes) {
+        warnln("\033[37;1mBytecode passes\033[0m for \"{}\": threaded {} jump(s), removed {} unreachable block(s) of {}, removed {} redundant move(s)",
+            function ? function->name().view() : "(top level)"sv,
+            number_of_threaded_jumps,
+            number_of_unreachable_blocks,
+            blocks.size(),
+            number_of_removed_moves);
+    }
+
     generator.m_finished = true;
 
     return executable;
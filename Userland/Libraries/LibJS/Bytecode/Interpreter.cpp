@@ -14,6 +14,7 @@
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/RegExpCache.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/BigInt.h>
@@ -21,6 +22,7 @@
 #include <LibJS/Runtime/ECMAScriptFunctionObject.h>
 #include <LibJS/Runtime/Environment.h>
 #include <LibJS/Runtime/FunctionEnvironment.h>
+#include <LibJS/Runtime/GeneratorResult.h>
 #include <LibJS/Runtime/GlobalEnvironment.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/Iterator.h>
@@ -30,6 +32,7 @@
 #include <LibJS/Runtime/Realm.h>
 #include <LibJS/Runtime/Reference.h>
 #include <LibJS/Runtime/RegExpObject.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibJS/Runtime/TypedArray.h>
 #include <LibJS/Runtime/Value.h>
 #include <LibJS/Runtime/ValueInlines.h>
@@ -38,6 +41,7 @@
 namespace JS::Bytecode {
 
 bool g_dump_bytecode = false;
+bool g_dump_bytecode_passes = false;
 
 static ByteString format_operand(StringView name, Operand operand, Bytecode::Executable const& executable)
 {
@@ -166,18 +170,10 @@ ALWAYS_INLINE void Interpreter::set(Operand op, Value value)
 
 ALWAYS_INLINE Value Interpreter::do_yield(Value value, Optional<Label> continuation)
 {
-    auto object = Object::create(realm(), nullptr);
-    object->define_direct_property("result", value, JS::default_attributes);
-
+    Optional<size_t> continuation_address;
     if (continuation.has_value())
-        // FIXME: If we get a pointer, which is not accurately representable as a double
-        //        will cause this to explode
-        object->define_direct_property("continuation", Value(continuation->address()), JS::default_attributes);
-    else
-        object->define_direct_property("continuation", js_null(), JS::default_attributes);
-
-    object->define_direct_property("isAwait", Value(false), JS::default_attributes);
-    return object;
+        continuation_address = continuation->address();
+    return GeneratorResult::create(realm(), value, continuation_address, false);
 }
 
 // 16.1.6 ScriptEvaluation ( scriptRecord ), https://tc39.es/ecma262/#sec-runtime-semantics-scriptevaluation
@@ -229,7 +225,14 @@ ThrowCompletionOr<Value> Interpreter::run(Script& script_record, JS::GCPtr<Envir
 
     // 13. If result.[[Type]] is normal, then
     if (result.type() == Completion::Type::Normal) {
-        auto executable_result = JS::Bytecode::Generator::generate_from_ast_node(vm, script, {});
+        // NOTE: The executable is cached on the parse node, which may be shared with other scripts that have the same source text.
+        auto executable_result = [&]() -> CodeGenerationErrorOr<NonnullGCPtr<Executable>> {
+            if (auto* cached_executable = script.bytecode_executable())
+                return NonnullGCPtr { *cached_executable };
+            auto executable = TRY(JS::Bytecode::Generator::generate_from_ast_node(vm, script, {}));
+            const_cast<Program&>(script).set_bytecode_executable(executable);
+            return executable;
+        }();
 
         if (executable_result.is_error()) {
             if (auto error_string = executable_result.error().to_string(); error_string.is_error())
@@ -406,6 +409,9 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
 
         handle_Jump: {
             auto& instruction = *reinterpret_cast<Op::Jump const*>(&bytecode[program_counter]);
+            // NOTE: Unconditional jumps include loop back edges, so this lets the profiler see long-running loops.
+            if (auto* profiler = m_vm.sampling_profiler()) [[unlikely]]
+                profiler->tick(program_counter);
             program_counter = instruction.target().address();
             goto start;
         }
@@ -708,12 +714,11 @@ Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& exe
 
     auto& running_execution_context = vm().running_execution_context();
     u32 registers_and_constants_and_locals_count = executable.number_of_registers + executable.constants.size() + executable.local_variable_names.size();
-    if (running_execution_context.registers_and_constants_and_locals.size() < registers_and_constants_and_locals_count)
-        running_execution_context.registers_and_constants_and_locals.resize(registers_and_constants_and_locals_count);
+    running_execution_context.ensure_registers_and_constants_and_locals_count(registers_and_constants_and_locals_count);
 
     TemporaryChange restore_running_execution_context { m_running_execution_context, &running_execution_context };
-    TemporaryChange restore_arguments { m_arguments, running_execution_context.arguments.span() };
-    TemporaryChange restore_registers_and_constants_and_locals { m_registers_and_constants_and_locals, running_execution_context.registers_and_constants_and_locals.span() };
+    TemporaryChange restore_arguments { m_arguments, running_execution_context.arguments };
+    TemporaryChange restore_registers_and_constants_and_locals { m_registers_and_constants_and_locals, running_execution_context.registers_and_constants_and_locals };
 
     reg(Register::accumulator()) = initial_accumulator_value;
     reg(Register::return_value()) = {};
@@ -725,10 +730,14 @@ Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& exe
     if (reg(Register::this_value()).is_empty())
         reg(Register::this_value()) = running_execution_context.this_value;
 
-    running_execution_context.executable = &executable;
+    // NOTE: A suspended generator or async function is resumed in the same execution context, which already has the
+    //       constants of its executable in place from when it first started running.
+    if (running_execution_context.executable != &executable) {
+        running_execution_context.executable = &executable;
 
-    for (size_t i = 0; i < executable.constants.size(); ++i) {
-        running_execution_context.registers_and_constants_and_locals[executable.number_of_registers + i] = executable.constants[i];
+        for (size_t i = 0; i < executable.constants.size(); ++i) {
+            running_execution_context.registers_and_constants_and_locals[executable.number_of_registers + i] = executable.constants[i];
+        }
     }
 
     run_bytecode(entry_point.value_or(0));
@@ -745,6 +754,7 @@ Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& exe
                 value_string = registers_and_constants_and_locals[i].to_string_without_side_effects();
             dbgln("[{:3}] {}", i, value_string);
         }
+        executable.dump_property_lookup_cache_statistics();
     }
 
     auto return_value = js_undefined();
@@ -965,7 +975,7 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
 {
     if constexpr (mode == GetByIdMode::Length) {
         if (base_value.is_string()) {
-            return Value(base_value.as_string().utf16_string().length_in_code_units());
+            return Value(base_value.as_string().length_in_utf16_code_units());
         }
     }
 
@@ -980,37 +990,51 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
 
     auto& shape = base_obj->shape();
 
-    if (cache.prototype) {
-        // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
-        bool can_use_cache = [&]() -> bool {
-            if (&shape != cache.shape)
-                return false;
-            if (!cache.prototype_chain_validity)
-                return false;
-            if (!cache.prototype_chain_validity->is_valid())
-                return false;
-            return true;
-        }();
-        if (can_use_cache)
-            return cache.prototype->get_direct(cache.property_offset.value());
-    } else if (&shape == cache.shape) {
-        // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
-        return base_obj->get_direct(cache.property_offset.value());
+    if (!cache.is_megamorphic()) {
+        for (auto& entry : cache.entries) {
+            if (&shape != entry.shape)
+                continue;
+            if (entry.prototype) {
+                // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
+                if (!entry.prototype_chain_validity || !entry.prototype_chain_validity->is_valid())
+                    break;
+                ++cache.hit_count;
+                return entry.prototype->get_direct(entry.property_offset.value());
+            }
+            // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
+            ++cache.hit_count;
+            return base_obj->get_direct(entry.property_offset.value());
+        }
     }
 
+    ++cache.miss_count;
+
     CacheablePropertyMetadata cacheable_metadata;
     auto value = TRY(base_obj->internal_get(executable.get_identifier(property), this_value, &cacheable_metadata));
 
+    if (cacheable_metadata.type == CacheablePropertyMetadata::Type::NotCacheable)
+        return value;
+
+    // NOTE: Drop any stale entry for this shape (e.g. one with an invalidated prototype chain) before inserting a new one.
+    for (auto& entry : cache.entries) {
+        if (&shape == entry.shape)
+            entry = {};
+    }
+
+    auto* entry = cache.entry_for_insertion();
+    if (!entry)
+        return value;
+
     if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-        cache = {};
-        cache.shape = shape;
-        cache.property_offset = cacheable_metadata.property_offset.value();
+        *entry = {};
+        entry->shape = shape;
+        entry->property_offset = cacheable_metadata.property_offset.value();
     } else if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
-        cache = {};
-        cache.shape = &base_obj->shape();
-        cache.property_offset = cacheable_metadata.property_offset.value();
-        cache.prototype = *cacheable_metadata.prototype;
-        cache.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+        *entry = {};
+        entry->shape = &base_obj->shape();
+        entry->property_offset = cacheable_metadata.property_offset.value();
+        entry->prototype = *cacheable_metadata.prototype;
+        entry->prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
     }
 
     return value;
@@ -1113,6 +1137,7 @@ inline ThrowCompletionOr<Value> get_global(Interpreter& interpreter, IdentifierT
     }
 
     cache.environment_serial_number = declarative_record.environment_serial_number();
+    cache.environment_binding_index = {};
 
     auto& identifier = interpreter.current_executable().get_identifier(identifier_index);
 
@@ -1177,17 +1202,28 @@ inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value thi
         break;
     }
     case Op::PropertyKind::KeyValue: {
-        if (cache && cache->shape == &object->shape()) {
-            object->put_direct(*cache->property_offset, value);
-            return {};
+        if (cache && !cache->is_megamorphic()) {
+            for (auto& entry : cache->entries) {
+                if (&object->shape() != entry.shape)
+                    continue;
+                ++cache->hit_count;
+                object->put_direct(*entry.property_offset, value);
+                return {};
+            }
         }
 
+        if (cache)
+            ++cache->miss_count;
+
         CacheablePropertyMetadata cacheable_metadata;
         bool succeeded = TRY(object->internal_set(name, value, this_value, &cacheable_metadata));
 
         if (succeeded && cache && cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-            cache->shape = object->shape();
-            cache->property_offset = cacheable_metadata.property_offset.value();
+            if (auto* entry = cache->entry_for_insertion()) {
+                *entry = {};
+                entry->shape = object->shape();
+                entry->property_offset = cacheable_metadata.property_offset.value();
+            }
         }
 
         if (!succeeded && vm.in_strict_mode()) {
@@ -1412,9 +1448,16 @@ inline Value new_regexp(VM& vm, ParsedRegex const& parsed_regex, ByteString cons
 
     // 3. Return ! RegExpCreate(pattern, flags).
     auto& realm = *vm.current_realm();
-    Regex<ECMA262> regex(parsed_regex.regex, parsed_regex.pattern, parsed_regex.flags);
+
+    // OPTIMIZATION: The pattern was parsed along with the literal, but optimizing its bytecode still takes a while.
+    //               The compiled regex is shared with other evaluations of this literal, and with equivalent RegExps.
+    auto regex = vm.regexp_cache().find(pattern, flags);
+    if (!regex.has_value()) {
+        regex.emplace(parsed_regex.regex, parsed_regex.pattern, parsed_regex.flags);
+        vm.regexp_cache().add(pattern, flags, *regex);
+    }
     // NOTE: We bypass RegExpCreate and subsequently RegExpAlloc as an optimization to use the already parsed values.
-    auto regexp_object = RegExpObject::create(realm, move(regex), pattern, flags);
+    auto regexp_object = RegExpObject::create(realm, regex.release_value(), pattern, flags);
     // RegExpAlloc has these two steps from the 'Legacy RegExp features' proposal.
     regexp_object->set_realm(realm);
     // We don't need to check 'If SameValue(newTarget, thisRealm.[[Intrinsics]].[[%RegExp%]]) is true'
@@ -1820,6 +1863,46 @@ ThrowCompletionOr<void> Add::execute_impl(Bytecode::Interpreter& interpreter) co
     return {};
 }
 
+ThrowCompletionOr<void> Div::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    auto& vm = interpreter.vm();
+    auto const lhs = interpreter.get(m_lhs);
+    auto const rhs = interpreter.get(m_rhs);
+
+    if (lhs.is_number() && rhs.is_number()) {
+        interpreter.set(m_dst, Value(lhs.as_double() / rhs.as_double()));
+        return {};
+    }
+
+    interpreter.set(m_dst, TRY(div(vm, lhs, rhs)));
+    return {};
+}
+
+ThrowCompletionOr<void> Mod::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    auto& vm = interpreter.vm();
+    auto const lhs = interpreter.get(m_lhs);
+    auto const rhs = interpreter.get(m_rhs);
+
+    if (lhs.is_int32() && rhs.is_int32()) {
+        // NOTE: A negative dividend may produce -0, and a zero divisor produces NaN, so those go through fmod() below.
+        auto n = lhs.as_i32();
+        auto d = rhs.as_i32();
+        if (n >= 0 && d > 0) {
+            interpreter.set(m_dst, Value(n % d));
+            return {};
+        }
+    }
+
+    if (lhs.is_number() && rhs.is_number()) {
+        interpreter.set(m_dst, Value(fmod(lhs.as_double(), rhs.as_double())));
+        return {};
+    }
+
+    interpreter.set(m_dst, TRY(mod(vm, lhs, rhs)));
+    return {};
+}
+
 ThrowCompletionOr<void> Mul::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto& vm = interpreter.vm();
@@ -2539,7 +2622,8 @@ ThrowCompletionOr<void> Call::execute_impl(Bytecode::Interpreter& interpreter) c
         return {};
     }
 
-    Vector<Value> argument_values;
+    // NOTE: The callee copies the arguments into its own execution context, so most calls can pass them from the stack.
+    Vector<Value, 8> argument_values;
     argument_values.ensure_capacity(m_argument_count);
     for (size_t i = 0; i < m_argument_count; ++i)
         argument_values.unchecked_append(interpreter.get(m_arguments[i]));
@@ -2719,13 +2803,7 @@ void PrepareYield::execute_impl(Bytecode::Interpreter& interpreter) const
 void Await::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto yielded_value = interpreter.get(m_argument).value_or(js_undefined());
-    auto object = Object::create(interpreter.realm(), nullptr);
-    object->define_direct_property("result", yielded_value, JS::default_attributes);
-    // FIXME: If we get a pointer, which is not accurately representable as a double
-    //        will cause this to explode
-    object->define_direct_property("continuation", Value(m_continuation_label.address()), JS::default_attributes);
-    object->define_direct_property("isAwait", Value(true), JS::default_attributes);
-    interpreter.do_return(object);
+    interpreter.do_return(GeneratorResult::create(interpreter.realm(), yielded_value, m_continuation_label.address(), true));
 }
 
 ThrowCompletionOr<void> GetByValue::execute_impl(Bytecode::Interpreter& interpreter) const
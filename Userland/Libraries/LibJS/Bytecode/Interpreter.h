@@ -102,6 +102,7 @@ private:
 };
 
 extern bool g_dump_bytecode;
+extern bool g_dump_bytecode_passes;
 
 ThrowCompletionOr<NonnullGCPtr<Bytecode::Executable>> compile(VM&, ASTNode const&, JS::FunctionKind kind, DeprecatedFlyString const& name);
 ThrowCompletionOr<NonnullGCPtr<Bytecode::Executable>> compile(VM&, ECMAScriptFunctionObject const&);
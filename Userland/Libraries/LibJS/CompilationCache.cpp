@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/CompilationCache.h>
+#include <LibJS/SourceCode.h>
+
+namespace JS {
+
+static size_t source_length_of(Program const& program)
+{
+    return program.source_code().code().bytes().size();
+}
+
+RefPtr<Program> CompilationCache::find(Program::Type type, StringView source_text, StringView filename, size_t line_number_offset)
+{
+    if (source_text.length() < minimum_source_length_to_cache)
+        return nullptr;
+
+    auto source_hash = source_text.hash();
+    auto* entry = m_entries.find_if([&](Entry const& candidate) {
+        if (candidate.type != type || candidate.source_hash != source_hash || candidate.line_number_offset != line_number_offset)
+            return false;
+        auto const& source_code = candidate.program->source_code();
+        return source_code.filename() == filename && source_code.code().bytes_as_string_view() == source_text;
+    });
+    if (!entry)
+        return nullptr;
+    return entry->program;
+}
+
+void CompilationCache::add(Program::Type type, StringView source_text, size_t line_number_offset, NonnullRefPtr<Program> program)
+{
+    auto source_length = source_length_of(program);
+    if (source_text.length() < minimum_source_length_to_cache || source_length > maximum_cached_source_length)
+        return;
+
+    while (!m_entries.is_empty() && m_cached_source_length + source_length > maximum_cached_source_length)
+        m_cached_source_length -= source_length_of(m_entries.take_least_recently_used().program);
+
+    m_entries.add(Entry {
+        .type = type,
+        .source_hash = source_text.hash(),
+        .line_number_offset = line_number_offset,
+        .program = move(program),
+    });
+    m_cached_source_length += source_length;
+}
+
+void CompilationCache::clear()
+{
+    m_entries.clear();
+    m_cached_source_length = 0;
+}
+
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/LRUList.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefPtr.h>
+#include <AK/StringView.h>
+#include <LibJS/AST.h>
+
+namespace JS {
+
+// Keeps recently parsed scripts and modules around so that evaluating the same source text again
+// (e.g. the same framework bundle loaded by another document) skips lexing, parsing and, since
+// bytecode executables are cached on their AST nodes, code generation as well.
+class CompilationCache {
+public:
+    // NOTE: We don't bother caching tiny programs, they are cheap enough to parse again.
+    static constexpr size_t minimum_source_length_to_cache = 1 * KiB;
+    static constexpr size_t maximum_cached_source_length = 32 * MiB;
+
+    RefPtr<Program> find(Program::Type, StringView source_text, StringView filename, size_t line_number_offset);
+    void add(Program::Type, StringView source_text, size_t line_number_offset, NonnullRefPtr<Program>);
+
+    void clear();
+
+    size_t entry_count() const { return m_entries.size(); }
+    size_t cached_source_length() const { return m_cached_source_length; }
+
+private:
+    struct Entry {
+        Program::Type type;
+        u32 source_hash { 0 };
+        size_t line_number_offset { 0 };
+        NonnullRefPtr<Program> program;
+    };
+
+    LRUList<Entry> m_entries;
+    size_t m_cached_source_length { 0 };
+};
+
+}
@@ -160,6 +160,7 @@ class Cell;
 class CellAllocator;
 class ClassExpression;
 struct ClassFieldDefinition;
+class CompilationCache;
 class Completion;
 class Console;
 class CyclicModule;
@@ -204,7 +205,9 @@ class PropertyAttributes;
 class PropertyDescriptor;
 class PropertyKey;
 class Realm;
+class RegExpCache;
 class Reference;
+class SamplingProfiler;
 class ScopeNode;
 class Script;
 class Shape;
@@ -236,6 +239,7 @@ class AsyncFromSyncIteratorPrototype;
 class AsyncGenerator;
 class AsyncGeneratorPrototype;
 class GeneratorPrototype;
+class GeneratorResult;
 class WrapForValidIteratorPrototype;
 
 class TypedArrayBase;
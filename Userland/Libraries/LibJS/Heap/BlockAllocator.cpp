@@ -24,21 +24,28 @@ namespace JS {
 
 BlockAllocator::~BlockAllocator()
 {
-    for (auto* block : m_blocks) {
+    auto unmap_block = [](void* block) {
         ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
         if (munmap(block, HeapBlock::block_size) < 0) {
             perror("munmap");
             VERIFY_NOT_REACHED();
         }
-    }
+    };
+    for (auto* block : m_blocks)
+        unmap_block(block);
+    for (auto* block : m_dirty_blocks)
+        unmap_block(block);
 }
 
 void* BlockAllocator::allocate_block([[maybe_unused]] char const* name)
 {
-    if (!m_blocks.is_empty()) {
+    // Prefer blocks that are still backed by physical memory, so we don't have to fault their pages back in.
+    for (auto* cache : { &m_dirty_blocks, &m_blocks }) {
+        if (cache->is_empty())
+            continue;
         // To reduce predictability, take a random block from the cache.
-        size_t random_index = get_random_uniform(m_blocks.size());
-        auto* block = m_blocks.unstable_take(random_index);
+        size_t random_index = get_random_uniform(cache->size());
+        auto* block = cache->unstable_take(random_index);
         ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
         LSAN_REGISTER_ROOT_REGION(block, HeapBlock::block_size);
         return block;
@@ -54,6 +61,22 @@ void BlockAllocator::deallocate_block(void* block)
 {
     VERIFY(block);
 
+    ASAN_POISON_MEMORY_REGION(block, HeapBlock::block_size);
+    LSAN_UNREGISTER_ROOT_REGION(block, HeapBlock::block_size);
+    m_dirty_blocks.append(block);
+}
+
+void BlockAllocator::decommit_dirty_blocks()
+{
+    for (auto* block : m_dirty_blocks) {
+        decommit_block(block);
+        m_blocks.append(block);
+    }
+    m_dirty_blocks.clear();
+}
+
+void BlockAllocator::decommit_block(void* block)
+{
 #if defined(USE_FALLBACK_BLOCK_DEALLOCATION)
     // If we can't use any of the nicer techniques, unmap and remap the block to return the physical pages while keeping the VM.
     if (munmap(block, HeapBlock::block_size) < 0) {
@@ -64,6 +87,8 @@ void BlockAllocator::deallocate_block(void* block)
         perror("mmap");
         VERIFY_NOT_REACHED();
     }
+    // NOTE: The fresh mapping is not poisoned, so make sure it stays that way until the block is handed out again.
+    ASAN_POISON_MEMORY_REGION(block, HeapBlock::block_size);
 #elif defined(MADV_FREE)
     if (madvise(block, HeapBlock::block_size, MADV_FREE) < 0) {
         perror("madvise(MADV_FREE)");
@@ -75,10 +100,6 @@ void BlockAllocator::deallocate_block(void* block)
         VERIFY_NOT_REACHED();
     }
 #endif
-
-    ASAN_POISON_MEMORY_REGION(block, HeapBlock::block_size);
-    LSAN_UNREGISTER_ROOT_REGION(block, HeapBlock::block_size);
-    m_blocks.append(block);
 }
 
 }
@@ -19,8 +19,18 @@ public:
     void* allocate_block(char const* name);
     void deallocate_block(void*);
 
+    // Returns the physical memory backing every block that has been deallocated since the last call to the OS.
+    void decommit_dirty_blocks();
+
 private:
+    static void decommit_block(void*);
+
+    // Blocks whose physical memory has been returned to the OS.
     Vector<void*> m_blocks;
+
+    // Deallocated blocks that are still backed by physical memory. We hang on to these until
+    // the next garbage collection, since they are cheaper to reuse than decommitted blocks.
+    Vector<void*> m_dirty_blocks;
 };
 
 }
@@ -12,14 +12,18 @@
 #include <AK/JsonObject.h>
 #include <AK/Platform.h>
 #include <AK/StackInfo.h>
+#include <AK/Stream.h>
+#include <AK/StringBuilder.h>
 #include <AK/TemporaryChange.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibCore/Tracing.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Heap/CellAllocator.h>
 #include <LibJS/Heap/Handle.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Heap/HeapBlock.h>
 #include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/WeakContainer.h>
 #include <LibJS/SafeFunction.h>
 #include <setjmp.h>
@@ -67,7 +71,9 @@ void Heap::will_allocate(size_t size)
     m_allocated_bytes_since_last_gc += size;
 }
 
-static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
+// NOTE: We deliberately collect possible pointers into a Vector rather than a hash table, since most of the
+//       words we scan are not pointers into the heap at all, and duplicates are cheap to weed out later.
+static void add_possible_value(Vector<PossibleCellPointer>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
 {
     if constexpr (sizeof(FlatPtr*) == sizeof(Value)) {
         // Because Value stores pointers in non-canonical form we have to check if the top bytes
@@ -80,14 +86,14 @@ static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, Fl
             possible_pointer = data;
         if (possible_pointer < min_block_address || possible_pointer > max_block_address)
             return;
-        possible_pointers.set(possible_pointer, move(origin));
+        possible_pointers.append({ possible_pointer, origin });
     } else {
         static_assert((sizeof(Value) % sizeof(FlatPtr*)) == 0);
         if (data < min_block_address || data > max_block_address)
             return;
         // In the 32-bit case we will look at the top and bottom part of Value separately we just
         // add both the upper and lower bytes as possible pointers.
-        possible_pointers.set(data, move(origin));
+        possible_pointers.append({ data, origin });
     }
 }
 
@@ -101,31 +107,69 @@ void Heap::find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_a
     }
 }
 
+HashTable<HeapBlock*> Heap::gather_all_live_heap_blocks()
+{
+    HashTable<HeapBlock*> all_live_heap_blocks;
+    for_each_block([&](auto& block) {
+        all_live_heap_blocks.set(&block);
+        return IterationDecision::Continue;
+    });
+    return all_live_heap_blocks;
+}
+
 template<typename Callback>
-static void for_each_cell_among_possible_pointers(HashTable<HeapBlock*> const& all_live_heap_blocks, HashMap<FlatPtr, HeapRoot>& possible_pointers, Callback callback)
+static void for_each_cell_among_possible_pointers(HashTable<HeapBlock*> const& all_live_heap_blocks, Vector<PossibleCellPointer> const& possible_pointers, Callback callback)
 {
-    for (auto possible_pointer : possible_pointers.keys()) {
-        if (!possible_pointer)
+    // OPTIMIZATION: Neighboring words very often point into the same block, so remember the outcome of the last block lookup.
+    HeapBlock* last_heap_block = nullptr;
+    bool last_heap_block_is_live = false;
+
+    for (auto const& possible_pointer : possible_pointers) {
+        if (!possible_pointer.address)
             continue;
-        auto* possible_heap_block = HeapBlock::from_cell(reinterpret_cast<Cell const*>(possible_pointer));
-        if (!all_live_heap_blocks.contains(possible_heap_block))
+        auto* possible_heap_block = HeapBlock::from_cell(reinterpret_cast<Cell const*>(possible_pointer.address));
+        if (possible_heap_block != last_heap_block) {
+            last_heap_block = possible_heap_block;
+            last_heap_block_is_live = all_live_heap_blocks.contains(possible_heap_block);
+        }
+        if (!last_heap_block_is_live)
             continue;
-        if (auto* cell = possible_heap_block->cell_from_possible_pointer(possible_pointer)) {
-            callback(cell, possible_pointer);
+        if (auto* cell = possible_heap_block->cell_from_possible_pointer(possible_pointer.address)) {
+            callback(cell, possible_pointer.origin);
         }
     }
 }
 
+static ByteString describe_root(HeapRoot const& root)
+{
+    switch (root.type) {
+    case HeapRoot::Type::HeapFunctionCapturedPointer:
+        return "HeapFunctionCapturedPointer";
+    case HeapRoot::Type::Handle:
+        return ByteString::formatted("Handle {} {}:{}", root.location->function_name(), root.location->filename(), root.location->line_number());
+    case HeapRoot::Type::MarkedVector:
+        return "MarkedVector";
+    case HeapRoot::Type::ConservativeVector:
+        return "ConservativeVector";
+    case HeapRoot::Type::RegisterPointer:
+        return "RegisterPointer";
+    case HeapRoot::Type::StackPointer:
+        return "StackPointer";
+    case HeapRoot::Type::VM:
+        return "VM";
+    case HeapRoot::Type::SafeFunction:
+        return ByteString::formatted("SafeFunction {} {}:{}", root.location->function_name(), root.location->filename(), root.location->line_number());
+    }
+    VERIFY_NOT_REACHED();
+}
+
 class GraphConstructorVisitor final : public Cell::Visitor {
 public:
-    explicit GraphConstructorVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    explicit GraphConstructorVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
         : m_heap(heap)
+        , m_all_live_heap_blocks(all_live_heap_blocks)
     {
         m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
 
         for (auto& [root, root_origin] : roots) {
             auto& graph_node = m_graph.ensure(bit_cast<FlatPtr>(root));
@@ -149,13 +193,13 @@ public:
 
     virtual void visit_possible_values(ReadonlyBytes bytes) override
     {
-        HashMap<FlatPtr, HeapRoot> possible_pointers;
+        Vector<PossibleCellPointer> possible_pointers;
 
         auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
         for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
             add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
 
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, HeapRoot const&) {
             if (m_node_being_visited)
                 m_node_being_visited->edges.set(reinterpret_cast<FlatPtr>(&cell));
 
@@ -186,32 +230,8 @@ public:
             }
 
             auto node = AK::JsonObject();
-            if (it.value.root_origin.has_value()) {
-                auto type = it.value.root_origin->type;
-                auto location = it.value.root_origin->location;
-                switch (type) {
-                case HeapRoot::Type::Handle:
-                    node.set("root"sv, ByteString::formatted("Handle {} {}:{}", location->function_name(), location->filename(), location->line_number()));
-                    break;
-                case HeapRoot::Type::MarkedVector:
-                    node.set("root"sv, "MarkedVector");
-                    break;
-                case HeapRoot::Type::RegisterPointer:
-                    node.set("root"sv, "RegisterPointer");
-                    break;
-                case HeapRoot::Type::StackPointer:
-                    node.set("root"sv, "StackPointer");
-                    break;
-                case HeapRoot::Type::VM:
-                    node.set("root"sv, "VM");
-                    break;
-                case HeapRoot::Type::SafeFunction:
-                    node.set("root"sv, ByteString::formatted("SafeFunction {} {}:{}", location->function_name(), location->filename(), location->line_number()));
-                    break;
-                default:
-                    VERIFY_NOT_REACHED();
-                }
-            }
+            if (it.value.root_origin.has_value())
+                node.set("root"sv, describe_root(*it.value.root_origin));
             node.set("class_name"sv, it.value.class_name);
             node.set("edges"sv, edges);
             graph.set(ByteString::number(it.key), node);
@@ -232,46 +252,255 @@ private:
     HashMap<FlatPtr, GraphNode> m_graph;
 
     Heap& m_heap;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
+    HashTable<HeapBlock*> const& m_all_live_heap_blocks;
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
 };
 
 AK::JsonObject Heap::dump_graph()
 {
+    auto all_live_heap_blocks = gather_all_live_heap_blocks();
     HashMap<Cell*, HeapRoot> roots;
-    gather_roots(roots);
-    GraphConstructorVisitor visitor(*this, roots);
+    gather_roots(roots, all_live_heap_blocks);
+    GraphConstructorVisitor visitor(*this, roots, all_live_heap_blocks);
     visitor.visit_all_cells();
     return visitor.dump();
 }
 
+// Writes the cells that are reachable from the roots in the .heapsnapshot format of Chrome's DevTools:
+// https://learn.microsoft.com/en-us/microsoft-edge/devtools-guide-chromium/memory-problems/heap-snapshot-schema
+// Nodes are referred to by their index, so the graph itself only costs a few words per cell and edge. The JSON is
+// written out in chunks as it is generated.
+class HeapSnapshotWriter final : public Cell::Visitor {
+public:
+    HeapSnapshotWriter(Heap& heap, HashMap<Cell*, HeapRoot> const& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
+        : m_all_live_heap_blocks(all_live_heap_blocks)
+    {
+        heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
+
+        // NOTE: Node 0 is the synthetic root the snapshot starts from, its edges lead to all of our roots.
+        m_nodes.append(nullptr);
+        for (auto& [root, root_origin] : roots) {
+            m_edge_targets.append(node_index(*root));
+            m_root_edge_names.append(string_index(describe_root(root_origin)));
+        }
+        m_edge_counts.append(m_edge_targets.size());
+    }
+
+    virtual void visit_impl(Cell& cell) override
+    {
+        m_edge_targets.append(node_index(cell));
+    }
+
+    virtual void visit_possible_values(ReadonlyBytes bytes) override
+    {
+        Vector<PossibleCellPointer> possible_pointers;
+
+        auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
+        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
+            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
+
+        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, HeapRoot const&) {
+            m_edge_targets.append(node_index(*cell));
+        });
+    }
+
+    void visit_all_cells()
+    {
+        // NOTE: Newly found cells are appended to m_nodes, so this visits them in breadth-first order,
+        //       and the edges of each node end up next to each other in m_edge_targets.
+        for (size_t index = 1; index < m_nodes.size(); ++index) {
+            auto edge_count_before = m_edge_targets.size();
+            m_nodes[index]->visit_edges(*this);
+            m_edge_counts.append(m_edge_targets.size() - edge_count_before);
+        }
+    }
+
+    ErrorOr<void> write(Stream& stream)
+    {
+        m_builder.appendff(R"~~~({{"snapshot":{{"meta":{{)~~~"
+                           R"~~~("node_fields":["type","name","id","self_size","edge_count","trace_node_id","detachedness"],)~~~"
+                           R"~~~("node_types":[["hidden","array","string","object","code","closure","regexp","number","native","synthetic","concatenated string","sliced string","symbol","bigint","object shape"],"string","number","number","number","number","number"],)~~~"
+                           R"~~~("edge_fields":["type","name_or_index","to_node"],)~~~"
+                           R"~~~("edge_types":[["context","element","property","internal","hidden","shortcut","weak"],"string_or_number","node"]}},)~~~"
+                           R"~~~("node_count":{},"edge_count":{},"trace_function_count":0}},)~~~"
+                           "\n",
+            m_nodes.size(), m_edge_targets.size());
+
+        m_builder.append("\"nodes\":["sv);
+        for (size_t index = 0; index < m_nodes.size(); ++index) {
+            auto* cell = m_nodes[index];
+            auto type = cell ? NodeType::Object : NodeType::Synthetic;
+            auto name = cell ? string_index(cell->class_name()) : string_index("(GC roots)"sv);
+            auto self_size = cell ? HeapBlock::from_cell(cell)->cell_size() : 0;
+
+            // NOTE: The IDs of objects are odd by convention. They're only stable within a single snapshot.
+            m_builder.appendff("{}{},{},{},{},{},0,0\n", index == 0 ? "" : ",", to_underlying(type), name, index * 2 + 1, self_size, m_edge_counts[index]);
+            TRY(flush_if_needed(stream));
+        }
+
+        m_builder.append("],\n\"edges\":["sv);
+        size_t edge_index = 0;
+        for (size_t index = 0; index < m_nodes.size(); ++index) {
+            for (size_t i = 0; i < m_edge_counts[index]; ++i, ++edge_index) {
+                auto to_node = m_edge_targets[edge_index] * node_field_count;
+
+                // NOTE: Cells don't tell us where they keep their references, so we only name the edges from the
+                //       synthetic root after the kind of root they lead to.
+                if (index == 0)
+                    m_builder.appendff("{}{},{},{}\n", edge_index == 0 ? "" : ",", to_underlying(EdgeType::Internal), m_root_edge_names[i], to_node);
+                else
+                    m_builder.appendff("{}{},{},{}\n", edge_index == 0 ? "" : ",", to_underlying(EdgeType::Element), i, to_node);
+                TRY(flush_if_needed(stream));
+            }
+        }
+
+        m_builder.append("],\n\"strings\":["sv);
+        for (size_t index = 0; index < m_strings.size(); ++index) {
+            if (index != 0)
+                m_builder.append(',');
+            m_builder.append('"');
+            m_builder.append_escaped_for_json(m_strings[index]);
+            m_builder.append("\"\n"sv);
+            TRY(flush_if_needed(stream));
+        }
+        m_builder.append("]}\n"sv);
+
+        return flush(stream);
+    }
+
+private:
+    // NOTE: These are indices into the node_types and edge_types arrays in the meta data above.
+    enum class NodeType : u8 {
+        Object = 3,
+        Synthetic = 9,
+    };
+    enum class EdgeType : u8 {
+        Element = 1,
+        Internal = 3,
+    };
+    static constexpr size_t node_field_count = 7;
+    static constexpr size_t flush_threshold = 64 * KiB;
+
+    u32 node_index(Cell& cell)
+    {
+        return m_node_indices.ensure(&cell, [&] {
+            m_nodes.append(&cell);
+            return static_cast<u32>(m_nodes.size() - 1);
+        });
+    }
+
+    u32 string_index(StringView string)
+    {
+        if (auto index = m_string_indices.get(string); index.has_value())
+            return *index;
+        auto index = static_cast<u32>(m_strings.size());
+        m_strings.append(string);
+        m_string_indices.set(m_strings.last().view(), index);
+        return index;
+    }
+
+    ErrorOr<void> flush_if_needed(Stream& stream)
+    {
+        if (m_builder.length() < flush_threshold)
+            return {};
+        return flush(stream);
+    }
+
+    ErrorOr<void> flush(Stream& stream)
+    {
+        TRY(stream.write_until_depleted(m_builder.string_view().bytes()));
+        m_builder.clear();
+        return {};
+    }
+
+    Vector<Cell*> m_nodes;
+    HashMap<Cell*, u32> m_node_indices;
+    Vector<u32> m_edge_counts;
+    Vector<u32> m_edge_targets;
+    Vector<u32> m_root_edge_names;
+
+    // NOTE: The keys are views into m_strings, whose storage doesn't move when the vector grows.
+    Vector<ByteString> m_strings;
+    HashMap<StringView, u32> m_string_indices;
+
+    StringBuilder m_builder;
+
+    HashTable<HeapBlock*> const& m_all_live_heap_blocks;
+    FlatPtr m_min_block_address;
+    FlatPtr m_max_block_address;
+};
+
+ErrorOr<void> Heap::write_heap_snapshot(Stream& stream)
+{
+    auto all_live_heap_blocks = gather_all_live_heap_blocks();
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots, all_live_heap_blocks);
+    HeapSnapshotWriter writer(*this, roots, all_live_heap_blocks);
+    writer.visit_all_cells();
+    return writer.write(stream);
+}
+
 void Heap::collect_garbage(CollectionType collection_type, bool print_report)
 {
     VERIFY(!m_collecting_garbage);
     TemporaryChange change(m_collecting_garbage, true);
 
-    Core::ElapsedTimer collection_measurement_timer;
-    if (print_report)
-        collection_measurement_timer.start();
+    if (collection_type == CollectionType::CollectGarbage && m_gc_deferrals) {
+        m_should_gc_when_deferral_ends = true;
+        return;
+    }
+
+    Core::Tracing::ScopedEvent trace_event { Core::Tracing::Category::GC, "Heap::collect_garbage"sv };
+
+    m_last_collection_statistics = {};
+    m_last_collection_statistics.type = collection_type;
+
+    auto phase_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    auto end_phase = [&](AK::Duration& phase_time) {
+        phase_time = phase_timer.elapsed_time();
+        phase_timer.start();
+    };
 
     if (collection_type == CollectionType::CollectGarbage) {
-        if (m_gc_deferrals) {
-            m_should_gc_when_deferral_ends = true;
-            return;
-        }
+        // NOTE: Both conservative root scanning and marking need to know which blocks are live,
+        //       so we gather them once up front instead of walking every block twice.
+        auto all_live_heap_blocks = gather_all_live_heap_blocks();
         HashMap<Cell*, HeapRoot> roots;
-        gather_roots(roots);
-        mark_live_cells(roots);
+        gather_roots(roots, all_live_heap_blocks);
+        end_phase(m_last_collection_statistics.root_gathering_time);
+
+        mark_live_cells(roots, all_live_heap_blocks);
+        end_phase(m_last_collection_statistics.marking_time);
     }
+
     finalize_unmarked_cells();
-    sweep_dead_cells(print_report, collection_measurement_timer);
+    end_phase(m_last_collection_statistics.finalization_time);
+
+    sweep_dead_cells();
+    end_phase(m_last_collection_statistics.sweeping_time);
+
+    ++m_collection_count;
+    m_total_collection_time += m_last_collection_statistics.total_time();
+
+    if (print_report)
+        print_collection_report();
+}
+
+void Heap::collect_garbage_if_close_to_threshold()
+{
+    if (m_collecting_garbage || m_gc_deferrals)
+        return;
+    if (m_allocated_bytes_since_last_gc < m_gc_bytes_threshold / 100 * GC_IDLE_THRESHOLD_PERCENTAGE)
+        return;
+    m_allocated_bytes_since_last_gc = 0;
+    collect_garbage();
 }
 
-void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
+void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
 {
     vm().gather_roots(roots);
-    gather_conservative_roots(roots);
+    gather_conservative_roots(roots, all_live_heap_blocks);
 
     for (auto& handle : m_handles)
         roots.set(handle.cell(), HeapRoot { .type = HeapRoot::Type::Handle, .location = &handle.source_location() });
@@ -287,7 +516,7 @@ void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
 }
 
 #ifdef HAS_ADDRESS_SANITIZER
-NO_SANITIZE_ADDRESS void Heap::gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr addr, FlatPtr min_block_address, FlatPtr max_block_address)
+NO_SANITIZE_ADDRESS void Heap::gather_asan_fake_stack_roots(Vector<PossibleCellPointer>& possible_pointers, FlatPtr addr, FlatPtr min_block_address, FlatPtr max_block_address)
 {
     void* begin = nullptr;
     void* end = nullptr;
@@ -303,12 +532,12 @@ NO_SANITIZE_ADDRESS void Heap::gather_asan_fake_stack_roots(HashMap<FlatPtr, Hea
     }
 }
 #else
-void Heap::gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr, FlatPtr)
+void Heap::gather_asan_fake_stack_roots(Vector<PossibleCellPointer>&, FlatPtr, FlatPtr, FlatPtr)
 {
 }
 #endif
 
-NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot>& roots)
+NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot>& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
 {
     FlatPtr dummy;
 
@@ -317,7 +546,7 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
     jmp_buf buf;
     setjmp(buf);
 
-    HashMap<FlatPtr, HeapRoot> possible_pointers;
+    Vector<PossibleCellPointer> possible_pointers;
 
     auto* raw_jmp_buf = reinterpret_cast<FlatPtr const*>(buf);
 
@@ -340,8 +569,8 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
     //       This is where JS::SafeFunction closures get marked.
     if (s_custom_ranges_for_conservative_scan) {
         for (auto& custom_range : *s_custom_ranges_for_conservative_scan) {
+            auto safe_function_location = s_safe_function_locations->get(custom_range.key);
             for (size_t i = 0; i < (custom_range.value / sizeof(FlatPtr)); ++i) {
-                auto safe_function_location = s_safe_function_locations->get(custom_range.key);
                 add_possible_value(possible_pointers, custom_range.key[i], HeapRoot { .type = HeapRoot::Type::SafeFunction, .location = *safe_function_location }, min_block_address, max_block_address);
             }
         }
@@ -353,16 +582,10 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
         }
     }
 
-    HashTable<HeapBlock*> all_live_heap_blocks;
-    for_each_block([&](auto& block) {
-        all_live_heap_blocks.set(&block);
-        return IterationDecision::Continue;
-    });
-
-    for_each_cell_among_possible_pointers(all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr possible_pointer) {
+    for_each_cell_among_possible_pointers(all_live_heap_blocks, possible_pointers, [&](Cell* cell, HeapRoot const& origin) {
         if (cell->state() == Cell::State::Live) {
             dbgln_if(HEAP_DEBUG, "  ?-> {}", (void const*)cell);
-            roots.set(cell, *possible_pointers.get(possible_pointer));
+            roots.set(cell, origin);
         } else {
             dbgln_if(HEAP_DEBUG, "  #-> {}", (void const*)cell);
         }
@@ -371,14 +594,11 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
         : m_heap(heap)
+        , m_all_live_heap_blocks(all_live_heap_blocks)
     {
         m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
 
         for (auto* root : roots.keys()) {
             visit(root);
@@ -397,13 +617,13 @@ public:
 
     virtual void visit_possible_values(ReadonlyBytes bytes) override
     {
-        HashMap<FlatPtr, HeapRoot> possible_pointers;
+        Vector<PossibleCellPointer> possible_pointers;
 
         auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
         for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
             add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
 
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, HeapRoot const&) {
             if (cell->is_marked())
                 return;
             if (cell->state() != Cell::State::Live)
@@ -423,16 +643,16 @@ public:
 private:
     Heap& m_heap;
     Vector<NonnullGCPtr<Cell>> m_work_queue;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
+    HashTable<HeapBlock*> const& m_all_live_heap_blocks;
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
 };
 
-void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
+void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots, HashTable<HeapBlock*> const& all_live_heap_blocks)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
-    MarkingVisitor visitor(*this, roots);
+    MarkingVisitor visitor(*this, roots, all_live_heap_blocks);
 
     visitor.mark_all_live_cells();
 
@@ -460,43 +680,63 @@ void Heap::finalize_unmarked_cells()
     });
 }
 
-void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+void Heap::sweep_dead_cells()
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
     Vector<HeapBlock*, 32> empty_blocks;
     Vector<HeapBlock*, 32> full_blocks_that_became_usable;
 
-    size_t collected_cells = 0;
-    size_t live_cells = 0;
-    size_t collected_cell_bytes = 0;
-    size_t live_cell_bytes = 0;
+    auto& statistics = m_last_collection_statistics;
 
-    for_each_block([&](auto& block) {
-        bool block_has_live_cells = false;
-        bool block_was_full = block.is_full();
-        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
-            if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
-                dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                block.deallocate(cell);
-                ++collected_cells;
-                collected_cell_bytes += block.cell_size();
-            } else {
-                cell->set_marked(false);
-                block_has_live_cells = true;
-                ++live_cells;
-                live_cell_bytes += block.cell_size();
-            }
+    for (auto& allocator : m_all_cell_allocators) {
+        CollectionStatistics::AllocatorStatistics allocator_statistics {
+            .class_name = allocator.class_name(),
+            .cell_size = allocator.cell_size(),
+        };
+
+        allocator.for_each_block([&](auto& block) {
+            bool block_has_live_cells = false;
+            bool block_was_full = block.is_full();
+            block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+                if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
+                    dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+                    block.deallocate(cell);
+                    ++allocator_statistics.collected_cells;
+                } else {
+                    cell->set_marked(false);
+                    block_has_live_cells = true;
+                    ++allocator_statistics.live_cells;
+                }
+            });
+            if (!block_has_live_cells)
+                empty_blocks.append(&block);
+            else if (block_was_full != block.is_full())
+                full_blocks_that_became_usable.append(&block);
+            ++statistics.live_blocks;
+            return IterationDecision::Continue;
         });
-        if (!block_has_live_cells)
-            empty_blocks.append(&block);
-        else if (block_was_full != block.is_full())
-            full_blocks_that_became_usable.append(&block);
-        return IterationDecision::Continue;
-    });
+
+        statistics.live_cells += allocator_statistics.live_cells;
+        statistics.live_cell_bytes += allocator_statistics.live_cells * allocator_statistics.cell_size;
+        statistics.collected_cells += allocator_statistics.collected_cells;
+        statistics.collected_cell_bytes += allocator_statistics.collected_cells * allocator_statistics.cell_size;
+
+        if (allocator_statistics.live_cells || allocator_statistics.collected_cells)
+            statistics.allocators.append(allocator_statistics);
+    }
+
+    statistics.live_blocks -= empty_blocks.size();
+    statistics.freed_blocks = empty_blocks.size();
 
     for (auto& weak_container : m_weak_containers)
         weak_container.remove_dead_cells({});
 
+    // NOTE: Blocks that became empty during the previous collection and haven't been reused since are
+    //       unlikely to be needed again soon, so now is a good time to give their memory back to the OS.
+    //       This keeps the madvise() churn for blocks that get reused right away out of the collection.
+    for (auto& allocator : m_all_cell_allocators)
+        allocator.block_allocator().decommit_dirty_blocks();
+
     for (auto* block : empty_blocks) {
         dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
         block->cell_allocator().block_did_become_empty({}, *block);
@@ -514,25 +754,98 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         });
     }
 
-    m_gc_bytes_threshold = live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
+    m_gc_bytes_threshold = statistics.live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? statistics.live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
+}
+
+void Heap::print_collection_report() const
+{
+    auto const& statistics = m_last_collection_statistics;
+
+    dbgln("Garbage collection report");
+    dbgln("=============================================");
+    dbgln("     Time spent: {} ms", statistics.total_time().to_milliseconds());
+    dbgln("   Gather roots: {} ms", statistics.root_gathering_time.to_milliseconds());
+    dbgln("        Marking: {} ms", statistics.marking_time.to_milliseconds());
+    dbgln("   Finalization: {} ms", statistics.finalization_time.to_milliseconds());
+    dbgln("       Sweeping: {} ms", statistics.sweeping_time.to_milliseconds());
+    dbgln("     Live cells: {} ({} bytes)", statistics.live_cells, statistics.live_cell_bytes);
+    dbgln("Collected cells: {} ({} bytes)", statistics.collected_cells, statistics.collected_cell_bytes);
+    dbgln("    Live blocks: {} ({} bytes)", statistics.live_blocks, statistics.live_blocks * HeapBlock::block_size);
+    dbgln("   Freed blocks: {} ({} bytes)", statistics.freed_blocks, statistics.freed_blocks * HeapBlock::block_size);
+    dbgln("=============================================");
+}
 
-    if (print_report) {
-        AK::Duration const time_spent = measurement_timer.elapsed_time();
-        size_t live_block_count = 0;
-        for_each_block([&](auto&) {
-            ++live_block_count;
+Vector<Heap::AllocatorMemoryUsage> Heap::allocator_memory_usage()
+{
+    Vector<AllocatorMemoryUsage> usage;
+    for (auto& allocator : m_all_cell_allocators) {
+        AllocatorMemoryUsage allocator_usage {
+            .class_name = allocator.class_name(),
+            .cell_size = allocator.cell_size(),
+        };
+        allocator.for_each_block([&](auto& block) {
+            ++allocator_usage.block_count;
+            block.template for_each_cell_in_state<Cell::State::Live>([&](Cell*) {
+                ++allocator_usage.live_cells;
+            });
             return IterationDecision::Continue;
         });
+        if (allocator_usage.block_count != 0)
+            usage.append(allocator_usage);
+    }
+    return usage;
+}
 
-        dbgln("Garbage collection report");
-        dbgln("=============================================");
-        dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
-        dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
-        dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
-        dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
-        dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
-        dbgln("=============================================");
+AK::JsonObject Heap::dump_statistics() const
+{
+    auto const& statistics = m_last_collection_statistics;
+
+    auto allocators = AK::JsonArray();
+    for (auto const& allocator_statistics : statistics.allocators) {
+        auto allocator = AK::JsonObject();
+        if (allocator_statistics.class_name)
+            allocator.set("class_name"sv, allocator_statistics.class_name);
+        else
+            allocator.set("class_name"sv, ByteString::formatted("<size class {}>", allocator_statistics.cell_size));
+        allocator.set("cell_size"sv, allocator_statistics.cell_size);
+        allocator.set("live_cells"sv, allocator_statistics.live_cells);
+        allocator.set("live_bytes"sv, allocator_statistics.live_cells * allocator_statistics.cell_size);
+        allocator.set("collected_cells"sv, allocator_statistics.collected_cells);
+        allocator.set("collected_bytes"sv, allocator_statistics.collected_cells * allocator_statistics.cell_size);
+        allocators.must_append(move(allocator));
     }
+
+    auto last_collection = AK::JsonObject();
+    last_collection.set("type"sv, statistics.type == CollectionType::CollectGarbage ? "CollectGarbage"sv : "CollectEverything"sv);
+    last_collection.set("total_time_us"sv, statistics.total_time().to_microseconds());
+    last_collection.set("root_gathering_time_us"sv, statistics.root_gathering_time.to_microseconds());
+    last_collection.set("marking_time_us"sv, statistics.marking_time.to_microseconds());
+    last_collection.set("finalization_time_us"sv, statistics.finalization_time.to_microseconds());
+    last_collection.set("sweeping_time_us"sv, statistics.sweeping_time.to_microseconds());
+    last_collection.set("live_cells"sv, statistics.live_cells);
+    last_collection.set("live_cell_bytes"sv, statistics.live_cell_bytes);
+    last_collection.set("collected_cells"sv, statistics.collected_cells);
+    last_collection.set("collected_cell_bytes"sv, statistics.collected_cell_bytes);
+    last_collection.set("live_blocks"sv, statistics.live_blocks);
+    last_collection.set("freed_blocks"sv, statistics.freed_blocks);
+    last_collection.set("allocators"sv, move(allocators));
+
+    auto shape_statistics = Shape::memory_statistics();
+    auto shapes = AK::JsonObject();
+    shapes.set("property_table_count"sv, shape_statistics.property_table_count);
+    shapes.set("shared_property_table_count"sv, shape_statistics.shared_property_table_count);
+    shapes.set("property_table_entry_count"sv, shape_statistics.property_table_entry_count);
+    shapes.set("property_table_bytes"sv, shape_statistics.property_table_bytes);
+
+    auto result = AK::JsonObject();
+    result.set("collection_count"sv, m_collection_count);
+    result.set("total_collection_time_us"sv, m_total_collection_time.to_microseconds());
+    result.set("allocated_bytes_since_last_gc"sv, m_allocated_bytes_since_last_gc);
+    result.set("gc_bytes_threshold"sv, m_gc_bytes_threshold);
+    if (m_collection_count > 0)
+        result.set("last_collection"sv, move(last_collection));
+    result.set("shapes"sv, move(shapes));
+    return result;
 }
 
 void Heap::defer_gc()
@@ -11,6 +11,7 @@
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -28,6 +29,12 @@
 
 namespace JS {
 
+// A word found during conservative scanning that might be a pointer to a cell.
+struct PossibleCellPointer {
+    FlatPtr address;
+    HeapRoot origin;
+};
+
 class Heap : public HeapBase {
     AK_MAKE_NONCOPYABLE(Heap);
     AK_MAKE_NONMOVABLE(Heap);
@@ -63,9 +70,63 @@ public:
         CollectEverything,
     };
 
+    struct CollectionStatistics {
+        struct AllocatorStatistics {
+            // NOTE: This is null for the size-based allocators shared by all cell types.
+            char const* class_name { nullptr };
+            size_t cell_size { 0 };
+            size_t live_cells { 0 };
+            size_t collected_cells { 0 };
+        };
+
+        CollectionType type { CollectionType::CollectGarbage };
+
+        AK::Duration root_gathering_time;
+        AK::Duration marking_time;
+        AK::Duration finalization_time;
+        AK::Duration sweeping_time;
+
+        size_t live_cells { 0 };
+        size_t live_cell_bytes { 0 };
+        size_t collected_cells { 0 };
+        size_t collected_cell_bytes { 0 };
+        size_t live_blocks { 0 };
+        size_t freed_blocks { 0 };
+
+        Vector<AllocatorStatistics> allocators;
+
+        AK::Duration total_time() const { return root_gathering_time + marking_time + finalization_time + sweeping_time; }
+    };
+
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
+
+    // Collects garbage if we've already allocated a sizable chunk of the way towards the next automatic collection.
+    // Hosts should call this when they are idle, so that collections are less likely to interrupt running script.
+    void collect_garbage_if_close_to_threshold();
     AK::JsonObject dump_graph();
 
+    // Writes the cells that are reachable from the roots as a Chrome DevTools heap snapshot. Unlike dump_graph(),
+    // this doesn't build the whole document in memory first, which makes it usable for large heaps.
+    ErrorOr<void> write_heap_snapshot(Stream&);
+    AK::JsonObject dump_statistics() const;
+
+    struct AllocatorMemoryUsage {
+        // NOTE: This is null for the size-based allocators shared by all cell types.
+        char const* class_name { nullptr };
+        size_t cell_size { 0 };
+        size_t block_count { 0 };
+        size_t live_cells { 0 };
+    };
+
+    // The memory every allocator is holding on to right now. This doesn't collect garbage first, so cells that are
+    // garbage but haven't been collected yet are counted as live.
+    Vector<AllocatorMemoryUsage> allocator_memory_usage();
+
+    CollectionStatistics const& last_collection_statistics() const { return m_last_collection_statistics; }
+    size_t collection_count() const { return m_collection_count; }
+    AK::Duration total_collection_time() const { return m_total_collection_time; }
+    size_t allocated_bytes_since_last_gc() const { return m_allocated_bytes_since_last_gc; }
+
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
@@ -91,6 +152,7 @@ public:
 private:
     friend class MarkingVisitor;
     friend class GraphConstructorVisitor;
+    friend class HeapSnapshotWriter;
     friend class DeferGC;
 
     void defer_gc();
@@ -113,12 +175,14 @@ private:
     void will_allocate(size_t);
 
     void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
-    void gather_roots(HashMap<Cell*, HeapRoot>&);
-    void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
-    void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
-    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    HashTable<HeapBlock*> gather_all_live_heap_blocks();
+    void gather_roots(HashMap<Cell*, HeapRoot>&, HashTable<HeapBlock*> const& all_live_heap_blocks);
+    void gather_conservative_roots(HashMap<Cell*, HeapRoot>&, HashTable<HeapBlock*> const& all_live_heap_blocks);
+    void gather_asan_fake_stack_roots(Vector<PossibleCellPointer>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
+    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells, HashTable<HeapBlock*> const& all_live_heap_blocks);
     void finalize_unmarked_cells();
-    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+    void sweep_dead_cells();
+    void print_collection_report() const;
 
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
     {
@@ -141,11 +205,16 @@ private:
     }
 
     static constexpr size_t GC_MIN_BYTES_THRESHOLD { 4 * 1024 * 1024 };
+    static constexpr size_t GC_IDLE_THRESHOLD_PERCENTAGE { 50 };
     size_t m_gc_bytes_threshold { GC_MIN_BYTES_THRESHOLD };
     size_t m_allocated_bytes_since_last_gc { 0 };
 
     bool m_should_collect_on_every_allocation { false };
 
+    CollectionStatistics m_last_collection_statistics;
+    size_t m_collection_count { 0 };
+    AK::Duration m_total_collection_time;
+
     Vector<NonnullOwnPtr<CellAllocator>> m_size_based_cell_allocators;
     CellAllocator::List m_all_cell_allocators;
 
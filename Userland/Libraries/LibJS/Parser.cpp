@@ -105,7 +105,7 @@ public:
         return scope_pusher;
     }
 
-    static ScopePusher catch_scope(Parser& parser, RefPtr<BindingPattern const> const& pattern, DeprecatedFlyString const& parameter)
+    static ScopePusher catch_scope(Parser& parser, RefPtr<BindingPattern const> const& pattern, RefPtr<Identifier const> const& parameter)
     {
         ScopePusher scope_pusher(parser, nullptr, ScopeLevel::NotTopLevel, ScopeType::Catch);
         if (pattern) {
@@ -114,9 +114,11 @@ public:
                 scope_pusher.m_forbidden_var_names.set(identifier.string());
                 scope_pusher.m_bound_names.set(identifier.string());
             }));
-        } else if (!parameter.is_empty()) {
-            scope_pusher.m_var_names.set(parameter);
-            scope_pusher.m_bound_names.set(parameter);
+        } else if (parameter) {
+            scope_pusher.m_var_names.set(parameter->string());
+            scope_pusher.m_bound_names.set(parameter->string());
+            scope_pusher.register_identifier(const_cast<Identifier&>(*parameter));
+            scope_pusher.m_catch_parameter = parameter;
         }
 
         return scope_pusher;
@@ -170,6 +172,9 @@ public:
                         || pusher->m_forbidden_var_names.contains(name))
                         throw_identifier_declared(name, declaration);
 
+                    if (pusher->m_type == ScopeType::Catch && pusher->m_catch_parameter && pusher->m_catch_parameter->string() == name)
+                        pusher->m_catch_parameter_is_redeclared_by_var = true;
+
                     pusher->m_var_names.set(name);
                     if (pusher->is_top_level())
                         break;
@@ -310,6 +315,25 @@ public:
                     hoistable_function_declaration = true;
             }
 
+            if (m_type == ScopeType::Catch && m_catch_parameter && m_catch_parameter->string() == identifier_group_name) {
+                // NOTE: A simple catch parameter is only visible inside the catch clause, so it can live in a local as long
+                //       as nothing reaches it through an environment. A `var` of the same name in the catch block assigns
+                //       to the parameter (see B.3.4 VariableStatements in Catch Blocks), which is left to the environment.
+                if (!identifier_group.captured_by_nested_function
+                    && !identifier_group.used_inside_with_statement
+                    && !m_screwed_by_eval_in_scope_chain
+                    && !m_catch_parameter_is_redeclared_by_var) {
+                    auto local_scope = last_function_scope();
+                    if (!local_scope)
+                        local_scope = m_top_level_scope;
+
+                    auto local_variable_index = local_scope->m_node->add_local_variable(identifier_group_name);
+                    for (auto& identifier : identifier_group.identifiers)
+                        identifier->set_local_variable_index(local_variable_index);
+                }
+                continue;
+            }
+
             if ((m_type == ScopeType::ClassDeclaration || m_type == ScopeType::Catch) && m_bound_names.contains(identifier_group_name)) {
                 // NOTE: Currently, the parser cannot recognize that assigning a named function expression creates a scope with a binding for the function name.
                 //       As a result, function names are not considered as candidates for optimization in global variable access.
@@ -519,6 +543,9 @@ private:
     bool m_contains_await_expression { false };
     bool m_screwed_by_eval_in_scope_chain { false };
 
+    RefPtr<Identifier const> m_catch_parameter;
+    bool m_catch_parameter_is_redeclared_by_var { false };
+
     // Function uses this binding from function environment if:
     // 1. It's an arrow function or establish parent scope for an arrow function
     // 2. Uses new.target
@@ -748,7 +775,7 @@ bool Parser::parse_directive(ScopeNode& body)
 NonnullRefPtr<Program> Parser::parse_program(bool starts_in_strict_mode)
 {
     auto rule_start = push_start();
-    auto program = adopt_ref(*new Program({ m_source_code, rule_start.position(), position() }, m_program_type));
+    auto program = create_ast_node<Program>({ m_source_code, rule_start.position(), position() }, m_program_type);
     ScopePusher program_scope = ScopePusher::program_scope(*this, *program);
 
     if (m_program_type == Program::Type::Script)
@@ -3756,7 +3783,7 @@ NonnullRefPtr<CatchClause const> Parser::parse_catch_clause()
     auto rule_start = push_start();
     consume(TokenType::Catch);
 
-    DeprecatedFlyString parameter;
+    RefPtr<Identifier const> parameter;
     RefPtr<BindingPattern const> pattern_parameter;
     auto should_expect_parameter = false;
     if (match(TokenType::ParenOpen)) {
@@ -3767,13 +3794,13 @@ NonnullRefPtr<CatchClause const> Parser::parse_catch_clause()
             && (!match(TokenType::Yield) || !m_state.in_generator_function_context)
             && (!match(TokenType::Async) || !m_state.await_expression_is_valid)
             && (!match(TokenType::Await) || !m_state.in_class_static_init_block))
-            parameter = consume().value();
+            parameter = create_ast_node<Identifier const>({ m_source_code, rule_start.position(), position() }, consume().DeprecatedFlyString_value());
         else
             pattern_parameter = parse_binding_pattern(AllowDuplicates::No, AllowMemberExpressions::No);
         consume(TokenType::ParenClose);
     }
 
-    if (should_expect_parameter && parameter.is_empty() && !pattern_parameter)
+    if (should_expect_parameter && !parameter && !pattern_parameter)
         expected("an identifier or a binding pattern");
 
     HashTable<DeprecatedFlyString> bound_names;
@@ -3787,9 +3814,9 @@ NonnullRefPtr<CatchClause const> Parser::parse_catch_clause()
             }));
     }
 
-    if (!parameter.is_empty()) {
-        check_identifier_name_for_assignment_validity(parameter);
-        bound_names.set(parameter);
+    if (parameter) {
+        check_identifier_name_for_assignment_validity(parameter->string());
+        bound_names.set(parameter->string());
     }
 
     ScopePusher catch_scope = ScopePusher::catch_scope(*this, pattern_parameter, parameter);
@@ -3808,9 +3835,15 @@ NonnullRefPtr<CatchClause const> Parser::parse_catch_clause()
             move(body));
     }
 
+    if (parameter) {
+        return create_ast_node<CatchClause>(
+            { m_source_code, rule_start.position(), position() },
+            parameter.release_nonnull(),
+            move(body));
+    }
+
     return create_ast_node<CatchClause>(
         { m_source_code, rule_start.position(), position() },
-        move(parameter),
         move(body));
 }
 
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/RegExpCache.h>
+
+namespace JS {
+
+Optional<Regex<ECMA262>> RegExpCache::find(StringView pattern, StringView flags)
+{
+    auto* entry = m_entries.find_if([&](Entry const& candidate) { return candidate.pattern == pattern && candidate.flags == flags; });
+    if (!entry)
+        return {};
+    return entry->regex.clone();
+}
+
+void RegExpCache::add(ByteString pattern, ByteString flags, Regex<ECMA262> const& regex)
+{
+    if (pattern.length() > maximum_cached_pattern_length)
+        return;
+
+    if (m_entries.size() == maximum_entry_count)
+        (void)m_entries.take_least_recently_used();
+
+    m_entries.add(Entry {
+        .pattern = move(pattern),
+        .flags = move(flags),
+        .regex = regex.clone(),
+    });
+}
+
+void RegExpCache::clear()
+{
+    m_entries.clear();
+}
+
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/LRUList.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <LibRegex/Regex.h>
+
+namespace JS {
+
+// Keeps the compiled bytecode of recently created regular expressions around, so that evaluating the same regex
+// literal or constructing the same RegExp again (e.g. in a loop) skips parsing and optimizing the pattern.
+// Entries are keyed by the source text and flags as written, before any translation of the pattern.
+class RegExpCache {
+public:
+    static constexpr size_t maximum_entry_count = 64;
+
+    // NOTE: We don't bother caching huge patterns, they are rarely created more than once.
+    static constexpr size_t maximum_cached_pattern_length = 16 * KiB;
+
+    Optional<Regex<ECMA262>> find(StringView pattern, StringView flags);
+    void add(ByteString pattern, ByteString flags, Regex<ECMA262> const&);
+
+    void clear();
+
+    size_t entry_count() const { return m_entries.size(); }
+
+private:
+    struct Entry {
+        ByteString pattern;
+        ByteString flags;
+        Regex<ECMA262> regex;
+    };
+
+    LRUList<Entry> m_entries;
+};
+
+}
@@ -178,15 +178,288 @@ ThrowCompletionOr<bool> Array::set_length(PropertyDescriptor const& property_des
     return true;
 }
 
+SimpleIndexedPropertyStorage const* packed_storage_of_array(Object const& object)
+{
+    if (!is<Array>(object))
+        return nullptr;
+    auto const* storage = object.indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage())
+        return nullptr;
+    auto const& simple_storage = static_cast<SimpleIndexedPropertyStorage const&>(*storage);
+    if (!simple_storage.is_packed())
+        return nullptr;
+    return &simple_storage;
+}
+
+Optional<Value> packed_array_element(Object const& object, size_t index)
+{
+    auto const* storage = packed_storage_of_array(object);
+    if (!storage || index >= storage->array_like_size())
+        return {};
+    return storage->elements()[index];
+}
+
+// A TimSort: runs that are already in order (or in strictly descending order, which are reversed) are found first and
+// extended to a minimum length with a binary insertion sort, then merged in an order that keeps the merges balanced.
+// Partially sorted input needs far fewer comparisons than with a plain merge sort. The sort is stable.
+//
+// `is_less_than` returns whether its first argument has to be ordered before its second one. `buffer` has to be as
+// large as `items`. If items are GC values, the buffer has to keep them alive, as comparisons may run a garbage
+// collection while some of the items only live in it.
+template<typename T, typename LessThan>
+static ThrowCompletionOr<void> tim_sort(Span<T> items, Span<T> buffer, LessThan is_less_than)
+{
+    VERIFY(buffer.size() >= items.size());
+
+    auto size = items.size();
+    if (size < 2)
+        return {};
+
+    // Returns the length of the run starting at `start`, after making it ascending.
+    auto count_run_and_make_ascending = [&](size_t start) -> ThrowCompletionOr<size_t> {
+        auto end = start + 1;
+        if (end == size)
+            return 1;
+
+        // NOTE: Descending runs have to be strictly descending, so that reversing them keeps the sort stable.
+        if (TRY(is_less_than(items[end], items[start]))) {
+            ++end;
+            while (end < size && TRY(is_less_than(items[end], items[end - 1])))
+                ++end;
+            items.slice(start, end - start).reverse();
+        } else {
+            ++end;
+            while (end < size && !TRY(is_less_than(items[end], items[end - 1])))
+                ++end;
+        }
+
+        return end - start;
+    };
+
+    // Sorts items[start, end), where items[start, sorted_end) are sorted already.
+    auto binary_insertion_sort = [&](size_t start, size_t end, size_t sorted_end) -> ThrowCompletionOr<void> {
+        for (auto i = sorted_end; i < end; ++i) {
+            // Insert after all equal items, to keep the sort stable.
+            size_t low = start;
+            size_t high = i;
+            while (low < high) {
+                auto middle = low + (high - low) / 2;
+                if (TRY(is_less_than(items[i], items[middle])))
+                    high = middle;
+                else
+                    low = middle + 1;
+            }
+
+            auto pivot = move(items[i]);
+            for (auto j = i; j > low; --j)
+                items[j] = move(items[j - 1]);
+            items[low] = move(pivot);
+        }
+        return {};
+    };
+
+    // Returns the first position in items[start, end) whose item is ordered after `value` if `after_equal_items` is
+    // true, or the first one that isn't ordered before it otherwise.
+    auto find_insertion_point = [&](T const& value, size_t start, size_t end, bool after_equal_items) -> ThrowCompletionOr<size_t> {
+        while (start < end) {
+            auto middle = start + (end - start) / 2;
+            bool goes_before_middle = after_equal_items ? TRY(is_less_than(value, items[middle])) : !TRY(is_less_than(items[middle], value));
+            if (goes_before_middle)
+                end = middle;
+            else
+                start = middle + 1;
+        }
+        return start;
+    };
+
+    // Merges the neighbouring sorted runs items[start, middle) and items[middle, end).
+    auto merge = [&](size_t start, size_t middle, size_t end) -> ThrowCompletionOr<void> {
+        // Items at the start of the first run that aren't ordered after the first item of the second run are in place
+        // already, and so are the items at the end of the second run that aren't ordered before the last item of the
+        // first run. This is what makes merging partially sorted runs cheap.
+        start = TRY(find_insertion_point(items[middle], start, middle, true));
+        if (start == middle)
+            return {};
+        end = TRY(find_insertion_point(items[middle - 1], middle, end, false));
+
+        auto left_size = middle - start;
+        for (size_t i = 0; i < left_size; ++i)
+            buffer[i] = items[start + i];
+
+        size_t left = 0;
+        size_t right = middle;
+        size_t output = start;
+        while (left < left_size && right < end) {
+            if (TRY(is_less_than(items[right], buffer[left])))
+                items[output++] = items[right++];
+            else
+                items[output++] = buffer[left++];
+        }
+        while (left < left_size)
+            items[output++] = buffer[left++];
+
+        return {};
+    };
+
+    // Runs shorter than this are extended with the binary insertion sort. It is chosen such that the number of runs is a
+    // power of two, or just below one, which keeps the final merges balanced.
+    auto minimum_run_size = [&] {
+        size_t remaining = size;
+        bool has_remainder = false;
+        while (remaining >= 32) {
+            has_remainder |= (remaining & 1) != 0;
+            remaining >>= 1;
+        }
+        return remaining + (has_remainder ? 1 : 0);
+    }();
+
+    struct Run {
+        size_t start { 0 };
+        size_t size { 0 };
+    };
+    Vector<Run, 64> runs;
+
+    auto merge_at = [&](size_t index) -> ThrowCompletionOr<void> {
+        auto& run = runs[index];
+        auto const& next_run = runs[index + 1];
+        TRY(merge(run.start, next_run.start, next_run.start + next_run.size));
+        run.size += next_run.size;
+        runs.remove(index + 1);
+        return {};
+    };
+
+    for (size_t start = 0; start < size;) {
+        auto run_size = TRY(count_run_and_make_ascending(start));
+        if (run_size < minimum_run_size) {
+            auto forced_run_size = min(minimum_run_size, size - start);
+            TRY(binary_insertion_sort(start, start + forced_run_size, start + run_size));
+            run_size = forced_run_size;
+        }
+        runs.append({ start, run_size });
+        start += run_size;
+
+        // Merge until the sizes of the pending runs shrink faster than the Fibonacci numbers from the oldest one on.
+        while (runs.size() > 1) {
+            auto index = runs.size() - 2;
+            if ((index >= 1 && runs[index - 1].size <= runs[index].size + runs[index + 1].size)
+                || (index >= 2 && runs[index - 2].size <= runs[index - 1].size + runs[index].size)) {
+                if (runs[index - 1].size < runs[index + 1].size)
+                    --index;
+            } else if (runs[index].size > runs[index + 1].size) {
+                break;
+            }
+            TRY(merge_at(index));
+        }
+    }
+
+    while (runs.size() > 1) {
+        auto index = runs.size() - 2;
+        if (index >= 1 && runs[index - 1].size < runs[index + 1].size)
+            --index;
+        TRY(merge_at(index));
+    }
+
+    return {};
+}
+
+static ThrowCompletionOr<void> sort_values(VM& vm, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, MarkedVector<Value>& items)
+{
+    MarkedVector<Value> buffer { vm.heap() };
+    buffer.resize(items.size());
+
+    return tim_sort(items.span(), buffer.span(), [&](Value x, Value y) -> ThrowCompletionOr<bool> {
+        return TRY(sort_compare(x, y)) < 0;
+    });
+}
+
+// OPTIMIZATION: CompareArrayElements without a comparefn compares the results of ToString. For undefined and for
+//               primitives other than Symbols, ToString can neither fail nor run user code, so it doesn't matter how
+//               often it is called. The strings are then created only once per item, rather than twice per comparison.
+static ThrowCompletionOr<bool> sort_by_cached_string_keys(VM& vm, MarkedVector<Value>& items)
+{
+    for (auto const& item : items) {
+        if (item.is_object() || item.is_symbol())
+            return false;
+    }
+
+    struct SortKey {
+        ByteString string;
+        Value value;
+    };
+
+    // NOTE: The values don't need to be kept alive by the keys, as they are all still in items until the very end.
+    Vector<SortKey> keys;
+    keys.ensure_capacity(items.size());
+    size_t undefined_count = 0;
+
+    for (auto const& item : items) {
+        // CompareArrayElements orders undefined after everything else.
+        if (item.is_undefined()) {
+            ++undefined_count;
+            continue;
+        }
+        keys.unchecked_append({ TRY(item.to_byte_string(vm)), item });
+    }
+
+    // NOTE: ToString results are compared by their code points. That is the same order the bytes of their UTF-8
+    //       encodings are in, so they can be compared directly.
+    Vector<SortKey> buffer;
+    buffer.resize(keys.size());
+    MUST(tim_sort(keys.span(), buffer.span(), [](SortKey const& x, SortKey const& y) -> ThrowCompletionOr<bool> {
+        return x.string.view() < y.string.view();
+    }));
+
+    for (size_t i = 0; i < keys.size(); ++i)
+        items[i] = keys[i].value;
+    for (size_t i = keys.size(); i < items.size(); ++i)
+        items[i] = js_undefined();
+
+    return true;
+}
+
+// OPTIMIZATION: CompareTypedArrayElements without a comparefn compares Numbers numerically, with NaN ordered after
+//               everything else and -0 before +0. That can be done without going through SortCompare.
+static bool sort_numbers(VM& vm, MarkedVector<Value>& items)
+{
+    if (items.is_empty() || !items.first().is_number())
+        return false;
+
+    MarkedVector<Value> buffer { vm.heap() };
+    buffer.resize(items.size());
+
+    MUST(tim_sort(items.span(), buffer.span(), [](Value x, Value y) -> ThrowCompletionOr<bool> {
+        if (x.is_nan())
+            return false;
+        if (y.is_nan())
+            return true;
+
+        auto x_double = x.as_double();
+        auto y_double = y.as_double();
+        if (x_double != y_double)
+            return x_double < y_double;
+        return x.is_negative_zero() && y.is_positive_zero();
+    }));
+    return true;
+}
+
 // 23.1.3.30.1 SortIndexedProperties ( obj, len, SortCompare, holes ), https://tc39.es/ecma262/#sec-sortindexedproperties
-ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM& vm, Object const& object, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes)
+ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM& vm, Object const& object, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes, DefaultSortCompare default_sort_compare)
 {
     // 1. Let items be a new empty List.
     auto items = MarkedVector<Value> { vm.heap() };
 
     // 2. Let k be 0.
+    size_t k = 0;
+
+    // OPTIMIZATION: A packed array has no holes and no accessors, so we can copy its elements over directly.
+    if (auto const* storage = packed_storage_of_array(object); storage && length <= storage->array_like_size()) {
+        items.ensure_capacity(length);
+        for (; k < length; ++k)
+            items.unchecked_append(storage->elements()[k]);
+    }
+
     // 3. Repeat, while k < len,
-    for (size_t k = 0; k < length; ++k) {
+    for (; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
@@ -219,13 +492,13 @@ ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM& vm, Object co
     }
 
     // 4. Sort items using an implementation-defined sequence of calls to SortCompare. If any such call returns an abrupt completion, stop before performing any further calls to SortCompare or steps in this algorithm and return that Completion Record.
+    // NOTE: The spec requires the sort to be stable, see the definition of "consistent comparator".
+    if (default_sort_compare == DefaultSortCompare::CompareArrayElements && TRY(sort_by_cached_string_keys(vm, items)))
+        return items;
+    if (default_sort_compare == DefaultSortCompare::CompareTypedArrayElements && sort_numbers(vm, items))
+        return items;
 
-    // Perform sorting by merge sort. This isn't as efficient compared to quick sort, but
-    // quicksort can't be used in all cases because the spec requires Array.prototype.sort()
-    // to be stable. FIXME: when initially scanning through the array, maintain a flag
-    // for if an unstable sort would be indistinguishable from a stable sort (such as just
-    // just strings or numbers), and in that case use quick sort instead for better performance.
-    TRY(array_merge_sort(vm, sort_compare, items));
+    TRY(sort_values(vm, sort_compare, items));
 
     // 5. Return items.
     return items;
@@ -63,7 +63,20 @@ enum class Holes {
     ReadThroughHoles,
 };
 
-ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes);
+// When SortCompare is known to perform one of the default comparisons, SortIndexedProperties can sort the items
+// without calling into it for every comparison.
+enum class DefaultSortCompare {
+    None,
+    CompareArrayElements,
+    CompareTypedArrayElements,
+};
+
+ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes, DefaultSortCompare = DefaultSortCompare::None);
 ThrowCompletionOr<double> compare_array_elements(VM&, Value x, Value y, FunctionObject* comparefn);
 
+// OPTIMIZATION: For an Array whose elements are in packed simple storage, HasProperty and Get on any index below the
+//               array-like size can be answered straight from the elements, without running any user code.
+SimpleIndexedPropertyStorage const* packed_storage_of_array(Object const&);
+Optional<Value> packed_array_element(Object const&, size_t index);
+
 }
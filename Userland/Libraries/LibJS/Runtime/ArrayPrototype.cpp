@@ -700,13 +700,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::for_each)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // OPTIMIZATION: Packed arrays can answer HasProperty and Get straight from their elements.
+        auto packed_element = packed_array_element(object, k);
+
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
+        auto k_present = packed_element.has_value() || TRY(object->has_property(property_key));
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
+            auto k_value = packed_element.has_value() ? *packed_element : TRY(object->get(property_key));
 
             // ii. Perform ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
             TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
@@ -742,6 +745,28 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = from_argument;
     }
     auto value_to_find = vm.argument(0);
+
+    // OPTIMIZATION: Nothing below can run user code, so a packed array's elements can be searched directly.
+    if (auto const* storage = packed_storage_of_array(this_object); storage && length <= storage->array_like_size()) {
+        auto const& elements = storage->elements();
+        if (storage->has_only_number_elements()) {
+            if (!value_to_find.is_number())
+                return Value(false);
+            auto number_to_find = value_to_find.as_double();
+            bool find_nan = value_to_find.is_nan();
+            for (u64 i = from_index; i < length; ++i) {
+                if (elements[i].as_double() == number_to_find || (find_nan && elements[i].is_nan()))
+                    return Value(true);
+            }
+            return Value(false);
+        }
+        for (u64 i = from_index; i < length; ++i) {
+            if (same_value_zero(elements[i], value_to_find))
+                return Value(true);
+        }
+        return Value(false);
+    }
+
     for (u64 i = from_index; i < length; ++i) {
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
@@ -795,6 +820,29 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // OPTIMIZATION: Nothing below can run user code, so a packed array's elements can be searched directly.
+    if (auto const* storage = packed_storage_of_array(object); storage && length <= storage->array_like_size()) {
+        auto const& elements = storage->elements();
+        if (storage->elements_kind() == ElementsKind::PackedInt32) {
+            if (!search_element.is_number())
+                return Value(-1);
+            auto number_to_find = search_element.as_double();
+            if (!(number_to_find >= NumericLimits<i32>::min() && number_to_find <= NumericLimits<i32>::max()) || static_cast<i32>(number_to_find) != number_to_find)
+                return Value(-1);
+            auto int_to_find = static_cast<i32>(number_to_find);
+            for (; k < length; ++k) {
+                if (elements[k].as_i32() == int_to_find)
+                    return Value(k);
+            }
+            return Value(-1);
+        }
+        for (; k < length; ++k) {
+            if (is_strictly_equal(search_element, elements[k]))
+                return Value(k);
+        }
+        return Value(-1);
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -906,6 +954,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::last_index_of)
         k = (double)length + n;
     }
 
+    // OPTIMIZATION: Nothing below can run user code, so a packed array's elements can be searched directly.
+    if (auto const* storage = packed_storage_of_array(object); storage && length <= storage->array_like_size()) {
+        auto const& elements = storage->elements();
+        for (; k >= 0; --k) {
+            if (is_strictly_equal(search_element, elements[k]))
+                return Value((size_t)k);
+        }
+        return Value(-1);
+    }
+
     // 8. Repeat, while k ≥ 0,
     for (; k >= 0; --k) {
         auto property_key = PropertyKey { k };
@@ -958,13 +1016,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // OPTIMIZATION: Packed arrays can answer HasProperty and Get straight from their elements.
+        auto packed_element = packed_array_element(object, k);
+
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
+        auto k_present = packed_element.has_value() || TRY(object->has_property(property_key));
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
+            auto k_value = packed_element.has_value() ? *packed_element : TRY(object->get(property_key));
 
             // ii. Let mappedValue be ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
             auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
@@ -1075,13 +1136,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::reduce)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // OPTIMIZATION: Packed arrays can answer HasProperty and Get straight from their elements.
+        auto packed_element = packed_array_element(object, k);
+
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
+        auto k_present = packed_element.has_value() || TRY(object->has_property(property_key));
 
         // c. If kPresent is true, then
         if (k_present) {
             // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
+            auto k_value = packed_element.has_value() ? *packed_element : TRY(object->get(property_key));
 
             // ii. Set accumulator to ? Call(callbackfn, undefined, « accumulator, kValue, 𝔽(k), O »).
             accumulator = TRY(call(vm, callback_function.as_function(), js_undefined(), accumulator, k_value, Value(k), object));
@@ -1339,62 +1403,6 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::some)
     return Value(false);
 }
 
-ThrowCompletionOr<void> array_merge_sort(VM& vm, Function<ThrowCompletionOr<double>(Value, Value)> const& compare_func, MarkedVector<Value>& arr_to_sort)
-{
-    // FIXME: it would probably be better to switch to insertion sort for small arrays for
-    // better performance
-    if (arr_to_sort.size() <= 1)
-        return {};
-
-    MarkedVector<Value> left(vm.heap());
-    MarkedVector<Value> right(vm.heap());
-
-    left.ensure_capacity(arr_to_sort.size() / 2);
-    right.ensure_capacity(arr_to_sort.size() / 2 + (arr_to_sort.size() & 1));
-
-    for (size_t i = 0; i < arr_to_sort.size(); ++i) {
-        if (i < arr_to_sort.size() / 2) {
-            left.append(arr_to_sort[i]);
-        } else {
-            right.append(arr_to_sort[i]);
-        }
-    }
-
-    TRY(array_merge_sort(vm, compare_func, left));
-    TRY(array_merge_sort(vm, compare_func, right));
-
-    arr_to_sort.clear();
-
-    size_t left_index = 0, right_index = 0;
-
-    while (left_index < left.size() && right_index < right.size()) {
-        auto x = left[left_index];
-        auto y = right[right_index];
-
-        double comparison_result = TRY(compare_func(x, y));
-
-        if (comparison_result <= 0) {
-            arr_to_sort.append(x);
-            left_index++;
-        } else {
-            arr_to_sort.append(y);
-            right_index++;
-        }
-    }
-
-    while (left_index < left.size()) {
-        arr_to_sort.append(left[left_index]);
-        left_index++;
-    }
-
-    while (right_index < right.size()) {
-        arr_to_sort.append(right[right_index]);
-        right_index++;
-    }
-
-    return {};
-}
-
 // 23.1.3.30 Array.prototype.sort ( comparefn ), https://tc39.es/ecma262/#sec-array.prototype.sort
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
 {
@@ -1416,7 +1424,7 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
     };
 
     // 5. Let sortedList be ? SortIndexedProperties(obj, len, SortCompare, skip-holes).
-    auto sorted_list = TRY(sort_indexed_properties(vm, object, length, sort_compare, Holes::SkipHoles));
+    auto sorted_list = TRY(sort_indexed_properties(vm, object, length, sort_compare, Holes::SkipHoles, comparefn.is_undefined() ? DefaultSortCompare::CompareArrayElements : DefaultSortCompare::None));
 
     // 6. Let itemCount be the number of elements in sortedList.
     auto item_count = sorted_list.size();
@@ -1724,7 +1732,7 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::to_sorted)
     };
 
     // 6. Let sortedList be ? SortIndexedProperties(obj, len, SortCompare, read-through-holes).
-    auto sorted_list = TRY(sort_indexed_properties(vm, object, length, sort_compare, Holes::ReadThroughHoles));
+    auto sorted_list = TRY(sort_indexed_properties(vm, object, length, sort_compare, Holes::ReadThroughHoles, comparefn.is_undefined() ? DefaultSortCompare::CompareArrayElements : DefaultSortCompare::None));
 
     // 7. Let j be 0.
     // 8. Repeat, while j < len,
@@ -38,6 +38,8 @@ private:
     NonnullGCPtr<GeneratorObject> m_generator_object;
     NonnullGCPtr<Promise> m_top_level_promise;
     GCPtr<Promise> m_current_promise { nullptr };
+    GCPtr<NativeFunction> m_on_fulfilled;
+    GCPtr<NativeFunction> m_on_rejected;
     Handle<AsyncFunctionDriverWrapper> m_self_handle;
     OwnPtr<ExecutionContext> m_suspended_execution_context;
 };
@@ -9,6 +9,7 @@
 #include <LibJS/Runtime/AsyncGeneratorPrototype.h>
 #include <LibJS/Runtime/AsyncGeneratorRequest.h>
 #include <LibJS/Runtime/ECMAScriptFunctionObject.h>
+#include <LibJS/Runtime/GeneratorResult.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/PromiseConstructor.h>
 
@@ -158,24 +159,20 @@ void AsyncGenerator::execute(VM& vm, Completion completion)
         VERIFY(completion.value().has_value());
 
         auto generated_value = [](Value value) -> Value {
-            if (value.is_object())
-                return value.as_object().get_without_side_effects("result");
+            if (value.is_object() && is<GeneratorResult>(value.as_object()))
+                return static_cast<GeneratorResult const&>(value.as_object()).result();
             return value.is_empty() ? js_undefined() : value;
         };
 
         auto generated_continuation = [&](Value value) -> Optional<size_t> {
-            if (value.is_object()) {
-                auto number_value = value.as_object().get_without_side_effects("continuation");
-                if (number_value.is_null())
-                    return {};
-                return static_cast<size_t>(number_value.as_double());
-            }
+            if (value.is_object() && is<GeneratorResult>(value.as_object()))
+                return static_cast<GeneratorResult const&>(value.as_object()).continuation();
             return {};
         };
 
         auto generated_is_await = [](Value value) -> bool {
-            if (value.is_object())
-                return value.as_object().get_without_side_effects("isAwait").as_bool();
+            if (value.is_object() && is<GeneratorResult>(value.as_object()))
+                return static_cast<GeneratorResult const&>(value.as_object()).is_await();
             return false;
         };
 
@@ -19,6 +19,7 @@
 #include <LibJS/Runtime/DatePrototype.h>
 #include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/Intl/AbstractOperations.h>
 #include <LibJS/Runtime/Intl/DateTimeFormat.h>
 #include <LibJS/Runtime/Intl/DateTimeFormatConstructor.h>
 #include <LibJS/Runtime/Temporal/Instant.h>
@@ -1002,10 +1003,12 @@ JS_DEFINE_NATIVE_FUNCTION(DatePrototype::to_locale_date_string)
         return PrimitiveString::create(vm, "Invalid Date"_string);
 
     // 3. Let dateFormat be ? CreateDateTimeFormat(%DateTimeFormat%, locales, options, "date", "date").
-    auto date_format = TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Date, Intl::OptionDefaults::Date));
+    auto date_format = TRY(Intl::cached_to_locale_string_formatter(vm, "DateTimeFormat date"sv, locales, options, [&]() -> ThrowCompletionOr<NonnullGCPtr<Object>> {
+        return TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Date, Intl::OptionDefaults::Date));
+    }));
 
     // 4. Return ? FormatDateTime(dateFormat, x).
-    auto formatted = TRY(Intl::format_date_time(vm, date_format, time));
+    auto formatted = TRY(Intl::format_date_time(vm, static_cast<Intl::DateTimeFormat&>(*date_format), time));
     return PrimitiveString::create(vm, move(formatted));
 }
 
@@ -1026,10 +1029,12 @@ JS_DEFINE_NATIVE_FUNCTION(DatePrototype::to_locale_string)
         return PrimitiveString::create(vm, "Invalid Date"_string);
 
     // 3. Let dateFormat be ? CreateDateTimeFormat(%DateTimeFormat%, locales, options, "any", "all").
-    auto date_format = TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Any, Intl::OptionDefaults::All));
+    auto date_format = TRY(Intl::cached_to_locale_string_formatter(vm, "DateTimeFormat any"sv, locales, options, [&]() -> ThrowCompletionOr<NonnullGCPtr<Object>> {
+        return TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Any, Intl::OptionDefaults::All));
+    }));
 
     // 4. Return ? FormatDateTime(dateFormat, x).
-    auto formatted = TRY(Intl::format_date_time(vm, date_format, time));
+    auto formatted = TRY(Intl::format_date_time(vm, static_cast<Intl::DateTimeFormat&>(*date_format), time));
     return PrimitiveString::create(vm, move(formatted));
 }
 
@@ -1050,10 +1055,12 @@ JS_DEFINE_NATIVE_FUNCTION(DatePrototype::to_locale_time_string)
         return PrimitiveString::create(vm, "Invalid Date"_string);
 
     // 3. Let timeFormat be ? CreateDateTimeFormat(%DateTimeFormat%, locales, options, "time", "time").
-    auto time_format = TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Time, Intl::OptionDefaults::Time));
+    auto time_format = TRY(Intl::cached_to_locale_string_formatter(vm, "DateTimeFormat time"sv, locales, options, [&]() -> ThrowCompletionOr<NonnullGCPtr<Object>> {
+        return TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Time, Intl::OptionDefaults::Time));
+    }));
 
     // 4. Return ? FormatDateTime(timeFormat, x).
-    auto formatted = TRY(Intl::format_date_time(vm, time_format, time));
+    auto formatted = TRY(Intl::format_date_time(vm, static_cast<Intl::DateTimeFormat&>(*time_format), time));
     return PrimitiveString::create(vm, move(formatted));
 }
 
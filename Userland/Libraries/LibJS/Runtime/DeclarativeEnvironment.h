@@ -129,7 +129,10 @@ private:
     Vector<Binding> m_bindings;
     Vector<DisposableResource> m_disposable_resource_stack;
 
-    u64 m_environment_serial_number { 0 };
+    // NOTE: Serial numbers are drawn from a process-wide counter, so that a cache keyed on a serial number
+    //       can never mistake one environment for another (e.g. when a bytecode executable is shared between realms).
+    static u64 next_environment_serial_number();
+    u64 m_environment_serial_number { next_environment_serial_number() };
 };
 
 inline ThrowCompletionOr<Value> DeclarativeEnvironment::get_binding_value_direct(VM& vm, size_t index) const
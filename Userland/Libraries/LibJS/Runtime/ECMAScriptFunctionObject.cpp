@@ -102,6 +102,16 @@ ECMAScriptFunctionObject::ECMAScriptFunctionObject(DeprecatedFlyString name, Byt
         return true;
     });
 
+    m_uses_this = parsing_insights.uses_this;
+    m_uses_this_from_environment = parsing_insights.uses_this_from_environment;
+}
+
+// OPTIMIZATION: Many functions are created but never called, so we defer this analysis (like code generation) until the first call.
+void ECMAScriptFunctionObject::analyze_function_declaration_instantiation()
+{
+    VERIFY(!m_function_declaration_instantiation_analyzed);
+    m_function_declaration_instantiation_analyzed = true;
+
     // NOTE: The following steps are from FunctionDeclarationInstantiation that could be executed once
     //       and then reused in all subsequent function instantiations.
 
@@ -331,8 +341,7 @@ ECMAScriptFunctionObject::ECMAScriptFunctionObject(DeprecatedFlyString name, Byt
         }));
     }
 
-    m_function_environment_needed = arguments_object_needs_binding || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || parsing_insights.uses_this_from_environment || m_contains_direct_call_to_eval;
-    m_uses_this = parsing_insights.uses_this;
+    m_function_environment_needed = arguments_object_needs_binding || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || m_uses_this_from_environment || m_contains_direct_call_to_eval;
 }
 
 void ECMAScriptFunctionObject::initialize(Realm& realm)
@@ -382,16 +391,17 @@ ThrowCompletionOr<Value> ECMAScriptFunctionObject::internal_call(Value this_argu
     // 1. Let callerContext be the running execution context.
     // NOTE: No-op, kept by the VM in its execution context stack.
 
-    auto callee_context = ExecutionContext::create();
+    u32 registers_and_constants_and_locals_count = 0;
+    u32 argument_count = max(arguments_list.size(), m_formal_parameters.size());
+    TRY(get_stack_frame_size(registers_and_constants_and_locals_count));
+
+    ALLOCATE_EXECUTION_CONTEXT_ON_NATIVE_STACK(callee_context, registers_and_constants_and_locals_count, argument_count);
 
     // Non-standard
-    callee_context->arguments.ensure_capacity(max(arguments_list.size(), m_formal_parameters.size()));
-    callee_context->arguments.append(arguments_list.data(), arguments_list.size());
+    arguments_list.copy_to(callee_context->arguments);
     callee_context->passed_argument_count = arguments_list.size();
-    if (arguments_list.size() < m_formal_parameters.size()) {
-        for (size_t i = arguments_list.size(); i < m_formal_parameters.size(); ++i)
-            callee_context->arguments.append(js_undefined());
-    }
+    for (size_t i = arguments_list.size(); i < argument_count; ++i)
+        callee_context->arguments[i] = js_undefined();
 
     // 2. Let calleeContext be PrepareForOrdinaryCall(F, undefined).
     // NOTE: We throw if the end of the native stack is reached, so unlike in the spec this _does_ need an exception check.
@@ -456,16 +466,17 @@ ThrowCompletionOr<NonnullGCPtr<Object>> ECMAScriptFunctionObject::internal_const
         this_argument = TRY(ordinary_create_from_constructor<Object>(vm, new_target, &Intrinsics::object_prototype, ConstructWithPrototypeTag::Tag));
     }
 
-    auto callee_context = ExecutionContext::create();
+    u32 registers_and_constants_and_locals_count = 0;
+    u32 argument_count = max(arguments_list.size(), m_formal_parameters.size());
+    TRY(get_stack_frame_size(registers_and_constants_and_locals_count));
+
+    ALLOCATE_EXECUTION_CONTEXT_ON_NATIVE_STACK(callee_context, registers_and_constants_and_locals_count, argument_count);
 
     // Non-standard
-    callee_context->arguments.ensure_capacity(max(arguments_list.size(), m_formal_parameters.size()));
-    callee_context->arguments.append(arguments_list.data(), arguments_list.size());
+    arguments_list.copy_to(callee_context->arguments);
     callee_context->passed_argument_count = arguments_list.size();
-    if (arguments_list.size() < m_formal_parameters.size()) {
-        for (size_t i = arguments_list.size(); i < m_formal_parameters.size(); ++i)
-            callee_context->arguments.append(js_undefined());
-    }
+    for (size_t i = arguments_list.size(); i < argument_count; ++i)
+        callee_context->arguments[i] = js_undefined();
 
     // 4. Let calleeContext be PrepareForOrdinaryCall(F, newTarget).
     // NOTE: We throw if the end of the native stack is reached, so unlike in the spec this _does_ need an exception check.
@@ -572,6 +583,9 @@ ThrowCompletionOr<void> ECMAScriptFunctionObject::prepare_for_ordinary_call(Exec
 {
     auto& vm = this->vm();
 
+    if (!m_function_declaration_instantiation_analyzed)
+        analyze_function_declaration_instantiation();
+
     // Non-standard
     callee_context.is_strict_mode = m_strict;
 
@@ -814,12 +828,9 @@ template void async_function_start(VM&, PromiseCapability const&, NonnullRefPtr<
 template void async_block_start(VM&, SafeFunction<Completion()> const& async_body, PromiseCapability const&, ExecutionContext&);
 template void async_function_start(VM&, PromiseCapability const&, SafeFunction<Completion()> const& async_function_body);
 
-// 10.2.1.4 OrdinaryCallEvaluateBody ( F, argumentsList ), https://tc39.es/ecma262/#sec-ordinarycallevaluatebody
-// 15.8.4 Runtime Semantics: EvaluateAsyncFunctionBody, https://tc39.es/ecma262/#sec-runtime-semantics-evaluatefunctionbody
-Completion ECMAScriptFunctionObject::ordinary_call_evaluate_body()
+ThrowCompletionOr<void> ECMAScriptFunctionObject::get_stack_frame_size(u32& registers_and_constants_and_locals_count)
 {
     auto& vm = this->vm();
-    auto& realm = *vm.current_realm();
 
     if (!m_bytecode_executable) {
         if (!m_ecmascript_code->bytecode_executable()) {
@@ -832,7 +843,19 @@ Completion ECMAScriptFunctionObject::ordinary_call_evaluate_body()
         m_bytecode_executable = m_ecmascript_code->bytecode_executable();
     }
 
-    vm.running_execution_context().registers_and_constants_and_locals.resize(m_local_variables_names.size() + m_bytecode_executable->number_of_registers + m_bytecode_executable->constants.size());
+    registers_and_constants_and_locals_count = m_bytecode_executable->number_of_registers + m_bytecode_executable->constants.size() + m_bytecode_executable->local_variable_names.size();
+    return {};
+}
+
+// 10.2.1.4 OrdinaryCallEvaluateBody ( F, argumentsList ), https://tc39.es/ecma262/#sec-ordinarycallevaluatebody
+// 15.8.4 Runtime Semantics: EvaluateAsyncFunctionBody, https://tc39.es/ecma262/#sec-runtime-semantics-evaluatefunctionbody
+Completion ECMAScriptFunctionObject::ordinary_call_evaluate_body()
+{
+    auto& vm = this->vm();
+    auto& realm = *vm.current_realm();
+
+    // NOTE: The executable was compiled by get_stack_frame_size() before the execution context was created.
+    VERIFY(m_bytecode_executable);
 
     auto result_and_frame = vm.bytecode_interpreter().run_executable(*m_bytecode_executable, {});
 
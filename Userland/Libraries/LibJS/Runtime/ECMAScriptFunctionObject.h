@@ -114,6 +114,11 @@ private:
     virtual bool is_ecmascript_function_object() const override { return true; }
     virtual void visit_edges(Visitor&) override;
 
+    void analyze_function_declaration_instantiation();
+
+    // Compiles the function if needed, so that its execution context can be created with room for all of its registers.
+    ThrowCompletionOr<void> get_stack_frame_size(u32& registers_and_constants_and_locals_count);
+
     ThrowCompletionOr<void> prepare_for_ordinary_call(ExecutionContext& callee_context, Object* new_target);
     void ordinary_call_bind_this(ExecutionContext&, Value this_argument);
 
@@ -165,6 +170,8 @@ private:
     bool m_is_module_wrapper { false };
     bool m_function_environment_needed { false };
     bool m_uses_this { false };
+    bool m_uses_this_from_environment { false };
+    bool m_function_declaration_instantiation_analyzed { false };
     Vector<VariableNameToInitialize> m_var_names_to_initialize_binding;
     Vector<DeprecatedFlyString> m_function_names_to_initialize_binding;
 
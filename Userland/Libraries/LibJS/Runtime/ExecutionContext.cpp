@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/kmalloc.h>
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Runtime/ExecutionContext.h>
@@ -13,47 +14,49 @@
 
 namespace JS {
 
-class ExecutionContextAllocator {
-public:
-    NonnullOwnPtr<ExecutionContext> allocate()
-    {
-        if (m_execution_contexts.is_empty())
-            return adopt_own(*new ExecutionContext);
-        void* slot = m_execution_contexts.take_last();
-        return adopt_own(*new (slot) ExecutionContext);
-    }
-    void deallocate(void* ptr)
-    {
-        m_execution_contexts.append(ptr);
-    }
-
-private:
-    Vector<void*> m_execution_contexts;
-};
-
-static NeverDestroyed<ExecutionContextAllocator> s_execution_context_allocator;
-
-NonnullOwnPtr<ExecutionContext> ExecutionContext::create()
+NonnullOwnPtr<ExecutionContext> ExecutionContext::create(u32 registers_and_constants_and_locals_count, u32 arguments_count)
 {
-    return s_execution_context_allocator->allocate();
+    auto* memory = kmalloc(allocation_size(registers_and_constants_and_locals_count, arguments_count));
+    VERIFY(memory);
+    return adopt_own(*new (memory) ExecutionContext(registers_and_constants_and_locals_count, arguments_count));
 }
 
 void ExecutionContext::operator delete(void* ptr)
 {
-    s_execution_context_allocator->deallocate(ptr);
+    free(ptr);
 }
 
-ExecutionContext::ExecutionContext()
+ExecutionContext::ExecutionContext(u32 registers_and_constants_and_locals_count, u32 arguments_count)
 {
+    auto* values = reinterpret_cast<Value*>(this + 1);
+    for (size_t i = 0; i < static_cast<size_t>(registers_and_constants_and_locals_count) + arguments_count; ++i)
+        new (&values[i]) Value();
+
+    registers_and_constants_and_locals = { values, registers_and_constants_and_locals_count };
+    arguments = { values + registers_and_constants_and_locals_count, arguments_count };
 }
 
 ExecutionContext::~ExecutionContext()
 {
 }
 
+void ExecutionContext::ensure_registers_and_constants_and_locals_count(u32 count)
+{
+    if (registers_and_constants_and_locals.size() >= count)
+        return;
+
+    Vector<Value> grown_registers_and_constants_and_locals;
+    grown_registers_and_constants_and_locals.ensure_capacity(count);
+    grown_registers_and_constants_and_locals.append(registers_and_constants_and_locals.data(), registers_and_constants_and_locals.size());
+    grown_registers_and_constants_and_locals.resize(count);
+
+    m_grown_registers_and_constants_and_locals = move(grown_registers_and_constants_and_locals);
+    registers_and_constants_and_locals = m_grown_registers_and_constants_and_locals.span();
+}
+
 NonnullOwnPtr<ExecutionContext> ExecutionContext::copy() const
 {
-    auto copy = create();
+    auto copy = create(registers_and_constants_and_locals.size(), arguments.size());
     copy->function = function;
     copy->realm = realm;
     copy->script_or_module = script_or_module;
@@ -65,9 +68,9 @@ NonnullOwnPtr<ExecutionContext> ExecutionContext::copy() const
     copy->this_value = this_value;
     copy->is_strict_mode = is_strict_mode;
     copy->executable = executable;
-    copy->arguments = arguments;
+    arguments.copy_to(copy->arguments);
     copy->passed_argument_count = passed_argument_count;
-    copy->registers_and_constants_and_locals = registers_and_constants_and_locals;
+    registers_and_constants_and_locals.copy_to(copy->registers_and_constants_and_locals);
     copy->unwind_contexts = unwind_contexts;
     copy->saved_lexical_environments = saved_lexical_environments;
     copy->previously_scheduled_jumps = previously_scheduled_jumps;
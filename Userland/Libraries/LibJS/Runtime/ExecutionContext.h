@@ -9,6 +9,7 @@
 #pragma once
 
 #include <AK/DeprecatedFlyString.h>
+#include <AK/ScopeGuard.h>
 #include <AK/WeakPtr.h>
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Forward.h>
@@ -22,20 +23,28 @@ namespace JS {
 using ScriptOrModule = Variant<Empty, NonnullGCPtr<Script>, NonnullGCPtr<Module>>;
 
 // 9.4 Execution Contexts, https://tc39.es/ecma262/#sec-execution-contexts
+// NOTE: The registers, constants and locals are stored right behind the execution context, followed by the arguments.
+//       Contexts that only live for the duration of a call are put on the native stack together with those values with
+//       ALLOCATE_EXECUTION_CONTEXT_ON_NATIVE_STACK, so that most calls don't have to allocate any memory.
 struct ExecutionContext {
-    static NonnullOwnPtr<ExecutionContext> create();
+    static NonnullOwnPtr<ExecutionContext> create(u32 registers_and_constants_and_locals_count = 0, u32 arguments_count = 0);
     [[nodiscard]] NonnullOwnPtr<ExecutionContext> copy() const;
 
+    // NOTE: Use create() or ALLOCATE_EXECUTION_CONTEXT_ON_NATIVE_STACK to get the memory for the values as well.
+    ExecutionContext(u32 registers_and_constants_and_locals_count, u32 arguments_count);
     ~ExecutionContext();
 
-    void visit_edges(Cell::Visitor&);
+    // Contexts that would take up more of the native stack than this (because of huge functions, or calls with very many
+    // arguments) are put on the heap instead.
+    static constexpr size_t maximum_native_stack_allocation_size = 8 * KiB;
 
-private:
-    friend class ExecutionContextAllocator;
+    static constexpr size_t allocation_size(u32 registers_and_constants_and_locals_count, u32 arguments_count)
+    {
+        return sizeof(ExecutionContext) + (static_cast<size_t>(registers_and_constants_and_locals_count) + arguments_count) * sizeof(Value);
+    }
 
-    ExecutionContext();
+    void visit_edges(Cell::Visitor&);
 
-public:
     void operator delete(void* ptr);
 
     GCPtr<FunctionObject> function;                // [[Function]]
@@ -70,16 +79,39 @@ public:
         return registers_and_constants_and_locals[index];
     }
 
+    // Contexts of scripts, modules and eval code are created before the executable they run is known, and are given
+    // their registers once it is.
+    void ensure_registers_and_constants_and_locals_count(u32 count);
+
     u32 passed_argument_count { 0 };
     bool is_strict_mode { false };
 
-    Vector<Value> arguments;
-    Vector<Value> registers_and_constants_and_locals;
+    Span<Value> arguments;
+    Span<Value> registers_and_constants_and_locals;
     Vector<Bytecode::UnwindInfo> unwind_contexts;
     Vector<Optional<size_t>> previously_scheduled_jumps;
     Vector<GCPtr<Environment>> saved_lexical_environments;
+
+private:
+    Vector<Value> m_grown_registers_and_constants_and_locals;
 };
 
+#define ALLOCATE_EXECUTION_CONTEXT_ON_NATIVE_STACK(execution_context, registers_and_constants_and_locals_count, arguments_count)              \
+    JS::ExecutionContext* execution_context = nullptr;                                                                                        \
+    OwnPtr<JS::ExecutionContext> execution_context##_on_heap;                                                                                 \
+    if (auto execution_context##_size = JS::ExecutionContext::allocation_size((registers_and_constants_and_locals_count), (arguments_count)); \
+        execution_context##_size <= JS::ExecutionContext::maximum_native_stack_allocation_size) [[likely]] {                                  \
+        execution_context = new (__builtin_alloca(execution_context##_size))                                                                  \
+            JS::ExecutionContext((registers_and_constants_and_locals_count), (arguments_count));                                              \
+    } else {                                                                                                                                  \
+        execution_context##_on_heap = JS::ExecutionContext::create((registers_and_constants_and_locals_count), (arguments_count));            \
+        execution_context = execution_context##_on_heap.ptr();                                                                                \
+    }                                                                                                                                         \
+    ScopeGuard execution_context##_destructor([&] {                                                                                           \
+        if (!execution_context##_on_heap)                                                                                                     \
+            execution_context->~ExecutionContext();                                                                                           \
+    })
+
 struct StackTraceElement {
     ExecutionContext* execution_context;
     Optional<UnrealizedSourceRange> source_range;
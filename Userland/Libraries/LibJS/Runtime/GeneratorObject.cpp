@@ -9,6 +9,7 @@
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Runtime/GeneratorObject.h>
 #include <LibJS/Runtime/GeneratorPrototype.h>
+#include <LibJS/Runtime/GeneratorResult.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/Iterator.h>
 
@@ -83,18 +84,14 @@ ThrowCompletionOr<Value> GeneratorObject::execute(VM& vm, Completion const& comp
     VERIFY(completion.value().has_value());
 
     auto generated_value = [](Value value) -> Value {
-        if (value.is_object())
-            return value.as_object().get_without_side_effects("result");
+        if (value.is_object() && is<GeneratorResult>(value.as_object()))
+            return static_cast<GeneratorResult const&>(value.as_object()).result();
         return value.is_empty() ? js_undefined() : value;
     };
 
     auto generated_continuation = [&](Value value) -> Optional<size_t> {
-        if (value.is_object()) {
-            auto number_value = value.as_object().get_without_side_effects("continuation");
-            if (number_value.is_null())
-                return {};
-            return static_cast<u64>(number_value.as_double());
-        }
+        if (value.is_object() && is<GeneratorResult>(value.as_object()))
+            return static_cast<GeneratorResult const&>(value.as_object()).continuation();
         return {};
     };
 
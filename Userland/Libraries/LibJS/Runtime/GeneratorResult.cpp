@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Heap/Heap.h>
+#include <LibJS/Runtime/GeneratorResult.h>
+#include <LibJS/Runtime/Realm.h>
+
+namespace JS {
+
+JS_DEFINE_ALLOCATOR(GeneratorResult);
+
+NonnullGCPtr<GeneratorResult> GeneratorResult::create(Realm& realm, Value result, Optional<size_t> continuation, bool is_await)
+{
+    return realm.heap().allocate<GeneratorResult>(realm, realm, result, continuation, is_await);
+}
+
+GeneratorResult::GeneratorResult(Realm& realm, Value result, Optional<size_t> continuation, bool is_await)
+    : Object(ConstructWithoutPrototypeTag::Tag, realm)
+    , m_result(result)
+    , m_continuation(continuation)
+    , m_is_await(is_await)
+{
+}
+
+void GeneratorResult::visit_edges(Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_result);
+}
+
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <LibJS/Runtime/Object.h>
+
+namespace JS {
+
+// What the bytecode of a generator or async function hands back to its driver when it yields, awaits or returns.
+// NOTE: This is never exposed to user code, and its fields are read directly instead of being looked up as properties.
+class GeneratorResult final : public Object {
+    JS_OBJECT(GeneratorResult, Object);
+    JS_DECLARE_ALLOCATOR(GeneratorResult);
+
+public:
+    static NonnullGCPtr<GeneratorResult> create(Realm&, Value result, Optional<size_t> continuation, bool is_await);
+
+    virtual ~GeneratorResult() override = default;
+
+    Value result() const { return m_result; }
+    Optional<size_t> const& continuation() const { return m_continuation; }
+    bool is_await() const { return m_is_await; }
+
+private:
+    GeneratorResult(Realm&, Value result, Optional<size_t> continuation, bool is_await);
+
+    virtual bool is_generator_result() const override { return true; }
+    virtual void visit_edges(Cell::Visitor&) override;
+
+    Value m_result;
+    Optional<size_t> m_continuation;
+    bool m_is_await { false };
+};
+
+template<>
+inline bool Object::fast_is<GeneratorResult>() const { return is_generator_result(); }
+
+}
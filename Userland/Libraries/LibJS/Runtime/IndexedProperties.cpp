@@ -18,6 +18,25 @@ SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initi
     , m_array_size(initial_values.size())
     , m_packed_elements(move(initial_values))
 {
+    for (auto value : m_packed_elements)
+        transition_elements_kind_for(value);
+}
+
+static ElementsKind elements_kind_for(Value value)
+{
+    // NOTE: Accessors have to go through Get, so as far as fast paths are concerned they're no better than holes.
+    if (value.is_empty() || value.is_accessor())
+        return ElementsKind::Holey;
+    if (value.is_int32())
+        return ElementsKind::PackedInt32;
+    if (value.is_number())
+        return ElementsKind::PackedNumber;
+    return ElementsKind::Packed;
+}
+
+void SimpleIndexedPropertyStorage::transition_elements_kind_for(Value value)
+{
+    m_elements_kind = max(m_elements_kind, elements_kind_for(value));
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
@@ -48,16 +67,20 @@ void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttribute
     VERIFY(attributes == default_attributes);
 
     if (index >= m_array_size) {
+        if (index > m_array_size)
+            m_elements_kind = ElementsKind::Holey;
         m_array_size = index + 1;
         grow_storage_if_needed();
     }
     m_packed_elements[index] = value;
+    transition_elements_kind_for(value);
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
 {
     VERIFY(index < m_array_size);
     m_packed_elements[index] = {};
+    m_elements_kind = ElementsKind::Holey;
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_first()
@@ -76,6 +99,8 @@ ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 
 bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
+    if (new_size > m_array_size)
+        m_elements_kind = ElementsKind::Holey;
     m_array_size = new_size;
     m_packed_elements.resize_and_keep_capacity(new_size);
     return true;
@@ -23,6 +23,16 @@ class IndexedProperties;
 class IndexedPropertyIterator;
 class GenericIndexedPropertyStorage;
 
+// The elements kind of a simple storage describes what every element below the array-like size is known to be.
+// Anything but Holey means each of those elements is present and a plain data value.
+// Kinds are ordered from most to least specific, and a storage only ever transitions towards the less specific ones.
+enum class ElementsKind : u8 {
+    PackedInt32,
+    PackedNumber,
+    Packed,
+    Holey,
+};
+
 class IndexedPropertyStorage {
 public:
     virtual ~IndexedPropertyStorage() = default;
@@ -74,6 +84,10 @@ public:
 
     Vector<Value> const& elements() const { return m_packed_elements; }
 
+    [[nodiscard]] ElementsKind elements_kind() const { return m_elements_kind; }
+    [[nodiscard]] bool is_packed() const { return m_elements_kind != ElementsKind::Holey; }
+    [[nodiscard]] bool has_only_number_elements() const { return m_elements_kind == ElementsKind::PackedInt32 || m_elements_kind == ElementsKind::PackedNumber; }
+
     [[nodiscard]] bool inline_has_index(u32 index) const
     {
         return index < m_array_size && !m_packed_elements.data()[index].is_empty();
@@ -90,9 +104,11 @@ private:
     friend GenericIndexedPropertyStorage;
 
     void grow_storage_if_needed();
+    void transition_elements_kind_for(Value);
 
     size_t m_array_size { 0 };
     Vector<Value> m_packed_elements;
+    ElementsKind m_elements_kind { ElementsKind::PackedInt32 };
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
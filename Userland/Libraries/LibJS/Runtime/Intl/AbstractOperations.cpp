@@ -14,6 +14,7 @@
 #include <LibJS/Runtime/Intl/AbstractOperations.h>
 #include <LibJS/Runtime/Intl/Locale.h>
 #include <LibJS/Runtime/Intl/SingleUnitIdentifiers.h>
+#include <LibJS/Runtime/Intrinsics.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/Runtime/ValueInlines.h>
 #include <LibUnicode/TimeZone.h>
@@ -647,6 +648,30 @@ ThrowCompletionOr<Object*> coerce_options_to_object(VM& vm, Value options)
     return TRY(options.to_object(vm)).ptr();
 }
 
+// OPTIMIZATION: The toLocaleString() methods create a new formatter on every call, and never hand it out. Creating the
+//               formatter for a given formatter name, locale string and no options is not observable, so those are reused
+//               instead, as long as the default locale and time zone stay the same.
+ThrowCompletionOr<NonnullGCPtr<Object>> cached_to_locale_string_formatter(VM& vm, StringView formatter_name, Value locales, Value options, Function<ThrowCompletionOr<NonnullGCPtr<Object>>()> const& create_formatter)
+{
+    if (!options.is_undefined() || (!locales.is_undefined() && !locales.is_string()))
+        return create_formatter();
+
+    auto& intrinsics = vm.current_realm()->intrinsics();
+
+    auto key = MUST(String::formatted("{} {} {} {}",
+        formatter_name,
+        locales.is_string() ? locales.as_string().utf8_string_view() : ""sv,
+        Unicode::default_locale(),
+        system_time_zone_identifier()));
+
+    if (auto formatter = intrinsics.cached_intl_formatter(key))
+        return *formatter;
+
+    auto formatter = TRY(create_formatter());
+    intrinsics.cache_intl_formatter(move(key), formatter);
+    return formatter;
+}
+
 // NOTE: 9.2.11 GetOption has been removed and is being pulled in from ECMA-262 in the Temporal proposal.
 
 // 9.2.12 GetBooleanOrStringNumberFormatOption ( options, property, stringValues, fallback ), https://tc39.es/ecma402/#sec-getbooleanorstringnumberformatoption
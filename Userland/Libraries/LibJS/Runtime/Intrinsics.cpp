@@ -420,6 +420,28 @@ void Intrinsics::visit_edges(Visitor& visitor)
     visitor.visit(m_##snake_name##_prototype);
     JS_ENUMERATE_ITERATOR_PROTOTYPES
 #undef __JS_ENUMERATE
+
+    for (auto& cached_formatter : m_cached_intl_formatters)
+        visitor.visit(cached_formatter.formatter);
+}
+
+GCPtr<Object> Intrinsics::cached_intl_formatter(StringView key)
+{
+    auto index = m_cached_intl_formatters.find_first_index_if([&](auto const& cached_formatter) { return cached_formatter.key == key; });
+    if (!index.has_value())
+        return nullptr;
+
+    auto formatter = m_cached_intl_formatters[*index].formatter;
+    if (*index != m_cached_intl_formatters.size() - 1)
+        m_cached_intl_formatters.append(m_cached_intl_formatters.take(*index));
+    return formatter;
+}
+
+void Intrinsics::cache_intl_formatter(String key, NonnullGCPtr<Object> formatter)
+{
+    if (m_cached_intl_formatters.size() == max_cached_intl_formatters)
+        m_cached_intl_formatters.remove(0);
+    m_cached_intl_formatters.append({ move(key), formatter });
 }
 
 // 10.2.4 AddRestrictedFunctionProperties ( F, realm ), https://tc39.es/ecma262/#sec-addrestrictedfunctionproperties
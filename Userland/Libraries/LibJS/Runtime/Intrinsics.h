@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/String.h>
+#include <AK/Vector.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Cell.h>
 
@@ -95,6 +97,10 @@ public:
     JS_ENUMERATE_ITERATOR_PROTOTYPES
 #undef __JS_ENUMERATE
 
+    // Intl formatters that the toLocaleString() methods created internally, see Intl::cached_to_locale_string_formatter().
+    GCPtr<Object> cached_intl_formatter(StringView key);
+    void cache_intl_formatter(String key, NonnullGCPtr<Object> formatter);
+
 private:
     Intrinsics(Realm& realm)
         : m_realm(realm)
@@ -189,6 +195,15 @@ private:
     GCPtr<Object> m_##snake_name##_prototype;
     JS_ENUMERATE_ITERATOR_PROTOTYPES
 #undef __JS_ENUMERATE
+
+    struct CachedIntlFormatter {
+        String key;
+        NonnullGCPtr<Object> formatter;
+    };
+    static constexpr size_t max_cached_intl_formatters = 16;
+
+    // Least recently used first.
+    Vector<CachedIntlFormatter> m_cached_intl_formatters;
 };
 
 void add_restricted_function_properties(FunctionObject&, Realm&);
@@ -4,7 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/CharacterTypes.h>
+#include <AK/FloatingPointStringConversions.h>
 #include <AK/Function.h>
+#include <AK/GenericLexer.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonParser.h>
@@ -107,7 +110,9 @@ ThrowCompletionOr<Optional<ByteString>> JSONObject::stringify_impl(VM& vm, Value
 
     auto wrapper = Object::create(realm, realm.intrinsics().object_prototype());
     MUST(wrapper->create_data_property_or_throw(ByteString::empty(), value));
-    return serialize_json_property(vm, state, ByteString::empty(), wrapper);
+    if (!TRY(serialize_json_property(vm, state, ByteString::empty(), wrapper)))
+        return Optional<ByteString> {};
+    return state.builder.to_byte_string();
 }
 
 // 25.5.2 JSON.stringify ( value [ , replacer [ , space ] ] ), https://tc39.es/ecma262/#sec-json.stringify
@@ -128,7 +133,7 @@ JS_DEFINE_NATIVE_FUNCTION(JSONObject::stringify)
 }
 
 // 25.5.2.1 SerializeJSONProperty ( state, key, holder ), https://tc39.es/ecma262/#sec-serializejsonproperty
-ThrowCompletionOr<Optional<ByteString>> JSONObject::serialize_json_property(VM& vm, StringifyState& state, PropertyKey const& key, Object* holder)
+ThrowCompletionOr<bool> JSONObject::serialize_json_property(VM& vm, StringifyState& state, PropertyKey const& key, Object* holder)
 {
     // 1. Let value be ? Get(holder, key).
     auto value = TRY(holder->get(key));
@@ -178,26 +183,35 @@ ThrowCompletionOr<Optional<ByteString>> JSONObject::serialize_json_property(VM&
     }
 
     // 5. If value is null, return "null".
-    if (value.is_null())
-        return "null"sv;
+    if (value.is_null()) {
+        state.builder.append("null"sv);
+        return true;
+    }
 
     // 6. If value is true, return "true".
     // 7. If value is false, return "false".
-    if (value.is_boolean())
-        return value.as_bool() ? "true"sv : "false"sv;
+    if (value.is_boolean()) {
+        state.builder.append(value.as_bool() ? "true"sv : "false"sv);
+        return true;
+    }
 
     // 8. If Type(value) is String, return QuoteJSONString(value).
-    if (value.is_string())
-        return quote_json_string(value.as_string().byte_string());
+    if (value.is_string()) {
+        quote_json_string(state.builder, value.as_string().byte_string());
+        return true;
+    }
 
     // 9. If Type(value) is Number, then
     if (value.is_number()) {
         // a. If value is finite, return ! ToString(value).
-        if (value.is_finite_number())
-            return MUST(value.to_byte_string(vm));
-
+        if (value.is_int32())
+            state.builder.appendff("{}", value.as_i32());
+        else if (value.is_finite_number())
+            state.builder.append(MUST(value.to_byte_string(vm)));
         // b. Return "null".
-        return "null"sv;
+        else
+            state.builder.append("null"sv);
+        return true;
     }
 
     // 10. If Type(value) is BigInt, throw a TypeError exception.
@@ -211,18 +225,19 @@ ThrowCompletionOr<Optional<ByteString>> JSONObject::serialize_json_property(VM&
 
         // b. If isArray is true, return ? SerializeJSONArray(state, value).
         if (is_array)
-            return TRY(serialize_json_array(vm, state, value.as_object()));
-
+            TRY(serialize_json_array(vm, state, value.as_object()));
         // c. Return ? SerializeJSONObject(state, value).
-        return TRY(serialize_json_object(vm, state, value.as_object()));
+        else
+            TRY(serialize_json_object(vm, state, value.as_object()));
+        return true;
     }
 
     // 12. Return undefined.
-    return Optional<ByteString> {};
+    return false;
 }
 
 // 25.5.2.4 SerializeJSONObject ( state, value ), https://tc39.es/ecma262/#sec-serializejsonobject
-ThrowCompletionOr<ByteString> JSONObject::serialize_json_object(VM& vm, StringifyState& state, Object& object)
+ThrowCompletionOr<void> JSONObject::serialize_json_object(VM& vm, StringifyState& state, Object& object)
 {
     if (state.seen_objects.contains(&object))
         return vm.throw_completion<TypeError>(ErrorType::JsonCircular);
@@ -230,19 +245,32 @@ ThrowCompletionOr<ByteString> JSONObject::serialize_json_object(VM& vm, Stringif
     state.seen_objects.set(&object);
     ByteString previous_indent = state.indent;
     state.indent = ByteString::formatted("{}{}", state.indent, state.gap);
-    Vector<ByteString> property_strings;
+
+    auto& builder = state.builder;
+    builder.append('{');
+    bool first = true;
 
     auto process_property = [&](PropertyKey const& key) -> ThrowCompletionOr<void> {
         if (key.is_symbol())
             return {};
-        auto serialized_property_string = TRY(serialize_json_property(vm, state, key, &object));
-        if (serialized_property_string.has_value()) {
-            property_strings.append(ByteString::formatted(
-                "{}:{}{}",
-                quote_json_string(key.to_string()),
-                state.gap.is_empty() ? "" : " ",
-                serialized_property_string));
+
+        // NOTE: We optimistically write out the key, and take it back out if the value turns out to be undefined.
+        auto length_before_property = builder.length();
+        if (!first)
+            builder.append(',');
+        if (!state.gap.is_empty()) {
+            builder.append('\n');
+            builder.append(state.indent);
         }
+        quote_json_string(builder, key.to_string());
+        builder.append(':');
+        if (!state.gap.is_empty())
+            builder.append(' ');
+
+        if (TRY(serialize_json_property(vm, state, key, &object)))
+            first = false;
+        else
+            builder.trim(builder.length() - length_before_property);
         return {};
     };
 
@@ -250,47 +278,37 @@ ThrowCompletionOr<ByteString> JSONObject::serialize_json_object(VM& vm, Stringif
         auto property_list = state.property_list.value();
         for (auto& property : property_list)
             TRY(process_property(property));
+    } else if (object.class_name() == "Object"sv && object.indexed_properties().is_empty()) {
+        // OPTIMIZATION: A plain object without indexed properties has exactly the own keys listed in its shape, in order.
+        //               We take a snapshot of the enumerable string keys up front, since serializing the values may run
+        //               user code that changes the object.
+        Vector<PropertyKey> property_list;
+        property_list.ensure_capacity(object.shape().property_count());
+        for (auto const& [key, metadata] : object.shape().property_table()) {
+            if (key.is_string() && metadata.attributes.is_enumerable())
+                property_list.unchecked_append(key.as_string());
+        }
+        for (auto& property : property_list)
+            TRY(process_property(property));
     } else {
         auto property_list = TRY(object.enumerable_own_property_names(PropertyKind::Key));
         for (auto& property : property_list)
             TRY(process_property(property.as_string().byte_string()));
     }
-    StringBuilder builder;
-    if (property_strings.is_empty()) {
-        builder.append("{}"sv);
-    } else {
-        bool first = true;
-        builder.append('{');
-        if (state.gap.is_empty()) {
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(',');
-                first = false;
-                builder.append(property_string);
-            }
-        } else {
-            builder.append('\n');
-            builder.append(state.indent);
-            auto separator = ByteString::formatted(",\n{}", state.indent);
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(separator);
-                first = false;
-                builder.append(property_string);
-            }
-            builder.append('\n');
-            builder.append(previous_indent);
-        }
-        builder.append('}');
+
+    if (!first && !state.gap.is_empty()) {
+        builder.append('\n');
+        builder.append(previous_indent);
     }
+    builder.append('}');
 
     state.seen_objects.remove(&object);
     state.indent = previous_indent;
-    return builder.to_byte_string();
+    return {};
 }
 
 // 25.5.2.5 SerializeJSONArray ( state, value ), https://tc39.es/ecma262/#sec-serializejsonarray
-ThrowCompletionOr<ByteString> JSONObject::serialize_json_array(VM& vm, StringifyState& state, Object& object)
+ThrowCompletionOr<void> JSONObject::serialize_json_array(VM& vm, StringifyState& state, Object& object)
 {
     if (state.seen_objects.contains(&object))
         return vm.throw_completion<TypeError>(ErrorType::JsonCircular);
@@ -298,63 +316,38 @@ ThrowCompletionOr<ByteString> JSONObject::serialize_json_array(VM& vm, Stringify
     state.seen_objects.set(&object);
     ByteString previous_indent = state.indent;
     state.indent = ByteString::formatted("{}{}", state.indent, state.gap);
-    Vector<ByteString> property_strings;
 
     auto length = TRY(length_of_array_like(vm, object));
 
-    // Optimization
-    property_strings.ensure_capacity(length);
+    auto& builder = state.builder;
+    builder.append('[');
 
     for (size_t i = 0; i < length; ++i) {
-        auto serialized_property_string = TRY(serialize_json_property(vm, state, i, &object));
-        if (!serialized_property_string.has_value()) {
-            property_strings.append("null"sv);
-        } else {
-            property_strings.append(serialized_property_string.release_value());
+        if (i > 0)
+            builder.append(',');
+        if (!state.gap.is_empty()) {
+            builder.append('\n');
+            builder.append(state.indent);
         }
+        if (!TRY(serialize_json_property(vm, state, i, &object)))
+            builder.append("null"sv);
     }
 
-    StringBuilder builder;
-    if (property_strings.is_empty()) {
-        builder.append("[]"sv);
-    } else {
-        if (state.gap.is_empty()) {
-            builder.append('[');
-            bool first = true;
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(',');
-                first = false;
-                builder.append(property_string);
-            }
-            builder.append(']');
-        } else {
-            builder.append("[\n"sv);
-            builder.append(state.indent);
-            auto separator = ByteString::formatted(",\n{}", state.indent);
-            bool first = true;
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(separator);
-                first = false;
-                builder.append(property_string);
-            }
-            builder.append('\n');
-            builder.append(previous_indent);
-            builder.append(']');
-        }
+    if (length > 0 && !state.gap.is_empty()) {
+        builder.append('\n');
+        builder.append(previous_indent);
     }
+    builder.append(']');
 
     state.seen_objects.remove(&object);
     state.indent = previous_indent;
-    return builder.to_byte_string();
+    return {};
 }
 
 // 25.5.2.2 QuoteJSONString ( value ), https://tc39.es/ecma262/#sec-quotejsonstring
-ByteString JSONObject::quote_json_string(ByteString string)
+void JSONObject::quote_json_string(StringBuilder& builder, StringView string)
 {
     // 1. Let product be the String value consisting solely of the code unit 0x0022 (QUOTATION MARK).
-    StringBuilder builder;
     builder.append('"');
 
     // 2. For each code point C of StringToCodePoints(value), do
@@ -402,9 +395,266 @@ ByteString JSONObject::quote_json_string(ByteString string)
     builder.append('"');
 
     // 4. Return product.
-    return builder.to_byte_string();
 }
 
+// OPTIMIZATION: This parses JSON text straight into JS values, instead of building an AK::JsonValue tree first and
+//               converting that afterwards. It accepts exactly the same grammar as AK::JsonParser.
+class JSONParser : public GenericLexer {
+public:
+    JSONParser(VM& vm, StringView input)
+        : GenericLexer(input)
+        , m_vm(vm)
+        , m_realm(*vm.current_realm())
+    {
+    }
+
+    ThrowCompletionOr<Value> parse()
+    {
+        auto result = TRY(parse_value());
+        ignore_while(is_space);
+        if (!is_eof())
+            return malformed();
+        return result;
+    }
+
+private:
+    static constexpr bool is_space(char ch)
+    {
+        return ch == '\t' || ch == '\n' || ch == '\r' || ch == ' ';
+    }
+
+    ThrowCompletionOr<Value> malformed() const
+    {
+        return m_vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
+    }
+
+    ThrowCompletionOr<Value> parse_value()
+    {
+        if (m_vm.did_reach_stack_space_limit())
+            return m_vm.throw_completion<InternalError>(ErrorType::CallStackSizeExceeded);
+
+        ignore_while(is_space);
+        switch (peek()) {
+        case '{':
+            return parse_object();
+        case '[':
+            return parse_array();
+        case '"': {
+            auto string = TRY(consume_and_unescape_string());
+            return PrimitiveString::create(m_vm, move(string));
+        }
+        case '-':
+        case '0':
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+        case '6':
+        case '7':
+        case '8':
+        case '9':
+            return parse_number();
+        case 'f':
+            if (!consume_specific("false"sv))
+                return malformed();
+            return Value(false);
+        case 't':
+            if (!consume_specific("true"sv))
+                return malformed();
+            return Value(true);
+        case 'n':
+            if (!consume_specific("null"sv))
+                return malformed();
+            return js_null();
+        }
+        return malformed();
+    }
+
+    ThrowCompletionOr<ByteString> consume_and_unescape_string()
+    {
+        if (!consume_specific('"'))
+            return m_vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
+
+        // Most strings don't contain any escape sequences, so we only reach for a StringBuilder when we see one.
+        Optional<StringBuilder> builder;
+
+        for (;;) {
+            size_t literal_characters = 0;
+            for (;;) {
+                char ch = peek(literal_characters);
+                // NOTE: We get a 0 byte when we hit EOF.
+                if (ch == 0 || is_ascii_c0_control(ch))
+                    return m_vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
+                if (ch == '"' || ch == '\\')
+                    break;
+                ++literal_characters;
+            }
+            auto literal = consume(literal_characters);
+
+            if (peek() == '"') {
+                ignore();
+                if (!builder.has_value())
+                    return ByteString { literal };
+                builder->append(literal);
+                return builder->to_byte_string();
+            }
+
+            if (!builder.has_value())
+                builder.emplace();
+            builder->append(literal);
+
+            ignore(); // '\'
+
+            switch (peek()) {
+            case '"':
+            case '\\':
+            case '/':
+                builder->append(consume());
+                break;
+            case 'b':
+                ignore();
+                builder->append('\b');
+                break;
+            case 'f':
+                ignore();
+                builder->append('\f');
+                break;
+            case 'n':
+                ignore();
+                builder->append('\n');
+                break;
+            case 'r':
+                ignore();
+                builder->append('\r');
+                break;
+            case 't':
+                ignore();
+                builder->append('\t');
+                break;
+            case 'u': {
+                ignore(); // 'u'
+                auto code_point = decode_single_or_paired_surrogate();
+                if (code_point.is_error())
+                    return m_vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
+                builder->append_code_point(code_point.value());
+                break;
+            }
+            default:
+                return m_vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
+            }
+        }
+    }
+
+    ThrowCompletionOr<Value> parse_object()
+    {
+        if (!consume_specific('{'))
+            return malformed();
+
+        // NOTE: Objects with the same keys in the same order end up sharing shapes through the cached put transitions,
+        //       so parsing a long list of similar records doesn't create a new shape per record.
+        auto object = Object::create(m_realm, m_realm.intrinsics().object_prototype());
+        for (;;) {
+            ignore_while(is_space);
+            if (peek() == '}')
+                break;
+            auto name = TRY(consume_and_unescape_string());
+            ignore_while(is_space);
+            if (!consume_specific(':'))
+                return malformed();
+            ignore_while(is_space);
+            auto value = TRY(parse_value());
+            object->define_direct_property(name, value, default_attributes);
+            ignore_while(is_space);
+            if (peek() == '}')
+                break;
+            if (!consume_specific(','))
+                return malformed();
+            ignore_while(is_space);
+            if (peek() == '}')
+                return malformed();
+        }
+        if (!consume_specific('}'))
+            return malformed();
+        return object;
+    }
+
+    ThrowCompletionOr<Value> parse_array()
+    {
+        if (!consume_specific('['))
+            return malformed();
+
+        // NOTE: We collect the elements first so the array's storage can be created at its final size in one go.
+        MarkedVector<Value> elements { m_vm.heap() };
+        for (;;) {
+            ignore_while(is_space);
+            if (peek() == ']')
+                break;
+            elements.append(TRY(parse_value()));
+            ignore_while(is_space);
+            if (peek() == ']')
+                break;
+            if (!consume_specific(','))
+                return malformed();
+            ignore_while(is_space);
+            if (peek() == ']')
+                return malformed();
+        }
+        if (!consume_specific(']'))
+            return malformed();
+        return Array::create_from(m_realm, elements);
+    }
+
+    ThrowCompletionOr<Value> parse_number()
+    {
+        auto start_index = tell();
+
+        bool negative = consume_specific('-');
+        if (!is_ascii_digit(peek()))
+            return malformed();
+
+        // Leading zeros are not allowed, but a single zero may be followed by a fraction or an exponent.
+        if (peek() == '0' && is_ascii_digit(peek(1)))
+            return malformed();
+
+        u64 integer = 0;
+        size_t digit_count = 0;
+        while (is_ascii_digit(peek())) {
+            integer = integer * 10 + parse_ascii_digit(consume());
+            ++digit_count;
+        }
+
+        bool is_integer = true;
+        if (peek() == '.') {
+            if (!is_ascii_digit(peek(1)))
+                return malformed();
+            is_integer = false;
+        } else if (peek() == 'e' || peek() == 'E') {
+            char next = peek(1);
+            if (!is_ascii_digit(next) && ((next != '+' && next != '-') || !is_ascii_digit(peek(2))))
+                return malformed();
+            is_integer = false;
+        }
+
+        // Integers with up to 19 digits fit in a u64, and converting those to a double rounds correctly.
+        if (is_integer && digit_count <= 19) {
+            auto value = static_cast<double>(integer);
+            return Value(negative ? -value : value);
+        }
+
+        auto view = m_input.substring_view(start_index);
+        char const* start = view.characters_without_null_termination();
+        auto parse_result = parse_first_floating_point<double>(start, start + view.length());
+        if (!parse_result.parsed_value())
+            return malformed();
+        m_index = start_index + (parse_result.end_ptr - start);
+        return Value(parse_result.value);
+    }
+
+    VM& m_vm;
+    Realm& m_realm;
+};
+
 // 25.5.1 JSON.parse ( text [ , reviver ] ), https://tc39.es/ecma262/#sec-json.parse
 JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
 {
@@ -413,10 +663,7 @@ JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
     auto string = TRY(vm.argument(0).to_byte_string(vm));
     auto reviver = vm.argument(1);
 
-    auto json = JsonValue::from_string(string);
-    if (json.is_error())
-        return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
-    Value unfiltered = parse_json_value(vm, json.value());
+    Value unfiltered = TRY(JSONParser(vm, string).parse());
     if (reviver.is_function()) {
         auto root = Object::create(realm, realm.intrinsics().object_prototype());
         auto root_name = ByteString::empty();
@@ -23,71 +23,86 @@ Map::Map(Object& prototype)
 // 24.1.3.1 Map.prototype.clear ( ), https://tc39.es/ecma262/#sec-map.prototype.clear
 void Map::map_clear()
 {
-    m_keys.clear();
-    m_entries.clear();
+    m_slots.clear();
+    m_indices.clear();
+    m_removed_slot_count = 0;
+    ++m_generation;
 }
 
 // 24.1.3.3 Map.prototype.delete ( key ), https://tc39.es/ecma262/#sec-map.prototype.delete
 bool Map::map_remove(Value const& key)
 {
-    Optional<size_t> index;
-
-    for (auto it = m_keys.begin(); !it.is_end(); ++it) {
-        if (ValueTraits::equals(*it, key)) {
-            index = it.key();
-            break;
-        }
-    }
-
-    if (!index.has_value())
+    auto it = m_indices.find(key);
+    if (it == m_indices.end())
         return false;
 
-    m_keys.remove(*index);
-    m_entries.remove(key);
+    m_slots[it->value].entry = {};
+    m_indices.remove(it);
+    ++m_removed_slot_count;
+
+    if (m_removed_slot_count >= 16 && m_removed_slot_count * 2 >= m_slots.size())
+        compact_slots();
     return true;
 }
 
 // 24.1.3.6 Map.prototype.get ( key ), https://tc39.es/ecma262/#sec-map.prototype.get
 Optional<Value> Map::map_get(Value const& key) const
 {
-    if (auto it = m_entries.find(key); it != m_entries.end())
-        return it->value;
+    if (auto it = m_indices.find(key); it != m_indices.end())
+        return m_slots[it->value].entry.value;
     return {};
 }
 
 // 24.1.3.7 Map.prototype.has ( key ), https://tc39.es/ecma262/#sec-map.prototype.has
 bool Map::map_has(Value const& key) const
 {
-    return m_entries.contains(key);
+    return m_indices.contains(key);
 }
 
 // 24.1.3.9 Map.prototype.set ( key, value ), https://tc39.es/ecma262/#sec-map.prototype.set
 void Map::map_set(Value const& key, Value value)
 {
-    auto it = m_entries.find(key);
-    if (it != m_entries.end()) {
-        it->value = value;
-    } else {
-        auto index = m_next_insertion_id++;
-        m_keys.insert(index, key);
-        m_entries.set(key, value);
-    }
+    auto index = m_indices.ensure(key, [&] {
+        m_slots.append({ { key, js_undefined() }, m_next_insertion_id++ });
+        return m_slots.size() - 1;
+    });
+    m_slots[index].entry.value = value;
 }
 
 size_t Map::map_size() const
 {
-    return m_keys.size();
+    return m_indices.size();
+}
+
+void Map::compact_slots()
+{
+    size_t new_index = 0;
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+        auto& slot = m_slots[i];
+        if (slot.is_removed())
+            continue;
+
+        if (new_index != i) {
+            m_indices.find(slot.entry.key)->value = new_index;
+            m_slots[new_index] = move(slot);
+        }
+        ++new_index;
+    }
+
+    m_slots.shrink(new_index);
+    m_removed_slot_count = 0;
+    ++m_generation;
 }
 
 void Map::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
-    for (auto& value : m_entries) {
-        visitor.visit(value.key);
-        visitor.visit(value.value);
+    for (auto const& slot : m_slots) {
+        if (slot.is_removed())
+            continue;
+        visitor.visit(slot.entry.key);
+        visitor.visit(slot.entry.value);
     }
-    // NOTE: The entries in m_keys are already visited by the walk over m_entries above.
-    visitor.ignore(m_keys);
 }
 
 }
@@ -7,7 +7,7 @@
 #pragma once
 
 #include <AK/HashMap.h>
-#include <AK/RedBlackTree.h>
+#include <AK/Vector.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/Object.h>
 #include <LibJS/Runtime/Value.h>
@@ -31,36 +31,50 @@ public:
     void map_set(Value const&, Value);
     size_t map_size() const;
 
+    struct Entry {
+        Value key;
+        Value value;
+    };
+
     struct EndIterator {
     };
 
+    // NOTE: Iterators stay valid while the map is modified. They follow the entry they point at by its insertion id,
+    //       and find it again if the entries have moved since.
     template<bool IsConst>
     struct IteratorImpl {
         bool is_end() const
         {
-            return m_map->m_keys.begin_from(m_index).is_end()
-                && m_map->m_keys.find_smallest_not_below_iterator(m_index).is_end();
+            ensure_next_element();
+            return m_position >= m_map->m_slots.size();
         }
 
         IteratorImpl& operator++()
         {
-            ++m_index;
+            ensure_next_element();
+            ++m_position;
+            update_insertion_id();
             return *this;
         }
 
-        decltype(auto) operator*()
+        auto& operator*()
         {
             ensure_next_element();
-            return *m_map->m_entries.find(*m_map->m_keys.begin_from(m_index));
+            return m_map->m_slots[m_position].entry;
         }
 
-        decltype(auto) operator*() const
+        auto& operator*() const
         {
             ensure_next_element();
-            return *m_map->m_entries.find(*m_map->m_keys.begin_from(m_index));
+            return m_map->m_slots[m_position].entry;
         }
 
-        bool operator==(IteratorImpl const& other) const { return m_index == other.m_index && &m_map == &other.m_map; }
+        bool operator==(IteratorImpl const& other) const
+        {
+            ensure_next_element();
+            other.ensure_next_element();
+            return m_position == other.m_position && m_map.ptr() == other.m_map.ptr();
+        }
         bool operator==(EndIterator const&) const { return is_end(); }
 
     private:
@@ -68,35 +82,54 @@ public:
         IteratorImpl(Map const& map)
         requires(IsConst)
             : m_map(map)
+            , m_generation(map.m_generation)
         {
-            ensure_index();
+            update_insertion_id();
         }
 
         IteratorImpl(Map& map)
         requires(!IsConst)
             : m_map(map)
+            , m_generation(map.m_generation)
         {
-            ensure_index();
+            update_insertion_id();
         }
 
-        void ensure_index() const
+        void update_insertion_id() const
         {
-            if (m_map->m_keys.is_empty())
-                m_index = m_map->m_next_insertion_id;
-            else
-                m_index = m_map->m_keys.begin().key();
+            auto const& slots = m_map->m_slots;
+            m_insertion_id = m_position < slots.size() ? slots[m_position].insertion_id : m_map->m_next_insertion_id;
         }
 
         void ensure_next_element() const
         {
-            if (auto it = m_map->m_keys.find_smallest_not_below_iterator(m_index); it.is_end())
-                m_index = m_map->m_next_insertion_id;
-            else
-                m_index = it.key();
+            auto const& slots = m_map->m_slots;
+
+            if (m_generation != m_map->m_generation) {
+                // The entries were compacted or cleared, so the position has to be looked up again. It is the first
+                // entry that is at least as new as the one we were pointing at, whether that one was removed or not.
+                size_t low = 0;
+                size_t high = slots.size();
+                while (low < high) {
+                    auto middle = low + (high - low) / 2;
+                    if (slots[middle].insertion_id < m_insertion_id)
+                        low = middle + 1;
+                    else
+                        high = middle;
+                }
+                m_position = low;
+                m_generation = m_map->m_generation;
+            }
+
+            while (m_position < slots.size() && slots[m_position].is_removed())
+                ++m_position;
+            update_insertion_id();
         }
 
         Conditional<IsConst, NonnullGCPtr<Map const>, NonnullGCPtr<Map>> m_map;
-        mutable size_t m_index { 0 };
+        mutable size_t m_position { 0 };
+        mutable size_t m_insertion_id { 0 };
+        mutable size_t m_generation { 0 };
     };
 
     using Iterator = IteratorImpl<false>;
@@ -110,9 +143,25 @@ private:
     explicit Map(Object& prototype);
     virtual void visit_edges(Visitor& visitor) override;
 
+    // Entries are kept in insertion order. Removed entries are left in place with an empty key until there are enough of
+    // them to be worth compacting away.
+    struct Slot {
+        bool is_removed() const { return entry.key.is_empty(); }
+
+        Entry entry;
+        size_t insertion_id { 0 };
+    };
+
+    void compact_slots();
+
+    Vector<Slot> m_slots;
+    HashMap<Value, size_t, ValueTraits> m_indices;
+    size_t m_removed_slot_count { 0 };
+
     size_t m_next_insertion_id { 0 };
-    RedBlackTree<size_t, Value> m_keys;
-    HashMap<Value, Value, ValueTraits> m_entries;
+
+    // Bumped whenever the slots move, which tells the iterators to look up their position again.
+    size_t m_generation { 0 };
 };
 
 }
@@ -121,7 +121,7 @@ ThrowCompletionOr<Value> NativeFunction::internal_call(Value this_argument, Read
     // NOTE: We don't support this concept yet.
 
     // 3. Let calleeContext be a new execution context.
-    auto callee_context = ExecutionContext::create();
+    ALLOCATE_EXECUTION_CONTEXT_ON_NATIVE_STACK(callee_context, 0, arguments_list.size());
 
     // 4. Set the Function of calleeContext to F.
     callee_context->function = this;
@@ -146,7 +146,7 @@ ThrowCompletionOr<Value> NativeFunction::internal_call(Value this_argument, Read
 
     // 8. Perform any necessary implementation-defined initialization of calleeContext.
     callee_context->this_value = this_argument;
-    callee_context->arguments.append(arguments_list.data(), arguments_list.size());
+    arguments_list.copy_to(callee_context->arguments);
 
     callee_context->lexical_environment = caller_context.lexical_environment;
     callee_context->variable_environment = caller_context.variable_environment;
@@ -184,7 +184,7 @@ ThrowCompletionOr<NonnullGCPtr<Object>> NativeFunction::internal_construct(Reado
     // NOTE: We don't support this concept yet.
 
     // 3. Let calleeContext be a new execution context.
-    auto callee_context = ExecutionContext::create();
+    ALLOCATE_EXECUTION_CONTEXT_ON_NATIVE_STACK(callee_context, 0, arguments_list.size());
 
     // 4. Set the Function of calleeContext to F.
     callee_context->function = this;
@@ -208,7 +208,7 @@ ThrowCompletionOr<NonnullGCPtr<Object>> NativeFunction::internal_construct(Reado
     // Note: This is already the default value.
 
     // 8. Perform any necessary implementation-defined initialization of calleeContext.
-    callee_context->arguments.append(arguments_list.data(), arguments_list.size());
+    arguments_list.copy_to(callee_context->arguments);
 
     callee_context->lexical_environment = caller_context.lexical_environment;
     callee_context->variable_environment = caller_context.variable_environment;
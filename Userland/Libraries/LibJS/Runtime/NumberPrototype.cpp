@@ -272,10 +272,12 @@ JS_DEFINE_NATIVE_FUNCTION(NumberPrototype::to_locale_string)
     auto number_value = TRY(this_number_value(vm, vm.this_value()));
 
     // 2. Let numberFormat be ? Construct(%NumberFormat%, « locales, options »).
-    auto* number_format = static_cast<Intl::NumberFormat*>(TRY(construct(vm, realm.intrinsics().intl_number_format_constructor(), locales, options)).ptr());
+    auto number_format = TRY(Intl::cached_to_locale_string_formatter(vm, "NumberFormat"sv, locales, options, [&]() {
+        return construct(vm, realm.intrinsics().intl_number_format_constructor(), locales, options);
+    }));
 
     // 3. Return ? FormatNumeric(numberFormat, x).
-    auto formatted = Intl::format_numeric(*number_format, number_value);
+    auto formatted = Intl::format_numeric(static_cast<Intl::NumberFormat&>(*number_format), number_value);
     return PrimitiveString::create(vm, move(formatted));
 }
 
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/CharacterTypes.h>
 #include <AK/FlyString.h>
 #include <AK/StringBuilder.h>
@@ -26,6 +27,10 @@ PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
     , m_lhs(&lhs)
     , m_rhs(&rhs)
 {
+    if (lhs.m_length_in_utf16_code_units.has_value() && rhs.m_length_in_utf16_code_units.has_value())
+        m_length_in_utf16_code_units = *lhs.m_length_in_utf16_code_units + *rhs.m_length_in_utf16_code_units;
+    if (lhs.m_is_ascii.has_value() && rhs.m_is_ascii.has_value())
+        m_is_ascii = *lhs.m_is_ascii && *rhs.m_is_ascii;
 }
 
 PrimitiveString::PrimitiveString(String string)
@@ -76,6 +81,100 @@ bool PrimitiveString::is_empty() const
     VERIFY_NOT_REACHED();
 }
 
+static size_t utf16_length_of_utf8(StringView string)
+{
+    size_t length = 0;
+    for (auto code_point : Utf8View(string))
+        length += code_point > 0xffff ? 2 : 1;
+    return length;
+}
+
+size_t PrimitiveString::length_in_utf16_code_units() const
+{
+    if (m_length_in_utf16_code_units.has_value())
+        return *m_length_in_utf16_code_units;
+
+    if (!m_is_rope) {
+        if (has_utf16_string())
+            m_length_in_utf16_code_units = m_utf16_string->length_in_code_units();
+        else if (has_utf8_string())
+            m_length_in_utf16_code_units = utf16_length_of_utf8(m_utf8_string->bytes_as_string_view());
+        else if (has_byte_string())
+            m_length_in_utf16_code_units = utf16_length_of_utf8(m_byte_string->view());
+        else
+            VERIFY_NOT_REACHED();
+        return *m_length_in_utf16_code_units;
+    }
+
+    // NOTE: We traverse the rope tree without using recursion, since we'd run out of
+    //       stack space quickly when handling a long sequence of unresolved concatenations.
+    //       Every rope we pass through remembers its length, so this only happens once per rope.
+    Vector<PrimitiveString const*> stack;
+    stack.append(this);
+    while (!stack.is_empty()) {
+        auto const* current = stack.last();
+        if (current->m_length_in_utf16_code_units.has_value()) {
+            stack.take_last();
+            continue;
+        }
+        if (!current->m_is_rope) {
+            (void)current->length_in_utf16_code_units();
+            stack.take_last();
+            continue;
+        }
+        auto const& lhs_length = current->m_lhs->m_length_in_utf16_code_units;
+        auto const& rhs_length = current->m_rhs->m_length_in_utf16_code_units;
+        if (lhs_length.has_value() && rhs_length.has_value()) {
+            current->m_length_in_utf16_code_units = *lhs_length + *rhs_length;
+            stack.take_last();
+            continue;
+        }
+        if (!rhs_length.has_value())
+            stack.append(current->m_rhs);
+        if (!lhs_length.has_value())
+            stack.append(current->m_lhs);
+    }
+
+    return *m_length_in_utf16_code_units;
+}
+
+bool PrimitiveString::has_utf16_substring_at(size_t position, Utf16View const& substring) const
+{
+    auto end = position + substring.length_in_code_units();
+    if (end > length_in_utf16_code_units())
+        return false;
+
+    if (!m_is_rope)
+        return utf16_string_view().substring_view(position, substring.length_in_code_units()) == substring;
+
+    // Only visit the pieces of the rope that overlap with [position, end), comparing each against the matching part of the substring.
+    struct Piece {
+        PrimitiveString const* string;
+        size_t start;
+    };
+    Vector<Piece> stack;
+    stack.append({ this, 0 });
+    while (!stack.is_empty()) {
+        auto [current, current_start] = stack.take_last();
+        auto current_end = current_start + current->length_in_utf16_code_units();
+        if (current_end <= position || current_start >= end)
+            continue;
+
+        if (current->m_is_rope) {
+            stack.append({ current->m_rhs, current_start + current->m_lhs->length_in_utf16_code_units() });
+            stack.append({ current->m_lhs, current_start });
+            continue;
+        }
+
+        auto overlap_start = max(position, current_start);
+        auto overlap_length = min(end, current_end) - overlap_start;
+        auto piece = current->utf16_string_view().substring_view(overlap_start - current_start, overlap_length);
+        if (piece != substring.substring_view(overlap_start - position, overlap_length))
+            return false;
+    }
+    return true;
+}
+
 String PrimitiveString::utf8_string() const
 {
     resolve_rope_if_needed(EncodingPreference::UTF8);
@@ -98,6 +197,20 @@ StringView PrimitiveString::utf8_string_view() const
     return m_utf8_string->bytes_as_string_view();
 }
 
+Optional<StringView> PrimitiveString::ascii_string_view() const
+{
+    if (!m_is_rope && !has_utf8_string() && !has_byte_string())
+        return {};
+
+    auto view = utf8_string_view();
+    if (!m_is_ascii.has_value())
+        m_is_ascii = all_of(view, [](char ch) { return is_ascii(ch); });
+
+    if (!*m_is_ascii)
+        return {};
+    return view;
+}
+
 ByteString PrimitiveString::byte_string() const
 {
     resolve_rope_if_needed(EncodingPreference::UTF8);
@@ -142,13 +255,18 @@ ThrowCompletionOr<Optional<Value>> PrimitiveString::get(VM& vm, PropertyKey cons
         return Optional<Value> {};
     if (property_key.is_string()) {
         if (property_key.as_string() == vm.names.length.as_string()) {
-            auto length = utf16_string().length_in_code_units();
+            auto length = length_in_utf16_code_units();
             return Value(static_cast<double>(length));
         }
     }
     auto index = canonical_numeric_index_string(property_key, CanonicalIndexMode::IgnoreNumericRoundtrip);
     if (!index.is_index())
         return Optional<Value> {};
+    if (auto ascii_string = ascii_string_view(); ascii_string.has_value()) {
+        if (ascii_string->length() <= index.as_index())
+            return Optional<Value> {};
+        return Value(&vm.single_ascii_character_string(ascii_string->characters_without_null_termination()[index.as_index()]));
+    }
     auto str = utf16_string_view();
     auto length = str.length_in_code_units();
     if (length <= index.as_index())
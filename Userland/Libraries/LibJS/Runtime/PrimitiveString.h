@@ -40,6 +40,10 @@ public:
 
     bool is_empty() const;
 
+    // NOTE: These work on ropes without resolving them, so they're cheap to call on the result of many concatenations.
+    [[nodiscard]] size_t length_in_utf16_code_units() const;
+    [[nodiscard]] bool has_utf16_substring_at(size_t position, Utf16View const&) const;
+
     [[nodiscard]] String utf8_string() const;
     [[nodiscard]] StringView utf8_string_view() const;
     bool has_utf8_string() const { return m_utf8_string.has_value(); }
@@ -47,6 +51,11 @@ public:
     [[nodiscard]] ByteString byte_string() const;
     bool has_byte_string() const { return m_byte_string.has_value(); }
 
+    // NOTE: A string that's all ASCII has exactly one byte per UTF-16 code unit in its UTF-8 representation, so its code
+    //       units can be read from there without converting it to UTF-16. This returns nothing for other strings, and
+    //       for strings that are only held in UTF-16.
+    [[nodiscard]] Optional<StringView> ascii_string_view() const;
+
     [[nodiscard]] Utf16String utf16_string() const;
     [[nodiscard]] Utf16View utf16_string_view() const;
     bool has_utf16_string() const { return m_utf16_string.has_value(); }
@@ -75,6 +84,9 @@ private:
     mutable Optional<String> m_utf8_string;
     mutable Optional<ByteString> m_byte_string;
     mutable Optional<Utf16String> m_utf16_string;
+
+    mutable Optional<size_t> m_length_in_utf16_code_units;
+    mutable Optional<bool> m_is_ascii;
 };
 
 }
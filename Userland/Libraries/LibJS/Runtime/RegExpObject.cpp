@@ -5,6 +5,7 @@
  */
 
 #include <AK/Function.h>
+#include <LibJS/RegExpCache.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/PrimitiveString.h>
@@ -203,26 +204,32 @@ ThrowCompletionOr<NonnullGCPtr<RegExpObject>> RegExpObject::regexp_initialize(VM
         return vm.throw_completion<SyntaxError>(parsed_flags_or_error.release_error());
     auto parsed_flags = parsed_flags_or_error.release_value();
 
-    auto parsed_pattern = ByteString::empty();
-    if (!pattern.is_empty()) {
-        bool unicode = parsed_flags.has_flag_set(regex::ECMAScriptFlags::Unicode);
-        bool unicode_sets = parsed_flags.has_flag_set(regex::ECMAScriptFlags::UnicodeSets);
-
-        // 11. If u is true or v is true, then
-        //     a. Let patternText be StringToCodePoints(P).
-        // 12. Else,
-        //     a. Let patternText be the result of interpreting each of P's 16-bit elements as a Unicode BMP code point. UTF-16 decoding is not applied to the elements.
-        // 13. Let parseResult be ParsePattern(patternText, u, v).
-        parsed_pattern = TRY(parse_regex_pattern(vm, pattern, unicode, unicode_sets));
-    }
+    // OPTIMIZATION: Only patterns that compiled successfully are cached, so steps 11 to 15 can be skipped for those.
+    auto regex = vm.regexp_cache().find(pattern, flags);
+    if (!regex.has_value()) {
+        auto parsed_pattern = ByteString::empty();
+        if (!pattern.is_empty()) {
+            bool unicode = parsed_flags.has_flag_set(regex::ECMAScriptFlags::Unicode);
+            bool unicode_sets = parsed_flags.has_flag_set(regex::ECMAScriptFlags::UnicodeSets);
+
+            // 11. If u is true or v is true, then
+            //     a. Let patternText be StringToCodePoints(P).
+            // 12. Else,
+            //     a. Let patternText be the result of interpreting each of P's 16-bit elements as a Unicode BMP code point. UTF-16 decoding is not applied to the elements.
+            // 13. Let parseResult be ParsePattern(patternText, u, v).
+            parsed_pattern = TRY(parse_regex_pattern(vm, pattern, unicode, unicode_sets));
+        }
 
-    // 14. If parseResult is a non-empty List of SyntaxError objects, throw a SyntaxError exception.
-    Regex<ECMA262> regex(move(parsed_pattern), parsed_flags);
-    if (regex.parser_result.error != regex::Error::NoError)
-        return vm.throw_completion<SyntaxError>(ErrorType::RegExpCompileError, regex.error_string());
+        // 14. If parseResult is a non-empty List of SyntaxError objects, throw a SyntaxError exception.
+        regex.emplace(move(parsed_pattern), parsed_flags);
+        if (regex->parser_result.error != regex::Error::NoError)
+            return vm.throw_completion<SyntaxError>(ErrorType::RegExpCompileError, regex->error_string());
 
-    // 15. Assert: parseResult is a Pattern Parse Node.
-    VERIFY(regex.parser_result.error == regex::Error::NoError);
+        // 15. Assert: parseResult is a Pattern Parse Node.
+        VERIFY(regex->parser_result.error == regex::Error::NoError);
+
+        vm.regexp_cache().add(pattern, flags, *regex);
+    }
 
     // 16. Set obj.[[OriginalSource]] to P.
     m_pattern = move(pattern);
@@ -234,7 +241,7 @@ ThrowCompletionOr<NonnullGCPtr<RegExpObject>> RegExpObject::regexp_initialize(VM
     // 19. Let rer be the RegExp Record { [[IgnoreCase]]: i, [[Multiline]]: m, [[DotAll]]: s, [[Unicode]]: u, [[CapturingGroupsCount]]: capturingGroupsCount }.
     // 20. Set obj.[[RegExpRecord]] to rer.
     // 21. Set obj.[[RegExpMatcher]] to CompilePattern of parseResult with argument rer.
-    m_regex = move(regex);
+    m_regex = regex.release_value();
 
     // 22. Perform ? Set(obj, "lastIndex", +0𝔽, true).
     TRY(set(vm.names.lastIndex, Value(0), Object::ShouldThrowExceptions::Yes));
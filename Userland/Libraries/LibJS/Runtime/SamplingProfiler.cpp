@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Runtime/ECMAScriptFunctionObject.h>
+#include <LibJS/Runtime/ExecutionContext.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
+#include <LibJS/Runtime/VM.h>
+
+namespace JS {
+
+SamplingProfiler::SamplingProfiler(VM& vm, AK::Duration sampling_interval)
+    : m_vm(vm)
+    , m_sampling_interval(sampling_interval)
+{
+    m_nodes.append({});
+    m_frames.append({ .function_name = "(root)", .url = {}, .line_number = 0, .column_number = 0 });
+}
+
+void SamplingProfiler::start()
+{
+    m_running = true;
+    m_start_time = MonotonicTime::now();
+    m_next_sample_time = m_start_time;
+    m_ticks_until_clock_check = ticks_between_clock_checks;
+}
+
+void SamplingProfiler::stop()
+{
+    m_running = false;
+    m_end_time = MonotonicTime::now();
+}
+
+SamplingProfiler::Frame SamplingProfiler::frame_for(ExecutionContext const& context, Optional<size_t> program_counter) const
+{
+    Frame frame;
+    if (context.function_name)
+        frame.function_name = context.function_name->byte_string();
+    else if (context.function)
+        frame.function_name = context.function->name();
+    if (frame.function_name.is_empty())
+        frame.function_name = context.function ? "(anonymous)" : "(top level)";
+
+    Optional<SourceRange> source_range;
+    if (context.executable && program_counter.has_value()) {
+        source_range = context.executable->source_range_at(*program_counter).realize();
+    } else if (context.function && is<ECMAScriptFunctionObject>(*context.function)) {
+        // NOTE: This is a function that hasn't started executing yet (we're sampling right as it's being called),
+        //       so we attribute the sample to the start of its body.
+        source_range = static_cast<ECMAScriptFunctionObject const&>(*context.function).ecmascript_code().source_range();
+    }
+
+    if (source_range.has_value()) {
+        frame.url = source_range->filename();
+        frame.line_number = source_range->start.line;
+        frame.column_number = source_range->start.column;
+    } else if (context.function) {
+        frame.url = "(native)";
+    }
+
+    return frame;
+}
+
+u32 SamplingProfiler::intern_frame(Frame frame)
+{
+    if (auto index = m_frame_indices.get(frame); index.has_value())
+        return *index;
+    auto index = static_cast<u32>(m_frames.size());
+    m_frame_indices.set(frame, index);
+    m_frames.append(move(frame));
+    return index;
+}
+
+u32 SamplingProfiler::child_node(u32 parent_index, u32 frame_index)
+{
+    auto key = (static_cast<u64>(parent_index) << 32) | frame_index;
+    if (auto index = m_child_node_indices.get(key); index.has_value())
+        return *index;
+    auto index = static_cast<u32>(m_nodes.size());
+    m_nodes.append({ .frame_index = frame_index, .parent_index = parent_index, .hit_count = 0, .children = {} });
+    m_nodes[parent_index].children.append(index);
+    m_child_node_indices.set(key, index);
+    return index;
+}
+
+void SamplingProfiler::take_sample_if_due(Optional<size_t> program_counter)
+{
+    auto now = MonotonicTime::now();
+    if (now < m_next_sample_time)
+        return;
+    m_next_sample_time = now + m_sampling_interval;
+
+    auto const& stack = m_vm.execution_context_stack();
+    if (stack.is_empty())
+        return;
+
+    u32 node_index = 0;
+    for (size_t i = 0; i < stack.size(); ++i) {
+        auto const& context = *stack[i];
+        // NOTE: Contexts below the running one had their program counter saved when they made a call.
+        auto context_program_counter = i == stack.size() - 1 ? program_counter : context.program_counter;
+        node_index = child_node(node_index, intern_frame(frame_for(context, context_program_counter)));
+    }
+
+    ++m_nodes[node_index].hit_count;
+    m_samples.append({ .node_index = node_index, .timestamp = now });
+}
+
+// https://chromedevtools.github.io/devtools-protocol/tot/Profiler/#type-Profile
+AK::JsonObject SamplingProfiler::to_cpuprofile_json() const
+{
+    auto nodes = AK::JsonArray();
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+        auto const& node = m_nodes[i];
+        auto const& frame = m_frames[node.frame_index];
+
+        auto call_frame = AK::JsonObject();
+        call_frame.set("functionName"sv, frame.function_name);
+        call_frame.set("scriptId"sv, "0"sv);
+        call_frame.set("url"sv, frame.url);
+        // NOTE: The format wants zero-based line and column numbers.
+        call_frame.set("lineNumber"sv, static_cast<i64>(frame.line_number) - 1);
+        call_frame.set("columnNumber"sv, static_cast<i64>(frame.column_number) - 1);
+
+        auto children = AK::JsonArray();
+        for (auto child_index : node.children)
+            children.must_append(child_index + 1);
+
+        auto json_node = AK::JsonObject();
+        // NOTE: Node IDs have to be positive.
+        json_node.set("id"sv, i + 1);
+        json_node.set("callFrame"sv, move(call_frame));
+        json_node.set("hitCount"sv, node.hit_count);
+        json_node.set("children"sv, move(children));
+        nodes.must_append(move(json_node));
+    }
+
+    auto samples = AK::JsonArray();
+    auto time_deltas = AK::JsonArray();
+    auto previous_timestamp = m_start_time;
+    for (auto const& sample : m_samples) {
+        samples.must_append(sample.node_index + 1);
+        time_deltas.must_append((sample.timestamp - previous_timestamp).to_microseconds());
+        previous_timestamp = sample.timestamp;
+    }
+
+    auto end_time = m_running ? MonotonicTime::now() : m_end_time;
+
+    auto profile = AK::JsonObject();
+    profile.set("nodes"sv, move(nodes));
+    profile.set("startTime"sv, m_start_time.nanoseconds() / 1000);
+    profile.set("endTime"sv, end_time.nanoseconds() / 1000);
+    profile.set("samples"sv, move(samples));
+    profile.set("timeDeltas"sv, move(time_deltas));
+    return profile;
+}
+
+}
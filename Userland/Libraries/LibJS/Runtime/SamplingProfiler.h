@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Forward.h>
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+
+namespace JS {
+
+// Periodically records the execution context stack, so that we can see where time goes in JS code.
+// NOTE: The interpreter only gives us a chance to sample at calls and unconditional jumps (e.g. loop back edges),
+//       and we only look at the clock every few of those to keep the overhead down.
+class SamplingProfiler {
+public:
+    static constexpr u32 ticks_between_clock_checks = 64;
+
+    explicit SamplingProfiler(VM&, AK::Duration sampling_interval = AK::Duration::from_milliseconds(1));
+
+    void start();
+    void stop();
+    [[nodiscard]] bool is_running() const { return m_running; }
+
+    // The program counter should be that of the running execution context, if we know it.
+    ALWAYS_INLINE void tick(Optional<size_t> program_counter)
+    {
+        if (!m_running || --m_ticks_until_clock_check != 0)
+            return;
+        m_ticks_until_clock_check = ticks_between_clock_checks;
+        take_sample_if_due(program_counter);
+    }
+
+    [[nodiscard]] size_t sample_count() const { return m_samples.size(); }
+
+    // Serializes the samples in the .cpuprofile format understood by Chrome DevTools.
+    AK::JsonObject to_cpuprofile_json() const;
+
+private:
+    struct Frame {
+        ByteString function_name;
+        ByteString url;
+        u32 line_number { 0 };
+        u32 column_number { 0 };
+
+        bool operator==(Frame const&) const = default;
+    };
+
+    struct FrameTraits : public DefaultTraits<Frame> {
+        static unsigned hash(Frame const& frame)
+        {
+            return pair_int_hash(pair_int_hash(frame.function_name.hash(), frame.url.hash()), pair_int_hash(frame.line_number, frame.column_number));
+        }
+    };
+
+    struct Node {
+        u32 frame_index { 0 };
+        u32 parent_index { 0 };
+        u32 hit_count { 0 };
+        Vector<u32> children;
+    };
+
+    struct Sample {
+        u32 node_index { 0 };
+        MonotonicTime timestamp;
+    };
+
+    void take_sample_if_due(Optional<size_t> program_counter);
+    Frame frame_for(ExecutionContext const&, Optional<size_t> program_counter) const;
+    u32 intern_frame(Frame);
+    u32 child_node(u32 parent_index, u32 frame_index);
+
+    VM& m_vm;
+    AK::Duration m_sampling_interval;
+    MonotonicTime m_start_time { MonotonicTime::now() };
+    MonotonicTime m_end_time { MonotonicTime::now() };
+    MonotonicTime m_next_sample_time { MonotonicTime::now() };
+    u32 m_ticks_until_clock_check { ticks_between_clock_checks };
+    bool m_running { false };
+
+    Vector<Frame> m_frames;
+    HashMap<Frame, u32, FrameTraits> m_frame_indices;
+
+    // NOTE: Node 0 is the root of the call tree.
+    Vector<Node> m_nodes;
+    HashMap<u64, u32> m_child_node_indices;
+
+    Vector<Sample> m_samples;
+};
+
+}
@@ -14,6 +14,33 @@ JS_DEFINE_ALLOCATOR(Shape);
 JS_DEFINE_ALLOCATOR(PrototypeChainValidity);
 
 static HashTable<JS::GCPtr<Shape>> s_all_prototype_shapes;
+static HashTable<PropertyTable*> s_all_property_tables;
+
+PropertyTable::PropertyTable()
+{
+    s_all_property_tables.set(this);
+}
+
+PropertyTable::~PropertyTable()
+{
+    s_all_property_tables.remove(this);
+}
+
+Shape::MemoryStatistics Shape::memory_statistics()
+{
+    // NOTE: This is an estimate; an ordered hash table bucket holds the entry, its probe state and the insertion order links.
+    static constexpr size_t approximate_bucket_size = sizeof(StringOrSymbol) + sizeof(PropertyMetadata) + 3 * sizeof(void*);
+
+    MemoryStatistics statistics;
+    for (auto* table : s_all_property_tables) {
+        ++statistics.property_table_count;
+        if (table->ref_count() > 1)
+            ++statistics.shared_property_table_count;
+        statistics.property_table_entry_count += table->entries.size();
+        statistics.property_table_bytes += sizeof(PropertyTable) + table->entries.capacity() * approximate_bucket_size;
+    }
+    return statistics;
+}
 
 Shape::~Shape()
 {
@@ -28,10 +55,8 @@ NonnullGCPtr<Shape> Shape::create_cacheable_dictionary_transition()
     new_shape->m_cacheable = true;
     new_shape->m_prototype = m_prototype;
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
-    ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->m_property_table = copy_visible_property_table();
+    new_shape->m_property_count = new_shape->m_property_table->entries.size();
     return new_shape;
 }
 
@@ -42,10 +67,8 @@ NonnullGCPtr<Shape> Shape::create_uncacheable_dictionary_transition()
     new_shape->m_cacheable = true;
     new_shape->m_prototype = m_prototype;
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
-    ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->m_property_table = copy_visible_property_table();
+    new_shape->m_property_count = new_shape->m_property_table->entries.size();
     return new_shape;
 }
 
@@ -192,6 +215,7 @@ void Shape::visit_edges(Cell::Visitor& visitor)
 
     // NOTE: We don't need to mark the keys in the property table, since they are guaranteed
     //       to also be marked by the chain of shapes leading up to this one.
+    //       Entries past our property count in a shared table belong to other shapes, and we never look at them.
 
     visitor.ignore(m_prototype_transitions);
 
@@ -214,8 +238,9 @@ Optional<PropertyMetadata> Shape::lookup(StringOrSymbol const& property_key) con
 {
     if (m_property_count == 0)
         return {};
-    auto property = property_table().get(property_key);
-    if (!property.has_value())
+    ensure_property_table();
+    auto property = m_property_table->entries.get(property_key);
+    if (!property.has_value() || property->offset >= m_property_count)
         return {};
     return property;
 }
@@ -223,45 +248,86 @@ Optional<PropertyMetadata> Shape::lookup(StringOrSymbol const& property_key) con
 FLATTEN OrderedHashMap<StringOrSymbol, PropertyMetadata> const& Shape::property_table() const
 {
     ensure_property_table();
-    return *m_property_table;
+    if (m_property_table->entries.size() != m_property_count)
+        ensure_property_table_is_private();
+    return m_property_table->entries;
+}
+
+NonnullRefPtr<PropertyTable> Shape::copy_visible_property_table() const
+{
+    ensure_property_table();
+    auto table = PropertyTable::create();
+    table->entries.ensure_capacity(m_property_count);
+    for (auto const& it : m_property_table->entries) {
+        if (it.value.offset < m_property_count)
+            table->entries.set(it.key, it.value);
+    }
+    return table;
+}
+
+void Shape::ensure_property_table_is_private() const
+{
+    VERIFY(m_property_table);
+    if (m_property_table->ref_count() > 1) {
+        m_property_table = copy_visible_property_table();
+        return;
+    }
+    // Nobody else is sharing the table anymore, so we can drop the entries left behind by other shapes in place.
+    if (m_property_table->entries.size() != m_property_count)
+        m_property_table->entries.remove_all_matching([&](auto const&, auto const& metadata) { return metadata.offset >= m_property_count; });
 }
 
 void Shape::ensure_property_table() const
 {
     if (m_property_table)
         return;
-    m_property_table = make<OrderedHashMap<StringOrSymbol, PropertyMetadata>>();
 
     u32 next_offset = 0;
 
+    // If the only transitions between us and the nearest shape with a property table are puts (or prototype changes),
+    // and that shape's table hasn't been extended by anyone else yet, we can append our properties to it and share it.
+    bool can_share_table = true;
+
     Vector<Shape const&, 64> transition_chain;
     transition_chain.append(*this);
     for (auto shape = m_previous; shape; shape = shape->m_previous) {
         if (shape->m_property_table) {
-            *m_property_table = *shape->m_property_table;
+            if (can_share_table && !shape->m_dictionary && shape->m_property_table->entries.size() == shape->m_property_count)
+                m_property_table = shape->m_property_table;
+            else
+                m_property_table = shape->copy_visible_property_table();
             next_offset = shape->m_property_count;
             break;
         }
         transition_chain.append(*shape);
+        if (shape->m_transition_type != TransitionType::Put && shape->m_transition_type != TransitionType::Prototype)
+            can_share_table = false;
     }
 
+    if (m_transition_type != TransitionType::Put && m_transition_type != TransitionType::Prototype)
+        can_share_table = false;
+
+    if (!m_property_table)
+        m_property_table = PropertyTable::create();
+
+    auto& entries = m_property_table->entries;
     for (auto const& shape : transition_chain.in_reverse()) {
         if (!shape.m_property_key.is_valid()) {
             // Ignore prototype transitions as they don't affect the key map.
             continue;
         }
         if (shape.m_transition_type == TransitionType::Put) {
-            m_property_table->set(shape.m_property_key, { next_offset++, shape.m_attributes });
+            entries.set(shape.m_property_key, { next_offset++, shape.m_attributes });
         } else if (shape.m_transition_type == TransitionType::Configure) {
-            auto it = m_property_table->find(shape.m_property_key);
-            VERIFY(it != m_property_table->end());
+            auto it = entries.find(shape.m_property_key);
+            VERIFY(it != entries.end());
             it->value.attributes = shape.m_attributes;
         } else if (shape.m_transition_type == TransitionType::Delete) {
-            auto remove_it = m_property_table->find(shape.m_property_key);
-            VERIFY(remove_it != m_property_table->end());
+            auto remove_it = entries.find(shape.m_property_key);
+            VERIFY(remove_it != entries.end());
             auto removed_offset = remove_it->value.offset;
-            m_property_table->remove(remove_it);
-            for (auto& it : *m_property_table) {
+            entries.remove(remove_it);
+            for (auto& it : entries) {
                 if (it.value.offset > removed_offset)
                     --it.value.offset;
             }
@@ -286,7 +352,8 @@ void Shape::add_property_without_transition(StringOrSymbol const& property_key,
 {
     VERIFY(property_key.is_valid());
     ensure_property_table();
-    if (m_property_table->set(property_key, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry) {
+    ensure_property_table_is_private();
+    if (m_property_table->entries.set(property_key, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry) {
         VERIFY(m_property_count < NumericLimits<u32>::max());
         ++m_property_count;
     }
@@ -302,19 +369,21 @@ void Shape::set_property_attributes_without_transition(StringOrSymbol const& pro
 {
     VERIFY(is_dictionary());
     VERIFY(m_property_table);
-    auto it = m_property_table->find(property_key);
-    VERIFY(it != m_property_table->end());
+    ensure_property_table_is_private();
+    auto it = m_property_table->entries.find(property_key);
+    VERIFY(it != m_property_table->entries.end());
     it->value.attributes = attributes;
-    m_property_table->set(property_key, it->value);
+    m_property_table->entries.set(property_key, it->value);
 }
 
 void Shape::remove_property_without_transition(StringOrSymbol const& property_key, u32 offset)
 {
     VERIFY(is_uncacheable_dictionary());
     VERIFY(m_property_table);
-    if (m_property_table->remove(property_key))
+    ensure_property_table_is_private();
+    if (m_property_table->entries.remove(property_key))
         --m_property_count;
-    for (auto& it : *m_property_table) {
+    for (auto& it : m_property_table->entries) {
         VERIFY(it.value.offset != offset);
         if (it.value.offset > offset)
             --it.value.offset;
@@ -339,10 +408,8 @@ NonnullGCPtr<Shape> Shape::clone_for_prototype()
     s_all_prototype_shapes.set(new_shape);
     new_shape->m_is_prototype_shape = true;
     new_shape->m_prototype = m_prototype;
-    ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->m_property_table = copy_visible_property_table();
+    new_shape->m_property_count = new_shape->m_property_table->entries.size();
     new_shape->m_prototype_chain_validity = heap().allocate_without_realm<PrototypeChainValidity>();
     return new_shape;
 }
@@ -8,6 +8,8 @@
 
 #include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
 #include <AK/StringView.h>
 #include <AK/WeakPtr.h>
 #include <AK/Weakable.h>
@@ -34,6 +36,19 @@ struct TransitionKey {
     }
 };
 
+// A property table may be shared by every shape along a chain of put transitions.
+// Each of those shapes only sees the entries whose offset is below its own property count.
+class PropertyTable : public RefCounted<PropertyTable> {
+public:
+    static NonnullRefPtr<PropertyTable> create() { return adopt_ref(*new PropertyTable); }
+    ~PropertyTable();
+
+    OrderedHashMap<StringOrSymbol, PropertyMetadata> entries;
+
+private:
+    PropertyTable();
+};
+
 class PrototypeChainValidity final : public Cell {
     JS_CELL(PrototypeChainValidity, Cell);
     JS_DECLARE_ALLOCATOR(PrototypeChainValidity);
@@ -103,6 +118,14 @@ public:
         PropertyMetadata value;
     };
 
+    struct MemoryStatistics {
+        size_t property_table_count { 0 };
+        size_t shared_property_table_count { 0 };
+        size_t property_table_entry_count { 0 };
+        size_t property_table_bytes { 0 };
+    };
+    [[nodiscard]] static MemoryStatistics memory_statistics();
+
     void set_prototype_without_transition(Object* new_prototype);
 
 private:
@@ -121,10 +144,12 @@ private:
     [[nodiscard]] GCPtr<Shape> get_or_prune_cached_delete_transition(StringOrSymbol const&);
 
     void ensure_property_table() const;
+    void ensure_property_table_is_private() const;
+    [[nodiscard]] NonnullRefPtr<PropertyTable> copy_visible_property_table() const;
 
     NonnullGCPtr<Realm> m_realm;
 
-    mutable OwnPtr<OrderedHashMap<StringOrSymbol, PropertyMetadata>> m_property_table;
+    mutable RefPtr<PropertyTable> m_property_table;
 
     OwnPtr<HashMap<TransitionKey, WeakPtr<Shape>>> m_forward_transitions;
     OwnPtr<HashMap<GCPtr<Object>, WeakPtr<Shape>>> m_prototype_transitions;
@@ -48,6 +48,141 @@ static ThrowCompletionOr<Utf16String> utf16_string_from(VM& vm)
     return TRY(this_value.to_utf16_string(vm));
 }
 
+// NOTE: Unlike utf16_string_from(), this doesn't resolve the string if it's a rope.
+static ThrowCompletionOr<NonnullGCPtr<PrimitiveString>> primitive_string_from(VM& vm)
+{
+    auto this_value = TRY(require_object_coercible(vm, vm.this_value()));
+    return TRY(this_value.to_primitive_string(vm));
+}
+
+// OPTIMIZATION: In a string that's all ASCII, each code unit is one byte of its UTF-8 representation. Such strings can be
+//               searched, split and indexed as they are, instead of being converted to UTF-16 first.
+static Optional<StringView> ascii_string_view(Value value)
+{
+    if (!value.is_string())
+        return {};
+    return value.as_string().ascii_string_view();
+}
+
+// The code units of the this value, read from its UTF-8 bytes if it's an ASCII string, or converted to UTF-16 otherwise.
+// NOTE: The ASCII view is only taken from a primitive this value, which stays alive for as long as the function runs.
+class CodeUnitString {
+public:
+    static ThrowCompletionOr<CodeUnitString> from_this_value(VM& vm)
+    {
+        if (auto ascii_string = ascii_string_view(vm.this_value()); ascii_string.has_value())
+            return CodeUnitString { *ascii_string };
+        return CodeUnitString { TRY(utf16_string_from(vm)) };
+    }
+
+    size_t length_in_code_units() const
+    {
+        return m_string.visit(
+            [](StringView string) { return string.length(); },
+            [](Utf16String const& string) { return string.length_in_code_units(); });
+    }
+
+    u16 code_unit_at(size_t index) const
+    {
+        return m_string.visit(
+            [&](StringView string) -> u16 { return static_cast<u8>(string[index]); },
+            [&](Utf16String const& string) { return string.code_unit_at(index); });
+    }
+
+    u32 code_point_at(size_t index) const
+    {
+        return m_string.visit(
+            [&](StringView string) -> u32 { return static_cast<u8>(string[index]); },
+            [&](Utf16String const& string) { return JS::code_point_at(string.view(), index).code_point; });
+    }
+
+    NonnullGCPtr<PrimitiveString> substring(VM& vm, size_t start, size_t length) const
+    {
+        return m_string.visit(
+            [&](StringView string) {
+                return PrimitiveString::create(vm, String::from_utf8_without_validation(string.substring_view(start, length).bytes()));
+            },
+            [&](Utf16String const& string) {
+                return PrimitiveString::create(vm, Utf16String::create(string.substring_view(start, length)));
+            });
+    }
+
+private:
+    explicit CodeUnitString(Variant<StringView, Utf16String> string)
+        : m_string(move(string))
+    {
+    }
+
+    Variant<StringView, Utf16String> m_string;
+};
+
+static NonnullGCPtr<PrimitiveString> create_ascii_substring(VM& vm, StringView string, size_t start, size_t length)
+{
+    return PrimitiveString::create(vm, String::from_utf8_without_validation(string.substring_view(start, length).bytes()));
+}
+
+static ThrowCompletionOr<Value> split_ascii_string(VM& vm, StringView string, StringView separator, Value limit_argument)
+{
+    auto& realm = *vm.current_realm();
+
+    auto array = MUST(Array::create(realm, 0));
+    size_t array_length = 0;
+
+    auto limit = NumericLimits<u32>::max();
+    if (!limit_argument.is_undefined())
+        limit = TRY(limit_argument.to_u32(vm));
+
+    if (limit == 0)
+        return array;
+
+    if (string.is_empty()) {
+        if (!separator.is_empty())
+            MUST(array->create_data_property_or_throw(0, PrimitiveString::create(vm, string)));
+        return array;
+    }
+
+    // An empty separator splits the string into its code units, but never gives an empty string at the end.
+    if (separator.is_empty()) {
+        for (size_t i = 0; i < string.length() && array_length < limit; ++i)
+            MUST(array->create_data_property_or_throw(array_length++, &vm.single_ascii_character_string(string[i])));
+        return array;
+    }
+
+    size_t start = 0;
+    for (auto position = string.find(separator); position.has_value(); position = string.find(separator, start)) {
+        MUST(array->create_data_property_or_throw(array_length++, create_ascii_substring(vm, string, start, *position - start)));
+        if (array_length == limit)
+            return array;
+        start = *position + separator.length();
+    }
+
+    MUST(array->create_data_property_or_throw(array_length, create_ascii_substring(vm, string, start, string.length() - start)));
+    return array;
+}
+
+// NOTE: A replacement without any '$' is inserted as it is, so there is nothing for GetSubstitution to do with it.
+static NonnullGCPtr<PrimitiveString> replace_all_in_ascii_string(VM& vm, StringView string, StringView search_string, StringView replacement)
+{
+    VERIFY(!search_string.is_empty());
+
+    auto position = string.find(search_string);
+    if (!position.has_value())
+        return PrimitiveString::create(vm, String::from_utf8_without_validation(string.bytes()));
+
+    StringBuilder builder(string.length());
+    size_t end_of_last_match = 0;
+
+    do {
+        builder.append(string.substring_view(end_of_last_match, *position - end_of_last_match));
+        builder.append(replacement);
+        end_of_last_match = *position + search_string.length();
+        position = string.find(search_string, end_of_last_match);
+    } while (position.has_value());
+
+    builder.append(string.substring_view(end_of_last_match));
+    return PrimitiveString::create(vm, MUST(builder.to_string()));
+}
+
 // 22.1.3.21.1 SplitMatch ( S, q, R ), https://tc39.es/ecma262/#sec-splitmatch
 // FIXME: This no longer exists in the spec!
 static Optional<size_t> split_match(Utf16View const& haystack, size_t start, Utf16View const& needle)
@@ -251,7 +386,7 @@ static ThrowCompletionOr<NonnullGCPtr<PrimitiveString>> this_string_value(VM& vm
 JS_DEFINE_NATIVE_FUNCTION(StringPrototype::at)
 {
     // 1. Let O be ? ToObject(this value).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(CodeUnitString::from_this_value(vm));
     // 2. Let len be ? LengthOfArrayLike(O).
     auto length = string.length_in_code_units();
 
@@ -277,7 +412,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::at)
         return js_undefined();
 
     // 7. Return ? Get(O, ! ToString(𝔽(k))).
-    return PrimitiveString::create(vm, Utf16String::create(string.substring_view(index.value(), 1)));
+    return string.substring(vm, index.value(), 1);
 }
 
 // 22.1.3.2 String.prototype.charAt ( pos ), https://tc39.es/ecma262/#sec-string.prototype.charat
@@ -285,7 +420,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::char_at)
 {
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(CodeUnitString::from_this_value(vm));
 
     // 3. Let position be ? ToIntegerOrInfinity(pos).
     auto position = TRY(vm.argument(0).to_integer_or_infinity(vm));
@@ -296,7 +431,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::char_at)
         return PrimitiveString::create(vm, String {});
 
     // 6. Return the substring of S from position to position + 1.
-    return PrimitiveString::create(vm, Utf16String::create(string.substring_view(position, 1)));
+    return string.substring(vm, position, 1);
 }
 
 // 22.1.3.3 String.prototype.charCodeAt ( pos ), https://tc39.es/ecma262/#sec-string.prototype.charcodeat
@@ -304,7 +439,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::char_code_at)
 {
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(CodeUnitString::from_this_value(vm));
 
     // 3. Let position be ? ToIntegerOrInfinity(pos).
     auto position = TRY(vm.argument(0).to_integer_or_infinity(vm));
@@ -323,7 +458,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::code_point_at)
 {
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(CodeUnitString::from_this_value(vm));
 
     // 3. Let position be ? ToIntegerOrInfinity(pos).
     auto position = TRY(vm.argument(0).to_integer_or_infinity(vm));
@@ -334,10 +469,10 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::code_point_at)
         return js_undefined();
 
     // 6. Let cp be CodePointAt(S, position).
-    auto code_point = JS::code_point_at(string.view(), position);
+    auto code_point = string.code_point_at(position);
 
     // 7. Return 𝔽(cp.[[CodePoint]]).
-    return Value(code_point.code_point);
+    return Value(code_point);
 }
 
 // 22.1.3.5 String.prototype.concat ( ...args ), https://tc39.es/ecma262/#sec-string.prototype.concat
@@ -373,7 +508,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::ends_with)
 
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(primitive_string_from(vm));
 
     // Let isRegExp be ? IsRegExp(searchString).
     bool is_regexp = TRY(search_string_value.is_regexp(vm));
@@ -386,7 +521,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::ends_with)
     auto search_string = TRY(search_string_value.to_utf16_string(vm));
 
     // 6. Let len be the length of S.
-    auto string_length = string.length_in_code_units();
+    auto string_length = string->length_in_utf16_code_units();
 
     // 7. If endPosition is undefined, let pos be len; else let pos be ? ToIntegerOrInfinity(endPosition).
     size_t end = string_length;
@@ -412,11 +547,9 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::ends_with)
     size_t start = end - search_length;
 
     // 13. Let substring be the substring of S from start to end.
-    auto substring_view = string.substring_view(start, end - start);
-
     // 14. If substring is searchStr, return true.
     // 15. Return false.
-    return Value(substring_view == search_string.view());
+    return Value(string->has_utf16_substring_at(start, search_string.view()));
 }
 
 // 22.1.3.8 String.prototype.includes ( searchString [ , position ] ), https://tc39.es/ecma262/#sec-string.prototype.includes
@@ -461,6 +594,19 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::includes)
 // 22.1.3.9 String.prototype.indexOf ( searchString [ , position ] ), https://tc39.es/ecma262/#sec-string.prototype.indexof
 JS_DEFINE_NATIVE_FUNCTION(StringPrototype::index_of)
 {
+    if (auto ascii_string = ascii_string_view(vm.this_value()); ascii_string.has_value()) {
+        if (auto ascii_search_string = ascii_string_view(vm.argument(0)); ascii_search_string.has_value()) {
+            size_t start = 0;
+            if (vm.argument_count() > 1) {
+                auto position = TRY(vm.argument(1).to_integer_or_infinity(vm));
+                start = clamp(position, static_cast<double>(0), static_cast<double>(ascii_string->length()));
+            }
+
+            auto index = ascii_string->find(*ascii_search_string, start);
+            return index.has_value() ? Value(*index) : Value(-1);
+        }
+    }
+
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
     auto string = TRY(utf16_string_from(vm));
@@ -900,6 +1046,14 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::replace_all)
         }
     }
 
+    if (auto ascii_string = ascii_string_view(this_object); ascii_string.has_value()) {
+        auto ascii_search_string = ascii_string_view(search_value);
+        auto ascii_replacement = ascii_string_view(replace_value);
+
+        if (ascii_search_string.has_value() && !ascii_search_string->is_empty() && ascii_replacement.has_value() && !ascii_replacement->contains('$'))
+            return replace_all_in_ascii_string(vm, *ascii_string, *ascii_search_string, *ascii_replacement);
+    }
+
     // 3. Let string be ? ToString(O).
     auto string = TRY(this_object.to_utf16_string(vm));
 
@@ -1018,7 +1172,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::slice)
 
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(CodeUnitString::from_this_value(vm));
 
     // 3. Let len be the length of S.
     auto string_length = static_cast<double>(string.length_in_code_units());
@@ -1056,7 +1210,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::slice)
         return PrimitiveString::create(vm, String {});
 
     // 13. Return the substring of S from from to to.
-    return PrimitiveString::create(vm, Utf16String::create(string.substring_view(int_start, int_end - int_start)));
+    return string.substring(vm, int_start, int_end - int_start);
 }
 
 // 22.1.3.23 String.prototype.split ( separator, limit ), https://tc39.es/ecma262/#sec-string.prototype.split
@@ -1080,6 +1234,11 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::split)
         }
     }
 
+    if (auto ascii_string = ascii_string_view(object); ascii_string.has_value()) {
+        if (auto ascii_separator = ascii_string_view(separator_argument); ascii_separator.has_value())
+            return split_ascii_string(vm, *ascii_string, *ascii_separator, limit_argument);
+    }
+
     // 3. Let S be ? ToString(O).
     auto string = TRY(object.to_utf16_string(vm));
 
@@ -1169,7 +1328,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::starts_with)
 
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(primitive_string_from(vm));
 
     // 3. Let isRegExp be ? IsRegExp(searchString).
     bool is_regexp = TRY(search_string_value.is_regexp(vm));
@@ -1182,7 +1341,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::starts_with)
     auto search_string = TRY(search_string_value.to_utf16_string(vm));
 
     // 6. Let len be the length of S.
-    auto string_length = string.length_in_code_units();
+    auto string_length = string->length_in_utf16_code_units();
 
     size_t start = 0;
 
@@ -1209,11 +1368,9 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::starts_with)
         return Value(false);
 
     // 13. Let substring be the substring of S from start to end.
-    auto substring_view = string.substring_view(start, end - start);
-
     // 14. If substring is searchStr, return true.
     // 15. Return false.
-    return Value(substring_view == search_string.view());
+    return Value(string->has_utf16_substring_at(start, search_string.view()));
 }
 
 // 22.1.3.25 String.prototype.substring ( start, end ), https://tc39.es/ecma262/#sec-string.prototype.substring
@@ -1221,7 +1378,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::substring)
 {
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(CodeUnitString::from_this_value(vm));
 
     // 3. Let len be the length of S.
     auto string_length = static_cast<double>(string.length_in_code_units());
@@ -1247,7 +1404,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::substring)
     size_t to = max(final_start, final_end);
 
     // 10. Return the substring of S from from to to.
-    return PrimitiveString::create(vm, Utf16String::create(string.substring_view(from, to - from)));
+    return string.substring(vm, from, to - from);
 }
 
 enum class TargetCase {
@@ -1485,7 +1642,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::substr)
 {
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
-    auto string = TRY(utf16_string_from(vm));
+    auto string = TRY(CodeUnitString::from_this_value(vm));
 
     // 3. Let size be the length of S.
     auto size = string.length_in_code_units();
@@ -1517,7 +1674,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::substr)
         return PrimitiveString::create(vm, String {});
 
     // 11. Return the substring of S from intStart to intEnd.
-    return PrimitiveString::create(vm, Utf16String::create(string.substring_view(int_start, int_end - int_start)));
+    return string.substring(vm, int_start, int_end - int_start);
 }
 
 // B.2.2.2.1 CreateHTML ( string, tag, attribute, value ), https://tc39.es/ecma262/#sec-createhtml
@@ -497,6 +497,106 @@ inline void fast_typed_array_fill(TypedArrayBase& typed_array, u32 begin, u32 en
         *(slot++) = value;
 }
 
+// Fills the elements in [begin, end) with copies of the bytes of element `begin`, doubling the copied span each time.
+// NOTE: This function assumes that the range is valid within the TypedArray, that the TypedArray is not detached,
+//       and that element `begin` has already been written.
+static void fast_typed_array_replicate_first_element(TypedArrayBase& typed_array, u32 begin, u32 end)
+{
+    auto element_size = typed_array.element_size();
+    auto* data = typed_array.viewed_array_buffer()->buffer().offset_pointer(typed_array.byte_offset() + static_cast<size_t>(begin) * element_size);
+
+    auto total_size = static_cast<size_t>(end - begin) * element_size;
+    for (size_t filled_size = element_size; filled_size < total_size;) {
+        auto chunk_size = min(filled_size, total_size - filled_size);
+        memcpy(data + filled_size, data, chunk_size);
+        filled_size += chunk_size;
+    }
+}
+
+// Searches the elements in [begin, end) for one that is equal to the given number, without materializing a Value per element.
+// Both IsStrictlyEqual and SameValueZero treat +0 and -0 as equal, and only differ in whether NaN can be found.
+// NOTE: This function assumes that the range is valid within the TypedArray, and that the TypedArray is not detached.
+template<typename T>
+static Optional<u32> fast_typed_array_find_number(TypedArrayBase const& typed_array, u32 begin, u32 end, double needle, bool nan_is_equal_to_nan)
+{
+    using UnderlyingBufferDataType = Conditional<IsSame<ClampedU8, T>, u8, T>;
+    auto const* elements = reinterpret_cast<UnderlyingBufferDataType const*>(typed_array.viewed_array_buffer()->buffer().offset_pointer(typed_array.byte_offset()));
+
+    if constexpr (IsFloatingPoint<UnderlyingBufferDataType>) {
+        if (isnan(needle)) {
+            if (!nan_is_equal_to_nan)
+                return {};
+            for (auto i = begin; i < end; ++i) {
+                if (isnan(elements[i]))
+                    return i;
+            }
+            return {};
+        }
+
+        // A number that can't be represented exactly as an element can't be equal to any element.
+        if (!isinf(needle) && fabs(needle) > static_cast<double>(NumericLimits<UnderlyingBufferDataType>::max()))
+            return {};
+        if (static_cast<double>(static_cast<UnderlyingBufferDataType>(needle)) != needle)
+            return {};
+    } else {
+        if (isnan(needle) || trunc(needle) != needle)
+            return {};
+        if (needle < static_cast<double>(NumericLimits<UnderlyingBufferDataType>::min()) || needle > static_cast<double>(NumericLimits<UnderlyingBufferDataType>::max()))
+            return {};
+    }
+
+    auto value = static_cast<UnderlyingBufferDataType>(needle);
+    for (auto i = begin; i < end; ++i) {
+        if (elements[i] == value)
+            return i;
+    }
+    return {};
+}
+
+// Returns true if the elements in [0, length) can be searched for `search_element` directly in the underlying buffer.
+// Evaluating fromIndex may have shrunk or detached the buffer, in which case we have to go through the spec steps.
+static bool can_search_typed_array_directly(TypedArrayBase const& typed_array, u32 length, Value search_element)
+{
+    if (typed_array.content_type() != TypedArrayBase::ContentType::Number || !search_element.is_number())
+        return false;
+
+    auto typed_array_record = make_typed_array_with_buffer_witness_record(typed_array, ArrayBuffer::Order::SeqCst);
+    if (is_typed_array_out_of_bounds(typed_array_record))
+        return false;
+    return typed_array_length(typed_array_record) >= length;
+}
+
+static Optional<u32> search_typed_array_directly(TypedArrayBase const& typed_array, u32 begin, u32 end, Value search_element, bool nan_is_equal_to_nan)
+{
+    auto needle = search_element.as_double();
+
+    switch (typed_array.kind()) {
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, Type)                      \
+    case TypedArrayBase::Kind::ClassName:                                                                \
+        if constexpr (IsSame<Type, u64> || IsSame<Type, i64>)                                             \
+            VERIFY_NOT_REACHED();                                                                        \
+        else                                                                                             \
+            return fast_typed_array_find_number<Type>(typed_array, begin, end, needle, nan_is_equal_to_nan); \
+        break;
+        JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+    }
+    VERIFY_NOT_REACHED();
+}
+
+// Reverses the elements in [0, length) in place, preserving their bit patterns.
+// NOTE: This function assumes that the range is valid within the TypedArray, and that the TypedArray is not detached.
+template<typename T>
+static void fast_typed_array_reverse(TypedArrayBase& typed_array, u32 length)
+{
+    if (length == 0)
+        return;
+
+    auto* elements = reinterpret_cast<T*>(typed_array.viewed_array_buffer()->buffer().offset_pointer(typed_array.byte_offset()));
+    for (u32 lower = 0, upper = length - 1; lower < upper; ++lower, --upper)
+        swap(elements[lower], elements[upper]);
+}
+
 // 23.2.3.9 %TypedArray%.prototype.fill ( value [ , start [ , end ] ] ), https://tc39.es/ecma262/#sec-%typedarray%.prototype.fill
 JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::fill)
 {
@@ -595,7 +695,9 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::fill)
     }
 
     // 18. Repeat, while k < final,
-    while (k < final) {
+    // OPTIMIZATION: Every element ends up with the same bit pattern, so we only convert the value once for the
+    //               first element, and then copy its bytes over the rest of the range.
+    if (k < final) {
         // a. Let Pk be ! ToString(𝔽(k)).
         // b. Perform ! Set(O, Pk, value, true).
         CanonicalIndex canonical_index { CanonicalIndex::Type::Index, k };
@@ -609,7 +711,8 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::fill)
         }
 
         // c. Set k to k + 1.
-        ++k;
+        // NOTE: The remaining iterations are performed by copying the bytes of the first element.
+        fast_typed_array_replicate_first_element(*typed_array, k, final);
     }
 
     // 19. Return O.
@@ -917,6 +1020,10 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::includes)
         k = relative_k;
     }
 
+    // OPTIMIZATION: Searching for a number in a Number TypedArray that's still fully in bounds can skip the property lookups.
+    if (k < length && can_search_typed_array_directly(*typed_array, length, search_element))
+        return Value { search_typed_array_directly(*typed_array, k, length, search_element, true).has_value() };
+
     // 11. Repeat, while k < len,
     while (k < length) {
         // a. Let elementK be ! Get(O, ! ToString(𝔽(k))).
@@ -986,6 +1093,13 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::index_of)
         k = relative_k;
     }
 
+    // OPTIMIZATION: Searching for a number in a Number TypedArray that's still fully in bounds can skip the property lookups.
+    if (k < length && can_search_typed_array_directly(*typed_array, length, search_element)) {
+        if (auto index = search_typed_array_directly(*typed_array, k, length, search_element, false); index.has_value())
+            return Value { *index };
+        return Value { -1 };
+    }
+
     // 11. Repeat, while k < len,
     while (k < length) {
         // a. Let kPresent be ! HasProperty(O, ! ToString(𝔽(k))).
@@ -1350,6 +1464,24 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::reverse)
     // 3. Let len be TypedArrayLength(taRecord).
     auto length = typed_array_length(typed_array_record);
 
+    // OPTIMIZATION: Swapping the raw elements is equivalent to the Get/Set steps below, as the TypedArray can't change in between.
+    switch (typed_array->element_size()) {
+    case 1:
+        fast_typed_array_reverse<u8>(*typed_array, length);
+        return typed_array;
+    case 2:
+        fast_typed_array_reverse<u16>(*typed_array, length);
+        return typed_array;
+    case 4:
+        fast_typed_array_reverse<u32>(*typed_array, length);
+        return typed_array;
+    case 8:
+        fast_typed_array_reverse<u64>(*typed_array, length);
+        return typed_array;
+    default:
+        break;
+    }
+
     // 4. Let middle be floor(len / 2).
     auto middle = length / 2;
 
@@ -1722,6 +1854,12 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::slice)
                 return array;
             }
 
+            // OPTIMIZATION: Copying byte by byte between distinct buffers is a plain memcpy.
+            if (&source_buffer != &target_buffer && !(source_buffer.is_shared_array_buffer() && target_buffer.is_shared_array_buffer() && &source_buffer.buffer() == &target_buffer.buffer())) {
+                memcpy(target_buffer.buffer().offset_pointer(target_byte_index), source_buffer.buffer().offset_pointer(source_byte_index.value()), limit.value() - target_byte_index);
+                return array;
+            }
+
             // ix. Repeat, while targetByteIndex < limit,
             while (target_byte_index < limit) {
                 // 1. Let value be GetValueFromBuffer(srcBuffer, srcByteIndex, uint8, true, unordered).
@@ -1832,7 +1970,7 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::sort)
     };
 
     // 7. Let sortedList be ? SortIndexedProperties(obj, len, SortCompare, read-through-holes).
-    auto sorted_list = TRY(sort_indexed_properties(vm, *typed_array, length, sort_compare, Holes::ReadThroughHoles));
+    auto sorted_list = TRY(sort_indexed_properties(vm, *typed_array, length, sort_compare, Holes::ReadThroughHoles, compare_function.is_undefined() ? DefaultSortCompare::CompareTypedArrayElements : DefaultSortCompare::None));
 
     // 8. Let j be 0.
     // 9. Repeat, while j < len,
@@ -2069,7 +2207,7 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::to_sorted)
     };
 
     // 8. Let sortedList be ? SortIndexedProperties(O, len, SortCompare, read-through-holes).
-    auto sorted_list = TRY(sort_indexed_properties(vm, *typed_array, length, sort_compare, Holes::ReadThroughHoles));
+    auto sorted_list = TRY(sort_indexed_properties(vm, *typed_array, length, sort_compare, Holes::ReadThroughHoles, compare_function.is_undefined() ? DefaultSortCompare::CompareTypedArrayElements : DefaultSortCompare::None));
 
     // 9. Let j be 0.
     // 10. Repeat, while j < len,
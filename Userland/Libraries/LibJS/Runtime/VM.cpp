@@ -15,6 +15,8 @@
 #include <LibFileSystem/FileSystem.h>
 #include <LibJS/AST.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/CompilationCache.h>
+#include <LibJS/RegExpCache.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
@@ -28,6 +30,7 @@
 #include <LibJS/Runtime/NativeFunction.h>
 #include <LibJS/Runtime/PromiseCapability.h>
 #include <LibJS/Runtime/Reference.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibJS/Runtime/Symbol.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/SourceTextModule.h>
@@ -63,6 +66,8 @@ static constexpr auto single_ascii_character_strings = make_single_ascii_charact
 
 VM::VM(OwnPtr<CustomData> custom_data, ErrorMessages error_messages)
     : m_heap(*this)
+    , m_compilation_cache(make<CompilationCache>())
+    , m_regexp_cache(make<RegExpCache>())
     , m_error_messages(move(error_messages))
     , m_custom_data(move(custom_data))
 {
@@ -715,6 +720,9 @@ void VM::push_execution_context(ExecutionContext& context)
     if (!m_execution_context_stack.is_empty())
         m_execution_context_stack.last()->program_counter = bytecode_interpreter().program_counter();
     m_execution_context_stack.append(&context);
+
+    if (m_sampling_profiler) [[unlikely]]
+        m_sampling_profiler->tick({});
 }
 
 void VM::pop_execution_context()
@@ -724,6 +732,19 @@ void VM::pop_execution_context()
         on_call_stack_emptied();
 }
 
+SamplingProfiler& VM::start_sampling_profiler()
+{
+    m_sampling_profiler = make<SamplingProfiler>(*this);
+    m_sampling_profiler->start();
+    return *m_sampling_profiler;
+}
+
+void VM::stop_sampling_profiler()
+{
+    if (m_sampling_profiler)
+        m_sampling_profiler->stop();
+}
+
 #if ARCH(X86_64)
 struct [[gnu::packed]] NativeStackFrame {
     NativeStackFrame* prev;
@@ -51,6 +51,14 @@ public:
     Heap& heap() { return m_heap; }
     Heap const& heap() const { return m_heap; }
 
+    CompilationCache& compilation_cache() { return *m_compilation_cache; }
+    RegExpCache& regexp_cache() { return *m_regexp_cache; }
+
+    // NOTE: This is null unless sampling profiling has been started at least once.
+    SamplingProfiler* sampling_profiler() { return m_sampling_profiler.ptr(); }
+    SamplingProfiler& start_sampling_profiler();
+    void stop_sampling_profiler();
+
     Bytecode::Interpreter& bytecode_interpreter();
 
     void dump_backtrace() const;
@@ -300,6 +308,11 @@ private:
 
     Heap m_heap;
 
+    // NOTE: This must come after m_heap, since cached programs hold handles to bytecode executables.
+    NonnullOwnPtr<CompilationCache> m_compilation_cache;
+
+    NonnullOwnPtr<RegExpCache> m_regexp_cache;
+
     Vector<ExecutionContext*> m_execution_context_stack;
 
     Vector<Vector<ExecutionContext*>> m_saved_execution_context_stacks;
@@ -337,6 +350,8 @@ private:
 
     OwnPtr<Bytecode::Interpreter> m_bytecode_interpreter;
 
+    OwnPtr<SamplingProfiler> m_sampling_profiler;
+
     bool m_dynamic_imports_allowed { false };
 };
 
@@ -23,6 +23,29 @@ SourceCode::SourceCode(String filename, String code)
 {
 }
 
+SourceCode::~SourceCode()
+{
+    for (auto* node : m_large_ast_nodes)
+        ::operator delete(node);
+}
+
+void* SourceCode::allocate_ast_node(size_t size, size_t alignment) const
+{
+    // Leave room in each chunk for a couple of nodes, so that one big node doesn't waste most of a chunk.
+    static constexpr size_t max_size_in_chunk = 1 * KiB;
+
+    if (size > max_size_in_chunk) {
+        m_large_ast_nodes.ensure_capacity(m_large_ast_nodes.size() + 1);
+        auto* memory = ::operator new(size);
+        m_large_ast_nodes.unchecked_append(memory);
+        return memory;
+    }
+
+    auto* memory = m_ast_node_allocator.allocate(size, alignment);
+    VERIFY(memory);
+    return memory;
+}
+
 String const& SourceCode::filename() const
 {
     return m_filename;
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/BumpAllocator.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 #include <LibJS/Forward.h>
@@ -16,12 +17,17 @@ namespace JS {
 class SourceCode : public RefCounted<SourceCode> {
 public:
     static NonnullRefPtr<SourceCode const> create(String filename, String code);
+    ~SourceCode();
 
     String const& filename() const;
     String const& code() const;
 
     SourceRange range_from_offsets(u32 start_offset, u32 end_offset) const;
 
+    // Every AST node keeps the source code it was parsed from alive, so its memory can be handed out from here and
+    // freed all at once, when the source code and with it the last of its nodes goes away.
+    void* allocate_ast_node(size_t size, size_t alignment) const;
+
 private:
     SourceCode(String filename, String code);
 
@@ -33,6 +39,10 @@ private:
     // line:column they map to. This can then be binary-searched.
     void fill_position_cache() const;
     Vector<Position> mutable m_cached_positions;
+
+    BumpAllocator<> mutable m_ast_node_allocator;
+    // Nodes that don't fit into the allocator's chunks (like calls with very many arguments) are allocated separately.
+    Vector<void*> mutable m_large_ast_nodes;
 };
 
 }
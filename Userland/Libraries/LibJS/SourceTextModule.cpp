@@ -8,6 +8,7 @@
 #include <AK/Debug.h>
 #include <AK/QuickSort.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/CompilationCache.h>
 #include <LibJS/Parser.h>
 #include <LibJS/Runtime/AsyncFunctionDriverWrapper.h>
 #include <LibJS/Runtime/ECMAScriptFunctionObject.h>
@@ -128,13 +129,21 @@ void SourceTextModule::visit_edges(Cell::Visitor& visitor)
 // 16.2.1.6.1 ParseModule ( sourceText, realm, hostDefined ), https://tc39.es/ecma262/#sec-parsemodule
 Result<NonnullGCPtr<SourceTextModule>, Vector<ParserError>> SourceTextModule::parse(StringView source_text, Realm& realm, StringView filename, Script::HostDefined* host_defined)
 {
+    auto& compilation_cache = realm.vm().compilation_cache();
+
     // 1. Let body be ParseText(sourceText, Module).
-    auto parser = Parser(Lexer(source_text, filename), Program::Type::Module);
-    auto body = parser.parse_program();
+    // OPTIMIZATION: If we've recently parsed the exact same source text, reuse its parse node (and the bytecode cached on it).
+    RefPtr<Program> body = compilation_cache.find(Program::Type::Module, source_text, filename, 1);
+    if (!body) {
+        auto parser = Parser(Lexer(source_text, filename), Program::Type::Module);
+        body = parser.parse_program();
+
+        // 2. If body is a List of errors, return body.
+        if (parser.has_errors())
+            return parser.errors();
 
-    // 2. If body is a List of errors, return body.
-    if (parser.has_errors())
-        return parser.errors();
+        compilation_cache.add(Program::Type::Module, source_text, 1, *body);
+    }
 
     // 3. Let requestedModules be the ModuleRequests of body.
     auto requested_modules = module_requests(*body);
@@ -251,7 +260,7 @@ Result<NonnullGCPtr<SourceTextModule>, Vector<ParserError>> SourceTextModule::pa
         filename,
         host_defined,
         async,
-        move(body),
+        body.release_nonnull(),
         move(requested_modules),
         move(import_entries),
         move(local_export_entries),
@@ -714,7 +723,14 @@ ThrowCompletionOr<void> SourceTextModule::execute_module(VM& vm, GCPtr<PromiseCa
         // c. Let result be the result of evaluating module.[[ECMAScriptCode]].
         Completion result;
 
-        auto maybe_executable = Bytecode::compile(vm, m_ecmascript_code, FunctionKind::Normal, "ShadowRealmEval"sv);
+        // NOTE: The executable is cached on the parse node, which may be shared with other modules that have the same source text.
+        auto maybe_executable = [&]() -> ThrowCompletionOr<NonnullGCPtr<Bytecode::Executable>> {
+            if (auto* cached_executable = m_ecmascript_code->bytecode_executable())
+                return NonnullGCPtr { *cached_executable };
+            auto executable = TRY(Bytecode::compile(vm, m_ecmascript_code, FunctionKind::Normal, "ShadowRealmEval"sv));
+            m_ecmascript_code->set_bytecode_executable(executable);
+            return executable;
+        }();
         if (maybe_executable.is_error())
             result = maybe_executable.release_error();
         else {
@@ -26,3 +26,14 @@ test("is unscopable", () => {
         }).toThrowWithMessage(ReferenceError, "'includes' is not defined");
     }
 });
+
+test("arrays of numbers", () => {
+    var array = [1, 2.5, NaN, -0];
+    expect(array.includes(1)).toBeTrue();
+    expect(array.includes(2.5)).toBeTrue();
+    expect(array.includes(NaN)).toBeTrue();
+    expect(array.includes(0)).toBeTrue();
+    expect(array.includes("1")).toBeFalse();
+    expect(array.includes(3)).toBeFalse();
+    expect(array.includes(1, 1)).toBeFalse();
+});
@@ -23,3 +23,42 @@ test("basic functionality", () => {
     expect([].indexOf()).toBe(-1);
     expect([undefined].indexOf()).toBe(0);
 });
+
+test("arrays of numbers", () => {
+    var ints = [1, 2, 3, 2, 1];
+    expect(ints.indexOf(2)).toBe(1);
+    expect(ints.indexOf(2, 2)).toBe(3);
+    expect(ints.indexOf(2.0)).toBe(1);
+    expect(ints.indexOf(2.5)).toBe(-1);
+    expect(ints.indexOf("2")).toBe(-1);
+    expect(ints.indexOf(2 ** 40)).toBe(-1);
+    expect([0, 1].indexOf(-0)).toBe(0);
+
+    var doubles = [1.5, NaN, -0, 2];
+    expect(doubles.indexOf(1.5)).toBe(0);
+    expect(doubles.indexOf(NaN)).toBe(-1);
+    expect(doubles.indexOf(0)).toBe(2);
+    expect(doubles.indexOf(2)).toBe(3);
+});
+
+test("array shrunk while converting fromIndex", () => {
+    var array = [1, 2, 3, 4];
+    var fromIndex = {
+        valueOf() {
+            array.length = 1;
+            return 0;
+        },
+    };
+    expect(array.indexOf(3, fromIndex)).toBe(-1);
+    expect(array.indexOf(1)).toBe(0);
+});
+
+test("holes are looked up on the prototype chain", () => {
+    var array = [1, , 3];
+    Array.prototype[1] = 2;
+    try {
+        expect(array.indexOf(2)).toBe(1);
+    } finally {
+        delete Array.prototype[1];
+    }
+});
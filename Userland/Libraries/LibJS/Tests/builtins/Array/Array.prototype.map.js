@@ -48,4 +48,18 @@ describe("normal behavior", () => {
         var squaredNumbers = [0, 1, 2, 3, 4].map(x => x ** 2);
         expect(squaredNumbers).toEqual([0, 1, 4, 9, 16]);
     });
+
+    test("sees elements changed by the callback", () => {
+        var array = [1, 2, 3, 4];
+        var result = array.map((value, index) => {
+            if (index === 0) {
+                array[2] = "three";
+                array.length = 3;
+            }
+            return value;
+        });
+        expect(result).toEqual([1, 2, "three", undefined]);
+        expect(result).toHaveLength(4);
+        expect(Object.hasOwn(result, 3)).toBeFalse();
+    });
 });
@@ -201,4 +201,42 @@ describe("Array.prototype.sort", () => {
         );
         Array.prototype.sort.call(obj);
     });
+
+    test("that the default comparison orders primitives by their string values", () => {
+        expect([10, 9, 1, -1, 100, 2.5].sort()).toEqual([-1, 1, 10, 100, 2.5, 9]);
+        expect(["b", undefined, 3, "a", null, true, 20n, "3"].sort()).toEqual([
+            20n,
+            3,
+            "3",
+            "a",
+            "b",
+            null,
+            true,
+            undefined,
+        ]);
+
+        // Items that are equal as strings keep their order.
+        const sorted = [1, "1", 0, "0", "1", 1].sort();
+        expect(sorted.map(item => typeof item)).toEqual([
+            "number",
+            "string",
+            "number",
+            "string",
+            "string",
+            "number",
+        ]);
+    });
+
+    test("that partially sorted arrays are sorted stably", () => {
+        const arr = [];
+        for (let i = 0; i < 1000; ++i) arr.push({ key: i % 100 < 50 ? i : 1000 - i, index: i });
+        for (let i = 0; i < 50; ++i) arr.push({ key: i * 7, index: 1000 + i });
+
+        const sorted = arr.slice().sort((a, b) => a.key - b.key);
+        for (let i = 1; i < sorted.length; ++i) {
+            expect(sorted[i - 1].key <= sorted[i].key).toBeTrue();
+            if (sorted[i - 1].key === sorted[i].key)
+                expect(sorted[i - 1].index < sorted[i].index).toBeTrue();
+        }
+    });
 });
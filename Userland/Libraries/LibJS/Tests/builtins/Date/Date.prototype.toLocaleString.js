@@ -58,3 +58,22 @@ describe("correct behavior", () => {
         expect(d1.toLocaleString("ar", { timeStyle: "short", timeZone: "UTC" })).toBe("٧:٠٨ ص");
     });
 });
+
+describe("repeated calls", () => {
+    test("date and time formats are not mixed up", () => {
+        const d = new Date(Date.UTC(1989, 0, 23, 7, 8, 9));
+        const string = d.toLocaleString();
+        const dateString = d.toLocaleDateString();
+        const timeString = d.toLocaleTimeString();
+
+        expect(string).not.toBe(dateString);
+        expect(string).not.toBe(timeString);
+        expect(dateString).not.toBe(timeString);
+
+        for (let i = 0; i < 3; ++i) {
+            expect(d.toLocaleTimeString()).toBe(timeString);
+            expect(d.toLocaleDateString()).toBe(dateString);
+            expect(d.toLocaleString()).toBe(string);
+        }
+    });
+});
@@ -50,6 +50,23 @@ test("basic functionality", () => {
     expect((() => this).apply("foo")).toBe(globalThis);
 });
 
+test("calls with many arguments", () => {
+    const values = [];
+    for (let i = 0; i < 100_000; ++i) values.push(i);
+
+    expect(Math.max.apply(null, values)).toBe(99_999);
+
+    function lastArgument() {
+        return arguments[arguments.length - 1];
+    }
+    expect(lastArgument.apply(null, values)).toBe(99_999);
+
+    function Counter() {
+        this.count = arguments.length;
+    }
+    expect(Reflect.construct(Counter, values).count).toBe(100_000);
+});
+
 describe("errors", () => {
     test("does not accept non-function values", () => {
         expect(() => {
@@ -74,3 +74,38 @@ test("does not truncate large integers", () => {
     expect(JSON.parse("18446744073709551616")).toEqual(18446744073709551616);
     expect(JSON.parse("18446744073709551617")).toEqual(18446744073709551617);
 });
+
+test("string escapes", () => {
+    expect(JSON.parse('"plain"')).toBe("plain");
+    expect(JSON.parse('"a\\"b\\\\c\\/d"')).toBe('a"b\\c/d');
+    expect(JSON.parse('"\\b\\f\\n\\r\\t"')).toBe("\b\f\n\r\t");
+    expect(JSON.parse('"\\u0041\\u00e9\\ud834\\udd1e"')).toBe("Aé𝄞");
+    expect(JSON.parse('{"k\\u0065y": 1}')).toEqual({ key: 1 });
+});
+
+test("repeated and numeric keys", () => {
+    const result = JSON.parse('[{"a": 1, "b": 2}, {"a": 3, "b": 4}, {"b": 5, "a": 6, "b": 7}, {"1": "x", "0": "y"}]');
+    expect(result).toHaveLength(4);
+    expect(Object.keys(result[0])).toEqual(["a", "b"]);
+    expect(result[1].a).toBe(3);
+    expect(result[1].b).toBe(4);
+    expect(Object.keys(result[2])).toEqual(["b", "a"]);
+    expect(result[2].b).toBe(7);
+    expect(Object.keys(result[3])).toEqual(["0", "1"]);
+});
+
+test("negative zero and exponents", () => {
+    expect(JSON.parse("-0")).toBe(-0);
+    expect(JSON.parse("[-0.0]")[0]).toBe(-0);
+    expect(JSON.parse("1e3")).toBe(1000);
+    expect(JSON.parse("-1.5E-2")).toBe(-0.015);
+    expect(JSON.parse("0.5")).toBe(0.5);
+});
+
+test("malformed input", () => {
+    ["", "-", "01", "1.", "1e", "1e+", '"unterminated', '"\\x"', "[1,]", '{"a":1,}', "[1 2]", "tru", "nul", "{a:1}", '"a"b'].forEach(
+        input => {
+            expect(() => JSON.parse(input)).toThrow(SyntaxError);
+        }
+    );
+});
@@ -96,4 +96,35 @@ describe("errors", () => {
             }).toThrow(TypeError, "Cannot stringify circular object");
         });
     });
+
+    test("skips undefined members without leaving separators behind", () => {
+        const object = { a: undefined, b: 1, c: () => {}, d: [undefined, 2], e: Symbol("e"), f: undefined };
+        expect(JSON.stringify(object)).toBe('{"b":1,"d":[null,2]}');
+        expect(JSON.stringify(object, null, 2)).toBe('{\n  "b": 1,\n  "d": [\n    null,\n    2\n  ]\n}');
+        expect(JSON.stringify({ a: undefined })).toBe("{}");
+        expect(JSON.stringify({ a: undefined }, null, 2)).toBe("{}");
+        expect(JSON.stringify([], null, 2)).toBe("[]");
+    });
+
+    test("object changed while serializing", () => {
+        const object = {
+            a: {
+                toJSON() {
+                    delete object.b;
+                    object.c = 3;
+                    return 1;
+                },
+            },
+            b: 2,
+        };
+        expect(JSON.stringify(object)).toBe('{"a":1}');
+    });
+
+    test("non-enumerable and indexed properties of plain objects", () => {
+        const object = { b: 1, 1: "one", a: 2 };
+        Object.defineProperty(object, "hidden", { value: 3, enumerable: false });
+        expect(JSON.stringify(object)).toBe('{"1":"one","b":1,"a":2}');
+        delete object[1];
+        expect(JSON.stringify(object)).toBe('{"b":1,"a":2}');
+    });
 });
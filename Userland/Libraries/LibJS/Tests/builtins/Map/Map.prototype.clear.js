@@ -10,3 +10,18 @@ test("basic functionality", () => {
     map.clear();
     expect(map).toHaveSize(0);
 });
+
+test("iterators continue with elements added after clearing", () => {
+    const map = new Map([
+        ["a", 0],
+        ["b", 1],
+    ]);
+    const iterator = map.entries();
+    expect(iterator.next()).toBeIteratorResultWithValue(["a", 0]);
+
+    map.clear();
+    map.set("c", 2);
+
+    expect(iterator.next()).toBeIteratorResultWithValue(["c", 2]);
+    expect(iterator.next()).toBeIteratorResultDone();
+});
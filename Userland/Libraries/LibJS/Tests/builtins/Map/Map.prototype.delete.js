@@ -82,4 +82,24 @@ describe("modification with active iterators", () => {
         expect(iterator.next()).toBeIteratorResultDone();
         expect(iterator.next()).toBeIteratorResultDone();
     });
+
+    test("iterators keep their place when many elements are deleted", () => {
+        const map = new Map();
+        for (let i = 0; i < 100; ++i) map.set(i, i);
+
+        const iterator = map.keys();
+        for (let i = 0; i < 10; ++i) expect(iterator.next()).toBeIteratorResultWithValue(i);
+
+        // Deleting most of the elements both before and after the iterator makes the map drop them from its storage.
+        for (let i = 0; i < 100; ++i) {
+            if (i % 10 !== 5) expect(map.delete(i)).toBeTrue();
+        }
+        expect(map).toHaveSize(10);
+
+        for (let i = 15; i < 100; i += 10) expect(iterator.next()).toBeIteratorResultWithValue(i);
+
+        map.set(100, 100);
+        expect(iterator.next()).toBeIteratorResultWithValue(100);
+        expect(iterator.next()).toBeIteratorResultDone();
+    });
 });
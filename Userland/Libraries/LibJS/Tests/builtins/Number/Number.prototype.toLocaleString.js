@@ -76,3 +76,35 @@ describe("styles", () => {
         ).toBe("\u0661\u066b\u0662\u0663 كيلومتر في الساعة");
     });
 });
+
+describe("repeated calls", () => {
+    test("locales", () => {
+        for (let i = 0; i < 3; ++i) {
+            expect((1234.5).toLocaleString()).toBe("1,234.5");
+            expect((1234.5).toLocaleString("en")).toBe("1,234.5");
+            expect((1234.5).toLocaleString("de")).toBe("1.234,5");
+            expect((1234.5).toLocaleString("ar")).toBe("\u0661\u066c\u0662\u0663\u0664\u066b\u0665");
+        }
+    });
+
+    test("options are read on every call", () => {
+        let count = 0;
+        const options = {
+            get maximumFractionDigits() {
+                ++count;
+                return 0;
+            },
+        };
+
+        for (let i = 0; i < 3; ++i) expect((1234.5).toLocaleString("en", options)).toBe("1,235");
+        expect(count).toBe(3);
+    });
+
+    test("invalid locales throw on every call", () => {
+        for (let i = 0; i < 3; ++i) {
+            expect(() => {
+                (1).toLocaleString("en-");
+            }).toThrowWithMessage(RangeError, "en- is not a structurally valid language tag");
+        }
+    });
+});
@@ -66,3 +66,27 @@ test("Incorrectly escaped code units not converted to invalid patterns", () => {
     expect(re.test("⫀")).toBeTrue();
     expect(re.test("\\u2abe")).toBeFalse(); // ⫀ is \u2abe
 });
+
+test("repeatedly created regexps don't share state", () => {
+    const regexps = [];
+    for (var i = 0; i < 3; ++i) {
+        regexps.push(/a+/g);
+        regexps.push(new RegExp("a+", "g"));
+    }
+    expect(regexps[0]).not.toBe(regexps[2]);
+
+    expect(regexps[0].exec("baab")[0]).toBe("aa");
+    expect(regexps[0].lastIndex).toBe(3);
+    for (var i = 1; i < regexps.length; ++i) {
+        expect(regexps[i].lastIndex).toBe(0);
+        expect(regexps[i].exec("caaad")[0]).toBe("aaa");
+    }
+
+    // The same pattern with other flags is a different regexp.
+    expect(new RegExp("a+", "i").test("AA")).toBeTrue();
+    expect(new RegExp("a+", "").test("AA")).toBeFalse();
+    expect(/a+/.test("AA")).toBeFalse();
+
+    // Invalid patterns keep throwing.
+    for (var i = 0; i < 2; ++i) expect(() => new RegExp("a(", "g")).toThrow(SyntaxError);
+});
@@ -27,3 +27,18 @@ test("UTF-16", () => {
     expect(s.charCodeAt(1)).toBe(0xde00);
     expect(s.charCodeAt(2)).toBe(NaN);
 });
+
+test("concatenated strings", () => {
+    var ascii = "";
+    var mixed = "";
+    for (var i = 0; i < 4; ++i) {
+        ascii += "ab";
+        mixed += i === 2 ? "é" : "ab";
+    }
+    expect(ascii.charCodeAt(7)).toBe(0x62);
+    expect(ascii[6]).toBe("a");
+    expect(mixed.charCodeAt(4)).toBe(0xe9);
+    expect(mixed.charCodeAt(5)).toBe(0x61);
+    expect(mixed[4]).toBe("é");
+    expect(mixed[7]).toBe(undefined);
+});
@@ -48,3 +48,14 @@ test("UTF-16", () => {
     expect(s.endsWith("\ude00")).toBeTrue();
     expect(s.endsWith("a")).toBeFalse();
 });
+
+test("strings built by repeated concatenation", () => {
+    var s = "";
+    for (var i = 0; i < 100; ++i) s += i + ",";
+
+    expect(s.endsWith("98,99,")).toBeTrue();
+    expect(s.endsWith("97,99,")).toBeFalse();
+    expect(s.endsWith("0,1,2,", 6)).toBeTrue();
+    expect(s.endsWith(s)).toBeTrue();
+    expect(s.endsWith("x" + s)).toBeFalse();
+});
@@ -29,3 +29,17 @@ test("UTF-16", () => {
     expect(s.indexOf("\ude00")).toBe(1);
     expect(s.indexOf("a")).toBe(-1);
 });
+
+test("ASCII strings mixed with other strings", () => {
+    expect("abcabc".indexOf("ca")).toBe(2);
+    expect("abcabc".indexOf("ca", 3)).toBe(-1);
+    expect("abcabc".indexOf("", 4)).toBe(4);
+    expect("abcabc".indexOf("", 10)).toBe(6);
+    expect("abcabc".indexOf("c", -Infinity)).toBe(2);
+    expect("abcabc".indexOf("c", Infinity)).toBe(-1);
+    expect("abcabc".indexOf("abcabcd")).toBe(-1);
+
+    expect("ab😀c".indexOf("c")).toBe(4);
+    expect("abc".indexOf("😀")).toBe(-1);
+    expect("ab😀c😀".indexOf("😀", 3)).toBe(5);
+});
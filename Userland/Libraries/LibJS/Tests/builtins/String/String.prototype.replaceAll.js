@@ -166,3 +166,15 @@ test("UTF-16", () => {
     expect("😀😀😀".replaceAll(/\ude00/gu, "")).toBe("😀😀😀");
     expect("😀😀😀".replaceAll(/\ud83d\ude00/gu, "")).toBe("");
 });
+
+test("ASCII strings mixed with other strings", () => {
+    expect("a.b.c".replaceAll(".", "--")).toBe("a--b--c");
+    expect("aaa".replaceAll("aa", "b")).toBe("ba");
+    expect("abc".replaceAll("d", "e")).toBe("abc");
+    expect("abc".replaceAll("", "-")).toBe("-a-b-c-");
+    expect("abc".replaceAll("b", "[$&$&]")).toBe("a[bb]c");
+    expect("abc".replaceAll("b", "$$")).toBe("a$c");
+
+    expect("a😀b😀".replaceAll("b", "c")).toBe("a😀c😀");
+    expect("abab".replaceAll("b", "😀")).toBe("a😀a😀");
+});
@@ -25,3 +25,17 @@ test("UTF-16", () => {
     expect(s.slice(0, 1)).toBe("\ud83d");
     expect(s.slice(0, 2)).toBe("😀");
 });
+
+test("ASCII and non-ASCII strings", () => {
+    expect("abcdef".slice(2, 4)).toBe("cd");
+    expect("abcdef".substring(4, 2)).toBe("cd");
+    expect("abcdef".substr(-2)).toBe("ef");
+    expect("abcdef".at(-1)).toBe("f");
+    expect("abcdef".charAt(1)).toBe("b");
+    expect("abcdef".codePointAt(5)).toBe(0x66);
+
+    expect("aéb".slice(1, 2)).toBe("é");
+    expect("aéb".substring(2)).toBe("b");
+    expect("aéb".at(-2)).toBe("é");
+    expect("aéb".codePointAt(1)).toBe(0xe9);
+});
@@ -80,3 +80,20 @@ test("UTF-16", () => {
     expect(s.split(/\ud83d/)).toEqual(["", "\ude00", "\ude00", "\ude00"]);
     expect(s.split(/\ude00/)).toEqual(["\ud83d", "\ud83d", "\ud83d", ""]);
 });
+
+test("ASCII strings mixed with other strings", () => {
+    expect("a,b,,c,".split(",")).toEqual(["a", "b", "", "c", ""]);
+    expect(",a".split(",")).toEqual(["", "a"]);
+    expect("a--b--c".split("--")).toEqual(["a", "b", "c"]);
+    expect("a--b--c".split("--", 2)).toEqual(["a", "b"]);
+    expect("a--b--c".split("--", 0)).toEqual([]);
+    expect("aaa".split("aa")).toEqual(["", "a"]);
+    expect("abc".split("")).toEqual(["a", "b", "c"]);
+    expect("abc".split("", 2)).toEqual(["a", "b"]);
+    expect("".split("")).toEqual([]);
+    expect("".split(",")).toEqual([""]);
+    expect("abc".split("abcd")).toEqual(["abc"]);
+
+    expect("a😀b😀".split("b")).toEqual(["a😀", "😀"]);
+    expect("a,b".split("😀")).toEqual(["a,b"]);
+});
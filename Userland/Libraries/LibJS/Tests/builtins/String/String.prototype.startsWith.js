@@ -42,3 +42,21 @@ test("UTF-16", () => {
     expect(s.startsWith("\ude00")).toBeFalse();
     expect(s.startsWith("a")).toBeFalse();
 });
+
+test("strings built by repeated concatenation", () => {
+    var s = "";
+    for (var i = 0; i < 100; ++i) s += i + ",";
+
+    expect(s.length).toBe(290);
+    expect(s.startsWith("0,1,2,")).toBeTrue();
+    expect(s.startsWith("9,10,11,", 18)).toBeTrue();
+    expect(s.startsWith("9,10,12,", 18)).toBeFalse();
+    expect(s.startsWith("98,99,", 284)).toBeTrue();
+    expect(s.startsWith("98,99,,", 284)).toBeFalse();
+
+    var surrogates = "a" + "\ud83d";
+    surrogates += "\ude00" + "b";
+    expect(surrogates.length).toBe(4);
+    expect(surrogates.startsWith("😀", 1)).toBeTrue();
+    expect(surrogates.startsWith("\ude00b", 2)).toBeTrue();
+});
@@ -75,3 +75,18 @@ test("basic functionality", () => {
         expect(typedArray[2]).toBe(0n);
     });
 });
+
+test("filling larger ranges", () => {
+    [Float32Array, Float64Array, Int16Array].forEach(T => {
+        const typedArray = new T(37);
+        expect(typedArray.fill(1.5, 3, 30)).toBe(typedArray);
+        for (let i = 0; i < typedArray.length; ++i) {
+            const expected = i >= 3 && i < 30 ? (T === Int16Array ? 1 : 1.5) : 0;
+            expect(typedArray[i]).toBe(expected);
+        }
+    });
+
+    const bigints = new BigInt64Array(9).fill(-3n, 1);
+    expect(bigints[0]).toBe(0n);
+    for (let i = 1; i < bigints.length; ++i) expect(bigints[i]).toBe(-3n);
+});
@@ -62,3 +62,25 @@ test("basic functionality", () => {
         expect(typedArray.includes(2n, -2)).toBe(true);
     });
 });
+
+test("NaN and negative zero", () => {
+    const float32 = new Float32Array([1, NaN]);
+    expect(float32.includes(NaN)).toBeTrue();
+    expect(new Float64Array([1, 2]).includes(NaN)).toBeFalse();
+    expect(new Float64Array([-0]).includes(0)).toBeTrue();
+    expect(new Int32Array([0]).includes(-0)).toBeTrue();
+    expect(new Int32Array([1]).includes(NaN)).toBeFalse();
+});
+
+test("fromIndex shrinking the buffer", () => {
+    const arrayBuffer = new ArrayBuffer(4, { maxByteLength: 8 });
+    const typedArray = new Uint8Array(arrayBuffer);
+    const fromIndex = {
+        valueOf() {
+            arrayBuffer.resize(2);
+            return 0;
+        },
+    };
+    // Elements past the new end read as undefined.
+    expect(typedArray.includes(undefined, fromIndex)).toBeTrue();
+});
@@ -62,3 +62,39 @@ test("basic functionality", () => {
         expect(typedArray.indexOf(2n, -2)).toBe(1);
     });
 });
+
+test("numbers that aren't representable as an element", () => {
+    const integers = [Uint8Array, Uint8ClampedArray, Uint16Array, Uint32Array, Int8Array, Int16Array, Int32Array];
+    integers.forEach(T => {
+        const typedArray = new T([0, 1, 2]);
+        expect(typedArray.indexOf(1.5)).toBe(-1);
+        expect(typedArray.indexOf(NaN)).toBe(-1);
+        expect(typedArray.indexOf(-0)).toBe(0);
+        expect(typedArray.indexOf(2 ** 40)).toBe(-1);
+        expect(typedArray.indexOf("1")).toBe(-1);
+    });
+
+    const float32 = new Float32Array([0.5, 0.1, NaN]);
+    expect(float32.indexOf(0.5)).toBe(0);
+    expect(float32.indexOf(0.1)).toBe(-1);
+    expect(float32.indexOf(Math.fround(0.1))).toBe(1);
+    expect(float32.indexOf(NaN)).toBe(-1);
+    expect(float32.indexOf(1e300)).toBe(-1);
+
+    const float64 = new Float64Array([-0, Infinity]);
+    expect(float64.indexOf(0)).toBe(0);
+    expect(float64.indexOf(Infinity)).toBe(1);
+});
+
+test("fromIndex shrinking the buffer", () => {
+    const arrayBuffer = new ArrayBuffer(4, { maxByteLength: 8 });
+    const typedArray = new Uint8Array(arrayBuffer);
+    typedArray.set([1, 2, 3, 4]);
+    const fromIndex = {
+        valueOf() {
+            arrayBuffer.resize(2);
+            return 0;
+        },
+    };
+    expect(typedArray.indexOf(1, fromIndex)).toBe(0);
+});
@@ -85,3 +85,18 @@ describe("basic functionality", () => {
         });
     });
 });
+
+test("Odd and larger lengths", () => {
+    TYPED_ARRAYS.forEach(T => {
+        const array = new T([1, 2, 3, 4, 5]);
+        expect(array.reverse()).toEqual(new T([5, 4, 3, 2, 1]));
+
+        const subarray = new T([1, 2, 3, 4, 5, 6]).subarray(1, 4);
+        expect(subarray.reverse()).toEqual(new T([4, 3, 2]));
+    });
+
+    BIGINT_TYPED_ARRAYS.forEach(T => {
+        const array = new T([1n, 2n, 3n]);
+        expect(array.reverse()).toEqual(new T([3n, 2n, 1n]));
+    });
+});
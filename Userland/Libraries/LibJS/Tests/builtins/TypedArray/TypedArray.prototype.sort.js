@@ -89,3 +89,14 @@ test("detached buffer", () => {
         expect(typedArray[2]).toBeUndefined();
     });
 });
+
+test("NaN and negative zero", () => {
+    [Float32Array, Float64Array].forEach(T => {
+        const typedArray = new T([NaN, 1, 0, -Infinity, -0, NaN, -1, Infinity, -0, 0]);
+        expect(typedArray.sort()).toBe(typedArray);
+        expect(Array.from(typedArray)).toEqual([-Infinity, -1, -0, -0, 0, 0, 1, Infinity, NaN, NaN]);
+        expect(Object.is(typedArray[2], -0)).toBeTrue();
+        expect(Object.is(typedArray[3], -0)).toBeTrue();
+        expect(Object.is(typedArray[4], 0)).toBeTrue();
+    });
+});
@@ -0,0 +1,74 @@
+test("Nested breaks and continues that jump through empty blocks", () => {
+    let result = [];
+    outer: for (let i = 0; i < 4; ++i) {
+        for (let j = 0; j < 4; ++j) {
+            if (j === 1) continue;
+            if (j === 3) continue outer;
+            if (i === 2) break outer;
+            result.push(`${i}${j}`);
+        }
+    }
+    expect(result).toEqual(["00", "02", "10", "12"]);
+});
+
+test("Code after return and throw is not reached", () => {
+    function f(x) {
+        if (x) {
+            return "early";
+            x = "unreachable";
+        }
+        throw new Error("late");
+        return "unreachable";
+    }
+    expect(f(true)).toBe("early");
+    expect(() => f(false)).toThrowWithMessage(Error, "late");
+});
+
+test("Empty if and else branches", () => {
+    function f(x) {
+        let y = 0;
+        if (x) {
+        } else {
+        }
+        if (x) {
+            y = 1;
+        } else {
+        }
+        return y;
+    }
+    expect(f(true)).toBe(1);
+    expect(f(false)).toBe(0);
+});
+
+test("finally blocks still run on every exit path", () => {
+    let log = [];
+    function f(x) {
+        for (;;) {
+            try {
+                if (x === 0) break;
+                if (x === 1) return "returned";
+                throw "thrown";
+            } catch (e) {
+                log.push(e);
+                break;
+            } finally {
+                log.push(`finally ${x}`);
+            }
+        }
+        return "fell through";
+    }
+    expect(f(0)).toBe("fell through");
+    expect(f(1)).toBe("returned");
+    expect(f(2)).toBe("fell through");
+    expect(log).toEqual(["finally 0", "finally 1", "thrown", "finally 2"]);
+});
+
+test("Self-assignment keeps the value", () => {
+    function f(a) {
+        a = a;
+        let b = a;
+        b = b;
+        return b;
+    }
+    expect(f(42)).toBe(42);
+});
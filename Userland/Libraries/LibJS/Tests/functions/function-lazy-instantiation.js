@@ -0,0 +1,49 @@
+test("Closures that are never called don't affect ones that are", () => {
+    const closures = [];
+    for (let i = 0; i < 10; ++i) {
+        closures.push(function (a, b = i) {
+            var x = a + b;
+            return [x, arguments.length];
+        });
+    }
+
+    expect(closures[3](1)).toEqual([4, 1]);
+    expect(closures[7](1, 2)).toEqual([3, 2]);
+});
+
+test("Function properties are available before the first call", () => {
+    function f(a, b, ...rest) {
+        return arguments;
+    }
+
+    expect(f.length).toBe(2);
+    expect(f.name).toBe("f");
+    expect(f.prototype.constructor).toBe(f);
+    expect(f(1, 2, 3).length).toBe(3);
+});
+
+test("Annex B function hoisting inside a function that is called later", () => {
+    function outer() {
+        {
+            function inner() {
+                return "inner";
+            }
+        }
+        return inner();
+    }
+
+    const later = outer;
+    expect(later()).toBe("inner");
+});
+
+test("Constructing a function before ever calling it", () => {
+    function Point(x, y) {
+        this.x = x;
+        this.y = y;
+    }
+
+    const p = new Point(1, 2);
+    expect(p.x).toBe(1);
+    expect(p.y).toBe(2);
+    expect(Point.call({}, 3, 4)).toBeUndefined();
+});
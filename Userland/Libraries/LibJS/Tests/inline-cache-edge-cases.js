@@ -16,3 +16,60 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Polymorphic inline cache returns the right property for each shape", () => {
+    function ic(o) {
+        return o.x;
+    }
+
+    let objects = [{ x: 1 }, { a: 0, x: 2 }, { a: 0, b: 0, x: 3 }, { a: 0, b: 0, c: 0, x: 4 }];
+    for (let i = 0; i < 3; ++i) {
+        for (let j = 0; j < objects.length; ++j) expect(ic(objects[j])).toBe(j + 1);
+    }
+});
+
+test("Megamorphic inline cache keeps working after too many shapes", () => {
+    function get(o) {
+        return o.x;
+    }
+
+    function set(o, value) {
+        o.x = value;
+    }
+
+    let objects = [];
+    for (let i = 0; i < 32; ++i) {
+        let o = {};
+        o["p" + i] = i;
+        o.x = i;
+        objects.push(o);
+    }
+
+    for (let i = 0; i < 2; ++i) {
+        for (let j = 0; j < objects.length; ++j) {
+            expect(get(objects[j])).toBe(j);
+            set(objects[j], j * 2);
+            expect(get(objects[j])).toBe(j * 2);
+            set(objects[j], j);
+        }
+    }
+});
+
+test("Polymorphic inline cache entry invalidated by prototype mutation", () => {
+    function ic(o) {
+        return o.foo;
+    }
+
+    let proto = { foo: 1 };
+    let a = Object.create(proto);
+    let b = { foo: 2 };
+
+    expect(ic(a)).toBe(1);
+    expect(ic(b)).toBe(2);
+    proto.foo = 3;
+    expect(ic(a)).toBe(3);
+    Object.setPrototypeOf(proto, { bar: 1 });
+    delete proto.foo;
+    expect(ic(a)).toBeUndefined();
+    expect(ic(b)).toBe(2);
+});
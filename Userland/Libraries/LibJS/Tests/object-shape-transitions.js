@@ -0,0 +1,70 @@
+test("Objects sharing a transition chain only see their own properties", () => {
+    const a = {};
+    a.x = 1;
+    a.y = 2;
+    const b = {};
+    b.x = 1;
+    b.y = 2;
+    b.z = 3;
+
+    expect(Object.keys(a)).toEqual(["x", "y"]);
+    expect(Object.keys(b)).toEqual(["x", "y", "z"]);
+    expect(a.z).toBeUndefined();
+    expect(Object.hasOwn(a, "z")).toBeFalse();
+    expect(b.z).toBe(3);
+});
+
+test("Branching transition chains keep their properties apart", () => {
+    const a = { x: 1, y: 2 };
+    const b = { x: 1, z: 3 };
+    const c = { x: 1, y: 2, w: 4 };
+
+    expect(Object.keys(a)).toEqual(["x", "y"]);
+    expect(Object.keys(b)).toEqual(["x", "z"]);
+    expect(Object.keys(c)).toEqual(["x", "y", "w"]);
+    expect(a.z).toBeUndefined();
+    expect(b.y).toBeUndefined();
+    expect(c.z).toBeUndefined();
+    expect(b.z).toBe(3);
+    expect(c.w).toBe(4);
+});
+
+test("Enumerating an object in the middle of a chain, then extending it", () => {
+    const long = { a: 1, b: 2, c: 3, d: 4 };
+    const short = { a: 1, b: 2 };
+
+    expect(Object.keys(short)).toEqual(["a", "b"]);
+    short.e = 5;
+    expect(Object.keys(short)).toEqual(["a", "b", "e"]);
+    expect(short.c).toBeUndefined();
+    expect(Object.keys(long)).toEqual(["a", "b", "c", "d"]);
+    expect(long.e).toBeUndefined();
+});
+
+test("Reconfiguring and deleting properties along a shared chain", () => {
+    const a = { x: 1, y: 2, z: 3 };
+    const b = { x: 1, y: 2, z: 3 };
+
+    Object.defineProperty(b, "y", { enumerable: false });
+    expect(Object.keys(a)).toEqual(["x", "y", "z"]);
+    expect(Object.keys(b)).toEqual(["x", "z"]);
+
+    delete a.x;
+    expect(Object.keys(a)).toEqual(["y", "z"]);
+    expect(a.y).toBe(2);
+    expect(a.z).toBe(3);
+    expect(b.x).toBe(1);
+    expect(Object.getOwnPropertyNames(b)).toEqual(["x", "y", "z"]);
+});
+
+test("Symbol keys along a shared chain", () => {
+    const s1 = Symbol("s1");
+    const s2 = Symbol("s2");
+    const a = { [s1]: 1 };
+    const b = { [s1]: 1, [s2]: 2 };
+
+    expect(Object.getOwnPropertySymbols(a)).toEqual([s1]);
+    expect(Object.getOwnPropertySymbols(b)).toEqual([s1, s2]);
+    expect(a[s2]).toBeUndefined();
+    expect(b[s2]).toBe(2);
+});
@@ -37,3 +37,15 @@ test("basic functionality", () => {
     expect(undefined % undefined).toBeNaN();
     expect(null % null).toBeNaN();
 });
+
+test("int32 operands", () => {
+    const mod = (a, b) => a % b;
+    expect(mod(17, 5)).toBe(2);
+    expect(mod(0, 7)).toBe(0);
+    expect(mod(-17, 5)).toBe(-2);
+    expect(mod(-10, 5)).toBe(-0);
+    expect(mod(17, -5)).toBe(2);
+    expect(mod(5, 0)).toBeNaN();
+    expect(mod(-2147483648, -1)).toBe(-0);
+    expect(mod(2147483647, 2)).toBe(1);
+});
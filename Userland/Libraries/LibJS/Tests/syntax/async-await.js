@@ -292,3 +292,43 @@ describe("await observably looks up constructor of Promise objects", () => {
     runQueuedPromiseJobs();
     expect(calls).toBe(4);
 });
+
+describe("many awaits in one async function", () => {
+    test("fulfilled and rejected awaits can be interleaved", () => {
+        let log = [];
+        async function f() {
+            for (let i = 0; i < 5; ++i) {
+                log.push(await i);
+                try {
+                    await Promise.reject(`error ${i}`);
+                } catch (e) {
+                    log.push(e);
+                }
+            }
+            return "done";
+        }
+
+        let result;
+        f().then(value => {
+            result = value;
+        });
+        runQueuedPromiseJobs();
+        expect(result).toBe("done");
+        expect(log).toEqual([0, "error 0", 1, "error 1", 2, "error 2", 3, "error 3", 4, "error 4"]);
+    });
+
+    test("concurrently suspended async functions resume independently", () => {
+        let log = [];
+        async function f(name) {
+            for (let i = 0; i < 3; ++i) {
+                await null;
+                log.push(`${name}${i}`);
+            }
+        }
+
+        f("a");
+        f("b");
+        runQueuedPromiseJobs();
+        expect(log).toEqual(["a0", "b0", "a1", "b1", "a2", "b2"]);
+    });
+});
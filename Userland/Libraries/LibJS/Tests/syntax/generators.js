@@ -63,3 +63,17 @@ test("function expression names equal to 'yield'", () => {
     expect(`function *foo() { (function yield() {}); }`).toEval();
     expect(`function *foo() { function yield() {} }`).not.toEval();
 });
+
+test("yielded and returned values that look like internal results", () => {
+    function* foo() {
+        const received = yield { result: 1, continuation: null, isAwait: true };
+        yield received;
+        return { result: 2, continuation: 0 };
+    }
+
+    const generator = foo();
+    expect(generator.next().value).toEqual({ result: 1, continuation: null, isAwait: true });
+    expect(generator.next(3)).toEqual({ value: 3, done: false });
+    expect(generator.next()).toEqual({ value: { result: 2, continuation: 0 }, done: true });
+    expect(generator.next()).toEqual({ value: undefined, done: true });
+});
@@ -170,3 +170,51 @@ test("try statement must have either 'catch' or 'finally' clause", () => {
     expect("try {} catch (e) {} finally {}").toEval();
     expect("try {}").not.toEval();
 });
+
+test("catch parameter shadows outer binding", () => {
+    let e = "outer";
+    try {
+        throw "inner";
+    } catch (e) {
+        expect(e).toBe("inner");
+        e = "assigned";
+        expect(e).toBe("assigned");
+    }
+    expect(e).toBe("outer");
+});
+
+test("catch parameter is fresh on every iteration", () => {
+    const caught = [];
+    const closures = [];
+    for (let i = 0; i < 3; ++i) {
+        try {
+            throw i;
+        } catch (e) {
+            caught.push(e);
+            closures.push(() => e);
+        }
+    }
+    expect(caught).toEqual([0, 1, 2]);
+    expect(closures.map(closure => closure())).toEqual([0, 1, 2]);
+});
+
+test("catch parameter is visible to direct eval", () => {
+    try {
+        throw 42;
+    } catch (e) {
+        expect(eval("e")).toBe(42);
+    }
+});
+
+test("var redeclaring catch parameter assigns to the parameter", () => {
+    function f() {
+        try {
+            throw "thrown";
+        } catch (e) {
+            var e = "assigned";
+            expect(e).toBe("assigned");
+        }
+        return e;
+    }
+    expect(f()).toBeUndefined();
+});
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/Math.h>
 #include <AK/StdLibExtras.h>
 #include <LibGfx/Matrix4x4.h>
@@ -155,4 +156,79 @@ DecoderErrorOr<ColorConverter> ColorConverter::create(u8 bit_depth, CodingIndepe
     return ColorConverter(bit_depth, input_cicp, should_skip_color_remapping, should_tonemap, input_conversion_matrix, to_linear_lookup_table, color_primaries_matrix_4x4, to_non_linear_lookup_table);
 }
 
+template<typename T>
+ALWAYS_INLINE void ColorConverter::convert_row_impl(T const* y_row, T const* u_row, T const* v_row, u32* output, size_t width) const
+{
+    using namespace AK::SIMD;
+
+    // NOTE: Tonemapping works on all three channels of a pixel together, so it's left to the per-pixel conversion.
+    if (m_should_tonemap) {
+        for (size_t x = 0; x < width; ++x)
+            output[x] = convert_yuv(y_row[x], u_row[x], v_row[x]).value();
+        return;
+    }
+
+    // The same steps as convert_yuv(), with each vector holding one channel of four pixels.
+    auto const* input_matrix = m_input_conversion_matrix.elements();
+    auto const* remapping_matrix = m_color_space_conversion_matrix.elements();
+    auto convert_pixels = [&](T const* y_samples, T const* u_samples, T const* v_samples) {
+        auto load = [](T const* samples) {
+            return f32x4 { static_cast<float>(samples[0]), static_cast<float>(samples[1]), static_cast<float>(samples[2]), static_cast<float>(samples[3]) };
+        };
+        auto y = load(y_samples);
+        auto u = load(u_samples);
+        auto v = load(v_samples);
+
+        f32x4 red = input_matrix[0][0] * y + input_matrix[0][1] * u + input_matrix[0][2] * v + input_matrix[0][3];
+        f32x4 green = input_matrix[1][0] * y + input_matrix[1][1] * u + input_matrix[1][2] * v + input_matrix[1][3];
+        f32x4 blue = input_matrix[2][0] * y + input_matrix[2][1] * u + input_matrix[2][2] * v + input_matrix[2][3];
+
+        if (!m_should_skip_color_remapping) {
+            red = m_to_linear_lookup.do_lookup(red);
+            green = m_to_linear_lookup.do_lookup(green);
+            blue = m_to_linear_lookup.do_lookup(blue);
+
+            f32x4 remapped_red = remapping_matrix[0][0] * red + remapping_matrix[0][1] * green + remapping_matrix[0][2] * blue;
+            f32x4 remapped_green = remapping_matrix[1][0] * red + remapping_matrix[1][1] * green + remapping_matrix[1][2] * blue;
+            f32x4 remapped_blue = remapping_matrix[2][0] * red + remapping_matrix[2][1] * green + remapping_matrix[2][2] * blue;
+
+            red = m_to_non_linear_lookup.do_lookup(remapped_red);
+            green = m_to_non_linear_lookup.do_lookup(remapped_green);
+            blue = m_to_non_linear_lookup.do_lookup(remapped_blue);
+        }
+
+        auto to_channel = [](f32x4 value) { return to_u32x4(AK::SIMD::clamp(value, 0.0f, 1.0f) * 255.0f); };
+        return 0xff000000 | (to_channel(red) << 16) | (to_channel(green) << 8) | to_channel(blue);
+    };
+
+    size_t x = 0;
+    for (; x + 4 <= width; x += 4)
+        store_unaligned(output + x, convert_pixels(y_row + x, u_row + x, v_row + x));
+
+    if (x < width) {
+        // Pad the pixels that are left over out to a full vector, so that they are converted the same way as the rest.
+        Array<T, 4> y_samples {};
+        Array<T, 4> u_samples {};
+        Array<T, 4> v_samples {};
+        for (size_t i = 0; x + i < width; ++i) {
+            y_samples[i] = y_row[x + i];
+            u_samples[i] = u_row[x + i];
+            v_samples[i] = v_row[x + i];
+        }
+        auto pixels = convert_pixels(y_samples.data(), u_samples.data(), v_samples.data());
+        for (size_t i = 0; x + i < width; ++i)
+            output[x + i] = pixels[i];
+    }
+}
+
+void ColorConverter::convert_row(u8 const* y_row, u8 const* u_row, u8 const* v_row, u32* output, size_t width) const
+{
+    convert_row_impl(y_row, u_row, v_row, output, width);
+}
+
+void ColorConverter::convert_row(u16 const* y_row, u16 const* u_row, u16 const* v_row, u32* output, size_t width) const
+{
+    convert_row_impl(y_row, u_row, v_row, output, width);
+}
+
 }
@@ -10,10 +10,58 @@
 #include "FFmpegHelpers.h"
 #include "FFmpegVideoDecoder.h"
 
+extern "C" {
+#include <libavutil/hwcontext.h>
+}
+
 namespace Media::FFmpeg {
 
-static AVPixelFormat negotiate_output_format(AVCodecContext*, AVPixelFormat const* formats)
+static AVHWDeviceType preferred_hardware_device_type()
+{
+#if defined(AK_OS_MACOS)
+    return AV_HWDEVICE_TYPE_VIDEOTOOLBOX;
+#elif defined(AK_OS_LINUX)
+    return AV_HWDEVICE_TYPE_VAAPI;
+#else
+    return AV_HWDEVICE_TYPE_NONE;
+#endif
+}
+
+// Returns the pixel format that frames decoded with a device of the given type come out in, if the codec can be
+// decoded with one at all.
+static Optional<AVPixelFormat> hardware_pixel_format_for(AVCodec const* codec, AVHWDeviceType device_type)
 {
+    if (device_type == AV_HWDEVICE_TYPE_NONE)
+        return {};
+
+    for (int i = 0;; i++) {
+        auto const* config = avcodec_get_hw_config(codec, i);
+        if (!config)
+            return {};
+        if (config->device_type == device_type && (config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) != 0)
+            return config->pix_fmt;
+    }
+}
+
+// Hardware decoding is set up through the context's opaque pointer, which holds the pixel format that the hardware
+// decoder outputs, or AV_PIX_FMT_NONE if it's decoded in software.
+static AVPixelFormat hardware_pixel_format(AVCodecContext* codec_context)
+{
+    return static_cast<AVPixelFormat>(reinterpret_cast<intptr_t>(codec_context->opaque));
+}
+
+static AVPixelFormat negotiate_output_format(AVCodecContext* codec_context, AVPixelFormat const* formats)
+{
+    // NOTE: If the stream turns out not to be supported by the hardware decoder (for example, because of its profile),
+    //       its format won't be offered here, and we fall back to decoding in software.
+    auto hardware_format = hardware_pixel_format(codec_context);
+    if (hardware_format != AV_PIX_FMT_NONE) {
+        for (auto const* format = formats; *format >= 0; format++) {
+            if (*format == hardware_format)
+                return hardware_format;
+        }
+    }
+
     while (*formats >= 0) {
         switch (*formats) {
         case AV_PIX_FMT_YUV420P:
@@ -34,6 +82,65 @@ static AVPixelFormat negotiate_output_format(AVCodecContext*, AVPixelFormat cons
     return AV_PIX_FMT_NONE;
 }
 
+namespace {
+
+struct PixelFormatDescription {
+    u8 bit_depth { 8 };
+    Subsampling subsampling;
+    // Whether the chroma samples are interleaved in a single plane (as in NV12), rather than each having their own.
+    bool has_interleaved_chroma { false };
+    // How far the samples have to be shifted right to end up with bit_depth significant bits.
+    u8 sample_shift { 0 };
+};
+
+}
+
+static Optional<PixelFormatDescription> describe_pixel_format(AVPixelFormat format)
+{
+    switch (format) {
+    case AV_PIX_FMT_YUV420P:
+        return PixelFormatDescription { 8, { true, true } };
+    case AV_PIX_FMT_YUV420P10:
+        return PixelFormatDescription { 10, { true, true } };
+    case AV_PIX_FMT_YUV420P12:
+        return PixelFormatDescription { 12, { true, true } };
+    case AV_PIX_FMT_YUV422P:
+        return PixelFormatDescription { 8, { true, false } };
+    case AV_PIX_FMT_YUV422P10:
+        return PixelFormatDescription { 10, { true, false } };
+    case AV_PIX_FMT_YUV422P12:
+        return PixelFormatDescription { 12, { true, false } };
+    case AV_PIX_FMT_YUV444P:
+        return PixelFormatDescription { 8, { false, false } };
+    case AV_PIX_FMT_YUV444P10:
+        return PixelFormatDescription { 10, { false, false } };
+    case AV_PIX_FMT_YUV444P12:
+        return PixelFormatDescription { 12, { false, false } };
+    // Hardware decoders hand their frames over in these.
+    case AV_PIX_FMT_NV12:
+        return PixelFormatDescription { 8, { true, true }, true };
+    case AV_PIX_FMT_P010:
+        return PixelFormatDescription { 10, { true, true }, true, 6 };
+    default:
+        return {};
+    }
+}
+
+static void unshift_samples(u16 const* source, u16* destination, size_t count, u8 shift)
+{
+    for (size_t i = 0; i < count; i++)
+        destination[i] = source[i] >> shift;
+}
+
+template<typename T>
+static void deinterleave_chroma(T const* source, T* __restrict__ u_destination, T* __restrict__ v_destination, size_t count, u8 shift)
+{
+    for (size_t i = 0; i < count; i++) {
+        u_destination[i] = source[i * 2] >> shift;
+        v_destination[i] = source[i * 2 + 1] >> shift;
+    }
+}
+
 DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> FFmpegVideoDecoder::try_create(CodecID codec_id, ReadonlyBytes codec_initialization_data)
 {
     AVCodecContext* codec_context = nullptr;
@@ -57,8 +164,22 @@ DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> FFmpegVideoDecoder::try_create
         return DecoderError::format(DecoderErrorCategory::Memory, "Failed to allocate FFmpeg codec context for codec {}", codec_id);
 
     codec_context->get_format = negotiate_output_format;
+    codec_context->opaque = reinterpret_cast<void*>(static_cast<intptr_t>(AV_PIX_FMT_NONE));
+
+    // Decode in hardware where we can. If the device can't be opened, we decode in software instead.
+    auto hardware_device_type = preferred_hardware_device_type();
+    if (auto hardware_format = hardware_pixel_format_for(codec, hardware_device_type); hardware_format.has_value()) {
+        AVBufferRef* hardware_device_context = nullptr;
+        if (av_hwdevice_ctx_create(&hardware_device_context, hardware_device_type, nullptr, nullptr, 0) >= 0) {
+            // NOTE: The codec context takes over the reference and releases it along with itself.
+            codec_context->hw_device_ctx = hardware_device_context;
+            codec_context->opaque = reinterpret_cast<void*>(static_cast<intptr_t>(hardware_format.value()));
+        }
+    }
 
-    codec_context->thread_count = static_cast<int>(min(Core::System::hardware_concurrency(), 4));
+    // The decoding threads only help when the frames are decoded in software.
+    if (!codec_context->hw_device_ctx)
+        codec_context->thread_count = static_cast<int>(min(Core::System::hardware_concurrency(), 4));
 
     if (!codec_initialization_data.is_empty()) {
         if (codec_initialization_data.size() > NumericLimits<int>::max())
@@ -98,6 +219,7 @@ FFmpegVideoDecoder::~FFmpegVideoDecoder()
 {
     av_packet_free(&m_packet);
     av_frame_free(&m_frame);
+    av_frame_free(&m_transfer_frame);
     avcodec_free_context(&m_codec_context);
 }
 
@@ -133,6 +255,11 @@ DecoderErrorOr<NonnullOwnPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(
 
     switch (result) {
     case 0: {
+        // Frames that were decoded in hardware stay in the device's memory until they're brought over here.
+        AVFrame const* source_frame = m_frame;
+        if (m_frame->hw_frames_ctx)
+            source_frame = TRY(transfer_hardware_frame());
+
         auto color_primaries = static_cast<ColorPrimaries>(m_frame->color_primaries);
         auto transfer_characteristics = static_cast<TransferCharacteristics>(m_frame->color_trc);
         auto matrix_coefficients = static_cast<MatrixCoefficients>(m_frame->colorspace);
@@ -148,73 +275,71 @@ DecoderErrorOr<NonnullOwnPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(
         }();
         auto cicp = CodingIndependentCodePoints { color_primaries, transfer_characteristics, matrix_coefficients, color_range };
 
-        size_t bit_depth = [&] {
-            switch (m_frame->format) {
-            case AV_PIX_FMT_YUV420P:
-            case AV_PIX_FMT_YUV422P:
-            case AV_PIX_FMT_YUV444P:
-                return 8;
-            case AV_PIX_FMT_YUV420P10:
-            case AV_PIX_FMT_YUV422P10:
-            case AV_PIX_FMT_YUV444P10:
-                return 10;
-            case AV_PIX_FMT_YUV420P12:
-            case AV_PIX_FMT_YUV422P12:
-            case AV_PIX_FMT_YUV444P12:
-                return 12;
-            }
-            VERIFY_NOT_REACHED();
-        }();
+        auto pixel_format = describe_pixel_format(static_cast<AVPixelFormat>(source_frame->format));
+        if (!pixel_format.has_value())
+            return DecoderError::format(DecoderErrorCategory::NotImplemented, "Frames in pixel format {} are not supported", source_frame->format);
+        auto bit_depth = pixel_format->bit_depth;
+        auto subsampling = pixel_format->subsampling;
         size_t component_size = (bit_depth + 7) / 8;
 
-        auto subsampling = [&]() -> Subsampling {
-            switch (m_frame->format) {
-            case AV_PIX_FMT_YUV420P:
-            case AV_PIX_FMT_YUV420P10:
-            case AV_PIX_FMT_YUV420P12:
-                return { true, true };
-            case AV_PIX_FMT_YUV422P:
-            case AV_PIX_FMT_YUV422P10:
-            case AV_PIX_FMT_YUV422P12:
-                return { true, false };
-            case AV_PIX_FMT_YUV444P:
-            case AV_PIX_FMT_YUV444P10:
-            case AV_PIX_FMT_YUV444P12:
-                return { false, false };
-
-            default:
-                VERIFY_NOT_REACHED();
-            }
-        }();
-
         auto size = Gfx::Size<u32> { m_frame->width, m_frame->height };
 
         auto timestamp = AK::Duration::from_microseconds(m_frame->pts);
         auto frame = DECODER_TRY_ALLOC(SubsampledYUVFrame::try_create(timestamp, size, bit_depth, cicp, subsampling));
 
-        for (u32 plane = 0; plane < 3; plane++) {
-            VERIFY(m_frame->linesize[plane] != 0);
-            if (m_frame->linesize[plane] < 0)
+        auto source_plane_count = pixel_format->has_interleaved_chroma ? 2u : 3u;
+        for (u32 plane = 0; plane < source_plane_count; plane++) {
+            VERIFY(source_frame->linesize[plane] != 0);
+            if (source_frame->linesize[plane] < 0)
                 return DecoderError::with_description(DecoderErrorCategory::NotImplemented, "Reversed scanlines are not supported"sv);
+        }
 
+        // NOTE: Interleaved chroma samples are split up into their planes below.
+        auto planar_plane_count = pixel_format->has_interleaved_chroma ? 1u : 3u;
+        for (u32 plane = 0; plane < planar_plane_count; plane++) {
             bool const use_subsampling = plane > 0;
             auto plane_size = (use_subsampling ? subsampling.subsampled_size(size) : size).to_type<size_t>();
 
             auto output_line_size = plane_size.width() * component_size;
-            VERIFY(output_line_size <= static_cast<size_t>(m_frame->linesize[plane]));
+            VERIFY(output_line_size <= static_cast<size_t>(source_frame->linesize[plane]));
 
-            auto const* source = m_frame->data[plane];
-            VERIFY(source != nullptr);
             auto* destination = frame->get_raw_plane_data(plane);
             VERIFY(destination != nullptr);
 
+            auto const* source = source_frame->data[plane];
+            VERIFY(source != nullptr);
+
             for (size_t row = 0; row < plane_size.height(); row++) {
-                memcpy(destination, source, output_line_size);
-                source += m_frame->linesize[plane];
+                if (pixel_format->sample_shift == 0) {
+                    memcpy(destination, source, output_line_size);
+                } else {
+                    unshift_samples(reinterpret_cast<u16 const*>(source), reinterpret_cast<u16*>(destination), plane_size.width(), pixel_format->sample_shift);
+                }
+                source += source_frame->linesize[plane];
                 destination += output_line_size;
             }
         }
 
+        if (pixel_format->has_interleaved_chroma) {
+            auto plane_size = subsampling.subsampled_size(size).to_type<size_t>();
+            VERIFY(plane_size.width() * 2 * component_size <= static_cast<size_t>(source_frame->linesize[1]));
+
+            auto const* source = source_frame->data[1];
+            VERIFY(source != nullptr);
+            auto* u_destination = frame->get_raw_plane_data(1);
+            auto* v_destination = frame->get_raw_plane_data(2);
+
+            for (size_t row = 0; row < plane_size.height(); row++) {
+                if (component_size == 1)
+                    deinterleave_chroma(source, u_destination, v_destination, plane_size.width(), 0);
+                else
+                    deinterleave_chroma(reinterpret_cast<u16 const*>(source), reinterpret_cast<u16*>(u_destination), reinterpret_cast<u16*>(v_destination), plane_size.width(), pixel_format->sample_shift);
+                source += source_frame->linesize[1];
+                u_destination += plane_size.width() * component_size;
+                v_destination += plane_size.width() * component_size;
+            }
+        }
+
         return frame;
     }
     case AVERROR(EAGAIN):
@@ -228,6 +353,25 @@ DecoderErrorOr<NonnullOwnPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(
     }
 }
 
+DecoderErrorOr<AVFrame*> FFmpegVideoDecoder::transfer_hardware_frame()
+{
+    if (!m_transfer_frame) {
+        m_transfer_frame = av_frame_alloc();
+        if (!m_transfer_frame)
+            return DecoderError::with_description(DecoderErrorCategory::Memory, "Failed to allocate FFmpeg frame"sv);
+    }
+
+    // NOTE: The transfer picks the first system memory format the device can give us, which is NV12 or P010 for all the
+    //       devices we use.
+    av_frame_unref(m_transfer_frame);
+    auto result = av_hwframe_transfer_data(m_transfer_frame, m_frame, 0);
+    if (result == AVERROR(ENOMEM))
+        return DecoderError::with_description(DecoderErrorCategory::Memory, "Failed to allocate memory to transfer a hardware frame into"sv);
+    if (result < 0)
+        return DecoderError::format(DecoderErrorCategory::Unknown, "Failed to transfer a frame from the hardware decoder with code {:x}", result);
+    return m_transfer_frame;
+}
+
 void FFmpegVideoDecoder::flush()
 {
     avcodec_flush_buffers(m_codec_context);
@@ -26,10 +26,13 @@ public:
 
 private:
     DecoderErrorOr<void> decode_single_sample(AK::Duration timestamp, u8* data, int size);
+    DecoderErrorOr<AVFrame*> transfer_hardware_frame();
 
     AVCodecContext* m_codec_context;
     AVPacket* m_packet;
     AVFrame* m_frame;
+    // Receives the frames decoded in hardware once they have been brought over to system memory.
+    AVFrame* m_transfer_frame { nullptr };
 };
 
 }
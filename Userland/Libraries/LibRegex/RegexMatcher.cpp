@@ -77,6 +77,21 @@ Regex<Parser>& Regex<Parser>::operator=(Regex&& regex)
     return *this;
 }
 
+template<class Parser>
+Regex<Parser>::Regex(CloneTag, Regex const& regex)
+    : pattern_value(regex.pattern_value)
+    , parser_result(regex.parser_result)
+{
+    if (regex.matcher)
+        matcher = make<Matcher<Parser>>(this, regex.matcher->options());
+}
+
+template<class Parser>
+Regex<Parser> Regex<Parser>::clone() const
+{
+    return Regex { CloneTag {}, *this };
+}
+
 template<class Parser>
 typename ParserTraits<Parser>::OptionsType Regex<Parser>::options() const
 {
@@ -185,6 +200,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
 
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
     auto only_start_of_line = m_pattern->parser_result.optimization_data.only_start_of_line && !input.regex_options.has_flag_set(AllFlags::Multiline);
+    auto const& starting_ranges = m_pattern->parser_result.optimization_data.starting_ranges;
 
     for (auto const& view : views) {
         if (lines_to_skip != 0) {
@@ -197,6 +213,22 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
 
         auto view_length = view.length();
         size_t view_index = m_pattern->start_offset;
+
+        // Outside of unicode mode every start position is a single code unit, so we can reject candidates without running the VM.
+        auto use_starting_ranges = !starting_ranges.is_empty() && !view.unicode()
+            && !input.regex_options.has_flag_set(AllFlags::Insensitive) && !input.regex_options.has_flag_set(AllFlags::Internal_Stateful);
+        Optional<char> single_starting_byte;
+        if (use_starting_ranges && view.is_string_view() && starting_ranges.size() == 1 && starting_ranges.first().from == starting_ranges.first().to && starting_ranges.first().from <= 0x7f)
+            single_starting_byte = static_cast<char>(starting_ranges.first().from);
+
+        auto is_possible_start = [&](size_t index) {
+            auto code_unit = view.code_unit_at(index);
+            for (auto const& range : starting_ranges) {
+                if (code_unit >= range.from && code_unit <= range.to)
+                    return true;
+            }
+            return false;
+        };
         state.string_position = view_index;
         state.string_position_in_code_units = view_index;
         bool succeeded = false;
@@ -246,6 +278,23 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             if (match_length_minimum && match_length_minimum > view_length - view_index)
                 break;
 
+            if (use_starting_ranges) {
+                if (!continue_search) {
+                    if (view_index == view_length || !is_possible_start(view_index))
+                        break;
+                } else if (single_starting_byte.has_value()) {
+                    auto next_candidate = view.string_view().find(*single_starting_byte, view_index);
+                    if (!next_candidate.has_value())
+                        break;
+                    view_index = *next_candidate;
+                } else {
+                    while (view_index < view_length && !is_possible_start(view_index))
+                        ++view_index;
+                    if (view_index == view_length)
+                        break;
+                }
+            }
+
             input.column = match_count;
             input.match_index = match_count;
 
@@ -343,7 +392,18 @@ public:
 
     ALWAYS_INLINE void append(T value)
     {
-        auto node_ptr = m_allocator.allocate(move(value));
+        Node* node_ptr;
+        if (m_free_nodes) {
+            // Reuse a node released by take_last(), so deep backtracking keeps touching the same (hot) memory
+            // instead of bump-allocating fresh nodes for every fork.
+            node_ptr = m_free_nodes;
+            m_free_nodes = node_ptr->next;
+            node_ptr->value = move(value);
+            node_ptr->next = nullptr;
+            node_ptr->previous = nullptr;
+        } else {
+            node_ptr = m_allocator.allocate(move(value));
+        }
         VERIFY(node_ptr);
 
         if (!m_first) {
@@ -360,7 +420,8 @@ public:
     ALWAYS_INLINE T take_last()
     {
         VERIFY(m_last);
-        T value = move(m_last->value);
+        auto* node = m_last;
+        T value = move(node->value);
         if (m_last == m_first) {
             m_last = nullptr;
             m_first = nullptr;
@@ -368,6 +429,10 @@ public:
             m_last = m_last->previous;
             m_last->next = nullptr;
         }
+        // The allocator only runs destructors when it is torn down, so the node stays valid on the free list.
+        node->previous = nullptr;
+        node->next = m_free_nodes;
+        m_free_nodes = node;
         return value;
     }
 
@@ -415,6 +480,7 @@ private:
     UniformBumpAllocator<Node, true, 2 * MiB> m_allocator;
     Node* m_first { nullptr };
     Node* m_last { nullptr };
+    Node* m_free_nodes { nullptr };
 };
 
 template<class Parser>
@@ -95,6 +95,9 @@ public:
     Regex(Regex&&);
     Regex& operator=(Regex&&);
 
+    // Makes an independent copy of this regex, without parsing and optimizing the pattern again.
+    Regex clone() const;
+
     typename ParserTraits<Parser>::OptionsType options() const;
     ByteString error_string(Optional<ByteString> message = {}) const;
 
@@ -229,9 +232,13 @@ public:
     static BasicBlockList split_basic_blocks(ByteCode const&);
 
 private:
+    struct CloneTag { };
+    Regex(CloneTag, Regex const&);
+
     void run_optimization_passes();
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
     bool attempt_rewrite_entire_match_as_substring_search(BasicBlockList const&);
+    void fill_starting_ranges();
 };
 
 // free standing functions for match, search and has_match
@@ -6,6 +6,7 @@
 
 #include <AK/Debug.h>
 #include <AK/Function.h>
+#include <AK/HashTable.h>
 #include <AK/Queue.h>
 #include <AK/QuickSort.h>
 #include <AK/RedBlackTree.h>
@@ -43,6 +44,8 @@ void Regex<Parser>::run_optimization_passes()
         parser_result.optimization_data.only_start_of_line = true;
 
     parser_result.bytecode.flatten();
+
+    fill_starting_ranges();
 }
 
 template<typename Parser>
@@ -533,6 +536,117 @@ static AtomicRewritePreconditionResult block_satisfies_atomic_rewrite_preconditi
     return AtomicRewritePreconditionResult::SatisfiedWithEmptyHeader;
 }
 
+template<typename Parser>
+void Regex<Parser>::fill_starting_ranges()
+{
+    // If every path from the start of the pattern has to consume a code unit from a small set before doing
+    // anything else, the matcher can skip over any start position that holds some other code unit.
+    // e.g. /foo|bar/ has to start with 'f' or 'b', and /(a+)c/ has to start with 'a'.
+    if (parser_result.options.has_flag_set(AllFlags::Insensitive))
+        return;
+
+    static constexpr size_t max_starting_ranges = 16;
+
+    auto& bytecode = parser_result.bytecode;
+    Vector<CharRange> ranges;
+    HashTable<size_t> visited;
+    Vector<size_t> positions_to_visit;
+    positions_to_visit.append(0);
+
+    auto add_range = [&](u32 from, u32 to) {
+        ranges.empend(from, to);
+        return ranges.size() <= max_starting_ranges;
+    };
+
+    auto collect_first_code_units = [&](OpCode_Compare const& compare, size_t position) {
+        // The arguments of a single Compare are alternatives for the same code unit.
+        size_t offset = position + 3;
+        for (size_t i = 0; i < compare.arguments_count(); ++i) {
+            auto compare_type = (CharacterCompareType)bytecode.at(offset++);
+            switch (compare_type) {
+            case CharacterCompareType::Char: {
+                auto ch = bytecode.at(offset++);
+                if (!add_range(ch, ch))
+                    return false;
+                break;
+            }
+            case CharacterCompareType::CharRange: {
+                CharRange range = bytecode.at(offset++);
+                if (!add_range(range.from, range.to))
+                    return false;
+                break;
+            }
+            case CharacterCompareType::String: {
+                auto length = bytecode.at(offset++);
+                if (length == 0)
+                    return false;
+                auto ch = bytecode.at(offset);
+                if (!add_range(ch, ch))
+                    return false;
+                offset += length;
+                break;
+            }
+            case CharacterCompareType::LookupTable: {
+                auto count = bytecode.at(offset++);
+                for (size_t j = 0; j < count; ++j) {
+                    CharRange range = bytecode.at(offset++);
+                    if (!add_range(range.from, range.to))
+                        return false;
+                }
+                break;
+            }
+            default:
+                // Inversions, classes, properties and references can't be summarized cheaply.
+                return false;
+            }
+        }
+        return compare.arguments_count() > 0;
+    };
+
+    while (!positions_to_visit.is_empty()) {
+        auto position = positions_to_visit.take_last();
+        if (visited.set(position) != HashSetResult::InsertedNewEntry)
+            continue;
+
+        // Reaching the end of the bytecode means the pattern can match without consuming anything.
+        if (position >= bytecode.size())
+            return;
+
+        MatchState state;
+        state.instruction_position = position;
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            if (!collect_first_code_units(static_cast<OpCode_Compare const&>(opcode), position))
+                return;
+            break;
+        case OpCodeId::Jump:
+            positions_to_visit.append(position + opcode.size() + static_cast<OpCode_Jump const&>(opcode).offset());
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            positions_to_visit.append(position + opcode.size());
+            positions_to_visit.append(position + opcode.size() + static_cast<OpCode_ForkJump const&>(opcode).offset());
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            positions_to_visit.append(position + opcode.size());
+            positions_to_visit.append(position + opcode.size() + static_cast<OpCode_ForkStay const&>(opcode).offset());
+            break;
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+            positions_to_visit.append(position + opcode.size());
+            break;
+        default:
+            return;
+        }
+    }
+
+    parser_result.optimization_data.starting_ranges = move(ranges);
+}
+
 template<typename Parser>
 bool Regex<Parser>::attempt_rewrite_entire_match_as_substring_search(BasicBlockList const& basic_blocks)
 {
@@ -59,6 +59,8 @@ public:
         struct {
             Optional<ByteString> pure_substring_search;
             bool only_start_of_line = false;
+            // Every match has to start with a code unit in one of these ranges (empty if unknown).
+            Vector<CharRange> starting_ranges;
         } optimization_data {};
     };
 
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/System.h>
 #include <LibRequests/Request.h>
 #include <LibRequests/RequestClient.h>
 
@@ -28,9 +29,17 @@ bool Request::stop()
     return m_client->stop_request({}, *this);
 }
 
-void Request::set_request_fd(Badge<Requests::RequestClient>, int fd)
+ErrorOr<void> Request::set_request_fd(Badge<Requests::RequestClient>, int fd, Core::AnonymousBuffer body_buffer)
 {
     VERIFY(m_fd == -1);
+
+    // NOTE: The body is only ever written to the ring, whatever comes through the fd is just a wakeup.
+    auto ring = Core::SharedByteRingBuffer::attach(move(body_buffer));
+    if (ring.is_error()) {
+        (void)Core::System::close(fd);
+        return ring.release_error();
+    }
+    m_body_ring = ring.release_value();
     m_fd = fd;
 
     auto notifier = Core::Notifier::construct(fd, Core::Notifier::Type::Read);
@@ -38,6 +47,7 @@ void Request::set_request_fd(Badge<Requests::RequestClient>, int fd)
     notifier->on_activation = move(m_internal_stream_data->read_notifier->on_activation);
     m_internal_stream_data->read_notifier = move(notifier);
     m_internal_stream_data->read_stream = move(stream);
+    return {};
 }
 
 void Request::set_buffered_request_finished_callback(BufferedRequestFinished on_buffered_request_finished)
@@ -121,7 +131,10 @@ void Request::set_up_internal_stream_data(DataReceived on_data_available)
     };
 
     m_internal_stream_data->on_finish = [this, user_on_finish = move(user_on_finish)]() {
-        if (!m_internal_stream_data->user_finish_called && m_internal_stream_data->read_stream->is_eof()) {
+        // NOTE: Without a stream, the request failed before it could start.
+        auto stream_is_drained = !m_internal_stream_data->read_stream || m_internal_stream_data->read_stream->is_eof();
+        auto body_ring_is_drained = !m_body_ring.is_valid() || m_body_ring.used_space() == 0;
+        if (!m_internal_stream_data->user_finish_called && stream_is_drained && body_ring_is_drained) {
             m_internal_stream_data->user_finish_called = true;
             user_on_finish(m_internal_stream_data->success, m_internal_stream_data->total_size);
         }
@@ -138,13 +151,20 @@ void Request::set_up_internal_stream_data(DataReceived on_data_available)
             if (result.is_error())
                 continue;
 
-            auto read_bytes = result.release_value();
-            if (read_bytes.is_empty())
+            // Whatever comes through the fd is only there to wake us up.
+            if (result.value().is_empty())
                 break;
-
-            on_data_available(read_bytes);
         } while (true);
 
+        auto* bytes = reinterpret_cast<u8*>(buffer);
+        while (auto nread = m_body_ring.read({ bytes, buffer_size }))
+            on_data_available({ bytes, nread });
+
+        if (m_body_ring.take_producer_is_waiting()) {
+            u8 wakeup = 0;
+            (void)Core::System::send(m_fd, &wakeup, sizeof(wakeup), MSG_NOSIGNAL);
+        }
+
         if (m_internal_stream_data->read_stream->is_eof())
             m_internal_stream_data->read_notifier->close();
 
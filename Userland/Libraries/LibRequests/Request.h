@@ -14,6 +14,7 @@
 #include <AK/RefCounted.h>
 #include <AK/WeakPtr.h>
 #include <LibCore/Notifier.h>
+#include <LibCore/SharedByteRingBuffer.h>
 #include <LibHTTP/HeaderMap.h>
 #include <LibIPC/Forward.h>
 
@@ -58,7 +59,7 @@ public:
     void did_request_certificates(Badge<RequestClient>);
 
     RefPtr<Core::Notifier>& write_notifier(Badge<RequestClient>) { return m_write_notifier; }
-    void set_request_fd(Badge<RequestClient>, int fd);
+    ErrorOr<void> set_request_fd(Badge<RequestClient>, int fd, Core::AnonymousBuffer body_buffer);
 
 private:
     explicit Request(RequestClient&, i32 request_id);
@@ -70,6 +71,9 @@ private:
     RefPtr<Core::Notifier> m_write_notifier;
     int m_fd { -1 };
 
+    // The response body arrives through this ring buffer in shared memory, while the fd only carries wakeups.
+    Core::SharedByteRingBuffer m_body_ring;
+
     enum class Mode {
         Buffered,
         Unbuffered,
@@ -27,7 +27,12 @@ void RequestClient::ensure_connection(URL::URL const& url, ::RequestServer::Cach
     async_ensure_connection(url, cache_level);
 }
 
-RefPtr<Request> RequestClient::start_request(ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ReadonlyBytes request_body, Core::ProxyData const& proxy_data)
+ByteString RequestClient::connection_statistics()
+{
+    return IPCProxy::connection_statistics();
+}
+
+RefPtr<Request> RequestClient::start_request(ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ReadonlyBytes request_body, Core::ProxyData const& proxy_data, ::RequestServer::RequestPriority priority, ByteString const& cache_partition)
 {
     auto body_result = ByteBuffer::copy(request_body);
     if (body_result.is_error())
@@ -36,13 +41,13 @@ RefPtr<Request> RequestClient::start_request(ByteString const& method, URL::URL
     static i32 s_next_request_id = 0;
     auto request_id = s_next_request_id++;
 
-    IPCProxy::async_start_request(request_id, method, url, request_headers, body_result.release_value(), proxy_data);
+    IPCProxy::async_start_request(request_id, method, url, request_headers, body_result.release_value(), proxy_data, priority, cache_partition);
     auto request = Request::create_from_id({}, *this, request_id);
     m_requests.set(request_id, request);
     return request;
 }
 
-void RequestClient::request_started(i32 request_id, IPC::File const& response_file)
+void RequestClient::request_started(i32 request_id, IPC::File const& response_file, Core::AnonymousBuffer const& body_buffer)
 {
     auto request = m_requests.get(request_id);
     if (!request.has_value()) {
@@ -51,7 +56,11 @@ void RequestClient::request_started(i32 request_id, IPC::File const& response_fi
     }
 
     auto response_fd = response_file.take_fd();
-    request.value()->set_request_fd({}, response_fd);
+    if (auto result = request.value()->set_request_fd({}, response_fd, body_buffer); result.is_error()) {
+        warnln("Unable to read the response body of request {}: {}", request_id, result.error());
+        (void)IPCProxy::stop_request(request_id);
+        request_finished(request_id, false, 0);
+    }
 }
 
 bool RequestClient::stop_request(Badge<Request>, Request& request)
@@ -148,6 +157,13 @@ void RequestClient::websocket_subprotocol(i64 websocket_id, ByteString const& su
     }
 }
 
+void RequestClient::websocket_extensions(i64 websocket_id, ByteString const& extensions)
+{
+    auto maybe_connection = m_websockets.get(websocket_id);
+    if (maybe_connection.has_value())
+        maybe_connection.value()->set_extensions_in_use(extensions);
+}
+
 void RequestClient::websocket_certificate_requested(i64 websocket_id)
 {
     auto maybe_connection = m_websockets.get(websocket_id);
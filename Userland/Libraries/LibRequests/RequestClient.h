@@ -27,11 +27,12 @@ public:
     explicit RequestClient(NonnullOwnPtr<Core::LocalSocket>);
     virtual ~RequestClient() override;
 
-    RefPtr<Request> start_request(ByteString const& method, URL::URL const&, HTTP::HeaderMap const& request_headers = {}, ReadonlyBytes request_body = {}, Core::ProxyData const& = {});
+    RefPtr<Request> start_request(ByteString const& method, URL::URL const&, HTTP::HeaderMap const& request_headers = {}, ReadonlyBytes request_body = {}, Core::ProxyData const& = {}, ::RequestServer::RequestPriority = ::RequestServer::RequestPriority::Medium, ByteString const& cache_partition = {});
 
     RefPtr<WebSocket> websocket_connect(const URL::URL&, ByteString const& origin = {}, Vector<ByteString> const& protocols = {}, Vector<ByteString> const& extensions = {}, HTTP::HeaderMap const& request_headers = {});
 
     void ensure_connection(URL::URL const&, ::RequestServer::CacheLevel);
+    ByteString connection_statistics();
 
     bool stop_request(Badge<Request>, Request&);
     bool set_certificate(Badge<Request>, Request&, ByteString, ByteString);
@@ -39,7 +40,7 @@ public:
 private:
     virtual void die() override;
 
-    virtual void request_started(i32, IPC::File const&) override;
+    virtual void request_started(i32, IPC::File const&, Core::AnonymousBuffer const&) override;
     virtual void request_finished(i32, bool, u64) override;
     virtual void certificate_requested(i32) override;
     virtual void headers_became_available(i32, HTTP::HeaderMap const&, Optional<u32> const&) override;
@@ -50,6 +51,7 @@ private:
     virtual void websocket_closed(i64 websocket_id, u16, ByteString const&, bool) override;
     virtual void websocket_ready_state_changed(i64 websocket_id, u32 ready_state) override;
     virtual void websocket_subprotocol(i64 websocket_id, ByteString const& subprotocol) override;
+    virtual void websocket_extensions(i64 websocket_id, ByteString const& extensions) override;
     virtual void websocket_certificate_requested(i64 websocket_id) override;
 
     HashMap<i32, RefPtr<Request>> m_requests;
@@ -35,6 +35,16 @@ void WebSocket::set_subprotocol_in_use(ByteString subprotocol)
     m_subprotocol = move(subprotocol);
 }
 
+ByteString WebSocket::extensions_in_use()
+{
+    return m_extensions;
+}
+
+void WebSocket::set_extensions_in_use(ByteString extensions)
+{
+    m_extensions = move(extensions);
+}
+
 void WebSocket::send(ByteBuffer binary_or_text_message, bool is_text)
 {
     m_client->async_websocket_send(m_websocket_id, is_text, move(binary_or_text_message));
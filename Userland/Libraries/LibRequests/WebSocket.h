@@ -57,6 +57,9 @@ public:
     ByteString subprotocol_in_use();
     void set_subprotocol_in_use(ByteString);
 
+    ByteString extensions_in_use();
+    void set_extensions_in_use(ByteString);
+
     void send(ByteBuffer binary_or_text_message, bool is_text);
     void send(StringView text_message);
     void close(u16 code = 1005, ByteString reason = {});
@@ -78,6 +81,7 @@ private:
     WeakPtr<RequestClient> m_client;
     ReadyState m_ready_state { ReadyState::Connecting };
     ByteString m_subprotocol;
+    ByteString m_extensions;
     i64 m_websocket_id { -1 };
 };
 
@@ -34,6 +34,16 @@ ByteBuffer TLSv12::build_hello()
     builder.append(version);
     builder.append(m_context.local_random, sizeof(m_context.local_random));
 
+    // Offer the session we last had with this server, so that the server can skip the key exchange if it still knows it.
+    if (can_resume_sessions()) {
+        m_context.offered_session = SessionCache::the().find(m_context.session_cache_key);
+        if (m_context.offered_session.has_value()) {
+            auto const& session_id = m_context.offered_session->session_id;
+            memcpy(m_context.session_id, session_id.data(), session_id.size());
+            m_context.session_id_size = session_id.size();
+        }
+    }
+
     builder.append(m_context.session_id_size);
     if (m_context.session_id_size)
         builder.append(m_context.session_id, m_context.session_id_size);
@@ -227,6 +237,21 @@ ssize_t TLSv12::handle_handshake_finished(ReadonlyBytes buffer, WritePacketStage
 
     // TODO: Compare Hashes
     dbgln_if(TLS_DEBUG, "FIXME: handle_handshake_finished :: Check message validity");
+
+    // RFC 5246 section 7.3: In an abbreviated handshake the server sends its Finished first, and the connection is only
+    //                       established once we have answered with our own.
+    if (m_context.resuming_session) {
+        write_packets = WritePacketStage::Finished;
+        return index + size;
+    }
+
+    finish_handshake();
+
+    return index + size;
+}
+
+void TLSv12::finish_handshake()
+{
     m_context.connection_status = ConnectionStatus::Established;
 
     if (m_handshake_timeout_timer) {
@@ -236,10 +261,22 @@ ssize_t TLSv12::handle_handshake_finished(ReadonlyBytes buffer, WritePacketStage
         m_handshake_timeout_timer = nullptr;
     }
 
+    if (!m_context.resuming_session && m_context.session_id_size && can_resume_sessions()) {
+        auto session_id = ByteBuffer::copy(m_context.session_id, m_context.session_id_size);
+        auto master_key = ByteBuffer::copy(m_context.master_key);
+        if (!session_id.is_error() && !master_key.is_error()) {
+            SessionCache::the().store(m_context.session_cache_key,
+                {
+                    .session_id = session_id.release_value(),
+                    .master_key = master_key.release_value(),
+                    .cipher = m_context.cipher,
+                    .extended_master_secret = m_context.extensions.extended_master_secret,
+                });
+        }
+    }
+
     if (on_connected)
         on_connected();
-
-    return index + size;
 }
 
 ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
@@ -547,7 +584,7 @@ ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
                 auto packet = build_handshake_finished();
                 write_packet(packet);
             }
-            m_context.connection_status = ConnectionStatus::Established;
+            finish_handshake();
             break;
         }
         payload_size++;
@@ -196,9 +196,47 @@ ssize_t TLSv12::handle_server_hello(ReadonlyBytes buffer, WritePacketStage& writ
         }
     }
 
+    if (m_context.offered_session.has_value()) {
+        auto resumption_result = resume_offered_session();
+        if (resumption_result < 0)
+            return resumption_result;
+    }
+
     return res;
 }
 
+ssize_t TLSv12::resume_offered_session()
+{
+    auto session = m_context.offered_session.release_value();
+
+    // RFC 5246 section 7.4.1.3: The server echoes the session ID we offered if it agrees to resume that session,
+    //                           and picks a new one otherwise.
+    if (ReadonlyBytes { m_context.session_id, m_context.session_id_size } != session.session_id.bytes()) {
+        dbgln_if(TLS_DEBUG, "Server declined to resume the session");
+        SessionCache::the().did_not_resume(m_context.session_cache_key);
+        return 0;
+    }
+
+    // RFC 5246 section 7.4.1.3: A resumed session has to keep its cipher suite.
+    // RFC 7627 section 5.3: It also has to keep using the extended master secret, or keep not using it.
+    if (m_context.cipher != session.cipher || m_context.extensions.extended_master_secret != session.extended_master_secret) {
+        dbgln("Server resumed a session with different parameters");
+        SessionCache::the().remove(m_context.session_cache_key);
+        return (i8)Error::NotSafe;
+    }
+
+    m_context.master_key = move(session.master_key);
+    if (!expand_key())
+        return (i8)Error::NotSafe;
+
+    dbgln_if(TLS_DEBUG, "Resuming session");
+    SessionCache::the().did_resume();
+    m_context.resuming_session = true;
+    // The server follows up with ChangeCipherSpec and Finished right away.
+    m_context.connection_status = ConnectionStatus::KeyExchange;
+    return 0;
+}
+
 ssize_t TLSv12::handle_server_hello_done(ReadonlyBytes buffer)
 {
     if (buffer.size() < 3)
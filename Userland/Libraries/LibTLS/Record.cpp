@@ -19,8 +19,12 @@ ByteBuffer TLSv12::build_alert(bool critical, u8 code)
     builder.append((u8)(critical ? AlertLevel::FATAL : AlertLevel::WARNING));
     builder.append(code);
 
-    if (critical)
+    if (critical) {
         m_context.critical_error = code;
+        // RFC 5246 section 7.2.2: Any connection terminated with a fatal alert MUST NOT be resumed.
+        if (code != (u8)AlertDescription::CLOSE_NOTIFY && can_resume_sessions())
+            SessionCache::the().remove(m_context.session_cache_key);
+    }
 
     auto packet = builder.build();
     update_packet(packet);
@@ -537,6 +541,8 @@ ssize_t TLSv12::handle_message(ReadonlyBytes buffer)
                 m_context.critical_error = code;
                 try_disambiguate_error();
                 res = (i8)Error::UnknownError;
+                if (code != (u8)AlertDescription::CLOSE_NOTIFY && can_resume_sessions())
+                    SessionCache::the().remove(m_context.session_cache_key);
             }
 
             if (code == (u8)AlertDescription::CLOSE_NOTIFY) {
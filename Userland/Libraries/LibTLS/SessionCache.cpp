@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <LibTLS/SessionCache.h>
+
+namespace TLS {
+
+SessionCache& SessionCache::the()
+{
+    static SessionCache s_the;
+    return s_the;
+}
+
+ByteString SessionCache::key_for(StringView host, u16 port, ReadonlySpan<CipherSuite> cipher_suites, bool extended_master_secret)
+{
+    StringBuilder builder;
+    builder.appendff("{}:{};ems={};ciphers=", host, port, extended_master_secret);
+    for (auto cipher_suite : cipher_suites)
+        builder.appendff("{:04x},", to_underlying(cipher_suite));
+    return builder.to_byte_string();
+}
+
+Optional<Session> SessionCache::find(StringView key)
+{
+    Threading::MutexLocker locker(m_mutex);
+
+    auto it = m_sessions.find(key);
+    if (it == m_sessions.end()) {
+        ++m_statistics.misses;
+        return {};
+    }
+
+    if (MonotonicTime::now_coarse() - it->value.established_time > max_session_age) {
+        m_sessions.remove(it);
+        ++m_statistics.misses;
+        return {};
+    }
+
+    auto session_id = ByteBuffer::copy(it->value.session_id);
+    auto master_key = ByteBuffer::copy(it->value.master_key);
+    if (session_id.is_error() || master_key.is_error()) {
+        ++m_statistics.misses;
+        return {};
+    }
+
+    return Session {
+        .session_id = session_id.release_value(),
+        .master_key = master_key.release_value(),
+        .cipher = it->value.cipher,
+        .extended_master_secret = it->value.extended_master_secret,
+        .established_time = it->value.established_time,
+    };
+}
+
+void SessionCache::store(ByteString const& key, Session session)
+{
+    Threading::MutexLocker locker(m_mutex);
+
+    if (m_sessions.size() >= max_entries && !m_sessions.contains(key)) {
+        auto oldest = m_sessions.begin();
+        for (auto it = m_sessions.begin(); it != m_sessions.end(); ++it) {
+            if (it->value.established_time < oldest->value.established_time)
+                oldest = it;
+        }
+        m_sessions.remove(oldest);
+    }
+
+    m_sessions.set(key, move(session));
+}
+
+void SessionCache::remove(StringView key)
+{
+    Threading::MutexLocker locker(m_mutex);
+    m_sessions.remove(key);
+}
+
+void SessionCache::did_resume()
+{
+    Threading::MutexLocker locker(m_mutex);
+    ++m_statistics.hits;
+}
+
+void SessionCache::did_not_resume(StringView key)
+{
+    Threading::MutexLocker locker(m_mutex);
+    m_sessions.remove(key);
+    ++m_statistics.misses;
+}
+
+SessionCache::Statistics SessionCache::statistics() const
+{
+    Threading::MutexLocker locker(m_mutex);
+    return m_statistics;
+}
+
+void SessionCache::clear()
+{
+    Threading::MutexLocker locker(m_mutex);
+    m_sessions.clear();
+    m_statistics = {};
+}
+
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/Time.h>
+#include <LibTLS/CipherSuite.h>
+#include <LibThreading/Mutex.h>
+
+namespace TLS {
+
+// Everything needed to resume a TLS 1.2 session by its ID (RFC 5246 section 7.3) without a new key exchange.
+struct Session {
+    ByteBuffer session_id;
+    ByteBuffer master_key;
+    CipherSuite cipher { CipherSuite::TLS_NULL_WITH_NULL_NULL };
+    bool extended_master_secret { false };
+    MonotonicTime established_time { MonotonicTime::now_coarse() };
+};
+
+// Remembers the last session negotiated with each server, shared by every connection in the process,
+// so that reconnecting to the same server takes an abbreviated handshake instead of a full one.
+class SessionCache {
+public:
+    static SessionCache& the();
+
+    struct Statistics {
+        // Connections on which the server accepted the session we offered.
+        u64 hits { 0 };
+        // Connections which had to do a full handshake, either because we had nothing to offer or the server declined it.
+        u64 misses { 0 };
+    };
+
+    // Sessions are only offered to the same host and port, and only by connections that would negotiate the same
+    // parameters: a server resuming a session with a cipher suite we didn't offer this time would abort the connection.
+    static ByteString key_for(StringView host, u16 port, ReadonlySpan<CipherSuite> cipher_suites, bool extended_master_secret);
+
+    Optional<Session> find(StringView key);
+    void store(ByteString const& key, Session);
+    void remove(StringView key);
+
+    void did_resume();
+    void did_not_resume(StringView key);
+
+    Statistics statistics() const;
+    void clear();
+
+    // Servers commonly forget sessions well before this, in which case they simply decline to resume them.
+    static constexpr AK::Duration max_session_age = AK::Duration::from_seconds(60 * 60);
+    static constexpr size_t max_entries = 256;
+
+private:
+    SessionCache() = default;
+
+    mutable Threading::Mutex m_mutex;
+    HashMap<ByteString, Session> m_sessions;
+    Statistics m_statistics;
+};
+
+}
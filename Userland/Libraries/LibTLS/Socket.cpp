@@ -57,6 +57,8 @@ ErrorOr<NonnullOwnPtr<TLSv12>> TLSv12::connect(ByteString const& host, u16 port,
     TRY(tcp_socket->set_blocking(false));
     auto tls_socket = make<TLSv12>(move(tcp_socket), move(options));
     tls_socket->set_sni(host);
+    auto const& tls_options = tls_socket->m_context.options;
+    tls_socket->m_context.session_cache_key = SessionCache::key_for(host, port, tls_options.usable_cipher_suites, tls_options.enable_extended_master_secret);
     tls_socket->on_connected = [&] {
         promise->resolve({});
     };
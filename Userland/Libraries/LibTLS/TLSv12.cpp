@@ -521,6 +521,18 @@ TLSv12::TLSv12(StreamVariantType stream, Options options)
     setup_connection();
 }
 
+bool TLSv12::can_resume_sessions() const
+{
+    // Only sessions that were established with the default level of scrutiny may be picked up by later connections,
+    // since resuming one skips certificate validation altogether.
+    auto const& options = m_context.options;
+    return options.enable_session_resumption
+        && options.validate_certificates
+        && !options.allow_self_signed_certificates
+        && !options.root_certificates.has_value()
+        && !m_context.session_cache_key.is_empty();
+}
+
 Vector<Certificate> TLSv12::parse_pem_certificate(ReadonlyBytes certificate_pem_buffer, ReadonlyBytes rsa_key) // FIXME: This should not be bound to RSA
 {
     if (certificate_pem_buffer.is_empty() || rsa_key.is_empty()) {
@@ -20,6 +20,7 @@
 #include <LibCrypto/Hash/HashManager.h>
 #include <LibCrypto/PK/RSA.h>
 #include <LibTLS/CipherSuite.h>
+#include <LibTLS/SessionCache.h>
 #include <LibTLS/TLSPacketBuilder.h>
 
 namespace TLS {
@@ -194,6 +195,8 @@ struct Options {
     OPTION_WITH_DEFAULTS(Function<void()>, finish_callback, [] {})
     OPTION_WITH_DEFAULTS(Function<Vector<Certificate>()>, certificate_provider, [] { return Vector<Certificate> {}; })
     OPTION_WITH_DEFAULTS(bool, enable_extended_master_secret, true)
+    // FIXME: Enable this by default once the abbreviated handshake has been tested against a server.
+    OPTION_WITH_DEFAULTS(bool, enable_session_resumption, false)
 
 #undef OPTION_WITH_DEFAULTS
 };
@@ -247,6 +250,12 @@ struct Context {
     u8 session_id[32];
     u8 session_id_size { 0 };
     CipherSuite cipher;
+    // The session we offered the server to resume, and whether it agreed to.
+    Optional<Session> offered_session;
+    bool resuming_session { false };
+    // Where the session is kept in the SessionCache. Empty if the connection's session may not be resumed later,
+    // e.g. because we don't know which port the server is on.
+    ByteString session_cache_key;
     bool is_server { false };
     Vector<Certificate> certificates;
     Certificate private_key;
@@ -439,6 +448,7 @@ private:
 
     ssize_t handle_server_hello(ReadonlyBytes, WritePacketStage&);
     ssize_t handle_handshake_finished(ReadonlyBytes, WritePacketStage&);
+    void finish_handshake();
     ssize_t handle_certificate(ReadonlyBytes);
     ssize_t handle_server_key_exchange(ReadonlyBytes);
     ssize_t handle_dhe_rsa_server_key_exchange(ReadonlyBytes);
@@ -523,6 +533,9 @@ private:
 
     bool expand_key();
 
+    bool can_resume_sessions() const;
+    ssize_t resume_offered_session();
+
     bool compute_master_secret_from_pre_master_secret(size_t length);
 
     void try_disambiguate_error() const;
@@ -431,6 +431,11 @@ ErrorOr<void> Latin1Decoder::process(StringView input, Function<ErrorOr<void>(u3
     return {};
 }
 
+ErrorOr<String> Latin1Decoder::to_utf8(StringView input)
+{
+    return String::from_latin1(input.bytes());
+}
+
 ErrorOr<void> PDFDocEncodingDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
 {
     // PDF 1.7 spec, Appendix D.2 "PDFDocEncoding Character Set"
@@ -502,6 +507,14 @@ ErrorOr<void> XUserDefinedDecoder::process(StringView input, Function<ErrorOr<vo
     return {};
 }
 
+static size_t find_ascii_run_length(ReadonlyBytes bytes)
+{
+    size_t length = 0;
+    while (length < bytes.size() && bytes[length] < 0x80)
+        ++length;
+    return length;
+}
+
 // https://encoding.spec.whatwg.org/#single-byte-decoder
 template<Integral ArrayType>
 ErrorOr<void> SingleByteDecoder<ArrayType>::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
@@ -525,6 +538,29 @@ ErrorOr<void> SingleByteDecoder<ArrayType>::process(StringView input, Function<E
     return {};
 }
 
+template<Integral ArrayType>
+ErrorOr<String> SingleByteDecoder<ArrayType>::to_utf8(StringView input)
+{
+    // OPTIMIZATION: ASCII bytes decode to themselves, so runs of them are copied over as they are, and inputs that are
+    //               all ASCII don't need to be decoded at all.
+    auto bytes = input.bytes();
+    if (find_ascii_run_length(bytes) == bytes.size())
+        return String::from_utf8_without_validation(bytes);
+
+    StringBuilder builder(input.length());
+    for (size_t i = 0; i < bytes.size();) {
+        auto ascii_run_length = find_ascii_run_length(bytes.slice(i));
+        TRY(builder.try_append(input.substring_view(i, ascii_run_length)));
+        i += ascii_run_length;
+        if (i == bytes.size())
+            break;
+
+        TRY(builder.try_append_code_point(m_translation_table[bytes[i] - 0x80]));
+        ++i;
+    }
+    return builder.to_string_without_validation();
+}
+
 // https://encoding.spec.whatwg.org/#index-gb18030-ranges-code-point
 static Optional<u32> index_gb18030_ranges_code_point(u32 pointer)
 {
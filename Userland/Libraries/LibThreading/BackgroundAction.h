@@ -17,6 +17,7 @@
 #include <LibCore/EventReceiver.h>
 #include <LibCore/Promise.h>
 #include <LibThreading/Thread.h>
+#include <LibThreading/ThreadPool.h>
 
 namespace Threading {
 
@@ -50,6 +51,7 @@ public:
     Optional<Result> const& result() const { return m_result; }
     Optional<Result>& result() { return m_result; }
 
+    // An action that is canceled before it starts doesn't run at all.
     void cancel() { m_canceled = true; }
     // If your action is long-running, you should periodically check the cancel state and possibly return early.
     bool is_canceled() const { return m_canceled; }
@@ -59,6 +61,22 @@ private:
         : m_promise(Promise::try_create().release_value_but_fixme_should_propagate_errors())
         , m_action(move(action))
         , m_on_complete(move(on_complete))
+    {
+        set_up_callbacks(move(on_error));
+        enqueue_work(make_work());
+    }
+
+    // Runs the action on one of the pool's threads instead of the shared background thread.
+    BackgroundAction(ThreadPool& thread_pool, ThreadPool::Priority priority, ESCAPING Function<ErrorOr<Result>(BackgroundAction&)> action, ESCAPING Function<ErrorOr<void>(Result)> on_complete, ESCAPING Optional<Function<void(Error)>> on_error = {})
+        : m_promise(Promise::try_create().release_value_but_fixme_should_propagate_errors())
+        , m_action(move(action))
+        , m_on_complete(move(on_complete))
+    {
+        set_up_callbacks(move(on_error));
+        thread_pool.enqueue(make_work(), priority);
+    }
+
+    void set_up_callbacks(Optional<Function<void(Error)>> on_error)
     {
         if (m_on_complete) {
             m_promise->on_resolution = [](NonnullRefPtr<Core::EventReceiver>& object) -> ErrorOr<void> {
@@ -74,9 +92,14 @@ private:
 
         if (on_error.has_value())
             m_on_error = on_error.release_value();
+    }
 
-        enqueue_work([self = NonnullRefPtr(*this), origin_event_loop = &Core::EventLoop::current()]() {
-            auto result = self->m_action(*self);
+    Function<void()> make_work()
+    {
+        return [self = NonnullRefPtr(*this), origin_event_loop = &Core::EventLoop::current()]() {
+            ErrorOr<Result> result = Error::from_errno(ECANCELED);
+            if (!self->m_canceled)
+                result = self->m_action(*self);
             // The event loop cancels the promise when it exits.
             self->m_canceled |= self->m_promise->is_rejected();
             // All of our work was successful and we weren't cancelled; resolve the event loop's promise.
@@ -106,7 +129,7 @@ private:
                     self->m_on_error(move(error));
                 }
             }
-        });
+        };
     }
 
     NonnullRefPtr<Promise> m_promise;
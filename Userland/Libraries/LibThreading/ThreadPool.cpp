@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/System.h>
+#include <LibThreading/ThreadPool.h>
+
+namespace Threading {
+
+static thread_local ThreadPool const* s_current_pool = nullptr;
+static thread_local size_t s_current_worker_index = 0;
+
+void ThreadPool::WorkQueue::push(Function<void()> work)
+{
+    m_work.append(move(work));
+}
+
+Function<void()> ThreadPool::WorkQueue::take_newest()
+{
+    VERIFY(!is_empty());
+    auto work = m_work.take_last();
+    reset_if_empty();
+    return work;
+}
+
+Function<void()> ThreadPool::WorkQueue::take_oldest()
+{
+    VERIFY(!is_empty());
+    auto work = move(m_work[m_head++]);
+    reset_if_empty();
+
+    // Don't let the slots of work that was taken pile up in front of a queue that never quite runs dry.
+    if (m_head >= 64 && m_head * 2 >= m_work.size()) {
+        m_work.remove(0, m_head);
+        m_head = 0;
+    }
+    return work;
+}
+
+void ThreadPool::WorkQueue::reset_if_empty()
+{
+    if (!is_empty())
+        return;
+    m_work.clear_with_capacity();
+    m_head = 0;
+}
+
+ErrorOr<NonnullOwnPtr<ThreadPool>> ThreadPool::create(StringView name, size_t thread_count)
+{
+    VERIFY(thread_count > 0);
+
+    auto pool = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ThreadPool));
+    TRY(pool->m_workers.try_ensure_capacity(thread_count));
+    for (size_t i = 0; i < thread_count; ++i)
+        pool->m_workers.unchecked_append(TRY(adopt_nonnull_own_or_enomem(new (nothrow) Worker)));
+
+    // Only start the threads once every worker exists, since they steal from each other right away.
+    for (size_t i = 0; i < thread_count; ++i) {
+        auto thread = TRY(Thread::try_create([&pool = *pool, i] { return pool.run(i); }, name));
+        thread->start();
+        pool->m_workers[i]->thread = move(thread);
+    }
+    return pool;
+}
+
+ThreadPool& ThreadPool::the()
+{
+    static ThreadPool* s_the = MUST(create("ThreadPool"sv, max(Core::System::hardware_concurrency(), 1u))).leak_ptr();
+    return *s_the;
+}
+
+ThreadPool::~ThreadPool()
+{
+    m_should_stop.store(true);
+    {
+        MutexLocker locker(m_sleep_mutex);
+        m_wake_condition.broadcast();
+    }
+
+    for (auto& worker : m_workers) {
+        if (worker->thread)
+            MUST(worker->thread->join());
+    }
+}
+
+void ThreadPool::enqueue(Function<void()> work, Priority priority)
+{
+    push(move(work), priority);
+}
+
+void ThreadPool::push(Function<void()> work, Priority priority)
+{
+    auto priority_index = to_underlying(priority);
+
+    if (auto worker_index = current_worker_index(); worker_index.has_value()) {
+        auto& worker = *m_workers[*worker_index];
+        MutexLocker locker(worker.mutex);
+        m_pending_work_count[priority_index].fetch_add(1);
+        worker.queues[priority_index].push(move(work));
+    } else {
+        MutexLocker locker(m_shared_queues_mutex);
+        m_pending_work_count[priority_index].fetch_add(1);
+        m_shared_queues[priority_index].push(move(work));
+    }
+
+    // A thread that is about to sleep counts itself as sleeping before it checks for pending work, and we counted the
+    // work as pending before checking for sleeping threads, so at least one of us notices the other.
+    if (m_sleeping_thread_count.load() > 0) {
+        MutexLocker locker(m_sleep_mutex);
+        m_wake_condition.signal();
+    }
+}
+
+Optional<size_t> ThreadPool::current_worker_index() const
+{
+    if (s_current_pool != this)
+        return {};
+    return s_current_worker_index;
+}
+
+bool ThreadPool::has_pending_work() const
+{
+    for (auto const& count : m_pending_work_count) {
+        if (count.load() > 0)
+            return true;
+    }
+    return false;
+}
+
+Function<void()> ThreadPool::take_work(Optional<size_t> worker_index)
+{
+    for (size_t priority = 0; priority < priority_count; ++priority) {
+        if (m_pending_work_count[priority].load() == 0)
+            continue;
+
+        auto take_from = [&](Mutex& mutex, WorkQueue& queue, bool newest) -> Function<void()> {
+            MutexLocker locker(mutex);
+            if (queue.is_empty())
+                return {};
+            m_pending_work_count[priority].fetch_sub(1);
+            return newest ? queue.take_newest() : queue.take_oldest();
+        };
+
+        if (worker_index.has_value()) {
+            auto& worker = *m_workers[*worker_index];
+            if (auto work = take_from(worker.mutex, worker.queues[priority], true))
+                return work;
+        }
+
+        if (auto work = take_from(m_shared_queues_mutex, m_shared_queues[priority], false))
+            return work;
+
+        // Start looking for work to steal at a different thread for every thread, so they don't all pile onto the first.
+        auto start = worker_index.has_value() ? *worker_index + 1 : 0;
+        for (size_t i = 0; i < m_workers.size(); ++i) {
+            auto& victim = *m_workers[(start + i) % m_workers.size()];
+            if (auto work = take_from(victim.mutex, victim.queues[priority], false))
+                return work;
+        }
+    }
+
+    return {};
+}
+
+intptr_t ThreadPool::run(size_t worker_index)
+{
+    s_current_pool = this;
+    s_current_worker_index = worker_index;
+
+    while (!m_should_stop.load()) {
+        if (auto work = take_work(worker_index)) {
+            work();
+            continue;
+        }
+
+        MutexLocker locker(m_sleep_mutex);
+        m_sleeping_thread_count.fetch_add(1);
+        m_wake_condition.wait_while([&] {
+            return !m_should_stop.load() && !has_pending_work();
+        });
+        m_sleeping_thread_count.fetch_sub(1);
+    }
+
+    return 0;
+}
+
+void ThreadPool::run_and_wait(size_t task_count, Function<void(size_t)> const& task, Priority priority)
+{
+    if (task_count == 0)
+        return;
+
+    struct {
+        Mutex mutex;
+        ConditionVariable condition { mutex };
+        size_t remaining { 0 };
+    } tasks;
+    tasks.remaining = task_count;
+
+    auto finish_task = [&tasks] {
+        MutexLocker locker(tasks.mutex);
+        if (--tasks.remaining == 0)
+            tasks.condition.broadcast();
+    };
+
+    for (size_t i = 1; i < task_count; ++i) {
+        push([&task, &finish_task, i] {
+            task(i);
+            finish_task();
+        },
+            priority);
+    }
+
+    task(0);
+    finish_task();
+
+    // Rather than sitting idle, work on whatever is pending until our own tasks are done. Tasks we pushed onto our own
+    // queue are found first, since that is where a worker looks first.
+    auto worker_index = current_worker_index();
+    while (true) {
+        {
+            MutexLocker locker(tasks.mutex);
+            if (tasks.remaining == 0)
+                return;
+        }
+        auto work = take_work(worker_index);
+        if (!work)
+            break;
+        work();
+    }
+
+    // Whatever is left is already running on other threads.
+    MutexLocker locker(tasks.mutex);
+    tasks.condition.wait_while([&] { return tasks.remaining > 0; });
+}
+
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/Function.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
+#include <LibCore/EventLoop.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+
+namespace Threading {
+
+// A fixed number of threads running work concurrently, with higher priority work going first.
+// Work enqueued from outside the pool starts in the order it was enqueued. Work enqueued from one of the pool's own
+// threads goes to that thread's own queue, which it works through newest first while idle threads steal the oldest
+// work from it. This keeps work that splits itself up (like parallel_for() does) on the cores whose caches are warm.
+// Unlike the single background thread that BackgroundAction uses by default, work here can run concurrently,
+// so whatever it touches has to be safe to use from several threads at once.
+class ThreadPool {
+    AK_MAKE_NONCOPYABLE(ThreadPool);
+    AK_MAKE_NONMOVABLE(ThreadPool);
+
+public:
+    enum class Priority {
+        High,
+        Normal,
+        Low,
+    };
+    static constexpr size_t priority_count = 3;
+
+    static ErrorOr<NonnullOwnPtr<ThreadPool>> create(StringView name, size_t thread_count);
+
+    // A pool with one thread per CPU core, shared by everything in the process. It is created on first use and lives
+    // until the process exits.
+    static ThreadPool& the();
+
+    // Waits for the work that is already running to finish. Work that hasn't started yet is dropped.
+    ~ThreadPool();
+
+    void enqueue(ESCAPING Function<void()>, Priority = Priority::Normal);
+
+    // Runs the work on the pool, then hands its result to on_complete on the event loop of the calling thread.
+    // That event loop has to outlive the work.
+    template<typename Work, typename OnComplete>
+    void enqueue_with_completion(Work&& work, OnComplete&& on_complete, Priority priority = Priority::Normal)
+    {
+        enqueue([work = forward<Work>(work), on_complete = forward<OnComplete>(on_complete), origin_event_loop = &Core::EventLoop::current()]() mutable {
+            origin_event_loop->deferred_invoke([on_complete = move(on_complete), result = work()]() mutable {
+                on_complete(move(result));
+            });
+            origin_event_loop->wake();
+        },
+            priority);
+    }
+
+    // Calls the callback for every index in [begin, end) and returns once all of those calls have returned.
+    // Indices are handed out in chunks of at least grain_size, so that each piece of work is worth the overhead
+    // of scheduling it. The calling thread works on chunks too, so this may also be used by work on the pool itself.
+    template<typename Callback>
+    void parallel_for(size_t begin, size_t end, Callback&& callback, size_t grain_size = 1, Priority priority = Priority::Normal)
+    {
+        if (begin >= end)
+            return;
+
+        auto count = end - begin;
+        auto chunk_count = min(max<size_t>(count / max<size_t>(grain_size, 1), 1), 4 * thread_count());
+        auto chunk_size = ceil_div(count, chunk_count);
+        chunk_count = ceil_div(count, chunk_size);
+
+        run_and_wait(
+            chunk_count, [&](size_t chunk) {
+                auto chunk_begin = begin + chunk * chunk_size;
+                auto chunk_end = min(chunk_begin + chunk_size, end);
+                for (auto index = chunk_begin; index < chunk_end; ++index)
+                    callback(index);
+            },
+            priority);
+    }
+
+    // Calls every callback, some of them concurrently, and returns once all of them have returned.
+    template<typename... Callbacks>
+    void parallel_invoke(Callbacks&&... callbacks)
+    {
+        run_and_wait(
+            sizeof...(Callbacks), [&](size_t index) {
+                size_t callback_index = 0;
+                ((callback_index++ == index ? (void)callbacks() : (void)0), ...);
+            },
+            Priority::Normal);
+    }
+
+    size_t thread_count() const { return m_workers.size(); }
+
+private:
+    struct WorkQueue {
+        bool is_empty() const { return m_head == m_work.size(); }
+        void push(Function<void()>);
+        Function<void()> take_newest();
+        Function<void()> take_oldest();
+
+    private:
+        void reset_if_empty();
+
+        Vector<Function<void()>> m_work;
+        size_t m_head { 0 };
+    };
+
+    struct Worker {
+        Mutex mutex;
+        Array<WorkQueue, priority_count> queues;
+        RefPtr<Thread> thread;
+    };
+
+    ThreadPool() = default;
+
+    intptr_t run(size_t worker_index);
+
+    void push(Function<void()>, Priority);
+    Function<void()> take_work(Optional<size_t> worker_index);
+    Optional<size_t> current_worker_index() const;
+
+    // Runs task(0) to task(task_count - 1) and waits for all of them, helping out with other work in the meantime.
+    void run_and_wait(size_t task_count, Function<void(size_t)> const& task, Priority);
+
+    Vector<NonnullOwnPtr<Worker>> m_workers;
+
+    // Work enqueued from threads outside the pool.
+    Mutex m_shared_queues_mutex;
+    Array<WorkQueue, priority_count> m_shared_queues;
+
+    bool has_pending_work() const;
+
+    // How much work of each priority is waiting in any of the queues, so that finding work doesn't mean locking them all.
+    Array<Atomic<size_t>, priority_count> m_pending_work_count {};
+    Atomic<size_t> m_sleeping_thread_count { 0 };
+    Atomic<bool> m_should_stop { false };
+    Mutex m_sleep_mutex;
+    ConditionVariable m_wake_condition { m_sleep_mutex };
+};
+
+}
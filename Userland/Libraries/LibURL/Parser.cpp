@@ -5,11 +5,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
 #include <AK/ByteString.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/IntegralMath.h>
 #include <AK/Optional.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/SourceLocation.h>
 #include <AK/StringBuilder.h>
 #include <AK/StringUtils.h>
@@ -816,11 +819,142 @@ String Parser::percent_encode_after_encoding(TextCodec::Encoder& encoder, String
     return MUST(output.to_string());
 }
 
+// Returns whether input only consists of the code points U+0021 (!) to U+007E (~), so that it has nothing to trim or remove,
+// nothing to decode, and nothing the C0 control percent-encode set would encode.
+static bool is_printable_ascii(StringView input)
+{
+    using namespace AK::SIMD;
+
+    auto const* characters = reinterpret_cast<u8 const*>(input.characters_without_null_termination());
+    size_t i = 0;
+    for (; i + sizeof(u8x16) <= input.length(); i += sizeof(u8x16)) {
+        // NOTE: Subtracting 0x21 wraps the bytes below the range around to the top, so one comparison catches both sides.
+        auto bytes = load_unaligned<u8x16>(characters + i);
+        auto is_outside_range = bit_cast<u64x2>((bytes - 0x21) > (0x7E - 0x21));
+        if ((is_outside_range[0] | is_outside_range[1]) != 0)
+            return false;
+    }
+
+    for (; i < input.length(); ++i) {
+        if (characters[i] < 0x21 || characters[i] > 0x7E)
+            return false;
+    }
+    return true;
+}
+
+// Parses URLs like "https://example.com:8080/a/b?c#d" that have a special scheme other than "file", and are already in
+// the form the basic URL parser would serialize them to, by slicing the input into its components.
+// Returns an empty Optional for anything else (including invalid URLs), which has to go through the state machine.
+Optional<URL> Parser::parse_normalized_special_url(StringView input)
+{
+    if (!is_printable_ascii(input))
+        return {};
+
+    // The scheme has to be lowercase, and followed by exactly two slashes.
+    auto scheme_end = input.find("://"sv);
+    if (!scheme_end.has_value())
+        return {};
+    auto scheme = input.substring_view(0, *scheme_end);
+    if (!is_special_scheme(scheme) || scheme == "file"sv)
+        return {};
+
+    auto remaining = input.substring_view(*scheme_end + 3);
+    auto authority_end = remaining.find_any_of("/?#"sv).value_or(remaining.length());
+    auto authority = remaining.substring_view(0, authority_end);
+    remaining = remaining.substring_view(authority_end);
+
+    // The host has to be a non-empty lowercase ASCII domain: no credentials, no IPv6 address or percent-encoded code
+    // points, and no labels that the IDNA processing or the IPv4 parser would have to look at.
+    auto host = authority;
+    Optional<StringView> port_string;
+    if (auto port_start = authority.find(':'); port_start.has_value()) {
+        host = authority.substring_view(0, *port_start);
+        port_string = authority.substring_view(*port_start + 1);
+    }
+
+    if (host.is_empty())
+        return {};
+    for (auto character : host) {
+        if (!is_ascii_lower_alpha(character) && !is_ascii_digit(character) && character != '.' && character != '-' && character != '_')
+            return {};
+    }
+    for (auto label : host.split_view('.')) {
+        if (label.starts_with("xn--"sv))
+            return {};
+    }
+    if (ends_in_a_number_checker(host))
+        return {};
+
+    Optional<u16> port;
+    if (port_string.has_value() && !port_string->is_empty()) {
+        if (port_string->length() > 5 || !all_of(*port_string, is_ascii_digit))
+            return {};
+        auto port_number = port_string->to_number<u32>();
+        if (!port_number.has_value() || *port_number > NumericLimits<u16>::max())
+            return {};
+        if (auto default_port = default_port_for_scheme(scheme); !default_port.has_value() || *default_port != *port_number)
+            port = static_cast<u16>(*port_number);
+    }
+
+    Optional<StringView> fragment;
+    if (auto fragment_start = remaining.find('#'); fragment_start.has_value()) {
+        fragment = remaining.substring_view(*fragment_start + 1);
+        remaining = remaining.substring_view(0, *fragment_start);
+    }
+
+    Optional<StringView> query;
+    if (auto query_start = remaining.find('?'); query_start.has_value()) {
+        query = remaining.substring_view(*query_start + 1);
+        remaining = remaining.substring_view(0, *query_start);
+    }
+
+    // Nothing may need to be percent-encoded, and there may be no backslashes or dot segments in the path.
+    auto path = remaining;
+    for (auto character : path) {
+        if (code_point_is_in_percent_encode_set(character, PercentEncodeSet::Path) || character == '\\')
+            return {};
+    }
+    if (query.has_value() && any_of(*query, [](auto character) { return code_point_is_in_percent_encode_set(character, PercentEncodeSet::SpecialQuery); }))
+        return {};
+    if (fragment.has_value() && any_of(*fragment, [](auto character) { return code_point_is_in_percent_encode_set(character, PercentEncodeSet::Fragment); }))
+        return {};
+
+    // NOTE: A special URL with an empty path gets a single empty path segment, just like one with a path of "/".
+    Vector<StringView> path_segments { ""sv };
+    if (path.length() > 1)
+        path_segments = path.substring_view(1).split_view('/', SplitBehavior::KeepEmpty);
+    for (auto segment : path_segments) {
+        if (is_single_dot_path_segment(segment) || is_double_dot_path_segment(segment))
+            return {};
+    }
+
+    URL url;
+    url.m_data->scheme = String::from_utf8_without_validation(scheme.bytes());
+    url.m_data->host = String::from_utf8_without_validation(host.bytes());
+    url.m_data->port = port;
+    url.m_data->paths.ensure_capacity(path_segments.size());
+    for (auto segment : path_segments)
+        url.m_data->paths.unchecked_append(String::from_utf8_without_validation(segment.bytes()));
+    if (query.has_value())
+        url.m_data->query = String::from_utf8_without_validation(query->bytes());
+    if (fragment.has_value())
+        url.m_data->fragment = String::from_utf8_without_validation(fragment->bytes());
+    url.m_data->valid = true;
+    return url;
+}
+
 // https://url.spec.whatwg.org/#concept-basic-url-parser
 URL Parser::basic_parse(StringView raw_input, Optional<URL> const& base_url, URL* url, Optional<State> state_override, Optional<StringView> encoding)
 {
     dbgln_if(URL_PARSER_DEBUG, "URL::Parser::basic_parse: Parsing '{}'", raw_input);
 
+    // OPTIMIZATION: Most URLs are absolute URLs that are already normalized, for which the state machine below would do
+    //               nothing but copy each component over one code point at a time.
+    if (!url && !state_override.has_value()) {
+        if (auto normalized_url = parse_normalized_special_url(raw_input); normalized_url.has_value())
+            return normalized_url.release_value();
+    }
+
     size_t start_index = 0;
     size_t end_index = raw_input.length();
 
@@ -68,6 +68,9 @@ public:
 
     // https://url.spec.whatwg.org/#shorten-a-urls-path
     static void shorten_urls_path(URL&);
+
+private:
+    static Optional<URL> parse_normalized_special_url(StringView input);
 };
 
 #undef ENUMERATE_STATES
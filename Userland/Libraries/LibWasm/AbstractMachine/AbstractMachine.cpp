@@ -76,14 +76,6 @@ Optional<ElementAddress> Store::allocate(ValueType const& type, Vector<Reference
     return address;
 }
 
-FunctionInstance* Store::get(FunctionAddress address)
-{
-    auto value = address.value();
-    if (m_functions.size() <= value)
-        return nullptr;
-    return &m_functions[value];
-}
-
 Module const* Store::get_module_for(Wasm::FunctionAddress address)
 {
     auto* function = get(address);
@@ -92,46 +84,6 @@ Module const* Store::get_module_for(Wasm::FunctionAddress address)
     return function->get<WasmFunction>().module_ref().ptr();
 }
 
-TableInstance* Store::get(TableAddress address)
-{
-    auto value = address.value();
-    if (m_tables.size() <= value)
-        return nullptr;
-    return &m_tables[value];
-}
-
-MemoryInstance* Store::get(MemoryAddress address)
-{
-    auto value = address.value();
-    if (m_memories.size() <= value)
-        return nullptr;
-    return &m_memories[value];
-}
-
-GlobalInstance* Store::get(GlobalAddress address)
-{
-    auto value = address.value();
-    if (m_globals.size() <= value)
-        return nullptr;
-    return &m_globals[value];
-}
-
-ElementInstance* Store::get(ElementAddress address)
-{
-    auto value = address.value();
-    if (m_elements.size() <= value)
-        return nullptr;
-    return &m_elements[value];
-}
-
-DataInstance* Store::get(DataAddress address)
-{
-    auto value = address.value();
-    if (m_datas.size() <= value)
-        return nullptr;
-    return &m_datas[value];
-}
-
 ErrorOr<void, ValidationError> AbstractMachine::validate(Module& module)
 {
     if (module.validation_status() != Module::ValidationStatus::Unchecked) {
@@ -147,6 +99,9 @@ ErrorOr<void, ValidationError> AbstractMachine::validate(Module& module)
         return result.release_error();
     }
 
+    for (auto& code : module.code_section().functions())
+        BytecodeInterpreter::compile_to_synthetic_instructions(code.func().body());
+
     return {};
 }
 InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<ExternValue> externs)
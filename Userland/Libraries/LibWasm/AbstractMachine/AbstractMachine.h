@@ -454,13 +454,24 @@ public:
             return true;
         u64 new_size = m_data.size() + size_to_grow;
         // Can't grow past 2^16 pages.
-        if (new_size >= Constants::page_size * 65536)
+        if (new_size >= Constants::page_size * Constants::max_memory_pages)
             return false;
         if (auto max = m_type.limits().max(); max.has_value()) {
             if (max.value() * Constants::page_size < new_size)
                 return false;
         }
         auto previous_size = m_size;
+
+        // NOTE: Growing past the buffer's capacity copies all of the memory over, so the capacity is at least doubled
+        //       each time, up to the largest size the memory may grow to. Should that fail, only the new size is tried.
+        if (new_size > m_data.capacity()) {
+            u64 max_size = Constants::page_size * Constants::max_memory_pages;
+            if (auto max = m_type.limits().max(); max.has_value())
+                max_size = min(max_size, max.value() * Constants::page_size);
+            u64 new_capacity = clamp(static_cast<u64>(m_data.capacity()) * 2, new_size, max_size);
+            (void)m_data.try_ensure_capacity(new_capacity);
+        }
+
         if (m_data.try_resize(new_size).is_error())
             return false;
         m_size = new_size;
@@ -565,14 +576,23 @@ public:
     Optional<ElementAddress> allocate(ValueType const&, Vector<Reference>);
 
     Module const* get_module_for(FunctionAddress);
-    FunctionInstance* get(FunctionAddress);
-    TableInstance* get(TableAddress);
-    MemoryInstance* get(MemoryAddress);
-    GlobalInstance* get(GlobalAddress);
-    DataInstance* get(DataAddress);
-    ElementInstance* get(ElementAddress);
+    // These are looked up by every memory, table and global access, so keep them inline.
+    FunctionInstance* get(FunctionAddress address) { return get_from(m_functions, address.value()); }
+    TableInstance* get(TableAddress address) { return get_from(m_tables, address.value()); }
+    MemoryInstance* get(MemoryAddress address) { return get_from(m_memories, address.value()); }
+    GlobalInstance* get(GlobalAddress address) { return get_from(m_globals, address.value()); }
+    DataInstance* get(DataAddress address) { return get_from(m_datas, address.value()); }
+    ElementInstance* get(ElementAddress address) { return get_from(m_elements, address.value()); }
 
 private:
+    template<typename T>
+    static ALWAYS_INLINE T* get_from(Vector<T>& instances, size_t index)
+    {
+        if (index >= instances.size()) [[unlikely]]
+            return nullptr;
+        return &instances.data()[index];
+    }
+
     Vector<FunctionInstance> m_functions;
     Vector<TableInstance> m_tables;
     Vector<MemoryInstance> m_memories;
@@ -633,7 +653,8 @@ public:
     explicit AbstractMachine() = default;
 
     // Validate a module; permanently sets the module's validity status.
-    ErrorOr<void, ValidationError> validate(Module&);
+    // This doesn't touch the machine's state, so it can be done on any thread.
+    static ErrorOr<void, ValidationError> validate(Module&);
     // Load and instantiate a module, and link it into this interpreter.
     InstantiationResult instantiate(Module const&, Vector<ExternValue>);
     Result invoke(FunctionAddress, Vector<Value>);
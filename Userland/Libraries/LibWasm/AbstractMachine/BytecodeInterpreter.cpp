@@ -33,14 +33,21 @@ namespace Wasm {
 void BytecodeInterpreter::interpret(Configuration& configuration)
 {
     m_trap = Empty {};
+    if (configuration.should_limit_instruction_count())
+        return interpret_impl<true>(configuration);
+    return interpret_impl<false>(configuration);
+}
+
+template<bool should_limit_instruction_count>
+void BytecodeInterpreter::interpret_impl(Configuration& configuration)
+{
     auto& instructions = configuration.frame().expression().instructions();
     auto max_ip_value = InstructionPointer { instructions.size() };
     auto& current_ip_value = configuration.ip();
-    auto const should_limit_instruction_count = configuration.should_limit_instruction_count();
     u64 executed_instructions = 0;
 
     while (current_ip_value < max_ip_value) {
-        if (should_limit_instruction_count) {
+        if constexpr (should_limit_instruction_count) {
             if (executed_instructions++ >= Constants::max_allowed_executed_instructions_per_call) [[unlikely]] {
                 m_trap = Trap { "Exceeded maximum allowed number of instructions" };
                 return;
@@ -49,13 +56,71 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
         auto& instruction = instructions[current_ip_value.value()];
         auto old_ip = current_ip_value;
         interpret_instruction(configuration, current_ip_value, instruction);
-        if (did_trap())
+        if (did_trap()) [[unlikely]]
             return;
         if (current_ip_value == old_ip) // If no jump occurred
             ++current_ip_value;
     }
 }
 
+void BytecodeInterpreter::compile_to_synthetic_instructions(Expression& expression)
+{
+    auto& instructions = expression.instructions();
+
+    auto is = [&](size_t index, OpCode opcode) {
+        return index < instructions.size() && instructions[index].opcode() == opcode;
+    };
+    auto local_index_at = [&](size_t index) { return instructions[index].arguments().get<LocalIndex>(); };
+    auto i32_at = [&](size_t index) { return instructions[index].arguments().get<i32>(); };
+
+    // Branches name their targets by label, so only the instruction pointers in structured instructions need to be
+    // remapped. Those always point at or just past a block, loop, if, else or end, none of which are ever folded into
+    // a synthetic instruction, so no target can end up in the middle of one.
+    Vector<Instruction> compiled_instructions;
+    compiled_instructions.ensure_capacity(instructions.size());
+    Vector<InstructionPointer> compiled_ips;
+    compiled_ips.resize(instructions.size() + 1);
+
+    for (size_t i = 0; i < instructions.size();) {
+        Optional<Instruction> synthetic_instruction;
+        size_t folded_instruction_count = 1;
+
+        if (is(i, Instructions::local_get) && is(i + 1, Instructions::local_get) && is(i + 2, Instructions::i32_add)) {
+            synthetic_instruction = Instruction(Instructions::synthetic_i32_add2local, Instruction::LocalPairArgs { local_index_at(i), local_index_at(i + 1) });
+            folded_instruction_count = 3;
+        } else if (is(i, Instructions::local_get) && is(i + 1, Instructions::i32_const) && is(i + 2, Instructions::i32_add)) {
+            synthetic_instruction = Instruction(Instructions::synthetic_i32_addconstlocal, Instruction::LocalAndConstArgs { local_index_at(i), i32_at(i + 1) });
+            folded_instruction_count = 3;
+        } else if (is(i, Instructions::local_get) && is(i + 1, Instructions::i32_const) && is(i + 2, Instructions::i32_and)) {
+            synthetic_instruction = Instruction(Instructions::synthetic_i32_andconstlocal, Instruction::LocalAndConstArgs { local_index_at(i), i32_at(i + 1) });
+            folded_instruction_count = 3;
+        } else if (is(i, Instructions::i32_const) && is(i + 1, Instructions::local_set)) {
+            synthetic_instruction = Instruction(Instructions::synthetic_local_seti32_const, Instruction::LocalAndConstArgs { local_index_at(i + 1), i32_at(i) });
+            folded_instruction_count = 2;
+        } else if (is(i, Instructions::local_get) && is(i + 1, Instructions::local_set)) {
+            synthetic_instruction = Instruction(Instructions::synthetic_local_copy, Instruction::LocalPairArgs { local_index_at(i), local_index_at(i + 1) });
+            folded_instruction_count = 2;
+        }
+
+        for (size_t j = 0; j < folded_instruction_count; ++j)
+            compiled_ips[i + j] = compiled_instructions.size();
+        compiled_instructions.append(synthetic_instruction.has_value() ? synthetic_instruction.release_value() : move(instructions[i]));
+        i += folded_instruction_count;
+    }
+    compiled_ips[instructions.size()] = compiled_instructions.size();
+
+    for (auto& instruction : compiled_instructions) {
+        auto* args = instruction.arguments().get_pointer<Instruction::StructuredInstructionArgs>();
+        if (!args)
+            continue;
+        args->end_ip = compiled_ips[args->end_ip.value()];
+        if (args->else_ip.has_value())
+            args->else_ip = compiled_ips[args->else_ip->value()];
+    }
+
+    instructions = move(compiled_instructions);
+}
+
 void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelIndex index)
 {
     dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}...", index.value());
@@ -83,8 +148,7 @@ void BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
-    auto slice = memory->data().bytes().slice(instance_address, sizeof(ReadType));
-    entry = Value(static_cast<PushType>(read_value<ReadType>(slice)));
+    entry = Value(static_cast<PushType>(read_value<ReadType>({ memory->data().data() + instance_address, sizeof(ReadType) })));
 }
 
 template<typename TDst, typename TSrc>
@@ -357,50 +421,37 @@ void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruct
 {
     auto& address = configuration.frame().module().memories()[arg.memory_index.value()];
     auto memory = configuration.store().get(address);
+    // Both the base and the offset are 32-bit, so this can't overflow.
     u64 instance_address = static_cast<u64>(base) + arg.offset;
-    Checked addition { instance_address };
-    addition += data.size();
-    if (addition.has_overflow() || addition.value() > memory->size()) {
+    if (instance_address + data.size() > memory->size()) [[unlikely]] {
         m_trap = Trap { "Memory access out of bounds" };
         dbgln("LibWasm: Memory access out of bounds (expected 0 <= {} and {} <= {})", instance_address, instance_address + data.size(), memory->size());
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "temporary({}b) -> store({})", data.size(), instance_address);
-    data.copy_to(memory->data().bytes().slice(instance_address, data.size()));
+    memcpy(memory->data().data() + instance_address, data.data(), data.size());
 }
 
+// The callers have already checked that the data is large enough, so this can read it directly.
 template<typename T>
 T BytecodeInterpreter::read_value(ReadonlyBytes data)
 {
-    FixedMemoryStream stream { data };
-    auto value_or_error = stream.read_value<LittleEndian<T>>();
-    if (value_or_error.is_error()) {
-        dbgln("Read from {} failed", data.data());
-        m_trap = Trap { "Read from memory failed" };
-    }
-    return value_or_error.release_value();
+    VERIFY(data.size() >= sizeof(T));
+    LittleEndian<T> value;
+    memcpy(&value, data.data(), sizeof(T));
+    return value;
 }
 
 template<>
 float BytecodeInterpreter::read_value<float>(ReadonlyBytes data)
 {
-    FixedMemoryStream stream { data };
-    auto raw_value_or_error = stream.read_value<LittleEndian<u32>>();
-    if (raw_value_or_error.is_error())
-        m_trap = Trap { "Read from memory failed" };
-    auto raw_value = raw_value_or_error.release_value();
-    return bit_cast<float>(static_cast<u32>(raw_value));
+    return bit_cast<float>(read_value<u32>(data));
 }
 
 template<>
 double BytecodeInterpreter::read_value<double>(ReadonlyBytes data)
 {
-    FixedMemoryStream stream { data };
-    auto raw_value_or_error = stream.read_value<LittleEndian<u64>>();
-    if (raw_value_or_error.is_error())
-        m_trap = Trap { "Read from memory failed" };
-    auto raw_value = raw_value_or_error.release_value();
-    return bit_cast<double>(static_cast<u64>(raw_value));
+    return bit_cast<double>(read_value<u64>(data));
 }
 
 ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
@@ -421,6 +472,35 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
         configuration.frame().locals()[instruction.arguments().get<LocalIndex>().value()] = value;
         return;
     }
+    case Instructions::synthetic_i32_add2local.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalPairArgs>();
+        auto& locals = configuration.frame().locals();
+        configuration.value_stack().append(Value(locals[args.lhs.value()].to<u32>() + locals[args.rhs.value()].to<u32>()));
+        return;
+    }
+    case Instructions::synthetic_i32_addconstlocal.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalAndConstArgs>();
+        auto& locals = configuration.frame().locals();
+        configuration.value_stack().append(Value(locals[args.local_index.value()].to<u32>() + static_cast<u32>(args.value)));
+        return;
+    }
+    case Instructions::synthetic_i32_andconstlocal.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalAndConstArgs>();
+        auto& locals = configuration.frame().locals();
+        configuration.value_stack().append(Value(locals[args.local_index.value()].to<i32>() & args.value));
+        return;
+    }
+    case Instructions::synthetic_local_seti32_const.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalAndConstArgs>();
+        configuration.frame().locals()[args.local_index.value()] = Value(args.value);
+        return;
+    }
+    case Instructions::synthetic_local_copy.value(): {
+        auto& args = instruction.arguments().get<Instruction::LocalPairArgs>();
+        auto& locals = configuration.frame().locals();
+        locals[args.rhs.value()] = locals[args.lhs.value()];
+        return;
+    }
     case Instructions::i32_const.value():
         configuration.value_stack().append(Value(instruction.arguments().get<i32>()));
         return;
@@ -652,14 +732,12 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
         u8 value = static_cast<u8>(configuration.value_stack().take_last().to<u32>());
         auto destination_offset = configuration.value_stack().take_last().to<u32>();
 
-        TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= instance->data().size());
+        TRAP_IF_NOT(static_cast<size_t>(destination_offset) + count <= instance->data().size());
 
         if (count == 0)
             return;
 
-        for (u32 i = 0; i < count; ++i)
-            store_to_memory(configuration, Instruction::MemoryArgument { 0, 0 }, { &value, sizeof(value) }, destination_offset + i);
-
+        instance->data().bytes().slice(destination_offset, count).fill(value);
         return;
     }
     // https://webassembly.github.io/spec/core/bikeshed/#exec-memory-copy
@@ -670,33 +748,18 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
         auto source_instance = configuration.store().get(source_address);
         auto destination_instance = configuration.store().get(destination_address);
 
-        auto count = configuration.value_stack().take_last().to<i32>();
-        auto source_offset = configuration.value_stack().take_last().to<i32>();
-        auto destination_offset = configuration.value_stack().take_last().to<i32>();
+        auto count = configuration.value_stack().take_last().to<u32>();
+        auto source_offset = configuration.value_stack().take_last().to<u32>();
+        auto destination_offset = configuration.value_stack().take_last().to<u32>();
 
-        Checked<size_t> source_position = source_offset;
-        source_position.saturating_add(count);
-        Checked<size_t> destination_position = destination_offset;
-        destination_position.saturating_add(count);
-        TRAP_IF_NOT(source_position <= source_instance->data().size());
-        TRAP_IF_NOT(destination_position <= destination_instance->data().size());
+        TRAP_IF_NOT(static_cast<size_t>(source_offset) + count <= source_instance->data().size());
+        TRAP_IF_NOT(static_cast<size_t>(destination_offset) + count <= destination_instance->data().size());
 
         if (count == 0)
             return;
 
-        Instruction::MemoryArgument memarg { 0, 0, args.dst_index };
-        if (destination_offset <= source_offset) {
-            for (auto i = 0; i < count; ++i) {
-                auto value = source_instance->data()[source_offset + i];
-                store_to_memory(configuration, memarg, { &value, sizeof(value) }, destination_offset + i);
-            }
-        } else {
-            for (auto i = count - 1; i >= 0; --i) {
-                auto value = source_instance->data()[source_offset + i];
-                store_to_memory(configuration, memarg, { &value, sizeof(value) }, destination_offset + i);
-            }
-        }
-
+        // The ranges may overlap, for which memmove does the right thing.
+        memmove(destination_instance->data().data() + destination_offset, source_instance->data().data() + source_offset, count);
         return;
     }
     // https://webassembly.github.io/spec/core/bikeshed/#exec-memory-init
@@ -720,11 +783,7 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
         if (count == 0)
             return;
 
-        Instruction::MemoryArgument memarg { 0, 0, args.memory_index };
-        for (size_t i = 0; i < (size_t)count; ++i) {
-            auto value = data.data()[source_offset + i];
-            store_to_memory(configuration, memarg, { &value, sizeof(value) }, destination_offset + i);
-        }
+        data.data().span().slice(source_offset, count).copy_to(memory->data().bytes().slice(destination_offset, count));
         return;
     }
     // https://webassembly.github.io/spec/core/bikeshed/#exec-data-drop
@@ -20,6 +20,9 @@ struct BytecodeInterpreter : public Interpreter {
 
     virtual void interpret(Configuration&) final;
 
+    // Rewrites a validated function body to use the synthetic instructions from Opcode.h where possible.
+    static void compile_to_synthetic_instructions(Expression&);
+
     virtual ~BytecodeInterpreter() override = default;
     virtual bool did_trap() const final { return !m_trap.has<Empty>(); }
     virtual ByteString trap_reason() const final
@@ -45,6 +48,8 @@ struct BytecodeInterpreter : public Interpreter {
     };
 
 protected:
+    template<bool should_limit_instruction_count>
+    void interpret_impl(Configuration&);
     void interpret_instruction(Configuration&, InstructionPointer&, Instruction const&);
     void branch_to_label(Configuration&, LabelIndex);
     template<typename ReadT, typename PushT>
@@ -160,6 +160,21 @@ struct BitRotateRight {
     static StringView name() { return "rotate_right"sv; }
 };
 
+// These operators map directly onto the native vector operations, which apply them to all lanes at once.
+template<typename Op>
+constexpr bool is_lanewise_comparison = IsOneOf<Op, Equals, NotEquals, GreaterThan, LessThan, LessThanOrEquals, GreaterThanOrEquals>;
+
+template<typename Op>
+constexpr bool is_lanewise_wrapping_arithmetic = IsOneOf<Op, Add, Subtract, Multiply>;
+
+// Picks the lanes of if_true where the mask (as produced by a vector comparison) is set, and those of if_false elsewhere.
+template<SIMDVector VectorType, SIMDVector MaskType>
+ALWAYS_INLINE static VectorType select_lanes(MaskType mask, VectorType if_true, VectorType if_false)
+{
+    static_assert(sizeof(MaskType) == sizeof(VectorType));
+    return bit_cast<VectorType>((bit_cast<MaskType>(if_true) & mask) | (bit_cast<MaskType>(if_false) & ~mask));
+}
+
 template<size_t VectorSize, template<typename> typename SetSign = MakeSigned>
 struct VectorAllTrue {
     auto operator()(u128 c) const
@@ -334,6 +349,11 @@ template<size_t VectorSize, typename Op, template<typename> typename SetSign = M
 struct VectorCmpOp {
     auto operator()(u128 c1, u128 c2) const
     {
+        if constexpr (is_lanewise_comparison<Op>) {
+            using VectorType = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
+            return bit_cast<u128>(Op {}(bit_cast<VectorType>(c1), bit_cast<VectorType>(c2)));
+        }
+
         using ElementType = NativeIntegralType<128 / VectorSize>;
         auto result = bit_cast<Native128ByteVectorOf<ElementType, SetSign>>(c1);
         auto other = bit_cast<Native128ByteVectorOf<ElementType, SetSign>>(c2);
@@ -369,6 +389,9 @@ struct VectorFloatCmpOp {
     {
         auto first = bit_cast<NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>>(c1);
         auto other = bit_cast<NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>>(c2);
+        if constexpr (is_lanewise_comparison<Op>)
+            return bit_cast<u128>(Op {}(first, other));
+
         using ElementType = NativeIntegralType<128 / VectorSize>;
         Native128ByteVectorOf<ElementType, MakeUnsigned> result;
         Op op;
@@ -610,20 +633,12 @@ struct VectorIntegerExt {
     {
         using VectorResult = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
         using VectorInput = NativeVectorType<128 / (VectorSize * 2), VectorSize * 2, SetSign>;
-        auto vector = bit_cast<VectorInput>(c);
-        VectorResult result;
-
-        // FIXME: Find a way to not loop here
-        for (size_t i = 0; i < VectorSize; ++i) {
-            if constexpr (Mode == VectorExt::High)
-                result[i] = vector[VectorSize + i];
-            else if constexpr (Mode == VectorExt::Low)
-                result[i] = vector[i];
-            else
-                VERIFY_NOT_REACHED();
-        }
+        using HalfInput = NativeVectorType<128 / (VectorSize * 2), VectorSize, SetSign>;
+        static_assert(sizeof(VectorInput) == 2 * sizeof(HalfInput));
 
-        return bit_cast<u128>(result);
+        constexpr size_t half_index = Mode == VectorExt::High ? 1 : 0;
+        auto half = bit_cast<HalfInput>(bit_cast<u64x2>(c)[half_index]);
+        return bit_cast<u128>(__builtin_convertvector(half, VectorResult));
     }
 
     static StringView name()
@@ -647,13 +662,21 @@ struct VectorIntegerExtOp {
     {
         using VectorResult = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
         using VectorInput = NativeVectorType<128 / (VectorSize * 2), VectorSize * 2, SetSign>;
+        if constexpr (IsSame<Op, Multiply>) {
+            // NOTE: The products of the widened lanes always fit, so they can't overflow.
+            using HalfInput = NativeVectorType<128 / (VectorSize * 2), VectorSize, SetSign>;
+            constexpr size_t half_index = Mode == VectorExt::High ? 1 : 0;
+            auto first = __builtin_convertvector(bit_cast<HalfInput>(bit_cast<u64x2>(lhs)[half_index]), VectorResult);
+            auto second = __builtin_convertvector(bit_cast<HalfInput>(bit_cast<u64x2>(rhs)[half_index]), VectorResult);
+            return bit_cast<u128>(first * second);
+        }
+
         auto first = bit_cast<VectorInput>(lhs);
         auto second = bit_cast<VectorInput>(rhs);
         VectorResult result;
         Op op;
 
         using ResultType = SetSign<NativeIntegralType<128 / VectorSize>>;
-        // FIXME: Find a way to not loop here
         for (size_t i = 0; i < VectorSize; ++i) {
             if constexpr (Mode == VectorExt::High) {
                 ResultType a = first[VectorSize + i];
@@ -689,13 +712,26 @@ template<size_t VectorSize, typename Op, template<typename> typename SetSign = M
 struct VectorIntegerBinaryOp {
     auto operator()(u128 lhs, u128 rhs) const
     {
+        using ElementType = SetSign<NativeIntegralType<128 / VectorSize>>;
         using VectorType = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
+        using UnsignedVectorType = NativeVectorType<128 / VectorSize, VectorSize, MakeUnsigned>;
         auto first = bit_cast<VectorType>(lhs);
         auto second = bit_cast<VectorType>(rhs);
+
+        if constexpr (is_lanewise_wrapping_arithmetic<Op>) {
+            // NOTE: Signed overflow is undefined, so wrap around in the unsigned domain.
+            return bit_cast<u128>(Op {}(bit_cast<UnsignedVectorType>(first), bit_cast<UnsignedVectorType>(second)));
+        } else if constexpr (IsSame<Op, Minimum>) {
+            return bit_cast<u128>(select_lanes(first < second, first, second));
+        } else if constexpr (IsSame<Op, Maximum>) {
+            return bit_cast<u128>(select_lanes(first < second, second, first));
+        } else if constexpr (IsSame<Op, Average> && IsUnsigned<ElementType>) {
+            // NOTE: This is (a + b + 1) / 2, without overflowing the lanes.
+            return bit_cast<u128>((first | second) - ((first ^ second) >> 1));
+        }
+
         VectorType result;
         Op op;
-
-        // FIXME: Find a way to not loop here
         for (size_t i = 0; i < VectorSize; ++i) {
             result[i] = op(first[i], second[i]);
         }
@@ -797,12 +833,21 @@ template<size_t VectorSize, typename Op, template<typename> typename SetSign = M
 struct VectorIntegerUnaryOp {
     auto operator()(u128 lhs) const
     {
+        using ElementType = SetSign<NativeIntegralType<128 / VectorSize>>;
         using VectorType = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
+        using UnsignedVectorType = NativeVectorType<128 / VectorSize, VectorSize, MakeUnsigned>;
         auto value = bit_cast<VectorType>(lhs);
+
+        // NOTE: Negating the most negative value wraps around to itself, so negate in the unsigned domain.
+        if constexpr (IsSame<Op, Negate>) {
+            return bit_cast<u128>(UnsignedVectorType {} - bit_cast<UnsignedVectorType>(value));
+        } else if constexpr (IsSame<Op, Absolute> && IsSigned<ElementType>) {
+            auto negated = bit_cast<VectorType>(UnsignedVectorType {} - bit_cast<UnsignedVectorType>(value));
+            return bit_cast<u128>(select_lanes(value < 0, negated, value));
+        }
+
         VectorType result;
         Op op;
-
-        // FIXME: Find a way to not loop here
         for (size_t i = 0; i < VectorSize; ++i) {
             result[i] = op(value[i]);
         }
@@ -834,6 +879,17 @@ struct VectorFloatBinaryOp {
         using VectorType = NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>;
         auto first = bit_cast<VectorType>(lhs);
         auto second = bit_cast<VectorType>(rhs);
+
+        if constexpr (IsOneOf<Op, Add, Subtract, Multiply>)
+            return bit_cast<u128>(Op {}(first, second));
+        else if constexpr (IsSame<Op, Divide>)
+            return bit_cast<u128>(first / second);
+        else if constexpr (IsSame<Op, PseudoMinimum>)
+            return bit_cast<u128>(select_lanes(second < first, second, first));
+        else if constexpr (IsSame<Op, PseudoMaximum>)
+            return bit_cast<u128>(select_lanes(first < second, second, first));
+
+        // NOTE: Minimum and maximum have to treat NaNs and signed zeroes specially, so we go lane by lane for those.
         VectorType result;
         Op op;
         for (size_t i = 0; i < VectorSize; ++i) {
@@ -861,6 +917,15 @@ struct VectorFloatUnaryOp {
     {
         using VectorType = NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>;
         auto value = bit_cast<VectorType>(lhs);
+
+        // NOTE: Negation and absolute value only touch the sign bit, even for NaNs.
+        using BitsType = NativeVectorType<128 / VectorSize, VectorSize, MakeUnsigned>;
+        constexpr auto sign_bit = static_cast<NativeIntegralType<128 / VectorSize>>(1) << (128 / VectorSize - 1);
+        if constexpr (IsSame<Op, Negate>)
+            return bit_cast<u128>(bit_cast<BitsType>(value) ^ sign_bit);
+        else if constexpr (IsSame<Op, Absolute>)
+            return bit_cast<u128>(bit_cast<BitsType>(value) & ~sign_bit);
+
         VectorType result;
         Op op;
         for (size_t i = 0; i < VectorSize; ++i) {
@@ -9,11 +9,16 @@
 #include <AK/SourceLocation.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Try.h>
+#include <LibCore/System.h>
+#include <LibThreading/Thread.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWasm/Printer/Printer.h>
 
 namespace Wasm {
 
+// Function bodies only depend on the module's other sections, so large code sections are validated on several threads.
+static constexpr size_t min_functions_per_validation_thread = 64;
+
 ErrorOr<void, ValidationError> Validator::validate(Module& module)
 {
     // Pre-emptively make invalid. The module will be set to `Valid` at the end
@@ -240,30 +245,101 @@ ErrorOr<void, ValidationError> Validator::validate(TableSection const& section)
     return {};
 }
 
+NonnullOwnPtr<Validator> Validator::fork_for_another_thread() const
+{
+    Context context;
+    context.types.extend(m_context.types);
+    context.functions.extend(m_context.functions);
+    context.tables.extend(m_context.tables);
+    context.memories.extend(m_context.memories);
+    context.globals.extend(m_context.globals);
+    context.elements.extend(m_context.elements);
+    context.datas.extend(m_context.datas);
+    context.locals.extend(m_context.locals);
+    context.data_count = m_context.data_count;
+    for (auto& index : m_context.references->tree)
+        context.references->tree.insert(index.value(), index);
+    context.imported_function_count = m_context.imported_function_count;
+    return adopt_own(*new Validator { move(context) });
+}
+
+ErrorOr<void, ValidationError> Validator::validate_function(FunctionIndex function_index, CodeSection::Code const& entry)
+{
+    TRY(validate(function_index));
+    auto& function_type = m_context.functions[function_index.value()];
+    auto& function = entry.func();
+
+    auto function_validator = fork();
+    function_validator.m_context.locals = {};
+    function_validator.m_context.locals.extend(function_type.parameters());
+    for (auto& local : function.locals()) {
+        for (size_t i = 0; i < local.n(); ++i)
+            function_validator.m_context.locals.append(local.type());
+    }
+
+    function_validator.m_frames.empend(function_type, FrameKind::Function, (size_t)0);
+
+    auto results = TRY(function_validator.validate(function.body(), function_type.results()));
+    if (results.result_types.size() != function_type.results().size())
+        return Errors::invalid("function result"sv, function_type.results(), results.result_types);
+
+    return {};
+}
+
 ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
 {
-    size_t index = m_context.imported_function_count;
-    for (auto& entry : section.functions()) {
-        auto function_index = index++;
-        TRY(validate(FunctionIndex { function_index }));
-        auto& function_type = m_context.functions[function_index];
-        auto& function = entry.func();
-
-        auto function_validator = fork();
-        function_validator.m_context.locals = {};
-        function_validator.m_context.locals.extend(function_type.parameters());
-        for (auto& local : function.locals()) {
-            for (size_t i = 0; i < local.n(); ++i)
-                function_validator.m_context.locals.append(local.type());
-        }
+    auto& functions = section.functions();
+    auto first_function_index = m_context.imported_function_count;
 
-        function_validator.m_frames.empend(function_type, FrameKind::Function, (size_t)0);
+    auto thread_count = min<size_t>(Core::System::hardware_concurrency(), functions.size() / min_functions_per_validation_thread);
+    if (thread_count <= 1) {
+        for (size_t i = 0; i < functions.size(); ++i)
+            TRY(validate_function(FunctionIndex { first_function_index + i }, functions[i]));
+        return {};
+    }
 
-        auto results = TRY(function_validator.validate(function.body(), function_type.results()));
-        if (results.result_types.size() != function_type.results().size())
-            return Errors::invalid("function result"sv, function_type.results(), results.result_types);
+    // Each thread validates a contiguous range of functions with its own copy of the context, and stops at the first
+    // invalid one. The first range with an error then has the same error that validating in order would have found.
+    Vector<NonnullOwnPtr<Validator>> validators;
+    Vector<Optional<ValidationError>> errors;
+    for (size_t i = 0; i < thread_count; ++i) {
+        validators.append(fork_for_another_thread());
+        errors.append({});
     }
 
+    auto validate_range = [&](size_t range_index) -> intptr_t {
+        auto start = functions.size() * range_index / thread_count;
+        auto end = functions.size() * (range_index + 1) / thread_count;
+        for (size_t i = start; i < end; ++i) {
+            if (auto result = validators[range_index]->validate_function(FunctionIndex { first_function_index + i }, functions[i]); result.is_error()) {
+                errors[range_index] = result.release_error();
+                break;
+            }
+        }
+        return 0;
+    };
+
+    // This thread does its share of the work too, and picks up the share of any thread that couldn't be started.
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    Vector<size_t> ranges_for_this_thread { 0 };
+    for (size_t i = 1; i < thread_count; ++i) {
+        auto thread = Threading::Thread::try_create([&validate_range, i] { return validate_range(i); }, "Wasm validator"sv);
+        if (thread.is_error() || threads.try_append(thread.value()).is_error()) {
+            ranges_for_this_thread.append(i);
+            continue;
+        }
+        thread.value()->start();
+    }
+
+    for (auto range_index : ranges_for_this_thread)
+        validate_range(range_index);
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    for (auto& error : errors) {
+        if (error.has_value())
+            return error.release_value();
+    }
     return {};
 }
 
@@ -8,6 +8,7 @@
 
 #include <AK/COWVector.h>
 #include <AK/Debug.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/RedBlackTree.h>
 #include <AK/SourceLocation.h>
 #include <AK/Tuple.h>
@@ -57,6 +58,10 @@ public:
         return Validator { m_context };
     }
 
+    // Unlike fork(), this shares no (non-thread-safe) reference counted storage with this validator,
+    // so the copy can be used on another thread.
+    [[nodiscard]] NonnullOwnPtr<Validator> fork_for_another_thread() const;
+
     // Module
     ErrorOr<void, ValidationError> validate(Module&);
     ErrorOr<void, ValidationError> validate(ImportSection const&);
@@ -278,6 +283,8 @@ public:
     ErrorOr<void, ValidationError> validate(GlobalType const&) { return {}; }
 
 private:
+    ErrorOr<void, ValidationError> validate_function(FunctionIndex, CodeSection::Code const&);
+
     explicit Validator(Context context)
         : m_context(move(context))
     {
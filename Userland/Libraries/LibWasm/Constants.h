@@ -36,6 +36,7 @@ static constexpr auto extern_memory_tag = 0x02;
 static constexpr auto extern_global_tag = 0x03;
 
 static constexpr auto page_size = 64 * KiB;
+static constexpr auto max_memory_pages = 65536;
 
 // Implementation-defined limits
 // These are not concretely defined by the spec, so the values are only defined by us.
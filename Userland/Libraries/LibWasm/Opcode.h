@@ -460,8 +460,18 @@ namespace Instructions {
     ENUMERATE_SINGLE_BYTE_WASM_OPCODES(M) \
     ENUMERATE_MULTI_BYTE_WASM_OPCODES(M)
 
+// These don't exist in the binary format. Once a function has been validated, common sequences of instructions in its
+// body are replaced with these, which operate on locals directly instead of going through the value stack.
+#define ENUMERATE_SYNTHETIC_INSTRUCTION_OPCODES(M)           \
+    M(synthetic_i32_add2local, 0xff00000000000000ull)        \
+    M(synthetic_i32_addconstlocal, 0xff00000000000001ull)    \
+    M(synthetic_i32_andconstlocal, 0xff00000000000002ull)    \
+    M(synthetic_local_seti32_const, 0xff00000000000003ull)   \
+    M(synthetic_local_copy, 0xff00000000000004ull)
+
 #define M(name, value) static constexpr OpCode name = value;
 ENUMERATE_WASM_OPCODES(M)
+ENUMERATE_SYNTHETIC_INSTRUCTION_OPCODES(M)
 #undef M
 
 }
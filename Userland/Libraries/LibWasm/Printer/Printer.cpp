@@ -446,6 +446,8 @@ void Printer::print(Wasm::Instruction const& instruction)
             [&](GlobalIndex const& index) { print("(global index {})", index.value()); },
             [&](LabelIndex const& index) { print("(label index {})", index.value()); },
             [&](LocalIndex const& index) { print("(local index {})", index.value()); },
+            [&](Instruction::LocalAndConstArgs const& args) { print("(local index {}) (const {})", args.local_index.value(), args.value); },
+            [&](Instruction::LocalPairArgs const& args) { print("(local index {}) (local index {})", args.lhs.value(), args.rhs.value()); },
             [&](TableIndex const& index) { print("(table index {})", index.value()); },
             [&](Instruction::IndirectCallArgs const& args) { print("(indirect (type index {}) (table index {}))", args.type.value(), args.table.value()); },
             [&](Instruction::MemoryArgument const& args) { print("(memory index {} (align {}) (offset {}))", args.memory_index.value(), args.align, args.offset); },
@@ -1140,5 +1142,10 @@ HashMap<Wasm::OpCode, ByteString> Wasm::Names::instruction_names {
     { Instructions::f64x2_convert_low_i32x4_u, "f64x2.convert_low_i32x4_u" },
     { Instructions::structured_else, "synthetic:else" },
     { Instructions::structured_end, "synthetic:end" },
+    { Instructions::synthetic_i32_add2local, "synthetic:i32.add2local" },
+    { Instructions::synthetic_i32_addconstlocal, "synthetic:i32.addconstlocal" },
+    { Instructions::synthetic_i32_andconstlocal, "synthetic:i32.andconstlocal" },
+    { Instructions::synthetic_local_seti32_const, "synthetic:local.seti32.const" },
+    { Instructions::synthetic_local_copy, "synthetic:local.copy" },
 };
 HashMap<ByteString, Wasm::OpCode> Wasm::Names::instructions_by_name;
@@ -1333,8 +1333,9 @@ void Animation::invalidate_effect()
 
     if (auto* target = m_effect->target(); target) {
         target->document().set_needs_animated_style_update();
+        // NOTE: The display list is invalidated once the new style is known, see KeyframeEffect::update_style_properties().
         if (target->paintable()) {
-            target->paintable()->set_needs_display();
+            target->paintable()->set_needs_display(InvalidateDisplayList::No);
         }
     }
 }
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/QuickSort.h>
 #include <LibJS/Runtime/Iterator.h>
 #include <LibWeb/Animations/Animation.h>
@@ -13,6 +14,7 @@
 #include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/Layout/Node.h>
 #include <LibWeb/Painting/Paintable.h>
+#include <LibWeb/Painting/StackingContext.h>
 #include <LibWeb/WebIDL/ExceptionOr.h>
 
 namespace Web::Animations {
@@ -927,8 +929,9 @@ void KeyframeEffect::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_keyframe_objects);
 }
 
-static CSS::RequiredInvalidationAfterStyleChange compute_required_invalidation(HashMap<CSS::PropertyID, NonnullRefPtr<CSS::CSSStyleValue const>> const& old_properties, HashMap<CSS::PropertyID, NonnullRefPtr<CSS::CSSStyleValue const>> const& new_properties)
+static CSS::RequiredInvalidationAfterStyleChange compute_required_invalidation(HashMap<CSS::PropertyID, NonnullRefPtr<CSS::CSSStyleValue const>> const& old_properties, HashMap<CSS::PropertyID, NonnullRefPtr<CSS::CSSStyleValue const>> const& new_properties, bool& only_stacking_context_effects_changed)
 {
+    only_stacking_context_effects_changed = true;
     CSS::RequiredInvalidationAfterStyleChange invalidation;
     auto old_and_new_properties = MUST(Bitmap::create(to_underlying(CSS::last_property_id) + 1, 0));
     for (auto const& [property_id, _] : old_properties)
@@ -943,11 +946,41 @@ static CSS::RequiredInvalidationAfterStyleChange compute_required_invalidation(H
         auto new_value = new_properties.get(property_id).value_or({});
         if (!old_value && !new_value)
             continue;
-        invalidation |= compute_property_invalidation(property_id, old_value, new_value);
+        auto property_invalidation = compute_property_invalidation(property_id, old_value, new_value);
+        // NOTE: These are applied by the stacking context the element establishes, not painted by the element itself.
+        if (!property_invalidation.is_none() && !AK::first_is_one_of(property_id, CSS::PropertyID::Opacity, CSS::PropertyID::Transform))
+            only_stacking_context_effects_changed = false;
+        invalidation |= property_invalidation;
     }
     return invalidation;
 }
 
+// Non-inherited properties only reach the descendants that explicitly inherit them, e.g. with `opacity: inherit`, and
+// from those only the descendants that explicitly inherit them again.
+static void update_explicitly_inherited_properties(DOM::Element& parent, ReadonlySpan<CSS::PropertyID> property_ids)
+{
+    parent.for_each_child_of_type<DOM::Element>([&](auto& element) {
+        auto* element_style = element.computed_css_values();
+        if (!element_style || !element.layout_node())
+            return IterationDecision::Continue;
+
+        bool inherits_any_property = false;
+        for (auto property_id : property_ids) {
+            if (!element_style->is_property_inherited(property_id))
+                continue;
+            auto new_value = CSS::StyleComputer::get_inherit_value(element.realm(), property_id, &element);
+            element_style->set_property(property_id, *new_value, CSS::StyleProperties::Inherited::Yes);
+            inherits_any_property = true;
+        }
+
+        if (inherits_any_property) {
+            element.layout_node()->apply_style(*element_style);
+            update_explicitly_inherited_properties(element, property_ids);
+        }
+        return IterationDecision::Continue;
+    });
+}
+
 void KeyframeEffect::update_style_properties()
 {
     auto target = this->target();
@@ -969,40 +1002,79 @@ void KeyframeEffect::update_style_properties()
     document.style_computer().collect_animation_into(*target, pseudo_element_type(), *this, *style, CSS::StyleComputer::AnimationRefresh::Yes);
 
     // Traversal of the subtree is necessary to update the animated properties inherited from the target element.
-    target->for_each_in_subtree_of_type<DOM::Element>([&](auto& element) {
-        auto* element_style = element.computed_css_values();
-        if (!element_style || !element.layout_node())
-            return TraversalDecision::Continue;
-
-        for (auto i = to_underlying(CSS::first_property_id); i <= to_underlying(CSS::last_property_id); ++i) {
-            if (element_style->is_property_inherited(static_cast<CSS::PropertyID>(i))) {
-                auto new_value = CSS::StyleComputer::get_inherit_value(document.realm(), static_cast<CSS::PropertyID>(i), &element);
-                element_style->set_property(static_cast<CSS::PropertyID>(i), *new_value, CSS::StyleProperties::Inherited::Yes);
+    // NOTE: Animations of properties that aren't inherited, like the transform and opacity ones that make up most
+    //       spinners and transitions, only have to visit the descendants that explicitly inherit those properties.
+    auto has_inherited_property = [](HashMap<CSS::PropertyID, NonnullRefPtr<CSS::CSSStyleValue const>> const& properties) {
+        return any_of(properties, [](auto const& entry) { return CSS::is_inherited_property(entry.key); });
+    };
+    if (has_inherited_property(animated_properties_before_update) || has_inherited_property(style->animated_property_values())) {
+        target->for_each_in_subtree_of_type<DOM::Element>([&](auto& element) {
+            auto* element_style = element.computed_css_values();
+            if (!element_style || !element.layout_node())
+                return TraversalDecision::Continue;
+
+            for (auto i = to_underlying(CSS::first_property_id); i <= to_underlying(CSS::last_property_id); ++i) {
+                if (element_style->is_property_inherited(static_cast<CSS::PropertyID>(i))) {
+                    auto new_value = CSS::StyleComputer::get_inherit_value(document.realm(), static_cast<CSS::PropertyID>(i), &element);
+                    element_style->set_property(static_cast<CSS::PropertyID>(i), *new_value, CSS::StyleProperties::Inherited::Yes);
+                }
             }
-        }
 
-        element.layout_node()->apply_style(*element_style);
-        return TraversalDecision::Continue;
-    });
+            element.layout_node()->apply_style(*element_style);
+            return TraversalDecision::Continue;
+        });
+    } else {
+        Vector<CSS::PropertyID> animated_property_ids;
+        for (auto property_id : animated_properties_before_update.keys())
+            animated_property_ids.append(property_id);
+        for (auto property_id : style->animated_property_values().keys()) {
+            if (!animated_properties_before_update.contains(property_id))
+                animated_property_ids.append(property_id);
+        }
+        update_explicitly_inherited_properties(*target, animated_property_ids);
+    }
 
-    auto invalidation = compute_required_invalidation(animated_properties_before_update, style->animated_property_values());
+    bool only_stacking_context_effects_changed = false;
+    auto invalidation = compute_required_invalidation(animated_properties_before_update, style->animated_property_values(), only_stacking_context_effects_changed);
 
+    Painting::Paintable* paintable = nullptr;
     if (!pseudo_element_type().has_value()) {
-        if (target->layout_node())
+        if (target->layout_node()) {
             target->layout_node()->apply_style(*style);
+            paintable = target->paintable();
+        }
     } else {
         auto pseudo_element_node = target->get_pseudo_element_node(pseudo_element_type().value());
         if (auto* node_with_style = dynamic_cast<Layout::NodeWithStyle*>(pseudo_element_node.ptr())) {
             node_with_style->apply_style(*style);
+            paintable = node_with_style->paintable();
         }
     }
 
-    if (invalidation.relayout)
-        document.set_needs_layout();
+    if (invalidation.relayout) {
+        if (target->layout_node())
+            target->layout_node()->set_needs_layout_update();
+        else
+            document.set_needs_layout();
+    }
     if (invalidation.rebuild_layout_tree)
         document.invalidate_layout_tree();
-    if (invalidation.repaint)
+    if (invalidation.repaint) {
         document.set_needs_to_resolve_paint_only_properties();
+        if (only_stacking_context_effects_changed) {
+            // NOTE: The cached content of the element's stacking context is still good, it just has to be put back
+            //       together with the new effects applied.
+            document.invalidate_display_list_for_paint_only_change();
+        } else if (paintable) {
+            paintable->set_needs_display();
+            // NOTE: Inherited properties may have changed for the whole subtree, including nested stacking contexts.
+            paintable->for_each_in_subtree([](auto const& descendant) {
+                if (auto const* stacking_context = descendant.stacking_context())
+                    stacking_context->invalidate_cached_display_list_chunk();
+                return TraversalDecision::Continue;
+            });
+        }
+    }
     if (invalidation.rebuild_stacking_context_tree)
         document.invalidate_stacking_context_tree();
 }
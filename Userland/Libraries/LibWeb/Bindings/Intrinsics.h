@@ -51,7 +51,7 @@ public:
         if (auto it = m_prototypes.find(class_name); it != m_prototypes.end())
             return *it->value;
 
-        create_web_prototype_and_constructor<PrototypeType>(*m_realm);
+        create_web_prototype<PrototypeType>(*m_realm);
         return *m_prototypes.find(class_name)->value;
     }
 
@@ -61,20 +61,28 @@ public:
         if (auto it = m_constructors.find(class_name); it != m_constructors.end())
             return *it->value;
 
-        create_web_prototype_and_constructor<PrototypeType>(*m_realm);
+        create_web_constructor<PrototypeType>(*m_realm);
         return *m_constructors.find(class_name)->value;
     }
 
     bool is_exposed(StringView name) const;
 
+    // How many namespace, prototype and constructor objects have been created in this realm so far.
+    size_t created_object_count() const { return m_namespaces.size() + m_prototypes.size() + m_constructors.size(); }
+
 private:
     virtual void visit_edges(JS::Cell::Visitor&) override;
 
     template<typename NamespaceType>
     void create_web_namespace(JS::Realm& realm);
 
+    // NOTE: Most pages never touch the constructors of most of the objects they create, so prototypes and constructors
+    //       are created separately, with the prototype's "constructor" property creating the constructor on first access.
+    template<typename PrototypeType>
+    void create_web_prototype(JS::Realm& realm);
+
     template<typename PrototypeType>
-    void create_web_prototype_and_constructor(JS::Realm& realm);
+    void create_web_constructor(JS::Realm& realm);
 
     HashMap<FlyString, JS::NonnullGCPtr<JS::Object>> m_namespaces;
     HashMap<FlyString, JS::NonnullGCPtr<JS::Object>> m_prototypes;
@@ -41,6 +41,23 @@ struct AspectRatio {
     Optional<Ratio> preferred_ratio;
 };
 
+// https://drafts.csswg.org/css-contain-2/#contain-property
+struct Containment {
+    bool size_containment { false };
+    bool layout_containment { false };
+    bool style_containment { false };
+    bool paint_containment { false };
+
+    bool is_empty() const { return !(size_containment || layout_containment || style_containment || paint_containment); }
+};
+
+// https://drafts.csswg.org/css-sizing-4/#intrinsic-size-override
+struct ContainIntrinsicSize {
+    bool use_last_remembered_size { false };
+    // NOTE: An empty length means `none`.
+    Optional<CSS::Length> length;
+};
+
 struct GridAutoFlow {
     bool row { true };
     bool dense { false };
@@ -102,6 +119,8 @@ public:
     static CSS::CaptionSide caption_side() { return CSS::CaptionSide::Top; }
     static CSS::Clear clear() { return CSS::Clear::None; }
     static CSS::Clip clip() { return CSS::Clip::make_auto(); }
+    static CSS::Containment contain() { return {}; }
+    static CSS::ContainIntrinsicSize contain_intrinsic_size() { return {}; }
     static CSS::ContentVisibility content_visibility() { return CSS::ContentVisibility::Visible; }
     static CSS::Cursor cursor() { return CSS::Cursor::Auto; }
     static CSS::WhiteSpace white_space() { return CSS::WhiteSpace::Normal; }
@@ -366,6 +385,9 @@ public:
     CSS::CaptionSide caption_side() const { return m_inherited.caption_side; }
     CSS::Clear clear() const { return m_noninherited.clear; }
     CSS::Clip clip() const { return m_noninherited.clip; }
+    CSS::Containment const& contain() const { return m_noninherited.contain; }
+    CSS::ContainIntrinsicSize const& contain_intrinsic_width() const { return m_noninherited.contain_intrinsic_width; }
+    CSS::ContainIntrinsicSize const& contain_intrinsic_height() const { return m_noninherited.contain_intrinsic_height; }
     CSS::ContentVisibility content_visibility() const { return m_inherited.content_visibility; }
     CSS::Cursor cursor() const { return m_inherited.cursor; }
     CSS::ContentData content() const { return m_noninherited.content; }
@@ -570,6 +592,9 @@ protected:
         CSS::Float float_ { InitialValues::float_() };
         CSS::Clear clear { InitialValues::clear() };
         CSS::Clip clip { InitialValues::clip() };
+        CSS::Containment contain { InitialValues::contain() };
+        CSS::ContainIntrinsicSize contain_intrinsic_width { InitialValues::contain_intrinsic_size() };
+        CSS::ContainIntrinsicSize contain_intrinsic_height { InitialValues::contain_intrinsic_size() };
         CSS::Display display { InitialValues::display() };
         Optional<int> z_index;
         // FIXME: Store this as flags in a u8.
@@ -692,6 +717,9 @@ public:
     void set_color(Color color) { m_inherited.color = color; }
     void set_clip(CSS::Clip const& clip) { m_noninherited.clip = clip; }
     void set_content(ContentData const& content) { m_noninherited.content = content; }
+    void set_contain(CSS::Containment const& contain) { m_noninherited.contain = contain; }
+    void set_contain_intrinsic_width(CSS::ContainIntrinsicSize const& value) { m_noninherited.contain_intrinsic_width = value; }
+    void set_contain_intrinsic_height(CSS::ContainIntrinsicSize const& value) { m_noninherited.contain_intrinsic_height = value; }
     void set_content_visibility(CSS::ContentVisibility content_visibility) { m_inherited.content_visibility = content_visibility; }
     void set_cursor(CSS::Cursor cursor) { m_inherited.cursor = cursor; }
     void set_image_rendering(CSS::ImageRendering value) { m_inherited.image_rendering = value; }
@@ -79,6 +79,8 @@ public:
         CSSPixels cap_height;
         CSSPixels zero_advance;
         CSSPixels line_height;
+
+        [[nodiscard]] bool operator==(FontMetrics const&) const = default;
     };
 
     static Optional<Type> unit_from_name(StringView);
@@ -163,6 +165,8 @@ public:
         CSSPixelRect viewport_rect;
         FontMetrics font_metrics;
         FontMetrics root_font_metrics;
+
+        [[nodiscard]] bool operator==(ResolutionContext const&) const = default;
     };
 
     [[nodiscard]] CSSPixels to_px(ResolutionContext const&) const;
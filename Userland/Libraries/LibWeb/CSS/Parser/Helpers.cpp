@@ -15,21 +15,32 @@
 
 namespace Web {
 
-CSS::CSSStyleSheet* parse_css_stylesheet(CSS::Parser::ParsingContext const& context, StringView css, Optional<URL::URL> location)
+static CSS::CSSStyleSheet* parse_css_stylesheet_impl(CSS::Parser::ParsingContext const& context, StringView css, Optional<URL::URL> location)
 {
     if (css.is_empty()) {
         auto rule_list = CSS::CSSRuleList::create_empty(context.realm());
         auto media_list = CSS::MediaList::create(context.realm(), {});
-        auto style_sheet = CSS::CSSStyleSheet::create(context.realm(), rule_list, media_list, location);
-        style_sheet->set_source_text({});
-        return style_sheet;
+        return CSS::CSSStyleSheet::create(context.realm(), rule_list, media_list, location);
     }
-    auto* style_sheet = CSS::Parser::Parser::create(context, css).parse_as_css_stylesheet(location);
-    // FIXME: Avoid this copy
+    return CSS::Parser::Parser::create(context, css).parse_as_css_stylesheet(location);
+}
+
+CSS::CSSStyleSheet* parse_css_stylesheet(CSS::Parser::ParsingContext const& context, StringView css, Optional<URL::URL> location)
+{
+    auto* style_sheet = parse_css_stylesheet_impl(context, css, move(location));
     style_sheet->set_source_text(MUST(String::from_utf8(css)));
     return style_sheet;
 }
 
+// NOTE: Style sheets coming from the network have already been decoded into a String, which we can keep as the source
+//       text instead of validating and copying the whole thing again.
+CSS::CSSStyleSheet* parse_css_stylesheet(CSS::Parser::ParsingContext const& context, String const& css, Optional<URL::URL> location)
+{
+    auto* style_sheet = parse_css_stylesheet_impl(context, css, move(location));
+    style_sheet->set_source_text(css);
+    return style_sheet;
+}
+
 CSS::ElementInlineCSSStyleDeclaration* parse_css_style_attribute(CSS::Parser::ParsingContext const& context, StringView css, DOM::Element& element)
 {
     if (css.is_empty())
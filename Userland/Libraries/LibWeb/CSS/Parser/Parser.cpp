@@ -4703,6 +4703,86 @@ RefPtr<CSSStyleValue> Parser::parse_single_shadow_value(TokenStream<ComponentVal
     return ShadowStyleValue::create(color.release_nonnull(), offset_x.release_nonnull(), offset_y.release_nonnull(), blur_radius.release_nonnull(), spread_distance.release_nonnull(), placement.release_value());
 }
 
+// https://drafts.csswg.org/css-contain-2/#contain-property
+RefPtr<CSSStyleValue> Parser::parse_contain_value(TokenStream<ComponentValue>& tokens)
+{
+    // none | strict | content | [ size || layout || style || paint ]
+    StyleValueVector style_values;
+
+    while (tokens.has_next_token()) {
+        auto maybe_value = parse_css_value_for_property(PropertyID::Contain, tokens);
+        if (!maybe_value)
+            break;
+        auto value = maybe_value.release_nonnull();
+
+        auto maybe_contain = keyword_to_contain(value->to_keyword());
+        if (!maybe_contain.has_value())
+            break;
+
+        if (first_is_one_of(*maybe_contain, Contain::None, Contain::Strict, Contain::Content)) {
+            if (!style_values.is_empty())
+                break;
+            return value;
+        }
+        if (style_values.contains_slow(value))
+            break;
+        style_values.append(move(value));
+    }
+
+    if (style_values.is_empty())
+        return nullptr;
+    return StyleValueList::create(move(style_values), StyleValueList::Separator::Space);
+}
+
+// https://drafts.csswg.org/css-sizing-4/#intrinsic-size-override
+RefPtr<CSSStyleValue> Parser::parse_single_contain_intrinsic_size_value(PropertyID property_id, TokenStream<ComponentValue>& tokens)
+{
+    // none | <length [0,∞]> | auto && [ none | <length [0,∞]> ]
+    auto transaction = tokens.begin_transaction();
+
+    auto parse_auto_keyword = [&tokens]() {
+        tokens.skip_whitespace();
+        if (!tokens.peek_token().is_ident("auto"sv))
+            return false;
+        (void)tokens.next_token();
+        return true;
+    };
+
+    bool has_auto = parse_auto_keyword();
+    auto value = parse_css_value_for_property(property_id, tokens);
+    if (!value)
+        return nullptr;
+    if (!has_auto)
+        has_auto = parse_auto_keyword();
+
+    transaction.commit();
+    if (!has_auto)
+        return value;
+    return StyleValueList::create(StyleValueVector { CSSKeywordValue::create(Keyword::Auto), value.release_nonnull() }, StyleValueList::Separator::Space);
+}
+
+RefPtr<CSSStyleValue> Parser::parse_contain_intrinsic_size_value(TokenStream<ComponentValue>& tokens)
+{
+    // [ none | <length [0,∞]> | auto && [ none | <length [0,∞]> ] ]{1,2}
+    auto transaction = tokens.begin_transaction();
+    auto width = parse_single_contain_intrinsic_size_value(PropertyID::ContainIntrinsicWidth, tokens);
+    if (!width)
+        return nullptr;
+
+    tokens.skip_whitespace();
+    RefPtr<CSSStyleValue> height = width;
+    if (tokens.has_next_token()) {
+        height = parse_single_contain_intrinsic_size_value(PropertyID::ContainIntrinsicHeight, tokens);
+        if (!height)
+            return nullptr;
+    }
+
+    transaction.commit();
+    return ShorthandStyleValue::create(PropertyID::ContainIntrinsicSize,
+        { PropertyID::ContainIntrinsicWidth, PropertyID::ContainIntrinsicHeight },
+        { width.release_nonnull(), height.release_nonnull() });
+}
+
 RefPtr<CSSStyleValue> Parser::parse_content_value(TokenStream<ComponentValue>& tokens)
 {
     // FIXME: `content` accepts several kinds of function() type, which we don't handle in property_accepts_value() yet.
@@ -7727,6 +7807,19 @@ Parser::ParseErrorOr<NonnullRefPtr<CSSStyleValue>> Parser::parse_css_value(Prope
         if (auto parsed_value = parse_columns_value(tokens); parsed_value && !tokens.has_next_token())
             return parsed_value.release_nonnull();
         return ParseError::SyntaxError;
+    case PropertyID::Contain:
+        if (auto parsed_value = parse_contain_value(tokens); parsed_value && !tokens.has_next_token())
+            return parsed_value.release_nonnull();
+        return ParseError::SyntaxError;
+    case PropertyID::ContainIntrinsicHeight:
+    case PropertyID::ContainIntrinsicWidth:
+        if (auto parsed_value = parse_single_contain_intrinsic_size_value(property_id, tokens); parsed_value && !tokens.has_next_token())
+            return parsed_value.release_nonnull();
+        return ParseError::SyntaxError;
+    case PropertyID::ContainIntrinsicSize:
+        if (auto parsed_value = parse_contain_intrinsic_size_value(tokens); parsed_value && !tokens.has_next_token())
+            return parsed_value.release_nonnull();
+        return ParseError::SyntaxError;
     case PropertyID::Content:
         if (auto parsed_value = parse_content_value(tokens); parsed_value && !tokens.has_next_token())
             return parsed_value.release_nonnull();
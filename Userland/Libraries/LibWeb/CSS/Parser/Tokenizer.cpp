@@ -301,6 +301,40 @@ u32 Tokenizer::next_code_point()
     return code_point;
 }
 
+// Consumes the longest run of ASCII code points matching the predicate straight from the underlying bytes, without
+// decoding them one by one. Stops at the first non-ASCII byte, so callers must handle whatever follows themselves.
+template<typename Predicate>
+StringView Tokenizer::consume_ascii_code_points_while(Predicate predicate)
+{
+    auto start_byte_offset = current_byte_offset();
+    auto remaining = m_utf8_view.as_string().substring_view(start_byte_offset);
+
+    size_t length = 0;
+    auto position = m_position;
+    auto previous_position = m_prev_position;
+    for (; length < remaining.length(); ++length) {
+        auto code_point = static_cast<u8>(remaining[length]);
+        if (!is_ascii(code_point) || !predicate(code_point))
+            break;
+        previous_position = position;
+        if (is_newline(code_point)) {
+            position.line++;
+            position.column = 0;
+        } else {
+            position.column++;
+        }
+    }
+
+    if (length == 0)
+        return {};
+
+    m_prev_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(start_byte_offset + length - 1);
+    m_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(start_byte_offset + length);
+    m_prev_position = previous_position;
+    m_position = position;
+    return remaining.substring_view(0, length);
+}
+
 u32 Tokenizer::peek_code_point(size_t offset) const
 {
     auto it = m_utf8_iterator;
@@ -606,11 +640,20 @@ FlyString Tokenizer::consume_an_ident_sequence()
     // If that is the intended use, ensure that the stream starts with an ident sequence before
     // calling this algorithm.
 
+    // NOTE: Almost all idents are plain ASCII without escapes, so try to take them straight from the input first.
+    auto is_ascii_ident_code_point = [](u32 code_point) { return is_ident_code_point(code_point); };
+    auto ascii_prefix = consume_ascii_code_points_while(is_ascii_ident_code_point);
+    if (auto next = peek_code_point(); is_eof(next) || (is_ascii(next) && !is_reverse_solidus(next)))
+        return FlyString::from_utf8_without_validation(ascii_prefix.bytes());
+
     // Let result initially be an empty string.
     StringBuilder result;
+    result.append(ascii_prefix);
 
     // Repeatedly consume the next input code point from the stream:
     for (;;) {
+        result.append(consume_ascii_code_points_while(is_ascii_ident_code_point));
+
         auto input = next_code_point();
 
         if (is_eof(input))
@@ -780,9 +823,8 @@ void Tokenizer::consume_the_remnants_of_a_bad_url()
 
 void Tokenizer::consume_as_much_whitespace_as_possible()
 {
-    while (is_whitespace(peek_code_point())) {
-        (void)next_code_point();
-    }
+    // NOTE: All whitespace is ASCII.
+    (void)consume_ascii_code_points_while([](u32 code_point) { return is_whitespace(code_point); });
 }
 
 void Tokenizer::reconsume_current_input_code_point()
@@ -969,8 +1011,15 @@ Token Tokenizer::consume_string_token(u32 ending_code_point)
         return token;
     };
 
+    // NOTE: Runs of ASCII code points that aren't special here are appended as-is.
+    auto is_plain_string_code_point = [ending_code_point](u32 code_point) {
+        return code_point != ending_code_point && !is_newline(code_point) && !is_reverse_solidus(code_point);
+    };
+
     // Repeatedly consume the next input code point from the stream:
     for (;;) {
+        builder.append(consume_ascii_code_points_while(is_plain_string_code_point));
+
         auto input = next_code_point();
 
         // ending code point
@@ -1042,6 +1091,8 @@ start:
     (void)next_code_point();
 
     for (;;) {
+        (void)consume_ascii_code_points_while([](u32 code_point) { return !is_asterisk(code_point); });
+
         auto twin_inner = peek_twin();
         if (is_eof(twin_inner.first) || is_eof(twin_inner.second)) {
             log_parse_error();
@@ -76,6 +76,9 @@ private:
     [[nodiscard]] U32Twin peek_twin() const;
     [[nodiscard]] U32Triplet peek_triplet() const;
 
+    template<typename Predicate>
+    StringView consume_ascii_code_points_while(Predicate);
+
     [[nodiscard]] U32Twin start_of_input_stream_twin();
     [[nodiscard]] U32Triplet start_of_input_stream_triplet();
 
@@ -202,8 +202,12 @@ static inline bool matches_attribute(CSS::Selector::SimpleSelector::Attribute co
 
     auto const& attribute_name = attribute.qualified_name.name.name;
 
-    auto const* attr = element.namespace_uri() == Namespace::HTML ? element.attributes()->get_attribute_with_lowercase_qualified_name(attribute_name)
-                                                                  : element.attributes()->get_attribute(attribute_name);
+    auto const* attributes = element.attributes();
+    DOM::Attr const* attr = nullptr;
+    if (attributes) {
+        attr = element.namespace_uri() == Namespace::HTML ? attributes->get_attribute_with_lowercase_qualified_name(attribute_name)
+                                                          : attributes->get_attribute(attribute_name);
+    }
 
     if (attribute.match_type == CSS::Selector::SimpleSelector::Attribute::MatchType::HasAttribute) {
         // Early way out in case of an attribute existence selector.
@@ -806,97 +810,144 @@ bool matches(CSS::Selector const& selector, Optional<CSS::CSSStyleSheet const&>
     return matches(selector, style_sheet_for_rule, selector.compound_selectors().size() - 1, element, shadow_host, scope, selector_kind);
 }
 
-static bool fast_matches_simple_selector(CSS::Selector::SimpleSelector const& simple_selector, Optional<CSS::CSSStyleSheet const&> style_sheet_for_rule, DOM::Element const& element, JS::GCPtr<DOM::Element const> shadow_host)
+OwnPtr<CompiledSelector> CompiledSelector::compile(CSS::Selector const& selector)
 {
-    switch (simple_selector.type) {
-    case CSS::Selector::SimpleSelector::Type::Universal:
-        return matches_namespace(simple_selector.qualified_name(), element, style_sheet_for_rule);
-    case CSS::Selector::SimpleSelector::Type::TagName:
-        if (element.document().document_type() == DOM::Document::Type::HTML) {
-            if (simple_selector.qualified_name().name.lowercase_name != element.local_name())
-                return false;
-        } else if (!Infra::is_ascii_case_insensitive_match(simple_selector.qualified_name().name.name, element.local_name())) {
-            return false;
+    if (!can_use_fast_matches(selector))
+        return {};
+
+    auto compiled_selector = adopt_own(*new CompiledSelector);
+    auto& instructions = compiled_selector->m_instructions;
+
+    auto emit_namespace_check = [&](CSS::Selector::SimpleSelector const& simple_selector) {
+        if (simple_selector.qualified_name().namespace_type != CSS::Selector::SimpleSelector::QualifiedName::NamespaceType::Any)
+            instructions.append({ Instruction::Type::MatchNamespace, {}, &simple_selector });
+    };
+
+    // NOTE: All simple selectors in a compound have to match, so we're free to order them by how cheap they are to
+    //       check and how likely they are to reject the element.
+    auto emit_compound_selector = [&](CSS::Selector::CompoundSelector const& compound_selector) {
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Id)
+                instructions.append({ Instruction::Type::MatchId, simple_selector.name(), &simple_selector });
         }
-        return matches_namespace(simple_selector.qualified_name(), element, style_sheet_for_rule);
-    case CSS::Selector::SimpleSelector::Type::Class: {
-        // Class selectors are matched case insensitively in quirks mode.
-        // See: https://drafts.csswg.org/selectors-4/#class-html
-        auto case_sensitivity = element.document().in_quirks_mode() ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive;
-        return element.has_class(simple_selector.name(), case_sensitivity);
-    }
-    case CSS::Selector::SimpleSelector::Type::Id:
-        return simple_selector.name() == element.id();
-    case CSS::Selector::SimpleSelector::Type::Attribute:
-        return matches_attribute(simple_selector.attribute(), style_sheet_for_rule, element);
-    case CSS::Selector::SimpleSelector::Type::PseudoClass:
-        return matches_pseudo_class(simple_selector.pseudo_class(), style_sheet_for_rule, element, shadow_host, nullptr, SelectorKind::Normal);
-    default:
-        VERIFY_NOT_REACHED();
-    }
-}
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Class)
+                instructions.append({ Instruction::Type::MatchClass, simple_selector.name(), &simple_selector });
+        }
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            if (simple_selector.type == CSS::Selector::SimpleSelector::Type::TagName) {
+                instructions.append({ Instruction::Type::MatchTagName, simple_selector.qualified_name().name.lowercase_name, &simple_selector });
+                emit_namespace_check(simple_selector);
+            } else if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Universal) {
+                emit_namespace_check(simple_selector);
+            }
+        }
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Attribute)
+                instructions.append({ Instruction::Type::MatchAttribute, {}, &simple_selector });
+        }
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass)
+                instructions.append({ Instruction::Type::MatchPseudoClass, {}, &simple_selector });
+        }
+    };
 
-static bool fast_matches_compound_selector(CSS::Selector::CompoundSelector const& compound_selector, Optional<CSS::CSSStyleSheet const&> style_sheet_for_rule, DOM::Element const& element, JS::GCPtr<DOM::Element const> shadow_host)
-{
-    for (auto const& simple_selector : compound_selector.simple_selectors) {
-        if (!fast_matches_simple_selector(simple_selector, style_sheet_for_rule, element, shadow_host))
-            return false;
+    auto const& compound_selectors = selector.compound_selectors();
+    for (ssize_t compound_selector_index = compound_selectors.size() - 1; compound_selector_index >= 0; --compound_selector_index) {
+        auto const& compound_selector = compound_selectors[compound_selector_index];
+        emit_compound_selector(compound_selector);
+
+        switch (compound_selector.combinator) {
+        case CSS::Selector::Combinator::None:
+            instructions.append({ Instruction::Type::Accept, {}, nullptr });
+            break;
+        case CSS::Selector::Combinator::Descendant:
+            instructions.append({ Instruction::Type::MoveToAncestor, {}, nullptr });
+            break;
+        case CSS::Selector::Combinator::ImmediateChild:
+            instructions.append({ Instruction::Type::MoveToParent, {}, nullptr });
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
     }
-    return true;
+
+    VERIFY(instructions.last().type == Instruction::Type::Accept);
+    return compiled_selector;
 }
 
-bool fast_matches(CSS::Selector const& selector, Optional<CSS::CSSStyleSheet const&> style_sheet_for_rule, DOM::Element const& element_to_match, JS::GCPtr<DOM::Element const> shadow_host)
+bool CompiledSelector::matches(Optional<CSS::CSSStyleSheet const&> style_sheet_for_rule, DOM::Element const& element_to_match, JS::GCPtr<DOM::Element const> shadow_host) const
 {
-    DOM::Element const* current = &element_to_match;
+    auto const& document = element_to_match.document();
+    bool is_html_document = document.document_type() == DOM::Document::Type::HTML;
 
-    ssize_t compound_selector_index = selector.compound_selectors().size() - 1;
+    // Class selectors are matched case insensitively in quirks mode.
+    // See: https://drafts.csswg.org/selectors-4/#class-html
+    auto class_case_sensitivity = document.in_quirks_mode() ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive;
 
-    if (!fast_matches_compound_selector(selector.compound_selectors().last(), style_sheet_for_rule, *current, shadow_host))
-        return false;
+    DOM::Element const* current = &element_to_match;
 
-    // NOTE: If we fail after following a child combinator, we may need to backtrack
-    //       to the last matched descendant. We store the state here.
+    // NOTE: If a compound selector fails to match, the only thing that can still help is to pick a different ancestor
+    //       for the most recent descendant combinator. Moving an earlier one further up would only leave fewer
+    //       ancestors to try, so we only need to remember the most recent one.
     struct {
-        JS::GCPtr<DOM::Element const> element;
-        ssize_t compound_selector_index = 0;
+        DOM::Element const* element { nullptr };
+        size_t program_counter { 0 };
     } backtrack_state;
 
-    for (;;) {
-        // NOTE: There should always be a leftmost compound selector without combinator that kicks us out of this loop.
-        VERIFY(compound_selector_index >= 0);
-
-        auto const* compound_selector = &selector.compound_selectors()[compound_selector_index];
+    for (size_t program_counter = 0;;) {
+        auto const& instruction = m_instructions[program_counter];
+        bool matched = true;
 
-        switch (compound_selector->combinator) {
-        case CSS::Selector::Combinator::None:
-            return true;
-        case CSS::Selector::Combinator::Descendant:
-            backtrack_state = { current->parent_element(), compound_selector_index };
-            compound_selector = &selector.compound_selectors()[--compound_selector_index];
-            for (current = current->parent_element(); current; current = current->parent_element()) {
-                if (fast_matches_compound_selector(*compound_selector, style_sheet_for_rule, *current, shadow_host))
-                    break;
-            }
+        switch (instruction.type) {
+        case Instruction::Type::MatchId:
+            matched = instruction.name == current->id();
+            break;
+        case Instruction::Type::MatchClass:
+            matched = current->has_class(instruction.name, class_case_sensitivity);
+            break;
+        case Instruction::Type::MatchTagName:
+            if (is_html_document)
+                matched = instruction.name == current->local_name();
+            else
+                matched = Infra::is_ascii_case_insensitive_match(instruction.simple_selector->qualified_name().name.name, current->local_name());
+            break;
+        case Instruction::Type::MatchNamespace:
+            matched = matches_namespace(instruction.simple_selector->qualified_name(), *current, style_sheet_for_rule);
+            break;
+        case Instruction::Type::MatchAttribute:
+            matched = matches_attribute(instruction.simple_selector->attribute(), style_sheet_for_rule, *current);
+            break;
+        case Instruction::Type::MatchPseudoClass:
+            matched = matches_pseudo_class(instruction.simple_selector->pseudo_class(), style_sheet_for_rule, *current, shadow_host, nullptr, SelectorKind::Normal);
+            break;
+        case Instruction::Type::MoveToParent:
+            current = current->parent_element();
             if (!current)
                 return false;
             break;
-        case CSS::Selector::Combinator::ImmediateChild:
-            compound_selector = &selector.compound_selectors()[--compound_selector_index];
+        case Instruction::Type::MoveToAncestor:
             current = current->parent_element();
             if (!current)
                 return false;
-            if (!fast_matches_compound_selector(*compound_selector, style_sheet_for_rule, *current, shadow_host)) {
-                if (backtrack_state.element) {
-                    current = backtrack_state.element;
-                    compound_selector_index = backtrack_state.compound_selector_index;
-                    continue;
-                }
-                return false;
-            }
+            backtrack_state = { current, program_counter + 1 };
             break;
-        default:
-            VERIFY_NOT_REACHED();
+        case Instruction::Type::Accept:
+            return true;
+        }
+
+        if (matched) {
+            ++program_counter;
+            continue;
         }
+
+        if (!backtrack_state.element)
+            return false;
+        current = backtrack_state.element->parent_element();
+        if (!current)
+            return false;
+        backtrack_state.element = current;
+        program_counter = backtrack_state.program_counter;
     }
 }
 
@@ -18,9 +18,42 @@ enum class SelectorKind {
 
 bool matches(CSS::Selector const&, Optional<CSS::CSSStyleSheet const&> style_sheet_for_rule, DOM::Element const&, JS::GCPtr<DOM::Element const> shadow_host, Optional<CSS::Selector::PseudoElement::Type> = {}, JS::GCPtr<DOM::ParentNode const> scope = {}, SelectorKind selector_kind = SelectorKind::Normal);
 
-[[nodiscard]] bool fast_matches(CSS::Selector const&, Optional<CSS::CSSStyleSheet const&> style_sheet_for_rule, DOM::Element const&, JS::GCPtr<DOM::Element const> shadow_host);
 [[nodiscard]] bool can_use_fast_matches(CSS::Selector const&);
 
+// A selector flattened into a right-to-left list of instructions, for the selectors that can_use_fast_matches() accepts.
+// These are compiled once when building the rule cache, so that matching doesn't have to walk the compound and simple
+// selectors and re-derive the same things about them for every element.
+class CompiledSelector {
+public:
+    [[nodiscard]] static OwnPtr<CompiledSelector> compile(CSS::Selector const&);
+
+    [[nodiscard]] bool matches(Optional<CSS::CSSStyleSheet const&> style_sheet_for_rule, DOM::Element const&, JS::GCPtr<DOM::Element const> shadow_host) const;
+
+private:
+    CompiledSelector() = default;
+
+    struct Instruction {
+        enum class Type : u8 {
+            MatchId,
+            MatchClass,
+            MatchTagName,
+            MatchNamespace,
+            MatchAttribute,
+            MatchPseudoClass,
+            MoveToParent,
+            MoveToAncestor,
+            Accept,
+        };
+        Type type;
+        // The id, class name or lowercased tag name to compare against.
+        FlyString name;
+        // The simple selector this instruction was compiled from. The selector outlives the rule cache holding us.
+        CSS::Selector::SimpleSelector const* simple_selector { nullptr };
+    };
+
+    Vector<Instruction> m_instructions;
+};
+
 [[nodiscard]] bool matches_hover_pseudo_class(DOM::Element const&);
 
 }
@@ -462,8 +462,8 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
 
         auto const& selector = rule_to_run.rule->selectors()[rule_to_run.selector_index];
 
-        if (rule_to_run.can_use_fast_matches) {
-            if (!SelectorEngine::fast_matches(selector, *rule_to_run.sheet, element, shadow_host_to_use))
+        if (rule_to_run.compiled_selector) {
+            if (!rule_to_run.compiled_selector->matches(*rule_to_run.sheet, element, shadow_host_to_use))
                 continue;
         } else {
             if (!SelectorEngine::matches(selector, *rule_to_run.sheet, element, shadow_host_to_use, pseudo_element))
@@ -825,7 +825,7 @@ void StyleComputer::for_each_property_expanding_shorthands(PropertyID property_i
 void StyleComputer::set_property_expanding_shorthands(StyleProperties& style, PropertyID property_id, CSSStyleValue const& value, CSSStyleDeclaration const* declaration, StyleProperties const& style_for_revert, StyleProperties const& style_for_revert_layer, Important important)
 {
     auto revert_shorthand = [&](PropertyID shorthand_id, StyleProperties const& style_for_revert) {
-        auto previous_value = style_for_revert.m_data->m_property_values[to_underlying(shorthand_id)];
+        auto previous_value = style_for_revert.property_value_slot(shorthand_id);
         if (!previous_value)
             previous_value = CSSKeywordValue::create(Keyword::Initial);
 
@@ -1497,7 +1497,7 @@ void StyleComputer::compute_cascaded_values(StyleProperties& style, DOM::Element
             // FIXME: This is not very efficient, we should only resolve the custom properties that are actually used.
             for (auto i = to_underlying(CSS::first_property_id); i <= to_underlying(CSS::last_property_id); ++i) {
                 auto property_id = (CSS::PropertyID)i;
-                auto& property = style.m_data->m_property_values[i];
+                auto& property = style.mutable_property_value_slot(property_id);
                 if (property && property->is_unresolved())
                     property = Parser::Parser::resolve_unresolved_style_value(Parser::ParsingContext { document() }, element, pseudo_element, property_id, property->as_unresolved());
             }
@@ -1619,7 +1619,7 @@ void StyleComputer::compute_defaulted_property_value(StyleProperties& style, DOM
 {
     // FIXME: If we don't know the correct initial value for a property, we fall back to `initial`.
 
-    auto& value_slot = style.m_data->m_property_values[to_underlying(property_id)];
+    auto& value_slot = style.mutable_property_value_slot(property_id);
     if (!value_slot) {
         if (is_inherited_property(property_id)) {
             style.set_property(
@@ -2090,7 +2090,7 @@ void StyleComputer::absolutize_values(StyleProperties& style) const
     //       We have to resolve them right away, so that the *computed* line-height is ready for inheritance.
     //       We can't simply absolutize *all* percentage values against the font size,
     //       because most percentages are relative to containing block metrics.
-    auto& line_height_value_slot = style.m_data->m_property_values[to_underlying(CSS::PropertyID::LineHeight)];
+    auto& line_height_value_slot = style.mutable_property_value_slot(CSS::PropertyID::LineHeight);
     if (line_height_value_slot && line_height_value_slot->is_percentage()) {
         line_height_value_slot = LengthStyleValue::create(
             Length::make_px(CSSPixels::nearest_value_for(font_size * static_cast<double>(line_height_value_slot->as_percentage().percentage().as_fraction()))));
@@ -2103,8 +2103,8 @@ void StyleComputer::absolutize_values(StyleProperties& style) const
     if (line_height_value_slot && line_height_value_slot->is_length())
         line_height_value_slot = LengthStyleValue::create(Length::make_px(line_height));
 
-    for (size_t i = 0; i < style.m_data->m_property_values.size(); ++i) {
-        auto& value_slot = style.m_data->m_property_values[i];
+    for (size_t i = 0; i < StyleProperties::number_of_properties; ++i) {
+        auto& value_slot = style.mutable_property_value_slot(static_cast<PropertyID>(i));
         if (!value_slot)
             continue;
         value_slot = value_slot->absolutized(viewport_rect(), font_metrics, m_root_element_font_metrics);
@@ -2300,6 +2300,24 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
 
     ScopeGuard guard { [&element]() { element.set_needs_style_update(false); } };
 
+    bool can_share_style = m_style_sharing_enabled && mode == ComputeStyleMode::Normal && !pseudo_element.has_value();
+    if (can_share_style) {
+        if (auto const* element_to_share_with = find_element_to_share_style_with(element)) {
+            ++m_style_sharing_statistics.hits;
+            auto style = element_to_share_with->computed_css_values()->clone();
+            element.set_custom_properties({}, element_to_share_with->custom_properties({}));
+
+            // Transitions are tracked per element, so this is the one step we still have to perform ourselves.
+            compute_transitioned_properties(style, element, pseudo_element);
+            if (auto const* previous_style = element.computed_css_values())
+                start_needed_transitions(*previous_style, style, element, pseudo_element);
+
+            m_elements_with_shareable_style.set(&element);
+            return style;
+        }
+        ++m_style_sharing_statistics.misses;
+    }
+
     auto style = StyleProperties::create();
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
@@ -2362,9 +2380,104 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
         start_needed_transitions(*previous_style, style, element, pseudo_element);
     }
 
+    if (can_share_style)
+        m_elements_with_shareable_style.set(&element);
+
+    if (auto const* parent_element = element_to_inherit_style_from(&element, pseudo_element); parent_element && parent_element->computed_css_values())
+        style->share_inherited_property_values_if_equal(*parent_element->computed_css_values());
+
     return style;
 }
 
+void StyleComputer::begin_style_sharing()
+{
+    m_style_sharing_enabled = true;
+}
+
+void StyleComputer::end_style_sharing()
+{
+    m_style_sharing_enabled = false;
+    m_elements_with_shareable_style.clear();
+}
+
+bool StyleComputer::rule_cache_prevents_style_sharing(RuleCache const& rule_cache, DOM::Element const& element) const
+{
+    // NOTE: This mirrors the buckets that collect_matching_rules() looks into.
+    if (rule_cache.other_rules_prevent_style_sharing)
+        return true;
+    for (auto const& class_name : element.class_names()) {
+        if (rule_cache.classes_preventing_style_sharing.contains(class_name))
+            return true;
+    }
+    if (auto id = element.id(); id.has_value() && rule_cache.ids_preventing_style_sharing.contains(id.value()))
+        return true;
+    if (rule_cache.tag_names_preventing_style_sharing.contains(element.local_name()))
+        return true;
+
+    bool has_attribute_preventing_style_sharing = false;
+    element.for_each_attribute([&](auto& name, auto&) {
+        if (rule_cache.attribute_names_preventing_style_sharing.contains(name))
+            has_attribute_preventing_style_sharing = true;
+    });
+    return has_attribute_preventing_style_sharing;
+}
+
+// Finds a sibling whose computed style can be reused for `element` instead of running the cascade again.
+// This is a big win for long runs of identical siblings, like the rows and cells of a table.
+DOM::Element const* StyleComputer::find_element_to_share_style_with(DOM::Element const& element) const
+{
+    auto const* candidate = element.previous_element_sibling();
+    if (!candidate || !m_elements_with_shareable_style.contains(candidate))
+        return nullptr;
+    if (candidate->needs_style_update() || !candidate->computed_css_values())
+        return nullptr;
+
+    if (element.local_name() != candidate->local_name() || element.namespace_uri() != candidate->namespace_uri())
+        return nullptr;
+    if (element.custom_element_state() != candidate->custom_element_state())
+        return nullptr;
+
+    // Shadow trees have their own style scopes, and shadow hosts match :host rules.
+    if (is<DOM::ShadowRoot>(element.root()) || element.is_shadow_host() || candidate->is_shadow_host())
+        return nullptr;
+
+    // Everything a selector can look at on the element itself has to be identical, including the inline style.
+    if (element.attribute_list_size() != candidate->attribute_list_size())
+        return nullptr;
+    bool attributes_are_identical = true;
+    element.for_each_attribute([&](DOM::Attr const& attribute) {
+        if (attributes_are_identical && candidate->get_attribute_ns(attribute.namespace_uri(), attribute.local_name()) != attribute.value())
+            attributes_are_identical = false;
+    });
+    if (!attributes_are_identical)
+        return nullptr;
+
+    // Interaction state is matched by :hover, :active, :focus and friends, so we only share between idle elements.
+    auto const* focused_element = document().focused_element();
+    auto const* target_element = document().target_element();
+    for (auto const* it : Array { &element, candidate }) {
+        if (it->is_active() || SelectorEngine::matches_hover_pseudo_class(*it))
+            return nullptr;
+        if (focused_element && it->is_inclusive_ancestor_of(*focused_element))
+            return nullptr;
+        if (target_element && it->is_inclusive_ancestor_of(*target_element))
+            return nullptr;
+        if (it->has_associated_animations())
+            return nullptr;
+    }
+
+    auto const& candidate_style = *candidate->computed_css_values();
+    if (candidate_style.animation_name_source() || !candidate_style.animated_property_values().is_empty())
+        return nullptr;
+
+    if (rule_cache_prevents_style_sharing(rule_cache_for_cascade_origin(CascadeOrigin::UserAgent), element)
+        || rule_cache_prevents_style_sharing(rule_cache_for_cascade_origin(CascadeOrigin::User), element)
+        || rule_cache_prevents_style_sharing(rule_cache_for_cascade_origin(CascadeOrigin::Author), element))
+        return nullptr;
+
+    return candidate;
+}
+
 void StyleComputer::build_rule_cache_if_needed() const
 {
     if (m_author_rule_cache && m_user_rule_cache && m_user_agent_rule_cache)
@@ -2408,206 +2521,394 @@ static Optional<SimplifiedSelectorForBucketing> is_roundabout_selector_bucketabl
     return {};
 }
 
-NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_cascade_origin(CascadeOrigin cascade_origin)
+void StyleComputer::add_selector_to_invalidation_sets(CSS::Selector const& selector, bool is_pseudo_class_argument)
 {
-    auto rule_cache = make<RuleCache>();
+    auto const& compound_selectors = selector.compound_selectors();
+
+    // Descendants that could match the selector's subject have at least one of the subject's id, classes or tag name.
+    auto add_subject_to_descendant_features = [&](InvalidationSet& invalidation_set) {
+        auto const& subject = compound_selectors.last();
+        for (auto const& simple_selector : subject.simple_selectors) {
+            if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Id) {
+                invalidation_set.descendant_ids.set(simple_selector.name());
+                return;
+            }
+        }
+        for (auto const& simple_selector : subject.simple_selectors) {
+            if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Class) {
+                invalidation_set.descendant_classes.set(simple_selector.name());
+                return;
+            }
+        }
+        for (auto const& simple_selector : subject.simple_selectors) {
+            if (simple_selector.type == CSS::Selector::SimpleSelector::Type::TagName) {
+                invalidation_set.descendant_tag_names.set(simple_selector.qualified_name().name.lowercase_name);
+                return;
+            }
+        }
+        invalidation_set.invalidate_whole_subtree = true;
+    };
 
-    size_t num_class_rules = 0;
-    size_t num_id_rules = 0;
-    size_t num_tag_name_rules = 0;
-    size_t num_pseudo_element_rules = 0;
-    size_t num_root_rules = 0;
-    size_t num_attribute_rules = 0;
-    size_t num_hover_rules = 0;
+    for (size_t compound_index = 0; compound_index < compound_selectors.size(); ++compound_index) {
+        bool is_subject = compound_index == compound_selectors.size() - 1;
+
+        // Figure out how an element matching this compound relates to the selector's subject.
+        bool crosses_sibling_combinator = false;
+        bool crosses_descendant_combinator = false;
+        for (size_t i = compound_index + 1; i < compound_selectors.size(); ++i) {
+            switch (compound_selectors[i].combinator) {
+            case CSS::Selector::Combinator::ImmediateChild:
+            case CSS::Selector::Combinator::Descendant:
+                crosses_descendant_combinator = true;
+                break;
+            default:
+                crosses_sibling_combinator = true;
+                break;
+            }
+        }
 
-    Vector<MatchingRule> matching_rules;
-    size_t style_sheet_index = 0;
-    for_each_stylesheet(cascade_origin, [&](auto& sheet, JS::GCPtr<DOM::ShadowRoot> shadow_root) {
-        size_t rule_index = 0;
-        sheet.for_each_effective_style_rule([&](auto const& rule) {
-            size_t selector_index = 0;
-            for (CSS::Selector const& selector : rule.selectors()) {
-                MatchingRule matching_rule {
-                    shadow_root,
-                    &rule,
-                    sheet,
-                    style_sheet_index,
-                    rule_index,
-                    selector_index,
-                    selector.specificity(),
-                    cascade_origin,
-                    false,
-                    SelectorEngine::can_use_fast_matches(selector),
-                    false,
-                };
-
-                bool contains_root_pseudo_class = false;
-                Optional<CSS::Selector::PseudoElement::Type> pseudo_element;
-
-                for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
-                    if (!rule_cache->has_has_selectors && simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass && simple_selector.pseudo_class().type == CSS::PseudoClass::Has)
-                        rule_cache->has_has_selectors = true;
-                    if (!matching_rule.contains_pseudo_element) {
-                        if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoElement) {
-                            matching_rule.contains_pseudo_element = true;
-                            pseudo_element = simple_selector.pseudo_element().type();
-                            ++num_pseudo_element_rules;
-                        }
+        for (auto const& simple_selector : compound_selectors[compound_index].simple_selectors) {
+            if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Attribute) {
+                auto const& attribute_name = simple_selector.attribute().qualified_name.name.lowercase_name;
+                if (attribute_name == HTML::AttributeNames::class_ || attribute_name == HTML::AttributeNames::id)
+                    m_has_attribute_selectors_for_class_or_id = true;
+                continue;
+            }
+
+            if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass) {
+                for (auto const& argument_selector : simple_selector.pseudo_class().argument_selector_list)
+                    add_selector_to_invalidation_sets(*argument_selector, true);
+                continue;
+            }
+
+            InvalidationSet* invalidation_set = nullptr;
+            if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Class)
+                invalidation_set = &m_class_invalidation_sets.ensure(simple_selector.name());
+            else if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Id)
+                invalidation_set = &m_id_invalidation_sets.ensure(simple_selector.name());
+            else
+                continue;
+
+            // We don't track where a pseudo-class argument sits in its outer selector, and things like
+            // :nth-last-child(of .foo) depend on preceding siblings too, so restyle everything below the parent.
+            if (is_pseudo_class_argument) {
+                invalidation_set->invalidate_parent_subtree = true;
+                continue;
+            }
+
+            if (is_subject) {
+                invalidation_set->invalidate_self = true;
+            } else if (crosses_sibling_combinator) {
+                invalidation_set->invalidate_subsequent_siblings = true;
+                if (crosses_descendant_combinator)
+                    invalidation_set->invalidate_whole_subtree = true;
+            } else {
+                add_subject_to_descendant_features(*invalidation_set);
+            }
+        }
+    }
+}
+
+bool StyleComputer::can_use_invalidation_sets() const
+{
+    build_rule_cache_if_needed();
+    return !m_has_has_selectors && !m_has_attribute_selectors_for_class_or_id;
+}
+
+StyleComputer::InvalidationSet const* StyleComputer::invalidation_set_for_class(FlyString const& class_name) const
+{
+    build_rule_cache_if_needed();
+    auto it = m_class_invalidation_sets.find(class_name);
+    if (it == m_class_invalidation_sets.end())
+        return nullptr;
+    return &it->value;
+}
+
+StyleComputer::InvalidationSet const* StyleComputer::invalidation_set_for_id(FlyString const& id) const
+{
+    build_rule_cache_if_needed();
+    auto it = m_id_invalidation_sets.find(id);
+    if (it == m_id_invalidation_sets.end())
+        return nullptr;
+    return &it->value;
+}
+
+// Returns true if `selector` could match only one of two siblings that have identical attributes and interaction state.
+// Combinators that lead to ancestors are fine, since siblings share all of their ancestors.
+static bool selector_prevents_style_sharing(CSS::Selector const& selector)
+{
+    auto const& subject = selector.compound_selectors().last();
+    if (first_is_one_of(subject.combinator, CSS::Selector::Combinator::NextSibling, CSS::Selector::Combinator::SubsequentSibling, CSS::Selector::Combinator::Column))
+        return true;
+
+    for (auto const& simple_selector : subject.simple_selectors) {
+        if (simple_selector.type != CSS::Selector::SimpleSelector::Type::PseudoClass)
+            continue;
+        auto const& pseudo_class = simple_selector.pseudo_class();
+        switch (pseudo_class.type) {
+        // Interaction state is checked for both elements before sharing.
+        case CSS::PseudoClass::Active:
+        case CSS::PseudoClass::Focus:
+        case CSS::PseudoClass::FocusVisible:
+        case CSS::PseudoClass::FocusWithin:
+        case CSS::PseudoClass::Hover:
+        case CSS::PseudoClass::Target:
+        case CSS::PseudoClass::TargetWithin:
+        // These only depend on the element's attributes and ancestors.
+        case CSS::PseudoClass::AnyLink:
+        case CSS::PseudoClass::Lang:
+        case CSS::PseudoClass::Link:
+        case CSS::PseudoClass::LocalLink:
+        case CSS::PseudoClass::Root:
+        case CSS::PseudoClass::Visited:
+            break;
+        case CSS::PseudoClass::Is:
+        case CSS::PseudoClass::Not:
+        case CSS::PseudoClass::Where:
+            for (auto const& argument_selector : pseudo_class.argument_selector_list) {
+                if (selector_prevents_style_sharing(*argument_selector))
+                    return true;
+            }
+            break;
+        default:
+            // Structural pseudo-classes (:first-child, :nth-of-type(), :empty, :has(), ...) and element state
+            // (:checked, :disabled, :open, ...) can differ between otherwise identical siblings.
+            return true;
+        }
+    }
+    return false;
+}
+
+void StyleComputer::add_style_sheet_to_rule_cache(RuleCache& rule_cache, CascadeOrigin cascade_origin, CSSStyleSheet const& sheet, JS::GCPtr<DOM::ShadowRoot> shadow_root)
+{
+    // NOTE: Style sheet indices only have to order the sheets, so removing a sheet leaves a gap instead of renumbering.
+    size_t style_sheet_index = rule_cache.next_style_sheet_index++;
+    auto& style_sheet_rules = rule_cache.rules_by_style_sheet.ensure(&sheet);
+
+    size_t rule_index = 0;
+    sheet.for_each_effective_style_rule([&](auto const& rule) {
+        size_t selector_index = 0;
+        for (CSS::Selector const& selector : rule.selectors()) {
+            SelectorEngine::CompiledSelector const* compiled_selector = nullptr;
+            if (auto compiled = SelectorEngine::CompiledSelector::compile(selector)) {
+                compiled_selector = compiled.ptr();
+                style_sheet_rules.compiled_selectors.append(compiled.release_nonnull());
+            }
+
+            MatchingRule matching_rule {
+                shadow_root,
+                &rule,
+                sheet,
+                style_sheet_index,
+                rule_index,
+                selector_index,
+                selector.specificity(),
+                cascade_origin,
+                false,
+                compiled_selector,
+                false,
+            };
+
+            bool contains_root_pseudo_class = false;
+            Optional<CSS::Selector::PseudoElement::Type> pseudo_element;
+            bool prevents_style_sharing = selector_prevents_style_sharing(selector);
+            add_selector_to_invalidation_sets(selector);
+
+            for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
+                if (!rule_cache.has_has_selectors && simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass && simple_selector.pseudo_class().type == CSS::PseudoClass::Has)
+                    rule_cache.has_has_selectors = true;
+                if (!matching_rule.contains_pseudo_element) {
+                    if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoElement) {
+                        matching_rule.contains_pseudo_element = true;
+                        pseudo_element = simple_selector.pseudo_element().type();
                     }
-                    if (!contains_root_pseudo_class) {
-                        if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass
-                            && simple_selector.pseudo_class().type == CSS::PseudoClass::Root) {
-                            contains_root_pseudo_class = true;
-                            ++num_root_rules;
-                        }
+                }
+                if (!contains_root_pseudo_class) {
+                    if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass
+                        && simple_selector.pseudo_class().type == CSS::PseudoClass::Root) {
+                        contains_root_pseudo_class = true;
                     }
+                }
 
-                    if (!matching_rule.must_be_hovered) {
-                        if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass && simple_selector.pseudo_class().type == CSS::PseudoClass::Hover) {
-                            matching_rule.must_be_hovered = true;
-                            ++num_hover_rules;
-                        }
-                        if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass
-                            && (simple_selector.pseudo_class().type == CSS::PseudoClass::Is
-                                || simple_selector.pseudo_class().type == CSS::PseudoClass::Where)) {
-                            auto const& argument_selectors = simple_selector.pseudo_class().argument_selector_list;
-
-                            if (argument_selectors.size() == 1) {
-                                auto const& simple_argument_selector = argument_selectors.first()->compound_selectors().last().simple_selectors.last();
-                                if (simple_argument_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass
-                                    && simple_argument_selector.pseudo_class().type == CSS::PseudoClass::Hover) {
-                                    matching_rule.must_be_hovered = true;
-                                    ++num_hover_rules;
-                                }
+                if (!matching_rule.must_be_hovered) {
+                    if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass && simple_selector.pseudo_class().type == CSS::PseudoClass::Hover) {
+                        matching_rule.must_be_hovered = true;
+                    }
+                    if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass
+                        && (simple_selector.pseudo_class().type == CSS::PseudoClass::Is
+                            || simple_selector.pseudo_class().type == CSS::PseudoClass::Where)) {
+                        auto const& argument_selectors = simple_selector.pseudo_class().argument_selector_list;
+
+                        if (argument_selectors.size() == 1) {
+                            auto const& simple_argument_selector = argument_selectors.first()->compound_selectors().last().simple_selectors.last();
+                            if (simple_argument_selector.type == CSS::Selector::SimpleSelector::Type::PseudoClass
+                                && simple_argument_selector.pseudo_class().type == CSS::PseudoClass::Hover) {
+                                matching_rule.must_be_hovered = true;
                             }
                         }
                     }
                 }
+            }
+
+            // NOTE: We traverse the simple selectors in reverse order to make sure that class/ID buckets are preferred over tag buckets
+            //       in the common case of div.foo or div#foo selectors.
+            bool added_to_bucket = false;
 
-                // NOTE: We traverse the simple selectors in reverse order to make sure that class/ID buckets are preferred over tag buckets
-                //       in the common case of div.foo or div#foo selectors.
-                bool added_to_bucket = false;
-
-                auto add_to_id_bucket = [&](FlyString const& name) {
-                    rule_cache->rules_by_id.ensure(name).append(move(matching_rule));
-                    ++num_id_rules;
-                    added_to_bucket = true;
-                };
-
-                auto add_to_class_bucket = [&](FlyString const& name) {
-                    rule_cache->rules_by_class.ensure(name).append(move(matching_rule));
-                    ++num_class_rules;
-                    added_to_bucket = true;
-                };
-
-                auto add_to_tag_name_bucket = [&](FlyString const& name) {
-                    rule_cache->rules_by_tag_name.ensure(name).append(move(matching_rule));
-                    ++num_tag_name_rules;
-                    added_to_bucket = true;
-                };
-
-                for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors.in_reverse()) {
-                    if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Id) {
-                        add_to_id_bucket(simple_selector.name());
+            auto add_to_id_bucket = [&](FlyString const& name) {
+                rule_cache.rules_by_id.ensure(name).append(move(matching_rule));
+                if (prevents_style_sharing)
+                    rule_cache.ids_preventing_style_sharing.set(name);
+                style_sheet_rules.ids.set(name);
+                added_to_bucket = true;
+            };
+
+            auto add_to_class_bucket = [&](FlyString const& name) {
+                rule_cache.rules_by_class.ensure(name).append(move(matching_rule));
+                if (prevents_style_sharing)
+                    rule_cache.classes_preventing_style_sharing.set(name);
+                style_sheet_rules.classes.set(name);
+                added_to_bucket = true;
+            };
+
+            auto add_to_tag_name_bucket = [&](FlyString const& name) {
+                rule_cache.rules_by_tag_name.ensure(name).append(move(matching_rule));
+                if (prevents_style_sharing)
+                    rule_cache.tag_names_preventing_style_sharing.set(name);
+                style_sheet_rules.tag_names.set(name);
+                added_to_bucket = true;
+            };
+
+            for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors.in_reverse()) {
+                if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Id) {
+                    add_to_id_bucket(simple_selector.name());
+                    break;
+                }
+                if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Class) {
+                    add_to_class_bucket(simple_selector.name());
+                    break;
+                }
+                if (simple_selector.type == CSS::Selector::SimpleSelector::Type::TagName) {
+                    add_to_tag_name_bucket(simple_selector.qualified_name().name.lowercase_name);
+                    break;
+                }
+                // NOTE: Selectors like `:is/where(.foo)` and `:is/where(.foo .bar)` are bucketed as class selectors for `foo` and `bar` respectively.
+                if (auto simplified = is_roundabout_selector_bucketable_as_something_simpler(simple_selector); simplified.has_value()) {
+                    if (simplified->type == CSS::Selector::SimpleSelector::Type::TagName) {
+                        add_to_tag_name_bucket(simplified->name);
                         break;
                     }
-                    if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Class) {
-                        add_to_class_bucket(simple_selector.name());
+                    if (simplified->type == CSS::Selector::SimpleSelector::Type::Class) {
+                        add_to_class_bucket(simplified->name);
                         break;
                     }
-                    if (simple_selector.type == CSS::Selector::SimpleSelector::Type::TagName) {
-                        add_to_tag_name_bucket(simple_selector.qualified_name().name.lowercase_name);
+                    if (simplified->type == CSS::Selector::SimpleSelector::Type::Id) {
+                        add_to_id_bucket(simplified->name);
                         break;
                     }
-                    // NOTE: Selectors like `:is/where(.foo)` and `:is/where(.foo .bar)` are bucketed as class selectors for `foo` and `bar` respectively.
-                    if (auto simplified = is_roundabout_selector_bucketable_as_something_simpler(simple_selector); simplified.has_value()) {
-                        if (simplified->type == CSS::Selector::SimpleSelector::Type::TagName) {
-                            add_to_tag_name_bucket(simplified->name);
-                            break;
-                        }
-                        if (simplified->type == CSS::Selector::SimpleSelector::Type::Class) {
-                            add_to_class_bucket(simplified->name);
-                            break;
-                        }
-                        if (simplified->type == CSS::Selector::SimpleSelector::Type::Id) {
-                            add_to_id_bucket(simplified->name);
-                            break;
-                        }
-                    }
                 }
-                if (!added_to_bucket) {
-                    if (matching_rule.contains_pseudo_element) {
-                        if (to_underlying(pseudo_element.value()) < to_underlying(CSS::Selector::PseudoElement::Type::KnownPseudoElementCount)) {
-                            rule_cache->rules_by_pseudo_element[to_underlying(pseudo_element.value())].append(move(matching_rule));
-                        } else {
-                            // NOTE: We don't cache rules for unknown pseudo-elements. They can't match anything anyway.
-                        }
-                    } else if (contains_root_pseudo_class) {
-                        rule_cache->root_rules.append(move(matching_rule));
+            }
+            if (!added_to_bucket) {
+                if (matching_rule.contains_pseudo_element) {
+                    if (to_underlying(pseudo_element.value()) < to_underlying(CSS::Selector::PseudoElement::Type::KnownPseudoElementCount)) {
+                        rule_cache.rules_by_pseudo_element[to_underlying(pseudo_element.value())].append(move(matching_rule));
+                        style_sheet_rules.has_pseudo_element_rules = true;
                     } else {
-                        for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
-                            if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Attribute) {
-                                rule_cache->rules_by_attribute_name.ensure(simple_selector.attribute().qualified_name.name.lowercase_name).append(move(matching_rule));
-                                ++num_attribute_rules;
-                                added_to_bucket = true;
-                                break;
-                            }
-                        }
-                        if (!added_to_bucket) {
-                            rule_cache->other_rules.append(move(matching_rule));
+                        // NOTE: We don't cache rules for unknown pseudo-elements. They can't match anything anyway.
+                    }
+                } else if (contains_root_pseudo_class) {
+                    rule_cache.root_rules.append(move(matching_rule));
+                    style_sheet_rules.has_root_rules = true;
+                } else {
+                    for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
+                        if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Attribute) {
+                            auto const& attribute_name = simple_selector.attribute().qualified_name.name.lowercase_name;
+                            rule_cache.rules_by_attribute_name.ensure(attribute_name).append(move(matching_rule));
+                            if (prevents_style_sharing)
+                                rule_cache.attribute_names_preventing_style_sharing.set(attribute_name);
+                            style_sheet_rules.attribute_names.set(attribute_name);
+                            added_to_bucket = true;
+                            break;
                         }
                     }
+                    if (!added_to_bucket) {
+                        rule_cache.other_rules.append(move(matching_rule));
+                        style_sheet_rules.has_other_rules = true;
+                        if (prevents_style_sharing)
+                            rule_cache.other_rules_prevent_style_sharing = true;
+                    }
                 }
-
-                ++selector_index;
             }
-            ++rule_index;
-        });
 
-        // Loosely based on https://drafts.csswg.org/css-animations-2/#keyframe-processing
-        sheet.for_each_effective_keyframes_at_rule([&](CSSKeyframesRule const& rule) {
-            auto keyframe_set = adopt_ref(*new Animations::KeyframeEffect::KeyFrameSet);
-            HashTable<PropertyID> animated_properties;
-
-            // Forwards pass, resolve all the user-specified keyframe properties.
-            for (auto const& keyframe_rule : *rule.css_rules()) {
-                auto const& keyframe = verify_cast<CSSKeyframeRule>(*keyframe_rule);
-                Animations::KeyframeEffect::KeyFrameSet::ResolvedKeyFrame resolved_keyframe;
-
-                auto key = static_cast<u64>(keyframe.key().value() * Animations::KeyframeEffect::AnimationKeyFrameKeyScaleFactor);
-                auto const& keyframe_style = *keyframe.style_as_property_owning_style_declaration();
-                for (auto const& it : keyframe_style.properties()) {
-                    // Unresolved properties will be resolved in collect_animation_into()
-                    for_each_property_expanding_shorthands(it.property_id, it.value, AllowUnresolved::Yes, [&](PropertyID shorthand_id, CSSStyleValue const& shorthand_value) {
-                        animated_properties.set(shorthand_id);
-                        resolved_keyframe.properties.set(shorthand_id, NonnullRefPtr<CSSStyleValue const> { shorthand_value });
-                    });
-                }
+            ++selector_index;
+        }
+        ++rule_index;
+    });
 
-                keyframe_set->keyframes_by_key.insert(key, resolved_keyframe);
+    // Loosely based on https://drafts.csswg.org/css-animations-2/#keyframe-processing
+    sheet.for_each_effective_keyframes_at_rule([&](CSSKeyframesRule const& rule) {
+        auto keyframe_set = adopt_ref(*new Animations::KeyframeEffect::KeyFrameSet);
+        HashTable<PropertyID> animated_properties;
+
+        // Forwards pass, resolve all the user-specified keyframe properties.
+        for (auto const& keyframe_rule : *rule.css_rules()) {
+            auto const& keyframe = verify_cast<CSSKeyframeRule>(*keyframe_rule);
+            Animations::KeyframeEffect::KeyFrameSet::ResolvedKeyFrame resolved_keyframe;
+
+            auto key = static_cast<u64>(keyframe.key().value() * Animations::KeyframeEffect::AnimationKeyFrameKeyScaleFactor);
+            auto const& keyframe_style = *keyframe.style_as_property_owning_style_declaration();
+            for (auto const& it : keyframe_style.properties()) {
+                // Unresolved properties will be resolved in collect_animation_into()
+                for_each_property_expanding_shorthands(it.property_id, it.value, AllowUnresolved::Yes, [&](PropertyID shorthand_id, CSSStyleValue const& shorthand_value) {
+                    animated_properties.set(shorthand_id);
+                    resolved_keyframe.properties.set(shorthand_id, NonnullRefPtr<CSSStyleValue const> { shorthand_value });
+                });
             }
 
-            Animations::KeyframeEffect::generate_initial_and_final_frames(keyframe_set, animated_properties);
+            keyframe_set->keyframes_by_key.insert(key, resolved_keyframe);
+        }
 
-            if constexpr (LIBWEB_CSS_DEBUG) {
-                dbgln("Resolved keyframe set '{}' into {} keyframes:", rule.name(), keyframe_set->keyframes_by_key.size());
-                for (auto it = keyframe_set->keyframes_by_key.begin(); it != keyframe_set->keyframes_by_key.end(); ++it)
-                    dbgln("    - keyframe {}: {} properties", it.key(), it->properties.size());
-            }
+        Animations::KeyframeEffect::generate_initial_and_final_frames(keyframe_set, animated_properties);
 
-            rule_cache->rules_by_animation_keyframes.set(rule.name(), move(keyframe_set));
-        });
-        ++style_sheet_index;
+        if constexpr (LIBWEB_CSS_DEBUG) {
+            dbgln("Resolved keyframe set '{}' into {} keyframes:", rule.name(), keyframe_set->keyframes_by_key.size());
+            for (auto it = keyframe_set->keyframes_by_key.begin(); it != keyframe_set->keyframes_by_key.end(); ++it)
+                dbgln("    - keyframe {}: {} properties", it.key(), it->properties.size());
+        }
+
+        rule_cache.rules_by_animation_keyframes.set(rule.name(), move(keyframe_set));
+        style_sheet_rules.has_keyframes = true;
+    });
+}
+
+NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_cascade_origin(CascadeOrigin cascade_origin)
+{
+    auto rule_cache = make<RuleCache>();
+
+    for_each_stylesheet(cascade_origin, [&](auto& sheet, JS::GCPtr<DOM::ShadowRoot> shadow_root) {
+        add_style_sheet_to_rule_cache(*rule_cache, cascade_origin, sheet, shadow_root);
     });
 
-    size_t total_rules = num_class_rules + num_id_rules + num_tag_name_rules + num_pseudo_element_rules + num_root_rules + num_attribute_rules + rule_cache->other_rules.size();
     if constexpr (LIBWEB_CSS_DEBUG) {
+        auto count_rules = [](auto const& rules_by_name) {
+            size_t count = 0;
+            for (auto const& it : rules_by_name)
+                count += it.value.size();
+            return count;
+        };
+        size_t num_pseudo_element_rules = 0;
+        for (auto const& rules : rule_cache->rules_by_pseudo_element)
+            num_pseudo_element_rules += rules.size();
+        size_t num_id_rules = count_rules(rule_cache->rules_by_id);
+        size_t num_class_rules = count_rules(rule_cache->rules_by_class);
+        size_t num_tag_name_rules = count_rules(rule_cache->rules_by_tag_name);
+        size_t num_attribute_rules = count_rules(rule_cache->rules_by_attribute_name);
+        size_t total_rules = num_class_rules + num_id_rules + num_tag_name_rules + num_pseudo_element_rules + rule_cache->root_rules.size() + num_attribute_rules + rule_cache->other_rules.size();
         dbgln("Built rule cache!");
         dbgln("           ID: {}", num_id_rules);
         dbgln("        Class: {}", num_class_rules);
         dbgln("      TagName: {}", num_tag_name_rules);
         dbgln("PseudoElement: {}", num_pseudo_element_rules);
-        dbgln("         Root: {}", num_root_rules);
+        dbgln("         Root: {}", rule_cache->root_rules.size());
         dbgln("    Attribute: {}", num_attribute_rules);
         dbgln("        Other: {}", rule_cache->other_rules.size());
         dbgln("        Total: {}", total_rules);
@@ -2615,6 +2916,38 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
     return rule_cache;
 }
 
+// NOTE: The UA style sheets are parsed once and shared by every document in the process, and their media queries are
+//       never evaluated against a document, so which of their rules are in effect only depends on quirks mode.
+//       That means we only have to build their rule cache once per process for each mode, instead of for every document
+//       and every time a document's author style sheets change.
+void StyleComputer::use_shared_user_agent_rule_cache()
+{
+    struct SharedUserAgentRuleCache {
+        NonnullOwnPtr<RuleCache> rule_cache;
+        HashMap<FlyString, InvalidationSet> class_invalidation_sets;
+        HashMap<FlyString, InvalidationSet> id_invalidation_sets;
+        bool has_attribute_selectors_for_class_or_id { false };
+    };
+    static OwnPtr<SharedUserAgentRuleCache> s_rule_cache;
+    static OwnPtr<SharedUserAgentRuleCache> s_quirks_mode_rule_cache;
+
+    auto& shared_rule_cache = document().in_quirks_mode() ? s_quirks_mode_rule_cache : s_rule_cache;
+    if (!shared_rule_cache) {
+        m_has_attribute_selectors_for_class_or_id = false;
+        m_class_invalidation_sets.clear();
+        m_id_invalidation_sets.clear();
+
+        auto rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::UserAgent);
+        shared_rule_cache = make<SharedUserAgentRuleCache>(move(rule_cache), m_class_invalidation_sets, m_id_invalidation_sets, m_has_attribute_selectors_for_class_or_id);
+    } else {
+        m_has_attribute_selectors_for_class_or_id = shared_rule_cache->has_attribute_selectors_for_class_or_id;
+        m_class_invalidation_sets = shared_rule_cache->class_invalidation_sets;
+        m_id_invalidation_sets = shared_rule_cache->id_invalidation_sets;
+    }
+
+    m_user_agent_rule_cache = shared_rule_cache->rule_cache.ptr();
+}
+
 struct LayerNode {
     OrderedHashMap<FlyString, LayerNode> children {};
 };
@@ -2691,9 +3024,11 @@ void StyleComputer::build_rule_cache()
 
     build_qualified_layer_names_cache();
 
+    // NOTE: This resets the invalidation sets to what the UA style sheets contribute, so it has to come first.
+    use_shared_user_agent_rule_cache();
+
     m_author_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::Author);
     m_user_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::User);
-    m_user_agent_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::UserAgent);
 
     m_has_has_selectors = m_author_rule_cache->has_has_selectors || m_user_rule_cache->has_has_selectors || m_user_agent_rule_cache->has_has_selectors;
 }
@@ -2708,11 +3043,95 @@ void StyleComputer::invalidate_rule_cache()
     m_user_rule_cache = nullptr;
     m_user_style_sheet = nullptr;
 
-    // NOTE: It might not be necessary to throw away the UA rule cache.
-    //       If we are sure that it's safe, we could keep it as an optimization.
+    // NOTE: The UA rule cache doesn't change, but we pick it up again in case we've switched in or out of quirks mode.
     m_user_agent_rule_cache = nullptr;
 }
 
+static bool style_sheet_declares_layers(CSSStyleSheet const& sheet)
+{
+    bool declares_layers = false;
+    sheet.for_each_effective_rule(TraversalOrder::Preorder, [&](CSSRule const& rule) {
+        if (rule.type() == CSSRule::Type::LayerBlock || rule.type() == CSSRule::Type::LayerStatement)
+            declares_layers = true;
+    });
+    return declares_layers;
+}
+
+// NOTE: Scripts often add and remove small style sheets at runtime. Instead of rebuilding the author rule cache from
+//       every style sheet each time, we try to patch the sheet's rules into or out of the existing cache.
+void StyleComputer::did_add_style_sheet(CSSStyleSheet const& sheet)
+{
+    if (!m_author_rule_cache)
+        return;
+
+    // The new sheet's rules have to be ordered after those of every other sheet, so we can only append them if it's
+    // the last sheet we'd visit when building the cache from scratch.
+    CSSStyleSheet const* last_sheet = nullptr;
+    JS::GCPtr<DOM::ShadowRoot> last_shadow_root;
+    for_each_stylesheet(CascadeOrigin::Author, [&](auto& each_sheet, JS::GCPtr<DOM::ShadowRoot> shadow_root) {
+        last_sheet = &each_sheet;
+        last_shadow_root = shadow_root;
+    });
+
+    // Layers are ordered by their first declaration across all sheets, so a sheet declaring them can reorder everything.
+    if (last_sheet != &sheet || m_author_rule_cache->rules_by_style_sheet.contains(&sheet) || style_sheet_declares_layers(sheet)) {
+        invalidate_rule_cache();
+        return;
+    }
+
+    add_style_sheet_to_rule_cache(*m_author_rule_cache, CascadeOrigin::Author, sheet, last_shadow_root);
+    m_has_has_selectors = m_has_has_selectors || m_author_rule_cache->has_has_selectors;
+}
+
+void StyleComputer::did_remove_style_sheet(CSSStyleSheet const& sheet)
+{
+    if (!m_author_rule_cache)
+        return;
+
+    auto style_sheet_rules = m_author_rule_cache->rules_by_style_sheet.find(&sheet);
+    if (style_sheet_rules == m_author_rule_cache->rules_by_style_sheet.end()) {
+        // NOTE: The sheet wasn't active when we built the cache, so none of its rules are in there.
+        return;
+    }
+
+    // An earlier sheet may define keyframes with the same name, and we don't keep those around.
+    if (style_sheet_rules->value.has_keyframes || style_sheet_declares_layers(sheet)) {
+        invalidate_rule_cache();
+        return;
+    }
+
+    auto remove_rules_from_sheet = [&](Vector<MatchingRule>& rules) {
+        rules.remove_all_matching([&](MatchingRule const& rule) { return rule.sheet.ptr() == &sheet; });
+    };
+    auto remove_rules_from_buckets = [&](auto& rules_by_name, auto const& names) {
+        for (auto const& name : names) {
+            auto bucket = rules_by_name.find(name);
+            if (bucket == rules_by_name.end())
+                continue;
+            remove_rules_from_sheet(bucket->value);
+            if (bucket->value.is_empty())
+                rules_by_name.remove(bucket);
+        }
+    };
+
+    // NOTE: We leave the style sharing and invalidation bookkeeping alone, since being too conservative there is fine.
+    auto& rule_cache = *m_author_rule_cache;
+    remove_rules_from_buckets(rule_cache.rules_by_id, style_sheet_rules->value.ids);
+    remove_rules_from_buckets(rule_cache.rules_by_class, style_sheet_rules->value.classes);
+    remove_rules_from_buckets(rule_cache.rules_by_tag_name, style_sheet_rules->value.tag_names);
+    remove_rules_from_buckets(rule_cache.rules_by_attribute_name, style_sheet_rules->value.attribute_names);
+    if (style_sheet_rules->value.has_pseudo_element_rules) {
+        for (auto& rules : rule_cache.rules_by_pseudo_element)
+            remove_rules_from_sheet(rules);
+    }
+    if (style_sheet_rules->value.has_root_rules)
+        remove_rules_from_sheet(rule_cache.root_rules);
+    if (style_sheet_rules->value.has_other_rules)
+        remove_rules_from_sheet(rule_cache.other_rules);
+
+    rule_cache.rules_by_style_sheet.remove(style_sheet_rules);
+}
+
 void StyleComputer::did_load_font(FlyString const&)
 {
     document().invalidate_style(DOM::StyleInvalidationReason::CSSFontLoaded);
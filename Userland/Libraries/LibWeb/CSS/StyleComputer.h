@@ -20,6 +20,10 @@
 #include <LibWeb/Forward.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 
+namespace Web::SelectorEngine {
+class CompiledSelector;
+}
+
 namespace Web::CSS {
 
 // A counting bloom filter with 2 hash functions.
@@ -91,7 +95,8 @@ struct MatchingRule {
     u32 specificity { 0 };
     CascadeOrigin cascade_origin;
     bool contains_pseudo_element { false };
-    bool can_use_fast_matches { false };
+    // Null if the selector has to go through the general SelectorEngine::matches().
+    SelectorEngine::CompiledSelector const* compiled_selector { nullptr };
     bool must_be_hovered { false };
     bool skip { false };
 };
@@ -137,6 +142,8 @@ public:
     Vector<MatchingRule> collect_matching_rules(DOM::Element const&, CascadeOrigin, Optional<CSS::Selector::PseudoElement::Type>, FlyString const& qualified_layer_name = {}) const;
 
     void invalidate_rule_cache();
+    void did_add_style_sheet(CSSStyleSheet const&);
+    void did_remove_style_sheet(CSSStyleSheet const&);
 
     Gfx::Font const& initial_font() const;
 
@@ -161,6 +168,40 @@ public:
 
     size_t number_of_css_font_faces_with_loading_in_progress() const;
 
+    struct StyleSharingStatistics {
+        size_t hits { 0 };
+        size_t misses { 0 };
+    };
+
+    // Style sharing is only enabled while the document walks its tree to update style, since that's when we know
+    // that a sibling's computed style is up to date.
+    void begin_style_sharing();
+    void end_style_sharing();
+    StyleSharingStatistics const& style_sharing_statistics() const { return m_style_sharing_statistics; }
+
+    // Describes which elements may start or stop matching some selector when a class name or id is added to or removed
+    // from an element. Built alongside the rule caches.
+    struct InvalidationSet {
+        // The element itself (and therefore everything that inherits from it).
+        bool invalidate_self { false };
+        // The element's subsequent siblings, through `+` and `~`.
+        bool invalidate_subsequent_siblings { false };
+        // Descendants of the element. If we don't know what they look like, we have to restyle the whole subtree,
+        // otherwise only descendants with one of these ids, classes or tag names.
+        bool invalidate_whole_subtree { false };
+        HashTable<FlyString> descendant_ids;
+        HashTable<FlyString> descendant_classes;
+        HashTable<FlyString, AK::ASCIICaseInsensitiveFlyStringTraits> descendant_tag_names;
+        // The parent and everything below it, for selectors we can't reason about more precisely.
+        bool invalidate_parent_subtree { false };
+    };
+
+    // Returns false if changes to classes and ids have to invalidate conservatively, e.g. because of :has().
+    [[nodiscard]] bool can_use_invalidation_sets() const;
+    // Returns nullptr if no selector mentions the class or id, in which case changing it can't affect style.
+    [[nodiscard]] InvalidationSet const* invalidation_set_for_class(FlyString const&) const;
+    [[nodiscard]] InvalidationSet const* invalidation_set_for_id(FlyString const&) const;
+
 private:
     enum class ComputeStyleMode {
         Normal,
@@ -227,17 +268,51 @@ private:
 
         HashMap<FlyString, NonnullRefPtr<Animations::KeyframeEffect::KeyFrameSet>> rules_by_animation_keyframes;
 
+        // What each style sheet contributed to the buckets above, so that it can be removed again without rebuilding.
+        struct StyleSheetRules {
+            // Owns the compiled form of the sheet's selectors, pointed to by MatchingRule::compiled_selector.
+            Vector<NonnullOwnPtr<SelectorEngine::CompiledSelector>> compiled_selectors;
+            HashTable<FlyString> ids;
+            HashTable<FlyString> classes;
+            HashTable<FlyString> tag_names;
+            HashTable<FlyString, AK::ASCIICaseInsensitiveFlyStringTraits> attribute_names;
+            bool has_pseudo_element_rules { false };
+            bool has_root_rules { false };
+            bool has_other_rules { false };
+            bool has_keyframes { false };
+        };
+        HashMap<CSSStyleSheet const*, StyleSheetRules> rules_by_style_sheet;
+        size_t next_style_sheet_index { 0 };
+
         bool has_has_selectors { false };
+
+        // Buckets holding a rule whose subject depends on more than the element's own attributes and its ancestors,
+        // e.g. `li:first-child` or `.foo + li`. Elements that look into any of these buckets never share style.
+        HashTable<FlyString> ids_preventing_style_sharing;
+        HashTable<FlyString> classes_preventing_style_sharing;
+        HashTable<FlyString> tag_names_preventing_style_sharing;
+        HashTable<FlyString, AK::ASCIICaseInsensitiveFlyStringTraits> attribute_names_preventing_style_sharing;
+        bool other_rules_prevent_style_sharing { false };
     };
 
     NonnullOwnPtr<RuleCache> make_rule_cache_for_cascade_origin(CascadeOrigin);
+    void use_shared_user_agent_rule_cache();
+    void add_style_sheet_to_rule_cache(RuleCache&, CascadeOrigin, CSSStyleSheet const&, JS::GCPtr<DOM::ShadowRoot>);
+    void add_selector_to_invalidation_sets(Selector const&, bool is_pseudo_class_argument = false);
 
     RuleCache const& rule_cache_for_cascade_origin(CascadeOrigin) const;
 
+    [[nodiscard]] DOM::Element const* find_element_to_share_style_with(DOM::Element const&) const;
+    [[nodiscard]] bool rule_cache_prevents_style_sharing(RuleCache const&, DOM::Element const&) const;
+
     bool m_has_has_selectors { false };
+    bool m_has_attribute_selectors_for_class_or_id { false };
+    HashMap<FlyString, InvalidationSet> m_class_invalidation_sets;
+    HashMap<FlyString, InvalidationSet> m_id_invalidation_sets;
     OwnPtr<RuleCache> m_author_rule_cache;
     OwnPtr<RuleCache> m_user_rule_cache;
-    OwnPtr<RuleCache> m_user_agent_rule_cache;
+    // Owned by the process, see use_shared_user_agent_rule_cache().
+    RuleCache const* m_user_agent_rule_cache { nullptr };
     JS::Handle<CSSStyleSheet> m_user_style_sheet;
 
     using FontLoaderList = Vector<NonnullOwnPtr<FontLoader>>;
@@ -249,6 +324,10 @@ private:
     CSSPixelRect m_viewport_rect;
 
     CountingBloomFilter<u8, 14> m_ancestor_filter;
+
+    bool m_style_sharing_enabled { false };
+    mutable HashTable<DOM::Element const*> m_elements_with_shareable_style;
+    mutable StyleSharingStatistics m_style_sharing_statistics;
 };
 
 class FontLoader : public ResourceClient {
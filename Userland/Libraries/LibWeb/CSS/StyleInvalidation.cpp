@@ -13,7 +13,8 @@ RequiredInvalidationAfterStyleChange compute_property_invalidation(CSS::Property
 {
     RequiredInvalidationAfterStyleChange invalidation;
 
-    bool const property_value_changed = (!old_value || !new_value) || *old_value != *new_value;
+    // NOTE: Common values are interned, so identical values are usually the very same object.
+    bool const property_value_changed = old_value != new_value && ((!old_value || !new_value) || *old_value != *new_value);
     if (!property_value_changed)
         return invalidation;
 
@@ -50,6 +51,12 @@ RequiredInvalidationAfterStyleChange compute_property_invalidation(CSS::Property
         if (old_value_opacity != new_value_opacity && (old_value_opacity == 1 || new_value_opacity == 1)) {
             invalidation.rebuild_stacking_context_tree = true;
         }
+    } else if (property_id == CSS::PropertyID::Transform && old_value && new_value) {
+        // OPTIMIZATION: Likewise, an element only starts or stops creating a stacking context when its transform
+        //               changes from or to `none`, so moving it around (e.g. in an animation) doesn't need a rebuild.
+        auto is_none = [](CSS::CSSStyleValue const& value) { return value.to_keyword() == CSS::Keyword::None; };
+        if (is_none(*old_value) != is_none(*new_value))
+            invalidation.rebuild_stacking_context_tree = true;
     } else if (CSS::property_affects_stacking_context(property_id)) {
         invalidation.rebuild_stacking_context_tree = true;
     }
@@ -43,7 +43,8 @@ NonnullRefPtr<StyleProperties::Data> StyleProperties::Data::clone() const
     auto clone = adopt_ref(*new StyleProperties::Data);
     clone->m_animation_name_source = m_animation_name_source;
     clone->m_transition_property_source = m_transition_property_source;
-    clone->m_property_values = m_property_values;
+    clone->m_inherited_property_values = m_inherited_property_values;
+    clone->m_non_inherited_property_values = m_non_inherited_property_values;
     clone->m_property_important = m_property_important;
     clone->m_property_inherited = m_property_inherited;
     clone->m_animated_property_values = m_animated_property_values;
@@ -60,6 +61,85 @@ NonnullRefPtr<StyleProperties> StyleProperties::clone() const
     return cloned;
 }
 
+size_t StyleProperties::memory_usage(HashTable<void const*>& seen_data) const
+{
+    size_t size = sizeof(StyleProperties);
+    auto add_unless_seen = [&](void const* data, size_t data_size) {
+        if (seen_data.set(data) == HashSetResult::InsertedNewEntry)
+            size += data_size;
+    };
+
+    auto const& data = m_data.value();
+    using AnimatedPropertyValues = decltype(data.m_animated_property_values);
+    auto animated_property_value_size = sizeof(AnimatedPropertyValues::KeyType) + sizeof(AnimatedPropertyValues::ValueType);
+    add_unless_seen(&data, sizeof(Data) + data.m_animated_property_values.capacity() * animated_property_value_size);
+
+    auto const& inherited_values = data.m_inherited_property_values.value();
+    add_unless_seen(&inherited_values, sizeof(inherited_values) + inherited_values.values.capacity() * sizeof(inherited_values.values[0]));
+
+    auto const& non_inherited_values = data.m_non_inherited_property_values.value();
+    add_unless_seen(&non_inherited_values, sizeof(non_inherited_values) + non_inherited_values.values.capacity() * sizeof(non_inherited_values.values[0]));
+
+    return size;
+}
+
+StyleProperties::PropertyGroupSlots const& StyleProperties::property_group_slots()
+{
+    static PropertyGroupSlots const property_group_slots = [] {
+        PropertyGroupSlots slots;
+        for (size_t i = 0; i < number_of_properties; ++i) {
+            if (is_inherited_property(static_cast<PropertyID>(i)))
+                slots.slots[i] = { PropertyGroup::Inherited, static_cast<u16>(slots.inherited_property_count++) };
+            else
+                slots.slots[i] = { PropertyGroup::NonInherited, static_cast<u16>(slots.non_inherited_property_count++) };
+        }
+        return slots;
+    }();
+    return property_group_slots;
+}
+
+size_t StyleProperties::property_count_in_group(PropertyGroup group)
+{
+    if (group == PropertyGroup::Inherited)
+        return property_group_slots().inherited_property_count;
+    return property_group_slots().non_inherited_property_count;
+}
+
+RefPtr<CSSStyleValue const> const& StyleProperties::property_value_slot(CSS::PropertyID property_id) const
+{
+    auto slot = property_group_slot(property_id);
+    if (slot.group == PropertyGroup::Inherited)
+        return m_data->m_inherited_property_values->values[slot.index];
+    return m_data->m_non_inherited_property_values->values[slot.index];
+}
+
+RefPtr<CSSStyleValue const>& StyleProperties::mutable_property_value_slot(CSS::PropertyID property_id)
+{
+    auto slot = property_group_slot(property_id);
+    if (slot.group == PropertyGroup::Inherited)
+        return m_data->m_inherited_property_values->values[slot.index];
+    return m_data->m_non_inherited_property_values->values[slot.index];
+}
+
+void StyleProperties::share_inherited_property_values_if_equal(StyleProperties const& other)
+{
+    auto const& own_values = m_data.value().m_inherited_property_values.value();
+    auto const& other_values = other.m_data->m_inherited_property_values.value();
+    if (&own_values == &other_values)
+        return;
+
+    for (size_t i = 0; i < own_values.values.size(); ++i) {
+        auto const& own_value = own_values.values[i];
+        auto const& other_value = other_values.values[i];
+        if (own_value == other_value)
+            continue;
+        if (!own_value || !other_value || !own_value->equals(*other_value))
+            return;
+    }
+
+    m_data->m_inherited_property_values = other.m_data->m_inherited_property_values;
+}
+
 bool StyleProperties::is_property_important(CSS::PropertyID property_id) const
 {
     size_t n = to_underlying(property_id);
@@ -92,14 +172,14 @@ void StyleProperties::set_property_inherited(CSS::PropertyID property_id, Inheri
 
 void StyleProperties::set_property(CSS::PropertyID id, NonnullRefPtr<CSSStyleValue const> value, Inherited inherited, Important important)
 {
-    m_data->m_property_values[to_underlying(id)] = move(value);
+    mutable_property_value_slot(id) = move(value);
     set_property_important(id, important);
     set_property_inherited(id, inherited);
 }
 
 void StyleProperties::revert_property(CSS::PropertyID id, StyleProperties const& style_for_revert)
 {
-    m_data->m_property_values[to_underlying(id)] = style_for_revert.m_data->m_property_values[to_underlying(id)];
+    mutable_property_value_slot(id) = style_for_revert.property_value_slot(id);
     set_property_important(id, style_for_revert.is_property_important(id) ? Important::Yes : Important::No);
     set_property_inherited(id, style_for_revert.is_property_inherited(id) ? Inherited::Yes : Inherited::No);
 }
@@ -122,14 +202,14 @@ NonnullRefPtr<CSSStyleValue const> StyleProperties::property(CSS::PropertyID pro
     }
 
     // By the time we call this method, all properties have values assigned.
-    return *m_data->m_property_values[to_underlying(property_id)];
+    return *property_value_slot(property_id);
 }
 
 RefPtr<CSSStyleValue const> StyleProperties::maybe_null_property(CSS::PropertyID property_id) const
 {
     if (auto animated_value = m_data->m_animated_property_values.get(property_id).value_or(nullptr))
         return *animated_value;
-    return m_data->m_property_values[to_underlying(property_id)];
+    return property_value_slot(property_id);
 }
 
 CSS::Size StyleProperties::size_value(CSS::PropertyID id) const
@@ -619,12 +699,9 @@ Optional<CSS::Positioning> StyleProperties::position() const
 
 bool StyleProperties::operator==(StyleProperties const& other) const
 {
-    if (m_data->m_property_values.size() != other.m_data->m_property_values.size())
-        return false;
-
-    for (size_t i = 0; i < m_data->m_property_values.size(); ++i) {
-        auto const& my_style = m_data->m_property_values[i];
-        auto const& other_style = other.m_data->m_property_values[i];
+    for (size_t i = 0; i < number_of_properties; ++i) {
+        auto const& my_style = property_value_slot(static_cast<PropertyID>(i));
+        auto const& other_style = other.property_value_slot(static_cast<PropertyID>(i));
         if (!my_style) {
             if (other_style)
                 return false;
@@ -830,6 +907,62 @@ StyleProperties::ContentDataAndQuoteNestingLevel StyleProperties::content(DOM::E
     return { {}, quote_nesting_level };
 }
 
+CSS::Containment StyleProperties::contain() const
+{
+    CSS::Containment containment;
+
+    auto apply_keyword = [&containment](Keyword keyword) {
+        switch (keyword_to_contain(keyword).value_or(CSS::Contain::None)) {
+        case CSS::Contain::None:
+            break;
+        case CSS::Contain::Strict:
+            containment.size_containment = true;
+            [[fallthrough]];
+        case CSS::Contain::Content:
+            containment.layout_containment = true;
+            containment.style_containment = true;
+            containment.paint_containment = true;
+            break;
+        case CSS::Contain::Size:
+            containment.size_containment = true;
+            break;
+        case CSS::Contain::Layout:
+            containment.layout_containment = true;
+            break;
+        case CSS::Contain::Style:
+            containment.style_containment = true;
+            break;
+        case CSS::Contain::Paint:
+            containment.paint_containment = true;
+            break;
+        }
+    };
+
+    auto value = property(CSS::PropertyID::Contain);
+    if (value->is_value_list()) {
+        for (auto const& item : value->as_value_list().values())
+            apply_keyword(item->to_keyword());
+    } else {
+        apply_keyword(value->to_keyword());
+    }
+    return containment;
+}
+
+CSS::ContainIntrinsicSize StyleProperties::contain_intrinsic_size(CSS::PropertyID property_id) const
+{
+    CSS::ContainIntrinsicSize contain_intrinsic_size;
+
+    auto value = property(property_id);
+    if (value->is_value_list()) {
+        // NOTE: The parser only produces lists for `auto <length>` and `auto none`.
+        contain_intrinsic_size.use_last_remembered_size = true;
+        value = value->as_value_list().values().last();
+    }
+    if (value->is_length())
+        contain_intrinsic_size.length = value->as_length().length();
+    return contain_intrinsic_size;
+}
+
 Optional<CSS::ContentVisibility> StyleProperties::content_visibility() const
 {
     auto value = property(CSS::PropertyID::ContentVisibility);
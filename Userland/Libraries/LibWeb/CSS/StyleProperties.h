@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/NonnullRefPtr.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/FontCascadeList.h>
@@ -24,6 +25,41 @@ public:
     static constexpr size_t number_of_properties = to_underlying(CSS::last_property_id) + 1;
 
 private:
+    // Computed values are split into a group for inherited and a group for non-inherited properties. Each group is
+    // copy-on-write on its own, so a copy of a StyleProperties only duplicates the group it actually modifies, and an
+    // element that doesn't change any inherited property can point at its parent's inherited values.
+    enum class PropertyGroup : u8 {
+        Inherited,
+        NonInherited,
+    };
+
+    struct PropertyGroupSlot {
+        PropertyGroup group;
+        u16 index;
+    };
+    struct PropertyGroupSlots {
+        Array<PropertyGroupSlot, number_of_properties> slots;
+        size_t inherited_property_count { 0 };
+        size_t non_inherited_property_count { 0 };
+    };
+    static PropertyGroupSlots const& property_group_slots();
+    static PropertyGroupSlot property_group_slot(CSS::PropertyID property_id) { return property_group_slots().slots[to_underlying(property_id)]; }
+    static size_t property_count_in_group(PropertyGroup);
+
+    template<PropertyGroup group>
+    struct PropertyValueGroup : public RefCounted<PropertyValueGroup<group>> {
+        PropertyValueGroup() { values.resize(property_count_in_group(group)); }
+
+        NonnullRefPtr<PropertyValueGroup> clone() const
+        {
+            auto clone = adopt_ref(*new PropertyValueGroup);
+            clone->values = values;
+            return clone;
+        }
+
+        Vector<RefPtr<CSSStyleValue const>> values;
+    };
+
     struct Data : public RefCounted<Data> {
         friend class StyleComputer;
 
@@ -33,7 +69,8 @@ private:
         JS::GCPtr<CSS::CSSStyleDeclaration const> m_animation_name_source;
         JS::GCPtr<CSS::CSSStyleDeclaration const> m_transition_property_source;
 
-        Array<RefPtr<CSSStyleValue const>, number_of_properties> m_property_values;
+        AK::CopyOnWrite<PropertyValueGroup<PropertyGroup::Inherited>> m_inherited_property_values;
+        AK::CopyOnWrite<PropertyValueGroup<PropertyGroup::NonInherited>> m_non_inherited_property_values;
         Array<u8, ceil_div(number_of_properties, 8uz)> m_property_important {};
         Array<u8, ceil_div(number_of_properties, 8uz)> m_property_inherited {};
 
@@ -51,12 +88,16 @@ public:
     static NonnullRefPtr<StyleProperties> create() { return adopt_ref(*new StyleProperties); }
     NonnullRefPtr<StyleProperties> clone() const;
 
+    // The memory taken up by these computed values, not counting the style values themselves. Data that is shared with
+    // other StyleProperties is only counted by the first call that sees it.
+    size_t memory_usage(HashTable<void const*>& seen_data) const;
+
     template<typename Callback>
     inline void for_each_property(Callback callback) const
     {
-        for (size_t i = 0; i < m_data->m_property_values.size(); ++i) {
-            if (m_data->m_property_values[i])
-                callback((CSS::PropertyID)i, *m_data->m_property_values[i]);
+        for (size_t i = 0; i < number_of_properties; ++i) {
+            if (auto const& value = property_value_slot((CSS::PropertyID)i))
+                callback((CSS::PropertyID)i, *value);
         }
     }
 
@@ -83,6 +124,9 @@ public:
     RefPtr<CSSStyleValue const> maybe_null_property(CSS::PropertyID) const;
     void revert_property(CSS::PropertyID, StyleProperties const& style_for_revert);
 
+    // Makes us share `other`'s inherited values if they're all equal to ours. Used to let children share with parents.
+    void share_inherited_property_values_if_equal(StyleProperties const& other);
+
     JS::GCPtr<CSS::CSSStyleDeclaration const> animation_name_source() const { return m_data->m_animation_name_source; }
     void set_animation_name_source(JS::GCPtr<CSS::CSSStyleDeclaration const> declaration) { m_data->m_animation_name_source = declaration; }
 
@@ -111,6 +155,8 @@ public:
         u32 final_quote_nesting_level { 0 };
     };
     ContentDataAndQuoteNestingLevel content(DOM::Element&, u32 initial_quote_nesting_level) const;
+    CSS::Containment contain() const;
+    CSS::ContainIntrinsicSize contain_intrinsic_size(CSS::PropertyID) const;
     Optional<CSS::ContentVisibility> content_visibility() const;
     Optional<CSS::Cursor> cursor() const;
     Variant<LengthOrCalculated, NumberOrCalculated> tab_size() const;
@@ -218,6 +264,9 @@ public:
 private:
     friend class StyleComputer;
 
+    RefPtr<CSSStyleValue const> const& property_value_slot(CSS::PropertyID) const;
+    RefPtr<CSSStyleValue const>& mutable_property_value_slot(CSS::PropertyID);
+
     Optional<CSS::Overflow> overflow(CSS::PropertyID) const;
     Vector<CSS::ShadowData> shadow(CSS::PropertyID, Layout::Node const&) const;
 
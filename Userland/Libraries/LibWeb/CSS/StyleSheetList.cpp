@@ -107,7 +107,7 @@ void StyleSheetList::add_sheet(CSSStyleSheet& sheet)
         return;
     }
 
-    document().style_computer().invalidate_rule_cache();
+    document().style_computer().did_add_style_sheet(sheet);
     document().style_computer().load_fonts_from_sheet(sheet);
     document_or_shadow_root().invalidate_style(DOM::StyleInvalidationReason::StyleSheetListAddSheet);
 }
@@ -124,7 +124,7 @@ void StyleSheetList::remove_sheet(CSSStyleSheet& sheet)
     }
 
     m_document_or_shadow_root->document().style_computer().unload_fonts_from_sheet(sheet);
-    m_document_or_shadow_root->document().style_computer().invalidate_rule_cache();
+    m_document_or_shadow_root->document().style_computer().did_remove_style_sheet(sheet);
     document_or_shadow_root().invalidate_style(DOM::StyleInvalidationReason::StyleSheetListRemoveSheet);
 }
 
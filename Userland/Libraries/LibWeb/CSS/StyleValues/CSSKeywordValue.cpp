@@ -8,6 +8,7 @@
  */
 
 #include "CSSKeywordValue.h"
+#include <AK/HashMap.h>
 #include <LibGfx/Palette.h>
 #include <LibWeb/CSS/SystemColor.h>
 #include <LibWeb/DOM/Document.h>
@@ -16,6 +17,17 @@
 
 namespace Web::CSS {
 
+ValueComparingNonnullRefPtr<CSSKeywordValue> CSSKeywordValue::create(Keyword keyword)
+{
+    // NOTE: Keyword values are immutable, so every occurrence of a keyword shares a single instance.
+    //       This keeps large style sheets small and lets equality checks short-circuit on pointer identity.
+    // NOTE: We'll have to be much more careful with caching once we expose CSSKeywordValue to JS, as it's mutable.
+    static HashMap<Keyword, ValueComparingNonnullRefPtr<CSSKeywordValue>> instances;
+    return instances.ensure(keyword, [keyword] {
+        return adopt_ref(*new (nothrow) CSSKeywordValue(keyword));
+    });
+}
+
 String CSSKeywordValue::to_string() const
 {
     return MUST(String::from_utf8(string_from_keyword(keyword())));
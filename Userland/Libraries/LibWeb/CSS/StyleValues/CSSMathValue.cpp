@@ -2624,7 +2624,7 @@ bool CSSMathValue::equals(CSSStyleValue const& other) const
 
 Optional<Angle> CSSMathValue::resolve_angle() const
 {
-    auto result = m_calculation->resolve({}, {});
+    auto result = resolve_calculation({}, {});
 
     if (result.value().has<Angle>())
         return result.value().get<Angle>();
@@ -2633,7 +2633,7 @@ Optional<Angle> CSSMathValue::resolve_angle() const
 
 Optional<Angle> CSSMathValue::resolve_angle_percentage(Angle const& percentage_basis) const
 {
-    auto result = m_calculation->resolve({}, percentage_basis);
+    auto result = resolve_calculation({}, percentage_basis);
 
     return result.value().visit(
         [&](Angle const& angle) -> Optional<Angle> {
@@ -2649,7 +2649,7 @@ Optional<Angle> CSSMathValue::resolve_angle_percentage(Angle const& percentage_b
 
 Optional<Flex> CSSMathValue::resolve_flex() const
 {
-    auto result = m_calculation->resolve({}, {});
+    auto result = resolve_calculation({}, {});
 
     if (result.value().has<Flex>())
         return result.value().get<Flex>();
@@ -2658,7 +2658,7 @@ Optional<Flex> CSSMathValue::resolve_flex() const
 
 Optional<Frequency> CSSMathValue::resolve_frequency() const
 {
-    auto result = m_calculation->resolve({}, {});
+    auto result = resolve_calculation({}, {});
 
     if (result.value().has<Frequency>())
         return result.value().get<Frequency>();
@@ -2667,7 +2667,7 @@ Optional<Frequency> CSSMathValue::resolve_frequency() const
 
 Optional<Frequency> CSSMathValue::resolve_frequency_percentage(Frequency const& percentage_basis) const
 {
-    auto result = m_calculation->resolve({}, percentage_basis);
+    auto result = resolve_calculation({}, percentage_basis);
 
     return result.value().visit(
         [&](Frequency const& frequency) -> Optional<Frequency> {
@@ -2681,9 +2681,26 @@ Optional<Frequency> CSSMathValue::resolve_frequency_percentage(Frequency const&
         });
 }
 
+CSSMathValue::CalculationResult CSSMathValue::resolve_calculation(Optional<Length::ResolutionContext const&> context, PercentageBasis const& percentage_basis) const
+{
+    if (m_cached_resolution.has_value()
+        && m_cached_resolution->context.has_value() == context.has_value()
+        && (!context.has_value() || *m_cached_resolution->context == *context)
+        && m_cached_resolution->percentage_basis == percentage_basis) {
+        return m_cached_resolution->result;
+    }
+
+    auto result = m_calculation->resolve(context, percentage_basis);
+    Optional<Length::ResolutionContext> context_copy;
+    if (context.has_value())
+        context_copy = *context;
+    m_cached_resolution = CachedResolution { move(context_copy), percentage_basis, result };
+    return result;
+}
+
 Optional<Length> CSSMathValue::resolve_length(Length::ResolutionContext const& context) const
 {
-    auto result = m_calculation->resolve(context, {});
+    auto result = resolve_calculation(context, {});
 
     if (result.value().has<Length>())
         return result.value().get<Length>();
@@ -2707,7 +2724,7 @@ Optional<Length> CSSMathValue::resolve_length_percentage(Layout::Node const& lay
 
 Optional<Length> CSSMathValue::resolve_length_percentage(Length::ResolutionContext const& resolution_context, Length const& percentage_basis) const
 {
-    auto result = m_calculation->resolve(resolution_context, percentage_basis);
+    auto result = resolve_calculation(resolution_context, percentage_basis);
 
     return result.value().visit(
         [&](Length const& length) -> Optional<Length> {
@@ -2723,7 +2740,7 @@ Optional<Length> CSSMathValue::resolve_length_percentage(Length::ResolutionConte
 
 Optional<Percentage> CSSMathValue::resolve_percentage() const
 {
-    auto result = m_calculation->resolve({}, {});
+    auto result = resolve_calculation({}, {});
     if (result.value().has<Percentage>())
         return result.value().get<Percentage>();
     return {};
@@ -2731,7 +2748,7 @@ Optional<Percentage> CSSMathValue::resolve_percentage() const
 
 Optional<Resolution> CSSMathValue::resolve_resolution() const
 {
-    auto result = m_calculation->resolve({}, {});
+    auto result = resolve_calculation({}, {});
     if (result.value().has<Resolution>())
         return result.value().get<Resolution>();
     return {};
@@ -2739,7 +2756,7 @@ Optional<Resolution> CSSMathValue::resolve_resolution() const
 
 Optional<Time> CSSMathValue::resolve_time() const
 {
-    auto result = m_calculation->resolve({}, {});
+    auto result = resolve_calculation({}, {});
 
     if (result.value().has<Time>())
         return result.value().get<Time>();
@@ -2748,7 +2765,7 @@ Optional<Time> CSSMathValue::resolve_time() const
 
 Optional<Time> CSSMathValue::resolve_time_percentage(Time const& percentage_basis) const
 {
-    auto result = m_calculation->resolve({}, percentage_basis);
+    auto result = resolve_calculation({}, percentage_basis);
 
     return result.value().visit(
         [&](Time const& time) -> Optional<Time> {
@@ -2761,7 +2778,7 @@ Optional<Time> CSSMathValue::resolve_time_percentage(Time const& percentage_basi
 
 Optional<double> CSSMathValue::resolve_number() const
 {
-    auto result = m_calculation->resolve({}, {});
+    auto result = resolve_calculation({}, {});
     if (result.value().has<Number>())
         return result.value().get<Number>().value();
     return {};
@@ -2769,7 +2786,7 @@ Optional<double> CSSMathValue::resolve_number() const
 
 Optional<i64> CSSMathValue::resolve_integer() const
 {
-    auto result = m_calculation->resolve({}, {});
+    auto result = resolve_calculation({}, {});
     if (result.value().has<Number>())
         return result.value().get<Number>().integer_value();
     return {};
@@ -133,8 +133,19 @@ private:
     {
     }
 
+    CalculationResult resolve_calculation(Optional<Length::ResolutionContext const&>, PercentageBasis const&) const;
+
     CSSNumericType m_resolved_type;
     NonnullOwnPtr<CalculationNode> m_calculation;
+
+    // Resolving walks the whole calculation tree, and layout tends to ask for the same value with the same inputs
+    // over and over again, so we remember the most recent result.
+    struct CachedResolution {
+        Optional<Length::ResolutionContext> context;
+        PercentageBasis percentage_basis;
+        CalculationResult result;
+    };
+    mutable Optional<CachedResolution> m_cached_resolution;
 };
 
 // https://www.w3.org/TR/css-values-4/#calculation-tree
@@ -8,20 +8,26 @@
  */
 
 #include "LengthStyleValue.h"
+#include <AK/Array.h>
+#include <math.h>
 
 namespace Web::CSS {
 
 ValueComparingNonnullRefPtr<LengthStyleValue> LengthStyleValue::create(Length const& length)
 {
     VERIFY(!length.is_auto());
+    // NOTE: Small integral pixel lengths (borders, paddings, margins, ...) show up all over style sheets,
+    //       so we share a single instance of each of them.
+    static constexpr double max_shared_px_value = 16;
     if (length.is_px()) {
-        if (length.raw_value() == 0) {
-            static auto value = adopt_ref(*new (nothrow) LengthStyleValue(CSS::Length::make_px(0)));
-            return value;
-        }
-        if (length.raw_value() == 1) {
-            static auto value = adopt_ref(*new (nothrow) LengthStyleValue(CSS::Length::make_px(1)));
-            return value;
+        auto px = length.raw_value();
+        // NOTE: -0px compares equal to 0px, but has to keep its own sign, so it's never shared.
+        if (px >= 0 && px <= max_shared_px_value && !signbit(px) && trunc(px) == px) {
+            static Array<RefPtr<LengthStyleValue>, static_cast<size_t>(max_shared_px_value) + 1> shared_values;
+            auto& shared_value = shared_values[static_cast<size_t>(px)];
+            if (!shared_value)
+                shared_value = adopt_ref(*new (nothrow) LengthStyleValue(CSS::Length::make_px(px)));
+            return *shared_value;
         }
     }
     return adopt_ref(*new (nothrow) LengthStyleValue(length));
@@ -8,9 +8,26 @@
  */
 
 #include "NumberStyleValue.h"
+#include <AK/Array.h>
+#include <math.h>
 
 namespace Web::CSS {
 
+ValueComparingNonnullRefPtr<NumberStyleValue> NumberStyleValue::create(double value)
+{
+    // NOTE: Small non-negative integers are by far the most common numbers, not least because every color
+    //       component is one, so we share a single instance of each of them.
+    static constexpr double max_shared_value = 255;
+    if (value >= 0 && value <= max_shared_value && !signbit(value) && trunc(value) == value) {
+        static Array<RefPtr<NumberStyleValue>, static_cast<size_t>(max_shared_value) + 1> shared_values;
+        auto& shared_value = shared_values[static_cast<size_t>(value)];
+        if (!shared_value)
+            shared_value = adopt_ref(*new (nothrow) NumberStyleValue(value));
+        return *shared_value;
+    }
+    return adopt_ref(*new (nothrow) NumberStyleValue(value));
+}
+
 String NumberStyleValue::to_string() const
 {
     return MUST(String::number(m_value));
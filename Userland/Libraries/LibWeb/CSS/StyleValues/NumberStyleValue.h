@@ -15,10 +15,7 @@ namespace Web::CSS {
 
 class NumberStyleValue final : public CSSUnitValue {
 public:
-    static ValueComparingNonnullRefPtr<NumberStyleValue> create(double value)
-    {
-        return adopt_ref(*new (nothrow) NumberStyleValue(value));
-    }
+    static ValueComparingNonnullRefPtr<NumberStyleValue> create(double value);
 
     double number() const { return m_value; }
     virtual double value() const override { return m_value; }
@@ -11,6 +11,7 @@
 
 #include <LibWeb/CSS/Percentage.h>
 #include <LibWeb/CSS/StyleValues/CSSUnitValue.h>
+#include <math.h>
 
 namespace Web::CSS {
 
@@ -18,6 +19,18 @@ class PercentageStyleValue final : public CSSUnitValue {
 public:
     static ValueComparingNonnullRefPtr<PercentageStyleValue> create(Percentage percentage)
     {
+        if (percentage.value() == 0 && !signbit(percentage.value())) {
+            static auto value = adopt_ref(*new (nothrow) PercentageStyleValue(Percentage(0)));
+            return value;
+        }
+        if (percentage.value() == 50) {
+            static auto value = adopt_ref(*new (nothrow) PercentageStyleValue(Percentage(50)));
+            return value;
+        }
+        if (percentage.value() == 100) {
+            static auto value = adopt_ref(*new (nothrow) PercentageStyleValue(Percentage(100)));
+            return value;
+        }
         return adopt_ref(*new (nothrow) PercentageStyleValue(move(percentage)));
     }
     virtual ~PercentageStyleValue() override = default;
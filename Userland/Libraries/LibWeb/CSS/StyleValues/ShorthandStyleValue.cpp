@@ -106,6 +106,13 @@ String ShorthandStyleValue::to_string() const
 
         return MUST(String::formatted("{} {}", column_width, column_count));
     }
+    case PropertyID::ContainIntrinsicSize: {
+        auto width = longhand(PropertyID::ContainIntrinsicWidth)->to_string();
+        auto height = longhand(PropertyID::ContainIntrinsicHeight)->to_string();
+        if (width == height)
+            return width;
+        return MUST(String::formatted("{} {}", width, height));
+    }
     case PropertyID::Flex:
         return MUST(String::formatted("{} {} {}", longhand(PropertyID::FlexGrow)->to_string(), longhand(PropertyID::FlexShrink)->to_string(), longhand(PropertyID::FlexBasis)->to_string()));
     case PropertyID::FlexFlow:
@@ -15,6 +15,7 @@
 #include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
 #include <LibCore/Timer.h>
+#include <LibCore/Tracing.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/FunctionObject.h>
 #include <LibJS/Runtime/NativeFunction.h>
@@ -445,6 +446,7 @@ void Document::visit_edges(Cell::Visitor& visitor)
     Base::visit_edges(visitor);
     visitor.visit(m_page);
     visitor.visit(m_window);
+    m_element_index.visit_edges(visitor);
     visitor.visit(m_layout_root);
     visitor.visit(m_style_sheets);
     visitor.visit(m_hovered_node);
@@ -489,6 +491,7 @@ void Document::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_resize_observers);
 
     visitor.visit(m_shared_resource_requests);
+    visitor.visit(m_map_of_preloaded_resources);
 
     visitor.visit(m_associated_animation_timelines);
     visitor.visit(m_list_of_available_images);
@@ -1059,6 +1062,15 @@ URL::URL Document::parse_url(StringView url) const
 }
 
 void Document::set_needs_layout()
+{
+    m_needs_full_layout = true;
+    if (m_needs_layout)
+        return;
+    m_needs_layout = true;
+    schedule_layout_update();
+}
+
+void Document::did_mark_layout_node_as_needing_layout_update(Badge<Layout::Node>)
 {
     if (m_needs_layout)
         return;
@@ -1133,6 +1145,8 @@ void Document::update_layout()
     if (m_created_for_appropriate_template_contents)
         return;
 
+    Core::Tracing::ScopedEvent trace_event { Core::Tracing::Category::Layout, "Document::update_layout"sv };
+
     invalidate_display_list();
 
     auto* document_element = this->document_element();
@@ -1148,12 +1162,19 @@ void Document::update_layout()
         }
     }
 
+    // NOTE: If we don't know what changed, none of the results cached by earlier layouts can be trusted.
+    bool const needs_to_reset_layout_caches = exchange(m_needs_full_layout, false);
+
     // Assign each box that establishes a formatting context a list of absolutely positioned children it should take care of during layout
     m_layout_root->for_each_in_inclusive_subtree_of_type<Layout::Box>([&](auto& child) {
         child.clear_contained_abspos_children();
+        if (needs_to_reset_layout_caches)
+            child.reset_layout_caches();
         return TraversalDecision::Continue;
     });
+    u32 next_layout_index = 0;
     m_layout_root->for_each_in_inclusive_subtree([&](auto& child) {
+        child.set_layout_index(next_layout_index++);
         if (!child.is_absolutely_positioned())
             return TraversalDecision::Continue;
         if (auto* containing_block = child.containing_block()) {
@@ -1194,6 +1215,7 @@ void Document::update_layout()
     }
 
     layout_state.commit(*m_layout_root);
+    m_layout_root->reset_needs_layout_update_in_subtree();
 
     // Broadcast the current viewport rect to any new paintables, so they know whether they're visible or not.
     inform_all_viewport_clients_about_the_current_viewport_rect();
@@ -1235,11 +1257,34 @@ void Document::update_layout()
     bool is_display_none = false;
 
     if (is<Element>(node)) {
-        invalidation |= static_cast<Element&>(node).recompute_style();
+        auto element_invalidation = static_cast<Element&>(node).recompute_style();
+        if (element_invalidation.relayout && !element_invalidation.rebuild_layout_tree) {
+            if (auto* layout_node = node.layout_node())
+                layout_node->set_needs_layout_update();
+        }
+        invalidation |= element_invalidation;
         is_display_none = static_cast<Element&>(node).computed_css_values()->display().is_none();
     }
     node.set_needs_style_update(false);
 
+    // OPTIMIZATION: The contents of an element that skips its contents are neither laid out nor painted, so we don't
+    //               compute their style until the element stops skipping them. Until then, they keep needing a style
+    //               update, which Element::determine_proximity_to_the_viewport() picks up again.
+    //               getComputedStyle() computes the style of elements without a layout node on demand.
+    if (is<Element>(node) && static_cast<Element&>(node).skips_its_contents()) {
+        if (needs_full_style_update) {
+            if (auto shadow_root = static_cast<Element&>(node).shadow_root())
+                shadow_root->mark_inclusive_subtree_as_needing_style_update();
+            node.for_each_child([](auto& child) {
+                child.mark_inclusive_subtree_as_needing_style_update();
+                return IterationDecision::Continue;
+            });
+            node.set_child_needs_style_update(true);
+        }
+        style_computer.pop_ancestor(static_cast<Element const&>(node));
+        return invalidation;
+    }
+
     if (needs_full_style_update || node.child_needs_style_update()) {
         if (node.is_element()) {
             if (auto shadow_root = static_cast<DOM::Element&>(node).shadow_root()) {
@@ -1287,6 +1332,8 @@ void Document::update_style()
     if (m_created_for_appropriate_template_contents)
         return;
 
+    Core::Tracing::ScopedEvent trace_event { Core::Tracing::Category::Style, "Document::update_style"sv };
+
     // Fetch the viewport rect once, instead of repeatedly, during style computation.
     style_computer().set_viewport_rect({}, viewport_rect());
 
@@ -1294,15 +1341,24 @@ void Document::update_style()
 
     style_computer().reset_ancestor_filter();
 
+    style_computer().begin_style_sharing();
     auto invalidation = update_style_recursively(*this, style_computer());
-    if (!invalidation.is_none()) {
+    style_computer().end_style_sharing();
+
+    if constexpr (LIBWEB_CSS_DEBUG) {
+        auto const& statistics = style_computer().style_sharing_statistics();
+        dbgln("Style sharing: {} hits, {} misses", statistics.hits, statistics.misses);
+    }
+    // NOTE: Elements that only need a repaint have already invalidated the display list chunk of their stacking
+    //       context, which keeps the chunks of the other stacking contexts around.
+    if (invalidation.rebuild_stacking_context_tree || invalidation.relayout || invalidation.rebuild_layout_tree) {
         invalidate_display_list();
     }
     if (invalidation.rebuild_layout_tree) {
         invalidate_layout_tree();
     } else {
-        if (invalidation.relayout)
-            set_needs_layout();
+        // NOTE: Elements whose style change requires relayout have already marked their layout node
+        //       in update_style_recursively().
         if (invalidation.rebuild_stacking_context_tree)
             invalidate_stacking_context_tree();
     }
@@ -2953,6 +3009,7 @@ bool Document::anything_is_delaying_the_load_event() const
 
 void Document::invalidate_stacking_context_tree()
 {
+    m_whole_viewport_damaged = true;
     if (auto* paintable_box = this->paintable_box())
         paintable_box->invalidate_stacking_context();
 }
@@ -3866,10 +3923,11 @@ void Document::queue_an_intersection_observer_entry(IntersectionObserver::Inters
 }
 
 // https://www.w3.org/TR/intersection-observer/#compute-the-intersection
-static JS::NonnullGCPtr<Geometry::DOMRectReadOnly> compute_intersection(JS::NonnullGCPtr<Element> target, IntersectionObserver::IntersectionObserver const& observer)
+// NOTE: This takes the bounding box of target and the root intersection rectangle, which the caller has already computed.
+static CSSPixelRect compute_intersection(CSSPixelRect const& target_rect, CSSPixelRect const& root_intersection_rectangle)
 {
     // 1. Let intersectionRect be the result of getting the bounding box for target.
-    auto intersection_rect = target->get_bounding_client_rect();
+    auto intersection_rect = target_rect;
 
     // FIXME: 2. Let container be the containing block of target.
     // FIXME: 3. While container is not root:
@@ -3884,13 +3942,7 @@ static JS::NonnullGCPtr<Geometry::DOMRectReadOnly> compute_intersection(JS::Nonn
 
     // 5. Update intersectionRect by intersecting it with the root intersection rectangle.
     // FIXME: Pass in target so we can properly apply rootMargin.
-    auto root_intersection_rectangle = observer.root_intersection_rectangle();
-    CSSPixelRect intersection_rect_as_pixel_rect(intersection_rect->x(), intersection_rect->y(), intersection_rect->width(), intersection_rect->height());
-    intersection_rect_as_pixel_rect.intersect(root_intersection_rectangle);
-    intersection_rect->set_x(static_cast<double>(intersection_rect_as_pixel_rect.x()));
-    intersection_rect->set_y(static_cast<double>(intersection_rect_as_pixel_rect.y()));
-    intersection_rect->set_width(static_cast<double>(intersection_rect_as_pixel_rect.width()));
-    intersection_rect->set_height(static_cast<double>(intersection_rect_as_pixel_rect.height()));
+    intersection_rect.intersect(root_intersection_rectangle);
 
     // FIXME: 6. Map intersectionRect to the coordinate space of the viewport of the document containing target.
 
@@ -3903,10 +3955,32 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
 {
     auto& realm = this->realm();
 
+    auto create_dom_rect = [&](CSSPixelRect const& rect) {
+        return Geometry::DOMRectReadOnly::construct_impl(realm, static_cast<double>(rect.x()), static_cast<double>(rect.y()), static_cast<double>(rect.width()), static_cast<double>(rect.height())).release_value_but_fixme_should_propagate_errors();
+    };
+
+    // NOTE: Targets observed by several observers only have their bounding box computed once.
+    HashMap<Element const*, CSSPixelRect> target_rects;
+    auto bounding_box_of = [&](Element const& target) {
+        return target_rects.ensure(&target, [&] {
+            auto rect = target.get_bounding_client_rect();
+            return CSSPixelRect { rect->x(), rect->y(), rect->width(), rect->height() };
+        });
+    };
+
     // 1. Let observer list be a list of all IntersectionObservers whose root is in the DOM tree of document.
     //    For the top-level browsing context, this includes implicit root observers.
     // 2. For each observer in observer list:
     for (auto& observer : m_intersection_observers) {
+        auto intersection_root = observer->intersection_root();
+        auto intersection_root_document = intersection_root.visit([](auto& node) -> JS::NonnullGCPtr<Document> {
+            return node->document();
+        });
+
+        // NOTE: Bring the geometry of the root up to date first, so that its geometry generation below is current.
+        intersection_root_document->update_layout();
+        intersection_root_document->update_paint_and_hit_testing_properties_if_needed();
+
         // 1. Let rootBounds be observer’s root intersection rectangle.
         auto root_bounds = observer->root_intersection_rectangle();
 
@@ -3921,10 +3995,11 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
             bool is_intersecting = false;
 
             // targetRect be a DOMRectReadOnly with x, y, width, and height set to 0.
-            auto target_rect = Geometry::DOMRectReadOnly::construct_impl(realm, 0, 0, 0, 0).release_value_but_fixme_should_propagate_errors();
+            // NOTE: The DOMRectReadOnly objects are only created if an entry is queued.
+            CSSPixelRect target_rect;
 
             // intersectionRect be a DOMRectReadOnly with x, y, width, and height set to 0.
-            auto intersection_rect = Geometry::DOMRectReadOnly::construct_impl(realm, 0, 0, 0, 0).release_value_but_fixme_should_propagate_errors();
+            CSSPixelRect intersection_rect;
 
             // SPEC ISSUE: It doesn't pass in intersection ratio to "queue an IntersectionObserverEntry" despite needing it.
             //             This is default 0, as isIntersecting is default false, see step 9.
@@ -3933,29 +4008,39 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
             // 2. If the intersection root is not the implicit root, and target is not in the same document as the intersection root, skip to step 11.
             // 3. If the intersection root is an Element, and target is not a descendant of the intersection root in the containing block chain, skip to step 11.
             // FIXME: Actually use the containing block chain.
-            auto intersection_root = observer->intersection_root();
-            auto intersection_root_document = intersection_root.visit([](auto& node) -> JS::NonnullGCPtr<Document> {
-                return node->document();
-            });
+            // NOTE: Step 11 is done first, so that the registration can tell whether anything could have moved.
+            auto& intersection_observer_registration = target->get_intersection_observer_registration({}, observer);
             if (!(observer->root().has<Empty>() && &target->document() == intersection_root_document.ptr())
                 || !(intersection_root.has<JS::Handle<DOM::Element>>() && !target->is_descendant_of(*intersection_root.get<JS::Handle<DOM::Element>>()))) {
+                auto& target_document = target->document();
+                target_document.update_layout();
+                target_document.update_paint_and_hit_testing_properties_if_needed();
+
+                // NOTE: If neither the target nor the root could have moved since thresholdIndex and isIntersecting
+                //       were last computed for this registration, they are still the same, and no entry will be queued.
+                if (intersection_observer_registration.target_geometry_generation == target_document.geometry_generation()
+                    && intersection_observer_registration.root_geometry_generation == intersection_root_document->geometry_generation()) {
+                    continue;
+                }
+                intersection_observer_registration.target_geometry_generation = target_document.geometry_generation();
+                intersection_observer_registration.root_geometry_generation = intersection_root_document->geometry_generation();
+
                 // 4. Set targetRect to the DOMRectReadOnly obtained by getting the bounding box for target.
-                target_rect = target->get_bounding_client_rect();
+                target_rect = bounding_box_of(*target);
 
                 // 5. Let intersectionRect be the result of running the compute the intersection algorithm on target and
                 //    observer’s intersection root.
-                intersection_rect = compute_intersection(target, observer);
+                intersection_rect = compute_intersection(target_rect, root_bounds);
 
                 // 6. Let targetArea be targetRect’s area.
-                auto target_area = target_rect->width() * target_rect->height();
+                auto target_area = static_cast<double>(target_rect.width()) * static_cast<double>(target_rect.height());
 
                 // 7. Let intersectionArea be intersectionRect’s area.
-                auto intersection_area = intersection_rect->width() * intersection_rect->height();
+                auto intersection_area = static_cast<double>(intersection_rect.width()) * static_cast<double>(intersection_rect.height());
 
                 // 8. Let isIntersecting be true if targetRect and rootBounds intersect or are edge-adjacent, even if the
                 //    intersection has zero area (because rootBounds or targetRect have zero area).
-                CSSPixelRect target_rect_as_pixel_rect(target_rect->x(), target_rect->y(), target_rect->width(), target_rect->height());
-                is_intersecting = target_rect_as_pixel_rect.intersects(root_bounds);
+                is_intersecting = target_rect.intersects(root_bounds);
 
                 // 9. If targetArea is non-zero, let intersectionRatio be intersectionArea divided by targetArea.
                 //    Otherwise, let intersectionRatio be 1 if isIntersecting is true, or 0 if isIntersecting is false.
@@ -3971,11 +4056,14 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
                                                             return threshold_value > intersection_ratio;
                                                         })
                                       .value_or(observer->thresholds().size());
+            } else {
+                intersection_observer_registration.target_geometry_generation = 0;
+                intersection_observer_registration.root_geometry_generation = 0;
             }
 
             // 11. Let intersectionObserverRegistration be the IntersectionObserverRegistration record in target’s
             //     internal [[RegisteredIntersectionObservers]] slot whose observer property is equal to observer.
-            auto& intersection_observer_registration = target->get_intersection_observer_registration({}, observer);
+            // NOTE: This was done before step 2.
 
             // 12. Let previousThresholdIndex be the intersectionObserverRegistration’s previousThresholdIndex property.
             auto previous_threshold_index = intersection_observer_registration.previous_threshold_index;
@@ -3987,10 +4075,8 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
             //     previousIsIntersecting, queue an IntersectionObserverEntry, passing in observer, time,
             //     rootBounds, targetRect, intersectionRect, isIntersecting, and target.
             if (threshold_index != previous_threshold_index || is_intersecting != previous_is_intersecting) {
-                auto root_bounds_as_dom_rect = Geometry::DOMRectReadOnly::construct_impl(realm, static_cast<double>(root_bounds.x()), static_cast<double>(root_bounds.y()), static_cast<double>(root_bounds.width()), static_cast<double>(root_bounds.height())).release_value_but_fixme_should_propagate_errors();
-
                 // SPEC ISSUE: It doesn't pass in intersectionRatio, but it's required.
-                queue_an_intersection_observer_entry(observer, time, root_bounds_as_dom_rect, target_rect, intersection_rect, is_intersecting, intersection_ratio, target);
+                queue_an_intersection_observer_entry(observer, time, create_dom_rect(root_bounds), create_dom_rect(target_rect), create_dom_rect(intersection_rect), is_intersecting, intersection_ratio, target);
             }
 
             // 15. Assign thresholdIndex to intersectionObserverRegistration’s previousThresholdIndex property.
@@ -4987,6 +5073,21 @@ static size_t calculate_depth_for_node(Node const& node)
     return depth;
 }
 
+Vector<JS::Handle<Element>> Document::elements_with_content_visibility_auto() const
+{
+    Vector<JS::Handle<Element>> elements;
+    if (!m_layout_root)
+        return elements;
+
+    // NOTE: Elements in the contents of an element that skips its contents have no layout node, so they're skipped too.
+    m_layout_root->for_each_in_inclusive_subtree_of_type<Layout::Box>([&](auto const& box) {
+        if (box.computed_values().content_visibility() == CSS::ContentVisibility::Auto && box.dom_node() && box.dom_node()->is_element())
+            elements.append(JS::make_handle(const_cast<Element&>(static_cast<Element const&>(*box.dom_node()))));
+        return TraversalDecision::Continue;
+    });
+    return elements;
+}
+
 // https://drafts.csswg.org/resize-observer-1/#gather-active-observations-h
 void Document::gather_active_observations_at_depth(size_t depth)
 {
@@ -5058,6 +5159,7 @@ size_t Document::broadcast_active_resize_observations()
             default:
                 VERIFY_NOT_REACHED();
             }
+            observation->did_report_sizes();
 
             // 4. Set targetDepth to the result of calculate depth for node for observation.target.
             auto target_depth = calculate_depth_for_node(*observation->target());
@@ -5492,16 +5594,18 @@ void Document::set_cached_navigable(JS::GCPtr<HTML::Navigable> navigable)
 
 void Document::set_needs_display(InvalidateDisplayList should_invalidate_display_list)
 {
-    set_needs_display(viewport_rect(), should_invalidate_display_list);
+    set_needs_display({ {}, viewport_rect().size() }, should_invalidate_display_list);
 }
 
-void Document::set_needs_display(CSSPixelRect const&, InvalidateDisplayList should_invalidate_display_list)
+void Document::set_needs_display(CSSPixelRect const& viewport_relative_rect, InvalidateDisplayList should_invalidate_display_list)
 {
-    // FIXME: Ignore updates outside the visible viewport rect.
-    //        This requires accounting for fixed-position elements in the input rect, which we don't do yet.
-
     m_needs_repaint = true;
 
+    if (m_damage_rect.has_value())
+        m_damage_rect = m_damage_rect->united(viewport_relative_rect);
+    else
+        m_damage_rect = viewport_relative_rect;
+
     if (should_invalidate_display_list == InvalidateDisplayList::Yes) {
         invalidate_display_list();
     }
@@ -5516,13 +5620,27 @@ void Document::set_needs_display(CSSPixelRect const&, InvalidateDisplayList shou
     }
 
     if (auto container = navigable->container()) {
-        container->document().set_needs_display(should_invalidate_display_list);
+        // NOTE: All of our content is painted within the container's box.
+        if (auto* container_paintable = container->paintable())
+            container_paintable->set_needs_display(InvalidateDisplayList::No);
+        else
+            container->document().set_needs_display(should_invalidate_display_list);
     }
 }
 
+Optional<CSSPixelRect> Document::take_damage_rect()
+{
+    auto damage_rect = exchange(m_damage_rect, {});
+    if (exchange(m_whole_viewport_damaged, false))
+        return {};
+    return damage_rect.value_or({});
+}
+
 void Document::invalidate_display_list()
 {
     m_cached_display_list.clear();
+    ++m_display_list_chunk_generation;
+    m_whole_viewport_damaged = true;
 
     auto navigable = this->navigable();
     if (!navigable)
@@ -5533,10 +5651,39 @@ void Document::invalidate_display_list()
     }
 }
 
+// Like invalidate_display_list(), but keeps cached display list chunks around. The caller is responsible for
+// invalidating the chunk of the stacking context that paints the changed content.
+void Document::invalidate_display_list_for_paint_only_change()
+{
+    m_cached_display_list.clear();
+
+    auto navigable = this->navigable();
+    if (!navigable)
+        return;
+
+    if (auto container = navigable->container()) {
+        // NOTE: The container's stacking context holds on to our previous display list, so only its chunk goes stale.
+        if (auto* container_paintable = container->paintable())
+            container_paintable->invalidate_display_list_chunk();
+        else
+            container->document().invalidate_display_list();
+    }
+}
+
 RefPtr<Painting::DisplayList> Document::record_display_list(PaintConfig config)
 {
-    if (m_cached_display_list && m_cached_display_list_paint_config == config)
+    if (m_cached_display_list && m_cached_display_list_paint_config == config) {
+        m_needs_repaint = false;
         return m_cached_display_list;
+    }
+
+    Core::Tracing::ScopedEvent trace_event { Core::Tracing::Category::DisplayList, "Document::record_display_list"sv };
+
+    auto device_pixels_per_css_pixel = page().client().device_pixels_per_css_pixel();
+    if (m_cached_display_list_paint_config != config || m_display_list_chunk_device_pixels_per_css_pixel != device_pixels_per_css_pixel) {
+        ++m_display_list_chunk_generation;
+        m_display_list_chunk_device_pixels_per_css_pixel = device_pixels_per_css_pixel;
+    }
 
     auto display_list = Painting::DisplayList::create();
     Painting::DisplayListRecorder display_list_recorder(display_list);
@@ -5558,6 +5705,7 @@ RefPtr<Painting::DisplayList> Document::record_display_list(PaintConfig config)
     context.set_should_show_line_box_borders(config.should_show_line_box_borders);
     context.set_should_paint_overlay(config.paint_overlay);
     context.set_has_focus(config.has_focus);
+    context.set_display_list_chunk_generation(m_display_list_chunk_generation);
 
     update_paint_and_hit_testing_properties_if_needed();
 
@@ -23,6 +23,7 @@
 #include <LibWeb/CSS/CSSStyleSheet.h>
 #include <LibWeb/CSS/StyleSheetList.h>
 #include <LibWeb/Cookie/Cookie.h>
+#include <LibWeb/DOM/ElementIndex.h>
 #include <LibWeb/DOM/NonElementParentNode.h>
 #include <LibWeb/DOM/ParentNode.h>
 #include <LibWeb/HTML/BrowsingContext.h>
@@ -33,6 +34,7 @@
 #include <LibWeb/HTML/LazyLoadingElement.h>
 #include <LibWeb/HTML/NavigationType.h>
 #include <LibWeb/HTML/Origin.h>
+#include <LibWeb/HTML/PreloadEntry.h>
 #include <LibWeb/HTML/SandboxingFlagSet.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/VisibilityState.h>
@@ -242,7 +244,15 @@ public:
     void update_paint_and_hit_testing_properties_if_needed();
     void update_animated_style_if_needed();
 
+    // Changes whenever boxes may have moved, i.e. after layout and whenever something was scrolled or had its paint-only
+    // properties (like transforms) resolved again. Geometry cached on paintables and elements is keyed by it.
+    u64 geometry_generation() const { return m_geometry_generation; }
+    void did_change_geometry() { ++m_geometry_generation; }
+
+    // NOTE: Prefer Layout::Node::set_needs_layout_update() when the change can be attributed to a specific layout node,
+    //       as set_needs_layout() discards all cached layout results.
     void set_needs_layout();
+    void did_mark_layout_node_as_needing_layout_update(Badge<Layout::Node>);
 
     void invalidate_layout_tree();
     void invalidate_stacking_context_tree();
@@ -591,6 +601,8 @@ public:
 
     void run_the_update_intersection_observations_steps(HighResolutionTime::DOMHighResTimeStamp time);
 
+    HashTable<FlyString>& previously_reported_paints() { return m_previously_reported_paints; }
+
     void start_intersection_observing_a_lazy_loading_element(Element&);
 
     void shared_declarative_refresh_steps(StringView input, JS::GCPtr<HTML::HTMLMetaElement const> meta_element = nullptr);
@@ -607,6 +619,9 @@ public:
 
     HashMap<URL::URL, JS::GCPtr<HTML::SharedResourceRequest>>& shared_resource_requests();
 
+    // https://html.spec.whatwg.org/multipage/links.html#map-of-preloaded-resources
+    HashMap<HTML::PreloadKey, JS::NonnullGCPtr<HTML::PreloadEntry>>& map_of_preloaded_resources() { return m_map_of_preloaded_resources; }
+
     void restore_the_history_object_state(JS::NonnullGCPtr<HTML::SessionHistoryEntry> entry);
 
     JS::NonnullGCPtr<Animations::DocumentTimeline> timeline();
@@ -652,13 +667,28 @@ public:
     Vector<JS::NonnullGCPtr<Element>> elements_from_point(double x, double y);
     JS::GCPtr<Element const> scrolling_element() const;
 
-    void set_needs_to_resolve_paint_only_properties() { m_needs_to_resolve_paint_only_properties = true; }
+    void set_needs_to_resolve_paint_only_properties()
+    {
+        m_needs_to_resolve_paint_only_properties = true;
+        // NOTE: Paint-only properties (like transforms and shadows) move content around without a relayout,
+        //       and we don't know where it was painted before, so assume everything is damaged.
+        m_whole_viewport_damaged = true;
+    }
     void set_needs_animated_style_update() { m_needs_animated_style_update = true; }
 
     virtual JS::Value named_item_value(FlyString const& name) const override;
     virtual Vector<FlyString> supported_property_names() const override;
     Vector<JS::NonnullGCPtr<DOM::Element>> const& potentially_named_elements() const { return m_potentially_named_elements; }
 
+    ElementByIdMap& element_by_id() { return m_element_by_id; }
+    ElementByIdMap const& element_by_id() const { return m_element_by_id; }
+
+    ElementIndex& element_index() { return m_element_index; }
+    ElementIndex const& element_index() const { return m_element_index; }
+
+    // NOTE: Only elements that are in the layout tree are returned, as no other element can be close to the viewport.
+    Vector<JS::Handle<Element>> elements_with_content_visibility_auto() const;
+
     void gather_active_observations_at_depth(size_t depth);
     [[nodiscard]] size_t broadcast_active_resize_observations();
     [[nodiscard]] bool has_active_resize_observations();
@@ -708,7 +738,11 @@ public:
 
     [[nodiscard]] bool needs_repaint() const { return m_needs_repaint; }
     void set_needs_display(InvalidateDisplayList = InvalidateDisplayList::Yes);
-    void set_needs_display(CSSPixelRect const&, InvalidateDisplayList = InvalidateDisplayList::Yes);
+    // NOTE: The rect is relative to the viewport, i.e. it's where the damaged content ends up on screen.
+    void set_needs_display(CSSPixelRect const& viewport_relative_rect, InvalidateDisplayList = InvalidateDisplayList::Yes);
+
+    // Returns the viewport-relative area that was damaged since the last call, or nothing if the whole viewport was.
+    Optional<CSSPixelRect> take_damage_rect();
 
     struct PaintConfig {
         bool paint_overlay { false };
@@ -719,8 +753,14 @@ public:
         bool operator==(PaintConfig const& other) const = default;
     };
     RefPtr<Painting::DisplayList> record_display_list(PaintConfig);
+    RefPtr<Painting::DisplayList> record_display_list_with_last_paint_config() { return record_display_list(m_cached_display_list_paint_config.value_or({})); }
+
+    // Whether the last recorded display list is still good. Scrolling keeps it, as scroll offsets are only applied when
+    // it's played back.
+    bool has_cached_display_list() const { return !m_cached_display_list.is_null(); }
 
     void invalidate_display_list();
+    void invalidate_display_list_for_paint_only_change();
 
     Unicode::Segmenter& grapheme_segmenter() const;
     Unicode::Segmenter& word_segmenter() const;
@@ -849,6 +889,8 @@ private:
     Vector<WeakPtr<CSS::MediaQueryList>> m_media_query_lists;
 
     bool m_needs_layout { false };
+    bool m_needs_full_layout { false };
+    u64 m_geometry_generation { 1 };
 
     bool m_needs_full_style_update { false };
 
@@ -924,6 +966,10 @@ private:
     // Each document has an IntersectionObserverTaskQueued flag which is initialized to false.
     bool m_intersection_observer_task_queued { false };
 
+    // https://w3c.github.io/paint-timing/#previously-reported-paints
+    // Each Document has a set of previously reported paints, which is initially empty.
+    HashTable<FlyString> m_previously_reported_paints;
+
     // https://html.spec.whatwg.org/multipage/urls-and-fetching.html#lazy-load-intersection-observer
     // Each Document has a lazy load intersection observer, initially set to null but can be set to an IntersectionObserver instance.
     JS::GCPtr<IntersectionObserver::IntersectionObserver> m_lazy_load_intersection_observer;
@@ -943,6 +989,9 @@ private:
 
     HashMap<URL::URL, JS::GCPtr<HTML::SharedResourceRequest>> m_shared_resource_requests;
 
+    // https://html.spec.whatwg.org/multipage/links.html#map-of-preloaded-resources
+    HashMap<HTML::PreloadKey, JS::NonnullGCPtr<HTML::PreloadEntry>> m_map_of_preloaded_resources;
+
     // https://www.w3.org/TR/web-animations-1/#timeline-associated-with-a-document
     HashTable<JS::NonnullGCPtr<Animations::AnimationTimeline>> m_associated_animation_timelines;
 
@@ -966,6 +1015,9 @@ private:
 
     Vector<JS::NonnullGCPtr<DOM::Element>> m_potentially_named_elements;
 
+    ElementByIdMap m_element_by_id;
+    ElementIndex m_element_index;
+
     bool m_design_mode_enabled { false };
 
     bool m_needs_to_resolve_paint_only_properties { true };
@@ -999,9 +1051,17 @@ private:
 
     bool m_needs_repaint { false };
 
+    Optional<CSSPixelRect> m_damage_rect;
+    bool m_whole_viewport_damaged { true };
+
     Optional<PaintConfig> m_cached_display_list_paint_config;
     RefPtr<Painting::DisplayList> m_cached_display_list;
 
+    // NOTE: Stacking contexts cache their chunk of the display list tagged with this generation, see StackingContext::paint().
+    //       Bumping it throws away every chunk at once.
+    u64 m_display_list_chunk_generation { 0 };
+    double m_display_list_chunk_device_pixels_per_css_pixel { 0 };
+
     mutable OwnPtr<Unicode::Segmenter> m_grapheme_segmenter;
     mutable OwnPtr<Unicode::Segmenter> m_word_segmenter;
 };
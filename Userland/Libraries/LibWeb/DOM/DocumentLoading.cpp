@@ -10,6 +10,7 @@
 #include <AK/LexicalPath.h>
 #include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibTextCodec/Decoder.h>
+#include <LibThreading/BackgroundAction.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/DocumentLoading.h>
 #include <LibWeb/HTML/HTMLHeadElement.h>
@@ -59,6 +60,9 @@ bool build_xml_document(DOM::Document& document, ByteBuffer const& data, Optiona
     return !result.is_error() && !builder.has_error();
 }
 
+// Documents at least this large are decoded on a background thread before parsing.
+static constexpr size_t off_thread_decoding_threshold = 256 * KiB;
+
 // https://html.spec.whatwg.org/multipage/document-lifecycle.html#navigate-html
 static WebIDL::ExceptionOr<JS::NonnullGCPtr<DOM::Document>> load_html_document(HTML::NavigationParams const& navigation_params)
 {
@@ -92,6 +96,24 @@ static WebIDL::ExceptionOr<JS::NonnullGCPtr<DOM::Document>> load_html_document(H
     else {
         // FIXME: Parse as we receive the document data, instead of waiting for the whole document to be fetched first.
         auto process_body = JS::create_heap_function(document->heap(), [document, url = navigation_params.response->url().value()](ByteBuffer data) {
+            // Decoding a large document into UTF-8 doesn't touch the DOM, so do that part off the main thread.
+            // NOTE: Tokenization itself has to stay here, since tree construction switches the tokenizer's state.
+            if (data.size() >= off_thread_decoding_threshold) {
+                auto encoding = document->has_encoding()
+                    ? document->encoding()->to_byte_string()
+                    : HTML::run_encoding_sniffing_algorithm(*document, data);
+                (void)Threading::BackgroundAction<ByteString>::construct(
+                    [data = move(data), encoding](auto&) -> ErrorOr<ByteString> {
+                        return HTML::HTMLTokenizer::decode_input(data, encoding);
+                    },
+                    [document = JS::make_handle(document), encoding, url](ByteString decoded_input) -> ErrorOr<void> {
+                        auto parser = HTML::HTMLParser::create_with_decoded_input(*document, move(decoded_input), encoding);
+                        parser->run(url);
+                        return {};
+                    });
+                return;
+            }
+
             Platform::EventLoopPlugin::the().deferred_invoke([document = document, data = move(data), url = url] {
                 auto parser = HTML::HTMLParser::create_with_uncertain_encoding(document, data);
                 parser->run(url);
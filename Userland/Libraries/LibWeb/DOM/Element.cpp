@@ -24,6 +24,7 @@
 #include <LibWeb/DOM/DOMTokenList.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/ElementByIdMap.h>
 #include <LibWeb/DOM/ElementFactory.h>
 #include <LibWeb/DOM/HTMLCollection.h>
 #include <LibWeb/DOM/NamedNodeMap.h>
@@ -86,8 +87,6 @@ void Element::initialize(JS::Realm& realm)
 {
     Base::initialize(realm);
     WEB_SET_PROTOTYPE_FOR_INTERFACE(Element);
-
-    m_attributes = NamedNodeMap::create(*this);
 }
 
 void Element::visit_edges(Cell::Visitor& visitor)
@@ -116,7 +115,7 @@ void Element::visit_edges(Cell::Visitor& visitor)
 Optional<String> Element::get_attribute(FlyString const& name) const
 {
     // 1. Let attr be the result of getting an attribute given qualifiedName and this.
-    auto const* attribute = m_attributes->get_attribute(name);
+    auto const* attribute = m_attributes ? m_attributes->get_attribute(name) : nullptr;
 
     // 2. If attr is null, return null.
     if (!attribute)
@@ -130,7 +129,7 @@ Optional<String> Element::get_attribute(FlyString const& name) const
 Optional<String> Element::get_attribute_ns(Optional<FlyString> const& namespace_, FlyString const& name) const
 {
     // 1. Let attr be the result of getting an attribute given namespace, localName, and this.
-    auto const* attribute = m_attributes->get_attribute_ns(namespace_, name);
+    auto const* attribute = m_attributes ? m_attributes->get_attribute_ns(namespace_, name) : nullptr;
 
     // 2. If attr is null, return null.
     if (!attribute)
@@ -144,7 +143,7 @@ Optional<String> Element::get_attribute_ns(Optional<FlyString> const& namespace_
 String Element::get_attribute_value(FlyString const& local_name, Optional<FlyString> const& namespace_) const
 {
     // 1. Let attr be the result of getting an attribute given namespace, localName, and element.
-    auto const* attribute = m_attributes->get_attribute_ns(namespace_, local_name);
+    auto const* attribute = m_attributes ? m_attributes->get_attribute_ns(namespace_, local_name) : nullptr;
 
     // 2. If attr is null, then return the empty string.
     if (!attribute)
@@ -158,6 +157,8 @@ String Element::get_attribute_value(FlyString const& local_name, Optional<FlyStr
 JS::GCPtr<Attr> Element::get_attribute_node(FlyString const& name) const
 {
     // The getAttributeNode(qualifiedName) method steps are to return the result of getting an attribute given qualifiedName and this.
+    if (!m_attributes)
+        return nullptr;
     return m_attributes->get_attribute(name);
 }
 
@@ -165,6 +166,8 @@ JS::GCPtr<Attr> Element::get_attribute_node(FlyString const& name) const
 JS::GCPtr<Attr> Element::get_attribute_node_ns(Optional<FlyString> const& namespace_, FlyString const& name) const
 {
     // The getAttributeNodeNS(namespace, localName) method steps are to return the result of getting an attribute given namespace, localName, and this.
+    if (!m_attributes)
+        return nullptr;
     return m_attributes->get_attribute_ns(namespace_, name);
 }
 
@@ -179,13 +182,13 @@ WebIDL::ExceptionOr<void> Element::set_attribute(FlyString const& name, String c
     bool insert_as_lowercase = namespace_uri() == Namespace::HTML && document().document_type() == Document::Type::HTML;
 
     // 3. Let attribute be the first attribute in this’s attribute list whose qualified name is qualifiedName, and null otherwise.
-    auto* attribute = m_attributes->get_attribute(name);
+    auto* attribute = m_attributes ? m_attributes->get_attribute(name) : nullptr;
 
     // 4. If attribute is null, create an attribute whose local name is qualifiedName, value is value, and node document
     //    is this’s node document, then append this attribute to this, and then return.
     if (!attribute) {
         auto new_attribute = Attr::create(document(), insert_as_lowercase ? MUST(Infra::to_ascii_lowercase(name)) : name, value);
-        m_attributes->append_attribute(new_attribute);
+        ensure_attributes().append_attribute(new_attribute);
 
         return {};
     }
@@ -254,20 +257,20 @@ WebIDL::ExceptionOr<void> Element::set_attribute_ns(Optional<FlyString> const& n
 // https://dom.spec.whatwg.org/#concept-element-attributes-append
 void Element::append_attribute(FlyString const& name, String const& value)
 {
-    m_attributes->append_attribute(Attr::create(document(), name, value));
+    ensure_attributes().append_attribute(Attr::create(document(), name, value));
 }
 
 // https://dom.spec.whatwg.org/#concept-element-attributes-append
 void Element::append_attribute(Attr& attribute)
 {
-    m_attributes->append_attribute(attribute);
+    ensure_attributes().append_attribute(attribute);
 }
 
 // https://dom.spec.whatwg.org/#concept-element-attributes-set-value
 void Element::set_attribute_value(FlyString const& local_name, String const& value, Optional<FlyString> const& prefix, Optional<FlyString> const& namespace_)
 {
     // 1. Let attribute be the result of getting an attribute given namespace, localName, and element.
-    auto* attribute = m_attributes->get_attribute_ns(namespace_, local_name);
+    auto* attribute = m_attributes ? m_attributes->get_attribute_ns(namespace_, local_name) : nullptr;
 
     // 2. If attribute is null, create an attribute whose namespace is namespace, namespace prefix is prefix, local name
     //    is localName, value is value, and node document is element’s node document, then append this attribute to element,
@@ -276,7 +279,7 @@ void Element::set_attribute_value(FlyString const& local_name, String const& val
         QualifiedName name { local_name, prefix, namespace_ };
 
         auto new_attribute = Attr::create(document(), move(name), value);
-        m_attributes->append_attribute(new_attribute);
+        ensure_attributes().append_attribute(new_attribute);
 
         return;
     }
@@ -289,40 +292,42 @@ void Element::set_attribute_value(FlyString const& local_name, String const& val
 WebIDL::ExceptionOr<JS::GCPtr<Attr>> Element::set_attribute_node(Attr& attr)
 {
     // The setAttributeNode(attr) and setAttributeNodeNS(attr) methods steps are to return the result of setting an attribute given attr and this.
-    return m_attributes->set_attribute(attr);
+    return ensure_attributes().set_attribute(attr);
 }
 
 // https://dom.spec.whatwg.org/#dom-element-setattributenodens
 WebIDL::ExceptionOr<JS::GCPtr<Attr>> Element::set_attribute_node_ns(Attr& attr)
 {
     // The setAttributeNode(attr) and setAttributeNodeNS(attr) methods steps are to return the result of setting an attribute given attr and this.
-    return m_attributes->set_attribute(attr);
+    return ensure_attributes().set_attribute(attr);
 }
 
 // https://dom.spec.whatwg.org/#dom-element-removeattribute
 void Element::remove_attribute(FlyString const& name)
 {
     // The removeAttribute(qualifiedName) method steps are to remove an attribute given qualifiedName and this, and then return undefined.
-    m_attributes->remove_attribute(name);
+    if (m_attributes)
+        m_attributes->remove_attribute(name);
 }
 
 // https://dom.spec.whatwg.org/#dom-element-removeattributens
 void Element::remove_attribute_ns(Optional<FlyString> const& namespace_, FlyString const& name)
 {
     // The removeAttributeNS(namespace, localName) method steps are to remove an attribute given namespace, localName, and this, and then return undefined.
-    m_attributes->remove_attribute_ns(namespace_, name);
+    if (m_attributes)
+        m_attributes->remove_attribute_ns(namespace_, name);
 }
 
 // https://dom.spec.whatwg.org/#dom-element-removeattributenode
 WebIDL::ExceptionOr<JS::NonnullGCPtr<Attr>> Element::remove_attribute_node(JS::NonnullGCPtr<Attr> attr)
 {
-    return m_attributes->remove_attribute_node(attr);
+    return ensure_attributes().remove_attribute_node(attr);
 }
 
 // https://dom.spec.whatwg.org/#dom-element-hasattribute
 bool Element::has_attribute(FlyString const& name) const
 {
-    return m_attributes->get_attribute(name) != nullptr;
+    return m_attributes && m_attributes->get_attribute(name) != nullptr;
 }
 
 // https://dom.spec.whatwg.org/#dom-element-hasattributens
@@ -330,6 +335,9 @@ bool Element::has_attribute_ns(Optional<FlyString> const& namespace_, FlyString
 {
     // 1. If namespace is the empty string, then set it to null.
     // 2. Return true if this has an attribute whose namespace is namespace and local name is localName; otherwise false.
+    if (!m_attributes)
+        return false;
+
     if (namespace_ == FlyString {})
         return m_attributes->get_attribute_ns(OptionalNone {}, name) != nullptr;
 
@@ -347,7 +355,7 @@ WebIDL::ExceptionOr<bool> Element::toggle_attribute(FlyString const& name, Optio
     bool insert_as_lowercase = namespace_uri() == Namespace::HTML && document().document_type() == Document::Type::HTML;
 
     // 3. Let attribute be the first attribute in this’s attribute list whose qualified name is qualifiedName, and null otherwise.
-    auto* attribute = m_attributes->get_attribute(name);
+    auto* attribute = m_attributes ? m_attributes->get_attribute(name) : nullptr;
 
     // 4. If attribute is null, then:
     if (!attribute) {
@@ -355,7 +363,7 @@ WebIDL::ExceptionOr<bool> Element::toggle_attribute(FlyString const& name, Optio
         //    string, and node document is this’s node document, then append this attribute to this, and then return true.
         if (!force.has_value() || force.value()) {
             auto new_attribute = Attr::create(document(), insert_as_lowercase ? MUST(Infra::to_ascii_lowercase(name)) : name.to_string(), String {});
-            m_attributes->append_attribute(new_attribute);
+            ensure_attributes().append_attribute(new_attribute);
 
             return true;
         }
@@ -379,7 +387,7 @@ Vector<String> Element::get_attribute_names() const
 {
     // The getAttributeNames() method steps are to return the qualified names of the attributes in this’s attribute list, in order; otherwise a new list.
     Vector<String> names;
-    for (size_t i = 0; i < m_attributes->length(); ++i) {
+    for (size_t i = 0; i < attribute_list_size(); ++i) {
         auto const* attribute = m_attributes->item(i);
         names.append(attribute->name().to_string());
     }
@@ -450,7 +458,7 @@ void Element::run_attribute_change_steps(FlyString const& local_name, Optional<S
     attribute_changed(local_name, old_value, value);
 
     if (old_value != value) {
-        invalidate_style_after_attribute_change(local_name);
+        invalidate_style_after_attribute_change(local_name, old_value, value, namespace_);
         document().bump_dom_tree_version();
     }
 }
@@ -460,11 +468,19 @@ void Element::attribute_changed(FlyString const& name, Optional<String> const&,
     auto value_or_empty = value.value_or(String {});
 
     if (name == HTML::AttributeNames::id) {
+        auto& root = this->root();
+        auto* element_by_id = element_by_id_map_for_root(root);
+        if (element_by_id && m_id.has_value())
+            element_by_id->remove(*m_id, *this);
+
         if (value_or_empty.is_empty())
             m_id = {};
         else
             m_id = value_or_empty;
 
+        if (element_by_id && m_id.has_value())
+            element_by_id->add(*m_id, *this, root);
+
         document().element_id_changed({}, *this);
     } else if (name == HTML::AttributeNames::name) {
         if (value_or_empty.is_empty())
@@ -474,6 +490,10 @@ void Element::attribute_changed(FlyString const& name, Optional<String> const&,
 
         document().element_name_changed({}, *this);
     } else if (name == HTML::AttributeNames::class_) {
+        Optional<Vector<FlyString>> old_indexed_classes;
+        if (&root() == &document())
+            old_indexed_classes = m_classes;
+
         if (value_or_empty.is_empty()) {
             m_classes.clear();
         } else {
@@ -484,6 +504,8 @@ void Element::attribute_changed(FlyString const& name, Optional<String> const&,
                 m_classes.unchecked_append(FlyString::from_utf8(new_class).release_value_but_fixme_should_propagate_errors());
             }
         }
+        if (old_indexed_classes.has_value())
+            document().element_index().classes_changed(*this, *old_indexed_classes);
         if (m_class_list)
             m_class_list->associated_attribute_changed(value_or_empty);
     } else if (name == HTML::AttributeNames::style) {
@@ -1109,8 +1131,15 @@ void Element::inserted()
 {
     Base::inserted();
 
-    if (m_id.has_value())
+    auto& root = this->root();
+    if (&root == &document())
+        document().element_index().add(*this);
+
+    if (m_id.has_value()) {
+        if (auto* element_by_id = element_by_id_map_for_root(root))
+            element_by_id->add(*m_id, *this, root);
         document().element_with_id_was_added({}, *this);
+    }
 
     if (m_name.has_value())
         document().element_with_name_was_added({}, *this);
@@ -1120,11 +1149,20 @@ void Element::removed_from(Node* node)
 {
     Base::removed_from(node);
 
-    if (m_id.has_value())
+    document().element_index().remove(*this);
+
+    if (m_id.has_value()) {
+        // NOTE: We don't know which shadow root we were removed from (if any), but its map will drop us on lookup.
+        document().element_by_id().remove(*m_id, *this);
         document().element_with_id_was_removed({}, *this);
+    }
 
     if (m_name.has_value())
         document().element_with_name_was_removed({}, *this);
+
+    // NOTE: Losing our box this way doesn't go through layout, so we have to tell resize observations ourselves.
+    if (is_observed_by_resize_observer())
+        did_change_box_size();
 }
 
 void Element::children_changed()
@@ -1930,15 +1968,113 @@ ErrorOr<void> Element::scroll_into_view(Optional<Variant<bool, ScrollIntoViewOpt
     // FIXME: 8. Optionally perform some other action that brings the element to the user’s attention.
 }
 
-void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name)
+void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name, Optional<String> const& old_value, Optional<String> const& new_value, Optional<FlyString> const& namespace_)
 {
-    // FIXME: Only invalidate if the attribute can actually affect style.
-    (void)attribute_name;
+    // NOTE: Classes and ids are only visible to style through selectors, so we can use the invalidation sets to find
+    //       exactly the elements whose matched rules may change.
+    if (!namespace_.has_value() && (attribute_name == HTML::AttributeNames::class_ || attribute_name == HTML::AttributeNames::id)) {
+        if (invalidate_style_with_invalidation_sets(attribute_name, old_value, new_value))
+            return;
+    }
 
+    // FIXME: Only invalidate if the attribute can actually affect style.
     // FIXME: This will need to become smarter when we implement the :has() selector.
     invalidate_style(StyleInvalidationReason::ElementAttributeChange);
 }
 
+static void apply_invalidation_set(Element& element, CSS::StyleComputer::InvalidationSet const& invalidation_set)
+{
+    if (invalidation_set.invalidate_parent_subtree) {
+        if (auto* parent = element.parent_or_shadow_host())
+            parent->invalidate_style_of_subtree(StyleInvalidationReason::ElementAttributeChange);
+        else
+            element.invalidate_style_of_subtree(StyleInvalidationReason::ElementAttributeChange);
+        return;
+    }
+
+    if (invalidation_set.invalidate_subsequent_siblings) {
+        for (auto* sibling = element.next_element_sibling(); sibling; sibling = sibling->next_element_sibling())
+            sibling->invalidate_style_of_subtree(StyleInvalidationReason::ElementAttributeChange);
+    }
+
+    if (invalidation_set.invalidate_self || invalidation_set.invalidate_whole_subtree) {
+        element.invalidate_style_of_subtree(StyleInvalidationReason::ElementAttributeChange);
+        return;
+    }
+
+    if (invalidation_set.descendant_ids.is_empty() && invalidation_set.descendant_classes.is_empty() && invalidation_set.descendant_tag_names.is_empty())
+        return;
+
+    element.for_each_in_subtree_of_type<Element>([&](Element& descendant) {
+        bool might_match = invalidation_set.descendant_tag_names.contains(descendant.local_name());
+        if (!might_match) {
+            if (auto id = descendant.id(); id.has_value())
+                might_match = invalidation_set.descendant_ids.contains(id.value());
+        }
+        if (!might_match) {
+            for (auto const& class_name : descendant.class_names()) {
+                if (invalidation_set.descendant_classes.contains(class_name)) {
+                    might_match = true;
+                    break;
+                }
+            }
+        }
+
+        if (!might_match)
+            return TraversalDecision::Continue;
+
+        descendant.invalidate_style_of_subtree(StyleInvalidationReason::ElementAttributeChange);
+        return TraversalDecision::SkipChildrenAndContinue;
+    });
+}
+
+// Returns false if the invalidation sets can't be used for this change, and the caller has to invalidate conservatively.
+bool Element::invalidate_style_with_invalidation_sets(FlyString const& attribute_name, Optional<String> const& old_value, Optional<String> const& new_value)
+{
+    if (document().needs_full_style_update())
+        return true;
+
+    // NOTE: Class and id selectors match case-insensitively in quirks mode, but the invalidation sets are keyed exactly.
+    if (document().in_quirks_mode())
+        return false;
+
+    auto& style_computer = document().style_computer();
+    if (!style_computer.can_use_invalidation_sets())
+        return false;
+
+    auto invalidate_for_feature = [&](StringView feature) {
+        auto name = FlyString::from_utf8(feature).release_value_but_fixme_should_propagate_errors();
+        auto const* invalidation_set = attribute_name == HTML::AttributeNames::class_
+            ? style_computer.invalidation_set_for_class(name)
+            : style_computer.invalidation_set_for_id(name);
+        if (invalidation_set)
+            apply_invalidation_set(*this, *invalidation_set);
+    };
+
+    if (attribute_name == HTML::AttributeNames::id) {
+        if (old_value.has_value() && !old_value->is_empty())
+            invalidate_for_feature(*old_value);
+        if (new_value.has_value() && !new_value->is_empty())
+            invalidate_for_feature(*new_value);
+        return true;
+    }
+
+    // Only classes that were added or removed can change which rules match.
+    auto old_class_list = old_value.value_or(String {});
+    auto new_class_list = new_value.value_or(String {});
+    auto old_classes = old_class_list.bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace);
+    auto new_classes = new_class_list.bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace);
+    for (auto old_class : old_classes) {
+        if (!new_classes.contains_slow(old_class))
+            invalidate_for_feature(old_class);
+    }
+    for (auto new_class : new_classes) {
+        if (!old_classes.contains_slow(new_class))
+            invalidate_for_feature(new_class);
+    }
+    return true;
+}
+
 // https://www.w3.org/TR/wai-aria-1.2/#tree_exclusion
 bool Element::exclude_from_accessibility_tree() const
 {
@@ -2102,7 +2238,7 @@ JS::ThrowCompletionOr<void> Element::upgrade_element(JS::NonnullGCPtr<HTML::Cust
 
     // 4. For each attribute in element's attribute list, in order, enqueue a custom element callback reaction with element, callback name "attributeChangedCallback",
     //    and an argument list containing attribute's local name, null, attribute's value, and attribute's namespace.
-    for (size_t attribute_index = 0; attribute_index < m_attributes->length(); ++attribute_index) {
+    for (size_t attribute_index = 0; attribute_index < attribute_list_size(); ++attribute_index) {
         auto const* attribute = m_attributes->item(attribute_index);
         VERIFY(attribute);
 
@@ -2247,7 +2383,7 @@ Optional<String> Element::locate_a_namespace_prefix(Optional<String> const& name
 
 void Element::for_each_attribute(Function<void(Attr const&)> callback) const
 {
-    for (size_t i = 0; i < m_attributes->length(); ++i)
+    for (size_t i = 0; i < attribute_list_size(); ++i)
         callback(*m_attributes->item(i));
 }
 
@@ -2270,14 +2406,29 @@ JS::GCPtr<Layout::NodeWithStyle const> Element::layout_node() const
 
 bool Element::has_attributes() const
 {
-    return !m_attributes->is_empty();
+    return m_attributes && !m_attributes->is_empty();
 }
 
 size_t Element::attribute_list_size() const
 {
+    if (!m_attributes)
+        return 0;
     return m_attributes->length();
 }
 
+NamedNodeMap& Element::ensure_attributes()
+{
+    if (!m_attributes)
+        m_attributes = NamedNodeMap::create(*this);
+    return *m_attributes;
+}
+
+// https://dom.spec.whatwg.org/#dom-element-attributes
+NamedNodeMap* Element::attributes_for_bindings()
+{
+    return &ensure_attributes();
+}
+
 void Element::set_computed_css_values(RefPtr<CSS::StyleProperties> style)
 {
     m_computed_css_values = move(style);
@@ -2474,11 +2625,9 @@ bool Element::check_visibility(Optional<CheckVisibilityOptions> options)
     }
 
     // 5. If the contentVisibilityAuto dictionary member of options is true and an ancestor of this in the flat tree skips its contents due to content-visibility: auto, return false.
-    // FIXME: Currently we do not skip any content if content-visibility is auto: https://drafts.csswg.org/css-contain-2/#proximity-to-the-viewport
-    auto const skipped_contents_due_to_content_visibility_auto = false;
-    if (options->content_visibility_auto && skipped_contents_due_to_content_visibility_auto) {
-        for (auto* element = this; element; element = element->parent_element()) {
-            if (element->computed_css_values()->content_visibility() == CSS::ContentVisibility::Auto)
+    if (options->content_visibility_auto) {
+        for (auto* element = parent_element(); element; element = element->parent_element()) {
+            if (element->computed_css_values()->content_visibility() == CSS::ContentVisibility::Auto && element->skips_its_contents())
                 return false;
         }
     }
@@ -2487,6 +2636,97 @@ bool Element::check_visibility(Optional<CheckVisibilityOptions> options)
     return true;
 }
 
+// https://drafts.csswg.org/css-contain-2/#determine-proximity-to-the-viewport
+void Element::determine_proximity_to_the_viewport()
+{
+    // NOTE: An element without a box is neither close to nor far away from the viewport, so we keep whatever was
+    //       determined before.
+    auto const* paintable_box = this->paintable_box();
+    if (!paintable_box)
+        return;
+
+    // An element is close to the viewport if any part of it intersects the viewport, or an implementation-defined
+    // margin around it. We use a margin of half the viewport size in each direction, so that content is usually laid
+    // out before it is scrolled into view.
+    // FIXME: This only considers the viewport, and not the scroll containers that the element is nested in.
+    auto viewport_rect = document().viewport_rect();
+    auto margin_x = viewport_rect.width() / 2;
+    auto margin_y = viewport_rect.height() / 2;
+    viewport_rect.inflate(margin_y, margin_x, margin_y, margin_x);
+
+    auto proximity = paintable_box->absolute_border_box_rect().intersects(viewport_rect)
+        ? ProximityToTheViewport::CloseToTheViewport
+        : ProximityToTheViewport::FarAwayFromTheViewport;
+    if (proximity == m_proximity_to_the_viewport)
+        return;
+
+    bool skipped_its_contents = skips_its_contents();
+    m_proximity_to_the_viewport = proximity;
+    if (skips_its_contents() == skipped_its_contents)
+        return;
+
+    // NOTE: The element's contents start or stop being laid out and painted, which needs a new layout tree. Marking the
+    //       element itself also lets the deferred style updates of its contents run, see update_style_recursively().
+    set_needs_style_update(true);
+    document().invalidate_layout_tree();
+}
+
+// https://drafts.csswg.org/css-contain-2/#relevant-to-the-user
+bool Element::is_relevant_to_the_user() const
+{
+    // An element is relevant to the user if any of the following conditions are true:
+    // - The element is "on-screen": its proximity to the viewport is close to the viewport.
+    // FIXME: - The element or its contents are focused, as described by the :focus-within pseudo-class.
+    // FIXME: - The element or its contents are selected, where selection is described in the selection API.
+    // FIXME: - The element or its contents are placed in the top layer.
+    // FIXME: - The element has a flat tree descendant that is captured in a view transition.
+    return m_proximity_to_the_viewport == ProximityToTheViewport::CloseToTheViewport;
+}
+
+// https://drafts.csswg.org/css-contain-2/#skips-its-contents
+bool Element::skips_its_contents() const
+{
+    if (!m_computed_css_values)
+        return false;
+
+    switch (m_computed_css_values->content_visibility().value_or(CSS::ContentVisibility::Visible)) {
+    case CSS::ContentVisibility::Visible:
+        return false;
+    case CSS::ContentVisibility::Auto:
+        // If the element is not relevant to the user, it also skips its contents.
+        return !is_relevant_to_the_user();
+    case CSS::ContentVisibility::Hidden:
+        // The element skips its contents.
+        return true;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+// https://drafts.csswg.org/css-sizing-4/#last-remembered
+void Element::update_last_remembered_size()
+{
+    // NOTE: The spec does this at the time ResizeObserver events are determined and delivered, for every element.
+    //       Since only an element that skips its contents ever uses its last remembered size, we do it along with the
+    //       proximity to the viewport of elements with content-visibility: auto.
+    auto const* paintable_box = this->paintable_box();
+    if (!paintable_box)
+        return;
+
+    // If the element has contain-intrinsic-size: auto in neither axis, it has no last remembered size.
+    auto const& computed_values = paintable_box->computed_values();
+    if (!computed_values.contain_intrinsic_width().use_last_remembered_size && !computed_values.contain_intrinsic_height().use_last_remembered_size) {
+        m_last_remembered_size = {};
+        return;
+    }
+
+    // If the element is skipping its contents, its size does not change its last remembered size.
+    if (skips_its_contents())
+        return;
+
+    // Otherwise, its last remembered size is the size of its content box.
+    m_last_remembered_size = paintable_box->content_size();
+}
+
 bool Element::id_reference_exists(String const& id_reference) const
 {
     return document().get_element_by_id(id_reference);
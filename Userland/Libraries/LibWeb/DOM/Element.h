@@ -136,7 +136,9 @@ public:
 
     WebIDL::ExceptionOr<bool> toggle_attribute(FlyString const& name, Optional<bool> force);
     size_t attribute_list_size() const;
+    // NOTE: The attribute list is only allocated once an attribute is added or it's accessed from JS, so this may be null.
     NamedNodeMap const* attributes() const { return m_attributes.ptr(); }
+    NamedNodeMap* attributes_for_bindings();
     Vector<String> get_attribute_names() const;
 
     JS::GCPtr<Attr> get_attribute_node(FlyString const& name) const;
@@ -370,6 +372,33 @@ public:
 
     bool check_visibility(Optional<CheckVisibilityOptions>);
 
+    // https://drafts.csswg.org/css-contain-2/#proximity-to-the-viewport
+    enum class ProximityToTheViewport {
+        NotDetermined,
+        CloseToTheViewport,
+        FarAwayFromTheViewport,
+    };
+    ProximityToTheViewport proximity_to_the_viewport() const { return m_proximity_to_the_viewport; }
+    void determine_proximity_to_the_viewport();
+
+    // https://drafts.csswg.org/css-contain-2/#relevant-to-the-user
+    bool is_relevant_to_the_user() const;
+
+    // https://drafts.csswg.org/css-contain-2/#skips-its-contents
+    bool skips_its_contents() const;
+
+    // https://drafts.csswg.org/css-sizing-4/#last-remembered
+    Optional<CSSPixelSize> const& last_remembered_size() const { return m_last_remembered_size; }
+    void update_last_remembered_size();
+
+    // NOTE: LayoutState::commit() counts the changes to the box size of elements that are observed by a ResizeObserver,
+    //       so that resize observations only have to recalculate the sizes of boxes that actually changed.
+    bool is_observed_by_resize_observer() const { return m_resize_observation_count > 0; }
+    void did_create_resize_observation(Badge<ResizeObserver::ResizeObservation>) { ++m_resize_observation_count; }
+    void did_finalize_resize_observation(Badge<ResizeObserver::ResizeObservation>) { --m_resize_observation_count; }
+    u64 box_size_change_count() const { return m_box_size_change_count; }
+    void did_change_box_size() { ++m_box_size_change_count; }
+
     void register_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, IntersectionObserver::IntersectionObserverRegistration);
     void unregister_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, JS::NonnullGCPtr<IntersectionObserver::IntersectionObserver>);
     IntersectionObserver::IntersectionObserverRegistration& get_intersection_observer_registration(Badge<DOM::Document>, IntersectionObserver::IntersectionObserver const&);
@@ -432,7 +461,10 @@ protected:
 private:
     void make_html_uppercased_qualified_name();
 
-    void invalidate_style_after_attribute_change(FlyString const& attribute_name);
+    NamedNodeMap& ensure_attributes();
+
+    void invalidate_style_after_attribute_change(FlyString const& attribute_name, Optional<String> const& old_value, Optional<String> const& new_value, Optional<FlyString> const& namespace_);
+    [[nodiscard]] bool invalidate_style_with_invalidation_sets(FlyString const& attribute_name, Optional<String> const& old_value, Optional<String> const& new_value);
 
     WebIDL::ExceptionOr<JS::GCPtr<Node>> insert_adjacent(StringView where, JS::NonnullGCPtr<Node> node);
 
@@ -496,6 +528,12 @@ private:
 
     bool m_in_top_layer { false };
 
+    ProximityToTheViewport m_proximity_to_the_viewport { ProximityToTheViewport::NotDetermined };
+    Optional<CSSPixelSize> m_last_remembered_size;
+
+    size_t m_resize_observation_count { 0 };
+    u64 m_box_size_change_count { 0 };
+
     OwnPtr<CSS::CountersSet> m_counters_set;
 };
 
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/ElementByIdMap.h>
+#include <LibWeb/DOM/ShadowRoot.h>
+
+namespace Web::DOM {
+
+static bool is_valid_entry(WeakPtr<Element> const& element, FlyString const& element_id, Node const& root)
+{
+    return element && element->id() == element_id && &element->root() == &root;
+}
+
+void ElementByIdMap::add(FlyString const& element_id, Element& element, Node const& root)
+{
+    auto& elements = m_map.ensure(element_id);
+    elements.remove_all_matching([&](auto const& other) {
+        return other.ptr() == &element || !is_valid_entry(other, element_id, root);
+    });
+
+    auto index = elements.find_first_index_if([&](auto const& other) { return element.is_before(*other.ptr()); });
+    elements.insert(index.value_or(elements.size()), element);
+}
+
+void ElementByIdMap::remove(FlyString const& element_id, Element& element)
+{
+    auto it = m_map.find(element_id);
+    if (it == m_map.end())
+        return;
+    it->value.remove_first_matching([&](auto const& other) { return other.ptr() == &element; });
+    if (it->value.is_empty())
+        m_map.remove(it);
+}
+
+Vector<WeakPtr<Element>>* ElementByIdMap::valid_elements_with_id(FlyString const& element_id, Node const& root) const
+{
+    auto it = m_map.find(element_id);
+    if (it == m_map.end())
+        return nullptr;
+    it->value.remove_all_matching([&](auto const& element) { return !is_valid_entry(element, element_id, root); });
+    if (it->value.is_empty()) {
+        m_map.remove(it);
+        return nullptr;
+    }
+    return &it->value;
+}
+
+JS::GCPtr<Element> ElementByIdMap::get(FlyString const& element_id, Node const& root) const
+{
+    if (auto* elements = valid_elements_with_id(element_id, root))
+        return elements->first().ptr();
+    return {};
+}
+
+Vector<JS::NonnullGCPtr<Element>> ElementByIdMap::elements_with_id(FlyString const& element_id, Node const& root) const
+{
+    Vector<JS::NonnullGCPtr<Element>> result;
+    if (auto* elements = valid_elements_with_id(element_id, root)) {
+        result.ensure_capacity(elements->size());
+        for (auto const& element : *elements)
+            result.unchecked_append(*element.ptr());
+    }
+    return result;
+}
+
+ElementByIdMap* element_by_id_map_for_root(Node& root)
+{
+    if (root.is_document())
+        return &static_cast<Document&>(root).element_by_id();
+    if (root.is_shadow_root())
+        return &static_cast<ShadowRoot&>(root).element_by_id();
+    return nullptr;
+}
+
+ElementByIdMap const* element_by_id_map_for_root(Node const& root)
+{
+    return element_by_id_map_for_root(const_cast<Node&>(root));
+}
+
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
+#include <AK/Vector.h>
+#include <AK/WeakPtr.h>
+#include <LibJS/Heap/GCPtr.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::DOM {
+
+// Maps IDs to the elements of a document or shadow root that have them, in tree order.
+// NOTE: Elements that were removed from a shadow root aren't always removed from its map, so entries are checked
+//       against their current ID and root whenever they're looked up.
+class ElementByIdMap {
+public:
+    void add(FlyString const& element_id, Element&, Node const& root);
+    void remove(FlyString const& element_id, Element&);
+
+    JS::GCPtr<Element> get(FlyString const& element_id, Node const& root) const;
+    Vector<JS::NonnullGCPtr<Element>> elements_with_id(FlyString const& element_id, Node const& root) const;
+
+private:
+    Vector<WeakPtr<Element>>* valid_elements_with_id(FlyString const& element_id, Node const& root) const;
+
+    mutable HashMap<FlyString, Vector<WeakPtr<Element>>> m_map;
+};
+
+// Returns the ID map of the given node if it's a document or shadow root.
+ElementByIdMap* element_by_id_map_for_root(Node&);
+ElementByIdMap const* element_by_id_map_for_root(Node const&);
+
+}
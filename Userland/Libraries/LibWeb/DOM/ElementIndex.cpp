@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/ElementIndex.h>
+
+namespace Web::DOM {
+
+// Sorting by comparing paths is only worth it for a few elements. For more, we walk the subtree once instead.
+static constexpr size_t max_element_count_to_sort_by_path = 64;
+
+static void add_to(HashMap<FlyString, HashTable<JS::NonnullGCPtr<Element>>>& map, FlyString const& key, Element& element)
+{
+    map.ensure(key).set(element);
+}
+
+static void remove_from(HashMap<FlyString, HashTable<JS::NonnullGCPtr<Element>>>& map, FlyString const& key, Element& element)
+{
+    auto it = map.find(key);
+    if (it == map.end())
+        return;
+    it->value.remove(element);
+    if (it->value.is_empty())
+        map.remove(it);
+}
+
+void ElementIndex::add(Element& element)
+{
+    add_to(m_elements_by_local_name, element.local_name(), element);
+    for (auto const& class_name : element.class_names())
+        add_to(m_elements_by_class, class_name, element);
+}
+
+void ElementIndex::remove(Element& element)
+{
+    remove_from(m_elements_by_local_name, element.local_name(), element);
+    for (auto const& class_name : element.class_names())
+        remove_from(m_elements_by_class, class_name, element);
+}
+
+void ElementIndex::classes_changed(Element& element, ReadonlySpan<FlyString> old_classes)
+{
+    for (auto const& class_name : old_classes)
+        remove_from(m_elements_by_class, class_name, element);
+    for (auto const& class_name : element.class_names())
+        add_to(m_elements_by_class, class_name, element);
+}
+
+// The child indices on the way from the ancestor down to the node, which compare like the nodes do in tree order.
+static Vector<size_t> tree_order_path(Node const& ancestor, Node const& node)
+{
+    Vector<size_t> path;
+    for (auto const* current = &node; current != &ancestor; current = current->parent())
+        path.append(current->index());
+    path.reverse();
+    return path;
+}
+
+static Vector<JS::NonnullGCPtr<Element>> descendants_in_tree_order(ParentNode const& ancestor, HashMap<FlyString, HashTable<JS::NonnullGCPtr<Element>>> const& map, FlyString const& key)
+{
+    auto it = map.find(key);
+    if (it == map.end())
+        return {};
+    auto const& elements = it->value;
+
+    Vector<JS::NonnullGCPtr<Element>> result;
+    if (elements.size() > max_element_count_to_sort_by_path) {
+        ancestor.for_each_in_subtree_of_type<Element>([&](Element const& element) {
+            if (elements.contains(const_cast<Element&>(element)))
+                result.append(const_cast<Element&>(element));
+            return TraversalDecision::Continue;
+        });
+        return result;
+    }
+
+    Vector<Vector<size_t>> paths;
+    for (auto const& element : elements) {
+        if (!ancestor.is_ancestor_of(*element))
+            continue;
+        result.append(element);
+        paths.append(tree_order_path(ancestor, *element));
+    }
+
+    Vector<size_t> order;
+    order.ensure_capacity(result.size());
+    for (size_t i = 0; i < result.size(); ++i)
+        order.unchecked_append(i);
+    quick_sort(order, [&](size_t a, size_t b) {
+        auto const& path_a = paths[a];
+        auto const& path_b = paths[b];
+        for (size_t i = 0; i < min(path_a.size(), path_b.size()); ++i) {
+            if (path_a[i] != path_b[i])
+                return path_a[i] < path_b[i];
+        }
+        return path_a.size() < path_b.size();
+    });
+
+    Vector<JS::NonnullGCPtr<Element>> sorted_result;
+    sorted_result.ensure_capacity(result.size());
+    for (auto index : order)
+        sorted_result.unchecked_append(result[index]);
+    return sorted_result;
+}
+
+Vector<JS::NonnullGCPtr<Element>> ElementIndex::descendants_with_class(ParentNode const& ancestor, FlyString const& class_name) const
+{
+    return descendants_in_tree_order(ancestor, m_elements_by_class, class_name);
+}
+
+Vector<JS::NonnullGCPtr<Element>> ElementIndex::descendants_with_local_name(ParentNode const& ancestor, FlyString const& local_name) const
+{
+    return descendants_in_tree_order(ancestor, m_elements_by_local_name, local_name);
+}
+
+void ElementIndex::visit_edges(JS::Cell::Visitor& visitor)
+{
+    for (auto& it : m_elements_by_class) {
+        for (auto& element : it.value)
+            visitor.visit(element);
+    }
+    for (auto& it : m_elements_by_local_name) {
+        for (auto& element : it.value)
+            visitor.visit(element);
+    }
+}
+
+ElementIndex const* element_index_for_descendants_of(ParentNode const& node)
+{
+    auto const& document = node.document();
+    if (&node.root() != &document)
+        return nullptr;
+    return &document.element_index();
+}
+
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/Vector.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibJS/Heap/GCPtr.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::DOM {
+
+// Indexes the elements of a document tree (excluding shadow trees) by class and local name, so that selectors and
+// collections that require one of them only have to look at elements that have it.
+class ElementIndex {
+public:
+    void add(Element&);
+    void remove(Element&);
+    void classes_changed(Element&, ReadonlySpan<FlyString> old_classes);
+
+    // These return the indexed descendants of the given node in tree order.
+    Vector<JS::NonnullGCPtr<Element>> descendants_with_class(ParentNode const&, FlyString const& class_name) const;
+    Vector<JS::NonnullGCPtr<Element>> descendants_with_local_name(ParentNode const&, FlyString const& local_name) const;
+
+    void visit_edges(JS::Cell::Visitor&);
+
+private:
+    using ElementSet = HashTable<JS::NonnullGCPtr<Element>>;
+
+    HashMap<FlyString, ElementSet> m_elements_by_class;
+    HashMap<FlyString, ElementSet> m_elements_by_local_name;
+};
+
+// Returns the index that covers the descendants of the given node, if they're in a document tree.
+ElementIndex const* element_index_for_descendants_of(ParentNode const&);
+
+}
@@ -9,6 +9,7 @@
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/ElementIndex.h>
 #include <LibWeb/DOM/HTMLCollection.h>
 #include <LibWeb/DOM/ParentNode.h>
 #include <LibWeb/Namespace.h>
@@ -82,7 +83,18 @@ void HTMLCollection::update_cache_if_needed() const
 
     m_cached_elements.clear();
     m_cached_name_to_element_mappings = nullptr;
-    if (m_scope == Scope::Descendants) {
+    ElementIndex const* element_index = nullptr;
+    if (m_scope == Scope::Descendants && m_index_hint.has_value())
+        element_index = element_index_for_descendants_of(*m_root);
+    if (element_index) {
+        auto candidates = m_index_hint->kind == IndexHint::Kind::Class
+            ? element_index->descendants_with_class(*m_root, m_index_hint->name)
+            : element_index->descendants_with_local_name(*m_root, m_index_hint->name);
+        for (auto& element : candidates) {
+            if (m_filter(*element))
+                m_cached_elements.append(element);
+        }
+    } else if (m_scope == Scope::Descendants) {
         m_root->for_each_in_subtree_of_type<Element>([&](auto& element) {
             if (m_filter(element))
                 m_cached_elements.append(element);
@@ -34,6 +34,18 @@ public:
 
     virtual ~HTMLCollection() override;
 
+    // Tells the collection that its filter only matches elements with the given class or local name, so it can
+    // get its candidates from the document's ElementIndex instead of walking the whole subtree.
+    struct IndexHint {
+        enum class Kind {
+            Class,
+            LocalName,
+        };
+        Kind kind;
+        FlyString name;
+    };
+    void set_index_hint(IndexHint hint) { m_index_hint = move(hint); }
+
     size_t length() const;
     Element* item(size_t index) const;
     Element* named_item(FlyString const& key) const;
@@ -67,6 +79,7 @@ private:
     Function<bool(Element const&)> m_filter;
 
     Scope m_scope { Scope::Descendants };
+    Optional<IndexHint> m_index_hint;
 };
 
 }
@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
+#include <AK/CharacterTypes.h>
 #include <LibWeb/Bindings/NamedNodeMapPrototype.h>
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/Document.h>
@@ -151,6 +153,18 @@ Attr const* NamedNodeMap::get_attribute(FlyString const& qualified_name, size_t*
     // FIXME: Handle the second condition, assume it is an HTML document for now.
     bool compare_as_lowercase = associated_element().namespace_uri() == Namespace::HTML;
 
+    // OPTIMIZATION: Names that are already in lowercase, like all the ones in HTML::AttributeNames, can be compared with
+    //               each attribute's lowercase name by pointer instead of character by character.
+    if (compare_as_lowercase && !any_of(qualified_name.bytes(), is_ascii_upper_alpha)) {
+        for (auto const& attribute : m_attributes) {
+            if (attribute->lowercase_name() == qualified_name)
+                return attribute;
+            if (item_index)
+                ++(*item_index);
+        }
+        return nullptr;
+    }
+
     // 2. Return the first attribute in element’s attribute list whose qualified name is qualifiedName; otherwise null.
     for (auto const& attribute : m_attributes) {
         if (compare_as_lowercase) {
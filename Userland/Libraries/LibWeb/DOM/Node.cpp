@@ -422,32 +422,27 @@ void Node::invalidate_style(StyleInvalidationReason reason)
     // FIXME: This is a lot of invalidation and we should implement more sophisticated invalidation to do less work!
 
     auto invalidate_entire_subtree = [&](Node& subtree_root) {
-        subtree_root.for_each_in_inclusive_subtree([&](Node& node) {
-            node.m_needs_style_update = true;
-            if (node.has_children())
-                node.m_child_needs_style_update = true;
-            if (auto shadow_root = node.is_element() ? static_cast<DOM::Element&>(node).shadow_root() : nullptr) {
-                node.m_child_needs_style_update = true;
-                shadow_root->m_needs_style_update = true;
-                if (shadow_root->has_children())
-                    shadow_root->m_child_needs_style_update = true;
-            }
-            return TraversalDecision::Continue;
-        });
+        subtree_root.mark_inclusive_subtree_as_needing_style_update();
     };
 
     invalidate_entire_subtree(*this);
 
-    if (reason == StyleInvalidationReason::NodeInsertBefore || reason == StyleInvalidationReason::NodeRemove) {
+    // If the parent's entire subtree is already marked, so are all of our siblings. This is the common case when
+    // appending many children in a row, where each insertion would otherwise walk all of the previous ones.
+    bool siblings_are_invalidated = parent() && parent()->m_entire_subtree_needs_style_update;
+
+    if (!siblings_are_invalidated && (reason == StyleInvalidationReason::NodeInsertBefore || reason == StyleInvalidationReason::NodeRemove)) {
         for (auto* sibling = previous_sibling(); sibling; sibling = sibling->previous_sibling()) {
             if (sibling->is_element())
                 invalidate_entire_subtree(*sibling);
         }
     }
 
-    for (auto* sibling = next_sibling(); sibling; sibling = sibling->next_sibling()) {
-        if (sibling->is_element())
-            invalidate_entire_subtree(*sibling);
+    if (!siblings_are_invalidated) {
+        for (auto* sibling = next_sibling(); sibling; sibling = sibling->next_sibling()) {
+            if (sibling->is_element())
+                invalidate_entire_subtree(*sibling);
+        }
     }
 
     for (auto* ancestor = parent_or_shadow_host(); ancestor; ancestor = ancestor->parent_or_shadow_host())
@@ -455,6 +450,52 @@ void Node::invalidate_style(StyleInvalidationReason reason)
     document().schedule_style_update();
 }
 
+void Node::invalidate_style_of_subtree(StyleInvalidationReason reason)
+{
+    if (is_character_data())
+        return;
+
+    if (is_document()) {
+        invalidate_style(reason);
+        return;
+    }
+
+    if (document().needs_full_style_update())
+        return;
+
+    if (!needs_style_update()) {
+        dbgln_if(STYLE_INVALIDATION_DEBUG, "Invalidate style of subtree ({}): {}", to_string(reason), debug_description());
+    }
+
+    mark_inclusive_subtree_as_needing_style_update();
+
+    for (auto* ancestor = parent_or_shadow_host(); ancestor; ancestor = ancestor->parent_or_shadow_host())
+        ancestor->m_child_needs_style_update = true;
+    document().schedule_style_update();
+}
+
+void Node::mark_inclusive_subtree_as_needing_style_update()
+{
+    if (m_entire_subtree_needs_style_update)
+        return;
+
+    for_each_in_inclusive_subtree([&](Node& node) {
+        if (node.m_entire_subtree_needs_style_update)
+            return TraversalDecision::SkipChildrenAndContinue;
+        node.m_needs_style_update = true;
+        node.m_entire_subtree_needs_style_update = true;
+        if (node.has_children())
+            node.m_child_needs_style_update = true;
+        if (auto shadow_root = node.is_element() ? static_cast<DOM::Element&>(node).shadow_root() : nullptr) {
+            node.m_child_needs_style_update = true;
+            shadow_root->m_needs_style_update = true;
+            if (shadow_root->has_children())
+                shadow_root->m_child_needs_style_update = true;
+        }
+        return TraversalDecision::Continue;
+    });
+}
+
 String Node::child_text_content() const
 {
     if (!is<ParentNode>(*this))
@@ -647,7 +688,11 @@ void Node::insert_before(JS::NonnullGCPtr<Node> node, JS::GCPtr<Node> child, boo
         // 6. Run assign slottables for a tree with node’s root.
         assign_slottables_for_a_tree(node_to_insert->root());
 
-        node_to_insert->invalidate_style(StyleInvalidationReason::NodeInsertBefore);
+        // NOTE: A disconnected tree has no style to keep up to date. Once it is connected, the node inserted into the
+        //       document is invalidated along with its whole subtree, and every descendant is marked by its insertion
+        //       steps, so building a large detached subtree doesn't need to invalidate anything along the way.
+        if (is_connected())
+            node_to_insert->invalidate_style(StyleInvalidationReason::NodeInsertBefore);
 
         // 7. For each shadow-including inclusive descendant inclusiveDescendant of node, in shadow-including tree order:
         node_to_insert->for_each_shadow_including_inclusive_descendant([&](Node& inclusive_descendant) {
@@ -1172,6 +1217,13 @@ void Node::set_needs_style_update(bool value)
         return;
     m_needs_style_update = value;
 
+    if (!m_needs_style_update) {
+        // Neither this subtree nor any subtree containing it is entirely marked anymore.
+        m_entire_subtree_needs_style_update = false;
+        for (auto* ancestor = parent_or_shadow_host(); ancestor && ancestor->m_entire_subtree_needs_style_update; ancestor = ancestor->parent_or_shadow_host())
+            ancestor->m_entire_subtree_needs_style_update = false;
+    }
+
     if (m_needs_style_update) {
         for (auto* ancestor = parent_or_shadow_host(); ancestor; ancestor = ancestor->parent_or_shadow_host()) {
             ancestor->m_child_needs_style_update = true;
@@ -261,7 +261,12 @@ public:
     bool child_needs_style_update() const { return m_child_needs_style_update; }
     void set_child_needs_style_update(bool b) { m_child_needs_style_update = b; }
 
+    // Marks this node and all of its descendants as needing a style update, without touching its ancestors.
+    void mark_inclusive_subtree_as_needing_style_update();
+
     void invalidate_style(StyleInvalidationReason);
+    // Like invalidate_style(), but only for this node and its descendants, leaving its siblings alone.
+    void invalidate_style_of_subtree(StyleInvalidationReason);
 
     void set_document(Badge<Document>, Document&);
 
@@ -752,6 +757,10 @@ protected:
     bool m_needs_style_update { false };
     bool m_child_needs_style_update { false };
 
+    // Set when every node in this node's inclusive subtree has been marked as needing a style update, and none of
+    // them has been updated since. Lets repeated invalidations of the same subtree stop without walking it again.
+    bool m_entire_subtree_needs_style_update { false };
+
     i32 m_unique_id {};
 
     // https://dom.spec.whatwg.org/#registered-observer-list
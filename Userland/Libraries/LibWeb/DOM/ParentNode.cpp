@@ -9,6 +9,7 @@
 #include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/SelectorEngine.h>
 #include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/ElementIndex.h>
 #include <LibWeb/DOM/HTMLCollection.h>
 #include <LibWeb/DOM/NodeOperations.h>
 #include <LibWeb/DOM/ParentNode.h>
@@ -23,6 +24,55 @@ namespace Web::DOM {
 
 JS_DEFINE_ALLOCATOR(ParentNode);
 
+// Only elements that have the ID, class or tag name required by the rightmost compound selector can match. If it
+// requires any of them, we can look up the candidates in the ID map or element index instead of walking the whole
+// subtree. IDs are preferred, as they narrow things down the most.
+static Optional<Vector<JS::NonnullGCPtr<Element>>> candidate_elements_for_selectors(ParentNode& scope, CSS::SelectorList const& selectors)
+{
+    if (selectors.size() != 1)
+        return {};
+
+    auto const& compound_selectors = selectors.first()->compound_selectors();
+    if (compound_selectors.is_empty())
+        return {};
+    auto const& simple_selectors = compound_selectors.last().simple_selectors;
+
+    auto find_simple_selector = [&](CSS::Selector::SimpleSelector::Type type) -> CSS::Selector::SimpleSelector const* {
+        for (auto const& simple_selector : simple_selectors) {
+            if (simple_selector.type == type)
+                return &simple_selector;
+        }
+        return nullptr;
+    };
+
+    if (auto const* id_selector = find_simple_selector(CSS::Selector::SimpleSelector::Type::Id)) {
+        auto& root = scope.root();
+        if (auto const* element_by_id = element_by_id_map_for_root(root)) {
+            auto elements = element_by_id->elements_with_id(id_selector->name(), root);
+            elements.remove_all_matching([&](auto const& element) { return !scope.is_ancestor_of(*element); });
+            return elements;
+        }
+    }
+
+    auto const* element_index = element_index_for_descendants_of(scope);
+    if (!element_index)
+        return {};
+
+    // NOTE: Class selectors match case-insensitively in quirks mode, but the index is keyed by the exact class name.
+    if (!scope.document().in_quirks_mode()) {
+        if (auto const* class_selector = find_simple_selector(CSS::Selector::SimpleSelector::Type::Class))
+            return element_index->descendants_with_class(scope, class_selector->name());
+    }
+
+    // NOTE: Outside of HTML documents, type selectors match local names case-insensitively.
+    if (scope.document().document_type() == Document::Type::HTML) {
+        if (auto const* type_selector = find_simple_selector(CSS::Selector::SimpleSelector::Type::TagName))
+            return element_index->descendants_with_local_name(scope, type_selector->qualified_name().name.lowercase_name);
+    }
+
+    return {};
+}
+
 // https://dom.spec.whatwg.org/#dom-parentnode-queryselector
 WebIDL::ExceptionOr<JS::GCPtr<Element>> ParentNode::query_selector(StringView selector_text)
 {
@@ -41,6 +91,14 @@ WebIDL::ExceptionOr<JS::GCPtr<Element>> ParentNode::query_selector(StringView se
     auto selectors = maybe_selectors.value();
 
     // 3. Return the result of match a selector against a tree with s and node’s root using scoping root node.
+    if (auto candidates = candidate_elements_for_selectors(*this, selectors); candidates.has_value()) {
+        for (auto& element : *candidates) {
+            if (SelectorEngine::matches(*selectors.first(), {}, element, nullptr, {}, this))
+                return element.ptr();
+        }
+        return nullptr;
+    }
+
     JS::GCPtr<Element> result;
     // FIXME: This should be shadow-including. https://drafts.csswg.org/selectors-4/#match-a-selector-against-a-tree
     for_each_in_subtree_of_type<Element>([&](auto& element) {
@@ -74,6 +132,14 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<NodeList>> ParentNode::query_selector_all(S
 
     // 3. Return the result of match a selector against a tree with s and node’s root using scoping root node.
     Vector<JS::Handle<Node>> elements;
+    if (auto candidates = candidate_elements_for_selectors(*this, selectors); candidates.has_value()) {
+        for (auto& element : *candidates) {
+            if (SelectorEngine::matches(*selectors.first(), {}, element, nullptr, {}, this))
+                elements.append(element.ptr());
+        }
+        return StaticNodeList::create(realm(), move(elements));
+    }
+
     // FIXME: This should be shadow-including. https://drafts.csswg.org/selectors-4/#match-a-selector-against-a-tree
     for_each_in_subtree_of_type<Element>([&](auto& element) {
         for (auto& selector : selectors) {
@@ -140,7 +206,7 @@ JS::NonnullGCPtr<HTMLCollection> ParentNode::get_elements_by_tag_name(FlyString
     // 2. Otherwise, if root’s node document is an HTML document, return a HTMLCollection rooted at root, whose filter matches the following descendant elements:
     if (root().document().document_type() == Document::Type::HTML) {
         FlyString qualified_name_in_ascii_lowercase = MUST(Infra::to_ascii_lowercase(qualified_name));
-        return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [qualified_name, qualified_name_in_ascii_lowercase](Element const& element) {
+        auto collection = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [qualified_name, qualified_name_in_ascii_lowercase](Element const& element) {
             // - Whose namespace is the HTML namespace and whose qualified name is qualifiedName, in ASCII lowercase.
             if (element.namespace_uri() == Namespace::HTML)
                 return element.qualified_name() == qualified_name_in_ascii_lowercase;
@@ -148,12 +214,19 @@ JS::NonnullGCPtr<HTMLCollection> ParentNode::get_elements_by_tag_name(FlyString
             // - Whose namespace is not the HTML namespace and whose qualified name is qualifiedName.
             return element.qualified_name() == qualified_name;
         });
+        // NOTE: Without a prefix, the qualified name of any element that can match is also its local name.
+        if (qualified_name == qualified_name_in_ascii_lowercase && !qualified_name.bytes_as_string_view().contains(':'))
+            collection->set_index_hint({ HTMLCollection::IndexHint::Kind::LocalName, qualified_name });
+        return collection;
     }
 
     // 3. Otherwise, return a HTMLCollection rooted at root, whose filter matches descendant elements whose qualified name is qualifiedName.
-    return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [qualified_name](Element const& element) {
+    auto collection = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [qualified_name](Element const& element) {
         return element.qualified_name() == qualified_name;
     });
+    if (!qualified_name.bytes_as_string_view().contains(':'))
+        collection->set_index_hint({ HTMLCollection::IndexHint::Kind::LocalName, qualified_name });
+    return collection;
 }
 
 // https://dom.spec.whatwg.org/#concept-getelementsbytagnamens
@@ -173,9 +246,11 @@ JS::NonnullGCPtr<HTMLCollection> ParentNode::get_elements_by_tag_name_ns(Optiona
 
     // 3. Otherwise, if namespace is "*" (U+002A), return a HTMLCollection rooted at root, whose filter matches descendant elements whose local name is localName.
     if (namespace_ == "*") {
-        return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [local_name](Element const& element) {
+        auto collection = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [local_name](Element const& element) {
             return element.local_name() == local_name;
         });
+        collection->set_index_hint({ HTMLCollection::IndexHint::Kind::LocalName, local_name });
+        return collection;
     }
 
     // 4. Otherwise, if localName is "*" (U+002A), return a HTMLCollection rooted at root, whose filter matches descendant elements whose namespace is namespace.
@@ -186,9 +261,11 @@ JS::NonnullGCPtr<HTMLCollection> ParentNode::get_elements_by_tag_name_ns(Optiona
     }
 
     // 5. Otherwise, return a HTMLCollection rooted at root, whose filter matches descendant elements whose namespace is namespace and local name is localName.
-    return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [namespace_, local_name](Element const& element) {
+    auto collection = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [namespace_, local_name](Element const& element) {
         return element.namespace_uri() == namespace_ && element.local_name() == local_name;
     });
+    collection->set_index_hint({ HTMLCollection::IndexHint::Kind::LocalName, local_name });
+    return collection;
 }
 
 // https://dom.spec.whatwg.org/#dom-parentnode-prepend
@@ -234,13 +311,21 @@ JS::NonnullGCPtr<HTMLCollection> ParentNode::get_elements_by_class_name(StringVi
     for (auto& name : class_names.split_view_if(Infra::is_ascii_whitespace)) {
         list_of_class_names.append(FlyString::from_utf8(name).release_value_but_fixme_should_propagate_errors());
     }
-    return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [list_of_class_names = move(list_of_class_names), quirks_mode = document().in_quirks_mode()](Element const& element) {
+    // NOTE: Class names match case-insensitively in quirks mode, but the index is keyed by the exact class name.
+    Optional<FlyString> indexed_class_name;
+    if (!list_of_class_names.is_empty() && !document().in_quirks_mode())
+        indexed_class_name = list_of_class_names.first();
+
+    auto collection = HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [list_of_class_names = move(list_of_class_names), quirks_mode = document().in_quirks_mode()](Element const& element) {
         for (auto& name : list_of_class_names) {
             if (!element.has_class(name, quirks_mode ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive))
                 return false;
         }
         return !list_of_class_names.is_empty();
     });
+    if (indexed_class_name.has_value())
+        collection->set_index_hint({ HTMLCollection::IndexHint::Kind::Class, indexed_class_name.release_value() });
+    return collection;
 }
 
 }
@@ -62,6 +62,9 @@ public:
 
     Vector<JS::NonnullGCPtr<Animations::Animation>> get_animations();
 
+    ElementByIdMap& element_by_id() { return m_element_by_id; }
+    ElementByIdMap const& element_by_id() const { return m_element_by_id; }
+
     virtual void finalize() override;
 
 protected:
@@ -92,6 +95,8 @@ private:
 
     JS::GCPtr<CSS::StyleSheetList> m_style_sheets;
     mutable JS::GCPtr<WebIDL::ObservableArray> m_adopted_style_sheets;
+
+    ElementByIdMap m_element_by_id;
 };
 
 template<>
@@ -13,7 +13,7 @@
 namespace Web::Bindings {
 
 template<>
-void Intrinsics::create_web_prototype_and_constructor<URLSearchParamsIteratorPrototype>(JS::Realm& realm)
+void Intrinsics::create_web_prototype<URLSearchParamsIteratorPrototype>(JS::Realm& realm)
 {
     auto prototype = heap().allocate<URLSearchParamsIteratorPrototype>(realm, realm);
     m_prototypes.set("URLSearchParamsIterator"_fly_string, prototype);
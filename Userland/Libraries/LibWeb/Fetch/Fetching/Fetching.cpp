@@ -40,6 +40,7 @@
 #include <LibWeb/FileAPI/Blob.h>
 #include <LibWeb/FileAPI/BlobURLStore.h>
 #include <LibWeb/HTML/EventLoop/EventLoop.h>
+#include <LibWeb/HTML/PreloadEntry.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/HTML/Window.h>
@@ -71,6 +72,62 @@ bool g_http_cache_enabled;
         _temporary_result.release_value();                                                           \
     })
 
+// Our internal priority is the urgency with which the response is needed: what renders the page goes first, images and
+// media after everything else, and the request's priority (e.g. from the fetchpriority attribute) nudges it either way.
+static Infrastructure::Request::InternalPriority internal_priority_for_request(Infrastructure::Request const& request)
+{
+    using Destination = Infrastructure::Request::Destination;
+    using RequestPriority = RequestServer::RequestPriority;
+
+    auto priority = [&] {
+        if (request.render_blocking())
+            return RequestPriority::Highest;
+
+        // Requests from fetch() and XMLHttpRequest have no destination, and usually gate what a script does next.
+        if (!request.destination().has_value())
+            return RequestPriority::High;
+
+        switch (*request.destination()) {
+        case Destination::Document:
+        case Destination::Frame:
+        case Destination::IFrame:
+        case Destination::Style:
+        case Destination::XSLT:
+            return RequestPriority::Highest;
+        case Destination::Font:
+        case Destination::Script:
+        case Destination::JSON:
+        case Destination::SharedWorker:
+        case Destination::Worker:
+            return RequestPriority::High;
+        case Destination::Image:
+        case Destination::Audio:
+        case Destination::Video:
+        case Destination::Track:
+            return RequestPriority::Low;
+        case Destination::Report:
+            return RequestPriority::Lowest;
+        default:
+            return RequestPriority::Medium;
+        }
+    }();
+
+    switch (request.priority()) {
+    case Infrastructure::Request::Priority::High:
+        if (priority != RequestPriority::Highest)
+            priority = static_cast<RequestPriority>(to_underlying(priority) - 1);
+        break;
+    case Infrastructure::Request::Priority::Low:
+        if (priority != RequestPriority::Lowest)
+            priority = static_cast<RequestPriority>(to_underlying(priority) + 1);
+        break;
+    case Infrastructure::Request::Priority::Auto:
+        break;
+    }
+
+    return { .priority = priority };
+}
+
 // https://fetch.spec.whatwg.org/#concept-fetch
 WebIDL::ExceptionOr<JS::NonnullGCPtr<Infrastructure::FetchController>> fetch(JS::Realm& realm, Infrastructure::Request& request, Infrastructure::FetchAlgorithms const& algorithms, UseParallelQueue use_parallel_queue)
 {
@@ -160,11 +217,14 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<Infrastructure::FetchController>> fetch(JS:
             fetch_params->set_preloaded_response_candidate(response);
         });
 
-        // FIXME: 3. Let foundPreloadedResource be the result of invoking consume a preloaded resource for request’s
+        // 3. Let foundPreloadedResource be the result of invoking consume a preloaded resource for request’s
         //    window, given request’s URL, request’s destination, request’s mode, request’s credentials mode,
         //    request’s integrity metadata, and onPreloadedResponseAvailable.
+        // NOTE: Only documents have a map of preloaded resources, so there is nothing to find for workers.
         auto found_preloaded_resource = false;
-        (void)on_preloaded_response_available;
+        auto& global = request.window().get<JS::GCPtr<HTML::EnvironmentSettingsObject>>()->global_object();
+        if (is<HTML::Window>(global))
+            found_preloaded_resource = HTML::consume_a_preloaded_resource(verify_cast<HTML::Window>(global), request.url(), request.destination(), request.mode(), request.credentials_mode(), request.integrity_metadata(), on_preloaded_response_available);
 
         // 4. If foundPreloadedResource is true and fetchParams’s preloaded response candidate is null, then set
         //    fetchParams’s preloaded response candidate to "pending".
@@ -246,6 +306,8 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<Infrastructure::FetchController>> fetch(JS:
     //     in setting request’s priority to a user-agent-defined object.
     // NOTE: The user-agent-defined object could encompass stream weight and dependency for HTTP/2, and equivalent
     //       information used to prioritize dispatch and processing of HTTP/1 fetches.
+    if (!request.internal_priority().has_value())
+        request.set_internal_priority(internal_priority_for_request(request));
 
     // 16. If request is a subresource request, then:
     if (request.is_subresource_request()) {
@@ -1384,6 +1446,14 @@ public:
         update_stored_header_fields(response, cached_response.headers);
     }
 
+    size_t size_in_bytes() const
+    {
+        size_t size = 0;
+        for (auto const& it : m_cache)
+            size += it.value->body.size();
+        return size;
+    }
+
 private:
     // https://httpwg.org/specs/rfc9111.html#update
     void update_stored_header_fields(Infrastructure::Response const& response, HTTP::HeaderMap& headers)
@@ -1497,6 +1567,16 @@ public:
         });
     }
 
+    // Returns the number of bytes of response bodies that were dropped.
+    size_t clear()
+    {
+        size_t size = 0;
+        for (auto const& it : m_cache)
+            size += it.value->size_in_bytes();
+        m_cache.clear();
+        return size;
+    }
+
     static HTTPCache& the()
     {
         static HTTPCache s_cache;
@@ -2148,6 +2228,14 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<PendingResponse>> nonstandard_resource_load
     load_request.set_url(request->current_url());
     load_request.set_page(page);
     load_request.set_method(ByteString::copy(request->method()));
+    if (request->internal_priority().has_value())
+        load_request.set_priority(request->internal_priority()->priority);
+
+    // https://fetch.spec.whatwg.org/#determine-the-http-cache-partition
+    // NOTE: RequestServer keeps a separate HTTP cache for each network partition key's top-level origin. Opaque
+    //       top-level origins get no HTTP cache at all, since they all serialize to the same "null".
+    if (auto partition_key = Infrastructure::determine_the_network_partition_key(*request); partition_key.has_value() && !partition_key->top_level_origin.is_opaque())
+        load_request.set_cache_partition(partition_key->top_level_origin.serialize());
 
     for (auto const& header : *request->header_list())
         load_request.set_header(ByteString::copy(header.name), ByteString::copy(header.value));
@@ -2643,4 +2731,9 @@ void append_fetch_metadata_headers_for_request(Infrastructure::Request& request)
     set_sec_fetch_user_header(request);
 }
 
+size_t purge_http_cache()
+{
+    return HTTPCache::the().clear();
+}
+
 }
@@ -52,4 +52,7 @@ void set_sec_fetch_mode_header(Infrastructure::Request&);
 void set_sec_fetch_site_header(Infrastructure::Request&);
 void set_sec_fetch_user_header(Infrastructure::Request&);
 void append_fetch_metadata_headers_for_request(Infrastructure::Request&);
+
+// Drops every response in the HTTP cache, and returns the number of bytes of response bodies that were dropped.
+size_t purge_http_cache();
 }
@@ -13,7 +13,7 @@
 namespace Web::Bindings {
 
 template<>
-void Intrinsics::create_web_prototype_and_constructor<HeadersIteratorPrototype>(JS::Realm& realm)
+void Intrinsics::create_web_prototype<HeadersIteratorPrototype>(JS::Realm& realm)
 {
     auto prototype = heap().allocate<HeadersIteratorPrototype>(realm, realm);
     m_prototypes.set("HeadersIterator"_fly_string, prototype);
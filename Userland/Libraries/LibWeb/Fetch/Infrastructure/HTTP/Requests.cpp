@@ -227,6 +227,7 @@ JS::NonnullGCPtr<Request> Request::clone(JS::Realm& realm) const
     new_request->set_initiator(m_initiator);
     new_request->set_destination(m_destination);
     new_request->set_priority(m_priority);
+    new_request->set_internal_priority(m_internal_priority);
     new_request->set_origin(m_origin);
     new_request->set_policy_container(m_policy_container);
     new_request->set_referrer(m_referrer);
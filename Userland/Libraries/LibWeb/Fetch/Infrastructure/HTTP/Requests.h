@@ -23,6 +23,7 @@
 #include <LibWeb/HTML/Origin.h>
 #include <LibWeb/HTML/PolicyContainers.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
+#include <RequestServer/RequestPriority.h>
 
 namespace Web::Fetch::Infrastructure {
 
@@ -167,7 +168,9 @@ public:
     };
 
     // Members are implementation-defined
-    struct InternalPriority { };
+    struct InternalPriority {
+        RequestServer::RequestPriority priority { RequestServer::RequestPriority::Medium };
+    };
 
     using BodyType = Variant<Empty, ByteBuffer, JS::NonnullGCPtr<Body>>;
     using OriginType = Variant<Origin, HTML::Origin>;
@@ -226,6 +229,9 @@ public:
     [[nodiscard]] Priority const& priority() const { return m_priority; }
     void set_priority(Priority priority) { m_priority = priority; }
 
+    [[nodiscard]] Optional<InternalPriority> const& internal_priority() const { return m_internal_priority; }
+    void set_internal_priority(Optional<InternalPriority> internal_priority) { m_internal_priority = move(internal_priority); }
+
     [[nodiscard]] OriginType const& origin() const { return m_origin; }
     void set_origin(OriginType origin) { m_origin = move(origin); }
 
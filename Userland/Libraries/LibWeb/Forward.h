@@ -29,6 +29,7 @@ namespace Web::Painting {
 class BackingStore;
 class DisplayList;
 class DisplayListRecorder;
+struct DisplayListChunkRecording;
 class SVGGradientPaintStyle;
 using PaintStyle = RefPtr<SVGGradientPaintStyle>;
 }
@@ -257,6 +258,8 @@ class DOMEventListener;
 class DOMImplementation;
 class DOMTokenList;
 class Element;
+class ElementByIdMap;
+class ElementIndex;
 class Event;
 class EventHandler;
 class EventTarget;
@@ -483,15 +486,19 @@ class NavigationDestination;
 class NavigationHistoryEntry;
 class NavigationTransition;
 class Navigator;
+class OffscreenCanvas;
+class OffscreenCanvasRenderingContext2D;
 class Origin;
 class PageTransitionEvent;
 class Path2D;
 class Plugin;
 class PluginArray;
+class PreloadEntry;
 class PromiseRejectionEvent;
 class SelectedFile;
 class ServiceWorkerContainer;
 class ServiceWorkerRegistration;
+class SharedCanvasFrame;
 class SharedResourceRequest;
 class Storage;
 class SubmitEvent;
@@ -544,9 +551,12 @@ class Performance;
 }
 
 namespace Web::IndexedDB {
+class Database;
+class IDBDatabase;
 class IDBFactory;
 class IDBOpenDBRequest;
 class IDBRequest;
+class IDBVersionChangeEvent;
 }
 
 namespace Web::Internals {
@@ -590,9 +600,15 @@ class Viewport;
 
 enum class LayoutMode;
 
+struct GridPlacement;
 struct LayoutState;
 }
 
+namespace Web::LongTasks {
+class PerformanceLongTaskTiming;
+class TaskAttributionTiming;
+}
+
 namespace Web::MathML {
 class MathMLElement;
 }
@@ -631,6 +647,10 @@ struct BorderRadiusData;
 struct LinearGradientData;
 }
 
+namespace Web::PaintTiming {
+class PerformancePaintTiming;
+}
+
 namespace Web::PerformanceTimeline {
 class PerformanceEntry;
 class PerformanceObserver;
@@ -656,6 +676,7 @@ class IdleDeadline;
 }
 
 namespace Web::ResizeObserver {
+class ResizeObservation;
 class ResizeObserver;
 }
 
@@ -5,55 +5,328 @@
  */
 
 #include <LibGfx/Bitmap.h>
+#include <LibJS/Heap/Handle.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Runtime/Realm.h>
+#include <LibWeb/DOM/Document.h>
 #include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
 
 namespace Web::HTML {
 
 JS_DEFINE_ALLOCATOR(AnimatedBitmapDecodedImageData);
 
+// For streamed animations: how many frames past the current one we want decoded already, how many frames we ask for at
+// a time, and the duration we assume for frames whose duration we don't know yet.
+static constexpr size_t streamed_frames_ahead = 4;
+static constexpr size_t streamed_frames_per_request = 8;
+static constexpr int default_frame_duration = 100;
+
+// Once decoded bitmaps take up more than this, the bitmaps of discardable images that are out of view are dropped,
+// least recently seen first. They're decoded again from their encoded data when they come back into view.
+static constexpr size_t decoded_image_budget = 256 * MiB;
+
+static size_t s_resident_bitmap_bytes = 0;
+
+static AnimatedBitmapDecodedImageData::HiddenList& hidden_images()
+{
+    static AnimatedBitmapDecodedImageData::HiddenList list;
+    return list;
+}
+
+size_t AnimatedBitmapDecodedImageData::resident_bitmap_bytes()
+{
+    return s_resident_bitmap_bytes;
+}
+
 ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create(JS::Realm& realm, Vector<Frame>&& frames, size_t loop_count, bool animated)
 {
     return realm.heap().allocate<AnimatedBitmapDecodedImageData>(realm, move(frames), loop_count, animated);
 }
 
-AnimatedBitmapDecodedImageData::AnimatedBitmapDecodedImageData(Vector<Frame>&& frames, size_t loop_count, bool animated)
+ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create_streamed(JS::Realm& realm, Vector<Frame>&& frames, size_t frame_count, i64 image_id, size_t loop_count)
+{
+    VERIFY(!frames.is_empty() && frames.size() < frame_count);
+    auto decoded_frame_count = frames.size();
+    TRY(frames.try_resize(frame_count));
+    for (size_t i = decoded_frame_count; i < frame_count; ++i)
+        frames[i].duration = -1;
+    return realm.heap().allocate<AnimatedBitmapDecodedImageData>(realm, move(frames), loop_count, true, image_id);
+}
+
+ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create_discardable(JS::Realm& realm, Frame frame, Gfx::IntSize natural_size, ByteBuffer encoded_data, JS::NonnullGCPtr<DOM::Document> document)
+{
+    Vector<Frame> frames;
+    TRY(frames.try_append(move(frame)));
+    auto image_data = realm.heap().allocate<AnimatedBitmapDecodedImageData>(realm, move(frames), 0, false);
+    image_data->m_natural_size = natural_size;
+    image_data->m_encoded_data = move(encoded_data);
+    image_data->m_document = document;
+    return image_data;
+}
+
+AnimatedBitmapDecodedImageData::AnimatedBitmapDecodedImageData(Vector<Frame>&& frames, size_t loop_count, bool animated, Optional<i64> streamed_image_id)
     : m_frames(move(frames))
     , m_loop_count(loop_count)
     , m_animated(animated)
+    , m_streamed_image_id(streamed_image_id)
 {
+    if (!m_frames.is_empty() && m_frames.first().bitmap) {
+        m_natural_size = m_frames.first().bitmap->size();
+        m_decoded_size = m_natural_size;
+    }
+    update_resident_bitmap_bytes();
 }
 
 AnimatedBitmapDecodedImageData::~AnimatedBitmapDecodedImageData() = default;
 
-RefPtr<Gfx::ImmutableBitmap> AnimatedBitmapDecodedImageData::bitmap(size_t frame_index, Gfx::IntSize) const
+void AnimatedBitmapDecodedImageData::finalize()
+{
+    Base::finalize();
+    m_hidden_list_node.remove();
+    s_resident_bitmap_bytes -= m_resident_bitmap_bytes;
+    m_resident_bitmap_bytes = 0;
+    if (m_streamed_image_id.has_value())
+        Platform::ImageCodecPlugin::the().release_animation(*m_streamed_image_id);
+}
+
+void AnimatedBitmapDecodedImageData::visit_edges(Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_document);
+}
+
+RefPtr<Gfx::ImmutableBitmap> AnimatedBitmapDecodedImageData::bitmap(size_t frame_index, Gfx::IntSize size) const
 {
     if (frame_index >= m_frames.size())
         return nullptr;
-    return m_frames[frame_index].bitmap;
+    if (is_discardable()) {
+        redecode_if_needed(size);
+
+        // Callers that don't ask for a size (e.g. canvas drawImage() and createImageBitmap()) use the bitmap right away,
+        // so if it was discarded, they have to wait for it to be decoded again.
+        if (size.is_empty() && !m_frames.first().bitmap && m_redecode_in_flight) {
+            auto promise = m_redecode_promise;
+            (void)promise->await();
+        }
+    }
+    if (!m_streamed_image_id.has_value())
+        return m_frames[frame_index].bitmap;
+
+    request_frames_if_needed(frame_index);
+
+    // If the frame hasn't arrived yet, keep showing the closest one before it. The first frame is always there.
+    for (size_t i = frame_index + 1; i-- > 0;) {
+        if (m_frames[i].bitmap)
+            return m_frames[i].bitmap;
+    }
+    return nullptr;
 }
 
 int AnimatedBitmapDecodedImageData::frame_duration(size_t frame_index) const
 {
     if (frame_index >= m_frames.size())
         return 0;
-    return m_frames[frame_index].duration;
+    if (!m_streamed_image_id.has_value())
+        return m_frames[frame_index].duration;
+
+    request_frames_if_needed(frame_index);
+
+    // Until a frame has been decoded, assume it lasts as long as the closest one before it that has been.
+    for (size_t i = frame_index + 1; i-- > 0;) {
+        if (m_frames[i].duration >= 0)
+            return m_frames[i].duration;
+    }
+    return default_frame_duration;
+}
+
+void AnimatedBitmapDecodedImageData::request_frames_if_needed(size_t frame_index) const
+{
+    if (m_frame_request_in_flight)
+        return;
+
+    auto frame_count = m_frames.size();
+    auto distance_from_current_frame = [&](size_t index) {
+        return (index + frame_count - frame_index) % frame_count;
+    };
+
+    for (size_t offset = 0; offset <= streamed_frames_ahead; ++offset) {
+        auto index = (frame_index + offset) % frame_count;
+        if (m_frames[index].bitmap)
+            continue;
+
+        // Drop the frames we've moved past, so that only a window around the current frame stays decoded.
+        for (size_t i = 1; i < frame_count; ++i) {
+            if (distance_from_current_frame(i) > streamed_frames_ahead + streamed_frames_per_request)
+                m_frames[i].bitmap = nullptr;
+        }
+        update_resident_bitmap_bytes();
+
+        auto count = min(streamed_frames_per_request, frame_count - index);
+        m_frame_request_in_flight = true;
+
+        Platform::ImageCodecPlugin::the().request_animation_frames(*m_streamed_image_id, index, count,
+            [strong_this = JS::Handle(const_cast<AnimatedBitmapDecodedImageData&>(*this))](size_t first_frame_index, Vector<Platform::Frame> frames) {
+                strong_this->did_decode_frames(first_frame_index, move(frames));
+            });
+        return;
+    }
+}
+
+void AnimatedBitmapDecodedImageData::did_decode_frames(size_t first_frame_index, Vector<Platform::Frame> frames)
+{
+    m_frame_request_in_flight = false;
+
+    for (size_t i = 0; i < frames.size() && first_frame_index + i < m_frames.size(); ++i) {
+        auto& frame = m_frames[first_frame_index + i];
+        frame.duration = static_cast<int>(frames[i].duration);
+
+        if (frames[i].bitmap) {
+            frame.bitmap = Gfx::ImmutableBitmap::create(*frames[i].bitmap);
+            continue;
+        }
+
+        // A frame that failed to decode shows whatever came before it, so that we don't keep asking for it.
+        for (size_t j = first_frame_index + i; j-- > 0;) {
+            if (m_frames[j].bitmap) {
+                frame.bitmap = m_frames[j].bitmap;
+                break;
+            }
+        }
+    }
+    update_resident_bitmap_bytes();
+}
+
+void AnimatedBitmapDecodedImageData::redecode_if_needed(Gfx::IntSize size) const
+{
+    if (m_redecode_in_flight)
+        return;
+
+    // Without a size, the caller wants the image as it is (e.g. to draw it into a canvas), so go for the natural size.
+    auto wanted_size = m_natural_size;
+    if (!size.is_empty())
+        wanted_size = { min(size.width(), m_natural_size.width()), min(size.height(), m_natural_size.height()) };
+
+    // If the bitmap was discarded, bring it back at (at least) the size it had.
+    if (m_frames.first().bitmap) {
+        auto current_size = m_frames.first().bitmap->size();
+        if (wanted_size.width() <= current_size.width() && wanted_size.height() <= current_size.height())
+            return;
+    } else {
+        wanted_size = { max(wanted_size.width(), m_decoded_size.width()), max(wanted_size.height(), m_decoded_size.height()) };
+    }
+
+    Optional<Gfx::IntSize> ideal_size;
+    if (wanted_size != m_natural_size)
+        ideal_size = wanted_size;
+
+    // Someone is waiting to show this image, so it goes ahead of images that have yet to be shown.
+    bool const is_high_priority = true;
+
+    m_redecode_in_flight = true;
+    auto strong_this = JS::Handle(const_cast<AnimatedBitmapDecodedImageData&>(*this));
+    auto promise = Platform::ImageCodecPlugin::the().decode_image(
+        m_encoded_data.bytes(),
+        [strong_this](Platform::DecodedImage& result) -> ErrorOr<void> {
+            strong_this->did_redecode(result);
+            return {};
+        },
+        [strong_this](Error&) {
+            // Don't try again. If the bitmap was discarded, there's nothing left to show.
+            strong_this->m_redecode_in_flight = false;
+            strong_this->m_redecode_promise = nullptr;
+            strong_this->m_encoded_data.clear();
+            strong_this->m_hidden_list_node.remove();
+        },
+        ideal_size, is_high_priority);
+
+    // NOTE: The decode may have failed right away.
+    if (m_redecode_in_flight)
+        m_redecode_promise = move(promise);
+}
+
+void AnimatedBitmapDecodedImageData::did_redecode(Platform::DecodedImage& result)
+{
+    m_redecode_in_flight = false;
+    m_redecode_promise = nullptr;
+    if (result.frames.is_empty() || !result.frames.first().bitmap)
+        return;
+
+    auto& bitmap = *result.frames.first().bitmap;
+    m_frames.first().bitmap = Gfx::ImmutableBitmap::create(bitmap);
+    m_decoded_size = bitmap.size();
+    update_resident_bitmap_bytes();
+
+    if (m_document)
+        m_document->set_needs_display();
+
+    discard_hidden_bitmaps_if_needed();
+}
+
+void AnimatedBitmapDecodedImageData::did_enter_viewport()
+{
+    if (m_viewport_user_count++ > 0)
+        return;
+    m_hidden_list_node.remove();
+
+    // Start bringing a discarded bitmap back right away, rather than waiting for it to be painted.
+    if (is_discardable() && !m_frames.first().bitmap)
+        redecode_if_needed({});
+}
+
+void AnimatedBitmapDecodedImageData::did_leave_viewport()
+{
+    VERIFY(m_viewport_user_count > 0);
+    if (--m_viewport_user_count > 0 || !is_discardable())
+        return;
+    hidden_images().append(*this);
+    discard_hidden_bitmaps_if_needed();
+}
+
+void AnimatedBitmapDecodedImageData::discard_bitmap()
+{
+    m_hidden_list_node.remove();
+    m_frames.first().bitmap = nullptr;
+    update_resident_bitmap_bytes();
+}
+
+void AnimatedBitmapDecodedImageData::update_resident_bitmap_bytes() const
+{
+    size_t bytes = 0;
+    for (auto const& frame : m_frames) {
+        if (frame.bitmap)
+            bytes += frame.bitmap->bitmap().size_in_bytes();
+    }
+    s_resident_bitmap_bytes = s_resident_bitmap_bytes - m_resident_bitmap_bytes + bytes;
+    m_resident_bitmap_bytes = bytes;
+}
+
+void AnimatedBitmapDecodedImageData::discard_hidden_bitmaps_if_needed()
+{
+    auto& list = hidden_images();
+    while (s_resident_bitmap_bytes > decoded_image_budget && !list.is_empty())
+        list.first()->discard_bitmap();
+}
+
+void AnimatedBitmapDecodedImageData::discard_all_hidden_bitmaps()
+{
+    auto& list = hidden_images();
+    while (!list.is_empty())
+        list.first()->discard_bitmap();
 }
 
 Optional<CSSPixels> AnimatedBitmapDecodedImageData::intrinsic_width() const
 {
-    return m_frames.first().bitmap->width();
+    return m_natural_size.width();
 }
 
 Optional<CSSPixels> AnimatedBitmapDecodedImageData::intrinsic_height() const
 {
-    return m_frames.first().bitmap->height();
+    return m_natural_size.height();
 }
 
 Optional<CSSPixelFraction> AnimatedBitmapDecodedImageData::intrinsic_aspect_ratio() const
 {
-    return CSSPixels(m_frames.first().bitmap->width()) / CSSPixels(m_frames.first().bitmap->height());
+    return CSSPixels(m_natural_size.width()) / CSSPixels(m_natural_size.height());
 }
 
 }
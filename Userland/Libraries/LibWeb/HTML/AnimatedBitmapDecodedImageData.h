@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
+#include <AK/IntrusiveList.h>
 #include <LibGfx/ImmutableBitmap.h>
 #include <LibWeb/HTML/DecodedImageData.h>
+#include <LibWeb/Platform/ImageCodecPlugin.h>
 
 namespace Web::HTML {
 
@@ -22,6 +25,22 @@ public:
     };
 
     static ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> create(JS::Realm&, Vector<Frame>&&, size_t loop_count, bool animated);
+
+    // Creates an animation of which only the first few frames have been decoded. The rest are requested from the image
+    // codec plugin as playback approaches them, and only a small window of frames around the current one is kept.
+    static ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> create_streamed(JS::Realm&, Vector<Frame>&&, size_t frame_count, i64 image_id, size_t loop_count);
+
+    // Creates a still image that keeps its encoded data, so that it can be decoded again when needed: at a larger size
+    // if it was decoded at less than its natural size and is then shown larger, or after its bitmap was discarded
+    // to stay within the decoded image budget while it was out of view.
+    static ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> create_discardable(JS::Realm&, Frame, Gfx::IntSize natural_size, ByteBuffer encoded_data, JS::NonnullGCPtr<DOM::Document>);
+
+    // The number of bytes taken up by decoded bitmaps of all images in this process.
+    static size_t resident_bitmap_bytes();
+
+    // Drops the bitmaps of all discardable images that are out of view, even if we're within the decoded image budget.
+    static void discard_all_hidden_bitmaps();
+
     virtual ~AnimatedBitmapDecodedImageData() override;
 
     virtual RefPtr<Gfx::ImmutableBitmap> bitmap(size_t frame_index, Gfx::IntSize = {}) const override;
@@ -35,12 +54,52 @@ public:
     virtual Optional<CSSPixels> intrinsic_height() const override;
     virtual Optional<CSSPixelFraction> intrinsic_aspect_ratio() const override;
 
+    virtual void did_enter_viewport() override;
+    virtual void did_leave_viewport() override;
+
 private:
-    AnimatedBitmapDecodedImageData(Vector<Frame>&&, size_t loop_count, bool animated);
+    AnimatedBitmapDecodedImageData(Vector<Frame>&&, size_t loop_count, bool animated, Optional<i64> streamed_image_id = {});
+
+    virtual void finalize() override;
+    virtual void visit_edges(Cell::Visitor&) override;
+
+    void request_frames_if_needed(size_t frame_index) const;
+    void did_decode_frames(size_t first_frame_index, Vector<Platform::Frame>);
+
+    void redecode_if_needed(Gfx::IntSize) const;
+    void did_redecode(Platform::DecodedImage&);
 
-    Vector<Frame> m_frames;
+    bool is_discardable() const { return !m_encoded_data.is_empty(); }
+    void discard_bitmap();
+    void update_resident_bitmap_bytes() const;
+    static void discard_hidden_bitmaps_if_needed();
+
+    // For streamed animations, frames that haven't been decoded (or have been dropped again) have no bitmap, and
+    // frames that haven't been decoded yet have a negative duration.
+    mutable Vector<Frame> m_frames;
     size_t m_loop_count { 0 };
     bool m_animated { false };
+
+    Optional<i64> m_streamed_image_id;
+    mutable bool m_frame_request_in_flight { false };
+
+    Gfx::IntSize m_natural_size;
+
+    // For discardable images, the data to decode the image from again, and the size it was last decoded at.
+    ByteBuffer m_encoded_data;
+    JS::GCPtr<DOM::Document> m_document;
+    mutable bool m_redecode_in_flight { false };
+    mutable RefPtr<Core::Promise<Platform::DecodedImage>> m_redecode_promise;
+    Gfx::IntSize m_decoded_size;
+
+    mutable size_t m_resident_bitmap_bytes { 0 };
+    size_t m_viewport_user_count { 0 };
+
+    // Discardable images that aren't in any viewport, least recently seen first.
+    IntrusiveListNode<AnimatedBitmapDecodedImageData> m_hidden_list_node;
+
+public:
+    using HiddenList = IntrusiveList<&AnimatedBitmapDecodedImageData::m_hidden_list_node>;
 };
 
 }
@@ -17,7 +17,7 @@ public:
 
     virtual WebIDL::ExceptionOr<JS::NonnullGCPtr<ImageData>> create_image_data(int width, int height, Optional<ImageDataSettings> const& settings = {}) const = 0;
     virtual WebIDL::ExceptionOr<JS::GCPtr<ImageData>> get_image_data(int x, int y, int width, int height, Optional<ImageDataSettings> const& settings = {}) const = 0;
-    virtual void put_image_data(ImageData const&, float x, float y) = 0;
+    virtual void put_image_data(ImageData const&, int x, int y) = 0;
 
 protected:
     CanvasImageData() = default;
@@ -125,6 +125,9 @@ WebIDL::ExceptionOr<JS::GCPtr<CanvasPattern>> CanvasPattern::create(JS::Realm& r
     if (!repetition_value.has_value())
         return WebIDL::SyntaxError::create(realm, "Repetition value is not valid"_fly_string);
 
+    if (auto const* canvas = image.get_pointer<JS::Handle<HTMLCanvasElement>>())
+        (*canvas)->present();
+
     // Note: Bitmap won't be null here, as if it were it would have "bad" usability.
     auto const& bitmap = *image.visit([](auto const& source) -> Gfx::Bitmap const* { return source->bitmap(); });
 
@@ -6,8 +6,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Checked.h>
 #include <AK/OwnPtr.h>
 #include <LibGfx/DeprecatedPainter.h>
+#include <LibGfx/PixelConversion.h>
 #include <LibGfx/Quad.h>
 #include <LibGfx/Rect.h>
 #include <LibUnicode/Segmenter.h>
@@ -42,6 +44,12 @@ CanvasRenderingContext2D::CanvasRenderingContext2D(JS::Realm& realm, HTMLCanvasE
 {
 }
 
+CanvasRenderingContext2D::CanvasRenderingContext2D(JS::Realm& realm)
+    : PlatformObject(realm)
+    , CanvasPath(static_cast<Bindings::PlatformObject&>(*this), *this)
+{
+}
+
 CanvasRenderingContext2D::~CanvasRenderingContext2D() = default;
 
 void CanvasRenderingContext2D::initialize(JS::Realm& realm)
@@ -58,17 +66,32 @@ void CanvasRenderingContext2D::visit_edges(Cell::Visitor& visitor)
 
 HTMLCanvasElement& CanvasRenderingContext2D::canvas_element()
 {
+    VERIFY(m_element);
     return *m_element;
 }
 
 HTMLCanvasElement const& CanvasRenderingContext2D::canvas_element() const
 {
+    VERIFY(m_element);
     return *m_element;
 }
 
 JS::NonnullGCPtr<HTMLCanvasElement> CanvasRenderingContext2D::canvas_for_binding() const
 {
-    return *m_element;
+    return canvas_element();
+}
+
+Gfx::Bitmap* CanvasRenderingContext2D::canvas_bitmap()
+{
+    return canvas_element().bitmap();
+}
+
+bool CanvasRenderingContext2D::create_canvas_bitmap()
+{
+    if (!canvas_element().create_bitmap())
+        return false;
+    canvas_element().document().invalidate_display_list();
+    return true;
 }
 
 Gfx::Path CanvasRenderingContext2D::rect_path(float x, float y, float width, float height)
@@ -120,6 +143,10 @@ WebIDL::ExceptionOr<void> CanvasRenderingContext2D::draw_image_internal(CanvasIm
     if (usability == CanvasImageSourceUsability::Bad)
         return {};
 
+    // NOTE: Another canvas may still have drawing to do before its bitmap is up to date.
+    if (auto const* canvas = image.get_pointer<JS::Handle<HTMLCanvasElement>>())
+        (*canvas)->present();
+
     auto const* bitmap = image.visit([](auto const& source) -> Gfx::Bitmap const* { return source->bitmap(); });
     if (!bitmap)
         return {};
@@ -172,22 +199,29 @@ WebIDL::ExceptionOr<void> CanvasRenderingContext2D::draw_image_internal(CanvasIm
 void CanvasRenderingContext2D::did_draw(Gfx::FloatRect const&)
 {
     // FIXME: Make use of the rect to reduce the invalidated area when possible.
+    canvas_element().invalidate_snapshot();
     if (!canvas_element().paintable())
         return;
-    canvas_element().paintable()->set_needs_display(InvalidateDisplayList::No);
+    // NOTE: The display list holds on to the old snapshot, so the canvas has to be recorded again to show the new one.
+    canvas_element().paintable()->set_needs_display(InvalidateDisplayList::Yes);
 }
 
 Gfx::Painter* CanvasRenderingContext2D::painter()
 {
-    if (!canvas_element().bitmap()) {
-        if (!canvas_element().create_bitmap())
+    if (!canvas_bitmap()) {
+        if (!create_canvas_bitmap())
             return nullptr;
-        canvas_element().document().invalidate_display_list();
-        m_painter = Gfx::Painter::create(*canvas_element().bitmap());
+        m_painter = make<Gfx::DeferredPainter>(Gfx::Painter::create(*canvas_bitmap()), canvas_bitmap()->size());
     }
     return m_painter.ptr();
 }
 
+void CanvasRenderingContext2D::present()
+{
+    if (m_painter)
+        m_painter->flush();
+}
+
 Gfx::Path CanvasRenderingContext2D::text_path(StringView text, float x, float y, Optional<double> max_width)
 {
     if (max_width.has_value() && max_width.value() <= 0)
@@ -341,9 +375,11 @@ WebIDL::ExceptionOr<JS::GCPtr<ImageData>> CanvasRenderingContext2D::get_image_da
     auto image_data = TRY(ImageData::create(realm(), width, height, settings));
 
     // NOTE: We don't attempt to create the underlying bitmap here; if it doesn't exist, it's like copying only transparent black pixels (which is a no-op).
-    if (!canvas_element().bitmap())
+    const_cast<CanvasRenderingContext2D&>(*this).present();
+    auto const* canvas_bitmap = const_cast<CanvasRenderingContext2D&>(*this).canvas_bitmap();
+    if (!canvas_bitmap)
         return image_data;
-    auto const& bitmap = *canvas_element().bitmap();
+    auto const& bitmap = *canvas_bitmap;
 
     // 5. Let the source rectangle be the rectangle whose corners are the four points (sx, sy), (sx+sw, sy), (sx+sw, sy+sh), (sx, sy+sh).
     auto source_rect = Gfx::Rect { x, y, width, height };
@@ -353,11 +389,17 @@ WebIDL::ExceptionOr<JS::GCPtr<ImageData>> CanvasRenderingContext2D::get_image_da
     // NOTE: Internally we must use premultiplied alpha, but ImageData should hold unpremultiplied alpha. This conversion
     //       might result in a loss of precision, but is according to spec.
     //       See: https://html.spec.whatwg.org/multipage/canvas.html#premultiplied-alpha-and-the-2d-rendering-context
-    ASSERT(bitmap.alpha_type() == Gfx::AlphaType::Premultiplied);
-    ASSERT(image_data->bitmap().alpha_type() == Gfx::AlphaType::Unpremultiplied);
-
-    auto painter = Gfx::Painter::create(image_data->bitmap());
-    painter->draw_bitmap(image_data->bitmap().rect().to_type<float>(), bitmap, source_rect_intersected, Gfx::ScalingMode::NearestNeighbor, drawing_state().global_alpha);
+    ASSERT(bitmap.format() == Gfx::BitmapFormat::BGRA8888 && bitmap.alpha_type() == Gfx::AlphaType::Premultiplied);
+    auto& destination = image_data->bitmap();
+    ASSERT(destination.format() == Gfx::BitmapFormat::RGBA8888 && destination.alpha_type() == Gfx::AlphaType::Unpremultiplied);
+
+    // NOTE: The ImageData's bitmap is a view of its data, so this writes straight into what the script gets to see.
+    auto row_length = static_cast<size_t>(source_rect_intersected.width());
+    for (int row = source_rect_intersected.top(); row < source_rect_intersected.bottom(); ++row) {
+        auto const* source_row = bitmap.scanline(row) + source_rect_intersected.left();
+        auto* destination_row = destination.scanline(row - source_rect.top()) + (source_rect_intersected.left() - source_rect.left());
+        Gfx::convert_bgra_premultiplied_to_rgba_unpremultiplied({ source_row, row_length }, { destination_row, row_length });
+    }
 
     // 7. Set the pixels values of imageData for areas of the source rectangle that are outside of the output bitmap to transparent black.
     // NOTE: No-op, already done during creation.
@@ -366,19 +408,47 @@ WebIDL::ExceptionOr<JS::GCPtr<ImageData>> CanvasRenderingContext2D::get_image_da
     return image_data;
 }
 
-void CanvasRenderingContext2D::put_image_data(ImageData const& image_data, float x, float y)
+// https://html.spec.whatwg.org/multipage/canvas.html#dom-context-2d-putimagedata
+void CanvasRenderingContext2D::put_image_data(ImageData const& image_data, int x, int y)
 {
-    if (auto* painter = this->painter()) {
-        auto dst_rect = Gfx::FloatRect(x, y, image_data.width(), image_data.height());
-        painter->draw_bitmap(dst_rect, image_data.bitmap(), image_data.bitmap().rect(), Gfx::ScalingMode::NearestNeighbor, 1.0f);
-        did_draw(dst_rect);
+    // NOTE: This also makes sure that the bitmap exists.
+    if (!painter())
+        return;
+
+    // NOTE: Image data replaces the pixels regardless of the transform, clipping, compositing and global alpha, so it
+    //       can't be drawn with the painter. Whatever has been drawn with it before has to land first though.
+    present();
+    auto& bitmap = *canvas_bitmap();
+    auto const& source = image_data.bitmap();
+    ASSERT(bitmap.format() == Gfx::BitmapFormat::BGRA8888 && bitmap.alpha_type() == Gfx::AlphaType::Premultiplied);
+    ASSERT(source.format() == Gfx::BitmapFormat::RGBA8888 && source.alpha_type() == Gfx::AlphaType::Unpremultiplied);
+
+    Checked<int> right = x;
+    right += source.width();
+    Checked<int> bottom = y;
+    bottom += source.height();
+    if (right.has_overflow() || bottom.has_overflow())
+        return;
+
+    auto destination_rect = Gfx::IntRect { x, y, source.width(), source.height() };
+    auto destination_rect_intersected = destination_rect.intersected(bitmap.rect());
+    if (destination_rect_intersected.is_empty())
+        return;
+
+    auto row_length = static_cast<size_t>(destination_rect_intersected.width());
+    for (int row = destination_rect_intersected.top(); row < destination_rect_intersected.bottom(); ++row) {
+        auto const* source_row = source.scanline(row - y) + (destination_rect_intersected.left() - x);
+        auto* destination_row = bitmap.scanline(row) + destination_rect_intersected.left();
+        Gfx::convert_rgba_unpremultiplied_to_bgra_premultiplied({ source_row, row_length }, { destination_row, row_length });
     }
+
+    did_draw(destination_rect_intersected.to_type<float>());
 }
 
 // https://html.spec.whatwg.org/multipage/canvas.html#reset-the-rendering-context-to-its-default-state
 void CanvasRenderingContext2D::reset_to_default_state()
 {
-    auto* bitmap = canvas_element().bitmap();
+    auto* bitmap = canvas_bitmap();
 
     // 1. Clear canvas's bitmap to transparent black.
     if (bitmap) {
@@ -439,6 +509,18 @@ JS::NonnullGCPtr<TextMetrics> CanvasRenderingContext2D::measure_text(StringView
     return metrics;
 }
 
+RefPtr<Gfx::Font const> CanvasRenderingContext2D::font_for_style_value(CSS::ShorthandStyleValue const& font_style_value)
+{
+    auto& canvas_element = this->canvas_element();
+    auto& font_style = *font_style_value.longhand(CSS::PropertyID::FontStyle);
+    auto& font_weight = *font_style_value.longhand(CSS::PropertyID::FontWeight);
+    auto& font_width = *font_style_value.longhand(CSS::PropertyID::FontWidth);
+    auto& font_size = *font_style_value.longhand(CSS::PropertyID::FontSize);
+    auto& font_family = *font_style_value.longhand(CSS::PropertyID::FontFamily);
+    auto font_list = canvas_element.document().style_computer().compute_font_for_style_values(&canvas_element, {}, font_family, font_size, font_style, font_weight, font_width);
+    return font_list->first();
+}
+
 RefPtr<Gfx::Font const> CanvasRenderingContext2D::current_font()
 {
     // When font style value is empty load default font
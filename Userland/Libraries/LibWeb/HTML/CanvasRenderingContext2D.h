@@ -11,6 +11,7 @@
 #include <AK/Variant.h>
 #include <LibGfx/AffineTransform.h>
 #include <LibGfx/Color.h>
+#include <LibGfx/DeferredPainter.h>
 #include <LibGfx/Forward.h>
 #include <LibGfx/Painter.h>
 #include <LibGfx/Path.h>
@@ -76,7 +77,7 @@ public:
 
     virtual WebIDL::ExceptionOr<JS::NonnullGCPtr<ImageData>> create_image_data(int width, int height, Optional<ImageDataSettings> const& settings = {}) const override;
     virtual WebIDL::ExceptionOr<JS::GCPtr<ImageData>> get_image_data(int x, int y, int width, int height, Optional<ImageDataSettings> const& settings = {}) const override;
-    virtual void put_image_data(ImageData const&, float x, float y) override;
+    virtual void put_image_data(ImageData const&, int x, int y) override;
 
     virtual void reset_to_default_state() override;
 
@@ -103,12 +104,25 @@ public:
 
     [[nodiscard]] Gfx::Painter* painter();
 
-private:
+    // Drawing is recorded and only done once something needs the pixels, like rendering the canvas or reading it back.
+    void present();
+
+    virtual RefPtr<Gfx::Font const> font_for_style_value(CSS::ShorthandStyleValue const&);
+
+protected:
     explicit CanvasRenderingContext2D(JS::Realm&, HTMLCanvasElement&);
 
+    // For OffscreenCanvasRenderingContext2D, which draws to an OffscreenCanvas rather than to a canvas element.
+    explicit CanvasRenderingContext2D(JS::Realm&);
+
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    virtual Gfx::Bitmap* canvas_bitmap();
+    virtual bool create_canvas_bitmap();
+    virtual void did_draw(Gfx::FloatRect const&);
+
+private:
     virtual Gfx::Painter* painter_for_canvas_state() override { return painter(); }
     virtual Gfx::Path& path_for_canvas_state() override { return path(); }
 
@@ -118,8 +132,6 @@ private:
         Gfx::IntRect bounding_box;
     };
 
-    void did_draw(Gfx::FloatRect const&);
-
     RefPtr<Gfx::Font const> current_font();
 
     PreparedText prepare_text(ByteString const& text, float max_width = INFINITY);
@@ -131,8 +143,8 @@ private:
     void fill_internal(Gfx::Path const&, Gfx::WindingRule);
     void clip_internal(Gfx::Path&, Gfx::WindingRule);
 
-    JS::NonnullGCPtr<HTMLCanvasElement> m_element;
-    OwnPtr<Gfx::Painter> m_painter;
+    JS::GCPtr<HTMLCanvasElement> m_element;
+    OwnPtr<Gfx::DeferredPainter> m_painter;
 
     // https://html.spec.whatwg.org/multipage/canvas.html#concept-canvas-origin-clean
     bool m_origin_clean { true };
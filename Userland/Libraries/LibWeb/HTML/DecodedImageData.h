@@ -31,6 +31,11 @@ public:
     virtual Optional<CSSPixels> intrinsic_height() const = 0;
     virtual Optional<CSSPixelFraction> intrinsic_aspect_ratio() const = 0;
 
+    // Called as elements showing this image scroll into and out of view, so that images nobody can see can let go of
+    // their decoded bitmaps. Calls are balanced.
+    virtual void did_enter_viewport() { }
+    virtual void did_leave_viewport() { }
+
 protected:
     DecodedImageData();
 };
@@ -19,7 +19,9 @@
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/HighResolutionTime/Performance.h>
 #include <LibWeb/HighResolutionTime/TimeOrigin.h>
+#include <LibWeb/LongTasks/PerformanceLongTaskTiming.h>
 #include <LibWeb/Page/Page.h>
+#include <LibWeb/PaintTiming/PerformancePaintTiming.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/Platform/Timer.h>
 
@@ -149,7 +151,7 @@ void EventLoop::process()
 
     // 1. Let oldestTask and taskStartTime be null.
     JS::GCPtr<Task> oldest_task;
-    [[maybe_unused]] double task_start_time = 0;
+    double task_start_time = 0;
 
     // 2. If the event loop has a task queue with at least one runnable task, then:
     if (m_task_queue->has_runnable_tasks()) {
@@ -178,7 +180,7 @@ void EventLoop::process()
     }
 
     // 3. Let taskEndTime be the unsafe shared current time. [HRT]
-    [[maybe_unused]] auto task_end_time = HighResolutionTime::unsafe_shared_current_time();
+    auto task_end_time = HighResolutionTime::unsafe_shared_current_time();
 
     // 4. If oldestTask is not null, then:
     if (oldest_task) {
@@ -189,7 +191,10 @@ void EventLoop::process()
         // FIXME: 2.3. If global's browsing context is null, then continue.
         // FIXME: 2.4. Let tlbc be global's browsing context's top-level browsing context.
         // FIXME: 2.5. If tlbc is not null, then append it to top-level browsing contexts.
-        // FIXME: 3. Report long tasks, passing in taskStartTime, taskEndTime, top-level browsing contexts, and oldestTask.
+        // 3. Report long tasks, passing in taskStartTime, taskEndTime, top-level browsing contexts, and oldestTask.
+        // NOTE: The top-level browsing contexts are derived from oldestTask's document instead, see report_long_tasks().
+        LongTasks::report_long_tasks(task_start_time, task_end_time, oldest_task->document());
+
         // FIXME: 4. If oldestTask's document is not null, then record task end time given taskEndTime and oldestTask's document.
     }
 
@@ -205,6 +210,10 @@ void EventLoop::process()
         for (auto& win : same_loop_windows()) {
             win->start_an_idle_period();
         }
+
+        // OPTIMIZATION: We have nothing else to do right now, so this is a good time to collect garbage if we're
+        //               getting close to the allocation threshold, rather than pausing in the middle of a future task.
+        heap().collect_garbage_if_close_to_threshold();
     }
 
     // If there are eligible tasks in the queue, schedule a new round of processing. :^)
@@ -321,9 +330,29 @@ void EventLoop::queue_task_to_update_the_rendering()
                     // NOTE: Recalculation of styles is handled by update_layout()
                     document->update_layout();
 
-                    // FIXME: 2. Let hadInitialVisibleContentVisibilityDetermination be false.
-                    // FIXME: 3. For each element element with 'auto' used value of 'content-visibility':
-                    // FIXME: 4. If hadInitialVisibleContentVisibilityDetermination is true, then continue.
+                    // 2. Let hadInitialVisibleContentVisibilityDetermination be false.
+                    bool had_initial_visible_content_visibility_determination = false;
+
+                    // 3. For each element element with 'auto' used value of 'content-visibility':
+                    for (auto& element : document->elements_with_content_visibility_auto()) {
+                        // NOTE: This is where we remember the size of the element's contents, see Element::update_last_remembered_size().
+                        //       It has to happen before the proximity changes, as the layout is only up to date for the current one.
+                        element->update_last_remembered_size();
+
+                        // 1. Let checkForInitialDetermination be true if element's proximity to the viewport is not determined and it is not relevant to the user. Otherwise, let checkForInitialDetermination be false.
+                        bool check_for_initial_determination = element->proximity_to_the_viewport() == DOM::Element::ProximityToTheViewport::NotDetermined && !element->is_relevant_to_the_user();
+
+                        // 2. Determine proximity to the viewport for element.
+                        element->determine_proximity_to_the_viewport();
+
+                        // 3. If checkForInitialDetermination is true and element is now relevant to the user, then set hadInitialVisibleContentVisibilityDetermination to true.
+                        if (check_for_initial_determination && element->is_relevant_to_the_user())
+                            had_initial_visible_content_visibility_determination = true;
+                    }
+
+                    // 4. If hadInitialVisibleContentVisibilityDetermination is true, then continue.
+                    if (had_initial_visible_content_visibility_determination)
+                        continue;
 
                     // 5. Gather active resize observations at depth resizeObserverDepth for doc.
                     document->gather_active_observations_at_depth(resize_observer_depth);
@@ -358,7 +387,10 @@ void EventLoop::queue_task_to_update_the_rendering()
 
             // FIXME: 20. For each doc of docs, record rendering time for doc given unsafeStyleAndLayoutStartTime.
 
-            // FIXME: 21. For each doc of docs, mark paint timing for doc.
+            // 21. For each doc of docs, mark paint timing for doc.
+            for (auto& document : docs) {
+                PaintTiming::mark_paint_timing(*document);
+            }
 
             // 22. For each doc of docs, update the rendering or user interface of doc and its node navigable to reflect the current state.
             for (auto& document : docs) {
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <AK/Badge.h>
 #include <AK/DistinctNumeric.h>
+#include <AK/Time.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibJS/Heap/CellAllocator.h>
 #include <LibJS/SafeFunction.h>
@@ -14,6 +16,7 @@
 
 namespace Web::HTML {
 
+class TaskQueue;
 struct UniqueTaskSource;
 
 AK_TYPEDEF_DISTINCT_NUMERIC_GENERAL(u64, TaskID, Comparison);
@@ -66,6 +69,9 @@ public:
         // https://html.spec.whatwg.org/multipage/webappapis.html#rendering-task-source
         Rendering,
 
+        // https://w3c.github.io/IndexedDB/#database-access-task-source
+        DatabaseAccess,
+
         // !!! IMPORTANT: Keep this field last!
         // This serves as the base value of all unique task sources.
         // Some elements, such as the HTMLMediaElement, must have a unique task source per instance.
@@ -84,6 +90,9 @@ public:
 
     bool is_runnable() const;
 
+    MonotonicTime queued_time() const { return m_queued_time; }
+    void set_queued_time(Badge<TaskQueue>, MonotonicTime time) { m_queued_time = time; }
+
 private:
     Task(Source, JS::GCPtr<DOM::Document const>, JS::NonnullGCPtr<JS::HeapFunction<void()>> steps);
 
@@ -93,6 +102,7 @@ private:
     Source m_source { Source::Unspecified };
     JS::NonnullGCPtr<JS::HeapFunction<void()>> m_steps;
     JS::GCPtr<DOM::Document const> m_document;
+    MonotonicTime m_queued_time { MonotonicTime::now_coarse() };
 };
 
 struct UniqueTaskSource {
@@ -4,6 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
+#include <AK/QuickSort.h>
+#include <AK/Time.h>
 #include <LibJS/Heap/MarkedVector.h>
 #include <LibWeb/HTML/EventLoop/EventLoop.h>
 #include <LibWeb/HTML/EventLoop/TaskQueue.h>
@@ -12,6 +15,26 @@ namespace Web::HTML {
 
 JS_DEFINE_ALLOCATOR(TaskQueue);
 
+// A task that has waited at least this long runs before any higher-priority task that was queued after it,
+// so a steady stream of input or rendering work can't starve networking and timers.
+static constexpr auto starvation_threshold = AK::Duration::from_milliseconds(100);
+
+TaskQueue::Priority TaskQueue::priority_for_source(Task::Source source)
+{
+    switch (source) {
+    case Task::Source::UserInteraction:
+        return Priority::UserInteraction;
+    case Task::Source::Rendering:
+        return Priority::Rendering;
+    case Task::Source::TimerTask:
+        return Priority::Timer;
+    case Task::Source::IdleTask:
+        return Priority::Idle;
+    default:
+        return Priority::Normal;
+    }
+}
+
 TaskQueue::TaskQueue(HTML::EventLoop& event_loop)
     : m_event_loop(event_loop)
 {
@@ -23,23 +46,118 @@ void TaskQueue::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_event_loop);
-    visitor.visit(m_tasks);
+    for (auto& queue : m_queues)
+        queue.visit_edges(visitor);
+}
+
+void TaskQueue::PriorityQueue::visit_edges(Visitor& visitor)
+{
+    for (auto& task : tasks())
+        visitor.visit(task);
+}
+
+Optional<size_t> TaskQueue::PriorityQueue::index_of_first_runnable() const
+{
+    for (size_t i = m_first; i < m_tasks.size(); ++i) {
+        if (m_tasks[i]->is_runnable())
+            return i;
+    }
+    return {};
+}
+
+JS::NonnullGCPtr<Task> TaskQueue::PriorityQueue::take(size_t index)
+{
+    VERIFY(index >= m_first && index < m_tasks.size());
+    if (index != m_first)
+        return m_tasks.take(index);
+
+    auto task = m_tasks[m_first++];
+    if (is_empty()) {
+        m_tasks.clear_with_capacity();
+        m_first = 0;
+    } else if (m_first >= 32 && m_first * 2 >= m_tasks.size()) {
+        compact();
+    }
+    return task;
+}
+
+void TaskQueue::PriorityQueue::compact()
+{
+    if (m_first == 0)
+        return;
+    m_tasks.remove(0, m_first);
+    m_first = 0;
 }
 
 void TaskQueue::add(JS::NonnullGCPtr<Task> task)
 {
-    m_tasks.append(task);
+    task->set_queued_time({}, MonotonicTime::now_coarse());
+    queue_for(priority_for_source(task->source())).append(task);
+    ++m_size;
     m_event_loop->schedule();
 }
 
+JS::NonnullGCPtr<Task> TaskQueue::take_from(Priority priority, size_t index)
+{
+    auto task = queue_for(priority).take(index);
+    --m_size;
+    dbgln_if(TASK_QUEUE_DEBUG, "TaskQueue: Taking task {} (source {}, priority {}) after {}ms in the queue",
+        task->id(), to_underlying(task->source()), to_underlying(priority), (MonotonicTime::now_coarse() - task->queued_time()).to_milliseconds());
+    return task;
+}
+
 JS::GCPtr<Task> TaskQueue::take_first_runnable()
 {
     if (m_event_loop->execution_paused())
         return nullptr;
 
-    for (size_t i = 0; i < m_tasks.size(); ++i) {
-        if (m_tasks[i]->is_runnable())
-            return m_tasks.take(i);
+    auto now = MonotonicTime::now_coarse();
+
+    // Take the oldest runnable task of the highest priority, unless a lower-priority task has been waiting for longer
+    // than the starvation threshold, in which case the longest-waiting such task goes first.
+    Optional<Priority> chosen_priority;
+    size_t chosen_index = 0;
+    Optional<Priority> starved_priority;
+    size_t starved_index = 0;
+
+    for (size_t i = 0; i < priority_count; ++i) {
+        auto priority = static_cast<Priority>(i);
+        auto& queue = queue_for(priority);
+        if (queue.is_empty())
+            continue;
+        auto index = queue.index_of_first_runnable();
+        if (!index.has_value())
+            continue;
+
+        if (!chosen_priority.has_value()) {
+            chosen_priority = priority;
+            chosen_index = *index;
+            continue;
+        }
+
+        auto queued_time = queue.at(*index).queued_time();
+        if (now - queued_time < starvation_threshold)
+            continue;
+        if (!starved_priority.has_value() || queued_time < queue_for(*starved_priority).at(starved_index).queued_time()) {
+            starved_priority = priority;
+            starved_index = *index;
+        }
+    }
+
+    if (starved_priority.has_value() && queue_for(*starved_priority).at(starved_index).queued_time() < queue_for(*chosen_priority).at(chosen_index).queued_time())
+        return take_from(*starved_priority, starved_index);
+    if (chosen_priority.has_value())
+        return take_from(*chosen_priority, chosen_index);
+    return nullptr;
+}
+
+JS::GCPtr<Task> TaskQueue::dequeue()
+{
+    for (size_t i = 0; i < priority_count; ++i) {
+        auto priority = static_cast<Priority>(i);
+        auto& queue = queue_for(priority);
+        if (!queue.is_empty())
+            return take_from(priority, queue.first_index());
     }
     return nullptr;
 }
@@ -49,8 +167,8 @@ bool TaskQueue::has_runnable_tasks() const
     if (m_event_loop->execution_paused())
         return false;
 
-    for (auto& task : m_tasks) {
-        if (task->is_runnable())
+    for (auto& queue : m_queues) {
+        if (queue.index_of_first_runnable().has_value())
             return true;
     }
     return false;
@@ -58,34 +176,44 @@ bool TaskQueue::has_runnable_tasks() const
 
 void TaskQueue::remove_tasks_matching(Function<bool(HTML::Task const&)> filter)
 {
-    m_tasks.remove_all_matching([&](auto& task) {
-        return filter(*task);
-    });
+    for (auto& queue : m_queues) {
+        auto size_before = queue.size();
+        queue.remove_all_matching([&](auto& task) {
+            return filter(*task);
+        });
+        m_size -= size_before - queue.size();
+    }
 }
 
 JS::MarkedVector<JS::NonnullGCPtr<Task>> TaskQueue::take_tasks_matching(Function<bool(HTML::Task const&)> filter)
 {
     JS::MarkedVector<JS::NonnullGCPtr<Task>> matching_tasks(heap());
 
-    for (size_t i = 0; i < m_tasks.size();) {
-        auto& task = m_tasks.at(i);
-
-        if (filter(*task)) {
+    for (auto& queue : m_queues) {
+        auto size_before = queue.size();
+        queue.remove_all_matching([&](auto& task) {
+            if (!filter(*task))
+                return false;
             matching_tasks.append(task);
-            m_tasks.remove(i);
-        } else {
-            ++i;
-        }
+            return true;
+        });
+        m_size -= size_before - queue.size();
     }
 
+    // Hand the tasks back in the order they were queued, regardless of which queue they came from.
+    quick_sort(matching_tasks, [](auto& a, auto& b) { return a->id() < b->id(); });
     return matching_tasks;
 }
 
 Task const* TaskQueue::last_added_task() const
 {
-    if (m_tasks.is_empty())
-        return nullptr;
-    return m_tasks.last();
+    Task const* last_added_task = nullptr;
+    for (auto& queue : m_queues) {
+        auto const* task = queue.last();
+        if (task && (!last_added_task || task->id() > last_added_task->id()))
+            last_added_task = task;
+    }
+    return last_added_task;
 }
 
 }
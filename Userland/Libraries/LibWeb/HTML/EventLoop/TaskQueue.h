@@ -6,7 +6,8 @@
 
 #pragma once
 
-#include <AK/Queue.h>
+#include <AK/Array.h>
+#include <AK/Vector.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibWeb/HTML/EventLoop/Task.h>
 
@@ -17,10 +18,23 @@ class TaskQueue : public JS::Cell {
     JS_DECLARE_ALLOCATOR(TaskQueue);
 
 public:
+    // Tasks are kept in one queue per priority. Every task source maps to exactly one of these, so tasks from
+    // the same source still run in the order they were queued.
+    enum class Priority : u8 {
+        UserInteraction,
+        Rendering,
+        Normal,
+        Timer,
+        Idle,
+    };
+    static constexpr size_t priority_count = 5;
+
+    static Priority priority_for_source(Task::Source);
+
     explicit TaskQueue(HTML::EventLoop&);
     virtual ~TaskQueue() override;
 
-    bool is_empty() const { return m_tasks.is_empty(); }
+    bool is_empty() const { return m_size == 0; }
 
     bool has_runnable_tasks() const;
 
@@ -28,12 +42,7 @@ public:
     JS::GCPtr<HTML::Task> take_first_runnable();
 
     void enqueue(JS::NonnullGCPtr<HTML::Task> task) { add(task); }
-    JS::GCPtr<HTML::Task> dequeue()
-    {
-        if (m_tasks.is_empty())
-            return {};
-        return m_tasks.take_first();
-    }
+    JS::GCPtr<HTML::Task> dequeue();
 
     void remove_tasks_matching(Function<bool(HTML::Task const&)>);
     JS::MarkedVector<JS::NonnullGCPtr<Task>> take_tasks_matching(Function<bool(HTML::Task const&)>);
@@ -43,9 +52,47 @@ public:
 private:
     virtual void visit_edges(Visitor&) override;
 
+    class PriorityQueue {
+    public:
+        bool is_empty() const { return m_first == m_tasks.size(); }
+        size_t size() const { return m_tasks.size() - m_first; }
+
+        void append(JS::NonnullGCPtr<Task> task) { m_tasks.append(task); }
+        // Indices are stable until the next call to take() or remove_all_matching().
+        Optional<size_t> index_of_first_runnable() const;
+        size_t first_index() const { return m_first; }
+        Task const& at(size_t index) const { return *m_tasks[index]; }
+        JS::NonnullGCPtr<Task> take(size_t index);
+        Task const* last() const { return is_empty() ? nullptr : m_tasks.last().ptr(); }
+
+        template<typename Callback>
+        void remove_all_matching(Callback callback)
+        {
+            compact();
+            m_tasks.remove_all_matching(callback);
+        }
+
+        ReadonlySpan<JS::NonnullGCPtr<Task>> tasks() const { return m_tasks.span().slice(m_first); }
+
+        void visit_edges(Visitor&);
+
+    private:
+        void compact();
+
+        Vector<JS::NonnullGCPtr<Task>> m_tasks;
+
+        // Tasks before this index have already been taken. Taking from the front just moves it along, and the
+        // vector is compacted once enough dead entries have built up.
+        size_t m_first { 0 };
+    };
+
+    PriorityQueue& queue_for(Priority priority) { return m_queues[to_underlying(priority)]; }
+    JS::NonnullGCPtr<Task> take_from(Priority, size_t index);
+
     JS::NonnullGCPtr<HTML::EventLoop> m_event_loop;
 
-    Vector<JS::NonnullGCPtr<HTML::Task>> m_tasks;
+    Array<PriorityQueue, priority_count> m_queues;
+    size_t m_size { 0 };
 };
 
 }
@@ -7,8 +7,10 @@
 #include <AK/Base64.h>
 #include <AK/Checked.h>
 #include <AK/MemoryStream.h>
+#include <LibCore/System.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/JPEGWriter.h>
+#include <LibGfx/ImmutableBitmap.h>
 #include <LibGfx/ImageFormats/PNGWriter.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/HTMLCanvasElementPrototype.h>
@@ -20,8 +22,10 @@
 #include <LibWeb/HTML/CanvasRenderingContext2D.h>
 #include <LibWeb/HTML/HTMLCanvasElement.h>
 #include <LibWeb/HTML/Numbers.h>
+#include <LibWeb/HTML/OffscreenCanvas.h>
 #include <LibWeb/HTML/Scripting/ExceptionReporter.h>
 #include <LibWeb/Layout/CanvasBox.h>
+#include <LibWeb/Painting/Paintable.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/WebIDL/AbstractOperations.h>
 
@@ -29,8 +33,6 @@ namespace Web::HTML {
 
 JS_DEFINE_ALLOCATOR(HTMLCanvasElement);
 
-static constexpr auto max_canvas_area = 16384 * 16384;
-
 HTMLCanvasElement::HTMLCanvasElement(DOM::Document& document, DOM::QualifiedName qualified_name)
     : HTMLElement(document, move(qualified_name))
 {
@@ -100,6 +102,7 @@ unsigned HTMLCanvasElement::height() const
 
 void HTMLCanvasElement::reset_context_to_default_state()
 {
+    invalidate_snapshot();
     m_context.visit(
         [](JS::NonnullGCPtr<CanvasRenderingContext2D>& context) {
             context->reset_to_default_state();
@@ -114,6 +117,8 @@ void HTMLCanvasElement::reset_context_to_default_state()
 
 WebIDL::ExceptionOr<void> HTMLCanvasElement::set_width(unsigned value)
 {
+    if (m_is_placeholder)
+        return WebIDL::InvalidStateError::create(realm(), "Canvas has transferred control to an OffscreenCanvas"_fly_string);
     TRY(set_attribute(HTML::AttributeNames::width, MUST(String::number(value))));
     m_bitmap = nullptr;
     reset_context_to_default_state();
@@ -122,6 +127,8 @@ WebIDL::ExceptionOr<void> HTMLCanvasElement::set_width(unsigned value)
 
 WebIDL::ExceptionOr<void> HTMLCanvasElement::set_height(unsigned value)
 {
+    if (m_is_placeholder)
+        return WebIDL::InvalidStateError::create(realm(), "Canvas has transferred control to an OffscreenCanvas"_fly_string);
     TRY(set_attribute(HTML::AttributeNames::height, MUST(String::number(value))));
     m_bitmap = nullptr;
     reset_context_to_default_state();
@@ -167,6 +174,9 @@ JS::ThrowCompletionOr<HTMLCanvasElement::RenderingContext> HTMLCanvasElement::ge
 
     // 3. Run the steps in the cell of the following table whose column header matches this canvas element's canvas context mode and whose row header matches contextId:
     // NOTE: See the spec for the full table.
+    if (m_is_placeholder)
+        return JS::throw_completion(WebIDL::InvalidStateError::create(realm(), "Canvas has transferred control to an OffscreenCanvas"_fly_string));
+
     if (type == "2d"sv) {
         if (create_2d_context() == HasOrCreatedContext::Yes)
             return JS::make_handle(*m_context.get<JS::NonnullGCPtr<HTML::CanvasRenderingContext2D>>());
@@ -209,6 +219,7 @@ bool HTMLCanvasElement::create_bitmap(size_t minimum_width, size_t minimum_heigh
     auto size = bitmap_size_for_canvas(*this, minimum_width, minimum_height);
     if (size.is_empty()) {
         m_bitmap = nullptr;
+        invalidate_snapshot();
         return false;
     }
     if (!m_bitmap || m_bitmap->size() != size) {
@@ -216,6 +227,7 @@ bool HTMLCanvasElement::create_bitmap(size_t minimum_width, size_t minimum_heigh
         if (bitmap_or_error.is_error())
             return false;
         m_bitmap = bitmap_or_error.release_value_but_fixme_should_propagate_errors();
+        invalidate_snapshot();
     }
     return m_bitmap;
 }
@@ -262,6 +274,8 @@ String HTMLCanvasElement::to_data_url(StringView type, Optional<double> quality)
     if (!m_bitmap)
         return "data:,"_string;
 
+    present();
+
     // 3. Let file be a serialization of this canvas element's bitmap as a file, passing type and quality if given.
     auto file = serialize_bitmap(*m_bitmap, type, move(quality));
 
@@ -293,8 +307,10 @@ WebIDL::ExceptionOr<void> HTMLCanvasElement::to_blob(JS::NonnullGCPtr<WebIDL::Ca
 
     // 3. If this canvas element's bitmap has pixels (i.e., neither its horizontal dimension nor its vertical dimension is zero),
     //    then set result to a copy of this canvas element's bitmap.
-    if (m_bitmap)
+    if (m_bitmap) {
+        present();
         bitmap_result = TRY_OR_THROW_OOM(vm(), m_bitmap->clone());
+    }
 
     // 4. Run these steps in parallel:
     Platform::EventLoopPlugin::the().deferred_invoke([this, callback, bitmap_result, type, quality] {
@@ -327,8 +343,8 @@ WebIDL::ExceptionOr<void> HTMLCanvasElement::to_blob(JS::NonnullGCPtr<WebIDL::Ca
 void HTMLCanvasElement::present()
 {
     m_context.visit(
-        [](JS::NonnullGCPtr<CanvasRenderingContext2D>&) {
-            // Do nothing, CRC2D writes directly to the canvas bitmap.
+        [](JS::NonnullGCPtr<CanvasRenderingContext2D>& context) {
+            context->present();
         },
         [](JS::NonnullGCPtr<WebGL::WebGLRenderingContext>& context) {
             context->present();
@@ -338,4 +354,96 @@ void HTMLCanvasElement::present()
         });
 }
 
+// https://html.spec.whatwg.org/multipage/canvas.html#dom-canvas-transfercontroltooffscreen
+WebIDL::ExceptionOr<JS::NonnullGCPtr<OffscreenCanvas>> HTMLCanvasElement::transfer_control_to_offscreen()
+{
+    // 1. If this canvas element's context mode is not set to none, throw an "InvalidStateError" DOMException.
+    if (m_is_placeholder || !m_context.has<Empty>())
+        return WebIDL::InvalidStateError::create(realm(), "Canvas already has a rendering context"_fly_string);
+
+    // 2. Let offscreenCanvas be a new OffscreenCanvas object with its width and height equal to the values of the width
+    //    and height content attributes of this canvas element.
+    auto offscreen_canvas = OffscreenCanvas::create(realm(), width(), height());
+
+    // 3. Set the placeholder canvas element of offscreenCanvas to be a weak reference to this canvas element.
+    // NOTE: A canvas without any pixels (or with too many of them) has nothing to show, so there is no need to commit
+    //       frames to it.
+    auto area = Checked<size_t>(width()) * height();
+    RefPtr<SharedCanvasFrame> frame;
+    if (!area.has_overflow() && area.value() <= max_canvas_area) {
+        if (auto frame_or_error = SharedCanvasFrame::create({ static_cast<int>(width()), static_cast<int>(height()) }); !frame_or_error.is_error())
+            frame = frame_or_error.release_value();
+    }
+    if (frame) {
+        int fds[2] = {};
+        TRY_OR_THROW_OOM(vm(), Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+        auto socket0 = MUST(Core::LocalSocket::adopt_fd(fds[0]));
+        MUST(socket0->set_blocking(false));
+        MUST(socket0->set_close_on_exec(true));
+        auto socket1 = MUST(Core::LocalSocket::adopt_fd(fds[1]));
+        MUST(socket1->set_blocking(false));
+        MUST(socket1->set_close_on_exec(true));
+
+        // NOTE: The socket goes away along with us, so it can't call back into a canvas that no longer exists.
+        socket0->on_ready_to_read = [this] {
+            did_receive_placeholder_frame();
+        };
+
+        m_placeholder_frame = frame;
+        m_placeholder_socket = move(socket0);
+        offscreen_canvas->set_placeholder(frame.release_nonnull(), move(socket1));
+    }
+
+    // 4. Set this canvas element's context mode to placeholder.
+    m_is_placeholder = true;
+
+    // 5. Return offscreenCanvas.
+    return offscreen_canvas;
+}
+
+void HTMLCanvasElement::did_receive_placeholder_frame()
+{
+    // NOTE: Frames may have been committed faster than we got around to them, but only the newest one matters.
+    Array<u8, 64> buffer;
+    while (true) {
+        auto bytes = m_placeholder_socket->read_some(buffer);
+        if (bytes.is_error())
+            break;
+        if (bytes.value().is_empty()) {
+            // The OffscreenCanvas went away, so no more frames are coming.
+            m_placeholder_socket->set_notifications_enabled(false);
+            break;
+        }
+    }
+
+    // NOTE: If the frame was read while the next one was being written, that next one will tell us about itself.
+    auto bitmap = m_placeholder_frame->read();
+    if (!bitmap)
+        return;
+
+    // NOTE: Nothing draws to the bitmap of a placeholder, so the snapshot can share it.
+    m_bitmap = bitmap;
+    m_snapshot = Gfx::ImmutableBitmap::create(bitmap.release_nonnull());
+    if (auto* paintable = this->paintable())
+        paintable->set_needs_display();
+}
+
+RefPtr<Gfx::ImmutableBitmap> HTMLCanvasElement::snapshot()
+{
+    if (!m_bitmap) {
+        m_snapshot = nullptr;
+        return nullptr;
+    }
+
+    present();
+
+    if (!m_snapshot) {
+        auto bitmap_or_error = m_bitmap->clone();
+        if (bitmap_or_error.is_error())
+            return nullptr;
+        m_snapshot = Gfx::ImmutableBitmap::create(bitmap_or_error.release_value());
+    }
+    return m_snapshot;
+}
+
 }
@@ -7,12 +7,17 @@
 #pragma once
 
 #include <AK/ByteBuffer.h>
+#include <LibCore/Socket.h>
 #include <LibGfx/Forward.h>
 #include <LibWeb/HTML/HTMLElement.h>
+#include <LibWeb/HTML/SharedCanvasFrame.h>
 #include <LibWeb/WebGL/WebGLRenderingContext.h>
 
 namespace Web::HTML {
 
+// The largest bitmap, in pixels, that canvas elements and OffscreenCanvases are allowed to have.
+static constexpr auto max_canvas_area = 16384 * 16384;
+
 class HTMLCanvasElement final : public HTMLElement {
     WEB_PLATFORM_OBJECT(HTMLCanvasElement, HTMLElement);
     JS_DECLARE_ALLOCATOR(HTMLCanvasElement);
@@ -37,8 +42,16 @@ public:
     String to_data_url(StringView type, Optional<double> quality);
     WebIDL::ExceptionOr<void> to_blob(JS::NonnullGCPtr<WebIDL::CallbackType> callback, StringView type, Optional<double> quality);
 
+    WebIDL::ExceptionOr<JS::NonnullGCPtr<OffscreenCanvas>> transfer_control_to_offscreen();
+
     void present();
 
+    // The current contents of the bitmap, for painting. The copy is only made again if something was drawn since,
+    // so that a canvas that doesn't change from frame to frame doesn't have to be uploaded to the GPU again either.
+    // Unlike the bitmap, the snapshot can be handed to the rendering thread without JS drawing into it meanwhile.
+    RefPtr<Gfx::ImmutableBitmap> snapshot();
+    void invalidate_snapshot() { m_snapshot = nullptr; }
+
 private:
     HTMLCanvasElement(DOM::Document&, DOM::QualifiedName);
 
@@ -58,9 +71,19 @@ private:
     JS::ThrowCompletionOr<HasOrCreatedContext> create_webgl_context(JS::Value options);
     void reset_context_to_default_state();
 
+    void did_receive_placeholder_frame();
+
     RefPtr<Gfx::Bitmap> m_bitmap;
+    RefPtr<Gfx::ImmutableBitmap> m_snapshot;
 
     Variant<JS::NonnullGCPtr<HTML::CanvasRenderingContext2D>, JS::NonnullGCPtr<WebGL::WebGLRenderingContext>, Empty> m_context;
+
+    // https://html.spec.whatwg.org/multipage/canvas.html#concept-canvas-placeholder
+    // NOTE: Once control has been transferred to an OffscreenCanvas, this is where it commits its frames to, see
+    //       OffscreenCanvas::set_placeholder().
+    bool m_is_placeholder { false };
+    RefPtr<SharedCanvasFrame> m_placeholder_frame;
+    OwnPtr<Core::LocalSocket> m_placeholder_socket;
 };
 
 }
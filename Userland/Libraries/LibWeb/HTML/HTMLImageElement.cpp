@@ -74,9 +74,16 @@ void HTMLImageElement::visit_edges(Cell::Visitor& visitor)
     Base::visit_edges(visitor);
     visitor.visit(m_current_request);
     visitor.visit(m_pending_request);
+    visitor.visit(m_image_data_in_viewport);
     visit_lazy_loading_element(visitor);
 }
 
+void HTMLImageElement::removed_from(DOM::Node* old_parent)
+{
+    Base::removed_from(old_parent);
+    set_visible_in_viewport(false);
+}
+
 void HTMLImageElement::apply_presentational_hints(CSS::StyleProperties& style) const
 {
     for_each_attribute([&](auto& name, auto& value) {
@@ -160,9 +167,65 @@ RefPtr<Gfx::ImmutableBitmap> HTMLImageElement::current_image_bitmap(Gfx::IntSize
     return nullptr;
 }
 
-void HTMLImageElement::set_visible_in_viewport(bool)
+Optional<Gfx::IntSize> HTMLImageElement::current_natural_size() const
 {
-    // FIXME: Loosen grip on image data when it's not visible, e.g via volatile memory.
+    if (auto image_data = m_current_request->image_data()) {
+        if (auto width = image_data->intrinsic_width(), height = image_data->intrinsic_height(); width.has_value() && height.has_value())
+            return Gfx::IntSize { width->to_int(), height->to_int() };
+    }
+    if (auto bitmap = current_image_bitmap())
+        return bitmap->size();
+    return {};
+}
+
+// The size in device pixels we expect to show the image at, if we can tell before it's loaded. This lets the image be
+// decoded at that size rather than its natural size.
+Optional<Gfx::IntSize> HTMLImageElement::display_size_hint() const
+{
+    Optional<CSSPixelSize> size;
+
+    if (auto const* layout_node = this->layout_node()) {
+        auto const& computed_values = layout_node->computed_values();
+
+        // These show the image at its natural size (or part of it), regardless of the box's size.
+        if (computed_values.object_fit() == CSS::ObjectFit::None || computed_values.object_fit() == CSS::ObjectFit::ScaleDown)
+            return {};
+
+        if (auto const* paintable_box = this->paintable_box(); paintable_box && !computed_values.width().is_auto() && !computed_values.height().is_auto())
+            size = paintable_box->content_size();
+    }
+
+    if (!size.has_value()) {
+        auto width = get_attribute_value(HTML::AttributeNames::width).to_number<int>();
+        auto height = get_attribute_value(HTML::AttributeNames::height).to_number<int>();
+        if (!width.has_value() || !height.has_value() || *width <= 0 || *height <= 0)
+            return {};
+        size = CSSPixelSize { *width, *height };
+    }
+
+    if (size->is_empty())
+        return {};
+
+    auto device_pixels_per_css_pixel = document().page().client().device_pixels_per_css_pixel();
+    return Gfx::IntSize {
+        static_cast<int>(ceil(size->width().to_double() * device_pixels_per_css_pixel)),
+        static_cast<int>(ceil(size->height().to_double() * device_pixels_per_css_pixel)),
+    };
+}
+
+void HTMLImageElement::set_visible_in_viewport(bool visible_in_viewport)
+{
+    JS::GCPtr<DecodedImageData> image_data;
+    if (visible_in_viewport && m_current_request)
+        image_data = m_current_request->image_data();
+    if (image_data == m_image_data_in_viewport)
+        return;
+
+    if (m_image_data_in_viewport)
+        m_image_data_in_viewport->did_leave_viewport();
+    m_image_data_in_viewport = image_data;
+    if (m_image_data_in_viewport)
+        m_image_data_in_viewport->did_enter_viewport();
 }
 
 // https://html.spec.whatwg.org/multipage/embedded-content.html#dom-img-width
@@ -182,8 +245,8 @@ unsigned HTMLImageElement::width() const
 
     // ...or else the density-corrected intrinsic width and height of the image, in CSS pixels,
     // if the image has intrinsic dimensions and is available but not being rendered.
-    if (auto bitmap = current_image_bitmap())
-        return bitmap->width();
+    if (auto natural_size = current_natural_size(); natural_size.has_value())
+        return natural_size->width();
 
     // ...or else 0, if the image is not available or does not have intrinsic dimensions.
     return 0;
@@ -211,8 +274,8 @@ unsigned HTMLImageElement::height() const
 
     // ...or else the density-corrected intrinsic height and height of the image, in CSS pixels,
     // if the image has intrinsic dimensions and is available but not being rendered.
-    if (auto bitmap = current_image_bitmap())
-        return bitmap->height();
+    if (auto natural_size = current_natural_size(); natural_size.has_value())
+        return natural_size->height();
 
     // ...or else 0, if the image is not available or does not have intrinsic dimensions.
     return 0;
@@ -228,8 +291,8 @@ unsigned HTMLImageElement::natural_width() const
 {
     // Return the density-corrected intrinsic width of the image, in CSS pixels,
     // if the image has intrinsic dimensions and is available.
-    if (auto bitmap = current_image_bitmap())
-        return bitmap->width();
+    if (auto natural_size = current_natural_size(); natural_size.has_value())
+        return natural_size->width();
 
     // ...or else 0.
     return 0;
@@ -240,8 +303,8 @@ unsigned HTMLImageElement::natural_height() const
 {
     // Return the density-corrected intrinsic height of the image, in CSS pixels,
     // if the image has intrinsic dimensions and is available.
-    if (auto bitmap = current_image_bitmap())
-        return bitmap->height();
+    if (auto natural_size = current_natural_size(); natural_size.has_value())
+        return natural_size->height();
 
     // ...or else 0.
     return 0;
@@ -381,6 +444,25 @@ bool HTMLImageElement::uses_srcset_or_picture() const
     return has_attribute(HTML::AttributeNames::srcset) || (parent() && is<HTMLPictureElement>(*parent()));
 }
 
+// AD-HOC: Once the image has been laid out, fetch it ahead of other images if it's in the viewport and after them if
+//         it's not, unless its fetchpriority attribute asks for something specific. Images without layout yet keep
+//         the priority that fetch gives images by default.
+void HTMLImageElement::prioritize_request_by_viewport_visibility(Fetch::Infrastructure::Request& request) const
+{
+    if (request.priority() != Fetch::Infrastructure::Request::Priority::Auto)
+        return;
+
+    auto const* paintable_box = this->paintable_box();
+    auto navigable = document().navigable();
+    if (!paintable_box || !navigable)
+        return;
+
+    auto is_in_viewport = paintable_box->absolute_rect().intersects(navigable->viewport_rect());
+    request.set_internal_priority(Fetch::Infrastructure::Request::InternalPriority {
+        .priority = is_in_viewport ? RequestServer::RequestPriority::High : RequestServer::RequestPriority::Lowest,
+    });
+}
+
 // We batch handling of successfully fetched images to avoid interleaving 1 image, 1 layout, 1 image, 1 layout, etc.
 // The processing timer is 1ms instead of 0ms, since layout is driven by a 0ms timer, and if we use 0ms here,
 // the event loop will process them in insertion order. This is a bit of a hack, but it works.
@@ -657,6 +739,7 @@ after_step_7:
         if (will_lazy_load_element()) {
             // 1. Set the img's lazy load resumption steps to the rest of this algorithm starting with the step labeled fetch the image.
             set_lazy_load_resumption_steps([this, request, image_request]() {
+                prioritize_request_by_viewport_visibility(request);
                 image_request->fetch_image(realm(), request);
             });
 
@@ -667,6 +750,7 @@ after_step_7:
             return;
         }
 
+        prioritize_request_by_viewport_visibility(request);
         image_request->fetch_image(realm(), request);
     }));
     return {};
@@ -708,6 +792,10 @@ void HTMLImageElement::add_callbacks_to_image_request(JS::NonnullGCPtr<ImageRequ
                 set_needs_style_update(true);
                 document().set_needs_layout();
 
+                // The image we're showing may have changed under an earlier visibility report.
+                if (m_image_data_in_viewport)
+                    set_visible_in_viewport(true);
+
                 if (image_data->is_animated() && image_data->frame_count() > 1) {
                     m_current_frame_index = 0;
                     m_animation_timer->set_interval(image_data->frame_duration(0));
@@ -738,7 +826,23 @@ void HTMLImageElement::add_callbacks_to_image_request(JS::NonnullGCPtr<ImageRequ
                 dispatch_event(DOM::Event::create(realm(), HTML::EventNames::error));
 
             m_load_event_delayer.clear();
-        });
+        },
+        display_size_hint());
+
+    // Show the parts of the image that have arrived so far, as long as it's the image we're currently showing.
+    image_request->add_progress_callback([this, image_request]() {
+        if (image_request != m_current_request)
+            return;
+        if (image_request->state() != ImageRequest::State::Unavailable && image_request->state() != ImageRequest::State::PartiallyAvailable)
+            return;
+
+        VERIFY(image_request->shared_resource_request());
+        image_request->set_image_data(image_request->shared_resource_request()->image_data());
+        image_request->set_state(ImageRequest::State::PartiallyAvailable);
+
+        set_needs_style_update(true);
+        document().set_needs_layout();
+    });
 }
 
 void HTMLImageElement::did_set_viewport_rect(CSSPixelRect const& viewport_rect)
@@ -900,9 +1004,11 @@ void HTMLImageElement::react_to_changes_in_the_environment()
                 //    or if the user agent is able to determine that image request's image is corrupted in some
                 //    fatal way such that the image dimensions cannot be obtained,
                 m_pending_request = nullptr;
-            });
+            },
+            display_size_hint());
 
         // 5. Let response be the result of fetching request.
+        prioritize_request_by_viewport_visibility(request);
         image_request->fetch_image(realm(), request);
     }
 }
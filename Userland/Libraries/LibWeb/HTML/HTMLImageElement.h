@@ -74,6 +74,8 @@ public:
     // https://html.spec.whatwg.org/multipage/images.html#use-srcset-or-picture
     [[nodiscard]] bool uses_srcset_or_picture() const;
 
+    void prioritize_request_by_viewport_visibility(Fetch::Infrastructure::Request&) const;
+
     // https://html.spec.whatwg.org/multipage/rendering.html#restart-the-animation
     void restart_the_animation();
 
@@ -117,6 +119,7 @@ private:
     virtual void finalize() override;
 
     virtual void adopted_from(DOM::Document&) override;
+    virtual void removed_from(DOM::Node*) override;
 
     virtual void apply_presentational_hints(CSS::StyleProperties&) const override;
 
@@ -131,6 +134,9 @@ private:
     void handle_failed_fetch();
     void add_callbacks_to_image_request(JS::NonnullGCPtr<ImageRequest>, bool maybe_omit_events, URL::URL const& url_string, URL::URL const& previous_url);
 
+    Optional<Gfx::IntSize> display_size_hint() const;
+    Optional<Gfx::IntSize> current_natural_size() const;
+
     void animate();
 
     RefPtr<Core::Timer> m_animation_timer;
@@ -148,6 +154,9 @@ private:
     // https://html.spec.whatwg.org/multipage/images.html#current-request
     JS::GCPtr<ImageRequest> m_current_request;
 
+    // The image data we've told that we're showing it in the viewport.
+    JS::GCPtr<DecodedImageData> m_image_data_in_viewport;
+
     // https://html.spec.whatwg.org/multipage/images.html#pending-request
     JS::GCPtr<ImageRequest> m_pending_request;
 
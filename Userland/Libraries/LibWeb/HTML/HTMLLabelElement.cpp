@@ -44,7 +44,16 @@ JS::GCPtr<HTMLElement> HTMLLabelElement::control() const
     // and the first such element in tree order is a labelable element, then that element is the
     // label element's labeled control.
     if (for_().has_value()) {
-        root().for_each_in_inclusive_subtree_of_type<HTMLElement>([&](auto& element) {
+        auto const& root = this->root();
+        if (auto const* element_by_id = DOM::element_by_id_map_for_root(root)) {
+            for (auto& element : element_by_id->elements_with_id(*for_(), root)) {
+                if (is<HTMLElement>(*element) && static_cast<HTMLElement&>(*element).is_labelable())
+                    return static_cast<HTMLElement*>(element.ptr());
+            }
+            return {};
+        }
+
+        root.for_each_in_inclusive_subtree_of_type<HTMLElement>([&](auto& element) {
             if (element.id() == *for_() && element.is_labelable()) {
                 control = &const_cast<HTMLElement&>(element);
                 return TraversalDecision::Break;
@@ -195,6 +195,7 @@ WebIDL::ExceptionOr<void> HTMLVideoElement::determine_element_poster_frame(Optio
             (void)Platform::ImageCodecPlugin::the().decode_image(
                 image_data,
                 [strong_this = JS::Handle(*this)](Web::Platform::DecodedImage& image) -> ErrorOr<void> {
+                    Platform::ImageCodecPlugin::the().discard_remaining_frames(image);
                     if (!image.frames.is_empty())
                         strong_this->m_poster_frame = move(image.frames[0].bitmap);
                     return {};
@@ -131,10 +131,16 @@ void ImageRequest::fetch_image(JS::Realm& realm, JS::NonnullGCPtr<Fetch::Infrast
     m_shared_resource_request->fetch_resource(realm, request);
 }
 
-void ImageRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail)
+void ImageRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Optional<Gfx::IntSize> display_size_hint)
 {
     VERIFY(m_shared_resource_request);
-    m_shared_resource_request->add_callbacks(move(on_finish), move(on_fail));
+    m_shared_resource_request->add_callbacks(move(on_finish), move(on_fail), display_size_hint);
+}
+
+void ImageRequest::add_progress_callback(Function<void()> on_progress)
+{
+    VERIFY(m_shared_resource_request);
+    m_shared_resource_request->add_progress_callback(move(on_progress));
 }
 
 }
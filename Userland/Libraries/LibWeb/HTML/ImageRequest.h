@@ -55,7 +55,8 @@ public:
     void prepare_for_presentation(HTMLImageElement&);
 
     void fetch_image(JS::Realm&, JS::NonnullGCPtr<Fetch::Infrastructure::Request>);
-    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail);
+    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Optional<Gfx::IntSize> display_size_hint = {});
+    void add_progress_callback(Function<void()> on_progress);
 
     JS::GCPtr<SharedResourceRequest const> shared_resource_request() const { return m_shared_resource_request; }
 
@@ -34,6 +34,7 @@
 #include <LibWeb/HTML/WindowProxy.h>
 #include <LibWeb/Infra/Strings.h>
 #include <LibWeb/Layout/Node.h>
+#include <LibWeb/Layout/Viewport.h>
 #include <LibWeb/Loader/GeneratedPagesLoader.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/Painting/Paintable.h>
@@ -1991,8 +1992,13 @@ void Navigable::set_viewport_size(CSSPixelSize size)
     m_size = size;
     if (auto document = active_document()) {
         // NOTE: Resizing the viewport changes the reference value for viewport-relative CSS lengths.
+        //       Any element whose style changes because of that will mark itself as needing layout,
+        //       so only the viewport itself is invalidated here.
         document->invalidate_style(DOM::StyleInvalidationReason::NavigableSetViewportSize);
-        document->set_needs_layout();
+        if (auto* viewport = document->layout_node())
+            viewport->set_needs_layout_update();
+        else
+            document->set_needs_layout();
     }
 
     if (auto document = active_document()) {
@@ -2044,7 +2050,11 @@ bool Navigable::has_a_rendering_opportunity() const
     // or whether the document's visibility state is "visible".
     // Rendering opportunities typically occur at regular intervals.
 
-    // FIXME: Return `false` here if we're an inactive browser tab.
+    // NOTE: Navigables in a tab that isn't visible (e.g. a background tab) don't render, as nobody would see it.
+    auto traversable = traversable_navigable();
+    if (traversable && traversable->system_visibility_state() == VisibilityState::Hidden)
+        return false;
+
     auto browsing_context = const_cast<Navigable*>(this)->active_browsing_context();
     if (!browsing_context)
         return false;
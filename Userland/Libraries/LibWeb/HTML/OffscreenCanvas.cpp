@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Checked.h>
+#include <LibCore/System.h>
+#include <LibGfx/Bitmap.h>
+#include <LibIPC/File.h>
+#include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/Bindings/OffscreenCanvasPrototype.h>
+#include <LibWeb/HTML/HTMLCanvasElement.h>
+#include <LibWeb/HTML/ImageBitmap.h>
+#include <LibWeb/HTML/OffscreenCanvas.h>
+#include <LibWeb/HTML/OffscreenCanvasRenderingContext2D.h>
+#include <LibWeb/Platform/EventLoopPlugin.h>
+#include <LibWeb/WebIDL/ExceptionOr.h>
+
+namespace Web::HTML {
+
+constexpr u8 PLACEHOLDER_TAG = 0xA6;
+
+JS_DEFINE_ALLOCATOR(OffscreenCanvas);
+
+JS::NonnullGCPtr<OffscreenCanvas> OffscreenCanvas::create(JS::Realm& realm, WebIDL::UnsignedLongLong width, WebIDL::UnsignedLongLong height)
+{
+    return realm.heap().allocate<OffscreenCanvas>(realm, realm, width, height);
+}
+
+// https://html.spec.whatwg.org/multipage/canvas.html#dom-offscreencanvas
+WebIDL::ExceptionOr<JS::NonnullGCPtr<OffscreenCanvas>> OffscreenCanvas::construct_impl(JS::Realm& realm, WebIDL::UnsignedLongLong width, WebIDL::UnsignedLongLong height)
+{
+    // The new OffscreenCanvas(width, height) constructor steps are:
+    // 1. Initialize the bitmap of this to a rectangular array of transparent black pixels of the dimensions specified by width and height.
+    // 2. Initialize the width of this to width.
+    // 3. Initialize the height of this to height.
+    // 4. Set this's inherited placeholder canvas element to null.
+    // NOTE: The bitmap is only created once something is drawn to it.
+    return create(realm, width, height);
+}
+
+OffscreenCanvas::OffscreenCanvas(JS::Realm& realm, WebIDL::UnsignedLongLong width, WebIDL::UnsignedLongLong height)
+    : DOM::EventTarget(realm)
+    , m_width(width)
+    , m_height(height)
+{
+}
+
+OffscreenCanvas::~OffscreenCanvas() = default;
+
+void OffscreenCanvas::initialize(JS::Realm& realm)
+{
+    Base::initialize(realm);
+    WEB_SET_PROTOTYPE_FOR_INTERFACE(OffscreenCanvas);
+}
+
+void OffscreenCanvas::visit_edges(Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_context);
+}
+
+// https://html.spec.whatwg.org/multipage/canvas.html#dom-offscreencanvas-width
+WebIDL::ExceptionOr<void> OffscreenCanvas::set_width(WebIDL::UnsignedLongLong width)
+{
+    if (is_detached())
+        return WebIDL::InvalidStateError::create(realm(), "OffscreenCanvas has been transferred"_fly_string);
+
+    // On setting the width or height attributes, the user agent must set the bitmap dimensions of this to the new value.
+    m_width = width;
+    reset_bitmap();
+    return {};
+}
+
+// https://html.spec.whatwg.org/multipage/canvas.html#dom-offscreencanvas-height
+WebIDL::ExceptionOr<void> OffscreenCanvas::set_height(WebIDL::UnsignedLongLong height)
+{
+    if (is_detached())
+        return WebIDL::InvalidStateError::create(realm(), "OffscreenCanvas has been transferred"_fly_string);
+
+    m_height = height;
+    reset_bitmap();
+    return {};
+}
+
+// https://html.spec.whatwg.org/multipage/canvas.html#offscreencanvas-set-bitmap-dimensions
+void OffscreenCanvas::reset_bitmap()
+{
+    // FIXME: If there is a placeholder canvas element, its intrinsic size should follow ours. For now, frames that
+    //        don't fit the placeholder are cut off or padded with transparent black instead.
+    m_bitmap = nullptr;
+    if (m_context)
+        m_context->reset_to_default_state();
+}
+
+bool OffscreenCanvas::create_bitmap()
+{
+    Checked<size_t> area = m_width;
+    area *= m_height;
+    if (m_width == 0 || m_height == 0 || area.has_overflow() || area.value() > max_canvas_area) {
+        m_bitmap = nullptr;
+        return false;
+    }
+
+    auto bitmap_or_error = Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, { static_cast<int>(m_width), static_cast<int>(m_height) });
+    if (bitmap_or_error.is_error())
+        return false;
+    m_bitmap = bitmap_or_error.release_value();
+    return true;
+}
+
+// https://html.spec.whatwg.org/multipage/canvas.html#dom-offscreencanvas-getcontext
+WebIDL::ExceptionOr<JS::GCPtr<OffscreenCanvasRenderingContext2D>> OffscreenCanvas::get_context(String const& context_id, JS::Value options)
+{
+    // 1. If options is not an object, then set options to null.
+    // 2. Set options to the result of converting options to a JavaScript value.
+    // NOTE: No-op, as we don't support any options yet.
+    (void)options;
+
+    if (!context_id.is_one_of("2d"sv, "bitmaprenderer"sv, "webgl"sv, "webgl2"sv, "webgpu"sv))
+        return vm().throw_completion<JS::TypeError>(JS::ErrorType::InvalidEnumerationValue, context_id, "OffscreenRenderingContextId");
+
+    // 3. Run the steps in the cell of the following table whose column header matches this OffscreenCanvas object's
+    //    context mode and whose row header matches contextId:
+    if (is_detached())
+        return WebIDL::InvalidStateError::create(realm(), "OffscreenCanvas has been transferred"_fly_string);
+
+    if (context_id == "2d"sv) {
+        // none: Let context be the result of running the offscreen 2D context creation algorithm given this and options.
+        //       Set this's context mode to 2d.
+        //       Return context.
+        if (!m_context)
+            m_context = OffscreenCanvasRenderingContext2D::create(realm(), *this);
+
+        // 2d: Return the same object as was returned the last time the method was invoked with this same first argument.
+        return m_context;
+    }
+
+    // FIXME: Support the other kinds of contexts.
+    return nullptr;
+}
+
+// https://html.spec.whatwg.org/multipage/canvas.html#dom-offscreencanvas-transfertoimagebitmap
+WebIDL::ExceptionOr<JS::NonnullGCPtr<ImageBitmap>> OffscreenCanvas::transfer_to_image_bitmap()
+{
+    // 1. If the value of this OffscreenCanvas object's [[Detached]] internal slot is set to true, then throw an "InvalidStateError" DOMException.
+    if (is_detached())
+        return WebIDL::InvalidStateError::create(realm(), "OffscreenCanvas has been transferred"_fly_string);
+
+    // 2. If this OffscreenCanvas object's context mode is set to none, then throw an "InvalidStateError" DOMException.
+    if (!m_context)
+        return WebIDL::InvalidStateError::create(realm(), "OffscreenCanvas has no rendering context"_fly_string);
+
+    if (!m_bitmap && !create_bitmap())
+        return WebIDL::InvalidStateError::create(realm(), "OffscreenCanvas has no bitmap"_fly_string);
+    m_context->present();
+
+    // 3. Let image be a newly created ImageBitmap object that references the same underlying bitmap data as this
+    //    OffscreenCanvas object's bitmap.
+    auto image = ImageBitmap::create(realm());
+    image->set_bitmap(m_bitmap);
+
+    // 4. Set this OffscreenCanvas object's bitmap to reference a newly created bitmap of the same dimensions and color
+    //    space as the previous bitmap, and with its pixels initialized to transparent black, or opaque black if the
+    //    rendering context's alpha is false.
+    // NOTE: The rendering context creates the new bitmap the next time it draws.
+    m_bitmap = nullptr;
+
+    // 5. Return image.
+    return image;
+}
+
+void OffscreenCanvas::did_draw()
+{
+    if (!m_placeholder_frame || m_has_pending_commit)
+        return;
+
+    m_has_pending_commit = true;
+    Platform::EventLoopPlugin::the().deferred_invoke([this, protect = JS::make_handle(*this)] {
+        m_has_pending_commit = false;
+        commit_to_placeholder();
+    });
+}
+
+// https://html.spec.whatwg.org/multipage/canvas.html#offscreencanvas-placeholder
+void OffscreenCanvas::set_placeholder(NonnullRefPtr<SharedCanvasFrame> frame, NonnullOwnPtr<Core::LocalSocket> socket)
+{
+    m_placeholder_frame = move(frame);
+    m_placeholder_socket = move(socket);
+}
+
+void OffscreenCanvas::commit_to_placeholder()
+{
+    if (!m_placeholder_frame || !m_bitmap)
+        return;
+
+    if (m_context)
+        m_context->present();
+    m_placeholder_frame->write(*m_bitmap);
+
+    // NOTE: If the socket is full, the placeholder hasn't gotten around to the frames announced so far, and will see
+    //       this one when it does. If the placeholder has gone away, nobody is looking anymore.
+    u8 const announcement = 0;
+    (void)m_placeholder_socket->write_some({ &announcement, sizeof(announcement) });
+}
+
+static JS::NonnullGCPtr<WebIDL::DOMException> transfer_error(JS::Realm& realm, Error const& error)
+{
+    dbgln("Failed to transfer OffscreenCanvas: {}", error);
+    return WebIDL::DataCloneError::create(realm, "Failed to transfer OffscreenCanvas"_fly_string);
+}
+
+template<typename T>
+static void append_to_data_holder(TransferDataHolder& data_holder, T value)
+{
+    data_holder.data.append(reinterpret_cast<u8 const*>(&value), sizeof(value));
+}
+
+template<typename T>
+static WebIDL::ExceptionOr<T> take_from_data_holder(JS::Realm& realm, TransferDataHolder& data_holder)
+{
+    if (data_holder.data.size() < sizeof(T))
+        return WebIDL::DataCloneError::create(realm, "Truncated OffscreenCanvas transfer data"_fly_string);
+
+    T value;
+    memcpy(&value, data_holder.data.data(), sizeof(T));
+    data_holder.data.remove(0, sizeof(T));
+    return value;
+}
+
+// https://html.spec.whatwg.org/multipage/canvas.html#the-offscreencanvas-interface:transfer-steps
+WebIDL::ExceptionOr<void> OffscreenCanvas::transfer_steps(HTML::TransferDataHolder& data_holder)
+{
+    // 1. If value's context mode is not equal to none, then throw an "InvalidStateError" DOMException.
+    if (m_context)
+        return WebIDL::InvalidStateError::create(realm(), "Cannot transfer an OffscreenCanvas that has a rendering context"_fly_string);
+
+    // 2. Set value's context mode to detached.
+    // NOTE: This happens when our [[Detached]] internal slot is set after we return.
+
+    // 3. Let width and height be the dimensions of value's bitmap.
+    // 4. Unset value's bitmap.
+    m_bitmap = nullptr;
+
+    // 5. Set dataHolder.[[Width]] to width and dataHolder.[[Height]] to height.
+    append_to_data_holder(data_holder, m_width);
+    append_to_data_holder(data_holder, m_height);
+
+    // 6. Set dataHolder.[[PlaceholderCanvas]] to be a weak reference to value's placeholder canvas element, if value
+    //    has one, or null if it does not.
+    if (m_placeholder_frame) {
+        auto frame_fd = IPC::File::clone_fd(m_placeholder_frame->fd());
+        if (frame_fd.is_error())
+            return transfer_error(realm(), frame_fd.error());
+        auto socket_fd = m_placeholder_socket->release_fd();
+        if (socket_fd.is_error())
+            return transfer_error(realm(), socket_fd.error());
+
+        data_holder.data.append(PLACEHOLDER_TAG);
+        append_to_data_holder<u32>(data_holder, m_placeholder_frame->size().width());
+        append_to_data_holder<u32>(data_holder, m_placeholder_frame->size().height());
+        data_holder.fds.append(frame_fd.release_value());
+        data_holder.fds.append(IPC::File::adopt_fd(socket_fd.release_value()));
+        m_placeholder_frame = nullptr;
+        m_placeholder_socket = nullptr;
+    } else {
+        data_holder.data.append(0);
+    }
+
+    return {};
+}
+
+// https://html.spec.whatwg.org/multipage/canvas.html#the-offscreencanvas-interface:transfer-receiving-steps
+WebIDL::ExceptionOr<void> OffscreenCanvas::transfer_receiving_steps(HTML::TransferDataHolder& data_holder)
+{
+    // 1. Initialize value's bitmap to a rectangular array of transparent black pixels with width given by
+    //    dataHolder.[[Width]] and height given by dataHolder.[[Height]].
+    m_width = TRY(take_from_data_holder<WebIDL::UnsignedLongLong>(realm(), data_holder));
+    m_height = TRY(take_from_data_holder<WebIDL::UnsignedLongLong>(realm(), data_holder));
+
+    // 2. If dataHolder.[[PlaceholderCanvas]] is not null, set value's placeholder canvas element to
+    //    dataHolder.[[PlaceholderCanvas]] (while maintaining the weak reference semantics).
+    auto placeholder_tag = TRY(take_from_data_holder<u8>(realm(), data_holder));
+    if (placeholder_tag == PLACEHOLDER_TAG) {
+        auto frame_width = TRY(take_from_data_holder<u32>(realm(), data_holder));
+        auto frame_height = TRY(take_from_data_holder<u32>(realm(), data_holder));
+        if (data_holder.fds.size() < 2)
+            return WebIDL::DataCloneError::create(realm(), "Missing OffscreenCanvas placeholder"_fly_string);
+
+        auto frame_fd = data_holder.fds.take_first();
+        auto socket_fd = data_holder.fds.take_first();
+        auto frame = SharedCanvasFrame::create_from_fd(frame_fd.take_fd(), { static_cast<int>(frame_width), static_cast<int>(frame_height) });
+        if (frame.is_error())
+            return transfer_error(realm(), frame.error());
+        auto socket = Core::LocalSocket::adopt_fd(socket_fd.take_fd());
+        if (socket.is_error())
+            return transfer_error(realm(), socket.error());
+        if (auto result = socket.value()->set_blocking(false); result.is_error())
+            return transfer_error(realm(), result.error());
+
+        set_placeholder(frame.release_value(), socket.release_value());
+    } else if (placeholder_tag != 0) {
+        return WebIDL::DataCloneError::create(realm(), "Unexpected OffscreenCanvas transfer data"_fly_string);
+    }
+
+    return {};
+}
+
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibCore/Socket.h>
+#include <LibGfx/Forward.h>
+#include <LibWeb/Bindings/Transferable.h>
+#include <LibWeb/DOM/EventTarget.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/HTML/OffscreenCanvasRenderingContext2D.h>
+#include <LibWeb/HTML/SharedCanvasFrame.h>
+#include <LibWeb/WebIDL/Types.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/canvas.html#the-offscreencanvas-interface
+class OffscreenCanvas final : public DOM::EventTarget
+    , public Bindings::Transferable {
+    WEB_PLATFORM_OBJECT(OffscreenCanvas, DOM::EventTarget);
+    JS_DECLARE_ALLOCATOR(OffscreenCanvas);
+
+public:
+    [[nodiscard]] static JS::NonnullGCPtr<OffscreenCanvas> create(JS::Realm&, WebIDL::UnsignedLongLong width, WebIDL::UnsignedLongLong height);
+    static WebIDL::ExceptionOr<JS::NonnullGCPtr<OffscreenCanvas>> construct_impl(JS::Realm&, WebIDL::UnsignedLongLong width, WebIDL::UnsignedLongLong height);
+
+    virtual ~OffscreenCanvas() override;
+
+    WebIDL::UnsignedLongLong width() const { return m_width; }
+    WebIDL::UnsignedLongLong height() const { return m_height; }
+    WebIDL::ExceptionOr<void> set_width(WebIDL::UnsignedLongLong);
+    WebIDL::ExceptionOr<void> set_height(WebIDL::UnsignedLongLong);
+
+    WebIDL::ExceptionOr<JS::GCPtr<OffscreenCanvasRenderingContext2D>> get_context(String const& context_id, JS::Value options);
+    WebIDL::ExceptionOr<JS::NonnullGCPtr<ImageBitmap>> transfer_to_image_bitmap();
+
+    // ^Transferable
+    virtual WebIDL::ExceptionOr<void> transfer_steps(HTML::TransferDataHolder&) override;
+    virtual WebIDL::ExceptionOr<void> transfer_receiving_steps(HTML::TransferDataHolder&) override;
+    virtual HTML::TransferType primary_interface() const override { return HTML::TransferType::OffscreenCanvas; }
+
+    Gfx::Bitmap* bitmap() { return m_bitmap; }
+    bool create_bitmap();
+
+    // Called by the rendering context. If there is a placeholder canvas element, the new frame is committed to it
+    // once the current task is done, so that it shows everything that was drawn during that task at once.
+    void did_draw();
+
+    // https://html.spec.whatwg.org/multipage/canvas.html#offscreencanvas-placeholder
+    // The frames committed to the placeholder go through shared memory, as the placeholder may be in another process.
+    // Every commit is announced by writing to the socket, the other end of which the placeholder is listening to.
+    void set_placeholder(NonnullRefPtr<SharedCanvasFrame>, NonnullOwnPtr<Core::LocalSocket>);
+
+private:
+    OffscreenCanvas(JS::Realm&, WebIDL::UnsignedLongLong width, WebIDL::UnsignedLongLong height);
+
+    virtual void initialize(JS::Realm&) override;
+    virtual void visit_edges(Cell::Visitor&) override;
+
+    void reset_bitmap();
+    void commit_to_placeholder();
+
+    WebIDL::UnsignedLongLong m_width { 0 };
+    WebIDL::UnsignedLongLong m_height { 0 };
+    RefPtr<Gfx::Bitmap> m_bitmap;
+
+    // https://html.spec.whatwg.org/multipage/canvas.html#offscreencanvas-context-mode
+    // NOTE: The context mode is "none" while there is no context, and "detached" once we have been transferred.
+    JS::GCPtr<OffscreenCanvasRenderingContext2D> m_context;
+
+    RefPtr<SharedCanvasFrame> m_placeholder_frame;
+    OwnPtr<Core::LocalSocket> m_placeholder_socket;
+    bool m_has_pending_commit { false };
+};
+
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/Bindings/OffscreenCanvasRenderingContext2DPrototype.h>
+#include <LibWeb/CSS/StyleValues/LengthStyleValue.h>
+#include <LibWeb/HTML/OffscreenCanvas.h>
+#include <LibWeb/HTML/OffscreenCanvasRenderingContext2D.h>
+#include <LibWeb/HTML/Scripting/Environments.h>
+#include <LibWeb/HTML/Window.h>
+#include <LibWeb/Platform/FontPlugin.h>
+
+namespace Web::HTML {
+
+JS_DEFINE_ALLOCATOR(OffscreenCanvasRenderingContext2D);
+
+JS::NonnullGCPtr<OffscreenCanvasRenderingContext2D> OffscreenCanvasRenderingContext2D::create(JS::Realm& realm, OffscreenCanvas& canvas)
+{
+    return realm.heap().allocate<OffscreenCanvasRenderingContext2D>(realm, realm, canvas);
+}
+
+OffscreenCanvasRenderingContext2D::OffscreenCanvasRenderingContext2D(JS::Realm& realm, OffscreenCanvas& canvas)
+    : CanvasRenderingContext2D(realm)
+    , m_canvas(canvas)
+{
+}
+
+OffscreenCanvasRenderingContext2D::~OffscreenCanvasRenderingContext2D() = default;
+
+void OffscreenCanvasRenderingContext2D::initialize(JS::Realm& realm)
+{
+    Base::initialize(realm);
+    WEB_SET_PROTOTYPE_FOR_INTERFACE(OffscreenCanvasRenderingContext2D);
+}
+
+void OffscreenCanvasRenderingContext2D::visit_edges(Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_canvas);
+}
+
+Gfx::Bitmap* OffscreenCanvasRenderingContext2D::canvas_bitmap()
+{
+    return m_canvas->bitmap();
+}
+
+bool OffscreenCanvasRenderingContext2D::create_canvas_bitmap()
+{
+    return m_canvas->create_bitmap();
+}
+
+void OffscreenCanvasRenderingContext2D::did_draw(Gfx::FloatRect const&)
+{
+    m_canvas->did_draw();
+}
+
+RefPtr<Gfx::Font const> OffscreenCanvasRenderingContext2D::font_for_style_value(CSS::ShorthandStyleValue const& font_style_value)
+{
+    auto& font_style = *font_style_value.longhand(CSS::PropertyID::FontStyle);
+    auto& font_weight = *font_style_value.longhand(CSS::PropertyID::FontWeight);
+    auto& font_width = *font_style_value.longhand(CSS::PropertyID::FontWidth);
+    auto& font_size = *font_style_value.longhand(CSS::PropertyID::FontSize);
+    auto& font_family = *font_style_value.longhand(CSS::PropertyID::FontFamily);
+
+    // NOTE: On the main thread, fonts are looked up like they are for the canvas element, only without an element to
+    //       inherit from.
+    if (auto& global_object = relevant_global_object(*this); is<HTML::Window>(global_object)) {
+        auto& window = static_cast<HTML::Window&>(global_object);
+        auto font_list = window.associated_document().style_computer().compute_font_for_style_values(nullptr, {}, font_family, font_size, font_style, font_weight, font_width);
+        return font_list->first();
+    }
+
+    // FIXME: Workers have no style computer to look up fonts with, so they get the default font in the right size.
+    float font_size_in_px = 10;
+    if (font_size.is_length() && font_size.as_length().length().is_absolute())
+        font_size_in_px = font_size.as_length().length().absolute_length_to_px().to_float();
+    return Platform::FontPlugin::the().default_font().with_size(font_size_in_px * 0.75f);
+}
+
+}
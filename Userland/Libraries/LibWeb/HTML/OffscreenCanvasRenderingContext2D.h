@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibWeb/HTML/CanvasRenderingContext2D.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/canvas.html#the-offscreen-2d-rendering-context
+// Draws just like CanvasRenderingContext2D does, only to the bitmap of an OffscreenCanvas, which may be in a worker.
+class OffscreenCanvasRenderingContext2D final : public CanvasRenderingContext2D {
+    WEB_PLATFORM_OBJECT(OffscreenCanvasRenderingContext2D, CanvasRenderingContext2D);
+    JS_DECLARE_ALLOCATOR(OffscreenCanvasRenderingContext2D);
+
+public:
+    [[nodiscard]] static JS::NonnullGCPtr<OffscreenCanvasRenderingContext2D> create(JS::Realm&, OffscreenCanvas&);
+    virtual ~OffscreenCanvasRenderingContext2D() override;
+
+    JS::NonnullGCPtr<OffscreenCanvas> offscreen_canvas_for_binding() const { return m_canvas; }
+
+    virtual RefPtr<Gfx::Font const> font_for_style_value(CSS::ShorthandStyleValue const&) override;
+
+private:
+    OffscreenCanvasRenderingContext2D(JS::Realm&, OffscreenCanvas&);
+
+    virtual void initialize(JS::Realm&) override;
+    virtual void visit_edges(Cell::Visitor&) override;
+
+    virtual Gfx::Bitmap* canvas_bitmap() override;
+    virtual bool create_canvas_bitmap() override;
+    virtual void did_draw(Gfx::FloatRect const&) override;
+
+    JS::NonnullGCPtr<OffscreenCanvas> m_canvas;
+};
+
+}
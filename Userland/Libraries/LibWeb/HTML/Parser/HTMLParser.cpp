@@ -9,6 +9,7 @@
 #include <AK/Debug.h>
 #include <AK/SourceLocation.h>
 #include <AK/Utf32View.h>
+#include <LibCore/Tracing.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
@@ -35,6 +36,7 @@
 #include <LibWeb/HTML/Parser/HTMLEncodingDetection.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
 #include <LibWeb/HTML/Parser/HTMLToken.h>
+#include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
 #include <LibWeb/HTML/Scripting/ExceptionReporter.h>
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/HighResolutionTime/TimeOrigin.h>
@@ -174,6 +176,8 @@ void HTMLParser::visit_edges(Cell::Visitor& visitor)
 
 void HTMLParser::run(HTMLTokenizer::StopAtInsertionPoint stop_at_insertion_point)
 {
+    Core::Tracing::ScopedEvent trace_event { Core::Tracing::Category::HTMLParse, "HTMLParser::run"sv };
+
     for (;;) {
         // FIXME: Find a better way to say that we come from Document::close() and want to process EOF.
         if (!m_tokenizer.is_eof_inserted() && m_tokenizer.is_insertion_point_reached())
@@ -2930,7 +2934,14 @@ void HTMLParser::handle_text(HTMLToken& token)
                     // 2. Set the pending parsing-blocking script to null.
                     auto the_script = document().take_pending_parsing_blocking_script({});
 
-                    // FIXME: 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // NOTE: We don't stream the input, so everything after the insertion point is already available
+                    //       and a single speculative pass finds every resource in it. Later blocking scripts would
+                    //       only rescan the same input, so those are skipped.
+                    if (!m_has_run_speculative_html_parser) {
+                        m_has_run_speculative_html_parser = true;
+                        run_speculative_html_parser(*m_document, m_tokenizer.remaining_input());
+                    }
 
                     // 4. Block the tokenizer for this instance of the HTML parser, such that the event loop will not run tasks that invoke the tokenizer.
                     m_tokenizer.set_blocked(true);
@@ -2949,7 +2960,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     if (m_aborted)
                         return;
 
-                    // FIXME: 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // NOTE: The speculative HTML parser runs to completion synchronously, so there is nothing left to stop.
 
                     // 8. Unblock the tokenizer for this instance of the HTML parser, such that tasks that invoke the tokenizer can again be run.
                     m_tokenizer.set_blocked(false);
@@ -4266,9 +4278,42 @@ DOM::Document& HTMLParser::document()
     return *m_document;
 }
 
+// Returns whether running the fragment parsing algorithm on markup would produce nothing but a single text node
+// containing markup verbatim (or no nodes at all, if markup is empty).
+static bool fragment_parses_as_plain_text(DOM::Element const& context_element, StringView markup)
+{
+    if (context_element.namespace_uri() != Namespace::HTML)
+        return false;
+
+    // In these contexts, character tokens are dropped, foster-parented or make the parser imply elements around them.
+    if (context_element.local_name().is_one_of(HTML::TagNames::html, HTML::TagNames::head, HTML::TagNames::frameset, HTML::TagNames::table, HTML::TagNames::tbody, HTML::TagNames::thead, HTML::TagNames::tfoot, HTML::TagNames::tr, HTML::TagNames::colgroup, HTML::TagNames::template_))
+        return false;
+
+    // Without tags, character references, NULs or newlines to normalize, every code point becomes a character token
+    // that is appended to the same text node.
+    for (auto byte : markup.bytes()) {
+        if (byte == '<' || byte == '&' || byte == '\r' || byte == '\0')
+            return false;
+    }
+    return true;
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#parsing-html-fragments
 Vector<JS::Handle<DOM::Node>> HTMLParser::parse_html_fragment(DOM::Element& context_element, StringView markup, AllowDeclarativeShadowRoots allow_declarative_shadow_roots)
 {
+    // AD-HOC: Setting innerHTML to plain text is very common. When the result can only be a single text node, skip
+    //         creating a temporary document, parser and root element just to build it.
+    if (fragment_parses_as_plain_text(context_element, markup)) {
+        if (auto data = String::from_utf8(markup); !data.is_error()) {
+            Vector<JS::Handle<DOM::Node>> children;
+            if (!markup.is_empty()) {
+                auto& document = context_element.document();
+                children.append(JS::make_handle(*document.heap().allocate<DOM::Text>(document.realm(), document, data.release_value())));
+            }
+            return children;
+        }
+    }
+
     // 1. Create a new Document node, and mark it as being an HTML document.
     auto temp_document = DOM::Document::create_for_fragment_parsing(context_element.realm());
     temp_document->set_document_type(DOM::Document::Type::HTML);
@@ -4387,6 +4432,16 @@ JS::NonnullGCPtr<HTMLParser> HTMLParser::create(DOM::Document& document, StringV
     return document.heap().allocate_without_realm<HTMLParser>(document, input, encoding);
 }
 
+JS::NonnullGCPtr<HTMLParser> HTMLParser::create_with_decoded_input(DOM::Document& document, ByteString decoded_input, StringView encoding)
+{
+    auto parser = document.heap().allocate_without_realm<HTMLParser>(document);
+    parser->m_tokenizer.set_decoded_input(move(decoded_input));
+    auto standardized_encoding = TextCodec::get_standardized_encoding(encoding);
+    VERIFY(standardized_encoding.has_value());
+    document.set_encoding(MUST(String::from_utf8(standardized_encoding.value())));
+    return parser;
+}
+
 enum class AttributeMode {
     No,
     Yes,
@@ -8,8 +8,10 @@
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/GenericShorthands.h>
+#include <AK/HashMap.h>
 #include <AK/SourceLocation.h>
 #include <LibTextCodec/Decoder.h>
+#include <LibWeb/HTML/AttributeNames.h>
 #include <LibWeb/HTML/Parser/Entities.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
 #include <LibWeb/HTML/Parser/HTMLToken.h>
@@ -198,20 +200,16 @@ Optional<u32> HTMLTokenizer::next_code_point()
     if (m_utf8_iterator == m_utf8_view.end())
         return {};
 
-    u32 code_point;
+    u32 code_point = *m_utf8_iterator;
     // https://html.spec.whatwg.org/multipage/parsing.html#preprocessing-the-input-stream:tokenization
     // https://infra.spec.whatwg.org/#normalize-newlines
-    if (peek_code_point(0).value_or(0) == '\r' && peek_code_point(1).value_or(0) == '\n') {
+    if (code_point == '\r') {
         // replace every U+000D CR U+000A LF code point pair with a single U+000A LF code point,
-        skip(2);
-        code_point = '\n';
-    } else if (peek_code_point(0).value_or(0) == '\r') {
-        // replace every remaining U+000D CR code point with a U+000A LF code point.
-        skip(1);
+        // and replace every remaining U+000D CR code point with a U+000A LF code point.
+        skip(peek_code_point(1).value_or(0) == '\n' ? 2 : 1);
         code_point = '\n';
     } else {
         skip(1);
-        code_point = *m_prev_utf8_iterator;
     }
 
     dbgln_if(TOKENIZER_TRACE_DEBUG, "(Tokenizer) Next code_point: {}", code_point);
@@ -238,6 +236,66 @@ void HTMLTokenizer::skip(size_t count)
     }
 }
 
+// A set of ASCII bytes that end a run of input which can be appended to the current builder verbatim.
+// CR (which needs newline normalization) and NUL (which needs replacing) always end a run.
+class RunTerminators {
+public:
+    constexpr RunTerminators(StringView bytes)
+    {
+        add('\r');
+        add('\0');
+        for (auto byte : bytes)
+            add(byte);
+    }
+
+    constexpr bool contains(u8 byte) const { return m_bits[byte / 64] & (1ull << (byte % 64)); }
+
+private:
+    constexpr void add(u8 byte) { m_bits[byte / 64] |= 1ull << (byte % 64); }
+
+    u64 m_bits[4] {};
+};
+
+static constexpr RunTerminators double_quoted_attribute_value_run_terminators { "\"&"sv };
+static constexpr RunTerminators single_quoted_attribute_value_run_terminators { "'&"sv };
+static constexpr RunTerminators unquoted_attribute_value_run_terminators { "\t\n\f &>\"'<=`"sv };
+
+void HTMLTokenizer::consume_run_into_current_builder(RunTerminators const& terminators)
+{
+    auto start = m_utf8_view.byte_offset_of(m_utf8_iterator);
+    auto end = m_decoded_input.length();
+    if (m_insertion_point.defined && m_insertion_point.position >= start)
+        end = m_insertion_point.position;
+
+    auto const* bytes = reinterpret_cast<u8 const*>(m_decoded_input.characters());
+    auto position = m_source_positions.is_empty() ? Optional<HTMLToken::Position> {} : m_source_positions.last();
+
+    // Scan a byte at a time rather than a code point at a time; every terminator is ASCII, so a run
+    // can never end in the middle of a multi-byte sequence.
+    auto offset = start;
+    for (; offset < end && !terminators.contains(bytes[offset]); ++offset) {
+        if (!position.has_value())
+            continue;
+        if (bytes[offset] == '\n') {
+            position->line++;
+            position->column = 0;
+        } else if ((bytes[offset] & 0xC0) != 0x80) {
+            position->column++;
+        }
+    }
+
+    if (offset == start)
+        return;
+
+    m_current_builder.append(m_decoded_input.substring_view(start, offset - start));
+    m_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(offset);
+    m_prev_utf8_iterator = m_utf8_iterator;
+    if (position.has_value()) {
+        position->byte_offset += offset - start;
+        m_source_positions.append(position.release_value());
+    }
+}
+
 Optional<u32> HTMLTokenizer::peek_code_point(size_t offset) const
 {
     auto it = m_utf8_iterator;
@@ -1120,31 +1178,31 @@ _StartOfFunction:
                 ON_WHITESPACE
                 {
                     m_current_token.last_attribute().name_end_position = nth_last_position(1);
-                    m_current_token.last_attribute().local_name = consume_current_builder();
+                    m_current_token.last_attribute().local_name = consume_current_builder_as_attribute_name();
                     RECONSUME_IN(AfterAttributeName);
                 }
                 ON('/')
                 {
                     m_current_token.last_attribute().name_end_position = nth_last_position(1);
-                    m_current_token.last_attribute().local_name = consume_current_builder();
+                    m_current_token.last_attribute().local_name = consume_current_builder_as_attribute_name();
                     RECONSUME_IN(AfterAttributeName);
                 }
                 ON('>')
                 {
                     m_current_token.last_attribute().name_end_position = nth_last_position(1);
-                    m_current_token.last_attribute().local_name = consume_current_builder();
+                    m_current_token.last_attribute().local_name = consume_current_builder_as_attribute_name();
                     RECONSUME_IN(AfterAttributeName);
                 }
                 ON_EOF
                 {
                     m_current_token.last_attribute().name_end_position = nth_last_position(1);
-                    m_current_token.last_attribute().local_name = consume_current_builder();
+                    m_current_token.last_attribute().local_name = consume_current_builder_as_attribute_name();
                     RECONSUME_IN(AfterAttributeName);
                 }
                 ON('=')
                 {
                     m_current_token.last_attribute().name_end_position = nth_last_position(1);
-                    m_current_token.last_attribute().local_name = consume_current_builder();
+                    m_current_token.last_attribute().local_name = consume_current_builder_as_attribute_name();
                     SWITCH_TO(BeforeAttributeValue);
                 }
                 ON_ASCII_UPPER_ALPHA
@@ -1272,6 +1330,7 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    consume_run_into_current_builder(double_quoted_attribute_value_run_terminators);
                     continue;
                 }
             }
@@ -1304,6 +1363,7 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    consume_run_into_current_builder(single_quoted_attribute_value_run_terminators);
                     continue;
                 }
             }
@@ -1369,6 +1429,7 @@ _StartOfFunction:
                 {
                 AnythingElseAttributeValueUnquoted:
                     m_current_builder.append_code_point(current_input_character.value());
+                    consume_run_into_current_builder(unquoted_attribute_value_run_terminators);
                     continue;
                 }
             }
@@ -2801,13 +2862,24 @@ HTMLTokenizer::HTMLTokenizer()
 }
 
 HTMLTokenizer::HTMLTokenizer(StringView input, ByteString const& encoding)
+{
+    set_decoded_input(decode_input(input, encoding));
+}
+
+ByteString HTMLTokenizer::decode_input(StringView input, StringView encoding)
 {
     auto decoder = TextCodec::decoder_for(encoding);
     VERIFY(decoder.has_value());
-    m_decoded_input = decoder->to_utf8(input).release_value_but_fixme_should_propagate_errors().to_byte_string();
+    return decoder->to_utf8(input).release_value_but_fixme_should_propagate_errors().to_byte_string();
+}
+
+void HTMLTokenizer::set_decoded_input(ByteString decoded_input)
+{
+    m_decoded_input = move(decoded_input);
     m_utf8_view = Utf8View(m_decoded_input);
     m_utf8_iterator = m_utf8_view.begin();
     m_prev_utf8_iterator = m_utf8_view.begin();
+    m_source_positions.clear_with_capacity();
     m_source_positions.empend(0u, 0u);
 }
 
@@ -2903,4 +2975,27 @@ String HTMLTokenizer::consume_current_builder()
     return string;
 }
 
+static HashMap<StringView, FlyString> const& known_attribute_names()
+{
+    static HashMap<StringView, FlyString> names;
+    if (names.is_empty()) {
+#define __ENUMERATE_HTML_ATTRIBUTE(name) \
+    names.set(AttributeNames::name.bytes_as_string_view(), AttributeNames::name);
+        ENUMERATE_HTML_ATTRIBUTES
+#undef __ENUMERATE_HTML_ATTRIBUTE
+    }
+    return names;
+}
+
+FlyString HTMLTokenizer::consume_current_builder_as_attribute_name()
+{
+    // Almost every attribute name in real content is a known one, so hand out the interned name directly
+    // instead of building a String just to look it up in the FlyString table.
+    if (auto name = known_attribute_names().get(m_current_builder.string_view()); name.has_value()) {
+        m_current_builder.clear();
+        return name.release_value();
+    }
+    return consume_current_builder();
+}
+
 }
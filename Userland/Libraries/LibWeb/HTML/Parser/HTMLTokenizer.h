@@ -18,6 +18,8 @@
 
 namespace Web::HTML {
 
+class RunTerminators;
+
 #define ENUMERATE_TOKENIZER_STATES                                        \
     __ENUMERATE_TOKENIZER_STATE(Data)                                     \
     __ENUMERATE_TOKENIZER_STATE(RCDATA)                                   \
@@ -105,6 +107,11 @@ public:
     explicit HTMLTokenizer();
     explicit HTMLTokenizer(StringView input, ByteString const& encoding);
 
+    // Decoding is pure CPU work over the input bytes, so it may be done ahead of time (and on another thread)
+    // and the result handed to set_decoded_input() before tokenization starts.
+    static ByteString decode_input(StringView input, StringView encoding);
+    void set_decoded_input(ByteString);
+
     enum class State {
 #define __ENUMERATE_TOKENIZER_STATE(state) state,
         ENUMERATE_TOKENIZER_STATES
@@ -129,6 +136,7 @@ public:
     bool is_blocked() const { return m_blocked; }
 
     ByteString source() const { return m_decoded_input; }
+    StringView remaining_input() const { return m_decoded_input.substring_view(m_utf8_view.byte_offset_of(m_utf8_iterator)); }
 
     void insert_input_at_insertion_point(StringView input);
     void insert_eof();
@@ -159,6 +167,8 @@ private:
     void create_new_token(HTMLToken::Type);
     bool current_end_tag_token_is_appropriate() const;
     String consume_current_builder();
+    FlyString consume_current_builder_as_attribute_name();
+    void consume_run_into_current_builder(RunTerminators const&);
 
     static char const* state_name(State state)
     {
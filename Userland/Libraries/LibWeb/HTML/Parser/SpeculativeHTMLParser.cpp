@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/HashTable.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/Fetch/Fetching/Fetching.h>
+#include <LibWeb/Fetch/Infrastructure/FetchAlgorithms.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/CORSSettingAttribute.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
+#include <LibWeb/HTML/PotentialCORSRequest.h>
+#include <LibWeb/HTML/PreloadEntry.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Infra/CharacterTypes.h>
+#include <LibWeb/MimeSniff/MimeType.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-fetch
+static void speculative_fetch(DOM::Document& document, HashTable<URL::URL>& fetched_urls, URL::URL const& url, Fetch::Infrastructure::Request::Destination destination, CORSSettingAttribute cors_setting, String const& integrity_metadata = {})
+{
+    // Only network fetches are worth overlapping with the blocking script.
+    if (!url.is_valid() || !url.scheme().is_one_of("http"sv, "https"sv))
+        return;
+    if (fetched_urls.set(url) != AK::HashSetResult::InsertedNewEntry)
+        return;
+
+    auto& vm = document.vm();
+    auto request = create_potential_CORS_request(vm, url, destination, cors_setting);
+    request->set_client(&document.relevant_settings_object());
+    request->set_priority(Fetch::Infrastructure::Request::Priority::Low);
+    request->set_integrity_metadata(integrity_metadata);
+
+    // The response is handed to the element's own fetch through the document's map of preloaded resources, the same
+    // way a <link rel=preload> would, so the resource is only downloaded once even when nothing ends up in the HTTP cache.
+    PreloadKey key { request->url(), request->destination(), request->mode(), request->credentials_mode() };
+    auto& preloads = document.map_of_preloaded_resources();
+    if (preloads.contains(key))
+        return;
+
+    dbgln_if(HTML_PARSER_DEBUG, "Speculative fetch: {}", url);
+
+    auto entry = PreloadEntry::create(vm, integrity_metadata);
+
+    Fetch::Infrastructure::FetchAlgorithms::Input fetch_algorithms_input {};
+    fetch_algorithms_input.process_response_consume_body = [&vm, entry](JS::NonnullGCPtr<Fetch::Infrastructure::Response> response, Fetch::Infrastructure::FetchAlgorithms::BodyBytes body_bytes) {
+        // NOTE: A fully read body still has its bytes as its source, so the consumer can read it again.
+        if (body_bytes.has<Fetch::Infrastructure::FetchAlgorithms::ConsumeBodyFailureTag>())
+            response = Fetch::Infrastructure::Response::network_error(vm, "Speculative fetch failed to read the response body"sv);
+
+        if (auto on_response_available = entry->on_response_available())
+            on_response_available->function()(response);
+        else
+            entry->set_response(response);
+    };
+    (void)Fetch::Fetching::fetch(document.realm(), request, Fetch::Infrastructure::FetchAlgorithms::create(vm, move(fetch_algorithms_input)));
+
+    // NOTE: The entry goes into the map only once the fetch has started, so that fetch doesn't consume it itself.
+    preloads.set(move(key), entry);
+}
+
+static bool has_link_type(Optional<String> const& rel, StringView link_type)
+{
+    if (!rel.has_value())
+        return false;
+    for (auto part : rel->bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace)) {
+        if (part.equals_ignoring_ascii_case(link_type))
+            return true;
+    }
+    return false;
+}
+
+void run_speculative_html_parser(DOM::Document& document, StringView remaining_input)
+{
+    // The speculative parser only looks for resources to fetch; it never touches the DOM. Without a tree builder,
+    // the tokenizer is switched into the text states by hand, as the tree construction stage would do.
+    HTMLTokenizer tokenizer { remaining_input, "utf-8" };
+    HashTable<URL::URL> fetched_urls;
+
+    // The speculative HTML parser should act as if the first base element with an href attribute applies.
+    auto base_url = document.base_url();
+    bool has_seen_base_element = false;
+
+    auto complete_url = [&](Optional<String> const& value) -> Optional<URL::URL> {
+        if (!value.has_value() || value->is_empty())
+            return {};
+        return base_url.complete_url(*value);
+    };
+
+    for (;;) {
+        auto token = tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+        if (!token->is_start_tag())
+            continue;
+
+        auto const& tag_name = token->tag_name();
+
+        if (tag_name == TagNames::base) {
+            if (!has_seen_base_element) {
+                if (auto href = token->attribute(AttributeNames::href); href.has_value()) {
+                    has_seen_base_element = true;
+                    base_url = document.fallback_base_url().complete_url(*href);
+                }
+            }
+        } else if (tag_name == TagNames::script) {
+            auto type = token->attribute(AttributeNames::type);
+            bool is_module = type.has_value() && type->equals_ignoring_ascii_case("module"sv);
+            bool is_fetchable_type = !type.has_value()
+                || type->is_empty()
+                || is_module
+                || MimeSniff::is_javascript_mime_type_essence_match(type->bytes_as_string_view().trim(Infra::ASCII_WHITESPACE));
+            if (is_fetchable_type) {
+                auto cors_setting = cors_setting_attribute_from_keyword(token->attribute(AttributeNames::crossorigin));
+                // NOTE: Module scripts are always fetched in "cors" mode, with same-origin credentials unless crossorigin says otherwise.
+                if (is_module && cors_setting == CORSSettingAttribute::NoCORS)
+                    cors_setting = CORSSettingAttribute::Anonymous;
+                if (auto url = complete_url(token->attribute(AttributeNames::src)); url.has_value())
+                    speculative_fetch(document, fetched_urls, *url, Fetch::Infrastructure::Request::Destination::Script, cors_setting, token->attribute(AttributeNames::integrity).value_or({}));
+            }
+            tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+        } else if (tag_name == TagNames::link) {
+            auto rel = token->attribute(AttributeNames::rel);
+            if (has_link_type(rel, "stylesheet"sv) && !has_link_type(rel, "alternate"sv)) {
+                if (auto url = complete_url(token->attribute(AttributeNames::href)); url.has_value())
+                    speculative_fetch(document, fetched_urls, *url, Fetch::Infrastructure::Request::Destination::Style, cors_setting_attribute_from_keyword(token->attribute(AttributeNames::crossorigin)), token->attribute(AttributeNames::integrity).value_or({}));
+            }
+        } else if (tag_name == TagNames::img) {
+            // FIXME: Pick a candidate from srcset and sizes the way the image's update the image data steps would.
+            if (!token->has_attribute(AttributeNames::srcset)) {
+                if (auto url = complete_url(token->attribute(AttributeNames::src)); url.has_value())
+                    speculative_fetch(document, fetched_urls, *url, Fetch::Infrastructure::Request::Destination::Image, cors_setting_attribute_from_keyword(token->attribute(AttributeNames::crossorigin)));
+            }
+        } else if (tag_name.is_one_of(TagNames::style, TagNames::xmp, TagNames::iframe, TagNames::noembed, TagNames::noframes, TagNames::noscript)) {
+            tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+        } else if (tag_name.is_one_of(TagNames::textarea, TagNames::title)) {
+            tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+        } else if (tag_name == TagNames::plaintext) {
+            break;
+        }
+    }
+}
+
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Runtime/VM.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
+#include <LibWeb/HTML/PreloadEntry.h>
+#include <LibWeb/HTML/Window.h>
+#include <LibWeb/SRI/SRI.h>
+
+namespace Web::HTML {
+
+JS_DEFINE_ALLOCATOR(PreloadEntry);
+
+JS::NonnullGCPtr<PreloadEntry> PreloadEntry::create(JS::VM& vm, String integrity_metadata)
+{
+    return vm.heap().allocate_without_realm<PreloadEntry>(move(integrity_metadata));
+}
+
+PreloadEntry::PreloadEntry(String integrity_metadata)
+    : m_integrity_metadata(move(integrity_metadata))
+{
+}
+
+void PreloadEntry::visit_edges(JS::Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_response);
+    visitor.visit(m_on_response_available);
+}
+
+// https://html.spec.whatwg.org/multipage/links.html#consume-a-preloaded-resource
+bool consume_a_preloaded_resource(Window& window, URL::URL const& url, Optional<Fetch::Infrastructure::Request::Destination> destination, Fetch::Infrastructure::Request::Mode mode, Fetch::Infrastructure::Request::CredentialsMode credentials_mode, StringView integrity_metadata, JS::NonnullGCPtr<PreloadEntry::OnResponseAvailable> on_response_available)
+{
+    // 1. Let key be a preload key whose URL is url, destination is destination, mode is mode, and credentials mode is
+    //    credentialsMode.
+    PreloadKey key { url, destination, mode, credentials_mode };
+
+    // 2. Let preloads be window's associated Document's map of preloaded resources.
+    auto& preloads = window.associated_document().map_of_preloaded_resources();
+
+    // 3. If key does not exist in preloads, then return false.
+    auto it = preloads.find(key);
+    if (it == preloads.end())
+        return false;
+
+    // 4. Let entry be preloads[key].
+    auto entry = it->value;
+
+    // 5. Let consumerIntegrityMetadata be the result of parsing integrityMetadata.
+    auto consumer_integrity_metadata = SRI::parse_metadata(integrity_metadata);
+
+    // 6. Let preloadIntegrityMetadata be the result of parsing entry's integrity metadata.
+    auto preload_integrity_metadata = SRI::parse_metadata(entry->integrity_metadata());
+    if (consumer_integrity_metadata.is_error() || preload_integrity_metadata.is_error())
+        return false;
+
+    // 7. If none of the following conditions apply:
+    //    - consumerIntegrityMetadata is no metadata;
+    //    - consumerIntegrityMetadata is equal to preloadIntegrityMetadata,
+    //    then return false.
+    if (!consumer_integrity_metadata.value().is_empty() && consumer_integrity_metadata.value() != preload_integrity_metadata.value())
+        return false;
+
+    // 8. Remove preloads[key].
+    preloads.remove(it);
+
+    // 9. If entry's response is null, then set entry's on response available to onResponseAvailable.
+    if (!entry->response())
+        entry->set_on_response_available(on_response_available);
+    // 10. Otherwise, call onResponseAvailable with entry's response.
+    else
+        on_response_available->function()(*entry->response());
+
+    // 11. Return true.
+    return true;
+}
+
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashFunctions.h>
+#include <AK/String.h>
+#include <AK/Traits.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibJS/Heap/GCPtr.h>
+#include <LibJS/Heap/HeapFunction.h>
+#include <LibURL/URL.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/links.html#preload-key
+struct PreloadKey {
+    URL::URL url;
+    Optional<Fetch::Infrastructure::Request::Destination> destination;
+    Fetch::Infrastructure::Request::Mode mode;
+    Fetch::Infrastructure::Request::CredentialsMode credentials_mode;
+
+    bool operator==(PreloadKey const&) const = default;
+};
+
+// https://html.spec.whatwg.org/multipage/links.html#preload-entry
+class PreloadEntry final : public JS::Cell {
+    JS_CELL(PreloadEntry, JS::Cell);
+    JS_DECLARE_ALLOCATOR(PreloadEntry);
+
+public:
+    using OnResponseAvailable = JS::HeapFunction<void(JS::NonnullGCPtr<Fetch::Infrastructure::Response>)>;
+
+    [[nodiscard]] static JS::NonnullGCPtr<PreloadEntry> create(JS::VM&, String integrity_metadata);
+
+    String const& integrity_metadata() const { return m_integrity_metadata; }
+
+    JS::GCPtr<Fetch::Infrastructure::Response> response() const { return m_response; }
+    void set_response(JS::NonnullGCPtr<Fetch::Infrastructure::Response> response) { m_response = response; }
+
+    JS::GCPtr<OnResponseAvailable> on_response_available() const { return m_on_response_available; }
+    void set_on_response_available(JS::NonnullGCPtr<OnResponseAvailable> on_response_available) { m_on_response_available = on_response_available; }
+
+private:
+    explicit PreloadEntry(String integrity_metadata);
+
+    virtual void visit_edges(JS::Cell::Visitor&) override;
+
+    // https://html.spec.whatwg.org/multipage/links.html#preload-integrity-metadata
+    String m_integrity_metadata;
+
+    // https://html.spec.whatwg.org/multipage/links.html#preload-response
+    JS::GCPtr<Fetch::Infrastructure::Response> m_response;
+
+    // https://html.spec.whatwg.org/multipage/links.html#preload-on-response-available
+    JS::GCPtr<OnResponseAvailable> m_on_response_available;
+};
+
+bool consume_a_preloaded_resource(Window&, URL::URL const&, Optional<Fetch::Infrastructure::Request::Destination>, Fetch::Infrastructure::Request::Mode, Fetch::Infrastructure::Request::CredentialsMode, StringView integrity_metadata, JS::NonnullGCPtr<PreloadEntry::OnResponseAvailable>);
+
+}
+
+template<>
+struct AK::Traits<Web::HTML::PreloadKey> : public AK::DefaultTraits<Web::HTML::PreloadKey> {
+    static unsigned hash(Web::HTML::PreloadKey const& key)
+    {
+        auto hash = Traits<URL::URL>::hash(key.url);
+        hash = pair_int_hash(hash, key.destination.has_value() ? to_underlying(*key.destination) + 1 : 0);
+        hash = pair_int_hash(hash, to_underlying(key.mode));
+        return pair_int_hash(hash, to_underlying(key.credentials_mode));
+    }
+};
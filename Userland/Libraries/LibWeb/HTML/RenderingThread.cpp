@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibWeb/HTML/RenderingThread.h>
+
+namespace Web::HTML {
+
+RenderingThread::RenderingThread()
+    : m_main_thread_event_loop(Core::EventLoop::current())
+{
+    m_thread = Threading::Thread::construct([this] {
+        rendering_thread_loop();
+        return static_cast<intptr_t>(0);
+    },
+        "Rendering"sv);
+    m_thread->start();
+}
+
+RenderingThread::~RenderingThread()
+{
+    {
+        Threading::MutexLocker const locker(m_mutex);
+        m_exit = true;
+        m_task_ready.signal();
+    }
+    (void)m_thread->join();
+}
+
+void RenderingThread::enqueue_rendering_task(NonnullRefPtr<Painting::DisplayList> display_list, Function<void(Painting::DisplayList&)>&& render, Function<void()>&& callback)
+{
+    Threading::MutexLocker const locker(m_mutex);
+    m_tasks.enqueue({ move(display_list), move(render), move(callback) });
+    m_task_ready.signal();
+}
+
+void RenderingThread::wait_until_idle()
+{
+    Threading::MutexLocker const locker(m_mutex);
+    m_idle.wait_while([this] { return m_is_rendering || !m_tasks.is_empty(); });
+}
+
+void RenderingThread::rendering_thread_loop()
+{
+    while (true) {
+        Optional<Task> task;
+        {
+            Threading::MutexLocker const locker(m_mutex);
+            m_is_rendering = false;
+            m_idle.broadcast();
+            m_task_ready.wait_while([this] { return m_tasks.is_empty() && !m_exit; });
+            if (m_exit)
+                break;
+            m_is_rendering = true;
+            task = m_tasks.dequeue();
+        }
+
+        task->render(*task->display_list);
+
+        // NOTE: The display list holds on to fonts, bitmaps, etc. whose reference counts aren't atomic, so we hand it
+        //       back to the main thread to be released there.
+        m_main_thread_event_loop.deferred_invoke([display_list = move(task->display_list), callback = move(task->callback)] {
+            if (callback)
+                callback();
+        });
+        m_main_thread_event_loop.wake();
+    }
+}
+
+}
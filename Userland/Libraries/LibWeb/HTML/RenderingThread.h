@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/Queue.h>
+#include <LibCore/Forward.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+#include <LibWeb/Painting/DisplayList.h>
+
+namespace Web::HTML {
+
+// Plays back display lists on a separate thread, so the main thread can go on running script and layout while a
+// frame is being rasterized.
+class RenderingThread {
+    AK_MAKE_NONCOPYABLE(RenderingThread);
+    AK_MAKE_NONMOVABLE(RenderingThread);
+
+public:
+    RenderingThread();
+    ~RenderingThread();
+
+    // NOTE: The display list must not be shared with anything that may change while it's being rendered, see
+    //       DisplayList::snapshot_for_playback(). Once rendering is done, the display list is released and the
+    //       callback is invoked on the thread that enqueued the task.
+    void enqueue_rendering_task(NonnullRefPtr<Painting::DisplayList>, Function<void(Painting::DisplayList&)>&& render, Function<void()>&& callback);
+
+    // Blocks until all enqueued display lists have been rendered. Their callbacks may still be pending at that point.
+    void wait_until_idle();
+
+private:
+    void rendering_thread_loop();
+
+    struct Task {
+        NonnullRefPtr<Painting::DisplayList> display_list;
+        Function<void(Painting::DisplayList&)> render;
+        Function<void()> callback;
+    };
+
+    Core::EventLoop& m_main_thread_event_loop;
+    RefPtr<Threading::Thread> m_thread;
+
+    Threading::Mutex m_mutex;
+    Threading::ConditionVariable m_task_ready { m_mutex };
+    Threading::ConditionVariable m_idle { m_mutex };
+    Queue<Task> m_tasks;
+    bool m_is_rendering { false };
+    bool m_exit { false };
+};
+
+}
@@ -6,6 +6,7 @@
 
 #include <AK/Debug.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibCore/Tracing.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/HTML/Scripting/ClassicScript.h>
@@ -95,6 +96,7 @@ JS::Completion ClassicScript::run(RethrowErrors rethrow_errors, JS::GCPtr<JS::En
         evaluation_status = JS::Completion { JS::Completion::Type::Throw, error_to_rethrow() };
     } else {
         auto timer = Core::ElapsedTimer::start_new();
+        Core::Tracing::ScopedEvent trace_event { Core::Tracing::Category::JavaScript, "ClassicScript::run"sv };
 
         // 6. Otherwise, set evaluationStatus to ScriptEvaluation(script's record).
         evaluation_status = vm().bytecode_interpreter().run(*m_script_record, lexical_environment_override);
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/Tracing.h>
 #include <LibJS/Runtime/ModuleRequest.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/Fetching.h>
@@ -133,6 +134,8 @@ JS::Promise* JavaScriptModuleScript::run(PreventErrorReporting)
     // 3. Prepare to run script given settings.
     settings.prepare_to_run_script();
 
+    Core::Tracing::ScopedEvent trace_event { Core::Tracing::Category::JavaScript, "JavaScriptModuleScript::run"sv };
+
     // 4. Let evaluationPromise be null.
     JS::Promise* evaluation_promise = nullptr;
 
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Checked.h>
+#include <AK/ScopeGuard.h>
+#include <LibCore/System.h>
+#include <LibGfx/Bitmap.h>
+#include <LibWeb/HTML/SharedCanvasFrame.h>
+
+namespace Web::HTML {
+
+// The pixels follow a header holding the sequence number, which is odd while a frame is being written and zero until
+// the first one was.
+static constexpr size_t header_size = 16;
+static_assert(sizeof(Atomic<u32>) == sizeof(u32));
+
+static ErrorOr<size_t> buffer_size_for(Gfx::IntSize size)
+{
+    if (size.is_empty())
+        return Error::from_string_literal("Invalid size for a shared canvas frame");
+
+    Checked<size_t> buffer_size = size.width();
+    buffer_size *= size.height();
+    buffer_size *= sizeof(Gfx::ARGB32);
+    buffer_size += header_size;
+    if (buffer_size.has_overflow())
+        return Error::from_string_literal("Invalid size for a shared canvas frame");
+    return buffer_size.value();
+}
+
+ErrorOr<NonnullRefPtr<SharedCanvasFrame>> SharedCanvasFrame::create(Gfx::IntSize size)
+{
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(TRY(buffer_size_for(size))));
+    return adopt_nonnull_ref_or_enomem(new (nothrow) SharedCanvasFrame(move(buffer), size));
+}
+
+ErrorOr<NonnullRefPtr<SharedCanvasFrame>> SharedCanvasFrame::create_from_fd(int fd, Gfx::IntSize size)
+{
+    ArmedScopeGuard close_fd_on_error { [&] { (void)Core::System::close(fd); } };
+    auto buffer_size = TRY(buffer_size_for(size));
+
+    // NOTE: Touching memory past the end of the file would crash us, so don't take the other end's word for its size.
+    auto stat = TRY(Core::System::fstat(fd));
+    if (stat.st_size < 0 || static_cast<size_t>(stat.st_size) < buffer_size)
+        return Error::from_string_literal("Shared canvas frame is smaller than its size says");
+
+    auto buffer = TRY(Core::AnonymousBuffer::create_from_anon_fd(fd, buffer_size));
+    close_fd_on_error.disarm();
+    return adopt_nonnull_ref_or_enomem(new (nothrow) SharedCanvasFrame(move(buffer), size));
+}
+
+SharedCanvasFrame::SharedCanvasFrame(Core::AnonymousBuffer buffer, Gfx::IntSize size)
+    : m_buffer(move(buffer))
+    , m_size(size)
+{
+}
+
+Atomic<u32>& SharedCanvasFrame::sequence() const
+{
+    return *reinterpret_cast<Atomic<u32>*>(const_cast<u8*>(m_buffer.data<u8>()));
+}
+
+u8* SharedCanvasFrame::pixels()
+{
+    return m_buffer.data<u8>() + header_size;
+}
+
+u8 const* SharedCanvasFrame::pixels() const
+{
+    return m_buffer.data<u8>() + header_size;
+}
+
+void SharedCanvasFrame::write(Gfx::Bitmap const& bitmap)
+{
+    VERIFY(bitmap.format() == Gfx::BitmapFormat::BGRA8888);
+    VERIFY(bitmap.alpha_type() == Gfx::AlphaType::Premultiplied);
+
+    auto& sequence = this->sequence();
+    auto start = sequence.load(AK::MemoryOrder::memory_order_relaxed) + 1;
+    sequence.store(start, AK::MemoryOrder::memory_order_relaxed);
+    AK::atomic_thread_fence(AK::MemoryOrder::memory_order_release);
+
+    auto pitch = m_size.width() * sizeof(Gfx::ARGB32);
+    auto copied_width = min(bitmap.width(), m_size.width()) * sizeof(Gfx::ARGB32);
+    auto copied_height = min(bitmap.height(), m_size.height());
+    for (int y = 0; y < m_size.height(); ++y) {
+        auto* row = pixels() + y * pitch;
+        if (y < copied_height) {
+            memcpy(row, bitmap.scanline(y), copied_width);
+            memset(row + copied_width, 0, pitch - copied_width);
+        } else {
+            memset(row, 0, pitch);
+        }
+    }
+
+    sequence.store(start + 1, AK::MemoryOrder::memory_order_release);
+}
+
+RefPtr<Gfx::Bitmap> SharedCanvasFrame::read() const
+{
+    auto& sequence = this->sequence();
+    auto start = sequence.load(AK::MemoryOrder::memory_order_acquire);
+    if (start == 0 || (start & 1) != 0)
+        return nullptr;
+
+    auto bitmap_or_error = Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, m_size);
+    if (bitmap_or_error.is_error())
+        return nullptr;
+    auto bitmap = bitmap_or_error.release_value();
+
+    auto pitch = m_size.width() * sizeof(Gfx::ARGB32);
+    for (int y = 0; y < m_size.height(); ++y)
+        memcpy(bitmap->scanline(y), pixels() + y * pitch, pitch);
+
+    AK::atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
+    if (sequence.load(AK::MemoryOrder::memory_order_relaxed) != start)
+        return nullptr;
+    return bitmap;
+}
+
+}
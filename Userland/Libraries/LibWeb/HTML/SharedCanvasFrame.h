@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/RefCounted.h>
+#include <LibCore/AnonymousBuffer.h>
+#include <LibGfx/Forward.h>
+#include <LibGfx/Size.h>
+
+namespace Web::HTML {
+
+// The frames an OffscreenCanvas commits to its placeholder canvas element, in memory that both of them can see, so
+// that the OffscreenCanvas can be drawn to from a worker in another process.
+// Frames are copied in with a sequence number around them, so that the placeholder can tell when it read a frame
+// while the next one was being written, and simply keep showing the one it has until it is told about the next.
+class SharedCanvasFrame final : public RefCounted<SharedCanvasFrame> {
+public:
+    static ErrorOr<NonnullRefPtr<SharedCanvasFrame>> create(Gfx::IntSize);
+
+    // For the other end, given the file descriptor of a frame made by create(). Takes ownership of the file descriptor.
+    static ErrorOr<NonnullRefPtr<SharedCanvasFrame>> create_from_fd(int fd, Gfx::IntSize);
+
+    Gfx::IntSize size() const { return m_size; }
+    int fd() const { return m_buffer.fd(); }
+
+    // Copies the bitmap in as the new frame. The parts that don't fit into the frame are left out.
+    void write(Gfx::Bitmap const&);
+
+    // Returns a copy of the last frame that was written, or null if no frame was written yet or if one was being
+    // written at the same time.
+    RefPtr<Gfx::Bitmap> read() const;
+
+private:
+    SharedCanvasFrame(Core::AnonymousBuffer, Gfx::IntSize);
+
+    Atomic<u32>& sequence() const;
+    u8* pixels();
+    u8 const* pixels() const;
+
+    Core::AnonymousBuffer m_buffer;
+    Gfx::IntSize m_size;
+};
+
+}
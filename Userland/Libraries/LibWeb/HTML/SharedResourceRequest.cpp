@@ -9,6 +9,7 @@
 #include <LibWeb/Fetch/Fetching/Fetching.h>
 #include <LibWeb/Fetch/Infrastructure/FetchAlgorithms.h>
 #include <LibWeb/Fetch/Infrastructure/FetchController.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Statuses.h>
 #include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
@@ -22,6 +23,18 @@ namespace Web::HTML {
 
 JS_DEFINE_ALLOCATOR(SharedResourceRequest);
 
+// While a progressively decodable image is loading, decode what we have at most this often, and only once enough new
+// data has arrived to make a visible difference.
+static constexpr auto partial_decode_interval = AK::Duration::from_milliseconds(250);
+static constexpr size_t partial_decode_min_new_bytes = 16 * KiB;
+
+// FIXME: Decode interlaced PNGs (and maybe others) progressively too. For now, only JPEG's decoder makes an image out
+//        of truncated data.
+static bool is_progressively_decodable(StringView mime_type)
+{
+    return mime_type == "image/jpeg"sv || mime_type == "image/pjpeg"sv;
+}
+
 JS::NonnullGCPtr<SharedResourceRequest> SharedResourceRequest::get_or_create(JS::Realm& realm, JS::NonnullGCPtr<Page> page, URL::URL const& url)
 {
     auto document = Bindings::host_defined_environment_settings_object(realm).responsible_document();
@@ -60,6 +73,7 @@ void SharedResourceRequest::visit_edges(JS::Cell::Visitor& visitor)
         visitor.visit(callback.on_finish);
         visitor.visit(callback.on_fail);
     }
+    visitor.visit(m_progress_callbacks);
     visitor.visit(m_image_data);
 }
 
@@ -101,11 +115,28 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, JS::NonnullGCPtr<Fe
             return;
         }
 
+        auto extracted_mime_type = response->header_list()->extract_mime_type();
+        if (extracted_mime_type.has_value() && is_progressively_decodable(extracted_mime_type->essence().bytes_as_string_view())) {
+            auto process_body_chunk = JS::create_heap_function(heap(), [this](ByteBuffer chunk) {
+                handle_body_chunk(move(chunk));
+            });
+            auto process_end_of_body = JS::create_heap_function(heap(), [this, request, mime_type = extracted_mime_type->essence()] {
+                handle_successful_fetch(request->url(), mime_type.bytes_as_string_view(), move(m_received_data));
+            });
+            response->body()->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, JS::NonnullGCPtr { realm.global_object() });
+            return;
+        }
+
         response->body()->fully_read(realm, process_body, process_body_error, JS::NonnullGCPtr { realm.global_object() });
     };
 
     m_state = State::Fetching;
 
+    // Images that were important enough to fetch first (e.g. because they're in view) are decoded first, too.
+    auto const& internal_priority = request->internal_priority();
+    m_decode_with_high_priority = request->priority() == Fetch::Infrastructure::Request::Priority::High
+        || (internal_priority.has_value() && internal_priority->priority <= RequestServer::RequestPriority::High);
+
     auto fetch_controller = Fetch::Fetching::fetch(
         realm,
         request,
@@ -115,8 +146,18 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, JS::NonnullGCPtr<Fe
     set_fetch_controller(fetch_controller);
 }
 
-void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail)
+void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Optional<Gfx::IntSize> display_size_hint)
 {
+    if (m_state == State::New || m_state == State::Fetching) {
+        if (!display_size_hint.has_value() || display_size_hint->is_empty()) {
+            m_needs_full_size = true;
+        } else if (!m_display_size_hint.has_value()) {
+            m_display_size_hint = display_size_hint;
+        } else {
+            m_display_size_hint = Gfx::IntSize { max(m_display_size_hint->width(), display_size_hint->width()), max(m_display_size_hint->height(), display_size_hint->height()) };
+        }
+    }
+
     if (m_state == State::Finished) {
         if (on_finish)
             on_finish();
@@ -138,6 +179,83 @@ void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<v
     m_callbacks.append(move(callbacks));
 }
 
+void SharedResourceRequest::add_progress_callback(Function<void()> on_progress)
+{
+    if (m_state == State::Finished || m_state == State::Failed || !on_progress)
+        return;
+    m_progress_callbacks.append(JS::create_heap_function(vm().heap(), move(on_progress)));
+}
+
+void SharedResourceRequest::handle_body_chunk(ByteBuffer chunk)
+{
+    if (m_received_data.try_append(chunk).is_error()) {
+        handle_failed_fetch();
+        return;
+    }
+    decode_partial_image_if_needed();
+}
+
+void SharedResourceRequest::decode_partial_image_if_needed()
+{
+    if (m_partial_decode_in_flight || m_progress_callbacks.is_empty())
+        return;
+    if (m_received_data.size() < m_partially_decoded_size + partial_decode_min_new_bytes)
+        return;
+    auto now = MonotonicTime::now_coarse();
+    if (now - m_last_partial_decode_time < partial_decode_interval)
+        return;
+
+    m_partial_decode_in_flight = true;
+    m_partially_decoded_size = m_received_data.size();
+    m_last_partial_decode_time = now;
+
+    Optional<Gfx::IntSize> ideal_size;
+    if (!m_needs_full_size)
+        ideal_size = m_display_size_hint;
+
+    auto handle_successful_decode = [strong_this = JS::Handle(*this)](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
+        strong_this->m_partial_decode_in_flight = false;
+
+        // The whole image may have been decoded in the meantime.
+        if (strong_this->m_state != State::Fetching || result.is_animated || result.frames.is_empty() || !result.frames.first().bitmap)
+            return {};
+
+        strong_this->m_image_data = strong_this->create_image_data(result, {});
+        for (auto& callback : strong_this->m_progress_callbacks)
+            callback->function()();
+        return {};
+    };
+
+    auto handle_failed_decode = [strong_this = JS::Handle(*this)](Error&) -> void {
+        // Not enough of the image may have arrived yet to decode anything, so just wait for more.
+        strong_this->m_partial_decode_in_flight = false;
+    };
+
+    (void)Web::Platform::ImageCodecPlugin::the().decode_image(m_received_data.bytes(), move(handle_successful_decode), move(handle_failed_decode), ideal_size, m_decode_with_high_priority);
+}
+
+JS::NonnullGCPtr<DecodedImageData> SharedResourceRequest::create_image_data(Platform::DecodedImage& result, ByteBuffer encoded_data)
+{
+    Vector<AnimatedBitmapDecodedImageData::Frame> frames;
+    for (auto& frame : result.frames) {
+        frames.append(AnimatedBitmapDecodedImageData::Frame {
+            .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap),
+            .duration = static_cast<int>(frame.duration),
+        });
+    }
+
+    auto is_downscaled = !result.is_animated && frames.size() == 1
+        && (frames.first().bitmap->width() < result.natural_size.width() || frames.first().bitmap->height() < result.natural_size.height());
+
+    if (result.is_animated && result.frame_count > frames.size())
+        return AnimatedBitmapDecodedImageData::create_streamed(m_document->realm(), move(frames), result.frame_count, result.image_id, result.loop_count).release_value_but_fixme_should_propagate_errors();
+
+    // Still images keep their encoded data, so that their bitmap can be let go of while they're out of view.
+    if (!result.is_animated && frames.size() == 1 && (is_downscaled || !encoded_data.is_empty()))
+        return AnimatedBitmapDecodedImageData::create_discardable(m_document->realm(), move(frames.first()), result.natural_size, move(encoded_data), *m_document).release_value_but_fixme_should_propagate_errors();
+    return AnimatedBitmapDecodedImageData::create(m_document->realm(), move(frames), result.loop_count, result.is_animated).release_value_but_fixme_should_propagate_errors();
+}
+
 void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string, StringView mime_type, ByteBuffer data)
 {
     // AD-HOC: At this point, things gets very ad-hoc.
@@ -157,28 +275,32 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
     }
 
     auto handle_successful_bitmap_decode = [strong_this = JS::Handle(*this)](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
-        Vector<AnimatedBitmapDecodedImageData::Frame> frames;
-        for (auto& frame : result.frames) {
-            frames.append(AnimatedBitmapDecodedImageData::Frame {
-                .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap),
-                .duration = static_cast<int>(frame.duration),
-            });
-        }
-        strong_this->m_image_data = AnimatedBitmapDecodedImageData::create(strong_this->m_document->realm(), move(frames), result.loop_count, result.is_animated).release_value_but_fixme_should_propagate_errors();
+        strong_this->m_image_data = strong_this->create_image_data(result, move(strong_this->m_encoded_data));
         strong_this->handle_successful_resource_load();
         return {};
     };
 
     auto handle_failed_decode = [strong_this = JS::Handle(*this)](Error&) -> void {
+        strong_this->m_encoded_data.clear();
         strong_this->handle_failed_fetch();
     };
 
-    (void)Web::Platform::ImageCodecPlugin::the().decode_image(data.bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode));
+    // Keep the encoded data around, so the image can be decoded again if it's later shown larger than it was decoded
+    // at, or if its bitmap is discarded while it's out of view.
+    Optional<Gfx::IntSize> ideal_size;
+    if (!m_needs_full_size)
+        ideal_size = m_display_size_hint;
+    m_encoded_data = move(data);
+
+    (void)Web::Platform::ImageCodecPlugin::the().decode_image(m_encoded_data.bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode), ideal_size, m_decode_with_high_priority);
 }
 
 void SharedResourceRequest::handle_failed_fetch()
 {
     m_state = State::Failed;
+    m_image_data = nullptr;
+    m_received_data.clear();
+    m_progress_callbacks.clear();
     for (auto& callback : m_callbacks) {
         if (callback.on_fail)
             callback.on_fail->function()();
@@ -189,6 +311,7 @@ void SharedResourceRequest::handle_failed_fetch()
 void SharedResourceRequest::handle_successful_resource_load()
 {
     m_state = State::Finished;
+    m_progress_callbacks.clear();
     for (auto& callback : m_callbacks) {
         if (callback.on_finish)
             callback.on_finish->function()();
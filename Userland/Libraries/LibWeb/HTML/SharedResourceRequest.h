@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/Error.h>
 #include <AK/OwnPtr.h>
+#include <AK/Time.h>
 #include <LibGfx/Size.h>
 #include <LibJS/Heap/Handle.h>
 #include <LibJS/Heap/HeapFunction.h>
@@ -35,7 +37,12 @@ public:
 
     void fetch_resource(JS::Realm&, JS::NonnullGCPtr<Fetch::Infrastructure::Request>);
 
-    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail);
+    // The display size hint is the size in device pixels the image will be shown at, if known. Unless a user asks for
+    // the image without one, it's decoded at the largest hinted size rather than its natural size, to save memory.
+    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Optional<Gfx::IntSize> display_size_hint = {});
+
+    // Called whenever a partially loaded image has been decoded, with image_data() holding what we have so far.
+    void add_progress_callback(Function<void()> on_progress);
 
     bool is_fetching() const;
     bool needs_fetching() const;
@@ -50,6 +57,10 @@ private:
     void handle_failed_fetch();
     void handle_successful_resource_load();
 
+    void handle_body_chunk(ByteBuffer);
+    void decode_partial_image_if_needed();
+    JS::NonnullGCPtr<DecodedImageData> create_image_data(Platform::DecodedImage&, ByteBuffer encoded_data);
+
     enum class State {
         New,
         Fetching,
@@ -66,11 +77,23 @@ private:
         JS::GCPtr<JS::HeapFunction<void()>> on_fail;
     };
     Vector<Callbacks> m_callbacks;
+    Vector<JS::NonnullGCPtr<JS::HeapFunction<void()>>> m_progress_callbacks;
 
     URL::URL m_url;
     JS::GCPtr<DecodedImageData> m_image_data;
     JS::GCPtr<Fetch::Infrastructure::FetchController> m_fetch_controller;
 
+    Optional<Gfx::IntSize> m_display_size_hint;
+    bool m_needs_full_size { false };
+    bool m_decode_with_high_priority { false };
+    ByteBuffer m_encoded_data;
+
+    // For images that can be shown before they've fully arrived, the data received so far.
+    ByteBuffer m_received_data;
+    size_t m_partially_decoded_size { 0 };
+    MonotonicTime m_last_partial_decode_time { MonotonicTime::now_coarse() };
+    bool m_partial_decode_in_flight { false };
+
     JS::GCPtr<DOM::Document> m_document;
 };
 
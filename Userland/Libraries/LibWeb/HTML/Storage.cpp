@@ -5,22 +5,41 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashTable.h>
 #include <AK/String.h>
+#include <LibWeb/Bindings/HostDefined.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/Bindings/StoragePrototype.h>
 #include <LibWeb/HTML/Storage.h>
+#include <LibWeb/Page/Page.h>
+#include <LibWeb/WebIDL/DOMException.h>
 
 namespace Web::HTML {
 
 JS_DEFINE_ALLOCATOR(Storage);
 
-JS::NonnullGCPtr<Storage> Storage::create(JS::Realm& realm)
+// The amount of data that scripts may keep in a storage, like other browsers do.
+static constexpr size_t storage_quota_in_bytes = 5 * MiB;
+
+static HashTable<Storage*>& shared_storages()
+{
+    static HashTable<Storage*> storages;
+    return storages;
+}
+
+static size_t size_in_bytes(StringView key, StringView value)
+{
+    return key.length() + value.length();
+}
+
+JS::NonnullGCPtr<Storage> Storage::create(JS::Realm& realm, Optional<String> storage_key)
 {
-    return realm.heap().allocate<Storage>(realm, realm);
+    return realm.heap().allocate<Storage>(realm, realm, move(storage_key));
 }
 
-Storage::Storage(JS::Realm& realm)
+Storage::Storage(JS::Realm& realm, Optional<String> storage_key)
     : Bindings::PlatformObject(realm)
+    , m_storage_key(move(storage_key))
 {
     m_legacy_platform_object_flags = LegacyPlatformObjectFlags {
         .supports_named_properties = true,
@@ -30,9 +49,23 @@ Storage::Storage(JS::Realm& realm)
         .named_property_setter_has_identifier = true,
         .named_property_deleter_has_identifier = true,
     };
+
+    if (!m_storage_key.has_value())
+        return;
+
+    m_page = Bindings::host_defined_page(realm);
+    m_map = m_page->client().page_did_request_local_storage_items(*m_storage_key);
+    for (auto const& it : m_map)
+        m_size_in_bytes += size_in_bytes(it.key, it.value);
+
+    shared_storages().set(this);
 }
 
-Storage::~Storage() = default;
+Storage::~Storage()
+{
+    if (m_storage_key.has_value())
+        shared_storages().remove(this);
+}
 
 void Storage::initialize(JS::Realm& realm)
 {
@@ -40,6 +73,12 @@ void Storage::initialize(JS::Realm& realm)
     WEB_SET_PROTOTYPE_FOR_INTERFACE(Storage);
 }
 
+void Storage::visit_edges(Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_page);
+}
+
 // https://html.spec.whatwg.org/multipage/webstorage.html#dom-storage-length
 size_t Storage::length() const
 {
@@ -95,10 +134,20 @@ WebIDL::ExceptionOr<void> Storage::set_item(String const& key, String const& val
         reorder = false;
     }
 
-    // FIXME: 4. If value cannot be stored, then throw a "QuotaExceededError" DOMException exception.
+    // 4. If value cannot be stored, then throw a "QuotaExceededError" DOMException exception.
+    auto new_size_in_bytes = m_size_in_bytes + size_in_bytes(key, value);
+    // NOTE: Reorder is only false if the key is in the map already, in which case the old value is the one replaced.
+    if (!reorder)
+        new_size_in_bytes -= size_in_bytes(key, old_value);
+    if (new_size_in_bytes > storage_quota_in_bytes)
+        return WebIDL::QuotaExceededError::create(realm(), "Storage quota exceeded"_fly_string);
 
     // 5. Set this's map[key] to value.
     m_map.set(key, value);
+    m_size_in_bytes = new_size_in_bytes;
+
+    if (m_storage_key.has_value())
+        m_page->client().page_did_set_local_storage_item(*m_storage_key, key, value);
 
     // 6. If reorder is true, then reorder this.
     if (reorder)
@@ -123,7 +172,12 @@ void Storage::remove_item(StringView key)
     auto old_value = it->value;
 
     // 3. Remove this's map[key].
+    auto removed_key = it->key;
     m_map.remove(it);
+    m_size_in_bytes -= size_in_bytes(key, old_value);
+
+    if (m_storage_key.has_value())
+        m_page->client().page_did_remove_local_storage_item(*m_storage_key, removed_key);
 
     // 4. Reorder this.
     reorder();
@@ -137,11 +191,40 @@ void Storage::clear()
 {
     // 1. Clear this's map.
     m_map.clear();
+    m_size_in_bytes = 0;
+
+    if (m_storage_key.has_value())
+        m_page->client().page_did_clear_local_storage(*m_storage_key);
 
     // 2. Broadcast this with null, null, and null.
     broadcast({}, {}, {});
 }
 
+void Storage::did_change_in_another_process(String const& storage_key, Optional<String> const& key, Optional<String> const& value)
+{
+    for (auto* storage : shared_storages()) {
+        if (storage->m_storage_key != storage_key)
+            continue;
+
+        // FIXME: Fire storage events at the documents of this process once broadcast() is implemented.
+        auto& map = storage->m_map;
+        if (!key.has_value()) {
+            map.clear();
+            storage->m_size_in_bytes = 0;
+            continue;
+        }
+
+        if (auto it = map.find(*key); it != map.end()) {
+            storage->m_size_in_bytes -= size_in_bytes(*key, it->value);
+            map.remove(it);
+        }
+        if (value.has_value()) {
+            map.set(*key, *value);
+            storage->m_size_in_bytes += size_in_bytes(*key, *value);
+        }
+    }
+}
+
 // https://html.spec.whatwg.org/multipage/webstorage.html#concept-storage-reorder
 void Storage::reorder()
 {
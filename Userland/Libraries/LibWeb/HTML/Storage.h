@@ -18,9 +18,14 @@ class Storage : public Bindings::PlatformObject {
     JS_DECLARE_ALLOCATOR(Storage);
 
 public:
-    [[nodiscard]] static JS::NonnullGCPtr<Storage> create(JS::Realm&);
+    // Storages with a storage key are shared with the other WebContent processes by way of the UI process, which also
+    // persists them. Their items are loaded when they are created, and kept in sync from then on.
+    [[nodiscard]] static JS::NonnullGCPtr<Storage> create(JS::Realm&, Optional<String> storage_key = {});
     ~Storage();
 
+    // Applies a change that was made to the storage with this storage key in another process.
+    static void did_change_in_another_process(String const& storage_key, Optional<String> const& key, Optional<String> const& value);
+
     size_t length() const;
     Optional<String> key(size_t index);
     Optional<String> get_item(StringView key) const;
@@ -33,9 +38,10 @@ public:
     void dump() const;
 
 private:
-    explicit Storage(JS::Realm&);
+    Storage(JS::Realm&, Optional<String> storage_key);
 
     virtual void initialize(JS::Realm&) override;
+    virtual void visit_edges(Cell::Visitor&) override;
 
     // ^PlatformObject
     virtual JS::Value named_item_value(FlyString const&) const override;
@@ -47,6 +53,12 @@ private:
     void broadcast(StringView key, StringView old_value, StringView new_value);
 
     OrderedHashMap<String, String> m_map;
+
+    // The number of bytes taken up by the keys and values in the map, which is held to the storage quota.
+    size_t m_size_in_bytes { 0 };
+
+    Optional<String> m_storage_key;
+    JS::GCPtr<Page> m_page;
 };
 
 }
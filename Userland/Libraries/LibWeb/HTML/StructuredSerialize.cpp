@@ -45,6 +45,7 @@
 #include <LibWeb/Geometry/DOMRect.h>
 #include <LibWeb/Geometry/DOMRectReadOnly.h>
 #include <LibWeb/HTML/MessagePort.h>
+#include <LibWeb/HTML/OffscreenCanvas.h>
 #include <LibWeb/HTML/StructuredSerialize.h>
 #include <LibWeb/WebIDL/ExceptionOr.h>
 
@@ -348,7 +349,7 @@ public:
         }
 
         // 25. Set memory[value] to serialized.
-        m_memory.set(make_handle(value), m_next_id++);
+        m_memory.set(make_handle(value), m_memory.size());
 
         // 26. If deep is true, then:
         if (deep) {
@@ -440,7 +441,6 @@ public:
 private:
     JS::VM& m_vm;
     SerializationMemory& m_memory; // JS value -> index
-    u32 m_next_id { 0 };
     SerializationRecord m_serialized;
     bool m_for_storage { false };
 };
@@ -639,8 +639,9 @@ WebIDL::ExceptionOr<void> serialize_viewed_array_buffer(JS::VM& vm, Vector<u32>&
     auto buffer_serialized = TRY(structured_serialize_internal(vm, JS::Value(buffer), for_storage, memory));
 
     // 4. Assert: bufferSerialized.[[Type]] is "ArrayBuffer", "ResizableArrayBuffer", "SharedArrayBuffer", or "GrowableSharedArrayBuffer".
-    // NOTE: We currently only implement this for ArrayBuffer
-    VERIFY(buffer_serialized[0] == ValueTag::ArrayBuffer);
+    // NOTE: We currently only implement this for ArrayBuffer. The buffer may also be a reference to one that was already
+    //       serialized, or one that is being transferred.
+    VERIFY(buffer_serialized[0] == ValueTag::ArrayBuffer || buffer_serialized[0] == ValueTag::ObjectReference);
 
     // 5. If value has a [[DataView]] internal slot, then set serialized to { [[Type]]: "ArrayBufferView", [[Constructor]]: "DataView",
     //    [[ArrayBufferSerialized]]: bufferSerialized, [[ByteLength]]: value.[[ByteLength]], [[ByteOffset]]: value.[[ByteOffset]] }.
@@ -1112,12 +1113,14 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
     for (auto const& transferable : transfer_list) {
 
         // 1. If transferable has neither an [[ArrayBufferData]] internal slot nor a [[Detached]] internal slot, then throw a "DataCloneError" DOMException.
-        // FIXME: Handle transferring ArrayBufferData objects
-        if (!is<Bindings::Transferable>(*transferable)) {
+        if (!is<JS::ArrayBuffer>(*transferable) && !is<Bindings::Transferable>(*transferable)) {
             return WebIDL::DataCloneError::create(*vm.current_realm(), "Cannot transfer type"_fly_string);
         }
 
-        // FIXME: 2. If transferable has an [[ArrayBufferData]] internal slot and IsSharedArrayBuffer(transferable) is true, then throw a "DataCloneError" DOMException.
+        // 2. If transferable has an [[ArrayBufferData]] internal slot and IsSharedArrayBuffer(transferable) is true, then throw a "DataCloneError" DOMException.
+        if (is<JS::ArrayBuffer>(*transferable) && static_cast<JS::ArrayBuffer const&>(*transferable).is_shared_array_buffer()) {
+            return WebIDL::DataCloneError::create(*vm.current_realm(), "Cannot transfer shared array buffer"_fly_string);
+        }
 
         // 3. If memory[transferable] exists, then throw a "DataCloneError" DOMException.
         auto transferable_value = JS::Value(transferable);
@@ -1126,7 +1129,8 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
         }
 
         // 4. Set memory[transferable] to { [[Type]]: an uninitialized value }.
-        memory.set(JS::make_handle(transferable_value), NumericLimits<u32>::max());
+        // IMPLEMENTATION DEFINED: The transferred values are the first ones in the deserialization memory, so they get the first indices.
+        memory.set(JS::make_handle(transferable_value), memory.size());
     }
 
     // 3. Let serialized be ? StructuredSerializeInternal(value, false, memory).
@@ -1138,7 +1142,10 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
 
     // 5. For each transferable of transferList:
     for (auto& transferable : transfer_list) {
-        // 1. FIXME: If transferable has an [[ArrayBufferData]] internal slot and IsDetachedBuffer(transferable) is true, then throw a "DataCloneError" DOMException.
+        // 1. If transferable has an [[ArrayBufferData]] internal slot and IsDetachedBuffer(transferable) is true, then throw a "DataCloneError" DOMException.
+        if (is<JS::ArrayBuffer>(*transferable) && static_cast<JS::ArrayBuffer const&>(*transferable).is_detached()) {
+            return WebIDL::DataCloneError::create(*vm.current_realm(), "Cannot transfer detached buffer"_fly_string);
+        }
 
         // 2. If transferable has a [[Detached]] internal slot and transferable.[[Detached]] is true, then throw a "DataCloneError" DOMException.
         if (is<Bindings::Transferable>(*transferable)) {
@@ -1152,8 +1159,40 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
         // IMPLEMENTATION DEFINED: We just create a data holder here, our memory holds indices into the SerializationRecord
         TransferDataHolder data_holder;
 
-        // FIXME 4. If transferable has an [[ArrayBufferData]] internal slot, then:
-        if (false) {
+        // 4. If transferable has an [[ArrayBufferData]] internal slot, then:
+        if (is<JS::ArrayBuffer>(*transferable)) {
+            auto& array_buffer = static_cast<JS::ArrayBuffer&>(*transferable);
+
+            // NOTE: DetachArrayBuffer() only fails if the buffer has a detach key, check for that before the data is moved out of it.
+            if (!array_buffer.detach_key().is_undefined())
+                return vm.throw_completion<JS::TypeError>(JS::ErrorType::DetachKeyMismatch, JS::js_undefined(), array_buffer.detach_key());
+
+            // 1. If transferable has an [[ArrayBufferMaxByteLength]] internal slot, then:
+            if (!array_buffer.is_fixed_length()) {
+                // 1. Set dataHolder.[[Type]] to "ResizableArrayBuffer".
+                data_holder.data.append(to_underlying(TransferType::ResizableArrayBuffer));
+
+                // 2. Set dataHolder.[[ArrayBufferData]] to transferable.[[ArrayBufferData]].
+                // 3. Set dataHolder.[[ArrayBufferByteLength]] to transferable.[[ArrayBufferByteLength]].
+                data_holder.array_buffer_data = move(array_buffer.buffer());
+
+                // 4. Set dataHolder.[[ArrayBufferMaxByteLength]] to transferable.[[ArrayBufferMaxByteLength]].
+                data_holder.array_buffer_max_byte_length = array_buffer.max_byte_length();
+            }
+            // 2. Otherwise:
+            else {
+                // 1. Set dataHolder.[[Type]] to "ArrayBuffer".
+                data_holder.data.append(to_underlying(TransferType::ArrayBuffer));
+
+                // 2. Set dataHolder.[[ArrayBufferData]] to transferable.[[ArrayBufferData]].
+                // 3. Set dataHolder.[[ArrayBufferByteLength]] to transferable.[[ArrayBufferByteLength]].
+                data_holder.array_buffer_data = move(array_buffer.buffer());
+            }
+
+            // 3. Perform ? DetachArrayBuffer(transferable).
+            // NOTE: Specifications can use the [[ArrayBufferDetachKey]] internal slot to prevent ArrayBuffers from being detached.
+            //       This is used in WebAssembly JavaScript Interface, for example. See: https://webassembly.github.io/spec/js-api/#create-a-memory-buffer
+            MUST(JS::detach_array_buffer(vm, array_buffer));
         }
 
         // 5. Otherwise:
@@ -1190,6 +1229,13 @@ static bool is_interface_exposed_on_target_realm(u8 name, JS::Realm& realm)
     case TransferType::MessagePort:
         return intrinsics.is_exposed("MessagePort"sv);
         break;
+    case TransferType::OffscreenCanvas:
+        return intrinsics.is_exposed("OffscreenCanvas"sv);
+        break;
+    case TransferType::ArrayBuffer:
+    case TransferType::ResizableArrayBuffer:
+        dbgln("ArrayBuffer is not a transferable interface");
+        break;
     default:
         dbgln("Unknown interface type for transfer: {}", name);
         break;
@@ -1205,6 +1251,14 @@ static WebIDL::ExceptionOr<JS::NonnullGCPtr<Bindings::PlatformObject>> create_tr
         TRY(message_port->transfer_receiving_steps(transfer_data_holder));
         return message_port;
     }
+    case TransferType::OffscreenCanvas: {
+        auto offscreen_canvas = HTML::OffscreenCanvas::create(target_realm, 0, 0);
+        TRY(offscreen_canvas->transfer_receiving_steps(transfer_data_holder));
+        return offscreen_canvas;
+    }
+    case TransferType::ArrayBuffer:
+    case TransferType::ResizableArrayBuffer:
+        break;
     }
     VERIFY_NOT_REACHED();
 }
@@ -1225,22 +1279,26 @@ WebIDL::ExceptionOr<DeserializedTransferRecord> structured_deserialize_with_tran
         // 1. Let value be an uninitialized value.
         JS::Value value;
 
-        // FIXME: 2. If transferDataHolder.[[Type]] is "ArrayBuffer", then set value to a new ArrayBuffer object in targetRealm
+        // 2. If transferDataHolder.[[Type]] is "ArrayBuffer", then set value to a new ArrayBuffer object in targetRealm
         //    whose [[ArrayBufferData]] internal slot value is transferDataHolder.[[ArrayBufferData]], and
         //    whose [[ArrayBufferByteLength]] internal slot value is transferDataHolder.[[ArrayBufferByteLength]].
         // NOTE: In cases where the original memory occupied by [[ArrayBufferData]] is accessible during the deserialization,
         //       this step is unlikely to throw an exception, as no new memory needs to be allocated: the memory occupied by
         //       [[ArrayBufferData]] is instead just getting transferred into the new ArrayBuffer. This could be true, for example,
         //       when both the source and target realms are in the same process.
-        if (false) {
+        if (transfer_data_holder.data.first() == to_underlying(TransferType::ArrayBuffer)) {
+            value = JS::ArrayBuffer::create(target_realm, move(transfer_data_holder.array_buffer_data));
         }
 
-        // FIXME: 3. Otherwise, if transferDataHolder.[[Type]] is "ResizableArrayBuffer", then set value to a new ArrayBuffer object
-        //     in targetRealm whose [[ArrayBufferData]] internal slot value is transferDataHolder.[[ArrayBufferData]], whose
-        //     [[ArrayBufferByteLength]] internal slot value is transferDataHolder.[[ArrayBufferByteLength]], and whose
-        //     [[ArrayBufferMaxByteLength]] internal slot value is transferDataHolder.[[ArrayBufferMaxByteLength]].
+        // 3. Otherwise, if transferDataHolder.[[Type]] is "ResizableArrayBuffer", then set value to a new ArrayBuffer object
+        //    in targetRealm whose [[ArrayBufferData]] internal slot value is transferDataHolder.[[ArrayBufferData]], whose
+        //    [[ArrayBufferByteLength]] internal slot value is transferDataHolder.[[ArrayBufferByteLength]], and whose
+        //    [[ArrayBufferMaxByteLength]] internal slot value is transferDataHolder.[[ArrayBufferMaxByteLength]].
         // NOTE: For the same reason as the previous step, this step is also unlikely to throw an exception.
-        else if (false) {
+        else if (transfer_data_holder.data.first() == to_underlying(TransferType::ResizableArrayBuffer)) {
+            auto array_buffer = JS::ArrayBuffer::create(target_realm, move(transfer_data_holder.array_buffer_data));
+            array_buffer->set_max_byte_length(transfer_data_holder.array_buffer_max_byte_length.value());
+            value = array_buffer;
         }
 
         // 4. Otherwise:
@@ -1334,6 +1392,8 @@ ErrorOr<void> encode(Encoder& encoder, ::Web::HTML::TransferDataHolder const& da
 {
     TRY(encoder.encode(data_holder.data));
     TRY(encoder.encode(data_holder.fds));
+    TRY(encoder.encode(data_holder.array_buffer_data));
+    TRY(encoder.encode(data_holder.array_buffer_max_byte_length));
     return {};
 }
 
@@ -1350,7 +1410,9 @@ ErrorOr<::Web::HTML::TransferDataHolder> decode(Decoder& decoder)
 {
     auto data = TRY(decoder.decode<Vector<u8>>());
     auto fds = TRY(decoder.decode<Vector<IPC::File>>());
-    return ::Web::HTML::TransferDataHolder { move(data), move(fds) };
+    auto array_buffer_data = TRY(decoder.decode<ByteBuffer>());
+    auto array_buffer_max_byte_length = TRY(decoder.decode<Optional<u64>>());
+    return ::Web::HTML::TransferDataHolder { move(data), move(fds), move(array_buffer_data), array_buffer_max_byte_length };
 }
 
 template<>
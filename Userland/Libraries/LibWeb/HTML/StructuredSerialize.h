@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/Result.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
@@ -29,6 +30,11 @@ using DeserializationMemory = JS::MarkedVector<JS::Value>;
 struct TransferDataHolder {
     Vector<u8> data;
     Vector<IPC::File> fds;
+
+    // The [[ArrayBufferData]] and [[ArrayBufferMaxByteLength]] of a transferred ArrayBuffer. The data is moved here
+    // from the source ArrayBuffer and on into the new one, so it is only ever copied when going through IPC.
+    ByteBuffer array_buffer_data;
+    Optional<u64> array_buffer_max_byte_length;
 };
 
 struct SerializedTransferRecord {
@@ -48,6 +54,9 @@ struct DeserializedRecord {
 
 enum class TransferType : u8 {
     MessagePort,
+    OffscreenCanvas,
+    ArrayBuffer,
+    ResizableArrayBuffer,
 };
 
 WebIDL::ExceptionOr<SerializationRecord> structured_serialize(JS::VM& vm, JS::Value);
@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/NeverDestroyed.h>
 #include <LibCore/Timer.h>
 #include <LibJS/Runtime/Object.h>
+#include <LibWeb/DOM/Document.h>
 #include <LibWeb/HTML/Timer.h>
 #include <LibWeb/HTML/Window.h>
 
@@ -13,6 +15,13 @@ namespace Web::HTML {
 
 JS_DEFINE_ALLOCATOR(Timer);
 
+// A timer may fire up to this fraction of its timeout late, capped below, so that nearby timers can be batched.
+static constexpr i32 slack_divisor = 16;
+static constexpr auto max_slack = AK::Duration::from_milliseconds(16);
+
+// Timers in hidden documents only fire on whole multiples of this interval.
+static constexpr auto hidden_document_alignment = AK::Duration::from_seconds(1);
+
 JS::NonnullGCPtr<Timer> Timer::create(JS::Object& window_or_worker_global_scope, i32 milliseconds, Function<void()> callback, i32 id)
 {
     auto heap_function_callback = JS::create_heap_function(window_or_worker_global_scope.heap(), move(callback));
@@ -22,11 +31,9 @@ JS::NonnullGCPtr<Timer> Timer::create(JS::Object& window_or_worker_global_scope,
 Timer::Timer(JS::Object& window_or_worker_global_scope, i32 milliseconds, JS::NonnullGCPtr<JS::HeapFunction<void()>> callback, i32 id)
     : m_window_or_worker_global_scope(window_or_worker_global_scope)
     , m_callback(move(callback))
+    , m_milliseconds(milliseconds)
     , m_id(id)
 {
-    m_timer = Core::Timer::create_single_shot(milliseconds, [this] {
-        m_callback->function()();
-    });
 }
 
 void Timer::visit_edges(Cell::Visitor& visitor)
@@ -38,17 +45,121 @@ void Timer::visit_edges(Cell::Visitor& visitor)
 
 Timer::~Timer()
 {
-    VERIFY(!m_timer->is_active());
+    VERIFY(!m_active);
 }
 
 void Timer::start()
 {
-    m_timer->start();
+    if (m_active)
+        TimerScheduler::the().unschedule({}, *this);
+    m_deadline = MonotonicTime::now() + AK::Duration::from_milliseconds(m_milliseconds);
+    m_active = true;
+    TimerScheduler::the().schedule({}, *this);
 }
 
 void Timer::stop()
 {
-    m_timer->stop();
+    if (!m_active)
+        return;
+    m_active = false;
+    TimerScheduler::the().unschedule({}, *this);
+}
+
+bool Timer::is_in_hidden_document() const
+{
+    if (!is<Window>(*m_window_or_worker_global_scope))
+        return false;
+    return static_cast<Window const&>(*m_window_or_worker_global_scope).associated_document().hidden();
+}
+
+MonotonicTime Timer::latest_fire_time() const
+{
+    if (is_in_hidden_document()) {
+        auto alignment = hidden_document_alignment.to_nanoseconds();
+        auto remainder = m_deadline.nanoseconds() % alignment;
+        if (remainder == 0)
+            return m_deadline;
+        return m_deadline + AK::Duration::from_nanoseconds(alignment - remainder);
+    }
+
+    auto slack = min(AK::Duration::from_milliseconds(m_milliseconds / slack_divisor), max_slack);
+    return m_deadline + slack;
+}
+
+void Timer::fire(Badge<TimerScheduler>)
+{
+    VERIFY(m_active);
+    m_active = false;
+    m_callback->function()();
+}
+
+TimerScheduler& TimerScheduler::the()
+{
+    static NeverDestroyed<TimerScheduler> scheduler;
+    return *scheduler;
+}
+
+TimerScheduler::TimerScheduler()
+    : m_wakeup_timer(Core::Timer::create_single_shot(0, [this] { fire_due_timers(); }))
+{
+}
+
+void TimerScheduler::schedule(Badge<Timer>, Timer& timer)
+{
+    // Keep timers ordered by deadline, and timers with the same deadline in the order they were started.
+    size_t low = 0;
+    size_t high = m_timers.size();
+    while (low < high) {
+        auto middle = low + (high - low) / 2;
+        if (m_timers[middle]->deadline() <= timer.deadline())
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    m_timers.insert(low, &timer);
+    update_wakeup();
+}
+
+void TimerScheduler::unschedule(Badge<Timer>, Timer& timer)
+{
+    m_timers.remove_first_matching([&](auto* it) { return it == &timer; });
+    update_wakeup();
+}
+
+void TimerScheduler::update_wakeup()
+{
+    if (m_timers.is_empty()) {
+        m_wakeup_timer->stop();
+        return;
+    }
+
+    auto wakeup_time = m_timers.first()->latest_fire_time();
+    for (auto* timer : m_timers) {
+        // Timers are ordered by deadline, so nothing after this one could want to fire earlier.
+        if (timer->deadline() >= wakeup_time)
+            break;
+        wakeup_time = min(wakeup_time, timer->latest_fire_time());
+    }
+
+    // Round up, so that we never wake up just before the deadline and have to spin until it passes.
+    auto delay = max(wakeup_time - MonotonicTime::now(), AK::Duration::zero());
+    auto delay_ms = (delay.to_nanoseconds() + 999'999) / 1'000'000;
+    m_wakeup_timer->restart(static_cast<int>(delay_ms));
+}
+
+void TimerScheduler::fire_due_timers()
+{
+    auto now = MonotonicTime::now();
+
+    // Take every timer that is due first, since firing one may start or stop others.
+    Vector<Timer*> due_timers;
+    while (!m_timers.is_empty() && m_timers.first()->deadline() <= now)
+        due_timers.append(m_timers.take_first());
+
+    for (auto* timer : due_timers)
+        timer->fire({});
+
+    update_wakeup();
 }
 
 }
@@ -6,9 +6,11 @@
 
 #pragma once
 
+#include <AK/Badge.h>
 #include <AK/Forward.h>
 #include <AK/Function.h>
-#include <AK/WeakPtr.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
 #include <LibCore/Forward.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibJS/Heap/GCPtr.h>
@@ -17,6 +19,8 @@
 
 namespace Web::HTML {
 
+class TimerScheduler;
+
 class Timer final : public JS::Cell {
     JS_CELL(Timer, JS::Cell);
     JS_DECLARE_ALLOCATOR(Timer);
@@ -28,15 +32,47 @@ public:
     void start();
     void stop();
 
+    bool is_active() const { return m_active; }
+
+    // The timer must not fire before its deadline, but may fire any time up to its latest fire time. This lets
+    // timers that come due close together (and all timers in hidden documents) share a single wakeup.
+    MonotonicTime deadline() const { return m_deadline; }
+    MonotonicTime latest_fire_time() const;
+
+    void fire(Badge<TimerScheduler>);
+
 private:
     Timer(JS::Object& window, i32 milliseconds, JS::NonnullGCPtr<JS::HeapFunction<void()>> callback, i32 id);
 
     virtual void visit_edges(Cell::Visitor&) override;
 
-    RefPtr<Core::Timer> m_timer;
+    bool is_in_hidden_document() const;
+
     JS::NonnullGCPtr<JS::Object> m_window_or_worker_global_scope;
     JS::NonnullGCPtr<JS::HeapFunction<void()>> m_callback;
+    i32 m_milliseconds { 0 };
     i32 m_id { 0 };
+    bool m_active { false };
+    MonotonicTime m_deadline { MonotonicTime::now() };
+};
+
+// All HTML timers share a single platform timer. Active timers are kept ordered by deadline, and each wakeup fires
+// every timer whose deadline has passed by then.
+class TimerScheduler {
+public:
+    static TimerScheduler& the();
+
+    TimerScheduler();
+
+    void schedule(Badge<Timer>, Timer&);
+    void unschedule(Badge<Timer>, Timer&);
+
+private:
+    void fire_due_timers();
+    void update_wakeup();
+
+    Vector<Timer*> m_timers;
+    RefPtr<Core::Timer> m_wakeup_timer;
 };
 
 }
@@ -5,6 +5,7 @@
  */
 
 #include <AK/QuickSort.h>
+#include <LibCore/Tracing.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/HTML/BrowsingContextGroup.h>
@@ -1195,11 +1196,11 @@ JS::GCPtr<DOM::Node> TraversableNavigable::currently_focused_area()
     return candidate;
 }
 
-void TraversableNavigable::paint(DevicePixelRect const& content_rect, Painting::BackingStore& target, PaintOptions paint_options)
+RefPtr<Painting::DisplayList> TraversableNavigable::record_display_list(DevicePixelRect const& content_rect, PaintOptions paint_options)
 {
     auto document = active_document();
     if (!document)
-        return;
+        return {};
 
     for (auto& navigable : all_navigables()) {
         if (auto active_document = navigable->active_document(); active_document && active_document->paintable()) {
@@ -1212,39 +1213,53 @@ void TraversableNavigable::paint(DevicePixelRect const& content_rect, Painting::
     paint_config.should_show_line_box_borders = paint_options.should_show_line_box_borders;
     paint_config.has_focus = paint_options.has_focus;
     paint_config.canvas_fill_rect = Gfx::IntRect { {}, content_rect.size() };
-    auto display_list = document->record_display_list(paint_config);
-    if (!display_list) {
-        return;
-    }
+    return document->record_display_list(paint_config);
+}
 
-    switch (page().client().display_list_player_type()) {
+static NonnullRefPtr<Painting::DisplayList> optimized_snapshot_for_playback(Painting::DisplayList const& display_list, DevicePixelRect const& content_rect)
+{
+    auto snapshot = display_list.snapshot_for_playback();
+    auto statistics = snapshot->optimize({ {}, content_rect.size().to_type<int>() });
+    if (Painting::g_log_display_list_optimizations)
+        dbgln("Optimized display list from {} to {} commands", statistics.command_count_before, statistics.command_count_after);
+    return snapshot;
+}
+
+// NOTE: This runs on the rendering thread for frames started by start_display_list_rendering(), so it must not touch
+//       anything but the display list, the target and the GPU contexts.
+void TraversableNavigable::play_display_list(DisplayListPlayerType display_list_player_type, Painting::DisplayList& display_list, Painting::BackingStore& target, Optional<Gfx::IntRect> damage_rect)
+{
+    Core::Tracing::ScopedEvent trace_event { Core::Tracing::Category::Raster, "TraversableNavigable::play_display_list"sv };
+
+    switch (display_list_player_type) {
     case DisplayListPlayerType::SkiaGPUIfAvailable: {
 #ifdef AK_OS_MACOS
         if (m_metal_context && m_skia_backend_context && is<Painting::IOSurfaceBackingStore>(target)) {
             auto& iosurface_backing_store = static_cast<Painting::IOSurfaceBackingStore&>(target);
             auto texture = m_metal_context->create_texture_from_iosurface(iosurface_backing_store.iosurface_handle());
             Painting::DisplayListPlayerSkia player(*m_skia_backend_context, *texture);
-            player.execute(*display_list);
+            player.execute(display_list, damage_rect);
             return;
         }
 #endif
 
 #ifdef USE_VULKAN
         if (m_skia_backend_context) {
+            // NOTE: This player reads back its whole surface into the bitmap, so we can't skip undamaged areas here.
             Painting::DisplayListPlayerSkia player(*m_skia_backend_context, target.bitmap());
-            player.execute(*display_list);
+            player.execute(display_list);
             return;
         }
 #endif
 
         // Fallback to CPU backend if GPU is not available
         Painting::DisplayListPlayerSkia player(target.bitmap());
-        player.execute(*display_list);
+        player.execute(display_list, damage_rect);
         break;
     }
     case DisplayListPlayerType::SkiaCPU: {
         Painting::DisplayListPlayerSkia player(target.bitmap());
-        player.execute(*display_list);
+        player.execute(display_list, damage_rect);
         break;
     }
     default:
@@ -1252,4 +1267,46 @@ void TraversableNavigable::paint(DevicePixelRect const& content_rect, Painting::
     }
 }
 
+void TraversableNavigable::paint(DevicePixelRect const& content_rect, Painting::BackingStore& target, PaintOptions paint_options)
+{
+    auto display_list = record_display_list(content_rect, paint_options);
+    if (!display_list)
+        return;
+
+    // NOTE: The GPU contexts are shared with the rendering thread, so let it finish any frame it's working on first.
+    wait_for_display_list_rendering();
+
+    Optional<Gfx::IntRect> damage_rect;
+    if (paint_options.damage_rect.has_value())
+        damage_rect = paint_options.damage_rect->to_type<int>();
+    auto snapshot = optimized_snapshot_for_playback(*display_list, content_rect);
+    play_display_list(page().client().display_list_player_type(), *snapshot, target, damage_rect);
+}
+
+bool TraversableNavigable::start_display_list_rendering(DevicePixelRect const& content_rect, Painting::BackingStore& target, PaintOptions paint_options, Function<void()>&& on_complete)
+{
+    auto display_list = record_display_list(content_rect, paint_options);
+    if (!display_list)
+        return false;
+
+    Optional<Gfx::IntRect> damage_rect;
+    if (paint_options.damage_rect.has_value())
+        damage_rect = paint_options.damage_rect->to_type<int>();
+
+    if (!m_rendering_thread)
+        m_rendering_thread = make<RenderingThread>();
+    m_rendering_thread->enqueue_rendering_task(
+        optimized_snapshot_for_playback(*display_list, content_rect),
+        [this, display_list_player_type = page().client().display_list_player_type(), &target, damage_rect](Painting::DisplayList& display_list) {
+            play_display_list(display_list_player_type, display_list, target, damage_rect);
+        },
+        move(on_complete));
+    return true;
+}
+
+void TraversableNavigable::wait_for_display_list_rendering()
+{
+    if (m_rendering_thread)
+        m_rendering_thread->wait_until_idle();
+}
 }
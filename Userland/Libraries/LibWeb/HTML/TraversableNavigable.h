@@ -9,6 +9,7 @@
 #include <AK/Vector.h>
 #include <LibWeb/HTML/Navigable.h>
 #include <LibWeb/HTML/NavigationType.h>
+#include <LibWeb/HTML/RenderingThread.h>
 #include <LibWeb/HTML/SessionHistoryTraversalQueue.h>
 #include <LibWeb/HTML/VisibilityState.h>
 #include <LibWeb/Page/Page.h>
@@ -97,6 +98,11 @@ public:
 
     void paint(Web::DevicePixelRect const&, Painting::BackingStore&, Web::PaintOptions);
 
+    // Records a display list on this thread and plays it back into the target on the rendering thread. The target must
+    // stay alive until on_complete has been invoked. Returns false if there was nothing to paint.
+    bool start_display_list_rendering(Web::DevicePixelRect const&, Painting::BackingStore&, Web::PaintOptions, Function<void()>&& on_complete);
+    void wait_for_display_list_rendering();
+
 private:
     TraversableNavigable(JS::NonnullGCPtr<Page>);
 
@@ -116,6 +122,9 @@ private:
 
     [[nodiscard]] bool can_go_forward() const;
 
+    RefPtr<Painting::DisplayList> record_display_list(Web::DevicePixelRect const&, Web::PaintOptions);
+    void play_display_list(DisplayListPlayerType, Painting::DisplayList&, Painting::BackingStore&, Optional<Gfx::IntRect> damage_rect);
+
     // https://html.spec.whatwg.org/multipage/document-sequences.html#tn-current-session-history-step
     int m_current_session_history_step { 0 };
 
@@ -139,6 +148,10 @@ private:
 #ifdef AK_OS_MACOS
     OwnPtr<Core::MetalContext> m_metal_context;
 #endif
+
+    // NOTE: This is only started once the traversable renders a frame off the main thread, so that traversables which
+    //       never do (e.g. the ones of SVG images) don't each hold on to an idle thread.
+    OwnPtr<RenderingThread> m_rendering_thread;
 };
 
 struct BrowsingContextAndDocument {
@@ -65,6 +65,7 @@
 #include <LibWeb/Painting/PaintableBox.h>
 #include <LibWeb/RequestIdleCallback/IdleDeadline.h>
 #include <LibWeb/Selection/Selection.h>
+#include <LibWeb/StorageAPI/StorageKey.h>
 #include <LibWeb/WebIDL/AbstractOperations.h>
 
 namespace Web::HTML {
@@ -417,7 +418,11 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<Storage>> Window::local_storage()
     // FIXME: Implement according to spec.
     static HashMap<Origin, JS::Handle<Storage>> local_storage_per_origin;
     auto storage = local_storage_per_origin.ensure(associated_document().origin(), [this]() -> JS::Handle<Storage> {
-        return Storage::create(realm());
+        // NOTE: Storages of opaque origins can't be told apart by their storage key, so they are only kept in memory.
+        auto storage_key = StorageAPI::obtain_a_storage_key(relevant_settings_object(*this));
+        if (!storage_key.has_value())
+            return Storage::create(realm());
+        return Storage::create(realm(), MUST(String::from_byte_string(storage_key->origin.serialize())));
     });
     return JS::NonnullGCPtr { *storage };
 }
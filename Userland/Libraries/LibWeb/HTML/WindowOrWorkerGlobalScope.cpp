@@ -33,6 +33,8 @@
 #include <LibWeb/HighResolutionTime/Performance.h>
 #include <LibWeb/HighResolutionTime/SupportedPerformanceTypes.h>
 #include <LibWeb/IndexedDB/IDBFactory.h>
+#include <LibWeb/LongTasks/PerformanceLongTaskTiming.h>
+#include <LibWeb/PaintTiming/PerformancePaintTiming.h>
 #include <LibWeb/PerformanceTimeline/EntryTypes.h>
 #include <LibWeb/PerformanceTimeline/PerformanceObserver.h>
 #include <LibWeb/PerformanceTimeline/PerformanceObserverEntryList.h>
@@ -47,6 +49,8 @@
 
 namespace Web::HTML {
 
+static constexpr i32 hidden_document_minimum_timeout_ms = 1000;
+
 WindowOrWorkerGlobalScopeMixin::~WindowOrWorkerGlobalScopeMixin() = default;
 
 void WindowOrWorkerGlobalScopeMixin::initialize(JS::Realm&)
@@ -231,6 +235,7 @@ JS::NonnullGCPtr<JS::Promise> WindowOrWorkerGlobalScopeMixin::create_image_bitma
                     // If this is an animated image, imageBitmap's bitmap data must only be taken from the default image
                     // of the animation (the one that the format defines is to be used when animation is not supported
                     // or is disabled), or, if there is no such image, the first frame of the animation.
+                    Web::Platform::ImageCodecPlugin::the().discard_remaining_frames(result);
                     image_bitmap->set_bitmap(result.frames.take_first().bitmap);
 
                     // 5. Resolve p with imageBitmap.
@@ -684,6 +689,12 @@ void WindowOrWorkerGlobalScopeMixin::run_steps_after_a_timeout_impl(i32 timeout,
     if (!timer_key.has_value())
         timer_key = m_timer_id_allocator.allocate();
 
+    // NOTE: This is step 5.3 ("Optionally, wait a further implementation-defined length of time"), done up front.
+    //       Timers of documents that aren't visible wait at least a second, so that a page in a background tab doesn't
+    //       keep waking up the process, and its timers pick up their own pace again once the page is shown.
+    if (is<Window>(this_impl()) && static_cast<Window&>(this_impl()).associated_document().hidden())
+        timeout = max(timeout, hidden_document_minimum_timeout_ms);
+
     // FIXME: 3. Let startTime be the current high resolution time given global.
     auto timer = Timer::create(this_impl(), timeout, move(completion_step), timer_key.value());
 
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/Bindings/IDBDatabasePrototype.h>
+#include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/HTML/EventNames.h>
+#include <LibWeb/IndexedDB/IDBDatabase.h>
+#include <LibWeb/IndexedDB/Internal/Algorithms.h>
+
+namespace Web::IndexedDB {
+
+JS_DEFINE_ALLOCATOR(IDBDatabase);
+
+JS::NonnullGCPtr<IDBDatabase> IDBDatabase::create(JS::Realm& realm, Database& database)
+{
+    return realm.heap().allocate<IDBDatabase>(realm, realm, database);
+}
+
+IDBDatabase::IDBDatabase(JS::Realm& realm, Database& database)
+    : EventTarget(realm)
+    , m_associated_database(database)
+{
+    database.associate(*this);
+}
+
+IDBDatabase::~IDBDatabase() = default;
+
+void IDBDatabase::initialize(JS::Realm& realm)
+{
+    Base::initialize(realm);
+    WEB_SET_PROTOTYPE_FOR_INTERFACE(IDBDatabase);
+}
+
+void IDBDatabase::visit_edges(Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_associated_database);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-close
+void IDBDatabase::close()
+{
+    // The close() method steps are to run close a database connection with this connection.
+    close_a_database_connection(*this);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onabort
+void IDBDatabase::set_onabort(WebIDL::CallbackType* event_handler)
+{
+    set_event_handler_attribute(HTML::EventNames::abort, event_handler);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onabort
+WebIDL::CallbackType* IDBDatabase::onabort()
+{
+    return event_handler_attribute(HTML::EventNames::abort);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onclose
+void IDBDatabase::set_onclose(WebIDL::CallbackType* event_handler)
+{
+    set_event_handler_attribute(HTML::EventNames::close, event_handler);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onclose
+WebIDL::CallbackType* IDBDatabase::onclose()
+{
+    return event_handler_attribute(HTML::EventNames::close);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onerror
+void IDBDatabase::set_onerror(WebIDL::CallbackType* event_handler)
+{
+    set_event_handler_attribute(HTML::EventNames::error, event_handler);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onerror
+WebIDL::CallbackType* IDBDatabase::onerror()
+{
+    return event_handler_attribute(HTML::EventNames::error);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onversionchange
+void IDBDatabase::set_onversionchange(WebIDL::CallbackType* event_handler)
+{
+    set_event_handler_attribute(HTML::EventNames::versionchange, event_handler);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbdatabase-onversionchange
+WebIDL::CallbackType* IDBDatabase::onversionchange()
+{
+    return event_handler_attribute(HTML::EventNames::versionchange);
+}
+
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibWeb/DOM/EventTarget.h>
+#include <LibWeb/IndexedDB/Internal/Database.h>
+
+namespace Web::IndexedDB {
+
+// https://w3c.github.io/IndexedDB/#idbdatabase
+// NOTE: An IDBDatabase object represents a connection to a database.
+class IDBDatabase : public DOM::EventTarget {
+    WEB_PLATFORM_OBJECT(IDBDatabase, DOM::EventTarget);
+    JS_DECLARE_ALLOCATOR(IDBDatabase);
+
+public:
+    enum class ConnectionState {
+        Open,
+        Closed,
+    };
+
+    [[nodiscard]] static JS::NonnullGCPtr<IDBDatabase> create(JS::Realm&, Database&);
+    virtual ~IDBDatabase() override;
+
+    String const& name() const { return m_associated_database->name(); }
+    u64 version() const { return m_version; }
+    void set_version(u64 version) { m_version = version; }
+
+    void close();
+
+    Database& associated_database() { return *m_associated_database; }
+
+    bool close_pending() const { return m_close_pending; }
+    void set_close_pending(bool close_pending) { m_close_pending = close_pending; }
+    ConnectionState state() const { return m_state; }
+    void set_state(ConnectionState state) { m_state = state; }
+
+    void set_onabort(WebIDL::CallbackType*);
+    WebIDL::CallbackType* onabort();
+    void set_onclose(WebIDL::CallbackType*);
+    WebIDL::CallbackType* onclose();
+    void set_onerror(WebIDL::CallbackType*);
+    WebIDL::CallbackType* onerror();
+    void set_onversionchange(WebIDL::CallbackType*);
+    WebIDL::CallbackType* onversionchange();
+
+private:
+    IDBDatabase(JS::Realm&, Database&);
+
+    virtual void initialize(JS::Realm&) override;
+    virtual void visit_edges(Visitor&) override;
+
+    // https://w3c.github.io/IndexedDB/#connection-version
+    u64 m_version { 0 };
+
+    // https://w3c.github.io/IndexedDB/#connection-close-pending-flag
+    bool m_close_pending { false };
+
+    ConnectionState m_state { ConnectionState::Open };
+
+    JS::NonnullGCPtr<Database> m_associated_database;
+};
+
+}
@@ -6,7 +6,14 @@
 
 #include <LibWeb/Bindings/IDBFactoryPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/DOM/Event.h>
+#include <LibWeb/HTML/EventNames.h>
+#include <LibWeb/HTML/Scripting/Environments.h>
+#include <LibWeb/IndexedDB/IDBDatabase.h>
 #include <LibWeb/IndexedDB/IDBFactory.h>
+#include <LibWeb/IndexedDB/Internal/Algorithms.h>
+#include <LibWeb/Platform/EventLoopPlugin.h>
+#include <LibWeb/StorageAPI/StorageKey.h>
 
 namespace Web::IndexedDB {
 
@@ -25,4 +32,77 @@ void IDBFactory::initialize(JS::Realm& realm)
     WEB_SET_PROTOTYPE_FOR_INTERFACE(IDBFactory);
 }
 
+// https://w3c.github.io/IndexedDB/#dom-idbfactory-open
+WebIDL::ExceptionOr<JS::NonnullGCPtr<IDBOpenDBRequest>> IDBFactory::open(String const& name, Optional<u64> version)
+{
+    auto& realm = this->realm();
+
+    // 1. If version is 0 (zero), throw a TypeError.
+    if (version.has_value() && version.value() == 0)
+        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, "The version provided must not be 0"sv };
+
+    // 2. Let environment be this's relevant settings object.
+    auto& environment = HTML::relevant_settings_object(*this);
+
+    // 3. Let storageKey be the result of running obtain a storage key given environment.
+    //    If failure is returned, then throw a "SecurityError" DOMException and abort these steps.
+    auto storage_key = StorageAPI::obtain_a_storage_key(environment);
+    if (!storage_key.has_value())
+        return WebIDL::SecurityError::create(realm, "Failed to obtain a storage key"_fly_string);
+
+    // 4. Let request be a new open request.
+    auto request = IDBOpenDBRequest::create(realm);
+
+    // 5. Run these steps in parallel:
+    Platform::EventLoopPlugin::the().deferred_invoke([&realm, storage_key = storage_key.release_value(), name, version, request] {
+        // 1. Let result be the result of opening a database connection, with storageKey, name, version if given and undefined otherwise, and request.
+        auto result = open_a_database_connection(realm, storage_key, name, version, request);
+
+        JS::GCPtr<IDBDatabase> connection;
+        JS::GCPtr<WebIDL::DOMException> error;
+        if (result.is_error())
+            error = result.release_error().get<JS::NonnullGCPtr<WebIDL::DOMException>>();
+        else
+            connection = result.release_value();
+
+        // 2. Set request's processed flag to true.
+        request->set_processed(true);
+
+        // 3. Queue a task to run these steps:
+        HTML::queue_global_task(HTML::Task::Source::DatabaseAccess, realm.global_object(), JS::create_heap_function(realm.heap(), [&realm, request, connection, error] {
+            // 1. If result is an error, then:
+            if (error) {
+                // 1. Set request's result to undefined.
+                request->set_result(JS::js_undefined());
+
+                // 2. Set request's error to result.
+                request->set_error(error);
+
+                // 3. Set request's done flag to true.
+                request->set_done(true);
+
+                // 4. Fire an event named error at request with its bubbles and cancelable attributes initialized to true.
+                auto event = DOM::Event::create(realm, HTML::EventNames::error);
+                event->set_bubbles(true);
+                event->set_cancelable(true);
+                request->dispatch_event(event);
+            }
+            // 2. Otherwise:
+            else {
+                // 1. Set request's result to result.
+                request->set_result(connection);
+
+                // 2. Set request's done flag to true.
+                request->set_done(true);
+
+                // 3. Fire an event named success at request.
+                request->dispatch_event(DOM::Event::create(realm, HTML::EventNames::success));
+            }
+        }));
+    });
+
+    // 6. Return a new IDBOpenDBRequest object for request.
+    return request;
+}
+
 }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <LibWeb/Bindings/PlatformObject.h>
+#include <LibWeb/IndexedDB/IDBOpenDBRequest.h>
 
 namespace Web::IndexedDB {
 
@@ -18,6 +19,8 @@ class IDBFactory : public Bindings::PlatformObject {
 public:
     virtual ~IDBFactory() override;
 
+    WebIDL::ExceptionOr<JS::NonnullGCPtr<IDBOpenDBRequest>> open(String const& name, Optional<u64> version);
+
 protected:
     explicit IDBFactory(JS::Realm&);
 
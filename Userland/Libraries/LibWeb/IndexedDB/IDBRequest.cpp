@@ -5,7 +5,6 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <LibWeb/Bindings/IDBRequestPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/HTML/EventNames.h>
 #include <LibWeb/IndexedDB/IDBRequest.h>
@@ -27,6 +26,44 @@ void IDBRequest::initialize(JS::Realm& realm)
     WEB_SET_PROTOTYPE_FOR_INTERFACE(IDBRequest);
 }
 
+void IDBRequest::visit_edges(Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_result);
+    visitor.visit(m_error);
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbrequest-result
+WebIDL::ExceptionOr<JS::Value> IDBRequest::result() const
+{
+    // 1. If this's done flag is false, then throw an "InvalidStateError" DOMException.
+    if (!m_done)
+        return WebIDL::InvalidStateError::create(realm(), "The request is not done yet"_fly_string);
+
+    // 2. Otherwise, return this's result, or undefined if the request resulted in an error.
+    if (m_error)
+        return JS::js_undefined();
+    return m_result;
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbrequest-error
+WebIDL::ExceptionOr<JS::GCPtr<WebIDL::DOMException>> IDBRequest::error() const
+{
+    // 1. If this's done flag is false, then throw an "InvalidStateError" DOMException.
+    if (!m_done)
+        return WebIDL::InvalidStateError::create(realm(), "The request is not done yet"_fly_string);
+
+    // 2. Otherwise, return this's error, or null if no error occurred.
+    return m_error;
+}
+
+// https://w3c.github.io/IndexedDB/#dom-idbrequest-readystate
+Bindings::IDBRequestReadyState IDBRequest::ready_state() const
+{
+    // The readyState getter steps are to return "pending" if this's done flag is false, and "done" otherwise.
+    return m_done ? Bindings::IDBRequestReadyState::Done : Bindings::IDBRequestReadyState::Pending;
+}
+
 // https://w3c.github.io/IndexedDB/#dom-idbrequest-onsuccess
 void IDBRequest::set_onsuccess(WebIDL::CallbackType* event_handler)
 {
@@ -7,10 +7,13 @@
 
 #pragma once
 
+#include <LibWeb/Bindings/IDBRequestPrototype.h>
 #include <LibWeb/DOM/EventTarget.h>
+#include <LibWeb/WebIDL/DOMException.h>
 
 namespace Web::IndexedDB {
 
+// https://w3c.github.io/IndexedDB/#idbrequest
 class IDBRequest : public DOM::EventTarget {
     WEB_PLATFORM_OBJECT(IDBRequest, DOM::EventTarget);
     JS_DECLARE_ALLOCATOR(IDBRequest);
@@ -18,6 +21,17 @@ class IDBRequest : public DOM::EventTarget {
 public:
     virtual ~IDBRequest() override;
 
+    WebIDL::ExceptionOr<JS::Value> result() const;
+    WebIDL::ExceptionOr<JS::GCPtr<WebIDL::DOMException>> error() const;
+    Bindings::IDBRequestReadyState ready_state() const;
+
+    bool done() const { return m_done; }
+    void set_done(bool done) { m_done = done; }
+    bool processed() const { return m_processed; }
+    void set_processed(bool processed) { m_processed = processed; }
+    void set_result(JS::Value result) { m_result = result; }
+    void set_error(JS::GCPtr<WebIDL::DOMException> error) { m_error = error; }
+
     void set_onsuccess(WebIDL::CallbackType*);
     WebIDL::CallbackType* onsuccess();
     void set_onerror(WebIDL::CallbackType*);
@@ -27,6 +41,20 @@ protected:
     explicit IDBRequest(JS::Realm&);
 
     virtual void initialize(JS::Realm&) override;
+    virtual void visit_edges(Visitor&) override;
+
+private:
+    // https://w3c.github.io/IndexedDB/#request-processed-flag
+    bool m_processed { false };
+
+    // https://w3c.github.io/IndexedDB/#request-done-flag
+    bool m_done { false };
+
+    // https://w3c.github.io/IndexedDB/#request-result
+    JS::Value m_result;
+
+    // https://w3c.github.io/IndexedDB/#request-error
+    JS::GCPtr<WebIDL::DOMException> m_error;
 };
 
 }
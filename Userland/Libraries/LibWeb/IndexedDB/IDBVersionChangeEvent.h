@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/Optional.h>
+#include <LibWeb/DOM/Event.h>
+
+namespace Web::IndexedDB {
+
+struct IDBVersionChangeEventInit : public DOM::EventInit {
+    u64 old_version { 0 };
+    Optional<u64> new_version;
+};
+
+// https://w3c.github.io/IndexedDB/#idbversionchangeevent
+class IDBVersionChangeEvent final : public DOM::Event {
+    WEB_PLATFORM_OBJECT(IDBVersionChangeEvent, DOM::Event);
+    JS_DECLARE_ALLOCATOR(IDBVersionChangeEvent);
+
+public:
+    [[nodiscard]] static JS::NonnullGCPtr<IDBVersionChangeEvent> create(JS::Realm&, FlyString const& event_name, IDBVersionChangeEventInit const& event_init);
+    static WebIDL::ExceptionOr<JS::NonnullGCPtr<IDBVersionChangeEvent>> construct_impl(JS::Realm&, FlyString const& event_name, IDBVersionChangeEventInit const& event_init);
+
+    virtual ~IDBVersionChangeEvent() override;
+
+    u64 old_version() const { return m_old_version; }
+    Optional<u64> new_version() const { return m_new_version; }
+
+private:
+    IDBVersionChangeEvent(JS::Realm&, FlyString const& event_name, IDBVersionChangeEventInit const& event_init);
+
+    virtual void initialize(JS::Realm&) override;
+
+    u64 m_old_version { 0 };
+    Optional<u64> m_new_version;
+};
+
+}
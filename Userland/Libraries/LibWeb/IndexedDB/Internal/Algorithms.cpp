@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Runtime/Realm.h>
+#include <LibWeb/DOM/EventDispatcher.h>
+#include <LibWeb/HTML/EventLoop/EventLoop.h>
+#include <LibWeb/HTML/EventNames.h>
+#include <LibWeb/HTML/Scripting/Environments.h>
+#include <LibWeb/IndexedDB/IDBDatabase.h>
+#include <LibWeb/IndexedDB/IDBRequest.h>
+#include <LibWeb/IndexedDB/IDBVersionChangeEvent.h>
+#include <LibWeb/IndexedDB/Internal/Algorithms.h>
+#include <LibWeb/Platform/EventLoopPlugin.h>
+
+namespace Web::IndexedDB {
+
+static void queue_a_database_task(JS::Realm& realm, Function<void()> steps)
+{
+    HTML::queue_global_task(HTML::Task::Source::DatabaseAccess, realm.global_object(), JS::create_heap_function(realm.heap(), move(steps)));
+}
+
+// https://w3c.github.io/IndexedDB/#open-a-database-connection
+WebIDL::ExceptionOr<JS::NonnullGCPtr<IDBDatabase>> open_a_database_connection(JS::Realm& realm, StorageAPI::StorageKey storage_key, String const& name, Optional<u64> maybe_version, IDBRequest& request)
+{
+    // FIXME: 1. Let queue be the connection queue for storageKey and name.
+    // FIXME: 2. Add request to queue.
+    // FIXME: 3. Wait until all previous requests in queue have been processed.
+
+    // 4. Let db be the database named name in storageKey, or null otherwise.
+    auto db = Database::for_key_and_name(storage_key, name);
+
+    // 5. If version is undefined, let version be 1 if db is null, or db's version otherwise.
+    auto version = maybe_version.value_or(db ? db->version() : 1);
+
+    // 6. If db is null, let db be a new database with name name, version 0 (zero), and with no object stores.
+    //    If this fails for any reason, return an appropriate error (e.g. a "QuotaExceededError" or "UnknownError" DOMException).
+    if (!db)
+        db = Database::create_for_key_and_name(realm, storage_key, name);
+
+    // 7. If db's version is greater than version, return a newly created "VersionError" DOMException and abort these steps.
+    if (db->version() > version)
+        return WebIDL::VersionError::create(realm, "Database version is greater than the requested version"_fly_string);
+
+    // 8. Let connection be a new connection to db.
+    auto connection = IDBDatabase::create(realm, *db);
+
+    // 9. Set connection's version to version.
+    connection->set_version(version);
+
+    // 10. If db's version is less than version, then:
+    if (db->version() < version) {
+        // 1. Let openConnections be the set of all connections, except connection, associated with db.
+        Vector<JS::NonnullGCPtr<IDBDatabase>> open_connections;
+        for (auto const& entry : db->associated_connections()) {
+            if (entry != connection)
+                open_connections.append(entry);
+        }
+
+        // 2. For each entry of openConnections that does not have its close pending flag set to true,
+        //    queue a task to fire a version change event named versionchange at entry with db's version and version.
+        size_t events_to_fire = 0;
+        size_t events_fired = 0;
+        for (auto const& entry : open_connections) {
+            if (entry->close_pending())
+                continue;
+
+            ++events_to_fire;
+            queue_a_database_task(realm, [&realm, entry, db, version, &events_fired]() {
+                fire_a_version_change_event(realm, HTML::EventNames::versionchange, *entry, db->version(), version);
+                ++events_fired;
+            });
+        }
+
+        // 3. Wait for all of the events to be fired.
+        HTML::main_thread_event_loop().spin_until([&] {
+            return events_fired == events_to_fire;
+        });
+
+        // 4. If any of the connections in openConnections are still not closed,
+        //    queue a task to fire a version change event named blocked at request with db's version and version.
+        auto is_closed = [](auto const& entry) { return entry->state() == IDBDatabase::ConnectionState::Closed; };
+        if (!all_of(open_connections, is_closed)) {
+            queue_a_database_task(realm, [&realm, request = JS::NonnullGCPtr { request }, db, version]() {
+                fire_a_version_change_event(realm, HTML::EventNames::blocked, *request, db->version(), version);
+            });
+        }
+
+        // 5. Wait until all connections in openConnections are closed.
+        HTML::main_thread_event_loop().spin_until([&] {
+            return all_of(open_connections, is_closed);
+        });
+
+        // 6. Run upgrade a database using connection, version and request.
+        upgrade_a_database(realm, connection, version, request);
+
+        // 7. If connection was closed, return a newly created "AbortError" DOMException and abort these steps.
+        if (connection->state() == IDBDatabase::ConnectionState::Closed)
+            return WebIDL::AbortError::create(realm, "Connection was closed during the upgrade"_fly_string);
+
+        // FIXME: 8. If the upgrade transaction was aborted, run the steps to close a database connection with connection,
+        //           return a newly created "AbortError" DOMException and abort these steps.
+    }
+
+    // 11. Return connection.
+    return connection;
+}
+
+// https://w3c.github.io/IndexedDB/#upgrade-a-database
+void upgrade_a_database(JS::Realm& realm, IDBDatabase& connection, u64 version, IDBRequest& request)
+{
+    // 1. Let db be connection's database.
+    auto& db = connection.associated_database();
+
+    // FIXME: 2. Let transaction be a new upgrade transaction with connection used as connection.
+    // FIXME: 3. Set transaction's scope to connection's object store set.
+    // FIXME: 4. Set db's upgrade transaction to transaction.
+    // FIXME: 5. Set transaction's state to inactive.
+    // FIXME: 6. Start transaction.
+
+    // 7. Let old version be db's version.
+    auto old_version = db.version();
+
+    // 8. Set db's version to version. This change is considered part of the transaction, and so if the transaction is aborted, this change is reverted.
+    db.set_version(version);
+
+    // 9. Set request's processed flag to true.
+    request.set_processed(true);
+
+    // 10. Queue a task to run these steps:
+    bool did_fire_upgradeneeded = false;
+    queue_a_database_task(realm, [&realm, connection = JS::NonnullGCPtr { connection }, request = JS::NonnullGCPtr { request }, old_version, version, &did_fire_upgradeneeded]() {
+        // 1. Set request's result to connection.
+        request->set_result(connection);
+
+        // FIXME: 2. Set request's transaction to transaction.
+
+        // 3. Set request's done flag to true.
+        request->set_done(true);
+
+        // FIXME: 4. Set transaction's state to active.
+
+        // 5. Let didThrow be the result of firing a version change event named upgradeneeded at request with old version and version.
+        fire_a_version_change_event(realm, HTML::EventNames::upgradeneeded, *request, old_version, version);
+
+        // FIXME: 6. Set transaction's state to inactive.
+        // FIXME: 7. If didThrow is true, run abort a transaction with transaction and a newly created "AbortError" DOMException.
+        did_fire_upgradeneeded = true;
+    });
+
+    // 11. Wait for transaction to finish.
+    // NOTE: Without transactions, the upgrade is finished once upgradeneeded has been fired.
+    HTML::main_thread_event_loop().spin_until([&] {
+        return did_fire_upgradeneeded;
+    });
+}
+
+// https://w3c.github.io/IndexedDB/#close-a-database-connection
+void close_a_database_connection(IDBDatabase& connection, bool forced)
+{
+    // 1. Set connection's close pending flag to true.
+    connection.set_close_pending(true);
+
+    // FIXME: 2. If the forced flag is true, then for each transaction created using connection run abort a transaction with transaction and newly created "AbortError" DOMException.
+    // FIXME: 3. Wait for all transactions created using connection to complete. Once they are complete, connection is closed.
+    connection.set_state(IDBDatabase::ConnectionState::Closed);
+    connection.associated_database().disassociate(connection);
+
+    // 4. If the forced flag is true, then fire an event named close at connection.
+    if (forced)
+        connection.dispatch_event(DOM::Event::create(connection.realm(), HTML::EventNames::close));
+}
+
+// https://w3c.github.io/IndexedDB/#fire-a-version-change-event
+bool fire_a_version_change_event(JS::Realm& realm, FlyString const& event_name, DOM::EventTarget& target, u64 old_version, Optional<u64> new_version)
+{
+    IDBVersionChangeEventInit event_init = {};
+    // 4. Set event's oldVersion attribute to oldVersion.
+    event_init.old_version = old_version;
+    // 5. Set event's newVersion attribute to newVersion.
+    event_init.new_version = new_version;
+
+    // 1. Let event be the result of creating an event using IDBVersionChangeEvent.
+    // 2. Set event's type attribute to e.
+    auto event = IDBVersionChangeEvent::create(realm, event_name, event_init);
+
+    // 3. Set event's bubbles and cancelable attributes to false.
+    event->set_bubbles(false);
+    event->set_cancelable(false);
+
+    // FIXME: 6. Let legacyOutputDidListenersThrowFlag be false.
+    // 7. Dispatch event at target with legacyOutputDidListenersThrowFlag.
+    DOM::EventDispatcher::dispatch(target, *event);
+
+    // FIXME: 8. Return legacyOutputDidListenersThrowFlag.
+    return false;
+}
+
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/Optional.h>
+#include <LibJS/Forward.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/StorageAPI/StorageKey.h>
+#include <LibWeb/WebIDL/ExceptionOr.h>
+
+namespace Web::IndexedDB {
+
+WebIDL::ExceptionOr<JS::NonnullGCPtr<IDBDatabase>> open_a_database_connection(JS::Realm&, StorageAPI::StorageKey, String const& name, Optional<u64> version, IDBRequest&);
+void upgrade_a_database(JS::Realm&, IDBDatabase& connection, u64 version, IDBRequest&);
+void close_a_database_connection(IDBDatabase& connection, bool forced = false);
+bool fire_a_version_change_event(JS::Realm&, FlyString const& event_name, DOM::EventTarget&, u64 old_version, Optional<u64> new_version);
+
+}
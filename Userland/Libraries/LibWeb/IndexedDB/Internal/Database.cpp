@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <LibJS/Heap/Handle.h>
+#include <LibJS/Runtime/Realm.h>
+#include <LibWeb/IndexedDB/IDBDatabase.h>
+#include <LibWeb/IndexedDB/Internal/Database.h>
+
+namespace Web::IndexedDB {
+
+JS_DEFINE_ALLOCATOR(Database);
+
+// The databases of each storage key, by their serialized origin and then by their name.
+static HashMap<ByteString, HashMap<String, JS::Handle<Database>>>& databases()
+{
+    static HashMap<ByteString, HashMap<String, JS::Handle<Database>>> databases;
+    return databases;
+}
+
+JS::GCPtr<Database> Database::for_key_and_name(StorageAPI::StorageKey const& storage_key, String const& name)
+{
+    auto databases_of_key = databases().find(storage_key.origin.serialize());
+    if (databases_of_key == databases().end())
+        return nullptr;
+
+    auto database = databases_of_key->value.get(name);
+    if (!database.has_value())
+        return nullptr;
+    return database->ptr();
+}
+
+JS::NonnullGCPtr<Database> Database::create_for_key_and_name(JS::Realm& realm, StorageAPI::StorageKey const& storage_key, String const& name)
+{
+    auto database = realm.heap().allocate_without_realm<Database>(name);
+    databases().ensure(storage_key.origin.serialize()).set(name, JS::make_handle(database));
+    return database;
+}
+
+Database::Database(String name)
+    : m_name(move(name))
+{
+}
+
+Database::~Database() = default;
+
+void Database::visit_edges(Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_associated_connections);
+}
+
+void Database::associate(IDBDatabase& connection)
+{
+    m_associated_connections.append(connection);
+}
+
+void Database::disassociate(IDBDatabase& connection)
+{
+    m_associated_connections.remove_first_matching([&](auto const& entry) { return entry.ptr() == &connection; });
+}
+
+}
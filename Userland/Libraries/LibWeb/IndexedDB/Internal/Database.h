@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibJS/Heap/GCPtr.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/StorageAPI/StorageKey.h>
+
+namespace Web::IndexedDB {
+
+// https://w3c.github.io/IndexedDB/#database-construct
+// NOTE: Databases are only kept in the memory of this process for now.
+class Database final : public JS::Cell {
+    JS_CELL(Database, JS::Cell);
+    JS_DECLARE_ALLOCATOR(Database);
+
+public:
+    // Returns the database named name in storage_key, if there is one.
+    static JS::GCPtr<Database> for_key_and_name(StorageAPI::StorageKey const&, String const& name);
+    static JS::NonnullGCPtr<Database> create_for_key_and_name(JS::Realm&, StorageAPI::StorageKey const&, String const& name);
+
+    virtual ~Database() override;
+
+    String const& name() const { return m_name; }
+    u64 version() const { return m_version; }
+    void set_version(u64 version) { m_version = version; }
+
+    Vector<JS::NonnullGCPtr<IDBDatabase>> const& associated_connections() const { return m_associated_connections; }
+    void associate(IDBDatabase&);
+    void disassociate(IDBDatabase&);
+
+private:
+    explicit Database(String name);
+
+    virtual void visit_edges(Visitor&) override;
+
+    // https://w3c.github.io/IndexedDB/#database-name
+    String m_name;
+
+    // https://w3c.github.io/IndexedDB/#database-version
+    u64 m_version { 0 };
+
+    Vector<JS::NonnullGCPtr<IDBDatabase>> m_associated_connections;
+};
+
+}
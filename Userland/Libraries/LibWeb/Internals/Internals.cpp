@@ -11,13 +11,16 @@
 #include <LibWeb/DOM/Event.h>
 #include <LibWeb/DOM/EventTarget.h>
 #include <LibWeb/DOMURL/DOMURL.h>
+#include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/HTML/HTMLElement.h>
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/Internals/Internals.h>
+#include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Page/InputEvent.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/Painting/PaintableBox.h>
+#include <LibWeb/Painting/StackingContext.h>
 #include <LibWeb/Painting/ViewportPaintable.h>
 
 namespace Web::Internals {
@@ -156,6 +159,38 @@ JS::NonnullGCPtr<InternalAnimationTimeline> Internals::create_internal_animation
     return realm.heap().allocate<InternalAnimationTimeline>(realm, realm);
 }
 
+u64 Internals::decoded_image_bytes() const
+{
+    return HTML::AnimatedBitmapDecodedImageData::resident_bitmap_bytes();
+}
+
+void Internals::discard_hidden_image_bitmaps()
+{
+    HTML::AnimatedBitmapDecodedImageData::discard_all_hidden_bitmaps();
+}
+
+u64 Internals::created_interface_object_count()
+{
+    return Bindings::host_defined_intrinsics(realm()).created_object_count();
+}
+
+void Internals::record_display_list()
+{
+    auto& document = internals_window().associated_document();
+    document.update_layout();
+    (void)document.record_display_list_with_last_paint_config();
+}
+
+u64 Internals::replayed_display_list_chunk_count()
+{
+    return Painting::StackingContext::replayed_display_list_chunk_count();
+}
+
+u64 Internals::started_network_request_count()
+{
+    return ResourceLoader::the().started_network_request_count();
+}
+
 void Internals::simulate_drag_start(double x, double y, String const& name, String const& contents)
 {
     Vector<HTML::SelectedFile> files;
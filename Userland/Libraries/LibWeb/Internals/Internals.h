@@ -39,6 +39,15 @@ public:
 
     JS::NonnullGCPtr<InternalAnimationTimeline> create_internal_animation_timeline();
 
+    u64 decoded_image_bytes() const;
+    void discard_hidden_image_bitmaps();
+    u64 created_interface_object_count();
+
+    void record_display_list();
+    u64 replayed_display_list_chunk_count();
+
+    u64 started_network_request_count();
+
     void simulate_drag_start(double x, double y, String const& name, String const& contents);
     void simulate_drag_move(double x, double y);
     void simulate_drop(double x, double y);
@@ -33,6 +33,12 @@ struct IntersectionObserverRegistration {
     // https://www.w3.org/TR/intersection-observer/#dom-intersectionobserverregistration-previousisintersecting
     // [A] previousIsIntersecting property holding a boolean.
     bool previous_is_intersecting { false };
+
+    // NOTE: Not in the spec. The geometry generations of the documents of the target and of the intersection root at
+    //       the time thresholdIndex and isIntersecting were last computed for this registration. As long as neither
+    //       changes, computing them again would give the same result, so the target is skipped.
+    u64 target_geometry_generation { 0 };
+    u64 root_geometry_generation { 0 };
 };
 
 // https://w3c.github.io/IntersectionObserver/#intersection-observer-interface
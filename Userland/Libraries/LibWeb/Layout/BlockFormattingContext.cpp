@@ -444,6 +444,8 @@ void BlockFormattingContext::resolve_used_height_if_treated_as_auto(Box const& b
     CSSPixels height = 0;
     if (box_is_sized_as_replaced_element(box)) {
         height = compute_height_for_replaced_element(box, available_space);
+    } else if (auto size_containment_height = size_containment_intrinsic_size(box, Orientation::Vertical); size_containment_height.has_value()) {
+        height = *size_containment_height;
     } else {
         if (box_formatting_context) {
             height = box_formatting_context->automatic_content_height();
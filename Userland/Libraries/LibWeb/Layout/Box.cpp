@@ -6,10 +6,12 @@
  */
 
 #include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/Element.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
 #include <LibWeb/Layout/BlockContainer.h>
 #include <LibWeb/Layout/Box.h>
 #include <LibWeb/Layout/FormattingContext.h>
+#include <LibWeb/Layout/GridFormattingContext.h>
 #include <LibWeb/Painting/PaintableBox.h>
 
 namespace Web::Layout {
@@ -28,10 +30,33 @@ Box::~Box()
 {
 }
 
+Box::IntrinsicSizes& Box::cached_intrinsic_sizes() const
+{
+    if (!m_cached_intrinsic_sizes)
+        m_cached_intrinsic_sizes = make<IntrinsicSizes>();
+    return *m_cached_intrinsic_sizes;
+}
+
+void Box::set_cached_grid_placement(NonnullOwnPtr<GridPlacement> grid_placement) const
+{
+    m_cached_grid_placement = move(grid_placement);
+}
+
+void Box::reset_layout_caches() const
+{
+    m_cached_intrinsic_sizes = nullptr;
+    m_cached_grid_placement = nullptr;
+}
+
 void Box::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_contained_abspos_children);
+    if (m_cached_grid_placement) {
+        visitor.visit(m_cached_grid_placement->children);
+        for (auto& item : m_cached_grid_placement->grid_items)
+            visitor.visit(item.box);
+    }
 }
 
 // https://www.w37.org/TR/css-overflow-3/#overflow-control
@@ -66,6 +91,95 @@ bool Box::is_user_scrollable() const
     return computed_values().overflow_y() == CSS::Overflow::Scroll || computed_values().overflow_y() == CSS::Overflow::Auto;
 }
 
+// https://drafts.csswg.org/css-contain-2/#skips-its-contents
+static DOM::Element const* element_that_skips_its_contents(Box const& box)
+{
+    auto const* dom_node = box.dom_node();
+    if (!dom_node || !dom_node->is_element())
+        return nullptr;
+    auto const& element = static_cast<DOM::Element const&>(*dom_node);
+    if (!element.skips_its_contents())
+        return nullptr;
+    return &element;
+}
+
+// https://drafts.csswg.org/css-contain-2/#containment-size
+bool Box::has_size_containment() const
+{
+    // Giving an element size containment has no effect if any of the following are true:
+    // - if the element does not generate a principal box (as is the case with display: contents or display: none)
+    // - if its inner display type is table
+    // - if its principal box is an internal table box
+    // - if its principal box is an internal ruby box or a non-atomic inline-level box
+    // NOTE: Non-atomic inline-level boxes are InlineNodes, not Boxes.
+    if (display().is_table_inside() || display().is_internal())
+        return false;
+
+    // An element that skips its contents has size containment.
+    return computed_values().contain().size_containment || element_that_skips_its_contents(*this);
+}
+
+// https://drafts.csswg.org/css-contain-2/#containment-layout
+bool Box::has_layout_containment() const
+{
+    // Giving an element layout containment has no effect if any of the following are true:
+    // - if the element does not generate a principal box (as is the case with display: contents or display: none)
+    // - if its principal box is an internal table box other than table-cell
+    // - if its principal box is an internal ruby box
+    // - if its principal box is a non-atomic inline-level box
+    if (display().is_internal() && !display().is_table_cell())
+        return false;
+
+    // content-visibility: auto and content-visibility: hidden turn on layout containment.
+    return computed_values().contain().layout_containment || computed_values().content_visibility() != CSS::ContentVisibility::Visible;
+}
+
+// https://drafts.csswg.org/css-contain-2/#containment-paint
+bool Box::has_paint_containment() const
+{
+    // Giving an element paint containment has no effect if any of the following are true:
+    // - if the element does not generate a principal box (as is the case with display: contents or display: none)
+    // - if its principal box is an internal table box other than table-cell
+    // - if its principal box is an internal ruby box
+    // - if its principal box is a non-atomic inline-level box
+    if (display().is_internal() && !display().is_table_cell())
+        return false;
+
+    // content-visibility: auto and content-visibility: hidden turn on paint containment.
+    return computed_values().contain().paint_containment || computed_values().content_visibility() != CSS::ContentVisibility::Visible;
+}
+
+// https://drafts.csswg.org/css-sizing-4/#intrinsic-size-override
+// NOTE: The last remembered size is only passed in if the box's element is currently skipping its contents.
+static CSSPixels explicit_intrinsic_inner_size(Box const& box, CSS::ContainIntrinsicSize const& contain_intrinsic_size, Optional<CSSPixels> last_remembered_size)
+{
+    // If auto is specified and the element has a last remembered size and is currently skipping its contents, its
+    // explicit intrinsic inner size in the corresponding axis is the last remembered size in that axis.
+    if (contain_intrinsic_size.use_last_remembered_size && last_remembered_size.has_value())
+        return *last_remembered_size;
+
+    // NOTE: Without an explicit intrinsic inner size, a box with size containment is sized as if it was empty.
+    if (!contain_intrinsic_size.length.has_value())
+        return 0;
+    return contain_intrinsic_size.length->to_px(box);
+}
+
+CSSPixels Box::explicit_intrinsic_inner_width() const
+{
+    Optional<CSSPixels> last_remembered_width;
+    if (auto const* element = element_that_skips_its_contents(*this); element && element->last_remembered_size().has_value())
+        last_remembered_width = element->last_remembered_size()->width();
+    return explicit_intrinsic_inner_size(*this, computed_values().contain_intrinsic_width(), last_remembered_width);
+}
+
+CSSPixels Box::explicit_intrinsic_inner_height() const
+{
+    Optional<CSSPixels> last_remembered_height;
+    if (auto const* element = element_that_skips_its_contents(*this); element && element->last_remembered_size().has_value())
+        last_remembered_height = element->last_remembered_size()->height();
+    return explicit_intrinsic_inner_size(*this, computed_values().contain_intrinsic_height(), last_remembered_height);
+}
+
 bool Box::is_body() const
 {
     return dom_node() && dom_node() == document().body();
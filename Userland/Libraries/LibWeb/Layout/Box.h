@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
 #include <LibGfx/Rect.h>
 #include <LibJS/Heap/Cell.h>
@@ -54,10 +55,40 @@ public:
 
     bool is_user_scrollable() const;
 
+    // https://drafts.csswg.org/css-contain-2/#containment-types
+    bool has_size_containment() const;
+    bool has_layout_containment() const;
+    bool has_paint_containment() const;
+
+    // https://drafts.csswg.org/css-sizing-4/#explicit-intrinsic-inner-size
+    // The size a box with size containment is laid out at in place of the size of its contents.
+    CSSPixels explicit_intrinsic_inner_width() const;
+    CSSPixels explicit_intrinsic_inner_height() const;
+
     void add_contained_abspos_child(JS::NonnullGCPtr<Node> child) { m_contained_abspos_children.append(child); }
     void clear_contained_abspos_children() { m_contained_abspos_children.clear(); }
     Vector<JS::NonnullGCPtr<Node>> const& contained_abspos_children() const { return m_contained_abspos_children; }
 
+    // The min-content and max-content widths of the box, and its min-content and max-content heights per available width.
+    // They're kept around across layouts, and discarded when set_needs_layout_update() is called on the box, on one of
+    // its descendants or on a box generated for one of its pseudo-elements, or when the document needs a full layout.
+    struct IntrinsicSizes {
+        Optional<CSSPixels> min_content_width;
+        Optional<CSSPixels> max_content_width;
+
+        HashMap<CSSPixels, Optional<CSSPixels>> min_content_height;
+        HashMap<CSSPixels, Optional<CSSPixels>> max_content_height;
+    };
+
+    IntrinsicSizes& cached_intrinsic_sizes() const;
+
+    // The placement of a grid container's items only depends on the styles of the container and its children, and on
+    // the number of explicit tracks, so it's kept around the same way.
+    GridPlacement const* cached_grid_placement() const { return m_cached_grid_placement.ptr(); }
+    void set_cached_grid_placement(NonnullOwnPtr<GridPlacement>) const;
+
+    void reset_layout_caches() const;
+
     virtual void visit_edges(Cell::Visitor&) override;
 
 protected:
@@ -72,6 +103,9 @@ private:
     Optional<CSSPixelFraction> m_natural_aspect_ratio;
 
     Vector<JS::NonnullGCPtr<Node>> m_contained_abspos_children;
+
+    mutable OwnPtr<IntrinsicSizes> m_cached_intrinsic_sizes;
+    mutable OwnPtr<GridPlacement> m_cached_grid_placement;
 };
 
 template<>
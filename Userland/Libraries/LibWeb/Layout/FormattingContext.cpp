@@ -93,7 +93,9 @@ bool FormattingContext::creates_block_formatting_context(Box const& box)
     if (box.display().is_flow_root_inside())
         return true;
 
-    // FIXME: Elements with contain: layout, content, or paint.
+    // Elements with contain: layout, content, or paint.
+    if (box.has_layout_containment() || box.has_paint_containment())
+        return true;
 
     if (box.parent()) {
         auto parent_display = box.parent()->display();
@@ -1449,14 +1451,26 @@ CSSPixels FormattingContext::calculate_fit_content_height(Layout::Box const& box
     return calculate_max_content_height(box, available_space.width.to_px_or_zero());
 }
 
+// https://drafts.csswg.org/css-contain-2/#containment-size
+Optional<CSSPixels> FormattingContext::size_containment_intrinsic_size(Box const& box, Orientation orientation)
+{
+    // A box with size containment is sized as if it had no contents, but with its explicit intrinsic inner size.
+    if (!box.has_size_containment())
+        return {};
+    if (orientation == Orientation::Horizontal)
+        return box.explicit_intrinsic_inner_width();
+    return box.explicit_intrinsic_inner_height();
+}
+
 CSSPixels FormattingContext::calculate_min_content_width(Layout::Box const& box) const
 {
     if (box.has_natural_width())
         return *box.natural_width();
 
-    auto& root_state = m_state.m_root;
+    if (auto size = size_containment_intrinsic_size(box, Orientation::Horizontal); size.has_value())
+        return *size;
 
-    auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+    auto& cache = box.cached_intrinsic_sizes();
     if (cache.min_content_width.has_value())
         return *cache.min_content_width;
 
@@ -1492,9 +1506,10 @@ CSSPixels FormattingContext::calculate_max_content_width(Layout::Box const& box)
     if (box.has_natural_width())
         return *box.natural_width();
 
-    auto& root_state = m_state.m_root;
+    if (auto size = size_containment_intrinsic_size(box, Orientation::Horizontal); size.has_value())
+        return *size;
 
-    auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+    auto& cache = box.cached_intrinsic_sizes();
     if (cache.max_content_width.has_value())
         return *cache.max_content_width;
 
@@ -1535,9 +1550,11 @@ CSSPixels FormattingContext::calculate_min_content_height(Layout::Box const& box
     if (box.has_natural_height())
         return *box.natural_height();
 
+    if (auto size = size_containment_intrinsic_size(box, Orientation::Vertical); size.has_value())
+        return *size;
+
     auto get_cache_slot = [&]() -> Optional<CSSPixels>* {
-        auto& root_state = m_state.m_root;
-        auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+        auto& cache = box.cached_intrinsic_sizes();
         return &cache.min_content_height.ensure(width);
     };
 
@@ -1579,9 +1596,11 @@ CSSPixels FormattingContext::calculate_max_content_height(Layout::Box const& box
     if (box.has_natural_height())
         return *box.natural_height();
 
+    if (auto size = size_containment_intrinsic_size(box, Orientation::Vertical); size.has_value())
+        return *size;
+
     auto get_cache_slot = [&]() -> Optional<CSSPixels>* {
-        auto& root_state = m_state.m_root;
-        auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+        auto& cache = box.cached_intrinsic_sizes();
         return &cache.max_content_height.ensure(width);
     };
 
@@ -773,7 +773,6 @@ void GridFormattingContext::distribute_extra_space_across_spanned_tracks_growth_
 void GridFormattingContext::increase_sizes_to_accommodate_spanning_items_crossing_content_sized_tracks(GridDimension const dimension, size_t span)
 {
     auto& available_size = dimension == GridDimension::Column ? m_available_space->width : m_available_space->height;
-    auto& tracks = dimension == GridDimension::Column ? m_grid_columns : m_grid_rows;
     for (auto& item : m_grid_items) {
         auto const item_span = item.span(dimension);
         if (item_span != span)
@@ -790,6 +789,15 @@ void GridFormattingContext::increase_sizes_to_accommodate_spanning_items_crossin
         if (item_spans_tracks_with_flexible_sizing_function)
             continue;
 
+        // OPTIMIZATION: Every step below only grows tracks with an intrinsic min or max track sizing function. If the
+        //               item spans none of those, there's no need to measure its contributions, which would mean laying
+        //               it out under min- and max-content constraints.
+        auto item_spans_tracks_with_intrinsic_sizing_function = any_of(spanned_tracks, [&](auto& track) {
+            return track.min_track_sizing_function.is_intrinsic(available_size) || track.max_track_sizing_function.is_intrinsic(available_size);
+        });
+        if (!item_spans_tracks_with_intrinsic_sizing_function)
+            continue;
+
         // 1. For intrinsic minimums: First increase the base size of tracks with an intrinsic min track sizing
         //    function by distributing extra space as needed to accommodate these items’ minimum contributions.
         auto item_size_contribution = [&] {
@@ -835,7 +843,8 @@ void GridFormattingContext::increase_sizes_to_accommodate_spanning_items_crossin
 
         // 4. If at this point any track’s growth limit is now less than its base size, increase its growth limit to
         //    match its base size.
-        for (auto& track : tracks) {
+        // NOTE: Only the base sizes of the tracks spanned by this item have changed since this was last done.
+        for (auto& track : spanned_tracks) {
             if (track.growth_limit.has_value() && track.growth_limit.value() < track.base_size)
                 track.growth_limit = track.base_size;
         }
@@ -887,7 +896,6 @@ void GridFormattingContext::increase_sizes_to_accommodate_spanning_items_crossin
 
 void GridFormattingContext::increase_sizes_to_accommodate_spanning_items_crossing_flexible_tracks(GridDimension const dimension)
 {
-    auto& tracks = dimension == GridDimension::Column ? m_grid_columns : m_grid_rows;
     for (auto& item : m_grid_items) {
         Vector<GridTrack&> spanned_tracks;
         for_each_spanned_track_by_item(item, dimension, [&](GridTrack& track) {
@@ -915,7 +923,8 @@ void GridFormattingContext::increase_sizes_to_accommodate_spanning_items_crossin
 
         // 4. If at this point any track’s growth limit is now less than its base size, increase its growth limit to
         //    match its base size.
-        for (auto& track : tracks) {
+        // NOTE: Only the base sizes of the tracks spanned by this item have changed since this was last done.
+        for (auto& track : spanned_tracks) {
             if (track.growth_limit.has_value() && track.growth_limit.value() < track.base_size)
                 track.growth_limit = track.base_size;
         }
@@ -1265,7 +1274,7 @@ void GridFormattingContext::place_grid_items()
     // flex items), which are then assigned to predefined areas in the grid. They can be explicitly
     // placed using coordinates through the grid-placement properties or implicitly placed into
     // empty areas using auto-placement.
-    HashMap<int, Vector<JS::NonnullGCPtr<Box const>>> order_item_bucket;
+    Vector<JS::NonnullGCPtr<Box const>> children;
     grid_container().for_each_child_of_type<Box>([&](Box& child_box) {
         if (can_skip_is_anonymous_text_run(child_box))
             return IterationDecision::Continue;
@@ -1274,13 +1283,28 @@ void GridFormattingContext::place_grid_items()
             return IterationDecision::Continue;
 
         child_box.set_grid_item(true);
-
-        auto& order_bucket = order_item_bucket.ensure(child_box.computed_values().order());
-        order_bucket.append(child_box);
+        children.append(child_box);
 
         return IterationDecision::Continue;
     });
 
+    // OPTIMIZATION: Placing the items doesn't involve any sizes, so the placement from an earlier layout can be reused
+    //               as long as the explicit grid has the same number of tracks and the same items are in it. Any style
+    //               change that could move an item resets the cache.
+    if (auto const* cached_placement = grid_container().cached_grid_placement()) {
+        if (cached_placement->explicit_columns_line_count == m_explicit_columns_line_count
+            && cached_placement->explicit_rows_line_count == m_explicit_rows_line_count
+            && cached_placement->children == children) {
+            m_grid_items = cached_placement->grid_items;
+            m_occupation_grid = cached_placement->occupation_grid;
+            return;
+        }
+    }
+
+    HashMap<int, Vector<JS::NonnullGCPtr<Box const>>> order_item_bucket;
+    for (auto const& child_box : children)
+        order_item_bucket.ensure(child_box->computed_values().order()).append(child_box);
+
     m_occupation_grid = OccupationGrid(column_tracks_count, row_tracks_count);
 
     // https://drafts.csswg.org/css-grid/#auto-placement-algo
@@ -1291,35 +1315,39 @@ void GridFormattingContext::place_grid_items()
 
     // FIXME: 0. Generate anonymous grid items
 
-    // 1. Position anything that's not auto-positioned.
-    for (auto key : keys) {
-        auto& boxes_to_place = order_item_bucket.get(key).value();
-        for (size_t i = 0; i < boxes_to_place.size(); i++) {
-            auto const& child_box = boxes_to_place[i];
-            auto const& computed_values = child_box->computed_values();
-            if (is_auto_positioned_track(computed_values.grid_row_start(), computed_values.grid_row_end())
-                || is_auto_positioned_track(computed_values.grid_column_start(), computed_values.grid_column_end()))
-                continue;
-            place_item_with_row_and_column_position(child_box);
-            boxes_to_place.remove(i);
-            i--;
+    // NOTE: Items that are placed are dropped from their bucket all at once, as removing them one by one would take
+    //       quadratic time in grids with many items.
+    auto place_items_from_buckets = [&](auto place_item_if_possible) {
+        for (auto key : keys) {
+            auto& boxes_to_place = order_item_bucket.get(key).value();
+            Vector<JS::NonnullGCPtr<Box const>> remaining_boxes;
+            for (auto const& child_box : boxes_to_place) {
+                if (!place_item_if_possible(*child_box))
+                    remaining_boxes.append(child_box);
+            }
+            boxes_to_place = move(remaining_boxes);
         }
-    }
+    };
+
+    // 1. Position anything that's not auto-positioned.
+    place_items_from_buckets([&](Box const& child_box) {
+        auto const& computed_values = child_box.computed_values();
+        if (is_auto_positioned_track(computed_values.grid_row_start(), computed_values.grid_row_end())
+            || is_auto_positioned_track(computed_values.grid_column_start(), computed_values.grid_column_end()))
+            return false;
+        place_item_with_row_and_column_position(child_box);
+        return true;
+    });
 
     // 2. Process the items locked to a given row.
     // FIXME: Do "dense" packing
-    for (auto key : keys) {
-        auto& boxes_to_place = order_item_bucket.get(key).value();
-        for (size_t i = 0; i < boxes_to_place.size(); i++) {
-            auto const& child_box = boxes_to_place[i];
-            auto const& computed_values = child_box->computed_values();
-            if (is_auto_positioned_track(computed_values.grid_row_start(), computed_values.grid_row_end()))
-                continue;
-            place_item_with_row_position(child_box);
-            boxes_to_place.remove(i);
-            i--;
-        }
-    }
+    place_items_from_buckets([&](Box const& child_box) {
+        auto const& computed_values = child_box.computed_values();
+        if (is_auto_positioned_track(computed_values.grid_row_start(), computed_values.grid_row_end()))
+            return false;
+        place_item_with_row_position(child_box);
+        return true;
+    });
 
     // 3. Determine the columns in the implicit grid.
     // NOTE: "implicit grid" here is the same as the m_occupation_grid
@@ -1359,34 +1387,30 @@ void GridFormattingContext::place_grid_items()
     // order:
     auto auto_placement_cursor_x = 0;
     auto auto_placement_cursor_y = 0;
-    for (auto key : keys) {
-        auto& boxes_to_place = order_item_bucket.get(key).value();
-        for (size_t i = 0; i < boxes_to_place.size(); i++) {
-            auto const& child_box = boxes_to_place[i];
-            auto const& computed_values = child_box->computed_values();
-            // 4.1. For sparse packing:
-            // FIXME: no distinction made. See #4.2
+    place_items_from_buckets([&](Box const& child_box) {
+        auto const& computed_values = child_box.computed_values();
+        // 4.1. For sparse packing:
+        // FIXME: no distinction made. See #4.2
 
-            // 4.1.1. If the item has a definite column position:
-            if (!is_auto_positioned_track(computed_values.grid_column_start(), computed_values.grid_column_end()))
-                place_item_with_column_position(child_box, auto_placement_cursor_x, auto_placement_cursor_y);
-
-            // 4.1.2. If the item has an automatic grid position in both axes:
-            else
-                place_item_with_no_declared_position(child_box, auto_placement_cursor_x, auto_placement_cursor_y);
+        // 4.1.1. If the item has a definite column position:
+        if (!is_auto_positioned_track(computed_values.grid_column_start(), computed_values.grid_column_end()))
+            place_item_with_column_position(child_box, auto_placement_cursor_x, auto_placement_cursor_y);
 
-            boxes_to_place.remove(i);
-            i--;
+        // 4.1.2. If the item has an automatic grid position in both axes:
+        else
+            place_item_with_no_declared_position(child_box, auto_placement_cursor_x, auto_placement_cursor_y);
 
-            // FIXME: 4.2. For dense packing:
-        }
-    }
+        // FIXME: 4.2. For dense packing:
+        return true;
+    });
 
     // NOTE: When final implicit grid sizes are known, we can offset their positions so leftmost grid track has 0 index.
     for (auto& item : m_grid_items) {
         item.row = item.row - m_occupation_grid.min_row_index();
         item.column = item.column - m_occupation_grid.min_column_index();
     }
+
+    grid_container().set_cached_grid_placement(make<GridPlacement>(m_explicit_columns_line_count, m_explicit_rows_line_count, move(children), m_grid_items, m_occupation_grid));
 }
 
 void GridFormattingContext::determine_grid_container_height()
@@ -99,6 +99,18 @@ private:
     int m_max_row_index { 0 };
 };
 
+// The outcome of the grid item placement algorithm, cached on the grid container.
+struct GridPlacement {
+    size_t explicit_columns_line_count { 0 };
+    size_t explicit_rows_line_count { 0 };
+
+    // The grid items in tree order, as they were found when the placement was made.
+    Vector<JS::NonnullGCPtr<Box const>> children;
+
+    Vector<GridItem> grid_items;
+    OccupationGrid occupation_grid;
+};
+
 class GridFormattingContext final : public FormattingContext {
 public:
     explicit GridFormattingContext(LayoutState&, LayoutMode, Box const& grid_container, FormattingContext* parent);
@@ -6,6 +6,7 @@
  */
 
 #include <AK/Debug.h>
+#include <LibWeb/DOM/Element.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/Layout/AvailableSpace.h>
 #include <LibWeb/Layout/BlockContainer.h>
@@ -29,46 +30,65 @@ LayoutState::~LayoutState()
 {
 }
 
-LayoutState::UsedValues& LayoutState::get_mutable(NodeWithStyle const& node)
+LayoutState::UsedValues* LayoutState::find_used_values(NodeWithStyle const& node) const
 {
-    if (auto* used_values = used_values_per_layout_node.get(node).value_or(nullptr))
-        return *used_values;
-
-    for (auto const* ancestor = m_parent; ancestor; ancestor = ancestor->m_parent) {
-        if (auto* ancestor_used_values = ancestor->used_values_per_layout_node.get(node).value_or(nullptr)) {
-            auto cow_used_values = adopt_own(*new UsedValues(*ancestor_used_values));
-            auto* cow_used_values_ptr = cow_used_values.ptr();
-            used_values_per_layout_node.set(node, move(cow_used_values));
-            return *cow_used_values_ptr;
-        }
+    if (auto layout_index = node.layout_index(); layout_index.has_value() && *layout_index < m_used_values_by_layout_index.size()) {
+        if (auto* used_values = m_used_values_by_layout_index[*layout_index])
+            return used_values;
     }
+    return const_cast<UsedValues*>(used_values_per_layout_node.get(node).value_or(nullptr));
+}
 
+LayoutState::UsedValues& LayoutState::create_used_values(NodeWithStyle const& node)
+{
     auto const* containing_block_used_values = node.is_viewport() ? nullptr : &get(*node.containing_block());
 
+    if (auto layout_index = node.layout_index(); !m_parent && layout_index.has_value()) {
+        if (*layout_index >= m_used_values_by_layout_index.size())
+            m_used_values_by_layout_index.resize(*layout_index + 1);
+        m_used_values_arena.append(UsedValues {});
+        auto& used_values = m_used_values_arena.at(m_used_values_arena.size() - 1);
+        used_values.set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
+        m_used_values_by_layout_index[*layout_index] = &used_values;
+        return used_values;
+    }
+
     auto new_used_values = adopt_own(*new UsedValues);
-    auto* new_used_values_ptr = new_used_values.ptr();
     new_used_values->set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
-    used_values_per_layout_node.set(node, move(new_used_values));
-    return *new_used_values_ptr;
+    return store_used_values(node, move(new_used_values));
+}
+
+LayoutState::UsedValues& LayoutState::store_used_values(NodeWithStyle const& node, NonnullOwnPtr<UsedValues> used_values)
+{
+    auto* used_values_ptr = used_values.ptr();
+    used_values_per_layout_node.set(node, move(used_values));
+    return *used_values_ptr;
+}
+
+LayoutState::UsedValues& LayoutState::get_mutable(NodeWithStyle const& node)
+{
+    if (auto* used_values = find_used_values(node))
+        return *used_values;
+
+    for (auto const* ancestor = m_parent; ancestor; ancestor = ancestor->m_parent) {
+        if (auto* ancestor_used_values = ancestor->find_used_values(node))
+            return store_used_values(node, adopt_own(*new UsedValues(*ancestor_used_values)));
+    }
+
+    return create_used_values(node);
 }
 
 LayoutState::UsedValues const& LayoutState::get(NodeWithStyle const& node) const
 {
-    if (auto const* used_values = used_values_per_layout_node.get(node).value_or(nullptr))
+    if (auto const* used_values = find_used_values(node))
         return *used_values;
 
     for (auto const* ancestor = m_parent; ancestor; ancestor = ancestor->m_parent) {
-        if (auto const* ancestor_used_values = ancestor->used_values_per_layout_node.get(node).value_or(nullptr))
+        if (auto const* ancestor_used_values = ancestor->find_used_values(node))
             return *ancestor_used_values;
     }
 
-    auto const* containing_block_used_values = node.is_viewport() ? nullptr : &get(*node.containing_block());
-
-    auto new_used_values = adopt_own(*new UsedValues);
-    auto* new_used_values_ptr = new_used_values.ptr();
-    new_used_values->set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
-    const_cast<LayoutState*>(this)->used_values_per_layout_node.set(node, move(new_used_values));
-    return *new_used_values_ptr;
+    return const_cast<LayoutState*>(this)->create_used_values(node);
 }
 
 // https://www.w3.org/TR/css-overflow-3/#scrollable-overflow
@@ -159,15 +179,14 @@ void LayoutState::resolve_relative_positions()
 {
     // This function resolves relative position offsets of fragments that belong to inline paintables.
     // It runs *after* the paint tree has been constructed, so it modifies paintable node & fragment offsets directly.
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for_each_used_values([&](UsedValues& used_values) {
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
         auto* paintable = node.paintable();
         if (!paintable)
-            continue;
+            return;
         if (!is<Painting::InlinePaintable>(*paintable))
-            continue;
+            return;
 
         auto const& inline_paintable = static_cast<Painting::InlinePaintable&>(*paintable);
         for (auto& fragment : inline_paintable.fragments()) {
@@ -189,7 +208,7 @@ void LayoutState::resolve_relative_positions()
             }
             const_cast<Painting::PaintableFragment&>(fragment).set_offset(fragment.offset().translated(offset));
         }
-    }
+    });
 }
 
 static void build_paint_tree(Node& node, Painting::Paintable* parent_paintable = nullptr)
@@ -210,6 +229,25 @@ static void build_paint_tree(Node& node, Painting::Paintable* parent_paintable =
     }
 }
 
+struct ResizeObservedBoxSizes {
+    CSSPixelSize content_size;
+    CSSPixelSize border_box_size;
+
+    static ResizeObservedBoxSizes of(Painting::PaintableBox const* paintable_box)
+    {
+        if (!paintable_box)
+            return {};
+        return { paintable_box->content_size(), { paintable_box->border_box_width(), paintable_box->border_box_height() } };
+    }
+
+    bool operator==(ResizeObservedBoxSizes const&) const = default;
+};
+
+struct ResizeObservedElement {
+    JS::NonnullGCPtr<DOM::Element> element;
+    ResizeObservedBoxSizes old_box_sizes;
+};
+
 void LayoutState::commit(Box& root)
 {
     // Only the top-level LayoutState should ever be committed.
@@ -222,7 +260,13 @@ void LayoutState::commit(Box& root)
         node.set_paintable(nullptr);
         return TraversalDecision::Continue;
     });
+
+    // NOTE: We remember the old box sizes of elements that are observed by a ResizeObserver, so that we can tell them
+    //       whether layout changed their box size once the new paint tree is in place.
+    Vector<ResizeObservedElement> resize_observed_elements;
     root.document().for_each_shadow_including_inclusive_descendant([&](DOM::Node& node) {
+        if (is<DOM::Element>(node) && static_cast<DOM::Element&>(node).is_observed_by_resize_observer())
+            resize_observed_elements.append({ static_cast<DOM::Element&>(node), ResizeObservedBoxSizes::of(node.paintable_box()) });
         node.set_paintable(nullptr);
         return TraversalDecision::Continue;
     });
@@ -231,8 +275,7 @@ void LayoutState::commit(Box& root)
 
     Vector<Painting::PaintableWithLines&> paintables_with_lines;
 
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for_each_used_values([&](UsedValues& used_values) {
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
         if (is<NodeWithStyleAndBoxModelMetrics>(node)) {
@@ -284,17 +327,16 @@ void LayoutState::commit(Box& root)
                 paintable_box.set_used_values_for_grid_template_rows(used_values.grid_template_rows());
             }
         }
-    }
+    });
 
     // Resolve relative positions for regular boxes (not line box fragments):
     // NOTE: This needs to occur before fragments are transferred into the corresponding inline paintables, because
     //       after this transfer, the containing_line_box_fragment will no longer be valid.
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for_each_used_values([&](UsedValues& used_values) {
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
         if (!node.is_box())
-            continue;
+            return;
 
         auto& paintable = static_cast<Painting::PaintableBox&>(*node.paintable());
         CSSPixelPoint offset;
@@ -320,7 +362,7 @@ void LayoutState::commit(Box& root)
             offset.translate_by(inset.left, inset.top);
         }
         paintable.set_offset(offset);
-    }
+    });
 
     // Make a pass over all the line boxes to:
     // - Collect all text nodes, so we can create paintables for them later.
@@ -368,10 +410,9 @@ void LayoutState::commit(Box& root)
     resolve_relative_positions();
 
     // Measure overflow in scroll containers.
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for_each_used_values([&](UsedValues& used_values) {
         if (!used_values.node().is_box())
-            continue;
+            return;
         auto const& box = static_cast<Layout::Box const&>(used_values.node());
         measure_scrollable_overflow(box);
 
@@ -381,12 +422,11 @@ void LayoutState::commit(Box& root)
         auto& paintable_box = const_cast<Painting::PaintableBox&>(*box.paintable_box());
         if (!paintable_box.scroll_offset().is_zero())
             paintable_box.set_scroll_offset(paintable_box.scroll_offset());
-    }
+    });
 
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for_each_used_values([&](UsedValues& used_values) {
         if (!used_values.node().is_box())
-            continue;
+            return;
         auto const& box = static_cast<Layout::Box const&>(used_values.node());
 
         auto& paintable_box = const_cast<Painting::PaintableBox&>(*box.paintable_box());
@@ -418,6 +458,11 @@ void LayoutState::commit(Box& root)
             }
             paintable_box.set_sticky_insets(move(sticky_insets));
         }
+    });
+
+    for (auto& [element, old_box_sizes] : resize_observed_elements) {
+        if (ResizeObservedBoxSizes::of(element->paintable_box()) != old_box_sizes)
+            element->did_change_box_size();
     }
 }
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/SegmentedVector.h>
 #include <LibGfx/Path.h>
 #include <LibGfx/Point.h>
 #include <LibWeb/Layout/Box.h>
@@ -226,25 +227,35 @@ struct LayoutState {
     // NOTE: get() will not CoW the UsedValues.
     UsedValues const& get(NodeWithStyle const&) const;
 
-    HashMap<JS::NonnullGCPtr<Layout::Node const>, NonnullOwnPtr<UsedValues>> used_values_per_layout_node;
-
-    // We cache intrinsic sizes once determined, as they will not change over the course of a full layout.
-    // This avoids computing them several times while performing flex layout.
-    struct IntrinsicSizes {
-        Optional<CSSPixels> min_content_width;
-        Optional<CSSPixels> max_content_width;
-
-        HashMap<CSSPixels, Optional<CSSPixels>> min_content_height;
-        HashMap<CSSPixels, Optional<CSSPixels>> max_content_height;
-    };
+    template<typename Callback>
+    void for_each_used_values(Callback callback)
+    {
+        for (auto* used_values : m_used_values_by_layout_index) {
+            if (used_values)
+                callback(*used_values);
+        }
+        for (auto& it : used_values_per_layout_node)
+            callback(*it.value);
+    }
 
-    HashMap<JS::GCPtr<NodeWithStyle const>, NonnullOwnPtr<IntrinsicSizes>> mutable intrinsic_sizes;
+    // NOTE: Nested states only ever touch a handful of nodes, so they keep their used values in a hash map.
+    //       The root state stores the used values of nodes with a layout index densely instead, see below.
+    HashMap<JS::NonnullGCPtr<Layout::Node const>, NonnullOwnPtr<UsedValues>> used_values_per_layout_node;
 
     LayoutState const* m_parent { nullptr };
     LayoutState const& m_root;
 
 private:
     void resolve_relative_positions();
+
+    UsedValues* find_used_values(NodeWithStyle const&) const;
+    UsedValues& create_used_values(NodeWithStyle const&);
+    UsedValues& store_used_values(NodeWithStyle const&, NonnullOwnPtr<UsedValues>);
+
+    // NOTE: The used values of the root state live in one arena and are looked up by the node's layout index,
+    //       which turns lookups into array reads and frees everything in one go when the layout is done.
+    SegmentedVector<UsedValues, 256> m_used_values_arena;
+    Vector<UsedValues*> m_used_values_by_layout_index;
 };
 
 }
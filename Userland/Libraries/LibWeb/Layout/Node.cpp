@@ -87,6 +87,13 @@ bool Node::can_contain_boxes_with_position_absolute() const
     if (!computed_values().transformations().is_empty())
         return true;
 
+    // https://drafts.csswg.org/css-contain-2/#containment-layout
+    // https://drafts.csswg.org/css-contain-2/#containment-paint
+    // The element acts as a containing block for absolutely positioned and fixed-position descendants.
+    // FIXME: Fixed-position descendants don't use it yet.
+    if (is<Box>(*this) && (static_cast<Box const&>(*this).has_layout_containment() || static_cast<Box const&>(*this).has_paint_containment()))
+        return true;
+
     return false;
 }
 
@@ -201,6 +208,12 @@ bool Node::establishes_stacking_context() const
     if (computed_values().mask().has_value() || computed_values().clip_path().has_value())
         return true;
 
+    // https://drafts.csswg.org/css-contain-2/#containment-layout
+    // https://drafts.csswg.org/css-contain-2/#containment-paint
+    // The element forms a stacking context.
+    if (is<Box>(*this) && (static_cast<Box const&>(*this).has_layout_containment() || static_cast<Box const&>(*this).has_paint_containment()))
+        return true;
+
     return computed_values().opacity() < 1.0f;
 }
 
@@ -636,6 +649,10 @@ void NodeWithStyle::apply_style(const CSS::StyleProperties& computed_style)
     if (content_visibility.has_value())
         computed_values.set_content_visibility(content_visibility.value());
 
+    computed_values.set_contain(computed_style.contain());
+    computed_values.set_contain_intrinsic_width(computed_style.contain_intrinsic_size(CSS::PropertyID::ContainIntrinsicWidth));
+    computed_values.set_contain_intrinsic_height(computed_style.contain_intrinsic_size(CSS::PropertyID::ContainIntrinsicHeight));
+
     auto cursor = computed_style.cursor();
     if (cursor.has_value())
         computed_values.set_cursor(cursor.value());
@@ -1022,6 +1039,42 @@ void NodeWithStyle::transfer_table_box_computed_values_to_wrapper_computed_value
     reset_table_box_computed_values_used_by_wrapper_to_init_values();
 }
 
+void Node::set_needs_layout_update()
+{
+    if (m_needs_layout_update)
+        return;
+    m_needs_layout_update = true;
+
+    // NOTE: The cached layout results of this box and of any boxes generated for its pseudo-elements depend on
+    //       the change, and so do those of all its ancestors.
+    if (is<Box>(*this))
+        static_cast<Box const&>(*this).reset_layout_caches();
+    for_each_child_of_type<Box>([](Box& child) {
+        if (child.is_generated())
+            child.reset_layout_caches();
+        return IterationDecision::Continue;
+    });
+    for (Node* ancestor = parent(); ancestor && !ancestor->m_child_needs_layout_update; ancestor = ancestor->parent()) {
+        ancestor->m_child_needs_layout_update = true;
+        if (is<Box>(*ancestor))
+            static_cast<Box const&>(*ancestor).reset_layout_caches();
+    }
+
+    document().did_mark_layout_node_as_needing_layout_update({});
+}
+
+void Node::reset_needs_layout_update_in_subtree()
+{
+    m_needs_layout_update = false;
+    if (!m_child_needs_layout_update)
+        return;
+    m_child_needs_layout_update = false;
+    for_each_child([](Node& child) {
+        child.reset_needs_layout_update_in_subtree();
+        return IterationDecision::Continue;
+    });
+}
+
 void Node::set_paintable(JS::GCPtr<Painting::Paintable> paintable)
 {
     m_paintable = move(paintable);
@@ -162,6 +162,14 @@ public:
     bool children_are_inline() const { return m_children_are_inline; }
     void set_children_are_inline(bool value) { m_children_are_inline = value; }
 
+    // Assigned to every node in the layout tree before each layout, so that LayoutState can store used values densely.
+    Optional<u32> layout_index() const { return m_layout_index; }
+    void set_layout_index(u32 layout_index) { m_layout_index = layout_index; }
+
+    // Discards the cached layout results of the node and its ancestors, and schedules a layout.
+    void set_needs_layout_update();
+    void reset_needs_layout_update_in_subtree();
+
     u32 initial_quote_nesting_level() const { return m_initial_quote_nesting_level; }
     void set_initial_quote_nesting_level(u32 value) { m_initial_quote_nesting_level = value; }
 
@@ -194,6 +202,11 @@ private:
     bool m_has_style { false };
     bool m_children_are_inline { false };
 
+    Optional<u32> m_layout_index;
+
+    bool m_needs_layout_update { false };
+    bool m_child_needs_layout_update { false };
+
     bool m_is_flex_item { false };
     bool m_is_grid_item { false };
 
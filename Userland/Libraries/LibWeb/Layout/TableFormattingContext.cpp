@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <LibWeb/DOM/Node.h>
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/HTML/HTMLTableColElement.h>
@@ -103,6 +104,11 @@ void TableFormattingContext::compute_cell_measures()
 
     compute_constrainedness();
 
+    // In fixed mode, only the cells in the first row (and cells spanning multiple columns) contribute to the column widths.
+    // If no cell spans multiple rows, the row heights come from laying out each cell at its final width in compute_table_height(),
+    // so there's no need to measure the intrinsic sizes of the other cells, which is most of the work for large tables.
+    bool const can_skip_measuring_cells_outside_first_row = use_fixed_mode_layout() && all_of(m_cells, [](auto const& cell) { return cell.row_span == 1; });
+
     for (auto& cell : m_cells) {
         auto const& computed_values = cell.box->computed_values();
         CSSPixels padding_top = computed_values.padding().top().to_px(cell.box, containing_block.content_height());
@@ -118,6 +124,15 @@ void TableFormattingContext::compute_cell_measures()
         CSSPixels border_left = use_collapsing_borders_model ? round(cell_state.border_left / 2) : computed_values.border_left().width;
         CSSPixels border_right = use_collapsing_borders_model ? round(cell_state.border_right / 2) : computed_values.border_right().width;
 
+        if (can_skip_measuring_cells_outside_first_row && cell.row_index != 0 && cell.column_span == 1) {
+            auto min_height = computed_values.min_height().to_px(cell.box, containing_block.content_height());
+            auto height = computed_values.height().is_length() ? computed_values.height().to_px(cell.box, containing_block.content_height()) : 0;
+            auto cell_intrinsic_height_offsets = padding_top + padding_bottom + border_top + border_bottom;
+            cell.outer_min_height = min_height + cell_intrinsic_height_offsets;
+            cell.outer_max_height = max(min_height, height) + cell_intrinsic_height_offsets;
+            continue;
+        }
+
         auto min_content_width = calculate_min_content_width(cell.box);
         auto max_content_width = calculate_max_content_width(cell.box);
         auto min_content_height = calculate_min_content_height(cell.box, max_content_width);
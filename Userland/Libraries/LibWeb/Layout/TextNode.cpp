@@ -308,8 +308,13 @@ void TextNode::invalidate_text_for_rendering()
 
 String const& TextNode::text_for_rendering() const
 {
-    if (!m_text_for_rendering.has_value())
+    if (!m_text_for_rendering.has_value()) {
         const_cast<TextNode*>(this)->compute_text_for_rendering();
+        m_text_for_rendering_is_ascii = all_of(m_text_for_rendering->bytes(), [](auto byte) { return is_ascii(byte); });
+
+        if (m_grapheme_segmenter)
+            m_grapheme_segmenter->set_segmented_text(*m_text_for_rendering);
+    }
     return *m_text_for_rendering;
 }
 
@@ -406,8 +411,10 @@ TextNode::ChunkIterator::ChunkIterator(TextNode const& text_node, bool wrap_line
     , m_respect_linebreaks(respect_linebreaks)
     , m_utf8_view(text_node.text_for_rendering())
     , m_font_cascade_list(text_node.computed_values().font_list())
-    , m_grapheme_segmenter(text_node.grapheme_segmenter())
 {
+    // OPTIMIZATION: ASCII text is split into grapheme clusters without a segmenter, see next_without_peek().
+    if (!text_node.m_text_for_rendering_is_ascii)
+        m_grapheme_segmenter = &text_node.grapheme_segmenter();
 }
 
 static Gfx::GlyphRun::TextType text_type_for_code_point(u32 code_point)
@@ -479,7 +486,15 @@ Optional<TextNode::Chunk> TextNode::ChunkIterator::next_without_peek()
         return *m_utf8_view.iterator_at_byte_offset_without_validation(m_current_index);
     };
     auto next_grapheme_boundary = [this]() {
-        return m_grapheme_segmenter.next_boundary(m_current_index).value_or(m_utf8_view.byte_length());
+        if (!m_grapheme_segmenter) {
+            // Every ASCII code point is a grapheme cluster of its own, except for CR LF.
+            // https://www.unicode.org/reports/tr29/#GB3
+            auto text = m_utf8_view.as_string();
+            if (text[m_current_index] == '\r' && m_current_index + 1 < text.length() && text[m_current_index + 1] == '\n')
+                return m_current_index + 2;
+            return m_current_index + 1;
+        }
+        return m_grapheme_segmenter->next_boundary(m_current_index).value_or(m_utf8_view.byte_length());
     };
 
     auto code_point = current_code_point();
@@ -53,7 +53,7 @@ public:
         Utf8View m_utf8_view;
         Gfx::FontCascadeList const& m_font_cascade_list;
 
-        Unicode::Segmenter& m_grapheme_segmenter;
+        Unicode::Segmenter* m_grapheme_segmenter { nullptr };
         size_t m_current_index { 0 };
 
         Vector<Chunk> m_peek_queue;
@@ -70,6 +70,7 @@ private:
     virtual bool is_text_node() const final { return true; }
 
     Optional<String> m_text_for_rendering;
+    mutable bool m_text_for_rendering_is_ascii { false };
     mutable OwnPtr<Unicode::Segmenter> m_grapheme_segmenter;
 };
 
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BinarySearch.h>
+#include <AK/QuickSort.h>
 #include <AK/StringBuilder.h>
 #include <LibWeb/Loader/ContentFilter.h>
 
@@ -24,10 +26,56 @@ bool ContentFilter::is_filtered(const URL::URL& url) const
     if (url.scheme() == "data")
         return false;
 
-    auto url_string = url.to_byte_string();
+    if (!m_filtered_domains.is_empty()) {
+        if (auto const* host = url.host().get_pointer<String>(); host && is_filtered_domain(*host))
+            return true;
+    }
+
+    if (m_nodes.size() <= 1)
+        return false;
 
-    for (auto& pattern : m_patterns) {
-        if (url_string.find(pattern.text).has_value())
+    return contains_substring_pattern(url.to_byte_string());
+}
+
+bool ContentFilter::is_filtered_domain(StringView host) const
+{
+    // Look up the host itself, then each of its parent domains.
+    for (;;) {
+        if (m_filtered_domains.contains(host))
+            return true;
+
+        auto dot = host.find('.');
+        if (!dot.has_value())
+            return false;
+        host = host.substring_view(*dot + 1);
+    }
+}
+
+Optional<u32> ContentFilter::transition(u32 node, u8 byte) const
+{
+    auto const& transitions = m_transitions.span().slice(m_nodes[node].first_transition, m_nodes[node].transition_count);
+    auto const* found = binary_search(transitions, byte, nullptr, [](u8 byte, Transition const& transition) {
+        return static_cast<int>(byte) - static_cast<int>(transition.byte);
+    });
+    if (!found)
+        return {};
+    return found->target;
+}
+
+bool ContentFilter::contains_substring_pattern(StringView url) const
+{
+    u32 node = 0;
+    for (auto byte : url.bytes()) {
+        for (;;) {
+            if (auto next = transition(node, byte); next.has_value()) {
+                node = *next;
+                break;
+            }
+            if (node == 0)
+                break;
+            node = m_nodes[node].failure;
+        }
+        if (m_nodes[node].is_match)
             return true;
     }
     return false;
@@ -35,10 +83,83 @@ bool ContentFilter::is_filtered(const URL::URL& url) const
 
 ErrorOr<void> ContentFilter::set_patterns(ReadonlySpan<String> patterns)
 {
-    m_patterns.clear_with_capacity();
+    m_filtered_domains.clear();
+    m_nodes.clear_with_capacity();
+    m_transitions.clear_with_capacity();
+
+    // Build the trie of the substring patterns first, then lay out its transitions and compute the failure links.
+    Vector<Vector<Transition>> trie;
+    Vector<bool> ends_pattern;
+    TRY(trie.try_empend());
+    TRY(ends_pattern.try_append(false));
 
     for (auto const& pattern : patterns) {
-        TRY(m_patterns.try_empend(pattern));
+        auto text = pattern.bytes_as_string_view();
+
+        if (text.starts_with("||"sv)) {
+            auto domain = text.substring_view(2);
+            if (domain.ends_with('^'))
+                domain = domain.substring_view(0, domain.length() - 1);
+            if (!domain.is_empty() && !domain.contains('/')) {
+                TRY(m_filtered_domains.try_set(TRY(String::from_byte_string(domain.to_lowercase_string()))));
+                continue;
+            }
+        }
+
+        if (text.is_empty())
+            continue;
+
+        size_t node = 0;
+        for (auto byte : text.bytes()) {
+            auto existing = trie[node].find_if([&](auto const& transition) { return transition.byte == byte; });
+            if (existing != trie[node].end()) {
+                node = existing->target;
+                continue;
+            }
+
+            auto target = static_cast<u32>(trie.size());
+            TRY(trie[node].try_append({ byte, target }));
+            TRY(trie.try_empend());
+            TRY(ends_pattern.try_append(false));
+            node = target;
+        }
+        ends_pattern[node] = true;
+    }
+
+    TRY(m_nodes.try_resize(trie.size()));
+    for (size_t node = 0; node < trie.size(); ++node) {
+        quick_sort(trie[node], [](auto const& a, auto const& b) { return a.byte < b.byte; });
+        m_nodes[node].first_transition = m_transitions.size();
+        m_nodes[node].transition_count = trie[node].size();
+        m_nodes[node].is_match = ends_pattern[node];
+        TRY(m_transitions.try_extend(trie[node]));
+    }
+
+    // Every node's failure link points to the node of its longest proper suffix that is in the trie. Going through the
+    // nodes breadth-first makes sure the links of shorter prefixes are already known.
+    Vector<u32> queue;
+    TRY(queue.try_ensure_capacity(m_nodes.size()));
+    for (auto const& child : trie[0])
+        queue.unchecked_append(child.target);
+
+    for (size_t i = 0; i < queue.size(); ++i) {
+        auto node = queue[i];
+        for (auto const& child : trie[node]) {
+            auto failure = m_nodes[node].failure;
+            for (;;) {
+                if (auto next = transition(failure, child.byte); next.has_value()) {
+                    failure = *next;
+                    break;
+                }
+                if (failure == 0)
+                    break;
+                failure = m_nodes[failure].failure;
+            }
+
+            m_nodes[child.target].failure = failure;
+            m_nodes[child.target].is_match |= m_nodes[failure].is_match;
+            queue.unchecked_append(child.target);
+        }
     }
 
     return {};
@@ -6,12 +6,15 @@
 
 #pragma once
 
+#include <AK/HashTable.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 #include <LibURL/URL.h>
 
 namespace Web {
 
+// Patterns of the form "||example.com^" block the domain and all of its subdomains, and are looked up by the URL's
+// host. Any other pattern blocks every URL whose serialization contains it.
 class ContentFilter {
 public:
     static ContentFilter& the();
@@ -23,10 +26,28 @@ private:
     ContentFilter();
     ~ContentFilter();
 
-    struct Pattern {
-        String text;
+    bool is_filtered_domain(StringView host) const;
+    bool contains_substring_pattern(StringView url) const;
+
+    HashTable<String> m_filtered_domains;
+
+    // The substring patterns are matched with an Aho-Corasick automaton, so a URL is scanned only once, however many
+    // patterns there are. The transitions out of each node are stored next to each other, sorted by byte.
+    struct Transition {
+        u8 byte { 0 };
+        u32 target { 0 };
     };
-    Vector<Pattern> m_patterns;
+    struct Node {
+        u32 first_transition { 0 };
+        u32 transition_count { 0 };
+        u32 failure { 0 };
+        // Set if a pattern ends here, or at one of the nodes reached through the failure links.
+        bool is_match { false };
+    };
+    Optional<u32> transition(u32 node, u8 byte) const;
+
+    Vector<Node> m_nodes;
+    Vector<Transition> m_transitions;
 };
 
 }
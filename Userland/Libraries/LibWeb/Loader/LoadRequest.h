@@ -13,6 +13,7 @@
 #include <LibURL/URL.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/Page/Page.h>
+#include <RequestServer/RequestPriority.h>
 
 namespace Web {
 
@@ -40,6 +41,15 @@ public:
     ByteBuffer const& body() const { return m_body; }
     void set_body(ByteBuffer body) { m_body = move(body); }
 
+    // How urgently the response is needed. This decides when ResourceLoader starts the load, and how RequestServer
+    // weighs it against other loads on the same connection.
+    RequestServer::RequestPriority priority() const { return m_priority; }
+    void set_priority(RequestServer::RequestPriority priority) { m_priority = priority; }
+
+    // Which HTTP cache partition the response may be stored in and served from. Loads without one bypass the HTTP cache.
+    ByteString const& cache_partition() const { return m_cache_partition; }
+    void set_cache_partition(ByteString cache_partition) { m_cache_partition = move(cache_partition); }
+
     void start_timer() { m_load_timer.start(); }
     AK::Duration load_time() const { return m_load_timer.elapsed_time(); }
 
@@ -65,7 +75,7 @@ public:
             if (it.value != jt->value)
                 return false;
         }
-        return m_url == other.m_url && m_method == other.m_method && m_body == other.m_body;
+        return m_url == other.m_url && m_method == other.m_method && m_body == other.m_body && m_cache_partition == other.m_cache_partition;
     }
 
     void set_header(ByteString const& name, ByteString const& value) { m_headers.set(name, value); }
@@ -79,6 +89,8 @@ private:
     ByteString m_method { "GET" };
     HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> m_headers;
     ByteBuffer m_body;
+    RequestServer::RequestPriority m_priority { RequestServer::RequestPriority::Medium };
+    ByteString m_cache_partition;
     Core::ElapsedTimer m_load_timer;
     JS::Handle<Page> m_page;
     bool m_main_resource { false };
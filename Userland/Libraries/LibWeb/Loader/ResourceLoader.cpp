@@ -9,8 +9,10 @@
 #include <LibCore/DateTime.h>
 #include <LibCore/Directory.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibCore/MappedFile.h>
 #include <LibCore/MimeData.h>
 #include <LibCore/Resource.h>
+#include <LibCore/Tracing.h>
 #include <LibWeb/Cookie/Cookie.h>
 #include <LibWeb/Cookie/ParsedCookie.h>
 #include <LibWeb/Fetch/Infrastructure/URL.h>
@@ -167,8 +169,19 @@ static void log_request_start(LoadRequest const& request)
     dbgln_if(SPAM_DEBUG, "ResourceLoader: Starting load of: \"{}\"", url_for_logging);
 }
 
+static void trace_load(LoadRequest const& request)
+{
+    if (!Core::Tracing::is_enabled(Core::Tracing::Category::Fetch))
+        return;
+
+    auto end = MonotonicTime::now();
+    Core::Tracing::add_event(Core::Tracing::Category::Fetch, "ResourceLoader::load"sv, end - request.load_time(), end, sanitized_url_for_logging(request.url()));
+}
+
 static void log_success(LoadRequest const& request)
 {
+    trace_load(request);
+
     auto url_for_logging = sanitized_url_for_logging(request.url());
     auto load_time_ms = request.load_time().to_milliseconds();
 
@@ -178,6 +191,8 @@ static void log_success(LoadRequest const& request)
 template<typename ErrorType>
 static void log_failure(LoadRequest const& request, ErrorType const& error)
 {
+    trace_load(request);
+
     auto url_for_logging = sanitized_url_for_logging(request.url());
     auto load_time_ms = request.load_time().to_milliseconds();
 
@@ -357,7 +372,25 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
                 return;
             }
 
-            // Try to read file normally
+            auto path = URL::percent_decode(request.url().serialize_path());
+            auto response_headers = response_headers_for_file(path, st_or_error.value().st_mtime);
+
+            // Map regular files instead of reading them, so that large local files aren't copied into a buffer first.
+            // Empty files can't be mapped, and other kinds of files may not support it, so those are read normally.
+            if (S_ISREG(st_or_error.value().st_mode) && st_or_error.value().st_size > 0) {
+                auto mapped_file = Core::MappedFile::map_from_fd_and_close(fd, path);
+                if (mapped_file.is_error()) {
+                    log_failure(request, mapped_file.error());
+                    if (error_callback)
+                        error_callback(ByteString::formatted("{}", mapped_file.error()), {}, {}, {});
+                    return;
+                }
+
+                log_success(request);
+                success_callback(mapped_file.value()->bytes(), response_headers, {});
+                return;
+            }
+
             auto maybe_file = Core::File::adopt_fd(fd, Core::File::OpenMode::Read);
             if (maybe_file.is_error()) {
                 log_failure(request, maybe_file.error());
@@ -376,7 +409,6 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
             }
 
             auto data = maybe_data.release_value();
-            auto response_headers = response_headers_for_file(URL::percent_decode(request.url().serialize_path()), st_or_error.value().st_mtime);
 
             log_success(request);
             success_callback(data, response_headers, {});
@@ -392,44 +424,89 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
     }
 
     if (url.scheme() == "http" || url.scheme() == "https") {
-        auto protocol_request = start_network_request(request);
-        if (!protocol_request) {
-            if (error_callback)
-                error_callback("Failed to start network request"sv, {}, {}, {});
-            return;
-        }
-
-        if (timeout.has_value() && timeout.value() > 0) {
-            auto timer = Platform::Timer::create_single_shot(timeout.value(), nullptr);
-            timer->on_timeout = [timer, protocol_request, timeout_callback = move(timeout_callback)] {
-                protocol_request->stop();
-                if (timeout_callback)
-                    timeout_callback();
-            };
-            timer->start();
+        auto coalesce = can_coalesce_network_load(request, timeout);
+        if (coalesce) {
+            if (auto it = m_coalesced_network_loads.find(request); it != m_coalesced_network_loads.end()) {
+                dbgln_if(SPAM_DEBUG, "ResourceLoader: Coalescing load of {} with the one already in flight", url);
+                it->value.append({ request, move(success_callback), move(error_callback) });
+                return;
+            }
+            m_coalesced_network_loads.set(request, {});
         }
 
-        auto on_buffered_request_finished = [this, success_callback = move(success_callback), error_callback = move(error_callback), request, &protocol_request = *protocol_request](bool success, auto, auto& response_headers, auto status_code, ReadonlyBytes payload) mutable {
-            handle_network_response_headers(request, response_headers);
-            finish_network_request(protocol_request);
+        // Takes the loads that were coalesced with this one, so that they get the same response.
+        auto take_coalesced_loads = [this, coalesce](LoadRequest const& request) -> Vector<CoalescedNetworkLoad> {
+            if (!coalesce)
+                return {};
+            auto coalesced_loads = m_coalesced_network_loads.take(request);
+            if (!coalesced_loads.has_value())
+                return {};
+            return coalesced_loads.release_value();
+        };
 
-            if (!success || (status_code.has_value() && *status_code >= 400 && *status_code <= 599 && (payload.is_empty() || !request.is_main_resource()))) {
-                StringBuilder error_builder;
-                if (status_code.has_value())
-                    error_builder.appendff("Load failed: {}", *status_code);
-                else
-                    error_builder.append("Load failed"sv);
-                log_failure(request, error_builder.string_view());
+        schedule_network_load(request, [this, request, success_callback = move(success_callback), error_callback = move(error_callback), timeout, timeout_callback = move(timeout_callback), take_coalesced_loads]() mutable {
+            auto protocol_request = start_network_request(request);
+            if (!protocol_request) {
                 if (error_callback)
-                    error_callback(error_builder.to_byte_string(), status_code, payload, response_headers);
+                    error_callback("Failed to start network request"sv, {}, {}, {});
+                for (auto& coalesced_load : take_coalesced_loads(request)) {
+                    if (coalesced_load.error_callback)
+                        coalesced_load.error_callback("Failed to start network request"sv, {}, {}, {});
+                }
                 return;
             }
 
-            log_success(request);
-            success_callback(payload, response_headers, status_code);
-        };
+            if (timeout.has_value() && timeout.value() > 0) {
+                auto timer = Platform::Timer::create_single_shot(timeout.value(), nullptr);
+                timer->on_timeout = [this, timer, protocol_request, timeout_callback = move(timeout_callback)] {
+                    // Stopping the request drops its callbacks, so nothing else will tell us that it's done.
+                    if (protocol_request->stop())
+                        finish_network_request(*protocol_request);
+                    if (timeout_callback)
+                        timeout_callback();
+                };
+                timer->start();
+            }
 
-        protocol_request->set_buffered_request_finished_callback(move(on_buffered_request_finished));
+            auto on_buffered_request_finished = [this, success_callback = move(success_callback), error_callback = move(error_callback), request, take_coalesced_loads = move(take_coalesced_loads), &protocol_request = *protocol_request](bool success, auto, auto& response_headers, auto status_code, ReadonlyBytes payload) mutable {
+                handle_network_response_headers(request, response_headers);
+                finish_network_request(protocol_request);
+
+                // NOTE: The coalesced loads are taken before any callback runs, so that identical loads that are started
+                //       from within the callbacks go to the network again.
+                auto coalesced_loads = take_coalesced_loads(request);
+
+                if (!success || (status_code.has_value() && *status_code >= 400 && *status_code <= 599 && (payload.is_empty() || !request.is_main_resource()))) {
+                    StringBuilder error_builder;
+                    if (status_code.has_value())
+                        error_builder.appendff("Load failed: {}", *status_code);
+                    else
+                        error_builder.append("Load failed"sv);
+                    auto error = error_builder.to_byte_string();
+
+                    log_failure(request, error);
+                    if (error_callback)
+                        error_callback(error, status_code, payload, response_headers);
+
+                    for (auto& coalesced_load : coalesced_loads) {
+                        log_failure(coalesced_load.request, error);
+                        if (coalesced_load.error_callback)
+                            coalesced_load.error_callback(error, status_code, payload, response_headers);
+                    }
+                    return;
+                }
+
+                log_success(request);
+                success_callback(payload, response_headers, status_code);
+
+                for (auto& coalesced_load : coalesced_loads) {
+                    log_success(coalesced_load.request);
+                    coalesced_load.success_callback(payload, response_headers, status_code);
+                }
+            };
+
+            protocol_request->set_buffered_request_finished_callback(move(on_buffered_request_finished));
+        });
         return;
     }
 
@@ -457,34 +534,112 @@ void ResourceLoader::load_unbuffered(LoadRequest& request, OnHeadersReceived on_
         return;
     }
 
-    auto protocol_request = start_network_request(request);
-    if (!protocol_request) {
-        on_complete(false, "Failed to start network request"sv);
+    schedule_network_load(request, [this, request, on_headers_received = move(on_headers_received), on_data_received = move(on_data_received), on_complete = move(on_complete)]() mutable {
+        auto protocol_request = start_network_request(request);
+        if (!protocol_request) {
+            on_complete(false, "Failed to start network request"sv);
+            return;
+        }
+
+        auto protocol_headers_received = [this, on_headers_received = move(on_headers_received), request](auto const& response_headers, auto status_code) {
+            handle_network_response_headers(request, response_headers);
+            on_headers_received(response_headers, move(status_code));
+        };
+
+        auto protocol_data_received = [on_data_received = move(on_data_received)](auto data) {
+            on_data_received(data);
+        };
+
+        auto protocol_complete = [this, on_complete = move(on_complete), request, &protocol_request = *protocol_request](bool success, u64) {
+            finish_network_request(protocol_request);
+
+            if (success) {
+                log_success(request);
+                on_complete(true, {});
+            } else {
+                log_failure(request, "Request finished with error"sv);
+                on_complete(false, "Request finished with error"sv);
+            }
+        };
+
+        protocol_request->set_unbuffered_request_callbacks(move(protocol_headers_received), move(protocol_data_received), move(protocol_complete));
+    });
+}
+
+// Loads that rendering waits on, such as documents, style sheets and fonts.
+static bool is_critical_priority(RequestServer::RequestPriority priority)
+{
+    return priority <= RequestServer::RequestPriority::High;
+}
+
+// Loads that can wait, such as images. These are held back while critical loads are in flight, so they don't compete
+// with them for bandwidth.
+static bool is_delayable_priority(RequestServer::RequestPriority priority)
+{
+    return priority >= RequestServer::RequestPriority::Low;
+}
+
+static constexpr size_t max_delayable_loads_in_flight = 10;
+static constexpr size_t max_delayable_loads_in_flight_while_critical_loads_are = 1;
+
+bool ResourceLoader::can_start_network_load(RequestServer::RequestPriority priority) const
+{
+    if (!is_delayable_priority(priority))
+        return true;
+
+    auto limit = m_critical_loads_in_flight > 0 ? max_delayable_loads_in_flight_while_critical_loads_are : max_delayable_loads_in_flight;
+    return m_delayable_loads_in_flight < limit;
+}
+
+void ResourceLoader::schedule_network_load(LoadRequest const& request, StartNetworkLoad start)
+{
+    auto priority = request.priority();
+    if (can_start_network_load(priority)) {
+        start();
         return;
     }
 
-    auto protocol_headers_received = [this, on_headers_received = move(on_headers_received), request](auto const& response_headers, auto status_code) {
-        handle_network_response_headers(request, response_headers);
-        on_headers_received(response_headers, move(status_code));
-    };
+    dbgln_if(SPAM_DEBUG, "ResourceLoader: Deferring load of {} until {} critical and {} delayable loads have made room",
+        request.url(), m_critical_loads_in_flight, m_delayable_loads_in_flight);
 
-    auto protocol_data_received = [on_data_received = move(on_data_received)](auto data) {
-        on_data_received(data);
-    };
+    auto index = m_pending_network_loads.find_first_index_if([&](auto const& pending_load) {
+        return pending_load.priority > priority;
+    });
+    m_pending_network_loads.insert(index.value_or(m_pending_network_loads.size()), { priority, move(start) });
+}
 
-    auto protocol_complete = [this, on_complete = move(on_complete), request, &protocol_request = *protocol_request](bool success, u64) {
-        finish_network_request(protocol_request);
+void ResourceLoader::start_pending_network_loads()
+{
+    while (!m_pending_network_loads.is_empty() && can_start_network_load(m_pending_network_loads.first().priority)) {
+        auto pending_load = m_pending_network_loads.take_first();
+        pending_load.start();
+    }
+}
 
-        if (success) {
-            log_success(request);
-            on_complete(true, {});
-        } else {
-            log_failure(request, "Request finished with error"sv);
-            on_complete(false, "Request finished with error"sv);
-        }
-    };
+// Identical loads that are in flight at the same time, such as the same script or font being fetched by several
+// iframes, share a single network request. That is only done for requests that the HTTP cache could serve too.
+bool ResourceLoader::can_coalesce_network_load(LoadRequest const& request, Optional<u32> timeout)
+{
+    // Loads with a timeout would have to time out together.
+    if (timeout.has_value() && timeout.value() > 0)
+        return false;
+
+    // Main resources may display the body of an error response, so they are told apart from subresources on failure.
+    if (request.is_main_resource())
+        return false;
+
+    if (request.method() != "GET"sv || !request.body().is_empty())
+        return false;
+
+    // A request that asks to bypass the cache wants a response of its own.
+    for (auto const& [name, value] : request.headers()) {
+        if (name.equals_ignoring_ascii_case("Cache-Control"sv) && (value.contains("no-store"sv, CaseSensitivity::CaseInsensitive) || value.contains("no-cache"sv, CaseSensitivity::CaseInsensitive) || value.contains("max-age=0"sv, CaseSensitivity::CaseInsensitive)))
+            return false;
+        if (name.equals_ignoring_ascii_case("Pragma"sv) && value.contains("no-cache"sv, CaseSensitivity::CaseInsensitive))
+            return false;
+    }
 
-    protocol_request->set_unbuffered_request_callbacks(move(protocol_headers_received), move(protocol_data_received), move(protocol_complete));
+    return true;
 }
 
 RefPtr<ResourceLoaderConnectorRequest> ResourceLoader::start_network_request(LoadRequest const& request)
@@ -500,7 +655,7 @@ RefPtr<ResourceLoaderConnectorRequest> ResourceLoader::start_network_request(Loa
     if (!headers.contains("User-Agent"))
         headers.set("User-Agent", m_user_agent.to_byte_string());
 
-    auto protocol_request = m_connector->start_request(request.method(), request.url(), headers, request.body(), proxy);
+    auto protocol_request = m_connector->start_request(request.method(), request.url(), headers, request.body(), proxy, request.priority(), request.cache_partition());
     if (!protocol_request) {
         log_failure(request, "Failed to initiate load"sv);
         return nullptr;
@@ -511,10 +666,16 @@ RefPtr<ResourceLoaderConnectorRequest> ResourceLoader::start_network_request(Loa
     };
 
     ++m_pending_loads;
+    ++m_started_network_request_count;
     if (on_load_counter_change)
         on_load_counter_change();
 
-    m_active_requests.set(*protocol_request);
+    if (is_critical_priority(request.priority()))
+        ++m_critical_loads_in_flight;
+    else if (is_delayable_priority(request.priority()))
+        ++m_delayable_loads_in_flight;
+
+    m_active_requests.set(*protocol_request, request.priority());
     return protocol_request;
 }
 
@@ -537,19 +698,36 @@ void ResourceLoader::handle_network_response_headers(LoadRequest const& request,
 
 void ResourceLoader::finish_network_request(NonnullRefPtr<ResourceLoaderConnectorRequest> const& protocol_request)
 {
+    auto priority = m_active_requests.take(protocol_request);
+    if (!priority.has_value())
+        return;
+
     --m_pending_loads;
     if (on_load_counter_change)
         on_load_counter_change();
 
+    if (is_critical_priority(*priority))
+        --m_critical_loads_in_flight;
+    else if (is_delayable_priority(*priority))
+        --m_delayable_loads_in_flight;
+
+    // The request has to stay alive until its callbacks have returned, and whatever was waiting on it starts after that.
     Platform::EventLoopPlugin::the().deferred_invoke([this, protocol_request] {
-        m_active_requests.remove(protocol_request);
+        (void)protocol_request;
+        start_pending_network_loads();
     });
 }
 
-void ResourceLoader::clear_cache()
+size_t ResourceLoader::clear_cache()
 {
     dbgln_if(CACHE_DEBUG, "Clearing {} items from ResourceLoader cache", s_resource_cache.size());
+
+    size_t size = 0;
+    for (auto const& it : s_resource_cache)
+        size += it.value->encoded_data().size();
+
     s_resource_cache.clear();
+    return size;
 }
 
 void ResourceLoader::evict_from_cache(LoadRequest const& request)
@@ -18,6 +18,7 @@
 #include <LibWeb/Loader/Resource.h>
 #include <LibWeb/Loader/UserAgent.h>
 #include <LibWeb/Page/Page.h>
+#include <RequestServer/RequestPriority.h>
 
 namespace Web {
 
@@ -58,7 +59,7 @@ public:
     virtual void prefetch_dns(URL::URL const&) = 0;
     virtual void preconnect(URL::URL const&) = 0;
 
-    virtual RefPtr<ResourceLoaderConnectorRequest> start_request(ByteString const& method, URL::URL const&, HTTP::HeaderMap const& request_headers = {}, ReadonlyBytes request_body = {}, Core::ProxyData const& = {}) = 0;
+    virtual RefPtr<ResourceLoaderConnectorRequest> start_request(ByteString const& method, URL::URL const&, HTTP::HeaderMap const& request_headers = {}, ReadonlyBytes request_body = {}, Core::ProxyData const& = {}, RequestServer::RequestPriority = RequestServer::RequestPriority::Medium, ByteString const& cache_partition = {}) = 0;
     virtual RefPtr<Web::WebSockets::WebSocketClientSocket> websocket_connect(const URL::URL&, ByteString const& origin, Vector<ByteString> const& protocols) = 0;
 
 protected:
@@ -94,6 +95,9 @@ public:
 
     int pending_loads() const { return m_pending_loads; }
 
+    // The number of requests that were actually handed to the network, i.e. not served by a coalesced load.
+    u64 started_network_request_count() const { return m_started_network_request_count; }
+
     String const& user_agent() const { return m_user_agent; }
     void set_user_agent(String user_agent) { m_user_agent = move(user_agent); }
 
@@ -117,20 +121,48 @@ public:
     bool enable_do_not_track() const { return m_enable_do_not_track; }
     void set_enable_do_not_track(bool enable) { m_enable_do_not_track = enable; }
 
-    void clear_cache();
+    // Returns the number of bytes of encoded data that were dropped.
+    size_t clear_cache();
     void evict_from_cache(LoadRequest const&);
 
 private:
     ResourceLoader(NonnullRefPtr<ResourceLoaderConnector>);
     static ErrorOr<NonnullRefPtr<ResourceLoader>> try_create(NonnullRefPtr<ResourceLoaderConnector>);
 
+    using StartNetworkLoad = Function<void()>;
+    void schedule_network_load(LoadRequest const&, StartNetworkLoad);
+    void start_pending_network_loads();
+    bool can_start_network_load(RequestServer::RequestPriority) const;
+
+    static bool can_coalesce_network_load(LoadRequest const&, Optional<u32> timeout);
+
     RefPtr<ResourceLoaderConnectorRequest> start_network_request(LoadRequest const&);
     void handle_network_response_headers(LoadRequest const&, HTTP::HeaderMap const&);
     void finish_network_request(NonnullRefPtr<ResourceLoaderConnectorRequest> const&);
 
     int m_pending_loads { 0 };
+    u64 m_started_network_request_count { 0 };
+
+    HashMap<NonnullRefPtr<ResourceLoaderConnectorRequest>, RequestServer::RequestPriority> m_active_requests;
+    size_t m_critical_loads_in_flight { 0 };
+    size_t m_delayable_loads_in_flight { 0 };
+
+    // Network loads that were held back so they don't compete with more urgent ones, ordered by priority.
+    struct PendingNetworkLoad {
+        RequestServer::RequestPriority priority;
+        StartNetworkLoad start;
+    };
+    Vector<PendingNetworkLoad> m_pending_network_loads;
+
+    // Loads that were identical to one that was already in flight. They get the response of that load instead of
+    // going to the network themselves.
+    struct CoalescedNetworkLoad {
+        LoadRequest request;
+        SuccessCallback success_callback;
+        ErrorCallback error_callback;
+    };
+    HashMap<LoadRequest, Vector<CoalescedNetworkLoad>> m_coalesced_network_loads;
 
-    HashTable<NonnullRefPtr<ResourceLoaderConnectorRequest>> m_active_requests;
     NonnullRefPtr<ResourceLoaderConnector> m_connector;
     String m_user_agent;
     String m_platform;
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Runtime/Array.h>
+#include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/Bindings/PerformanceLongTaskTimingPrototype.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/HTML/HTMLIFrameElement.h>
+#include <LibWeb/HTML/HTMLObjectElement.h>
+#include <LibWeb/HTML/Navigable.h>
+#include <LibWeb/HTML/NavigableContainer.h>
+#include <LibWeb/HTML/Window.h>
+#include <LibWeb/HighResolutionTime/TimeOrigin.h>
+#include <LibWeb/LongTasks/PerformanceLongTaskTiming.h>
+#include <LibWeb/PerformanceTimeline/EntryTypes.h>
+
+namespace Web::LongTasks {
+
+JS_DEFINE_ALLOCATOR(PerformanceLongTaskTiming);
+
+// https://w3c.github.io/longtasks/#long-task
+static constexpr HighResolutionTime::DOMHighResTimeStamp long_task_threshold = 50;
+
+JS::NonnullGCPtr<PerformanceLongTaskTiming> PerformanceLongTaskTiming::create(JS::Realm& realm, String const& name, HighResolutionTime::DOMHighResTimeStamp start_time, HighResolutionTime::DOMHighResTimeStamp duration, ContainerAttribution container)
+{
+    auto attribution = realm.heap().allocate<TaskAttributionTiming>(realm, realm, move(container));
+    return realm.heap().allocate<PerformanceLongTaskTiming>(realm, realm, name, start_time, duration, attribution);
+}
+
+PerformanceLongTaskTiming::PerformanceLongTaskTiming(JS::Realm& realm, String const& name, HighResolutionTime::DOMHighResTimeStamp start_time, HighResolutionTime::DOMHighResTimeStamp duration, JS::NonnullGCPtr<TaskAttributionTiming> attribution)
+    : PerformanceTimeline::PerformanceEntry(realm, name, start_time, duration)
+    , m_attribution(attribution)
+{
+}
+
+PerformanceLongTaskTiming::~PerformanceLongTaskTiming() = default;
+
+FlyString const& PerformanceLongTaskTiming::entry_type() const
+{
+    return PerformanceTimeline::EntryTypes::longtask;
+}
+
+void PerformanceLongTaskTiming::initialize(JS::Realm& realm)
+{
+    Base::initialize(realm);
+    WEB_SET_PROTOTYPE_FOR_INTERFACE(PerformanceLongTaskTiming);
+}
+
+void PerformanceLongTaskTiming::visit_edges(JS::Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_attribution);
+}
+
+JS::NonnullGCPtr<JS::Object> PerformanceLongTaskTiming::attribution_js_array() const
+{
+    Vector<JS::Value> attribution { JS::Value(m_attribution.ptr()) };
+    auto array = JS::Array::create_from(realm(), attribution);
+    MUST(array->set_integrity_level(JS::Object::IntegrityLevel::Frozen));
+    return array;
+}
+
+// https://w3c.github.io/longtasks/#sec-TaskAttributionTiming
+static ContainerAttribution container_attribution_for(HTML::Navigable const& culprit_navigable)
+{
+    // NOTE: containerType is "window" for tasks that ran in a top-level document, all other attributes stay empty.
+    ContainerAttribution attribution { .type = "window"_string, .src = {}, .id = {}, .name = {} };
+
+    auto container = culprit_navigable.container();
+    if (!container)
+        return attribution;
+
+    if (container->id().has_value())
+        attribution.id = container->id()->to_string();
+    attribution.name = container->get_attribute_value(HTML::AttributeNames::name);
+
+    if (is<HTML::HTMLIFrameElement>(*container)) {
+        attribution.type = "iframe"_string;
+        attribution.src = container->get_attribute_value(HTML::AttributeNames::src);
+    } else if (is<HTML::HTMLObjectElement>(*container)) {
+        attribution.type = "object"_string;
+        attribution.src = container->get_attribute_value(HTML::AttributeNames::data);
+    }
+
+    return attribution;
+}
+
+// https://w3c.github.io/longtasks/#sec-PerformanceLongTaskTiming
+static String attribution_name(DOM::Document const& culprit, HTML::Navigable& culprit_navigable, DOM::Document const& destination, HTML::Navigable& destination_navigable)
+{
+    auto is_same_origin = culprit.origin().is_same_origin(destination.origin());
+
+    if (is_same_origin && &culprit_navigable == &destination_navigable)
+        return "self"_string;
+    if (is_same_origin && destination_navigable.is_ancestor_of(culprit_navigable))
+        return "same-origin-descendant"_string;
+    if (is_same_origin && culprit_navigable.is_ancestor_of(destination_navigable))
+        return "same-origin-ancestor"_string;
+    if (is_same_origin)
+        return "same-origin"_string;
+    if (culprit_navigable.is_ancestor_of(destination_navigable))
+        return "cross-origin-ancestor"_string;
+    if (destination_navigable.is_ancestor_of(culprit_navigable))
+        return "cross-origin-descendant"_string;
+    return "cross-origin-unreachable"_string;
+}
+
+// https://w3c.github.io/longtasks/#report-long-tasks
+void report_long_tasks(HighResolutionTime::DOMHighResTimeStamp start_time, HighResolutionTime::DOMHighResTimeStamp end_time, DOM::Document const* task_document)
+{
+    // 1. If end time minus start time is less than the long tasks threshold of 50 ms, abort these steps.
+    if (end_time - start_time < long_task_threshold)
+        return;
+
+    // FIXME: Tasks don't keep track of their script evaluation environment settings object set yet, so the task's
+    //        document stands in for it. A task without a document is attributed as "unknown", and has no top-level
+    //        browsing context to report to.
+    if (!task_document)
+        return;
+    auto culprit_navigable = task_document->navigable();
+    if (!culprit_navigable)
+        return;
+
+    // 2. Let destinationRealms be an empty set.
+    // 3. Determine the set of JavaScript Realms to which reports will be delivered:
+    //    For each top-level browsing context topmostBC in topmostBCs:
+    //    1. Add topmostBC's active document's relevant Realm to destinationRealms.
+    //    2. Let descendantBCs be topmostBC's active document's list of descendant browsing contexts.
+    //    3. For each descendantBC in descendantBCs, add descendantBC's active document's relevant Realm to destinationRealms.
+    auto top_level_document = culprit_navigable->top_level_traversable()->active_document();
+    if (!top_level_document)
+        return;
+
+    Vector<JS::Handle<DOM::Document>> destination_documents;
+    destination_documents.append(*top_level_document);
+    for (auto const& navigable : top_level_document->descendant_navigables()) {
+        if (auto document = navigable->active_document())
+            destination_documents.append(*document);
+    }
+
+    // 4. A user agent may remove some JavaScript Realms from destinationRealms.
+    // NOTE: Like other engines, we only report long tasks to realms that are same origin with the culprit.
+    destination_documents.remove_all_matching([&](auto const& document) {
+        return !document->origin().is_same_origin(task_document->origin());
+    });
+
+    auto container = container_attribution_for(*culprit_navigable);
+
+    // 5. For each destinationRealm in destinationRealms:
+    for (auto const& destination_document : destination_documents) {
+        auto window = destination_document->window();
+        auto destination_navigable = destination_document->navigable();
+        if (!window || !destination_navigable)
+            continue;
+
+        // 1. Let name be the empty string. This will be used to report minimal frame attribution, below.
+        // 2. Let culpritSettings be null.
+        // 3. Process task to determine name and culpritSettings.
+        auto name = attribution_name(*task_document, *culprit_navigable, *destination_document, *destination_navigable);
+
+        // 4. Create a new TaskAttributionTiming object attribution in destinationRealm.
+        // 5. Create a new PerformanceLongTaskTiming object newEntry in destinationRealm and set its attributes:
+        //    1. Set newEntry's name attribute to name.
+        //    2. Set newEntry's entryType attribute to "longtask".
+        //    3. Set newEntry's startTime attribute to the result of coarsening start time given destinationRealm.
+        //    4. Let dur be the result of coarsening end time given destinationRealm, minus newEntry's startTime.
+        //    5. Set newEntry's duration attribute to the integer part of dur.
+        //    6. Set newEntry's attribution attribute to a new frozen array containing the single value attribution.
+        auto entry_start_time = HighResolutionTime::relative_high_resolution_time(start_time, *window);
+        auto entry_end_time = HighResolutionTime::relative_high_resolution_time(end_time, *window);
+        auto new_entry = PerformanceLongTaskTiming::create(window->realm(), name, entry_start_time, trunc(entry_end_time - entry_start_time), container);
+
+        // 6. Queue the PerformanceEntry newEntry.
+        window->queue_performance_entry(new_entry);
+    }
+}
+
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/Bindings/TaskAttributionTimingPrototype.h>
+#include <LibWeb/LongTasks/TaskAttributionTiming.h>
+
+namespace Web::LongTasks {
+
+JS_DEFINE_ALLOCATOR(TaskAttributionTiming);
+
+// https://w3c.github.io/longtasks/#sec-TaskAttributionTiming
+// NOTE: The name of an attribution is always "unknown", its startTime and duration are always 0.
+TaskAttributionTiming::TaskAttributionTiming(JS::Realm& realm, ContainerAttribution container)
+    : PerformanceTimeline::PerformanceEntry(realm, "unknown"_string, 0, 0)
+    , m_container(move(container))
+{
+}
+
+TaskAttributionTiming::~TaskAttributionTiming() = default;
+
+FlyString const& TaskAttributionTiming::entry_type() const
+{
+    static auto const task_attribution = "taskattribution"_fly_string;
+    return task_attribution;
+}
+
+void TaskAttributionTiming::initialize(JS::Realm& realm)
+{
+    Base::initialize(realm);
+    WEB_SET_PROTOTYPE_FOR_INTERFACE(TaskAttributionTiming);
+}
+
+}
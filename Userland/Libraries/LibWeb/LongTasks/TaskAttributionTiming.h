@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibWeb/PerformanceTimeline/PerformanceEntry.h>
+
+namespace Web::LongTasks {
+
+struct ContainerAttribution {
+    String type;
+    String src;
+    String id;
+    String name;
+};
+
+// https://w3c.github.io/longtasks/#sec-TaskAttributionTiming
+class TaskAttributionTiming final : public PerformanceTimeline::PerformanceEntry {
+    WEB_PLATFORM_OBJECT(TaskAttributionTiming, PerformanceTimeline::PerformanceEntry);
+    JS_DECLARE_ALLOCATOR(TaskAttributionTiming);
+
+public:
+    virtual ~TaskAttributionTiming();
+
+    // NOTE: TaskAttributionTiming entries are never queued on their own, they only appear in the attribution of a
+    //       PerformanceLongTaskTiming entry.
+    virtual PerformanceTimeline::ShouldAddEntry should_add_entry(Optional<PerformanceTimeline::PerformanceObserverInit const&> = {}) const override { return PerformanceTimeline::ShouldAddEntry::No; }
+
+    virtual FlyString const& entry_type() const override;
+
+    String const& container_type() const { return m_container.type; }
+    String const& container_src() const { return m_container.src; }
+    String const& container_id() const { return m_container.id; }
+    String const& container_name() const { return m_container.name; }
+
+private:
+    friend class PerformanceLongTaskTiming;
+
+    TaskAttributionTiming(JS::Realm&, ContainerAttribution);
+
+    virtual void initialize(JS::Realm&) override;
+
+    ContainerAttribution m_container;
+};
+
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Font/FontDatabase.h>
+#include <LibJS/Heap/Heap.h>
+#include <LibWeb/Bindings/MainThreadVM.h>
+#include <LibWeb/Fetch/Fetching/Fetching.h>
+#include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
+#include <LibWeb/Loader/ResourceLoader.h>
+#include <LibWeb/Page/MemoryPressure.h>
+
+namespace Web {
+
+size_t MemoryPressureReport::total_bytes_reclaimed() const
+{
+    size_t total = 0;
+    for (auto const& entry : entries)
+        total += entry.bytes_reclaimed;
+    return total;
+}
+
+MemoryPressureReport handle_memory_pressure()
+{
+    MemoryPressureReport report;
+
+    auto bitmap_bytes_before = HTML::AnimatedBitmapDecodedImageData::resident_bitmap_bytes();
+    HTML::AnimatedBitmapDecodedImageData::discard_all_hidden_bitmaps();
+    auto bitmap_bytes_after = HTML::AnimatedBitmapDecodedImageData::resident_bitmap_bytes();
+    report.entries.append({ "Decoded images"sv, bitmap_bytes_before - bitmap_bytes_after });
+
+    report.entries.append({ "HTTP cache"sv, Fetch::Fetching::purge_http_cache() });
+
+    report.entries.append({ "Resource cache"sv, ResourceLoader::the().clear_cache() });
+
+    // Collect garbage after dropping the caches, so that whatever was only kept alive by them goes away too.
+    auto& heap = Bindings::main_thread_vm().heap();
+    heap.collect_garbage();
+    report.entries.append({ "JavaScript heap"sv, heap.last_collection_statistics().collected_cell_bytes });
+
+    report.entries.append({ "Glyph cache"sv, Gfx::FontDatabase::purge_glyph_caches() });
+
+    return report;
+}
+
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+
+namespace Web {
+
+struct MemoryPressureReport {
+    struct Entry {
+        StringView subsystem;
+        size_t bytes_reclaimed { 0 };
+    };
+
+    size_t total_bytes_reclaimed() const;
+
+    Vector<Entry> entries;
+};
+
+// Gives back as much memory as this process can do without, by dropping everything that can be loaded, decoded or
+// rasterized again when it's needed: out of view image bitmaps, cached responses, cached glyphs and garbage.
+// This is for when the system is running low on memory, as everything that's dropped is slow to get back.
+MemoryPressureReport handle_memory_pressure();
+
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashTable.h>
+#include <AK/JsonArray.h>
+#include <LibGfx/Font/FontDatabase.h>
+#include <LibJS/Heap/Heap.h>
+#include <LibJS/Heap/HeapBlock.h>
+#include <LibWeb/Bindings/MainThreadVM.h>
+#include <LibWeb/CSS/StyleProperties.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/Element.h>
+#include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
+#include <LibWeb/HTML/Navigable.h>
+#include <LibWeb/HTML/TraversableNavigable.h>
+#include <LibWeb/Layout/Viewport.h>
+#include <LibWeb/Page/MemoryReport.h>
+#include <LibWeb/Page/Page.h>
+#include <LibWeb/Painting/StackingContext.h>
+#include <LibWeb/Painting/ViewportPaintable.h>
+
+namespace Web {
+
+namespace {
+
+struct Usage {
+    size_t count { 0 };
+    size_t bytes { 0 };
+
+    void add_cell(JS::Cell const& cell)
+    {
+        ++count;
+        bytes += JS::HeapBlock::from_cell(&cell)->cell_size();
+    }
+
+    JsonObject to_json() const
+    {
+        JsonObject object;
+        object.set("count"sv, count);
+        object.set("bytes"sv, bytes);
+        return object;
+    }
+};
+
+}
+
+static JsonObject bytes_to_json(size_t bytes)
+{
+    JsonObject object;
+    object.set("bytes"sv, bytes);
+    return object;
+}
+
+static JsonObject page_memory_report(Page& page)
+{
+    Usage dom;
+    Usage style;
+    Usage layout;
+    Usage paint;
+    size_t display_list_bytes = 0;
+    HashTable<void const*> seen_style_data;
+
+    auto top_level_traversable = page.top_level_traversable();
+
+    for (auto* navigable : HTML::all_navigables()) {
+        if (navigable->traversable_navigable() != top_level_traversable)
+            continue;
+
+        auto document = navigable->active_document();
+        if (!document)
+            continue;
+
+        document->for_each_in_inclusive_subtree([&](DOM::Node const& node) {
+            dom.add_cell(node);
+            if (is<DOM::Element>(node)) {
+                if (auto const* computed_style = static_cast<DOM::Element const&>(node).computed_css_values()) {
+                    ++style.count;
+                    style.bytes += computed_style->memory_usage(seen_style_data);
+                }
+            }
+            return TraversalDecision::Continue;
+        });
+
+        if (auto* viewport = document->layout_node()) {
+            viewport->for_each_in_inclusive_subtree([&](Layout::Node const& node) {
+                layout.add_cell(node);
+                return TraversalDecision::Continue;
+            });
+        }
+
+        if (auto const* viewport_paintable = document->paintable()) {
+            viewport_paintable->for_each_in_inclusive_subtree([&](Painting::Paintable const& paintable) {
+                paint.add_cell(paintable);
+                if (auto const* stacking_context = paintable.stacking_context())
+                    display_list_bytes += stacking_context->cached_display_list_chunk_size_in_bytes();
+                return TraversalDecision::Continue;
+            });
+        }
+    }
+
+    JsonObject report;
+    report.set("dom"sv, dom.to_json());
+    report.set("style"sv, style.to_json());
+    report.set("layout"sv, layout.to_json());
+    report.set("paint"sv, paint.to_json());
+    report.set("display_lists"sv, bytes_to_json(display_list_bytes));
+    return report;
+}
+
+static JsonObject process_memory_report()
+{
+    JsonArray javascript_heap;
+    for (auto const& allocator : Bindings::main_thread_vm().heap().allocator_memory_usage()) {
+        JsonObject object;
+        if (allocator.class_name)
+            object.set("class_name"sv, allocator.class_name);
+        else
+            object.set("class_name"sv, ByteString::formatted("<size class {}>", allocator.cell_size));
+        object.set("cell_size"sv, allocator.cell_size);
+        object.set("live_cells"sv, allocator.live_cells);
+        object.set("live_bytes"sv, allocator.live_cells * allocator.cell_size);
+        object.set("block_bytes"sv, allocator.block_count * JS::HeapBlock::block_size);
+        javascript_heap.must_append(move(object));
+    }
+
+    JsonObject report;
+    report.set("javascript_heap"sv, move(javascript_heap));
+    report.set("decoded_images"sv, bytes_to_json(HTML::AnimatedBitmapDecodedImageData::resident_bitmap_bytes()));
+    auto glyph_cache_statistics = Gfx::FontDatabase::glyph_cache_statistics();
+    JsonObject glyph_cache;
+    glyph_cache.set("count"sv, glyph_cache_statistics.glyph_count);
+    glyph_cache.set("bytes"sv, glyph_cache_statistics.bytes);
+    glyph_cache.set("budget_bytes"sv, glyph_cache_statistics.budget_bytes);
+    report.set("glyph_cache"sv, move(glyph_cache));
+    return report;
+}
+
+JsonObject memory_report(Page& page)
+{
+    JsonObject report;
+    report.set("page"sv, page_memory_report(page));
+    report.set("process"sv, process_memory_report());
+    return report;
+}
+
+}
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/JsonObject.h>
+#include <LibWeb/Forward.h>
+
+namespace Web {
+
+// Reports how much memory the documents of a page take up, broken down by subsystem, along with what the process
+// as a whole is using for the JS heap, decoded images and fonts. Everything is counted as it is right now, so e.g.
+// garbage that hasn't been collected yet is included.
+//
+//     {
+//         "page": { "dom": { "count", "bytes" }, "style": ..., "layout": ..., "paint": ..., "display_lists": { "bytes" } },
+//         "process": { "javascript_heap": [ { "class_name", "cell_size", "live_cells", "live_bytes", "block_bytes" } ],
+//                      "decoded_images": { "bytes" }, "glyph_cache": { "count", "bytes", "budget_bytes" } }
+//     }
+JsonObject memory_report(Page&);
+
+}
@@ -279,6 +279,9 @@ struct PaintOptions {
     PaintOverlay paint_overlay { PaintOverlay::Yes };
     bool should_show_line_box_borders { false };
     bool has_focus { false };
+
+    // If set, only this part of the target is repainted. Everything outside of it must already be up to date.
+    Optional<DevicePixelRect> damage_rect;
 };
 
 enum class DisplayListPlayerType {
@@ -343,6 +346,10 @@ public:
     virtual String page_did_request_cookie(URL::URL const&, Cookie::Source) { return {}; }
     virtual void page_did_set_cookie(URL::URL const&, Cookie::ParsedCookie const&, Cookie::Source) { }
     virtual void page_did_update_cookie(Web::Cookie::Cookie) { }
+    virtual OrderedHashMap<String, String> page_did_request_local_storage_items(String const&) { return {}; }
+    virtual void page_did_set_local_storage_item(String const&, String const&, String const&) { }
+    virtual void page_did_remove_local_storage_item(String const&, String const&) { }
+    virtual void page_did_clear_local_storage(String const&) { }
     virtual void page_did_update_resource_count(i32) { }
     struct NewWebViewResult {
         JS::GCPtr<Page> page;
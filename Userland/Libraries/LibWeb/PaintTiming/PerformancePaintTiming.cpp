@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/Bindings/PerformancePaintTimingPrototype.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/HTML/HTMLCanvasElement.h>
+#include <LibWeb/HTML/HTMLVideoElement.h>
+#include <LibWeb/HTML/Window.h>
+#include <LibWeb/HighResolutionTime/TimeOrigin.h>
+#include <LibWeb/Layout/CanvasBox.h>
+#include <LibWeb/Layout/ImageBox.h>
+#include <LibWeb/Layout/ImageProvider.h>
+#include <LibWeb/Layout/VideoBox.h>
+#include <LibWeb/PaintTiming/PerformancePaintTiming.h>
+#include <LibWeb/Painting/InlinePaintable.h>
+#include <LibWeb/Painting/SVGPathPaintable.h>
+#include <LibWeb/Painting/SVGSVGPaintable.h>
+#include <LibWeb/Painting/ViewportPaintable.h>
+#include <LibWeb/PerformanceTimeline/EntryTypes.h>
+
+namespace Web::PaintTiming {
+
+JS_DEFINE_ALLOCATOR(PerformancePaintTiming);
+
+PerformancePaintTiming::PerformancePaintTiming(JS::Realm& realm, String const& name, HighResolutionTime::DOMHighResTimeStamp start_time)
+    : PerformanceTimeline::PerformanceEntry(realm, name, start_time, 0)
+{
+}
+
+PerformancePaintTiming::~PerformancePaintTiming() = default;
+
+FlyString const& PerformancePaintTiming::entry_type() const
+{
+    return PerformanceTimeline::EntryTypes::paint;
+}
+
+void PerformancePaintTiming::initialize(JS::Realm& realm)
+{
+    Base::initialize(realm);
+    WEB_SET_PROTOTYPE_FOR_INTERFACE(PerformancePaintTiming);
+}
+
+static bool has_contentful_text(Vector<Painting::PaintableFragment> const& fragments, CSSPixelRect const& viewport_rect)
+{
+    for (auto const& fragment : fragments) {
+        if (!fragment.layout_node().is_text_node() || !fragment.paintable().is_visible())
+            continue;
+        if (fragment.string_view().is_whitespace() || !fragment.absolute_rect().intersects(viewport_rect))
+            continue;
+        return true;
+    }
+    return false;
+}
+
+// https://w3c.github.io/paint-timing/#contentful
+static bool is_contentful(Painting::PaintableBox const& paintable_box)
+{
+    auto const& layout_node = paintable_box.layout_node();
+
+    // - target is a replaced element representing an available image.
+    if (is<Layout::ImageBox>(layout_node))
+        return static_cast<Layout::ImageBox const&>(layout_node).image_provider().is_image_available();
+
+    // - target is a canvas with its context mode set to any value other than none.
+    if (is<Layout::CanvasBox>(layout_node))
+        return static_cast<Layout::CanvasBox const&>(layout_node).dom_node().bitmap() != nullptr;
+
+    // - target is a video element that represents its poster frame or the first video frame and the frame is available.
+    if (is<Layout::VideoBox>(layout_node)) {
+        auto const& video_element = static_cast<Layout::VideoBox const&>(layout_node).dom_node();
+        return video_element.current_frame().frame || video_element.poster_frame();
+    }
+
+    // - target is an svg element with rendered descendants.
+    if (is<Painting::SVGSVGPaintable>(paintable_box)) {
+        bool has_rendered_descendants = false;
+        paintable_box.for_each_in_subtree_of_type<Painting::SVGPathPaintable>([&](auto const&) {
+            has_rendered_descendants = true;
+            return TraversalDecision::Break;
+        });
+        return has_rendered_descendants;
+    }
+
+    // - target is an element with a contentful background-image.
+    for (auto const& layer : paintable_box.computed_values().background_layers()) {
+        if (layer.background_image && layer.background_image->is_paintable())
+            return true;
+    }
+
+    return false;
+}
+
+struct PaintedContent {
+    bool has_non_default_content { false };
+    bool has_contentful_content { false };
+};
+
+// NOTE: Only what is visible and intersects the viewport counts as painted, as described by "paintable":
+//       https://w3c.github.io/paint-timing/#paintable
+static PaintedContent determine_painted_content(Painting::ViewportPaintable const& viewport_paintable, CSSPixelRect const& viewport_rect)
+{
+    PaintedContent content;
+
+    viewport_paintable.for_each_in_subtree_of_type<Painting::PaintableBox>([&](auto const& paintable_box) {
+        // - target has a text node child, representing non-empty text, and the node's used opacity is greater than zero.
+        if (is<Painting::PaintableWithLines>(paintable_box) && has_contentful_text(static_cast<Painting::PaintableWithLines const&>(paintable_box).fragments(), viewport_rect))
+            content.has_contentful_content = true;
+
+        if (!content.has_contentful_content && paintable_box.is_visible() && paintable_box.absolute_rect().intersects(viewport_rect)) {
+            if (is_contentful(paintable_box))
+                content.has_contentful_content = true;
+
+            // NOTE: First paint excludes the default background paint, but includes non-default background paint.
+            if (paintable_box.computed_values().background_color().alpha() > 0)
+                content.has_non_default_content = true;
+        }
+
+        if (content.has_contentful_content) {
+            content.has_non_default_content = true;
+            return TraversalDecision::Break;
+        }
+        return TraversalDecision::Continue;
+    });
+
+    // Text in inline elements is held by their InlinePaintable rather than by the containing block.
+    if (!content.has_contentful_content) {
+        viewport_paintable.for_each_in_subtree_of_type<Painting::InlinePaintable>([&](auto const& inline_paintable) {
+            if (!has_contentful_text(inline_paintable.fragments(), viewport_rect))
+                return TraversalDecision::Continue;
+            content.has_non_default_content = true;
+            content.has_contentful_content = true;
+            return TraversalDecision::Break;
+        });
+    }
+
+    return content;
+}
+
+// https://w3c.github.io/paint-timing/#report-paint-timing
+static void report_paint_timing(DOM::Document& document, FlyString const& paint_type, HighResolutionTime::DOMHighResTimeStamp paint_timestamp)
+{
+    auto& window = *document.window();
+    auto& realm = window.realm();
+
+    // 1. Create a new PerformancePaintTiming object newEntry with document's relevant realm and set its attributes as
+    //    follows:
+    //    1. Set newEntry's name attribute to paintType.
+    //    2. Set newEntry's entryType attribute to "paint".
+    //    3. Set newEntry's startTime attribute to paintTimestamp.
+    //    4. Set newEntry's duration attribute to 0.
+    auto new_entry = realm.heap().allocate<PerformancePaintTiming>(realm, realm, paint_type.to_string(), paint_timestamp);
+
+    // 2. Queue the PerformanceEntry newEntry.
+    window.queue_performance_entry(new_entry);
+
+    // 3. Append paintType to the document's set of previously reported paints.
+    document.previously_reported_paints().set(paint_type);
+}
+
+// https://w3c.github.io/paint-timing/#mark-paint-timing
+void mark_paint_timing(DOM::Document& document)
+{
+    static auto const first_paint = "first-paint"_fly_string;
+    static auto const first_contentful_paint = "first-contentful-paint"_fly_string;
+
+    auto& reported_paints = document.previously_reported_paints();
+    if (reported_paints.contains(first_contentful_paint))
+        return;
+
+    auto const* viewport_paintable = document.paintable();
+    if (!viewport_paintable || !document.window() || !document.navigable())
+        return;
+
+    // 1. Let paintTimestamp be the current high resolution time given document's relevant global object.
+    auto paint_timestamp = HighResolutionTime::current_high_resolution_time(*document.window());
+
+    auto content = determine_painted_content(*viewport_paintable, document.viewport_rect());
+
+    // 2. If reportedPaints does not contain "first-paint", and the user agent is configured to mark first paint, then
+    //    report paint timing given document, "first-paint", and paintTimestamp.
+    if (!reported_paints.contains(first_paint) && content.has_non_default_content)
+        report_paint_timing(document, first_paint, paint_timestamp);
+
+    // 3. If document should report first contentful paint, then report paint timing given document,
+    //    "first-contentful-paint", and paintTimestamp.
+    if (content.has_contentful_content)
+        report_paint_timing(document, first_contentful_paint, paint_timestamp);
+}
+
+}
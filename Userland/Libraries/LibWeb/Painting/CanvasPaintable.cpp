@@ -36,11 +36,10 @@ void CanvasPaintable::paint(PaintContext& context, PaintPhase phase) const
         auto canvas_rect = context.rounded_device_rect(absolute_rect());
         ScopedCornerRadiusClip corner_clip { context, canvas_rect, normalized_border_radii_data(ShrinkRadiiForBorders::Yes) };
 
-        if (layout_box().dom_node().bitmap()) {
-            // FIXME: Remove this const_cast.
-            const_cast<HTML::HTMLCanvasElement&>(layout_box().dom_node()).present();
-            auto scaling_mode = to_gfx_scaling_mode(computed_values().image_rendering(), layout_box().dom_node().bitmap()->rect(), canvas_rect.to_type<int>());
-            context.display_list_recorder().draw_scaled_bitmap(canvas_rect.to_type<int>(), *layout_box().dom_node().bitmap(), layout_box().dom_node().bitmap()->rect(), scaling_mode);
+        // FIXME: Remove this const_cast.
+        if (auto snapshot = const_cast<HTML::HTMLCanvasElement&>(layout_box().dom_node()).snapshot()) {
+            auto scaling_mode = to_gfx_scaling_mode(computed_values().image_rendering(), snapshot->rect(), canvas_rect.to_type<int>());
+            context.display_list_recorder().draw_scaled_immutable_bitmap(canvas_rect.to_type<int>(), *snapshot, snapshot->rect(), scaling_mode);
         }
     }
 }
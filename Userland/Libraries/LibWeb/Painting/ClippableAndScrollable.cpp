@@ -30,6 +30,16 @@ CSSPixelPoint ClippableAndScrollable::cumulative_offset_of_enclosing_scroll_fram
     return {};
 }
 
+Optional<CSSPixelRect> ClippableAndScrollable::absolute_rect_to_viewport_rect(CSSPixelRect rect) const
+{
+    if (!m_combined_css_transform.is_identity_or_translation())
+        return {};
+    auto translation = m_combined_css_transform.translation();
+    rect.translate_by(CSSPixels::nearest_value_for(translation.x()), CSSPixels::nearest_value_for(translation.y()));
+    rect.translate_by(cumulative_offset_of_enclosing_scroll_frame());
+    return rect;
+}
+
 Optional<CSSPixelRect> ClippableAndScrollable::clip_rect_for_hit_testing() const
 {
     if (m_enclosing_clip_frame)
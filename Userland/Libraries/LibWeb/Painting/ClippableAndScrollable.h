@@ -23,6 +23,10 @@ public:
     [[nodiscard]] CSSPixelPoint cumulative_offset_of_enclosing_scroll_frame() const;
     [[nodiscard]] Optional<CSSPixelRect> clip_rect_for_hit_testing() const;
 
+    // Maps a rect in absolute coordinates to where it ends up on screen, relative to the viewport and ignoring clips.
+    // Returns nothing if that can't be determined cheaply, i.e. if the CSS transforms involved aren't plain translations.
+    [[nodiscard]] Optional<CSSPixelRect> absolute_rect_to_viewport_rect(CSSPixelRect) const;
+
     [[nodiscard]] RefPtr<ScrollFrame const> own_scroll_frame() const { return m_own_scroll_frame; }
     [[nodiscard]] Optional<int> own_scroll_frame_id() const;
     [[nodiscard]] CSSPixelPoint own_scroll_frame_offset() const
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibGfx/Matrix4x4.h>
 #include <LibWeb/Painting/DisplayList.h>
 
 namespace Web::Painting {
@@ -13,6 +14,22 @@ void DisplayList::append(Command&& command, Optional<i32> scroll_frame_id)
     m_commands.append({ scroll_frame_id, move(command) });
 }
 
+void DisplayList::append_commands(ReadonlySpan<CommandListItem> commands)
+{
+    for (auto const& item : commands) {
+        auto command = item.command;
+        m_commands.append({ item.scroll_frame_id, move(command) });
+    }
+}
+
+void DisplayList::copy_commands_into(Vector<CommandListItem>& commands, size_t start_index, size_t end_index) const
+{
+    VERIFY(start_index <= end_index && end_index <= m_commands.size());
+    commands.ensure_capacity(commands.size() + end_index - start_index);
+    for (size_t i = start_index; i < end_index; ++i)
+        commands.unchecked_append(m_commands[i]);
+}
+
 static Optional<Gfx::IntRect> command_bounding_rectangle(Command const& command)
 {
     return command.visit(
@@ -24,38 +41,260 @@ static Optional<Gfx::IntRect> command_bounding_rectangle(Command const& command)
         });
 }
 
-void DisplayListPlayer::execute(DisplayList& display_list)
+static bool needs_scroll_offset_applied(DisplayList::CommandListItem const& item)
+{
+    return item.scroll_frame_id.has_value() || item.command.has<PaintScrollBar>();
+}
+
+static void apply_scroll_offset(Command& command, Optional<i32> scroll_frame_id, Vector<RefPtr<ScrollFrame>> const& scroll_state, double device_pixels_per_css_pixel)
+{
+    if (command.has<PaintScrollBar>()) {
+        auto& paint_scroll_bar = command.get<PaintScrollBar>();
+        auto const& scroll_offset = scroll_state[paint_scroll_bar.scroll_frame_id]->own_offset();
+        if (paint_scroll_bar.vertical) {
+            auto offset = scroll_offset.y() * paint_scroll_bar.scroll_size;
+            paint_scroll_bar.rect.translate_by(0, -offset.to_int() * device_pixels_per_css_pixel);
+        } else {
+            auto offset = scroll_offset.x() * paint_scroll_bar.scroll_size;
+            paint_scroll_bar.rect.translate_by(-offset.to_int() * device_pixels_per_css_pixel, 0);
+        }
+    }
+
+    if (scroll_frame_id.has_value()) {
+        auto const& scroll_offset = scroll_state[scroll_frame_id.value()]->cumulative_offset().to_type<double>().scaled(device_pixels_per_css_pixel).to_type<int>();
+        command.visit(
+            [&](auto& command) {
+                if constexpr (requires { command.translate_by(scroll_offset); }) {
+                    command.translate_by(scroll_offset);
+                }
+            });
+    }
+}
+
+NonnullRefPtr<DisplayList> DisplayList::snapshot_for_playback() const
+{
+    auto snapshot = DisplayList::create();
+    snapshot->m_device_pixels_per_css_pixel = m_device_pixels_per_css_pixel;
+    snapshot->m_has_scroll_offsets_applied = true;
+    for (auto const& item : m_commands) {
+        auto command = item.command;
+        if (!m_has_scroll_offsets_applied && needs_scroll_offset_applied(item))
+            apply_scroll_offset(command, item.scroll_frame_id, m_scroll_state, m_device_pixels_per_css_pixel);
+        if (command.has<PaintNestedDisplayList>()) {
+            auto& nested_display_list = command.get<PaintNestedDisplayList>().display_list;
+            if (nested_display_list)
+                nested_display_list = nested_display_list->snapshot_for_playback();
+        }
+        snapshot->m_commands.append({ {}, move(command) });
+    }
+    return snapshot;
+}
+
+bool g_log_display_list_optimizations = false;
+
+static bool has_identity_transform(PushStackingContext const& command)
+{
+    return command.post_transform_translation.is_zero() && Gfx::extract_2d_affine_transform(command.transform.matrix).is_identity();
+}
+
+static bool is_no_op_stacking_context(PushStackingContext const& command)
+{
+    return command.opacity >= 1 && has_identity_transform(command) && !command.mask.has_value() && !command.clip_path.has_value();
+}
+
+static bool changes_player_state(Command const& command)
+{
+    return command.has<AddClipRect>() || command.has<AddRoundedRectClip>() || command.has<AddMask>() || command.has<PaintNestedDisplayList>();
+}
+
+static bool draws_anything(Command const& command)
+{
+    return !command.has<AddClipRect>() && !command.has<AddRoundedRectClip>() && !command.has<AddMask>();
+}
+
+static bool try_merge_fill_rects(FillRect& into, FillRect const& other)
+{
+    if (into.color != other.color)
+        return false;
+
+    // NOTE: The area where translucent rects overlap would be blended twice, so those can only be merged if they touch.
+    auto may_overlap = into.color.alpha() == 255;
+    auto const& a = into.rect;
+    auto const& b = other.rect;
+    bool can_merge = false;
+    if (a.x() == b.x() && a.width() == b.width()) {
+        can_merge = may_overlap ? (b.top() <= a.bottom() && a.top() <= b.bottom()) : (b.top() == a.bottom() || a.top() == b.bottom());
+    } else if (a.y() == b.y() && a.height() == b.height()) {
+        can_merge = may_overlap ? (b.left() <= a.right() && a.left() <= b.right()) : (b.left() == a.right() || a.left() == b.right());
+    }
+    if (!can_merge)
+        return false;
+
+    into.rect = a.united(b);
+    return true;
+}
+
+static bool try_merge_glyph_runs(DrawGlyphRun& into, DrawGlyphRun const& other)
+{
+    if (into.color != other.color || into.scale != other.scale || &into.glyph_run->font() != &other.glyph_run->font())
+        return false;
+
+    // NOTE: Glyph positions are scaled before the translation is applied, see DisplayListPlayerSkia::draw_glyph_run().
+    auto delta = (other.translation - into.translation).scaled(static_cast<float>(1 / into.scale));
+    into.glyph_run = into.glyph_run->merged_with(*other.glyph_run, delta);
+    into.rect = into.rect.united(other.rect);
+    return true;
+}
+
+DisplayList::OptimizationStatistics DisplayList::optimize(Gfx::IntRect const& visible_rect)
+{
+    // NOTE: Commands of different scroll frames move independently, so we can only reason about their positions once
+    //       the scroll offsets have been applied.
+    VERIFY(m_has_scroll_offsets_applied);
+
+    OptimizationStatistics statistics;
+    statistics.command_count_before = m_commands.size();
+
+    // 1. Cull commands that are entirely clipped, and turn stacking contexts that only save and restore into just that.
+    //    The clip is only tracked as long as nothing transforms the coordinate space.
+    Vector<Command> culled_commands;
+    culled_commands.ensure_capacity(m_commands.size());
+    {
+        Optional<Gfx::IntRect> clip = visible_rect;
+        Vector<Optional<Gfx::IntRect>> clip_stack;
+        Vector<bool> stacking_context_is_no_op_stack;
+        for (auto& item : m_commands) {
+            auto& command = item.command;
+            if (command.has<Save>()) {
+                clip_stack.append(clip);
+            } else if (command.has<Restore>()) {
+                clip = clip_stack.take_last();
+            } else if (auto* push_stacking_context = command.get_pointer<PushStackingContext>()) {
+                clip_stack.append(clip);
+                if (!has_identity_transform(*push_stacking_context))
+                    clip = {};
+                auto is_no_op = is_no_op_stacking_context(*push_stacking_context);
+                stacking_context_is_no_op_stack.append(is_no_op);
+                if (is_no_op) {
+                    culled_commands.append(Save {});
+                    continue;
+                }
+            } else if (command.has<PopStackingContext>()) {
+                clip = clip_stack.take_last();
+                if (stacking_context_is_no_op_stack.take_last()) {
+                    culled_commands.append(Restore {});
+                    continue;
+                }
+            } else if (auto* add_clip_rect = command.get_pointer<AddClipRect>()) {
+                if (clip.has_value())
+                    clip = clip->intersected(add_clip_rect->rect);
+            } else if (auto* add_rounded_rect_clip = command.get_pointer<AddRoundedRectClip>()) {
+                // NOTE: An inside corner clip only cuts out the rounded rect, so everything outside it is still drawn.
+                if (clip.has_value() && add_rounded_rect_clip->corner_clip == CornerClip::Outside)
+                    clip = clip->intersected(add_rounded_rect_clip->border_rect);
+            } else if (command.has<PaintNestedDisplayList>()) {
+                // NOTE: The player translates to the nested display list's origin and leaves it at that.
+                if (clip.has_value() && !command.get<PaintNestedDisplayList>().rect.intersects(*clip))
+                    continue;
+                clip = {};
+            } else if (!command.has<AddMask>() && clip.has_value()) {
+                auto bounding_rect = command_bounding_rectangle(command);
+                if (bounding_rect.has_value() && !bounding_rect->intersects(*clip))
+                    continue;
+            }
+            culled_commands.append(move(command));
+        }
+    }
+
+    // 2. Drop save/restore pairs and stacking contexts that nothing is drawn into, as well as saves that nothing in
+    //    between would have to be restored from.
+    Vector<Optional<Command>> flattened_commands;
+    flattened_commands.ensure_capacity(culled_commands.size());
+    {
+        struct Group {
+            size_t start_index { 0 };
+            bool changes_player_state { false };
+            bool draws_anything { false };
+        };
+        Vector<Group> groups;
+        for (auto& command : culled_commands) {
+            if (command.has<Save>() || command.has<PushStackingContext>()) {
+                groups.append({ .start_index = flattened_commands.size() });
+                flattened_commands.append(move(command));
+                continue;
+            }
+            if (command.has<Restore>() || command.has<PopStackingContext>()) {
+                auto group = groups.take_last();
+                if (!group.draws_anything) {
+                    flattened_commands.shrink(group.start_index);
+                    continue;
+                }
+                if (!groups.is_empty())
+                    groups.last().draws_anything = true;
+                if (command.has<Restore>() && !group.changes_player_state) {
+                    flattened_commands[group.start_index].clear();
+                    continue;
+                }
+                flattened_commands.append(move(command));
+                continue;
+            }
+            if (!groups.is_empty()) {
+                groups.last().changes_player_state |= changes_player_state(command);
+                groups.last().draws_anything |= draws_anything(command);
+            }
+            flattened_commands.append(move(command));
+        }
+    }
+
+    // 3. Merge adjacent rects of the same color and glyph runs of the same font and color.
+    m_commands = {};
+    Command* previous_command = nullptr;
+    for (auto& command : flattened_commands) {
+        if (!command.has_value())
+            continue;
+        if (previous_command) {
+            if (auto* fill_rect = command->get_pointer<FillRect>()) {
+                if (auto* previous_fill_rect = previous_command->get_pointer<FillRect>(); previous_fill_rect && try_merge_fill_rects(*previous_fill_rect, *fill_rect))
+                    continue;
+            } else if (auto* draw_glyph_run = command->get_pointer<DrawGlyphRun>()) {
+                if (auto* previous_draw_glyph_run = previous_command->get_pointer<DrawGlyphRun>(); previous_draw_glyph_run && try_merge_glyph_runs(*previous_draw_glyph_run, *draw_glyph_run))
+                    continue;
+            }
+        }
+        m_commands.append({ {}, command.release_value() });
+        previous_command = &m_commands[m_commands.size() - 1].command;
+    }
+
+    statistics.command_count_after = m_commands.size();
+    return statistics;
+}
+
+void DisplayListPlayer::execute(DisplayList& display_list, Optional<Gfx::IntRect> damage_rect)
 {
     auto const& commands = display_list.commands();
     auto const& scroll_state = display_list.scroll_state();
     auto device_pixels_per_css_pixel = display_list.device_pixels_per_css_pixel();
 
+    // NOTE: Clipping to the damage rect also makes us skip every command outside of it below.
+    if (damage_rect.has_value()) {
+        save({});
+        add_clip_rect({ .rect = *damage_rect });
+    }
+
+    // NOTE: Commands are only copied if the scroll offsets still have to be applied to them. Playing back a snapshot
+    //       must not copy anything, as that would touch the reference counts of fonts, bitmaps, etc.
+    Optional<Command> command_with_scroll_offset_applied;
+
     size_t next_command_index = 0;
     while (next_command_index < commands.size()) {
-        auto scroll_frame_id = commands[next_command_index].scroll_frame_id;
-        auto command = commands[next_command_index++].command;
-
-        if (command.has<PaintScrollBar>()) {
-            auto& paint_scroll_bar = command.get<PaintScrollBar>();
-            auto const& scroll_offset = scroll_state[paint_scroll_bar.scroll_frame_id]->own_offset();
-            if (paint_scroll_bar.vertical) {
-                auto offset = scroll_offset.y() * paint_scroll_bar.scroll_size;
-                paint_scroll_bar.rect.translate_by(0, -offset.to_int() * device_pixels_per_css_pixel);
-            } else {
-                auto offset = scroll_offset.x() * paint_scroll_bar.scroll_size;
-                paint_scroll_bar.rect.translate_by(-offset.to_int() * device_pixels_per_css_pixel, 0);
-            }
-        }
-
-        if (scroll_frame_id.has_value()) {
-            auto const& scroll_offset = scroll_state[scroll_frame_id.value()]->cumulative_offset().to_type<double>().scaled(device_pixels_per_css_pixel).to_type<int>();
-            command.visit(
-                [&](auto& command) {
-                    if constexpr (requires { command.translate_by(scroll_offset); }) {
-                        command.translate_by(scroll_offset);
-                    }
-                });
+        auto const& item = commands[next_command_index++];
+        Command const* command_pointer = &item.command;
+        if (!display_list.has_scroll_offsets_applied() && needs_scroll_offset_applied(item)) {
+            command_with_scroll_offset_applied = item.command;
+            apply_scroll_offset(*command_with_scroll_offset_applied, item.scroll_frame_id, scroll_state, device_pixels_per_css_pixel);
+            command_pointer = &command_with_scroll_offset_applied.value();
         }
+        auto const& command = *command_pointer;
 
         auto bounding_rect = command_bounding_rectangle(command);
         if (bounding_rect.has_value() && (bounding_rect->is_empty() || would_be_fully_clipped_by_painter(*bounding_rect))) {
@@ -102,6 +341,9 @@ void DisplayListPlayer::execute(DisplayList& display_list)
         else VERIFY_NOT_REACHED();
         // clang-format on
     }
+
+    if (damage_rect.has_value())
+        restore({});
 }
 
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/AtomicRefCounted.h>
 #include <AK/Forward.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/SegmentedVector.h>
@@ -39,7 +40,8 @@ class DisplayListPlayer {
 public:
     virtual ~DisplayListPlayer() = default;
 
-    void execute(DisplayList& display_list);
+    // If a damage rect is given, everything outside of it is left untouched.
+    void execute(DisplayList& display_list, Optional<Gfx::IntRect> damage_rect = {});
 
 private:
     virtual void draw_glyph_run(DrawGlyphRun const&) = 0;
@@ -76,7 +78,9 @@ private:
     virtual bool would_be_fully_clipped_by_painter(Gfx::IntRect) const = 0;
 };
 
-class DisplayList : public RefCounted<DisplayList> {
+extern bool g_log_display_list_optimizations;
+
+class DisplayList : public AtomicRefCounted<DisplayList> {
 public:
     static NonnullRefPtr<DisplayList> create()
     {
@@ -92,6 +96,9 @@ public:
 
     AK::SegmentedVector<CommandListItem, 512> const& commands() const { return m_commands; }
 
+    void append_commands(ReadonlySpan<CommandListItem>);
+    void copy_commands_into(Vector<CommandListItem>&, size_t start_index, size_t end_index) const;
+
     void set_scroll_state(Vector<RefPtr<ScrollFrame>> scroll_state) { m_scroll_state = move(scroll_state); }
 
     Vector<RefPtr<ScrollFrame>> const& scroll_state() const { return m_scroll_state; }
@@ -99,12 +106,27 @@ public:
     void set_device_pixels_per_css_pixel(double device_pixels_per_css_pixel) { m_device_pixels_per_css_pixel = device_pixels_per_css_pixel; }
     double device_pixels_per_css_pixel() const { return m_device_pixels_per_css_pixel; }
 
+    // Returns a copy with the current scroll offsets applied to all commands (including those of nested display lists),
+    // so it can be played back without looking at any scroll frames, e.g. on the rendering thread.
+    // NOTE: The copy shares fonts, bitmaps, etc. with this display list, so it must be released on this thread.
+    NonnullRefPtr<DisplayList> snapshot_for_playback() const;
+    bool has_scroll_offsets_applied() const { return m_has_scroll_offsets_applied; }
+
+    struct OptimizationStatistics {
+        size_t command_count_before { 0 };
+        size_t command_count_after { 0 };
+    };
+    // Rewrites the commands of a snapshot into a cheaper but equivalent list: drops commands outside the visible rect,
+    // flattens stacking contexts and save/restore pairs that have no effect, and merges adjacent rects and glyph runs.
+    OptimizationStatistics optimize(Gfx::IntRect const& visible_rect);
+
 private:
     DisplayList() = default;
 
     AK::SegmentedVector<CommandListItem, 512> m_commands;
     Vector<RefPtr<ScrollFrame>> m_scroll_state;
     double m_device_pixels_per_css_pixel;
+    bool m_has_scroll_offsets_applied { false };
 };
 
 }
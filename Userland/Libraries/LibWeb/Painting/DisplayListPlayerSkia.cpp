@@ -8,7 +8,6 @@
 #include <core/SkBlurTypes.h>
 #include <core/SkCanvas.h>
 #include <core/SkColorFilter.h>
-#include <core/SkFont.h>
 #include <core/SkFontMgr.h>
 #include <core/SkMaskFilter.h>
 #include <core/SkPath.h>
@@ -16,6 +15,7 @@
 #include <core/SkPathEffect.h>
 #include <core/SkRRect.h>
 #include <core/SkSurface.h>
+#include <core/SkTextBlob.h>
 #include <effects/SkDashPathEffect.h>
 #include <effects/SkGradientShader.h>
 #include <effects/SkImageFilters.h>
@@ -24,7 +24,6 @@
 #include <gpu/ganesh/SkSurfaceGanesh.h>
 #include <pathops/SkPathOps.h>
 
-#include <LibGfx/Font/ScaledFont.h>
 #include <LibGfx/PathSkia.h>
 #include <LibWeb/CSS/ComputedValues.h>
 #include <LibWeb/Painting/DisplayListPlayerSkia.h>
@@ -332,27 +331,13 @@ DisplayListPlayerSkia::SkiaSurface& DisplayListPlayerSkia::surface() const
 
 void DisplayListPlayerSkia::draw_glyph_run(DrawGlyphRun const& command)
 {
-    auto const& gfx_font = static_cast<Gfx::ScaledFont const&>(command.glyph_run->font());
-    auto sk_font = gfx_font.skia_font(command.scale);
-
-    auto glyph_count = command.glyph_run->glyphs().size();
-    Vector<SkGlyphID> glyphs;
-    glyphs.ensure_capacity(glyph_count);
-    Vector<SkPoint> positions;
-    positions.ensure_capacity(glyph_count);
-    auto font_ascent = gfx_font.pixel_metrics().ascent;
-    for (auto const& glyph : command.glyph_run->glyphs()) {
-        auto transformed_glyph = glyph;
-        transformed_glyph.position.set_y(glyph.position.y() + font_ascent);
-        transformed_glyph.position = transformed_glyph.position.scaled(command.scale);
-        auto const& point = transformed_glyph.position;
-        glyphs.append(transformed_glyph.glyph_id);
-        positions.append(to_skia_point(point));
-    }
+    auto const* text_blob = command.glyph_run->sk_text_blob(command.scale);
+    if (!text_blob)
+        return;
 
     SkPaint paint;
     paint.setColor(to_skia_color(command.color));
-    surface().canvas().drawGlyphs(glyphs.size(), glyphs.data(), positions.data(), to_skia_point(command.translation), sk_font, paint);
+    surface().canvas().drawTextBlob(text_blob, command.translation.x(), command.translation.y(), paint);
 }
 
 void DisplayListPlayerSkia::fill_rect(FillRect const& command)
@@ -379,18 +364,13 @@ void DisplayListPlayerSkia::draw_scaled_immutable_bitmap(DrawScaledImmutableBitm
 {
     auto src_rect = to_skia_rect(command.src_rect);
     auto dst_rect = to_skia_rect(command.dst_rect);
-    auto bitmap = to_skia_bitmap(command.bitmap->bitmap());
-    auto image = SkImages::RasterFromBitmap(bitmap);
     auto& canvas = surface().canvas();
     SkPaint paint;
-    canvas.drawImageRect(image, src_rect, dst_rect, to_skia_sampling_options(command.scaling_mode), &paint, SkCanvas::kStrict_SrcRectConstraint);
+    canvas.drawImageRect(command.bitmap->sk_image(), src_rect, dst_rect, to_skia_sampling_options(command.scaling_mode), &paint, SkCanvas::kStrict_SrcRectConstraint);
 }
 
 void DisplayListPlayerSkia::draw_repeated_immutable_bitmap(DrawRepeatedImmutableBitmap const& command)
 {
-    auto bitmap = to_skia_bitmap(command.bitmap->bitmap());
-    auto image = SkImages::RasterFromBitmap(bitmap);
-
     SkMatrix matrix;
     auto dst_rect = command.dst_rect.to_type<float>();
     auto src_size = command.bitmap->size().to_type<float>();
@@ -400,7 +380,7 @@ void DisplayListPlayerSkia::draw_repeated_immutable_bitmap(DrawRepeatedImmutable
 
     auto tile_mode_x = command.repeat.x ? SkTileMode::kRepeat : SkTileMode::kDecal;
     auto tile_mode_y = command.repeat.y ? SkTileMode::kRepeat : SkTileMode::kDecal;
-    auto shader = image->makeShader(tile_mode_x, tile_mode_y, sampling_options, matrix);
+    auto shader = command.bitmap->sk_image()->makeShader(tile_mode_x, tile_mode_y, sampling_options, matrix);
 
     SkPaint paint;
     paint.setShader(shader);
@@ -154,12 +154,23 @@ public:
 
     void append(Command&& command);
 
-private:
     struct State {
         Gfx::AffineTransform translation;
         Optional<Gfx::IntRect> clip_rect;
         Optional<i32> scroll_frame_id;
     };
+
+    // NOTE: Unlike save() and restore(), these don't record any commands. They're used to recreate the state
+    //       a cached display list chunk was recorded in, see StackingContext::paint().
+    State const& current_state() const { return state(); }
+    void push_state(State const& state) { m_state_stack.append(state); }
+    void pop_state()
+    {
+        VERIFY(m_state_stack.size() > 1);
+        m_state_stack.take_last();
+    }
+
+private:
     State& state() { return m_state_stack.last(); }
     State const& state() const { return m_state_stack.last(); }
 
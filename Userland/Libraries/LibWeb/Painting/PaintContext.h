@@ -84,6 +84,13 @@ public:
 
     u64 paint_generation_id() const { return m_paint_generation_id; }
 
+    // Stacking contexts only reuse display list chunks recorded with the same generation, see StackingContext::paint().
+    Optional<u64> display_list_chunk_generation() const { return m_display_list_chunk_generation; }
+    void set_display_list_chunk_generation(u64 generation) { m_display_list_chunk_generation = generation; }
+
+    Painting::DisplayListChunkRecording* display_list_chunk_recording() const { return m_display_list_chunk_recording; }
+    void set_display_list_chunk_recording(Painting::DisplayListChunkRecording* recording) { m_display_list_chunk_recording = recording; }
+
 private:
     Painting::DisplayListRecorder& m_display_list_recorder;
     Palette m_palette;
@@ -95,6 +102,8 @@ private:
     bool m_draw_svg_geometry_for_clip_path { false };
     Gfx::AffineTransform m_svg_transform;
     u64 m_paint_generation_id { 0 };
+    Optional<u64> m_display_list_chunk_generation;
+    Painting::DisplayListChunkRecording* m_display_list_chunk_recording { nullptr };
 };
 
 }
@@ -128,27 +128,56 @@ void Paintable::invalidate_stacking_context()
     m_stacking_context = nullptr;
 }
 
+void Paintable::invalidate_display_list_chunk()
+{
+    auto& document = const_cast<DOM::Document&>(this->document());
+    for (auto* paintable = this; paintable; paintable = paintable->parent()) {
+        if (auto* stacking_context = paintable->stacking_context()) {
+            stacking_context->invalidate_cached_display_list_chunk();
+            document.invalidate_display_list_for_paint_only_change();
+            return;
+        }
+    }
+    // NOTE: The stacking context tree hasn't been built yet, so there are no chunks to pick from.
+    document.invalidate_display_list();
+}
+
 void Paintable::set_needs_display(InvalidateDisplayList should_invalidate_display_list)
 {
     auto& document = const_cast<DOM::Document&>(this->document());
     if (should_invalidate_display_list == InvalidateDisplayList::Yes)
-        document.invalidate_display_list();
+        invalidate_display_list_chunk();
 
     auto* containing_block = this->containing_block();
     if (!containing_block)
         return;
 
+    // FIXME: Account for the extent of text shadows.
+    if (!computed_values().text_shadow().is_empty()) {
+        document.set_needs_display(InvalidateDisplayList::No);
+        return;
+    }
+
+    auto damage_fragment = [&](PaintableFragment const& fragment) {
+        // NOTE: The text cursor is painted just past the end of the fragment, so include a little slack around it.
+        auto rect = fragment.absolute_rect().inflated(2, 2);
+        if (auto viewport_rect = containing_block->absolute_rect_to_viewport_rect(rect); viewport_rect.has_value())
+            document.set_needs_display(*viewport_rect, InvalidateDisplayList::No);
+        else
+            document.set_needs_display(InvalidateDisplayList::No);
+    };
+
     if (is<Painting::InlinePaintable>(*this)) {
         auto const& fragments = static_cast<Painting::InlinePaintable const*>(this)->fragments();
         for (auto const& fragment : fragments) {
-            document.set_needs_display(fragment.absolute_rect(), InvalidateDisplayList::No);
+            damage_fragment(fragment);
         }
     }
 
     if (!is<Painting::PaintableWithLines>(*containing_block))
         return;
     static_cast<Painting::PaintableWithLines const&>(*containing_block).for_each_fragment([&](auto& fragment) {
-        document.set_needs_display(fragment.absolute_rect(), InvalidateDisplayList::No);
+        damage_fragment(fragment);
         return IterationDecision::Continue;
     });
 }
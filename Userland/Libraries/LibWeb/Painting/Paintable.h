@@ -152,6 +152,7 @@ public:
     StackingContext* enclosing_stacking_context();
 
     void invalidate_stacking_context();
+    void invalidate_display_list_chunk();
 
     virtual void before_paint(PaintContext&, PaintPhase) const { }
     virtual void after_paint(PaintContext&, PaintPhase) const { }
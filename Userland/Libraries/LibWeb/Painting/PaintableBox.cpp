@@ -17,6 +17,7 @@
 #include <LibWeb/Layout/BlockContainer.h>
 #include <LibWeb/Layout/Viewport.h>
 #include <LibWeb/Painting/BackgroundPainting.h>
+#include <LibWeb/Painting/InlinePaintable.h>
 #include <LibWeb/Painting/PaintableBox.h>
 #include <LibWeb/Painting/SVGPaintable.h>
 #include <LibWeb/Painting/SVGSVGPaintable.h>
@@ -170,7 +171,8 @@ CSSPixelRect PaintableBox::compute_absolute_paint_rect() const
 {
     // FIXME: This likely incomplete:
     auto rect = absolute_border_box_rect();
-    if (has_scrollable_overflow()) {
+    // NOTE: The contents of a box with paint containment are clipped to its padding box.
+    if (has_scrollable_overflow() && !layout_box().has_paint_containment()) {
         auto scrollable_overflow_rect = this->scrollable_overflow_rect().value();
         if (computed_values().overflow_x() == CSS::Overflow::Visible)
             rect.unite_horizontally(scrollable_overflow_rect);
@@ -662,7 +664,8 @@ void PaintableWithLines::paint(PaintContext& context, PaintPhase phase) const
     if (fragments().is_empty())
         return;
 
-    bool should_clip_overflow = computed_values().overflow_x() != CSS::Overflow::Visible && computed_values().overflow_y() != CSS::Overflow::Visible;
+    bool should_clip_overflow = (computed_values().overflow_x() != CSS::Overflow::Visible && computed_values().overflow_y() != CSS::Overflow::Visible)
+        || layout_box().has_paint_containment();
     Optional<u32> corner_clip_id;
 
     auto clip_box = absolute_padding_box_rect();
@@ -807,11 +810,54 @@ TraversalDecision PaintableBox::hit_test_scrollbars(CSSPixelPoint position, Func
     return TraversalDecision::Continue;
 }
 
+static CSSPixelRect hit_test_bounds_of_descendants(Paintable const& paintable)
+{
+    CSSPixelRect bounds;
+    paintable.for_each_child([&](Paintable const& child) {
+        if (is<PaintableBox>(child)) {
+            bounds = bounds.united(static_cast<PaintableBox const&>(child).hit_test_bounds());
+            return IterationDecision::Continue;
+        }
+        if (is<InlinePaintable>(child)) {
+            auto const& inline_paintable = static_cast<InlinePaintable const&>(child);
+            auto scroll_offset = inline_paintable.cumulative_offset_of_enclosing_scroll_frame();
+            for (auto const& fragment : inline_paintable.fragments())
+                bounds = bounds.united(fragment.absolute_rect().translated(scroll_offset));
+        }
+        bounds = bounds.united(hit_test_bounds_of_descendants(child));
+        return IterationDecision::Continue;
+    });
+    return bounds;
+}
+
+CSSPixelRect PaintableBox::hit_test_bounds() const
+{
+    // NOTE: Everything hit_test() finds is in the border box of a box or in a fragment, after taking away the scroll
+    //       offset of the scroll frame it's in. Adding those offsets to the rects puts them in the coordinates of
+    //       the positions hit_test() is called with.
+    if (m_hit_test_bounds_generation == document().geometry_generation())
+        return m_hit_test_bounds;
+
+    auto scroll_offset = cumulative_offset_of_enclosing_scroll_frame();
+    auto bounds = absolute_border_box_rect().translated(scroll_offset);
+    if (is<PaintableWithLines>(*this)) {
+        for (auto const& fragment : static_cast<PaintableWithLines const&>(*this).fragments())
+            bounds = bounds.united(fragment.absolute_rect().translated(scroll_offset));
+    }
+    m_hit_test_bounds = bounds.united(hit_test_bounds_of_descendants(*this));
+    m_hit_test_bounds_generation = document().geometry_generation();
+    return m_hit_test_bounds;
+}
+
 TraversalDecision PaintableBox::hit_test(CSSPixelPoint position, HitTestType type, Function<TraversalDecision(HitTestResult)> const& callback) const
 {
     if (clip_rect_for_hit_testing().has_value() && !clip_rect_for_hit_testing()->contains(position))
         return TraversalDecision::Continue;
 
+    // NOTE: Text cursor hit tests also look for the fragment closest to the position, which might be anywhere.
+    if (type == HitTestType::Exact && !layout_box().is_viewport() && !hit_test_bounds().contains(position))
+        return TraversalDecision::Continue;
+
     auto position_adjusted_by_scroll_offset = position;
     position_adjusted_by_scroll_offset.translate_by(-cumulative_offset_of_enclosing_scroll_frame());
 
@@ -870,6 +916,9 @@ TraversalDecision PaintableWithLines::hit_test(CSSPixelPoint position, HitTestTy
     if (clip_rect_for_hit_testing().has_value() && !clip_rect_for_hit_testing()->contains(position))
         return TraversalDecision::Continue;
 
+    if (type == HitTestType::Exact && !layout_box().is_viewport() && !hit_test_bounds().contains(position))
+        return TraversalDecision::Continue;
+
     auto position_adjusted_by_scroll_offset = position;
     position_adjusted_by_scroll_offset.translate_by(-cumulative_offset_of_enclosing_scroll_frame());
 
@@ -958,7 +1007,21 @@ TraversalDecision PaintableWithLines::hit_test(CSSPixelPoint position, HitTestTy
 
 void PaintableBox::set_needs_display(InvalidateDisplayList should_invalidate_display_list)
 {
-    document().set_needs_display(absolute_rect(), should_invalidate_display_list);
+    if (should_invalidate_display_list == InvalidateDisplayList::Yes)
+        invalidate_display_list_chunk();
+
+    auto rect = absolute_paint_rect();
+    if (auto const& outline_data = this->outline_data(); outline_data.has_value()) {
+        auto outline_width = max(max(outline_data->top.width, outline_data->right.width), max(outline_data->bottom.width, outline_data->left.width));
+        auto outset = outline_width + max(outline_offset(), CSSPixels(0));
+        rect.inflate(outset, outset, outset, outset);
+    }
+
+    auto& document = this->document();
+    if (auto viewport_rect = absolute_rect_to_viewport_rect(rect); viewport_rect.has_value())
+        document.set_needs_display(*viewport_rect, InvalidateDisplayList::No);
+    else
+        document.set_needs_display(InvalidateDisplayList::No);
 }
 
 Optional<CSSPixelRect> PaintableBox::get_masking_area() const
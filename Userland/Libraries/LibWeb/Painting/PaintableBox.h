@@ -140,6 +140,10 @@ public:
     [[nodiscard]] virtual TraversalDecision hit_test(CSSPixelPoint position, HitTestType type, Function<TraversalDecision(HitTestResult)> const& callback) const override;
     Optional<HitTestResult> hit_test(CSSPixelPoint, HitTestType) const;
 
+    // The area in which hit_test() can find this box or any of its descendants, in the same coordinates as the
+    // positions passed to it. Exact hit tests for positions outside of it skip the whole subtree.
+    CSSPixelRect hit_test_bounds() const;
+
     virtual bool handle_mousewheel(Badge<EventHandler>, CSSPixelPoint, unsigned buttons, unsigned modifiers, int wheel_delta_x, int wheel_delta_y) override;
 
     enum class ConflictingElementKind {
@@ -274,6 +278,9 @@ private:
     Optional<CSSPixelRect> mutable m_absolute_rect;
     Optional<CSSPixelRect> mutable m_absolute_paint_rect;
 
+    CSSPixelRect mutable m_hit_test_bounds;
+    u64 mutable m_hit_test_bounds_generation { 0 };
+
     RefPtr<ScrollFrame const> m_enclosing_scroll_frame;
     RefPtr<ClipFrame const> m_enclosing_clip_frame;
 
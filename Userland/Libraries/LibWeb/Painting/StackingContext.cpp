@@ -62,6 +62,14 @@ void StackingContext::set_last_paint_generation_id(u64 generation_id)
     m_last_paint_generation_id = generation_id;
 }
 
+size_t StackingContext::cached_display_list_chunk_size_in_bytes() const
+{
+    if (!m_cached_display_list_chunk.has_value())
+        return 0;
+    auto const& chunk = *m_cached_display_list_chunk;
+    return chunk.commands.capacity() * sizeof(DisplayList::CommandListItem) + chunk.children.capacity() * sizeof(DisplayListChunk::Child);
+}
+
 static PaintPhase to_paint_phase(StackingContext::StackingContextPaintPhase phase)
 {
     // There are not a fully correct mapping since some stacking context phases are combined.
@@ -265,6 +273,89 @@ static Gfx::FloatMatrix4x4 matrix_with_scaled_translation(Gfx::FloatMatrix4x4 ma
 }
 
 void StackingContext::paint(PaintContext& context) const
+{
+    auto& display_list = context.display_list_recorder().display_list();
+
+    // NOTE: If the enclosing stacking context is recording a chunk, take everything it painted so far and leave a
+    //       hole for us, so it can splice in our output (cached or not) when it gets replayed.
+    auto* parent_recording = context.display_list_chunk_recording();
+    if (parent_recording) {
+        parent_recording->flush_commands_up_to(display_list.commands().size());
+        parent_recording->chunk.children.append({
+            .command_index = parent_recording->chunk.commands.size(),
+            .stacking_context = this,
+            .recorder_state = context.display_list_recorder().current_state(),
+            .svg_transform = context.svg_transform(),
+            .draw_svg_geometry_for_clip_path = context.draw_svg_geometry_for_clip_path(),
+        });
+    }
+
+    context.set_display_list_chunk_recording(nullptr);
+    paint_with_effects(context);
+
+    context.set_display_list_chunk_recording(parent_recording);
+    if (parent_recording)
+        parent_recording->next_uncopied_command_index = display_list.commands().size();
+}
+
+// NOTE: Only the content is cached, not the effects (transform, opacity, mask, etc.) it is wrapped in. This way,
+//       changing just the effects, like transform and opacity animations do, doesn't require repainting the content.
+void StackingContext::paint_content(PaintContext& context) const
+{
+    auto& display_list = context.display_list_recorder().display_list();
+    auto generation = context.display_list_chunk_generation();
+    if (generation.has_value() && m_cached_display_list_chunk.has_value() && m_cached_display_list_chunk->generation == *generation) {
+        replay_cached_display_list_chunk(context);
+    } else if (generation.has_value() && m_parent) {
+        // NOTE: The root stacking context is never cached, as pretty much every invalidation ends up in it anyway.
+        DisplayListChunk chunk { .generation = *generation, .commands = {}, .children = {} };
+        DisplayListChunkRecording recording { chunk, display_list, display_list.commands().size() };
+        context.set_display_list_chunk_recording(&recording);
+        paint_internal(context);
+        recording.flush_commands_up_to(display_list.commands().size());
+        context.set_display_list_chunk_recording(nullptr);
+        m_cached_display_list_chunk = move(chunk);
+    } else {
+        paint_internal(context);
+    }
+}
+
+static u64 s_replayed_display_list_chunk_count = 0;
+
+u64 StackingContext::replayed_display_list_chunk_count()
+{
+    return s_replayed_display_list_chunk_count;
+}
+
+void StackingContext::replay_cached_display_list_chunk(PaintContext& context) const
+{
+    ++s_replayed_display_list_chunk_count;
+
+    auto& chunk = *m_cached_display_list_chunk;
+    auto& recorder = context.display_list_recorder();
+
+    size_t next_command_index = 0;
+    for (auto const& child : chunk.children) {
+        recorder.display_list().append_commands(chunk.commands.span().slice(next_command_index, child.command_index - next_command_index));
+        next_command_index = child.command_index;
+
+        auto saved_svg_transform = context.svg_transform();
+        auto saved_draw_svg_geometry_for_clip_path = context.draw_svg_geometry_for_clip_path();
+        recorder.push_state(child.recorder_state);
+        context.set_svg_transform(child.svg_transform);
+        context.set_draw_svg_geometry_for_clip_path(child.draw_svg_geometry_for_clip_path);
+
+        const_cast<StackingContext&>(*child.stacking_context).set_last_paint_generation_id(context.paint_generation_id());
+        child.stacking_context->paint(context);
+
+        context.set_draw_svg_geometry_for_clip_path(saved_draw_svg_geometry_for_clip_path);
+        context.set_svg_transform(saved_svg_transform);
+        recorder.pop_state();
+    }
+    recorder.display_list().append_commands(chunk.commands.span().slice(next_command_index));
+}
+
+void StackingContext::paint_with_effects(PaintContext& context) const
 {
     auto opacity = paintable().computed_values().opacity();
     if (opacity == 0.0f)
@@ -332,7 +423,7 @@ void StackingContext::paint(PaintContext& context) const
     if (paintable().is_paintable_box() && paintable_box().scroll_frame_id().has_value())
         context.display_list_recorder().set_scroll_frame_id(*paintable_box().scroll_frame_id());
     context.display_list_recorder().push_stacking_context(push_stacking_context_params);
-    paint_internal(context);
+    paint_content(context);
     context.display_list_recorder().pop_stacking_context();
     if (has_css_transform)
         paintable_box().clear_clip_overflow_rect(context, PaintPhase::Foreground);
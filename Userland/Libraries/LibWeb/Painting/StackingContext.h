@@ -8,11 +8,42 @@
 
 #include <AK/Vector.h>
 #include <LibGfx/Matrix4x4.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/DisplayListRecorder.h>
 #include <LibWeb/Painting/InlinePaintable.h>
 #include <LibWeb/Painting/Paintable.h>
 
 namespace Web::Painting {
 
+// The commands a stacking context recorded for its content, minus those of its child stacking contexts. Each child is
+// remembered along with the position in the command stream and the painter state it was painted with, so the chunk can
+// be replayed with fresh (or cached) output for the children spliced back in.
+struct DisplayListChunk {
+    struct Child {
+        size_t command_index { 0 };
+        StackingContext const* stacking_context { nullptr };
+        DisplayListRecorder::State recorder_state;
+        Gfx::AffineTransform svg_transform;
+        bool draw_svg_geometry_for_clip_path { false };
+    };
+
+    u64 generation { 0 };
+    Vector<DisplayList::CommandListItem> commands;
+    Vector<Child> children;
+};
+
+struct DisplayListChunkRecording {
+    DisplayListChunk& chunk;
+    DisplayList const& display_list;
+    size_t next_uncopied_command_index { 0 };
+
+    void flush_commands_up_to(size_t command_index)
+    {
+        display_list.copy_commands_into(chunk.commands, next_uncopied_command_index, command_index);
+        next_uncopied_command_index = command_index;
+    }
+};
+
 class StackingContext {
     friend class ViewportPaintable;
 
@@ -48,18 +79,28 @@ public:
 
     void set_last_paint_generation_id(u64 generation_id);
 
+    void invalidate_cached_display_list_chunk() const { m_cached_display_list_chunk.clear(); }
+    size_t cached_display_list_chunk_size_in_bytes() const;
+
+    // The number of times a cached chunk was replayed instead of being recorded again, in all documents of this process.
+    static u64 replayed_display_list_chunk_count();
+
 private:
     JS::NonnullGCPtr<Paintable> m_paintable;
     StackingContext* const m_parent { nullptr };
     Vector<StackingContext*> m_children;
     size_t m_index_in_tree_order { 0 };
     Optional<u64> m_last_paint_generation_id;
+    mutable Optional<DisplayListChunk> m_cached_display_list_chunk;
 
     Vector<JS::NonnullGCPtr<Paintable const>> m_positioned_descendants_with_stack_level_0_and_stacking_contexts;
     Vector<JS::NonnullGCPtr<Paintable const>> m_non_positioned_floating_descendants;
 
     static void paint_child(PaintContext&, StackingContext const&);
     void paint_internal(PaintContext&) const;
+    void paint_with_effects(PaintContext&) const;
+    void paint_content(PaintContext&) const;
+    void replay_cached_display_list_chunk(PaintContext&) const;
 };
 
 }
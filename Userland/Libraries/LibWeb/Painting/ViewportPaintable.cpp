@@ -35,6 +35,7 @@ void ViewportPaintable::build_stacking_context_tree_if_needed()
 
 void ViewportPaintable::build_stacking_context_tree()
 {
+    document().did_change_geometry();
     set_stacking_context(make<StackingContext>(*this, nullptr, 0));
 
     size_t index_in_tree_order = 1;
@@ -129,7 +130,8 @@ void ViewportPaintable::assign_clip_frames()
         auto overflow_x = paintable_box.computed_values().overflow_x();
         auto overflow_y = paintable_box.computed_values().overflow_y();
         auto has_hidden_overflow = overflow_x != CSS::Overflow::Visible && overflow_y != CSS::Overflow::Visible;
-        if (has_hidden_overflow || paintable_box.get_clip_rect().has_value()) {
+        // NOTE: Paint containment clips the contents of a box to its padding box, the same way as hidden overflow.
+        if (has_hidden_overflow || paintable_box.layout_box().has_paint_containment() || paintable_box.get_clip_rect().has_value()) {
             auto clip_frame = adopt_ref(*new ClipFrame());
             clip_state.set(paintable_box, move(clip_frame));
         }
@@ -162,7 +164,7 @@ void ViewportPaintable::assign_clip_frames()
             auto const& block_paintable_box = *block->paintable_box();
             auto block_overflow_x = block_paintable_box.computed_values().overflow_x();
             auto block_overflow_y = block_paintable_box.computed_values().overflow_y();
-            if (block_overflow_x != CSS::Overflow::Visible && block_overflow_y != CSS::Overflow::Visible) {
+            if ((block_overflow_x != CSS::Overflow::Visible && block_overflow_y != CSS::Overflow::Visible) || block->has_paint_containment()) {
                 auto rect = block_paintable_box.absolute_padding_box_rect();
                 clip_frame.add_clip_rect(rect, block_paintable_box.normalized_border_radii_data(ShrinkRadiiForBorders::Yes), block_paintable_box.enclosing_scroll_frame());
             }
@@ -181,6 +183,7 @@ void ViewportPaintable::refresh_scroll_state()
     if (!m_needs_to_refresh_scroll_state)
         return;
     m_needs_to_refresh_scroll_state = false;
+    document().did_change_geometry();
 
     for (auto& it : sticky_state) {
         auto const& sticky_box = *it.key;
@@ -277,6 +280,7 @@ void ViewportPaintable::resolve_paint_only_properties()
         paintable.resolve_paint_properties();
         return TraversalDecision::Continue;
     });
+    document().did_change_geometry();
 }
 
 JS::GCPtr<Selection::Selection> ViewportPaintable::selection() const
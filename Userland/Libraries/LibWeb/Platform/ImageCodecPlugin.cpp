@@ -13,6 +13,20 @@ static ImageCodecPlugin* s_the;
 
 ImageCodecPlugin::~ImageCodecPlugin() = default;
 
+void ImageCodecPlugin::request_animation_frames(i64, size_t, size_t, AnimationFramesCallback)
+{
+}
+
+void ImageCodecPlugin::release_animation(i64)
+{
+}
+
+void ImageCodecPlugin::discard_remaining_frames(DecodedImage const& image)
+{
+    if (image.frame_count > image.frames.size())
+        release_animation(image.image_id);
+}
+
 ImageCodecPlugin& ImageCodecPlugin::the()
 {
     VERIFY(s_the);
@@ -11,6 +11,7 @@
 #include <AK/Vector.h>
 #include <LibCore/Promise.h>
 #include <LibGfx/Forward.h>
+#include <LibGfx/Size.h>
 
 namespace Web::Platform {
 
@@ -20,8 +21,16 @@ struct Frame {
 };
 
 struct DecodedImage {
+    i64 image_id { 0 };
     bool is_animated { false };
     u32 loop_count { 0 };
+
+    // The size of the image itself. The frames may be smaller if it was decoded for a smaller ideal size.
+    Gfx::IntSize natural_size;
+
+    // The total number of frames. If this is more than the number of frames we got, the remaining ones have to be
+    // asked for with request_animation_frames() as the animation reaches them.
+    u32 frame_count { 0 };
     Vector<Frame> frames;
 };
 
@@ -32,7 +41,19 @@ public:
 
     virtual ~ImageCodecPlugin();
 
-    virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) = 0;
+    // If an ideal size is given, still images may be decoded at a smaller size that still covers it, rather than at
+    // their natural size. High priority images (e.g. ones in view) are decoded ahead of others that are waiting.
+    virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, bool is_high_priority = false) = 0;
+
+    // Frames that fail to decode are handed back without a bitmap.
+    using AnimationFramesCallback = Function<void(size_t first_frame_index, Vector<Frame>)>;
+    virtual void request_animation_frames(i64 image_id, size_t first_frame_index, size_t count, ESCAPING AnimationFramesCallback on_decoded);
+
+    // Lets the decoder forget an animation that was decoded incrementally.
+    virtual void release_animation(i64 image_id);
+
+    // For users that only look at the first frame, so that the decoder doesn't keep an animation around that's never played.
+    void discard_remaining_frames(DecodedImage const&);
 };
 
 }
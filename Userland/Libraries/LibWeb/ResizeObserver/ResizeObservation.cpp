@@ -26,6 +26,8 @@ ResizeObservation::ResizeObservation(JS::Realm& realm, DOM::Element& target, Bin
 {
     auto computed_size = realm.heap().allocate<ResizeObserverSize>(realm, realm);
     m_last_reported_sizes.append(computed_size);
+
+    m_target->did_create_resize_observation({});
 }
 
 void ResizeObservation::visit_edges(JS::Cell::Visitor& visitor)
@@ -36,9 +38,20 @@ void ResizeObservation::visit_edges(JS::Cell::Visitor& visitor)
     visitor.visit(m_last_reported_sizes);
 }
 
+void ResizeObservation::finalize()
+{
+    Base::finalize();
+    m_target->did_finalize_resize_observation({});
+}
+
 // https://drafts.csswg.org/resize-observer-1/#dom-resizeobservation-isactive
 bool ResizeObservation::is_active()
 {
+    // OPTIMIZATION: If layout hasn't changed the size of the target's box since we last compared it, we're still up to date.
+    //               This doesn't hold for device pixels, which also change along with the device pixel ratio.
+    if (m_observed_box != Bindings::ResizeObserverBoxOptions::DevicePixelContentBox && m_box_size_change_count_when_up_to_date == m_target->box_size_change_count())
+        return false;
+
     // 1. Set currentSize by calculate box size given target and observedBox.
     auto current_size = ResizeObserverSize::calculate_box_size(m_realm, m_target, m_observed_box);
 
@@ -48,7 +61,13 @@ bool ResizeObservation::is_active()
         return true;
 
     // 3. Return false.
+    m_box_size_change_count_when_up_to_date = m_target->box_size_change_count();
     return false;
 }
 
+void ResizeObservation::did_report_sizes()
+{
+    m_box_size_change_count_when_up_to_date = m_target->box_size_change_count();
+}
+
 }
@@ -21,6 +21,7 @@ public:
     static WebIDL::ExceptionOr<JS::NonnullGCPtr<ResizeObservation>> create(JS::Realm&, DOM::Element&, Bindings::ResizeObserverBoxOptions);
 
     bool is_active();
+    void did_report_sizes();
 
     JS::NonnullGCPtr<DOM::Element> target() const { return m_target; }
     Bindings::ResizeObserverBoxOptions observed_box() const { return m_observed_box; }
@@ -31,11 +32,15 @@ public:
 
 private:
     virtual void visit_edges(JS::Cell::Visitor&) override;
+    virtual void finalize() override;
 
     JS::NonnullGCPtr<JS::Realm> m_realm;
     JS::NonnullGCPtr<DOM::Element> m_target;
     Bindings::ResizeObserverBoxOptions m_observed_box;
     Vector<JS::NonnullGCPtr<ResizeObserverSize>> m_last_reported_sizes;
+
+    // The target's box size change count as of when this observation was last found to be up to date.
+    Optional<u64> m_box_size_change_count_when_up_to_date;
 };
 
 }
@@ -157,28 +157,72 @@ ErrorOr<Vector<Metadata>> get_strongest_metadata_from_set(Vector<Metadata> const
 
 // https://w3c.github.io/webappsec-subresource-integrity/#does-response-match-metadatalist
 ErrorOr<bool> do_bytes_match_metadata_list(ByteBuffer const& bytes, StringView metadata_list)
+{
+    auto matcher = TRY(MetadataListMatcher::create(metadata_list));
+    matcher.update(bytes);
+    return matcher.matches();
+}
+
+ErrorOr<MetadataListMatcher> MetadataListMatcher::create(StringView metadata_list)
 {
     // 1. Let parsedMetadata be the result of parsing metadataList.
     auto parsed_metadata = TRY(parse_metadata(metadata_list));
 
     // 2. If parsedMetadata is empty set, return true.
     if (parsed_metadata.is_empty())
-        return true;
+        return MetadataListMatcher { {}, Empty {} };
 
     // 3. Let metadata be the result of getting the strongest metadata from parsedMetadata.
     auto metadata = TRY(get_strongest_metadata_from_set(parsed_metadata));
 
+    // NOTE: All of the strongest metadata uses the same algorithm, so the bytes only have to be hashed once for all of it.
+    auto const& algorithm = metadata.first().algorithm;
+    HashFunction hash_function = Empty {};
+    if (algorithm == "sha256"sv)
+        hash_function = Crypto::Hash::SHA256 {};
+    else if (algorithm == "sha384"sv)
+        hash_function = Crypto::Hash::SHA384 {};
+    else if (algorithm == "sha512"sv)
+        hash_function = Crypto::Hash::SHA512 {};
+    else
+        VERIFY_NOT_REACHED();
+
+    return MetadataListMatcher { move(metadata), move(hash_function) };
+}
+
+MetadataListMatcher::MetadataListMatcher(Vector<Metadata> metadata, HashFunction hash_function)
+    : m_metadata(move(metadata))
+    , m_hash_function(move(hash_function))
+{
+}
+
+void MetadataListMatcher::update(ReadonlyBytes bytes)
+{
+    m_hash_function.visit(
+        [](Empty) {},
+        [&](auto& hash_function) { hash_function.update(bytes); });
+}
+
+ErrorOr<bool> MetadataListMatcher::matches()
+{
+    if (m_metadata.is_empty())
+        return true;
+
+    // 3. Let actualValue be the result of applying algorithm to bytes.
+    //    NOTE: This is the same for every item, see create().
+    auto actual_value = TRY(m_hash_function.visit(
+        [](Empty) -> ErrorOr<String> { VERIFY_NOT_REACHED(); },
+        [](auto& hash_function) -> ErrorOr<String> {
+            auto result = hash_function.digest();
+            return encode_base64(result.bytes());
+        }));
+
     // 4. For each item in metadata:
-    for (auto const& item : metadata) {
+    for (auto const& item : m_metadata) {
         // 1. Let algorithm be the item["alg"].
-        auto& algorithm = item.algorithm;
-
         // 2. Let expectedValue be the item["val"].
         auto& expected_value = item.base64_value;
 
-        // 3. Let actualValue be the result of applying algorithm to bytes.
-        auto actual_value = TRY(apply_algorithm_to_bytes(algorithm, bytes));
-
         // 4. If actualValue is a case-sensitive match for expectedValue, return true.
         if (actual_value == expected_value)
             return true;
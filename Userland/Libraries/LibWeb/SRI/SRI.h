@@ -7,6 +7,8 @@
 #pragma once
 
 #include <AK/String.h>
+#include <AK/Variant.h>
+#include <LibCrypto/Hash/SHA2.h>
 
 namespace Web::SRI {
 
@@ -15,6 +17,8 @@ struct Metadata {
     String algorithm;    // "alg"
     String base64_value; // "val"
     String options {};   // "opt"
+
+    bool operator==(Metadata const&) const = default;
 };
 
 ErrorOr<String> apply_algorithm_to_bytes(StringView algorithm, ByteBuffer const& bytes);
@@ -22,4 +26,22 @@ ErrorOr<Vector<Metadata>> parse_metadata(StringView metadata);
 ErrorOr<Vector<Metadata>> get_strongest_metadata_from_set(Vector<Metadata> const& set);
 ErrorOr<bool> do_bytes_match_metadata_list(ByteBuffer const& bytes, StringView metadata_list);
 
+// Does the work of do_bytes_match_metadata_list() incrementally, so that the bytes can be hashed as they arrive and the
+// result is ready as soon as the last of them has.
+class MetadataListMatcher {
+public:
+    static ErrorOr<MetadataListMatcher> create(StringView metadata_list);
+
+    void update(ReadonlyBytes);
+    ErrorOr<bool> matches();
+
+private:
+    using HashFunction = Variant<Empty, Crypto::Hash::SHA256, Crypto::Hash::SHA384, Crypto::Hash::SHA512>;
+
+    MetadataListMatcher(Vector<Metadata>, HashFunction);
+
+    Vector<Metadata> m_metadata;
+    HashFunction m_hash_function;
+};
+
 }
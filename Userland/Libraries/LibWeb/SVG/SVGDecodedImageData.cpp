@@ -116,16 +116,23 @@ RefPtr<Gfx::ImmutableBitmap> SVGDecodedImageData::bitmap(size_t, Gfx::IntSize si
     if (size.is_empty())
         return nullptr;
 
-    if (auto it = m_cached_rendered_bitmaps.find(size); it != m_cached_rendered_bitmaps.end())
-        return it->value;
+    if (auto it = m_cached_rendered_bitmaps.find(size); it != m_cached_rendered_bitmaps.end()) {
+        it->value.last_use = ++m_bitmap_use_counter;
+        return it->value.bitmap;
+    }
 
-    // Prevent the cache from growing too big.
-    // FIXME: Evict least used entries.
-    if (m_cached_rendered_bitmaps.size() > 10)
-        m_cached_rendered_bitmaps.remove(m_cached_rendered_bitmaps.begin());
+    // Prevent the cache from growing too big, by evicting the size that was used least recently.
+    if (m_cached_rendered_bitmaps.size() > 10) {
+        auto least_recently_used = m_cached_rendered_bitmaps.begin();
+        for (auto it = m_cached_rendered_bitmaps.begin(); it != m_cached_rendered_bitmaps.end(); ++it) {
+            if (it->value.last_use < least_recently_used->value.last_use)
+                least_recently_used = it;
+        }
+        m_cached_rendered_bitmaps.remove(least_recently_used);
+    }
 
     auto immutable_bitmap = Gfx::ImmutableBitmap::create(*render(size));
-    m_cached_rendered_bitmaps.set(size, immutable_bitmap);
+    m_cached_rendered_bitmaps.set(size, { immutable_bitmap, ++m_bitmap_use_counter });
     return immutable_bitmap;
 }
 
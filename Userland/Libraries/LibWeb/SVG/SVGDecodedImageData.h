@@ -42,7 +42,12 @@ private:
 
     RefPtr<Gfx::Bitmap> render(Gfx::IntSize) const;
 
-    mutable HashMap<Gfx::IntSize, NonnullRefPtr<Gfx::ImmutableBitmap>> m_cached_rendered_bitmaps;
+    struct CachedBitmap {
+        NonnullRefPtr<Gfx::ImmutableBitmap> bitmap;
+        u64 last_use { 0 };
+    };
+    mutable HashMap<Gfx::IntSize, CachedBitmap> m_cached_rendered_bitmaps;
+    mutable u64 m_bitmap_use_counter { 0 };
 
     JS::NonnullGCPtr<Page> m_page;
     JS::NonnullGCPtr<SVGPageClient> m_page_client;
@@ -101,8 +101,10 @@ void SVGPathElement::attribute_changed(FlyString const& name, Optional<String> c
 {
     SVGGeometryElement::attribute_changed(name, old_value, value);
 
-    if (name == "d")
+    if (name == "d") {
         m_instructions = AttributeParser::parse_path_data(value.value_or(String {}));
+        m_path.clear();
+    }
 }
 
 Gfx::Path path_from_path_instructions(ReadonlySpan<PathInstruction> instructions)
@@ -275,7 +277,9 @@ Gfx::Path path_from_path_instructions(ReadonlySpan<PathInstruction> instructions
 
 Gfx::Path SVGPathElement::get_path(CSSPixelSize)
 {
-    return path_from_path_instructions(m_instructions);
+    if (!m_path.has_value())
+        m_path = path_from_path_instructions(m_instructions);
+    return *m_path;
 }
 
 }
@@ -30,6 +30,9 @@ private:
     virtual void initialize(JS::Realm&) override;
 
     Vector<PathInstruction> m_instructions;
+
+    // Built from m_instructions the first time it's needed, as long paths take a while to build on every layout.
+    Optional<Gfx::Path> m_path;
 };
 
 [[nodiscard]] Gfx::Path path_from_path_instructions(ReadonlySpan<PathInstruction>);
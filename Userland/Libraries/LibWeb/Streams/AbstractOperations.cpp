@@ -3386,8 +3386,11 @@ WebIDL::ExceptionOr<void> readable_stream_pull_from_bytes(ReadableStream& stream
     // 3. Let desiredSize be available.
     auto desired_size = available;
 
-    // FIXME: 4. If stream’s current BYOB request view is non-null, then set desiredSize to stream’s current BYOB request
-    //           view's byte length.
+    // 4. If stream’s current BYOB request view is non-null, then set desiredSize to stream’s current BYOB request
+    //    view's byte length.
+    auto byob_view = current_byob_request_view(stream);
+    if (byob_view)
+        desired_size = byob_view->byte_length();
 
     // 5. Let pullSize be the smaller value of available and desiredSize.
     auto pull_size = min(available, desired_size);
@@ -3399,24 +3402,57 @@ WebIDL::ExceptionOr<void> readable_stream_pull_from_bytes(ReadableStream& stream
     if (pull_size != available)
         bytes = MUST(bytes.slice(pull_size, available - pull_size));
 
-    // FIXME: 8. If stream’s current BYOB request view is non-null, then:
-    //           1. Write pulled into stream’s current BYOB request view.
-    //           2. Perform ? ReadableByteStreamControllerRespond(stream.[[controller]], pullSize).
-    // 9. Otherwise,
-    {
+    auto enqueue_as_new_chunk = [&](ByteBuffer chunk) -> WebIDL::ExceptionOr<void> {
         auto& realm = HTML::relevant_realm(stream);
 
         // 1. Set view to the result of creating a Uint8Array from pulled in stream’s relevant Realm.
-        auto array_buffer = JS::ArrayBuffer::create(realm, move(pulled));
+        auto array_buffer = JS::ArrayBuffer::create(realm, move(chunk));
         auto view = JS::Uint8Array::create(realm, array_buffer->byte_length(), *array_buffer);
 
         // 2. Perform ? ReadableByteStreamControllerEnqueue(stream.[[controller]], view).
-        TRY(readable_byte_stream_controller_enqueue(controller, view));
+        return readable_byte_stream_controller_enqueue(controller, view);
+    };
+
+    // 8. If stream’s current BYOB request view is non-null, then:
+    if (byob_view) {
+        // 1. Write pulled into stream’s current BYOB request view.
+        // NOTE: This is the only copy the bytes go through on their way to the reader, no chunk is allocated for them.
+        auto view_bytes = byob_view->viewed_array_buffer()->buffer().bytes().slice(byob_view->byte_offset(), pull_size);
+        pulled.bytes().copy_to(view_bytes);
+
+        // 2. Perform ? ReadableByteStreamControllerRespond(stream.[[controller]], pullSize).
+        TRY(readable_byte_stream_controller_respond(controller, pull_size));
+
+        // NOTE: The spec leaves the remaining bytes in the buffer for the next pull. Our callers hand us each batch of
+        //       bytes only once, so they are enqueued for the following reads instead.
+        if (pull_size != available)
+            TRY(enqueue_as_new_chunk(move(bytes)));
+    }
+    // 9. Otherwise,
+    else {
+        TRY(enqueue_as_new_chunk(move(pulled)));
     }
 
     return {};
 }
 
+// https://streams.spec.whatwg.org/#readablestream-current-byob-request-view
+JS::GCPtr<WebIDL::ArrayBufferView> current_byob_request_view(ReadableStream& stream)
+{
+    // 1. Assert: stream.[[controller]] implements ReadableByteStreamController.
+    auto controller = stream.controller()->get<JS::NonnullGCPtr<ReadableByteStreamController>>();
+
+    // 2. Let byobRequest be ! ReadableByteStreamControllerGetBYOBRequest(stream.[[controller]]).
+    auto byob_request = readable_byte_stream_controller_get_byob_request(controller);
+
+    // 3. If byobRequest is null, then return null.
+    if (!byob_request)
+        return {};
+
+    // 4. Return byobRequest.[[view]].
+    return byob_request->view();
+}
+
 // https://streams.spec.whatwg.org/#transfer-array-buffer
 WebIDL::ExceptionOr<JS::NonnullGCPtr<JS::ArrayBuffer>> transfer_array_buffer(JS::Realm& realm, JS::ArrayBuffer& buffer)
 {
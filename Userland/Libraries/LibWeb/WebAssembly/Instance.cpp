@@ -23,12 +23,9 @@ JS_DEFINE_ALLOCATOR(Instance);
 
 WebIDL::ExceptionOr<JS::NonnullGCPtr<Instance>> Instance::construct_impl(JS::Realm& realm, Module& module, Optional<JS::Handle<JS::Object>>& import_object)
 {
-    // FIXME: Implement the importObject parameter.
-    (void)import_object;
-
     auto& vm = realm.vm();
 
-    auto module_instance = TRY(Detail::instantiate_module(vm, module.compiled_module()->module));
+    auto module_instance = TRY(Detail::instantiate_module(vm, module.compiled_module()->module, import_object.has_value() ? import_object->ptr() : nullptr));
     return vm.heap().allocate<Instance>(realm, realm, move(module_instance));
 }
 
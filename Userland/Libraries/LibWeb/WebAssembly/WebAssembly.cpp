@@ -5,9 +5,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashMap.h>
 #include <AK/MemoryStream.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
+#include <LibCrypto/Hash/SHA2.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/BigInt.h>
@@ -18,13 +20,22 @@
 #include <LibJS/Runtime/Promise.h>
 #include <LibJS/Runtime/TypedArray.h>
 #include <LibJS/Runtime/VM.h>
+#include <LibThreading/BackgroundAction.h>
 #include <LibWasm/AbstractMachine/Validator.h>
+#include <LibWeb/Bindings/HostDefined.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Statuses.h>
+#include <LibWeb/Fetch/Response.h>
+#include <LibWeb/HTML/EventLoop/EventLoop.h>
+#include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/WebAssembly/Instance.h>
 #include <LibWeb/WebAssembly/Memory.h>
 #include <LibWeb/WebAssembly/Module.h>
 #include <LibWeb/WebAssembly/Table.h>
 #include <LibWeb/WebAssembly/WebAssembly.h>
 #include <LibWeb/WebIDL/Buffers.h>
+#include <LibWeb/WebIDL/Promise.h>
 
 namespace Web::WebAssembly {
 
@@ -37,6 +48,51 @@ WebAssemblyCache& get_cache(JS::Realm& realm)
     return s_caches.ensure(realm.global_object());
 }
 
+Optional<CompiledModuleCache::Key> CompiledModuleCache::key_for(ReadonlyBytes bytes)
+{
+    if (bytes.size() < minimum_module_size_to_cache || bytes.size() > maximum_cached_module_size)
+        return {};
+
+    auto digest = ::Crypto::Hash::SHA256::hash(bytes);
+    Key key;
+    digest.bytes().copy_to(key);
+    return key;
+}
+
+CompiledModuleCache& CompiledModuleCache::the()
+{
+    static CompiledModuleCache cache;
+    return cache;
+}
+
+bool CompiledModuleCache::contains(Key const& key) const
+{
+    Threading::MutexLocker locker { m_mutex };
+    return m_entries.contains_if([&](auto const& entry) { return entry.key == key; });
+}
+
+RefPtr<Wasm::Module> CompiledModuleCache::find(Key const& key)
+{
+    Threading::MutexLocker locker { m_mutex };
+    auto* entry = m_entries.find_if([&](auto const& candidate) { return candidate.key == key; });
+    if (!entry)
+        return nullptr;
+    return entry->module;
+}
+
+void CompiledModuleCache::add(Key const& key, size_t module_size, NonnullRefPtr<Wasm::Module> module)
+{
+    Threading::MutexLocker locker { m_mutex };
+    if (m_entries.contains_if([&](auto const& entry) { return entry.key == key; }))
+        return;
+
+    while (!m_entries.is_empty() && m_cached_module_size + module_size > maximum_cached_module_size)
+        m_cached_module_size -= m_entries.take_least_recently_used().module_size;
+
+    m_entries.add(Entry { .key = key, .module_size = module_size, .module = move(module) });
+    m_cached_module_size += module_size;
+}
+
 }
 
 void visit_edges(JS::Object& object, JS::Cell::Visitor& visitor)
@@ -79,71 +135,170 @@ bool validate(JS::VM& vm, JS::Handle<WebIDL::BufferSource>& bytes)
     return true;
 }
 
-// https://webassembly.github.io/spec/js-api/#dom-webassembly-compile
-WebIDL::ExceptionOr<JS::Value> compile(JS::VM& vm, JS::Handle<WebIDL::BufferSource>& bytes)
+// NOTE: The background action that compiles a module may be destroyed on the background thread, so it only carries the
+//       ID of its compilation. The GC handles stay here, where only the main thread touches them.
+struct PendingCompilation {
+    JS::Handle<JS::Realm> realm;
+    JS::Handle<WebIDL::Promise> promise;
+};
+static HashMap<u64, PendingCompilation> s_pending_compilations;
+static u64 s_next_compilation_id { 0 };
+
+// https://webassembly.github.io/spec/js-api/#asynchronously-compile-a-webassembly-module
+static JS::NonnullGCPtr<WebIDL::Promise> asynchronously_compile_webassembly_module(JS::VM& vm, ByteBuffer bytes, HTML::Task::Source task_source = HTML::Task::Source::JavaScriptEngine)
 {
     auto& realm = *vm.current_realm();
 
-    // FIXME: This shouldn't block!
-    auto compiled_module_or_error = Detail::parse_module(vm, bytes->raw_object());
-    auto promise = JS::Promise::create(realm);
-
-    if (compiled_module_or_error.is_error()) {
-        promise->reject(*compiled_module_or_error.release_error().value());
-    } else {
-        auto module_object = vm.heap().allocate<Module>(realm, realm, compiled_module_or_error.release_value());
-        promise->fulfill(module_object);
-    }
+    // 1. Let promise be a new promise.
+    auto promise = WebIDL::create_promise(realm);
+
+    auto compilation_id = s_next_compilation_id++;
+    s_pending_compilations.set(compilation_id, { JS::make_handle(realm), JS::make_handle(promise) });
+
+    // 2. Run the following steps in parallel:
+    // NOTE: If the module is in the compiled module cache, the background thread only computes its key, and leaves
+    //       the module empty for the main thread to pick up from the cache.
+    struct CompileResult {
+        Optional<Detail::CompiledModuleCache::Key> cache_key;
+        Variant<Empty, NonnullRefPtr<Wasm::Module>, ByteString> module;
+    };
+
+    // NOTE: The bytes are owned by the completion callback so they're still around if the module has to be compiled
+    //       on the main thread after all, which is why they have to live on the heap.
+    auto owned_bytes = make<ByteBuffer>(move(bytes));
+    (void)Threading::BackgroundAction<CompileResult>::construct(
+        [bytes = owned_bytes->bytes()](auto&) -> ErrorOr<CompileResult> {
+            // 1. Compile the WebAssembly module bytes and store the result as module.
+            auto cache_key = Detail::CompiledModuleCache::key_for(bytes);
+            if (cache_key.has_value() && Detail::CompiledModuleCache::the().contains(*cache_key))
+                return CompileResult { cache_key, Empty {} };
+            return CompileResult { cache_key, Detail::compile_a_webassembly_module(bytes) };
+        },
+        [compilation_id, task_source, owned_bytes = move(owned_bytes)](CompileResult result) -> ErrorOr<void> {
+            auto [realm, promise] = s_pending_compilations.take(compilation_id).release_value();
+
+            auto& cache = Detail::CompiledModuleCache::the();
+            Variant<NonnullRefPtr<Wasm::Module>, ByteString> module = ByteString {};
+            if (result.module.has<Empty>()) {
+                // NOTE: The module may have been evicted since the background thread looked for it, in which case we
+                //       have no choice but to compile it again right here.
+                if (auto cached_module = cache.find(*result.cache_key))
+                    module = cached_module.release_nonnull();
+                else
+                    module = Detail::compile_a_webassembly_module(*owned_bytes);
+            } else {
+                module = move(result.module).downcast<NonnullRefPtr<Wasm::Module>, ByteString>();
+            }
+            if (auto* compiled_module = module.get_pointer<NonnullRefPtr<Wasm::Module>>(); compiled_module && result.cache_key.has_value())
+                cache.add(*result.cache_key, owned_bytes->size(), *compiled_module);
+
+            // 2. Queue a task to perform the following steps. If taskSource was provided, queue the task on that task source.
+            HTML::queue_global_task(task_source, realm->global_object(), JS::create_heap_function(realm->heap(), [realm = realm.ptr(), promise = promise.ptr(), module = move(module)]() {
+                HTML::TemporaryExecutionContext execution_context { Bindings::host_defined_environment_settings_object(*realm) };
+
+                // 1. If module is error, reject promise with a CompileError exception.
+                if (auto* error = module.get_pointer<ByteString>()) {
+                    // FIXME: Reject with a CompileError instead.
+                    WebIDL::reject_promise(*realm, *promise, JS::TypeError::create(*realm, error->view()));
+                    return;
+                }
+
+                // 2. Otherwise,
+                //     1. Construct a WebAssembly module object from module and bytes, and let moduleObject be the result.
+                auto compiled_module = make_ref_counted<Detail::CompiledWebAssemblyModule>(module.get<NonnullRefPtr<Wasm::Module>>());
+                Detail::get_cache(*realm).add_compiled_module(compiled_module);
+                auto module_object = realm->heap().allocate<Module>(*realm, *realm, move(compiled_module));
+
+                //     2. Resolve promise with moduleObject.
+                WebIDL::resolve_promise(*realm, *promise, module_object);
+            }));
+            return {};
+        });
 
+    // 3. Return promise.
     return promise;
 }
 
-// https://webassembly.github.io/spec/js-api/#dom-webassembly-instantiate
-WebIDL::ExceptionOr<JS::Value> instantiate(JS::VM& vm, JS::Handle<WebIDL::BufferSource>& bytes, Optional<JS::Handle<JS::Object>>& import_object)
+// https://webassembly.github.io/spec/js-api/#instantiate-a-promise-of-a-module
+static JS::NonnullGCPtr<WebIDL::Promise> instantiate_promise_of_module(JS::VM& vm, WebIDL::Promise const& promise_of_module, JS::GCPtr<JS::Object> import_object)
 {
-    // FIXME: Implement the importObject parameter.
-    (void)import_object;
-
     auto& realm = *vm.current_realm();
 
-    // FIXME: This shouldn't block!
-    auto compiled_module_or_error = Detail::parse_module(vm, bytes->raw_object());
-    auto promise = JS::Promise::create(realm);
+    // 1. Let promise be a new promise.
+    auto promise = WebIDL::create_promise(realm);
 
-    if (compiled_module_or_error.is_error()) {
-        promise->reject(*compiled_module_or_error.release_error().value());
-        return promise;
-    }
+    // 2. Upon fulfillment of promiseOfModule with value module:
+    auto fulfillment_steps = JS::create_heap_function(realm.heap(), [&realm, promise, import_object](JS::Value module) -> WebIDL::ExceptionOr<JS::Value> {
+        auto& vm = realm.vm();
+        auto& module_object = verify_cast<Module>(module.as_object());
 
-    auto compiled_module = compiled_module_or_error.release_value();
-    auto result = Detail::instantiate_module(vm, compiled_module->module);
+        // 1. Instantiate the WebAssembly module module importing importObject, and let innerPromise be the result.
+        // NOTE: Instantiation happens synchronously here, so there is no innerPromise to wait for.
+        auto result = Detail::instantiate_module(vm, module_object.compiled_module()->module, import_object);
 
-    if (result.is_error()) {
-        promise->reject(*result.release_error().value());
-    } else {
-        auto module_object = vm.heap().allocate<Module>(realm, realm, move(compiled_module));
+        // 3. Upon rejection of innerPromise with reason reason, reject promise with reason.
+        if (result.is_error()) {
+            WebIDL::reject_promise(realm, promise, *result.release_error().value());
+            return JS::js_undefined();
+        }
+
+        // 2. Upon fulfillment of innerPromise with value instance:
         auto instance_object = vm.heap().allocate<Instance>(realm, realm, result.release_value());
 
+        //     1. Let result be the WebAssemblyInstantiatedSource value «[ "module" → module, "instance" → instance ]».
         auto object = JS::Object::create(realm, nullptr);
-        object->define_direct_property("module", module_object, JS::default_attributes);
+        object->define_direct_property("module", &module_object, JS::default_attributes);
         object->define_direct_property("instance", instance_object, JS::default_attributes);
-        promise->fulfill(object);
-    }
 
+        //     2. Resolve promise with result.
+        WebIDL::resolve_promise(realm, promise, object);
+        return JS::js_undefined();
+    });
+
+    // 3. Upon rejection of promiseOfModule with reason reason:
+    auto rejection_steps = JS::create_heap_function(realm.heap(), [&realm, promise](JS::Value reason) -> WebIDL::ExceptionOr<JS::Value> {
+        // 1. Reject promise with reason.
+        WebIDL::reject_promise(realm, promise, reason);
+        return JS::js_undefined();
+    });
+
+    WebIDL::react_to_promise(promise_of_module, fulfillment_steps, rejection_steps);
+
+    // 4. Return promise.
     return promise;
 }
 
+// https://webassembly.github.io/spec/js-api/#dom-webassembly-compile
+WebIDL::ExceptionOr<JS::Value> compile(JS::VM& vm, JS::Handle<WebIDL::BufferSource>& bytes)
+{
+    // 1. Let stableBytes be a copy of the bytes held by the buffer bytes.
+    auto stable_bytes = TRY_OR_THROW_OOM(vm, ByteBuffer::copy(TRY(Detail::bytes_of_buffer_source(vm, bytes->raw_object()))));
+
+    // 2. Asynchronously compile a WebAssembly module from stableBytes and return the result.
+    return asynchronously_compile_webassembly_module(vm, move(stable_bytes))->promise();
+}
+
+// https://webassembly.github.io/spec/js-api/#dom-webassembly-instantiate
+WebIDL::ExceptionOr<JS::Value> instantiate(JS::VM& vm, JS::Handle<WebIDL::BufferSource>& bytes, Optional<JS::Handle<JS::Object>>& import_object)
+{
+    // 1. Let stableBytes be a copy of the bytes held by the buffer bytes.
+    auto stable_bytes = TRY_OR_THROW_OOM(vm, ByteBuffer::copy(TRY(Detail::bytes_of_buffer_source(vm, bytes->raw_object()))));
+
+    // 2. Asynchronously compile a WebAssembly module from stableBytes and let promiseOfModule be the result.
+    auto promise_of_module = asynchronously_compile_webassembly_module(vm, move(stable_bytes));
+
+    // 3. Instantiate promiseOfModule with imports importObject and return the result.
+    return instantiate_promise_of_module(vm, promise_of_module, import_object.has_value() ? import_object->ptr() : nullptr)->promise();
+}
+
 // https://webassembly.github.io/spec/js-api/#dom-webassembly-instantiate-moduleobject-importobject
 WebIDL::ExceptionOr<JS::Value> instantiate(JS::VM& vm, Module const& module_object, Optional<JS::Handle<JS::Object>>& import_object)
 {
-    // FIXME: Implement the importObject parameter.
-    (void)import_object;
-
     auto& realm = *vm.current_realm();
     auto promise = JS::Promise::create(realm);
 
     auto const& compiled_module = module_object.compiled_module();
-    auto result = Detail::instantiate_module(vm, compiled_module->module);
+    auto result = Detail::instantiate_module(vm, compiled_module->module, import_object.has_value() ? import_object->ptr() : nullptr);
 
     if (result.is_error()) {
         promise->reject(*result.release_error().value());
@@ -155,16 +310,127 @@ WebIDL::ExceptionOr<JS::Value> instantiate(JS::VM& vm, Module const& module_obje
     return promise;
 }
 
+// https://webassembly.github.io/spec/web-api/#compile-a-potential-webassembly-response
+static JS::NonnullGCPtr<WebIDL::Promise> compile_potential_webassembly_response(JS::VM& vm, JS::Promise& source)
+{
+    auto& realm = *vm.current_realm();
+
+    // 1. Let returnValue be a new promise.
+    auto return_value = WebIDL::create_promise(realm);
+
+    // 2. Upon fulfillment of source with value unwrappedSource:
+    auto fulfillment_steps = JS::create_heap_function(realm.heap(), [&realm, return_value](JS::Value unwrapped_source) -> WebIDL::ExceptionOr<JS::Value> {
+        auto& vm = realm.vm();
+
+        auto reject_with_type_error = [&](StringView message) {
+            WebIDL::reject_promise(realm, return_value, JS::TypeError::create(realm, message));
+            return JS::js_undefined();
+        };
+
+        // NOTE: The IDL only guarantees that source is a promise, not what it resolves to.
+        if (!unwrapped_source.is_object() || !is<Fetch::Response>(unwrapped_source.as_object()))
+            return reject_with_type_error("Source is not a Response"sv);
+        auto& response_object = static_cast<Fetch::Response&>(unwrapped_source.as_object());
+
+        // 1. Let response be unwrappedSource's response.
+        auto response = response_object.response();
+
+        // 2. Let mimeType be the result of getting `Content-Type` from response's header list.
+        auto mime_type = response->header_list()->get("Content-Type"sv.bytes());
+
+        // 3. If mimeType is null, reject returnValue with a TypeError and abort these substeps.
+        if (!mime_type.has_value())
+            return reject_with_type_error("Response has no Content-Type"sv);
+
+        // 4. Remove all HTTP tab or space byte from the start and end of mimeType.
+        auto trimmed_mime_type = StringView { *mime_type }.trim(Fetch::Infrastructure::HTTP_TAB_OR_SPACE);
+
+        // 5. If mimeType is not a byte-case-insensitive match for `application/wasm`, reject returnValue with a TypeError and abort these substeps.
+        if (!trimmed_mime_type.equals_ignoring_ascii_case("application/wasm"sv))
+            return reject_with_type_error("Response does not have the application/wasm MIME type"sv);
+
+        // 6. If response is not CORS-same-origin, reject returnValue with a TypeError and abort these substeps.
+        if (response->is_cors_cross_origin())
+            return reject_with_type_error("Response is not CORS-same-origin"sv);
+
+        // 7. If response's status is not an ok status, reject returnValue with a TypeError and abort these substeps.
+        if (!Fetch::Infrastructure::is_ok_status(response->status()))
+            return reject_with_type_error("Response does not have an ok status"sv);
+
+        // 8. Consume response's body as an ArrayBuffer, and let bodyPromise be the result.
+        auto body_promise_or_error = response_object.array_buffer();
+        if (body_promise_or_error.is_error()) {
+            auto completion = Bindings::dom_exception_to_throw_completion(vm, body_promise_or_error.release_error());
+            WebIDL::reject_promise(realm, return_value, *completion.value());
+            return JS::js_undefined();
+        }
+        auto body_promise = WebIDL::create_resolved_promise(realm, body_promise_or_error.release_value());
+
+        // 9. Upon fulfillment of bodyPromise with value bodyArrayBuffer:
+        auto body_fulfillment_steps = JS::create_heap_function(realm.heap(), [&realm, return_value](JS::Value body_array_buffer) -> WebIDL::ExceptionOr<JS::Value> {
+            auto& vm = realm.vm();
+
+            // 1. Let stableBytes be a copy of the bytes held by the buffer bodyArrayBuffer.
+            auto stable_bytes = TRY_OR_THROW_OOM(vm, ByteBuffer::copy(verify_cast<JS::ArrayBuffer>(body_array_buffer.as_object()).buffer()));
+
+            // 2. Asynchronously compile the WebAssembly module stableBytes using the networking task source and resolve returnValue with the result.
+            auto promise_of_module = asynchronously_compile_webassembly_module(vm, move(stable_bytes), HTML::Task::Source::Networking);
+            WebIDL::resolve_promise(realm, return_value, promise_of_module->promise());
+            return JS::js_undefined();
+        });
+
+        // 10. Upon rejection of bodyPromise with reason reason:
+        auto body_rejection_steps = JS::create_heap_function(realm.heap(), [&realm, return_value](JS::Value reason) -> WebIDL::ExceptionOr<JS::Value> {
+            // 1. Reject returnValue with reason.
+            WebIDL::reject_promise(realm, return_value, reason);
+            return JS::js_undefined();
+        });
+
+        WebIDL::react_to_promise(body_promise, body_fulfillment_steps, body_rejection_steps);
+        return JS::js_undefined();
+    });
+
+    // 3. Upon rejection of source with reason reason:
+    auto rejection_steps = JS::create_heap_function(realm.heap(), [&realm, return_value](JS::Value reason) -> WebIDL::ExceptionOr<JS::Value> {
+        // 1. Reject returnValue with reason.
+        WebIDL::reject_promise(realm, return_value, reason);
+        return JS::js_undefined();
+    });
+
+    WebIDL::react_to_promise(WebIDL::create_resolved_promise(realm, &source), fulfillment_steps, rejection_steps);
+
+    // 4. Return returnValue.
+    return return_value;
+}
+
+// https://webassembly.github.io/spec/web-api/#dom-webassembly-compilestreaming
+WebIDL::ExceptionOr<JS::Value> compile_streaming(JS::VM& vm, JS::Handle<JS::Promise>& source)
+{
+    // 1. Let promise be a new promise.
+    // 2. Compile a potential WebAssembly response with source and promise.
+    // 3. Return promise.
+    return compile_potential_webassembly_response(vm, *source)->promise();
+}
+
+// https://webassembly.github.io/spec/web-api/#dom-webassembly-instantiatestreaming
+WebIDL::ExceptionOr<JS::Value> instantiate_streaming(JS::VM& vm, JS::Handle<JS::Promise>& source, Optional<JS::Handle<JS::Object>>& import_object)
+{
+    // 1. Let promiseOfModule be a new promise.
+    // 2. Compile a potential WebAssembly response with source and promiseOfModule.
+    auto promise_of_module = compile_potential_webassembly_response(vm, *source);
+
+    // 3. Return the result of instantiating the promise of a module promiseOfModule with imports importObject.
+    return instantiate_promise_of_module(vm, promise_of_module, import_object.has_value() ? import_object->ptr() : nullptr)->promise();
+}
+
 namespace Detail {
 
-JS::ThrowCompletionOr<NonnullOwnPtr<Wasm::ModuleInstance>> instantiate_module(JS::VM& vm, Wasm::Module const& module)
+JS::ThrowCompletionOr<NonnullOwnPtr<Wasm::ModuleInstance>> instantiate_module(JS::VM& vm, Wasm::Module const& module, JS::GCPtr<JS::Object> import_object)
 {
     Wasm::Linker linker { module };
     HashMap<Wasm::Linker::Name, Wasm::ExternValue> resolved_imports;
-    auto import_argument = vm.argument(1);
     auto& cache = get_cache(*vm.current_realm());
-    if (!import_argument.is_undefined()) {
-        auto import_object = TRY(import_argument.to_object(vm));
+    if (import_object) {
         dbgln_if(LIBWEB_WASM_DEBUG, "Trying to resolve stuff because import object was specified");
         for (Wasm::Linker::Name const& import_name : linker.unresolved_imports()) {
             dbgln_if(LIBWEB_WASM_DEBUG, "Trying to resolve {}::{}", import_name.module, import_name.name);
@@ -307,7 +573,7 @@ JS::ThrowCompletionOr<NonnullOwnPtr<Wasm::ModuleInstance>> instantiate_module(JS
     return instance_result.release_value();
 }
 
-JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> parse_module(JS::VM& vm, JS::Object* buffer_object)
+JS::ThrowCompletionOr<ReadonlyBytes> bytes_of_buffer_source(JS::VM& vm, JS::Object* buffer_object)
 {
     ReadonlyBytes data;
     if (is<JS::ArrayBuffer>(buffer_object)) {
@@ -332,20 +598,42 @@ JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> parse_module(JS:
     } else {
         return vm.throw_completion<JS::TypeError>("Not a BufferSource"sv);
     }
-    FixedMemoryStream stream { data };
+    return data;
+}
+
+Variant<NonnullRefPtr<Wasm::Module>, ByteString> compile_a_webassembly_module(ReadonlyBytes bytes)
+{
+    FixedMemoryStream stream { bytes };
     auto module_result = Wasm::Module::parse(stream);
-    if (module_result.is_error()) {
-        // FIXME: Throw CompileError instead.
-        return vm.throw_completion<JS::TypeError>(Wasm::parse_error_to_byte_string(module_result.error()));
-    }
+    if (module_result.is_error())
+        return Wasm::parse_error_to_byte_string(module_result.error());
 
-    auto& cache = get_cache(*vm.current_realm());
-    if (auto validation_result = cache.abstract_machine().validate(module_result.value()); validation_result.is_error()) {
-        // FIXME: Throw CompileError instead.
-        return vm.throw_completion<JS::TypeError>(validation_result.error().error_string);
+    if (auto validation_result = Wasm::AbstractMachine::validate(module_result.value()); validation_result.is_error())
+        return validation_result.release_error().error_string;
+
+    return module_result.release_value();
+}
+
+JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> parse_module(JS::VM& vm, JS::Object* buffer_object)
+{
+    auto data = TRY(bytes_of_buffer_source(vm, buffer_object));
+
+    auto& module_cache = CompiledModuleCache::the();
+    auto cache_key = CompiledModuleCache::key_for(data);
+    RefPtr<Wasm::Module> module = cache_key.has_value() ? module_cache.find(*cache_key) : nullptr;
+    if (!module) {
+        auto module_or_error = compile_a_webassembly_module(data);
+        if (auto* error = module_or_error.get_pointer<ByteString>()) {
+            // FIXME: Throw CompileError instead.
+            return vm.throw_completion<JS::TypeError>(*error);
+        }
+        module = module_or_error.get<NonnullRefPtr<Wasm::Module>>();
+        if (cache_key.has_value())
+            module_cache.add(*cache_key, data.size(), *module);
     }
-    auto compiled_module = make_ref_counted<CompiledWebAssemblyModule>(module_result.release_value());
-    cache.add_compiled_module(compiled_module);
+
+    auto compiled_module = make_ref_counted<CompiledWebAssemblyModule>(module.release_nonnull());
+    get_cache(*vm.current_realm()).add_compiled_module(compiled_module);
     return compiled_module;
 }
 
@@ -7,11 +7,14 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/LRUList.h>
 #include <AK/Optional.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Handle.h>
 #include <LibJS/Runtime/Completion.h>
 #include <LibJS/Runtime/Value.h>
+#include <LibThreading/Mutex.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Forward.h>
@@ -27,6 +30,9 @@ WebIDL::ExceptionOr<JS::Value> compile(JS::VM&, JS::Handle<WebIDL::BufferSource>
 WebIDL::ExceptionOr<JS::Value> instantiate(JS::VM&, JS::Handle<WebIDL::BufferSource>& bytes, Optional<JS::Handle<JS::Object>>& import_object);
 WebIDL::ExceptionOr<JS::Value> instantiate(JS::VM&, Module const& module_object, Optional<JS::Handle<JS::Object>>& import_object);
 
+WebIDL::ExceptionOr<JS::Value> compile_streaming(JS::VM&, JS::Handle<JS::Promise>& source);
+WebIDL::ExceptionOr<JS::Value> instantiate_streaming(JS::VM&, JS::Handle<JS::Promise>& source, Optional<JS::Handle<JS::Object>>& import_object);
+
 namespace Detail {
 struct CompiledWebAssemblyModule : public RefCounted<CompiledWebAssemblyModule> {
     explicit CompiledWebAssemblyModule(NonnullRefPtr<Wasm::Module> module)
@@ -62,8 +68,46 @@ private:
 
 WebAssemblyCache& get_cache(JS::Realm&);
 
-JS::ThrowCompletionOr<NonnullOwnPtr<Wasm::ModuleInstance>> instantiate_module(JS::VM&, Wasm::Module const&);
+// Validated modules never change, so all realms in this process share them. This way repeat visits to a page, and
+// other documents using the same module, don't have to parse and validate it again.
+class CompiledModuleCache {
+public:
+    // NOTE: We don't bother caching tiny modules, they are cheap enough to compile again.
+    static constexpr size_t minimum_module_size_to_cache = 4 * KiB;
+    static constexpr size_t maximum_cached_module_size = 64 * MiB;
+
+    // The SHA-256 digest of the module's bytes, or nothing if the module isn't worth caching.
+    using Key = Array<u8, 32>;
+    static Optional<Key> key_for(ReadonlyBytes);
+
+    static CompiledModuleCache& the();
+
+    // This may be called from any thread.
+    bool contains(Key const&) const;
+
+    // These may only be called on the main thread, as the modules' reference counts aren't atomic.
+    RefPtr<Wasm::Module> find(Key const&);
+    void add(Key const&, size_t module_size, NonnullRefPtr<Wasm::Module>);
+
+private:
+    struct Entry {
+        Key key;
+        size_t module_size { 0 };
+        NonnullRefPtr<Wasm::Module> module;
+    };
+
+    mutable Threading::Mutex m_mutex;
+
+    LRUList<Entry> m_entries;
+    size_t m_cached_module_size { 0 };
+};
+
+JS::ThrowCompletionOr<NonnullOwnPtr<Wasm::ModuleInstance>> instantiate_module(JS::VM&, Wasm::Module const&, JS::GCPtr<JS::Object> import_object);
+JS::ThrowCompletionOr<ReadonlyBytes> bytes_of_buffer_source(JS::VM&, JS::Object* buffer);
 JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> parse_module(JS::VM&, JS::Object* buffer);
+
+// Parses and validates a module without touching any JS state, so this can run on any thread.
+Variant<NonnullRefPtr<Wasm::Module>, ByteString> compile_a_webassembly_module(ReadonlyBytes);
 JS::NativeFunction* create_native_function(JS::VM&, Wasm::FunctionAddress address, ByteString const& name, Instance* instance = nullptr);
 JS::ThrowCompletionOr<Wasm::Value> to_webassembly_value(JS::VM&, JS::Value value, Wasm::ValueType const& type);
 Wasm::Value default_webassembly_value(JS::VM&, Wasm::ValueType type);
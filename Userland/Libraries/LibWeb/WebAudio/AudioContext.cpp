@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/ThreadedPromise.h>
+#include <LibMedia/Audio/PlaybackStream.h>
 #include <LibWeb/Bindings/AudioContextPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/DOM/Event.h>
@@ -40,12 +42,15 @@ AudioContext::AudioContext(JS::Realm& realm, AudioContextOptions const& context_
     switch (context_options.latency_hint) {
     case Bindings::AudioContextLatencyCategory::Balanced:
         // FIXME: Determine optimal settings for balanced.
+        m_target_latency_ms = 50;
         break;
     case Bindings::AudioContextLatencyCategory::Interactive:
         // FIXME: Determine optimal settings for interactive.
+        m_target_latency_ms = 20;
         break;
     case Bindings::AudioContextLatencyCategory::Playback:
         // FIXME: Determine optimal settings for playback.
+        m_target_latency_ms = 100;
         break;
     default:
         VERIFY_NOT_REACHED();
@@ -220,7 +225,8 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<JS::Promise>> AudioContext::suspend()
     // 7. Queue a control message to suspend the AudioContext.
     // FIXME: Implement control message queue to run following steps on the rendering thread
 
-    // FIXME: 7.1: Attempt to release system resources.
+    // 7.1: Attempt to release system resources.
+    stop_rendering_audio_graph();
 
     // 7.2: Set the [[rendering thread state]] on the AudioContext to suspended.
     set_rendering_state(Bindings::AudioContextState::Suspended);
@@ -271,7 +277,8 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<JS::Promise>> AudioContext::close()
     // 5. Queue a control message to close the AudioContext.
     // FIXME: Implement control message queue to run following steps on the rendering thread
 
-    // FIXME: 5.1: Attempt to release system resources.
+    // 5.1: Attempt to release system resources.
+    stop_rendering_audio_graph();
 
     // 5.2: Set the [[rendering thread state]] to "suspended".
     set_rendering_state(Bindings::AudioContextState::Suspended);
@@ -304,11 +311,59 @@ void AudioContext::queue_a_media_element_task(Function<void()> steps)
     HTML::main_thread_event_loop().task_queue().add(move(task));
 }
 
-// FIXME: Actually implement the rendering thread
+void AudioContext::did_connect_to_destination()
+{
+    if (m_destination_has_input)
+        return;
+    m_destination_has_input = true;
+
+    if (rendering_state() == Bindings::AudioContextState::Running)
+        (void)start_rendering_audio_graph();
+}
+
+// https://webaudio.github.io/web-audio-api/#rendering-loop
 bool AudioContext::start_rendering_audio_graph()
 {
-    bool render_result = true;
-    return render_result;
+    // NOTE: There is nothing to hear until something is connected to the destination, so the audio device is left
+    //       alone until then.
+    if (!m_destination_has_input)
+        return true;
+
+    if (m_playback_stream) {
+        m_playback_stream->resume()->when_rejected([](Error&&) {
+            // FIXME: Propagate errors.
+        });
+        return true;
+    }
+
+    auto sample_rate = this->sample_rate();
+    auto playback_stream = Audio::PlaybackStream::create(
+        Audio::OutputState::Playing, static_cast<u32>(sample_rate), AudioBus::channel_count, m_target_latency_ms,
+        [render_graph = m_render_graph, sample_rate](Bytes buffer, Audio::PcmSampleFormat format, size_t sample_count) -> ReadonlyBytes {
+            VERIFY(format == Audio::PcmSampleFormat::Float32);
+
+            auto size = sample_count * AudioBus::channel_count * sizeof(float);
+            VERIFY(buffer.size() >= size);
+            render_graph->render({ reinterpret_cast<float*>(buffer.data()), sample_count * AudioBus::channel_count }, sample_rate);
+            return buffer.trim(size);
+        });
+    if (playback_stream.is_error()) {
+        dbgln("AudioContext: Failed to open the audio output: {}", playback_stream.error());
+        return false;
+    }
+
+    m_playback_stream = playback_stream.release_value();
+    return true;
+}
+
+void AudioContext::stop_rendering_audio_graph()
+{
+    if (!m_playback_stream)
+        return;
+
+    m_playback_stream->discard_buffer_and_suspend()->when_rejected([](Error&&) {
+        // FIXME: Propagate errors.
+    });
 }
 
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <LibMedia/Audio/Forward.h>
 #include <LibWeb/Bindings/AudioContextPrototype.h>
 #include <LibWeb/HighResolutionTime/DOMHighResTimeStamp.h>
 #include <LibWeb/WebAudio/BaseAudioContext.h>
@@ -45,6 +46,8 @@ private:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    virtual void did_connect_to_destination() override;
+
     double m_base_latency { 0 };
     double m_output_latency { 0 };
 
@@ -56,6 +59,13 @@ private:
 
     void queue_a_media_element_task(Function<void()> steps);
     bool start_rendering_audio_graph();
+    void stop_rendering_audio_graph();
+
+    u32 m_target_latency_ms { 0 };
+    bool m_destination_has_input { false };
+
+    // Its data request callback, which runs on the audio device's thread, is the rendering thread of this context.
+    RefPtr<Audio::PlaybackStream> m_playback_stream;
 };
 
 }
@@ -22,6 +22,22 @@ AudioDestinationNode::AudioDestinationNode(JS::Realm& realm, JS::NonnullGCPtr<Ba
 
 AudioDestinationNode::~AudioDestinationNode() = default;
 
+namespace {
+
+// Sends what's connected to it to the audio device.
+class DestinationRenderNode final : public RenderNode {
+public:
+    virtual bool is_destination() const override { return true; }
+    virtual void process(AudioBus&, float) override { }
+};
+
+}
+
+NonnullOwnPtr<RenderNode> AudioDestinationNode::create_render_node()
+{
+    return make<DestinationRenderNode>();
+}
+
 // https://webaudio.github.io/web-audio-api/#dom-audiodestinationnode-maxchannelcount
 WebIDL::UnsignedLong AudioDestinationNode::max_channel_count()
 {
@@ -31,6 +31,8 @@ protected:
 
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
+
+    virtual NonnullOwnPtr<RenderNode> create_render_node() override;
 };
 
 }
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <AK/SIMDExtras.h>
+#include <LibWeb/WebAudio/AudioKernels.h>
+
+namespace Web::WebAudio {
+
+using AK::SIMD::expand4;
+using AK::SIMD::f32x4;
+using AK::SIMD::load_unaligned;
+using AK::SIMD::store_unaligned;
+
+void mix_into(Span<float> destination, ReadonlySpan<float> source)
+{
+    VERIFY(destination.size() == source.size());
+
+    size_t i = 0;
+    for (; i + 4 <= destination.size(); i += 4) {
+        auto sum = load_unaligned<f32x4>(destination.data() + i) + load_unaligned<f32x4>(source.data() + i);
+        store_unaligned(destination.data() + i, sum);
+    }
+    for (; i < destination.size(); ++i)
+        destination[i] += source[i];
+}
+
+void apply_gain(Span<float> samples, float gain)
+{
+    auto gains = expand4(gain);
+
+    size_t i = 0;
+    for (; i + 4 <= samples.size(); i += 4)
+        store_unaligned(samples.data() + i, load_unaligned<f32x4>(samples.data() + i) * gains);
+    for (; i < samples.size(); ++i)
+        samples[i] *= gain;
+}
+
+void apply_gain_ramp(Span<float> samples, float start_gain, float end_gain)
+{
+    if (samples.is_empty())
+        return;
+    if (start_gain == end_gain) {
+        apply_gain(samples, end_gain);
+        return;
+    }
+
+    float step = (end_gain - start_gain) / static_cast<float>(samples.size());
+    auto gains = f32x4 { start_gain + step, start_gain + 2 * step, start_gain + 3 * step, start_gain + 4 * step };
+    auto gains_step = expand4(4 * step);
+
+    size_t i = 0;
+    for (; i + 4 <= samples.size(); i += 4) {
+        store_unaligned(samples.data() + i, load_unaligned<f32x4>(samples.data() + i) * gains);
+        gains += gains_step;
+    }
+    for (; i < samples.size(); ++i)
+        samples[i] *= start_gain + static_cast<float>(i + 1) * step;
+}
+
+void interleave(ReadonlySpan<float> left, ReadonlySpan<float> right, Span<float> destination)
+{
+    VERIFY(left.size() == right.size());
+    VERIFY(destination.size() == left.size() * 2);
+
+    size_t i = 0;
+    for (; i + 4 <= left.size(); i += 4) {
+        auto l = load_unaligned<f32x4>(left.data() + i);
+        auto r = load_unaligned<f32x4>(right.data() + i);
+        store_unaligned(destination.data() + 2 * i, f32x4 { l[0], r[0], l[1], r[1] });
+        store_unaligned(destination.data() + 2 * i + 4, f32x4 { l[2], r[2], l[3], r[3] });
+    }
+    for (; i < left.size(); ++i) {
+        destination[2 * i] = left[i];
+        destination[2 * i + 1] = right[i];
+    }
+}
+
+// https://webaudio.github.io/web-audio-api/#filters-characteristics
+BiquadCoefficients BiquadCoefficients::compute(Bindings::BiquadFilterType type, float sample_rate, float frequency, float detune, float q, float gain)
+{
+    // The computed frequency is clamped to the range that the filter can be built for.
+    double nyquist = sample_rate / 2.0;
+    double f0 = clamp(frequency * AK::pow(2.0, detune / 1200.0), 0.0, nyquist);
+
+    double A = AK::pow(10.0, gain / 40.0);
+    double w0 = 2 * AK::Pi<double> * f0 / sample_rate;
+    double sin_w0 = AK::sin(w0);
+    double cos_w0 = AK::cos(w0);
+    double alpha_q = sin_w0 / (2 * q);
+    double alpha_q_db = sin_w0 / (2 * AK::pow(10.0, q / 20.0));
+    // NOTE: The shelf slope S is always 1, for which alpha_S simplifies to this.
+    double alpha_s = sin_w0 / 2 * AK::sqrt(2.0);
+    double sqrt_a = AK::sqrt(A);
+
+    double b0, b1, b2, a0, a1, a2;
+    switch (type) {
+    case Bindings::BiquadFilterType::Lowpass:
+        b0 = (1 - cos_w0) / 2;
+        b1 = 1 - cos_w0;
+        b2 = (1 - cos_w0) / 2;
+        a0 = 1 + alpha_q_db;
+        a1 = -2 * cos_w0;
+        a2 = 1 - alpha_q_db;
+        break;
+    case Bindings::BiquadFilterType::Highpass:
+        b0 = (1 + cos_w0) / 2;
+        b1 = -(1 + cos_w0);
+        b2 = (1 + cos_w0) / 2;
+        a0 = 1 + alpha_q_db;
+        a1 = -2 * cos_w0;
+        a2 = 1 - alpha_q_db;
+        break;
+    case Bindings::BiquadFilterType::Bandpass:
+        b0 = alpha_q;
+        b1 = 0;
+        b2 = -alpha_q;
+        a0 = 1 + alpha_q;
+        a1 = -2 * cos_w0;
+        a2 = 1 - alpha_q;
+        break;
+    case Bindings::BiquadFilterType::Notch:
+        b0 = 1;
+        b1 = -2 * cos_w0;
+        b2 = 1;
+        a0 = 1 + alpha_q;
+        a1 = -2 * cos_w0;
+        a2 = 1 - alpha_q;
+        break;
+    case Bindings::BiquadFilterType::Allpass:
+        b0 = 1 - alpha_q;
+        b1 = -2 * cos_w0;
+        b2 = 1 + alpha_q;
+        a0 = 1 + alpha_q;
+        a1 = -2 * cos_w0;
+        a2 = 1 - alpha_q;
+        break;
+    case Bindings::BiquadFilterType::Peaking:
+        b0 = 1 + alpha_q * A;
+        b1 = -2 * cos_w0;
+        b2 = 1 - alpha_q * A;
+        a0 = 1 + alpha_q / A;
+        a1 = -2 * cos_w0;
+        a2 = 1 - alpha_q / A;
+        break;
+    case Bindings::BiquadFilterType::Lowshelf:
+        b0 = A * ((A + 1) - (A - 1) * cos_w0 + 2 * alpha_s * sqrt_a);
+        b1 = 2 * A * ((A - 1) - (A + 1) * cos_w0);
+        b2 = A * ((A + 1) - (A - 1) * cos_w0 - 2 * alpha_s * sqrt_a);
+        a0 = (A + 1) + (A - 1) * cos_w0 + 2 * alpha_s * sqrt_a;
+        a1 = -2 * ((A - 1) + (A + 1) * cos_w0);
+        a2 = (A + 1) + (A - 1) * cos_w0 - 2 * alpha_s * sqrt_a;
+        break;
+    case Bindings::BiquadFilterType::Highshelf:
+        b0 = A * ((A + 1) + (A - 1) * cos_w0 + 2 * alpha_s * sqrt_a);
+        b1 = -2 * A * ((A - 1) + (A + 1) * cos_w0);
+        b2 = A * ((A + 1) + (A - 1) * cos_w0 - 2 * alpha_s * sqrt_a);
+        a0 = (A + 1) - (A - 1) * cos_w0 + 2 * alpha_s * sqrt_a;
+        a1 = 2 * ((A - 1) - (A + 1) * cos_w0);
+        a2 = (A + 1) - (A - 1) * cos_w0 - 2 * alpha_s * sqrt_a;
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+    // A filter that can't be built (for instance with a Q of 0) lets nothing through, rather than filling the output
+    // with NaNs.
+    if (a0 == 0 || isnan(b0 / a0) || isnan(b1 / a0) || isnan(b2 / a0) || isnan(a1 / a0) || isnan(a2 / a0))
+        return { 0, 0, 0, 0, 0 };
+
+    return {
+        static_cast<float>(b0 / a0),
+        static_cast<float>(b1 / a0),
+        static_cast<float>(b2 / a0),
+        static_cast<float>(a1 / a0),
+        static_cast<float>(a2 / a0),
+    };
+}
+
+void apply_biquad(BiquadCoefficients const& coefficients, BiquadState& state, Span<Span<float>> channels)
+{
+    VERIFY(channels.size() <= BiquadState::max_channel_count);
+    if (channels.is_empty())
+        return;
+
+    auto frame_count = channels[0].size();
+    for (auto& channel : channels)
+        VERIFY(channel.size() == frame_count);
+
+    auto b0 = expand4(coefficients.b0);
+    auto b1 = expand4(coefficients.b1);
+    auto b2 = expand4(coefficients.b2);
+    auto a1 = expand4(coefficients.a1);
+    auto a2 = expand4(coefficients.a2);
+
+    // Lanes without a channel are fed zeros, and stay at zero.
+    Array<float*, BiquadState::max_channel_count> samples {};
+    for (size_t channel = 0; channel < channels.size(); ++channel)
+        samples[channel] = channels[channel].data();
+
+    auto x1 = state.x1;
+    auto x2 = state.x2;
+    auto y1 = state.y1;
+    auto y2 = state.y2;
+    for (size_t i = 0; i < frame_count; ++i) {
+        f32x4 x {};
+        for (size_t channel = 0; channel < channels.size(); ++channel)
+            x[channel] = samples[channel][i];
+
+        auto y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+
+        for (size_t channel = 0; channel < channels.size(); ++channel)
+            samples[channel][i] = y[channel];
+    }
+    state.x1 = x1;
+    state.x2 = x2;
+    state.y1 = y1;
+    state.y2 = y2;
+}
+
+}
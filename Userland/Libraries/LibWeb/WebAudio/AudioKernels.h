@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/SIMD.h>
+#include <AK/Span.h>
+#include <LibWeb/Bindings/BiquadFilterNodePrototype.h>
+
+// The inner loops of the rendering thread. They all work on whole blocks of samples, four at a time where they can.
+namespace Web::WebAudio {
+
+// Adds source to destination, sample by sample. Both have to be the same size.
+void mix_into(Span<float> destination, ReadonlySpan<float> source);
+
+// Multiplies every sample by gain.
+void apply_gain(Span<float>, float gain);
+
+// Multiplies the samples by a gain that goes linearly from start_gain towards end_gain, reaching it at the last sample.
+// Changing gain this way between render quanta avoids the clicks of stepping it.
+void apply_gain_ramp(Span<float>, float start_gain, float end_gain);
+
+// Writes the samples of two channels alternately into destination, which has to be twice their size.
+void interleave(ReadonlySpan<float> left, ReadonlySpan<float> right, Span<float> destination);
+
+// https://webaudio.github.io/web-audio-api/#filters-characteristics
+// The coefficients of a biquad filter, normalized so that a0 is 1.
+struct BiquadCoefficients {
+    static BiquadCoefficients compute(Bindings::BiquadFilterType, float sample_rate, float frequency, float detune, float q, float gain);
+
+    float b0 { 1 };
+    float b1 { 0 };
+    float b2 { 0 };
+    float a1 { 0 };
+    float a2 { 0 };
+};
+
+// The previous two inputs and outputs of a biquad filter, for up to four channels at once. Each lane of the vectors
+// belongs to one channel.
+struct BiquadState {
+    static constexpr size_t max_channel_count = 4;
+
+    AK::SIMD::f32x4 x1 {};
+    AK::SIMD::f32x4 x2 {};
+    AK::SIMD::f32x4 y1 {};
+    AK::SIMD::f32x4 y2 {};
+};
+
+// Runs every channel through the filter in place. The filter's recursion can't be split up along time, so instead the
+// channels are filtered side by side in the lanes of one vector. All channels have to be the same size.
+void apply_biquad(BiquadCoefficients const&, BiquadState&, Span<Span<float>> channels);
+
+}
@@ -15,12 +15,34 @@ JS_DEFINE_ALLOCATOR(AudioNode);
 AudioNode::AudioNode(JS::Realm& realm, JS::NonnullGCPtr<BaseAudioContext> context)
     : DOM::EventTarget(realm)
     , m_context(context)
-
+    , m_render_graph(context->render_graph())
 {
 }
 
 AudioNode::~AudioNode() = default;
 
+void AudioNode::finalize()
+{
+    Base::finalize();
+    if (m_render_node)
+        m_render_graph->remove_node(*m_render_node);
+}
+
+NonnullOwnPtr<RenderNode> AudioNode::create_render_node()
+{
+    return make<RenderNode>();
+}
+
+RenderNode& AudioNode::render_node()
+{
+    if (!m_render_node) {
+        auto render_node = create_render_node();
+        m_render_node = render_node.ptr();
+        m_render_graph->add_node(move(render_node));
+    }
+    return *m_render_node;
+}
+
 // https://webaudio.github.io/web-audio-api/#dom-audionode-connect
 WebIDL::ExceptionOr<JS::NonnullGCPtr<AudioNode>> AudioNode::connect(JS::NonnullGCPtr<AudioNode> destination_node, WebIDL::UnsignedLong output, WebIDL::UnsignedLong input)
 {
@@ -32,9 +54,20 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<AudioNode>> AudioNode::connect(JS::NonnullG
         return WebIDL::InvalidAccessError::create(realm(), "Cannot connect to an AudioNode in a different AudioContext"_fly_string);
     }
 
+    // FIXME: Throw an IndexSizeError if output or input are out of bounds, once nodes know how many they have.
     (void)output;
     (void)input;
-    dbgln("FIXME: Implement Audio::connect(AudioNode)");
+
+    if (m_outputs.contains_slow(destination_node))
+        return destination_node;
+
+    m_outputs.append(destination_node);
+    destination_node->m_inputs.append(*this);
+    m_render_graph->connect(render_node(), destination_node->render_node());
+
+    if (is<AudioDestinationNode>(*destination_node))
+        m_context->did_connect_to_destination();
+
     return destination_node;
 }
 
@@ -49,7 +82,13 @@ void AudioNode::connect(JS::NonnullGCPtr<AudioParam> destination_param, WebIDL::
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect
 void AudioNode::disconnect()
 {
-    dbgln("FIXME: Implement AudioNode::disconnect()");
+    // Disconnects all outgoing connections from the AudioNode.
+    for (auto& destination_node : m_outputs)
+        destination_node->m_inputs.remove_first_matching([&](auto& input) { return input.ptr() == this; });
+    m_outputs.clear();
+
+    if (m_render_node)
+        m_render_graph->disconnect_all(*m_render_node);
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect-output
@@ -62,8 +101,13 @@ void AudioNode::disconnect(WebIDL::UnsignedLong output)
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect-destinationnode
 void AudioNode::disconnect(JS::NonnullGCPtr<AudioNode> destination_node)
 {
-    (void)destination_node;
-    dbgln("FIXME: Implement AudioNode::disconnect(destination_node)");
+    // Disconnects all outputs of the AudioNode that go to a specific destination AudioNode.
+    // FIXME: If there is no connection to the destinationNode, throw an InvalidAccessError exception.
+    if (!m_outputs.remove_first_matching([&](auto& output) { return output == destination_node; }))
+        return;
+    destination_node->m_inputs.remove_first_matching([&](auto& input) { return input.ptr() == this; });
+
+    m_render_graph->disconnect(render_node(), destination_node->render_node());
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect-destinationnode-output
@@ -162,6 +206,8 @@ void AudioNode::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_context);
+    visitor.visit(m_inputs);
+    visitor.visit(m_outputs);
 }
 
 }
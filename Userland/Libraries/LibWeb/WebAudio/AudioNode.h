@@ -11,6 +11,7 @@
 #include <LibWeb/Bindings/AudioNodePrototype.h>
 #include <LibWeb/Bindings/PlatformObject.h>
 #include <LibWeb/DOM/EventTarget.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
 #include <LibWeb/WebIDL/Types.h>
 
 namespace Web::WebAudio {
@@ -57,14 +58,34 @@ public:
     WebIDL::ExceptionOr<void> set_channel_interpretation(Bindings::ChannelInterpretation);
     Bindings::ChannelInterpretation channel_interpretation();
 
+    // The counterpart of this node on the rendering thread. It's created the first time it's asked for, which is when
+    // the node is first connected to something.
+    RenderNode& render_node();
+
 protected:
     AudioNode(JS::Realm&, JS::NonnullGCPtr<BaseAudioContext>);
 
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    virtual NonnullOwnPtr<RenderNode> create_render_node();
+
+    RenderGraph& render_graph() { return *m_render_graph; }
+    // Changes to a node only have to be sent to the rendering thread once it has a render node over there.
+    RenderNode* existing_render_node() { return m_render_node; }
+
 private:
+    virtual void finalize() override;
+
     JS::NonnullGCPtr<BaseAudioContext> m_context;
+    NonnullRefPtr<RenderGraph> m_render_graph;
+    RenderNode* m_render_node { nullptr };
+
+    // NOTE: Nodes hold on to the nodes that are connected to them, so that everything that feeds into the destination
+    //       stays alive along with the context.
+    Vector<JS::NonnullGCPtr<AudioNode>> m_inputs;
+    Vector<JS::NonnullGCPtr<AudioNode>> m_outputs;
+
     Bindings::ChannelCountMode m_channel_count_mode { Bindings::ChannelCountMode::Max };
     Bindings::ChannelInterpretation m_channel_interpretation { Bindings::ChannelInterpretation::Speakers };
 };
@@ -20,6 +20,7 @@ AudioParam::AudioParam(JS::Realm& realm, float default_value, float min_value, f
     , m_min_value(min_value)
     , m_max_value(max_value)
     , m_automation_rate(automation_rate)
+    , m_render_param(RenderParam::create(value()))
 {
 }
 
@@ -43,6 +44,7 @@ float AudioParam::value() const
 void AudioParam::set_value(float value)
 {
     m_current_value = value;
+    m_render_param->set_value(this->value());
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audioparam-automationrate
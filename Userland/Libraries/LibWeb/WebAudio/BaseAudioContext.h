@@ -11,6 +11,7 @@
 #include <LibWeb/DOM/EventTarget.h>
 #include <LibWeb/WebAudio/AudioDestinationNode.h>
 #include <LibWeb/WebAudio/BiquadFilterNode.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
 #include <LibWeb/WebIDL/Types.h>
 
 namespace Web::WebAudio {
@@ -37,6 +38,7 @@ public:
     float sample_rate() const { return m_sample_rate; }
     double current_time() const { return m_current_time; }
     Bindings::AudioContextState state() const { return m_control_thread_state; }
+    Bindings::AudioContextState rendering_state() const { return m_rendering_thread_state; }
 
     // https://webaudio.github.io/web-audio-api/#--nyquist-frequency
     float nyquist_frequency() const { return m_sample_rate / 2; }
@@ -57,9 +59,16 @@ public:
     WebIDL::ExceptionOr<JS::NonnullGCPtr<DynamicsCompressorNode>> create_dynamics_compressor();
     JS::NonnullGCPtr<GainNode> create_gain();
 
+    RenderGraph& render_graph() { return *m_render_graph; }
+
+    // Called when anything gets connected to the destination node, which is when there might be something to hear.
+    virtual void did_connect_to_destination() { }
+
 protected:
     explicit BaseAudioContext(JS::Realm&, float m_sample_rate = 0);
 
+    // NOTE: This has to come before the destination node, which is constructed with a reference to it.
+    NonnullRefPtr<RenderGraph> m_render_graph;
     JS::NonnullGCPtr<AudioDestinationNode> m_destination;
 
     virtual void initialize(JS::Realm&) override;
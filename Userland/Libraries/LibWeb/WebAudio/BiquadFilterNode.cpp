@@ -7,6 +7,7 @@
 #include <LibWeb/Bindings/AudioParamPrototype.h>
 #include <LibWeb/Bindings/BiquadFilterNodePrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/WebAudio/AudioKernels.h>
 #include <LibWeb/WebAudio/AudioNode.h>
 #include <LibWeb/WebAudio/AudioParam.h>
 #include <LibWeb/WebAudio/BiquadFilterNode.h>
@@ -26,10 +27,80 @@ BiquadFilterNode::BiquadFilterNode(JS::Realm& realm, JS::NonnullGCPtr<BaseAudioC
 
 BiquadFilterNode::~BiquadFilterNode() = default;
 
+namespace {
+
+// https://webaudio.github.io/web-audio-api/#BiquadFilterNode
+class BiquadFilterRenderNode final : public RenderNode {
+public:
+    BiquadFilterRenderNode(Bindings::BiquadFilterType type, NonnullRefPtr<RenderParam> frequency, NonnullRefPtr<RenderParam> detune, NonnullRefPtr<RenderParam> q, NonnullRefPtr<RenderParam> gain)
+        : m_type(type)
+        , m_frequency(move(frequency))
+        , m_detune(move(detune))
+        , m_q(move(q))
+        , m_gain(move(gain))
+    {
+    }
+
+    void set_type(Bindings::BiquadFilterType type)
+    {
+        m_type = type;
+        m_parameters.clear();
+    }
+
+    virtual void process(AudioBus& bus, float sample_rate) override
+    {
+        // The coefficients only have to be worked out again when something they depend on changed.
+        Parameters parameters { sample_rate, m_frequency->value(), m_detune->value(), m_q->value(), m_gain->value() };
+        if (m_parameters != parameters) {
+            m_coefficients = BiquadCoefficients::compute(m_type, sample_rate, parameters.frequency, parameters.detune, parameters.q, parameters.gain);
+            m_parameters = parameters;
+        }
+
+        static_assert(AudioBus::channel_count <= BiquadState::max_channel_count);
+        Array<Span<float>, AudioBus::channel_count> channels;
+        for (size_t channel = 0; channel < AudioBus::channel_count; ++channel)
+            channels[channel] = bus.channels[channel].span();
+        apply_biquad(m_coefficients, m_state, channels.span());
+    }
+
+private:
+    struct Parameters {
+        float sample_rate { 0 };
+        float frequency { 0 };
+        float detune { 0 };
+        float q { 0 };
+        float gain { 0 };
+
+        bool operator==(Parameters const&) const = default;
+    };
+
+    Bindings::BiquadFilterType m_type;
+    NonnullRefPtr<RenderParam> m_frequency;
+    NonnullRefPtr<RenderParam> m_detune;
+    NonnullRefPtr<RenderParam> m_q;
+    NonnullRefPtr<RenderParam> m_gain;
+
+    Optional<Parameters> m_parameters;
+    BiquadCoefficients m_coefficients;
+    BiquadState m_state;
+};
+
+}
+
+NonnullOwnPtr<RenderNode> BiquadFilterNode::create_render_node()
+{
+    return make<BiquadFilterRenderNode>(m_type, m_frequency->render_param(), m_detune->render_param(), m_q->render_param(), m_gain->render_param());
+}
+
 // https://webaudio.github.io/web-audio-api/#dom-biquadfilternode-type
 WebIDL::ExceptionOr<void> BiquadFilterNode::set_type(Bindings::BiquadFilterType type)
 {
     m_type = type;
+    if (auto* render_node = existing_render_node()) {
+        render_graph().update_node(*render_node, [type](RenderNode& render_node) {
+            static_cast<BiquadFilterRenderNode&>(render_node).set_type(type);
+        });
+    }
     return {};
 }
 
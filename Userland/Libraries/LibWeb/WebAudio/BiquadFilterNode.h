@@ -46,6 +46,8 @@ protected:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    virtual NonnullOwnPtr<RenderNode> create_render_node() override;
+
 private:
     Bindings::BiquadFilterType m_type { Bindings::BiquadFilterType::Lowpass };
     JS::NonnullGCPtr<AudioParam> m_frequency;
@@ -5,6 +5,7 @@
  */
 
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/WebAudio/AudioKernels.h>
 #include <LibWeb/WebAudio/AudioNode.h>
 #include <LibWeb/WebAudio/AudioParam.h>
 #include <LibWeb/WebAudio/BaseAudioContext.h>
@@ -34,6 +35,39 @@ GainNode::GainNode(JS::Realm& realm, JS::NonnullGCPtr<BaseAudioContext> context,
 {
 }
 
+namespace {
+
+// https://webaudio.github.io/web-audio-api/#GainNode
+class GainRenderNode final : public RenderNode {
+public:
+    explicit GainRenderNode(NonnullRefPtr<RenderParam> gain)
+        : m_gain(move(gain))
+        , m_previous_gain(m_gain->value())
+    {
+    }
+
+    virtual void process(AudioBus& bus, float) override
+    {
+        // Each sample of the input is multiplied by the computedValue of the gain AudioParam. When the gain changed
+        // since the last quantum, it's ramped to its new value over the course of this one.
+        auto gain = m_gain->value();
+        for (auto& channel : bus.channels)
+            apply_gain_ramp(channel.span(), m_previous_gain, gain);
+        m_previous_gain = gain;
+    }
+
+private:
+    NonnullRefPtr<RenderParam> m_gain;
+    float m_previous_gain { 1 };
+};
+
+}
+
+NonnullOwnPtr<RenderNode> GainNode::create_render_node()
+{
+    return make<GainRenderNode>(m_gain->render_param());
+}
+
 void GainNode::initialize(JS::Realm& realm)
 {
     Base::initialize(realm);
@@ -35,6 +35,8 @@ protected:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    virtual NonnullOwnPtr<RenderNode> create_render_node() override;
+
 private:
     // https://webaudio.github.io/web-audio-api/#dom-gainnode-gain
     JS::NonnullGCPtr<AudioParam> m_gain;
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/WebAudio/AudioKernels.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
+
+namespace Web::WebAudio {
+
+void AudioBus::zero()
+{
+    for (auto& channel : channels)
+        channel.fill(0);
+}
+
+void AudioBus::mix_in(AudioBus const& other)
+{
+    for (size_t channel = 0; channel < channel_count; ++channel)
+        mix_into(channels[channel].span(), other.channels[channel].span());
+}
+
+RenderGraph::~RenderGraph()
+{
+    while (auto* node = m_nodes.take_first())
+        delete node;
+}
+
+void RenderGraph::post(Message&& message)
+{
+    // This is as good a time as any to get rid of the messages the rendering thread is done with.
+    (void)m_processed_messages.take_all();
+
+    m_messages.push(move(message));
+}
+
+void RenderGraph::post_inputs(RenderNode& node)
+{
+    post(SetInputs { &node, m_inputs.get(&node).value() });
+}
+
+void RenderGraph::add_node(NonnullOwnPtr<RenderNode> node)
+{
+    m_inputs.set(node.ptr(), {});
+    post(AddNode { move(node) });
+}
+
+void RenderGraph::remove_node(RenderNode& node)
+{
+    disconnect_all(node);
+    m_inputs.remove(&node);
+    post(RemoveNode { &node, nullptr });
+}
+
+void RenderGraph::connect(RenderNode& source, RenderNode& destination)
+{
+    // There can only be one connection between the same two nodes.
+    auto& inputs = m_inputs.find(&destination)->value;
+    if (inputs.contains_slow(&source))
+        return;
+    inputs.append(&source);
+    post_inputs(destination);
+}
+
+void RenderGraph::disconnect(RenderNode& source, RenderNode& destination)
+{
+    auto& inputs = m_inputs.find(&destination)->value;
+    if (inputs.remove_first_matching([&](auto* input) { return input == &source; }))
+        post_inputs(destination);
+}
+
+void RenderGraph::disconnect_all(RenderNode& source)
+{
+    for (auto& [node, inputs] : m_inputs) {
+        if (inputs.remove_all_matching([&](auto* input) { return input == &source; }))
+            post_inputs(*node);
+    }
+}
+
+void RenderGraph::update_node(RenderNode& node, Function<void(RenderNode&)>&& update)
+{
+    post(UpdateNode { &node, move(update) });
+}
+
+void RenderGraph::process_messages()
+{
+    // NOTE: The messages are worked through in place, and then handed back to the control thread as a whole.
+    auto messages = m_messages.take_all();
+    messages.for_each([&](Message& message) {
+        message.visit(
+            [&](AddNode& message) {
+                auto* node = message.node.leak_ptr();
+                if (node->is_destination())
+                    m_destination = node;
+                m_nodes.append(*node);
+            },
+            [&](RemoveNode& message) {
+                // NOTE: The control thread has already disconnected the node from everything.
+                if (m_destination == message.node)
+                    m_destination = nullptr;
+                m_nodes.remove(*message.node);
+                message.removed_node = adopt_own(*message.node);
+            },
+            [&](SetInputs& message) {
+                swap(message.node->m_inputs, message.inputs);
+            },
+            [&](UpdateNode& message) {
+                message.update(*message.node);
+            });
+    });
+    m_processed_messages.push_all(move(messages));
+}
+
+AudioBus const& RenderGraph::pull(RenderNode& node, float sample_rate)
+{
+    // NOTE: A node that has already been rendered in this quantum is fed to all its outputs as it is. This also
+    //       breaks cycles, whose nodes see the output of the node they started from as silence.
+    if (node.m_rendered_quantum == m_current_quantum)
+        return node.m_output;
+    node.m_rendered_quantum = m_current_quantum;
+
+    node.m_output.zero();
+    for (auto* input : node.m_inputs) {
+        auto const& input_bus = pull(*input, sample_rate);
+        node.m_output.mix_in(input_bus);
+    }
+    node.process(node.m_output, sample_rate);
+    return node.m_output;
+}
+
+void RenderGraph::render_quantum(float sample_rate)
+{
+    process_messages();
+
+    ++m_current_quantum;
+    if (m_destination)
+        m_quantum = pull(*m_destination, sample_rate);
+    else
+        m_quantum.zero();
+}
+
+void RenderGraph::render(Span<float> output, float sample_rate)
+{
+    VERIFY(output.size() % AudioBus::channel_count == 0);
+    auto frames_left = output.size() / AudioBus::channel_count;
+
+    // The output is asked for in however many frames the audio device wants, and rendered a quantum at a time.
+    while (frames_left > 0) {
+        if (m_frames_left_in_quantum == 0) {
+            render_quantum(sample_rate);
+            m_frames_left_in_quantum = render_quantum_size;
+        }
+
+        auto frames = min(frames_left, m_frames_left_in_quantum);
+        auto offset = render_quantum_size - m_frames_left_in_quantum;
+        interleave(m_quantum.channels[0].span().slice(offset, frames), m_quantum.channels[1].span().slice(offset, frames), output.trim(frames * AudioBus::channel_count));
+
+        output = output.slice(frames * AudioBus::channel_count);
+        frames_left -= frames;
+        m_frames_left_in_quantum -= frames;
+    }
+}
+
+}
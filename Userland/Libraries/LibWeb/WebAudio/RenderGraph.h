@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/MPSCQueue.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/Variant.h>
+#include <AK/Vector.h>
+
+namespace Web::WebAudio {
+
+// https://webaudio.github.io/web-audio-api/#render-quantum-size
+static constexpr size_t render_quantum_size = 128;
+
+// The samples of one render quantum.
+// FIXME: Every node renders the same two channels for now, rather than following its channel count and channel
+//        interpretation.
+struct AudioBus {
+    static constexpr size_t channel_count = 2;
+
+    void zero();
+    void mix_in(AudioBus const&);
+
+    Array<Array<float, render_quantum_size>, channel_count> channels {};
+};
+
+// The value of an AudioParam, as seen from the rendering thread. The control thread changes it without waiting, and
+// the rendering thread picks up the latest value at the start of each render quantum.
+// FIXME: This makes every AudioParam k-rate, and doesn't know about automation events.
+class RenderParam final : public AtomicRefCounted<RenderParam> {
+public:
+    static NonnullRefPtr<RenderParam> create(float value) { return adopt_ref(*new RenderParam(value)); }
+
+    float value() const { return m_value.load(AK::MemoryOrder::memory_order_relaxed); }
+    void set_value(float value) { m_value.store(value, AK::MemoryOrder::memory_order_relaxed); }
+
+private:
+    explicit RenderParam(float value)
+        : m_value(value)
+    {
+    }
+
+    Atomic<float> m_value;
+};
+
+// The counterpart of an AudioNode on the rendering thread. Once handed to the RenderGraph, it's only ever touched there.
+class RenderNode {
+    AK_MAKE_NONCOPYABLE(RenderNode);
+    AK_MAKE_NONMOVABLE(RenderNode);
+
+public:
+    RenderNode() = default;
+    virtual ~RenderNode() = default;
+
+    virtual bool is_destination() const { return false; }
+
+    // Turns the mix of this node's inputs into its output, in place. Nodes that don't render anything yet put out silence.
+    virtual void process(AudioBus& bus, float sample_rate)
+    {
+        (void)sample_rate;
+        bus.zero();
+    }
+
+private:
+    friend class RenderGraph;
+
+    IntrusiveListNode<RenderNode> m_list_node;
+    Vector<RenderNode*> m_inputs;
+    AudioBus m_output;
+    u64 m_rendered_quantum { NumericLimits<u64>::max() };
+};
+
+// https://webaudio.github.io/web-audio-api/#rendering-thread
+// The nodes of an audio context as the rendering thread sees them. Changes to the graph are made on the control thread
+// by posting them to a lock-free queue, which the rendering thread works through at the start of each render quantum,
+// so neither thread ever waits on the other.
+//
+// The rendering thread never allocates or frees memory either, as that could take a lock inside the allocator:
+// - Everything a change needs, down to a node's new list of inputs, is put together on the control thread.
+// - Messages the rendering thread is done with go back to the control thread in one piece, along with the nodes and
+//   input lists they replaced, and are destroyed there.
+class RenderGraph final : public AtomicRefCounted<RenderGraph> {
+public:
+    static NonnullRefPtr<RenderGraph> create() { return adopt_ref(*new RenderGraph); }
+
+    ~RenderGraph();
+
+    // May only be called from the control thread. The RenderNode references are only used to identify nodes that were
+    // added before, they're not touched here.
+    void add_node(NonnullOwnPtr<RenderNode>);
+    void remove_node(RenderNode&);
+    void connect(RenderNode& source, RenderNode& destination);
+    void disconnect(RenderNode& source, RenderNode& destination);
+    void disconnect_all(RenderNode& source);
+    void update_node(RenderNode&, Function<void(RenderNode&)>&&);
+
+    // May only be called from the rendering thread. Fills the output with interleaved stereo samples.
+    void render(Span<float> output, float sample_rate);
+
+private:
+    RenderGraph() = default;
+
+    // The rendering thread takes the node out of the message.
+    struct AddNode {
+        OwnPtr<RenderNode> node;
+    };
+    // The rendering thread puts the node into the message, to be destroyed along with it.
+    struct RemoveNode {
+        RenderNode* node;
+        OwnPtr<RenderNode> removed_node;
+    };
+    // The rendering thread swaps the inputs with the node's current ones, which are then destroyed with the message.
+    struct SetInputs {
+        RenderNode* node;
+        Vector<RenderNode*> inputs;
+    };
+    struct UpdateNode {
+        RenderNode* node;
+        Function<void(RenderNode&)> update;
+    };
+    using Message = Variant<AddNode, RemoveNode, SetInputs, UpdateNode>;
+
+    void post(Message&&);
+    void post_inputs(RenderNode&);
+    void process_messages();
+    void render_quantum(float sample_rate);
+    AudioBus const& pull(RenderNode&, float sample_rate);
+
+    MPSCQueue<Message> m_messages;
+    MPSCQueue<Message> m_processed_messages;
+
+    // Only touched by the control thread. The inputs of every node, as of the last message posted.
+    HashMap<RenderNode*, Vector<RenderNode*>> m_inputs;
+
+    // Only touched by the rendering thread.
+    IntrusiveList<&RenderNode::m_list_node> m_nodes;
+    RenderNode* m_destination { nullptr };
+    AudioBus m_quantum;
+    size_t m_frames_left_in_quantum { 0 };
+    u64 m_current_quantum { 0 };
+};
+
+}
@@ -4,9 +4,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Base64.h>
 #include <AK/Optional.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/ImageFormats/PNGWriter.h>
 #include <LibGfx/Rect.h>
+#include <LibThreading/BackgroundAction.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/ElementFactory.h>
 #include <LibWeb/HTML/AnimationFrameCallbackDriver.h>
@@ -24,27 +27,19 @@
 namespace Web::WebDriver {
 
 // https://w3c.github.io/webdriver/#dfn-encoding-a-canvas-as-base64
-static Response encode_canvas_element(HTML::HTMLCanvasElement& canvas)
+// NOTE: This does steps 3 to 6, which may run on a background thread. The data URL isn't built only to be taken apart
+//       again, the encoded string is the Base64 encoding of the file.
+static ErrorOr<String> encode_bitmap_as_base64(Gfx::Bitmap const& bitmap)
 {
-    // FIXME: 1. If the canvas element’s bitmap’s origin-clean flag is set to false, return error with error code unable to capture screen.
-
-    // 2. If the canvas element’s bitmap has no pixels (i.e. either its horizontal dimension or vertical dimension is zero) then return error with error code unable to capture screen.
-    if (canvas.bitmap()->width() == 0 || canvas.bitmap()->height() == 0)
-        return Error::from_code(ErrorCode::UnableToCaptureScreen, "Captured screenshot is empty"sv);
-
     // 3. Let file be a serialization of the canvas element’s bitmap as a file, using "image/png" as an argument.
-    // 4. Let data url be a data: URL representing file. [RFC2397]
-    auto data_url = canvas.to_data_url("image/png"sv, {});
+    // OPTIMIZATION: Screenshots are usually decoded again right away by the client, so encoding speed matters more than
+    //               the size of the file.
+    auto file = TRY(Gfx::PNGWriter::encode(bitmap, { .compression_level = 1, .encode_in_parallel = true }));
 
+    // 4. Let data url be a data: URL representing file. [RFC2397]
     // 5. Let index be the index of "," in data url.
-    auto index = data_url.find_byte_offset(',');
-    VERIFY(index.has_value());
-
     // 6. Let encoded string be a substring of data url using (index + 1) as the start argument.
-    auto encoded_string = MUST(data_url.substring_from_byte_offset(*index + 1));
-
-    // 7. Return success with data encoded string.
-    return JsonValue { move(encoded_string) };
+    return encode_base64(file);
 }
 
 // Common animation callback steps between:
@@ -93,13 +88,43 @@ Response capture_element_screenshot(Painter const& painter, Page& page, DOM::Ele
         return canvas;
     };
 
+    // NOTE: The bitmap is kept alive here while it's being encoded, the background thread only borrows it.
+    RefPtr<Gfx::Bitmap> bitmap;
+
     (void)element.document().window()->animation_frame_callback_driver().add([&](auto) {
         auto canvas_or_error = draw_bounding_box_from_the_framebuffer();
         if (canvas_or_error.is_error()) {
             encoded_string_or_error = canvas_or_error.release_error();
             return;
         }
-        encoded_string_or_error = encode_canvas_element(canvas_or_error.release_value());
+
+        // https://w3c.github.io/webdriver/#dfn-encoding-a-canvas-as-base64
+        auto canvas = canvas_or_error.release_value();
+        canvas->present();
+
+        // FIXME: 1. If the canvas element’s bitmap’s origin-clean flag is set to false, return error with error code unable to capture screen.
+
+        // 2. If the canvas element’s bitmap has no pixels (i.e. either its horizontal dimension or vertical dimension is zero) then return error with error code unable to capture screen.
+        if (canvas->bitmap()->width() == 0 || canvas->bitmap()->height() == 0) {
+            encoded_string_or_error = Error::from_code(ErrorCode::UnableToCaptureScreen, "Captured screenshot is empty"sv);
+            return;
+        }
+
+        // OPTIMIZATION: Encoding a screenshot of a large viewport takes a while, so it happens on a background thread,
+        //               while this one keeps running the event loop.
+        bitmap = canvas->bitmap();
+        (void)Threading::BackgroundAction<String>::construct(
+            [bitmap = bitmap.ptr()](auto&) {
+                return encode_bitmap_as_base64(*bitmap);
+            },
+            [&](String encoded_string) -> ErrorOr<void> {
+                // 7. Return success with data encoded string.
+                encoded_string_or_error = JsonValue { move(encoded_string) };
+                return {};
+            },
+            [&](AK::Error error) {
+                encoded_string_or_error = Error::from_code(ErrorCode::UnableToCaptureScreen, ByteString::formatted("Unable to encode screenshot: {}", error));
+            });
     });
 
     Platform::EventLoopPlugin::the().spin_until([&]() { return encoded_string_or_error.has_value(); });
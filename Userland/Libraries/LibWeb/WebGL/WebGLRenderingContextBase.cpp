@@ -54,6 +54,7 @@ void WebGLRenderingContextBase::present()
     m_context->gl_flush();
 
     m_context->present(*canvas_element().bitmap());
+    canvas_element().invalidate_snapshot();
 
     // "By default, after compositing the contents of the drawing buffer shall be cleared to their default values, as shown in the table above.
     // This default behavior can be changed by setting the preserveDrawingBuffer attribute of the WebGLContextAttributes object.
@@ -9,6 +9,7 @@
 #include <AK/ByteBuffer.h>
 #include <AK/Math.h>
 #include <AK/NumericLimits.h>
+#include <LibCore/Tracing.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/DataView.h>
@@ -131,6 +132,8 @@ inline JS::Completion clean_up_on_return(HTML::EnvironmentSettingsObject& stored
 
 JS::Completion call_user_object_operation(WebIDL::CallbackType& callback, String const& operation_name, Optional<JS::Value> this_argument, JS::MarkedVector<JS::Value> args)
 {
+    Core::Tracing::ScopedEvent trace_event { Core::Tracing::Category::JavaScript, "WebIDL::call_user_object_operation"sv };
+
     // 1. Let completion be an uninitialized variable.
     JS::Completion completion;
 
@@ -208,6 +211,8 @@ JS::Completion call_user_object_operation(WebIDL::CallbackType& callback, String
 // https://webidl.spec.whatwg.org/#invoke-a-callback-function
 JS::Completion invoke_callback(WebIDL::CallbackType& callback, Optional<JS::Value> this_argument, JS::MarkedVector<JS::Value> args)
 {
+    Core::Tracing::ScopedEvent trace_event { Core::Tracing::Category::JavaScript, "WebIDL::invoke_callback"sv };
+
     // 1. Let completion be an uninitialized variable.
     JS::Completion completion;
 
@@ -366,6 +371,10 @@ JS::ThrowCompletionOr<T> convert_to_int(JS::VM& vm, JS::Value value, EnforceRang
         upper_bound = NumericLimits<T>::max();
     }
 
+    // NOTE: Integers that are already in range come out of all of the steps below unchanged, so we can skip them.
+    if (value.is_int32() && value.as_i32() >= lower_bound && value.as_i32() <= upper_bound)
+        return static_cast<T>(value.as_i32());
+
     // 4. Let x be ? ToNumber(V).
     auto x = TRY(value.to_number(vm)).as_double();
 
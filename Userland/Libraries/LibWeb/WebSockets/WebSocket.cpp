@@ -174,8 +174,8 @@ String WebSocket::extensions() const
     if (!m_websocket)
         return String {};
     // https://websockets.spec.whatwg.org/#feedback-from-the-protocol
-    // FIXME: Change the extensions attribute's value to the extensions in use, if it is not the null value.
-    return String {};
+    // Change the extensions attribute's value to the extensions in use, if it is not the null value.
+    return MUST(String::from_byte_string(m_websocket->extensions_in_use()));
 }
 
 // https://websockets.spec.whatwg.org/#dom-websocket-protocol
@@ -102,6 +102,7 @@ public:
 
     virtual Web::WebSockets::WebSocket::ReadyState ready_state() = 0;
     virtual ByteString subprotocol_in_use() = 0;
+    virtual ByteString extensions_in_use() = 0;
 
     virtual void send(ByteBuffer binary_or_text_message, bool is_text) = 0;
     virtual void send(StringView text_message) = 0;
@@ -14,7 +14,7 @@
 namespace Web::Bindings {
 
 template<>
-void Intrinsics::create_web_prototype_and_constructor<FormDataIteratorPrototype>(JS::Realm& realm)
+void Intrinsics::create_web_prototype<FormDataIteratorPrototype>(JS::Realm& realm)
 {
     auto prototype = heap().allocate<FormDataIteratorPrototype>(realm, realm);
     m_prototypes.set("FormDataIterator"_fly_string, prototype);
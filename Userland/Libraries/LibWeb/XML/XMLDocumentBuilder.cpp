@@ -57,19 +57,21 @@ void XMLDocumentBuilder::element_start(const XML::Name& name, HashMap<XML::Name,
     if (m_has_error)
         return;
 
+    flush_text();
+
     if (auto it = attributes.find("xmlns"); it != attributes.end()) {
         m_namespace_stack.append({ m_namespace, 1 });
-        m_namespace = MUST(FlyString::from_deprecated_fly_string(it->value));
+        m_namespace = MUST(FlyString::from_utf8(it->value.view()));
     } else {
         m_namespace_stack.last().depth += 1;
     }
 
-    if (name == HTML::TagNames::html.to_deprecated_fly_string() && m_namespace != Namespace::HTML) {
+    if (HTML::TagNames::html == name.view() && m_namespace != Namespace::HTML) {
         m_has_error = true;
         return;
     }
 
-    auto node = DOM::create_element(m_document, MUST(FlyString::from_deprecated_fly_string(name)), m_namespace).release_value_but_fixme_should_propagate_errors();
+    auto node = DOM::create_element(m_document, MUST(FlyString::from_utf8(name.view())), m_namespace).release_value_but_fixme_should_propagate_errors();
 
     // When an XML parser with XML scripting support enabled creates a script element,
     // it must have its parser document set and its "force async" flag must be unset.
@@ -91,9 +93,9 @@ void XMLDocumentBuilder::element_start(const XML::Name& name, HashMap<XML::Name,
         if (attribute.key == "xmlns" || attribute.key.starts_with("xmlns:"sv)) {
             auto name = attribute.key;
             // The prefix xmlns is used only to declare namespace bindings and is by definition bound to the namespace name http://www.w3.org/2000/xmlns/.
-            MUST(node->set_attribute_ns(Namespace::XMLNS, MUST(FlyString::from_deprecated_fly_string(name)), MUST(String::from_byte_string(attribute.value))));
+            MUST(node->set_attribute_ns(Namespace::XMLNS, MUST(FlyString::from_utf8(name.view())), MUST(String::from_byte_string(attribute.value))));
         }
-        MUST(node->set_attribute(MUST(FlyString::from_deprecated_fly_string(attribute.key)), MUST(String::from_byte_string(attribute.value))));
+        MUST(node->set_attribute(MUST(FlyString::from_utf8(attribute.key.view())), MUST(String::from_byte_string(attribute.value))));
     }
 
     m_current_node = node.ptr();
@@ -104,6 +106,8 @@ void XMLDocumentBuilder::element_end(const XML::Name& name)
     if (m_has_error)
         return;
 
+    flush_text();
+
     if (--m_namespace_stack.last().depth == 0) {
         m_namespace = m_namespace_stack.take_last().ns;
     }
@@ -155,18 +159,27 @@ void XMLDocumentBuilder::text(StringView data)
 {
     if (m_has_error)
         return;
+
+    // NOTE: Text that is split up by references or CDATA sections comes in several pieces, which are collected here
+    //       and turned into a text node once the next element or comment starts.
+    text_builder.append(data);
+}
+
+void XMLDocumentBuilder::flush_text()
+{
+    if (text_builder.is_empty())
+        return;
+
+    auto data = MUST(text_builder.to_string());
+    text_builder.clear();
+
     auto last = m_current_node->last_child();
     if (last && last->is_text()) {
         auto& text_node = static_cast<DOM::Text&>(*last);
-        text_builder.append(text_node.data());
-        text_builder.append(data);
-        text_node.set_data(MUST(text_builder.to_string()));
-        text_builder.clear();
+        text_node.set_data(MUST(String::formatted("{}{}", text_node.data(), data)));
     } else {
-        if (!data.is_empty()) {
-            auto node = m_document->create_text_node(MUST(String::from_utf8(data)));
-            MUST(m_current_node->append_child(node));
-        }
+        auto node = m_document->create_text_node(move(data));
+        MUST(m_current_node->append_child(node));
     }
 }
 
@@ -174,11 +187,16 @@ void XMLDocumentBuilder::comment(StringView data)
 {
     if (m_has_error)
         return;
+
+    flush_text();
     MUST(m_document->append_child(m_document->create_comment(MUST(String::from_utf8(data)))));
 }
 
 void XMLDocumentBuilder::document_end()
 {
+    if (!m_has_error)
+        flush_text();
+
     // When an XML parser reaches the end of its input, it must stop parsing.
     // If the active speculative HTML parser is not null, then stop the speculative HTML parser and return.
     // NOTE: Noop.
@@ -37,6 +37,8 @@ private:
     virtual void comment(StringView data) override;
     virtual void document_end() override;
 
+    void flush_text();
+
     JS::NonnullGCPtr<DOM::Document> m_document;
     JS::GCPtr<DOM::Node> m_current_node;
     XMLScriptingSupport m_scripting_support { XMLScriptingSupport::Enabled };
@@ -209,6 +209,8 @@ libweb_js_bindings(HTML/NavigationDestination)
 libweb_js_bindings(HTML/NavigationHistoryEntry)
 libweb_js_bindings(HTML/NavigationTransition)
 libweb_js_bindings(HTML/Navigator)
+libweb_js_bindings(HTML/OffscreenCanvas)
+libweb_js_bindings(HTML/OffscreenCanvasRenderingContext2D)
 libweb_js_bindings(HTML/PageTransitionEvent)
 libweb_js_bindings(HTML/Path2D)
 libweb_js_bindings(HTML/Plugin)
@@ -238,18 +240,23 @@ libweb_js_bindings(HTML/WorkerGlobalScope)
 libweb_js_bindings(HTML/WorkerLocation)
 libweb_js_bindings(HTML/WorkerNavigator)
 libweb_js_bindings(HighResolutionTime/Performance)
+libweb_js_bindings(IndexedDB/IDBDatabase)
 libweb_js_bindings(IndexedDB/IDBFactory)
 libweb_js_bindings(IndexedDB/IDBOpenDBRequest)
 libweb_js_bindings(IndexedDB/IDBRequest)
+libweb_js_bindings(IndexedDB/IDBVersionChangeEvent)
 libweb_js_bindings(Internals/Inspector)
 libweb_js_bindings(Internals/InternalAnimationTimeline)
 libweb_js_bindings(Internals/Internals)
 libweb_js_bindings(IntersectionObserver/IntersectionObserver)
 libweb_js_bindings(IntersectionObserver/IntersectionObserverEntry)
+libweb_js_bindings(LongTasks/PerformanceLongTaskTiming)
+libweb_js_bindings(LongTasks/TaskAttributionTiming)
 libweb_js_bindings(MathML/MathMLElement)
 libweb_js_bindings(MediaCapabilitiesAPI/MediaCapabilities)
 libweb_js_bindings(NavigationTiming/PerformanceNavigation)
 libweb_js_bindings(NavigationTiming/PerformanceTiming)
+libweb_js_bindings(PaintTiming/PerformancePaintTiming)
 libweb_js_bindings(PerformanceTimeline/PerformanceEntry)
 libweb_js_bindings(PerformanceTimeline/PerformanceObserver)
 libweb_js_bindings(PerformanceTimeline/PerformanceObserverEntryList)
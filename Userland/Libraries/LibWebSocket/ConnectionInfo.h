@@ -33,6 +33,10 @@ public:
     HTTP::HeaderMap const& headers() const { return m_headers; }
     void set_headers(HTTP::HeaderMap headers) { m_headers = move(headers); }
 
+    // Whether to offer the permessage-deflate extension, as defined in RFC 7692.
+    bool permessage_deflate_enabled() const { return m_permessage_deflate_enabled; }
+    void set_permessage_deflate_enabled(bool enabled) { m_permessage_deflate_enabled = enabled; }
+
     // secure flag - defined in RFC 6455 Section 3
     bool is_secure() const;
 
@@ -45,6 +49,7 @@ private:
     Vector<ByteString> m_protocols {};
     Vector<ByteString> m_extensions {};
     HTTP::HeaderMap m_headers;
+    bool m_permessage_deflate_enabled { false };
 };
 
 }
@@ -6,7 +6,9 @@
  */
 
 #include <AK/Base64.h>
+#include <AK/MemoryStream.h>
 #include <AK/Random.h>
+#include <LibCompress/Deflate.h>
 #include <LibCrypto/Hash/HashManager.h>
 #include <LibWebSocket/Impl/WebSocketImplSerenity.h>
 #include <LibWebSocket/WebSocket.h>
@@ -17,6 +19,72 @@ namespace WebSocket {
 // Note : The websocket protocol is defined by RFC 6455, found at https://tools.ietf.org/html/rfc6455
 // In this file, section numbers will refer to the RFC 6455
 
+// The permessage-deflate extension is defined by RFC 7692, found at https://tools.ietf.org/html/rfc7692
+static constexpr auto permessage_deflate_offer = "permessage-deflate; client_no_context_takeover; server_no_context_takeover"sv;
+
+// Messages smaller than this are sent uncompressed, as compressing them wouldn't save anything worthwhile.
+static constexpr size_t permessage_deflate_minimum_size = 64;
+
+// Receiving a larger message fails the connection, so that a server can't make us buffer or inflate unbounded amounts
+// of data. A few kilobytes of compressed data are enough to inflate into gigabytes.
+static constexpr size_t max_message_size = 64 * MiB;
+
+// Masks or unmasks the given bytes in place, as described in section 5.3. The operation is its own inverse.
+static void apply_mask(Bytes bytes, u8 const (&masking_key)[4])
+{
+    u8 const repeated_key[8] = { masking_key[0], masking_key[1], masking_key[2], masking_key[3], masking_key[0], masking_key[1], masking_key[2], masking_key[3] };
+    u64 wide_key;
+    __builtin_memcpy(&wide_key, repeated_key, sizeof(wide_key));
+
+    size_t i = 0;
+    for (; i + sizeof(u64) <= bytes.size(); i += sizeof(u64)) {
+        u64 word;
+        __builtin_memcpy(&word, bytes.data() + i, sizeof(word));
+        word ^= wide_key;
+        __builtin_memcpy(bytes.data() + i, &word, sizeof(word));
+    }
+    for (; i < bytes.size(); ++i)
+        bytes[i] ^= masking_key[i % 4];
+}
+
+// RFC 7692 Section 7.2.1
+static ErrorOr<ByteBuffer> compress_message_payload(ReadonlyBytes payload)
+{
+    auto compressed = TRY(Compress::DeflateCompressor::compress_all(payload));
+
+    // Our compressor ends its output with a block that has BFINAL set. Appending an empty block with no compression,
+    // and then removing the 4 octets 0x00 0x00 0xff 0xff from the tail end, leaves a single 0x00 octet behind
+    // (see the example in section 7.2.3.4).
+    TRY(compressed.try_append(0x00));
+    return compressed;
+}
+
+// RFC 7692 Section 7.2.2
+static ErrorOr<ByteBuffer> decompress_message_payload(ReadonlyBytes payload)
+{
+    // Append 4 octets of 0x00 0x00 0xff 0xff to the tail end of the payload of the message. Our decompressor wants the
+    // data to end with a final block, so we also add an empty one of those, which has no effect on the output.
+    static constexpr u8 trailer[] = { 0x00, 0x00, 0xff, 0xff, 0x01, 0x00, 0x00, 0xff, 0xff };
+
+    auto data = TRY(ByteBuffer::create_uninitialized(payload.size() + sizeof(trailer)));
+    data.overwrite(0, payload.data(), payload.size());
+    data.overwrite(payload.size(), trailer, sizeof(trailer));
+
+    FixedMemoryStream memory_stream { data.bytes() };
+    LittleEndianInputBitStream bit_stream { MaybeOwned<Stream>(memory_stream) };
+    auto decompressor = TRY(Compress::DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream>(bit_stream)));
+
+    ByteBuffer message;
+    Array<u8, 4 * KiB> buffer;
+    while (!decompressor->is_eof()) {
+        auto bytes = TRY(decompressor->read_some(buffer));
+        if (message.size() + bytes.size() > max_message_size)
+            return Error::from_string_literal("Decompressed message is too large");
+        TRY(message.try_append(bytes));
+    }
+    return message;
+}
+
 NonnullRefPtr<WebSocket> WebSocket::create(ConnectionInfo connection, RefPtr<WebSocketImpl> impl)
 {
     return adopt_ref(*new WebSocket(move(connection), move(impl)));
@@ -79,15 +147,27 @@ ByteString WebSocket::subprotocol_in_use()
     return m_subprotocol_in_use;
 }
 
+ByteString WebSocket::extensions_in_use()
+{
+    return m_extensions_in_use;
+}
+
 void WebSocket::send(Message const& message)
 {
     // Calling send on a socket that is not opened is not allowed
     VERIFY(m_state == WebSocket::InternalState::Open);
     VERIFY(m_impl);
-    if (message.is_text())
-        send_frame(WebSocket::OpCode::Text, message.data(), true);
-    else
-        send_frame(WebSocket::OpCode::Binary, message.data(), true);
+    auto op_code = message.is_text() ? WebSocket::OpCode::Text : WebSocket::OpCode::Binary;
+
+    if (m_is_using_permessage_deflate && message.data().size() >= permessage_deflate_minimum_size) {
+        auto compressed = compress_message_payload(message.data());
+        if (!compressed.is_error() && compressed.value().size() < message.data().size()) {
+            send_frame(op_code, compressed.value(), true, true);
+            return;
+        }
+    }
+
+    send_frame(op_code, message.data(), true);
 }
 
 void WebSocket::close(u16 code, ByteString const& message)
@@ -146,7 +226,7 @@ void WebSocket::drain_read()
         }
         auto bytes = result.release_value();
         m_buffered_data.append(bytes.data(), bytes.size());
-        read_frame();
+        read_frames();
     } break;
     case InternalState::Closed:
     case InternalState::Errored: {
@@ -205,9 +285,12 @@ void WebSocket::send_client_handshake()
     }
 
     // 11. Websocket extensions (optional field)
-    if (!m_connection.extensions().is_empty()) {
+    auto extensions = m_connection.extensions();
+    if (m_connection.permessage_deflate_enabled())
+        extensions.append(permessage_deflate_offer);
+    if (!extensions.is_empty()) {
         builder.append("Sec-WebSocket-Extensions: "sv);
-        builder.join(',', m_connection.extensions());
+        builder.join(", "sv, extensions);
         builder.append("\r\n"sv);
     }
 
@@ -342,20 +425,9 @@ void WebSocket::read_server_handshake()
 
         if (header_name.equals_ignoring_ascii_case("Sec-WebSocket-Extensions"sv)) {
             // 5. |Sec-WebSocket-Extensions| should not contain an extension that doesn't appear in m_connection->extensions()
-            auto server_extensions = parts[1].split(',');
-            for (auto const& extension : server_extensions) {
-                auto trimmed_extension = extension.trim_whitespace();
-                bool found_extension = false;
-                for (auto const& supported_extension : m_connection.extensions()) {
-                    if (trimmed_extension.equals_ignoring_ascii_case(supported_extension)) {
-                        found_extension = true;
-                    }
-                }
-                if (!found_extension) {
-                    dbgln("WebSocket: Server HTTP Handshake Header |Sec-WebSocket-Extensions| contains '{}', which is not supported by the client. Failing connection.", trimmed_extension);
-                    fatal_error(WebSocket::Error::ConnectionUpgradeFailed);
-                    return;
-                }
+            if (!read_server_extensions(parts[1])) {
+                fatal_error(WebSocket::Error::ConnectionUpgradeFailed);
+                return;
             }
             continue;
         }
@@ -383,13 +455,106 @@ void WebSocket::read_server_handshake()
     // If needed, we will keep reading the header on the next drain_read call
 }
 
-void WebSocket::read_frame()
+bool WebSocket::read_server_extensions(StringView header_value)
+{
+    for (auto extension : header_value.split_view(',')) {
+        auto parameters = extension.split_view(';');
+        if (parameters.is_empty())
+            continue;
+        auto extension_name = parameters.take_first().trim_whitespace();
+
+        if (m_connection.permessage_deflate_enabled() && extension_name.equals_ignoring_ascii_case("permessage-deflate"sv)) {
+            // RFC 7692 Section 7.1: A client MUST _Fail the WebSocket Connection_ if the response contains an extension
+            // parameter it doesn't support, the same parameter twice, or an invalid value for one.
+            if (m_is_using_permessage_deflate) {
+                dbgln("WebSocket: Server accepted the permessage-deflate extension more than once. Failing connection.");
+                return false;
+            }
+
+            bool has_server_no_context_takeover = false;
+            for (auto parameter : parameters) {
+                auto name_and_value = parameter.split_view('=');
+                auto name = name_and_value[0].trim_whitespace();
+
+                if (name.equals_ignoring_ascii_case("server_no_context_takeover"sv) && name_and_value.size() == 1 && !has_server_no_context_takeover) {
+                    has_server_no_context_takeover = true;
+                    continue;
+                }
+                if (name.equals_ignoring_ascii_case("client_no_context_takeover"sv) && name_and_value.size() == 1)
+                    continue;
+                if (name.equals_ignoring_ascii_case("server_max_window_bits"sv) && name_and_value.size() == 2) {
+                    // Our decompressor handles any window size DEFLATE allows, so all we need to do is validate it.
+                    auto window_bits = name_and_value[1].trim_whitespace().trim("\""sv).to_number<u8>();
+                    if (window_bits.has_value() && *window_bits >= 8 && *window_bits <= 15)
+                        continue;
+                }
+
+                dbgln("WebSocket: Server HTTP Handshake Header |Sec-WebSocket-Extensions| contains permessage-deflate with unsupported parameter '{}'. Failing connection.", parameter.trim_whitespace());
+                return false;
+            }
+
+            // We offered server_no_context_takeover, which the server has to echo back if it accepts the offer.
+            if (!has_server_no_context_takeover) {
+                dbgln("WebSocket: Server accepted the permessage-deflate extension without server_no_context_takeover. Failing connection.");
+                return false;
+            }
+
+            m_is_using_permessage_deflate = true;
+            continue;
+        }
+
+        auto trimmed_extension = extension.trim_whitespace();
+        bool found_extension = false;
+        for (auto const& supported_extension : m_connection.extensions()) {
+            if (trimmed_extension.equals_ignoring_ascii_case(supported_extension)) {
+                found_extension = true;
+            }
+        }
+        if (!found_extension) {
+            dbgln("WebSocket: Server HTTP Handshake Header |Sec-WebSocket-Extensions| contains '{}', which is not supported by the client. Failing connection.", trimmed_extension);
+            return false;
+        }
+    }
+
+    m_extensions_in_use = header_value.trim_whitespace();
+    return true;
+}
+
+void WebSocket::read_frames()
 {
     VERIFY(m_impl);
     VERIFY(m_state == WebSocket::InternalState::Open || m_state == WebSocket::InternalState::Closing);
 
+    if (m_buffered_data.is_empty()) {
+        // The connection got closed.
+        set_state(WebSocket::InternalState::Closed);
+        notify_close(m_last_close_code, m_last_close_message, true);
+        discard_connection();
+        return;
+    }
+
+    NonnullRefPtr protect = *this;
+
+    // Handle every complete frame we have buffered, then drop them from the buffer all at once. Anything left over is
+    // the beginning of a frame whose remainder hasn't arrived yet.
     size_t cursor = 0;
-    auto get_buffered_bytes = [&](size_t count) -> ReadonlyBytes {
+    while (m_state == WebSocket::InternalState::Open || m_state == WebSocket::InternalState::Closing) {
+        if (!read_frame(cursor))
+            break;
+    }
+
+    if (cursor == m_buffered_data.size())
+        m_buffered_data.clear_with_capacity();
+    else if (cursor > 0)
+        m_buffered_data.remove(0, cursor);
+}
+
+// Handles the frame starting at the cursor and moves the cursor past it. Returns false, leaving the cursor untouched,
+// if the buffered data doesn't contain the whole frame yet.
+bool WebSocket::read_frame(size_t& frame_cursor)
+{
+    size_t cursor = frame_cursor;
+    auto get_buffered_bytes = [&](size_t count) -> Bytes {
         if (cursor + count > m_buffered_data.size())
             return {};
         auto bytes = m_buffered_data.span().slice(cursor, count);
@@ -398,16 +563,12 @@ void WebSocket::read_frame()
     };
 
     auto head_bytes = get_buffered_bytes(2);
-    if (head_bytes.is_null() || head_bytes.is_empty()) {
-        // The connection got closed.
-        set_state(WebSocket::InternalState::Closed);
-        notify_close(m_last_close_code, m_last_close_message, true);
-        discard_connection();
-        return;
-    }
+    if (head_bytes.is_null())
+        return false;
 
     auto op_code = (WebSocket::OpCode)(head_bytes[0] & 0x0f);
     bool is_final_frame = head_bytes[0] & 0x80;
+    bool is_compressed = head_bytes[0] & 0x40;
     bool is_masked = head_bytes[1] & 0x80;
 
     // Parse the payload length.
@@ -417,7 +578,7 @@ void WebSocket::read_frame()
         // A code of 127 means that the next 8 bytes contains the payload length
         auto actual_bytes = get_buffered_bytes(8);
         if (actual_bytes.is_null())
-            return;
+            return false;
         u64 full_payload_length = (u64)((u64)(actual_bytes[0] & 0xff) << 56)
             | (u64)((u64)(actual_bytes[1] & 0xff) << 48)
             | (u64)((u64)(actual_bytes[2] & 0xff) << 40)
@@ -432,7 +593,7 @@ void WebSocket::read_frame()
         // A code of 126 means that the next 2 bytes contains the payload length
         auto actual_bytes = get_buffered_bytes(2);
         if (actual_bytes.is_null())
-            return;
+            return false;
         payload_length = (size_t)((size_t)(actual_bytes[0] & 0xff) << 8)
             | (size_t)((size_t)(actual_bytes[1] & 0xff) << 0);
     } else {
@@ -449,90 +610,116 @@ void WebSocket::read_frame()
     if (is_masked) {
         auto masking_key_data = get_buffered_bytes(4);
         if (masking_key_data.is_null())
-            return;
+            return false;
         masking_key[0] = masking_key_data[0];
         masking_key[1] = masking_key_data[1];
         masking_key[2] = masking_key_data[2];
         masking_key[3] = masking_key_data[3];
     }
 
-    auto payload = ByteBuffer::create_uninitialized(payload_length).release_value_but_fixme_should_propagate_errors(); // FIXME: Handle possible OOM situation.
-    u64 read_length = 0;
-    while (read_length < payload_length) {
-        auto payload_part = get_buffered_bytes(payload_length - read_length);
-        if (payload_part.is_null())
-            return;
-        // We read at most "actual_length - read" bytes, so this is safe to do.
-        payload.overwrite(read_length, payload_part.data(), payload_part.size());
-        read_length += payload_part.size();
-    }
-
-    if (cursor == m_buffered_data.size()) {
-        m_buffered_data.clear();
-    } else {
-        Vector<u8> new_buffered_data;
-        new_buffered_data.append(m_buffered_data.data() + cursor, m_buffered_data.size() - cursor);
-        m_buffered_data = move(new_buffered_data);
+    // The payload is used straight out of the buffered data, which saves copying it before we know what to do with it.
+    Bytes payload;
+    if (payload_length > 0) {
+        payload = get_buffered_bytes(payload_length);
+        if (payload.is_null())
+            return false;
     }
+    frame_cursor = cursor;
 
     if (is_masked) {
         // Unmask the payload
-        for (size_t i = 0; i < payload.size(); ++i) {
-            payload[i] = payload[i] ^ (masking_key[i % 4]);
-        }
+        apply_mask(payload, masking_key);
+    }
+
+    // RFC 7692 Section 6: The "Per-Message Compressed" bit is only set on the first frame of a data message, and only
+    // if the extension is in use.
+    bool is_control_frame = (to_underlying(op_code) & 0x8) != 0;
+    if (is_compressed && (!m_is_using_permessage_deflate || is_control_frame || op_code == WebSocket::OpCode::Continuation)) {
+        dbgln("WebSocket: Received a frame with an unexpected RSV1 bit. Failing connection.");
+        fatal_error(WebSocket::Error::ServerClosedSocket);
+        return true;
     }
 
     if (op_code == WebSocket::OpCode::ConnectionClose) {
         if (payload.size() > 1) {
             m_last_close_code = (((u16)(payload[0] & 0xff) << 8) | ((u16)(payload[1] & 0xff)));
-            m_last_close_message = ByteString(ReadonlyBytes(payload.offset_pointer(2), payload.size() - 2));
+            m_last_close_message = ByteString(ReadonlyBytes(payload.slice(2)));
         }
         set_state(WebSocket::InternalState::Closing);
-        return;
+        return true;
     }
     if (op_code == WebSocket::OpCode::Ping) {
         // Immediately send a pong frame as a reply, with the given payload.
         send_frame(WebSocket::OpCode::Pong, payload, true);
-        return;
+        return true;
     }
     if (op_code == WebSocket::OpCode::Pong) {
         // We can safely ignore the pong
-        return;
+        return true;
     }
+
+    bool is_fragment = !is_final_frame || op_code == WebSocket::OpCode::Continuation;
+    if (is_fragment && m_fragmented_data_buffer.size() + payload.size() > max_message_size) {
+        dbgln("WebSocket: Received a message that is too large. Failing connection.");
+        fatal_error(WebSocket::Error::ServerClosedSocket);
+        return true;
+    }
+
+    ByteBuffer message_data;
     if (!is_final_frame) {
         if (op_code != WebSocket::OpCode::Continuation) {
             // First fragmented message
             m_initial_fragment_opcode = op_code;
+            m_fragmented_message_is_compressed = is_compressed;
         }
         // First and next fragmented message
-        m_fragmented_data_buffer.append(payload.data(), payload_length);
-        return;
+        m_fragmented_data_buffer.append(payload);
+        return true;
     }
-    if (is_final_frame && op_code == WebSocket::OpCode::Continuation) {
+    if (op_code == WebSocket::OpCode::Continuation) {
         // Last fragmented message
-        m_fragmented_data_buffer.append(payload.data(), payload_length);
+        m_fragmented_data_buffer.append(payload);
         op_code = m_initial_fragment_opcode;
-        payload.clear();
-        payload.append(m_fragmented_data_buffer.data(), m_fragmented_data_buffer.size());
-        m_fragmented_data_buffer.clear();
+        is_compressed = m_fragmented_message_is_compressed;
+        message_data = move(m_fragmented_data_buffer);
+    } else {
+        message_data = ByteBuffer::copy(payload).release_value_but_fixme_should_propagate_errors(); // FIXME: Handle possible OOM situation.
+    }
+
+    if (is_compressed) {
+        auto decompressed = decompress_message_payload(message_data);
+        if (decompressed.is_error()) {
+            dbgln("WebSocket: Failed to decompress message: {}. Failing connection.", decompressed.error());
+            fatal_error(WebSocket::Error::ServerClosedSocket);
+            return true;
+        }
+        message_data = decompressed.release_value();
     }
+
     if (op_code == WebSocket::OpCode::Text) {
-        notify_message(Message(payload, true));
-        return;
+        notify_message(Message(move(message_data), true));
+        return true;
     }
     if (op_code == WebSocket::OpCode::Binary) {
-        notify_message(Message(payload, false));
-        return;
+        notify_message(Message(move(message_data), false));
+        return true;
     }
     dbgln("Websocket: Found unknown opcode {}", (u8)op_code);
+    return true;
 }
 
-void WebSocket::send_frame(WebSocket::OpCode op_code, ReadonlyBytes payload, bool is_final)
+void WebSocket::send_frame(WebSocket::OpCode op_code, ReadonlyBytes payload, bool is_final, bool is_compressed)
 {
     VERIFY(m_impl);
     VERIFY(m_state == WebSocket::InternalState::Open);
-    u8 frame_head[1] = { (u8)((is_final ? 0x80 : 0x00) | ((u8)(op_code) & 0xf)) };
-    m_impl->send(ReadonlyBytes(frame_head, 1));
+
+    // The whole frame is assembled in one buffer and sent at once, so that a small message doesn't turn into several
+    // tiny writes (and TLS records).
+    ByteBuffer frame;
+    if (frame.try_ensure_capacity(payload.size() + 14).is_error())
+        return;
+
+    frame.append((u8)((is_final ? 0x80 : 0x00) | (is_compressed ? 0x40 : 0x00) | ((u8)(op_code) & 0xf)));
     // Section 5.1 : a client MUST mask all frames that it sends to the server
     bool has_mask = true;
     // FIXME: If the payload has a size > size_t max on a 32-bit platform, we could
@@ -540,70 +727,38 @@ void WebSocket::send_frame(WebSocket::OpCode op_code, ReadonlyBytes payload, boo
     //     truncated earlier in the call stack when stuffing into a ReadonlyBytes
     if (payload.size() > NumericLimits<u16>::max()) {
         // Send (the 'mask' flag + 127) + the 8-byte payload length
-        if constexpr (sizeof(size_t) >= 8) {
-            u8 payload_length[9] = {
-                (u8)((has_mask ? 0x80 : 0x00) | 127),
-                (u8)((payload.size() >> 56) & 0xff),
-                (u8)((payload.size() >> 48) & 0xff),
-                (u8)((payload.size() >> 40) & 0xff),
-                (u8)((payload.size() >> 32) & 0xff),
-                (u8)((payload.size() >> 24) & 0xff),
-                (u8)((payload.size() >> 16) & 0xff),
-                (u8)((payload.size() >> 8) & 0xff),
-                (u8)((payload.size() >> 0) & 0xff),
-            };
-            m_impl->send(ReadonlyBytes(payload_length, 9));
-        } else {
-            u8 payload_length[9] = {
-                (u8)((has_mask ? 0x80 : 0x00) | 127),
-                0,
-                0,
-                0,
-                0,
-                (u8)((payload.size() >> 24) & 0xff),
-                (u8)((payload.size() >> 16) & 0xff),
-                (u8)((payload.size() >> 8) & 0xff),
-                (u8)((payload.size() >> 0) & 0xff),
-            };
-            m_impl->send(ReadonlyBytes(payload_length, 9));
-        }
+        u64 length = payload.size();
+        frame.append((u8)((has_mask ? 0x80 : 0x00) | 127));
+        for (int shift = 56; shift >= 0; shift -= 8)
+            frame.append((u8)((length >> shift) & 0xff));
     } else if (payload.size() >= 126) {
         // Send (the 'mask' flag + 126) + the 2-byte payload length
-        u8 payload_length[3] = {
-            (u8)((has_mask ? 0x80 : 0x00) | 126),
-            (u8)((payload.size() >> 8) & 0xff),
-            (u8)((payload.size() >> 0) & 0xff),
-        };
-        m_impl->send(ReadonlyBytes(payload_length, 3));
+        frame.append((u8)((has_mask ? 0x80 : 0x00) | 126));
+        frame.append((u8)((payload.size() >> 8) & 0xff));
+        frame.append((u8)((payload.size() >> 0) & 0xff));
     } else {
         // Send the mask flag + the payload in a single byte
-        u8 payload_length[1] = {
-            (u8)((has_mask ? 0x80 : 0x00) | (u8)(payload.size() & 0x7f)),
-        };
-        m_impl->send(ReadonlyBytes(payload_length, 1));
+        frame.append((u8)((has_mask ? 0x80 : 0x00) | (u8)(payload.size() & 0x7f)));
     }
+
+    auto payload_offset = frame.size();
     if (has_mask) {
         // Section 10.3 :
         // > Clients MUST choose a new masking key for each frame, using an algorithm
         // > that cannot be predicted by end applications that provide data
         u8 masking_key[4];
         fill_with_random(masking_key);
-        m_impl->send(ReadonlyBytes(masking_key, 4));
-        // don't try to send empty payload
-        if (payload.size() == 0)
-            return;
-        // Mask the payload
-        auto buffer_result = ByteBuffer::create_uninitialized(payload.size());
-        if (!buffer_result.is_error()) {
-            auto& masked_payload = buffer_result.value();
-            for (size_t i = 0; i < payload.size(); ++i) {
-                masked_payload[i] = payload[i] ^ (masking_key[i % 4]);
-            }
-            m_impl->send(masked_payload);
-        }
-    } else if (payload.size() > 0) {
-        m_impl->send(payload);
+        frame.append(masking_key, 4);
+        payload_offset += 4;
+        frame.append(payload);
+
+        // Mask the payload in place, now that it's in the frame
+        apply_mask(frame.bytes().slice(payload_offset), masking_key);
+    } else {
+        frame.append(payload);
     }
+
+    m_impl->send(frame);
 }
 
 void WebSocket::fatal_error(WebSocket::Error error)
@@ -34,6 +34,9 @@ public:
 
     ByteString subprotocol_in_use();
 
+    // The extensions the server accepted, as listed in its |Sec-WebSocket-Extensions| header.
+    ByteString extensions_in_use();
+
     // Call this to start the WebSocket connection.
     void start();
 
@@ -75,8 +78,11 @@ private:
     void send_client_handshake();
     void read_server_handshake();
 
-    void read_frame();
-    void send_frame(OpCode, ReadonlyBytes, bool is_final);
+    bool read_server_extensions(StringView);
+
+    void read_frames();
+    bool read_frame(size_t& cursor);
+    void send_frame(OpCode, ReadonlyBytes, bool is_final, bool is_compressed = false);
 
     void notify_open();
     void notify_close(u16 code, ByteString reason, bool was_clean);
@@ -102,6 +108,7 @@ private:
     void set_state(InternalState);
 
     ByteString m_subprotocol_in_use { ByteString::empty() };
+    ByteString m_extensions_in_use { ByteString::empty() };
 
     ByteString m_websocket_key;
     bool m_has_read_server_handshake_first_line { false };
@@ -109,6 +116,10 @@ private:
     bool m_has_read_server_handshake_connection { false };
     bool m_has_read_server_handshake_accept { false };
 
+    // Set once the server has accepted our permessage-deflate offer. We always ask for no context takeover in both
+    // directions, so every message is compressed and decompressed on its own.
+    bool m_is_using_permessage_deflate { false };
+
     bool m_discard_connection_requested { false };
 
     u16 m_last_close_code { 1005 };
@@ -120,6 +131,7 @@ private:
     Vector<u8> m_buffered_data;
     ByteBuffer m_fragmented_data_buffer;
     WebSocket::OpCode m_initial_fragment_opcode;
+    bool m_fragmented_message_is_compressed { false };
 };
 
 }
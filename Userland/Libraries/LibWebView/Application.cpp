@@ -5,15 +5,19 @@
  */
 
 #include <AK/Debug.h>
+#include <AK/JsonObject.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/Environment.h>
+#include <LibCore/File.h>
 #include <LibCore/StandardPaths.h>
 #include <LibCore/TimeZoneWatcher.h>
+#include <LibCore/Tracing.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibImageDecoderClient/Client.h>
 #include <LibWebView/Application.h>
 #include <LibWebView/CookieJar.h>
 #include <LibWebView/Database.h>
+#include <LibWebView/StorageJar.h>
 #include <LibWebView/URL.h>
 #include <LibWebView/UserAgent.h>
 #include <LibWebView/WebContentClient.h>
@@ -53,6 +57,14 @@ Application::~Application()
     s_the = nullptr;
 }
 
+void Application::handle_memory_pressure()
+{
+    WebContentClient::for_each_client([&](WebView::WebContentClient& client) {
+        client.async_handle_memory_pressure();
+        return IterationDecision::Continue;
+    });
+}
+
 void Application::initialize(Main::Arguments const& arguments, URL::URL new_tab_page_url)
 {
     Vector<ByteString> raw_urls;
@@ -73,6 +85,9 @@ void Application::initialize(Main::Arguments const& arguments, URL::URL new_tab_
     bool expose_internals_object = false;
     bool force_cpu_painting = false;
     bool force_fontconfig = false;
+    Optional<StringView> trace_output_path;
+    Optional<size_t> web_content_process_pool_size;
+    Optional<size_t> web_content_memory_budget;
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("The Ladybird web browser :^)");
@@ -103,6 +118,22 @@ void Application::initialize(Main::Arguments const& arguments, URL::URL new_tab_
             return user_agent_preset.has_value();
         },
     });
+    args_parser.add_option(Core::ArgsParser::Option {
+        .argument_mode = Core::ArgsParser::OptionArgumentMode::Required,
+        .help_string = "Record trace events of the given comma-separated categories (or \"all\") in every process",
+        .long_name = "trace",
+        .value_name = "categories",
+        .accept_value = [&](StringView value) {
+            auto categories = Core::Tracing::parse_categories(value);
+            if (!categories.has_value())
+                return false;
+            Core::Tracing::set_enabled_categories(*categories);
+            return true;
+        },
+    });
+    args_parser.add_option(trace_output_path, "Write the trace to this file on exit (default: ladybird-trace.json)", "trace-output", 0, "path");
+    args_parser.add_option(web_content_process_pool_size, "Number of WebContent processes to keep ready for new tabs (default: 1)", "web-content-process-pool-size", 0, "count");
+    args_parser.add_option(web_content_memory_budget, "Make WebContent processes give back memory once they use more than this many MiB", "web-content-memory-budget", 0, "MiB");
 
     create_platform_arguments(args_parser);
     args_parser.parse(arguments);
@@ -137,6 +168,12 @@ void Application::initialize(Main::Arguments const& arguments, URL::URL new_tab_
     if (webdriver_content_ipc_path.has_value())
         m_chrome_options.webdriver_content_ipc_path = *webdriver_content_ipc_path;
 
+    if (Core::Tracing::enabled_categories() != Core::Tracing::Category::None)
+        m_chrome_options.trace_output_path = trace_output_path.value_or("ladybird-trace.json"sv);
+
+    if (web_content_process_pool_size.has_value())
+        m_chrome_options.web_content_process_pool_size = *web_content_process_pool_size;
+
     m_web_content_options = {
         .command_line = MUST(String::join(' ', arguments.strings)),
         .executable_path = MUST(String::from_byte_string(MUST(Core::System::current_executable_path()))),
@@ -148,6 +185,7 @@ void Application::initialize(Main::Arguments const& arguments, URL::URL new_tab_
         .force_cpu_painting = force_cpu_painting ? ForceCPUPainting::Yes : ForceCPUPainting::No,
         .force_fontconfig = force_fontconfig ? ForceFontconfig::Yes : ForceFontconfig::No,
         .enable_autoplay = enable_autoplay ? EnableAutoplay::Yes : EnableAutoplay::No,
+        .memory_budget_in_mib = web_content_memory_budget,
     };
 
     create_platform_options(m_chrome_options, m_web_content_options);
@@ -155,8 +193,10 @@ void Application::initialize(Main::Arguments const& arguments, URL::URL new_tab_
     if (m_chrome_options.disable_sql_database == DisableSQLDatabase::No) {
         m_database = Database::create().release_value_but_fixme_should_propagate_errors();
         m_cookie_jar = CookieJar::create(*m_database).release_value_but_fixme_should_propagate_errors();
+        m_storage_jar = StorageJar::create(*m_database).release_value_but_fixme_should_propagate_errors();
     } else {
         m_cookie_jar = CookieJar::create();
+        m_storage_jar = StorageJar::create();
     }
 }
 
@@ -164,6 +204,12 @@ int Application::execute()
 {
     int ret = m_event_loop.exec();
     m_in_shutdown = true;
+
+    if (m_chrome_options.trace_output_path.has_value()) {
+        if (auto result = write_trace(*m_chrome_options.trace_output_path); result.is_error())
+            warnln("Unable to write trace to {}: {}", *m_chrome_options.trace_output_path, result.error());
+    }
+
     return ret;
 }
 
@@ -184,9 +230,28 @@ Optional<Process&> Application::find_process(pid_t pid)
     return m_process_manager.find_process(pid);
 }
 
+void Application::set_spare_web_content_process_launcher(ProcessManager::LaunchWebContentProcess launch_web_content_process)
+{
+    m_process_manager.set_web_content_process_pool(m_chrome_options.web_content_process_pool_size, move(launch_web_content_process));
+}
+
+RefPtr<WebContentClient> Application::take_spare_web_content_process(ViewImplementation& view)
+{
+    auto client = m_process_manager.take_spare_web_content_process();
+    if (client)
+        client->assign_view(view);
+    return client;
+}
+
 void Application::update_process_statistics()
 {
     m_process_manager.update_all_process_statistics();
+
+    // The reports arrive asynchronously, so the next update shows the ones requested now.
+    WebContentClient::for_each_client([](WebContentClient& client) {
+        client.request_memory_reports();
+        return IterationDecision::Continue;
+    });
 }
 
 String Application::generate_process_statistics_html()
@@ -229,6 +294,17 @@ void Application::process_did_exit(Process&& process)
     }
 }
 
+ErrorOr<void> Application::write_trace(StringView path)
+{
+    JsonObject trace;
+    trace.set("traceEvents"sv, m_process_manager.take_trace_events());
+    trace.set("displayTimeUnit"sv, "ms"sv);
+    auto trace_json = trace.serialized<StringBuilder>();
+    auto trace_file = TRY(Core::File::open(path, Core::File::OpenMode::Write));
+    TRY(trace_file->write_until_depleted(trace_json.bytes()));
+    return {};
+}
+
 ErrorOr<LexicalPath> Application::path_for_downloaded_file(StringView file) const
 {
     auto downloads_directory = Core::StandardPaths::downloads_directory();
@@ -35,6 +35,7 @@ public:
     static WebContentOptions const& web_content_options() { return the().m_web_content_options; }
 
     static CookieJar& cookie_jar() { return *the().m_cookie_jar; }
+    static StorageJar& storage_jar() { return *the().m_storage_jar; }
 
     Core::EventLoop& event_loop() { return m_event_loop; }
 
@@ -46,12 +47,24 @@ public:
 #endif
     Optional<Process&> find_process(pid_t);
 
+    // Keeps chrome_options().web_content_process_pool_size WebContent processes launched with the given function ready
+    // for new tabs. Views should try to take one of those before launching a process of their own.
+    void set_spare_web_content_process_launcher(ProcessManager::LaunchWebContentProcess);
+    RefPtr<WebContentClient> take_spare_web_content_process(ViewImplementation&);
+
     // FIXME: Should we just expose the ProcessManager via a getter?
     void update_process_statistics();
     String generate_process_statistics_html();
 
     ErrorOr<LexicalPath> path_for_downloaded_file(StringView file) const;
 
+    // Asks every WebContent process to give back the memory it can do without, e.g. when the system is running low.
+    void handle_memory_pressure();
+
+    // Writes the trace events that all processes have recorded so far to a file that Perfetto and chrome://tracing can
+    // load. Every event is only written once.
+    ErrorOr<void> write_trace(StringView path);
+
 protected:
     template<DerivedFrom<Application> ApplicationType>
     static NonnullOwnPtr<ApplicationType> create(Main::Arguments& arguments, URL::URL new_tab_page_url)
@@ -81,6 +94,7 @@ private:
 
     RefPtr<Database> m_database;
     OwnPtr<CookieJar> m_cookie_jar;
+    OwnPtr<StorageJar> m_storage_jar;
 
     OwnPtr<Core::TimeZoneWatcher> m_time_zone_watcher;
 
@@ -46,6 +46,8 @@ ErrorOr<NonnullOwnPtr<CookieJar>> CookieJar::create(Database& database)
     statements.insert_cookie = TRY(database.prepare_statement("INSERT OR REPLACE INTO Cookies VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);"sv));
     statements.expire_cookie = TRY(database.prepare_statement("DELETE FROM Cookies WHERE (expiry_time < ?);"sv));
     statements.select_all_cookies = TRY(database.prepare_statement("SELECT * FROM Cookies;"sv));
+    statements.begin_transaction = TRY(database.prepare_statement("BEGIN TRANSACTION;"sv));
+    statements.commit_transaction = TRY(database.prepare_statement("COMMIT TRANSACTION;"sv));
 
     return adopt_own(*new CookieJar { PersistedStorage { database, statements } });
 }
@@ -68,11 +70,7 @@ CookieJar::CookieJar(Optional<PersistedStorage> persisted_storage)
     m_persisted_storage->synchronization_timer = Core::Timer::create_repeating(
         static_cast<int>(DATABASE_SYNCHRONIZATION_TIMER.to_milliseconds()),
         [this]() {
-            for (auto const& it : m_transient_storage.take_dirty_cookies())
-                m_persisted_storage->insert_cookie(it.value);
-
-            auto now = m_transient_storage.purge_expired_cookies();
-            m_persisted_storage->database.execute_statement(m_persisted_storage->statements.expire_cookie, {}, now);
+            synchronize_persisted_storage();
         });
     m_persisted_storage->synchronization_timer->start();
 }
@@ -83,7 +81,50 @@ CookieJar::~CookieJar()
         return;
 
     m_persisted_storage->synchronization_timer->stop();
-    m_persisted_storage->synchronization_timer->on_timeout();
+    synchronize_persisted_storage();
+
+    // Make sure the last batch has made it to the database before it goes away.
+    MUST(m_persisted_storage->database.synchronization_thread().wait_until_task_is_finished());
+}
+
+// The strings of a cookie share their storage with the copies in the transient storage, and that sharing is not
+// thread-safe. Cookies that are handed to the synchronization thread are copied in full first.
+static Web::Cookie::Cookie isolated_copy(Web::Cookie::Cookie const& cookie)
+{
+    auto copy_string = [](String const& string) {
+        return MUST(String::from_utf8(string.bytes_as_string_view()));
+    };
+
+    auto copy = cookie;
+    copy.name = copy_string(cookie.name);
+    copy.value = copy_string(cookie.value);
+    copy.domain = copy_string(cookie.domain);
+    copy.path = copy_string(cookie.path);
+    return copy;
+}
+
+void CookieJar::synchronize_persisted_storage()
+{
+    VERIFY(m_persisted_storage.has_value());
+
+    Vector<Web::Cookie::Cookie> dirty_cookies;
+    for (auto const& it : m_transient_storage.take_dirty_cookies())
+        dirty_cookies.append(isolated_copy(it.value));
+
+    auto now = m_transient_storage.purge_expired_cookies();
+
+    // Only one batch is written at a time, so that batches reach the database in the order they were taken. The
+    // previous batch will normally have finished long before the next synchronization. Writes to the database happen
+    // on the database's thread, so that they don't hold up the cookie lookups that every request and document.cookie
+    // access waits on.
+    auto& synchronization_thread = m_persisted_storage->database.synchronization_thread();
+    MUST(synchronization_thread.wait_until_task_is_finished());
+
+    auto did_start = synchronization_thread.start_task([&persisted_storage = *m_persisted_storage, dirty_cookies = move(dirty_cookies), now]() -> ErrorOr<void> {
+        persisted_storage.synchronize(dirty_cookies, now);
+        return {};
+    });
+    VERIFY(did_start);
 }
 
 // https://www.ietf.org/archive/id/draft-ietf-httpbis-rfc6265bis-15.html#section-5.8.3
@@ -555,7 +596,7 @@ Vector<Web::Cookie::Cookie> CookieJar::get_matching_cookies(const URL::URL& url,
     // 1. Let cookie-list be the set of cookies from the cookie store that meets all of the following requirements:
     Vector<Web::Cookie::Cookie> cookie_list;
 
-    m_transient_storage.for_each_cookie([&](Web::Cookie::Cookie& cookie) {
+    m_transient_storage.for_each_cookie_for_domain(canonicalized_domain, [&](Web::Cookie::Cookie& cookie) {
         // * Either:
         //     The cookie's host-only-flag is true and the canonicalized host of the retrieval's URI is identical to
         //     the cookie's domain.
@@ -628,19 +669,34 @@ Vector<Web::Cookie::Cookie> CookieJar::get_matching_cookies(const URL::URL& url,
 
 void CookieJar::TransientStorage::set_cookies(Cookies cookies)
 {
-    m_cookies = move(cookies);
+    m_cookies_by_domain.clear();
+    m_size = 0;
+
+    for (auto& it : cookies) {
+        auto& cookies_for_domain = m_cookies_by_domain.ensure(it.key.domain);
+        if (cookies_for_domain.set(it.key, move(it.value)) == HashSetResult::InsertedNewEntry)
+            ++m_size;
+    }
+
     purge_expired_cookies();
 }
 
 void CookieJar::TransientStorage::set_cookie(CookieStorageKey key, Web::Cookie::Cookie cookie)
 {
-    m_cookies.set(key, cookie);
+    auto& cookies_for_domain = m_cookies_by_domain.ensure(key.domain);
+    if (cookies_for_domain.set(key, cookie) == HashSetResult::InsertedNewEntry)
+        ++m_size;
+
     m_dirty_cookies.set(move(key), move(cookie));
 }
 
 Optional<Web::Cookie::Cookie> CookieJar::TransientStorage::get_cookie(CookieStorageKey const& key)
 {
-    return m_cookies.get(key);
+    auto it = m_cookies_by_domain.find(key.domain);
+    if (it == m_cookies_by_domain.end())
+        return {};
+
+    return it->value.get(key);
 }
 
 UnixDateTime CookieJar::TransientStorage::purge_expired_cookies()
@@ -648,7 +704,14 @@ UnixDateTime CookieJar::TransientStorage::purge_expired_cookies()
     auto now = UnixDateTime::now();
     auto is_expired = [&](auto const&, auto const& cookie) { return cookie.expiry_time < now; };
 
-    m_cookies.remove_all_matching(is_expired);
+    m_cookies_by_domain.remove_all_matching([&](auto const&, auto& cookies_for_domain) {
+        auto size_before = cookies_for_domain.size();
+        cookies_for_domain.remove_all_matching(is_expired);
+        m_size -= size_before - cookies_for_domain.size();
+
+        return cookies_for_domain.is_empty();
+    });
+
     return now;
 }
 
@@ -671,6 +734,18 @@ void CookieJar::PersistedStorage::insert_cookie(Web::Cookie::Cookie const& cooki
         cookie.persistent);
 }
 
+void CookieJar::PersistedStorage::synchronize(Vector<Web::Cookie::Cookie> const& dirty_cookies, UnixDateTime now)
+{
+    // Batching the writes into a single transaction saves SQLite from syncing to disk after every one of them.
+    database.execute_statement(statements.begin_transaction, {});
+
+    for (auto const& cookie : dirty_cookies)
+        insert_cookie(cookie);
+
+    database.execute_statement(statements.expire_cookie, {}, now);
+    database.execute_statement(statements.commit_transaction, {});
+}
+
 static Web::Cookie::Cookie parse_cookie(Database& database, Database::StatementID statement_id)
 {
     int column = 0;
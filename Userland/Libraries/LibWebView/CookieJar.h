@@ -9,6 +9,7 @@
 #include <AK/Function.h>
 #include <AK/HashMap.h>
 #include <AK/Optional.h>
+#include <AK/OwnPtr.h>
 #include <AK/String.h>
 #include <AK/StringView.h>
 #include <AK/Traits.h>
@@ -35,6 +36,8 @@ class CookieJar {
         Database::StatementID insert_cookie { 0 };
         Database::StatementID expire_cookie { 0 };
         Database::StatementID select_all_cookies { 0 };
+        Database::StatementID begin_transaction { 0 };
+        Database::StatementID commit_transaction { 0 };
     };
 
     class TransientStorage {
@@ -45,7 +48,7 @@ class CookieJar {
         void set_cookie(CookieStorageKey, Web::Cookie::Cookie);
         Optional<Web::Cookie::Cookie> get_cookie(CookieStorageKey const&);
 
-        size_t size() const { return m_cookies.size(); }
+        size_t size() const { return m_size; }
 
         UnixDateTime purge_expired_cookies();
 
@@ -53,27 +56,63 @@ class CookieJar {
 
         template<typename Callback>
         void for_each_cookie(Callback callback)
+        {
+            for (auto& it : m_cookies_by_domain) {
+                if (for_each_cookie_in(it.value, callback) == IterationDecision::Break)
+                    return;
+            }
+        }
+
+        // Visits only the cookies whose domain is the given domain or one of its parent domains, as no other cookie
+        // can match a request to that domain.
+        template<typename Callback>
+        void for_each_cookie_for_domain(StringView canonicalized_domain, Callback callback)
+        {
+            auto domain = canonicalized_domain;
+
+            while (true) {
+                if (auto it = m_cookies_by_domain.find(domain); it != m_cookies_by_domain.end()) {
+                    if (for_each_cookie_in(it->value, callback) == IterationDecision::Break)
+                        return;
+                }
+
+                auto next_label = domain.find('.');
+                if (!next_label.has_value())
+                    return;
+                domain = domain.substring_view(*next_label + 1);
+            }
+        }
+
+    private:
+        template<typename Callback>
+        static IterationDecision for_each_cookie_in(Cookies& cookies, Callback& callback)
         {
             using ReturnType = InvokeResult<Callback, Web::Cookie::Cookie&>;
 
-            for (auto& it : m_cookies) {
+            for (auto& it : cookies) {
                 if constexpr (IsSame<ReturnType, IterationDecision>) {
                     if (callback(it.value) == IterationDecision::Break)
-                        return;
+                        return IterationDecision::Break;
                 } else {
                     static_assert(IsSame<ReturnType, void>);
                     callback(it.value);
                 }
             }
+
+            return IterationDecision::Continue;
         }
 
-    private:
-        Cookies m_cookies;
+        // Cookies are grouped by their domain, so that looking up the cookies for a request is a handful of hash
+        // lookups rather than a scan of the entire cookie store.
+        HashMap<String, Cookies> m_cookies_by_domain;
+        size_t m_size { 0 };
+
         Cookies m_dirty_cookies;
     };
 
     struct PersistedStorage {
         void insert_cookie(Web::Cookie::Cookie const& cookie);
+        void synchronize(Vector<Web::Cookie::Cookie> const& dirty_cookies, UnixDateTime now);
         TransientStorage::Cookies select_all_cookies();
 
         Database& database;
@@ -110,6 +149,8 @@ private:
         WebDriver,
     };
 
+    void synchronize_persisted_storage();
+
     void store_cookie(Web::Cookie::ParsedCookie const& parsed_cookie, const URL::URL& url, String canonicalized_domain, Web::Cookie::Source source);
     Vector<Web::Cookie::Cookie> get_matching_cookies(const URL::URL& url, StringView canonicalized_domain, Web::Cookie::Source source, MatchingCookiesSpecMode mode = MatchingCookiesSpecMode::RFC6265);
 
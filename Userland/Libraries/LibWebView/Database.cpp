@@ -50,17 +50,22 @@ ErrorOr<NonnullRefPtr<Database>> Database::create()
     sqlite3* m_database { nullptr };
     SQL_TRY(sqlite3_open(database_file.characters(), &m_database));
 
-    return adopt_nonnull_ref_or_enomem(new (nothrow) Database(m_database));
+    auto synchronization_thread = TRY(Threading::WorkerThread<Error>::create("Database"sv));
+
+    return adopt_nonnull_ref_or_enomem(new (nothrow) Database(m_database, move(synchronization_thread)));
 }
 
-Database::Database(sqlite3* database)
+Database::Database(sqlite3* database, NonnullOwnPtr<Threading::WorkerThread<Error>> synchronization_thread)
     : m_database(database)
+    , m_synchronization_thread(move(synchronization_thread))
 {
     VERIFY(m_database);
 }
 
 Database::~Database()
 {
+    MUST(m_synchronization_thread->wait_until_task_is_finished());
+
     for (auto* prepared_statement : m_prepared_statements)
         sqlite3_finalize(prepared_statement);
 
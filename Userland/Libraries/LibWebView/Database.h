@@ -9,10 +9,12 @@
 
 #include <AK/Error.h>
 #include <AK/Function.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/StringView.h>
 #include <AK/Vector.h>
+#include <LibThreading/WorkerThread.h>
 
 struct sqlite3;
 struct sqlite3_stmt;
@@ -42,8 +44,12 @@ public:
     template<typename ValueType>
     ValueType result_column(StatementID, int column);
 
+    // Batches of writes that shouldn't hold up the main thread are run on this thread. Every user of the database shares
+    // it, so that the batches never interleave with each other's transactions.
+    Threading::WorkerThread<Error>& synchronization_thread() { return *m_synchronization_thread; }
+
 private:
-    explicit Database(sqlite3*);
+    Database(sqlite3*, NonnullOwnPtr<Threading::WorkerThread<Error>>);
 
     template<typename ValueType>
     void apply_placeholder(StatementID statement_id, int index, ValueType const& value);
@@ -56,6 +62,7 @@ private:
 
     sqlite3* m_database { nullptr };
     Vector<sqlite3_stmt*> m_prepared_statements;
+    NonnullOwnPtr<Threading::WorkerThread<Error>> m_synchronization_thread;
 };
 
 }
@@ -15,6 +15,7 @@ class Database;
 class InspectorClient;
 class OutOfProcessWebView;
 class ProcessManager;
+class StorageJar;
 class ViewImplementation;
 class WebContentClient;
 
@@ -22,6 +23,7 @@ struct Attribute;
 struct CookieStorageKey;
 struct ProcessHandle;
 struct SearchEngine;
+struct StorageItemKey;
 
 }
 
@@ -30,4 +32,7 @@ namespace AK {
 template<>
 struct Traits<WebView::CookieStorageKey>;
 
+template<>
+struct Traits<WebView::StorageItemKey>;
+
 }
@@ -58,6 +58,8 @@ struct ChromeOptions {
     Optional<ProcessType> debug_helper_process {};
     Optional<ProcessType> profile_helper_process {};
     Optional<ByteString> webdriver_content_ipc_path {};
+    Optional<ByteString> trace_output_path {};
+    size_t web_content_process_pool_size { 1 };
 };
 
 enum class IsLayoutTestMode {
@@ -100,6 +102,11 @@ enum class ForceFontconfig {
     Yes,
 };
 
+enum class LogDisplayListOptimizations {
+    No,
+    Yes,
+};
+
 struct WebContentOptions {
     String command_line;
     String executable_path;
@@ -114,6 +121,8 @@ struct WebContentOptions {
     ForceCPUPainting force_cpu_painting { ForceCPUPainting::No };
     ForceFontconfig force_fontconfig { ForceFontconfig::No };
     EnableAutoplay enable_autoplay { EnableAutoplay::No };
+    LogDisplayListOptimizations log_display_list_optimizations { LogDisplayListOptimizations::No };
+    Optional<size_t> memory_budget_in_mib {};
 };
 
 }
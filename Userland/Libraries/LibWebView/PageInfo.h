@@ -15,6 +15,9 @@ enum class PageInfoType {
     LayoutTree = 1 << 2,
     PaintTree = 1 << 3,
     GCGraph = 1 << 4,
+    GCStatistics = 1 << 5,
+    JSProfile = 1 << 6,
+    Trace = 1 << 7,
 };
 
 AK_ENUM_BITWISE_OPERATORS(PageInfoType);
@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
+#include <AK/JsonObject.h>
 #include <AK/String.h>
 #include <AK/WeakPtr.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/Process.h>
 #include <LibIPC/Connection.h>
 #include <LibWebView/ProcessType.h>
@@ -36,11 +39,22 @@ public:
 
     pid_t pid() const { return m_process.pid(); }
 
+    // The buffer the process records its trace events into, if it was launched while tracing.
+    Optional<Core::AnonymousBuffer>& trace_buffer() { return m_trace_buffer; }
+    void set_trace_buffer(Core::AnonymousBuffer trace_buffer) { m_trace_buffer = move(trace_buffer); }
+
+    // The latest memory report of each page in a WebContent process, keyed by page ID. See Web::memory_report().
+    HashMap<u64, JsonObject> const& memory_reports() const { return m_memory_reports; }
+    void set_memory_report(u64 page_id, JsonObject report) { m_memory_reports.set(page_id, move(report)); }
+    void remove_memory_report(u64 page_id) { m_memory_reports.remove(page_id); }
+
 private:
     Core::Process m_process;
     ProcessType m_type;
     Optional<String> m_title;
     WeakPtr<IPC::ConnectionBase> m_connection;
+    Optional<Core::AnonymousBuffer> m_trace_buffer;
+    HashMap<u64, JsonObject> m_memory_reports;
 };
 
 }
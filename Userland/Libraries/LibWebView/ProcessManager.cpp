@@ -4,11 +4,16 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
+#include <AK/JsonObject.h>
 #include <AK/NumberFormat.h>
+#include <AK/QuickSort.h>
 #include <AK/String.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/System.h>
+#include <LibCore/Tracing.h>
 #include <LibWebView/ProcessManager.h>
+#include <LibWebView/WebContentClient.h>
 
 namespace WebView {
 
@@ -110,7 +115,101 @@ Optional<Process> ProcessManager::remove_process(pid_t pid)
     m_statistics.processes.remove_first_matching([&](auto const& info) {
         return (info->pid == pid);
     });
-    return m_processes.take(pid);
+
+    auto process = m_processes.take(pid);
+    if (process.has_value() && process->trace_buffer().has_value())
+        m_exited_process_trace_buffers.append({ pid, process->type(), process->trace_buffer().release_value() });
+
+    if (m_spare_web_content_processes.remove_all_matching([&](auto const& client) { return client->pid() == pid; })) {
+        dbgln_if(WEBVIEW_PROCESS_DEBUG, "Spare WebContent process {} exited", pid);
+        schedule_web_content_process_pool_fill();
+    }
+
+    return process;
+}
+
+void ProcessManager::set_web_content_process_pool(size_t size, LaunchWebContentProcess launch_web_content_process)
+{
+    m_web_content_process_pool_size = size;
+    m_launch_spare_web_content_process = move(launch_web_content_process);
+
+    if (m_spare_web_content_processes.size() > size)
+        m_spare_web_content_processes.shrink(size);
+    schedule_web_content_process_pool_fill();
+}
+
+RefPtr<WebContentClient> ProcessManager::take_spare_web_content_process()
+{
+    if (m_spare_web_content_processes.is_empty())
+        return nullptr;
+
+    auto client = m_spare_web_content_processes.take_first();
+    schedule_web_content_process_pool_fill();
+    return client;
+}
+
+void ProcessManager::schedule_web_content_process_pool_fill()
+{
+    if (m_web_content_process_pool_fill_scheduled || !m_launch_spare_web_content_process)
+        return;
+    m_web_content_process_pool_fill_scheduled = true;
+
+    // Deferred, so that whoever just took a process out of the pool gets to set it up first.
+    Core::deferred_invoke([this] {
+        m_web_content_process_pool_fill_scheduled = false;
+        fill_web_content_process_pool();
+    });
+}
+
+void ProcessManager::fill_web_content_process_pool()
+{
+    while (m_launch_spare_web_content_process && m_spare_web_content_processes.size() < m_web_content_process_pool_size) {
+        auto client = m_launch_spare_web_content_process();
+        if (client.is_error()) {
+            // Launching is likely to keep failing, so tabs will launch their own processes instead.
+            warnln("Unable to launch a spare WebContent process: {}", client.error());
+            m_launch_spare_web_content_process = nullptr;
+            return;
+        }
+        m_spare_web_content_processes.append(client.release_value());
+    }
+}
+
+JsonArray ProcessManager::take_trace_events()
+{
+    Threading::MutexLocker locker { m_lock };
+    JsonArray trace_events;
+
+    auto append_events = [&](pid_t pid, ProcessType type, Vector<Core::Tracing::Event> events) {
+        if (events.is_empty())
+            return;
+
+        JsonObject args;
+        args.set("name"sv, process_name_from_type(type));
+
+        JsonObject process_name;
+        process_name.set("name"sv, "process_name"sv);
+        process_name.set("ph"sv, "M"sv);
+        process_name.set("pid"sv, pid);
+        process_name.set("args"sv, move(args));
+        trace_events.must_append(move(process_name));
+
+        for (auto const& trace_event : Core::Tracing::to_chrome_trace_events(events).values())
+            trace_events.must_append(trace_event);
+    };
+
+    for (auto& [pid, process] : m_processes) {
+        if (process.type() == ProcessType::Chrome)
+            append_events(pid, process.type(), Core::Tracing::take_events());
+        else if (process.trace_buffer().has_value())
+            append_events(pid, process.type(), Core::Tracing::take_events(*process.trace_buffer()));
+    }
+
+    for (auto& exited_process : m_exited_process_trace_buffers)
+        append_events(exited_process.pid, exited_process.type, Core::Tracing::take_events(exited_process.buffer));
+    m_exited_process_trace_buffers.clear();
+
+    return trace_events;
 }
 
 void ProcessManager::update_all_process_statistics()
@@ -119,6 +218,79 @@ void ProcessManager::update_all_process_statistics()
     (void)update_process_statistics(m_statistics);
 }
 
+static void append_memory_report_html(StringBuilder& builder, JsonObject const& report)
+{
+    auto append_row = [&](StringView subsystem, Optional<JsonObject const&> usage) {
+        if (!usage.has_value())
+            return;
+
+        builder.append("<tr>"sv);
+        builder.appendff("<td>{}</td>", escape_html_entities(subsystem));
+        if (auto count = usage->get_u64("count"sv); count.has_value())
+            builder.appendff("<td>{}</td>", *count);
+        else
+            builder.append("<td></td>"sv);
+        builder.appendff("<td>{}</td>", human_readable_size(usage->get_u64("bytes"sv).value_or(0)));
+        builder.append("</tr>"sv);
+    };
+
+    builder.append("<table><thead><tr><th>Subsystem</th><th>Count</th><th>Size</th></tr></thead><tbody>"sv);
+
+    if (auto page = report.get_object("page"sv); page.has_value()) {
+        append_row("DOM nodes"sv, page->get_object("dom"sv));
+        append_row("Computed styles"sv, page->get_object("style"sv));
+        append_row("Layout nodes"sv, page->get_object("layout"sv));
+        append_row("Paintables"sv, page->get_object("paint"sv));
+        append_row("Display lists"sv, page->get_object("display_lists"sv));
+        append_row("Backing stores"sv, page->get_object("backing_stores"sv));
+    }
+
+    // What follows is shared by all pages of the process.
+    if (auto process = report.get_object("process"sv); process.has_value()) {
+        append_row("Decoded images (process)"sv, process->get_object("decoded_images"sv));
+        append_row("Glyph cache (process)"sv, process->get_object("glyph_cache"sv));
+
+        if (auto javascript_heap = process->get_array("javascript_heap"sv); javascript_heap.has_value()) {
+            struct Allocator {
+                ByteString class_name;
+                u64 live_cells { 0 };
+                u64 live_bytes { 0 };
+                u64 block_bytes { 0 };
+            };
+            Vector<Allocator> allocators;
+            u64 total_live_cells = 0;
+            u64 total_block_bytes = 0;
+
+            javascript_heap->for_each([&](JsonValue const& value) {
+                if (!value.is_object())
+                    return;
+                auto const& object = value.as_object();
+                Allocator allocator {
+                    .class_name = object.get_byte_string("class_name"sv).value_or(ByteString {}),
+                    .live_cells = object.get_u64("live_cells"sv).value_or(0),
+                    .live_bytes = object.get_u64("live_bytes"sv).value_or(0),
+                    .block_bytes = object.get_u64("block_bytes"sv).value_or(0),
+                };
+                total_live_cells += allocator.live_cells;
+                total_block_bytes += allocator.block_bytes;
+                allocators.append(move(allocator));
+            });
+
+            builder.appendff("<tr><td>JavaScript heap (process)</td><td>{}</td><td>{}</td></tr>", total_live_cells, human_readable_size(total_block_bytes));
+
+            // Only list the allocators that hold on to the most memory, as there are hundreds of them.
+            quick_sort(allocators, [](auto const& a, auto const& b) { return a.block_bytes > b.block_bytes; });
+            for (size_t i = 0; i < min(allocators.size(), 10uz); ++i) {
+                auto const& allocator = allocators[i];
+                builder.appendff("<tr><td>&nbsp;&nbsp;{}</td><td>{}</td><td>{} ({} live)</td></tr>",
+                    escape_html_entities(allocator.class_name), allocator.live_cells, human_readable_size(allocator.block_bytes), human_readable_size(allocator.live_bytes));
+            }
+        }
+    }
+
+    builder.append("</tbody></table>"sv);
+}
+
 String ProcessManager::generate_html()
 {
     Threading::MutexLocker locker { m_lock };
@@ -197,6 +369,22 @@ String ProcessManager::generate_html()
     builder.append(R"(
                 </tbody>
                 </table>
+    )"sv);
+
+    for (auto const& [pid, process] : m_processes) {
+        for (auto const& [page_id, report] : process.memory_reports()) {
+            builder.append("<h3>"sv);
+            if (process.title().has_value())
+                builder.append(escape_html_entities(*process.title()));
+            else
+                builder.append(process_name_from_type(process.type()));
+            builder.appendff(" (PID {}, page {})</h3>", pid, page_id);
+
+            append_memory_report_html(builder, report);
+        }
+    }
+
+    builder.append(R"(
                 </body>
                 </html>
     )"sv);
@@ -6,8 +6,12 @@
 
 #pragma once
 
+#include <AK/Function.h>
+#include <AK/JsonArray.h>
+#include <AK/NonnullRefPtr.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/EventReceiver.h>
 #include <LibCore/Platform/ProcessStatistics.h>
 #include <LibThreading/Mutex.h>
@@ -38,11 +42,39 @@ public:
     void update_all_process_statistics();
     String generate_html();
 
+    // Returns the trace events that all processes have recorded so far, including those that have exited since, as
+    // Chrome trace events. Every event is only returned once.
+    JsonArray take_trace_events();
+
+    // Keeps up to the given number of WebContent processes launched ahead of time, so that opening a tab doesn't have
+    // to wait for a process to start up. The pool is refilled whenever a process is taken out of it.
+    using LaunchWebContentProcess = Function<ErrorOr<NonnullRefPtr<WebContentClient>>()>;
+    void set_web_content_process_pool(size_t size, LaunchWebContentProcess);
+    RefPtr<WebContentClient> take_spare_web_content_process();
+
     Function<void(Process&&)> on_process_exited;
 
 private:
+    void schedule_web_content_process_pool_fill();
+    void fill_web_content_process_pool();
+
     Core::Platform::ProcessStatistics m_statistics;
     HashMap<pid_t, Process> m_processes;
+
+    // Kept around so that the events leading up to a process exiting, or crashing, may still be looked at.
+    struct ExitedProcessTraceBuffer {
+        pid_t pid { 0 };
+        ProcessType type;
+        Core::AnonymousBuffer buffer;
+    };
+    Vector<ExitedProcessTraceBuffer> m_exited_process_trace_buffers;
+
+    // The pool is only used from the main thread, so it isn't guarded by m_lock. Launching a process takes that lock.
+    size_t m_web_content_process_pool_size { 0 };
+    LaunchWebContentProcess m_launch_spare_web_content_process;
+    Vector<NonnullRefPtr<WebContentClient>> m_spare_web_content_processes;
+    bool m_web_content_process_pool_fill_scheduled { false };
+
     int m_signal_handle { -1 };
     Threading::Mutex m_lock;
 };
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Time.h>
+#include <LibWebView/StorageJar.h>
+
+namespace WebView {
+
+static constexpr auto DATABASE_SYNCHRONIZATION_TIMER = AK::Duration::from_seconds(5);
+
+ErrorOr<NonnullOwnPtr<StorageJar>> StorageJar::create(Database& database)
+{
+    Statements statements {};
+
+    auto create_table = TRY(database.prepare_statement(R"#(
+        CREATE TABLE IF NOT EXISTS WebStorage (
+            storage_key TEXT,
+            key TEXT,
+            value TEXT,
+            PRIMARY KEY(storage_key, key)
+        );)#"sv));
+    database.execute_statement(create_table, {});
+
+    statements.insert_item = TRY(database.prepare_statement("INSERT OR REPLACE INTO WebStorage VALUES (?, ?, ?);"sv));
+    statements.delete_item = TRY(database.prepare_statement("DELETE FROM WebStorage WHERE (storage_key = ? AND key = ?);"sv));
+    statements.delete_items = TRY(database.prepare_statement("DELETE FROM WebStorage WHERE (storage_key = ?);"sv));
+    statements.select_all_items = TRY(database.prepare_statement("SELECT * FROM WebStorage;"sv));
+    statements.begin_transaction = TRY(database.prepare_statement("BEGIN TRANSACTION;"sv));
+    statements.commit_transaction = TRY(database.prepare_statement("COMMIT TRANSACTION;"sv));
+
+    return adopt_own(*new StorageJar { PersistedStorage { database, statements } });
+}
+
+NonnullOwnPtr<StorageJar> StorageJar::create()
+{
+    return adopt_own(*new StorageJar { OptionalNone {} });
+}
+
+StorageJar::StorageJar(Optional<PersistedStorage> persisted_storage)
+    : m_persisted_storage(move(persisted_storage))
+{
+    if (!m_persisted_storage.has_value())
+        return;
+
+    auto items = m_persisted_storage->select_all_items();
+    m_transient_storage.set_items(move(items));
+
+    m_persisted_storage->synchronization_timer = Core::Timer::create_repeating(
+        static_cast<int>(DATABASE_SYNCHRONIZATION_TIMER.to_milliseconds()),
+        [this]() {
+            synchronize_persisted_storage();
+        });
+    m_persisted_storage->synchronization_timer->start();
+}
+
+StorageJar::~StorageJar()
+{
+    if (!m_persisted_storage.has_value())
+        return;
+
+    m_persisted_storage->synchronization_timer->stop();
+    synchronize_persisted_storage();
+
+    // Make sure the last batch has made it to the database before it goes away.
+    MUST(m_persisted_storage->database.synchronization_thread().wait_until_task_is_finished());
+}
+
+// The strings share their storage with the copies in the transient storage, and that sharing is not thread-safe.
+// Strings that are handed to the synchronization thread are copied in full first.
+static String isolated_copy(String const& string)
+{
+    return MUST(String::from_utf8(string.bytes_as_string_view()));
+}
+
+void StorageJar::synchronize_persisted_storage()
+{
+    VERIFY(m_persisted_storage.has_value());
+
+    if (!m_transient_storage.has_dirty_items())
+        return;
+
+    Vector<String> cleared_storage_keys;
+    for (auto const& storage_key : m_transient_storage.take_cleared_storage_keys())
+        cleared_storage_keys.append(isolated_copy(storage_key));
+
+    TransientStorage::DirtyItems dirty_items;
+    for (auto const& it : m_transient_storage.take_dirty_items()) {
+        StorageItemKey key { isolated_copy(it.key.storage_key), isolated_copy(it.key.key) };
+        dirty_items.set(move(key), it.value.map([](auto const& value) { return isolated_copy(value); }));
+    }
+
+    // Only one batch is written at a time, so that batches reach the database in the order they were taken.
+    auto& synchronization_thread = m_persisted_storage->database.synchronization_thread();
+    MUST(synchronization_thread.wait_until_task_is_finished());
+
+    auto did_start = synchronization_thread.start_task([&persisted_storage = *m_persisted_storage, cleared_storage_keys = move(cleared_storage_keys), dirty_items = move(dirty_items)]() -> ErrorOr<void> {
+        persisted_storage.synchronize(cleared_storage_keys, dirty_items);
+        return {};
+    });
+    VERIFY(did_start);
+}
+
+OrderedHashMap<String, String> StorageJar::get_items(String const& storage_key) const
+{
+    return m_transient_storage.get_items(storage_key);
+}
+
+void StorageJar::set_item(String const& storage_key, String const& key, String const& value)
+{
+    m_transient_storage.set_item(storage_key, key, value);
+}
+
+void StorageJar::remove_item(String const& storage_key, String const& key)
+{
+    m_transient_storage.remove_item(storage_key, key);
+}
+
+void StorageJar::clear(String const& storage_key)
+{
+    m_transient_storage.clear(storage_key);
+}
+
+void StorageJar::TransientStorage::set_items(HashMap<String, Items> items)
+{
+    m_items = move(items);
+}
+
+StorageJar::TransientStorage::Items StorageJar::TransientStorage::get_items(String const& storage_key) const
+{
+    if (auto it = m_items.find(storage_key); it != m_items.end())
+        return it->value;
+    return {};
+}
+
+void StorageJar::TransientStorage::set_item(String const& storage_key, String const& key, String const& value)
+{
+    m_items.ensure(storage_key).set(key, value);
+    m_dirty_items.set({ storage_key, key }, value);
+}
+
+void StorageJar::TransientStorage::remove_item(String const& storage_key, String const& key)
+{
+    auto it = m_items.find(storage_key);
+    if (it == m_items.end())
+        return;
+
+    it->value.remove(key);
+    if (it->value.is_empty())
+        m_items.remove(it);
+
+    m_dirty_items.set({ storage_key, key }, OptionalNone {});
+}
+
+void StorageJar::TransientStorage::clear(String const& storage_key)
+{
+    m_items.remove(storage_key);
+
+    // Everything written to this storage before now is deleted along with the rest of its items, so there's no need to
+    // write it in the first place.
+    m_dirty_items.remove_all_matching([&](auto const& key, auto const&) {
+        return key.storage_key == storage_key;
+    });
+    m_cleared_storage_keys.append(storage_key);
+}
+
+void StorageJar::PersistedStorage::synchronize(Vector<String> const& cleared_storage_keys, TransientStorage::DirtyItems const& dirty_items)
+{
+    // Batching the writes into a single transaction saves SQLite from syncing to disk after every one of them.
+    database.execute_statement(statements.begin_transaction, {});
+
+    // NOTE: The items of a cleared storage that are still dirty were all written after it was cleared.
+    for (auto const& storage_key : cleared_storage_keys)
+        database.execute_statement(statements.delete_items, {}, storage_key);
+
+    for (auto const& it : dirty_items) {
+        if (it.value.has_value())
+            database.execute_statement(statements.insert_item, {}, it.key.storage_key, it.key.key, *it.value);
+        else
+            database.execute_statement(statements.delete_item, {}, it.key.storage_key, it.key.key);
+    }
+
+    database.execute_statement(statements.commit_transaction, {});
+}
+
+HashMap<String, StorageJar::TransientStorage::Items> StorageJar::PersistedStorage::select_all_items()
+{
+    HashMap<String, TransientStorage::Items> items;
+
+    database.execute_statement(
+        statements.select_all_items,
+        [&](auto statement_id) {
+            auto storage_key = database.result_column<String>(statement_id, 0);
+            auto key = database.result_column<String>(statement_id, 1);
+            auto value = database.result_column<String>(statement_id, 2);
+
+            items.ensure(storage_key).set(move(key), move(value));
+        });
+
+    return items;
+}
+
+}
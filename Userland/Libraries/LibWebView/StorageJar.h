@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Traits.h>
+#include <LibCore/Timer.h>
+#include <LibWebView/Database.h>
+#include <LibWebView/Forward.h>
+
+namespace WebView {
+
+struct StorageItemKey {
+    bool operator==(StorageItemKey const&) const = default;
+
+    String storage_key;
+    String key;
+};
+
+// Holds the localStorage items of every origin for all WebContent processes. The items are kept in memory and looked
+// up from there, changes are written back to the database in batches.
+class StorageJar {
+    struct Statements {
+        Database::StatementID insert_item { 0 };
+        Database::StatementID delete_item { 0 };
+        Database::StatementID delete_items { 0 };
+        Database::StatementID select_all_items { 0 };
+        Database::StatementID begin_transaction { 0 };
+        Database::StatementID commit_transaction { 0 };
+    };
+
+    class TransientStorage {
+    public:
+        using Items = OrderedHashMap<String, String>;
+
+        // A removed item is recorded with an empty value.
+        using DirtyItems = HashMap<StorageItemKey, Optional<String>>;
+
+        void set_items(HashMap<String, Items>);
+
+        Items get_items(String const& storage_key) const;
+        void set_item(String const& storage_key, String const& key, String const& value);
+        void remove_item(String const& storage_key, String const& key);
+        void clear(String const& storage_key);
+
+        bool has_dirty_items() const { return !m_dirty_items.is_empty() || !m_cleared_storage_keys.is_empty(); }
+        auto take_dirty_items() { return move(m_dirty_items); }
+        auto take_cleared_storage_keys() { return move(m_cleared_storage_keys); }
+
+    private:
+        HashMap<String, Items> m_items;
+
+        DirtyItems m_dirty_items;
+        Vector<String> m_cleared_storage_keys;
+    };
+
+    struct PersistedStorage {
+        void synchronize(Vector<String> const& cleared_storage_keys, TransientStorage::DirtyItems const& dirty_items);
+        HashMap<String, TransientStorage::Items> select_all_items();
+
+        Database& database;
+        Statements statements;
+        RefPtr<Core::Timer> synchronization_timer {};
+    };
+
+public:
+    static ErrorOr<NonnullOwnPtr<StorageJar>> create(Database&);
+    static NonnullOwnPtr<StorageJar> create();
+
+    ~StorageJar();
+
+    OrderedHashMap<String, String> get_items(String const& storage_key) const;
+    void set_item(String const& storage_key, String const& key, String const& value);
+    void remove_item(String const& storage_key, String const& key);
+    void clear(String const& storage_key);
+
+private:
+    explicit StorageJar(Optional<PersistedStorage>);
+
+    AK_MAKE_NONCOPYABLE(StorageJar);
+    AK_MAKE_NONMOVABLE(StorageJar);
+
+    void synchronize_persisted_storage();
+
+    Optional<PersistedStorage> m_persisted_storage;
+    TransientStorage m_transient_storage;
+};
+
+}
+
+template<>
+struct AK::Traits<WebView::StorageItemKey> : public AK::DefaultTraits<WebView::StorageItemKey> {
+    static unsigned hash(WebView::StorageItemKey const& key)
+    {
+        return pair_int_hash(key.storage_key.hash(), key.key.hash());
+    }
+};
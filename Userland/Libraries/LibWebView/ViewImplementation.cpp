@@ -630,6 +630,33 @@ ErrorOr<LexicalPath> ViewImplementation::dump_gc_graph()
     return path;
 }
 
+ErrorOr<LexicalPath> ViewImplementation::dump_heap_snapshot()
+{
+    LexicalPath path { Core::StandardPaths::tempfile_directory() };
+    path = path.append(TRY(Core::DateTime::now().to_string("heap-snapshot-%Y-%m-%d-%H-%M-%S.heapsnapshot"sv)));
+
+    // NOTE: WebContent writes the snapshot straight into the file, so that it never has to be held in memory as a whole.
+    auto dump_file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Write));
+    if (!client().write_heap_snapshot(page_id(), IPC::File::adopt_file(move(dump_file))))
+        return Error::from_string_literal("Unable to write heap snapshot");
+
+    return path;
+}
+
+ErrorOr<LexicalPath> ViewImplementation::dump_js_profile()
+{
+    auto promise = request_internal_page_info(PageInfoType::JSProfile);
+    auto js_profile_json = TRY(promise->await());
+
+    LexicalPath path { Core::StandardPaths::tempfile_directory() };
+    path = path.append(TRY(Core::DateTime::now().to_string("js-profile-%Y-%m-%d-%H-%M-%S.cpuprofile"sv)));
+
+    auto dump_file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Write));
+    TRY(dump_file->write_until_depleted(js_profile_json.bytes()));
+
+    return path;
+}
+
 void ViewImplementation::set_user_style_sheet(String source)
 {
     client().async_set_user_style(page_id(), move(source));
@@ -147,6 +147,8 @@ public:
     void did_receive_internal_page_info(Badge<WebContentClient>, PageInfoType, String const&);
 
     ErrorOr<LexicalPath> dump_gc_graph();
+    ErrorOr<LexicalPath> dump_heap_snapshot();
+    ErrorOr<LexicalPath> dump_js_profile();
 
     void set_user_style_sheet(String source);
     // Load Native.css as the User style sheet, which attempts to make WebView content look as close to
@@ -7,8 +7,10 @@
 #include "WebContentClient.h"
 #include "Application.h"
 #include "ViewImplementation.h"
+#include <AK/JsonValue.h>
 #include <LibWeb/Cookie/ParsedCookie.h>
 #include <LibWebView/CookieJar.h>
+#include <LibWebView/StorageJar.h>
 
 namespace WebView {
 
@@ -30,6 +32,12 @@ WebContentClient::WebContentClient(NonnullOwnPtr<Core::LocalSocket> socket, View
     m_views.set(0, &view);
 }
 
+WebContentClient::WebContentClient(NonnullOwnPtr<Core::LocalSocket> socket)
+    : IPC::ConnectionToServer<WebContentClientEndpoint, WebContentServerEndpoint>(*this, move(socket))
+{
+    s_clients.set(this);
+}
+
 WebContentClient::~WebContentClient()
 {
     s_clients.remove(this);
@@ -40,6 +48,12 @@ void WebContentClient::die()
     // Intentionally empty. Restart is handled at another level.
 }
 
+void WebContentClient::assign_view(ViewImplementation& view)
+{
+    VERIFY(m_views.is_empty());
+    m_views.set(0, &view);
+}
+
 void WebContentClient::register_view(u64 page_id, ViewImplementation& view)
 {
     VERIFY(page_id > 0);
@@ -49,12 +63,20 @@ void WebContentClient::register_view(u64 page_id, ViewImplementation& view)
 void WebContentClient::unregister_view(u64 page_id)
 {
     m_views.remove(page_id);
+    if (auto process = WebView::Application::the().find_process(m_process_handle.pid); process.has_value())
+        process->remove_memory_report(page_id);
     if (m_views.is_empty()) {
         on_web_content_process_crash = nullptr;
         async_close_server();
     }
 }
 
+void WebContentClient::request_memory_reports()
+{
+    for (auto page_id : m_views.keys())
+        async_request_memory_report(page_id);
+}
+
 void WebContentClient::did_paint(u64 page_id, Gfx::IntRect const& rect, i32 bitmap_id)
 {
     if (auto view = view_for_page_id(page_id); view.has_value())
@@ -337,6 +359,18 @@ void WebContentClient::did_take_screenshot(u64 page_id, Gfx::ShareableBitmap con
         view->did_receive_screenshot({}, screenshot);
 }
 
+void WebContentClient::did_get_memory_report(u64 page_id, String const& report)
+{
+    auto report_json = JsonValue::from_string(report);
+    if (report_json.is_error() || !report_json.value().is_object()) {
+        dbgln("Received an invalid memory report from WebContent process {}", m_process_handle.pid);
+        return;
+    }
+
+    if (auto process = WebView::Application::the().find_process(m_process_handle.pid); process.has_value())
+        process->set_memory_report(page_id, move(report_json.value().as_object()));
+}
+
 void WebContentClient::did_get_internal_page_info(u64 page_id, WebView::PageInfoType type, String const& info)
 {
     if (auto view = view_for_page_id(page_id); view.has_value())
@@ -445,6 +479,40 @@ void WebContentClient::did_update_cookie(Web::Cookie::Cookie const& cookie)
     Application::cookie_jar().update_cookie(cookie);
 }
 
+Messages::WebContentClient::DidRequestLocalStorageItemsResponse WebContentClient::did_request_local_storage_items(String const& storage_key)
+{
+    return Application::storage_jar().get_items(storage_key);
+}
+
+// Every WebContent process keeps its own copy of the localStorage items it has used, the other processes are told
+// about changes so that their copies stay up to date.
+void WebContentClient::notify_other_clients_of_local_storage_change(String const& storage_key, Optional<String> const& key, Optional<String> const& value)
+{
+    for_each_client([&](WebContentClient& client) {
+        if (&client != this)
+            client.async_local_storage_did_change(storage_key, key, value);
+        return IterationDecision::Continue;
+    });
+}
+
+void WebContentClient::did_set_local_storage_item(String const& storage_key, String const& key, String const& value)
+{
+    Application::storage_jar().set_item(storage_key, key, value);
+    notify_other_clients_of_local_storage_change(storage_key, key, value);
+}
+
+void WebContentClient::did_remove_local_storage_item(String const& storage_key, String const& key)
+{
+    Application::storage_jar().remove_item(storage_key, key);
+    notify_other_clients_of_local_storage_change(storage_key, key, {});
+}
+
+void WebContentClient::did_clear_local_storage(String const& storage_key)
+{
+    Application::storage_jar().clear(storage_key);
+    notify_other_clients_of_local_storage_change(storage_key, {}, {});
+}
+
 Messages::WebContentClient::DidRequestNewWebViewResponse WebContentClient::did_request_new_web_view(u64 page_id, Web::HTML::ActivateTab const& activate_tab, Web::HTML::WebViewHints const& hints, Optional<u64> const& page_index)
 {
     if (auto view = view_for_page_id(page_id); view.has_value()) {
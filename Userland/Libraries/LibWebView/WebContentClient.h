@@ -36,13 +36,23 @@ public:
     static size_t client_count() { return s_clients.size(); }
 
     WebContentClient(NonnullOwnPtr<Core::LocalSocket>, ViewImplementation&);
+
+    // For processes that are launched before there is a view for them, see ProcessManager. Such a client has to be
+    // given its view with assign_view() before it is used.
+    explicit WebContentClient(NonnullOwnPtr<Core::LocalSocket>);
+
     ~WebContentClient();
 
+    void assign_view(ViewImplementation&);
     void register_view(u64 page_id, ViewImplementation&);
     void unregister_view(u64 page_id);
 
+    // Asks for a new memory report of every page, which is stored with this client's process once it arrives.
+    void request_memory_reports();
+
     Function<void()> on_web_content_process_crash;
 
+    pid_t pid() const { return m_process_handle.pid; }
     void set_pid(pid_t pid) { m_process_handle.pid = pid; }
 
 private:
@@ -79,6 +89,7 @@ private:
     virtual void did_get_dom_node_html(u64 page_id, String const& html) override;
     virtual void did_take_screenshot(u64 page_id, Gfx::ShareableBitmap const& screenshot) override;
     virtual void did_get_internal_page_info(u64 page_id, PageInfoType, String const&) override;
+    virtual void did_get_memory_report(u64 page_id, String const&) override;
     virtual void did_output_js_console_message(u64 page_id, i32 message_index) override;
     virtual void did_get_js_console_messages(u64 page_id, i32 start_index, Vector<ByteString> const& message_types, Vector<ByteString> const& messages) override;
     virtual void did_change_favicon(u64 page_id, Gfx::ShareableBitmap const&) override;
@@ -93,6 +104,10 @@ private:
     virtual Messages::WebContentClient::DidRequestCookieResponse did_request_cookie(URL::URL const&, Web::Cookie::Source) override;
     virtual void did_set_cookie(URL::URL const&, Web::Cookie::ParsedCookie const&, Web::Cookie::Source) override;
     virtual void did_update_cookie(Web::Cookie::Cookie const&) override;
+    virtual Messages::WebContentClient::DidRequestLocalStorageItemsResponse did_request_local_storage_items(String const& storage_key) override;
+    virtual void did_set_local_storage_item(String const& storage_key, String const& key, String const& value) override;
+    virtual void did_remove_local_storage_item(String const& storage_key, String const& key) override;
+    virtual void did_clear_local_storage(String const& storage_key) override;
     virtual Messages::WebContentClient::DidRequestNewWebViewResponse did_request_new_web_view(u64 page_id, Web::HTML::ActivateTab const&, Web::HTML::WebViewHints const&, Optional<u64> const& page_index) override;
     virtual void did_request_activate_tab(u64 page_id) override;
     virtual void did_close_browsing_context(u64 page_id) override;
@@ -132,6 +147,8 @@ private:
 
     Optional<ViewImplementation&> view_for_page_id(u64, SourceLocation = SourceLocation::current());
 
+    void notify_other_clients_of_local_storage_change(String const& storage_key, Optional<String> const& key, Optional<String> const& value);
+
     // FIXME: Does a HashMap holding references make sense?
     HashMap<u64, ViewImplementation*> m_views;
 
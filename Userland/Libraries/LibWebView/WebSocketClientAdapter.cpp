@@ -92,6 +92,11 @@ ByteString WebSocketClientSocketAdapter::subprotocol_in_use()
     return m_websocket->subprotocol_in_use();
 }
 
+ByteString WebSocketClientSocketAdapter::extensions_in_use()
+{
+    return m_websocket->extensions_in_use();
+}
+
 void WebSocketClientSocketAdapter::send(ByteBuffer binary_or_text_message, bool is_text)
 {
     m_websocket->send(binary_or_text_message, is_text);
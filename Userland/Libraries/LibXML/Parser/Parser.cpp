@@ -70,6 +70,13 @@ size_t Parser::s_debug_indent_level { 0 };
 
 void Parser::append_node(NonnullOwnPtr<Node> node)
 {
+    // A listener builds its own tree from the events, so only the open elements are kept around.
+    if (m_listener) {
+        m_open_elements.append(move(node));
+        enter_node(*m_open_elements.last());
+        return;
+    }
+
     if (m_entered_node) {
         auto& entered_element = m_entered_node->content.get<Node::Element>();
         entered_element.children.append(move(node));
@@ -83,7 +90,8 @@ void Parser::append_node(NonnullOwnPtr<Node> node)
 void Parser::append_text(StringView text, LineTrackingLexer::Position position)
 {
     if (m_listener) {
-        m_listener->text(text);
+        if (!text.is_empty())
+            m_listener->text(text);
         return;
     }
 
@@ -155,6 +163,9 @@ void Parser::leave_node()
     }
 
     m_entered_node = m_entered_node->parent;
+
+    if (m_listener)
+        (void)m_open_elements.take_last();
 }
 
 ErrorOr<Document, ParseError> Parser::parse()
@@ -183,6 +194,7 @@ ErrorOr<void, ParseError> Parser::parse_with_listener(Listener& listener)
         m_listener->error(result.error());
     m_listener->document_end();
     m_root_node.clear();
+    m_open_elements.clear();
     return result;
 }
 
@@ -11,12 +11,38 @@
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
+#include <LibCore/System.h>
+#include <LibGfx/Painter.h>
+#include <math.h>
 
 namespace ImageDecoder {
 
 static HashMap<int, RefPtr<ConnectionFromClient>> s_connections;
 static IDAllocator s_client_ids;
 
+// Images are decoded on a pool of threads shared by all clients, so that a page with many images doesn't have them
+// wait on each other. Images the client needs right away (e.g. because they're in view) skip ahead of the others.
+static constexpr unsigned max_decode_thread_count = 8;
+static OwnPtr<Threading::ThreadPool> s_decode_pool;
+
+static Threading::ThreadPool& decode_pool()
+{
+    if (!s_decode_pool) {
+        auto thread_count = clamp(Core::System::hardware_concurrency(), 1u, max_decode_thread_count);
+        s_decode_pool = MUST(Threading::ThreadPool::create("ImageDecoder"sv, thread_count));
+    }
+    return *s_decode_pool;
+}
+
+// Animations longer than this only have their first few frames decoded up front. The client asks for the rest as the
+// animation plays, so a long GIF doesn't have to be held fully decoded in both processes.
+static constexpr u32 initial_animation_frame_count = 4;
+static constexpr u32 max_animation_frames_per_request = 16;
+
+// Still images that decode much larger than the size they are displayed at are scaled down before being sent, unless
+// the saving would be small. Decoders that can scale while decoding (like JPEG) will already have done so.
+static constexpr float max_downscale_factor = 0.75f;
+
 ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> socket)
     : IPC::ConnectionFromClient<ImageDecoderClientEndpoint, ImageDecoderServerEndpoint>(*this, move(socket), s_client_ids.allocate())
 {
@@ -30,11 +56,18 @@ void ConnectionFromClient::die()
     }
     m_pending_jobs.clear();
 
+    for (auto& [_, animation] : m_animations) {
+        if (animation->pending_job)
+            animation->pending_job->cancel();
+    }
+    m_animations.clear();
+
     auto client_id = this->client_id();
     s_connections.remove(client_id);
     s_client_ids.deallocate(client_id);
 
     if (s_connections.is_empty()) {
+        s_decode_pool = nullptr;
         Threading::quit_background_thread();
         Core::EventLoop::current().quit(0);
     }
@@ -75,9 +108,14 @@ Messages::ImageDecoderServer::ConnectNewClientsResponse ConnectionFromClient::co
     return files;
 }
 
-static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Optional<Gfx::IntSize> ideal_size, Vector<Optional<NonnullRefPtr<Gfx::Bitmap>>>& bitmaps, Vector<u32>& durations)
+// Decoding a frame can't be interrupted, but we stop between frames once the job has been canceled.
+template<typename JobType>
+static ErrorOr<void> decode_image_to_bitmaps_and_durations_with_decoder(JobType const& job, Gfx::ImageDecoder const& decoder, size_t first_frame_index, size_t frame_count, Optional<Gfx::IntSize> ideal_size, Vector<Optional<NonnullRefPtr<Gfx::Bitmap>>>& bitmaps, Vector<u32>& durations)
 {
-    for (size_t i = 0; i < decoder.frame_count(); ++i) {
+    for (size_t i = first_frame_index; i < first_frame_index + frame_count; ++i) {
+        if (job.is_canceled())
+            return Error::from_errno(ECANCELED);
+
         auto frame_or_error = decoder.frame(i, ideal_size);
         if (frame_or_error.is_error()) {
             bitmaps.append({});
@@ -88,9 +126,30 @@ static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder
             durations.append(frame.duration);
         }
     }
+    return {};
+}
+
+static ErrorOr<NonnullRefPtr<Gfx::Bitmap>> downscale_to_ideal_size(NonnullRefPtr<Gfx::Bitmap> bitmap, Gfx::IntSize ideal_size)
+{
+    if (ideal_size.is_empty())
+        return bitmap;
+
+    // Keep both dimensions at least as large as the ideal size, so the image never has to be scaled up again.
+    auto factor = max(static_cast<float>(ideal_size.width()) / bitmap->width(), static_cast<float>(ideal_size.height()) / bitmap->height());
+    if (factor > max_downscale_factor)
+        return bitmap;
+
+    Gfx::IntSize target_size {
+        max(1, static_cast<int>(ceilf(bitmap->width() * factor))),
+        max(1, static_cast<int>(ceilf(bitmap->height() * factor))),
+    };
+    auto scaled_bitmap = TRY(Gfx::Bitmap::create_shareable(bitmap->format(), bitmap->alpha_type(), target_size));
+    auto painter = Gfx::Painter::create(scaled_bitmap);
+    painter->draw_bitmap(scaled_bitmap->rect().to_type<float>(), *bitmap, bitmap->rect(), Gfx::ScalingMode::BoxSampling, 1.0f);
+    return scaled_bitmap;
 }
 
-static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type)
+static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(ConnectionFromClient::Job const& job, Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type)
 {
     auto decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() }, known_mime_type));
 
@@ -103,6 +162,7 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
     ConnectionFromClient::DecodeResult result;
     result.is_animated = decoder->is_animated();
     result.loop_count = decoder->loop_count();
+    result.frame_count = decoder->frame_count();
 
     Vector<Optional<NonnullRefPtr<Gfx::Bitmap>>> bitmaps;
 
@@ -118,35 +178,58 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
         }
     }
 
-    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, move(ideal_size), bitmaps, result.durations);
+    auto frames_to_decode = result.frame_count;
+    if (result.is_animated && frames_to_decode > initial_animation_frame_count) {
+        frames_to_decode = initial_animation_frame_count;
+        result.decoder = decoder;
+    }
+
+    TRY(decode_image_to_bitmaps_and_durations_with_decoder(job, *decoder, 0, frames_to_decode, ideal_size, bitmaps, result.durations));
 
     if (bitmaps.is_empty())
         return Error::from_string_literal("Could not decode image");
 
+    // Some decoders only learn the image's size while decoding, and would decode it at full size if we asked earlier.
+    result.natural_size = decoder->size();
+
+    if (job.is_canceled())
+        return Error::from_errno(ECANCELED);
+
+    if (ideal_size.has_value() && result.frame_count == 1 && bitmaps[0].has_value())
+        bitmaps[0] = TRY(downscale_to_ideal_size(bitmaps[0].release_value(), *ideal_size));
+
     result.bitmaps = Gfx::BitmapSequence { bitmaps };
 
     return result;
 }
 
-NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image_job(i64 image_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image_job(i64 image_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, bool is_high_priority)
 {
     return Job::construct(
-        [encoded_buffer = move(encoded_buffer), ideal_size = move(ideal_size), mime_type = move(mime_type)](auto&) -> ErrorOr<DecodeResult> {
-            return TRY(decode_image_to_details(encoded_buffer, ideal_size, mime_type));
+        decode_pool(),
+        is_high_priority ? Threading::ThreadPool::Priority::High : Threading::ThreadPool::Priority::Normal,
+        [encoded_buffer, ideal_size, mime_type = move(mime_type)](auto& job) -> ErrorOr<DecodeResult> {
+            return TRY(decode_image_to_details(job, encoded_buffer, ideal_size, mime_type));
         },
-        [strong_this = NonnullRefPtr(*this), image_id](DecodeResult result) -> ErrorOr<void> {
-            strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, result.bitmaps, result.durations, result.scale);
+        [strong_this = NonnullRefPtr(*this), image_id, encoded_buffer, ideal_size](DecodeResult result) -> ErrorOr<void> {
+            if (result.decoder) {
+                strong_this->m_animations.set(image_id, adopt_own(*new Animation { encoded_buffer, result.decoder.release_nonnull(), ideal_size, result.frame_count, nullptr }));
+            }
+            strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, result.frame_count, result.natural_size, result.bitmaps, result.durations, result.scale);
             strong_this->m_pending_jobs.remove(image_id);
             return {};
         },
         [strong_this = NonnullRefPtr(*this), image_id](Error error) -> void {
+            // A canceled job reports back on the decoding thread, and whoever canceled it has already forgotten it.
+            if (error.is_errno() && error.code() == ECANCELED)
+                return;
             if (strong_this->is_open())
                 strong_this->async_did_fail_to_decode_image(image_id, MUST(String::formatted("Decoding failed: {}", error)));
             strong_this->m_pending_jobs.remove(image_id);
         });
 }
 
-Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type)
+Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type, bool is_high_priority)
 {
     auto image_id = m_next_image_id++;
 
@@ -156,7 +239,7 @@ Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_i
         return image_id;
     }
 
-    m_pending_jobs.set(image_id, make_decode_image_job(image_id, encoded_buffer, ideal_size, mime_type));
+    m_pending_jobs.set(image_id, make_decode_image_job(image_id, encoded_buffer, ideal_size, mime_type, is_high_priority));
 
     return image_id;
 }
@@ -166,6 +249,78 @@ void ConnectionFromClient::cancel_decoding(i64 image_id)
     if (auto job = m_pending_jobs.take(image_id); job.has_value()) {
         job.value()->cancel();
     }
+    release_animation(image_id);
+}
+
+void ConnectionFromClient::request_animation_frames(i64 image_id, u32 first_frame_index, u32 count)
+{
+    auto animation = m_animations.get(image_id);
+    if (!animation.has_value()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "No animation with ID {} to decode frames from", image_id);
+        return;
+    }
+
+    auto frame_count = (*animation)->frame_count;
+    if (first_frame_index >= frame_count)
+        return;
+    count = min(min(count, max_animation_frames_per_request), frame_count - first_frame_index);
+
+    if ((*animation)->pending_job) {
+        (*animation)->queued_request = Animation::FramesRequest { first_frame_index, count };
+        return;
+    }
+    start_decoding_animation_frames(image_id, **animation, { first_frame_index, count });
+}
+
+void ConnectionFromClient::start_decoding_animation_frames(i64 image_id, Animation& animation, Animation::FramesRequest request)
+{
+    // Playback is waiting on these frames, so they go ahead of other images.
+    animation.pending_job = FramesJob::construct(
+        decode_pool(),
+        Threading::ThreadPool::Priority::High,
+        [decoder = animation.decoder, ideal_size = animation.ideal_size, first_frame_index = request.first_frame_index, count = request.count](auto& job) -> ErrorOr<FramesResult> {
+            FramesResult result;
+            Vector<Optional<NonnullRefPtr<Gfx::Bitmap>>> bitmaps;
+            TRY(decode_image_to_bitmaps_and_durations_with_decoder(job, *decoder, first_frame_index, count, ideal_size, bitmaps, result.durations));
+            result.bitmaps = Gfx::BitmapSequence { bitmaps };
+            return result;
+        },
+        [strong_this = NonnullRefPtr(*this), image_id, first_frame_index = request.first_frame_index](FramesResult result) -> ErrorOr<void> {
+            // The client may have released the animation while we were decoding.
+            if (!strong_this->m_animations.contains(image_id))
+                return {};
+            strong_this->async_did_decode_animation_frames(image_id, first_frame_index, result.bitmaps, result.durations);
+            strong_this->did_finish_decoding_animation_frames(image_id);
+            return {};
+        },
+        [strong_this = NonnullRefPtr(*this), image_id](Error error) -> void {
+            // NOTE: A canceled job may report back from the decoding thread, so it must not touch anything here.
+            if (error.is_errno() && error.code() == ECANCELED)
+                return;
+            dbgln("Failed to decode frames of animation {}: {}", image_id, error);
+            strong_this->did_finish_decoding_animation_frames(image_id);
+        });
+}
+
+void ConnectionFromClient::did_finish_decoding_animation_frames(i64 image_id)
+{
+    auto animation = m_animations.get(image_id);
+    if (!animation.has_value())
+        return;
+
+    (*animation)->pending_job = nullptr;
+    if (auto request = (*animation)->queued_request; request.has_value()) {
+        (*animation)->queued_request = {};
+        start_decoding_animation_frames(image_id, **animation, *request);
+    }
+}
+
+void ConnectionFromClient::release_animation(i64 image_id)
+{
+    if (auto animation = m_animations.take(image_id); animation.has_value()) {
+        if (auto& job = animation.value()->pending_job)
+            job->cancel();
+    }
 }
 
 }
@@ -11,6 +11,7 @@
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
 #include <LibGfx/BitmapSequence.h>
+#include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibThreading/BackgroundAction.h>
 
@@ -29,25 +30,59 @@ public:
         bool is_animated = false;
         u32 loop_count = 0;
         Gfx::FloatPoint scale { 1, 1 };
+        u32 frame_count = 0;
+        Gfx::IntSize natural_size;
+        Gfx::BitmapSequence bitmaps;
+        Vector<u32> durations;
+
+        // Set if only the first frames of an animation were decoded, so the decoder can be kept for the rest.
+        RefPtr<Gfx::ImageDecoder> decoder;
+    };
+
+    struct FramesResult {
         Gfx::BitmapSequence bitmaps;
         Vector<u32> durations;
     };
 
 private:
     using Job = Threading::BackgroundAction<DecodeResult>;
+    using FramesJob = Threading::BackgroundAction<FramesResult>;
+
+    // An animation whose frames are decoded as the client asks for them, rather than all at once.
+    struct Animation {
+        Core::AnonymousBuffer encoded_buffer;
+        NonnullRefPtr<Gfx::ImageDecoder> decoder;
+        Optional<Gfx::IntSize> ideal_size;
+        u32 frame_count { 0 };
+
+        // Decoders aren't safe to use from several threads at once, so only one job decodes frames at a time. A request
+        // that comes in meanwhile waits for it to finish, and replaces any other request that was already waiting.
+        struct FramesRequest {
+            u32 first_frame_index { 0 };
+            u32 count { 0 };
+        };
+        RefPtr<FramesJob> pending_job;
+        Optional<FramesRequest> queued_request;
+    };
 
     explicit ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket>);
 
-    virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer const&, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type) override;
+    virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer const&, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type, bool is_high_priority) override;
     virtual void cancel_decoding(i64 image_id) override;
+    virtual void request_animation_frames(i64 image_id, u32 first_frame_index, u32 count) override;
+    virtual void release_animation(i64 image_id) override;
     virtual Messages::ImageDecoderServer::ConnectNewClientsResponse connect_new_clients(size_t count) override;
 
     ErrorOr<IPC::File> connect_new_client();
 
-    NonnullRefPtr<Job> make_decode_image_job(i64 image_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type);
+    void start_decoding_animation_frames(i64 image_id, Animation&, Animation::FramesRequest);
+    void did_finish_decoding_animation_frames(i64 image_id);
+
+    NonnullRefPtr<Job> make_decode_image_job(i64 image_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, bool is_high_priority);
 
     i64 m_next_image_id { 0 };
     HashMap<i64, NonnullRefPtr<Job>> m_pending_jobs;
+    HashMap<i64, NonnullOwnPtr<Animation>> m_animations;
 };
 
 }
@@ -5,54 +5,121 @@
  */
 
 #include <AK/Badge.h>
+#include <AK/Debug.h>
 #include <AK/IDAllocator.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/Weakable.h>
 #include <LibCore/EventLoop.h>
+#include <LibCore/MappedFile.h>
+#include <LibCore/Notifier.h>
 #include <LibCore/Proxy.h>
 #include <LibCore/Socket.h>
+#include <LibCore/System.h>
+#include <LibThreading/BackgroundAction.h>
 #include <LibWebSocket/ConnectionInfo.h>
 #include <LibWebSocket/Message.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/RequestClientEndpoint.h>
+#include <RequestServer/ResponseBodyWriter.h>
+#include <arpa/inet.h>
 #include <curl/curl.h>
 #include <netdb.h>
 
 namespace RequestServer {
 
 ByteString g_default_certificate_path;
+bool g_http3_enabled;
 static HashMap<int, RefPtr<ConnectionFromClient>> s_connections;
 static IDAllocator s_client_ids;
 
+// Matches curl's default DNS cache timeout, after which anything we warmed up would have to be resolved again anyway.
+static constexpr auto preconnect_lifetime = AK::Duration::from_seconds(60);
+
+// Browsers have settled on six connections per host for HTTP/1.1. Multiplexed origins only ever need one.
+static constexpr long max_connections_per_host = 6;
+static constexpr long max_concurrent_streams_per_connection = 100;
+
+// We only keep statistics for this many of the most recently used connections.
+static constexpr size_t max_connection_statistics = 128;
+
+// https://httpwg.org/specs/rfc7540.html#StreamPriority
+static long stream_weight_for_priority(RequestPriority priority)
+{
+    switch (priority) {
+    case RequestPriority::Highest:
+        return 256;
+    case RequestPriority::High:
+        return 64;
+    case RequestPriority::Medium:
+        return 16;
+    case RequestPriority::Low:
+        return 4;
+    case RequestPriority::Lowest:
+        return 1;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 struct ConnectionFromClient::ActiveRequest {
     CURLM* multi { nullptr };
     CURL* easy { nullptr };
     i32 request_id { 0 };
-    RefPtr<Core::Notifier> notifier;
     WeakPtr<ConnectionFromClient> client;
-    int writer_fd { 0 };
+    OwnPtr<ResponseBodyWriter> body_writer;
     HTTP::HeaderMap headers;
     bool got_all_headers { false };
     size_t downloaded_so_far { 0 };
-    String url;
+    URL::URL url;
+    ByteString method;
+    HTTP::HeaderMap request_headers;
     ByteBuffer body;
 
-    ActiveRequest(ConnectionFromClient& client, CURLM* multi, CURL* easy, i32 request_id, int writer_fd)
+    UnixDateTime request_time;
+    u32 status_code { 0 };
+    ByteString cache_partition;
+    bool uses_disk_cache { false };
+    bool is_revalidating_cache_entry { false };
+    bool was_revalidated_by_server { false };
+    bool should_store_in_cache { false };
+    ByteBuffer body_for_cache;
+
+    // The stored response being revalidated. Its body stays mapped, so it can be served if the server answers with a
+    // 304, even if the entry is evicted or replaced in the meantime.
+    Optional<DiskCache::CachedResponse> revalidated_response;
+
+    // Background revalidations only update the cache. They have no client request, and so no body writer either.
+    bool is_background_revalidation { false };
+
+    curl_slist* resolve_list { nullptr };
+
+    // Body data the client had no room for yet. This never holds more than a single chunk from curl, since the
+    // transfer is paused until it has been flushed.
+    ByteBuffer pending_data;
+    bool is_paused { false };
+    Optional<CURLcode> result;
+
+    ActiveRequest(ConnectionFromClient& client, CURLM* multi, CURL* easy, i32 request_id, OwnPtr<ResponseBodyWriter> body_writer)
         : multi(multi)
         , easy(easy)
         , request_id(request_id)
         , client(client)
-        , writer_fd(writer_fd)
+        , body_writer(move(body_writer))
     {
     }
 
     ~ActiveRequest()
     {
-        MUST(Core::System::close(writer_fd));
         auto result = curl_multi_remove_handle(multi, easy);
         VERIFY(result == CURLM_OK);
         curl_easy_cleanup(easy);
+        curl_slist_free_all(resolve_list);
+
+        if (is_background_revalidation)
+            DiskCache::the()->end_background_revalidation(cache_partition, url);
     }
 
     void flush_headers_if_needed()
@@ -63,7 +130,46 @@ struct ConnectionFromClient::ActiveRequest {
         long http_status_code = 0;
         auto result = curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &http_status_code);
         VERIFY(result == CURLE_OK);
-        client->async_headers_became_available(request_id, headers, http_status_code);
+        status_code = static_cast<u32>(http_status_code);
+
+        if (uses_disk_cache) {
+            if (is_revalidating_cache_entry && status_code == 304) {
+                // The stored response is still good. Its headers and body are sent in place of this 304 once it is complete.
+                was_revalidated_by_server = true;
+                return;
+            }
+
+            should_store_in_cache = DiskCache::is_storable(method, request_headers, status_code, headers);
+            if (!should_store_in_cache && is_revalidating_cache_entry)
+                DiskCache::the()->remove(cache_partition, url);
+        }
+
+        if (!is_background_revalidation)
+            client->async_headers_became_available(request_id, headers, http_status_code);
+    }
+
+    void append_to_body_for_cache(ReadonlyBytes data)
+    {
+        if (!should_store_in_cache)
+            return;
+        if (body_for_cache.size() + data.size() > DiskCache::max_entry_size || body_for_cache.try_append(data).is_error()) {
+            should_store_in_cache = false;
+            body_for_cache.clear();
+        }
+    }
+};
+
+struct ConnectionFromClient::CachedResponseWriter {
+    i32 request_id { 0 };
+    NonnullOwnPtr<ResponseBodyWriter> body_writer;
+    NonnullOwnPtr<Core::MappedFile> body;
+    size_t written_so_far { 0 };
+
+    CachedResponseWriter(i32 request_id, NonnullOwnPtr<ResponseBodyWriter> body_writer, NonnullOwnPtr<Core::MappedFile> body)
+        : request_id(request_id)
+        , body_writer(move(body_writer))
+        , body(move(body))
+    {
     }
 };
 
@@ -86,28 +192,34 @@ size_t ConnectionFromClient::on_data_received(void* buffer, size_t size, size_t
     request->flush_headers_if_needed();
 
     size_t total_size = size * nmemb;
+    ReadonlyBytes data { buffer, total_size };
 
-    size_t remaining_length = total_size;
-    u8 const* remaining_data = static_cast<u8 const*>(buffer);
-    while (remaining_length > 0) {
-        auto result = Core::System::write(request->writer_fd, { remaining_data, remaining_length });
-        if (result.is_error()) {
-            if (result.error().code() != EAGAIN) {
-                dbgln("on_data_received: write failed: {}", result.error());
-                VERIFY_NOT_REACHED();
-            }
-            sched_yield();
-            continue;
-        }
-        auto nwritten = result.value();
-        if (nwritten == 0) {
-            dbgln("on_data_received: write returned 0");
-            VERIFY_NOT_REACHED();
-        }
-        remaining_data += nwritten;
-        remaining_length -= nwritten;
+    if (request->is_background_revalidation) {
+        request->append_to_body_for_cache(data);
+        request->downloaded_so_far += total_size;
+        return total_size;
     }
 
+    // Nothing may overtake data we are still holding on to. curl hands this chunk back to us once we unpause.
+    if (!request->pending_data.is_empty()) {
+        request->is_paused = true;
+        request->client->wait_for_client_to_make_room(*request);
+        return CURL_WRITEFUNC_PAUSE;
+    }
+
+    auto nwritten = request->body_writer->write(data);
+    if (nwritten == 0 && total_size > 0) {
+        request->is_paused = true;
+        request->client->wait_for_client_to_make_room(*request);
+        return CURL_WRITEFUNC_PAUSE;
+    }
+    if (nwritten < total_size) {
+        request->pending_data = MUST(ByteBuffer::copy(data.slice(nwritten)));
+        request->client->wait_for_client_to_make_room(*request);
+    }
+
+    request->append_to_body_for_cache(data);
+
     Optional<u64> content_length_for_ipc;
     curl_off_t content_length = -1;
     auto res = curl_easy_getinfo(request->easy, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &content_length);
@@ -189,6 +301,19 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> sock
     set_option(CURLMOPT_SOCKETDATA, this);
     set_option(CURLMOPT_TIMERFUNCTION, &on_timeout_callback);
     set_option(CURLMOPT_TIMERDATA, this);
+    set_option(CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    set_option(CURLMOPT_MAX_HOST_CONNECTIONS, max_connections_per_host);
+    set_option(CURLMOPT_MAX_CONCURRENT_STREAMS, max_concurrent_streams_per_connection);
+
+    // Share DNS results and TLS sessions between all transfers, including the connections we warm up on behalf of
+    // ensure_connection(), so that a later request to the same origin can skip the lookup and resume the TLS session.
+    m_curl_share = curl_share_init();
+    auto set_share_option = [this](auto option, auto value) {
+        auto result = curl_share_setopt(m_curl_share, option, value);
+        VERIFY(result == CURLSHE_OK);
+    };
+    set_share_option(CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    set_share_option(CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
 
     m_timer = Core::Timer::create_single_shot(0, [this] {
         int still_running = 0;
@@ -200,16 +325,35 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> sock
 
 ConnectionFromClient::~ConnectionFromClient()
 {
+    // NOTE: The share handle can only be cleaned up once no easy handle uses it anymore.
+    m_active_requests.clear();
+
+    for (auto* easy : m_preconnect_handles) {
+        auto result = curl_multi_remove_handle(m_curl_multi, easy);
+        VERIFY(result == CURLM_OK);
+        curl_easy_cleanup(easy);
+    }
+    m_preconnect_handles.clear();
+
+    auto result = curl_share_cleanup(m_curl_share);
+    VERIFY(result == CURLSHE_OK);
 }
 
 void ConnectionFromClient::die()
 {
+    dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: Pre-connect statistics: {} DNS prefetches ({} used), {} pre-connects ({} used)",
+        m_preconnect_statistics.dns_prefetches, m_preconnect_statistics.dns_prefetch_hits,
+        m_preconnect_statistics.preconnects, m_preconnect_statistics.preconnect_hits);
+
     auto client_id = this->client_id();
     s_connections.remove(client_id);
     s_client_ids.deallocate(client_id);
 
-    if (s_connections.is_empty())
+    if (s_connections.is_empty()) {
+        if (auto* disk_cache = DiskCache::the())
+            disk_cache->flush_index();
         Core::EventLoop::current().quit(0);
+    }
 }
 
 Messages::RequestServer::ConnectNewClientResponse ConnectionFromClient::connect_new_client()
@@ -239,7 +383,7 @@ Messages::RequestServer::IsSupportedProtocolResponse ConnectionFromClient::is_su
     return protocol == "http"sv || protocol == "https"sv;
 }
 
-void ConnectionFromClient::start_request(i32 request_id, ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ByteBuffer const& request_body, Core::ProxyData const& proxy_data)
+void ConnectionFromClient::start_request(i32 request_id, ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ByteBuffer const& request_body, Core::ProxyData const& proxy_data, RequestPriority const& priority, ByteString const& cache_partition)
 {
     if (!url.is_valid()) {
         dbgln("StartRequest: Invalid URL requested: '{}'", url);
@@ -253,19 +397,94 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString const& metho
         return;
     }
 
-    auto fds_or_error = Core::System::pipe2(O_NONBLOCK);
-    if (fds_or_error.is_error()) {
-        dbgln("StartRequest: Failed to create pipe: {}", fds_or_error.error());
+    auto body_writer_or_error = ResponseBodyWriter::create();
+    if (body_writer_or_error.is_error()) {
+        dbgln("StartRequest: Failed to create response body channel: {}", body_writer_or_error.error());
+        curl_easy_cleanup(easy);
         return;
     }
 
-    auto fds = fds_or_error.release_value();
-    auto writer_fd = fds[1];
-    auto reader_fd = fds[0];
-    async_request_started(request_id, IPC::File::adopt_fd(reader_fd));
+    auto body_writer = body_writer_or_error.release_value();
+    async_request_started(request_id, IPC::File::adopt_fd(body_writer->take_client_fd()), body_writer->body_buffer());
+
+    auto request_time = UnixDateTime::now();
+    auto* disk_cache = cache_partition.is_empty() ? nullptr : DiskCache::the();
+    HTTP::HeaderMap conditional_request_headers;
+    Optional<DiskCache::CachedResponse> revalidated_response;
+
+    if (disk_cache) {
+        if (auto lookup = disk_cache->lookup(method, cache_partition, url, request_headers); lookup.has_value()) {
+            // NOTE: If the stored body has gone missing, open() drops the entry, and the request goes out unconditionally.
+            if (auto cached_response = disk_cache->open(cache_partition, url); !cached_response.is_error()) {
+                switch (lookup->freshness) {
+                case DiskCache::Freshness::Fresh:
+                    curl_easy_cleanup(easy);
+                    serve_from_cache(request_id, move(body_writer), cached_response.release_value());
+                    return;
+                case DiskCache::Freshness::StaleWhileRevalidate:
+                    curl_easy_cleanup(easy);
+                    serve_from_cache(request_id, move(body_writer), cached_response.release_value());
+                    start_background_revalidation(url, request_headers, cache_partition, lookup->conditional_request_headers);
+                    return;
+                case DiskCache::Freshness::NeedsRevalidation:
+                    conditional_request_headers = move(lookup->conditional_request_headers);
+                    revalidated_response = cached_response.release_value();
+                    break;
+                }
+            }
+        }
+    }
+
+    auto request = make<ActiveRequest>(*this, m_curl_multi, easy, request_id, move(body_writer));
+    request->url = url;
+    request->method = method;
+    request->request_headers = request_headers;
+    request->request_time = request_time;
+    request->cache_partition = cache_partition;
+    request->uses_disk_cache = disk_cache != nullptr;
+    request->is_revalidating_cache_entry = revalidated_response.has_value();
+    request->revalidated_response = move(revalidated_response);
+
+    // FIXME: Set up proxy if applicable
+    (void)proxy_data;
+
+    issue_network_request(move(request), request_body, conditional_request_headers, priority);
+}
 
-    auto request = make<ActiveRequest>(*this, m_curl_multi, easy, request_id, writer_fd);
-    request->url = url.to_string().value();
+void ConnectionFromClient::start_background_revalidation(URL::URL const& url, HTTP::HeaderMap const& request_headers, ByteString const& cache_partition, HTTP::HeaderMap const& conditional_request_headers)
+{
+    auto* disk_cache = DiskCache::the();
+    if (!disk_cache->begin_background_revalidation(cache_partition, url))
+        return;
+
+    auto* easy = curl_easy_init();
+    if (!easy) {
+        dbgln("StartRequest: Failed to initialize curl easy handle for background revalidation");
+        disk_cache->end_background_revalidation(cache_partition, url);
+        return;
+    }
+
+    dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: Revalidating {} in the background", url);
+
+    // NOTE: Client request IDs count up from zero, so negative IDs can't collide with them.
+    auto request = make<ActiveRequest>(*this, m_curl_multi, easy, m_next_background_revalidation_id--, nullptr);
+    request->url = url;
+    request->method = "GET"sv;
+    request->request_headers = request_headers;
+    request->request_time = UnixDateTime::now();
+    request->cache_partition = cache_partition;
+    request->uses_disk_cache = true;
+    request->is_revalidating_cache_entry = true;
+    request->is_background_revalidation = true;
+
+    issue_network_request(move(request), {}, conditional_request_headers, RequestPriority::Lowest);
+}
+
+void ConnectionFromClient::issue_network_request(NonnullOwnPtr<ActiveRequest> request, ByteBuffer const& request_body, HTTP::HeaderMap const& conditional_request_headers, RequestPriority priority)
+{
+    auto* easy = request->easy;
+    auto const& url = request->url;
+    auto const& method = request->method;
 
     auto set_option = [easy](auto option, auto value) {
         auto result = curl_easy_setopt(easy, option, value);
@@ -277,14 +496,37 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString const& metho
     };
 
     set_option(CURLOPT_PRIVATE, request.ptr());
+    set_option(CURLOPT_SHARE, m_curl_share);
 
     if (!g_default_certificate_path.is_empty())
         set_option(CURLOPT_CAINFO, g_default_certificate_path.characters());
 
     set_option(CURLOPT_ACCEPT_ENCODING, "gzip, deflate, br");
+
+    // Prefer waiting for a multiplexed connection to the origin over opening another one, and let the server know how
+    // this request weighs against the others sharing that connection.
+    if (!g_http3_enabled || !set_option(CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_3))
+        set_option(CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+    set_option(CURLOPT_PIPEWAIT, 1L);
+    set_option(CURLOPT_STREAM_WEIGHT, stream_weight_for_priority(priority));
     set_option(CURLOPT_URL, url.to_string().value().to_byte_string().characters());
     set_option(CURLOPT_PORT, url.port_or_default());
 
+    if (auto origin_key = preconnect_key_for_url(url); origin_key.has_value()) {
+        auto now = MonotonicTime::now_coarse();
+
+        if (auto preresolved_host = m_preresolved_hosts.take(*origin_key); preresolved_host.has_value() && !preresolved_host->addresses.is_empty() && preresolved_host->expiry > now) {
+            // NOTE: The leading '+' lets the entry time out of curl's DNS cache like any other, instead of sticking around forever.
+            auto resolve_entry = ByteString::formatted("+{}:{}", *origin_key, preresolved_host->addresses);
+            request->resolve_list = curl_slist_append(nullptr, resolve_entry.characters());
+            set_option(CURLOPT_RESOLVE, request->resolve_list);
+            ++m_preconnect_statistics.dns_prefetch_hits;
+        }
+
+        if (auto preconnected_at = m_preconnected_origins.take(*origin_key); preconnected_at.has_value() && now - *preconnected_at < preconnect_lifetime)
+            ++m_preconnect_statistics.preconnect_hits;
+    }
+
     if (method == "GET"sv) {
         set_option(CURLOPT_HTTPGET, 1L);
     } else if (method.is_one_of("POST"sv, "PUT"sv, "PATCH"sv, "DELETE"sv)) {
@@ -299,15 +541,16 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString const& metho
     set_option(CURLOPT_FOLLOWLOCATION, 0);
 
     struct curl_slist* curl_headers = nullptr;
-    for (auto const& header : request_headers.headers()) {
+    for (auto const& header : request->request_headers.headers()) {
+        auto header_string = ByteString::formatted("{}: {}", header.name, header.value);
+        curl_headers = curl_slist_append(curl_headers, header_string.characters());
+    }
+    for (auto const& header : conditional_request_headers.headers()) {
         auto header_string = ByteString::formatted("{}: {}", header.name, header.value);
         curl_headers = curl_slist_append(curl_headers, header_string.characters());
     }
     set_option(CURLOPT_HTTPHEADER, curl_headers);
 
-    // FIXME: Set up proxy if applicable
-    (void)proxy_data;
-
     set_option(CURLOPT_WRITEFUNCTION, &on_data_received);
     set_option(CURLOPT_WRITEDATA, reinterpret_cast<void*>(request.ptr()));
 
@@ -317,6 +560,7 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString const& metho
     auto result = curl_multi_add_handle(m_curl_multi, easy);
     VERIFY(result == CURLM_OK);
 
+    auto request_id = request->request_id;
     m_active_requests.set(request_id, move(request));
 }
 
@@ -327,19 +571,225 @@ void ConnectionFromClient::check_active_requests()
         if (msg->msg != CURLMSG_DONE)
             continue;
 
+        if (m_preconnect_handles.remove(msg->easy_handle)) {
+            dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: Pre-connect finished: {}", curl_easy_strerror(msg->data.result));
+            auto* easy = msg->easy_handle;
+            auto result = curl_multi_remove_handle(m_curl_multi, easy);
+            VERIFY(result == CURLM_OK);
+            curl_easy_cleanup(easy);
+            continue;
+        }
+
         ActiveRequest* request = nullptr;
         auto result = curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &request);
         VERIFY(result == CURLE_OK);
         request->flush_headers_if_needed();
+        request->result = msg->data.result;
+
+        // If the client hasn't caught up with the body yet, we finish once the rest of it has been flushed.
+        if (!request->pending_data.is_empty())
+            continue;
+
+        finish_request(*request);
+    }
+}
+
+void ConnectionFromClient::finish_request(ActiveRequest& request)
+{
+    VERIFY(request.result.has_value());
+    auto success = request.result.value() == CURLE_OK;
+    auto request_id = request.request_id;
+
+    record_connection_statistics(request);
+
+    if (request.uses_disk_cache && success) {
+        auto& disk_cache = *DiskCache::the();
+        if (request.was_revalidated_by_server) {
+            disk_cache.freshen(request.cache_partition, request.url, request.headers, request.request_time, UnixDateTime::now());
+
+            // A background revalidation has nothing left to do once the entry is freshened.
+            if (request.revalidated_response.has_value()) {
+                auto cached_response = request.revalidated_response.release_value();
+                cached_response.headers = DiskCache::freshened_headers(cached_response.headers, request.headers);
+                auto body_writer = request.body_writer.release_nonnull();
+                m_active_requests.remove(request_id);
+                serve_from_cache(request_id, move(body_writer), move(cached_response));
+                return;
+            }
+        } else if (request.should_store_in_cache) {
+            disk_cache.store(request.cache_partition, request.url, request.status_code, request.headers, request.body_for_cache, request.request_time, UnixDateTime::now());
+        }
+    }
+
+    if (!request.is_background_revalidation)
+        async_request_finished(request_id, success, request.downloaded_so_far);
+
+    m_active_requests.remove(request_id);
+}
+
+void ConnectionFromClient::record_connection_statistics(ActiveRequest const& request)
+{
+    auto* easy = request.easy;
+
+    curl_off_t connection_id = -1;
+#if LIBCURL_VERSION_NUM >= 0x080200
+    (void)curl_easy_getinfo(easy, CURLINFO_CONN_ID, &connection_id);
+#endif
+
+    auto origin = request.url.serialize_origin();
+    auto key = ByteString::formatted("{}#{}", origin, connection_id);
+
+    auto& statistics = m_connection_statistics.ensure(key, [&] {
+        return ConnectionStatistics { .origin = origin, .connection_id = static_cast<i64>(connection_id) };
+    });
+
+    long http_version = 0;
+    if (curl_easy_getinfo(easy, CURLINFO_HTTP_VERSION, &http_version) == CURLE_OK)
+        statistics.http_version = http_version;
+
+    curl_off_t bytes_received = 0;
+    if (curl_easy_getinfo(easy, CURLINFO_SIZE_DOWNLOAD_T, &bytes_received) == CURLE_OK)
+        statistics.bytes_received += bytes_received;
+
+    curl_off_t bytes_sent = 0;
+    if (curl_easy_getinfo(easy, CURLINFO_SIZE_UPLOAD_T, &bytes_sent) == CURLE_OK)
+        statistics.bytes_sent += bytes_sent;
+
+    // The TCP handshake takes one round trip, so it makes for a decent estimate of the RTT. Transfers that reused the
+    // connection report no connect time at all.
+    curl_off_t name_lookup_time = 0;
+    curl_off_t connect_time = 0;
+    if (curl_easy_getinfo(easy, CURLINFO_NAMELOOKUP_TIME_T, &name_lookup_time) == CURLE_OK
+        && curl_easy_getinfo(easy, CURLINFO_CONNECT_TIME_T, &connect_time) == CURLE_OK
+        && connect_time > name_lookup_time) {
+        statistics.round_trip_time = AK::Duration::from_microseconds(connect_time - name_lookup_time);
+    }
+
+    if (request.result.value() != CURLE_OK)
+        ++statistics.failed_streams;
+    ++statistics.streams;
+    statistics.last_used = MonotonicTime::now_coarse();
+
+    if (m_connection_statistics.size() > max_connection_statistics) {
+        auto least_recently_used = m_connection_statistics.begin();
+        for (auto it = m_connection_statistics.begin(); it != m_connection_statistics.end(); ++it) {
+            if (it->value.last_used < least_recently_used->value.last_used)
+                least_recently_used = it;
+        }
+        m_connection_statistics.remove(least_recently_used);
+    }
+}
 
-        async_request_finished(request->request_id, msg->data.result == CURLE_OK, request->downloaded_so_far);
+Messages::RequestServer::ConnectionStatisticsResponse ConnectionFromClient::connection_statistics()
+{
+    auto http_version_string = [](long http_version) {
+        switch (http_version) {
+        case CURL_HTTP_VERSION_1_0:
+            return "HTTP/1.0"sv;
+        case CURL_HTTP_VERSION_1_1:
+            return "HTTP/1.1"sv;
+        case CURL_HTTP_VERSION_2_0:
+            return "HTTP/2"sv;
+        case CURL_HTTP_VERSION_3:
+            return "HTTP/3"sv;
+        default:
+            return "unknown"sv;
+        }
+    };
 
-        m_active_requests.remove(request->request_id);
+    JsonArray connections;
+    for (auto const& [key, statistics] : m_connection_statistics) {
+        JsonObject connection;
+        connection.set("origin"sv, statistics.origin);
+        connection.set("connection_id"sv, static_cast<i64>(statistics.connection_id));
+        connection.set("http_version"sv, http_version_string(statistics.http_version));
+        connection.set("streams"sv, statistics.streams);
+        connection.set("failed_streams"sv, statistics.failed_streams);
+        connection.set("bytes_received"sv, statistics.bytes_received);
+        connection.set("bytes_sent"sv, statistics.bytes_sent);
+        connection.set("round_trip_time_us"sv, statistics.round_trip_time.to_microseconds());
+        MUST(connections.append(move(connection)));
     }
+    return connections.serialized<StringBuilder>();
+}
+
+void ConnectionFromClient::wait_for_client_to_make_room(ActiveRequest& request)
+{
+    request.body_writer->wait_until_writable([this, request_id = request.request_id] {
+        client_did_make_room(request_id);
+    });
+}
+
+void ConnectionFromClient::client_did_make_room(i32 request_id)
+{
+    auto request_or_none = m_active_requests.get(request_id);
+    if (!request_or_none.has_value())
+        return;
+    auto& request = *request_or_none.value();
+
+    if (!request.pending_data.is_empty()) {
+        auto nwritten = request.body_writer->write(request.pending_data);
+        if (nwritten < request.pending_data.size()) {
+            request.pending_data = MUST(ByteBuffer::copy(request.pending_data.bytes().slice(nwritten)));
+            wait_for_client_to_make_room(request);
+            return;
+        }
+        request.pending_data.clear();
+    }
+
+    if (request.result.has_value()) {
+        finish_request(request);
+        return;
+    }
+
+    if (request.is_paused) {
+        request.is_paused = false;
+        // NOTE: This may deliver the chunk we turned down right away, and pause the transfer again if it doesn't fit.
+        auto result = curl_easy_pause(request.easy, CURLPAUSE_CONT);
+        VERIFY(result == CURLE_OK);
+        check_active_requests();
+    }
+}
+
+void ConnectionFromClient::serve_from_cache(i32 request_id, NonnullOwnPtr<ResponseBodyWriter> body_writer, DiskCache::CachedResponse cached_response)
+{
+    async_headers_became_available(request_id, cached_response.headers, cached_response.status_code);
+
+    auto writer = make<CachedResponseWriter>(request_id, move(body_writer), move(cached_response.body));
+    m_cached_response_writers.set(request_id, move(writer));
+
+    continue_cached_response(request_id);
+}
+
+void ConnectionFromClient::continue_cached_response(i32 request_id)
+{
+    auto it = m_cached_response_writers.find(request_id);
+    if (it == m_cached_response_writers.end())
+        return;
+    auto& writer = *it->value;
+
+    auto bytes = writer.body->bytes();
+    while (writer.written_so_far < bytes.size()) {
+        auto nwritten = writer.body_writer->write(bytes.slice(writer.written_so_far));
+        if (nwritten == 0) {
+            // Pick up where we left off once the client has made room.
+            writer.body_writer->wait_until_writable([this, request_id] {
+                continue_cached_response(request_id);
+            });
+            return;
+        }
+        writer.written_so_far += nwritten;
+    }
+
+    async_request_finished(request_id, true, writer.written_so_far);
+    m_cached_response_writers.remove(it);
 }
 
 Messages::RequestServer::StopRequestResponse ConnectionFromClient::stop_request(i32 request_id)
 {
+    if (m_cached_response_writers.remove(request_id))
+        return true;
+
     auto request = m_active_requests.take(request_id);
     if (!request.has_value()) {
         dbgln("StopRequest: Request ID {} not found", request_id);
@@ -381,8 +831,109 @@ void ConnectionFromClient::ensure_connection(URL::URL const& url, ::RequestServe
         return;
     }
 
-    (void)cache_level;
-    dbgln("FIXME: EnsureConnection: Pre-connect to {}", url);
+    if (!url.scheme().is_one_of("http"sv, "https"sv))
+        return;
+
+    auto origin_key = preconnect_key_for_url(url);
+    if (!origin_key.has_value())
+        return;
+
+    auto now = MonotonicTime::now_coarse();
+
+    if (cache_level == CacheLevel::ResolveOnly) {
+        if (auto preresolved_host = m_preresolved_hosts.get(*origin_key); preresolved_host.has_value() && preresolved_host->expiry > now)
+            return;
+        // Make sure we don't start another lookup for this host while this one is still in flight.
+        m_preresolved_hosts.set(*origin_key, { {}, now + preconnect_lifetime });
+
+        ++m_preconnect_statistics.dns_prefetches;
+        auto host = MUST(url.serialized_host()).to_byte_string();
+
+        (void)Threading::BackgroundAction<ByteString>::construct(
+            [host = move(host)](auto&) -> ErrorOr<ByteString> {
+                struct addrinfo hints {};
+                hints.ai_family = AF_UNSPEC;
+                hints.ai_socktype = SOCK_STREAM;
+                auto address_info = TRY(Core::System::getaddrinfo(host.characters(), nullptr, hints));
+
+                Vector<ByteString> addresses;
+                for (auto const& address : address_info.addresses()) {
+                    char buffer[INET6_ADDRSTRLEN] {};
+                    void const* raw_address = nullptr;
+                    if (address.ai_family == AF_INET)
+                        raw_address = &reinterpret_cast<sockaddr_in const*>(address.ai_addr)->sin_addr;
+                    else if (address.ai_family == AF_INET6)
+                        raw_address = &reinterpret_cast<sockaddr_in6 const*>(address.ai_addr)->sin6_addr;
+                    if (!raw_address || !inet_ntop(address.ai_family, raw_address, buffer, sizeof(buffer)))
+                        continue;
+
+                    auto formatted = address.ai_family == AF_INET6 ? ByteString::formatted("[{}]", buffer) : ByteString { buffer };
+                    if (!addresses.contains_slow(formatted))
+                        addresses.append(move(formatted));
+                }
+
+                if (addresses.is_empty())
+                    return Error::from_string_literal("No usable addresses");
+                return ByteString::join(',', addresses);
+            },
+            [weak_this = make_weak_ptr<ConnectionFromClient>(), origin_key = *origin_key](ByteString addresses) -> ErrorOr<void> {
+                if (!weak_this)
+                    return {};
+                dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: Pre-resolved {} to {}", origin_key, addresses);
+                weak_this->m_preresolved_hosts.set(origin_key, { move(addresses), MonotonicTime::now_coarse() + preconnect_lifetime });
+                return {};
+            },
+            [](Error error) {
+                dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: Pre-resolving failed: {}", error);
+            });
+        return;
+    }
+
+    VERIFY(cache_level == CacheLevel::CreateConnection);
+
+    if (auto preconnected_at = m_preconnected_origins.get(*origin_key); preconnected_at.has_value() && now - *preconnected_at < preconnect_lifetime)
+        return;
+    m_preconnected_origins.set(*origin_key, now);
+
+    auto* easy = curl_easy_init();
+    if (!easy) {
+        dbgln("EnsureConnection: Failed to initialize curl easy handle");
+        return;
+    }
+
+    auto set_option = [easy](auto option, auto value) {
+        auto result = curl_easy_setopt(easy, option, value);
+        if (result != CURLE_OK) {
+            dbgln("EnsureConnection: Failed to set curl option: {}", curl_easy_strerror(result));
+            return false;
+        }
+        return true;
+    };
+
+    // NOTE: curl never hands a connect-only connection to another transfer, so what this really warms up is the
+    //       shared DNS cache and TLS session cache. The next request to this origin then skips the lookup and
+    //       resumes the TLS session instead of doing a full handshake.
+    if (!g_default_certificate_path.is_empty())
+        set_option(CURLOPT_CAINFO, g_default_certificate_path.characters());
+    set_option(CURLOPT_URL, url.to_string().value().to_byte_string().characters());
+    set_option(CURLOPT_PORT, url.port_or_default());
+    set_option(CURLOPT_CONNECT_ONLY, 1L);
+    set_option(CURLOPT_SHARE, m_curl_share);
+
+    auto result = curl_multi_add_handle(m_curl_multi, easy);
+    VERIFY(result == CURLM_OK);
+
+    m_preconnect_handles.set(easy);
+    ++m_preconnect_statistics.preconnects;
+}
+
+Optional<ByteString> ConnectionFromClient::preconnect_key_for_url(URL::URL const& url)
+{
+    // Hosts that are IP addresses already don't need resolving, and we don't pre-connect to those either, to keep
+    // this to the common case of subresources on other named origins.
+    if (!url.host().has<String>())
+        return {};
+    return ByteString::formatted("{}:{}", url.host().get<String>(), url.port_or_default());
 }
 
 void ConnectionFromClient::websocket_connect(i64 websocket_id, URL::URL const& url, ByteString const& origin, Vector<ByteString> const& protocols, Vector<ByteString> const& extensions, HTTP::HeaderMap const& additional_request_headers)
@@ -397,9 +948,12 @@ void ConnectionFromClient::websocket_connect(i64 websocket_id, URL::URL const& u
     connection_info.set_protocols(protocols);
     connection_info.set_extensions(extensions);
     connection_info.set_headers(additional_request_headers);
+    connection_info.set_permessage_deflate_enabled(true);
 
     auto connection = WebSocket::WebSocket::create(move(connection_info));
     connection->on_open = [this, websocket_id]() {
+        if (auto connection = m_websockets.get(websocket_id).value_or({}); connection && !connection->extensions_in_use().is_empty())
+            async_websocket_extensions(websocket_id, connection->extensions_in_use());
         async_websocket_connected(websocket_id);
     };
     connection->on_message = [this, websocket_id](auto message) {
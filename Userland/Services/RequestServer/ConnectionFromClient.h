@@ -7,8 +7,11 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/Time.h>
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibWebSocket/WebSocket.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/Forward.h>
 #include <RequestServer/RequestClientEndpoint.h>
 #include <RequestServer/RequestServerEndpoint.h>
@@ -34,10 +37,11 @@ private:
 
     virtual Messages::RequestServer::ConnectNewClientResponse connect_new_client() override;
     virtual Messages::RequestServer::IsSupportedProtocolResponse is_supported_protocol(ByteString const&) override;
-    virtual void start_request(i32 request_id, ByteString const&, URL::URL const&, HTTP::HeaderMap const&, ByteBuffer const&, Core::ProxyData const&) override;
+    virtual void start_request(i32 request_id, ByteString const&, URL::URL const&, HTTP::HeaderMap const&, ByteBuffer const&, Core::ProxyData const&, ::RequestServer::RequestPriority const&, ByteString const& cache_partition) override;
     virtual Messages::RequestServer::StopRequestResponse stop_request(i32) override;
     virtual Messages::RequestServer::SetCertificateResponse set_certificate(i32, ByteString const&, ByteString const&) override;
     virtual void ensure_connection(URL::URL const& url, ::RequestServer::CacheLevel const& cache_level) override;
+    virtual Messages::RequestServer::ConnectionStatisticsResponse connection_statistics() override;
 
     virtual void websocket_connect(i64 websocket_id, URL::URL const&, ByteString const&, Vector<ByteString> const&, Vector<ByteString> const&, HTTP::HeaderMap const&) override;
     virtual void websocket_send(i64 websocket_id, bool, ByteBuffer const&) override;
@@ -54,10 +58,58 @@ private:
     static size_t on_header_received(void* buffer, size_t size, size_t nmemb, void* user_data);
     static size_t on_data_received(void* buffer, size_t size, size_t nmemb, void* user_data);
 
+    void issue_network_request(NonnullOwnPtr<ActiveRequest>, ByteBuffer const& request_body, HTTP::HeaderMap const& conditional_request_headers, RequestPriority);
+    void start_background_revalidation(URL::URL const&, HTTP::HeaderMap const& request_headers, ByteString const& cache_partition, HTTP::HeaderMap const& conditional_request_headers);
+
     HashMap<i32, NonnullOwnPtr<ActiveRequest>> m_active_requests;
+    i32 m_next_background_revalidation_id { -1 };
+
+    struct CachedResponseWriter;
+    HashMap<i32, NonnullOwnPtr<CachedResponseWriter>> m_cached_response_writers;
+
+    void serve_from_cache(i32 request_id, NonnullOwnPtr<ResponseBodyWriter>, DiskCache::CachedResponse);
+    void continue_cached_response(i32 request_id);
 
     void check_active_requests();
+    void finish_request(ActiveRequest&);
+    void wait_for_client_to_make_room(ActiveRequest&);
+    void client_did_make_room(i32 request_id);
+
+    static Optional<ByteString> preconnect_key_for_url(URL::URL const&);
+
+    struct PreresolvedHost {
+        ByteString addresses;
+        MonotonicTime expiry;
+    };
+    HashMap<ByteString, PreresolvedHost> m_preresolved_hosts;
+    HashMap<ByteString, MonotonicTime> m_preconnected_origins;
+    HashTable<void*> m_preconnect_handles;
+
+    struct PreconnectStatistics {
+        size_t dns_prefetches { 0 };
+        size_t dns_prefetch_hits { 0 };
+        size_t preconnects { 0 };
+        size_t preconnect_hits { 0 };
+    };
+    PreconnectStatistics m_preconnect_statistics;
+
+    void record_connection_statistics(ActiveRequest const&);
+
+    struct ConnectionStatistics {
+        ByteString origin;
+        i64 connection_id { -1 };
+        long http_version { 0 };
+        size_t streams { 0 };
+        size_t failed_streams { 0 };
+        u64 bytes_received { 0 };
+        u64 bytes_sent { 0 };
+        AK::Duration round_trip_time;
+        MonotonicTime last_used { MonotonicTime::now_coarse() };
+    };
+    HashMap<ByteString, ConnectionStatistics> m_connection_statistics;
+
     void* m_curl_multi { nullptr };
+    void* m_curl_share { nullptr };
     RefPtr<Core::Timer> m_timer;
     HashMap<int, NonnullRefPtr<Core::Notifier>> m_read_notifiers;
     HashMap<int, NonnullRefPtr<Core::Notifier>> m_write_notifiers;
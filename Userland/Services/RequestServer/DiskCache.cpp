@@ -0,0 +1,556 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/GenericShorthands.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/QuickSort.h>
+#include <LibCore/DateTime.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
+#include <LibCore/System.h>
+#include <LibCore/Timer.h>
+#include <RequestServer/DiskCache.h>
+
+namespace RequestServer {
+
+static constexpr u64 index_version = 2;
+static constexpr int index_save_delay_ms = 1000;
+
+// Used when a response carries a Last-Modified date but no explicit freshness information.
+static constexpr auto max_heuristic_freshness_lifetime = AK::Duration::from_seconds(24 * 60 * 60);
+
+// NOTE: This is intentionally leaked, so that its timer doesn't outlive the event loop during static destruction.
+static DiskCache* s_disk_cache;
+
+void DiskCache::initialize(ByteString directory)
+{
+    VERIFY(!s_disk_cache);
+
+    auto disk_cache = create(directory);
+    if (disk_cache.is_error()) {
+        dbgln("DiskCache: Unable to create cache directory {}: {}", directory, disk_cache.error());
+        return;
+    }
+
+    s_disk_cache = disk_cache.release_value().leak_ptr();
+}
+
+DiskCache* DiskCache::the()
+{
+    return s_disk_cache;
+}
+
+ErrorOr<NonnullOwnPtr<DiskCache>> DiskCache::create(ByteString directory)
+{
+    TRY(Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes));
+
+    auto disk_cache = adopt_own(*new DiskCache(move(directory)));
+    if (auto result = disk_cache->load_index(); result.is_error())
+        dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: Starting with an empty cache: {}", result.error());
+    return disk_cache;
+}
+
+DiskCache::DiskCache(ByteString directory)
+    : m_directory(move(directory))
+{
+    m_index_save_timer = Core::Timer::create_single_shot(index_save_delay_ms, [this] {
+        flush_index();
+    });
+}
+
+DiskCache::~DiskCache() = default;
+
+// NOTE: Partitions are serialized origins, which never contain a space.
+static ByteString cache_key(StringView partition, URL::URL const& url)
+{
+    return ByteString::formatted("{} {}", partition, url.serialize(URL::ExcludeFragment::Yes));
+}
+
+static Optional<UnixDateTime> parse_http_date(StringView value)
+{
+    auto date_time = Core::DateTime::parse("%a, %d %b %Y %H:%M:%S %Z"sv, value);
+    if (!date_time.has_value())
+        return {};
+    return UnixDateTime::from_seconds_since_epoch(date_time->timestamp());
+}
+
+static Optional<UnixDateTime> parse_date_header(HTTP::HeaderMap const& headers, StringView name)
+{
+    auto value = headers.get(name);
+    if (!value.has_value())
+        return {};
+    return parse_http_date(*value);
+}
+
+// https://httpwg.org/specs/rfc9111.html#field.cache-control
+static HashMap<ByteString, ByteString> parse_cache_control(HTTP::HeaderMap const& headers)
+{
+    HashMap<ByteString, ByteString> directives;
+
+    auto cache_control = headers.get("Cache-Control"sv);
+    if (!cache_control.has_value())
+        return directives;
+
+    cache_control->view().for_each_split_view(',', SplitBehavior::Nothing, [&](StringView directive) {
+        directive = directive.trim_whitespace();
+        auto name = directive;
+        StringView argument;
+        if (auto equals = directive.find('='); equals.has_value()) {
+            name = directive.substring_view(0, *equals).trim_whitespace();
+            argument = directive.substring_view(*equals + 1).trim_whitespace().trim("\""sv);
+        }
+        directives.set(name.to_lowercase_string(), argument);
+    });
+    return directives;
+}
+
+static Optional<AK::Duration> parse_delta_seconds(HashMap<ByteString, ByteString> const& directives, StringView name)
+{
+    auto argument = directives.get(name);
+    if (!argument.has_value())
+        return {};
+    auto seconds = argument->to_number<i64>();
+    if (!seconds.has_value() || *seconds < 0)
+        return AK::Duration::zero();
+    return AK::Duration::from_seconds(*seconds);
+}
+
+// https://httpwg.org/specs/rfc9111.html#calculating.freshness.lifetime
+AK::Duration DiskCache::freshness_lifetime(Entry const& entry)
+{
+    auto directives = parse_cache_control(entry.headers);
+
+    // NOTE: We are a private cache, so s-maxage does not apply to us.
+    if (auto max_age = parse_delta_seconds(directives, "max-age"sv); max_age.has_value())
+        return *max_age;
+
+    auto date = parse_date_header(entry.headers, "Date"sv).value_or(entry.response_time);
+
+    if (auto expires = entry.headers.get("Expires"sv); expires.has_value()) {
+        // A cache recipient MUST interpret invalid date formats, especially the value "0", as representing a time in the past.
+        auto expiry = parse_http_date(*expires);
+        if (!expiry.has_value() || *expiry < date)
+            return AK::Duration::zero();
+        return *expiry - date;
+    }
+
+    // https://httpwg.org/specs/rfc9111.html#heuristic.freshness
+    if (auto last_modified = parse_date_header(entry.headers, "Last-Modified"sv); last_modified.has_value() && *last_modified < date) {
+        auto lifetime = AK::Duration::from_milliseconds((date - *last_modified).to_milliseconds() / 10);
+        return min(lifetime, max_heuristic_freshness_lifetime);
+    }
+
+    return AK::Duration::zero();
+}
+
+// https://httpwg.org/specs/rfc9111.html#age.calculations
+AK::Duration DiskCache::current_age(Entry const& entry)
+{
+    auto age_value = AK::Duration::zero();
+    if (auto age = entry.headers.get("Age"sv); age.has_value())
+        age_value = AK::Duration::from_seconds(age->to_number<u32>().value_or(0));
+
+    auto apparent_age = AK::Duration::zero();
+    if (auto date = parse_date_header(entry.headers, "Date"sv); date.has_value())
+        apparent_age = max(AK::Duration::zero(), entry.response_time - *date);
+
+    auto response_delay = entry.response_time - entry.request_time;
+    auto corrected_age_value = age_value + response_delay;
+    auto corrected_initial_age = max(apparent_age, corrected_age_value);
+
+    auto resident_time = UnixDateTime::now() - entry.response_time;
+    return corrected_initial_age + resident_time;
+}
+
+// https://httpwg.org/specs/rfc9111.html#constructing.responses.from.caches
+Optional<DiskCache::LookupResult> DiskCache::lookup(StringView method, StringView partition, URL::URL const& url, HTTP::HeaderMap const& request_headers)
+{
+    if (method != "GET"sv || partition.is_empty())
+        return {};
+
+    // Requests that carry their own validators or ranges are conditional already, so we let them through untouched.
+    if (request_headers.contains("If-None-Match"sv) || request_headers.contains("If-Modified-Since"sv) || request_headers.contains("Range"sv))
+        return {};
+
+    auto request_directives = parse_cache_control(request_headers);
+    if (request_directives.contains("no-store"sv))
+        return {};
+
+    auto key = cache_key(partition, url);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: Miss for {}", key);
+        return {};
+    }
+
+    auto& entry = it->value;
+    LookupResult result { Freshness::Fresh, {} };
+
+    auto response_directives = parse_cache_control(entry.headers);
+    auto lifetime = freshness_lifetime(entry);
+    auto age = current_age(entry);
+    auto is_fresh = lifetime > age;
+    auto must_revalidate = response_directives.contains("no-cache"sv)
+        || request_directives.contains("no-cache"sv)
+        || request_headers.get("Pragma"sv).value_or({}).contains("no-cache"sv, CaseSensitivity::CaseInsensitive);
+
+    if (auto max_age = parse_delta_seconds(request_directives, "max-age"sv); max_age.has_value() && age > *max_age)
+        must_revalidate = true;
+
+    if (!is_fresh || must_revalidate) {
+        // https://httpwg.org/specs/rfc9111.html#validation.sent
+        auto etag = entry.headers.get("ETag"sv);
+        auto last_modified = entry.headers.get("Last-Modified"sv);
+        if (!etag.has_value() && !last_modified.has_value()) {
+            dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: Stale entry without validators for {}", key);
+            remove_entry(key);
+            return {};
+        }
+
+        // A stale response may still be served while it is revalidated in the background, for as long as the server
+        // allows. must-revalidate forbids reusing a stale response without validating it first.
+        result.freshness = Freshness::NeedsRevalidation;
+        if (!must_revalidate && !response_directives.contains("must-revalidate"sv)) {
+            if (auto stale_while_revalidate = parse_delta_seconds(response_directives, "stale-while-revalidate"sv); stale_while_revalidate.has_value() && lifetime + *stale_while_revalidate > age)
+                result.freshness = Freshness::StaleWhileRevalidate;
+        }
+
+        if (etag.has_value())
+            result.conditional_request_headers.set("If-None-Match", *etag);
+        if (last_modified.has_value())
+            result.conditional_request_headers.set("If-Modified-Since", *last_modified);
+    }
+
+    dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: {} for {}", result.freshness == Freshness::NeedsRevalidation ? "Revalidating"sv : "Hit"sv, key);
+    return result;
+}
+
+ErrorOr<DiskCache::CachedResponse> DiskCache::open(StringView partition, URL::URL const& url)
+{
+    auto key = cache_key(partition, url);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return Error::from_string_literal("No such cache entry");
+
+    auto& entry = it->value;
+    auto body_or_error = Core::MappedFile::map(body_path(entry.id));
+    if (body_or_error.is_error() || body_or_error.value()->bytes().size() != entry.body_size) {
+        remove_entry(key);
+        return Error::from_string_literal("Cache entry body is missing or truncated");
+    }
+
+    entry.last_access_time = UnixDateTime::now();
+    schedule_index_save();
+
+    return CachedResponse { entry.status_code, entry.headers, body_or_error.release_value() };
+}
+
+// https://httpwg.org/specs/rfc9111.html#response.cacheability
+bool DiskCache::is_storable(StringView method, HTTP::HeaderMap const& request_headers, u32 status_code, HTTP::HeaderMap const& response_headers)
+{
+    // A cache MUST NOT store a response to a request unless:
+
+    // - the request method is understood by the cache;
+    if (method != "GET"sv)
+        return false;
+
+    // - the response status code is final, and understood by the cache;
+    // NOTE: We only store status codes that are heuristically cacheable and complete, so partial content is never stored.
+    if (!first_is_one_of(status_code, 200u, 203u, 204u, 300u, 301u, 308u, 404u, 405u, 410u, 414u, 501u))
+        return false;
+
+    // - the no-store cache directive is not present in the request or the response;
+    auto request_directives = parse_cache_control(request_headers);
+    auto response_directives = parse_cache_control(response_headers);
+    if (request_directives.contains("no-store"sv) || response_directives.contains("no-store"sv))
+        return false;
+
+    // AD-HOC: We only ever send the same Accept-Encoding, so that is the only Vary we can match up with the request.
+    if (auto vary = response_headers.get("Vary"sv); vary.has_value()) {
+        auto varies_on_anything_else = false;
+        vary->view().for_each_split_view(',', SplitBehavior::Nothing, [&](StringView field) {
+            if (!field.trim_whitespace().equals_ignoring_ascii_case("Accept-Encoding"sv))
+                varies_on_anything_else = true;
+        });
+        if (varies_on_anything_else)
+            return false;
+    }
+
+    // - the response contains at least one of: a public or private directive, an Expires header field, a max-age
+    //   directive, or a status code that is heuristically cacheable. We additionally require something to either
+    //   compute freshness from or to revalidate with, since the entry would be useless otherwise.
+    return response_directives.contains("max-age"sv)
+        || response_headers.contains("Expires"sv)
+        || response_headers.contains("ETag"sv)
+        || response_headers.contains("Last-Modified"sv);
+}
+
+// https://httpwg.org/specs/rfc9111.html#storing.fields
+static HTTP::HeaderMap headers_for_storage(HTTP::HeaderMap const& response_headers)
+{
+    HTTP::HeaderMap headers;
+    for (auto const& header : response_headers.headers()) {
+        if (header.name.is_one_of_ignoring_ascii_case(
+                "Connection"sv,
+                "Proxy-Connection"sv,
+                "Keep-Alive"sv,
+                "TE"sv,
+                "Transfer-Encoding"sv,
+                "Upgrade"sv,
+                "Set-Cookie"sv)) {
+            continue;
+        }
+        headers.set(header.name, header.value);
+    }
+    return headers;
+}
+
+void DiskCache::store(StringView partition, URL::URL const& url, u32 status_code, HTTP::HeaderMap const& response_headers, ReadonlyBytes body, UnixDateTime request_time, UnixDateTime response_time)
+{
+    if (body.size() > max_entry_size || partition.is_empty())
+        return;
+
+    auto key = cache_key(partition, url);
+    remove_entry(key);
+
+    Entry entry;
+    entry.id = m_next_entry_id++;
+    entry.status_code = status_code;
+    entry.headers = headers_for_storage(response_headers);
+    entry.body_size = body.size();
+    entry.request_time = request_time;
+    entry.response_time = response_time;
+    entry.last_access_time = response_time;
+
+    auto write_body = [&]() -> ErrorOr<void> {
+        auto file = TRY(Core::File::open(body_path(entry.id), Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(file->write_until_depleted(body));
+        return {};
+    };
+    if (auto result = write_body(); result.is_error()) {
+        dbgln("DiskCache: Unable to store response body for {}: {}", key, result.error());
+        (void)Core::System::unlink(body_path(entry.id));
+        return;
+    }
+
+    dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: Stored {} ({} bytes)", key, body.size());
+
+    m_total_size += entry.body_size;
+    m_entries.set(move(key), move(entry));
+
+    evict_if_needed();
+    schedule_index_save();
+}
+
+HTTP::HeaderMap DiskCache::freshened_headers(HTTP::HeaderMap const& stored_headers, HTTP::HeaderMap const& response_headers)
+{
+    // The cache MUST update its header fields with the header fields provided in the 304 (Not Modified) response.
+    // Content-Length is left alone, as it describes the stored body rather than the empty 304 one.
+    auto updated_headers = headers_for_storage(response_headers);
+
+    HTTP::HeaderMap headers;
+    for (auto const& header : stored_headers.headers()) {
+        if (!updated_headers.contains(header.name) || header.name.equals_ignoring_ascii_case("Content-Length"sv))
+            headers.set(header.name, header.value);
+    }
+    for (auto const& header : updated_headers.headers()) {
+        if (!header.name.equals_ignoring_ascii_case("Content-Length"sv))
+            headers.set(header.name, header.value);
+    }
+    return headers;
+}
+
+void DiskCache::freshen(StringView partition, URL::URL const& url, HTTP::HeaderMap const& response_headers, UnixDateTime request_time, UnixDateTime response_time)
+{
+    auto it = m_entries.find(cache_key(partition, url));
+    if (it == m_entries.end())
+        return;
+
+    auto& entry = it->value;
+    entry.headers = freshened_headers(entry.headers, response_headers);
+    entry.request_time = request_time;
+    entry.response_time = response_time;
+    entry.last_access_time = response_time;
+    schedule_index_save();
+}
+
+void DiskCache::remove(StringView partition, URL::URL const& url)
+{
+    remove_entry(cache_key(partition, url));
+}
+
+bool DiskCache::begin_background_revalidation(StringView partition, URL::URL const& url)
+{
+    return m_background_revalidations.set(cache_key(partition, url)) == AK::HashSetResult::InsertedNewEntry;
+}
+
+void DiskCache::end_background_revalidation(StringView partition, URL::URL const& url)
+{
+    m_background_revalidations.remove(cache_key(partition, url));
+}
+
+void DiskCache::remove_entry(ByteString const& key)
+{
+    auto entry = m_entries.take(key);
+    if (!entry.has_value())
+        return;
+
+    m_total_size -= entry->body_size;
+    (void)Core::System::unlink(body_path(entry->id));
+    schedule_index_save();
+}
+
+void DiskCache::evict_if_needed()
+{
+    if (m_total_size <= m_size_limit)
+        return;
+
+    // Evict the least recently used entries until we are comfortably below the limit again, so that we don't end up
+    // evicting a single entry for every response we store from here on.
+    Vector<ByteString> keys;
+    keys.ensure_capacity(m_entries.size());
+    for (auto const& it : m_entries)
+        keys.append(it.key);
+
+    quick_sort(keys, [&](auto const& a, auto const& b) {
+        return m_entries.get(a)->last_access_time < m_entries.get(b)->last_access_time;
+    });
+
+    auto target_size = m_size_limit - m_size_limit / 10;
+    for (auto const& key : keys) {
+        if (m_total_size <= target_size)
+            break;
+        dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: Evicting {}", key);
+        remove_entry(key);
+    }
+}
+
+ByteString DiskCache::body_path(u64 id) const
+{
+    return ByteString::formatted("{}/{:016x}", m_directory, id);
+}
+
+void DiskCache::schedule_index_save()
+{
+    if (!m_index_save_timer->is_active())
+        m_index_save_timer->start();
+}
+
+void DiskCache::flush_index()
+{
+    m_index_save_timer->stop();
+    if (auto result = save_index(); result.is_error())
+        dbgln("DiskCache: Unable to save cache index: {}", result.error());
+}
+
+ErrorOr<void> DiskCache::load_index()
+{
+    auto file = TRY(Core::File::open(ByteString::formatted("{}/index.json", m_directory), Core::File::OpenMode::Read));
+    auto contents = TRY(file->read_until_eof());
+    auto json = TRY(JsonValue::from_string(StringView { contents }));
+    if (!json.is_object())
+        return Error::from_string_literal("Cache index is not an object");
+
+    auto const& index = json.as_object();
+    if (index.get_u64("version"sv) != index_version)
+        return Error::from_string_literal("Cache index has an unsupported version");
+
+    m_next_entry_id = index.get_u64("next_id"sv).value_or(1);
+
+    auto entries = index.get_array("entries"sv);
+    if (!entries.has_value())
+        return {};
+
+    for (auto const& value : entries->values()) {
+        if (!value.is_object())
+            continue;
+        auto const& object = value.as_object();
+
+        auto key = object.get_byte_string("key"sv);
+        auto id = object.get_u64("id"sv);
+        auto status_code = object.get_u32("status"sv);
+        auto body_size = object.get_u64("body_size"sv);
+        auto headers = object.get_array("headers"sv);
+        if (!key.has_value() || !id.has_value() || !status_code.has_value() || !body_size.has_value() || !headers.has_value())
+            continue;
+
+        auto stat = Core::System::stat(body_path(*id));
+        if (stat.is_error() || static_cast<u64>(stat.value().st_size) != *body_size)
+            continue;
+
+        Entry entry;
+        entry.id = *id;
+        entry.status_code = *status_code;
+        entry.body_size = *body_size;
+        entry.request_time = UnixDateTime::from_seconds_since_epoch(object.get_i64("request_time"sv).value_or(0));
+        entry.response_time = UnixDateTime::from_seconds_since_epoch(object.get_i64("response_time"sv).value_or(0));
+        entry.last_access_time = UnixDateTime::from_seconds_since_epoch(object.get_i64("last_access_time"sv).value_or(0));
+
+        for (auto const& header : headers->values()) {
+            if (!header.is_array() || header.as_array().size() != 2)
+                continue;
+            auto const& name = header.as_array().at(0);
+            auto const& value = header.as_array().at(1);
+            if (name.is_string() && value.is_string())
+                entry.headers.set(name.as_string(), value.as_string());
+        }
+
+        m_next_entry_id = max(m_next_entry_id, entry.id + 1);
+        m_total_size += entry.body_size;
+        m_entries.set(key.release_value(), move(entry));
+    }
+
+    dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: Loaded {} entries ({} bytes) from {}", m_entries.size(), m_total_size, m_directory);
+    evict_if_needed();
+    return {};
+}
+
+ErrorOr<void> DiskCache::save_index()
+{
+    JsonArray entries;
+    for (auto const& [key, entry] : m_entries) {
+        JsonArray headers;
+        for (auto const& header : entry.headers.headers()) {
+            JsonArray pair;
+            TRY(pair.append(header.name));
+            TRY(pair.append(header.value));
+            TRY(headers.append(move(pair)));
+        }
+
+        JsonObject object;
+        object.set("key"sv, key);
+        object.set("id"sv, entry.id);
+        object.set("status"sv, entry.status_code);
+        object.set("body_size"sv, entry.body_size);
+        object.set("request_time"sv, entry.request_time.seconds_since_epoch());
+        object.set("response_time"sv, entry.response_time.seconds_since_epoch());
+        object.set("last_access_time"sv, entry.last_access_time.seconds_since_epoch());
+        object.set("headers"sv, move(headers));
+        TRY(entries.append(move(object)));
+    }
+
+    JsonObject index;
+    index.set("version"sv, index_version);
+    index.set("next_id"sv, m_next_entry_id);
+    index.set("entries"sv, move(entries));
+
+    // Write to a temporary file first, so that a crash halfway through doesn't leave us with a corrupt index.
+    auto index_path = ByteString::formatted("{}/index.json", m_directory);
+    auto temporary_path = ByteString::formatted("{}.tmp", index_path);
+    {
+        auto serialized_index = index.serialized<StringBuilder>();
+        auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(file->write_until_depleted(serialized_index.bytes()));
+    }
+    TRY(Core::System::rename(temporary_path, index_path));
+    return {};
+}
+
+}
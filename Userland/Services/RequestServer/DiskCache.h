@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Time.h>
+#include <LibCore/Forward.h>
+#include <LibHTTP/HeaderMap.h>
+#include <LibURL/URL.h>
+
+namespace RequestServer {
+
+// A persistent HTTP cache shared by every client of this RequestServer, following RFC 9111 as a private cache.
+// Response bodies live in one file per entry next to an index file, and are memory-mapped when served.
+// Entries are partitioned by the cache partition each request is made in, so one site can't observe another's history.
+class DiskCache {
+public:
+    static void initialize(ByteString directory);
+    static DiskCache* the();
+
+    static ErrorOr<NonnullOwnPtr<DiskCache>> create(ByteString directory);
+
+    ~DiskCache();
+
+    struct CachedResponse {
+        u32 status_code { 0 };
+        HTTP::HeaderMap headers;
+        NonnullOwnPtr<Core::MappedFile> body;
+    };
+
+    enum class Freshness {
+        Fresh,
+        // https://httpwg.org/specs/rfc5861.html#the-stale-while-revalidate-cache-control-extension
+        StaleWhileRevalidate,
+        NeedsRevalidation,
+    };
+
+    struct LookupResult {
+        Freshness freshness;
+        HTTP::HeaderMap conditional_request_headers;
+    };
+
+    // Returns whether a stored response can answer the given request outright, can answer it while being revalidated
+    // in the background, or which validators to send along with the request if it has to be revalidated first. An
+    // empty result means the request must go to the network as-is.
+    Optional<LookupResult> lookup(StringView method, StringView partition, URL::URL const&, HTTP::HeaderMap const& request_headers);
+
+    ErrorOr<CachedResponse> open(StringView partition, URL::URL const&);
+
+    static bool is_storable(StringView method, HTTP::HeaderMap const& request_headers, u32 status_code, HTTP::HeaderMap const& response_headers);
+    void store(StringView partition, URL::URL const&, u32 status_code, HTTP::HeaderMap const& response_headers, ReadonlyBytes body, UnixDateTime request_time, UnixDateTime response_time);
+
+    // https://httpwg.org/specs/rfc9111.html#freshening.responses
+    static HTTP::HeaderMap freshened_headers(HTTP::HeaderMap const& stored_headers, HTTP::HeaderMap const& response_headers);
+    void freshen(StringView partition, URL::URL const&, HTTP::HeaderMap const& response_headers, UnixDateTime request_time, UnixDateTime response_time);
+
+    void remove(StringView partition, URL::URL const&);
+
+    // Background revalidations are tracked here, so that an entry is only ever revalidated by one request at a time.
+    bool begin_background_revalidation(StringView partition, URL::URL const&);
+    void end_background_revalidation(StringView partition, URL::URL const&);
+
+    void flush_index();
+
+    static constexpr size_t max_entry_size = 8 * MiB;
+
+private:
+    struct Entry {
+        u64 id { 0 };
+        u32 status_code { 0 };
+        HTTP::HeaderMap headers;
+        u64 body_size { 0 };
+        UnixDateTime request_time;
+        UnixDateTime response_time;
+        UnixDateTime last_access_time;
+    };
+
+    explicit DiskCache(ByteString directory);
+
+    ErrorOr<void> load_index();
+    ErrorOr<void> save_index();
+    void schedule_index_save();
+
+    ByteString body_path(u64 id) const;
+    void remove_entry(ByteString const& key);
+    void evict_if_needed();
+
+    static AK::Duration freshness_lifetime(Entry const&);
+    static AK::Duration current_age(Entry const&);
+
+    ByteString m_directory;
+
+    // Keyed by the cache partition and the URL, see cache_key().
+    HashMap<ByteString, Entry> m_entries;
+    HashTable<ByteString> m_background_revalidations;
+    u64 m_next_entry_id { 1 };
+    u64 m_total_size { 0 };
+    u64 m_size_limit { 256 * MiB };
+
+    RefPtr<Core::Timer> m_index_save_timer;
+};
+
+}
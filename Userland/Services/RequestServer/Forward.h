@@ -10,6 +10,7 @@ namespace RequestServer {
 
 class ConnectionFromClient;
 class Request;
+class ResponseBodyWriter;
 class HttpRequest;
 class HttpProtocol;
 class HttpsRequest;
@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+namespace RequestServer {
+
+// How urgently the client needs a response, used to weigh streams that share a multiplexed connection.
+enum class RequestPriority {
+    Highest,
+    High,
+    Medium,
+    Low,
+    Lowest,
+};
+
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Notifier.h>
+#include <LibCore/System.h>
+#include <RequestServer/ResponseBodyWriter.h>
+#include <sys/socket.h>
+
+namespace RequestServer {
+
+// Large enough that a client keeping up with the network never has to wake us up, while bounding the shared memory
+// each in-flight request pins.
+static constexpr size_t body_buffer_capacity = 256 * KiB;
+
+ErrorOr<NonnullOwnPtr<ResponseBodyWriter>> ResponseBodyWriter::create()
+{
+    auto ring = TRY(Core::SharedByteRingBuffer::create(body_buffer_capacity));
+
+    int fds[2] {};
+    TRY(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+
+    for (auto fd : fds) {
+        auto flags = TRY(Core::System::fcntl(fd, F_GETFL));
+        TRY(Core::System::fcntl(fd, F_SETFL, flags | O_NONBLOCK));
+        TRY(Core::System::fcntl(fd, F_SETFD, FD_CLOEXEC));
+    }
+
+    return adopt_own(*new ResponseBodyWriter(fds[0], fds[1], move(ring)));
+}
+
+ResponseBodyWriter::ResponseBodyWriter(int fd, int client_fd, Core::SharedByteRingBuffer ring)
+    : m_fd(fd)
+    , m_client_fd(client_fd)
+    , m_ring(move(ring))
+{
+}
+
+ResponseBodyWriter::~ResponseBodyWriter()
+{
+    MUST(Core::System::close(m_fd));
+    if (m_client_fd != -1)
+        MUST(Core::System::close(m_client_fd));
+}
+
+size_t ResponseBodyWriter::write(ReadonlyBytes bytes)
+{
+    auto written = m_ring.write(bytes);
+    if (written == 0)
+        return 0;
+
+    // A full socket already has wakeups queued up, so there is no need to retry.
+    u8 wakeup = 0;
+    if (auto result = Core::System::send(m_fd, &wakeup, sizeof(wakeup), MSG_NOSIGNAL); result.is_error() && result.error().code() != EAGAIN)
+        dbgln_if(REQUESTSERVER_DEBUG, "ResponseBodyWriter: Unable to wake up client: {}", result.error());
+
+    return written;
+}
+
+void ResponseBodyWriter::wait_until_writable(Function<void()> on_writable)
+{
+    m_on_writable = move(on_writable);
+
+    if (!m_notifier) {
+        m_notifier = Core::Notifier::construct(m_fd, Core::Notifier::Type::Read);
+        m_notifier->on_activation = [this] {
+            did_receive_wakeup();
+        };
+    }
+    m_notifier->set_enabled(true);
+
+    m_ring.set_producer_is_waiting();
+
+    // The client may have made room before it could see that we are waiting, in which case no wakeup is coming.
+    if (m_ring.free_space() > 0) {
+        Core::deferred_invoke([weak_this = make_weak_ptr()]() {
+            if (weak_this)
+                weak_this->did_receive_wakeup();
+        });
+    }
+}
+
+void ResponseBodyWriter::did_receive_wakeup()
+{
+    u8 buffer[64];
+    while (true) {
+        auto result = Core::System::recvfrom(m_fd, buffer, sizeof(buffer), 0, nullptr, nullptr);
+        if (result.is_error() || result.value() == 0)
+            break;
+    }
+
+    if (m_ring.free_space() == 0 || !m_on_writable)
+        return;
+
+    m_notifier->set_enabled(false);
+    auto on_writable = move(m_on_writable);
+    on_writable();
+}
+
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Weakable.h>
+#include <LibCore/Forward.h>
+#include <LibCore/SharedByteRingBuffer.h>
+
+namespace RequestServer {
+
+// The producing end of a response body. The body is written into a ring buffer in shared memory, which the client
+// reads from directly. The socket between us only carries wakeups: a byte from us means there is data to read, and a
+// byte from the client means it has made room after we asked it to. The client sees EOF once we are destroyed.
+class ResponseBodyWriter : public Weakable<ResponseBodyWriter> {
+    AK_MAKE_NONCOPYABLE(ResponseBodyWriter);
+    AK_MAKE_NONMOVABLE(ResponseBodyWriter);
+
+public:
+    static ErrorOr<NonnullOwnPtr<ResponseBodyWriter>> create();
+    ~ResponseBodyWriter();
+
+    // The client's ends of the channel, to be sent along with the request_started message.
+    int take_client_fd() { return exchange(m_client_fd, -1); }
+    Core::AnonymousBuffer const& body_buffer() const { return m_ring.anonymous_buffer(); }
+
+    // Writes as much of the given data as the client has room for, without blocking.
+    size_t write(ReadonlyBytes);
+
+    // Invokes the callback once the client has made room for more data. This is never invoked synchronously.
+    void wait_until_writable(Function<void()>);
+
+private:
+    ResponseBodyWriter(int fd, int client_fd, Core::SharedByteRingBuffer);
+
+    void did_receive_wakeup();
+
+    int m_fd { -1 };
+    int m_client_fd { -1 };
+    Core::SharedByteRingBuffer m_ring;
+    RefPtr<Core::Notifier> m_notifier;
+    Function<void()> m_on_writable;
+};
+
+}
@@ -40,6 +40,12 @@ void BackingStoreManager::restart_resize_timer()
 
 void BackingStoreManager::reallocate_backing_stores(Gfx::IntSize size)
 {
+    // NOTE: The rendering thread may still be painting into the back store.
+    m_page_client.page().top_level_traversable()->wait_for_display_list_rendering();
+
+    ++m_generation;
+    m_front_store_damage_rect.clear();
+
 #ifdef AK_OS_MACOS
     if (s_browser_mach_port.has_value()) {
         auto back_iosurface = Core::IOSurfaceHandle::create(size.width(), size.height());
@@ -126,10 +132,56 @@ void BackingStoreManager::resize_backing_stores_if_needed(WindowResizingInProgre
     }
 }
 
-void BackingStoreManager::swap_back_and_front()
+size_t BackingStoreManager::shrink_backing_stores()
+{
+    if (!m_front_store || !m_back_store)
+        return 0;
+
+    auto css_pixels_viewport_rect = m_page_client.page().top_level_traversable()->viewport_rect();
+    auto viewport_size = m_page_client.page().css_to_device_rect(css_pixels_viewport_rect).size().to_type<int>();
+    if (viewport_size.is_empty() || m_front_store->size() == viewport_size || !m_front_store->size().contains(viewport_size))
+        return 0;
+
+    auto bytes_before = size_in_bytes();
+
+    m_backing_store_shrink_timer->stop();
+    resize_backing_stores_if_needed(WindowResizingInProgress::No);
+
+    auto bytes_after = size_in_bytes();
+    return bytes_before > bytes_after ? bytes_before - bytes_after : 0;
+}
+
+size_t BackingStoreManager::size_in_bytes() const
+{
+    auto store_size_in_bytes = [](OwnPtr<Web::Painting::BackingStore> const& store) -> size_t {
+        if (!store)
+            return 0;
+        return static_cast<size_t>(store->size().width()) * static_cast<size_t>(store->size().height()) * sizeof(Gfx::ARGB32);
+    };
+    return store_size_in_bytes(m_front_store) + store_size_in_bytes(m_back_store);
+}
+
+bool BackingStoreManager::copy_front_store_damage_into_back_store()
+{
+    if (!m_front_store || !m_back_store || !m_front_store_damage_rect.has_value())
+        return false;
+
+    auto& front_bitmap = m_front_store->bitmap();
+    auto& back_bitmap = m_back_store->bitmap();
+    if (front_bitmap.size() != back_bitmap.size())
+        return false;
+
+    auto rect = m_front_store_damage_rect->intersected(front_bitmap.rect());
+    for (int y = rect.top(); y < rect.bottom(); ++y)
+        memcpy(back_bitmap.scanline(y) + rect.left(), front_bitmap.scanline(y) + rect.left(), rect.width() * sizeof(Gfx::ARGB32));
+    return true;
+}
+
+void BackingStoreManager::swap_back_and_front(Gfx::IntRect const& painted_rect)
 {
     swap(m_front_store, m_back_store);
     swap(m_front_bitmap_id, m_back_bitmap_id);
+    m_front_store_damage_rect = painted_rect;
 }
 
 }
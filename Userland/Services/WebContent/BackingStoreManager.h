@@ -27,10 +27,22 @@ public:
     void reallocate_backing_stores(Gfx::IntSize);
     void restart_resize_timer();
 
+    // Shrinks backing stores that were padded while the window was being resized to the size of the viewport, without
+    // waiting for the resize to settle. Returns the number of bytes that were freed.
+    size_t shrink_backing_stores();
+
+    size_t size_in_bytes() const;
+
     Web::Painting::BackingStore* back_store() { return m_back_store.ptr(); }
     i32 front_id() const { return m_front_bitmap_id; }
 
-    void swap_back_and_front();
+    // Bumped whenever the backing stores are reallocated, so frames that were started before can be recognized.
+    u64 generation() const { return m_generation; }
+
+    // The back store still holds the frame before the front one. This copies over what changed between the two, so
+    // the back store only has to be repainted where it's damaged. Returns false if its contents can't be reused.
+    bool copy_front_store_damage_into_back_store();
+    void swap_back_and_front(Gfx::IntRect const& painted_rect);
 
     BackingStoreManager(PageClient&);
 
@@ -42,7 +54,9 @@ private:
     i32 m_back_bitmap_id { -1 };
     OwnPtr<Web::Painting::BackingStore> m_front_store;
     OwnPtr<Web::Painting::BackingStore> m_back_store;
+    Optional<Gfx::IntRect> m_front_store_damage_rect;
     int m_next_bitmap_id { 0 };
+    u64 m_generation { 0 };
 
     RefPtr<Core::Timer> m_backing_store_shrink_timer;
 };
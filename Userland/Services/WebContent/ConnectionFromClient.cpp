@@ -9,14 +9,19 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <AK/JsonObject.h>
+#include <AK/NumberFormat.h>
 #include <AK/QuickSort.h>
+#include <LibCore/File.h>
+#include <LibCore/Tracing.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/SystemTheme.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibJS/Runtime/Date.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibUnicode/TimeZone.h>
 #include <LibWeb/ARIA/RoleType.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
@@ -41,6 +46,8 @@
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Loader/UserAgent.h>
 #include <LibWeb/Namespace.h>
+#include <LibWeb/Page/MemoryPressure.h>
+#include <LibWeb/Page/MemoryReport.h>
 #include <LibWeb/Painting/StackingContext.h>
 #include <LibWeb/Painting/ViewportPaintable.h>
 #include <LibWeb/PermissionsPolicy/AutoplayAllowlist.h>
@@ -219,6 +226,9 @@ void ConnectionFromClient::process_next_input_event()
         report_finished_handling_input_event(event.page_id, Web::EventResult::Dropped);
     report_finished_handling_input_event(event.page_id, result);
 
+    if (auto const* mouse_event = event.event.get_pointer<Web::MouseEvent>(); mouse_event && mouse_event->type == Web::MouseEvent::Type::MouseWheel && result == Web::EventResult::Handled)
+        page->paint_next_frame_if_only_scrolled();
+
     if (!m_input_event_queue.is_empty())
         m_input_event_queue_timer->start();
 }
@@ -358,6 +368,23 @@ void ConnectionFromClient::debug_request(u64 page_id, ByteString const& request,
         return;
     }
 
+    if (request == "trace-categories") {
+        if (auto categories = Core::Tracing::parse_categories(argument); categories.has_value())
+            Core::Tracing::set_enabled_categories(*categories);
+        else
+            dbgln("Unknown trace categories: {}", argument);
+        return;
+    }
+
+    if (request == "js-profiling") {
+        auto& vm = Web::Bindings::main_thread_vm();
+        if (argument == "on")
+            vm.start_sampling_profiler();
+        else
+            vm.stop_sampling_profiler();
+        return;
+    }
+
     if (request == "set-line-box-borders") {
         bool state = argument == "on";
         page->set_should_show_line_box_borders(state);
@@ -905,6 +932,27 @@ static void append_gc_graph(StringBuilder& builder)
     gc_graph.serialize(builder);
 }
 
+static void append_gc_statistics(StringBuilder& builder)
+{
+    auto gc_statistics = Web::Bindings::main_thread_vm().heap().dump_statistics();
+    gc_statistics.serialize(builder);
+}
+
+static void append_js_profile(StringBuilder& builder)
+{
+    auto* profiler = Web::Bindings::main_thread_vm().sampling_profiler();
+    if (!profiler) {
+        builder.append("(no JS profile, enable it with the \"js-profiling\" debug request)"sv);
+        return;
+    }
+    profiler->to_cpuprofile_json().serialize(builder);
+}
+
+static void append_trace(StringBuilder& builder)
+{
+    Core::Tracing::to_chrome_trace_events(Core::Tracing::take_events()).serialize(builder);
+}
+
 void ConnectionFromClient::request_internal_page_info(u64 page_id, WebView::PageInfoType type)
 {
     auto page = this->page(page_id);
@@ -937,9 +985,61 @@ void ConnectionFromClient::request_internal_page_info(u64 page_id, WebView::Page
         append_gc_graph(builder);
     }
 
+    if (has_flag(type, WebView::PageInfoType::GCStatistics)) {
+        if (!builder.is_empty())
+            builder.append("\n"sv);
+        append_gc_statistics(builder);
+    }
+
+    if (has_flag(type, WebView::PageInfoType::JSProfile)) {
+        if (!builder.is_empty())
+            builder.append("\n"sv);
+        append_js_profile(builder);
+    }
+
+    if (has_flag(type, WebView::PageInfoType::Trace)) {
+        if (!builder.is_empty())
+            builder.append("\n"sv);
+        append_trace(builder);
+    }
+
     async_did_get_internal_page_info(page_id, type, MUST(builder.to_string()));
 }
 
+Messages::WebContentServer::WriteHeapSnapshotResponse ConnectionFromClient::write_heap_snapshot(u64, IPC::File const& file)
+{
+    auto result = [&]() -> ErrorOr<void> {
+        auto snapshot_file = TRY(Core::File::adopt_fd(file.take_fd(), Core::File::OpenMode::Write));
+        return Web::Bindings::main_thread_vm().heap().write_heap_snapshot(*snapshot_file);
+    }();
+
+    if (result.is_error()) {
+        dbgln("Unable to write heap snapshot: {}", result.error());
+        return false;
+    }
+    return true;
+}
+
+void ConnectionFromClient::request_memory_report(u64 page_id)
+{
+    auto page = this->page(page_id);
+    if (!page.has_value())
+        return;
+
+    auto report = Web::memory_report(page->page());
+
+    // The backing stores belong to WebContent rather than to LibWeb, so they're added here.
+    auto page_report = report.get_object("page"sv).release_value();
+    JsonObject backing_stores;
+    backing_stores.set("bytes"sv, page->backing_store_size_in_bytes());
+    page_report.set("backing_stores"sv, move(backing_stores));
+    report.set("page"sv, move(page_report));
+
+    StringBuilder builder;
+    report.serialize(builder);
+    async_did_get_memory_report(page_id, MUST(builder.to_string()));
+}
+
 Messages::WebContentServer::GetSelectedTextResponse ConnectionFromClient::get_selected_text(u64 page_id)
 {
     if (auto page = this->page(page_id); page.has_value())
@@ -1106,6 +1206,11 @@ Messages::WebContentServer::GetSessionStorageEntriesResponse ConnectionFromClien
     return session_storage->map();
 }
 
+void ConnectionFromClient::local_storage_did_change(String const& storage_key, Optional<String> const& key, Optional<String> const& value)
+{
+    Web::HTML::Storage::did_change_in_another_process(storage_key, key, value);
+}
+
 void ConnectionFromClient::handle_file_return(u64, i32 error, Optional<IPC::File> const& file, i32 request_id)
 {
     auto file_request = m_requested_files.take(request_id);
@@ -1128,12 +1233,8 @@ void ConnectionFromClient::request_file(u64 page_id, Web::FileRequest file_reque
 
 void ConnectionFromClient::set_system_visibility_state(u64 page_id, bool visible)
 {
-    if (auto page = this->page(page_id); page.has_value()) {
-        page->page().top_level_traversable()->set_system_visibility_state(
-            visible
-                ? Web::HTML::VisibilityState::Visible
-                : Web::HTML::VisibilityState::Hidden);
-    }
+    if (auto page = this->page(page_id); page.has_value())
+        page->set_system_visibility_state(visible ? Web::HTML::VisibilityState::Visible : Web::HTML::VisibilityState::Hidden);
 }
 
 void ConnectionFromClient::js_console_input(u64 page_id, ByteString const& js_source)
@@ -1240,4 +1341,24 @@ void ConnectionFromClient::system_time_zone_changed()
     Unicode::clear_system_time_zone_cache();
 }
 
+void ConnectionFromClient::handle_memory_pressure()
+{
+    reclaim_memory();
+}
+
+void ConnectionFromClient::reclaim_memory()
+{
+    size_t backing_store_bytes = 0;
+    m_page_host->for_each_page([&](PageClient& page) {
+        backing_store_bytes += page.shrink_backing_stores();
+    });
+
+    auto report = Web::handle_memory_pressure();
+    report.entries.append({ "Backing stores"sv, backing_store_bytes });
+
+    dbgln_if(MEMORY_PRESSURE_DEBUG, "Reclaimed {} under memory pressure:", human_readable_size(report.total_bytes_reclaimed()));
+    for (auto const& entry : report.entries)
+        dbgln_if(MEMORY_PRESSURE_DEBUG, "    {}: {}", entry.subsystem, human_readable_size(entry.bytes_reclaimed));
+}
+
 }
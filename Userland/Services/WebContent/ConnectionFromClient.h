@@ -49,6 +49,9 @@ public:
 
     Function<void(IPC::File const&)> on_image_decoder_connection;
 
+    // Drops whatever memory can be recreated later, because the system is running low or we're over our budget.
+    void reclaim_memory();
+
 private:
     explicit ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket>);
 
@@ -134,9 +137,12 @@ private:
     virtual void take_dom_node_screenshot(u64 page_id, i32 node_id) override;
 
     virtual void request_internal_page_info(u64 page_id, WebView::PageInfoType) override;
+    virtual Messages::WebContentServer::WriteHeapSnapshotResponse write_heap_snapshot(u64 page_id, IPC::File const&) override;
+    virtual void request_memory_report(u64 page_id) override;
 
     virtual Messages::WebContentServer::GetLocalStorageEntriesResponse get_local_storage_entries(u64 page_id) override;
     virtual Messages::WebContentServer::GetSessionStorageEntriesResponse get_session_storage_entries(u64 page_id) override;
+    virtual void local_storage_did_change(String const& storage_key, Optional<String> const& key, Optional<String> const& value) override;
 
     virtual Messages::WebContentServer::GetSelectedTextResponse get_selected_text(u64 page_id) override;
     virtual void select_all(u64 page_id) override;
@@ -149,6 +155,8 @@ private:
 
     virtual void system_time_zone_changed() override;
 
+    virtual void handle_memory_pressure() override;
+
     void report_finished_handling_input_event(u64 page_id, Web::EventResult event_was_handled);
 
     NonnullOwnPtr<PageHost> m_page_host;
@@ -13,7 +13,7 @@ namespace WebContent {
 ImageCodecPluginSerenity::ImageCodecPluginSerenity() = default;
 ImageCodecPluginSerenity::~ImageCodecPluginSerenity() = default;
 
-NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPluginSerenity::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPluginSerenity::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, bool is_high_priority)
 {
     if (!m_client) {
         m_client = ImageDecoderClient::Client::try_create().release_value_but_fixme_should_propagate_errors();
@@ -33,8 +33,11 @@ NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPluginSereni
         [promise](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
             // FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
             Web::Platform::DecodedImage decoded_image;
+            decoded_image.image_id = result.image_id;
             decoded_image.is_animated = result.is_animated;
             decoded_image.loop_count = result.loop_count;
+            decoded_image.frame_count = result.frame_count;
+            decoded_image.natural_size = result.natural_size;
             for (auto const& frame : result.frames) {
                 decoded_image.frames.empend(move(frame.bitmap), frame.duration);
             }
@@ -43,9 +46,34 @@ NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPluginSereni
         },
         [promise](auto& error) {
             promise->reject(Error::copy(error));
-        });
+        },
+        ideal_size, {}, is_high_priority);
 
     return promise;
 }
 
+void ImageCodecPluginSerenity::request_animation_frames(i64 image_id, size_t first_frame_index, size_t count, AnimationFramesCallback on_decoded)
+{
+    if (!m_client)
+        return;
+
+    m_client->request_animation_frames(image_id, first_frame_index, count, [on_decoded = move(on_decoded)](u32 first_frame_index, Vector<Optional<ImageDecoderClient::Frame>> result) {
+        Vector<Web::Platform::Frame> frames;
+        frames.ensure_capacity(result.size());
+        for (auto& frame : result) {
+            if (frame.has_value())
+                frames.unchecked_append({ move(frame->bitmap), frame->duration });
+            else
+                frames.unchecked_append({});
+        }
+        on_decoded(first_frame_index, move(frames));
+    });
+}
+
+void ImageCodecPluginSerenity::release_animation(i64 image_id)
+{
+    if (m_client)
+        m_client->release_animation(image_id);
+}
+
 }
@@ -21,7 +21,9 @@ public:
     ImageCodecPluginSerenity();
     virtual ~ImageCodecPluginSerenity() override;
 
-    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) override;
+    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, bool is_high_priority = false) override;
+    virtual void request_animation_frames(i64 image_id, size_t first_frame_index, size_t count, AnimationFramesCallback on_decoded) override;
+    virtual void release_animation(i64 image_id) override;
 
 private:
     RefPtr<ImageDecoderClient::Client> m_client;
@@ -86,7 +86,20 @@ ConnectionFromClient& PageClient::client() const
 
 void PageClient::set_has_focus(bool has_focus)
 {
+    if (m_has_focus == has_focus)
+        return;
     m_has_focus = has_focus;
+    if (page().top_level_traversable_is_initialized())
+        page().top_level_traversable()->set_needs_display(Web::InvalidateDisplayList::No);
+}
+
+void PageClient::set_should_show_line_box_borders(bool should_show_line_box_borders)
+{
+    if (m_should_show_line_box_borders == should_show_line_box_borders)
+        return;
+    m_should_show_line_box_borders = should_show_line_box_borders;
+    if (page().top_level_traversable_is_initialized())
+        page().top_level_traversable()->set_needs_display(Web::InvalidateDisplayList::No);
 }
 
 void PageClient::setup_palette()
@@ -194,12 +207,53 @@ void PageClient::paint_next_frame()
         return;
 
     auto viewport_rect = page().css_to_device_rect(page().top_level_traversable()->viewport_rect());
-    paint(viewport_rect, *back_store);
+    Web::DevicePixelRect content_rect { {}, viewport_rect.size() };
+
+    Web::PaintOptions paint_options;
+    if (auto document = page().top_level_traversable()->active_document()) {
+        if (auto damage_rect = document->take_damage_rect(); damage_rect.has_value() && m_backing_store_manager.copy_front_store_damage_into_back_store()) {
+            // NOTE: Inflate a little to cover anti-aliasing that bleeds past the edges of the damaged content.
+            paint_options.damage_rect = page().enclosing_device_rect(*damage_rect).inflated(2, 2).intersected(content_rect);
+        }
+    }
+    paint_options.should_show_line_box_borders = m_should_show_line_box_borders;
+    paint_options.has_focus = m_has_focus;
 
-    m_backing_store_manager.swap_back_and_front();
+    auto painted_rect = paint_options.damage_rect.value_or(content_rect).to_type<int>();
+    auto backing_store_generation = m_backing_store_manager.generation();
 
+    // NOTE: The display list is played back on the rendering thread. We don't start on the next frame until the
+    //       client has received this one, so the back store isn't touched by anything else in the meantime.
     m_paint_state = PaintState::WaitingForClient;
-    client().async_did_paint(m_id, viewport_rect.to_type<int>(), m_backing_store_manager.front_id());
+    auto started = page().top_level_traversable()->start_display_list_rendering(viewport_rect, *back_store, paint_options, [this, strong_this = JS::make_handle(this), viewport_rect, painted_rect, backing_store_generation] {
+        if (backing_store_generation != m_backing_store_manager.generation()) {
+            // The backing stores were reallocated since we started painting, so this frame is stale.
+            m_paint_state = PaintState::Ready;
+            page().top_level_traversable()->set_needs_display();
+            return;
+        }
+
+        m_backing_store_manager.swap_back_and_front(painted_rect);
+        client().async_did_paint(m_id, viewport_rect.to_type<int>(), m_backing_store_manager.front_id());
+    });
+    if (!started)
+        m_paint_state = PaintState::Ready;
+}
+
+// Scroll offsets are applied to the recorded display list as it's played back on the rendering thread, so a frame at
+// the new scroll position doesn't need anything from the rendering update. Painting it right after the input event
+// keeps scrolling responsive while the rendering task is queued behind script tasks. Scroll events and everything
+// else that depends on the scroll position still happen during the next rendering update.
+void PageClient::paint_next_frame_if_only_scrolled()
+{
+    if (!is_ready_to_paint())
+        return;
+
+    auto document = page().top_level_traversable()->active_document();
+    if (!document || !document->needs_repaint() || !document->has_cached_display_list())
+        return;
+
+    paint_next_frame();
 }
 
 void PageClient::paint(Web::DevicePixelRect const& content_rect, Web::Painting::BackingStore& target, Web::PaintOptions paint_options)
@@ -209,6 +263,16 @@ void PageClient::paint(Web::DevicePixelRect const& content_rect, Web::Painting::
     page().top_level_traversable()->paint(content_rect, target, paint_options);
 }
 
+void PageClient::set_system_visibility_state(Web::HTML::VisibilityState visibility_state)
+{
+    page().top_level_traversable()->set_system_visibility_state(visibility_state);
+
+    if (visibility_state == Web::HTML::VisibilityState::Visible)
+        m_paint_refresh_timer->start();
+    else
+        m_paint_refresh_timer->stop();
+}
+
 void PageClient::set_viewport_size(Web::DevicePixelSize const& size)
 {
     page().top_level_traversable()->set_viewport_size(page().device_to_css_size(size));
@@ -502,6 +566,31 @@ void PageClient::page_did_update_cookie(Web::Cookie::Cookie cookie)
     client().async_did_update_cookie(move(cookie));
 }
 
+OrderedHashMap<String, String> PageClient::page_did_request_local_storage_items(String const& storage_key)
+{
+    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidRequestLocalStorageItems>(storage_key);
+    if (!response) {
+        dbgln("WebContent client disconnected during DidRequestLocalStorageItems. Exiting peacefully.");
+        exit(0);
+    }
+    return response->take_items();
+}
+
+void PageClient::page_did_set_local_storage_item(String const& storage_key, String const& key, String const& value)
+{
+    client().async_did_set_local_storage_item(storage_key, key, value);
+}
+
+void PageClient::page_did_remove_local_storage_item(String const& storage_key, String const& key)
+{
+    client().async_did_remove_local_storage_item(storage_key, key);
+}
+
+void PageClient::page_did_clear_local_storage(String const& storage_key)
+{
+    client().async_did_clear_local_storage(storage_key);
+}
+
 void PageClient::page_did_update_resource_count(i32 count_waiting)
 {
     client().async_did_update_resource_count(m_id, count_waiting);
@@ -12,6 +12,7 @@
 #include <LibWeb/CSS/StyleSheetIdentifier.h>
 #include <LibWeb/HTML/AudioPlayState.h>
 #include <LibWeb/HTML/FileFilter.h>
+#include <LibWeb/HTML/VisibilityState.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/PixelUnits.h>
 #include <WebContent/BackingStoreManager.h>
@@ -42,17 +43,24 @@ public:
     ErrorOr<void> connect_to_webdriver(ByteString const& webdriver_ipc_path);
 
     virtual void paint_next_frame() override;
+
+    // Paints a frame right away if nothing but scroll offsets changed since the last one, see the implementation.
+    void paint_next_frame_if_only_scrolled();
     virtual void process_screenshot_requests() override;
     virtual void paint(Web::DevicePixelRect const& content_rect, Web::Painting::BackingStore&, Web::PaintOptions = {}) override;
 
     void set_palette_impl(Gfx::PaletteImpl&);
     void set_viewport_size(Web::DevicePixelSize const&);
+
+    // Pages that aren't visible don't need to be rendered, so they stop asking for rendering opportunities until
+    // they're shown again.
+    void set_system_visibility_state(Web::HTML::VisibilityState);
     void set_screen_rects(Vector<Web::DevicePixelRect, 4> const& rects, size_t main_screen_index) { m_screen_rect = rects[main_screen_index]; }
     void set_device_pixels_per_css_pixel(float device_pixels_per_css_pixel) { m_device_pixels_per_css_pixel = device_pixels_per_css_pixel; }
     void set_preferred_color_scheme(Web::CSS::PreferredColorScheme);
     void set_preferred_contrast(Web::CSS::PreferredContrast);
     void set_preferred_motion(Web::CSS::PreferredMotion);
-    void set_should_show_line_box_borders(bool b) { m_should_show_line_box_borders = b; }
+    void set_should_show_line_box_borders(bool);
     void set_has_focus(bool);
     void set_is_scripting_enabled(bool);
     void set_window_position(Web::DevicePixelPoint);
@@ -91,6 +99,9 @@ public:
 
     void queue_screenshot_task(Optional<i32> node_id);
 
+    size_t shrink_backing_stores() { return m_backing_store_manager.shrink_backing_stores(); }
+    size_t backing_store_size_in_bytes() const { return m_backing_store_manager.size_in_bytes(); }
+
     friend class BackingStoreManager;
 
 private:
@@ -146,6 +157,10 @@ private:
     virtual String page_did_request_cookie(URL::URL const&, Web::Cookie::Source) override;
     virtual void page_did_set_cookie(URL::URL const&, Web::Cookie::ParsedCookie const&, Web::Cookie::Source) override;
     virtual void page_did_update_cookie(Web::Cookie::Cookie) override;
+    virtual OrderedHashMap<String, String> page_did_request_local_storage_items(String const& storage_key) override;
+    virtual void page_did_set_local_storage_item(String const& storage_key, String const& key, String const& value) override;
+    virtual void page_did_remove_local_storage_item(String const& storage_key, String const& key) override;
+    virtual void page_did_clear_local_storage(String const& storage_key) override;
     virtual void page_did_update_resource_count(i32) override;
     virtual NewWebViewResult page_did_request_new_web_view(Web::HTML::ActivateTab, Web::HTML::WebViewHints, Web::HTML::TokenizedFeature::NoOpener) override;
     virtual void page_did_request_activate_tab() override;
@@ -28,6 +28,13 @@ public:
     PageClient& create_page();
     void remove_page(Badge<PageClient>, u64 index);
 
+    template<typename Callback>
+    void for_each_page(Callback callback)
+    {
+        for (auto& it : m_pages)
+            callback(*it.value);
+    }
+
     ConnectionFromClient& client() const { return m_client; }
 
 private:
@@ -10,10 +10,17 @@
 #include <AK/Badge.h>
 #include <AK/ByteBuffer.h>
 #include <AK/ByteString.h>
+#include <AK/Function.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
 #include <AK/LexicalPath.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Platform.h>
+#include <AK/QuickSort.h>
+#include <AK/RefCounted.h>
 #include <AK/String.h>
+#include <AK/Time.h>
 #include <AK/Vector.h>
 #include <Ladybird/HelperProcess.h>
 #include <Ladybird/Utilities.h>
@@ -26,6 +33,7 @@
 #include <LibCore/Promise.h>
 #include <LibCore/ResourceImplementationFile.h>
 #include <LibCore/Timer.h>
+#include <LibCore/Tracing.h>
 #include <LibDiff/Format.h>
 #include <LibDiff/Generator.h>
 #include <LibFileSystem/FileSystem.h>
@@ -42,13 +50,12 @@
 #include <LibURL/URL.h>
 #include <LibWeb/HTML/SelectedFile.h>
 #include <LibWebView/Application.h>
+#include <LibWebView/URL.h>
 #include <LibWebView/ViewImplementation.h>
 #include <LibWebView/WebContentClient.h>
 
 constexpr int DEFAULT_TIMEOUT_MS = 30000; // 30sec
 
-static StringView s_current_test_path;
-
 class HeadlessWebContentView final : public WebView::ViewImplementation {
 public:
     static ErrorOr<NonnullOwnPtr<HeadlessWebContentView>> create(Core::AnonymousBuffer theme, Gfx::IntSize const& window_size, StringView resources_folder)
@@ -79,10 +86,10 @@ public:
         if (auto web_driver_ipc_path = WebView::Application::chrome_options().webdriver_content_ipc_path; web_driver_ipc_path.has_value())
             view->client().async_connect_to_webdriver(0, *web_driver_ipc_path);
 
-        view->m_client_state.client->on_web_content_process_crash = [] {
+        view->m_client_state.client->on_web_content_process_crash = [view = view.ptr()] {
             warnln("\033[31;1mWebContent Crashed!!\033[0m");
-            if (!s_current_test_path.is_empty()) {
-                warnln("    Last started test: {}", s_current_test_path);
+            if (!view->m_current_test_path.is_empty()) {
+                warnln("    Last started test: {}", view->m_current_test_path);
             }
             VERIFY_NOT_REACHED();
         };
@@ -90,23 +97,21 @@ public:
         return view;
     }
 
-    RefPtr<Gfx::Bitmap> take_screenshot()
+    NonnullRefPtr<Core::Promise<RefPtr<Gfx::Bitmap>>> take_screenshot()
     {
-        VERIFY(!m_pending_screenshot);
-
-        m_pending_screenshot = Core::Promise<RefPtr<Gfx::Bitmap>>::construct();
+        // Screenshots arrive in the order they were asked for. Keeping them in that order means that a screenshot
+        // which is still in flight for a test that timed out isn't handed to the next test.
+        auto promise = Core::Promise<RefPtr<Gfx::Bitmap>>::construct();
+        m_pending_screenshots.append(promise);
         client().async_take_document_screenshot(0);
-
-        auto screenshot = MUST(m_pending_screenshot->await());
-        m_pending_screenshot = nullptr;
-
-        return screenshot;
+        return promise;
     }
 
     virtual void did_receive_screenshot(Badge<WebView::WebContentClient>, Gfx::ShareableBitmap const& screenshot) override
     {
-        VERIFY(m_pending_screenshot);
-        m_pending_screenshot->resolve(screenshot.bitmap());
+        VERIFY(!m_pending_screenshots.is_empty());
+        auto promise = m_pending_screenshots.take_first();
+        promise->resolve(screenshot.bitmap());
     }
 
     void clear_content_filters()
@@ -114,6 +119,8 @@ public:
         client().async_set_content_filters(0, {});
     }
 
+    void set_current_test_path(ByteString path) { m_current_test_path = move(path); }
+
 private:
     HeadlessWebContentView(RefPtr<ImageDecoderClient::Client> image_decoder_client, RefPtr<Requests::RequestClient> request_client)
         : m_request_client(move(request_client))
@@ -133,7 +140,10 @@ private:
     virtual Gfx::IntPoint to_widget_position(Gfx::IntPoint content_position) const override { return content_position; }
 
     Gfx::IntSize m_viewport_size;
-    RefPtr<Core::Promise<RefPtr<Gfx::Bitmap>>> m_pending_screenshot;
+    Vector<NonnullRefPtr<Core::Promise<RefPtr<Gfx::Bitmap>>>> m_pending_screenshots;
+
+    // The crash handler reports this, so that we know which test brought WebContent down.
+    ByteString m_current_test_path;
 
     RefPtr<Requests::RequestClient> m_request_client;
     RefPtr<ImageDecoderClient::Client> m_image_decoder_client;
@@ -152,17 +162,19 @@ static ErrorOr<NonnullRefPtr<Core::Timer>> load_page_for_screenshot_and_exit(Cor
     auto timer = Core::Timer::create_single_shot(
         screenshot_timeout * 1000,
         [&]() {
-            if (auto screenshot = view.take_screenshot()) {
-                outln("Saving screenshot to {}", output_file_path);
-
-                auto output_file = MUST(Core::File::open(output_file_path, Core::File::OpenMode::Write));
-                auto image_buffer = MUST(Gfx::PNGWriter::encode(*screenshot));
-                MUST(output_file->write_until_depleted(image_buffer.bytes()));
-            } else {
-                warnln("No screenshot available");
-            }
-
-            event_loop.quit(0);
+            view.take_screenshot()->when_resolved([&](RefPtr<Gfx::Bitmap>& screenshot) {
+                if (screenshot) {
+                    outln("Saving screenshot to {}", output_file_path);
+
+                    auto output_file = MUST(Core::File::open(output_file_path, Core::File::OpenMode::Write));
+                    auto image_buffer = MUST(Gfx::PNGWriter::encode(*screenshot, { .encode_in_parallel = true }));
+                    MUST(output_file->write_until_depleted(image_buffer.bytes()));
+                } else {
+                    warnln("No screenshot available");
+                }
+
+                event_loop.quit(0);
+            });
         });
 
     view.load(url);
@@ -198,65 +210,66 @@ static StringView test_result_to_string(TestResult result)
     VERIFY_NOT_REACHED();
 }
 
-static ErrorOr<TestResult> run_dump_test(HeadlessWebContentView& view, URL::URL const& url, StringView expectation_path, TestMode mode, bool rebaseline = false, int timeout_in_milliseconds = DEFAULT_TIMEOUT_MS)
-{
-    Core::EventLoop loop;
-    bool did_timeout = false;
-
-    auto timeout_timer = Core::Timer::create_single_shot(timeout_in_milliseconds, [&] {
-        did_timeout = true;
-        loop.quit(0);
-    });
-
-    String result;
-    auto did_finish_test = false;
-    auto did_finish_loading = false;
+struct Test {
+    ByteString input_path;
+    ByteString expectation_path;
+    TestMode mode;
+    Optional<TestResult> result;
+    AK::Duration duration;
+};
 
-    if (mode == TestMode::Layout) {
-        view.on_load_finish = [&](auto const& loaded_url) {
-            // This callback will be called for 'about:blank' first, then for the URL we actually want to dump
-            VERIFY(url.equals(loaded_url, URL::ExcludeFragment::Yes) || loaded_url.equals(URL::URL("about:blank")));
+// A test that is running in a view. Tests don't block while they run, so that several views can run tests side by
+// side on the same event loop. A test run finishes once its result is known or once it times out, whichever is first.
+class TestRun : public RefCounted<TestRun> {
+public:
+    using OnComplete = Function<void(ErrorOr<TestResult>)>;
 
-            if (url.equals(loaded_url, URL::ExcludeFragment::Yes)) {
-                // NOTE: We take a screenshot here to force the lazy layout of SVG-as-image documents to happen.
-                //       It also causes a lot more code to run, which is good for finding bugs. :^)
-                (void)view.take_screenshot();
+    static NonnullRefPtr<TestRun> create(HeadlessWebContentView& view, OnComplete on_complete, int timeout_in_milliseconds)
+    {
+        auto run = adopt_ref(*new TestRun(view, move(on_complete)));
+        run->m_timeout_timer = Core::Timer::create_single_shot(timeout_in_milliseconds, [run = run.ptr()] {
+            run->finish(TestResult::Timeout);
+        });
+        run->m_timeout_timer->start();
+        return run;
+    }
 
-                auto promise = view.request_internal_page_info(WebView::PageInfoType::LayoutTree | WebView::PageInfoType::PaintTree);
-                result = MUST(promise->await());
+    bool is_finished() const { return m_is_finished; }
 
-                loop.quit(0);
-            }
-        };
+    void finish(ErrorOr<TestResult> result)
+    {
+        if (m_is_finished)
+            return;
+        m_is_finished = true;
 
-        view.on_text_test_finish = {};
-    } else if (mode == TestMode::Text) {
-        view.on_load_finish = [&](auto const& loaded_url) {
-            // NOTE: We don't want subframe loads to trigger the test finish.
-            if (!url.equals(loaded_url, URL::ExcludeFragment::Yes))
-                return;
-            did_finish_loading = true;
-            if (did_finish_test)
-                loop.quit(0);
-        };
+        NonnullRefPtr protect = *this;
+        m_timeout_timer->stop();
 
-        view.on_text_test_finish = [&](auto const& text) {
-            result = text;
+        // Anything the test is still waiting for from now on is ignored.
+        m_view.on_load_finish = nullptr;
+        m_view.on_text_test_finish = nullptr;
 
-            did_finish_test = true;
-            if (did_finish_loading)
-                loop.quit(0);
-        };
+        // We may be inside one of the view's callbacks here, and the next test will want to replace those.
+        Core::deferred_invoke([protect = move(protect), result = move(result)]() mutable {
+            protect->m_on_complete(move(result));
+        });
     }
 
-    view.load(url);
-
-    timeout_timer->start();
-    loop.exec();
+private:
+    TestRun(HeadlessWebContentView& view, OnComplete on_complete)
+        : m_view(view)
+        , m_on_complete(move(on_complete))
+    {
+    }
 
-    if (did_timeout)
-        return TestResult::Timeout;
+    HeadlessWebContentView& m_view;
+    OnComplete m_on_complete;
+    RefPtr<Core::Timer> m_timeout_timer;
+    bool m_is_finished { false };
+};
 
+static ErrorOr<TestResult> check_dump_test_result(URL::URL const& url, String const& result, StringView expectation_path, bool rebaseline)
+{
     if (expectation_path.is_empty()) {
         out("{}", result);
         return TestResult::Skipped;
@@ -301,38 +314,72 @@ static ErrorOr<TestResult> run_dump_test(HeadlessWebContentView& view, URL::URL
     return TestResult::Fail;
 }
 
-static ErrorOr<TestResult> run_ref_test(HeadlessWebContentView& view, URL::URL const& url, bool dump_failed_ref_tests, int timeout_in_milliseconds = DEFAULT_TIMEOUT_MS)
+static void run_dump_test(HeadlessWebContentView& view, URL::URL const& url, ByteString expectation_path, TestMode mode, TestRun::OnComplete on_complete, bool rebaseline = false, int timeout_in_milliseconds = DEFAULT_TIMEOUT_MS)
 {
-    Core::EventLoop loop;
-    bool did_timeout = false;
+    auto run = TestRun::create(view, move(on_complete), timeout_in_milliseconds);
 
-    auto timeout_timer = Core::Timer::create_single_shot(timeout_in_milliseconds, [&] {
-        did_timeout = true;
-        loop.quit(0);
-    });
-
-    RefPtr<Gfx::Bitmap> actual_screenshot, expectation_screenshot;
-    view.on_load_finish = [&](auto const&) {
-        if (actual_screenshot) {
-            expectation_screenshot = view.take_screenshot();
-            loop.quit(0);
-        } else {
-            actual_screenshot = view.take_screenshot();
-            view.debug_request("load-reference-page");
-        }
-    };
-    view.on_text_test_finish = [&](auto const&) {
-        dbgln("Unexpected text test finished during ref test for {}", url);
+    auto finish_with_result = [run, url, expectation_path = move(expectation_path), rebaseline](String const& result) {
+        run->finish(check_dump_test_result(url, result, expectation_path, rebaseline));
     };
 
-    view.load(url);
+    if (mode == TestMode::Layout) {
+        view.on_load_finish = [&view, run, url, finish_with_result](auto const& loaded_url) {
+            // This callback will be called for 'about:blank' first, then for the URL we actually want to dump
+            VERIFY(url.equals(loaded_url, URL::ExcludeFragment::Yes) || loaded_url.equals(URL::URL("about:blank")));
 
-    timeout_timer->start();
-    loop.exec();
+            if (!url.equals(loaded_url, URL::ExcludeFragment::Yes))
+                return;
+            view.on_load_finish = nullptr;
+
+            // NOTE: We take a screenshot here to force the lazy layout of SVG-as-image documents to happen.
+            //       It also causes a lot more code to run, which is good for finding bugs. :^)
+            view.take_screenshot()->when_resolved([&view, run, url, finish_with_result](RefPtr<Gfx::Bitmap>&) {
+                if (run->is_finished())
+                    return;
+
+                auto promise = view.request_internal_page_info(WebView::PageInfoType::LayoutTree | WebView::PageInfoType::PaintTree);
+                promise->when_resolved([run, finish_with_result](String& result) {
+                    if (!run->is_finished())
+                        finish_with_result(result);
+                });
+                promise->when_rejected([run, url](Error& error) {
+                    // This happens if the request of a test that timed out is still in flight.
+                    warnln("Unable to dump the layout tree of {}: {}", url, error);
+                    run->finish(TestResult::Fail);
+                });
+            });
+        };
+
+        view.on_text_test_finish = {};
+    } else if (mode == TestMode::Text) {
+        // The test is done once it has both finished loading and reported its result, in whichever order.
+        struct TextTestState : public RefCounted<TextTestState> {
+            Optional<String> result;
+            bool did_finish_loading { false };
+        };
+        auto state = make_ref_counted<TextTestState>();
+
+        view.on_load_finish = [state, url, finish_with_result](auto const& loaded_url) {
+            // NOTE: We don't want subframe loads to trigger the test finish.
+            if (!url.equals(loaded_url, URL::ExcludeFragment::Yes))
+                return;
+            state->did_finish_loading = true;
+            if (state->result.has_value())
+                finish_with_result(*state->result);
+        };
 
-    if (did_timeout)
-        return TestResult::Timeout;
+        view.on_text_test_finish = [state, finish_with_result](auto const& text) {
+            state->result = text;
+            if (state->did_finish_loading)
+                finish_with_result(*state->result);
+        };
+    }
 
+    view.load(url);
+}
+
+static ErrorOr<TestResult> check_ref_test_result(URL::URL const& url, RefPtr<Gfx::Bitmap> const& actual_screenshot, RefPtr<Gfx::Bitmap> const& expectation_screenshot, bool dump_failed_ref_tests)
+{
     VERIFY(actual_screenshot);
     VERIFY(expectation_screenshot);
 
@@ -344,7 +391,7 @@ static ErrorOr<TestResult> run_ref_test(HeadlessWebContentView& view, URL::URL c
         auto title = LexicalPath::title(URL::percent_decode(url.serialize_path()));
         auto dump_screenshot = [&](Gfx::Bitmap& bitmap, StringView path) -> ErrorOr<void> {
             auto screenshot_file = TRY(Core::File::open(path, Core::File::OpenMode::Write));
-            auto encoded_data = TRY(Gfx::PNGWriter::encode(bitmap));
+            auto encoded_data = TRY(Gfx::PNGWriter::encode(bitmap, { .encode_in_parallel = true }));
             TRY(screenshot_file->write_until_depleted(encoded_data));
             warnln("\033[33;1mDumped {}\033[0m", TRY(FileSystem::real_path(path)));
             return {};
@@ -360,17 +407,68 @@ static ErrorOr<TestResult> run_ref_test(HeadlessWebContentView& view, URL::URL c
     return TestResult::Fail;
 }
 
-static ErrorOr<TestResult> run_test(HeadlessWebContentView& view, StringView input_path, StringView expectation_path, TestMode mode, bool dump_failed_ref_tests, bool rebaseline)
+static void run_ref_test(HeadlessWebContentView& view, URL::URL const& url, bool dump_failed_ref_tests, TestRun::OnComplete on_complete, int timeout_in_milliseconds = DEFAULT_TIMEOUT_MS)
+{
+    auto run = TestRun::create(view, move(on_complete), timeout_in_milliseconds);
+
+    view.on_load_finish = [&view, run, url, dump_failed_ref_tests](auto const&) {
+        view.on_load_finish = nullptr;
+
+        view.take_screenshot()->when_resolved([&view, run, url, dump_failed_ref_tests](RefPtr<Gfx::Bitmap>& actual_screenshot) {
+            if (run->is_finished())
+                return;
+
+            view.on_load_finish = [&view, run, url, dump_failed_ref_tests, actual_screenshot](auto const&) {
+                view.on_load_finish = nullptr;
+
+                view.take_screenshot()->when_resolved([run, url, dump_failed_ref_tests, actual_screenshot](RefPtr<Gfx::Bitmap>& expectation_screenshot) {
+                    if (!run->is_finished())
+                        run->finish(check_ref_test_result(url, actual_screenshot, expectation_screenshot, dump_failed_ref_tests));
+                });
+            };
+            view.debug_request("load-reference-page");
+        });
+    };
+    view.on_text_test_finish = [url](auto const&) {
+        dbgln("Unexpected text test finished during ref test for {}", url);
+    };
+
+    view.load(url);
+}
+
+static void run_test(HeadlessWebContentView& view, Test const& test, bool dump_failed_ref_tests, bool rebaseline, TestRun::OnComplete on_complete)
 {
     // Clear the current document.
     // FIXME: Implement a debug-request to do this more thoroughly.
-    auto promise = Core::Promise<Empty>::construct();
-    view.on_load_finish = [&](auto) {
-        promise->resolve({});
+    view.on_load_finish = [&view, &test, dump_failed_ref_tests, rebaseline, on_complete = move(on_complete)](auto const&) mutable {
+        view.on_load_finish = nullptr;
+
+        // The test installs callbacks of its own, which it can't do from inside this one.
+        Core::deferred_invoke([&view, &test, dump_failed_ref_tests, rebaseline, on_complete = move(on_complete)]() mutable {
+            auto input_path = FileSystem::real_path(test.input_path);
+            if (input_path.is_error()) {
+                on_complete(input_path.release_error());
+                return;
+            }
+
+            auto url = URL::create_with_file_scheme(input_path.release_value());
+            view.set_current_test_path(test.input_path);
+
+            switch (test.mode) {
+            case TestMode::Text:
+            case TestMode::Layout:
+                run_dump_test(view, url, test.expectation_path, test.mode, move(on_complete), rebaseline);
+                return;
+            case TestMode::Ref:
+                run_ref_test(view, url, dump_failed_ref_tests, move(on_complete));
+                return;
+            }
+            VERIFY_NOT_REACHED();
+        });
     };
     view.on_text_test_finish = {};
 
-    view.on_request_file_picker = [&](auto const& accepted_file_types, auto allow_multiple_files) {
+    view.on_request_file_picker = [&view](auto const& accepted_file_types, auto allow_multiple_files) {
         // Create some dummy files for tests.
         Vector<Web::HTML::SelectedFile> selected_files;
 
@@ -412,29 +510,8 @@ static ErrorOr<TestResult> run_test(HeadlessWebContentView& view, StringView inp
     };
 
     view.load(URL::URL("about:blank"sv));
-    MUST(promise->await());
-
-    auto url = URL::create_with_file_scheme(TRY(FileSystem::real_path(input_path)));
-    s_current_test_path = input_path;
-
-    switch (mode) {
-    case TestMode::Text:
-    case TestMode::Layout:
-        return run_dump_test(view, url, expectation_path, mode, rebaseline);
-    case TestMode::Ref:
-        return run_ref_test(view, url, dump_failed_ref_tests);
-    default:
-        VERIFY_NOT_REACHED();
-    }
 }
 
-struct Test {
-    ByteString input_path;
-    ByteString expectation_path;
-    TestMode mode;
-    Optional<TestResult> result;
-};
-
 static Vector<ByteString> s_skipped_tests;
 
 static ErrorOr<void> load_test_config(StringView test_root_path)
@@ -477,7 +554,7 @@ static ErrorOr<void> collect_dump_tests(Vector<Test>& tests, StringView path, St
         auto basename = LexicalPath::title(name);
         auto expectation_path = ByteString::formatted("{}/expected/{}/{}.txt", path, trail, basename);
 
-        tests.append({ input_path, move(expectation_path), mode, {} });
+        tests.append({ input_path, move(expectation_path), mode, {}, {} });
     }
     return {};
 }
@@ -488,16 +565,16 @@ static ErrorOr<void> collect_ref_tests(Vector<Test>& tests, StringView path)
         if (entry.type == Core::DirectoryEntry::Type::Directory)
             return IterationDecision::Continue;
         auto input_path = TRY(FileSystem::real_path(ByteString::formatted("{}/{}", path, entry.name)));
-        tests.append({ input_path, {}, TestMode::Ref, {} });
+        tests.append({ input_path, {}, TestMode::Ref, {}, {} });
         return IterationDecision::Continue;
     }));
 
     return {};
 }
 
-static ErrorOr<int> run_tests(HeadlessWebContentView* view, StringView test_root_path, StringView test_glob, bool dump_failed_ref_tests, bool dump_gc_graph, bool dry_run, bool rebaseline)
+static ErrorOr<int> run_tests(Vector<NonnullOwnPtr<HeadlessWebContentView>>& views, StringView test_root_path, StringView test_glob, bool dump_failed_ref_tests, bool dump_gc_graph, bool dump_heap_snapshot, bool dry_run, bool rebaseline)
 {
-    if (view)
+    for (auto& view : views)
         view->clear_content_filters();
 
     TRY(load_test_config(test_root_path));
@@ -514,6 +591,13 @@ static ErrorOr<int> run_tests(HeadlessWebContentView* view, StringView test_root
         return !test.input_path.matches(test_glob, CaseSensitivity::CaseSensitive);
     });
 
+    if (dry_run) {
+        outln("Found {} tests...", tests.size());
+        for (size_t i = 0; i < tests.size(); ++i)
+            outln("{}/{}: {}", i + 1, tests.size(), LexicalPath::relative_path(tests[i].input_path, test_root_path));
+        return 0;
+    }
+
     size_t pass_count = 0;
     size_t fail_count = 0;
     size_t timeout_count = 0;
@@ -521,60 +605,91 @@ static ErrorOr<int> run_tests(HeadlessWebContentView* view, StringView test_root
 
     bool is_tty = isatty(STDOUT_FILENO);
 
-    if (dry_run)
-        outln("Found {} tests...", tests.size());
+    if (views.size() > 1)
+        outln("Running {} tests in {} views...", tests.size(), views.size());
     else
         outln("Running {} tests...", tests.size());
 
-    for (size_t i = 0; i < tests.size(); ++i) {
-        auto& test = tests[i];
-
-        if (is_tty && !dry_run) {
-            // Keep clearing and reusing the same line if stdout is a TTY.
-            out("\33[2K\r");
-        }
+    // Every view takes the next test that nobody has started yet as soon as it is done with its previous one, so the
+    // views stay busy no matter how long the individual tests take.
+    Core::EventLoop loop;
+    size_t next_test_index = 0;
+    size_t idle_view_count = 0;
+    Optional<Error> first_error;
+
+    Function<void(HeadlessWebContentView&)> run_next_test;
+    run_next_test = [&](HeadlessWebContentView& view) {
+        while (next_test_index < tests.size() && !first_error.has_value()) {
+            auto test_index = next_test_index++;
+            auto& test = tests[test_index];
+
+            if (is_tty) {
+                // Keep clearing and reusing the same line if stdout is a TTY.
+                out("\33[2K\r");
+            }
 
-        out("{}/{}: {}", i + 1, tests.size(), LexicalPath::relative_path(test.input_path, test_root_path));
+            out("{}/{}: {}", test_index + 1, tests.size(), LexicalPath::relative_path(test.input_path, test_root_path));
 
-        if (dry_run) {
-            outln("");
-            continue;
-        }
+            if (is_tty)
+                fflush(stdout);
+            else
+                outln("");
 
-        if (is_tty)
-            fflush(stdout);
-        else
-            outln("");
+            if (s_skipped_tests.contains_slow(test.input_path)) {
+                test.result = TestResult::Skipped;
+                ++skipped_count;
+                continue;
+            }
 
-        if (s_skipped_tests.contains_slow(test.input_path)) {
-            test.result = TestResult::Skipped;
-            ++skipped_count;
-            continue;
+            auto start_time = MonotonicTime::now();
+            run_test(view, test, dump_failed_ref_tests, rebaseline, [&, view = &view, test_index, start_time](ErrorOr<TestResult> result) {
+                auto& finished_test = tests[test_index];
+                finished_test.duration = MonotonicTime::now() - start_time;
+
+                if (result.is_error()) {
+                    if (!first_error.has_value())
+                        first_error = result.release_error();
+                } else {
+                    finished_test.result = result.value();
+                    switch (*finished_test.result) {
+                    case TestResult::Pass:
+                        ++pass_count;
+                        break;
+                    case TestResult::Fail:
+                        ++fail_count;
+                        break;
+                    case TestResult::Timeout:
+                        ++timeout_count;
+                        break;
+                    case TestResult::Skipped:
+                        VERIFY_NOT_REACHED();
+                        break;
+                    }
+                }
+
+                run_next_test(*view);
+            });
+            return;
         }
 
-        test.result = TRY(run_test(*view, test.input_path, test.expectation_path, test.mode, dump_failed_ref_tests, rebaseline));
-        switch (*test.result) {
-        case TestResult::Pass:
-            ++pass_count;
-            break;
-        case TestResult::Fail:
-            ++fail_count;
-            break;
-        case TestResult::Timeout:
-            ++timeout_count;
-            break;
-        case TestResult::Skipped:
-            VERIFY_NOT_REACHED();
-            break;
-        }
-    }
+        // Once one test has failed to run, we let the others that are still running finish but don't start new ones.
+        if (++idle_view_count == views.size())
+            loop.quit(0);
+    };
 
-    if (dry_run)
-        return 0;
+    auto start_time = MonotonicTime::now();
+    for (auto& view : views)
+        run_next_test(*view);
+    if (idle_view_count < views.size())
+        loop.exec();
+    auto total_duration = MonotonicTime::now() - start_time;
 
     if (is_tty)
         outln("\33[2K\rDone!");
 
+    if (first_error.has_value())
+        return first_error.release_value();
+
     outln("==================================================");
     outln("Pass: {}, Fail: {}, Skipped: {}, Timeout: {}", pass_count, fail_count, skipped_count, timeout_count);
     outln("==================================================");
@@ -584,12 +699,40 @@ static ErrorOr<int> run_tests(HeadlessWebContentView* view, StringView test_root
         outln("{}: {}", test_result_to_string(*test.result), test.input_path);
     }
 
+    Vector<Test const*> slowest_tests;
+    for (auto const& test : tests) {
+        if (*test.result != TestResult::Skipped)
+            slowest_tests.append(&test);
+    }
+    quick_sort(slowest_tests, [](auto const* a, auto const* b) { return a->duration > b->duration; });
+
+    static constexpr size_t slowest_test_count = 10;
+    if (!slowest_tests.is_empty()) {
+        outln("==================================================");
+        outln("Ran for {}ms, slowest tests:", total_duration.to_milliseconds());
+        for (size_t i = 0; i < min(slowest_tests.size(), slowest_test_count); ++i)
+            outln("{}ms: {}", slowest_tests[i]->duration.to_milliseconds(), LexicalPath::relative_path(slowest_tests[i]->input_path, test_root_path));
+    }
+
     if (dump_gc_graph) {
-        auto path = view->dump_gc_graph();
-        if (path.is_error()) {
-            warnln("Failed to dump GC graph: {}", path.error());
-        } else {
-            outln("GC graph dumped to {}", path.value());
+        for (auto& view : views) {
+            auto path = view->dump_gc_graph();
+            if (path.is_error()) {
+                warnln("Failed to dump GC graph: {}", path.error());
+            } else {
+                outln("GC graph dumped to {}", path.value());
+            }
+        }
+    }
+
+    if (dump_heap_snapshot) {
+        for (auto& view : views) {
+            auto path = view->dump_heap_snapshot();
+            if (path.is_error()) {
+                warnln("Failed to dump heap snapshot: {}", path.error());
+            } else {
+                outln("Heap snapshot dumped to {}", path.value());
+            }
         }
     }
 
@@ -598,6 +741,260 @@ static ErrorOr<int> run_tests(HeadlessWebContentView* view, StringView test_root
     return 1;
 }
 
+static constexpr Array benchmark_categories {
+    Core::Tracing::Category::Fetch,
+    Core::Tracing::Category::HTMLParse,
+    Core::Tracing::Category::Style,
+    Core::Tracing::Category::Layout,
+    Core::Tracing::Category::DisplayList,
+    Core::Tracing::Category::Raster,
+    Core::Tracing::Category::JavaScript,
+    Core::Tracing::Category::GC,
+};
+
+using BenchmarkTimings = Array<AK::Duration, benchmark_categories.size()>;
+
+// Works out how much time the traced events of each category took. Events on the same thread nest, so every event
+// only counts the time that the events inside of it don't account for. Fetches are asynchronous and overlap with
+// everything else, so for them we count the time during which any fetch was in flight instead.
+static ErrorOr<BenchmarkTimings> time_spent_per_category(JsonArray const& trace_events)
+{
+    struct Event {
+        size_t category_index;
+        u64 thread_id;
+        i64 start;
+        i64 duration;
+    };
+    Vector<Event> scoped_events;
+    Vector<Event> fetch_events;
+
+    for (auto const& value : trace_events.values()) {
+        if (!value.is_object())
+            return Error::from_string_literal("Trace event is not an object");
+        auto const& object = value.as_object();
+
+        // Flow events only connect the complete events to each other.
+        if (object.get_byte_string("ph"sv) != "X"sv)
+            continue;
+
+        auto category = Core::Tracing::parse_categories(object.get_byte_string("cat"sv).value_or({}));
+        auto start = object.get_i64("ts"sv);
+        auto duration = object.get_i64("dur"sv);
+        auto thread_id = object.get_u64("tid"sv);
+        if (!category.has_value() || !start.has_value() || !duration.has_value() || !thread_id.has_value())
+            return Error::from_string_literal("Malformed trace event");
+
+        auto category_index = benchmark_categories.first_index_of(*category);
+        if (!category_index.has_value())
+            continue;
+
+        Event event { *category_index, *thread_id, *start, *duration };
+        if (*category == Core::Tracing::Category::Fetch)
+            fetch_events.append(event);
+        else
+            scoped_events.append(event);
+    }
+
+    Array<i64, benchmark_categories.size()> microseconds {};
+
+    quick_sort(fetch_events, [](auto const& a, auto const& b) { return a.start < b.start; });
+    Optional<i64> in_flight_start;
+    i64 in_flight_end = 0;
+    for (auto const& event : fetch_events) {
+        if (in_flight_start.has_value() && event.start <= in_flight_end) {
+            in_flight_end = max(in_flight_end, event.start + event.duration);
+            continue;
+        }
+        if (in_flight_start.has_value())
+            microseconds[event.category_index] += in_flight_end - *in_flight_start;
+        in_flight_start = event.start;
+        in_flight_end = event.start + event.duration;
+    }
+    if (in_flight_start.has_value())
+        microseconds[fetch_events.first().category_index] += in_flight_end - *in_flight_start;
+
+    quick_sort(scoped_events, [](auto const& a, auto const& b) {
+        if (a.thread_id != b.thread_id)
+            return a.thread_id < b.thread_id;
+        if (a.start != b.start)
+            return a.start < b.start;
+        return a.duration > b.duration;
+    });
+
+    struct OpenEvent {
+        size_t index;
+        i64 end;
+    };
+    Vector<OpenEvent> open_events;
+    Vector<i64> self_times;
+    self_times.resize(scoped_events.size());
+
+    for (size_t i = 0; i < scoped_events.size(); ++i) {
+        auto const& event = scoped_events[i];
+        if (i > 0 && scoped_events[i - 1].thread_id != event.thread_id)
+            open_events.clear();
+        while (!open_events.is_empty() && open_events.last().end <= event.start)
+            open_events.take_last();
+
+        self_times[i] = event.duration;
+        if (!open_events.is_empty())
+            self_times[open_events.last().index] -= event.duration;
+        open_events.append({ i, event.start + event.duration });
+    }
+
+    for (size_t i = 0; i < scoped_events.size(); ++i)
+        microseconds[scoped_events[i].category_index] += self_times[i];
+
+    BenchmarkTimings timings;
+    for (size_t i = 0; i < timings.size(); ++i)
+        timings[i] = AK::Duration::from_microseconds(max<i64>(microseconds[i], 0));
+    return timings;
+}
+
+static double percentile_in_milliseconds(Vector<AK::Duration> durations, size_t percentile)
+{
+    VERIFY(!durations.is_empty());
+    quick_sort(durations);
+
+    // Nearest-rank, except that the median of an even number of samples is the mean of the two in the middle.
+    if (percentile == 50 && durations.size() % 2 == 0) {
+        auto middle = durations.size() / 2;
+        return static_cast<double>((durations[middle - 1] + durations[middle]).to_microseconds()) / 2000.0;
+    }
+
+    auto rank = ceil_div(percentile * durations.size(), static_cast<size_t>(100));
+    return static_cast<double>(durations[clamp<size_t>(rank, 1, durations.size()) - 1].to_microseconds()) / 1000.0;
+}
+
+static ErrorOr<void> load_page_and_wait(HeadlessWebContentView& view, URL::URL const& url)
+{
+    auto promise = Core::Promise<Empty>::construct();
+
+    view.on_load_finish = [&](auto const& loaded_url) {
+        // NOTE: We don't want subframe loads to count as the page having loaded.
+        if (url.equals(loaded_url, URL::ExcludeFragment::Yes))
+            promise->resolve({});
+    };
+
+    auto timeout_timer = Core::Timer::create_single_shot(DEFAULT_TIMEOUT_MS, [&] {
+        promise->reject(Error::from_string_literal("Timed out waiting for the page to load"));
+    });
+    timeout_timer->start();
+
+    view.load(url);
+    auto result = promise->await();
+
+    timeout_timer->stop();
+    view.on_load_finish = nullptr;
+
+    TRY(result);
+    return {};
+}
+
+static ErrorOr<JsonArray> take_trace_events(HeadlessWebContentView& view)
+{
+    auto trace = TRY(view.request_internal_page_info(WebView::PageInfoType::Trace)->await());
+    auto trace_events = TRY(JsonValue::from_string(trace));
+    if (!trace_events.is_array())
+        return Error::from_string_literal("Trace events are not an array");
+    return move(trace_events.as_array());
+}
+
+static ErrorOr<int> run_benchmark(HeadlessWebContentView& view, StringView url_list_path, size_t iterations, StringView trace_output_path)
+{
+    auto url_list_file = TRY(Core::File::open(url_list_path, Core::File::OpenMode::Read));
+    auto url_list = TRY(url_list_file->read_until_eof());
+
+    Vector<URL::URL> urls;
+    for (auto line : StringView { url_list.bytes() }.lines()) {
+        line = line.trim_whitespace();
+        if (line.is_empty() || line.starts_with('#'))
+            continue;
+
+        auto url = WebView::sanitize_url(line);
+        if (!url.has_value()) {
+            warnln("Invalid URL: \"{}\"", line);
+            return Error::from_string_literal("Invalid URL");
+        }
+        urls.append(url.release_value());
+    }
+
+    iterations = max<size_t>(iterations, 1);
+    outln("Loading {} pages {} times each...", urls.size(), iterations);
+
+    view.clear_content_filters();
+    view.debug_request("trace-categories", "all");
+
+    auto process_id = getpid();
+    JsonArray all_trace_events;
+
+    for (auto const& url : urls) {
+        Vector<AK::Duration> total_durations;
+        Array<Vector<AK::Duration>, benchmark_categories.size()> category_durations;
+
+        for (size_t iteration = 0; iteration < iterations; ++iteration) {
+            // Start every load from an empty document, and forget about whatever was traced while getting there.
+            TRY(load_page_and_wait(view, URL::URL("about:blank"sv)));
+            (void)TRY(take_trace_events(view));
+
+            auto start_time = MonotonicTime::now();
+            TRY(load_page_and_wait(view, url));
+
+            // NOTE: The screenshot makes sure that the page has been laid out, painted and rasterized.
+            (void)TRY(view.take_screenshot()->await());
+            auto total_duration = MonotonicTime::now() - start_time;
+
+            auto trace_events = TRY(take_trace_events(view));
+            auto timings = TRY(time_spent_per_category(trace_events));
+
+            total_durations.append(total_duration);
+            for (size_t i = 0; i < timings.size(); ++i)
+                category_durations[i].append(timings[i]);
+
+            JsonObject load_event;
+            load_event.set("name"sv, "Page load"sv);
+            load_event.set("cat"sv, "benchmark"sv);
+            load_event.set("ph"sv, "X"sv);
+            load_event.set("ts"sv, start_time.nanoseconds() / 1000);
+            load_event.set("dur"sv, total_duration.to_microseconds());
+            load_event.set("pid"sv, process_id);
+            load_event.set("tid"sv, 0);
+
+            JsonObject args;
+            args.set("url"sv, url.to_byte_string());
+            args.set("iteration"sv, iteration + 1);
+            load_event.set("args"sv, move(args));
+
+            all_trace_events.must_append(move(load_event));
+            for (auto& trace_event : trace_events.values())
+                all_trace_events.must_append(trace_event);
+        }
+
+        outln("{}", url);
+        outln("    {:<14} {:>10} {:>10}", "phase"sv, "median"sv, "p95"sv);
+
+        auto print_phase = [&](StringView name, Vector<AK::Duration> const& durations) {
+            outln("    {:<14} {:>8.1}ms {:>8.1}ms", name, percentile_in_milliseconds(durations, 50), percentile_in_milliseconds(durations, 95));
+        };
+        print_phase("total"sv, total_durations);
+        for (size_t i = 0; i < benchmark_categories.size(); ++i)
+            print_phase(Core::Tracing::category_name(benchmark_categories[i]), category_durations[i]);
+    }
+
+    view.debug_request("trace-categories", "none");
+
+    JsonObject trace;
+    trace.set("traceEvents"sv, move(all_trace_events));
+    trace.set("displayTimeUnit"sv, "ms"sv);
+
+    auto trace_json = trace.serialized<StringBuilder>();
+    auto trace_file = TRY(Core::File::open(trace_output_path, Core::File::OpenMode::Write));
+    TRY(trace_file->write_until_depleted(trace_json.bytes()));
+    outln("Trace written to {}", trace_output_path);
+
+    return 0;
+}
+
 struct Application : public WebView::Application {
     WEB_VIEW_APPLICATION(Application)
 
@@ -609,11 +1006,17 @@ struct Application : public WebView::Application {
         args_parser.add_option(test_root_path, "Run tests in path", "run-tests", 'R', "test-root-path");
         args_parser.add_option(test_glob, "Only run tests matching the given glob", "filter", 'f', "glob");
         args_parser.add_option(test_dry_run, "List the tests that would be run, without running them", "dry-run");
+        args_parser.add_option(test_concurrency, "Run [n] tests at the same time, each in its own view (default: 1)", "jobs", 'j', "n");
         args_parser.add_option(dump_failed_ref_tests, "Dump screenshots of failing ref tests", "dump-failed-ref-tests", 'D');
+        args_parser.add_option(benchmark_url_list_path, "Load every URL in the file repeatedly and report how long each phase of loading took", "benchmark", 0, "url-list");
+        args_parser.add_option(benchmark_iterations, "Load every page [n] times when benchmarking (default: 5)", "benchmark-iterations", 0, "n");
+        args_parser.add_option(benchmark_trace_path, "Write a Chrome trace of the benchmark to this file (default: benchmark-trace.json)", "benchmark-trace", 0, "path");
         args_parser.add_option(dump_gc_graph, "Dump GC graph", "dump-gc-graph", 'G');
+        args_parser.add_option(dump_heap_snapshot, "Dump a heap snapshot that can be loaded into Chrome's DevTools", "dump-heap-snapshot");
         args_parser.add_option(resources_folder, "Path of the base resources folder (defaults to /res)", "resources", 'r', "resources-root-path");
         args_parser.add_option(is_layout_test_mode, "Enable layout test mode", "layout-test-mode");
         args_parser.add_option(rebaseline, "Rebaseline any executed layout or text tests", "rebaseline");
+        args_parser.add_option(log_display_list_optimizations, "Log display list command counts before and after optimization", "log-display-list-optimizations");
     }
 
     virtual void create_platform_options(WebView::ChromeOptions&, WebView::WebContentOptions& web_content_options) override
@@ -624,6 +1027,7 @@ struct Application : public WebView::Application {
         }
 
         web_content_options.is_layout_test_mode = is_layout_test_mode ? WebView::IsLayoutTestMode::Yes : WebView::IsLayoutTestMode::No;
+        web_content_options.log_display_list_optimizations = log_display_list_optimizations ? WebView::LogDisplayListOptimizations::Yes : WebView::LogDisplayListOptimizations::No;
     }
 
     int screenshot_timeout { 1 };
@@ -632,11 +1036,17 @@ struct Application : public WebView::Application {
     bool dump_layout_tree { false };
     bool dump_text { false };
     bool dump_gc_graph { false };
+    bool dump_heap_snapshot { false };
     bool is_layout_test_mode { false };
     StringView test_root_path;
     ByteString test_glob;
     bool test_dry_run { false };
+    size_t test_concurrency { 1 };
+    StringView benchmark_url_list_path;
+    size_t benchmark_iterations { 5 };
+    ByteString benchmark_trace_path { "benchmark-trace.json"sv };
     bool rebaseline { false };
+    bool log_display_list_optimizations { false };
 };
 
 Application::Application(Badge<WebView::Application>, Main::Arguments&)
@@ -658,18 +1068,23 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     static constexpr Gfx::IntSize window_size { 800, 600 };
 
     if (!app->test_root_path.is_empty()) {
-        OwnPtr<HeadlessWebContentView> view;
-        if (!app->test_dry_run)
-            view = TRY(HeadlessWebContentView::create(move(theme), window_size, app->resources_folder));
+        Vector<NonnullOwnPtr<HeadlessWebContentView>> views;
+        if (!app->test_dry_run) {
+            for (size_t i = 0; i < max<size_t>(app->test_concurrency, 1); ++i)
+                views.append(TRY(HeadlessWebContentView::create(theme, window_size, app->resources_folder)));
+        }
 
         auto absolute_test_root_path = LexicalPath::absolute_path(TRY(FileSystem::current_working_directory()), app->test_root_path);
         app->test_root_path = absolute_test_root_path;
         auto test_glob = ByteString::formatted("*{}*", app->test_glob);
-        return run_tests(view, app->test_root_path, test_glob, app->dump_failed_ref_tests, app->dump_gc_graph, app->test_dry_run, app->rebaseline);
+        return run_tests(views, app->test_root_path, test_glob, app->dump_failed_ref_tests, app->dump_gc_graph, app->dump_heap_snapshot, app->test_dry_run, app->rebaseline);
     }
 
     auto view = TRY(HeadlessWebContentView::create(move(theme), window_size, app->resources_folder));
 
+    if (!app->benchmark_url_list_path.is_empty())
+        return run_benchmark(*view, app->benchmark_url_list_path, app->benchmark_iterations, app->benchmark_trace_path);
+
     VERIFY(!WebView::Application::chrome_options().urls.is_empty());
     auto const& url = WebView::Application::chrome_options().urls.first();
     if (!url.is_valid()) {
@@ -677,13 +1092,17 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return Error::from_string_literal("Invalid URL");
     }
 
-    if (app->dump_layout_tree) {
-        TRY(run_dump_test(*view, url, ""sv, TestMode::Layout));
-        return 0;
-    }
+    if (app->dump_layout_tree || app->dump_text) {
+        Core::EventLoop loop;
+        Optional<ErrorOr<TestResult>> result;
+
+        run_dump_test(*view, url, {}, app->dump_layout_tree ? TestMode::Layout : TestMode::Text, [&](ErrorOr<TestResult> test_result) {
+            result = move(test_result);
+            loop.quit(0);
+        });
+        loop.exec();
 
-    if (app->dump_text) {
-        TRY(run_dump_test(*view, url, ""sv, TestMode::Text));
+        TRY(result.release_value());
         return 0;
     }
 
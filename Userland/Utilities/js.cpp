@@ -6,10 +6,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/JsonObject.h>
 #include <AK/JsonValue.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/ConfigFile.h>
+#include <LibCore/File.h>
 #include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibJS/Bytecode/BasicBlock.h>
@@ -23,6 +25,7 @@
 #include <LibJS/Runtime/DeclarativeEnvironment.h>
 #include <LibJS/Runtime/GlobalEnvironment.h>
 #include <LibJS/Runtime/JSONObject.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibJS/Runtime/StringPrototype.h>
 #include <LibJS/Runtime/ValueInlines.h>
 #include <LibJS/SourceTextModule.h>
@@ -526,30 +529,47 @@ private:
     int m_group_stack_depth { 0 };
 };
 
+static ErrorOr<void> write_sampling_profile(StringView path)
+{
+    auto& profiler = *g_vm->sampling_profiler();
+    profiler.stop();
+
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write));
+    auto profile_json = profiler.to_cpuprofile_json().to_byte_string();
+    TRY(file->write_until_depleted(profile_json.bytes()));
+    warnln("Wrote {} samples to {}", profiler.sample_count(), path);
+    return {};
+}
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     TRY(Core::System::pledge("stdio rpath wpath cpath tty sigaction map_fixed"));
 
     bool gc_on_every_allocation = false;
+    bool print_gc_statistics = false;
     bool disable_syntax_highlight = false;
     bool disable_debug_printing = false;
     bool use_test262_global = false;
     StringView evaluate_script;
+    StringView profile_path;
     Vector<StringView> script_paths;
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("This is a JavaScript interpreter.");
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(JS::Bytecode::g_dump_bytecode_passes, "Dump what the bytecode optimization passes did", "dump-bytecode-passes", {});
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
     args_parser.add_option(s_disable_source_location_hints, "Disable source location hints", "disable-source-location-hints", 'h');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
+    args_parser.add_option(print_gc_statistics, "Print garbage collector statistics as JSON on exit", "gc-stats", {});
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_option(disable_debug_printing, "Disable debug output", "disable-debug-output", {});
     args_parser.add_option(evaluate_script, "Evaluate argument as a script", "evaluate", 'c', "script");
     args_parser.add_option(use_test262_global, "Use test262 global ($262)", "use-test262-global", {});
+    args_parser.add_option(profile_path, "Sample the interpreter and write a .cpuprofile (for Chrome DevTools) on exit", "profile", {}, "path");
     args_parser.add_positional_argument(script_paths, "Path to script files", "scripts", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -561,6 +581,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     g_vm = TRY(JS::VM::create());
     g_vm->set_dynamic_imports_allowed(true);
 
+    if (!profile_path.is_empty())
+        g_vm->start_sampling_profiler();
+
     if (!disable_debug_printing) {
         // NOTE: These will print out both warnings when using something like Promise.reject().catch(...) -
         // which is, as far as I can tell, correct - a promise is created, rejected without handler, and a
@@ -809,6 +832,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         s_editor->on_tab_complete = move(complete);
         TRY(repl(realm));
         s_editor->save_history(s_history_path.to_byte_string());
+
+        if (print_gc_statistics)
+            warnln("{}", g_vm->heap().dump_statistics().to_byte_string());
+
+        if (!profile_path.is_empty())
+            TRY(write_sampling_profile(profile_path));
     } else {
         OwnPtr<JS::ExecutionContext> root_execution_context;
         if (use_test262_global)
@@ -853,7 +882,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
         // We resolve modules as if it is the first file
 
-        if (!TRY(parse_and_run(realm, builder.string_view(), source_name)))
+        auto did_run = TRY(parse_and_run(realm, builder.string_view(), source_name));
+
+        if (print_gc_statistics)
+            warnln("{}", g_vm->heap().dump_statistics().to_byte_string());
+
+        if (!profile_path.is_empty())
+            TRY(write_sampling_profile(profile_path));
+
+        if (!did_run)
             return 1;
     }
 
@@ -10,6 +10,7 @@
 #include <AK/LexicalPath.h>
 #include <AK/Span.h>
 #include <AK/Vector.h>
+#include <LibArchive/Pipeline.h>
 #include <LibArchive/TarStream.h>
 #include <LibCompress/Gzip.h>
 #include <LibCompress/Lzma.h>
@@ -26,6 +27,7 @@
 #include <unistd.h>
 
 constexpr size_t buffer_size = 4096;
+constexpr size_t pipelined_buffer_size = 64 * KiB;
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
@@ -37,6 +39,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool lzma = false;
     bool xz = false;
     bool no_auto_compress = false;
+    bool pipelined = false;
     StringView archive_file;
     bool dereference = false;
     StringView directory;
@@ -51,6 +54,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(lzma, "Compress or decompress file using lzma", "lzma");
     args_parser.add_option(xz, "Compress or decompress file using xz", "xz", 'J');
     args_parser.add_option(no_auto_compress, "Do not use the archive suffix to select the compression algorithm", "no-auto-compress");
+    args_parser.add_option(pipelined, "Decompress, read and extract the archive on separate threads", "pipelined");
     args_parser.add_option(directory, "Directory to extract to/create from", "directory", 'C', "DIRECTORY");
     args_parser.add_option(archive_file, "Archive file", "file", 'f', "FILE");
     args_parser.add_option(dereference, "Follow symlinks", "dereference", 'h');
@@ -83,8 +87,28 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         if (lzma)
             input_stream = TRY(Compress::LzmaDecompressor::create_from_container(move(input_stream)));
 
-        if (xz)
-            input_stream = TRY(Compress::XzDecompressor::create(move(input_stream)));
+        if (xz) {
+            if (pipelined)
+                input_stream = TRY(Compress::XzDecompressor::create_parallel(move(input_stream)));
+            else
+                input_stream = TRY(Compress::XzDecompressor::create(move(input_stream)));
+        }
+
+        // Decompress on a separate thread, and leave all file system work to another one.
+        // NOTE: The file system operations only ever run one at a time, so they can share the file being extracted.
+        int output_fd = -1;
+        OwnPtr<Archive::SerialWorkQueue> file_system_queue;
+        if (pipelined) {
+            input_stream = TRY(Archive::ReadAheadStream::create(move(input_stream)));
+            if (extract)
+                file_system_queue = TRY(Archive::SerialWorkQueue::create("tar extract"sv));
+        }
+
+        auto run_file_system_operation = [&](Archive::SerialWorkQueue::Operation operation, size_t size = 0) -> ErrorOr<void> {
+            if (file_system_queue)
+                return file_system_queue->enqueue(move(operation), size);
+            return operation();
+        };
 
         auto tar_stream = TRY(Archive::TarInputStream::construct(move(input_stream)));
 
@@ -174,31 +198,49 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 switch (header.type_flag()) {
                 case Archive::TarFileType::NormalFile:
                 case Archive::TarFileType::AlternateNormalFile: {
-                    MUST(Core::Directory::create(parent_path, Core::Directory::CreateDirectories::Yes));
+                    TRY(run_file_system_operation([&output_fd, parent_path, absolute_path, header_mode]() -> ErrorOr<void> {
+                        MUST(Core::Directory::create(parent_path, Core::Directory::CreateDirectories::Yes));
 
-                    int fd = TRY(Core::System::open(absolute_path, O_CREAT | O_WRONLY, header_mode));
+                        output_fd = TRY(Core::System::open(absolute_path, O_CREAT | O_WRONLY, header_mode));
+                        return {};
+                    }));
 
-                    Array<u8, buffer_size> buffer;
                     while (!file_stream.is_eof()) {
+                        auto buffer = TRY(ByteBuffer::create_uninitialized(file_system_queue ? pipelined_buffer_size : buffer_size));
                         auto slice = TRY(file_stream.read_some(buffer));
-                        TRY(Core::System::write(fd, slice));
+                        buffer.trim(slice.size(), false);
+
+                        auto size = buffer.size();
+                        TRY(run_file_system_operation([&output_fd, buffer = move(buffer)]() -> ErrorOr<void> {
+                            TRY(Core::System::write(output_fd, buffer));
+                            return {};
+                        },
+                            size));
                     }
 
-                    TRY(Core::System::close(fd));
+                    TRY(run_file_system_operation([&output_fd]() -> ErrorOr<void> {
+                        return Core::System::close(output_fd);
+                    }));
                     break;
                 }
                 case Archive::TarFileType::SymLink: {
-                    MUST(Core::Directory::create(parent_path, Core::Directory::CreateDirectories::Yes));
+                    TRY(run_file_system_operation([parent_path, absolute_path, link_name = ByteString { header.link_name() }]() -> ErrorOr<void> {
+                        MUST(Core::Directory::create(parent_path, Core::Directory::CreateDirectories::Yes));
 
-                    TRY(Core::System::symlink(header.link_name(), absolute_path));
+                        TRY(Core::System::symlink(link_name, absolute_path));
+                        return {};
+                    }));
                     break;
                 }
                 case Archive::TarFileType::Directory: {
-                    MUST(Core::Directory::create(parent_path, Core::Directory::CreateDirectories::Yes));
+                    TRY(run_file_system_operation([parent_path, absolute_path, header_mode]() -> ErrorOr<void> {
+                        MUST(Core::Directory::create(parent_path, Core::Directory::CreateDirectories::Yes));
 
-                    auto result_or_error = Core::System::mkdir(absolute_path, header_mode);
-                    if (result_or_error.is_error() && result_or_error.error().code() != EEXIST)
-                        return result_or_error.release_error();
+                        auto result_or_error = Core::System::mkdir(absolute_path, header_mode);
+                        if (result_or_error.is_error() && result_or_error.error().code() != EEXIST)
+                            return result_or_error.release_error();
+                        return {};
+                    }));
                     break;
                 }
                 default:
@@ -214,6 +256,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             TRY(tar_stream->advance());
         }
 
+        if (file_system_queue)
+            TRY(file_system_queue->wait());
+
         return 0;
     }
 